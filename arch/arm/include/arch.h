@@ -104,10 +104,35 @@ do { \
 #  endif
 #endif /* CONFIG_ARCH_ADDRENV */
 
+/* With CONFIG_TLS_REGISTER (ARMv7-A), the User Read-Only Thread ID Register
+ * TPIDRURO holds the address of the TLS information of the running thread,
+ * i.e. the beginning of its stack allocation.  It is not part of the saved
+ * context, so it is reloaded on each context switch.
+ */
+
+#ifdef CONFIG_TLS_REGISTER
+#  define up_tls_info() ((FAR struct tls_info_s *)arm_read_tpidruro())
+#endif
+
 /****************************************************************************
  * Inline functions
  ****************************************************************************/
 
+#if defined(CONFIG_TLS_REGISTER) && !defined(__ASSEMBLY__)
+static inline uint32_t arm_read_tpidruro(void)
+{
+  uint32_t tpidruro;
+
+  __asm__ ("mrc p15, 0, %0, c13, c0, 3" : "=r" (tpidruro));
+  return tpidruro;
+}
+
+static inline void arm_write_tpidruro(uint32_t tpidruro)
+{
+  __asm__ __volatile__ ("mcr p15, 0, %0, c13, c0, 3" : : "r" (tpidruro));
+}
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -630,6 +630,15 @@ int up_addrenv_select(const group_addrenv_t *addrenv,
       /* Set (or clear) the new page table entry */
 
       paddr = (uintptr_t)addrenv->shm[i];
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+      if ((paddr & PMD_TYPE_MASK) == PMD_TYPE_SECT)
+        {
+          /* A large page section, the entry was saved by up_shmat() */
+
+          mmu_l1_restore(vaddr, paddr);
+        }
+      else
+#endif
       if (paddr)
         {
           mmu_l1_setentry(paddr, vaddr, MMU_L1_PGTABFLAGS);
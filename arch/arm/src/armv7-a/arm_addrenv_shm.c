@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
@@ -40,6 +41,57 @@
 
 #if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_SHM)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+#  if CONFIG_ARCH_SHM_LARGEPAGE_SHIFT != SECTION_SHIFT
+#    error CONFIG_ARCH_SHM_LARGEPAGE_SHIFT must be the section shift
+#  endif
+
+#  define SECTION_NPAGES (SECTION_SIZE >> MM_PGSHIFT)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: arm_shm_issection
+ *
+ * Description:
+ *   Return true if the next pages of the region fill the whole section at
+ *   vaddr with one aligned block of contiguous physical pages, as allocated
+ *   by shmget().  The section can then be mapped with a single level 1
+ *   entry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+static bool arm_shm_issection(const uintptr_t *pages, unsigned int npages,
+                              uintptr_t vaddr)
+{
+  unsigned int i;
+
+  if ((vaddr & SECTION_MASK) != 0 || (pages[0] & SECTION_MASK) != 0 ||
+      npages < SECTION_NPAGES)
+    {
+      return false;
+    }
+
+  for (i = 1; i < SECTION_NPAGES; i++)
+    {
+      if (pages[i] != pages[0] + (i << MM_PGSHIFT))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -76,6 +128,9 @@ int up_shmat(uintptr_t *pages, unsigned int npages, uintptr_t vaddr)
 #endif
   unsigned int nmapped;
   unsigned int shmndx;
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+  uint32_t l1;
+#endif
 
   shminfo("pages=%p npages=%d vaddr=%08lx\n",
           pages, npages, (unsigned long)vaddr);
@@ -96,6 +151,29 @@ int up_shmat(uintptr_t *pages, unsigned int npages, uintptr_t vaddr)
 
       shmndx = (vaddr - CONFIG_ARCH_SHM_VBASE) >> SECTION_SHIFT;
 
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+      /* Map a whole section with one level 1 entry, if there is no level 2
+       * page table for it already.  The entry is saved in shm[] as is:  The
+       * level 2 page table addresses there are never section entries.
+       */
+
+      if (group->tg_addrenv.shm[shmndx] == NULL &&
+          arm_shm_issection(pages, npages - nmapped, vaddr))
+        {
+          l1 = pages[0] | MMU_L1_SHMFLAGS;
+
+          flags = enter_critical_section();
+          group->tg_addrenv.shm[shmndx] = (uintptr_t *)l1;
+          mmu_l1_restore(vaddr, l1);
+          leave_critical_section(flags);
+
+          pages   += SECTION_NPAGES;
+          nmapped += SECTION_NPAGES;
+          vaddr   += SECTION_SIZE;
+          continue;
+        }
+#endif
+
       /* Has a level 1 page table entry been created for this virtual
        * address.
        */
@@ -253,6 +331,25 @@ int up_shmdt(uintptr_t vaddr, unsigned int npages)
       l1entry = group->tg_addrenv.shm[shmndx];
       DEBUGASSERT(l1entry != NULL);
 
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+      /* A section mapped by up_shmat() is unmapped as a whole */
+
+      if (((uintptr_t)l1entry & PMD_TYPE_MASK) == PMD_TYPE_SECT)
+        {
+          DEBUGASSERT((vaddr & SECTION_MASK) == 0 &&
+                      npages - nunmapped >= SECTION_NPAGES);
+
+          flags = enter_critical_section();
+          group->tg_addrenv.shm[shmndx] = NULL;
+          mmu_l1_clrentry(vaddr);
+          leave_critical_section(flags);
+
+          nunmapped += SECTION_NPAGES;
+          vaddr     += SECTION_SIZE;
+          continue;
+        }
+#endif
+
       /* Get the physical address of the L2 page table from the L1 page
        * table entry.
        */
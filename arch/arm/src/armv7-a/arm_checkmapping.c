@@ -92,4 +92,31 @@ bool arm_checkmapping(struct tcb_s *tcb)
   return (*pte != 0);
 }
 
+#ifdef CONFIG_PAGING_PREFETCH
+/****************************************************************************
+ * Name: up_nextpage()
+ *
+ * Description:
+ *   Set up the fault address in the context of tcb to the page after the
+ *   one of ftcb, for a prefetch fill.  tcb and ftcb may be the same.
+ *
+ ****************************************************************************/
+
+bool up_nextpage(struct tcb_s *tcb, const struct tcb_s *ftcb)
+{
+  uintptr_t vaddr;
+
+  DEBUGASSERT(tcb && ftcb);
+
+  vaddr = PG_ALIGNDOWN(ftcb->xcp.far) + PAGESIZE;
+  if (vaddr >= PG_PAGED_VEND)
+    {
+      return false;
+    }
+
+  tcb->xcp.far = vaddr;
+  return true;
+}
+#endif
+
 #endif /* CONFIG_PAGING */
@@ -334,4 +334,26 @@ int up_cpu_resume(int cpu)
   return OK;
 }
 
+/****************************************************************************
+ * Name: up_send_smp_call
+ *
+ * Description:
+ *   Raise SGI3 on the CPUs in 'cpuset'.  The SGI3 handler runs the requests
+ *   queued for the CPU by nxsched_smp_call().
+ *
+ * Input Parameters:
+ *   cpuset - The set of CPUs to interrupt
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+int up_send_smp_call(cpu_set_t cpuset)
+{
+  return arm_cpu_sgi(GIC_IRQ_SGI3, cpuset);
+}
+#endif
+
 #endif /* CONFIG_SMP */
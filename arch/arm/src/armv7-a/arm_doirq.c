@@ -31,6 +31,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/sched.h>
 #include <arch/board/board.h>
 
 #include "arm_internal.h"
@@ -70,7 +71,7 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
 
   irq_dispatch(irq, regs);
 
-#ifdef CONFIG_ARCH_ADDRENV
+#if defined(CONFIG_ARCH_ADDRENV) || defined(CONFIG_TLS_REGISTER)
   /* Check for a context switch.  If a context switch occurred, then
    * CURRENT_REGS will have a different value than it did on entry.  If an
    * interrupt level context switch has occurred, then establish the correct
@@ -79,6 +80,7 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
 
   if (regs != CURRENT_REGS)
     {
+#ifdef CONFIG_ARCH_ADDRENV
       /* Make sure that the address environment for the previously
        * running task is closed down gracefully (data caches dump,
        * MMU flushed) and set up the address environment for the new
@@ -86,6 +88,15 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
        */
 
       group_addrenv(NULL);
+#endif
+
+#ifdef CONFIG_TLS_REGISTER
+      /* TPIDRURO is not saved with the context, point it at the TLS
+       * information of the new thread.
+       */
+
+      arm_write_tpidruro((uint32_t)nxsched_self()->stack_alloc_ptr);
+#endif
     }
 #endif
 
@@ -77,6 +77,12 @@ void up_initial_state(struct tcb_s *tcb)
       arm_stack_color(tcb->stack_alloc_ptr, 0);
 #endif /* CONFIG_STACK_COLORATION */
 
+#ifdef CONFIG_TLS_REGISTER
+      /* The IDLE thread is already running, set its TPIDRURO directly */
+
+      arm_write_tpidruro((uint32_t)tcb->stack_alloc_ptr);
+#endif
+
       return;
     }
 
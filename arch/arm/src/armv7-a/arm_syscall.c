@@ -536,7 +536,7 @@ uint32_t *arm_syscall(uint32_t *regs)
         break;
     }
 
-#ifdef CONFIG_ARCH_ADDRENV
+#if defined(CONFIG_ARCH_ADDRENV) || defined(CONFIG_TLS_REGISTER)
   /* Check for a context switch.  If a context switch occurred, then
    * CURRENT_REGS will have a different value than it did on entry.  If an
    * interrupt level context switch has occurred, then establish the correct
@@ -545,6 +545,7 @@ uint32_t *arm_syscall(uint32_t *regs)
 
   if (regs != CURRENT_REGS)
     {
+#ifdef CONFIG_ARCH_ADDRENV
       /* Make sure that the address environment for the previously
        * running task is closed down gracefully (data caches dump,
        * MMU flushed) and set up the address environment for the new
@@ -552,6 +553,15 @@ uint32_t *arm_syscall(uint32_t *regs)
        */
 
       group_addrenv(NULL);
+#endif
+
+#ifdef CONFIG_TLS_REGISTER
+      /* TPIDRURO is not saved with the context, point it at the TLS
+       * information of the new thread.
+       */
+
+      arm_write_tpidruro((uint32_t)nxsched_self()->stack_alloc_ptr);
+#endif
     }
 #endif
 
@@ -598,7 +598,8 @@
  * registers, not the priority set by the sending Cortex-A9 processor.
  *
  * NOTE: If CONFIG_SMP is enabled then SGI1 and SGI2 are used for inter-CPU
- * task management.
+ * task management.  SGI3 is used for cross-CPU function calls if
+ * CONFIG_SMP_CALL is enabled.
  */
 
 #define GIC_IRQ_SGI0              0  /* Software Generated Interrupt (SGI) 0 */
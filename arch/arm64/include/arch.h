@@ -48,10 +48,30 @@
 
 #endif /* CONFIG_ARCH_ADDRENV */
 
+/* With CONFIG_TLS_REGISTER, TPIDR_EL0 holds the address of the TLS
+ * information of the running thread, i.e. the beginning of its stack
+ * allocation.  It is set when the thread is created and switched with the
+ * rest of its context.
+ */
+
+#ifdef CONFIG_TLS_REGISTER
+#  define up_tls_info() ((FAR struct tls_info_s *)arm64_read_tpidr_el0())
+#endif
+
 /****************************************************************************
  * Inline functions
  ****************************************************************************/
 
+#if defined(CONFIG_TLS_REGISTER) && !defined(__ASSEMBLY__)
+static inline uintptr_t arm64_read_tpidr_el0(void)
+{
+  uintptr_t tpidr;
+
+  __asm__ ("mrs %0, tpidr_el0" : "=r" (tpidr));
+  return tpidr;
+}
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -495,6 +495,16 @@ static inline uint64_t arch_get_current_tcb(void)
   return read_sysreg(tpidr_el1);
 }
 
+/* tpidr_el0 holds the TCB, too, unless it is used as the thread pointer for
+ * TLS (see up_tls_info())
+ */
+
+#ifdef CONFIG_TLS_REGISTER
+#  define ARM64_TPIDR_EL0(tcb)        ((uint64_t)(tcb)->stack_alloc_ptr)
+#else
+#  define ARM64_TPIDR_EL0(tcb)        ((uint64_t)(tcb))
+#endif
+
 void arch_cpu_idle(void);
 
 /****************************************************************************
@@ -116,7 +116,7 @@ static void arm64_smp_init_top(void *arg)
 
   write_sysreg(0, tpidrro_el0);
   write_sysreg(tcb, tpidr_el1);
-  write_sysreg(tcb, tpidr_el0);
+  write_sysreg(ARM64_TPIDR_EL0(tcb), tpidr_el0);
 
   nx_idle_trampoline();
 }
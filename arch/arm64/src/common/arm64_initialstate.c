@@ -85,7 +85,7 @@ void arm64_new_task(struct tcb_s * tcb)
   pinitctx->sp_elx       = (uint64_t)pinitctx;
   pinitctx->sp_el0       = (uint64_t)pinitctx;
   pinitctx->exe_depth    = 0;
-  pinitctx->tpidr_el0    = (uint64_t)tcb;
+  pinitctx->tpidr_el0    = ARM64_TPIDR_EL0(tcb);
   pinitctx->tpidr_el1    = (uint64_t)tcb;
 
   tcb->xcp.regs          = (uint64_t *)pinitctx;
@@ -133,7 +133,7 @@ void up_initial_state(struct tcb_s *tcb)
 
       write_sysreg(0, tpidrro_el0);
       write_sysreg(tcb, tpidr_el1);
-      write_sysreg(tcb, tpidr_el0);
+      write_sysreg(ARM64_TPIDR_EL0(tcb), tpidr_el0);
 
 #ifdef CONFIG_STACK_COLORATION
 
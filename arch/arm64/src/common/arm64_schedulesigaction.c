@@ -72,7 +72,7 @@ void arm64_init_signal_process(struct tcb_s *tcb)
   psigctx->sp_elx    = (uint64_t)psigctx;
   psigctx->sp_el0    = (uint64_t)psigctx;
   psigctx->exe_depth = 1;
-  psigctx->tpidr_el0 = (uint64_t)tcb;
+  psigctx->tpidr_el0 = ARM64_TPIDR_EL0(tcb);
   psigctx->tpidr_el1 = (uint64_t)tcb;
   tcb->xcp.regs      = (uint64_t *)psigctx;
 }
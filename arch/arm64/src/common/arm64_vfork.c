@@ -235,7 +235,7 @@ pid_t up_vfork(const struct vfork_s *context)
   pvforkctx->exe_depth       = 0;
   pvforkctx->sp_elx          = (uint64_t)pvforkctx;
   pvforkctx->sp_el0          = (uint64_t)pvforkctx;
-  pvforkctx->tpidr_el0       = (uint64_t)(&child->cmn);
+  pvforkctx->tpidr_el0       = ARM64_TPIDR_EL0(&child->cmn);
   pvforkctx->tpidr_el1       = (uint64_t)(&child->cmn);
 
   child->cmn.xcp.regs = (uint64_t *)pvforkctx;
@@ -52,6 +52,17 @@
 #  define ARCH_SPGTS          (ARCH_PGT_MAX_LEVELS - 1)
 #endif
 
+/* With CONFIG_TLS_REGISTER, the thread pointer register tp holds the
+ * address just past the TLS information of the running thread, where the
+ * __thread data begins (see riscv_tls.c).  It is set when the thread is
+ * created and switched with the rest of its context.
+ */
+
+#ifdef CONFIG_TLS_REGISTER
+#  define up_tls_info() \
+     ((FAR struct tls_info_s *)(riscv_read_tp() - sizeof(struct tls_info_s)))
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -110,6 +121,27 @@ typedef uintptr_t save_addrenv_t;
 #endif /* __ASSEMBLY__ */
 #endif /* CONFIG_ARCH_ADDRENV */
 
+/****************************************************************************
+ * Inline functions
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+#if defined(CONFIG_SCHED_THREAD_LOCAL) || defined(CONFIG_TLS_REGISTER)
+static inline uintptr_t riscv_read_tp(void)
+{
+  uintptr_t tp;
+
+  __asm__ ("mv %0, tp" : "=r" (tp));
+  return tp;
+}
+
+static inline void riscv_write_tp(uintptr_t tp)
+{
+  __asm__ __volatile__ ("mv tp, %0" : : "r" (tp));
+}
+#endif
+#endif /* __ASSEMBLY__ */
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
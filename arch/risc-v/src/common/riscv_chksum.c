@@ -0,0 +1,176 @@
+/****************************************************************************
+ * arch/risc-v/src/common/riscv_chksum.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORDSIZE sizeof(uintptr_t)
+
+/* Add w to the one's complement accumulator acc.  RISC-V has no carry
+ * flag:  The sum wrapped around if it is smaller than w.
+ */
+
+#define CHKSUM_ADD(acc, w) \
+  do \
+    { \
+      (acc) += (w); \
+      (acc) += ((acc) < (w)); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_chksum
+ *
+ * Description:
+ *   Calculate the raw Internet checksum over the memory region described
+ *   by data and len.
+ *
+ *   The data is summed in aligned register words, 8 bytes per three
+ *   instructions on RV64, instead of the 32-bit words of the generic
+ *   version.  Misaligned loads may trap, so the data is aligned first.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value in host byte order.
+ *
+ ****************************************************************************/
+
+uint16_t up_chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+{
+  FAR const uintptr_t *words;
+  unsigned int nbytes = len;
+  uintptr_t acc = 0;
+  uintptr_t w;
+  bool odd = false;
+
+  if (nbytes == 0)
+    {
+      return sum;
+    }
+
+  /* If the data starts at an odd address, the first byte is the second
+   * half of a word and all of the bytes are summed in swapped positions:
+   * Swap the sum back at the end.
+   */
+
+  if (((uintptr_t)data & 1) != 0)
+    {
+      acc = (uintptr_t)data[0] << 8;
+      data++;
+      nbytes--;
+      odd = true;
+    }
+
+  while (((uintptr_t)data & (WORDSIZE - 1)) != 0 && nbytes >= 2)
+    {
+      acc    += *(FAR const uint16_t *)data;
+      data   += 2;
+      nbytes -= 2;
+    }
+
+  words = (FAR const uintptr_t *)data;
+  while (nbytes >= 4 * WORDSIZE)
+    {
+      w = words[0];
+      CHKSUM_ADD(acc, w);
+      w = words[1];
+      CHKSUM_ADD(acc, w);
+      w = words[2];
+      CHKSUM_ADD(acc, w);
+      w = words[3];
+      CHKSUM_ADD(acc, w);
+
+      words  += 4;
+      nbytes -= 4 * WORDSIZE;
+    }
+
+  while (nbytes >= WORDSIZE)
+    {
+      w = *words++;
+      CHKSUM_ADD(acc, w);
+      nbytes -= WORDSIZE;
+    }
+
+  data = (FAR const uint8_t *)words;
+  while (nbytes >= 2)
+    {
+      w = *(FAR const uint16_t *)data;
+      CHKSUM_ADD(acc, w);
+      data   += 2;
+      nbytes -= 2;
+    }
+
+  if (nbytes > 0)
+    {
+      /* The last byte is the first half of a word */
+
+      w = data[0];
+      CHKSUM_ADD(acc, w);
+    }
+
+  /* Fold the register word into 16 bits.  After the 32-bit fold of RV64,
+   * three 16-bit folds are needed to absorb all of the carries.
+   */
+
+#if UINTPTR_MAX > UINT32_MAX
+  acc = (acc & 0xffffffff) + (acc >> 32);
+#endif
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  if (odd)
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+  /* RISC-V is little-endian:  Return the sum of big-endian words, added
+   * to the sum carried over.
+   */
+
+  acc  = ((acc & 0xff) << 8) | (acc >> 8);
+  sum += (uint16_t)acc;
+  if (sum < (uint16_t)acc)
+    {
+      sum++; /* carry */
+    }
+
+  return sum;
+}
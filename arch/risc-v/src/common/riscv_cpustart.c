@@ -34,6 +34,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/tls.h>
 
 #include "sched/sched.h"
 #include "init/init.h"
@@ -72,6 +73,13 @@ void riscv_cpu_boot(int cpu)
 
   asm("WFI");
 
+#if defined(CONFIG_SCHED_THREAD_LOCAL) || defined(CONFIG_TLS_REGISTER)
+  /* Set the thread pointer of the IDLE thread of this CPU */
+
+  riscv_write_tp((uintptr_t)this_task()->stack_alloc_ptr +
+                 sizeof(struct tls_info_s));
+#endif
+
   _info("CPU%d Started\n", this_cpu());
 
 #ifdef CONFIG_STACK_COLORATION
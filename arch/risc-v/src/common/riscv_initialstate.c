@@ -78,6 +78,13 @@ void up_initial_state(struct tcb_s *tcb)
 
       riscv_stack_color(tcb->stack_alloc_ptr, 0);
 #endif /* CONFIG_STACK_COLORATION */
+
+#if defined(CONFIG_SCHED_THREAD_LOCAL) || defined(CONFIG_TLS_REGISTER)
+      /* The IDLE thread is already running, set its tp directly */
+
+      riscv_write_tp((uintptr_t)tcb->stack_alloc_ptr +
+                     sizeof(struct tls_info_s));
+#endif
       return;
     }
 
@@ -101,7 +108,7 @@ void up_initial_state(struct tcb_s *tcb)
 
   /* Setup thread local storage pointer */
 
-#ifdef CONFIG_SCHED_THREAD_LOCAL
+#if defined(CONFIG_SCHED_THREAD_LOCAL) || defined(CONFIG_TLS_REGISTER)
   xcp->regs[REG_TP]      = (uintptr_t)tcb->stack_alloc_ptr +
                                      sizeof(struct tls_info_s);
 #endif
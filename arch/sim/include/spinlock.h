@@ -44,6 +44,15 @@
 
 typedef uint8_t spinlock_t;
 
+/* The simulated CPUs are host threads, and there may be more of them than
+ * host CPUs: The waits for a spinlock give the host CPU to the thread that
+ * holds it rather than spinning out the time slice.
+ */
+
+#ifdef CONFIG_SMP
+#  define SP_WFE() sim_cpu_relax()
+#endif
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -70,4 +79,16 @@ typedef uint8_t spinlock_t;
 
 /* See prototype in nuttx/include/nuttx/spinlock.h */
 
+/****************************************************************************
+ * Name: sim_cpu_relax
+ *
+ * Description:
+ *   Called at each turn of the loops that wait for a spinlock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void sim_cpu_relax(void);
+#endif
+
 #endif /* __ARCH_SIM_INCLUDE_SPINLOCK_H */
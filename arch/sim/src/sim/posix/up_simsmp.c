@@ -29,6 +29,7 @@
 #include <signal.h>
 #include <sched.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include "up_internal.h"
 
@@ -51,6 +52,10 @@ struct sim_cpuinfo_s
 static pthread_key_t g_cpu_key;
 static pthread_t     g_cpu_thread[CONFIG_SMP_NCPUS];
 
+/* The number of turns of the spin waits of this thread */
+
+static __thread unsigned int g_cpu_spins;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -78,7 +83,6 @@ static pthread_t     g_cpu_thread[CONFIG_SMP_NCPUS];
 static void *sim_idle_trampoline(void *arg)
 {
   struct sim_cpuinfo_s *cpuinfo = (struct sim_cpuinfo_s *)arg;
-  uint64_t now = 0;
   int ret;
 
   /* Set the CPU number for the CPU thread */
@@ -105,14 +109,14 @@ static void *sim_idle_trampoline(void *arg)
 
   up_cpu_started();
 
-  /* The idle Loop */
+  /* The idle Loop.  Only CPU0 drives the timer, there is nothing to do
+   * here but to wait for the IPI that brings a task to this CPU: Block on
+   * the host until a signal instead of waking up at each tick.
+   */
 
   for (; ; )
     {
-      /* Wait a bit so that the timing is close to the correct rate. */
-
-      now += 1000 * CONFIG_USEC_PER_TICK;
-      host_sleepuntil(now);
+      pause();
     }
 
   return NULL;
@@ -262,3 +266,28 @@ void sim_send_ipi(int cpu)
 {
   pthread_kill(g_cpu_thread[cpu], SIGUSR1);
 }
+
+/****************************************************************************
+ * Name: sim_cpu_relax
+ *
+ * Description:
+ *   Pause the host CPU for a short wait, then yield it, since the thread
+ *   that holds the spinlock may not be running.
+ *
+ ****************************************************************************/
+
+void sim_cpu_relax(void)
+{
+  if ((++g_cpu_spins & 63) != 0)
+    {
+#if defined(__i386__) || defined(__x86_64__)
+      __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+      __asm__ __volatile__("yield");
+#endif
+    }
+  else
+    {
+      sched_yield();
+    }
+}
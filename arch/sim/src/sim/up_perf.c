@@ -0,0 +1,57 @@
+/****************************************************************************
+ * arch/sim/src/sim/up_perf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+
+#include "up_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* The performance counter of the simulation counts the nanoseconds of the
+ * monotonic clock of the host.
+ */
+
+void up_perf_init(FAR void *arg)
+{
+}
+
+uint32_t up_perf_getfreq(void)
+{
+  return NSEC_PER_SEC;
+}
+
+uint32_t up_perf_gettime(void)
+{
+  return (uint32_t)host_gettime(false);
+}
+
+void up_perf_convert(uint32_t elapsed, FAR struct timespec *ts)
+{
+  ts->tv_sec  = elapsed / NSEC_PER_SEC;
+  ts->tv_nsec = elapsed % NSEC_PER_SEC;
+}
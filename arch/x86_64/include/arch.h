@@ -45,6 +45,16 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* With CONFIG_TLS_REGISTER, the FS base holds the address of the TLS
+ * information of the running thread, i.e. the beginning of its stack
+ * allocation.  It is not part of the saved context, so it is reloaded on
+ * each context switch (see up_restore_auxstate()).
+ */
+
+#ifdef CONFIG_TLS_REGISTER
+#  define up_tls_info() ((FAR struct tls_info_s *)read_fsbase())
+#endif
+
 /****************************************************************************
  * Inline functions
  ****************************************************************************/
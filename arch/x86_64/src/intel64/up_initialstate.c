@@ -77,6 +77,12 @@ void up_initial_state(struct tcb_s *tcb)
       tcb->stack_alloc_ptr = stack_ptr;
       tcb->stack_base_ptr  = stack_ptr;
       tcb->adj_stack_size  = CONFIG_IDLETHREAD_STACKSIZE;
+
+#ifdef CONFIG_TLS_REGISTER
+      /* The IDLE thread is already running, set its FS base directly */
+
+      write_fsbase((uintptr_t)stack_ptr);
+#endif
     }
 
   /* Initialize the initial exception register context structure */
@@ -53,4 +53,12 @@ void up_restore_auxstate(struct tcb_s *rtcb)
   /* Set PCID, avoid TLB flush */
 
   set_pcid(rtcb->pid);
+
+#ifdef CONFIG_TLS_REGISTER
+  /* The FS base is not saved with the context, point it at the TLS
+   * information of the new thread.
+   */
+
+  write_fsbase((uintptr_t)rtcb->stack_alloc_ptr);
+#endif
 }
@@ -32,10 +32,12 @@
 #include <unistd.h>
 #include <string.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mqueue.h>
 #include <nuttx/arch.h>
@@ -63,6 +65,16 @@
 #  define CONFIG_AUDIO_BUFFER_DEQUEUE_PRIO  1
 #endif
 
+/* The size of a buffer of a pool with its header, keeping the alignment */
+
+#define AUDIO_POOL_STRIDE(n) \
+  ((sizeof(struct ap_buffer_s) + (n) + AUDIO_ABP_ALIGNMENT) & \
+   ~AUDIO_ABP_ALIGNMENT)
+
+#define AUDIO_POOL_HDRSIZE \
+  ((sizeof(struct audio_pool_s) + AUDIO_ABP_ALIGNMENT) & \
+   ~AUDIO_ABP_ALIGNMENT)
+
 /****************************************************************************
  * Private Type Definitions
  ****************************************************************************/
@@ -76,6 +88,11 @@ struct audio_upperhalf_s
   sem_t             exclsem;          /* Supports mutual exclusion */
   FAR struct audio_lowerhalf_s *dev;  /* lower-half state */
   struct file      *usermq;           /* User mode app's message queue */
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+  FAR struct audio_pool_s *pool;      /* The buffer pool, if allocated */
+  size_t            poolsize;         /* Size of the pool allocation */
+  FAR struct pollfd *fds[CONFIG_AUDIO_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -93,6 +110,11 @@ static ssize_t  audio_write(FAR struct file *filep,
 static int      audio_ioctl(FAR struct file *filep,
                             int cmd,
                             unsigned long arg);
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+static int      audio_poll(FAR struct file *filep,
+                           FAR struct pollfd *fds,
+                           bool setup);
+#endif
 #ifdef CONFIG_AUDIO_MULTI_SESSION
 static int      audio_start(FAR struct audio_upperhalf_s *upper,
                             FAR void *session);
@@ -121,7 +143,11 @@ static const struct file_operations g_audioops =
   audio_write, /* write */
   NULL,        /* seek */
   audio_ioctl, /* ioctl */
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+  audio_poll   /* poll */
+#else
   NULL         /* poll */
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL       /* unlink */
 #endif
@@ -131,6 +157,214 @@ static const struct file_operations g_audioops =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+/****************************************************************************
+ * Name: audio_allocpool
+ *
+ * Description:
+ *   Handle the AUDIOIOC_ALLOCPOOL ioctl command.  All the buffers are
+ *   allocated in one block of user memory, after the pool header.
+ *
+ ****************************************************************************/
+
+static int audio_allocpool(FAR struct audio_upperhalf_s *upper,
+                           FAR struct audio_pool_desc_s *desc)
+{
+  FAR struct audio_pool_s *pool;
+  FAR struct ap_buffer_s *apb;
+  FAR uint8_t *mem;
+  size_t stride;
+  size_t size;
+  int i;
+
+  DEBUGASSERT(desc != NULL && desc->ppool != NULL);
+
+  if (upper->pool != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (desc->nbuffers == 0 ||
+      desc->nbuffers > CONFIG_AUDIO_POOL_MAXBUFFERS || desc->nbytes == 0)
+    {
+      return -EINVAL;
+    }
+
+  stride = AUDIO_POOL_STRIDE(desc->nbytes);
+  size   = AUDIO_POOL_HDRSIZE + desc->nbuffers * stride;
+
+  mem = kumm_zalloc(size);
+  if (mem == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  pool           = (FAR struct audio_pool_s *)mem;
+  pool->nbuffers = desc->nbuffers;
+  pool->nbytes   = desc->nbytes;
+
+  for (i = 0; i < desc->nbuffers; i++)
+    {
+      apb = (FAR struct ap_buffer_s *)
+            (mem + AUDIO_POOL_HDRSIZE + i * stride);
+
+      /* Like apb_alloc(), but the buffer is never freed on its own */
+
+      apb->i.channels = 1;
+      apb->crefs      = 1;
+      apb->nmaxbytes  = desc->nbytes;
+      apb->flags      = AUDIO_ABP_STATIC;
+      apb->samp       = (FAR uint8_t *)(apb + 1);
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+      apb->session    = desc->session;
+#endif
+      nxsem_init(&apb->sem, 0, 1);
+
+      pool->apb[i] = apb;
+    }
+
+  upper->pool     = pool;
+  upper->poolsize = size;
+  *desc->ppool    = pool;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: audio_freepool
+ ****************************************************************************/
+
+static void audio_freepool(FAR struct audio_upperhalf_s *upper)
+{
+  FAR struct audio_pool_s *pool = upper->pool;
+  irqstate_t flags;
+  int i;
+
+  if (pool != NULL)
+    {
+      flags = enter_critical_section();
+      upper->pool = NULL;
+      leave_critical_section(flags);
+
+      for (i = 0; i < pool->nbuffers; i++)
+        {
+          nxsem_destroy(&pool->apb[i]->sem);
+        }
+
+      kumm_free(pool);
+    }
+}
+
+/****************************************************************************
+ * Name: audio_pollnotify
+ ****************************************************************************/
+
+static void audio_pollnotify(FAR struct audio_upperhalf_s *upper)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < CONFIG_AUDIO_NPOLLWAITERS; i++)
+    {
+      fds = upper->fds[i];
+      if (fds != NULL && (fds->events & POLLIN) != 0)
+        {
+          fds->revents |= POLLIN;
+          poll_notify(fds);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: audio_pooldone
+ *
+ * Description:
+ *   Put a buffer of the pool in its done ring and wake up the pollers.
+ *   Return false if the buffer is not from the pool.  Called in a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+static bool audio_pooldone(FAR struct audio_upperhalf_s *upper,
+                           FAR struct ap_buffer_s *apb)
+{
+  FAR struct audio_pool_s *pool = upper->pool;
+  uintptr_t start;
+  size_t index;
+
+  if (pool == NULL)
+    {
+      return false;
+    }
+
+  start = (uintptr_t)pool->apb[0];
+  if ((uintptr_t)apb < start ||
+      (uintptr_t)apb >= (uintptr_t)pool + upper->poolsize)
+    {
+      return false;
+    }
+
+  index = ((uintptr_t)apb - start) / AUDIO_POOL_STRIDE(pool->nbytes);
+  DEBUGASSERT(pool->apb[index] == apb);
+
+  pool->done[pool->head % pool->nbuffers] = index;
+  pool->head++;
+
+  audio_pollnotify(upper);
+  return true;
+}
+
+/****************************************************************************
+ * Name: audio_poll
+ *
+ * Description:
+ *   POLLIN is set while buffers of the pool are in the done ring.
+ *
+ ****************************************************************************/
+
+static int audio_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct audio_upperhalf_s *upper = inode->i_private;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  flags = enter_critical_section();
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_AUDIO_NPOLLWAITERS; i++)
+        {
+          if (upper->fds[i] == NULL)
+            {
+              upper->fds[i] = fds;
+              fds->priv     = &upper->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_AUDIO_NPOLLWAITERS)
+        {
+          ret = -EBUSY;
+        }
+      else if (upper->pool != NULL &&
+               upper->pool->head != upper->pool->tail)
+        {
+          audio_pollnotify(upper);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      *(FAR struct pollfd **)fds->priv = NULL;
+      fds->priv = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: audio_open
  *
@@ -229,6 +463,10 @@ static int audio_close(FAR struct file *filep)
 
       lower->ops->shutdown(lower);
       upper->usermq = NULL;
+
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+      audio_freepool(upper);
+#endif
     }
 
   ret = OK;
@@ -568,6 +806,43 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+      /* AUDIOIOC_ALLOCPOOL - Allocate the buffers of a stream at once
+       *
+       *   ioctl argument:  pointer to an audio_pool_desc_s structure
+       */
+
+      case AUDIOIOC_ALLOCPOOL:
+        {
+          audinfo("AUDIOIOC_ALLOCPOOL\n");
+
+          ret = audio_allocpool(upper,
+                                (FAR struct audio_pool_desc_s *)arg);
+        }
+        break;
+
+      /* AUDIOIOC_FREEPOOL - Free the pool, while the stream is stopped
+       *
+       *   ioctl argument:  none
+       */
+
+      case AUDIOIOC_FREEPOOL:
+        {
+          audinfo("AUDIOIOC_FREEPOOL\n");
+
+          if (upper->started)
+            {
+              ret = -EBUSY;
+            }
+          else
+            {
+              audio_freepool(upper);
+              ret = OK;
+            }
+        }
+        break;
+#endif
+
       /* AUDIOIOC_ENQUEUEBUFFER - Enqueue an audio buffer
        *
        *   ioctl argument:  pointer to an audio_buf_desc_s structure
@@ -710,9 +985,27 @@ static inline void audio_dequeuebuffer(FAR struct audio_upperhalf_s *upper,
 #endif
 {
   struct audio_msg_s    msg;
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+  irqstate_t flags;
+  bool done;
+#endif
 
   audinfo("Entry\n");
 
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+  /* The buffers of the pool go back through its ring, without a message */
+
+  flags = enter_critical_section();
+  done  = audio_pooldone(upper, apb);
+  leave_critical_section(flags);
+
+  if (done)
+    {
+      apb->flags |= AUDIO_APB_DEQUEUED;
+      return;
+    }
+#endif
+
   /* Send a dequeue message to the user if a message queue is registered */
 
   if (upper->usermq != NULL)
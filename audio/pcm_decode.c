@@ -36,6 +36,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/audio/audio.h>
+#include <nuttx/audio/audio_dsp.h>
 #include <nuttx/audio/pcm.h>
 
 #if defined(CONFIG_AUDIO) && defined(CONFIG_AUDIO_FORMAT_PCM)
@@ -137,6 +138,13 @@ static void pcm_subsample(FAR struct pcm_decode_s *priv,
               FAR struct ap_buffer_s *apb);
 #endif
 
+#ifdef CONFIG_ENDIAN_BIG
+static void pcm_tohost(FAR struct pcm_decode_s *priv,
+                       FAR struct ap_buffer_s *apb);
+#else
+#  define pcm_tohost(p,a)
+#endif
+
 /* struct audio_lowerhalf_s methods *****************************************/
 
 static int  pcm_getcaps(FAR struct audio_lowerhalf_s *dev, int type,
@@ -681,6 +689,28 @@ static void pcm_subsample(FAR struct pcm_decode_s *priv,
 }
 #endif
 
+/****************************************************************************
+ * Name: pcm_tohost
+ *
+ * Description:
+ *   The samples of WAV files are little endian.  Give them to the lower
+ *   half in the host byte order, as it expects.  The buffers hold whole
+ *   samples.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ENDIAN_BIG
+static void pcm_tohost(FAR struct pcm_decode_s *priv,
+                       FAR struct ap_buffer_s *apb)
+{
+  if (priv->bpsamp == 16)
+    {
+      audio_dsp_swap16(&apb->samp[apb->curbyte],
+                       (apb->nbytes - apb->curbyte) / 2);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: pcm_getcaps
  *
@@ -1081,6 +1111,8 @@ static int pcm_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
       pcm_subsample(priv, apb);
 #endif
 
+      pcm_tohost(priv, apb);
+
       /* Then give the audio buffer to the lower driver */
 
       audinfo("Pass to lower enqueuebuffer: apb=%p curbyte=%d nbytes=%d\n",
@@ -1144,6 +1176,8 @@ static int pcm_enqueuebuffer(FAR struct audio_lowerhalf_s *dev,
       pcm_subsample(priv, apb);
 #endif
 
+      pcm_tohost(priv, apb);
+
       /* Then give the audio buffer to the lower driver */
 
       audinfo(
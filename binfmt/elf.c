@@ -74,7 +74,7 @@ static int elf_loadbinary(FAR struct binary_s *binp,
                           int nexports);
 #ifdef CONFIG_ELF_COREDUMP
 static int elf_dumpbinary(FAR struct memory_region_s *regions,
-                          FAR struct lib_outstream_s *stream);
+                          FAR struct lib_outstream_s *stream, pid_t pid);
 #endif
 #if defined(CONFIG_DEBUG_FEATURES) && defined(CONFIG_DEBUG_BINFMT)
 static void elf_dumploadinfo(FAR struct elf_loadinfo_s *loadinfo);
@@ -88,7 +88,11 @@ static struct binfmt_s g_elfbinfmt =
 {
   NULL,             /* next */
   elf_loadbinary,   /* load */
+#ifdef CONFIG_ELF_CACHE
+  elf_cache_release, /* unload */
+#else
   NULL,             /* unload */
+#endif
 #ifdef CONFIG_ELF_COREDUMP
   elf_dumpbinary,   /* coredump */
 #endif
@@ -227,6 +231,15 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 
   binfo("Loading file: %s\n", filename);
 
+#ifdef CONFIG_ELF_CACHE
+  /* A program launched again runs from its cached image */
+
+  if (elf_cache_load(binp, filename, exports, nexports) >= 0)
+    {
+      return OK;
+    }
+#endif
+
   /* Initialize the ELF library to load the program binary. */
 
   ret = elf_init(filename, &loadinfo);
@@ -258,7 +271,7 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 
   /* Return the load information */
 
-  binp->entrypt   = (main_t)(loadinfo.textalloc + loadinfo.ehdr.e_entry);
+  binp->entrypt   = (main_t)(loadinfo.textstart + loadinfo.ehdr.e_entry);
   binp->stacksize = CONFIG_ELF_STACKSIZE;
 
   /* Add the ELF allocation to the alloc[] only if there is no address
@@ -295,6 +308,11 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 #endif
 
   elf_dumpentrypt(binp, &loadinfo);
+
+#ifdef CONFIG_ELF_CACHE
+  elf_cache_add(binp, filename, exports, nexports, loadinfo.datasize);
+#endif
+
   elf_uninit(&loadinfo);
   return OK;
 
@@ -318,12 +336,13 @@ errout_with_init:
 
 #ifdef CONFIG_ELF_COREDUMP
 static int elf_dumpbinary(FAR struct memory_region_s *regions,
-                          FAR struct lib_outstream_s *stream)
+                          FAR struct lib_outstream_s *stream, pid_t pid)
 {
   struct elf_dumpinfo_s dumpinfo;
 
   dumpinfo.regions = regions;
   dumpinfo.stream  = stream;
+  dumpinfo.pid     = pid;
 
   return elf_coredump(&dumpinfo);
 }
@@ -331,4 +331,48 @@ int elf_addrenv_restore(FAR struct elf_loadinfo_s *loadinfo);
 
 void elf_addrenv_free(FAR struct elf_loadinfo_s *loadinfo);
 
+#ifdef CONFIG_ELF_CACHE
+/****************************************************************************
+ * Name: elf_cache_load
+ *
+ * Description:
+ *   Set up binp to run the cached image of the file, if there is one that
+ *   is up to date, bound to the same symbols and not running already.
+ *   Only the data of the image is restored: The file is not read.
+ *
+ * Returned Value:
+ *   0 (OK) is returned if the cached image is used; a negated errno value
+ *   is returned if the file must be loaded.
+ *
+ ****************************************************************************/
+
+int elf_cache_load(FAR struct binary_s *binp, FAR const char *filename,
+                   FAR const struct symtab_s *exports, int nexports);
+
+/****************************************************************************
+ * Name: elf_cache_add
+ *
+ * Description:
+ *   Keep the image just loaded into binp for the next launches of the
+ *   file.  On success, the cache takes the ownership of the text and data
+ *   allocations of binp.  Nothing is done if no entry is available.
+ *
+ ****************************************************************************/
+
+void elf_cache_add(FAR struct binary_s *binp, FAR const char *filename,
+                   FAR const struct symtab_s *exports, int nexports,
+                   size_t datasize);
+
+/****************************************************************************
+ * Name: elf_cache_release
+ *
+ * Description:
+ *   The unload method of the ELF programs: Allow the cached image of binp,
+ *   if any, to be launched again.
+ *
+ ****************************************************************************/
+
+int elf_cache_release(FAR struct binary_s *binp);
+#endif
+
 #endif /* __BINFMT_LIBELF_LIBELF_H */
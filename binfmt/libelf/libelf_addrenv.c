@@ -122,18 +122,21 @@ int elf_addrenv_alloc(FAR struct elf_loadinfo_s *loadinfo, size_t textsize,
 #else
   /* Allocate memory to hold the ELF image */
 
+  if (textsize > 0)
+    {
 #if defined(CONFIG_ARCH_USE_TEXT_HEAP)
-  loadinfo->textalloc = (uintptr_t)
-                         up_textheap_memalign(loadinfo->textalign,
-                                              textsize);
+      loadinfo->textalloc = (uintptr_t)
+                             up_textheap_memalign(loadinfo->textalign,
+                                                  textsize);
 #else
-  loadinfo->textalloc = (uintptr_t)kumm_memalign(loadinfo->textalign,
-                                                 textsize);
+      loadinfo->textalloc = (uintptr_t)kumm_memalign(loadinfo->textalign,
+                                                     textsize);
 #endif
 
-  if (!loadinfo->textalloc)
-    {
-      return -ENOMEM;
+      if (!loadinfo->textalloc)
+        {
+          return -ENOMEM;
+        }
     }
 
   if (loadinfo->datasize > 0)
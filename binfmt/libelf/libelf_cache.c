@@ -0,0 +1,317 @@
+/****************************************************************************
+ * binfmt/libelf/libelf_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/binfmt/binfmt.h>
+
+#include "libelf.h"
+
+#ifdef CONFIG_ELF_CACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A relocated program kept after it exits.  Its memory stays at the same
+ * addresses, since the relocations of the text refer to them, and so the
+ * image runs one instance at a time: The launches while it is busy load
+ * another copy of the file as usual.
+ */
+
+struct elf_cache_s
+{
+  FAR char *path;                     /* The file, or NULL if unused */
+  off_t size;                         /* The identity of the file */
+  time_t mtime;
+  ino_t ino;
+  FAR const struct symtab_s *exports; /* The symbols it is bound to */
+  int nexports;
+  main_t entrypt;                     /* The entry point of the image */
+  FAR void *alloc[2];                 /* The text and data allocations */
+  FAR void *pristine;                 /* The relocated data before running */
+  size_t datasize;                    /* The size of the data */
+  uint32_t used;                      /* Time of the last launch, for LRU */
+  bool busy;                          /* An instance is running */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct elf_cache_s g_elf_cache[CONFIG_ELF_CACHE_ENTRIES];
+static mutex_t g_elf_cachelock = NXMUTEX_INITIALIZER;
+static uint32_t g_elf_cachetime;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_cache_free
+ *
+ * Description:
+ *   Free the image of an entry that is not busy.
+ *
+ ****************************************************************************/
+
+static void elf_cache_free(FAR struct elf_cache_s *entry)
+{
+  DEBUGASSERT(!entry->busy);
+
+  if (entry->alloc[0] != NULL)
+    {
+#if defined(CONFIG_ARCH_USE_TEXT_HEAP)
+      up_textheap_free(entry->alloc[0]);
+#else
+      kumm_free(entry->alloc[0]);
+#endif
+    }
+
+  kumm_free(entry->alloc[1]);
+  kmm_free(entry->pristine);
+  kmm_free(entry->path);
+  memset(entry, 0, sizeof(*entry));
+}
+
+/****************************************************************************
+ * Name: elf_cache_find
+ *
+ * Description:
+ *   Find the entry of a file, dropping it if the file changed since it was
+ *   cached and it is not busy.  Called with the cache locked.
+ *
+ ****************************************************************************/
+
+static FAR struct elf_cache_s *
+elf_cache_find(FAR const char *filename, FAR const struct stat *buf,
+               FAR const struct symtab_s *exports, int nexports)
+{
+  FAR struct elf_cache_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_ELF_CACHE_ENTRIES; i++)
+    {
+      entry = &g_elf_cache[i];
+      if (entry->path == NULL || strcmp(entry->path, filename) != 0)
+        {
+          continue;
+        }
+
+      if (entry->size != buf->st_size || entry->mtime != buf->st_mtime ||
+          entry->ino != buf->st_ino || entry->exports != exports ||
+          entry->nexports != nexports)
+        {
+          if (!entry->busy)
+            {
+              binfo("Dropping the stale image of %s\n", filename);
+              elf_cache_free(entry);
+              return NULL;
+            }
+        }
+
+      return entry;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_cache_load
+ ****************************************************************************/
+
+int elf_cache_load(FAR struct binary_s *binp, FAR const char *filename,
+                   FAR const struct symtab_s *exports, int nexports)
+{
+  FAR struct elf_cache_s *entry;
+  struct stat buf;
+  int ret;
+
+  ret = nx_stat(filename, &buf, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nxmutex_lock(&g_elf_cachelock);
+
+  entry = elf_cache_find(filename, &buf, exports, nexports);
+  if (entry == NULL || entry->busy)
+    {
+      nxmutex_unlock(&g_elf_cachelock);
+      return -ENOENT;
+    }
+
+  /* The text is still relocated, only the data needs to be restored */
+
+  if (entry->datasize > 0)
+    {
+      memcpy(entry->alloc[1], entry->pristine, entry->datasize);
+    }
+
+  entry->busy     = true;
+  entry->used     = ++g_elf_cachetime;
+  binp->entrypt   = entry->entrypt;
+  binp->stacksize = CONFIG_ELF_STACKSIZE;
+
+  nxmutex_unlock(&g_elf_cachelock);
+
+  binfo("Running %s from the cache\n", filename);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: elf_cache_add
+ ****************************************************************************/
+
+void elf_cache_add(FAR struct binary_s *binp, FAR const char *filename,
+                   FAR const struct symtab_s *exports, int nexports,
+                   size_t datasize)
+{
+  FAR struct elf_cache_s *entry = NULL;
+  FAR struct elf_cache_s *victim;
+  struct stat buf;
+  int i;
+
+  if (nx_stat(filename, &buf, 1) < 0)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_elf_cachelock);
+
+  /* A busy image of the file is kept, this copy is not cached */
+
+  if (elf_cache_find(filename, &buf, exports, nexports) != NULL)
+    {
+      goto out;
+    }
+
+  /* Use a free entry, or replace the least recently used image */
+
+  for (i = 0; i < CONFIG_ELF_CACHE_ENTRIES; i++)
+    {
+      victim = &g_elf_cache[i];
+      if (victim->path == NULL)
+        {
+          entry = victim;
+          break;
+        }
+
+      if (!victim->busy && (entry == NULL || victim->used < entry->used))
+        {
+          entry = victim;
+        }
+    }
+
+  if (entry == NULL)
+    {
+      goto out;
+    }
+
+  if (entry->path != NULL)
+    {
+      elf_cache_free(entry);
+    }
+
+  entry->path = kmm_malloc(strlen(filename) + 1);
+  if (datasize > 0)
+    {
+      entry->pristine = kmm_malloc(datasize);
+    }
+
+  if (entry->path == NULL || (datasize > 0 && entry->pristine == NULL))
+    {
+      elf_cache_free(entry);
+      goto out;
+    }
+
+  /* Keep a copy of the relocated data before the program runs, and take
+   * the ownership of the memory from binp.
+   */
+
+  strcpy(entry->path, filename);
+  if (datasize > 0)
+    {
+      memcpy(entry->pristine, binp->alloc[1], datasize);
+    }
+
+  entry->size      = buf.st_size;
+  entry->mtime     = buf.st_mtime;
+  entry->ino       = buf.st_ino;
+  entry->exports   = exports;
+  entry->nexports  = nexports;
+  entry->entrypt   = binp->entrypt;
+  entry->alloc[0]  = binp->alloc[0];
+  entry->alloc[1]  = binp->alloc[1];
+  entry->datasize  = datasize;
+  entry->used      = ++g_elf_cachetime;
+  entry->busy      = true;
+
+  binp->alloc[0]   = NULL;
+  binp->alloc[1]   = NULL;
+
+out:
+  nxmutex_unlock(&g_elf_cachelock);
+}
+
+/****************************************************************************
+ * Name: elf_cache_release
+ ****************************************************************************/
+
+int elf_cache_release(FAR struct binary_s *binp)
+{
+  int i;
+
+  nxmutex_lock(&g_elf_cachelock);
+
+  for (i = 0; i < CONFIG_ELF_CACHE_ENTRIES; i++)
+    {
+      if (g_elf_cache[i].busy && g_elf_cache[i].entrypt == binp->entrypt)
+        {
+          g_elf_cache[i].busy = false;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_elf_cachelock);
+  return OK;
+}
+
+#endif /* CONFIG_ELF_CACHE */
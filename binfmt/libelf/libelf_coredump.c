@@ -26,6 +26,7 @@
 
 #include <sys/stat.h>
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -47,6 +48,18 @@
 #define ARRAY_SIZE(x)   (sizeof(x) / sizeof((x)[0]))
 #define ROUNDUP(x, y)   ((x + (y - 1)) / (y)) * (y)
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_COREDUMP_LZF
+/* The compression state is too large for the stack, and the heap may be
+ * what crashed.
+ */
+
+static struct lib_lzfoutstream_s g_lzfstream;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -108,7 +121,7 @@ static int elf_emit_align(FAR struct elf_dumpinfo_s *cinfo)
                         ELF_PAGESIZE) - cinfo->stream->nput;
   unsigned char null[256];
   off_t total = align;
-  off_t ret;
+  off_t ret = 0;
 
   memset(null, 0, sizeof(null));
 
@@ -127,6 +140,188 @@ static int elf_emit_align(FAR struct elf_dumpinfo_s *cinfo)
   return ret < 0 ? ret : align;
 }
 
+/****************************************************************************
+ * Name: elf_iszero
+ *
+ * Description:
+ *   Return true if the memory from start to start + len is all zero
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_COREDUMP_SKIPZERO
+static bool elf_iszero(uintptr_t start, size_t len)
+{
+  FAR const uint8_t *ptr = (FAR const uint8_t *)start;
+  FAR const uint8_t *end = ptr + len;
+
+  while (ptr < end && ((uintptr_t)ptr & (sizeof(uintptr_t) - 1)) != 0)
+    {
+      if (*ptr++ != 0)
+        {
+          return false;
+        }
+    }
+
+  while (ptr + sizeof(uintptr_t) <= end)
+    {
+      if (*(FAR const uintptr_t *)ptr != 0)
+        {
+          return false;
+        }
+
+      ptr += sizeof(uintptr_t);
+    }
+
+  while (ptr < end)
+    {
+      if (*ptr++ != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: elf_next_run
+ *
+ * Description:
+ *   Return the length of the segment that starts at addr in a region that
+ *   ends at end.  With CONFIG_ELF_COREDUMP_SKIPZERO, a segment is a run of
+ *   pages that are either all zero or not, and the zero ones are dumped
+ *   without data.  Otherwise the segment is the rest of the region.
+ *
+ ****************************************************************************/
+
+static size_t elf_next_run(uintptr_t addr, uintptr_t end, FAR bool *zero)
+{
+#ifdef CONFIG_ELF_COREDUMP_SKIPZERO
+  uintptr_t next;
+  uintptr_t run;
+  bool iszero;
+
+  for (run = addr; run < end; run = next)
+    {
+      next = (run | (ELF_PAGESIZE - 1)) + 1;
+      if (next > end || next < run)
+        {
+          next = end;
+        }
+
+      iszero = elf_iszero(run, next - run);
+      if (run == addr)
+        {
+          *zero = iszero;
+        }
+      else if (iszero != *zero)
+        {
+          break;
+        }
+    }
+
+  return run - addr;
+#else
+  *zero = false;
+  return end - addr;
+#endif
+}
+
+/****************************************************************************
+ * Name: elf_dump_task
+ *
+ * Description:
+ *   Return true if the state of the task is in the dump
+ *
+ ****************************************************************************/
+
+static bool elf_dump_task(FAR struct elf_dumpinfo_s *cinfo,
+                          FAR struct tcb_s *tcb)
+{
+  return tcb != NULL && (cinfo->pid < 0 || tcb->pid == cinfo->pid);
+}
+
+/****************************************************************************
+ * Name: elf_get_region
+ *
+ * Description:
+ *   Return the memory region i of the dump: the regions of the caller and
+ *   then the stack of the task, if it is not in them.  NULL is returned
+ *   after the last one.
+ *
+ ****************************************************************************/
+
+static FAR const struct memory_region_s *
+elf_get_region(FAR struct elf_dumpinfo_s *cinfo,
+               FAR const struct memory_region_s *stack, int i)
+{
+  int nregions = 0;
+
+  if (cinfo->regions)
+    {
+      for (; cinfo->regions[nregions].start <
+             cinfo->regions[nregions].end; nregions++);
+    }
+
+  if (i < nregions)
+    {
+      return &cinfo->regions[i];
+    }
+
+  if (i == nregions && stack->start < stack->end)
+    {
+      return stack;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: elf_get_stack
+ *
+ * Description:
+ *   Get the stack of the task of the dump, unless it is in the regions of
+ *   the caller already.
+ *
+ ****************************************************************************/
+
+static int elf_get_stack(FAR struct elf_dumpinfo_s *cinfo,
+                         FAR struct memory_region_s *stack)
+{
+  FAR const struct memory_region_s *region;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  memset(stack, 0, sizeof(*stack));
+
+  if (cinfo->pid < 0)
+    {
+      return OK;
+    }
+
+  tcb = nxsched_get_tcb(cinfo->pid);
+  if (tcb == NULL)
+    {
+      return -ESRCH;
+    }
+
+  for (i = 0; (region = elf_get_region(cinfo, stack, i)) != NULL; i++)
+    {
+      if ((uintptr_t)tcb->stack_base_ptr >= region->start &&
+          (uintptr_t)tcb->stack_base_ptr + tcb->adj_stack_size <=
+          region->end)
+        {
+          return OK;
+        }
+    }
+
+  stack->start = (uintptr_t)tcb->stack_base_ptr;
+  stack->end   = stack->start + tcb->adj_stack_size;
+  stack->flags = PF_R | PF_W;
+  return OK;
+}
+
 /****************************************************************************
  * Name: elf_emit_header
  *
@@ -168,7 +363,7 @@ static int elf_emit_header(FAR struct elf_dumpinfo_s *cinfo,
  *
  ****************************************************************************/
 
-static int elf_get_note_size(void)
+static int elf_get_note_size(FAR struct elf_dumpinfo_s *cinfo)
 {
   int count = 0;
   int total;
@@ -176,7 +371,7 @@ static int elf_get_note_size(void)
 
   for (i = 0; i < g_npidhash; i++)
     {
-      if (g_pidhash[i])
+      if (elf_dump_task(cinfo, g_pidhash[i]))
         {
           count++;
         }
@@ -212,7 +407,7 @@ static void elf_emit_note_info(FAR struct elf_dumpinfo_s *cinfo)
 
   for (i = 0; i < g_npidhash; i++)
     {
-      if (g_pidhash[i] == NULL)
+      if (!elf_dump_task(cinfo, g_pidhash[i]))
         {
           continue;
         }
@@ -263,35 +458,48 @@ static void elf_emit_note_info(FAR struct elf_dumpinfo_s *cinfo)
  ****************************************************************************/
 
 static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
+                                    FAR const struct memory_region_s *stack,
                                     int segs)
 {
   off_t offset = cinfo->stream->nput + (segs + 1) * sizeof(Elf_Phdr);
+  FAR const struct memory_region_s *region;
+  uintptr_t addr;
   Elf_Phdr phdr;
+  size_t len;
+  bool zero;
   int i;
 
   memset(&phdr, 0, sizeof(Elf_Phdr));
 
   phdr.p_type   = PT_NOTE;
   phdr.p_offset = offset;
-  phdr.p_filesz = elf_get_note_size();
+  phdr.p_filesz = elf_get_note_size(cinfo);
   offset       += phdr.p_filesz;
 
   elf_emit(cinfo, &phdr, sizeof(phdr));
 
   /* Write program headers for segments dump */
 
-  for (i = 0; i < segs; i++)
+  for (i = 0; (region = elf_get_region(cinfo, stack, i)) != NULL; i++)
     {
-      phdr.p_type   = PT_LOAD;
-      phdr.p_offset = ROUNDUP(offset, ELF_PAGESIZE);
-      phdr.p_vaddr  = cinfo->regions[i].start;
-      phdr.p_paddr  = cinfo->regions[i].start;
-      phdr.p_filesz = cinfo->regions[i].end - cinfo->regions[i].start;
-      phdr.p_memsz  = phdr.p_filesz;
-      phdr.p_flags  = cinfo->regions[i].flags;
-      phdr.p_align  = ELF_PAGESIZE;
-      offset       += ROUNDUP(phdr.p_memsz, ELF_PAGESIZE);
-      elf_emit(cinfo, &phdr, sizeof(phdr));
+      for (addr = region->start; addr < region->end; addr += len)
+        {
+          /* The zero segments have no data in the file, the loaders fill
+           * the memory size beyond the file size with zeros.
+           */
+
+          len           = elf_next_run(addr, region->end, &zero);
+          phdr.p_type   = PT_LOAD;
+          phdr.p_offset = ROUNDUP(offset, ELF_PAGESIZE);
+          phdr.p_vaddr  = addr;
+          phdr.p_paddr  = addr;
+          phdr.p_filesz = zero ? 0 : len;
+          phdr.p_memsz  = len;
+          phdr.p_flags  = region->flags;
+          phdr.p_align  = ELF_PAGESIZE;
+          offset       += ROUNDUP(phdr.p_filesz, ELF_PAGESIZE);
+          elf_emit(cinfo, &phdr, sizeof(phdr));
+        }
     }
 }
 
@@ -315,15 +523,30 @@ static void elf_emit_program_header(FAR struct elf_dumpinfo_s *cinfo,
 
 int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
 {
+  FAR const struct memory_region_s *region;
+  struct memory_region_s stack;
+  uintptr_t addr;
+  size_t len;
+  bool zero;
   int segs = 0;
+  int ret;
   int i;
 
   /* Check the memory region */
 
-  if (cinfo->regions)
+  ret = elf_get_stack(cinfo, &stack);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; (region = elf_get_region(cinfo, &stack, i)) != NULL; i++)
     {
-      for (; cinfo->regions[segs].start <
-             cinfo->regions[segs].end; segs++);
+      for (addr = region->start; addr < region->end; addr += len)
+        {
+          len = elf_next_run(addr, region->end, &zero);
+          segs++;
+        }
     }
 
   if (segs == 0)
@@ -331,6 +554,13 @@ int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
       return -EINVAL;
     }
 
+#ifdef CONFIG_ELF_COREDUMP_LZF
+  /* Compress the dump on its way to the stream */
+
+  lib_lzfoutstream(&g_lzfstream, cinfo->stream);
+  cinfo->stream = &g_lzfstream.public;
+#endif
+
   /* Fill notes section */
 
   elf_emit_header(cinfo, segs + 1);
@@ -339,7 +569,7 @@ int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
    * notes.  This also sets up the file header.
    */
 
-  elf_emit_program_header(cinfo, segs);
+  elf_emit_program_header(cinfo, &stack, segs);
 
   /* Fill note information */
 
@@ -349,17 +579,22 @@ int elf_coredump(FAR struct elf_dumpinfo_s *cinfo)
 
   elf_emit_align(cinfo);
 
-  /* Start dump the memory */
+  /* Start dump the memory, but for the zero segments */
 
-  for (i = 0; i < segs; i++)
+  for (i = 0; (region = elf_get_region(cinfo, &stack, i)) != NULL; i++)
     {
-      elf_emit(cinfo, (FAR void *)cinfo->regions[i].start,
-               cinfo->regions[i].end -
-               cinfo->regions[i].start);
+      for (addr = region->start; addr < region->end; addr += len)
+        {
+          len = elf_next_run(addr, region->end, &zero);
+          if (!zero)
+            {
+              elf_emit(cinfo, (FAR void *)addr, len);
 
-      /* Align to page */
+              /* Align to page */
 
-      elf_emit_align(cinfo);
+              elf_emit_align(cinfo);
+            }
+        }
     }
 
   /* Flush the dump */
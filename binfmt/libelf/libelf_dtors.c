@@ -181,10 +181,10 @@ int elf_loaddtors(FAR struct elf_loadinfo_s *loadinfo)
 
               binfo("dtor %d: "
                     "%08" PRIxPTR " + %08" PRIxPTR " = %08" PRIxPTR "\n",
-                    i, *ptr, (uintptr_t)loadinfo->textalloc,
-                    (uintptr_t)(*ptr + loadinfo->textalloc));
+                    i, *ptr, (uintptr_t)loadinfo->textstart,
+                    (uintptr_t)(*ptr + loadinfo->textstart));
 
-              *ptr += loadinfo->textalloc;
+              *ptr += loadinfo->textstart;
             }
         }
       else
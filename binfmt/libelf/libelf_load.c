@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -38,6 +39,8 @@
 #include <nuttx/addrenv.h>
 #include <nuttx/elf.h>
 #include <nuttx/binfmt/elf.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 
 #include "libelf.h"
 
@@ -69,6 +72,49 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: elf_xipsection
+ *
+ * Description:
+ *   Return true if the section can be used in place in the memory mapped
+ *   file: It is read-only, aligned in the file and relocated by no
+ *   relocation section, since the relocations cannot be written there.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_XIP
+static bool elf_xipsection(FAR struct elf_loadinfo_s *loadinfo, int index)
+{
+  FAR Elf_Shdr *shdr = &loadinfo->shdr[index];
+  int i;
+
+  if (loadinfo->xipbase == 0 || shdr->sh_type == SHT_NOBITS ||
+      (shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) != SHF_ALLOC)
+    {
+      return false;
+    }
+
+  if (shdr->sh_addralign > 1 &&
+      ((loadinfo->xipbase + shdr->sh_offset) &
+       (shdr->sh_addralign - 1)) != 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      if ((loadinfo->shdr[i].sh_type == SHT_REL ||
+           loadinfo->shdr[i].sh_type == SHT_RELA) &&
+          loadinfo->shdr[i].sh_info == index)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: elf_elfsize
  *
@@ -100,6 +146,15 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
        * execution.
        */
 
+#ifdef CONFIG_ELF_XIP
+      /* The sections used in place need no memory */
+
+      if (elf_xipsection(loadinfo, i))
+        {
+          continue;
+        }
+#endif
+
       if ((shdr->sh_flags & SHF_ALLOC) != 0)
         {
           /* SHF_WRITE indicates that the section address space is write-
@@ -173,6 +228,21 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
           continue;
         }
 
+#ifdef CONFIG_ELF_XIP
+      if (elf_xipsection(loadinfo, i))
+        {
+          shdr->sh_addr = loadinfo->xipbase + shdr->sh_offset;
+          binfo("%d. XIP at %08lx\n", i, (unsigned long)shdr->sh_addr);
+
+          if (loadinfo->textstart == 0)
+            {
+              loadinfo->textstart = shdr->sh_addr;
+            }
+
+          continue;
+        }
+#endif
+
       /* SHF_WRITE indicates that the section address space is write-
        * able
        */
@@ -188,6 +258,13 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
 
       *pptr = (FAR uint8_t *)_ALIGN_UP((uintptr_t)*pptr, shdr->sh_addralign);
 
+      /* The entry point is relative to the first .text section */
+
+      if (pptr == &text && loadinfo->textstart == 0)
+        {
+          loadinfo->textstart = (uintptr_t)*pptr;
+        }
+
       /* SHT_NOBITS indicates that there is no data in the file for the
        * section.
        */
@@ -265,6 +342,18 @@ int elf_load(FAR struct elf_loadinfo_s *loadinfo)
       goto errout_with_buffers;
     }
 
+#ifdef CONFIG_ELF_XIP
+  /* The read-only sections are used in place if the file is mapped in
+   * memory, as the files of a romfs in flash are.
+   */
+
+  if (file_ioctl(&loadinfo->file, FIOC_MMAP,
+                 (unsigned long)((uintptr_t)&loadinfo->xipbase)) < 0)
+    {
+      loadinfo->xipbase = 0;
+    }
+#endif
+
   /* Determine total size to allocate */
 
   elf_elfsize(loadinfo);
@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/userspace.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/mm/mm.h>
@@ -107,6 +108,12 @@ const struct userspace_s userspace locate_data(".userspace") =
 #ifdef CONFIG_LIBC_USRWORK
   .work_usrstart    = work_usrstart,
 #endif
+
+  /* Time data for clock_gettime() (declared in include/nuttx/clock.h) */
+
+#ifdef CONFIG_CLOCK_VDATA
+  .us_clockvdata    = &g_clock_vdata,
+#endif
 };
 
 /****************************************************************************
@@ -771,7 +771,7 @@ int boardctl(unsigned int cmd, uintptr_t arg)
             }
           else
             {
-              ret = up_testset(lock) == SP_LOCKED ? 1 : 0;
+              ret = up_testset(lock) != SP_UNLOCKED ? 1 : 0;
             }
         }
         break;
@@ -41,9 +41,74 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 
+#include <nuttx/compiler.h>
+#include <nuttx/mutex.h>
 #include <nuttx/crypto/aes.h>
+#include <nuttx/crypto/crypto.h>
+
+#if defined(CONFIG_CRYPTO_SW_AES_ISA) && !defined(CONFIG_ENDIAN_BIG)
+#  if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+#    include <arm_neon.h>
+#    define AES_ARMV8 1
+#  elif defined(__AES__) && defined(__SSE2__)
+#    include <wmmintrin.h>
+#    define AES_NI 1
+#  endif
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define AES_BLOCK_SIZE 16
+
+/* The columns of the state and of the round keys are 32 bit words with the
+ * byte of row 0 in the least significant bits, so that on little endian
+ * CPUs they have the memory layout of the AES instructions.
+ */
+
+#define AES_GETU32(p) \
+  ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+   ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+#define AES_PUTU32(p, v) \
+  do \
+    { \
+      (p)[0] = (uint8_t)(v); \
+      (p)[1] = (uint8_t)((v) >> 8); \
+      (p)[2] = (uint8_t)((v) >> 16); \
+      (p)[3] = (uint8_t)((v) >> 24); \
+    } \
+  while (0)
+
+#define AES_ROTL8(x)  (((x) << 8) | ((x) >> 24))
+#define AES_ROTL16(x) (((x) << 16) | ((x) >> 16))
+#define AES_ROTL24(x) (((x) << 24) | ((x) >> 8))
+
+#define AES_SUBWORD(w) \
+  ((uint32_t)g_sbox[(w) & 0xff] | \
+   ((uint32_t)g_sbox[((w) >> 8) & 0xff] << 8) | \
+   ((uint32_t)g_sbox[((w) >> 16) & 0xff] << 16) | \
+   ((uint32_t)g_sbox[(w) >> 24] << 24))
+
+/* One column of a round: the table of row 0, rotated for the other rows,
+ * indexed by the low byte of each argument.
+ */
+
+#define AES_TABLE(t, a, b, c, d) \
+  ((t)[(a) & 0xff] ^ AES_ROTL8((t)[(b) & 0xff]) ^ \
+   AES_ROTL16((t)[(c) & 0xff]) ^ AES_ROTL24((t)[(d) & 0xff]))
+
+/* One column of the last round, without (Inv)MixColumns */
+
+#define AES_FINAL(box, a, b, c, d) \
+  ((uint32_t)(box)[(a) & 0xff] | \
+   ((uint32_t)(box)[((b) >> 8) & 0xff] << 8) | \
+   ((uint32_t)(box)[((c) >> 16) & 0xff] << 16) | \
+   ((uint32_t)(box)[(d) >> 24] << 24))
 
 /****************************************************************************
  * Private Data
@@ -93,6 +158,7 @@ static const uint8_t g_sbox[256] =
 
 /* Inverse sbox */
 
+#if !defined(AES_ARMV8) && !defined(AES_NI)
 static const uint8_t g_rsbox[256] =
 {
   0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40,
@@ -129,6 +195,8 @@ static const uint8_t g_rsbox[256] =
                           0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
 };
 
+#endif
+
 /* Round constant */
 
 static const uint8_t g_rcon[11] =
@@ -136,572 +204,517 @@ static const uint8_t g_rcon[11] =
   0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
+#if !defined(AES_ARMV8) && !defined(AES_NI)
+/* Forward table: the MixColumns of a SubBytes, row 0 of a column */
+
+static const uint32_t g_te[256] =
+{
+  0xa56363c6, 0x847c7cf8, 0x997777ee, 0x8d7b7bf6,
+  0x0df2f2ff, 0xbd6b6bd6, 0xb16f6fde, 0x54c5c591,
+  0x50303060, 0x03010102, 0xa96767ce, 0x7d2b2b56,
+  0x19fefee7, 0x62d7d7b5, 0xe6abab4d, 0x9a7676ec,
+  0x45caca8f, 0x9d82821f, 0x40c9c989, 0x877d7dfa,
+  0x15fafaef, 0xeb5959b2, 0xc947478e, 0x0bf0f0fb,
+  0xecadad41, 0x67d4d4b3, 0xfda2a25f, 0xeaafaf45,
+  0xbf9c9c23, 0xf7a4a453, 0x967272e4, 0x5bc0c09b,
+  0xc2b7b775, 0x1cfdfde1, 0xae93933d, 0x6a26264c,
+  0x5a36366c, 0x413f3f7e, 0x02f7f7f5, 0x4fcccc83,
+  0x5c343468, 0xf4a5a551, 0x34e5e5d1, 0x08f1f1f9,
+  0x937171e2, 0x73d8d8ab, 0x53313162, 0x3f15152a,
+  0x0c040408, 0x52c7c795, 0x65232346, 0x5ec3c39d,
+  0x28181830, 0xa1969637, 0x0f05050a, 0xb59a9a2f,
+  0x0907070e, 0x36121224, 0x9b80801b, 0x3de2e2df,
+  0x26ebebcd, 0x6927274e, 0xcdb2b27f, 0x9f7575ea,
+  0x1b090912, 0x9e83831d, 0x742c2c58, 0x2e1a1a34,
+  0x2d1b1b36, 0xb26e6edc, 0xee5a5ab4, 0xfba0a05b,
+  0xf65252a4, 0x4d3b3b76, 0x61d6d6b7, 0xceb3b37d,
+  0x7b292952, 0x3ee3e3dd, 0x712f2f5e, 0x97848413,
+  0xf55353a6, 0x68d1d1b9, 0x00000000, 0x2cededc1,
+  0x60202040, 0x1ffcfce3, 0xc8b1b179, 0xed5b5bb6,
+  0xbe6a6ad4, 0x46cbcb8d, 0xd9bebe67, 0x4b393972,
+  0xde4a4a94, 0xd44c4c98, 0xe85858b0, 0x4acfcf85,
+  0x6bd0d0bb, 0x2aefefc5, 0xe5aaaa4f, 0x16fbfbed,
+  0xc5434386, 0xd74d4d9a, 0x55333366, 0x94858511,
+  0xcf45458a, 0x10f9f9e9, 0x06020204, 0x817f7ffe,
+  0xf05050a0, 0x443c3c78, 0xba9f9f25, 0xe3a8a84b,
+  0xf35151a2, 0xfea3a35d, 0xc0404080, 0x8a8f8f05,
+  0xad92923f, 0xbc9d9d21, 0x48383870, 0x04f5f5f1,
+  0xdfbcbc63, 0xc1b6b677, 0x75dadaaf, 0x63212142,
+  0x30101020, 0x1affffe5, 0x0ef3f3fd, 0x6dd2d2bf,
+  0x4ccdcd81, 0x140c0c18, 0x35131326, 0x2fececc3,
+  0xe15f5fbe, 0xa2979735, 0xcc444488, 0x3917172e,
+  0x57c4c493, 0xf2a7a755, 0x827e7efc, 0x473d3d7a,
+  0xac6464c8, 0xe75d5dba, 0x2b191932, 0x957373e6,
+  0xa06060c0, 0x98818119, 0xd14f4f9e, 0x7fdcdca3,
+  0x66222244, 0x7e2a2a54, 0xab90903b, 0x8388880b,
+  0xca46468c, 0x29eeeec7, 0xd3b8b86b, 0x3c141428,
+  0x79dedea7, 0xe25e5ebc, 0x1d0b0b16, 0x76dbdbad,
+  0x3be0e0db, 0x56323264, 0x4e3a3a74, 0x1e0a0a14,
+  0xdb494992, 0x0a06060c, 0x6c242448, 0xe45c5cb8,
+  0x5dc2c29f, 0x6ed3d3bd, 0xefacac43, 0xa66262c4,
+  0xa8919139, 0xa4959531, 0x37e4e4d3, 0x8b7979f2,
+  0x32e7e7d5, 0x43c8c88b, 0x5937376e, 0xb76d6dda,
+  0x8c8d8d01, 0x64d5d5b1, 0xd24e4e9c, 0xe0a9a949,
+  0xb46c6cd8, 0xfa5656ac, 0x07f4f4f3, 0x25eaeacf,
+  0xaf6565ca, 0x8e7a7af4, 0xe9aeae47, 0x18080810,
+  0xd5baba6f, 0x887878f0, 0x6f25254a, 0x722e2e5c,
+  0x241c1c38, 0xf1a6a657, 0xc7b4b473, 0x51c6c697,
+  0x23e8e8cb, 0x7cdddda1, 0x9c7474e8, 0x211f1f3e,
+  0xdd4b4b96, 0xdcbdbd61, 0x868b8b0d, 0x858a8a0f,
+  0x907070e0, 0x423e3e7c, 0xc4b5b571, 0xaa6666cc,
+  0xd8484890, 0x05030306, 0x01f6f6f7, 0x120e0e1c,
+  0xa36161c2, 0x5f35356a, 0xf95757ae, 0xd0b9b969,
+  0x91868617, 0x58c1c199, 0x271d1d3a, 0xb99e9e27,
+  0x38e1e1d9, 0x13f8f8eb, 0xb398982b, 0x33111122,
+  0xbb6969d2, 0x70d9d9a9, 0x898e8e07, 0xa7949433,
+  0xb69b9b2d, 0x221e1e3c, 0x92878715, 0x20e9e9c9,
+  0x49cece87, 0xff5555aa, 0x78282850, 0x7adfdfa5,
+  0x8f8c8c03, 0xf8a1a159, 0x80898909, 0x170d0d1a,
+  0xdabfbf65, 0x31e6e6d7, 0xc6424284, 0xb86868d0,
+  0xc3414182, 0xb0999929, 0x772d2d5a, 0x110f0f1e,
+  0xcbb0b07b, 0xfc5454a8, 0xd6bbbb6d, 0x3a16162c
+};
+
+#endif
+
+/* Inverse table: the InvMixColumns of an InvSubBytes, row 0 of a column */
+
+static const uint32_t g_td[256] =
+{
+  0x50a7f451, 0x5365417e, 0xc3a4171a, 0x965e273a,
+  0xcb6bab3b, 0xf1459d1f, 0xab58faac, 0x9303e34b,
+  0x55fa3020, 0xf66d76ad, 0x9176cc88, 0x254c02f5,
+  0xfcd7e54f, 0xd7cb2ac5, 0x80443526, 0x8fa362b5,
+  0x495ab1de, 0x671bba25, 0x980eea45, 0xe1c0fe5d,
+  0x02752fc3, 0x12f04c81, 0xa397468d, 0xc6f9d36b,
+  0xe75f8f03, 0x959c9215, 0xeb7a6dbf, 0xda595295,
+  0x2d83bed4, 0xd3217458, 0x2969e049, 0x44c8c98e,
+  0x6a89c275, 0x78798ef4, 0x6b3e5899, 0xdd71b927,
+  0xb64fe1be, 0x17ad88f0, 0x66ac20c9, 0xb43ace7d,
+  0x184adf63, 0x82311ae5, 0x60335197, 0x457f5362,
+  0xe07764b1, 0x84ae6bbb, 0x1ca081fe, 0x942b08f9,
+  0x58684870, 0x19fd458f, 0x876cde94, 0xb7f87b52,
+  0x23d373ab, 0xe2024b72, 0x578f1fe3, 0x2aab5566,
+  0x0728ebb2, 0x03c2b52f, 0x9a7bc586, 0xa50837d3,
+  0xf2872830, 0xb2a5bf23, 0xba6a0302, 0x5c8216ed,
+  0x2b1ccf8a, 0x92b479a7, 0xf0f207f3, 0xa1e2694e,
+  0xcdf4da65, 0xd5be0506, 0x1f6234d1, 0x8afea6c4,
+  0x9d532e34, 0xa055f3a2, 0x32e18a05, 0x75ebf6a4,
+  0x39ec830b, 0xaaef6040, 0x069f715e, 0x51106ebd,
+  0xf98a213e, 0x3d06dd96, 0xae053edd, 0x46bde64d,
+  0xb58d5491, 0x055dc471, 0x6fd40604, 0xff155060,
+  0x24fb9819, 0x97e9bdd6, 0xcc434089, 0x779ed967,
+  0xbd42e8b0, 0x888b8907, 0x385b19e7, 0xdbeec879,
+  0x470a7ca1, 0xe90f427c, 0xc91e84f8, 0x00000000,
+  0x83868009, 0x48ed2b32, 0xac70111e, 0x4e725a6c,
+  0xfbff0efd, 0x5638850f, 0x1ed5ae3d, 0x27392d36,
+  0x64d90f0a, 0x21a65c68, 0xd1545b9b, 0x3a2e3624,
+  0xb1670a0c, 0x0fe75793, 0xd296eeb4, 0x9e919b1b,
+  0x4fc5c080, 0xa220dc61, 0x694b775a, 0x161a121c,
+  0x0aba93e2, 0xe52aa0c0, 0x43e0223c, 0x1d171b12,
+  0x0b0d090e, 0xadc78bf2, 0xb9a8b62d, 0xc8a91e14,
+  0x8519f157, 0x4c0775af, 0xbbdd99ee, 0xfd607fa3,
+  0x9f2601f7, 0xbcf5725c, 0xc53b6644, 0x347efb5b,
+  0x7629438b, 0xdcc623cb, 0x68fcedb6, 0x63f1e4b8,
+  0xcadc31d7, 0x10856342, 0x40229713, 0x2011c684,
+  0x7d244a85, 0xf83dbbd2, 0x1132f9ae, 0x6da129c7,
+  0x4b2f9e1d, 0xf330b2dc, 0xec52860d, 0xd0e3c177,
+  0x6c16b32b, 0x99b970a9, 0xfa489411, 0x2264e947,
+  0xc48cfca8, 0x1a3ff0a0, 0xd82c7d56, 0xef903322,
+  0xc74e4987, 0xc1d138d9, 0xfea2ca8c, 0x360bd498,
+  0xcf81f5a6, 0x28de7aa5, 0x268eb7da, 0xa4bfad3f,
+  0xe49d3a2c, 0x0d927850, 0x9bcc5f6a, 0x62467e54,
+  0xc2138df6, 0xe8b8d890, 0x5ef7392e, 0xf5afc382,
+  0xbe805d9f, 0x7c93d069, 0xa92dd56f, 0xb31225cf,
+  0x3b99acc8, 0xa77d1810, 0x6e639ce8, 0x7bbb3bdb,
+  0x097826cd, 0xf418596e, 0x01b79aec, 0xa89a4f83,
+  0x656e95e6, 0x7ee6ffaa, 0x08cfbc21, 0xe6e815ef,
+  0xd99be7ba, 0xce366f4a, 0xd4099fea, 0xd67cb029,
+  0xafb2a431, 0x31233f2a, 0x3094a5c6, 0xc066a235,
+  0x37bc4e74, 0xa6ca82fc, 0xb0d090e0, 0x15d8a733,
+  0x4a9804f1, 0xf7daec41, 0x0e50cd7f, 0x2ff69117,
+  0x8dd64d76, 0x4db0ef43, 0x544daacc, 0xdf0496e4,
+  0xe3b5d19e, 0x1b886a4c, 0xb81f2cc1, 0x7f516546,
+  0x04ea5e9d, 0x5d358c01, 0x737487fa, 0x2e410bfb,
+  0x5a1d67b3, 0x52d2db92, 0x335610e9, 0x1347d66d,
+  0x8c61d79a, 0x7a0ca137, 0x8e14f859, 0x893c13eb,
+  0xee27a9ce, 0x35c961b7, 0xede51ce1, 0x3cb1477a,
+  0x59dfd29c, 0x3f73f255, 0x79ce1418, 0xbf37c773,
+  0xeacdf753, 0x5baafd5f, 0x146f3ddf, 0x86db4478,
+  0x81f3afca, 0x3ec468b9, 0x2c342438, 0x5f40a3c2,
+  0x72c31d16, 0x0c25e2bc, 0x8b493c28, 0x41950dff,
+  0x7101a839, 0xdeb30c08, 0x9ce4b4d8, 0x90c15664,
+  0x6184cb7b, 0x70b632d5, 0x745c6c48, 0x4257b8d0
+};
+
 static struct aes_state_s g_aes_state;
 
+#ifdef CONFIG_CRYPTO_AES
+/* The key schedule of aes_cypher(), kept out of the stack because of its
+ * size.  It is wiped once the call is done with it.
+ */
+
+static mutex_t g_aes_lock = NXMUTEX_INITIALIZER;
+static struct aes_state_s g_aes_cypher;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aes_invmixword
+ *
+ * Description:
+ *   Apply InvMixColumns to a column of a round key, for the round keys of
+ *   the equivalent inverse cipher.  g_td holds InvMixColumns(x) for the
+ *   InvSubBytes of the sbox of x, which is x itself.
+ *
+ ****************************************************************************/
+
+static uint32_t aes_invmixword(uint32_t w)
+{
+  return AES_TABLE(g_td, g_sbox[w & 0xff], g_sbox[(w >> 8) & 0xff],
+                   g_sbox[(w >> 16) & 0xff], g_sbox[w >> 24]);
+}
+
 /****************************************************************************
  * Name: expand_key
  *
  * Description:
- *   Expend a 16 bytes key for AES128 implementation
+ *   Expand a 16, 24 or 32 bytes key into the round keys of the cipher and
+ *   of the equivalent inverse cipher.
  *
  * Input Parameters:
- *  key          AES128 key - 16 bytes
- *  expanded_key expanded AES128 key
+ *  state  The AES context to hold the round keys
+ *  key    AES key
+ *  len    Length of the key in bytes
  *
  * Returned Value:
  *  None
  *
  ****************************************************************************/
 
-static void expand_key(FAR uint8_t *expanded_key, FAR const uint8_t *key)
+static void expand_key(FAR struct aes_state_s *state,
+                       FAR const uint8_t *key, int len)
 {
-  uint16_t buf1;
-  uint16_t ii;
+  FAR uint32_t *ek = state->ek;
+  FAR uint32_t *dk = state->dk;
+  uint32_t temp;
+  int nwords;
+  int nk;
+  int nr;
+  int i;
+  int j;
+
+  nk     = len / 4;
+  nr     = nk + 6;
+  nwords = 4 * (nr + 1);
 
-  for (ii = 0; ii < 16; ii++)
+  for (i = 0; i < nk; i++)
     {
-      expanded_key[ii] = key[ii];
+      ek[i] = AES_GETU32(&key[4 * i]);
     }
 
-  for (ii = 1; ii < 11; ii++)
+  for (; i < nwords; i++)
     {
-      buf1 = expanded_key[ii * 16 - 4];
-      expanded_key[ii * 16 + 0] = g_sbox[expanded_key[ii *16 - 3]] ^
-                            expanded_key[(ii - 1) * 16 + 0] ^ g_rcon[ii];
+      temp = ek[i - 1];
+      if (i % nk == 0)
+        {
+          temp = AES_SUBWORD(AES_ROTL24(temp)) ^ g_rcon[i / nk];
+        }
+      else if (nk > 6 && i % nk == 4)
+        {
+          temp = AES_SUBWORD(temp);
+        }
+
+      ek[i] = ek[i - nk] ^ temp;
+    }
 
-      expanded_key[ii * 16 + 1] = g_sbox[expanded_key[ii *16 - 2]] ^
-                            expanded_key[(ii - 1) * 16 + 1];
+  /* The round keys of the inverse cipher are in the reverse order, and
+   * all but the first and the last go through InvMixColumns.
+   */
 
-      expanded_key[ii * 16 + 2] = g_sbox[expanded_key[ii *16 - 1]] ^
-                            expanded_key[(ii - 1) * 16 + 2];
+  for (i = 0; i <= nr; i++)
+    {
+      for (j = 0; j < 4; j++)
+        {
+          temp = ek[4 * (nr - i) + j];
+          dk[4 * i + j] = (i == 0 || i == nr) ? temp : aes_invmixword(temp);
+        }
+    }
 
-      expanded_key[ii * 16 + 3] = g_sbox[buf1] ^
-                            expanded_key[(ii - 1) * 16 + 3];
+  state->nrounds = nr;
+}
 
-      expanded_key[ii * 16 + 4] = expanded_key[(ii - 1) * 16 + 4] ^
-                            expanded_key[ii * 16 + 0];
+#if defined(AES_ARMV8)
+/****************************************************************************
+ * Name: aes_encr
+ *
+ * Description:
+ *  Encrypt one block in place with the ARMv8 Crypto Extensions.  AESE is
+ *  AddRoundKey, SubBytes and ShiftRows; AESMC is MixColumns.
+ *
+ ****************************************************************************/
 
-      expanded_key[ii * 16 + 5] = expanded_key[(ii - 1) * 16 + 5] ^
-                            expanded_key[ii * 16 + 1];
+static void aes_encr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)state->ek;
+  uint8x16_t s = vld1q_u8(block);
+  int round;
 
-      expanded_key[ii * 16 + 6] = expanded_key[(ii - 1) * 16 + 6] ^
-                            expanded_key[ii * 16 + 2];
+  for (round = 0; round < state->nrounds - 1; round++)
+    {
+      s = vaesmcq_u8(vaeseq_u8(s, vld1q_u8(&rk[16 * round])));
+    }
 
-      expanded_key[ii * 16 + 7] = expanded_key[(ii - 1) * 16 + 7] ^
-                            expanded_key[ii * 16 + 3];
+  s = vaeseq_u8(s, vld1q_u8(&rk[16 * round]));
+  s = veorq_u8(s, vld1q_u8(&rk[16 * (round + 1)]));
+  vst1q_u8(block, s);
+}
 
-      expanded_key[ii * 16 + 8] = expanded_key[(ii - 1) * 16 + 8] ^
-                            expanded_key[ii * 16 + 4];
+/****************************************************************************
+ * Name: aes_decr
+ *
+ * Description:
+ *  Decrypt one block in place with the ARMv8 Crypto Extensions.
+ *
+ ****************************************************************************/
 
-      expanded_key[ii * 16 + 9] = expanded_key[(ii - 1) * 16 + 9] ^
-                            expanded_key[ii * 16 + 5];
+static void aes_decr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)state->dk;
+  uint8x16_t s = vld1q_u8(block);
+  int round;
 
-      expanded_key[ii * 16 +10] = expanded_key[(ii - 1) * 16 +10] ^
-                            expanded_key[ii * 16 + 6];
+  for (round = 0; round < state->nrounds - 1; round++)
+    {
+      s = vaesimcq_u8(vaesdq_u8(s, vld1q_u8(&rk[16 * round])));
+    }
 
-      expanded_key[ii * 16 +11] = expanded_key[(ii - 1) * 16 +11] ^
-                            expanded_key[ii * 16 + 7];
+  s = vaesdq_u8(s, vld1q_u8(&rk[16 * round]));
+  s = veorq_u8(s, vld1q_u8(&rk[16 * (round + 1)]));
+  vst1q_u8(block, s);
+}
 
-      expanded_key[ii * 16 +12] = expanded_key[(ii - 1) * 16 +12] ^
-                            expanded_key[ii * 16 + 8];
+#elif defined(AES_NI)
+/****************************************************************************
+ * Name: aes_encr
+ *
+ * Description:
+ *  Encrypt one block in place with the AES-NI instructions.
+ *
+ ****************************************************************************/
 
-      expanded_key[ii * 16 +13] = expanded_key[(ii - 1) * 16 +13] ^
-                            expanded_key[ii * 16 + 9];
+static void aes_encr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
+{
+  FAR const __m128i *rk = (FAR const __m128i *)state->ek;
+  __m128i s;
+  int round;
 
-      expanded_key[ii * 16 +14] = expanded_key[(ii - 1) * 16 +14] ^
-                            expanded_key[ii * 16 +10];
+  s = _mm_xor_si128(_mm_loadu_si128((FAR const __m128i *)block),
+                    _mm_loadu_si128(&rk[0]));
 
-      expanded_key[ii * 16 +15] = expanded_key[(ii - 1) * 16 +15] ^
-                            expanded_key[ii * 16 +11];
+  for (round = 1; round < state->nrounds; round++)
+    {
+      s = _mm_aesenc_si128(s, _mm_loadu_si128(&rk[round]));
     }
+
+  s = _mm_aesenclast_si128(s, _mm_loadu_si128(&rk[round]));
+  _mm_storeu_si128((FAR __m128i *)block, s);
 }
 
 /****************************************************************************
- * Name: galois_mul2
+ * Name: aes_decr
  *
  * Description:
- *    Multiply by 2 in the galois field
- *
- * Input Parameters:
- *  value    argument to multiply
- *
- * Returned Value:
- *  Multiplied argument
+ *  Decrypt one block in place with the AES-NI instructions.
  *
  ****************************************************************************/
 
-static uint8_t galois_mul2(uint8_t value)
+static void aes_decr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
 {
-  if (value >> 7)
-    {
-      value = value << 1;
-      return (value ^ 0x1b);
-    }
-  else
+  FAR const __m128i *rk = (FAR const __m128i *)state->dk;
+  __m128i s;
+  int round;
+
+  s = _mm_xor_si128(_mm_loadu_si128((FAR const __m128i *)block),
+                    _mm_loadu_si128(&rk[0]));
+
+  for (round = 1; round < state->nrounds; round++)
     {
-      return value << 1;
+      s = _mm_aesdec_si128(s, _mm_loadu_si128(&rk[round]));
     }
+
+  s = _mm_aesdeclast_si128(s, _mm_loadu_si128(&rk[round]));
+  _mm_storeu_si128((FAR __m128i *)block, s);
 }
 
+#else
 /****************************************************************************
  * Name: aes_encr
  *
  * Description:
- *  Internal implementation of AES128 encryption.
- *  Straight forward aes encryption implementation. First the group of
- *  operations:
- *
- *    - addRoundKey
- *    - subbytes
- *    - shiftrows
- *    - mixcolums
- *
- *  is executed 9 times, after this addroundkey to finish the 9th round,
- *  after that the 10th round without mixcolums no further subfunctions
- *  to save cycles for function calls no structuring with "for (....)"
- *  to save cycles.
+ *  Encrypt one block in place.  Each column of a round is four lookups in
+ *  g_te, which combine SubBytes, ShiftRows and MixColumns, and the round
+ *  key.  The last round has no MixColumns and uses the sbox.
  *
  * Input Parameters:
- *  expanded_key expanded AES128 key
- *  state        16 bytes of plain text and cipher text
+ *  block  16 bytes of plain text and cipher text
+ *  state  The AES context holding the round keys
  *
  * Returned Value:
  *  None
  *
  ****************************************************************************/
 
-static void aes_encr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
+static void aes_encr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  uint8_t round;
-
-  for (round = 0; round < 9; round ++)
+  FAR const uint32_t *rk = state->ek;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int round;
+
+  s0 = AES_GETU32(&block[0])  ^ rk[0];
+  s1 = AES_GETU32(&block[4])  ^ rk[1];
+  s2 = AES_GETU32(&block[8])  ^ rk[2];
+  s3 = AES_GETU32(&block[12]) ^ rk[3];
+
+  for (round = 1; round < state->nrounds; round++)
     {
-      /* addroundkey, sbox and shiftrows */
-
-      /* Row 0 */
-
-      state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-      state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-      state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-      state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-      /* Row 1 */
-
-      buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-      state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-      state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-      state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-      state[13]  = g_sbox[buf1];
-
-      /* Row 2 */
-
-      buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-      buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-      state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-      state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-      state[10]  = g_sbox[buf1];
-      state[14]  = g_sbox[buf2];
-
-      /* Row 3 */
-
-      buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-      state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-      state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-      state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-      state[3]   = g_sbox[buf1];
-
-      /* mixcolums */
-
-      /* Col1 */
-
-      buf1 = state[0] ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
-
-      buf3 = state[0] ^ state[1];
-      buf3 = galois_mul2(buf3);
-      state[0] = state[0] ^ buf3 ^ buf1;
-
-      buf3 = state[1] ^ state[2];
-      buf3 = galois_mul2(buf3);
-      state[1] = state[1] ^ buf3 ^ buf1;
-
-      buf3 = state[2] ^ state[3];
-      buf3 = galois_mul2(buf3);
-      state[2] = state[2] ^ buf3 ^ buf1;
-
-      buf3 = state[3] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[3] = state[3] ^ buf3 ^ buf1;
-
-      /* Col2 */
-
-      buf1 = state[4] ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
-
-      buf3 = state[4] ^ state[5];
-      buf3 = galois_mul2(buf3);
-      state[4] = state[4] ^ buf3 ^ buf1;
-
-      buf3 = state[5] ^ state[6];
-      buf3 = galois_mul2(buf3);
-      state[5] = state[5] ^ buf3 ^ buf1;
-
-      buf3 = state[6] ^ state[7];
-      buf3 = galois_mul2(buf3);
-      state[6] = state[6] ^ buf3 ^ buf1;
-
-      buf3 = state[7] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[7] = state[7] ^ buf3 ^ buf1;
-
-      /* Col3 */
-
-      buf1 = state[8] ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
-
-      buf3 = state[8] ^ state[9];
-      buf3 = galois_mul2(buf3);
-      state[8] = state[8] ^ buf3 ^ buf1;
-
-      buf3 = state[9] ^ state[10];
-      buf3 = galois_mul2(buf3);
-      state[9] = state[9] ^ buf3 ^ buf1;
-
-      buf3 = state[10] ^ state[11];
-      buf3 = galois_mul2(buf3);
-      state[10] = state[10] ^ buf3 ^ buf1;
-
-      buf3 = state[11] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[11] = state[11] ^ buf3 ^ buf1;
-
-      /* Col4 */
-
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
-
-      buf3 = state[12] ^ state[13];
-      buf3 = galois_mul2(buf3);
-      state[12] = state[12] ^ buf3 ^ buf1;
-
-      buf3 = state[13] ^ state[14];
-      buf3 = galois_mul2(buf3);
-      state[13] = state[13] ^ buf3 ^ buf1;
-
-      buf3 = state[14] ^ state[15];
-      buf3 = galois_mul2(buf3);
-      state[14] = state[14] ^ buf3 ^ buf1;
-
-      buf3 = state[15] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[15] = state[15] ^ buf3 ^ buf1;
+      rk += 4;
+      t0  = AES_TABLE(g_te, s0, s1 >> 8, s2 >> 16, s3 >> 24) ^ rk[0];
+      t1  = AES_TABLE(g_te, s1, s2 >> 8, s3 >> 16, s0 >> 24) ^ rk[1];
+      t2  = AES_TABLE(g_te, s2, s3 >> 8, s0 >> 16, s1 >> 24) ^ rk[2];
+      t3  = AES_TABLE(g_te, s3, s0 >> 8, s1 >> 16, s2 >> 24) ^ rk[3];
+      s0  = t0;
+      s1  = t1;
+      s2  = t2;
+      s3  = t3;
     }
 
-  /* 10th round without mixcols */
-
-  state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-  state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-  state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-  state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-  /* Row 1 */
-
-  buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-  state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-  state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-  state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-  state[13]  = g_sbox[buf1];
-
-  /* Row 2 */
-
-  buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-  buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-  state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-  state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-  state[10]  = g_sbox[buf1];
-  state[14]  = g_sbox[buf2];
-
-  /* Row 3 */
-
-  buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-  state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-  state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-  state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-  state[3]   = g_sbox[buf1];
-
-  /* Last addroundkey */
-
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
+  rk += 4;
+  t0  = AES_FINAL(g_sbox, s0, s1, s2, s3) ^ rk[0];
+  t1  = AES_FINAL(g_sbox, s1, s2, s3, s0) ^ rk[1];
+  t2  = AES_FINAL(g_sbox, s2, s3, s0, s1) ^ rk[2];
+  t3  = AES_FINAL(g_sbox, s3, s0, s1, s2) ^ rk[3];
+
+  AES_PUTU32(&block[0], t0);
+  AES_PUTU32(&block[4], t1);
+  AES_PUTU32(&block[8], t2);
+  AES_PUTU32(&block[12], t3);
 }
 
 /****************************************************************************
  * Name: aes_decr
  *
  * Description:
- *  Internal implementation of AES128 decryption.
- *  Straight forward aes decryption implementation.  The order of substeps is
- *  the exact reverse of decryption inverse functions:
- *
- *     - addRoundKey is its own inverse
- *     - rsbox is inverse of sbox
- *     - rightshift instead of leftshift
- *     - invMixColumns = barreto + mixColumns
- *
- *  No further subfunctions to save cycles for function calls no structuring
- *  with "for (....)" to save cycles
+ *  Decrypt one block in place with the equivalent inverse cipher, which
+ *  has the same structure as the cipher with g_td, the inverse sbox and
+ *  the rows shifted the other way.
  *
  * Input Parameters:
- *  expanded_key expanded AES128 key
- *  state        16 bytes of cipher text and plain text
+ *  block  16 bytes of cipher text and plain text
+ *  state  The AES context holding the round keys
  *
  * Returned Value:
  *  None
  *
  ****************************************************************************/
 
-static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
+static void aes_decr(FAR uint8_t *block,
+                     FAR const struct aes_state_s *state)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  int8_t round;
-
-  round = 9;
-
-  /* Initial addroundkey */
-
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
-
-  /* 10th round without mixcols */
-
-  state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-  state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-  state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-  state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
-
-  /* Row 1 */
-
-  buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-  state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-  state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-  state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-  state[1]   = buf1;
-
-  /* Row 2 */
-
-  buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-  buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-  state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-  state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-  state[10]  = buf1;
-  state[14]  = buf2;
-
-  /* Row 3 */
-
-  buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-  state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-  state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-  state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-  state[15]  = buf1;
-
-  for (round = 8; round >= 0; round--)
+  FAR const uint32_t *rk = state->dk;
+  uint32_t s0;
+  uint32_t s1;
+  uint32_t s2;
+  uint32_t s3;
+  uint32_t t0;
+  uint32_t t1;
+  uint32_t t2;
+  uint32_t t3;
+  int round;
+
+  s0 = AES_GETU32(&block[0])  ^ rk[0];
+  s1 = AES_GETU32(&block[4])  ^ rk[1];
+  s2 = AES_GETU32(&block[8])  ^ rk[2];
+  s3 = AES_GETU32(&block[12]) ^ rk[3];
+
+  for (round = 1; round < state->nrounds; round++)
     {
-      /* barreto */
-
-      /* Col1 */
-
-      buf1       = galois_mul2(galois_mul2(state[0] ^ state[2]));
-      buf2       = galois_mul2(galois_mul2(state[1] ^ state[3]));
-      state[0]  ^= buf1;
-      state[1]  ^= buf2;
-      state[2]  ^= buf1;
-      state[3]  ^= buf2;
-
-      /* Col2 */
-
-      buf1       = galois_mul2(galois_mul2(state[4] ^ state[6]));
-      buf2       = galois_mul2(galois_mul2(state[5] ^ state[7]));
-      state[4]  ^= buf1;
-      state[5]  ^= buf2;
-      state[6]  ^= buf1;
-      state[7]  ^= buf2;
-
-      /* Col3 */
-
-      buf1       = galois_mul2(galois_mul2(state[8] ^ state[10]));
-      buf2       = galois_mul2(galois_mul2(state[9] ^ state[11]));
-      state[8]  ^= buf1;
-      state[9]  ^= buf2;
-      state[10] ^= buf1;
-      state[11] ^= buf2;
-
-      /* Col4 */
-
-      buf1       = galois_mul2(galois_mul2(state[12] ^ state[14]));
-      buf2       = galois_mul2(galois_mul2(state[13] ^ state[15]));
-      state[12] ^= buf1;
-      state[13] ^= buf2;
-      state[14] ^= buf1;
-      state[15] ^= buf2;
-
-      /* mixcolums */
-
-      /* Col1 */
-
-      buf1 = state[0]  ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
-
-      buf3 = state[0]  ^ state[1];
-      buf3 = galois_mul2(buf3);
-      state[0] = state[0] ^ buf3 ^ buf1;
-
-      buf3 = state[1]  ^ state[2];
-      buf3 = galois_mul2(buf3);
-      state[1] = state[1] ^ buf3 ^ buf1;
-
-      buf3 = state[2]  ^ state[3];
-      buf3 = galois_mul2(buf3);
-      state[2] = state[2] ^ buf3 ^ buf1;
-
-      buf3 = state[3]  ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[3] = state[3] ^ buf3 ^ buf1;
-
-      /* Col2 */
-
-      buf1 = state[4]  ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
-
-      buf3 = state[4]  ^ state[5];
-      buf3 = galois_mul2(buf3);
-      state[4] = state[4] ^ buf3 ^ buf1;
-
-      buf3 = state[5]  ^ state[6];
-      buf3 = galois_mul2(buf3);
-      state[5] = state[5] ^ buf3 ^ buf1;
-
-      buf3 = state[6]  ^ state[7];
-      buf3 = galois_mul2(buf3);
-      state[6] = state[6] ^ buf3 ^ buf1;
-
-      buf3 = state[7]  ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[7] = state[7] ^ buf3 ^ buf1;
-
-      /* Col3 */
-
-      buf1 = state[8]  ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
-
-      buf3 = state[8]  ^ state[9];
-      buf3 = galois_mul2(buf3);
-      state[8] = state[8] ^ buf3 ^ buf1;
-
-      buf3 = state[9]  ^ state[10];
-      buf3 = galois_mul2(buf3);
-      state[9] = state[9] ^ buf3 ^ buf1;
-
-      buf3 = state[10] ^ state[11];
-      buf3 = galois_mul2(buf3);
-      state[10] = state[10] ^ buf3 ^ buf1;
-
-      buf3 = state[11] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[11] = state[11] ^ buf3 ^ buf1;
-
-      /* Col4 */
-
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
-
-      buf3 = state[12] ^ state[13];
-      buf3 = galois_mul2(buf3);
-      state[12] = state[12] ^ buf3 ^ buf1;
-
-      buf3 = state[13] ^ state[14];
-      buf3 = galois_mul2(buf3);
-      state[13] = state[13] ^ buf3 ^ buf1;
-
-      buf3 = state[14] ^ state[15];
-      buf3 = galois_mul2(buf3);
-      state[14] = state[14] ^ buf3 ^ buf1;
-
-      buf3 = state[15] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[15] = state[15] ^ buf3 ^ buf1;
-
-      /* addroundkey, rsbox and shiftrows */
+      rk += 4;
+      t0  = AES_TABLE(g_td, s0, s3 >> 8, s2 >> 16, s1 >> 24) ^ rk[0];
+      t1  = AES_TABLE(g_td, s1, s0 >> 8, s3 >> 16, s2 >> 24) ^ rk[1];
+      t2  = AES_TABLE(g_td, s2, s1 >> 8, s0 >> 16, s3 >> 24) ^ rk[2];
+      t3  = AES_TABLE(g_td, s3, s2 >> 8, s1 >> 16, s0 >> 24) ^ rk[3];
+      s0  = t0;
+      s1  = t1;
+      s2  = t2;
+      s3  = t3;
+    }
 
-      /* Row 0 */
+  rk += 4;
+  t0  = AES_FINAL(g_rsbox, s0, s3, s2, s1) ^ rk[0];
+  t1  = AES_FINAL(g_rsbox, s1, s0, s3, s2) ^ rk[1];
+  t2  = AES_FINAL(g_rsbox, s2, s1, s0, s3) ^ rk[2];
+  t3  = AES_FINAL(g_rsbox, s3, s2, s1, s0) ^ rk[3];
 
-      state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-      state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-      state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-      state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
+  AES_PUTU32(&block[0], t0);
+  AES_PUTU32(&block[4], t1);
+  AES_PUTU32(&block[8], t2);
+  AES_PUTU32(&block[12], t3);
+}
+#endif
 
-      /* Row 1 */
+#ifdef CONFIG_CRYPTO_AES
+/****************************************************************************
+ * Name: aes_xorblock
+ ****************************************************************************/
 
-      buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-      state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-      state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-      state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-      state[1]   = buf1;
+static void aes_xorblock(FAR uint8_t *dst, FAR const uint8_t *a,
+                         FAR const uint8_t *b, size_t len)
+{
+  size_t i;
 
-      /* Row 2 */
+  for (i = 0; i < len; i++)
+    {
+      dst[i] = a[i] ^ b[i];
+    }
+}
 
-      buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-      buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-      state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-      state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-      state[10]  = buf1;
-      state[14]  = buf2;
+/****************************************************************************
+ * Name: aes_ctrinc
+ *
+ * Description:
+ *   Increment the big endian counter block of the CTR mode.
+ *
+ ****************************************************************************/
 
-      /* Row 3 */
+static void aes_ctrinc(FAR uint8_t *ctr)
+{
+  int i;
 
-      buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-      state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-      state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-      state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-      state[15]  = buf1;
+  for (i = AES_BLOCK_SIZE - 1; i >= 0; i--)
+    {
+      if (++ctr[i] != 0)
+        {
+          break;
+        }
     }
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -715,14 +728,12 @@ static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key: 16 (AES-128), 24 (AES-192) or 32 (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if len is not 16, 24 or 32
  *
  ****************************************************************************/
 
@@ -730,12 +741,13 @@ int aes_setupkey(FAR struct aes_state_s *state,
                  FAR const uint8_t *key,
                  int len)
 {
-  if (len != 16)
+  if (len != AES128_KEY_SIZE && len != AES192_KEY_SIZE &&
+      len != AES256_KEY_SIZE)
     {
       return -EINVAL;
     }
 
-  expand_key(state->expanded_key, key);
+  expand_key(state, key, len);
   return 0;
 }
 
@@ -760,7 +772,7 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
   for (i = 0; i < nblk; i++)
     {
-      aes_encr(blocks + off, state->expanded_key);
+      aes_encr(blocks + off, state);
       off += 16;
     }
 }
@@ -786,7 +798,7 @@ void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
   for (i = 0; i < nblk; i++)
     {
-      aes_decr(blocks + off, state->expanded_key);
+      aes_decr(blocks + off, state);
       off += 16;
     }
 }
@@ -810,10 +822,10 @@ void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 
 void aes_encrypt(FAR uint8_t *state, FAR const uint8_t *key)
 {
-  /* Expand the key into 176 bytes */
+  /* Expand the key into the round keys */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_encr(state, g_aes_state.expanded_key);
+  aes_encr(state, &g_aes_state);
 }
 
 /****************************************************************************
@@ -835,8 +847,142 @@ void aes_encrypt(FAR uint8_t *state, FAR const uint8_t *key)
 
 void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key)
 {
-  /* Expand the key into 176 bytes */
+  /* Expand the key into the round keys */
 
   aes_setupkey(&g_aes_state, key, 16);
-  aes_decr(state, g_aes_state.expanded_key);
+  aes_decr(state, &g_aes_state);
+}
+
+#ifdef CONFIG_CRYPTO_AES
+/****************************************************************************
+ * Name: aes_cypher
+ *
+ * Description:
+ *   The software aes_cypher() of include/nuttx/crypto/crypto.h, for the
+ *   ECB, CBC, CTR and CFB modes with 128, 192 and 256 bit keys.  It is a
+ *   weak function: the architectures with a hardware AES engine provide
+ *   their own aes_cypher(), which replaces it.
+ *
+ *   The key schedule of the last key is kept, so that the repeated calls
+ *   with the same key, like those of the BCH encryption, do not expand it
+ *   again.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int weak_function aes_cypher(FAR void *out, FAR const void *in, size_t size,
+                             FAR const void *iv, FAR const void *key,
+                             size_t keysize, int mode, int encrypt)
+{
+  FAR const uint8_t *src = in;
+  FAR uint8_t *dst = out;
+  uint8_t chain[AES_BLOCK_SIZE];
+  uint8_t block[AES_BLOCK_SIZE];
+  size_t nbytes;
+  int ret = OK;
+
+  if (keysize != AES128_KEY_SIZE && keysize != AES192_KEY_SIZE &&
+      keysize != AES256_KEY_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  if ((mode == AES_MODE_ECB || mode == AES_MODE_CBC) &&
+      (size & (AES_BLOCK_SIZE - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (iv != NULL)
+    {
+      memcpy(chain, iv, AES_BLOCK_SIZE);
+    }
+  else
+    {
+      memset(chain, 0, AES_BLOCK_SIZE);
+    }
+
+  nxmutex_lock(&g_aes_lock);
+  expand_key(&g_aes_cypher, key, keysize);
+
+  for (; size > 0; size -= nbytes)
+    {
+      nbytes = size < AES_BLOCK_SIZE ? size : AES_BLOCK_SIZE;
+
+      switch (mode)
+        {
+          case AES_MODE_ECB:
+            memcpy(block, src, AES_BLOCK_SIZE);
+            if (encrypt == CYPHER_ENCRYPT)
+              {
+                aes_encr(block, &g_aes_cypher);
+              }
+            else
+              {
+                aes_decr(block, &g_aes_cypher);
+              }
+
+            memcpy(dst, block, AES_BLOCK_SIZE);
+            break;
+
+          case AES_MODE_CBC:
+            if (encrypt == CYPHER_ENCRYPT)
+              {
+                aes_xorblock(chain, chain, src, AES_BLOCK_SIZE);
+                aes_encr(chain, &g_aes_cypher);
+                memcpy(dst, chain, AES_BLOCK_SIZE);
+              }
+            else
+              {
+                /* Keep the cipher text, dst may be the same as src */
+
+                memcpy(block, src, AES_BLOCK_SIZE);
+                aes_decr(block, &g_aes_cypher);
+                aes_xorblock(block, block, chain, AES_BLOCK_SIZE);
+                memcpy(chain, src, AES_BLOCK_SIZE);
+                memcpy(dst, block, AES_BLOCK_SIZE);
+              }
+            break;
+
+          case AES_MODE_CTR:
+            memcpy(block, chain, AES_BLOCK_SIZE);
+            aes_encr(block, &g_aes_cypher);
+            aes_xorblock(dst, src, block, nbytes);
+            aes_ctrinc(chain);
+            break;
+
+          case AES_MODE_CFB:
+            memcpy(block, chain, AES_BLOCK_SIZE);
+            aes_encr(block, &g_aes_cypher);
+            if (encrypt == CYPHER_ENCRYPT)
+              {
+                aes_xorblock(dst, src, block, nbytes);
+                memcpy(chain, dst, nbytes);
+              }
+            else
+              {
+                memcpy(chain, src, nbytes);
+                aes_xorblock(dst, src, block, nbytes);
+              }
+            break;
+
+          default:
+            ret = -EINVAL;
+            goto out;
+        }
+
+      src += nbytes;
+      dst += nbytes;
+    }
+
+out:
+  explicit_bzero(&g_aes_cypher, sizeof(g_aes_cypher));
+  nxmutex_unlock(&g_aes_lock);
+
+  explicit_bzero(block, sizeof(block));
+  explicit_bzero(chain, sizeof(chain));
+  return ret;
 }
+#endif /* CONFIG_CRYPTO_AES */
@@ -98,6 +98,43 @@ static ssize_t cryptodev_write(FAR struct file *filep,
   return -EACCES;
 }
 
+#ifdef CONFIG_CRYPTO_AES
+static int cryptodev_crypt(FAR struct crypt_op *op)
+{
+  FAR struct session_op *ses = (FAR struct session_op *)op->ses;
+  int encrypt;
+
+  switch (op->op)
+    {
+    case COP_ENCRYPT:
+      encrypt = 1;
+      break;
+
+    case COP_DECRYPT:
+      encrypt = 0;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+  switch (ses->cipher)
+    {
+    case CRYPTO_AES_ECB:
+      return AES_CYPHER(AES_MODE_ECB);
+
+    case CRYPTO_AES_CBC:
+      return AES_CYPHER(AES_MODE_CBC);
+
+    case CRYPTO_AES_CTR:
+      return AES_CYPHER(AES_MODE_CTR);
+
+    default:
+      return -EINVAL;
+    }
+}
+#endif
+
 static int cryptodev_ioctl(FAR struct file *filep,
                            int cmd,
                            unsigned long arg)
@@ -119,38 +156,27 @@ static int cryptodev_ioctl(FAR struct file *filep,
 #ifdef CONFIG_CRYPTO_AES
   case CIOCCRYPT:
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
+      return cryptodev_crypt((FAR struct crypt_op *)arg);
+    }
 
-      switch (op->op)
-        {
-        case COP_ENCRYPT:
-          encrypt = 1;
-          break;
+  /* A batch saves the system call of each operation */
 
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
+  case CIOCNCRYPTM:
+    {
+      FAR struct crypt_mop *mop = (FAR struct crypt_mop *)arg;
+      unsigned i;
 
-        default:
+      if (mop == NULL || (mop->count > 0 && mop->reqs == NULL))
+        {
           return -EINVAL;
         }
 
-      switch (ses->cipher)
+      for (i = 0; i < mop->count; i++)
         {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
-
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
-
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
-
-        default:
-           return -EINVAL;
+          mop->reqs[i].status = cryptodev_crypt(&mop->reqs[i].op);
         }
+
+      return OK;
     }
 #endif
 
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <sched.h>
 #include <debug.h>
 #include <assert.h>
 #include <errno.h>
@@ -34,6 +35,7 @@
 #include <nuttx/random.h>
 #include <nuttx/board.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/crypto/blake2s.h>
 
@@ -48,6 +50,32 @@
 #define ROTL_32(x,n) ( ((x) << (n)) | ((x) >> (32-(n))) )
 #define ROTR_32(x,n) ( ((x) >> (n)) | ((x) << (32-(n))) )
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+/* The per-CPU generators produce CHACHA_NBLOCKS blocks at a time.  The
+ * first 32 bytes become the next key, so that the output already returned
+ * cannot be recomputed from the state ("fast key erasure").
+ */
+
+#  define CHACHA_BLOCKSIZE  64
+#  define CHACHA_KEYSIZE    32
+#  define CHACHA_NBLOCKS    4
+#  define CHACHA_BUFSIZE    (CHACHA_NBLOCKS * CHACHA_BLOCKSIZE)
+
+/* Reseed a per-CPU generator from the pool after this much output */
+
+#  define CHACHA_RESEED_BYTES (1024 * 1024)
+
+#  define CHACHA_QR(a,b,c,d) \
+  do \
+    { \
+      a += b; d ^= a; d = ROTL_32(d, 16); \
+      c += d; b ^= c; b = ROTL_32(b, 12); \
+      a += b; d ^= a; d = ROTL_32(d, 8); \
+      c += d; b ^= c; b = ROTL_32(b, 7); \
+    } \
+  while (0)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -73,9 +101,24 @@ struct rng_s
   volatile uint8_t rd_prev_time;
   volatile uint16_t rd_prev_irq;
   bool output_initialized;
+  uint32_t rd_generation; /* Incremented on each reseed */
   struct blake2xs_rng_s blake2xs;
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+/* The ChaCha20 generator of a CPU, seeded from the BLAKE2Xs generator */
+
+struct rng_cpu_s
+{
+  uint32_t key[CHACHA_KEYSIZE / 4];
+  uint8_t buf[CHACHA_BUFSIZE];  /* Output not returned yet at the end */
+  uint16_t avail;               /* Number of bytes left in buf */
+  bool seeded;
+  uint32_t generation;          /* rd_generation when seeded */
+  uint32_t output;              /* Bytes returned since seeded */
+};
+#endif
+
 enum
 {
   POOL_SIZE = ENTROPY_POOL_SIZE,
@@ -91,6 +134,10 @@ enum
 
 static struct rng_s g_rng;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+static struct rng_cpu_s g_rng_cpu[CONFIG_SMP_NCPUS];
+#endif
+
 #ifdef CONFIG_BOARD_ENTROPY_POOL
 /* Entropy pool structure can be provided by board source. Use for this is,
  * for example, allocate entropy pool from special area of RAM which content
@@ -304,6 +351,7 @@ static void rng_reseed(void)
   g_rng.blake2xs.param.node_depth = 0;
 
   g_rng.output_initialized = true;
+  g_rng.rd_generation++;
 }
 
 static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
@@ -357,6 +405,152 @@ static void rng_buf_internal(FAR uint8_t *bytes, size_t nbytes)
     }
 }
 
+/****************************************************************************
+ * Name: rng_buf
+ *
+ * Description:
+ *   Take random bytes from the BLAKE2Xs generator, under its lock.
+ *
+ ****************************************************************************/
+
+static void rng_buf(FAR uint8_t *bytes, size_t nbytes)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait_uninterruptible(&g_rng.rd_sem);
+
+      /* The only possible error should be if we were awakened by
+       * thread cancellation. At this point, we must continue to acquire
+       * the semaphore anyway.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -ECANCELED);
+    }
+  while (ret < 0);
+
+  rng_buf_internal(bytes, nbytes);
+  nxsem_post(&g_rng.rd_sem);
+}
+
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+/****************************************************************************
+ * Name: chacha_block
+ *
+ * Description:
+ *   Compute the ChaCha20 block 'counter' of 'key', with a zero nonce, per
+ *   RFC 8439.
+ *
+ ****************************************************************************/
+
+static void chacha_block(FAR const uint32_t *key, uint32_t counter,
+                         FAR uint8_t *out)
+{
+  uint32_t in[16];
+  uint32_t x[16];
+  int i;
+
+  in[0]  = 0x61707865;
+  in[1]  = 0x3320646e;
+  in[2]  = 0x79622d32;
+  in[3]  = 0x6b206574;
+  memcpy(&in[4], key, CHACHA_KEYSIZE);
+  in[12] = counter;
+  in[13] = 0;
+  in[14] = 0;
+  in[15] = 0;
+
+  memcpy(x, in, sizeof(x));
+
+  for (i = 0; i < 10; i++)
+    {
+      CHACHA_QR(x[0], x[4], x[8],  x[12]);
+      CHACHA_QR(x[1], x[5], x[9],  x[13]);
+      CHACHA_QR(x[2], x[6], x[10], x[14]);
+      CHACHA_QR(x[3], x[7], x[11], x[15]);
+      CHACHA_QR(x[0], x[5], x[10], x[15]);
+      CHACHA_QR(x[1], x[6], x[11], x[12]);
+      CHACHA_QR(x[2], x[7], x[8],  x[13]);
+      CHACHA_QR(x[3], x[4], x[9],  x[14]);
+    }
+
+  for (i = 0; i < 16; i++)
+    {
+      x[i] += in[i];
+    }
+
+  /* The output is random, its byte order does not matter */
+
+  memcpy(out, x, CHACHA_BLOCKSIZE);
+  explicit_bzero(x, sizeof(x));
+  explicit_bzero(in, sizeof(in));
+}
+
+/****************************************************************************
+ * Name: rng_cpu_refill
+ *
+ * Description:
+ *   Refill the output buffer of a per-CPU generator and replace its key.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_refill(FAR struct rng_cpu_s *cpu)
+{
+  int i;
+
+  for (i = 0; i < CHACHA_NBLOCKS; i++)
+    {
+      chacha_block(cpu->key, i, &cpu->buf[i * CHACHA_BLOCKSIZE]);
+    }
+
+  memcpy(cpu->key, cpu->buf, CHACHA_KEYSIZE);
+  explicit_bzero(cpu->buf, CHACHA_KEYSIZE);
+  cpu->avail = CHACHA_BUFSIZE - CHACHA_KEYSIZE;
+}
+
+/****************************************************************************
+ * Name: rng_cpu_reseed
+ *
+ * Description:
+ *   Mix a new seed from the BLAKE2Xs generator into the key of the
+ *   generator of the current CPU.  Called with the scheduler unlocked,
+ *   since the seed is taken under the lock of the pool.
+ *
+ ****************************************************************************/
+
+static void rng_cpu_reseed(void)
+{
+  FAR struct rng_cpu_s *cpu;
+  uint32_t seed[CHACHA_KEYSIZE / 4];
+  uint32_t generation;
+  int i;
+
+  rng_buf((FAR uint8_t *)seed, sizeof(seed));
+  generation = g_rng.rd_generation;
+
+  sched_lock();
+
+  cpu = &g_rng_cpu[up_cpu_index()];
+  for (i = 0; i < CHACHA_KEYSIZE / 4; i++)
+    {
+      cpu->key[i] ^= seed[i];
+    }
+
+  /* Drop the output of the previous key */
+
+  explicit_bzero(cpu->buf, sizeof(cpu->buf));
+  cpu->avail      = 0;
+  cpu->seeded     = true;
+  cpu->generation = generation;
+  cpu->output     = 0;
+
+  sched_unlock();
+
+  explicit_bzero(seed, sizeof(seed));
+}
+#endif
+
 static void rng_init(void)
 {
   cryptinfo("Initializing RNG\n");
@@ -546,21 +740,45 @@ void up_randompool_initialize(void)
 
 void arc4random_buf(FAR void *bytes, size_t nbytes)
 {
-  int ret;
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_PERCPU
+  FAR struct rng_cpu_s *cpu;
+  FAR uint8_t *dest = bytes;
+  size_t n;
 
-  do
+  /* Draw from the generator of the current CPU.  Locking the scheduler
+   * keeps the thread on the CPU without a lock shared by the CPUs.
+   */
+
+  while (nbytes > 0)
     {
-      ret = nxsem_wait_uninterruptible(&g_rng.rd_sem);
+      sched_lock();
 
-      /* The only possible error should be if we were awakened by
-       * thread cancellation. At this point, we must continue to acquire
-       * the semaphore anyway.
-       */
+      cpu = &g_rng_cpu[up_cpu_index()];
+      if (!cpu->seeded || cpu->generation != g_rng.rd_generation ||
+          cpu->output >= CHACHA_RESEED_BYTES)
+        {
+          sched_unlock();
+          rng_cpu_reseed();
+          continue;
+        }
 
-      DEBUGASSERT(ret == OK || ret == -ECANCELED);
-    }
-  while (ret < 0);
+      if (cpu->avail == 0)
+        {
+          rng_cpu_refill(cpu);
+        }
 
-  rng_buf_internal(bytes, nbytes);
-  nxsem_post(&g_rng.rd_sem);
+      n = MIN(nbytes, cpu->avail);
+      memcpy(dest, &cpu->buf[CHACHA_BUFSIZE - cpu->avail], n);
+      explicit_bzero(&cpu->buf[CHACHA_BUFSIZE - cpu->avail], n);
+      cpu->avail  -= n;
+      cpu->output += n;
+
+      sched_unlock();
+
+      dest   += n;
+      nbytes -= n;
+    }
+#else
+  rng_buf(bytes, nbytes);
+#endif
 }
@@ -36,6 +36,8 @@
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/analog/adc.h>
 #include <nuttx/analog/ioctl.h>
 #include <nuttx/random.h>
@@ -59,6 +61,10 @@ static int     adc_poll(FAR struct file *filep, struct pollfd *fds,
                         bool setup);
 static int     adc_reset_fifo(FAR struct adc_dev_s *dev);
 static int     adc_samples_on_read(FAR struct adc_dev_s *dev);
+#ifdef CONFIG_ADC_STREAM
+static int     adc_receiveblock(FAR struct adc_dev_s *dev,
+                                FAR const void *data, size_t nbytes);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -82,12 +88,128 @@ static const struct adc_callback_s g_adc_callback =
 {
   adc_receive,    /* au_receive */
   adc_reset       /* au_reset */
+#ifdef CONFIG_ADC_STREAM
+  , adc_receiveblock /* au_receiveblock */
+#endif
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_ADC_STREAM
+/****************************************************************************
+ * Name: adc_stream_copyin
+ *
+ * Description:
+ *   Copy to the ring of the stream at the free running offset 'pos'.
+ *
+ ****************************************************************************/
+
+static void adc_stream_copyin(FAR struct adc_stream_s *stream, size_t pos,
+                              FAR const void *src, size_t nbytes)
+{
+  size_t offset = pos % CONFIG_ADC_STREAM_BUFSIZE;
+  size_t chunk  = CONFIG_ADC_STREAM_BUFSIZE - offset;
+
+  if (chunk >= nbytes)
+    {
+      memcpy(&stream->as_buffer[offset], src, nbytes);
+    }
+  else
+    {
+      memcpy(&stream->as_buffer[offset], src, chunk);
+      memcpy(stream->as_buffer, (FAR const uint8_t *)src + chunk,
+             nbytes - chunk);
+    }
+}
+
+/****************************************************************************
+ * Name: adc_stream_copyout
+ *
+ * Description:
+ *   Copy from the ring of the stream at the free running offset 'pos'.
+ *
+ ****************************************************************************/
+
+static void adc_stream_copyout(FAR struct adc_stream_s *stream, size_t pos,
+                               FAR void *dest, size_t nbytes)
+{
+  size_t offset = pos % CONFIG_ADC_STREAM_BUFSIZE;
+  size_t chunk  = CONFIG_ADC_STREAM_BUFSIZE - offset;
+
+  if (chunk >= nbytes)
+    {
+      memcpy(dest, &stream->as_buffer[offset], nbytes);
+    }
+  else
+    {
+      memcpy(dest, &stream->as_buffer[offset], chunk);
+      memcpy((FAR uint8_t *)dest + chunk, stream->as_buffer,
+             nbytes - chunk);
+    }
+}
+
+/****************************************************************************
+ * Name: adc_stream_read
+ *
+ * Description:
+ *   Copy the whole blocks that fit in the user buffer.  The copy is done
+ *   with the interrupts enabled: adc_receiveblock() only writes to the free
+ *   part of the ring, and only the readers, serialized by as_rdsem, move
+ *   its head.
+ *
+ ****************************************************************************/
+
+static ssize_t adc_stream_read(FAR struct adc_dev_s *dev,
+                               FAR char *buffer, size_t buflen)
+{
+  FAR struct adc_stream_s *stream = &dev->ad_stream;
+  struct adc_block_s block;
+  irqstate_t flags;
+  size_t nread = 0;
+  size_t head;
+  size_t tail;
+  size_t size;
+  int ret;
+
+  ret = nxsem_wait(&stream->as_rdsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+  head  = stream->as_head;
+  tail  = stream->as_tail;
+  leave_critical_section(flags);
+
+  while (head != tail)
+    {
+      adc_stream_copyout(stream, head, &block, sizeof(block));
+      size = ADC_BLOCK_SIZE(block.ab_nbytes);
+      if (nread + size > buflen)
+        {
+          break;
+        }
+
+      adc_stream_copyout(stream, head, &buffer[nread], size);
+      nread += size;
+      head  += size;
+    }
+
+  flags = enter_critical_section();
+  stream->as_head = head;
+  leave_critical_section(flags);
+
+  nxsem_post(&stream->as_rdsem);
+
+  /* The buffer must hold at least one block */
+
+  return nread > 0 ? nread : -EMSGSIZE;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_open
  *
@@ -130,9 +252,29 @@ static int adc_open(FAR struct file *filep)
 
           if (tmp == 1)
             {
+              irqstate_t flags;
+
+#ifdef CONFIG_ADC_STREAM
+              /* Allocate the ring of the blocks of samples */
+
+              dev->ad_stream.as_buffer =
+                kmm_malloc(CONFIG_ADC_STREAM_BUFSIZE);
+              if (dev->ad_stream.as_buffer == NULL)
+                {
+                  nxsem_post(&dev->ad_closesem);
+                  return -ENOMEM;
+                }
+
+              dev->ad_stream.as_head     = 0;
+              dev->ad_stream.as_tail     = 0;
+              dev->ad_stream.as_seq      = 0;
+              dev->ad_stream.as_dropped  = 0;
+              dev->ad_stream.as_overruns = 0;
+#endif
+
               /* Yes.. perform one time hardware initialization. */
 
-              irqstate_t flags = enter_critical_section();
+              flags = enter_critical_section();
               ret = dev->ad_ops->ao_setup(dev);
               if (ret == OK)
                 {
@@ -151,11 +293,22 @@ static int adc_open(FAR struct file *filep)
                 }
 
               leave_critical_section(flags);
+
+#ifdef CONFIG_ADC_STREAM
+              if (ret < 0)
+                {
+                  kmm_free(dev->ad_stream.as_buffer);
+                  dev->ad_stream.as_buffer = NULL;
+                }
+#endif
             }
 
           /* Save the new open count on success */
 
-          dev->ad_ocount = tmp;
+          if (ret >= 0)
+            {
+              dev->ad_ocount = tmp;
+            }
         }
 
       nxsem_post(&dev->ad_closesem);
@@ -202,6 +355,10 @@ static int adc_close(FAR struct file *filep)
 
           flags = enter_critical_section();    /* Disable interrupts */
           dev->ad_ops->ao_shutdown(dev);       /* Disable the ADC */
+#ifdef CONFIG_ADC_STREAM
+          kmm_free(dev->ad_stream.as_buffer);
+          dev->ad_stream.as_buffer = NULL;
+#endif
           leave_critical_section(flags);
 
           nxsem_post(&dev->ad_closesem);
@@ -267,6 +424,16 @@ static ssize_t adc_read(FAR struct file *filep, FAR char *buffer,
       flags = enter_critical_section();
       while (dev->ad_recv.af_head == dev->ad_recv.af_tail)
         {
+#ifdef CONFIG_ADC_STREAM
+          /* Return the blocks of samples of the streaming mode */
+
+          if (dev->ad_stream.as_head != dev->ad_stream.as_tail)
+            {
+              leave_critical_section(flags);
+              return adc_stream_read(dev, buffer, buflen);
+            }
+#endif
+
           /* Check if there was an overrun, if set we need to return EIO */
 
           if (dev->ad_isovr)
@@ -426,6 +593,14 @@ static int adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_ADC_STREAM
+      case ANIOC_STREAM_OVERRUNS:
+        {
+          ret = dev->ad_stream.as_overruns;
+        }
+        break;
+#endif
+
       default:
         {
           /* Those IOCTLs might be used in arch specific section */
@@ -496,6 +671,47 @@ static int adc_receive(FAR struct adc_dev_s *dev, uint8_t ch, int32_t data)
   return errcode;
 }
 
+#ifdef CONFIG_ADC_STREAM
+/****************************************************************************
+ * Name: adc_receiveblock
+ ****************************************************************************/
+
+static int adc_receiveblock(FAR struct adc_dev_s *dev,
+                            FAR const void *data, size_t nbytes)
+{
+  FAR struct adc_stream_s *stream = &dev->ad_stream;
+  struct adc_block_s block;
+  size_t size = ADC_BLOCK_SIZE(nbytes);
+
+  /* Count the block as an overrun if the ring cannot take it.  The next
+   * block that fits reports the blocks dropped before it.
+   */
+
+  if (stream->as_buffer == NULL ||
+      stream->as_tail - stream->as_head + size > CONFIG_ADC_STREAM_BUFSIZE)
+    {
+      stream->as_seq++;
+      stream->as_dropped++;
+      stream->as_overruns++;
+      return -ENOMEM;
+    }
+
+  clock_systime_timespec(&block.ab_time);
+  block.ab_seq      = stream->as_seq++;
+  block.ab_dropped  = stream->as_dropped;
+  block.ab_nbytes   = nbytes;
+  block.ab_reserved = 0;
+  stream->as_dropped = 0;
+
+  adc_stream_copyin(stream, stream->as_tail, &block, sizeof(block));
+  adc_stream_copyin(stream, stream->as_tail + sizeof(block), data, nbytes);
+  stream->as_tail += size;
+
+  adc_notify(dev);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_pollnotify
  ****************************************************************************/
@@ -594,7 +810,11 @@ static int adc_poll(FAR struct file *filep, struct pollfd *fds, bool setup)
 
       /* Should we immediately notify on any of the requested events? */
 
-      if (dev->ad_recv.af_head != dev->ad_recv.af_tail)
+      if (dev->ad_recv.af_head != dev->ad_recv.af_tail
+#ifdef CONFIG_ADC_STREAM
+          || dev->ad_stream.as_head != dev->ad_stream.as_tail
+#endif
+         )
         {
           adc_pollnotify(dev, POLLIN);
         }
@@ -696,6 +916,9 @@ int adc_register(FAR const char *path, FAR struct adc_dev_s *dev)
 
   nxsem_init(&dev->ad_recv.af_sem, 0, 0);
   nxsem_init(&dev->ad_closesem, 0, 1);
+#ifdef CONFIG_ADC_STREAM
+  nxsem_init(&dev->ad_stream.as_rdsem, 0, 1);
+#endif
 
   /* The receive semaphore is used for signaling and, hence, should not have
    * priority inheritance enabled.
@@ -715,6 +938,9 @@ int adc_register(FAR const char *path, FAR struct adc_dev_s *dev)
     {
       nxsem_destroy(&dev->ad_recv.af_sem);
       nxsem_destroy(&dev->ad_closesem);
+#ifdef CONFIG_ADC_STREAM
+      nxsem_destroy(&dev->ad_stream.as_rdsem);
+#endif
     }
 
   return ret;
@@ -38,6 +38,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_BCH_CACHE_NSECTORS
+#  define CONFIG_BCH_CACHE_NSECTORS 1
+#endif
+
+#ifndef CONFIG_BCH_READAHEAD_NSECTORS
+#  define CONFIG_BCH_READAHEAD_NSECTORS 0
+#endif
+
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
@@ -45,18 +53,42 @@
  * Public Types
  ****************************************************************************/
 
+/* One sector held in the sector cache */
+
+struct bchlib_sector_s
+{
+  size_t sector;           /* The sector in the buffer, (size_t)-1: none */
+  uint32_t lastuse;        /* Time of the last access, for LRU replacement */
+  bool dirty;              /* true: Data has been written to the buffer */
+  FAR uint8_t *buffer;     /* The sector buffer (within bchlib_s::cache) */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
+  size_t lastsector;       /* The last sector read, to detect sequential
+                            * access */
+  uint32_t usecount;       /* Increments on each access to a sector */
   sem_t sem;               /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  FAR uint8_t *cache;      /* CONFIG_BCH_CACHE_NSECTORS sector buffers */
+  FAR uint8_t *buffer;     /* The buffer of the current sector */
+
+  /* The current sector and the state of the cached sectors */
+
+  FAR struct bchlib_sector_s *current;
+  struct bchlib_sector_s sectors[CONFIG_BCH_CACHE_NSECTORS];
+
+  /* The memory of a block driver that supports BIOC_XIPBASE, or NULL.  It
+   * is read directly and returned by FIOC_MMAP, and the writes are written
+   * through the sector cache so that the memory is always up to date.
+   */
+
+  FAR uint8_t *xipbase;
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -85,6 +117,10 @@ EXTERN const struct file_operations bch_fops;
 EXTERN int  bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN void bchlib_cacheread(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                             size_t sector, size_t nsectors);
+EXTERN void bchlib_cacheinval(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
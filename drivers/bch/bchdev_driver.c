@@ -424,9 +424,35 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
       case BIOC_FLUSH:
         {
-          /* Flush any dirty pages remaining in the cache */
+          FAR struct inode *bchinode = bch->inode;
+
+          /* Flush any dirty pages remaining in the cache, then let the
+           * block driver flush its own write buffer.
+           */
 
           ret = bchlib_flushsector(bch);
+          if (ret >= 0 && bchinode->u.i_bops->ioctl != NULL)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+              if (ret == -ENOTTY)
+                {
+                  ret = OK;
+                }
+            }
+        }
+        break;
+
+      /* Return the memory of a mapped block driver, for mmap() */
+
+      case FIOC_MMAP:
+        {
+          FAR void **ppv = (FAR void **)((uintptr_t)arg);
+
+          if (bch->xipbase != NULL && ppv != NULL)
+            {
+              *ppv = bch->xipbase;
+              ret  = OK;
+            }
         }
         break;
 
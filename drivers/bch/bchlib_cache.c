@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -36,6 +37,14 @@
 #  include <nuttx/crypto/crypto.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -59,10 +68,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch,
+                      FAR struct bchlib_sector_s *cs, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)cs->buffer;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -70,7 +80,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        cs->sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -89,69 +99,156 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Name: bchlib_cachefind
+ *
+ * Description:
+ *   Return the cache entry holding 'sector' or NULL if it is not cached.
+ *
  ****************************************************************************/
 
+static FAR struct bchlib_sector_s *
+bchlib_cachefind(FAR struct bchlib_s *bch, size_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      if (bch->sectors[i].sector == sector)
+        {
+          return &bch->sectors[i];
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bchlib_writerun
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
- *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ *   Write 'count' dirty cache entries beginning with entry 'first' with a
+ *   single transfer.  The entries hold consecutive sectors and their
+ *   buffers are adjacent in memory.
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+static int bchlib_writerun(FAR struct bchlib_s *bch, int first, int count)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  FAR struct inode *inode = bch->inode;
+  FAR struct bchlib_sector_s *cs = &bch->sectors[first];
+  ssize_t ret;
+  int i;
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
-   */
+#if defined(CONFIG_BCH_ENCRYPTION)
+  /* Encrypt data as necessary */
 
-  if (bch->dirty)
+  for (i = 0; i < count; i++)
     {
-      inode = bch->inode;
+      bch_cypher(bch, &cs[i], CYPHER_ENCRYPT);
+    }
+#endif
+
+  /* Write the sectors to the media */
+
+  ret = inode->u.i_bops->write(inode, cs->buffer, cs->sector, count);
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-      /* Encrypt data as necessary */
+  /* Computation overhead to save memory for extra sector buffer
+   * TODO: Add configuration switch for extra sector buffer
+   */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+  for (i = 0; i < count; i++)
+    {
+      bch_cypher(bch, &cs[i], CYPHER_DECRYPT);
+    }
 #endif
 
-      /* Write the sector to the media */
+  if (ret < 0)
+    {
+      ferr("Write failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+  /* The sectors are now in sync with the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+  for (i = 0; i < count; i++)
+    {
+      cs[i].dirty = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_writeback
+ *
+ * Description:
+ *   Write back the dirty cache entries 'first' through 'last'.  Runs of
+ *   entries holding consecutive sectors are written with one transfer.
+ *
+ ****************************************************************************/
+
+static int bchlib_writeback(FAR struct bchlib_s *bch, int first, int last)
+{
+  FAR struct bchlib_sector_s *cs;
+  int count;
+  int ret;
+
+  while (first <= last)
+    {
+      cs = &bch->sectors[first];
+      if (!cs->dirty)
+        {
+          first++;
+          continue;
+        }
+
+      count = 1;
+      while (first + count <= last && cs[count].dirty &&
+             cs[count].sector == cs->sector + count)
+        {
+          count++;
+        }
+
+      ret = bchlib_writerun(bch, first, count);
       if (ret < 0)
         {
-          ferr("Write failed: %zd\n", ret);
-          return (int)ret;
+          return ret;
         }
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-      /* Computation overhead to save memory for extra sector buffer
-       * TODO: Add configuration switch for extra sector buffer
-       */
+      first += count;
+    }
 
-      bch_cypher(bch, CYPHER_DECRYPT);
-#endif
+  return OK;
+}
 
-      /* The sector is now in sync with the media */
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-      bch->dirty = false;
-    }
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the current contents of the sector cache (if dirty)
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
 
-  return (int)ret;
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+  return bchlib_writeback(bch, 0, CONFIG_BCH_CACHE_NSECTORS - 1);
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make 'sector' the current sector in bch->buffer.  The sector is taken
+ *   from the sector cache or read from the media, together with the
+ *   following sectors if the access is sequential.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -161,33 +258,172 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
   FAR struct inode *inode;
-  ssize_t ret = OK;
+  FAR struct bchlib_sector_s *cs;
+  ssize_t ret;
+  int first;
+  int count;
+  int i;
+
+  if (bch->current != NULL && bch->current->sector == sector)
+    {
+      return OK;
+    }
+
+  /* Is the sector in the cache? */
 
-  if (bch->sector != sector)
+  cs = bchlib_cachefind(bch, sector);
+  if (cs != NULL)
     {
-      inode = bch->inode;
+      goto out;
+    }
 
-      ret = bchlib_flushsector(bch);
-      if (ret < 0)
+  /* No.. read it and, on sequential access, the sectors after it */
+
+  count = 1;
+#if CONFIG_BCH_READAHEAD_NSECTORS > 1
+  if (sector == bch->lastsector + 1)
+    {
+      count = MIN(CONFIG_BCH_READAHEAD_NSECTORS, CONFIG_BCH_CACHE_NSECTORS);
+      count = MIN(count, bch->nsectors - sector);
+    }
+
+  /* Do not read sectors a second time that are cached already */
+
+  for (i = 1; i < count; i++)
+    {
+      if (bchlib_cachefind(bch, sector + i) != NULL)
         {
-          ferr("Flush failed: %zd\n", ret);
-          return (int)ret;
+          count = i;
+          break;
         }
+    }
+#endif
 
-      bch->sector = (size_t)-1;
+  /* Replace the adjacent entries beginning with the least recently used
+   * one.
+   */
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
-      if (ret < 0)
+  first = 0;
+  for (i = 1; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      if ((int32_t)(bch->sectors[i].lastuse -
+                    bch->sectors[first].lastuse) < 0)
         {
-          ferr("Read failed: %zd\n", ret);
-          return (int)ret;
+          first = i;
         }
+    }
+
+  if (first + count > CONFIG_BCH_CACHE_NSECTORS)
+    {
+      first = CONFIG_BCH_CACHE_NSECTORS - count;
+    }
+
+  ret = bchlib_writeback(bch, first, first + count - 1);
+  if (ret < 0)
+    {
+      ferr("Flush failed: %zd\n", ret);
+      return (int)ret;
+    }
+
+  cs           = &bch->sectors[first];
+  bch->current = NULL;
+  bch->buffer  = NULL;
 
-      bch->sector = sector;
+  for (i = 0; i < count; i++)
+    {
+      cs[i].sector = (size_t)-1;
+    }
+
+  inode = bch->inode;
+  ret = inode->u.i_bops->read(inode, cs->buffer, sector, count);
+  if (ret < 0)
+    {
+      ferr("Read failed: %zd\n", ret);
+      return (int)ret;
+    }
+  else if (ret < 1)
+    {
+      return -EIO;
+    }
+
+  for (i = 0; i < ret; i++)
+    {
+      cs[i].sector  = sector + i;
+      cs[i].lastuse = ++bch->usecount;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, &cs[i], CYPHER_DECRYPT);
 #endif
     }
 
-  return (int)ret;
+out:
+  cs->lastuse     = ++bch->usecount;
+  bch->current    = cs;
+  bch->buffer     = cs->buffer;
+  bch->lastsector = sector;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_cacheread
+ *
+ * Description:
+ *   Update a buffer that 'nsectors' sectors beginning with 'sector' were
+ *   read into directly from the media with the dirty sectors in the cache.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_cacheread(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                      size_t sector, size_t nsectors)
+{
+  FAR struct bchlib_sector_s *cs;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      cs = &bch->sectors[i];
+      if (cs->dirty && cs->sector >= sector &&
+          cs->sector < sector + nsectors)
+        {
+          memcpy(&buffer[(cs->sector - sector) * bch->sectsize],
+                 cs->buffer, bch->sectsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_cacheinval
+ *
+ * Description:
+ *   Drop the cached copies of 'nsectors' sectors beginning with 'sector'
+ *   after they were written directly to the media.  The sector cache must
+ *   have been flushed before.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_cacheinval(FAR struct bchlib_s *bch, size_t sector,
+                       size_t nsectors)
+{
+  FAR struct bchlib_sector_s *cs;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      cs = &bch->sectors[i];
+      if (cs->sector >= sector && cs->sector < sector + nsectors)
+        {
+          DEBUGASSERT(!cs->dirty);
+          cs->sector = (size_t)-1;
+          if (bch->current == cs)
+            {
+              bch->current = NULL;
+              bch->buffer  = NULL;
+            }
+        }
+    }
 }
@@ -80,6 +80,28 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
       return 0;
     }
 
+  /* Copy straight from the memory of a mapped block driver.  The sector
+   * cache never holds dirty sectors of one.
+   */
+
+  if (bch->xipbase != NULL)
+    {
+      size_t size = bch->nsectors * bch->sectsize;
+
+      if (offset >= size)
+        {
+          return 0;
+        }
+
+      if (len > size - offset)
+        {
+          len = size - offset;
+        }
+
+      memcpy(buffer, &bch->xipbase[offset], len);
+      return len;
+    }
+
   /* Convert the file position into a sector number an offset. */
 
   sector     = offset / bch->sectsize;
@@ -152,6 +174,10 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
           return ret;
         }
 
+      /* The cache may hold newer contents of the sectors read */
+
+      bchlib_cacheread(bch, (FAR uint8_t *)buffer, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector    += nsectors;
@@ -36,6 +36,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 
 #include "bch.h"
 
@@ -57,6 +58,7 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   FAR struct bchlib_s *bch;
   struct geometry geo;
   int ret;
+  int i;
 
   DEBUGASSERT(blkdev);
 
@@ -105,25 +107,51 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
   /* Save the geometry info and complete initialization of the structure */
 
   nxsem_init(&bch->sem, 0, 1);
-  bch->nsectors = geo.geo_nsectors;
-  bch->sectsize = geo.geo_sectorsize;
-  bch->sector   = (size_t)-1;
-  bch->readonly = readonly;
+  bch->nsectors   = geo.geo_nsectors;
+  bch->sectsize   = geo.geo_sectorsize;
+  bch->lastsector = (size_t)-1;
+  bch->readonly   = readonly;
 
-  /* Allocate the sector I/O buffer */
+#ifndef CONFIG_BCH_ENCRYPTION
+  /* Use the memory of the block driver directly if it is mapped, like a
+   * RAM disk.  The memory holds the encrypted data otherwise.
+   */
+
+  if (bch->inode->u.i_bops->ioctl != NULL)
+    {
+      FAR void *xipbase;
+
+      if (bch->inode->u.i_bops->ioctl(bch->inode, BIOC_XIPBASE,
+                              (unsigned long)((uintptr_t)&xipbase)) >= 0)
+        {
+          bch->xipbase = xipbase;
+        }
+    }
+#endif
+
+  /* Allocate the sector cache.  The sector buffers are adjacent so that
+   * consecutive sectors can be transferred at once.
+   */
 
 #if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-  bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
+  bch->cache = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT,
+                            bch->sectsize * CONFIG_BCH_CACHE_NSECTORS);
 #else
-  bch->buffer = kmm_malloc(bch->sectsize);
+  bch->cache = kmm_malloc(bch->sectsize * CONFIG_BCH_CACHE_NSECTORS);
 #endif
-  if (!bch->buffer)
+  if (!bch->cache)
     {
       ferr("ERROR: Failed to allocate sector buffer\n");
       ret = -ENOMEM;
       goto errout_with_bch;
     }
 
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      bch->sectors[i].sector = (size_t)-1;
+      bch->sectors[i].buffer = &bch->cache[i * bch->sectsize];
+    }
+
   *handle = bch;
   return OK;
 
@@ -70,9 +70,9 @@ int bchlib_teardown(FAR void *handle)
 
   /* Free the BCH state structure */
 
-  if (bch->buffer)
+  if (bch->cache)
     {
-      kmm_free(bch->buffer);
+      kmm_free(bch->cache);
     }
 
   nxsem_destroy(&bch->sem);
@@ -37,22 +37,22 @@
 #include "bch.h"
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: bchlib_write
+ * Name: bchlib_cachewrite
  *
  * Description:
- *   Write to the block device set-up by bchlib_setup as if it were a
- *   character device.
+ *   Write through the sector cache.  The partial sectors are left dirty in
+ *   the cache.
  *
  ****************************************************************************/
 
-ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
-        size_t len)
+static ssize_t bchlib_cachewrite(FAR struct bchlib_s *bch,
+                                 FAR const char *buffer, size_t offset,
+                                 size_t len)
 {
-  FAR struct bchlib_s *bch = (FAR struct bchlib_s *)handle;
   size_t   nsectors;
   size_t   sector;
   uint16_t sectoffset;
@@ -102,7 +102,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
         }
 
       memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      bch->current->dirty = true;
 
       /* Adjust pointers and counts */
 
@@ -149,6 +149,10 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           return ret;
         }
 
+      /* Drop the cached copies of the sectors written */
+
+      bchlib_cacheinval(bch, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector       += nsectors;
@@ -179,7 +183,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
       /* Copy the head end of the sector from the user buffer */
 
       memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      bch->current->dirty = true;
 
       /* Adjust counts */
 
@@ -188,3 +192,45 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
   return byteswritten;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_write
+ *
+ * Description:
+ *   Write to the block device set-up by bchlib_setup as if it were a
+ *   character device.
+ *
+ ****************************************************************************/
+
+ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
+        size_t len)
+{
+  FAR struct bchlib_s *bch = (FAR struct bchlib_s *)handle;
+  ssize_t byteswritten;
+  int ret;
+
+  byteswritten = bchlib_cachewrite(bch, buffer, offset, len);
+
+  /* The memory of a mapped block driver is read directly and may be
+   * written through a mapping of it.  Write the partial sectors through
+   * and drop them, so that neither the memory nor the cache goes stale.
+   */
+
+  if (byteswritten > 0 && bch->xipbase != NULL)
+    {
+      ret = bchlib_flushsector(bch);
+      if (ret < 0)
+        {
+          ferr("ERROR: Flush failed: %d\n", ret);
+          return ret;
+        }
+
+      bchlib_cacheinval(bch, 0, bch->nsectors);
+    }
+
+  return byteswritten;
+}
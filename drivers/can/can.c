@@ -364,6 +364,106 @@ static void can_txready_work(FAR void *arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: can_rdfilter_match
+ *
+ * Description:
+ *   Return true if the message passes the filters of the reader.
+ *
+ ****************************************************************************/
+
+#if CONFIG_CAN_NRDFILTERS > 0
+static bool can_rdfilter_match(FAR struct can_reader_s *reader,
+                               FAR const struct can_hdr_s *hdr)
+{
+  FAR const struct canioc_rdfilter_s *filter;
+  uint8_t extid = 0;
+  int i;
+
+  if (reader->nfilters == 0)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_CAN_ERRORS
+  /* The error reports are not messages of the bus, always pass them */
+
+  if (hdr->ch_error)
+    {
+      return true;
+    }
+#endif
+
+#ifdef CONFIG_CAN_EXTID
+  extid = hdr->ch_extid;
+#endif
+
+  for (i = 0; i < reader->nfilters; i++)
+    {
+      filter = &reader->filters[i];
+      if (filter->rf_extid == extid &&
+          ((hdr->ch_id ^ filter->rf_id) & filter->rf_mask) == 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: can_rdfilter_ioctl
+ *
+ * Description:
+ *   Handle CANIOC_ADD_RDFILTER and CANIOC_DEL_RDFILTERS.
+ *
+ ****************************************************************************/
+
+static int can_rdfilter_ioctl(FAR struct file *filep, int cmd,
+                              unsigned long arg)
+{
+  FAR struct can_reader_s *reader = filep->f_priv;
+  FAR const struct canioc_rdfilter_s *filter;
+  irqstate_t flags;
+  int ret = OK;
+
+  /* Only the files opened for reading have a reader */
+
+  if (reader == NULL)
+    {
+      return -EBADF;
+    }
+
+  flags = enter_critical_section();
+
+  if (cmd == CANIOC_DEL_RDFILTERS)
+    {
+      reader->nfilters = 0;
+    }
+  else
+    {
+      filter = (FAR const struct canioc_rdfilter_s *)((uintptr_t)arg);
+      if (filter == NULL || filter->rf_extid > 1 ||
+          filter->rf_id > (filter->rf_extid ? CAN_MAX_EXTMSGID :
+                                              CAN_MAX_STDMSGID))
+        {
+          ret = -EINVAL;
+        }
+      else if (reader->nfilters >= CONFIG_CAN_NRDFILTERS)
+        {
+          ret = -ENOSPC;
+        }
+      else
+        {
+          reader->filters[reader->nfilters++] = *filter;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 static FAR struct can_reader_s *init_can_reader(FAR struct file *filep)
 {
   FAR struct can_reader_s *reader = kmm_zalloc(sizeof(struct can_reader_s));
@@ -1039,6 +1139,17 @@ static int can_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
                           (FAR struct canioc_rtr_s *)((uintptr_t)arg));
         break;
 
+#if CONFIG_CAN_NRDFILTERS > 0
+      /* CANIOC_ADD_RDFILTER/CANIOC_DEL_RDFILTERS: Set the filters of the
+       * file, applied by the upper half.
+       */
+
+      case CANIOC_ADD_RDFILTER:
+      case CANIOC_DEL_RDFILTERS:
+        ret = can_rdfilter_ioctl(filep, cmd, arg);
+        break;
+#endif
+
       /* Not a "built-in" ioctl command.. perhaps it is unique to this
        * lower-half, device driver.
        */
@@ -1294,6 +1405,7 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
   FAR uint8_t             *dest;
   FAR struct list_node    *node;
   FAR struct list_node    *tmp;
+  bool                     notify = false;
   int                      nexttail;
   int                      errcode = -ENOMEM;
   int                      i;
@@ -1302,6 +1414,19 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
   caninfo("ID: %" PRId32 " DLC: %d\n", (uint32_t)hdr->ch_id, hdr->ch_dlc);
 
+#ifdef CONFIG_CAN_TIMESTAMP
+  /* Stamp the message now if the lower half has no hardware timestamp */
+
+  if (!dev->cd_hwtstamp)
+    {
+      struct timespec ts;
+
+      clock_systime_timespec(&ts);
+      hdr->ch_ts.tv_sec  = ts.tv_sec;
+      hdr->ch_ts.tv_usec = ts.tv_nsec / NSEC_PER_USEC;
+    }
+#endif
+
   /* Check if adding this new message would over-run the drivers ability to
    * enqueue read data.
    */
@@ -1365,6 +1490,16 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
       FAR struct can_reader_s *reader = (FAR struct can_reader_s *)node;
       fifo = &reader->fifo;
 
+#if CONFIG_CAN_NRDFILTERS > 0
+      /* Skip the readers that do not want the message */
+
+      if (!can_rdfilter_match(reader, hdr))
+        {
+          errcode = OK;
+          continue;
+        }
+#endif
+
       nexttail = fifo->rx_tail + 1;
       if (nexttail >= CONFIG_CAN_FIFOSIZE)
         {
@@ -1397,11 +1532,7 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
           fifo->rx_tail = nexttail;
 
-          /* Notify all poll/select waiters that they can read from the
-           * cd_recv buffer
-           */
-
-          can_pollnotify(dev, POLLIN);
+          notify = true;
 
           sval = 0;
           if (nxsem_get_value(&fifo->rx_sem, &sval) < 0)
@@ -1437,6 +1568,15 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 #endif
     }
 
+  /* Notify all poll/select waiters once that they can read from the
+   * cd_recv buffers.
+   */
+
+  if (notify)
+    {
+      can_pollnotify(dev, POLLIN);
+    }
+
   return errcode;
 }
 
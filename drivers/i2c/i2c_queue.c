@@ -0,0 +1,414 @@
+/****************************************************************************
+ * drivers/i2c/i2c_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_QUEUE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct i2c_queue_s
+{
+  FAR struct i2c_master_s *i2c;      /* The lower half of the bus */
+  FAR struct i2c_request_s *head;    /* The requests, by priority */
+  FAR struct i2c_request_s *active;  /* The request in progress */
+  sem_t wake;                        /* Posted when a request is queued */
+  sem_t exit;                        /* Posted when the queue is idle */
+  bool async;                        /* The lower half runs the requests */
+  bool stop;                         /* Stop the queue */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+#ifdef CONFIG_I2C_ASYNC
+static void i2c_queue_complete(FAR void *arg, int result);
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_remove
+ *
+ * Description:
+ *   Remove the request with the highest priority from the queue.  Called
+ *   in a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct i2c_request_s *
+i2c_queue_remove(FAR struct i2c_queue_s *queue)
+{
+  FAR struct i2c_request_s *req = queue->head;
+
+  if (req != NULL)
+    {
+      queue->head = req->flink;
+      req->flink  = NULL;
+    }
+
+  return req;
+}
+
+#ifdef CONFIG_I2C_ASYNC
+/****************************************************************************
+ * Name: i2c_queue_start
+ *
+ * Description:
+ *   Start the next request in the lower half, if the bus is idle.  Called
+ *   in a critical section.  The requests that fail to start are completed
+ *   with their error.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_start(FAR struct i2c_queue_s *queue)
+{
+  FAR struct i2c_request_s *req;
+  int ret;
+
+  while (queue->active == NULL && (req = i2c_queue_remove(queue)) != NULL)
+    {
+      queue->active = req;
+      ret = I2C_TRANSFER_ASYNC(queue->i2c, req->msgv, req->msgc,
+                               i2c_queue_complete, queue);
+      if (ret >= 0)
+        {
+          break;
+        }
+
+      queue->active = NULL;
+      req->done(req, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: i2c_queue_complete
+ *
+ * Description:
+ *   Called from the interrupt handler of the lower half when the request
+ *   in progress completes.  Start the next one right away.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_complete(FAR void *arg, int result)
+{
+  FAR struct i2c_queue_s *queue = arg;
+  FAR struct i2c_request_s *req;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  req = queue->active;
+  DEBUGASSERT(req != NULL);
+  queue->active = NULL;
+
+  req->done(req, result);
+
+  if (queue->stop)
+    {
+      nxsem_post(&queue->exit);
+    }
+  else
+    {
+      i2c_queue_start(queue);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: i2c_queue_thread
+ *
+ * Description:
+ *   Run the requests of the queue one at a time, for the lower halves that
+ *   do not support I2C_TRANSFER_ASYNC().
+ *
+ ****************************************************************************/
+
+static int i2c_queue_thread(int argc, FAR char *argv[])
+{
+  FAR struct i2c_queue_s *queue;
+  FAR struct i2c_request_s *req;
+  irqstate_t flags;
+  int ret;
+
+  queue = (FAR struct i2c_queue_s *)
+    ((uintptr_t)strtoul(argv[1], NULL, 16));
+
+  while (!queue->stop)
+    {
+      nxsem_wait_uninterruptible(&queue->wake);
+
+      flags = enter_critical_section();
+      req   = i2c_queue_remove(queue);
+      queue->active = req;
+      leave_critical_section(flags);
+
+      if (req != NULL)
+        {
+          ret = I2C_TRANSFER(queue->i2c, req->msgv, req->msgc);
+          queue->active = NULL;
+          req->done(req, ret);
+        }
+    }
+
+  nxsem_post(&queue->exit);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Create the queue of an I2C bus.  If the lower half supports
+ *   I2C_TRANSFER_ASYNC(), the requests run back-to-back from its interrupt
+ *   handler and their callbacks are called there.  Otherwise the queue
+ *   starts a thread that runs them with I2C_TRANSFER() and calls their
+ *   callbacks.  Either way, the callbacks must not block.
+ *
+ * Input Parameters:
+ *   i2c - An instance of the lower half I2C driver
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_queue_s *i2c_queue_initialize(FAR struct i2c_master_s *i2c)
+{
+  FAR struct i2c_queue_s *queue;
+  FAR char *argv[2];
+  char arg1[32];
+  int ret;
+
+  DEBUGASSERT(i2c != NULL);
+
+  queue = kmm_zalloc(sizeof(struct i2c_queue_s));
+  if (queue == NULL)
+    {
+      return NULL;
+    }
+
+  queue->i2c = i2c;
+  nxsem_init(&queue->wake, 0, 0);
+  nxsem_init(&queue->exit, 0, 0);
+  nxsem_set_protocol(&queue->wake, SEM_PRIO_NONE);
+  nxsem_set_protocol(&queue->exit, SEM_PRIO_NONE);
+
+#ifdef CONFIG_I2C_ASYNC
+  if (i2c->ops->transfer_async != NULL)
+    {
+      queue->async = true;
+      return queue;
+    }
+#endif
+
+  snprintf(arg1, sizeof(arg1), "%p", queue);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create("i2c_queue", CONFIG_I2C_QUEUE_PRIORITY,
+                       CONFIG_I2C_QUEUE_STACKSIZE, i2c_queue_thread, argv);
+  if (ret < 0)
+    {
+      i2cerr("ERROR: Failed to start the thread: %d\n", ret);
+      nxsem_destroy(&queue->wake);
+      nxsem_destroy(&queue->exit);
+      kmm_free(queue);
+      return NULL;
+    }
+
+  return queue;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_uninitialize
+ *
+ * Description:
+ *   Wait for the request in progress and free the queue.  The requests
+ *   still queued are completed with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void i2c_queue_uninitialize(FAR struct i2c_queue_s *queue)
+{
+  FAR struct i2c_request_s *req;
+  irqstate_t flags;
+  bool wait;
+
+  DEBUGASSERT(queue != NULL);
+
+  flags = enter_critical_section();
+  queue->stop = true;
+  wait = !queue->async || queue->active != NULL;
+
+  while ((req = i2c_queue_remove(queue)) != NULL)
+    {
+      req->done(req, -ECANCELED);
+    }
+
+  leave_critical_section(flags);
+
+  /* Wake up the thread, or wait for the lower half to complete the request
+   * in progress.
+   */
+
+  if (!queue->async)
+    {
+      nxsem_post(&queue->wake);
+    }
+
+  if (wait)
+    {
+      nxsem_wait_uninterruptible(&queue->exit);
+    }
+
+  nxsem_destroy(&queue->wake);
+  nxsem_destroy(&queue->exit);
+  kmm_free(queue);
+}
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Queue a request by priority, after the requests of the same priority,
+ *   and return without waiting for it.  This may be called from an
+ *   interrupt handler or from the callback of another request.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request, with its msgv, msgc, priority and done set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR struct i2c_request_s **prev;
+  irqstate_t flags;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+  DEBUGASSERT(req->msgv != NULL && req->done != NULL);
+
+  flags = enter_critical_section();
+
+  if (queue->stop)
+    {
+      leave_critical_section(flags);
+      return -ESHUTDOWN;
+    }
+
+  for (prev = &queue->head; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if ((*prev)->priority < req->priority)
+        {
+          break;
+        }
+    }
+
+  req->flink = *prev;
+  *prev      = req;
+
+#ifdef CONFIG_I2C_ASYNC
+  if (queue->async)
+    {
+      i2c_queue_start(queue);
+      leave_critical_section(flags);
+      return OK;
+    }
+#endif
+
+  leave_critical_section(flags);
+
+  nxsem_post(&queue->wake);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request that is not started yet from the queue.  Its done
+ *   callback is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -EBUSY if it is not in the queue
+ *   any longer.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR struct i2c_request_s **prev;
+  irqstate_t flags;
+  int ret = -EBUSY;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+
+  flags = enter_critical_section();
+
+  for (prev = &queue->head; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if (*prev == req)
+        {
+          *prev      = req->flink;
+          req->flink = NULL;
+          ret        = OK;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_I2C_QUEUE */
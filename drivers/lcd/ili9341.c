@@ -401,6 +401,10 @@ static inline uint16_t ili9341_getyres(FAR struct ili9341_dev_s *dev);
 static int ili9341_putrun(FAR struct lcd_dev_s *dev, fb_coord_t row,
                           fb_coord_t col,
                           FAR const uint8_t * buffer, size_t npixels);
+static int ili9341_putarea(FAR struct lcd_dev_s *dev,
+                           fb_coord_t row_start, fb_coord_t row_end,
+                           fb_coord_t col_start, fb_coord_t col_end,
+                           FAR const uint8_t *buffer, fb_coord_t stride);
 #ifndef CONFIG_LCD_NOGETRUN
 static int ili9341_getrun(FAR struct lcd_dev_s *dev, fb_coord_t row,
                           fb_coord_t col, FAR uint8_t * buffer,
@@ -614,6 +618,88 @@ static int ili9341_putrun(FAR struct lcd_dev_s *lcd_dev, fb_coord_t row,
   return OK;
 }
 
+/****************************************************************************
+ * Name:  ili9341_putarea
+ *
+ * Description:
+ *   Write a rectangular area to the LCD.  The area is selected once and
+ *   sent with a single memory write command, as one transfer if the rows
+ *   are contiguous in the buffer.
+ *
+ * Input Parameters:
+ *   lcd_dev   - The lcd device
+ *   row_start - Starting row to write to (range: 0 <= row < yres)
+ *   row_end   - Ending row to write to (range: row_start <= row < yres)
+ *   col_start - Starting column to write to (range: 0 <= col <= xres)
+ *   col_end   - Ending column to write to
+ *               (range: col_start <= col_end < xres)
+ *   buffer    - The buffer containing the area to be written to the LCD
+ *   stride    - Length of a line of the buffer in bytes
+ *
+ * Returned Value:
+ *
+ *   On success - OK
+ *   On error   - -EINVAL
+ *
+ ****************************************************************************/
+
+static int ili9341_putarea(FAR struct lcd_dev_s *lcd_dev,
+                           fb_coord_t row_start, fb_coord_t row_end,
+                           fb_coord_t col_start, fb_coord_t col_end,
+                           FAR const uint8_t *buffer, fb_coord_t stride)
+{
+  FAR struct ili9341_dev_s *dev = (FAR struct ili9341_dev_s *)lcd_dev;
+  FAR struct ili9341_lcd_s *lcd = dev->lcd;
+  size_t cols = col_end - col_start + 1;
+  size_t rows = row_end - row_start + 1;
+  size_t row;
+
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Check if position outside of area */
+
+  if (col_end >= ili9341_getxres(dev) || row_end >= ili9341_getyres(dev) ||
+      col_start > col_end || row_start > row_end)
+    {
+      return -EINVAL;
+    }
+
+  /* Select lcd driver */
+
+  lcd->select(lcd);
+
+  /* Select the area, the gram address wraps to the next row of the area */
+
+  ili9341_selectarea(lcd, col_start, row_start, col_end, row_end);
+
+  /* Send memory write cmd */
+
+  lcd->sendcmd(lcd, ILI9341_MEMORY_WRITE);
+
+  /* Send pixel to gram */
+
+  if (stride == cols * sizeof(uint16_t))
+    {
+      /* The rows are contiguous (a full screen or full rows update) */
+
+      lcd->sendgram(lcd, (FAR const uint16_t *)buffer, cols * rows);
+    }
+  else
+    {
+      for (row = 0; row < rows; row++)
+        {
+          lcd->sendgram(lcd, (FAR const uint16_t *)buffer, cols);
+          buffer += stride;
+        }
+    }
+
+  /* Deselect the lcd driver */
+
+  lcd->deselect(lcd);
+
+  return OK;
+}
+
 /****************************************************************************
  * Name:  ili9341_getrun
  *
@@ -840,6 +926,7 @@ static int ili9341_getplaneinfo(FAR struct lcd_dev_s *dev,
       FAR struct ili9341_dev_s *priv = (FAR struct ili9341_dev_s *)dev;
 
       pinfo->putrun = ili9341_putrun;
+      pinfo->putarea = ili9341_putarea;
 #ifndef CONFIG_LCD_NOGETRUN
       pinfo->getrun = ili9341_getrun;
 #endif
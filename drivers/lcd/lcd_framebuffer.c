@@ -32,6 +32,8 @@
 
 #include <nuttx/board.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/lcd/lcd.h>
 #include <nuttx/video/fb.h>
 
@@ -45,10 +47,32 @@
 
 #define VIDEO_PLANE 0
 
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+#  define LCDFB_FLUSHDELAY MSEC2TICK(CONFIG_LCD_FRAMEBUFFER_FLUSHDELAY)
+#endif
+
+#ifndef MIN
+#  define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* A rectangle of the framebuffer, with inclusive bounds */
+
+struct lcdfb_rect_s
+{
+  fb_coord_t startx;
+  fb_coord_t endx;
+  fb_coord_t starty;
+  fb_coord_t endy;
+};
+
 /* This structure describes the LCD framebuffer */
 
 struct lcdfb_dev_s
@@ -63,6 +87,15 @@ struct lcdfb_dev_s
   fb_coord_t yres;                  /* Vertical resolution in pixel rows */
   fb_coord_t stride;                /* Width of a row in bytes */
   uint8_t display;                  /* Display number */
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+  /* The areas updated since the last flush, merged as they come */
+
+  mutex_t lock;                     /* Protects the dirty rectangles */
+  struct work_s work;               /* Flushes the dirty rectangles */
+  uint8_t ndirty;                   /* Number of dirty rectangles */
+  struct lcdfb_rect_s dirty[CONFIG_LCD_FRAMEBUFFER_NDIRTY];
+#endif
 };
 
 /****************************************************************************
@@ -107,6 +140,10 @@ static int lcdfb_setcursor(FAR struct fb_vtable_s *vtable,
 
 static int lcdfb_setpower(FAR struct fb_vtable_s *vtable, FAR int power);
 
+#if defined(CONFIG_LCD_FRAMEBUFFER_DIRTY) && defined(CONFIG_FB_SYNC)
+static int lcdfb_waitforvsync(FAR struct fb_vtable_s *vtable);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -152,53 +189,49 @@ static FAR struct lcdfb_dev_s *lcdfb_find(int display)
 }
 
 /****************************************************************************
- * Name: lcdfb_updateearea
+ * Name: lcdfb_clip
  *
  * Description:
- * Update the LCD when there is a change to the framebuffer.
+ *   Clip an area to fit in the framebuffer.  A NULL area is the whole
+ *   framebuffer.
  *
  ****************************************************************************/
 
-static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
-                             FAR const struct fb_area_s *area)
+static void lcdfb_clip(FAR struct lcdfb_dev_s *priv,
+                       FAR const struct fb_area_s *area,
+                       FAR struct lcdfb_rect_s *rect)
 {
-  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
-  FAR struct lcd_planeinfo_s *pinfo = &priv->pinfo;
-  FAR uint8_t *run = priv->fbmem;
-  fb_coord_t row;
-  fb_coord_t startx = 0;
-  fb_coord_t endx = priv->xres - 1;
-  fb_coord_t width = priv->xres;
-  fb_coord_t starty = 0;
-  fb_coord_t endy = priv->yres - 1;
-  int ret;
+  rect->startx = 0;
+  rect->endx   = priv->xres - 1;
+  rect->starty = 0;
+  rect->endy   = priv->yres - 1;
 
   if (area != NULL)
     {
       /* Clip to fit in the framebuffer */
 
-      startx = area->x;
-      if (startx < 0)
+      rect->startx = area->x;
+      if (rect->startx < 0)
         {
-          startx = 0;
+          rect->startx = 0;
         }
 
-      endx = startx + area->w - 1;
-      if (endx >= priv->xres)
+      rect->endx = rect->startx + area->w - 1;
+      if (rect->endx >= priv->xres)
         {
-          endx = priv->xres - 1;
+          rect->endx = priv->xres - 1;
         }
 
-      starty = area->y;
-      if (starty < 0)
+      rect->starty = area->y;
+      if (rect->starty < 0)
         {
-          starty = 0;
+          rect->starty = 0;
         }
 
-      endy = starty + area->h - 1;
-      if (endy >= priv->yres)
+      rect->endy = rect->starty + area->h - 1;
+      if (rect->endy >= priv->yres)
         {
-          endy = priv->yres - 1;
+          rect->endy = priv->yres - 1;
         }
 
       /* If the display uses a value of BPP < 8, then we may have to extend
@@ -206,17 +239,35 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
        * BPP={1,2,4}
        */
 
-      if (pinfo->bpp < 8)
+      if (priv->pinfo.bpp < 8)
         {
-          unsigned int pixperbyte = 8 / pinfo->bpp;
-          startx &= ~(pixperbyte - 1);
+          unsigned int pixperbyte = 8 / priv->pinfo.bpp;
+          rect->startx &= ~(pixperbyte - 1);
         }
+    }
+}
+
+/****************************************************************************
+ * Name: lcdfb_putrect
+ *
+ * Description:
+ *   Write a rectangle of the framebuffer to the LCD.
+ *
+ ****************************************************************************/
+
+static int lcdfb_putrect(FAR struct lcdfb_dev_s *priv,
+                         FAR const struct lcdfb_rect_s *rect)
+{
+  FAR struct lcd_planeinfo_s *pinfo = &priv->pinfo;
+  FAR uint8_t *run;
+  fb_coord_t row;
+  fb_coord_t width;
+  int ret;
 
-      /* Get the starting position in the framebuffer */
+  /* Get the starting position in the framebuffer */
 
-      run  = priv->fbmem + starty * priv->stride;
-      run += (startx * pinfo->bpp + 7) >> 3;
-    }
+  run  = priv->fbmem + rect->starty * priv->stride;
+  run += (rect->startx * pinfo->bpp + 7) >> 3;
 
   if (pinfo->putarea != NULL)
     {
@@ -230,8 +281,8 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
        * - apply DMA channel to transfer data to driver memory.
        */
 
-      ret = pinfo->putarea(pinfo->dev, starty, endy, startx, endx,
-                           run, priv->stride);
+      ret = pinfo->putarea(pinfo->dev, rect->starty, rect->endy,
+                           rect->startx, rect->endx, run, priv->stride);
       if (ret < 0)
         {
           lcderr("Failed to update area");
@@ -240,11 +291,11 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
     }
   else
     {
-      width = endx - startx + 1;
+      width = rect->endx - rect->startx + 1;
 
-      for (row = starty; row <= endy; row++)
+      for (row = rect->starty; row <= rect->endy; row++)
         {
-          ret = pinfo->putrun(pinfo->dev, row, startx, run, width);
+          ret = pinfo->putrun(pinfo->dev, row, rect->startx, run, width);
           if (ret < 0)
             {
               lcderr("Failed to update row");
@@ -255,11 +306,191 @@ static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
         }
     }
 
-  if (pinfo->redraw != NULL)
+  return OK;
+}
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+/****************************************************************************
+ * Name: lcdfb_union
+ *
+ * Description:
+ *   Return the bounding rectangle of two rectangles, and the number of
+ *   pixels that it covers in excess of them.
+ *
+ ****************************************************************************/
+
+static uint32_t lcdfb_union(FAR const struct lcdfb_rect_s *a,
+                            FAR const struct lcdfb_rect_s *b,
+                            FAR struct lcdfb_rect_s *u)
+{
+  uint32_t area_a;
+  uint32_t area_b;
+  uint32_t area_u;
+
+  u->startx = MIN(a->startx, b->startx);
+  u->endx   = MAX(a->endx, b->endx);
+  u->starty = MIN(a->starty, b->starty);
+  u->endy   = MAX(a->endy, b->endy);
+
+  area_a = (uint32_t)(a->endx - a->startx + 1) * (a->endy - a->starty + 1);
+  area_b = (uint32_t)(b->endx - b->startx + 1) * (b->endy - b->starty + 1);
+  area_u = (uint32_t)(u->endx - u->startx + 1) * (u->endy - u->starty + 1);
+
+  /* Overlapping and adjacent rectangles merge for free */
+
+  return area_u > area_a + area_b ? area_u - area_a - area_b : 0;
+}
+
+/****************************************************************************
+ * Name: lcdfb_adddirty
+ *
+ * Description:
+ *   Add a rectangle to the dirty rectangles.  It is merged with the ones
+ *   that it overlaps or that it extends.  If there is no room left, it is
+ *   merged with the one that adds the fewest pixels to redraw.  Called with
+ *   the lock held.
+ *
+ ****************************************************************************/
+
+static void lcdfb_adddirty(FAR struct lcdfb_dev_s *priv,
+                           FAR const struct lcdfb_rect_s *rect)
+{
+  struct lcdfb_rect_s merged = *rect;
+  struct lcdfb_rect_s u;
+  uint32_t mincost;
+  uint32_t cost;
+  int best;
+  int i;
+
+  for (; ; )
+    {
+      mincost = UINT32_MAX;
+      best    = -1;
+
+      for (i = 0; i < priv->ndirty; i++)
+        {
+          cost = lcdfb_union(&merged, &priv->dirty[i], &u);
+          if (cost < mincost)
+            {
+              mincost = cost;
+              best    = i;
+            }
+        }
+
+      if (best < 0 ||
+          (mincost > 0 && priv->ndirty < CONFIG_LCD_FRAMEBUFFER_NDIRTY))
+        {
+          break;
+        }
+
+      /* Take the rectangle out and try again with the union, which may
+       * now overlap others.
+       */
+
+      lcdfb_union(&merged, &priv->dirty[best], &merged);
+      priv->dirty[best] = priv->dirty[--priv->ndirty];
+    }
+
+  priv->dirty[priv->ndirty++] = merged;
+}
+
+/****************************************************************************
+ * Name: lcdfb_flush
+ *
+ * Description:
+ *   Write the dirty rectangles to the LCD.
+ *
+ ****************************************************************************/
+
+static int lcdfb_flush(FAR struct lcdfb_dev_s *priv)
+{
+  struct lcdfb_rect_s dirty[CONFIG_LCD_FRAMEBUFFER_NDIRTY];
+  FAR struct lcd_planeinfo_s *pinfo = &priv->pinfo;
+  int ndirty;
+  int ret = OK;
+  int i;
+
+  /* Take the rectangles, the updates from now on go to the next flush */
+
+  nxmutex_lock(&priv->lock);
+  ndirty = priv->ndirty;
+  memcpy(dirty, priv->dirty, ndirty * sizeof(struct lcdfb_rect_s));
+  priv->ndirty = 0;
+  nxmutex_unlock(&priv->lock);
+
+  for (i = 0; i < ndirty && ret >= 0; i++)
+    {
+      ret = lcdfb_putrect(priv, &dirty[i]);
+    }
+
+  if (ndirty > 0 && pinfo->redraw != NULL)
     {
       pinfo->redraw(pinfo->dev);
     }
 
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lcdfb_flush_work
+ ****************************************************************************/
+
+static void lcdfb_flush_work(FAR void *arg)
+{
+  lcdfb_flush(arg);
+}
+#endif
+
+/****************************************************************************
+ * Name: lcdfb_updateearea
+ *
+ * Description:
+ * Update the LCD when there is a change to the framebuffer.
+ *
+ ****************************************************************************/
+
+static int lcdfb_updateearea(FAR struct fb_vtable_s *vtable,
+                             FAR const struct fb_area_s *area)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
+  struct lcdfb_rect_s rect;
+  int ret;
+
+  lcdfb_clip(priv, area, &rect);
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+  /* Only record the area.  The areas of the updates that come in a burst,
+   * (e.g. the widgets of one frame) are merged and written together.
+   */
+
+  ret = nxmutex_lock(&priv->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  lcdfb_adddirty(priv, &rect);
+
+  if (work_available(&priv->work))
+    {
+      work_queue(LPWORK, &priv->work, lcdfb_flush_work, priv,
+                 LCDFB_FLUSHDELAY);
+    }
+
+  nxmutex_unlock(&priv->lock);
+#else
+  ret = lcdfb_putrect(priv, &rect);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (priv->pinfo.redraw != NULL)
+    {
+      priv->pinfo.redraw(priv->pinfo.dev);
+    }
+#endif
+
   return OK;
 }
 
@@ -492,6 +723,26 @@ static int lcdfb_setpower(FAR struct fb_vtable_s *vtable, FAR int power)
   return ret;
 }
 
+/****************************************************************************
+ * Name: lcdfb_waitforvsync
+ *
+ * Description:
+ *   Write the pending updates to the LCD now.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_LCD_FRAMEBUFFER_DIRTY) && defined(CONFIG_FB_SYNC)
+static int lcdfb_waitforvsync(FAR struct fb_vtable_s *vtable)
+{
+  FAR struct lcdfb_dev_s *priv = (FAR struct lcdfb_dev_s *)vtable;
+
+  DEBUGASSERT(vtable != NULL);
+
+  work_cancel(LPWORK, &priv->work);
+  return lcdfb_flush(priv);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -517,7 +768,7 @@ int up_fbinitialize(int display)
   FAR struct lcdfb_dev_s *priv;
   FAR struct lcd_dev_s *lcd;
   struct fb_videoinfo_s vinfo;
-  struct fb_area_s area;
+  struct lcdfb_rect_s rect;
   int ret;
 
   lcdinfo("display=%d\n", display);
@@ -548,6 +799,13 @@ int up_fbinitialize(int display)
 #endif
   priv->vtable.updatearea   = lcdfb_updateearea,
   priv->vtable.setpower     = lcdfb_setpower,
+#if defined(CONFIG_LCD_FRAMEBUFFER_DIRTY) && defined(CONFIG_FB_SYNC)
+  priv->vtable.waitforvsync = lcdfb_waitforvsync,
+#endif
+
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+  nxmutex_init(&priv->lock);
+#endif
 
 #ifdef CONFIG_LCD_EXTERNINIT
   /* Use external graphics driver initialization */
@@ -623,16 +881,17 @@ int up_fbinitialize(int display)
 
   /* Write the entire framebuffer to the LCD */
 
-  area.x = 0;
-  area.y = 0;
-  area.w = priv->xres;
-  area.h = priv->yres;
+  lcdfb_clip(priv, NULL, &rect);
 
-  ret = lcdfb_updateearea(&priv->vtable, &area);
+  ret = lcdfb_putrect(priv, &rect);
   if (ret < 0)
     {
       lcderr("FB update failed: %d\n", ret);
     }
+  else if (priv->pinfo.redraw != NULL)
+    {
+      priv->pinfo.redraw(priv->pinfo.dev);
+    }
 
   /* Turn the LCD on at 75% power */
 
@@ -645,6 +904,9 @@ errout_with_lcd:
 #endif
 
 errout_with_state:
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+  nxmutex_destroy(&priv->lock);
+#endif
   kmm_free(priv);
   return ret;
 }
@@ -734,6 +996,11 @@ void up_fbuninitialize(int display)
           board_lcd_uninitialize();
 #endif
 
+#ifdef CONFIG_LCD_FRAMEBUFFER_DIRTY
+          work_cancel(LPWORK, &priv->work);
+          nxmutex_destroy(&priv->lock);
+#endif
+
           /* Free the frame buffer allocation */
 
           kmm_free(priv->fbmem);
@@ -43,8 +43,10 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/loop.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/drivers/rwbuffer.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -53,6 +55,10 @@
 #define loop_semgive(d) nxsem_post(&(d)->sem)  /* To match loop_semtake */
 #define MAX_OPENCNT     (255)                  /* Limit of uint8_t */
 
+#if defined(CONFIG_LOOP_READAHEAD) || defined(CONFIG_LOOP_WRITEBUFFER)
+#  define LOOP_HAVE_RWBUFFER 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -66,6 +72,18 @@ struct loop_struct_s
   uint8_t      opencnt;      /* Count of open references to the loop device */
   bool         writeenabled; /* true: can write to device */
   struct file  devfile;      /* File struct of char device/file */
+
+  /* Direct I/O to a backing block driver, without the intermediate
+   * buffering of the file system layer.
+   */
+
+  FAR struct inode *blkdrvr; /* The block driver, NULL for a file */
+  blkcnt_t     blkoffset;    /* The offset in sectors of the block driver */
+  uint16_t     blkper;       /* Sectors of the block driver per sector */
+
+#ifdef LOOP_HAVE_RWBUFFER
+  struct rwbuffer_s rwb;     /* Read-ahead/write buffer support */
+#endif
 };
 
 /****************************************************************************
@@ -82,6 +100,8 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors);
 static int     loop_geometry(FAR struct inode *inode,
                              FAR struct geometry *geometry);
+static int     loop_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg);
 
 /****************************************************************************
  * Private Data
@@ -94,7 +114,7 @@ static const struct block_operations g_bops =
   loop_read,     /* read */
   loop_write,    /* write */
   loop_geometry, /* geometry */
-  NULL           /* ioctl */
+  loop_ioctl     /* ioctl */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL         /* unlink */
 #endif
@@ -181,6 +201,10 @@ static int loop_close(FAR struct inode *inode)
           dev->opencnt--;
         }
 
+#ifdef CONFIG_LOOP_WRITEBUFFER
+      rwb_flush(&dev->rwb);
+#endif
+
       loop_semgive(dev);
     }
 
@@ -188,56 +212,149 @@ static int loop_close(FAR struct inode *inode)
 }
 
 /****************************************************************************
- * Name: loop_read
+ * Name: loop_reload
  *
- * Description:  Read the specified number of sectors
+ * Description:
+ *   Read sectors from the backing file or block driver.  This is also the
+ *   reload callout of the read-ahead buffer.
  *
  ****************************************************************************/
 
-static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
-                         blkcnt_t start_sector, unsigned int nsectors)
+static ssize_t loop_reload(FAR void *priv, FAR uint8_t *buffer,
+                           off_t start_sector, size_t nsectors)
 {
-  FAR struct loop_struct_s *dev;
-  ssize_t nbytesread;
+  FAR struct loop_struct_s *dev = priv;
+  size_t remaining;
+  ssize_t nread;
   off_t offset;
-  off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
+  if (dev->blkdrvr != NULL)
+    {
+      nread = dev->blkdrvr->u.i_bops->read(dev->blkdrvr, buffer,
+                                  dev->blkoffset +
+                                  start_sector * dev->blkper,
+                                  nsectors * dev->blkper);
+      return nread < 0 ? nread : nread / dev->blkper;
+    }
 
-  if (start_sector + nsectors > dev->nsectors)
+  /* Read at the offset of the sectors without moving the file position,
+   * so that there is no seek and concurrent requests do not race for it.
+   * A short read is continued, the file systems may return less than
+   * asked at their buffer or cluster boundaries.
+   */
+
+  offset    = start_sector * dev->sectsize + dev->offset;
+  remaining = nsectors * dev->sectsize;
+
+  while (remaining > 0)
     {
-      ferr("ERROR: Read past end of file\n");
-      return -EIO;
+      nread = file_pread(&dev->devfile, buffer, remaining, offset);
+      if (nread == -EINTR)
+        {
+          continue;
+        }
+      else if (nread < 0)
+        {
+          ferr("ERROR: Read failed: %zd\n", nread);
+          return nread;
+        }
+      else if (nread == 0)
+        {
+          break;
+        }
+
+      buffer    += nread;
+      offset    += nread;
+      remaining -= nread;
     }
 
-  /* Calculate the offset to read the sectors and seek to the position */
+  /* Return the number of sectors read */
 
-  offset = start_sector * dev->sectsize + dev->offset;
-  ret = file_seek(&dev->devfile, offset, SEEK_SET);
-  if (ret < 0)
+  return nsectors - remaining / dev->sectsize;
+}
+
+/****************************************************************************
+ * Name: loop_flush
+ *
+ * Description:
+ *   Write sectors to the backing file or block driver.  This is also the
+ *   flush callout of the write buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t loop_flush(FAR void *priv, FAR const uint8_t *buffer,
+                          off_t start_sector, size_t nsectors)
+{
+  FAR struct loop_struct_s *dev = priv;
+  size_t remaining;
+  ssize_t nwritten;
+  off_t offset;
+
+  if (dev->blkdrvr != NULL)
     {
-      ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
-      return -EIO;
+      nwritten = dev->blkdrvr->u.i_bops->write(dev->blkdrvr, buffer,
+                                      dev->blkoffset +
+                                      start_sector * dev->blkper,
+                                      nsectors * dev->blkper);
+      return nwritten < 0 ? nwritten : nwritten / dev->blkper;
     }
 
-  /* Then read the requested number of sectors from that position */
+  offset    = start_sector * dev->sectsize + dev->offset;
+  remaining = nsectors * dev->sectsize;
 
-  do
+  while (remaining > 0)
     {
-      nbytesread = file_read(&dev->devfile, buffer,
-                             nsectors * dev->sectsize);
-      if (nbytesread < 0 && nbytesread != -EINTR)
+      nwritten = file_pwrite(&dev->devfile, buffer, remaining, offset);
+      if (nwritten == -EINTR)
+        {
+          continue;
+        }
+      else if (nwritten < 0)
         {
-          ferr("ERROR: Read failed: %zd\n", nbytesread);
-          return (int)nbytesread;
+          ferr("ERROR: file_pwrite failed: %zd\n", nwritten);
+          return nwritten;
         }
+      else if (nwritten == 0)
+        {
+          break;
+        }
+
+      buffer    += nwritten;
+      offset    += nwritten;
+      remaining -= nwritten;
     }
-  while (nbytesread < 0);
 
-  /* Return the number of sectors read */
+  /* Return the number of sectors written */
+
+  return nsectors - remaining / dev->sectsize;
+}
+
+/****************************************************************************
+ * Name: loop_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct loop_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Read past end of file\n");
+      return -EIO;
+    }
 
-  return nbytesread / dev->sectsize;
+#ifdef LOOP_HAVE_RWBUFFER
+  return rwb_read(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return loop_reload(dev, buffer, start_sector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -252,39 +369,21 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct loop_struct_s *dev;
-  ssize_t nbyteswritten;
-  off_t offset;
-  off_t ret;
 
   DEBUGASSERT(inode && inode->i_private);
   dev = (FAR struct loop_struct_s *)inode->i_private;
 
-  /* Calculate the offset to write the sectors and seek to the position */
-
-  offset = start_sector * dev->sectsize + dev->offset;
-  ret = file_seek(&dev->devfile, offset, SEEK_SET);
-  if (ret < 0)
-    {
-      ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
-    }
-
-  /* Then write the requested number of sectors to that position */
-
-  do
+  if (start_sector + nsectors > dev->nsectors)
     {
-      nbyteswritten = file_write(&dev->devfile, buffer,
-                                 nsectors * dev->sectsize);
-      if (nbyteswritten < 0 && nbyteswritten != -EINTR)
-        {
-          ferr("ERROR: file_write failed: %zd\n", nbyteswritten);
-          return nbyteswritten;
-        }
+      ferr("ERROR: Write past end of file\n");
+      return -EIO;
     }
-  while (nbyteswritten < 0);
 
-  /* Return the number of sectors written */
-
-  return nbyteswritten / dev->sectsize;
+#ifdef LOOP_HAVE_RWBUFFER
+  return rwb_write(&dev->rwb, start_sector, nsectors, buffer);
+#else
+  return loop_flush(dev, buffer, start_sector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -314,6 +413,89 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: loop_ioctl
+ *
+ * Description: Flush the write buffer on BIOC_FLUSH
+ *
+ ****************************************************************************/
+
+static int loop_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  FAR struct loop_struct_s *dev;
+  int ret = -ENOTTY;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (cmd == BIOC_FLUSH)
+    {
+#ifdef CONFIG_LOOP_WRITEBUFFER
+      rwb_flush(&dev->rwb);
+#endif
+
+      /* Pass the flush on to the backing block driver */
+
+      ret = OK;
+      if (dev->blkdrvr != NULL && dev->blkdrvr->u.i_bops->ioctl != NULL)
+        {
+          ret = dev->blkdrvr->u.i_bops->ioctl(dev->blkdrvr, cmd, arg);
+          if (ret == -ENOTTY)
+            {
+              ret = OK;
+            }
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: loop_openblock
+ *
+ * Description:
+ *   If the backing file is a block driver whose sectors divide the sectors
+ *   and the offset of the loop device, use the driver directly.  Otherwise
+ *   the file is opened and accessed through the file system layer, which
+ *   for a block driver means one more copy through the sector buffer of
+ *   the block-to-character driver.
+ *
+ * Returned Value:
+ *   The size in bytes of the block driver on success; a negated errno
+ *   value if the file cannot be used directly.
+ *
+ ****************************************************************************/
+
+static off_t loop_openblock(FAR struct loop_struct_s *dev,
+                            FAR const char *filename, bool readonly)
+{
+  struct geometry geo;
+  FAR struct inode *inode;
+  int ret;
+
+  ret = open_blockdriver(filename, readonly ? MS_RDONLY : 0, &inode);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = inode->u.i_bops->geometry(inode, &geo);
+  if (ret < 0 || !geo.geo_available || geo.geo_sectorsize == 0 ||
+      dev->sectsize % geo.geo_sectorsize != 0 ||
+      dev->offset % geo.geo_sectorsize != 0)
+    {
+      close_blockdriver(inode);
+      return -ENOTBLK;
+    }
+
+  dev->blkdrvr      = inode;
+  dev->blkper       = dev->sectsize / geo.geo_sectorsize;
+  dev->blkoffset    = dev->offset / geo.geo_sectorsize;
+  dev->writeenabled = !readonly && geo.geo_writeenabled;
+
+  return (off_t)geo.geo_nsectors * geo.geo_sectorsize;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -332,6 +514,7 @@ int losetup(FAR const char *devname, FAR const char *filename,
 {
   FAR struct loop_struct_s *dev;
   struct stat sb;
+  off_t size;
   int ret;
 
   /* Sanity check */
@@ -343,23 +526,6 @@ int losetup(FAR const char *devname, FAR const char *filename,
     }
 #endif
 
-  /* Get the size of the file */
-
-  ret = nx_stat(filename, &sb, 1);
-  if (ret < 0)
-    {
-      ferr("ERROR: Failed to stat %s: %d\n", filename, ret);
-      return ret;
-    }
-
-  /* Check if the file system is big enough for one block */
-
-  if (sb.st_size - offset < sectsize)
-    {
-      ferr("ERROR: File is too small for blocksize\n");
-      return -ERANGE;
-    }
-
   /* Allocate a loop device structure */
 
   dev = (FAR struct loop_struct_s *)
@@ -372,37 +538,91 @@ int losetup(FAR const char *devname, FAR const char *filename,
   /* Initialize the loop device structure. */
 
   nxsem_init(&dev->sem, 0, 1);
-  dev->nsectors  = (sb.st_size - offset) / sectsize;
   dev->sectsize  = sectsize;
   dev->offset    = offset;
 
-  /* Open the file. */
-
-  /* First try to open the device R/W access (unless we are asked
-   * to open it readonly).
-   */
-
-  ret = -ENOSYS;
-  if (!readonly)
-    {
-      ret = file_open(&dev->devfile, filename, O_RDWR);
-    }
+  /* Use a backing block driver directly if possible */
 
-  if (ret >= 0)
-    {
-      dev->writeenabled = true; /* Success */
-    }
-  else
+  size = loop_openblock(dev, filename, readonly);
+  if (size < 0)
     {
-      /* If that fails, then try to open the device read-only */
+      /* Get the size of the file */
 
-      ret = file_open(&dev->devfile, filename, O_RDONLY);
+      ret = nx_stat(filename, &sb, 1);
       if (ret < 0)
         {
-          ferr("ERROR: Failed to open %s: %d\n", filename, ret);
+          ferr("ERROR: Failed to stat %s: %d\n", filename, ret);
           goto errout_with_dev;
         }
+
+      size = sb.st_size;
+
+      /* Open the file. */
+
+      /* First try to open the device R/W access (unless we are asked
+       * to open it readonly).
+       */
+
+      ret = -ENOSYS;
+      if (!readonly)
+        {
+          ret = file_open(&dev->devfile, filename, O_RDWR);
+        }
+
+      if (ret >= 0)
+        {
+          dev->writeenabled = true; /* Success */
+        }
+      else
+        {
+          /* If that fails, then try to open the device read-only */
+
+          ret = file_open(&dev->devfile, filename, O_RDONLY);
+          if (ret < 0)
+            {
+              ferr("ERROR: Failed to open %s: %d\n", filename, ret);
+              goto errout_with_dev;
+            }
+        }
+    }
+
+  /* Check if the file system is big enough for one block */
+
+  if (size - offset < sectsize)
+    {
+      ferr("ERROR: File is too small for blocksize\n");
+      ret = -ERANGE;
+      goto errout_with_file;
+    }
+
+  dev->nsectors = (size - offset) / sectsize;
+
+#ifdef LOOP_HAVE_RWBUFFER
+  /* Merge the sequential writes and read ahead of the sequential reads,
+   * so that the backing file sees few large transfers.  The write buffer
+   * is flushed by the work queue after a delay with no activity.
+   */
+
+  dev->rwb.blocksize     = sectsize;
+  dev->rwb.nblocks       = dev->nsectors;
+  dev->rwb.dev           = dev;
+  dev->rwb.wrflush       = loop_flush;
+  dev->rwb.rhreload      = loop_reload;
+
+#ifdef CONFIG_LOOP_WRITEBUFFER
+  dev->rwb.wrmaxblocks   = CONFIG_LOOP_BUFFER_SECTORS;
+#endif
+#ifdef CONFIG_LOOP_READAHEAD
+  dev->rwb.rhmaxblocks   = CONFIG_LOOP_BUFFER_SECTORS;
+#endif
+
+  ret = rwb_initialize(&dev->rwb);
+  if (ret < 0)
+    {
+      ferr("ERROR: rwb_initialize failed: %d\n", ret);
+      goto errout_with_file;
     }
+#endif
 
   /* Inode private data will be reference to the loop device structure */
 
@@ -410,15 +630,28 @@ int losetup(FAR const char *devname, FAR const char *filename,
   if (ret < 0)
     {
       ferr("ERROR: register_blockdriver failed: %d\n", -ret);
-      goto errout_with_file;
+      goto errout_with_rwb;
     }
 
   return OK;
 
+errout_with_rwb:
+#ifdef LOOP_HAVE_RWBUFFER
+  rwb_uninitialize(&dev->rwb);
+#endif
+
 errout_with_file:
-  file_close(&dev->devfile);
+  if (dev->blkdrvr != NULL)
+    {
+      close_blockdriver(dev->blkdrvr);
+    }
+  else
+    {
+      file_close(&dev->devfile);
+    }
 
 errout_with_dev:
+  nxsem_destroy(&dev->sem);
   kmm_free(dev);
   return ret;
 }
@@ -477,11 +710,21 @@ int loteardown(FAR const char *devname)
 
   /* Release the device structure */
 
-  if (dev->devfile.f_inode != NULL)
+#ifdef LOOP_HAVE_RWBUFFER
+  rwb_uninitialize(&dev->rwb);
+#endif
+
+  if (dev->blkdrvr != NULL)
+    {
+      close_blockdriver(dev->blkdrvr);
+    }
+  else if (dev->devfile.f_inode != NULL)
     {
       file_close(&dev->devfile);
     }
 
+  nxsem_destroy(&dev->sem);
+
   kmm_free(dev);
   return ret;
 }
@@ -30,7 +30,9 @@
 #include <assert.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <poll.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
@@ -65,6 +67,10 @@ struct rpmsgdev_s
                                       * safe.
                                       */
   int                   open_count;  /* Device open count */
+  mutex_t               pollock;     /* Serializes the poll setup, which does
+                                      * not wait for the other operations.
+                                      */
+  FAR struct pollfd    *fds[CONFIG_DEV_RPMSG_NPOLLWAITERS];
 };
 
 /* Rpmsg device cookie used to handle the response from the remote cpu */
@@ -93,6 +99,8 @@ static off_t   rpmsgdev_seek(FAR struct file *filep, off_t offset,
 static size_t  rpmsgdev_ioctl_arglen(int cmd);
 static int     rpmsgdev_ioctl(FAR struct file *filep, int cmd,
                               unsigned long arg);
+static int     rpmsgdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                             bool setup);
 
 /* Functions for sending data to the remote cpu */
 
@@ -114,6 +122,9 @@ static int     rpmsgdev_read_handler(FAR struct rpmsg_endpoint *ept,
 static int     rpmsgdev_ioctl_handler(FAR struct rpmsg_endpoint *ept,
                                       FAR void *data, size_t len,
                                       uint32_t src, FAR void *priv);
+static int     rpmsgdev_notify_handler(FAR struct rpmsg_endpoint *ept,
+                                       FAR void *data, size_t len,
+                                       uint32_t src, FAR void *priv);
 
 /* Functions for creating communication with remote cpu */
 
@@ -139,7 +150,9 @@ static const rpmsg_ept_cb g_rpmsgdev_handler[] =
   [RPMSGDEV_READ]  = rpmsgdev_read_handler,
   [RPMSGDEV_WRITE] = rpmsgdev_default_handler,
   [RPMSGDEV_LSEEK] = rpmsgdev_default_handler,
-  [RPMSGDEV_IOCTL] = rpmsgdev_ioctl_handler,
+  [RPMSGDEV_IOCTL]  = rpmsgdev_ioctl_handler,
+  [RPMSGDEV_POLL]   = rpmsgdev_default_handler,
+  [RPMSGDEV_NOTIFY] = rpmsgdev_notify_handler,
 };
 
 /* File operations */
@@ -152,7 +165,7 @@ const struct file_operations g_rpmsgdev_ops =
   rpmsgdev_write,         /* write */
   rpmsgdev_seek,          /* seek */
   rpmsgdev_ioctl,         /* ioctl */
-  NULL                    /* poll */
+  rpmsgdev_poll           /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL                  /* unlink */
 #endif
@@ -598,6 +611,155 @@ static int rpmsgdev_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   return ret;
 }
 
+/****************************************************************************
+ * Name: rpmsgdev_pollnotify
+ *
+ * Description:
+ *   Report the events of the device to the pollers.
+ *
+ ****************************************************************************/
+
+static void rpmsgdev_pollnotify(FAR struct rpmsgdev_s *dev,
+                                pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < CONFIG_DEV_RPMSG_NPOLLWAITERS; i++)
+    {
+      fds = dev->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= (fds->events | POLLERR | POLLHUP) & eventset;
+          if (fds->revents != 0)
+            {
+              poll_notify(fds);
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: rpmsgdev_poll
+ *
+ * Description:
+ *   Rpmsg-device poll operation.  The server polls the device for the
+ *   union of the events of the local pollers, and sends the events as they
+ *   occur, so that only the setup and the teardown are round trips.
+ *
+ * Parameters:
+ *   filep - the file instance
+ *   fds   - The structure describing the events to be monitored
+ *   setup - true: Setup up the poll; false: Teardown the poll
+ *
+ * Returned Values:
+ *   OK on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+static int rpmsgdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                         bool setup)
+{
+  FAR struct rpmsgdev_s *dev;
+  struct rpmsgdev_poll_s msg;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  /* Sanity checks */
+
+  DEBUGASSERT(filep->f_inode != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  dev = filep->f_inode->i_private;
+  DEBUGASSERT(dev != NULL);
+
+  /* Do not take excl, a read may block in the server until the events
+   * that the poll waits for.
+   */
+
+  ret = nxmutex_lock(&dev->pollock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_DEV_RPMSG_NPOLLWAITERS; i++)
+        {
+          if (dev->fds[i] == NULL)
+            {
+              dev->fds[i] = fds;
+              fds->priv   = &dev->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_DEV_RPMSG_NPOLLWAITERS)
+        {
+          leave_critical_section(flags);
+          ret = -EBUSY;
+          goto out;
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      *(FAR struct pollfd **)fds->priv = NULL;
+      fds->priv = NULL;
+    }
+
+  msg.events = 0;
+  for (i = 0; i < CONFIG_DEV_RPMSG_NPOLLWAITERS; i++)
+    {
+      if (dev->fds[i] != NULL)
+        {
+          msg.events |= dev->fds[i]->events;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  /* Tell the server the new union of the events, it returns the events
+   * already pending.
+   */
+
+  ret = rpmsgdev_send_recv(dev, RPMSGDEV_POLL, true, &msg.header,
+                           sizeof(msg), NULL);
+  if (!setup)
+    {
+      ret = OK;
+    }
+  else if (ret < 0)
+    {
+      flags = enter_critical_section();
+      *(FAR struct pollfd **)fds->priv = NULL;
+      fds->priv = NULL;
+      leave_critical_section(flags);
+    }
+  else
+    {
+      if (ret > 0)
+        {
+          rpmsgdev_pollnotify(dev, ret);
+        }
+
+      ret = OK;
+    }
+
+out:
+  nxmutex_unlock(&dev->pollock);
+  return ret;
+}
+
 /****************************************************************************
  * Name: rpmsgdev_get_tx_payload_buffer
  *
@@ -823,6 +985,35 @@ static int rpmsgdev_ioctl_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+/****************************************************************************
+ * Name: rpmsgdev_notify_handler
+ *
+ * Description:
+ *   Rpmsg-device poll event handler, this function will be called when the
+ *   server reports the events of the device.  There is no response.
+ *
+ * Parameters:
+ *   ept  - The rpmsg endpoint
+ *   data - The return message
+ *   len  - The return message length
+ *   src  - unknow
+ *   priv - unknow
+ *
+ * Returned Values:
+ *   Always OK
+ *
+ ****************************************************************************/
+
+static int rpmsgdev_notify_handler(FAR struct rpmsg_endpoint *ept,
+                                   FAR void *data, size_t len,
+                                   uint32_t src, FAR void *priv)
+{
+  FAR struct rpmsgdev_notify_s *msg = data;
+
+  rpmsgdev_pollnotify(ept->priv, msg->revents);
+  return 0;
+}
+
 /****************************************************************************
  * Name: rpmsgdev_ns_bound
  *
@@ -988,6 +1179,7 @@ int rpmsgdev_register(FAR const char *remotecpu, FAR const char *remotepath,
   dev->remotepath = remotepath;
 
   nxmutex_init(&dev->excl);
+  nxmutex_init(&dev->pollock);
 
   nxsem_init(&dev->wait, 0, 0);
   nxsem_set_protocol(&dev->wait, SEM_PRIO_NONE);
@@ -1030,6 +1222,7 @@ fail_with_rpmsg:
 
 fail:
   nxmutex_destroy(&dev->excl);
+  nxmutex_destroy(&dev->pollock);
   nxsem_destroy(&dev->wait);
   kmm_free(dev);
 
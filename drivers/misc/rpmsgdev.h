@@ -44,6 +44,8 @@
 #define RPMSGDEV_WRITE           4
 #define RPMSGDEV_LSEEK           5
 #define RPMSGDEV_IOCTL           6
+#define RPMSGDEV_POLL            7
+#define RPMSGDEV_NOTIFY          8
 
 /****************************************************************************
  * Public Types
@@ -92,6 +94,24 @@ begin_packed_struct struct rpmsgdev_ioctl_s
   char                     buf[1];
 } end_packed_struct;
 
+/* Set up the poll of the server for the events, or tear it down if events
+ * is zero.  The result is the events already pending.
+ */
+
+begin_packed_struct struct rpmsgdev_poll_s
+{
+  struct rpmsgdev_header_s header;
+  uint32_t                 events;
+} end_packed_struct;
+
+/* Sent by the server, without a response, when the events occur */
+
+begin_packed_struct struct rpmsgdev_notify_s
+{
+  struct rpmsgdev_header_s header;
+  uint32_t                 revents;
+} end_packed_struct;
+
 /****************************************************************************
  * Internal function prototypes
  ****************************************************************************/
@@ -25,8 +25,12 @@
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/drivers/rpmsgdev.h>
 #include <nuttx/rptun/openamp.h>
@@ -45,6 +49,12 @@ struct rpmsgdev_server_s
 {
   struct rpmsg_endpoint ept;
   struct file           file;
+#ifdef CONFIG_SCHED_WORKQUEUE
+  struct pollfd         fds;      /* The poll of the device for the client */
+  sem_t                 pollsem;  /* The semaphore of fds, never posted */
+  struct work_s         pollwork; /* Sends the events to the client */
+  bool                  polling;  /* fds is set up */
+#endif
 };
 
 /****************************************************************************
@@ -71,6 +81,9 @@ static int rpmsgdev_lseek_handler(FAR struct rpmsg_endpoint *ept,
 static int rpmsgdev_ioctl_handler(FAR struct rpmsg_endpoint *ept,
                                   FAR void *data, size_t len,
                                   uint32_t src, FAR void *priv);
+static int rpmsgdev_poll_handler(FAR struct rpmsg_endpoint *ept,
+                                 FAR void *data, size_t len,
+                                 uint32_t src, FAR void *priv);
 
 /* Functions for creating communication with client cpu */
 
@@ -97,12 +110,79 @@ static const rpmsg_ept_cb g_rpmsgdev_handler[] =
   [RPMSGDEV_WRITE] = rpmsgdev_write_handler,
   [RPMSGDEV_LSEEK] = rpmsgdev_lseek_handler,
   [RPMSGDEV_IOCTL] = rpmsgdev_ioctl_handler,
+  [RPMSGDEV_POLL]  = rpmsgdev_poll_handler,
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_WORKQUEUE
+/****************************************************************************
+ * Name: rpmsgdev_poll_worker
+ *
+ * Description:
+ *   Send the events that occurred since the last time to the client.  The
+ *   events that occur in the meantime are sent together.
+ *
+ ****************************************************************************/
+
+static void rpmsgdev_poll_worker(FAR void *arg)
+{
+  FAR struct rpmsgdev_server_s *server = arg;
+  struct rpmsgdev_notify_s msg;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  msg.revents = server->fds.revents;
+  server->fds.revents = 0;
+  leave_critical_section(flags);
+
+  if (msg.revents != 0)
+    {
+      msg.header.command = RPMSGDEV_NOTIFY;
+      msg.header.result  = 0;
+      msg.header.cookie  = 0;
+
+      rpmsg_send(&server->ept, &msg, sizeof(msg));
+    }
+}
+
+/****************************************************************************
+ * Name: rpmsgdev_poll_cb
+ *
+ * Description:
+ *   Called by poll_notify() of the device, possibly from its interrupt
+ *   handler.
+ *
+ ****************************************************************************/
+
+static void rpmsgdev_poll_cb(FAR struct pollfd *fds)
+{
+  FAR struct rpmsgdev_server_s *server = fds->arg;
+
+  if (work_available(&server->pollwork))
+    {
+      work_queue(LPWORK, &server->pollwork, rpmsgdev_poll_worker,
+                 server, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: rpmsgdev_poll_teardown
+ ****************************************************************************/
+
+static void rpmsgdev_poll_teardown(FAR struct rpmsgdev_server_s *server)
+{
+  if (server->polling)
+    {
+      file_poll(&server->file, &server->fds, false);
+      work_cancel(LPWORK, &server->pollwork);
+      server->polling = false;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: rpmsgdev_open_handler
  ****************************************************************************/
@@ -132,6 +212,9 @@ static int rpmsgdev_close_handler(FAR struct rpmsg_endpoint *ept,
   FAR struct rpmsgdev_server_s *server = ept->priv;
   FAR struct rpmsgdev_close_s *msg = data;
 
+#ifdef CONFIG_SCHED_WORKQUEUE
+  rpmsgdev_poll_teardown(server);
+#endif
   msg->header.result = file_close(&server->file);
 
   return rpmsg_send(ept, msg, sizeof(*msg));
@@ -251,6 +334,58 @@ static int rpmsgdev_ioctl_handler(FAR struct rpmsg_endpoint *ept,
   return rpmsg_send(ept, msg, len);
 }
 
+/****************************************************************************
+ * Name: rpmsgdev_poll_handler
+ ****************************************************************************/
+
+static int rpmsgdev_poll_handler(FAR struct rpmsg_endpoint *ept,
+                                 FAR void *data, size_t len,
+                                 uint32_t src, FAR void *priv)
+{
+  FAR struct rpmsgdev_poll_s *msg = data;
+#ifdef CONFIG_SCHED_WORKQUEUE
+  FAR struct rpmsgdev_server_s *server = ept->priv;
+  irqstate_t flags;
+  int ret = OK;
+
+  /* The client sends the union of the events of its pollers each time one
+   * of them comes or goes.  Replace the poll for the previous union.
+   */
+
+  rpmsgdev_poll_teardown(server);
+
+  if (msg->events != 0)
+    {
+      memset(&server->fds, 0, sizeof(server->fds));
+      server->fds.events = msg->events;
+      server->fds.sem    = &server->pollsem;
+      server->fds.arg    = server;
+      server->fds.cb     = rpmsgdev_poll_cb;
+
+      ret = file_poll(&server->file, &server->fds, true);
+      if (ret >= 0)
+        {
+          server->polling = true;
+
+          /* Return the events already pending, the later ones are sent
+           * by rpmsgdev_poll_worker().
+           */
+
+          flags = enter_critical_section();
+          ret = server->fds.revents;
+          server->fds.revents = 0;
+          leave_critical_section(flags);
+        }
+    }
+
+  msg->header.result = ret;
+#else
+  msg->header.result = -ENOSYS;
+#endif
+
+  return rpmsg_send(ept, msg, sizeof(*msg));
+}
+
 /****************************************************************************
  * Name: rpmsgdev_ns_match
  ****************************************************************************/
@@ -280,12 +415,19 @@ static void rpmsgdev_ns_bind(FAR struct rpmsg_device *rdev,
     }
 
   server->ept.priv = server;
+#ifdef CONFIG_SCHED_WORKQUEUE
+  nxsem_init(&server->pollsem, 0, 0);
+  nxsem_set_protocol(&server->pollsem, SEM_PRIO_NONE);
+#endif
 
   ret = rpmsg_create_ept(&server->ept, rdev, name,
                          RPMSG_ADDR_ANY, dest,
                          rpmsgdev_ept_cb, rpmsgdev_ns_unbind);
   if (ret < 0)
     {
+#ifdef CONFIG_SCHED_WORKQUEUE
+      nxsem_destroy(&server->pollsem);
+#endif
       kmm_free(server);
     }
 }
@@ -298,6 +440,10 @@ static void rpmsgdev_ns_unbind(FAR struct rpmsg_endpoint *ept)
 {
   FAR struct rpmsgdev_server_s *server = ept->priv;
 
+#ifdef CONFIG_SCHED_WORKQUEUE
+  rpmsgdev_poll_teardown(server);
+  nxsem_destroy(&server->pollsem);
+#endif
   file_close(&server->file);
   rpmsg_destroy_ept(&server->ept);
 
@@ -56,6 +56,14 @@
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#  define MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -159,9 +167,58 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_wrflushbuffer
+ *
+ * Description:
+ *   Write one buffer of 'nblocks' blocks starting at 'blockstart' to the
+ *   media, padded to a multiple of wralignblocks.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrflushbuffer(FAR struct rwbuffer_s *rwb,
+                              FAR uint8_t *buffer, off_t blockstart,
+                              size_t nblocks)
+{
+  size_t padblocks;
+  ssize_t ret;
+
+  finfo("Flushing: blockstart=0x%08lx nblocks=%zu from buffer=%p\n",
+        (long)blockstart, nblocks, buffer);
+
+  padblocks = nblocks % rwb->wralignblocks;
+  if (padblocks)
+    {
+      padblocks = rwb->wralignblocks - padblocks;
+      rwb_read_(rwb, blockstart + nblocks, padblocks,
+                &buffer[nblocks * rwb->blocksize]);
+      nblocks += padblocks;
+    }
+
+  /* Flush cache.  On success, the flush method will return the number
+   * of blocks written.  Anything other than the number requested is
+   * an error.
+   */
+
+  ret = rwb->wrflush(rwb->dev, buffer, blockstart, nblocks);
+  if (ret != nblocks)
+    {
+      ferr("ERROR: Error flushing write buffer: %zd\n", ret);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_wrflush
  *
+ * Description:
+ *   Flush the write buffer and all parked write buffers.  The buffers are
+ *   written in ascending block order so that the media sees one sweep.
+ *
  * Assumptions:
  *   The caller holds the wrsem semaphore.
  *
@@ -170,41 +227,173 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
 static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
 {
-  int ret;
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  FAR struct rwb_wrpark_s *park;
+  int i;
 
-  if (rwb->wrnblocks > 0)
+  for (; ; )
     {
-      size_t padblocks;
+      /* Find the parked buffer with the lowest blocks */
 
-      finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-            (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+      park = NULL;
+      for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+        {
+          if (rwb->wrpark[i].nblocks > 0 &&
+              (park == NULL ||
+               rwb->wrpark[i].blockstart < park->blockstart))
+            {
+              park = &rwb->wrpark[i];
+            }
+        }
 
-      padblocks = rwb->wrnblocks % rwb->wralignblocks;
-      if (padblocks)
+      if (park == NULL)
         {
-          padblocks = rwb->wralignblocks - padblocks;
-          rwb_read_(rwb, rwb->wrblockstart + rwb->wrnblocks, padblocks,
-                    &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-          rwb->wrnblocks += padblocks;
+          break;
         }
 
-      /* Flush cache.  On success, the flush method will return the number
-       * of blocks written.  Anything other than the number requested is
-       * an error.
-       */
+      /* The current buffer goes first if its blocks are lower */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      if (rwb->wrnblocks > 0 && rwb->wrblockstart < park->blockstart)
         {
-          ferr("ERROR: Error flushing write buffer: %d\n", ret);
+          rwb_wrflushbuffer(rwb, rwb->wrbuffer, rwb->wrblockstart,
+                            rwb->wrnblocks);
+          rwb_resetwrbuffer(rwb);
         }
 
+      rwb_wrflushbuffer(rwb, park->buffer, park->blockstart,
+                        park->nblocks);
+      park->nblocks = 0;
+    }
+#endif
+
+  if (rwb->wrnblocks > 0)
+    {
+      rwb_wrflushbuffer(rwb, rwb->wrbuffer, rwb->wrblockstart,
+                        rwb->wrnblocks);
       rwb_resetwrbuffer(rwb);
     }
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_wrpending
+ *
+ * Description:
+ *   Return true if any write buffer holds data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static bool rwb_wrpending(FAR struct rwbuffer_s *rwb)
+{
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+    {
+      if (rwb->wrpark[i].nblocks > 0)
+        {
+          return true;
+        }
+    }
+#endif
+
+  return rwb->wrnblocks > 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrpark
+ *
+ * Description:
+ *   Make the write buffer available for new blocks: Park its contents in a
+ *   free parked buffer or, if there is none, flush all buffers.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) && CONFIG_DRVR_WRNBUFFERS > 1
+static void rwb_wrpark(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwb_wrpark_s *park;
+  FAR uint8_t *buffer;
+  int i;
+
+  if (rwb->wrnblocks == 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+    {
+      park = &rwb->wrpark[i];
+      if (park->nblocks == 0)
+        {
+          /* Swap the buffers */
+
+          buffer            = park->buffer;
+          park->buffer      = rwb->wrbuffer;
+          park->blockstart  = rwb->wrblockstart;
+          park->nblocks     = rwb->wrnblocks;
+          rwb->wrbuffer     = buffer;
+          rwb_resetwrbuffer(rwb);
+          return;
+        }
+    }
+
+  rwb_wrflush(rwb);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrparked
+ *
+ * Description:
+ *   Prepare the parked buffers for a write.  A write that lies within a
+ *   parked buffer updates it and true is returned.  Parked buffers that
+ *   the write overlaps only in part are flushed first, so that no two
+ *   buffers ever hold the same block.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) && CONFIG_DRVR_WRNBUFFERS > 1
+static bool rwb_wrparked(FAR struct rwbuffer_s *rwb, off_t startblock,
+                         size_t nblocks, FAR const uint8_t *wrbuffer)
+{
+  FAR struct rwb_wrpark_s *park;
+  int i;
+
+  for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+    {
+      park = &rwb->wrpark[i];
+      if (park->nblocks == 0 ||
+          !rwb_overlap(park->blockstart, park->nblocks, startblock, nblocks))
+        {
+          continue;
+        }
+
+      if (startblock >= park->blockstart &&
+          startblock + nblocks <= park->blockstart + park->nblocks)
+        {
+          memcpy(park->buffer +
+                 (startblock - park->blockstart) * rwb->blocksize,
+                 wrbuffer, nblocks * rwb->blocksize);
+          return true;
+        }
+
+      rwb_wrflushbuffer(rwb, park->buffer, park->blockstart, park->nblocks);
+      park->nblocks = 0;
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_wrtimeout
  ****************************************************************************/
@@ -276,6 +465,16 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
 
   rwb_wrcanceltimeout(rwb);
 
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  /* Rewrites of parked blocks stay in RAM */
+
+  if (rwb_wrparked(rwb, startblock, nblocks, wrbuffer))
+    {
+      rwb_wrstarttimeout(rwb);
+      return nwritten;
+    }
+#endif
+
   /* Is data saved in the write buffer? */
 
   if (rwb->wrnblocks > 0)
@@ -399,9 +598,13 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
     }
   else if (nblocks)
     {
-      /* Flush the write buffer */
+      /* Flush or park the write buffer */
 
+#if CONFIG_DRVR_WRNBUFFERS > 1
+      rwb_wrpark(rwb);
+#else
       rwb_wrflush(rwb);
+#endif
 
       /* Buffer the data in the write buffer */
 
@@ -410,7 +613,7 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
       rwb->wrnblocks    = nblocks;
     }
 
-  if (rwb->wrnblocks > 0)
+  if (rwb_wrpending(rwb))
     {
       rwb_wrstarttimeout(rwb);
     }
@@ -475,10 +678,10 @@ rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock,
+                        size_t nblocks)
 {
   off_t  endblock;
-  size_t nblocks;
   int    ret;
 
   /* Check for attempts to read beyond the end of the media */
@@ -488,11 +691,11 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
       return -ESPIPE;
     }
 
-  /* Get the block number +1 of the last block that will fit in the
-   * read-ahead buffer
+  /* Get the block number +1 of the last block to read.  That is no more
+   * than what fits in the read-ahead buffer.
    */
 
-  endblock = startblock + rwb->rhmaxblocks;
+  endblock = startblock + MIN(nblocks, rwb->rhmaxblocks);
 
   /* Make sure that we don't read past the end of the device */
 
@@ -542,6 +745,46 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
 {
   int ret = OK;
 
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  /* Drop the parked buffers within the region.  Those overlapping it only
+   * in part are flushed with the rest.
+   */
+
+  if (rwb->wrmaxblocks > 0)
+    {
+      FAR struct rwb_wrpark_s *park;
+      int i;
+
+      ret = rwb_semtake(&rwb->wrsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+        {
+          park = &rwb->wrpark[i];
+          if (park->nblocks == 0 ||
+              !rwb_overlap(park->blockstart, park->nblocks,
+                           startblock, blockcount))
+            {
+              continue;
+            }
+
+          if (park->blockstart < startblock ||
+              park->blockstart + park->nblocks > startblock + blockcount)
+            {
+              rwb_wrflushbuffer(rwb, park->buffer, park->blockstart,
+                                park->nblocks);
+            }
+
+          park->nblocks = 0;
+        }
+
+      rwb_semgive(&rwb->wrsem);
+    }
+#endif
+
   /* Is there a write buffer?  Is data saved in the write buffer? */
 
   if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
@@ -802,6 +1045,9 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 int rwb_initialize(FAR struct rwbuffer_s *rwb)
 {
   uint32_t allocsize;
+#if defined(CONFIG_DRVR_WRITEBUFFER) && CONFIG_DRVR_WRNBUFFERS > 1
+  int i;
+#endif
 
   /* Sanity checking */
 
@@ -815,6 +1061,9 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
   DEBUGASSERT(rwb->wrflush != NULL);
   rwb->wrbuffer = NULL;
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  memset(rwb->wrpark, 0, sizeof(rwb->wrpark));
+#endif
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
   DEBUGASSERT(rwb->rhreload != NULL);
@@ -853,6 +1102,20 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
         }
 
       finfo("Write buffer size: %" PRIu32 " bytes\n", allocsize);
+
+#if CONFIG_DRVR_WRNBUFFERS > 1
+      for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+        {
+          rwb->wrpark[i].nblocks = 0;
+          rwb->wrpark[i].buffer  = kmm_malloc(allocsize);
+          if (rwb->wrpark[i].buffer == NULL)
+            {
+              ferr("Write buffer kmm_malloc(%" PRIu32 ") failed\n",
+                   allocsize);
+              return -ENOMEM;
+            }
+        }
+#endif
     }
 #endif /* CONFIG_DRVR_WRITEBUFFER */
 
@@ -868,6 +1131,8 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
       /* Initialize read-ahead buffer parameters */
 
       rwb_resetrhbuffer(rwb);
+      rwb->rhwindow    = 0;
+      rwb->rhnextblock = -1;
 
       /* Allocate the read-ahead buffer */
 
@@ -893,6 +1158,10 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
 void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 {
+#if defined(CONFIG_DRVR_WRITEBUFFER) && CONFIG_DRVR_WRNBUFFERS > 1
+  int i;
+
+#endif
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -903,6 +1172,16 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
         {
           kmm_free(rwb->wrbuffer);
         }
+
+#if CONFIG_DRVR_WRNBUFFERS > 1
+      for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+        {
+          if (rwb->wrpark[i].buffer)
+            {
+              kmm_free(rwb->wrpark[i].buffer);
+            }
+        }
+#endif
     }
 #endif
 
@@ -938,6 +1217,23 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
           return ret;
         }
 
+      /* Detect sequential streams:  The read-ahead doubles while each read
+       * continues the previous one.  Other reads load only the blocks
+       * requested.
+       */
+
+      if (startblock == rwb->rhnextblock)
+        {
+          rwb->rhwindow = MIN(2 * MAX(rwb->rhwindow, nblocks),
+                              rwb->rhmaxblocks);
+        }
+      else
+        {
+          rwb->rhwindow = 0;
+        }
+
+      rwb->rhnextblock = startblock + nblocks;
+
       /* Loop until we have read all of the requested blocks */
 
       for (remaining = nblocks; remaining > 0; )
@@ -973,7 +1269,8 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 
           if (remaining > 0)
             {
-              ret = rwb_rhreload(rwb, startblock);
+              ret = rwb_rhreload(rwb, startblock,
+                                 MAX(remaining, rwb->rhwindow));
               if (ret < 0)
                 {
                   ferr("ERROR: Failed to fill the read-ahead buffer: %d\n",
@@ -1032,17 +1329,57 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
           return ret;
         }
 
-      /* If the write buffer overlaps the block(s) requested */
+      /* Take the blocks held by the write buffers from there and the
+       * blocks in front of each of them from the media.  The buffers never
+       * overlap each other.
+       */
 
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
-                      nblocks))
+      while (nblocks > 0)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
+          FAR uint8_t *buffer = NULL;
+          off_t blockstart = 0;
+          size_t bufnblocks = 0;
+          size_t rdblocks;
+          size_t wrnpass = 0;
+#if CONFIG_DRVR_WRNBUFFERS > 1
+          int i;
+#endif
+
+          /* Find the overlapping buffer with the lowest blocks */
+
+          if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
+                          nblocks))
+            {
+              buffer     = rwb->wrbuffer;
+              blockstart = rwb->wrblockstart;
+              bufnblocks = rwb->wrnblocks;
+            }
+
+#if CONFIG_DRVR_WRNBUFFERS > 1
+          for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+            {
+              FAR struct rwb_wrpark_s *park = &rwb->wrpark[i];
+
+              if (park->nblocks > 0 &&
+                  rwb_overlap(park->blockstart, park->nblocks, startblock,
+                              nblocks) &&
+                  (buffer == NULL || park->blockstart < blockstart))
+                {
+                  buffer     = park->buffer;
+                  blockstart = park->blockstart;
+                  bufnblocks = park->nblocks;
+                }
+            }
+#endif
 
-          if (rwb->wrblockstart > startblock)
+          if (buffer == NULL)
             {
-              rdblocks = rwb->wrblockstart - startblock;
+              break;
+            }
+
+          if (blockstart > startblock)
+            {
+              rdblocks = blockstart - startblock;
               ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
               if (ret < 0)
                 {
@@ -1056,15 +1393,14 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
               readblocks += ret;
             }
 
-          if (rwb->wrblockstart < startblock)
+          if (blockstart < startblock)
             {
-              wrnpass = startblock - rwb->wrblockstart;
+              wrnpass = startblock - blockstart;
             }
 
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
+          rdblocks = MIN(nblocks, bufnblocks - wrnpass);
+          memcpy(rdbuffer, &buffer[wrnpass * rwb->blocksize],
+                 rdblocks * rwb->blocksize);
 
           startblock += rdblocks;
           nblocks    -= rdblocks;
@@ -1203,9 +1539,15 @@ ssize_t rwb_readbytes(FAR struct rwbuffer_s *dev, off_t offset,
 #ifdef CONFIG_DRVR_REMOVABLE
 int rwb_mediaremoved(FAR struct rwbuffer_s *rwb)
 {
+  int ret;
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
+#if CONFIG_DRVR_WRNBUFFERS > 1
+      int i;
+#endif
+
       ret = rwb_semtake(&rwb->wrsem);
       if (ret < 0)
         {
@@ -1213,6 +1555,13 @@ int rwb_mediaremoved(FAR struct rwbuffer_s *rwb)
         }
 
       rwb_resetwrbuffer(rwb);
+#if CONFIG_DRVR_WRNBUFFERS > 1
+      for (i = 0; i < CONFIG_DRVR_WRNBUFFERS - 1; i++)
+        {
+          rwb->wrpark[i].nblocks = 0;
+        }
+#endif
+
       rwb_semgive(&rwb->wrsem);
     }
 #endif
@@ -51,6 +51,7 @@
 #include <nuttx/sdio.h>
 #include <nuttx/mmcsd.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/drivers/rwbuffer.h>
 
 #include "mmcsd.h"
 #include "mmcsd_sdio.h"
@@ -95,6 +96,16 @@
 
 #define MMCSD_CAPACITY(b, s)    ((s) >= 10 ? (b) << ((s) - 10) : (b) >> (10 - (s)))
 
+/* The largest block count of CMD23 SET_BLOCK_COUNT */
+
+#define MMCSD_CMD23_MAXBLOCKS   0xffff
+
+/* Check if read/write buffer support is needed */
+
+#if defined(CONFIG_MMCSD_WRITEBUFFER) || defined(CONFIG_MMCSD_READAHEAD)
+#  define MMCSD_HAVE_RWBUFFER   1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -116,6 +127,11 @@ struct mmcsd_state_s
   uint8_t wrprotect:1;             /* true: Card is write protected (from CSD) */
   uint8_t locked:1;                /* true: Media is locked (from R1) */
   uint8_t dsrimp:1;                /* true: card supports CMD4/DSR setting (from CSD) */
+  uint8_t cmd23:1;                 /* true: card supports CMD23 SET_BLOCK_COUNT */
+#ifdef MMCSD_HAVE_RWBUFFER
+  uint8_t rwbinit:1;               /* true: rwb has been initialized */
+  uint8_t rwbready:1;              /* true: rwb matches the card geometry */
+#endif
 #ifdef CONFIG_SDIO_DMA
   uint8_t dma:1;                   /* true: hardware supports DMA */
 #endif
@@ -132,6 +148,10 @@ struct mmcsd_state_s
   uint8_t  blockshift;             /* Log2 of blocksize */
   uint16_t blocksize;              /* Read block length (== block size) */
   uint32_t nblocks;                /* Number of blocks */
+
+#ifdef MMCSD_HAVE_RWBUFFER
+  struct rwbuffer_s rwb;           /* Read-ahead/write-behind buffers */
+#endif
 };
 
 /****************************************************************************
@@ -176,6 +196,10 @@ static int     mmcsd_eventwait(FAR struct mmcsd_state_s *priv,
 static int     mmcsd_transferready(FAR struct mmcsd_state_s *priv);
 #if MMCSD_MULTIBLOCK_LIMIT != 1
 static int     mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv);
+#ifdef CONFIG_MMCSD_CMD23
+static int     mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                 uint32_t nblocks);
+#endif
 #endif
 static int     mmcsd_setblocklen(FAR struct mmcsd_state_s *priv,
                  uint32_t blocklen);
@@ -192,6 +216,13 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
                  FAR const uint8_t *buffer, off_t startblock,
                  size_t nblocks);
 #endif
+static ssize_t mmcsd_reload(FAR void *dev, FAR uint8_t *buffer,
+                 off_t startblock, size_t nblocks);
+static ssize_t mmcsd_flush(FAR void *dev, FAR const uint8_t *buffer,
+                 off_t startblock, size_t nblocks);
+#ifdef MMCSD_HAVE_RWBUFFER
+static void    mmcsd_rwbsetup(FAR struct mmcsd_state_s *priv);
+#endif
 
 /* Block driver methods *****************************************************/
 
@@ -559,6 +590,17 @@ static void mmcsd_decode_csd(FAR struct mmcsd_state_s *priv, uint32_t csd[4])
    *   TRANSFER_RATE_UNIT 2:0   Rate mantissa
    */
 
+#ifdef CONFIG_MMCSD_CMD23
+  /* MMC cards support CMD23 SET_BLOCK_COUNT since the version 3.1 of the
+   * specification (SPEC_VERS 3).  SD cards tell it in their SCR.
+   */
+
+  if (IS_MMC(priv->type))
+    {
+      priv->cmd23 = ((csd[0] >> 26) & 0x0f) >= 3;
+    }
+#endif
+
 #ifdef CONFIG_DEBUG_FS_INFO
   memset(&decoded, 0, sizeof(struct mmcsd_csd_s));
   decoded.csdstructure               =  csd[0] >> 30;
@@ -977,6 +1019,18 @@ static void mmcsd_decode_scr(FAR struct mmcsd_state_s *priv, uint32_t scr[2])
   priv->buswidth     = (scr[0] >> 8) & 15;
 #endif
 
+  /* CMD_SUPPORT, bits 35:32 of the SD 3.0 SCR:  Bit 33 tells that CMD23
+   * SET_BLOCK_COUNT is supported.
+   */
+
+#ifdef CONFIG_MMCSD_CMD23
+#ifdef CONFIG_ENDIAN_BIG
+  priv->cmd23        = (scr[0] >> 1) & 1;
+#else
+  priv->cmd23        = (scr[0] >> 25) & 1;
+#endif
+#endif
+
 #ifdef CONFIG_DEBUG_FS_INFO
 #ifdef CONFIG_ENDIAN_BIG
   /* Card SCR is big-endian order / CPU also big-endian
@@ -1303,6 +1357,35 @@ static int mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv)
 }
 #endif
 
+/****************************************************************************
+ * Name: mmcsd_setblockcount
+ *
+ * Description:
+ *   Send SET_BLOCK_COUNT before a multiple block transfer, that then ends
+ *   by itself after 'nblocks' blocks:  The card knows the size of the
+ *   transfer beforehand and no STOP_TRANSMISSION is needed.
+ *
+ ****************************************************************************/
+
+#if MMCSD_MULTIBLOCK_LIMIT != 1 && defined(CONFIG_MMCSD_CMD23)
+static int mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                               uint32_t nblocks)
+{
+  int ret;
+
+  /* Send CMD23, SET_BLOCK_COUNT, and verify good R1 return status */
+
+  mmcsd_sendcmdpoll(priv, MMCSD_CMD23, nblocks);
+  ret = mmcsd_recv_r1(priv, MMCSD_CMD23);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmcsd_recv_r1 for CMD23 failed: %d\n", ret);
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_setblocklen
  *
@@ -1487,6 +1570,7 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
 {
   size_t nbytes = nblocks << priv->blockshift;
   off_t  offset;
+  bool   cmd23 = false;
   int ret;
 
   finfo("startblock=%jd nblocks=%zu\n", (intmax_t)startblock, nblocks);
@@ -1555,6 +1639,21 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_CMD23
+  /* Pre-define the number of blocks if the card supports it */
+
+  if (priv->cmd23 && nblocks <= MMCSD_CMD23_MAXBLOCKS)
+    {
+      ret = mmcsd_setblockcount(priv, nblocks);
+      if (ret != OK)
+        {
+          return ret;
+        }
+
+      cmd23 = true;
+    }
+#endif
+
   /* Configure SDIO controller hardware for the read transfer */
 
   SDIO_BLOCKSETUP(priv->dev, priv->blocksize, nblocks);
@@ -1601,13 +1700,15 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
-  /* Send STOP_TRANSMISSION */
-
-  ret = mmcsd_stoptransmission(priv);
+  /* Send STOP_TRANSMISSION, unless the count of blocks was pre-defined */
 
-  if (ret != OK)
+  if (!cmd23)
     {
-      ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
+      ret = mmcsd_stoptransmission(priv);
+      if (ret != OK)
+        {
+          ferr("ERROR: mmcsd_stoptransmission failed: %d\n", ret);
+        }
     }
 
   /* On success, return the number of blocks read */
@@ -1798,6 +1899,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
 {
   size_t nbytes = nblocks << priv->blockshift;
   off_t  offset;
+  bool   cmd23 = false;
   int ret;
   int evret = OK;
 
@@ -1869,13 +1971,30 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_CMD23
+  /* Pre-define the number of blocks if the card supports it.  This also
+   * tells the card how many blocks to pre-erase.
+   */
+
+  if (priv->cmd23 && nblocks <= MMCSD_CMD23_MAXBLOCKS)
+    {
+      ret = mmcsd_setblockcount(priv, nblocks);
+      if (ret != OK)
+        {
+          return ret;
+        }
+
+      cmd23 = true;
+    }
+#endif
+
   /* If this is an SD card, then send ACMD23 (SET_WR_BLK_ERASE_COUNT) just
    * before sending CMD25 (WRITE_MULTIPLE_BLOCK).  This sets the number of
    * write blocks to be pre-erased and might make the following multiple
    * block write command faster.
    */
 
-  if (IS_SD(priv->type))
+  if (IS_SD(priv->type) && !cmd23)
     {
       /* Send CMD55, APP_CMD, a verify that good R1 status is returned */
 
@@ -1975,9 +2094,15 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
        */
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION, unless the count of blocks was pre-defined
+   * and the transfer went well.
+   */
+
+  if (!cmd23 || evret != OK)
+    {
+      ret = mmcsd_stoptransmission(priv);
+    }
 
-  ret = mmcsd_stoptransmission(priv);
   if (evret != OK)
     {
       return evret;
@@ -2055,6 +2180,15 @@ static int mmcsd_close(FAR struct inode *inode)
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct mmcsd_state_s *)inode->i_private;
 
+#ifdef CONFIG_MMCSD_WRITEBUFFER
+  /* Write the buffered sectors before the card may be removed */
+
+  if (priv->rwbready)
+    {
+      rwb_flush(&priv->rwb);
+    }
+#endif
+
   /* Decrement the reference count on the block driver */
 
   DEBUGASSERT(priv->crefs > 0);
@@ -2070,27 +2204,24 @@ static int mmcsd_close(FAR struct inode *inode)
 }
 
 /****************************************************************************
- * Name: mmcsd_read
+ * Name: mmcsd_reload
  *
  * Description:
- *   Read the specified number of sectors from the read-ahead buffer or from
- *   the physical device.
+ *   Read the specified number of sectors from the physical device.
  *
  ****************************************************************************/
 
-static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
-                          blkcnt_t startsector, unsigned int nsectors)
+static ssize_t mmcsd_reload(FAR void *dev, FAR uint8_t *buffer,
+                            off_t startsector, size_t nsectors)
 {
-  FAR struct mmcsd_state_s *priv;
+  FAR struct mmcsd_state_s *priv = (FAR struct mmcsd_state_s *)dev;
   size_t sector;
   size_t endsector;
   ssize_t nread;
   ssize_t ret = nsectors;
 
-  DEBUGASSERT(inode && inode->i_private);
-  priv = (FAR struct mmcsd_state_s *)inode->i_private;
-  finfo("startsector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
-        startsector, nsectors, priv->blocksize);
+  finfo("startsector: %jd nsectors: %zu sectorsize: %d\n",
+        (intmax_t)startsector, nsectors, priv->blocksize);
 
   if (nsectors > 0)
     {
@@ -2147,28 +2278,24 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
 }
 
 /****************************************************************************
- * Name: mmcsd_write
+ * Name: mmcsd_flush
  *
  * Description:
- *   Write the specified number of sectors to the write buffer or to the
- *   physical device.
+ *   Write the specified number of sectors to the physical device.
  *
  ****************************************************************************/
 
-static ssize_t mmcsd_write(FAR struct inode *inode,
-                           FAR const unsigned char *buffer,
-                           blkcnt_t startsector, unsigned int nsectors)
+static ssize_t mmcsd_flush(FAR void *dev, FAR const uint8_t *buffer,
+                           off_t startsector, size_t nsectors)
 {
-  FAR struct mmcsd_state_s *priv;
+  FAR struct mmcsd_state_s *priv = (FAR struct mmcsd_state_s *)dev;
   size_t sector;
   size_t endsector;
   ssize_t nwrite;
   ssize_t ret = nsectors;
 
-  DEBUGASSERT(inode && inode->i_private);
-  priv = (FAR struct mmcsd_state_s *)inode->i_private;
-  finfo("startsector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
-        startsector, nsectors, priv->blocksize);
+  finfo("startsector: %jd nsectors: %zu sectorsize: %d\n",
+        (intmax_t)startsector, nsectors, priv->blocksize);
 
   if (nsectors > 0)
     {
@@ -2224,6 +2351,62 @@ static ssize_t mmcsd_write(FAR struct inode *inode,
   return ret;
 }
 
+/****************************************************************************
+ * Name: mmcsd_read
+ *
+ * Description:
+ *   Read the specified number of sectors from the read-ahead buffer or from
+ *   the physical device.
+ *
+ ****************************************************************************/
+
+static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
+                          blkcnt_t startsector, unsigned int nsectors)
+{
+  FAR struct mmcsd_state_s *priv;
+
+  DEBUGASSERT(inode && inode->i_private);
+  priv = (FAR struct mmcsd_state_s *)inode->i_private;
+
+#ifdef MMCSD_HAVE_RWBUFFER
+  if (priv->rwbready)
+    {
+      return rwb_read(&priv->rwb, startsector, nsectors, buffer);
+    }
+#endif
+
+  return mmcsd_reload(priv, buffer, startsector, nsectors);
+}
+
+/****************************************************************************
+ * Name: mmcsd_write
+ *
+ * Description:
+ *   Write the specified number of sectors to the write buffer or to the
+ *   physical device.  The write buffer merges the adjacent writes and
+ *   writes them later, in one transfer, on the work queue.
+ *
+ ****************************************************************************/
+
+static ssize_t mmcsd_write(FAR struct inode *inode,
+                           FAR const unsigned char *buffer,
+                           blkcnt_t startsector, unsigned int nsectors)
+{
+  FAR struct mmcsd_state_s *priv;
+
+  DEBUGASSERT(inode && inode->i_private);
+  priv = (FAR struct mmcsd_state_s *)inode->i_private;
+
+#ifdef CONFIG_MMCSD_WRITEBUFFER
+  if (priv->rwbready)
+    {
+      return rwb_write(&priv->rwb, startsector, nsectors, buffer);
+    }
+#endif
+
+  return mmcsd_flush(priv, buffer, startsector, nsectors);
+}
+
 /****************************************************************************
  * Name: mmcsd_geometry
  *
@@ -2300,6 +2483,17 @@ static int mmcsd_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct mmcsd_state_s *)inode->i_private;
 
+#ifdef CONFIG_MMCSD_WRITEBUFFER
+  /* The write buffer calls back into this driver:  Flush it before taking
+   * the semaphore.
+   */
+
+  if (cmd == BIOC_FLUSH)
+    {
+      return priv->rwbready ? rwb_flush(&priv->rwb) : OK;
+    }
+#endif
+
   /* Process the IOCTL by command */
 
   ret = mmcsd_takesem(priv);
@@ -3365,6 +3559,10 @@ static int mmcsd_probe(FAR struct mmcsd_state_s *priv)
               finfo("Capacity: %" PRIu32 " Kbytes\n",
                     MMCSD_CAPACITY(priv->nblocks, priv->blockshift));
               priv->mediachanged = true;
+
+#ifdef MMCSD_HAVE_RWBUFFER
+              mmcsd_rwbsetup(priv);
+#endif
             }
 
           /* When the card is identified, we have probed this card */
@@ -3399,6 +3597,53 @@ static int mmcsd_probe(FAR struct mmcsd_state_s *priv)
   return ret;
 }
 
+/****************************************************************************
+ * Name: mmcsd_rwbsetup
+ *
+ * Description:
+ *   Set up the read-ahead/write-behind buffers for the card just probed.
+ *   They are allocated for the block size of the first card, and are not
+ *   used with a card of another block size.
+ *
+ ****************************************************************************/
+
+#ifdef MMCSD_HAVE_RWBUFFER
+static void mmcsd_rwbsetup(FAR struct mmcsd_state_s *priv)
+{
+  int ret;
+
+  if (!priv->rwbinit)
+    {
+      priv->rwb.blocksize     = priv->blocksize;
+      priv->rwb.nblocks       = priv->nblocks;
+      priv->rwb.dev           = (FAR void *)priv;
+      priv->rwb.wrflush       = mmcsd_flush;
+      priv->rwb.rhreload      = mmcsd_reload;
+
+#ifdef CONFIG_MMCSD_WRITEBUFFER
+      priv->rwb.wrmaxblocks   = CONFIG_MMCSD_WRBUFFER_SECTORS;
+      priv->rwb.wralignblocks = 1;
+#endif
+
+#ifdef CONFIG_MMCSD_READAHEAD
+      priv->rwb.rhmaxblocks   = CONFIG_MMCSD_RHBUFFER_SECTORS;
+#endif
+
+      ret = rwb_initialize(&priv->rwb);
+      if (ret < 0)
+        {
+          ferr("ERROR: rwb_initialize failed: %d\n", ret);
+          return;
+        }
+
+      priv->rwbinit = true;
+    }
+
+  priv->rwb.nblocks = priv->nblocks;
+  priv->rwbready    = priv->rwb.blocksize == priv->blocksize;
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_removed
  *
@@ -3424,6 +3669,7 @@ static int mmcsd_removed(FAR struct mmcsd_state_s *priv)
   priv->type         = MMCSD_CARDTYPE_UNKNOWN;
   priv->rca          = 0;
   priv->selblocklen  = 0;
+  priv->cmd23        = false;
 
   /* Go back to the default 1-bit data bus. */
 
@@ -3542,6 +3788,15 @@ static void mmcsd_hwuninitialize(FAR struct mmcsd_state_s *priv)
 {
   mmcsd_removed(priv);
   SDIO_RESET(priv->dev);
+
+#ifdef MMCSD_HAVE_RWBUFFER
+  if (priv->rwbinit)
+    {
+      rwb_uninitialize(&priv->rwb);
+      priv->rwbinit  = false;
+      priv->rwbready = false;
+    }
+#endif
 }
 
 /****************************************************************************
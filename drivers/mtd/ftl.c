@@ -590,6 +590,14 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
 
   finfo("path=\"%s\"\n", path);
 
+#ifdef CONFIG_FTL_LOG
+  /* The log-structured FTL replaces the read-modify-write of the erase
+   * blocks.
+   */
+
+  return ftl_log_initialize_by_path(path, mtd);
+#endif
+
   /* Allocate a FTL device structure */
 
   dev = (FAR struct ftl_struct_s *)kmm_zalloc(sizeof(struct ftl_struct_s));
@@ -0,0 +1,1472 @@
+/****************************************************************************
+ * drivers/mtd/ftl_log.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/crc32.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/mtd/mtd.h>
+
+#ifdef CONFIG_FTL_LOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The first page of each erase block holds a struct ftl_log_header_s with
+ * the erase count of the block, written as soon as the block is erased.
+ * The other pages are written in order:  Runs of data pages, each followed
+ * by a summary page, struct ftl_log_summary_s, with the logical sectors of
+ * the run.  A run ends when its summary is full, when the erase block is
+ * full or when the block driver is flushed, so that the sectors written
+ * since the last flush may be lost on a power failure, as with the cache
+ * of a disk.  The logical to physical map is in memory only:  It is built
+ * again from the summaries when the driver is initialized.
+ */
+
+#define FTL_LOG_MAGIC        0x474f4c46  /* "FLOG" */
+#define FTL_LOG_SUMMAGIC     0x4d4d5553  /* "SUMM" */
+
+#define FTL_LOG_NONE         UINT32_MAX  /* Unmapped sector or no block */
+
+/* The sequence of the free and of the bad erase blocks */
+
+#define FTL_LOG_FREE         UINT32_MAX
+#define FTL_LOG_BAD          (UINT32_MAX - 1)
+
+/* The free erase blocks kept for the garbage collection */
+
+#define FTL_LOG_GCRESERVE    1
+
+#ifndef CONFIG_FTL_LOG_GCTHRESHOLD
+#  define CONFIG_FTL_LOG_GCTHRESHOLD 0
+#endif
+
+#define FTL_LOG_SUMMARY_SIZE(n) \
+  (offsetof(struct ftl_log_summary_s, lpn) + (n) * sizeof(uint32_t))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The first page of each erase block */
+
+struct ftl_log_header_s
+{
+  uint32_t magic;            /* FTL_LOG_MAGIC */
+  uint32_t crc;              /* CRC-32 of the erase count */
+  uint32_t erasecount;       /* Number of times the block was erased */
+};
+
+/* The page that follows each run of data pages */
+
+struct ftl_log_summary_s
+{
+  uint32_t magic;            /* FTL_LOG_SUMMAGIC */
+  uint32_t crc;              /* CRC-32 of the fields that follow */
+  uint32_t seq;              /* Sequence of the erase block */
+  uint16_t first;            /* First page of the run */
+  uint16_t count;            /* Number of pages of the run */
+  uint32_t lpn[1];           /* Logical sector of each page of the run */
+};
+
+/* The state of one erase block */
+
+struct ftl_log_block_s
+{
+  uint32_t seq;              /* The order in which the blocks were written,
+                              * FTL_LOG_FREE or FTL_LOG_BAD */
+  uint32_t erasecount;       /* Number of times the block was erased */
+  uint16_t valid;            /* Number of pages holding mapped sectors */
+  uint16_t next;             /* Next page to write */
+  uint16_t last;             /* Last summary page, 0 if none */
+};
+
+/* An erase block and its sequence, to replay the summaries in order */
+
+struct ftl_log_order_s
+{
+  uint32_t seq;
+  uint32_t block;
+};
+
+struct ftl_log_dev_s
+{
+  FAR struct mtd_dev_s *mtd;             /* Contained MTD interface */
+  struct mtd_geometry_s geo;             /* Device geometry */
+  mutex_t               lock;            /* Exclusive access to the state */
+#ifdef CONFIG_SCHED_LPWORK
+  struct work_s         work;            /* Background garbage collection */
+#endif
+  uint16_t              blkper;          /* R/W blocks per erase block */
+  uint16_t              sumcap;          /* Sectors described by a summary */
+  uint16_t              datapages;       /* Data pages per erase block */
+  uint16_t              refs;            /* Number of references */
+  bool                  unlinked;        /* The driver has been unlinked */
+  bool                  gc;              /* Garbage collection in progress */
+  bool                  wearlevel;       /* Static wear leveling is needed */
+  uint8_t               erasestate;      /* Value of the erased bytes */
+  uint32_t              nsectors;        /* Number of logical sectors */
+  uint32_t              nfree;           /* Number of free erase blocks */
+  uint32_t              head;            /* Erase block being written */
+  uint32_t              seq;             /* Sequence of the next block */
+  uint32_t              maxerase;        /* Highest erase count */
+  FAR uint32_t         *map;             /* Page of each logical sector */
+  FAR struct ftl_log_block_s *blocks;    /* State of each erase block */
+  FAR struct ftl_log_summary_s *summary; /* Summary of the current run */
+  FAR struct ftl_log_summary_s *gcsum;   /* Summary being read */
+  FAR uint8_t          *buffer;          /* One page */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t ftl_log_victim(FAR struct ftl_log_dev_s *dev,
+                 uint16_t maxvalid);
+static int     ftl_log_gc(FAR struct ftl_log_dev_s *dev, uint32_t victim);
+static void    ftl_log_wearlevel(FAR struct ftl_log_dev_s *dev);
+#ifdef CONFIG_SCHED_LPWORK
+static void    ftl_log_worker(FAR void *arg);
+#endif
+
+static int     ftl_log_open(FAR struct inode *inode);
+static int     ftl_log_close(FAR struct inode *inode);
+static ssize_t ftl_log_read(FAR struct inode *inode,
+                 FAR unsigned char *buffer, blkcnt_t start_sector,
+                 unsigned int nsectors);
+static ssize_t ftl_log_write(FAR struct inode *inode,
+                 FAR const unsigned char *buffer, blkcnt_t start_sector,
+                 unsigned int nsectors);
+static int     ftl_log_geometry(FAR struct inode *inode,
+                 FAR struct geometry *geometry);
+static int     ftl_log_ioctl(FAR struct inode *inode, int cmd,
+                 unsigned long arg);
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     ftl_log_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_ftl_log_bops =
+{
+  ftl_log_open,     /* open     */
+  ftl_log_close,    /* close    */
+  ftl_log_read,     /* read     */
+  ftl_log_write,    /* write    */
+  ftl_log_geometry, /* geometry */
+  ftl_log_ioctl     /* ioctl    */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , ftl_log_unlink  /* unlink   */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_readpages and ftl_log_writepages
+ *
+ * Description:
+ *   Read or write pages of the MTD device, returning zero on success.
+ *
+ ****************************************************************************/
+
+static int ftl_log_readpages(FAR struct ftl_log_dev_s *dev, uint32_t page,
+                             size_t npages, FAR uint8_t *buffer)
+{
+  ssize_t nxfrd;
+
+  nxfrd = MTD_BREAD(dev->mtd, page, npages, buffer);
+  if (nxfrd != (ssize_t)npages)
+    {
+      ferr("ERROR: Read %zu pages at %" PRIu32 " failed: %zd\n",
+           npages, page, nxfrd);
+      return nxfrd < 0 ? (int)nxfrd : -EIO;
+    }
+
+  return OK;
+}
+
+static int ftl_log_writepages(FAR struct ftl_log_dev_s *dev, uint32_t page,
+                              size_t npages, FAR const uint8_t *buffer)
+{
+  ssize_t nxfrd;
+
+  nxfrd = MTD_BWRITE(dev->mtd, page, npages, buffer);
+  if (nxfrd != (ssize_t)npages)
+    {
+      ferr("ERROR: Write %zu pages at %" PRIu32 " failed: %zd\n",
+           npages, page, nxfrd);
+      return nxfrd < 0 ? (int)nxfrd : -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_erased
+ *
+ * Description:
+ *   Return true if the page in the buffer was not written since the erase
+ *   of its block.
+ *
+ ****************************************************************************/
+
+static bool ftl_log_erased(FAR struct ftl_log_dev_s *dev,
+                           FAR const uint8_t *buffer)
+{
+  uint32_t i;
+
+  for (i = 0; i < dev->geo.blocksize; i++)
+    {
+      if (buffer[i] != dev->erasestate)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: ftl_log_sumcrc
+ *
+ * Description:
+ *   Return the CRC-32 of a summary.
+ *
+ ****************************************************************************/
+
+static uint32_t ftl_log_sumcrc(FAR const struct ftl_log_summary_s *sum)
+{
+  return crc32((FAR const uint8_t *)&sum->seq,
+               FTL_LOG_SUMMARY_SIZE(sum->count) -
+               offsetof(struct ftl_log_summary_s, seq));
+}
+
+/****************************************************************************
+ * Name: ftl_log_validsum
+ *
+ * Description:
+ *   Return true if the page read in 'sum' is the summary of the run that
+ *   ends before it.
+ *
+ ****************************************************************************/
+
+static bool ftl_log_validsum(FAR struct ftl_log_dev_s *dev,
+                             FAR const struct ftl_log_summary_s *sum,
+                             uint16_t page)
+{
+  return sum->magic == FTL_LOG_SUMMAGIC && sum->count > 0 &&
+         sum->count <= dev->sumcap && sum->first > 0 &&
+         sum->first + sum->count == page &&
+         sum->crc == ftl_log_sumcrc(sum);
+}
+
+/****************************************************************************
+ * Name: ftl_log_erase
+ *
+ * Description:
+ *   Erase a block that holds no mapped sector and write its header.  The
+ *   block is retired if it cannot be erased or written.
+ *
+ ****************************************************************************/
+
+static int ftl_log_erase(FAR struct ftl_log_dev_s *dev, uint32_t block)
+{
+  FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+  FAR struct ftl_log_header_s *hdr;
+  int ret;
+
+  DEBUGASSERT(blk->valid == 0 && block != dev->head);
+
+  ret = MTD_ERASE(dev->mtd, block, 1);
+  if (ret >= 0)
+    {
+      blk->erasecount++;
+
+      memset(dev->buffer, dev->erasestate, dev->geo.blocksize);
+      hdr             = (FAR struct ftl_log_header_s *)dev->buffer;
+      hdr->magic      = FTL_LOG_MAGIC;
+      hdr->erasecount = blk->erasecount;
+      hdr->crc        = crc32((FAR const uint8_t *)&hdr->erasecount,
+                              sizeof(hdr->erasecount));
+
+      ret = ftl_log_writepages(dev, block * dev->blkper, 1, dev->buffer);
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: Retiring erase block %" PRIu32 ": %d\n", block, ret);
+      blk->seq = FTL_LOG_BAD;
+      return ret;
+    }
+
+  if (blk->erasecount > dev->maxerase)
+    {
+      dev->maxerase = blk->erasecount;
+    }
+
+  blk->seq  = FTL_LOG_FREE;
+  blk->next = 1;
+  blk->last = 0;
+  dev->nfree++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_commit
+ *
+ * Description:
+ *   Write the summary of the current run, after which its sectors survive
+ *   a power failure.
+ *
+ ****************************************************************************/
+
+static int ftl_log_commit(FAR struct ftl_log_dev_s *dev)
+{
+  FAR struct ftl_log_summary_s *sum = dev->summary;
+  FAR struct ftl_log_block_s *blk;
+  int ret;
+
+  if (dev->head == FTL_LOG_NONE || sum->count == 0)
+    {
+      return OK;
+    }
+
+  blk        = &dev->blocks[dev->head];
+  sum->magic = FTL_LOG_SUMMAGIC;
+  sum->seq   = blk->seq;
+  sum->first = blk->next - sum->count;
+  sum->crc   = ftl_log_sumcrc(sum);
+
+  ret = ftl_log_writepages(dev, dev->head * dev->blkper + blk->next, 1,
+                           (FAR const uint8_t *)sum);
+  sum->count = 0;
+  if (ret < 0)
+    {
+      /* Do not write this block anymore */
+
+      blk->next = dev->blkper;
+      dev->head = FTL_LOG_NONE;
+      return ret;
+    }
+
+  blk->last = blk->next++;
+
+  /* A run needs a data page and its summary */
+
+  if (blk->next >= dev->blkper - 1)
+    {
+      dev->head = FTL_LOG_NONE;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_needwl
+ *
+ * Description:
+ *   Return true if a block holding data was erased much less often than
+ *   the most worn block:  Its data is static and should be moved for the
+ *   block to be worn too.
+ *
+ ****************************************************************************/
+
+static bool ftl_log_needwl(FAR struct ftl_log_dev_s *dev)
+{
+#if CONFIG_FTL_LOG_WEARLEVEL > 0
+  uint32_t block;
+
+  for (block = 0; block < dev->geo.neraseblocks; block++)
+    {
+      FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+
+      if (blk->seq < FTL_LOG_BAD && block != dev->head &&
+          dev->maxerase - blk->erasecount > CONFIG_FTL_LOG_WEARLEVEL)
+        {
+          return true;
+        }
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: ftl_log_worker and ftl_log_schedule
+ *
+ * Description:
+ *   Collect the garbage and level the wear in the background.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORK
+static void ftl_log_schedule(FAR struct ftl_log_dev_s *dev)
+{
+  if ((dev->nfree < CONFIG_FTL_LOG_GCTHRESHOLD || dev->wearlevel) &&
+      work_available(&dev->work))
+    {
+      work_queue(LPWORK, &dev->work, ftl_log_worker, dev, 0);
+    }
+}
+
+static void ftl_log_worker(FAR void *arg)
+{
+  FAR struct ftl_log_dev_s *dev = arg;
+  uint32_t victim;
+  int ret = -ENOSPC;
+
+  nxmutex_lock(&dev->lock);
+
+  /* One erase block at a time, not to hold the lock for too long.  Only
+   * the blocks that are half invalid are worth collecting before the
+   * space is needed.
+   */
+
+  if (dev->nfree < CONFIG_FTL_LOG_GCTHRESHOLD)
+    {
+      victim = ftl_log_victim(dev, dev->datapages / 2);
+      if (victim != FTL_LOG_NONE)
+        {
+          ret = ftl_log_gc(dev, victim);
+        }
+    }
+
+  if (ret < 0 && dev->wearlevel)
+    {
+      ftl_log_wearlevel(dev);
+    }
+  else if (ret >= 0)
+    {
+      ftl_log_schedule(dev);
+    }
+
+  nxmutex_unlock(&dev->lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_log_reserve
+ *
+ * Description:
+ *   Make sure that the current erase block has room for a data page and
+ *   its summary, collecting the garbage if there are too few free blocks.
+ *
+ ****************************************************************************/
+
+static int ftl_log_reserve(FAR struct ftl_log_dev_s *dev)
+{
+  FAR struct ftl_log_block_s *blk;
+  uint32_t retries = 0;
+  uint32_t victim;
+  uint32_t block;
+  int ret;
+
+  for (; ; )
+    {
+      if (dev->head != FTL_LOG_NONE)
+        {
+          if (dev->blocks[dev->head].next < dev->blkper - 1)
+            {
+              return OK;
+            }
+
+          ret = ftl_log_commit(dev);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          dev->head = FTL_LOG_NONE;
+        }
+
+      /* The garbage collection takes the reserved blocks */
+
+      if (dev->nfree > FTL_LOG_GCRESERVE || dev->gc)
+        {
+          break;
+        }
+
+      victim = ftl_log_victim(dev, dev->datapages);
+      if (victim == FTL_LOG_NONE || retries++ >= dev->geo.neraseblocks)
+        {
+          ferr("ERROR: No space left\n");
+          return -ENOSPC;
+        }
+
+      ret = ftl_log_gc(dev, victim);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Take the least worn free block */
+
+  block = FTL_LOG_NONE;
+  for (victim = 0; victim < dev->geo.neraseblocks; victim++)
+    {
+      if (dev->blocks[victim].seq == FTL_LOG_FREE &&
+          (block == FTL_LOG_NONE ||
+           dev->blocks[victim].erasecount < dev->blocks[block].erasecount))
+        {
+          block = victim;
+        }
+    }
+
+  if (block == FTL_LOG_NONE)
+    {
+      ferr("ERROR: No free erase block\n");
+      return -ENOSPC;
+    }
+
+  blk            = &dev->blocks[block];
+  blk->seq       = dev->seq++;
+  dev->head      = block;
+  dev->nfree--;
+  dev->wearlevel = ftl_log_needwl(dev);
+
+#ifdef CONFIG_SCHED_LPWORK
+  ftl_log_schedule(dev);
+#endif
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_append
+ *
+ * Description:
+ *   Write consecutive sectors at the end of the log and map them there.
+ *
+ * Returned Value:
+ *   The number of sectors written, that may be less than requested, or a
+ *   negated errno value on a failure.
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_log_append(FAR struct ftl_log_dev_s *dev, uint32_t lpn,
+                              FAR const uint8_t *buffer, size_t nsectors)
+{
+  FAR struct ftl_log_summary_s *sum = dev->summary;
+  FAR struct ftl_log_block_s *blk;
+  uint32_t page;
+  uint32_t old;
+  size_t room;
+  size_t i;
+  int ret;
+
+  ret = ftl_log_reserve(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Leave the last page of the block to the summary */
+
+  blk  = &dev->blocks[dev->head];
+  room = dev->blkper - 1 - blk->next;
+  if (room > dev->sumcap - sum->count)
+    {
+      room = dev->sumcap - sum->count;
+    }
+
+  if (nsectors > room)
+    {
+      nsectors = room;
+    }
+
+  page = dev->head * dev->blkper + blk->next;
+  ret  = ftl_log_writepages(dev, page, nsectors, buffer);
+  if (ret < 0)
+    {
+      /* Do not write this block anymore:  The run written so far is only
+       * lost on a power failure, as if it was not flushed.
+       */
+
+      sum->count = 0;
+      blk->next  = dev->blkper;
+      dev->head  = FTL_LOG_NONE;
+      return ret;
+    }
+
+  for (i = 0; i < nsectors; i++)
+    {
+      old = dev->map[lpn + i];
+      if (old != FTL_LOG_NONE)
+        {
+          dev->blocks[old / dev->blkper].valid--;
+        }
+
+      dev->map[lpn + i]         = page + i;
+      sum->lpn[sum->count++]    = lpn + i;
+    }
+
+  blk->valid += nsectors;
+  blk->next  += nsectors;
+
+  if (sum->count >= dev->sumcap || blk->next >= dev->blkper - 1)
+    {
+      ret = ftl_log_commit(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_log_victim
+ *
+ * Description:
+ *   Return the written erase block with the fewest mapped sectors, if it
+ *   has fewer than 'maxvalid'.
+ *
+ ****************************************************************************/
+
+static uint32_t ftl_log_victim(FAR struct ftl_log_dev_s *dev,
+                               uint16_t maxvalid)
+{
+  uint32_t victim = FTL_LOG_NONE;
+  uint32_t block;
+
+  for (block = 0; block < dev->geo.neraseblocks; block++)
+    {
+      FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+
+      if (blk->seq < FTL_LOG_BAD && block != dev->head &&
+          blk->valid < maxvalid)
+        {
+          victim   = block;
+          maxvalid = blk->valid;
+        }
+    }
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: ftl_log_gc
+ *
+ * Description:
+ *   Move the mapped sectors of an erase block to the end of the log, then
+ *   erase it.  The summaries of the block tell the sector of each page,
+ *   that is moved only if it is still mapped to that page.
+ *
+ ****************************************************************************/
+
+static int ftl_log_gc(FAR struct ftl_log_dev_s *dev, uint32_t victim)
+{
+  FAR struct ftl_log_summary_s *sum = dev->gcsum;
+  FAR struct ftl_log_block_s *blk = &dev->blocks[victim];
+  uint32_t base = victim * dev->blkper;
+  uint32_t page;
+  uint32_t lpn;
+  uint16_t i;
+  int ret = OK;
+
+  finfo("Collecting block %" PRIu32 ": %u valid erased %" PRIu32 "\n",
+        victim, blk->valid, blk->erasecount);
+
+  dev->gc = true;
+  for (page = blk->last; page > 0 && blk->valid > 0; page = sum->first - 1)
+    {
+      ret = ftl_log_readpages(dev, base + page, 1, (FAR uint8_t *)sum);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      if (!ftl_log_validsum(dev, sum, page))
+        {
+          ferr("ERROR: Bad summary at page %" PRIu32 "\n", base + page);
+          ret = -EIO;
+          goto errout;
+        }
+
+      for (i = sum->count; i-- > 0; )
+        {
+          lpn = sum->lpn[i];
+          if (lpn >= dev->nsectors || dev->map[lpn] != base + sum->first + i)
+            {
+              continue;
+            }
+
+          ret = ftl_log_readpages(dev, base + sum->first + i, 1,
+                                  dev->buffer);
+          if (ret >= 0)
+            {
+              ret = ftl_log_append(dev, lpn, dev->buffer, 1);
+            }
+
+          if (ret < 0)
+            {
+              goto errout;
+            }
+        }
+    }
+
+  /* The copies must survive a power failure before the block is erased */
+
+  ret = ftl_log_commit(dev);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  if (blk->valid != 0)
+    {
+      ferr("ERROR: %u sectors of block %" PRIu32 " are not in summaries\n",
+           blk->valid, victim);
+      ret = -EIO;
+      goto errout;
+    }
+
+  /* A block that cannot be erased is retired, the space is still freed */
+
+  ftl_log_erase(dev, victim);
+
+errout:
+  dev->gc = false;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_wearlevel
+ *
+ * Description:
+ *   Move the data of the least worn erase block, that is static since it
+ *   was not collected for long, for the block to take some of the writes.
+ *
+ ****************************************************************************/
+
+static void ftl_log_wearlevel(FAR struct ftl_log_dev_s *dev)
+{
+  uint32_t victim = FTL_LOG_NONE;
+  uint32_t block;
+
+  dev->wearlevel = false;
+
+  /* Moving a full erase block may take a whole free block */
+
+  if (dev->nfree <= FTL_LOG_GCRESERVE + 1)
+    {
+      return;
+    }
+
+  for (block = 0; block < dev->geo.neraseblocks; block++)
+    {
+      FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+
+      if (blk->seq < FTL_LOG_BAD && block != dev->head &&
+          (victim == FTL_LOG_NONE ||
+           blk->erasecount < dev->blocks[victim].erasecount))
+        {
+          victim = block;
+        }
+    }
+
+  if (victim != FTL_LOG_NONE)
+    {
+      ftl_log_gc(dev, victim);
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_compare
+ *
+ * Description:
+ *   Sort the erase blocks from the most recently written.
+ *
+ ****************************************************************************/
+
+static int ftl_log_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct ftl_log_order_s *oa = a;
+  FAR const struct ftl_log_order_s *ob = b;
+
+  if (oa->seq == ob->seq)
+    {
+      return 0;
+    }
+
+  return oa->seq < ob->seq ? 1 : -1;
+}
+
+/****************************************************************************
+ * Name: ftl_log_replay
+ *
+ * Description:
+ *   Map the sectors of the summaries of an erase block, from the last one.
+ *   The blocks are replayed from the most recently written so that a
+ *   sector is mapped to its latest copy, the first one found.
+ *
+ ****************************************************************************/
+
+static void ftl_log_replay(FAR struct ftl_log_dev_s *dev, uint32_t block)
+{
+  FAR struct ftl_log_summary_s *sum = dev->gcsum;
+  FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+  uint32_t base = block * dev->blkper;
+  uint32_t page;
+  uint32_t lpn;
+  uint16_t i;
+
+  for (page = blk->last; page > 0; page = sum->first - 1)
+    {
+      if (ftl_log_readpages(dev, base + page, 1, (FAR uint8_t *)sum) < 0 ||
+          !ftl_log_validsum(dev, sum, page))
+        {
+          ferr("ERROR: Bad summary at page %" PRIu32 "\n", base + page);
+          break;
+        }
+
+      for (i = sum->count; i-- > 0; )
+        {
+          lpn = sum->lpn[i];
+          if (lpn < dev->nsectors && dev->map[lpn] == FTL_LOG_NONE)
+            {
+              dev->map[lpn] = base + sum->first + i;
+              blk->valid++;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_scan
+ *
+ * Description:
+ *   Read the state of an erase block.  The pages are written in order, so
+ *   the last one written is found by a binary search, and it should be a
+ *   summary unless the power failed in the middle of a run.  The block is
+ *   to be erased (next is 0) if it has no header or no summary.
+ *
+ * Returned Value:
+ *   True if the block has a header, with its erase count.
+ *
+ ****************************************************************************/
+
+static bool ftl_log_scan(FAR struct ftl_log_dev_s *dev, uint32_t block)
+{
+  FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+  FAR struct ftl_log_header_s *hdr;
+  uint32_t base = block * dev->blkper;
+  uint16_t low = 1;
+  uint16_t high = dev->blkper;
+  uint16_t page;
+
+  blk->seq  = FTL_LOG_BAD;
+  blk->next = 0;
+
+  hdr = (FAR struct ftl_log_header_s *)dev->buffer;
+  if (ftl_log_readpages(dev, base, 1, dev->buffer) < 0 ||
+      hdr->magic != FTL_LOG_MAGIC ||
+      hdr->crc != crc32((FAR const uint8_t *)&hdr->erasecount,
+                        sizeof(hdr->erasecount)))
+    {
+      return false;
+    }
+
+  blk->erasecount = hdr->erasecount;
+  if (blk->erasecount > dev->maxerase)
+    {
+      dev->maxerase = blk->erasecount;
+    }
+
+  /* Find the first erased page, the pages that cannot be read are taken
+   * as written.
+   */
+
+  while (low < high)
+    {
+      page = low + (high - low) / 2;
+      if (ftl_log_readpages(dev, base + page, 1, dev->buffer) >= 0 &&
+          ftl_log_erased(dev, dev->buffer))
+        {
+          high = page;
+        }
+      else
+        {
+          low = page + 1;
+        }
+    }
+
+  if (low == 1)
+    {
+      blk->seq  = FTL_LOG_FREE;
+      blk->next = 1;
+      dev->nfree++;
+      return true;
+    }
+
+  for (page = low - 1; page > 0; page--)
+    {
+      if (ftl_log_readpages(dev, base + page, 1,
+                            (FAR uint8_t *)dev->gcsum) >= 0 &&
+          ftl_log_validsum(dev, dev->gcsum, page))
+        {
+          break;
+        }
+    }
+
+  if (page > 0)
+    {
+      /* After a run that has no summary, the block is not written anymore */
+
+      blk->seq  = dev->gcsum->seq;
+      blk->last = page;
+      blk->next = page == low - 1 ? page + 1 : dev->blkper;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: ftl_log_mount
+ *
+ * Description:
+ *   Build the state of the erase blocks and the logical to physical map.
+ *
+ ****************************************************************************/
+
+static int ftl_log_mount(FAR struct ftl_log_dev_s *dev)
+{
+  FAR struct ftl_log_order_s *order;
+  uint64_t total = 0;
+  uint32_t nknown = 0;
+  uint32_t norder = 0;
+  uint32_t block;
+  int ret = OK;
+
+  order = kmm_malloc(dev->geo.neraseblocks * sizeof(*order));
+  if (order == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(dev->map, 0xff, dev->nsectors * sizeof(uint32_t));
+
+  for (block = 0; block < dev->geo.neraseblocks; block++)
+    {
+      if (ftl_log_scan(dev, block))
+        {
+          nknown++;
+          total += dev->blocks[block].erasecount;
+        }
+
+      if (dev->blocks[block].seq < FTL_LOG_BAD)
+        {
+          order[norder].seq     = dev->blocks[block].seq;
+          order[norder++].block = block;
+          if (dev->blocks[block].seq >= dev->seq)
+            {
+              dev->seq = dev->blocks[block].seq + 1;
+            }
+        }
+    }
+
+  /* Erase the blocks that have no header or no summary, with the average
+   * erase count if it is unknown.
+   */
+
+  for (block = 0; block < dev->geo.neraseblocks; block++)
+    {
+      FAR struct ftl_log_block_s *blk = &dev->blocks[block];
+
+      if (blk->next == 0)
+        {
+          if (blk->erasecount == 0 && nknown > 0)
+            {
+              blk->erasecount = total / nknown;
+            }
+
+          ftl_log_erase(dev, block);
+        }
+    }
+
+  qsort(order, norder, sizeof(*order), ftl_log_compare);
+  for (block = 0; block < norder; block++)
+    {
+      ftl_log_replay(dev, order[block].block);
+    }
+
+  /* Go on writing the last block after its last summary */
+
+  if (norder > 0 &&
+      dev->blocks[order[0].block].next < dev->blkper - 1)
+    {
+      dev->head = order[0].block;
+    }
+
+  finfo("%" PRIu32 " blocks written, %" PRIu32 " free\n",
+        norder, dev->nfree);
+
+  if (dev->nfree + (dev->head != FTL_LOG_NONE) == 0)
+    {
+      ferr("ERROR: No free erase block\n");
+      ret = -ENOSPC;
+    }
+
+  kmm_free(order);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_free
+ *
+ * Description:
+ *   Free the FTL device structure
+ *
+ ****************************************************************************/
+
+static void ftl_log_free(FAR struct ftl_log_dev_s *dev)
+{
+#ifdef CONFIG_SCHED_LPWORK
+  work_cancel(LPWORK, &dev->work);
+#endif
+
+  nxmutex_destroy(&dev->lock);
+
+  if (dev->map)
+    {
+      kmm_free(dev->map);
+    }
+
+  if (dev->blocks)
+    {
+      kmm_free(dev->blocks);
+    }
+
+  if (dev->summary)
+    {
+      kmm_free(dev->summary);
+    }
+
+  kmm_free(dev);
+}
+
+/****************************************************************************
+ * Name: ftl_log_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+static int ftl_log_open(FAR struct inode *inode)
+{
+  FAR struct ftl_log_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  dev->refs++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_close
+ *
+ * Description: close the block device
+ *
+ ****************************************************************************/
+
+static int ftl_log_close(FAR struct inode *inode)
+{
+  FAR struct ftl_log_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  nxmutex_lock(&dev->lock);
+  ftl_log_commit(dev);
+  nxmutex_unlock(&dev->lock);
+
+  if (--dev->refs == 0 && dev->unlinked)
+    {
+      ftl_log_free(dev);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_read
+ *
+ * Description:  Read the specified number of sectors, the runs of sectors
+ *   that are consecutive on the FLASH at once.  The sectors never written
+ *   read as erased.
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_log_read(FAR struct inode *inode,
+                            FAR unsigned char *buffer,
+                            blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct ftl_log_dev_s *dev;
+  uint32_t lpn = start_sector;
+  uint32_t page;
+  unsigned int remaining = nsectors;
+  unsigned int n;
+  int ret = OK;
+
+  finfo("sector: %" PRIuOFF " nsectors: %u\n", start_sector, nsectors);
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&dev->lock);
+
+  while (remaining > 0)
+    {
+      page = dev->map[lpn];
+      for (n = 1; n < remaining; n++)
+        {
+          if (dev->map[lpn + n] !=
+              (page == FTL_LOG_NONE ? FTL_LOG_NONE : page + n))
+            {
+              break;
+            }
+        }
+
+      if (page == FTL_LOG_NONE)
+        {
+          memset(buffer, dev->erasestate, n * dev->geo.blocksize);
+        }
+      else
+        {
+          ret = ftl_log_readpages(dev, page, n, buffer);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+
+      lpn       += n;
+      remaining -= n;
+      buffer    += n * dev->geo.blocksize;
+    }
+
+  nxmutex_unlock(&dev->lock);
+  return ret < 0 ? ret : nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_log_write
+ *
+ * Description: Write the specified number of sectors at the end of the log
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_log_write(FAR struct inode *inode,
+                             FAR const unsigned char *buffer,
+                             blkcnt_t start_sector, unsigned int nsectors)
+{
+  FAR struct ftl_log_dev_s *dev;
+  unsigned int nwritten;
+  ssize_t ret = OK;
+
+  finfo("sector: %" PRIuOFF " nsectors: %u\n", start_sector, nsectors);
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&dev->lock);
+
+  for (nwritten = 0; nwritten < nsectors; nwritten += ret)
+    {
+      ret = ftl_log_append(dev, start_sector + nwritten,
+                           buffer + nwritten * dev->geo.blocksize,
+                           nsectors - nwritten);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+#ifndef CONFIG_SCHED_LPWORK
+  /* With no worker to do it, level the wear after the write */
+
+  if (dev->wearlevel)
+    {
+      ftl_log_wearlevel(dev);
+    }
+#endif
+
+  nxmutex_unlock(&dev->lock);
+  return ret < 0 ? ret : nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_log_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int ftl_log_geometry(FAR struct inode *inode,
+                            FAR struct geometry *geometry)
+{
+  FAR struct ftl_log_dev_s *dev;
+
+  finfo("Entry\n");
+
+  DEBUGASSERT(inode);
+  if (geometry)
+    {
+      dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+      geometry->geo_available     = true;
+      geometry->geo_mediachanged  = false;
+      geometry->geo_writeenabled  = true;
+      geometry->geo_nsectors      = dev->nsectors;
+      geometry->geo_sectorsize    = dev->geo.blocksize;
+
+      finfo("nsectors: %" PRIuOFF " sectorsize: %u\n",
+            geometry->geo_nsectors, geometry->geo_sectorsize);
+
+      return OK;
+    }
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: ftl_log_ioctl
+ *
+ * Description: Flush the current run on BIOC_FLUSH
+ *
+ ****************************************************************************/
+
+static int ftl_log_ioctl(FAR struct inode *inode, int cmd,
+                         unsigned long arg)
+{
+  FAR struct ftl_log_dev_s *dev;
+  int ret;
+
+  finfo("Entry\n");
+  DEBUGASSERT(inode && inode->i_private);
+
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  if (cmd == BIOC_FLUSH)
+    {
+      nxmutex_lock(&dev->lock);
+      ret = ftl_log_commit(dev);
+      nxmutex_unlock(&dev->lock);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Other possible MTD driver ioctl commands are passed through to the
+   * MTD driver (unchanged).
+   */
+
+  ret = MTD_IOCTL(dev->mtd, cmd, arg);
+  if (ret < 0 && ret != -ENOTTY)
+    {
+      ferr("ERROR: MTD ioctl(%04x) failed: %d\n", cmd, ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_unlink
+ *
+ * Description: Unlink the device
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int ftl_log_unlink(FAR struct inode *inode)
+{
+  FAR struct ftl_log_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_log_dev_s *)inode->i_private;
+
+  dev->unlinked = true;
+  if (dev->refs == 0)
+    {
+      ftl_log_free(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_initialize_by_path
+ *
+ * Description:
+ *   Initialize a log-structured block driver wrapper around an MTD
+ *   interface:  The sectors are written at the end of a log instead of in
+ *   place, and the erase blocks are reclaimed by a garbage collection.
+ *   CONFIG_FTL_LOG_RESERVED erase blocks are not exposed, to leave room to
+ *   the garbage collection.
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+int ftl_log_initialize_by_path(FAR const char *path,
+                               FAR struct mtd_dev_s *mtd)
+{
+  FAR struct ftl_log_dev_s *dev;
+  uint16_t nsummaries;
+  int ret;
+
+  /* Sanity check */
+
+  if (path == NULL || mtd == NULL)
+    {
+      return -EINVAL;
+    }
+
+  finfo("path=\"%s\"\n", path);
+
+  dev = kmm_zalloc(sizeof(struct ftl_log_dev_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  dev->mtd  = mtd;
+  dev->head = FTL_LOG_NONE;
+  nxmutex_init(&dev->lock);
+
+  ret = MTD_IOCTL(mtd, MTDIOC_GEOMETRY,
+                  (unsigned long)((uintptr_t)&dev->geo));
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(MTDIOC_GEOMETRY) failed: %d\n", ret);
+      goto errout;
+    }
+
+  if (MTD_IOCTL(mtd, MTDIOC_ERASESTATE,
+                (unsigned long)((uintptr_t)&dev->erasestate)) < 0)
+    {
+      dev->erasestate = 0xff;
+    }
+
+  /* Get the number of R/W blocks per erase block, and the capacity left
+   * by the headers and the summaries of full runs.
+   */
+
+  dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
+  DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
+
+  if (dev->geo.blocksize < FTL_LOG_SUMMARY_SIZE(1) || dev->blkper < 4 ||
+      dev->geo.neraseblocks <= CONFIG_FTL_LOG_RESERVED + 1)
+    {
+      ferr("ERROR: Unsupported geometry\n");
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  dev->sumcap    = (dev->geo.blocksize - FTL_LOG_SUMMARY_SIZE(0)) /
+                   sizeof(uint32_t);
+  nsummaries     = (dev->blkper - 1 + dev->sumcap) / (dev->sumcap + 1);
+  dev->datapages = dev->blkper - 1 - nsummaries;
+  dev->nsectors  = (dev->geo.neraseblocks - CONFIG_FTL_LOG_RESERVED) *
+                   dev->datapages;
+
+  /* The summaries and the page share one allocation */
+
+  dev->map     = kmm_malloc(dev->nsectors * sizeof(uint32_t));
+  dev->blocks  = kmm_zalloc(dev->geo.neraseblocks *
+                            sizeof(struct ftl_log_block_s));
+  dev->summary = kmm_zalloc(3 * dev->geo.blocksize);
+  if (dev->map == NULL || dev->blocks == NULL || dev->summary == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  dev->gcsum  = (FAR struct ftl_log_summary_s *)
+                ((FAR uint8_t *)dev->summary + dev->geo.blocksize);
+  dev->buffer = (FAR uint8_t *)dev->summary + 2 * dev->geo.blocksize;
+
+  ret = ftl_log_mount(dev);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  /* Inode private data is a reference to the FTL device structure */
+
+  ret = register_blockdriver(path, &g_ftl_log_bops, 0, dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: register_blockdriver failed: %d\n", -ret);
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  ftl_log_free(dev);
+  return ret;
+}
+
+#endif /* CONFIG_FTL_LOG */
@@ -100,6 +100,24 @@ static int      nand_readpage(FAR struct nand_dev_s *nand, off_t block,
                   unsigned int page, FAR uint8_t *data);
 static int      nand_writepage(FAR struct nand_dev_s *nand, off_t block,
                   unsigned int page, FAR const void *data);
+#ifdef CONFIG_MTD_NAND_CACHEREAD
+static int      nand_readpages(FAR struct nand_dev_s *nand, off_t block,
+                  unsigned int page, unsigned int npages,
+                  FAR uint8_t *data);
+#endif
+
+/* Page cache */
+
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+static FAR struct nand_cache_s *nand_cache_find(FAR struct nand_dev_s *nand,
+                  off_t block, unsigned int page);
+static void     nand_cache_fill(FAR struct nand_dev_s *nand, off_t block,
+                  unsigned int page, FAR const uint8_t *data);
+static void     nand_cache_discard(FAR struct nand_dev_s *nand,
+                  off_t block, unsigned int page);
+static void     nand_cache_discardblock(FAR struct nand_dev_s *nand,
+                  off_t block);
+#endif
 
 /* MTD driver methods */
 
@@ -529,6 +547,163 @@ static int nand_writepage(FAR struct nand_dev_s *nand, off_t block,
     }
 }
 
+#ifdef CONFIG_MTD_NAND_CACHEREAD
+/****************************************************************************
+ * Name: nand_readpages
+ *
+ * Description:
+ *   Reads the data areas of consecutive pages of a block with the
+ *   sequential cache read of the lower half.
+ *
+ * Input Parameters:
+ *   nand   - Upper-half, NAND FLASH interface
+ *   block  - Number of the block where the pages to read reside.
+ *   page   - Number of the first page to read inside the given block.
+ *   npages - Number of pages to read, up to the end of the block.
+ *   data   - Buffer where the data areas will be stored.
+ *
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ *
+ ****************************************************************************/
+
+static int nand_readpages(FAR struct nand_dev_s *nand, off_t block,
+                          unsigned int page, unsigned int npages,
+                          FAR uint8_t *data)
+{
+  finfo("block=%d page=%d npages=%d data=%p\n",
+        (int)block, page, npages, data);
+
+#ifdef CONFIG_MTD_NAND_BLOCKCHECK
+  /* Check that the block is not BAD if data is requested */
+
+  if (nand_checkblock(nand, block) != GOODBLOCK)
+    {
+      ferr("ERROR: Block is BAD\n");
+      return -EAGAIN;
+    }
+#endif
+
+  return NAND_READPAGES(nand->raw, block, page, npages, data);
+}
+#endif
+
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+/****************************************************************************
+ * Name: nand_cache_find
+ *
+ * Description:
+ *   Find a page in the page cache.
+ *
+ * Returned Value:
+ *   The cached page, NULL if the page is not cached.
+ *
+ ****************************************************************************/
+
+static FAR struct nand_cache_s *nand_cache_find(FAR struct nand_dev_s *nand,
+                                                off_t block,
+                                                unsigned int page)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_NAND_PAGECACHE; i++)
+    {
+      FAR struct nand_cache_s *cache = &nand->cache[i];
+
+      if (cache->block == block && cache->page == page)
+        {
+          cache->age = ++nand->age;
+          return cache;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nand_cache_fill
+ *
+ * Description:
+ *   Add a page read from NAND, with its data checked by the ECC, to the
+ *   page cache in place of the least recently used page.
+ *
+ ****************************************************************************/
+
+static void nand_cache_fill(FAR struct nand_dev_s *nand, off_t block,
+                            unsigned int page, FAR const uint8_t *data)
+{
+  FAR struct nand_cache_s *victim = &nand->cache[0];
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_NAND_PAGECACHE; i++)
+    {
+      FAR struct nand_cache_s *cache = &nand->cache[i];
+
+      if (cache->block < 0)
+        {
+          victim = cache;
+          break;
+        }
+
+      if ((int32_t)(cache->age - victim->age) < 0)
+        {
+          victim = cache;
+        }
+    }
+
+  memcpy(victim->data, data, nandmodel_getpagesize(&nand->raw->model));
+  victim->block = block;
+  victim->page  = page;
+  victim->age   = ++nand->age;
+}
+
+/****************************************************************************
+ * Name: nand_cache_discard
+ *
+ * Description:
+ *   Remove a page that is written from the page cache.
+ *
+ ****************************************************************************/
+
+static void nand_cache_discard(FAR struct nand_dev_s *nand, off_t block,
+                               unsigned int page)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_NAND_PAGECACHE; i++)
+    {
+      FAR struct nand_cache_s *cache = &nand->cache[i];
+
+      if (cache->block == block && cache->page == page)
+        {
+          cache->block = -1;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nand_cache_discardblock
+ *
+ * Description:
+ *   Remove the pages of a block that is erased from the page cache.
+ *
+ ****************************************************************************/
+
+static void nand_cache_discardblock(FAR struct nand_dev_s *nand,
+                                    off_t block)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_NAND_PAGECACHE; i++)
+    {
+      if (nand->cache[i].block == block)
+        {
+          nand->cache[i].block = -1;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nand_erase
  *
@@ -542,17 +717,56 @@ static int nand_erase(struct mtd_dev_s *dev, off_t startblock,
 {
   FAR struct nand_dev_s *nand = (FAR struct nand_dev_s *)dev;
   size_t blocksleft = nblocks;
+#ifdef CONFIG_MTD_NAND_MULTIPLANE
+  unsigned int nplanes;
+#endif
   int ret;
 
   finfo("startblock: %08lx nblocks: %d\n", (long)startblock, (int)nblocks);
 
+#ifdef CONFIG_MTD_NAND_MULTIPLANE
+  nplanes = nandmodel_getplanes(&nand->raw->model);
+  if (nand->raw->eraseblocks == NULL)
+    {
+      nplanes = 1;
+    }
+#endif
+
   /* Lock access to the NAND until we complete the erase */
 
   nand_lock(nand);
-  while (blocksleft-- > 0)
+  while (blocksleft > 0)
     {
+#ifdef CONFIG_MTD_NAND_MULTIPLANE
+      /* Erase one block in each plane at once.  If it fails, the blocks
+       * are erased one by one below so that the bad one is marked.
+       */
+
+      if (nplanes > 1 && (startblock % nplanes) == 0 &&
+          blocksleft >= nplanes &&
+          NAND_ERASEBLOCKS(nand->raw, startblock, nplanes) >= 0)
+        {
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+          unsigned int i;
+
+          for (i = 0; i < nplanes; i++)
+            {
+              nand_cache_discardblock(nand, startblock + i);
+            }
+#endif
+
+          startblock += nplanes;
+          blocksleft -= nplanes;
+          continue;
+        }
+#endif
+
       /* Erase each sector */
 
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+      nand_cache_discardblock(nand, startblock);
+#endif
+
       ret = nand_eraseblock(nand, startblock, false);
       if (ret < 0)
         {
@@ -563,6 +777,7 @@ static int nand_erase(struct mtd_dev_s *dev, off_t startblock,
         }
 
       startblock++;
+      blocksleft--;
     }
 
   nand_unlock(nand);
@@ -583,8 +798,12 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
   FAR struct nand_dev_s *nand = (FAR struct nand_dev_s *)dev;
   FAR struct nand_raw_s *raw;
   FAR struct nand_model_s *model;
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+  FAR struct nand_cache_s *cache;
+#endif
   unsigned int pagesperblock;
   unsigned int page;
+  unsigned int count;
   uint16_t pagesize;
   size_t remaining;
   off_t maxblock;
@@ -618,7 +837,7 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
 
   /* Then read every page from NAND */
 
-  for (remaining = npages; remaining > 0; remaining--)
+  for (remaining = npages; remaining > 0; remaining -= count)
     {
       /* Check for attempt to read beyond the end of NAND */
 
@@ -631,14 +850,61 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
           goto errout_with_lock;
         }
 
-      /* Read the next page from NAND */
+      count = 1;
 
-      ret = nand_readpage(nand, block, page, buffer);
-      if (ret < 0)
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+      /* Take the page from the cache if it was read recently */
+
+      cache = nand_cache_find(nand, block, page);
+      if (cache != NULL)
         {
-          ferr("ERROR: nand_readpage failed block=%ld page=%d: %d\n",
-               (long)block, page, ret);
-          goto errout_with_lock;
+          memcpy(buffer, cache->data, pagesize);
+        }
+      else
+#endif
+#ifdef CONFIG_MTD_NAND_CACHEREAD
+      /* Read the next pages of the block with a sequential cache read */
+
+      if (remaining > 1 && raw->readpages != NULL &&
+          raw->ecctype != NANDECC_SWECC && nandmodel_havecacheread(model))
+        {
+          count = pagesperblock - page;
+          if (count > remaining)
+            {
+              count = remaining;
+            }
+
+          ret = nand_readpages(nand, block, page, count, buffer);
+          if (ret < 0)
+            {
+              ferr("ERROR: nand_readpages failed block=%ld page=%d: %d\n",
+                   (long)block, page, ret);
+              goto errout_with_lock;
+            }
+        }
+      else
+#endif
+        {
+          /* Read the next page from NAND */
+
+          ret = nand_readpage(nand, block, page, buffer);
+          if (ret < 0)
+            {
+              ferr("ERROR: nand_readpage failed block=%ld page=%d: %d\n",
+                   (long)block, page, ret);
+              goto errout_with_lock;
+            }
+
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+          /* Keep the pages of the small reads, the pages of the long
+           * sequential reads would only flush the cache.
+           */
+
+          if (npages <= CONFIG_MTD_NAND_PAGECACHE)
+            {
+              nand_cache_fill(nand, block, page, buffer);
+            }
+#endif
         }
 
       /* Increment the page number.  If we exceed the number of
@@ -646,15 +912,16 @@ static ssize_t nand_bread(struct mtd_dev_s *dev, off_t startpage,
        * the block number.
        */
 
-      if (++page >= pagesperblock)
+      page += count;
+      if (page >= pagesperblock)
         {
           page = 0;
           block++;
         }
 
-      /* Increment the buffer point by the size of one page */
+      /* Increment the buffer point by the size of the pages read */
 
-      buffer += pagesize;
+      buffer += count * pagesize;
     }
 
   nand_unlock(nand);
@@ -729,6 +996,10 @@ static ssize_t nand_bwrite(struct mtd_dev_s *dev, off_t startpage,
 
       /* Write the next page into NAND */
 
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+      nand_cache_discard(nand, block, page);
+#endif
+
       ret = nand_writepage(nand, block, page, buffer);
       if (ret < 0)
         {
@@ -860,6 +1131,9 @@ FAR struct mtd_dev_s *nand_initialize(FAR struct nand_raw_s *raw)
 {
   FAR struct nand_dev_s *nand;
   struct onfi_pgparam_s onfi;
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+  int i;
+#endif
   int ret;
 
   finfo("cmdaddr=%p addraddr=%p dataaddr=%p\n",
@@ -909,6 +1183,20 @@ FAR struct mtd_dev_s *nand_initialize(FAR struct nand_raw_s *raw)
       model->devid     = onfi.manufacturer;
       model->options   = onfi.buswidth ? NANDMODEL_DATAWIDTH16 :
                                          NANDMODEL_DATAWIDTH8;
+      model->nplanes   = 1;
+
+      if ((onfi.optcmds & ONFI_OPTCMD_READCACHE) != 0)
+        {
+          model->options |= NANDMODEL_CACHEREAD;
+        }
+
+      if ((onfi.features & ONFI_FEATURE_MULTIPLANE) != 0 &&
+          onfi.planebits > 0)
+        {
+          model->options |= NANDMODEL_MULTIPLANE;
+          model->nplanes  = 1 << onfi.planebits;
+        }
+
       model->pagesize  = onfi.pagesize;
       model->sparesize = onfi.sparesize;
 
@@ -967,6 +1255,26 @@ FAR struct mtd_dev_s *nand_initialize(FAR struct nand_raw_s *raw)
   nand->mtd.ioctl  = nand_ioctl;
   nand->raw        = raw;
 
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+  /* Allocate the data of the cached pages */
+
+  nand->cache[0].data = kmm_malloc(CONFIG_MTD_NAND_PAGECACHE *
+                                   nandmodel_getpagesize(&raw->model));
+  if (nand->cache[0].data == NULL)
+    {
+      ferr("ERROR: Failed to allocate the NAND page cache\n");
+      kmm_free(nand);
+      return NULL;
+    }
+
+  for (i = 0; i < CONFIG_MTD_NAND_PAGECACHE; i++)
+    {
+      nand->cache[i].data  = nand->cache[0].data +
+                             i * nandmodel_getpagesize(&raw->model);
+      nand->cache[i].block = -1;
+    }
+#endif
+
   nxsem_init(&nand->exclsem, 0, 1);
 
 #if defined(CONFIG_MTD_NAND_BLOCKCHECK) && defined(CONFIG_DEBUG_INFO) && \
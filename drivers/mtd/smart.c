@@ -43,6 +43,8 @@
 #include <nuttx/crc16.h>
 #include <nuttx/crc32.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -57,6 +59,16 @@
 #  define CONFIG_SMART_LOCAL_CHECKFREE
 #endif
 
+/* The device must be locked against the background garbage collection */
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#  define smart_lock(dev)         nxmutex_lock(&(dev)->lock)
+#  define smart_unlock(dev)       nxmutex_unlock(&(dev)->lock)
+#else
+#  define smart_lock(dev)
+#  define smart_unlock(dev)
+#endif
+
 #define SMART_STATUS_COMMITTED    0x80
 #define SMART_STATUS_RELEASED     0x40
 #define SMART_STATUS_CRC          0x20
@@ -275,6 +287,10 @@ struct smart_struct_s
   size_t                bytesalloc;
   struct smart_alloc_s  alloc[SMART_MAX_ALLOCS];   /* Array of memory allocations */
 #endif
+#ifdef CONFIG_MTD_SMART_BGGC
+  mutex_t               lock;             /* Serializes access to the device */
+  struct work_s         gcwork;           /* Background garbage collection */
+#endif
 };
 
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
@@ -423,6 +439,13 @@ static int     smart_relocate_static_data(FAR struct smart_struct_s *dev,
 
 static int     smart_relocate_sector(FAR struct smart_struct_s *dev,
                  uint16_t oldsector, uint16_t newsector);
+static uint16_t smart_find_collectblock(FAR struct smart_struct_s *dev,
+                 FAR uint16_t *releasemax);
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void    smart_bggc_worker(FAR void *arg);
+static void    smart_bggc_schedule(FAR struct smart_struct_s *dev);
+#endif
 
 #ifdef CONFIG_MTD_SMART_FSCK
 static int     smart_fsck(FAR struct smart_struct_s *dev);
@@ -881,6 +904,7 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
                           blkcnt_t start_sector, unsigned int nsectors)
 {
   FAR struct smart_struct_s *dev;
+  ssize_t ret;
 
   finfo("SMART: sector: %" PRIuOFF " nsectors: %u\n",
         start_sector, nsectors);
@@ -891,7 +915,11 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
 #else
   dev = (struct smart_struct_s *)inode->i_private;
 #endif
-  return smart_reload(dev, buffer, start_sector, nsectors);
+
+  smart_lock(dev);
+  ret = smart_reload(dev, buffer, start_sector, nsectors);
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -928,7 +956,7 @@ static ssize_t smart_write(FAR struct inode *inode,
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-  /* I think maybe we need to lock on a mutex here */
+  smart_lock(dev);
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
@@ -969,10 +997,7 @@ static ssize_t smart_write(FAR struct inode *inode,
             {
               ferr("ERROR: Erase block=%" PRIdOFF " failed: %d\n",
                    eraseblock, ret);
-
-              /* Unlock the mutex if we add one */
-
-              return ret;
+              goto errout;
             }
         }
 
@@ -1000,10 +1025,8 @@ static ssize_t smart_write(FAR struct inode *inode,
 
           ferr("ERROR: Write block %" PRIdOFF " failed: %zd.\n",
                nextblock, nxfrd);
-
-          /* Unlock the mutex if we add one */
-
-          return -EIO;
+          ret = -EIO;
+          goto errout;
         }
 
       /* Then update for amount written */
@@ -1014,7 +1037,11 @@ static ssize_t smart_write(FAR struct inode *inode,
       alignedblock += mtdblkspererase;
     }
 
-  return nsectors;
+  ret = nsectors;
+
+errout:
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -3983,6 +4010,55 @@ retry:
   return physicalsector;
 }
 
+/****************************************************************************
+ * Name: smart_find_collectblock
+ *
+ * Description:  Find the erase block with the most released sectors.
+ *               Returns 0xffff if no block has released sectors.  The
+ *               count of released sectors is returned in 'releasemax'.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_find_collectblock(FAR struct smart_struct_s *dev,
+                                        FAR uint16_t *releasemax)
+{
+  uint16_t collectblock = 0xffff;
+  int x;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  uint8_t count;
+#endif
+
+  *releasemax = 0;
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
+
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
+        {
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      count = smart_get_count(dev, dev->releasecount, x);
+      if (count > *releasemax)
+        {
+          *releasemax = count;
+          collectblock = x;
+        }
+#else
+      if (dev->releasecount[x] > *releasemax)
+        {
+          *releasemax = dev->releasecount[x];
+          collectblock = x;
+        }
+#endif
+    }
+
+  return collectblock;
+}
+
 /****************************************************************************
  * Name: smart_garbagecollect
  *
@@ -3997,11 +4073,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
   uint16_t collectblock;
   uint16_t releasemax;
   bool collect = TRUE;
-  int x;
   int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-  uint8_t count;
-#endif
 
   while (collect)
     {
@@ -4030,39 +4102,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
         {
           /* Find the block with the most released sectors */
 
-          collectblock = 0xffff;
-          releasemax = 0;
-          for (x = 0; x < dev->neraseblocks; x++)
-            {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-              /* Don't collect blocks that have been worn completely */
-
-              if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
-                {
-                  continue;
-                }
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-              count = smart_get_count(dev, dev->releasecount, x);
-              if (count > releasemax)
-                {
-                  releasemax = count;
-                  collectblock = x;
-                }
-#else
-              if (dev->releasecount[x] > releasemax)
-                {
-                  releasemax = dev->releasecount[x];
-                  collectblock = x;
-                }
-#endif
-            }
-
-#if 0
-          releasemax = smart_get_count(dev, dev->releasecount, collectblock);
-#endif
-
+          collectblock = smart_find_collectblock(dev, &releasemax);
           if (collectblock == 0xffff)
             {
               /* Need to collect, but no sectors with released blocks! */
@@ -4115,6 +4155,83 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: smart_bggc_worker
+ *
+ * Description:  Relocate one erase block in the background.  The work
+ *               re-queues itself until the high watermark is reached, so
+ *               that the device is unlocked between two blocks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_bggc_worker(FAR void *arg)
+{
+  FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+  uint16_t collectblock;
+  uint16_t releasemax;
+  int ret;
+
+  smart_lock(dev);
+
+  if (dev->freesectors >= (uint32_t)dev->totalsectors *
+                          CONFIG_MTD_SMART_BGGC_HIWATER / 100)
+    {
+      goto out;
+    }
+
+  /* Only relocate blocks in which at least a quarter of the sectors have
+   * been released.  Relocating a block with few released sectors costs an
+   * erase for little gain; leave that to the synchronous collection.
+   */
+
+  collectblock = smart_find_collectblock(dev, &releasemax);
+  if (collectblock == 0xffff ||
+      releasemax < (dev->availsectperblk + 3) / 4)
+    {
+      goto out;
+    }
+
+  finfo("Background collecting block %d, released=%d totalfree=%d\n",
+        collectblock, releasemax, dev->freesectors);
+
+  ret = smart_relocate_block(dev, collectblock);
+  if (ret < 0)
+    {
+      ferr("ERROR: Background collection of block %d failed: %d\n",
+           collectblock, ret);
+      goto out;
+    }
+
+  work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, 0);
+
+out:
+  smart_unlock(dev);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_schedule
+ *
+ * Description:  Start the background garbage collection if the free sectors
+ *               dropped below the low watermark.
+ *
+ * Assumptions:  The caller holds the device lock.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_schedule(FAR struct smart_struct_s *dev)
+{
+  if (dev->releasesectors > 0 &&
+      dev->freesectors < (uint32_t)dev->totalsectors *
+                         CONFIG_MTD_SMART_BGGC_LOWATER / 100 &&
+      work_available(&dev->gcwork))
+    {
+      work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev,
+                 MSEC2TICK(CONFIG_MTD_SMART_BGGC_DELAY));
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: smart_write_wearstatus
  *
@@ -5479,6 +5596,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+  smart_lock(dev);
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
@@ -5531,6 +5650,9 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       /* Free the specified logical sector */
 
       ret = smart_freesector(dev, arg);
+#ifdef CONFIG_MTD_SMART_BGGC
+      smart_bggc_schedule(dev);
+#endif
       goto ok_out;
 
     case BIOC_WRITESECT:
@@ -5548,6 +5670,9 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
         }
 #endif
 
+#ifdef CONFIG_MTD_SMART_BGGC
+      smart_bggc_schedule(dev);
+#endif
       goto ok_out;
 
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
@@ -5618,6 +5743,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     }
 
 ok_out:
+  smart_unlock(dev);
   return ret;
 }
 
@@ -6202,6 +6328,9 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
                             dev->geo.neraseblocks;
       dev->lastallocblock = 0;
       dev->debuglevel     = 0;
+#ifdef CONFIG_MTD_SMART_BGGC
+      nxmutex_init(&dev->lock);
+#endif
 
       /* Mark the device format status an unknown */
 
@@ -6309,6 +6438,9 @@ errout:
     }
 #endif
 
+#ifdef CONFIG_MTD_SMART_BGGC
+  nxmutex_destroy(&dev->lock);
+#endif
   kmm_free(dev);
   return ret;
 }
@@ -6424,6 +6556,16 @@ static int smart_loteardown(FAR const char *devname)
 
   close_blockdriver(inode);
 
+#ifdef CONFIG_MTD_SMART_BGGC
+  /* The worker re-queues itself only while it holds the lock */
+
+  work_cancel(LPWORK, &dev->gcwork);
+  smart_lock(dev);
+  work_cancel(LPWORK, &dev->gcwork);
+  smart_unlock(dev);
+  nxmutex_destroy(&dev->lock);
+#endif
+
   /* Now teardown the filemtd */
 
   filemtd_teardown(dev->mtd);
@@ -76,6 +76,9 @@ struct lo_driver_s
 {
   bool lo_bifup;               /* true:ifup false:ifdown */
   bool lo_txdone;              /* One RX packet was looped back */
+#ifdef CONFIG_NET_LOOPBACK_DIRECT
+  bool lo_polling;             /* A poll is in progress */
+#endif
   struct work_s lo_work;       /* For deferring poll work to the work queue */
 
   /* This holds the information visible to the NuttX network */
@@ -280,6 +283,10 @@ static void lo_txavail_work(FAR void *arg)
   net_lock();
   if (priv->lo_bifup)
     {
+#ifdef CONFIG_NET_LOOPBACK_DIRECT
+      priv->lo_polling = true;
+#endif
+
       do
         {
           /* If so, then poll the network for new XMIT data */
@@ -288,6 +295,10 @@ static void lo_txavail_work(FAR void *arg)
           devif_poll(&priv->lo_dev, lo_txpoll);
         }
       while (priv->lo_txdone);
+
+#ifdef CONFIG_NET_LOOPBACK_DIRECT
+      priv->lo_polling = false;
+#endif
     }
 
   net_unlock();
@@ -316,6 +327,29 @@ static int lo_txavail(FAR struct net_driver_s *dev)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
 
+#ifdef CONFIG_NET_LOOPBACK_DIRECT
+  /* Poll right now, unless this is an interrupt handler.  A notification
+   * from within the poll, e.g. by a socket woken up by a looped back
+   * packet, only asks the running poll for another pass.
+   */
+
+  if (!up_interrupt_context())
+    {
+      net_lock();
+      if (priv->lo_polling)
+        {
+          priv->lo_txdone = true;
+        }
+      else
+        {
+          lo_txavail_work(priv);
+        }
+
+      net_unlock();
+      return OK;
+    }
+#endif
+
   /* Is our single work structure available?  It may not be if there are
    * pending interrupt actions and we will have to ignore the Tx
    * availability action.
@@ -423,6 +457,9 @@ int localhost_initialize(void)
 #endif
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = priv;         /* Used to recover private state from dev */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  priv->lo_dev.d_csumoff = NETDEV_CSUM_LOOPBACK; /* No checksums needed */
+#endif
 
   /* Register the loopabck device with the OS so that socket IOCTLs can b
    * performed.
@@ -0,0 +1,160 @@
+/****************************************************************************
+ * drivers/net/napi.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/napi.h>
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The network must never run on the high priority work queue */
+
+#define NAPIWORK LPWORK
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: napi_work
+ *
+ * Description:
+ *   Process one batch of frames from the worker thread.
+ *
+ ****************************************************************************/
+
+static void napi_work(FAR void *arg)
+{
+  FAR struct napi_s *napi = (FAR struct napi_s *)arg;
+  irqstate_t flags;
+  int done;
+
+  net_lock();
+  done = napi->poll(napi, napi->budget);
+  net_unlock();
+
+  flags = enter_critical_section();
+  if (!napi->scheduled)
+    {
+      /* napi_disable() was called meanwhile */
+    }
+  else if (done >= napi->budget)
+    {
+      /* There may be more frames:  Give other work its turn, then
+       * continue.
+       */
+
+      work_queue(NAPIWORK, &napi->work, napi_work, napi, 0);
+    }
+  else
+    {
+      /* The ring is empty.  Go idle and unmask the receive interrupt. */
+
+      napi->scheduled = false;
+      napi->rxint(napi, true);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: napi_init
+ *
+ * Description:
+ *   Initialize the poller of a driver.
+ *
+ ****************************************************************************/
+
+void napi_init(FAR struct napi_s *napi, FAR void *priv,
+               CODE int (*poll)(FAR struct napi_s *napi, int budget),
+               CODE void (*rxint)(FAR struct napi_s *napi, bool enable),
+               int budget)
+{
+  DEBUGASSERT(napi != NULL && poll != NULL && rxint != NULL);
+
+  napi->priv      = priv;
+  napi->poll      = poll;
+  napi->rxint     = rxint;
+  napi->budget    = budget > 0 ? budget : CONFIG_NETDEV_NAPI_BUDGET;
+  napi->scheduled = false;
+}
+
+/****************************************************************************
+ * Name: napi_schedule
+ *
+ * Description:
+ *   Mask the receive interrupt and schedule the poller, unless it is
+ *   already pending.
+ *
+ ****************************************************************************/
+
+void napi_schedule(FAR struct napi_s *napi)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!napi->scheduled)
+    {
+      napi->scheduled = true;
+      napi->rxint(napi, false);
+      work_queue(NAPIWORK, &napi->work, napi_work, napi, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: napi_disable
+ *
+ * Description:
+ *   Cancel the poller.
+ *
+ ****************************************************************************/
+
+void napi_disable(FAR struct napi_s *napi)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  napi->rxint(napi, false);
+  work_cancel(NAPIWORK, &napi->work);
+  napi->scheduled = false;
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_NETDEV_NAPI */
@@ -26,15 +26,18 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include <fcntl.h>
 #include <poll.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
 #include <nuttx/signal.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/telnet.h>
@@ -55,6 +58,10 @@
 #  define CONFIG_TELNET_TXBUFFER_SIZE 256
 #endif
 
+#ifndef CONFIG_TELNET_TXFLUSH_DELAY
+#  define CONFIG_TELNET_TXFLUSH_DELAY 0
+#endif
+
 #ifndef CONFIG_TELNET_MAXLCLIENTS
 #  define CONFIG_TELNET_MAXLCLIENTS 8
 #endif
@@ -122,11 +129,13 @@ struct telnet_dev_s
 {
   sem_t             td_exclsem;   /* Enforces mutually exclusive access */
   sem_t             td_iosem;     /* I/O thread will notify that data is available */
+  sem_t             td_txsem;     /* Exclusive access to the txbuffer */
   uint8_t           td_state;     /* (See telnet_state_e) */
   uint8_t           td_crefs;     /* The number of open references to the session */
   uint8_t           td_minor;     /* Minor device number */
   uint16_t          td_offset;    /* Offset to the valid, pending bytes in the rxbuffer */
   uint16_t          td_pending;   /* Number of valid, pending bytes in the rxbuffer */
+  uint16_t          td_txlen;     /* Number of bytes in the txbuffer */
 #ifdef CONFIG_TELNET_SUPPORT_NAWS
   uint16_t          td_rows;      /* Number of NAWS rows */
   uint16_t          td_cols;      /* Number of NAWS cols */
@@ -136,6 +145,10 @@ struct telnet_dev_s
   pid_t             td_pid;
 #endif
   struct pollfd     td_fds;
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+  bool              td_txqueued;  /* td_txwork is queued or running */
+  struct work_s     td_txwork;    /* Sends the txbuffer after the delay */
+#endif
   FAR struct socket td_psock;     /* A clone of the internal socket structure */
   char td_rxbuffer[CONFIG_TELNET_RXBUFFER_SIZE];
   char td_txbuffer[CONFIG_TELNET_TXBUFFER_SIZE];
@@ -158,8 +171,13 @@ static void    telnet_getchar(FAR struct telnet_dev_s *priv, uint8_t ch,
 static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                  FAR const char *src, size_t srclen, FAR char *dest,
                  size_t destlen);
-static bool    telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
-                 int *nwritten);
+static size_t  telnet_escape(FAR struct telnet_dev_s *priv,
+                 FAR const char *src, size_t srclen);
+static int     telnet_flush(FAR struct telnet_dev_s *priv);
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+static void    telnet_txworker(FAR void *arg);
+static bool    telnet_sync(FAR struct telnet_dev_s *priv);
+#endif
 static void    telnet_sendopt(FAR struct telnet_dev_s *priv, uint8_t option,
                  uint8_t value);
 static int     telnet_io_main(int argc, FAR char** argv);
@@ -356,14 +374,47 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
                               FAR const char *src, size_t srclen,
                               FAR char *dest, size_t destlen)
 {
+  size_t nplain;
+  size_t max;
   int nread;
   uint8_t ch;
 
   ninfo("srclen: %zd destlen: %zd\n", srclen, destlen);
 
-  for (nread = 0; srclen > 0 && nread < destlen; srclen--)
+  for (nread = 0; srclen > 0 && nread < destlen; )
     {
+      /* Copy the run of user data up to the next byte that the parser has
+       * to look at all at once.
+       */
+
+      if (priv->td_state == STATE_NORMAL)
+        {
+          max = destlen - nread < srclen ? destlen - nread : srclen;
+          for (nplain = 0; nplain < max; nplain++)
+            {
+              ch = src[nplain];
+#ifndef CONFIG_TELNET_CHARACTER_MODE
+              if (ch == TELNET_IAC || ch == TELNET_CR)
+#else
+              if (ch == TELNET_IAC)
+#endif
+                {
+                  break;
+                }
+            }
+
+          if (nplain > 0)
+            {
+              memcpy(&dest[nread], src, nplain);
+              nread  += nplain;
+              src    += nplain;
+              srclen -= nplain;
+              continue;
+            }
+        }
+
       ch = *src++;
+      srclen--;
       ninfo("ch=%02x state=%d\n", ch, priv->td_state);
 
       switch (priv->td_state)
@@ -559,48 +610,134 @@ static ssize_t telnet_receive(FAR struct telnet_dev_s *priv,
 }
 
 /****************************************************************************
- * Name: telnet_putchar
+ * Name: telnet_escape
  *
  * Description:
- *   Put another character from the user buffer to the TX buffer.
+ *   Append as much of the user buffer to the TX buffer as it can hold.
+ *   Carriage returns are dropped and put back after each line feed, and
+ *   IAC bytes are doubled so that the client does not take them for
+ *   commands.  Called with td_txsem held.
+ *
+ * Returned Value:
+ *   The number of bytes of the user buffer that were consumed.
  *
  ****************************************************************************/
 
-static bool telnet_putchar(FAR struct telnet_dev_s *priv, uint8_t ch,
-                           int *nread)
+static size_t telnet_escape(FAR struct telnet_dev_s *priv,
+                            FAR const char *src, size_t srclen)
 {
-  register int index;
-  bool ret = false;
+  FAR char *dest = &priv->td_txbuffer[priv->td_txlen];
+  FAR char *end  = &priv->td_txbuffer[CONFIG_TELNET_TXBUFFER_SIZE - 1];
+  size_t i;
+  uint8_t ch;
 
-  /* Ignore carriage returns (we will put these in automatically as
-   * necessary).
-   */
+  /* Each byte needs room for the longest sequence, "\n\r" or IAC IAC */
 
-  if (ch != TELNET_CR)
+  for (i = 0; i < srclen && dest < end; i++)
     {
-      /* Add all other characters to the destination buffer */
-
-      index = *nread;
-      priv->td_txbuffer[index++] = ch;
-
-      /* Check for line feeds */
+      ch = src[i];
+      if (ch == TELNET_CR)
+        {
+          continue;
+        }
 
+      *dest++ = ch;
       if (ch == TELNET_NL)
         {
-          /* Now add the carriage return */
+          *dest++ = TELNET_CR;
+        }
+      else if (ch == TELNET_IAC)
+        {
+          *dest++ = TELNET_IAC;
+        }
+    }
 
-          priv->td_txbuffer[index++] = TELNET_CR;
+  priv->td_txlen = dest - priv->td_txbuffer;
+  return i;
+}
 
-          /* End of line */
+/****************************************************************************
+ * Name: telnet_flush
+ *
+ * Description:
+ *   Send the content of the TX buffer.  Called with td_txsem held.
+ *
+ ****************************************************************************/
 
-          ret = true;
-        }
+static int telnet_flush(FAR struct telnet_dev_s *priv)
+{
+  ssize_t ret;
 
-      *nread = index;
+  if (priv->td_txlen == 0)
+    {
+      return OK;
     }
 
-  return ret;
+  telnet_dumpbuffer("Send txbuffer", priv->td_txbuffer, priv->td_txlen);
+
+  ret = psock_send(&priv->td_psock, priv->td_txbuffer, priv->td_txlen, 0);
+
+  /* The output is dropped if it can not be sent, the connection is lost */
+
+  priv->td_txlen = 0;
+  if (ret < 0)
+    {
+      nerr("ERROR: psock_send failed: %zd\n", ret);
+      return ret;
+    }
+
+  return OK;
+}
+
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+/****************************************************************************
+ * Name: telnet_txworker
+ *
+ * Description:
+ *   Send the output buffered by telnet_write() when the coalescing delay
+ *   has passed.
+ *
+ ****************************************************************************/
+
+static void telnet_txworker(FAR void *arg)
+{
+  FAR struct telnet_dev_s *priv = arg;
+
+  nxsem_wait_uninterruptible(&priv->td_txsem);
+  telnet_flush(priv);
+  priv->td_txqueued = false;
+  nxsem_post(&priv->td_txsem);
+}
+
+/****************************************************************************
+ * Name: telnet_sync
+ *
+ * Description:
+ *   Send the buffered output now, without waiting for the delay.
+ *
+ * Returned Value:
+ *   True if the worker could not be canceled because it is running.  It
+ *   still uses the driver until it clears td_txqueued.
+ *
+ ****************************************************************************/
+
+static bool telnet_sync(FAR struct telnet_dev_s *priv)
+{
+  bool queued;
+
+  nxsem_wait_uninterruptible(&priv->td_txsem);
+
+  if (priv->td_txqueued && work_cancel(LPWORK, &priv->td_txwork) >= 0)
+    {
+      priv->td_txqueued = false;
+    }
+
+  telnet_flush(priv);
+  queued = priv->td_txqueued;
+  nxsem_post(&priv->td_txsem);
+  return queued;
 }
+#endif
 
 /****************************************************************************
  * Name: telnet_sendopt
@@ -776,6 +913,17 @@ static int telnet_close(FAR struct file *filep)
 
       nxsem_post(&g_iosem);
 
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+      /* Send the output still buffered before closing the socket, and
+       * wait for a running worker to be done with the driver.
+       */
+
+      while (telnet_sync(priv))
+        {
+          nxsig_usleep(USEC_PER_TICK);
+        }
+#endif
+
       /* Close the socket */
 
       psock_close(&priv->td_psock);
@@ -790,6 +938,7 @@ static int telnet_close(FAR struct file *filep)
 
       DEBUGASSERT(priv->td_exclsem.semcount == 0);
       nxsem_destroy(&priv->td_exclsem);
+      nxsem_destroy(&priv->td_txsem);
       kmm_free(priv);
     }
 
@@ -836,6 +985,14 @@ static ssize_t telnet_read(FAR struct file *filep, FAR char *buffer,
               return -EAGAIN;
             }
 
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+          /* Send the output that the user is going to answer, the prompt
+           * for example.
+           */
+
+          telnet_sync(priv);
+#endif
+
           /* Wait for new data, interrupt, or thread cancellation */
 
           ret = nxsem_wait(&priv->td_iosem);
@@ -892,61 +1049,57 @@ static ssize_t telnet_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct telnet_dev_s *priv = inode->i_private;
-  FAR const char *src = buffer;
-  ssize_t nsent;
-  ssize_t ret;
-  int ncopied;
-  char ch;
-  bool eol;
+  size_t nsent;
+  int ret;
 
   ninfo("len: %zd\n", len);
 
-  /* Process each character from the user buffer */
-
-  for (nsent = 0, ncopied = 0; nsent < len; nsent++)
+  ret = nxsem_wait(&priv->td_txsem);
+  if (ret < 0)
     {
-      /* Get the next character from the user buffer */
-
-      ch = *src++;
-
-      /* Add the character to the TX buffer */
-
-      eol = telnet_putchar(priv, ch, &ncopied);
+      nerr("ERROR: nxsem_wait failed: %d\n", ret);
+      return ret;
+    }
 
-      /* Was that the end of a line? Or is the buffer too full to hold the
-       * next largest character sequence ("\r\n")?
-       */
+  /* Translate the user buffer into the TX buffer and send it each time
+   * that it is full, not at the end of each line.
+   */
 
-      if (eol || ncopied > CONFIG_TELNET_TXBUFFER_SIZE - 2)
+  for (nsent = 0; nsent < len; )
+    {
+      nsent += telnet_escape(priv, &buffer[nsent], len - nsent);
+      if (nsent < len)
         {
-          /* Yes... send the data now */
-
-          ret = psock_send(&priv->td_psock, priv->td_txbuffer, ncopied, 0);
+          ret = telnet_flush(priv);
           if (ret < 0)
             {
-              nerr("ERROR: psock_send failed '%s': %zd\n",
-                   priv->td_txbuffer, ret);
-              return ret;
+              goto errout;
             }
-
-          /* Reset the index to the beginning of the TX buffer. */
-
-          ncopied = 0;
         }
     }
 
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+  /* Leave the rest in the TX buffer for the next writes.  The delay runs
+   * from the first byte buffered.
+   */
+
+  if (priv->td_txlen > 0 && !priv->td_txqueued)
+    {
+      priv->td_txqueued = true;
+      work_queue(LPWORK, &priv->td_txwork, telnet_txworker, priv,
+                 MSEC2TICK(CONFIG_TELNET_TXFLUSH_DELAY));
+    }
+#else
   /* Send anything remaining in the TX buffer */
 
-  if (ncopied > 0)
+  ret = telnet_flush(priv);
+  if (ret < 0)
     {
-      ret = psock_send(&priv->td_psock, priv->td_txbuffer, ncopied, 0);
-      if (ret < 0)
-        {
-          nerr("ERROR: psock_send failed '%s': %zd\n",
-               priv->td_txbuffer, ret);
-          return ret;
-        }
+      goto errout;
     }
+#endif
+
+  nxsem_post(&priv->td_txsem);
 
   /* Notice that we don't actually return the number of bytes sent, but
    * rather, the number of bytes that the caller asked us to send.  We may
@@ -955,6 +1108,10 @@ static ssize_t telnet_write(FAR struct file *filep, FAR const char *buffer,
    */
 
   return len;
+
+errout:
+  nxsem_post(&priv->td_txsem);
+  return ret;
 }
 
 /****************************************************************************
@@ -993,6 +1150,7 @@ static int telnet_session(FAR struct telnet_session_s *session)
 
   nxsem_init(&priv->td_exclsem, 0, 1);
   nxsem_init(&priv->td_iosem, 0, 0);
+  nxsem_init(&priv->td_txsem, 0, 1);
 
   /* td_iosem is used for signaling and, hence, must not participate in
    * priority inheritance.
@@ -1005,6 +1163,10 @@ static int telnet_session(FAR struct telnet_session_s *session)
   priv->td_minor     = 0;
   priv->td_pending   = 0;
   priv->td_offset    = 0;
+  priv->td_txlen     = 0;
+#if CONFIG_TELNET_TXFLUSH_DELAY > 0
+  priv->td_txqueued  = false;
+#endif
 #ifdef HAVE_SIGNALS
   priv->td_pid       = INVALID_PROCESS_ID;
 #endif
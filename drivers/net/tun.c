@@ -104,6 +104,27 @@
 
 #define NET_TUN_PKTSIZE ((CONFIG_NET_TUN_PKTSIZE + CONFIG_NET_GUARDSIZE + 1) & ~1)
 
+/* CONFIG_NET_TUN_NBUFFERS is the number of packet buffers of a device.  The
+ * network may fill all but one of them with outgoing packets; the last one
+ * is kept for the packets written by the application, so that a write never
+ * waits for the application to read the packets that the network sent.
+ */
+
+#ifndef CONFIG_NET_TUN_NBUFFERS
+#  define CONFIG_NET_TUN_NBUFFERS 2
+#endif
+
+#if CONFIG_NET_TUN_NBUFFERS < 2
+#  error CONFIG_NET_TUN_NBUFFERS must be at least 2
+#endif
+
+#define TUN_NTXPOLL   (CONFIG_NET_TUN_NBUFFERS - 1)
+
+/* The index of the next free packet buffer */
+
+#define TUN_TAIL(p)   (((p)->read_head + (p)->read_count) % \
+                       CONFIG_NET_TUN_NBUFFERS)
+
 /* This is a helper pointer for accessing the contents of the Ethernet
  * header.
  */
@@ -128,6 +149,7 @@
 struct tun_device_s
 {
   bool              bifup;     /* true:ifup false:ifdown */
+  bool              batch;     /* true:IFF_BATCH, length-prefixed packets */
   bool              read_wait;
   bool              write_wait;
   struct work_s     work;      /* For deferring poll work to the work queue */
@@ -135,15 +157,20 @@ struct tun_device_s
   sem_t             waitsem;
   sem_t             read_wait_sem;
   sem_t             write_wait_sem;
-  size_t            read_d_len;
-  size_t            write_d_len;
+  uint8_t           read_head;  /* Index of the oldest packet to read */
+  uint8_t           read_count; /* Number of packets waiting to be read */
+  size_t            read_d_len[CONFIG_NET_TUN_NBUFFERS];
 
   /* These packet buffer arrays required 16-bit alignment.  That alignment
-   * is assured only by the preceding wide data types.
+   * is assured only by the preceding wide data types and by the even size
+   * of each buffer.
+   *
+   * The buffers form a ring of the packets to be read by the application,
+   * in the order sent by the network.  A written packet is given to the
+   * network in the next free buffer, where a response remains queued.
    */
 
-  uint8_t           read_buf[NET_TUN_PKTSIZE];
-  uint8_t           write_buf[NET_TUN_PKTSIZE];
+  uint8_t           read_buf[CONFIG_NET_TUN_NBUFFERS][NET_TUN_PKTSIZE];
 
   /* This holds the information visible to the NuttX network */
 
@@ -326,10 +353,41 @@ static void tun_pollnotify(FAR struct tun_device_s *priv,
 
 static void tun_fd_transmit(FAR struct tun_device_s *priv)
 {
+  /* The packet is in the next free buffer:  Queue it for reading */
+
+  DEBUGASSERT(priv->dev.d_buf == priv->read_buf[TUN_TAIL(priv)]);
+
+  priv->read_d_len[TUN_TAIL(priv)] = priv->dev.d_len;
+  priv->read_count++;
+
   NETDEV_TXPACKETS(&priv->dev);
   tun_pollnotify(priv, POLLIN);
 }
 
+/****************************************************************************
+ * Name: tun_txnext
+ *
+ * Description:
+ *   Point the device at the next free packet buffer after a packet was
+ *   queued by the TX poll.
+ *
+ * Returned Value:
+ *   Zero if the poll may continue with that buffer; one if the buffers
+ *   for the TX poll are exhausted.
+ *
+ ****************************************************************************/
+
+static int tun_txnext(FAR struct tun_device_s *priv)
+{
+  if (priv->read_count >= TUN_NTXPOLL)
+    {
+      return 1;
+    }
+
+  priv->dev.d_buf = priv->read_buf[TUN_TAIL(priv)];
+  return 0;
+}
+
 /****************************************************************************
  * Name: tun_txpoll
  *
@@ -429,12 +487,10 @@ static int tun_txpoll_tap(FAR struct net_driver_s *dev)
 
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet and continue with the next buffer */
 
-          priv->read_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txnext(priv);
         }
     }
 
@@ -483,12 +539,10 @@ static int tun_txpoll_tun(FAR struct net_driver_s *dev)
     {
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet and continue with the next buffer */
 
-          priv->read_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
-
-          return 1;
+          return tun_txnext(priv);
         }
     }
 
@@ -602,7 +656,6 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
       if (priv->dev.d_len > 0)
         {
-          priv->write_d_len = priv->dev.d_len;
           tun_fd_transmit(priv);
           priv->dev.d_len = 0;
         }
@@ -637,7 +690,6 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
       /* And send the packet */
 
-      priv->write_d_len = priv->dev.d_len;
       tun_fd_transmit(priv);
     }
 }
@@ -712,7 +764,6 @@ static void tun_net_receive_tun(FAR struct tun_device_s *priv)
 
   if (priv->dev.d_len > 0)
     {
-      priv->write_d_len = priv->dev.d_len;
       tun_fd_transmit(priv);
     }
 }
@@ -736,14 +787,13 @@ static void tun_net_receive_tun(FAR struct tun_device_s *priv)
 
 static void tun_txdone(FAR struct tun_device_s *priv)
 {
-  /* Check for errors and update statistics */
-
-  NETDEV_TXDONE(&priv->dev);
+  /* Poll the network for new XMIT data if there is a buffer for it */
 
-  /* Then poll the network for new XMIT data */
-
-  priv->dev.d_buf = priv->read_buf;
-  devif_poll(&priv->dev, tun_txpoll);
+  if (priv->bifup && priv->read_count < TUN_NTXPOLL)
+    {
+      priv->dev.d_buf = priv->read_buf[TUN_TAIL(priv)];
+      devif_poll(&priv->dev, tun_txpoll);
+    }
 }
 
 /****************************************************************************
@@ -851,23 +901,12 @@ static void tun_txavail_work(FAR void *arg)
       return;
     }
 
-  /* Check if there is room to hold another network packet. */
-
-  if (priv->read_d_len != 0)
-    {
-      tun_unlock(priv);
-      return;
-    }
+  /* Poll the network for new XMIT data if there is room to hold another
+   * network packet.
+   */
 
   net_lock();
-  if (priv->bifup)
-    {
-      /* Poll the network for new XMIT data */
-
-      priv->dev.d_buf = priv->read_buf;
-      devif_poll(&priv->dev, tun_txpoll);
-    }
-
+  tun_txdone(priv);
   net_unlock();
   tun_unlock(priv);
 }
@@ -1076,22 +1115,63 @@ static int tun_close(FAR struct file *filep)
   return ret;
 }
 
+/****************************************************************************
+ * Name: tun_write_packet
+ *
+ * Description:
+ *   Give one packet written by the application to the network.  The packet
+ *   is received in the next free buffer, where a response remains queued
+ *   for reading.
+ *
+ * Assumptions:
+ *   The device is locked and there is a free packet buffer.
+ *
+ ****************************************************************************/
+
+static void tun_write_packet(FAR struct tun_device_s *priv,
+                             FAR const char *buffer, size_t buflen)
+{
+  FAR uint8_t *buf = priv->read_buf[TUN_TAIL(priv)];
+
+  memcpy(buf, buffer, buflen);
+
+  net_lock();
+  priv->dev.d_buf = buf;
+  priv->dev.d_len = buflen;
+
+  tun_net_receive(priv);
+  net_unlock();
+}
+
 /****************************************************************************
  * Name: tun_write
+ *
+ * Description:
+ *   Give the packets written by the application to the network.  Without
+ *   IFF_BATCH, the buffer holds one packet.  With IFF_BATCH, it holds
+ *   several packets, each preceded by its length in a uint16_t.  Only
+ *   complete packets are consumed:  If not all of them fit in the free
+ *   packet buffers, the number of bytes of those written is returned.
+ *
  ****************************************************************************/
 
 static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
                          size_t buflen)
 {
   FAR struct tun_device_s *priv = filep->f_priv;
-  ssize_t nwritten = 0;
+  size_t nwritten = 0;
   int ret;
 
-  if (priv == NULL || buflen > CONFIG_NET_TUN_PKTSIZE)
+  if (priv == NULL || (!priv->batch && buflen > CONFIG_NET_TUN_PKTSIZE))
     {
       return -EINVAL;
     }
 
+  if (buflen == 0)
+    {
+      return 0;
+    }
+
   for (; ; )
     {
       /* Write must return immediately if interrupted by a signal (or if the
@@ -1101,23 +1181,51 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
       ret = nxsem_wait(&priv->waitsem);
       if (ret < 0)
         {
-          return nwritten == 0 ? (ssize_t)ret : nwritten;
+          return nwritten == 0 ? (ssize_t)ret : (ssize_t)nwritten;
         }
 
-      /* Check if there are free space to write */
+      /* Write packets while there is free space for them */
 
-      if (priv->write_d_len == 0)
+      while (nwritten < buflen &&
+             priv->read_count < CONFIG_NET_TUN_NBUFFERS)
         {
-          memcpy(priv->write_buf, buffer, buflen);
+          FAR const char *pkt = buffer + nwritten;
+          size_t pktlen = buflen - nwritten;
+          size_t reclen = pktlen;
 
-          net_lock();
-          priv->dev.d_buf = priv->write_buf;
-          priv->dev.d_len = buflen;
+          if (priv->batch)
+            {
+              uint16_t len16;
+
+              if (pktlen < sizeof(uint16_t))
+                {
+                  ret = -EINVAL;
+                  break;
+                }
+
+              memcpy(&len16, pkt, sizeof(uint16_t));
+              pkt    += sizeof(uint16_t);
+              pktlen  = len16;
+              reclen  = pktlen + sizeof(uint16_t);
+
+              if (reclen > buflen - nwritten ||
+                  pktlen > CONFIG_NET_TUN_PKTSIZE)
+                {
+                  ret = -EINVAL;
+                  break;
+                }
+            }
 
-          tun_net_receive(priv);
-          net_unlock();
+          tun_write_packet(priv, pkt, pktlen);
+          nwritten += reclen;
+        }
+
+      /* A malformed packet is reported once the preceding ones have been
+       * accepted.
+       */
 
-          nwritten = buflen;
+      if (nwritten > 0 || ret < 0)
+        {
           break;
         }
 
@@ -1125,7 +1233,7 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
 
       if ((filep->f_oflags & O_NONBLOCK) != 0)
         {
-          nwritten = -EAGAIN;
+          ret = -EAGAIN;
           break;
         }
 
@@ -1135,18 +1243,26 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
     }
 
   tun_unlock(priv);
-  return nwritten;
+  return nwritten > 0 ? (ssize_t)nwritten : (ssize_t)ret;
 }
 
 /****************************************************************************
  * Name: tun_read
+ *
+ * Description:
+ *   Return the packets queued by the network in the order they were sent.
+ *   Without IFF_BATCH, one packet is returned.  With IFF_BATCH, as many as
+ *   fit in the buffer are returned, each preceded by its length in a
+ *   uint16_t, and the network is polled again for more when the queue
+ *   runs empty.
+ *
  ****************************************************************************/
 
 static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
                         size_t buflen)
 {
   FAR struct tun_device_s *priv = filep->f_priv;
-  ssize_t nread = 0;
+  size_t nread = 0;
   int ret;
 
   if (priv == NULL)
@@ -1163,45 +1279,75 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
       ret = nxsem_wait(&priv->waitsem);
       if (ret < 0)
         {
-          return nread == 0 ? (ssize_t)ret : nread;
+          return nread == 0 ? (ssize_t)ret : (ssize_t)nread;
         }
 
-      /* Check if there are data to read in write buffer */
+      /* Check if there are packets to read */
 
-      if (priv->write_d_len > 0)
+      while (priv->read_count > 0)
         {
-          if (buflen < priv->write_d_len)
+          FAR uint8_t *buf = priv->read_buf[priv->read_head];
+          size_t pktlen = priv->read_d_len[priv->read_head];
+
+          if (priv->batch)
+            {
+              uint16_t len16 = pktlen;
+
+              if (pktlen + sizeof(uint16_t) > buflen - nread)
+                {
+                  break;
+                }
+
+              memcpy(buffer + nread, &len16, sizeof(uint16_t));
+              nread += sizeof(uint16_t);
+            }
+          else if (buflen < pktlen)
             {
-              nread = -EINVAL;
+              ret = -EINVAL;
               break;
             }
 
-          memcpy(buffer, priv->write_buf, priv->write_d_len);
-          nread = priv->write_d_len;
-          priv->write_d_len = 0;
+          memcpy(buffer + nread, buf, pktlen);
+          nread += pktlen;
 
+          priv->read_head = (priv->read_head + 1) % CONFIG_NET_TUN_NBUFFERS;
+          priv->read_count--;
           NETDEV_TXDONE(&priv->dev);
-          tun_pollnotify(priv, POLLOUT);
-          break;
-        }
 
-      /* Check if there are data to read in read buffer */
-
-      if (priv->read_d_len > 0)
-        {
-          if (buflen < priv->read_d_len)
+          if (!priv->batch)
             {
-              nread = -EINVAL;
               break;
             }
 
-          memcpy(buffer, priv->read_buf, priv->read_d_len);
-          nread = priv->read_d_len;
-          priv->read_d_len = 0;
+          /* Refill the queue from the network before returning */
+
+          if (priv->read_count == 0)
+            {
+              net_lock();
+              tun_txdone(priv);
+              net_unlock();
+            }
+        }
+
+      if (nread > 0)
+        {
+          /* Poll the network into the buffers freed, and let writers use
+           * them.
+           */
 
           net_lock();
           tun_txdone(priv);
           net_unlock();
+
+          tun_pollnotify(priv, POLLOUT);
+          break;
+        }
+
+      /* The buffer cannot hold the first packet */
+
+      if (ret < 0 || priv->read_count > 0)
+        {
+          ret = -EINVAL;
           break;
         }
 
@@ -1209,7 +1355,7 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
 
       if ((filep->f_oflags & O_NONBLOCK) != 0)
         {
-          nread = -EAGAIN;
+          ret = -EAGAIN;
           break;
         }
 
@@ -1219,7 +1365,7 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
     }
 
   tun_unlock(priv);
-  return nread;
+  return nread > 0 ? (ssize_t)nread : (ssize_t)ret;
 }
 
 /****************************************************************************
@@ -1257,18 +1403,18 @@ int tun_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
       eventset = 0;
 
-      /* If write buffer is empty notify App.  */
+      /* If there is a free packet buffer, a packet may be written */
 
-      if (priv->write_d_len == 0)
+      if (priv->read_count < CONFIG_NET_TUN_NBUFFERS)
         {
           eventset |= (fds->events & POLLOUT);
         }
 
-      /* The write buffer sometimes could be used for TX.
-       * So check it too.
+      /* Responses to the written packets are queued with the packets sent
+       * by the network.
        */
 
-      if (priv->read_d_len != 0 || priv->write_d_len != 0)
+      if (priv->read_count > 0)
         {
           eventset |= (fds->events & POLLIN);
         }
@@ -1342,6 +1488,7 @@ static int tun_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       tun->free_tuns &= ~(1 << intf);
 
       priv = filep->f_priv;
+      priv->batch = (ifr->ifr_flags & IFF_BATCH) != 0;
       strlcpy(ifr->ifr_name, priv->dev.d_ifname, IFNAMSIZ);
       tundev_unlock(tun);
 
@@ -25,6 +25,7 @@
 #include <nuttx/note/note_driver.h>
 #include <nuttx/note/note_sysview.h>
 #include <nuttx/note/noteram_driver.h>
+#include <nuttx/note/notestream_driver.h>
 #include <nuttx/note/notectl_driver.h>
 
 /****************************************************************************
@@ -58,6 +59,14 @@ int note_register(void)
     }
 #endif
 
+#ifdef CONFIG_DRIVER_NOTESTREAM
+  ret = notestream_register();
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_DRIVER_NOTECTL
   ret = notectl_register();
   if (ret < 0)
@@ -25,28 +25,73 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <limits.h>
 #include <sched.h>
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mutex.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched.h>
 #include <nuttx/sched_note.h>
 #include <nuttx/note/noteram_driver.h>
 #include <nuttx/fs/fs.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With CONFIG_DRIVER_NOTERAM_PERCPU each CPU records into a buffer of its
+ * own.  Otherwise all CPUs share one buffer.
+ */
+
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+#  define NOTERAM_NBUFFERS  CONFIG_SMP_NCPUS
+#else
+#  define NOTERAM_NBUFFERS  1
+#endif
+
+/* The head, tail and read indices of a buffer do not wrap at the end of the
+ * buffer but at a large multiple of its size.  The byte of an index is
+ * found modulo the buffer size.  That way, the reader can tell if the notes
+ * at its read index were removed by the producer in the meantime.
+ */
+
+#define NOTERAM_WRAP \
+  ((UINT_MAX / 2 / CONFIG_DRIVER_NOTERAM_BUFSIZE) * \
+   CONFIG_DRIVER_NOTERAM_BUFSIZE)
+
+#define NOTERAM_BYTE(ni, ndx) \
+  ((ni)->ni_buffer[(ndx) % CONFIG_DRIVER_NOTERAM_BUFSIZE])
+
+/* Barrier between the buffer contents and the indices */
+
+#ifdef CONFIG_SMP
+#  define noteram_barrier() SP_DMB()
+#else
+#  define noteram_barrier()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One circular note buffer.  The producer (sched_note_add()) writes the
+ * head and tail indices, the reader writes the read and start indices.
+ * Neither takes a lock to access the buffer.
+ */
+
 struct noteram_info_s
 {
-  unsigned int ni_overwrite;
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
-  volatile unsigned int ni_read;
+  volatile unsigned int ni_head;   /* Index just past the newest note */
+  volatile unsigned int ni_tail;   /* Index of the oldest note */
+  volatile unsigned int ni_start;  /* Oldest note not cleared by the reader */
+  volatile unsigned int ni_read;   /* Index of the next note to read */
   uint8_t ni_buffer[CONFIG_DRIVER_NOTERAM_BUFSIZE];
 };
 
@@ -92,27 +137,64 @@ static const struct file_operations g_noteram_fops =
 #endif
 };
 
-static struct noteram_info_s g_noteram_info =
-{
+static struct noteram_info_s g_noteram_info[NOTERAM_NBUFFERS];
+
+static volatile unsigned int g_noteram_overwrite =
 #ifdef CONFIG_DRIVER_NOTERAM_DEFAULT_NOOVERWRITE
-  NOTERAM_MODE_OVERWRITE_DISABLE
+  NOTERAM_MODE_OVERWRITE_DISABLE;
 #else
-  NOTERAM_MODE_OVERWRITE_ENABLE
+  NOTERAM_MODE_OVERWRITE_ENABLE;
 #endif
-};
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
 static struct noteram_taskname_s g_noteram_taskname;
 #endif
 
+/* With a shared buffer, this lock serializes the producers on all CPUs.
+ * With per-CPU buffers, it only protects the task name buffer.
+ */
+
 #ifdef CONFIG_SMP
 static volatile spinlock_t g_noteram_lock;
 #endif
 
+/* Serializes the readers of /dev/note */
+
+static mutex_t g_noteram_readlock = NXMUTEX_INITIALIZER;
+
+/* A copy of the next note of each buffer, taken by the reader */
+
+static uint8_t g_noteram_stage[NOTERAM_NBUFFERS][UINT8_MAX];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: noteram_lock and noteram_unlock
+ *
+ * Description:
+ *   Disable local interrupts and, on SMP, take the spinlock of the driver.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t noteram_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_noteram_lock);
+#endif
+  return flags;
+}
+
+static inline void noteram_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_noteram_lock);
+#endif
+  up_irq_restore(flags);
+}
+
 /****************************************************************************
  * Name: noteram_find_taskname
  *
@@ -251,11 +333,13 @@ static void noteram_remove_taskname(pid_t pid)
 static const char *noteram_get_taskname(pid_t pid)
 {
   irqstate_t irq_mask;
+  irqstate_t flags;
   const char *ret = NULL;
   FAR struct noteram_taskname_info_s *ti;
   FAR struct tcb_s *tcb;
 
   irq_mask = enter_critical_section();
+  flags = noteram_lock();
 
   ti = noteram_find_taskname(pid);
   if (ti != NULL)
@@ -272,46 +356,12 @@ static const char *noteram_get_taskname(pid_t pid)
         }
     }
 
+  noteram_unlock(flags);
   leave_critical_section(irq_mask);
   return ret;
 }
 #endif
 
-/****************************************************************************
- * Name: noteram_buffer_clear
- *
- * Description:
- *   Clear all contents of the circular buffer.
- *
- * Input Parameters:
- *   None.
- *
- * Returned Value:
- *   None.
- *
- ****************************************************************************/
-
-static void noteram_buffer_clear(void)
-{
-  irqstate_t flags;
-
-  flags = enter_critical_section();
-
-  g_noteram_info.ni_tail = g_noteram_info.ni_head;
-  g_noteram_info.ni_read = g_noteram_info.ni_head;
-
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
-    {
-      g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
-    }
-
-#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
-  g_noteram_taskname.buffer_used = 0;
-#endif
-
-  leave_critical_section(flags);
-}
-
 /****************************************************************************
  * Name: noteram_next
  *
@@ -320,7 +370,8 @@ static void noteram_buffer_clear(void)
  *   value, handling wraparound
  *
  * Input Parameters:
- *   ndx - Old circular buffer index
+ *   ndx    - Old circular buffer index
+ *   offset - The offset to add
  *
  * Returned Value:
  *   New circular buffer index
@@ -331,66 +382,98 @@ static inline unsigned int noteram_next(unsigned int ndx,
                                         unsigned int offset)
 {
   ndx += offset;
-  if (ndx >= CONFIG_DRIVER_NOTERAM_BUFSIZE)
+  if (ndx >= NOTERAM_WRAP)
     {
-      ndx -= CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      ndx -= NOTERAM_WRAP;
     }
 
   return ndx;
 }
 
 /****************************************************************************
- * Name: noteram_length
+ * Name: noteram_distance
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Return the number of bytes from the index 'from' forward to the index
+ *   'to', handling wraparound.
  *
- * Input Parameters:
- *   None
+ ****************************************************************************/
+
+static inline unsigned int noteram_distance(unsigned int from,
+                                            unsigned int to)
+{
+  return to >= from ? to - from : to + NOTERAM_WRAP - from;
+}
+
+/****************************************************************************
+ * Name: noteram_first
  *
- * Returned Value:
- *   Length of data currently in circular buffer.
+ * Description:
+ *   Return the index of the oldest note of a buffer that is still to be
+ *   reported:  The tail index or the start index set by the last
+ *   NOTERAM_CLEAR, whatever is newer.
  *
  ****************************************************************************/
 
-static unsigned int noteram_length(void)
+static unsigned int noteram_first(FAR struct noteram_info_s *ni,
+                                  unsigned int head)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int tail = g_noteram_info.ni_tail;
+  unsigned int tail = ni->ni_tail;
+  unsigned int start = ni->ni_start;
 
-  if (tail > head)
+  if (noteram_distance(tail, start) <= noteram_distance(tail, head))
     {
-      head += CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      tail = start;
     }
 
-  return head - tail;
+  return tail;
 }
 
 /****************************************************************************
- * Name: noteram_unread_length
+ * Name: noteram_buffer_clear
  *
  * Description:
- *   Length of unread data currently in circular buffer.
+ *   Clear all contents of the circular buffers.
  *
  * Input Parameters:
- *   None
+ *   None.
  *
  * Returned Value:
- *   Length of unread data currently in circular buffer.
+ *   None.
  *
  ****************************************************************************/
 
-static unsigned int noteram_unread_length(void)
+static void noteram_buffer_clear(void)
 {
-  unsigned int head = g_noteram_info.ni_head;
-  unsigned int read = g_noteram_info.ni_read;
+  FAR struct noteram_info_s *ni;
+#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+  irqstate_t flags;
+#endif
+  int i;
+
+  /* The producers free the cleared notes as they find the start index
+   * moved.
+   */
+
+  for (i = 0; i < NOTERAM_NBUFFERS; i++)
+    {
+      ni           = &g_noteram_info[i];
+      ni->ni_start = ni->ni_head;
+      ni->ni_read  = ni->ni_start;
+    }
+
+  noteram_barrier();
 
-  if (read > head)
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-      head += CONFIG_DRIVER_NOTERAM_BUFSIZE;
+      g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
     }
 
-  return head - read;
+#if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
+  flags = noteram_lock();
+  g_noteram_taskname.buffer_used = 0;
+  noteram_unlock(flags);
+#endif
 }
 
 /****************************************************************************
@@ -400,33 +483,29 @@ static unsigned int noteram_unread_length(void)
  *   Remove the variable length note from the tail of the circular buffer
  *
  * Input Parameters:
- *   None
+ *   ni   - The circular buffer
+ *   tail - The tail index of the circular buffer
  *
  * Returned Value:
- *   None
+ *   The new tail index
  *
  * Assumptions:
- *   We are within a critical section.
+ *   Called by the producer of the buffer with local interrupts disabled.
  *
  ****************************************************************************/
 
-static void noteram_remove(void)
+static unsigned int noteram_remove(FAR struct noteram_info_s *ni,
+                                   unsigned int tail)
 {
-  unsigned int tail;
   unsigned int length;
 
-  /* Get the tail index of the circular buffer */
-
-  tail = g_noteram_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
   /* Get the length of the note at the tail index */
 
-  length = g_noteram_info.ni_buffer[tail];
-  DEBUGASSERT(length <= noteram_length());
+  length = NOTERAM_BYTE(ni, tail);
+  DEBUGASSERT(length > 0 && length <= CONFIG_DRIVER_NOTERAM_BUFSIZE);
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
-  if (g_noteram_info.ni_buffer[noteram_next(tail, 1)] == NOTE_STOP)
+  if (NOTERAM_BYTE(ni, tail + 1) == NOTE_STOP)
     {
       uint8_t nc_pid[2];
 
@@ -435,14 +514,20 @@ static void noteram_remove(void)
        */
 
 #ifdef CONFIG_SMP
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 5)];
+      nc_pid[0] = NOTERAM_BYTE(ni, tail + 4);
+      nc_pid[1] = NOTERAM_BYTE(ni, tail + 5);
 #else
-      nc_pid[0] = g_noteram_info.ni_buffer[noteram_next(tail, 3)];
-      nc_pid[1] = g_noteram_info.ni_buffer[noteram_next(tail, 4)];
+      nc_pid[0] = NOTERAM_BYTE(ni, tail + 3);
+      nc_pid[1] = NOTERAM_BYTE(ni, tail + 4);
 #endif
 
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+      spin_lock_wo_note(&g_noteram_lock);
+#endif
       noteram_remove_taskname(nc_pid[0] + (nc_pid[1] << 8));
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+      spin_unlock_wo_note(&g_noteram_lock);
+#endif
     }
 #endif
 
@@ -450,151 +535,136 @@ static void noteram_remove(void)
    * buffer.
    */
 
-  if (g_noteram_info.ni_read == g_noteram_info.ni_tail)
-    {
-      /* The read index also needs increment. */
-
-      g_noteram_info.ni_read = noteram_next(tail, length);
-    }
-
-  g_noteram_info.ni_tail = noteram_next(tail, length);
+  return noteram_next(tail, length);
 }
 
 /****************************************************************************
- * Name: noteram_get
+ * Name: noteram_peek
  *
  * Description:
- *   Get the next note from the read index of the circular buffer.
+ *   Copy the next note at the read index of a circular buffer without
+ *   removing it.  The read index is moved forward first if the producer
+ *   has removed the notes at the read index.
  *
  * Input Parameters:
- *   buffer - Location to return the next note
- *   buflen - The length of the user provided buffer.
+ *   ni     - The circular buffer
+ *   buffer - Location to return the next note, UINT8_MAX bytes
  *
  * Returned Value:
- *   On success, the positive, non-zero length of the return note is
- *   provided.  Zero is returned only if the circular buffer is empty.  A
- *   negated errno value is returned in the event of any failure.
+ *   The length of the note or zero if the circular buffer is empty.
  *
  ****************************************************************************/
 
-static ssize_t noteram_get(FAR uint8_t *buffer, size_t buflen)
+static size_t noteram_peek(FAR struct noteram_info_s *ni,
+                           FAR uint8_t *buffer)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int remaining;
+  unsigned int head;
   unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
-
-  DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
-
-  /* Verify that the circular buffer is not empty */
-
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
-    {
-      notelen = 0;
-      goto errout_with_csection;
-    }
-
-  /* Get the read index of the circular buffer */
-
-  read    = g_noteram_info.ni_read;
-  DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
-  /* Get the length of the note at the read index */
+  unsigned int first;
+  irqstate_t flags;
+  size_t notelen;
+  size_t i;
 
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  /* Only local interrupts are disabled so that the copy is not delayed;
+   * the producers on other CPUs go on.
+   */
 
-  /* Is the user buffer large enough to hold the note? */
+  flags = up_irq_save();
 
-  if (buflen < notelen)
+  for (; ; )
     {
-      /* Skip the large note so that we do not get constipated. */
+      head = ni->ni_head;
+      noteram_barrier();
 
-      g_noteram_info.ni_read = noteram_next(read, notelen);
+      /* Skip the notes that were removed or cleared */
 
-      /* and return an error */
+      read  = ni->ni_read;
+      first = noteram_first(ni, head);
+      if (noteram_distance(first, read) > noteram_distance(first, head))
+        {
+          read = first;
+          ni->ni_read = read;
+        }
 
-      notelen = -EFBIG;
-      goto errout_with_csection;
-    }
+      if (read == head)
+        {
+          notelen = 0;
+          break;
+        }
 
-  /* Loop until the note has been transferred to the user buffer */
+      notelen = NOTERAM_BYTE(ni, read);
+      if (notelen > 0 && notelen <= noteram_distance(read, head))
+        {
+          for (i = 0; i < notelen; i++)
+            {
+              buffer[i] = NOTERAM_BYTE(ni, read + i);
+            }
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the read index */
+          /* The copy is only valid if the producer did not remove the note
+           * while it was taken.
+           */
 
-      *buffer++ = g_noteram_info.ni_buffer[read];
+          noteram_barrier();
+          first = ni->ni_tail;
+          if (noteram_distance(first, read) <=
+              noteram_distance(first, ni->ni_head))
+            {
+              break;
+            }
+        }
 
-      /* Adjust indices and counts */
+      /* The note was overwritten, try again with the oldest note */
 
-      read = noteram_next(read, 1);
-      remaining--;
+      ni->ni_read = ni->ni_tail;
     }
 
-  g_noteram_info.ni_read = read;
-
-errout_with_csection:
-  leave_critical_section(flags);
+  up_irq_restore(flags);
   return notelen;
 }
 
 /****************************************************************************
- * Name: noteram_size
+ * Name: noteram_timestamp
  *
  * Description:
- *   Return the size of the next note at the read index of the circular
- *   buffer.
- *
- * Input Parameters:
- *   None.
- *
- * Returned Value:
- *   Zero is returned if the circular buffer is empty.  Otherwise, the size
- *   of the next note is returned.
+ *   Return the time stamp of a note as one number for ordering the notes of
+ *   different buffers.
  *
  ****************************************************************************/
 
-static ssize_t noteram_size(void)
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+static uint64_t noteram_timestamp(FAR const uint8_t *buffer)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
+  FAR const struct note_common_s *note =
+    (FAR const struct note_common_s *)buffer;
+  uint64_t value = 0;
+  int i;
 
-  flags = enter_critical_section();
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  uint64_t nsec = 0;
 
-  /* Verify that the circular buffer is not empty */
+  /* The fields are stored in little endian order */
 
-  circlen = noteram_unread_length();
-  if (circlen <= 0)
+  for (i = sizeof(note->nc_systime_sec) - 1; i >= 0; i--)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      value = (value << 8) | note->nc_systime_sec[i];
     }
 
-  /* Get the read index of the circular buffer */
-
-  read = g_noteram_info.ni_read;
-  DEBUGASSERT(read < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-
-  /* Get the length of the note at the read index */
+  for (i = sizeof(note->nc_systime_nsec) - 1; i >= 0; i--)
+    {
+      nsec = (nsec << 8) | note->nc_systime_nsec[i];
+    }
 
-  note    = (FAR struct note_common_s *)&g_noteram_info.ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  value = value * NSEC_PER_SEC + nsec;
+#else
+  for (i = sizeof(note->nc_systime) - 1; i >= 0; i--)
+    {
+      value = (value << 8) | note->nc_systime[i];
+    }
+#endif
 
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+  return value;
 }
+#endif
 
 /****************************************************************************
  * Name: noteram_open
@@ -602,70 +672,137 @@ errout_with_csection:
 
 static int noteram_open(FAR struct file *filep)
 {
-  /* Reset the read index of the circular buffer */
+  int ret;
+  int i;
+
+  ret = nxmutex_lock(&g_noteram_readlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
-  g_noteram_info.ni_read = g_noteram_info.ni_tail;
+  /* Reset the read index of the circular buffers */
 
+  for (i = 0; i < NOTERAM_NBUFFERS; i++)
+    {
+      g_noteram_info[i].ni_read = g_noteram_info[i].ni_tail;
+    }
+
+  nxmutex_unlock(&g_noteram_readlock);
   return OK;
 }
 
 /****************************************************************************
  * Name: noteram_read
+ *
+ * Description:
+ *   Return as many notes as fit into the user buffer.  With per-CPU
+ *   buffers, the notes of all CPUs are merged in the order of their time
+ *   stamps.
+ *
  ****************************************************************************/
 
 static ssize_t noteram_read(FAR struct file *filep,
                             FAR char *buffer, size_t buflen)
 {
-  ssize_t notelen;
-  ssize_t retlen ;
+  FAR struct noteram_info_s *ni;
+  size_t stagelen[NOTERAM_NBUFFERS];
+  unsigned int stageread[NOTERAM_NBUFFERS];
+  ssize_t retlen = 0;
+  size_t notelen;
+  int next;
+  int ret;
+  int i;
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+  uint64_t nexttime = 0;
+  uint64_t timestamp;
+#endif
 
   DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
 
+  ret = nxmutex_lock(&g_noteram_readlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memset(stagelen, 0, sizeof(stagelen));
+
   /* Then loop, adding as many notes as possible to the user buffer. */
 
-  retlen = 0;
-  sched_lock();
-  do
+  for (; ; )
     {
-      /* Get the next note (removing it from the buffer) */
+      /* Take a copy of the next note of each buffer and select the oldest
+       * one.
+       */
 
-      notelen = noteram_get((FAR uint8_t *)buffer, buflen);
-      if (notelen < 0)
+      next = -1;
+      for (i = 0; i < NOTERAM_NBUFFERS; i++)
         {
-          /* We were unable to read the next note, probably because it will
-           * not fit into the user buffer.
-           */
+          ni = &g_noteram_info[i];
+          if (stagelen[i] == 0)
+            {
+              stagelen[i]  = noteram_peek(ni, g_noteram_stage[i]);
+              stageread[i] = ni->ni_read;
+              if (stagelen[i] == 0)
+                {
+                  continue;
+                }
+            }
+
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+          timestamp = noteram_timestamp(g_noteram_stage[i]);
+          if (next < 0 || timestamp < nexttime)
+            {
+              nexttime = timestamp;
+              next     = i;
+            }
+#else
+          next = i;
+#endif
+        }
 
+      if (next < 0)
+        {
+          /* All buffers are empty */
+
+          break;
+        }
+
+      /* Is the user buffer large enough to hold the note? */
+
+      notelen = stagelen[next];
+      if (notelen > buflen)
+        {
           if (retlen == 0)
             {
-              /* If nothing was read then report the error.  Otherwise,
-               * just silently drop the note.
+              /* Skip the large note so that we do not get constipated, and
+               * report the error.  Otherwise, just leave the note for the
+               * next read.
                */
 
-              retlen = notelen;
+              ni = &g_noteram_info[next];
+              ni->ni_read = noteram_next(stageread[next], notelen);
+              retlen = -EFBIG;
             }
 
           break;
         }
 
-      /* Update pointers from the note that was transferred */
+      /* Transfer the note and remove it from the buffer */
+
+      memcpy(buffer, g_noteram_stage[next], notelen);
+
+      ni = &g_noteram_info[next];
+      ni->ni_read = noteram_next(stageread[next], notelen);
+      stagelen[next] = 0;
 
       retlen += notelen;
       buffer += notelen;
       buflen -= notelen;
-
-      /* Will the next note fit?  There is a race here and even if the next
-       * note will fit, it may fail still when noteram_get() is called.
-       *
-       * It won't fit (or an error occurred).  Return what we have without
-       * trying to get the next note (which would cause it to be deleted).
-       */
-
-      notelen = noteram_size();
     }
-  while (notelen > 0 && notelen <= buflen);
 
-  sched_unlock();
+  nxmutex_unlock(&g_noteram_readlock);
   return retlen;
 }
 
@@ -687,8 +824,12 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
        */
 
       case NOTERAM_CLEAR:
-        noteram_buffer_clear();
-        ret = OK;
+        ret = nxmutex_lock(&g_noteram_readlock);
+        if (ret >= 0)
+          {
+            noteram_buffer_clear();
+            nxmutex_unlock(&g_noteram_readlock);
+          }
         break;
 
       /* NOTERAM_GETMODE
@@ -703,7 +844,7 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            *(unsigned int *)arg = g_noteram_info.ni_overwrite;
+            *(unsigned int *)arg = g_noteram_overwrite;
             ret = OK;
           }
         break;
@@ -720,7 +861,7 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
           }
         else
           {
-            g_noteram_info.ni_overwrite = *(unsigned int *)arg;
+            g_noteram_overwrite = *(unsigned int *)arg;
             ret = OK;
           }
         break;
@@ -792,23 +933,28 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
 
 void sched_note_add(FAR const void *note, size_t notelen)
 {
-  FAR const char *buf = note;
+  FAR struct noteram_info_s *ni;
+  FAR const uint8_t *buf = note;
   unsigned int head;
-  unsigned int next;
+  unsigned int tail;
   irqstate_t flags;
+  size_t i;
 
+  /* With per-CPU buffers, this CPU is the only producer of its buffer and
+   * disabling the local interrupts suffices.
+   */
+
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
   flags = up_irq_save();
-#ifdef CONFIG_SMP
-  spin_lock_wo_note(&g_noteram_lock);
+  ni    = &g_noteram_info[up_cpu_index()];
+#else
+  flags = noteram_lock();
+  ni    = &g_noteram_info[0];
 #endif
 
-  if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-#ifdef CONFIG_SMP
-      spin_unlock_wo_note(&g_noteram_lock);
-#endif
-      up_irq_restore(flags);
-      return;
+      goto out;
     }
 
 #if CONFIG_DRIVER_NOTERAM_TASKNAME_BUFSIZE > 0
@@ -820,61 +966,68 @@ void sched_note_add(FAR const void *note, size_t notelen)
       note_st = (FAR struct note_start_s *)note;
       if (note_st->nst_cmn.nc_type == NOTE_START)
         {
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+          spin_lock_wo_note(&g_noteram_lock);
+#endif
           noteram_record_taskname(note_st->nst_cmn.nc_pid[0] +
                                   (note_st->nst_cmn.nc_pid[1] << 8),
                                   note_st->nst_name);
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
+          spin_unlock_wo_note(&g_noteram_lock);
+#endif
         }
     }
 #endif
 
-  /* Get the index to the head of the circular buffer */
-
   DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
-  head = g_noteram_info.ni_head;
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  /* Get the head and tail indices of the circular buffer.  Notes cleared by
+   * the reader are free space, too.
+   */
 
-  while (notelen > 0)
-    {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
+  head = ni->ni_head;
+  tail = noteram_first(ni, head);
 
-      next = noteram_next(head, 1);
-      if (next == g_noteram_info.ni_tail)
-        {
-          if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
-            {
-              /* Stop recording if not in overwrite mode */
+  /* Remove notes at the tail until the new note fits */
 
-              g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+  while (noteram_distance(tail, head) + notelen >
+         CONFIG_DRIVER_NOTERAM_BUFSIZE)
+    {
+      if (g_noteram_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
+        {
+          /* Stop recording if not in overwrite mode */
 
-#ifdef CONFIG_SMP
-              spin_unlock_wo_note(&g_noteram_lock);
-#endif
-              up_irq_restore(flags);
-              return;
-            }
+          g_noteram_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          break;
+        }
 
-          /* Yes, then remove the note at the tail index */
+      tail = noteram_remove(ni, tail);
+    }
 
-          noteram_remove();
-        }
+  /* Publish the new tail index before the removed notes are overwritten,
+   * then the note before the new head index.
+   */
 
-      /* Save the next byte at the head index */
+  ni->ni_tail = tail;
+  noteram_barrier();
 
-      g_noteram_info.ni_buffer[head] = *buf++;
+  if (g_noteram_overwrite != NOTERAM_MODE_OVERWRITE_OVERFLOW)
+    {
+      for (i = 0; i < notelen; i++)
+        {
+          NOTERAM_BYTE(ni, head + i) = buf[i];
+        }
 
-      head = next;
-      notelen--;
+      noteram_barrier();
+      ni->ni_head = noteram_next(head, notelen);
     }
 
-  g_noteram_info.ni_head = head;
-
-#ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_noteram_lock);
-#endif
+out:
+#ifdef CONFIG_DRIVER_NOTERAM_PERCPU
   up_irq_restore(flags);
+#else
+  noteram_unlock(flags);
+#endif
 }
 
 /****************************************************************************
@@ -0,0 +1,591 @@
+/****************************************************************************
+ * drivers/note/notestream_driver.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/kthread.h>
+#include <nuttx/sched.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/note/notestream_driver.h>
+
+#if defined(CONFIG_DRIVER_NOTESTREAM_TCP)
+#  include <sys/socket.h>
+#  include <netinet/in.h>
+#  include <nuttx/net/net.h>
+#elif defined(CONFIG_DRIVER_NOTESTREAM_RTT)
+#  include <SEGGER_RTT.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the blocks of notes sent at once.  A record is never
+ * split:  Its length is a byte, so that any record fits in a block.
+ */
+
+#define NOTESTREAM_CHUNK  256
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The circular buffer of the notes not sent yet.  The producers
+ * (sched_note_add()) move the head index, the streaming thread the tail
+ * index.  Both take the lock, only for the time of a copy.
+ */
+
+static uint8_t g_notestream_buffer[CONFIG_DRIVER_NOTESTREAM_BUFSIZE];
+static volatile size_t g_notestream_head;
+static volatile size_t g_notestream_tail;
+
+/* The number of notes lost because the buffer was full */
+
+static volatile uint32_t g_notestream_dropped;
+
+#ifdef CONFIG_SMP
+static volatile spinlock_t g_notestream_lock;
+#endif
+
+/* The destination of the stream */
+
+#if defined(CONFIG_DRIVER_NOTESTREAM_DEVICE)
+static struct file g_notestream_file;
+#elif defined(CONFIG_DRIVER_NOTESTREAM_TCP)
+static struct socket g_notestream_listen;
+static struct socket g_notestream_conn;
+static bool g_notestream_listening;
+#elif defined(CONFIG_DRIVER_NOTESTREAM_RTT)
+static char g_notestream_rttbuf[CONFIG_DRIVER_NOTESTREAM_RTT_BUFSIZE];
+#endif
+
+/* A copy of the notes being sent */
+
+static uint8_t g_notestream_chunk[NOTESTREAM_CHUNK];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: notestream_lock and notestream_unlock
+ *
+ * Description:
+ *   Disable local interrupts and, on SMP, take the spinlock of the driver.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t notestream_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_notestream_lock);
+#endif
+  return flags;
+}
+
+static inline void notestream_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_notestream_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: notestream_put
+ *
+ * Description:
+ *   Add a record to the circular buffer as a whole, or count it as lost if
+ *   it does not fit.  Called with the lock held.
+ *
+ ****************************************************************************/
+
+static void notestream_put(FAR const void *record, size_t len)
+{
+  FAR const uint8_t *buf = record;
+  size_t head = g_notestream_head;
+  size_t space;
+  size_t chunk;
+
+  space = (g_notestream_tail + CONFIG_DRIVER_NOTESTREAM_BUFSIZE - head - 1) %
+          CONFIG_DRIVER_NOTESTREAM_BUFSIZE;
+  if (len > space)
+    {
+      g_notestream_dropped++;
+      return;
+    }
+
+  chunk = CONFIG_DRIVER_NOTESTREAM_BUFSIZE - head;
+  if (chunk > len)
+    {
+      chunk = len;
+    }
+
+  memcpy(&g_notestream_buffer[head], buf, chunk);
+  memcpy(g_notestream_buffer, &buf[chunk], len - chunk);
+
+  g_notestream_head = (head + len) % CONFIG_DRIVER_NOTESTREAM_BUFSIZE;
+}
+
+/****************************************************************************
+ * Name: notestream_get
+ *
+ * Description:
+ *   Copy the whole records from the tail of the circular buffer that fit
+ *   in the block, without removing them.  Called with the lock held.
+ *
+ * Returned Value:
+ *   The number of bytes copied.  *newtail is set to the index of the tail
+ *   once they are sent.
+ *
+ ****************************************************************************/
+
+static size_t notestream_get(FAR uint8_t *chunk, FAR size_t *newtail)
+{
+  size_t head = g_notestream_head;
+  size_t tail = g_notestream_tail;
+  size_t used;
+  size_t reclen;
+  size_t part;
+  size_t len = 0;
+
+  used = (head + CONFIG_DRIVER_NOTESTREAM_BUFSIZE - tail) %
+         CONFIG_DRIVER_NOTESTREAM_BUFSIZE;
+
+  while (used > 0)
+    {
+      /* The first byte of each record is its length */
+
+      reclen = g_notestream_buffer[tail];
+      DEBUGASSERT(reclen > 0 && reclen <= used);
+
+      if (len + reclen > NOTESTREAM_CHUNK)
+        {
+          break;
+        }
+
+      part = CONFIG_DRIVER_NOTESTREAM_BUFSIZE - tail;
+      if (part > reclen)
+        {
+          part = reclen;
+        }
+
+      memcpy(&chunk[len], &g_notestream_buffer[tail], part);
+      memcpy(&chunk[len + part], g_notestream_buffer, reclen - part);
+
+      len  += reclen;
+      used -= reclen;
+      tail  = (tail + reclen) % CONFIG_DRIVER_NOTESTREAM_BUFSIZE;
+    }
+
+  *newtail = tail;
+  return len;
+}
+
+/****************************************************************************
+ * Name: notestream_flatten
+ *
+ * Description:
+ *   Copy a value in the little endian layout of the notes.
+ *
+ ****************************************************************************/
+
+static void notestream_flatten(FAR uint8_t *dst, uint32_t value,
+                               size_t len)
+{
+  while (len-- > 0)
+    {
+      *dst++ = value & 0xff;
+      value >>= 8;
+    }
+}
+
+/****************************************************************************
+ * Name: notestream_taskname
+ *
+ * Description:
+ *   Record the name of an existing task, for the tasks that were started
+ *   before the stream was opened.
+ *
+ ****************************************************************************/
+
+static void notestream_taskname(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  uint8_t data[sizeof(struct notestream_taskname_s) +
+               CONFIG_TASK_NAME_SIZE];
+  FAR struct notestream_taskname_s *rec =
+    (FAR struct notestream_taskname_s *)data;
+  irqstate_t flags;
+  size_t len = 0;
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  len = strnlen(tcb->name, CONFIG_TASK_NAME_SIZE);
+  memcpy(rec->nt_name, tcb->name, len);
+#endif
+
+  rec->nt_name[len] = '\0';
+  rec->nt_length    = sizeof(struct notestream_taskname_s) + len;
+  rec->nt_type      = NOTESTREAM_TASKNAME;
+  notestream_flatten(rec->nt_pid, tcb->pid, sizeof(rec->nt_pid));
+
+  flags = notestream_lock();
+  notestream_put(rec, rec->nt_length);
+  notestream_unlock(flags);
+}
+
+/****************************************************************************
+ * Name: notestream_open
+ *
+ * Description:
+ *   Open the destination of the stream:  Wait for the device to be
+ *   available or for a client to connect.
+ *
+ ****************************************************************************/
+
+static int notestream_open(void)
+{
+#if defined(CONFIG_DRIVER_NOTESTREAM_DEVICE)
+  return file_open(&g_notestream_file, CONFIG_DRIVER_NOTESTREAM_PATH,
+                   O_WRONLY);
+
+#elif defined(CONFIG_DRIVER_NOTESTREAM_TCP)
+  struct sockaddr_in addr;
+  int ret;
+
+  if (!g_notestream_listening)
+    {
+      ret = psock_socket(AF_INET, SOCK_STREAM, 0, &g_notestream_listen);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      addr.sin_family      = AF_INET;
+      addr.sin_port        = HTONS(CONFIG_DRIVER_NOTESTREAM_PORT);
+      addr.sin_addr.s_addr = INADDR_ANY;
+
+      ret = psock_bind(&g_notestream_listen, (FAR struct sockaddr *)&addr,
+                       sizeof(struct sockaddr_in));
+      if (ret >= 0)
+        {
+          ret = psock_listen(&g_notestream_listen, 1);
+        }
+
+      if (ret < 0)
+        {
+          psock_close(&g_notestream_listen);
+          return ret;
+        }
+
+      g_notestream_listening = true;
+    }
+
+  return psock_accept(&g_notestream_listen, NULL, NULL,
+                      &g_notestream_conn);
+
+#elif defined(CONFIG_DRIVER_NOTESTREAM_RTT)
+  SEGGER_RTT_ConfigUpBuffer(CONFIG_DRIVER_NOTESTREAM_RTT_CHANNEL,
+                            "NuttX notes", g_notestream_rttbuf,
+                            sizeof(g_notestream_rttbuf),
+                            SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+  return OK;
+#endif
+}
+
+/****************************************************************************
+ * Name: notestream_close
+ ****************************************************************************/
+
+static void notestream_close(void)
+{
+#if defined(CONFIG_DRIVER_NOTESTREAM_DEVICE)
+  file_close(&g_notestream_file);
+#elif defined(CONFIG_DRIVER_NOTESTREAM_TCP)
+  psock_close(&g_notestream_conn);
+#endif
+}
+
+/****************************************************************************
+ * Name: notestream_send
+ *
+ * Description:
+ *   Send a buffer to the destination of the stream as a whole.
+ *
+ ****************************************************************************/
+
+static int notestream_send(FAR const void *buffer, size_t len)
+{
+  FAR const uint8_t *buf = buffer;
+  ssize_t nsent;
+
+  while (len > 0)
+    {
+#if defined(CONFIG_DRIVER_NOTESTREAM_DEVICE)
+      nsent = file_write(&g_notestream_file, buf, len);
+#elif defined(CONFIG_DRIVER_NOTESTREAM_TCP)
+      nsent = psock_send(&g_notestream_conn, buf, len, 0);
+#elif defined(CONFIG_DRIVER_NOTESTREAM_RTT)
+      nsent = SEGGER_RTT_Write(CONFIG_DRIVER_NOTESTREAM_RTT_CHANNEL,
+                               buf, len);
+      if (nsent == 0)
+        {
+          /* Wait for the debugger to read the RTT buffer */
+
+          nxsig_usleep(CONFIG_DRIVER_NOTESTREAM_INTERVAL * USEC_PER_MSEC);
+          continue;
+        }
+#endif
+
+      if (nsent < 0)
+        {
+          return nsent;
+        }
+      else if (nsent == 0)
+        {
+          return -EPIPE;
+        }
+
+      buf += nsent;
+      len -= nsent;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: notestream_header
+ *
+ * Description:
+ *   Send the header of the stream, then queue the names of the existing
+ *   tasks.
+ *
+ ****************************************************************************/
+
+static int notestream_header(void)
+{
+  struct notestream_header_s header;
+  uint16_t endian = 1;
+  int ret;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.nh_magic, NOTESTREAM_MAGIC, sizeof(header.nh_magic));
+
+  header.nh_version  = NOTESTREAM_VERSION;
+#ifdef CONFIG_SMP
+  header.nh_ncpus    = CONFIG_SMP_NCPUS;
+#else
+  header.nh_ncpus    = 1;
+#endif
+  header.nh_pidsize  = sizeof(pid_t);
+  header.nh_longsize = sizeof(long);
+  header.nh_ptrsize  = sizeof(uintptr_t);
+
+  if (*(FAR uint8_t *)&endian != 0)
+    {
+      header.nh_flags |= NOTESTREAM_FLAG_LITTLE;
+    }
+
+#ifdef CONFIG_SMP
+  header.nh_flags |= NOTESTREAM_FLAG_SMP;
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_HIRES
+  header.nh_flags   |= NOTESTREAM_FLAG_HIRES;
+  header.nh_timesize = sizeof(time_t);
+#else
+  header.nh_timesize = sizeof(clock_t);
+#endif
+
+  notestream_flatten(header.nh_usec_per_tick, USEC_PER_TICK,
+                     sizeof(header.nh_usec_per_tick));
+
+  ret = notestream_send(&header, sizeof(header));
+  if (ret >= 0)
+    {
+      nxsched_foreach(notestream_taskname, NULL);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: notestream_thread
+ *
+ * Description:
+ *   Send the notes as they are recorded, polling the buffer so that the
+ *   producers never have to wake up the thread from the scheduler.
+ *
+ ****************************************************************************/
+
+static int notestream_thread(int argc, FAR char *argv[])
+{
+  struct notestream_dropped_s dropped;
+  irqstate_t flags;
+  uint32_t ndropped;
+  size_t tail;
+  size_t len;
+  int ret;
+
+  for (; ; )
+    {
+      ret = notestream_open();
+      if (ret < 0)
+        {
+          nxsig_usleep(USEC_PER_SEC);
+          continue;
+        }
+
+      ret = notestream_header();
+
+      while (ret >= 0)
+        {
+          /* Take the next block of whole records.  They stay in the
+           * buffer until they are sent, so that the stream starts again
+           * with them after its header if the sending fails.
+           */
+
+          flags    = notestream_lock();
+          len      = notestream_get(g_notestream_chunk, &tail);
+          ndropped = 0;
+
+          /* Report the lost notes once the buffer is drained */
+
+          if (len == 0)
+            {
+              ndropped = g_notestream_dropped;
+              g_notestream_dropped = 0;
+            }
+
+          notestream_unlock(flags);
+
+          if (len > 0)
+            {
+              ret = notestream_send(g_notestream_chunk, len);
+              if (ret >= 0)
+                {
+                  /* Only this thread moves the tail */
+
+                  flags = notestream_lock();
+                  g_notestream_tail = tail;
+                  notestream_unlock(flags);
+                }
+            }
+          else if (ndropped > 0)
+            {
+              dropped.nd_length = sizeof(dropped);
+              dropped.nd_type   = NOTESTREAM_DROPPED;
+              notestream_flatten(dropped.nd_count, ndropped,
+                                 sizeof(dropped.nd_count));
+              ret = notestream_send(&dropped, sizeof(dropped));
+            }
+          else
+            {
+              nxsig_usleep(CONFIG_DRIVER_NOTESTREAM_INTERVAL *
+                           USEC_PER_MSEC);
+            }
+        }
+
+      notestream_close();
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_note_add
+ *
+ * Description:
+ *   Add the variable length note to the streaming buffer
+ *
+ * Input Parameters:
+ *   note    - The note buffer
+ *   notelen - The buffer length
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_note_add(FAR const void *note, size_t notelen)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(note != NULL &&
+              notelen < CONFIG_DRIVER_NOTESTREAM_BUFSIZE);
+
+  flags = notestream_lock();
+  notestream_put(note, notelen);
+  notestream_unlock(flags);
+}
+
+/****************************************************************************
+ * Name: notestream_register
+ *
+ * Description:
+ *   Start the thread that streams the notes to the configured device, TCP
+ *   port or RTT channel.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success.  A negated errno value is returned on a failure.
+ *
+ ****************************************************************************/
+
+int notestream_register(void)
+{
+  int ret;
+
+  ret = kthread_create("notestream", CONFIG_DRIVER_NOTESTREAM_PRIORITY,
+                       CONFIG_DRIVER_NOTESTREAM_STACKSIZE,
+                       notestream_thread, NULL);
+  if (ret < 0)
+    {
+      serr("ERROR: Failed to start the note stream: %d\n", ret);
+      return ret;
+    }
+
+  return OK;
+}
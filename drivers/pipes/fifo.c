@@ -51,6 +51,8 @@ static const struct file_operations g_fifo_fops =
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , pipecommon_unlink  /* unlink */
 #endif
+  , pipecommon_readv   /* readv */
+  , pipecommon_writev  /* writev */
 };
 
 /****************************************************************************
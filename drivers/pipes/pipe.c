@@ -62,6 +62,11 @@ static const struct file_operations g_pipe_fops =
   NULL,                /* seek */
   pipecommon_ioctl,    /* ioctl */
   pipecommon_poll      /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL               /* unlink */
+#endif
+  , pipecommon_readv   /* readv */
+  , pipecommon_writev  /* writev */
 };
 
 static sem_t g_pipesem = SEM_INITIALIZER(1);
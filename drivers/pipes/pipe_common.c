@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -60,6 +61,10 @@
 #  define pipe_dumpbuffer(m,a,n)
 #endif
 
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -105,12 +110,81 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
 }
 
+/****************************************************************************
+ * Name: pipecommon_resize
+ *
+ * Description:
+ *   Change the size of the buffer of the pipe to 'size' bytes.  The data
+ *   in the buffer is preserved.  Fails with -EBUSY if the data would not
+ *   fit.
+ *
+ * Assumptions:
+ *   The caller holds d_bfsem.
+ *
+ ****************************************************************************/
+
+static int pipecommon_resize(FAR struct pipe_dev_s *dev, size_t size)
+{
+  FAR uint8_t *buffer;
+  size_t count;
+  size_t n;
+  int sval;
+
+  if (dev->d_wrndx < dev->d_rdndx)
+    {
+      count = (dev->d_bufsize - dev->d_rdndx) + dev->d_wrndx;
+    }
+  else
+    {
+      count = dev->d_wrndx - dev->d_rdndx;
+    }
+
+  if (count > size)
+    {
+      return -EBUSY;
+    }
+
+  /* The buffer is allocated on the first open, only resize it if it is
+   * present.  The data is moved to the start of the new buffer.
+   */
+
+  if (dev->d_buffer != NULL)
+    {
+      buffer = (FAR uint8_t *)kmm_malloc(size + 1);
+      if (buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      n = MIN(count, (size_t)(dev->d_bufsize - dev->d_rdndx));
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], n);
+      memcpy(&buffer[n], dev->d_buffer, count - n);
+
+      kmm_free(dev->d_buffer);
+      dev->d_buffer = buffer;
+      dev->d_rdndx  = 0;
+      dev->d_wrndx  = count;
+    }
+
+  dev->d_bufsize = size + 1; /* +1 to compensate the full indicator */
+
+  /* There may be room for the waiting writers now */
+
+  pipecommon_pollnotify(dev, POLLOUT);
+  while (nxsem_get_value(&dev->d_wrsem, &sval) == 0 && sval <= 0)
+    {
+      nxsem_post(&dev->d_wrsem);
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -391,22 +465,33 @@ int pipecommon_close(FAR struct file *filep)
 }
 
 /****************************************************************************
- * Name: pipecommon_read
+ * Name: pipecommon_readv
+ *
+ * Description:
+ *   Fill the buffers of 'iov' one after the other with whatever is
+ *   available in the pipe, holding the device structure only once.
+ *
  ****************************************************************************/
 
-ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
+ssize_t pipecommon_readv(FAR struct file *filep,
+                         FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode      *inode = filep->f_inode;
   FAR struct pipe_dev_s *dev   = inode->i_private;
-#ifdef CONFIG_DEV_PIPEDUMP
-  FAR uint8_t           *start = (FAR uint8_t *)buffer;
-#endif
   ssize_t                nread = 0;
+  size_t                 len   = 0;
+  size_t                 off   = 0;
   int                    sval;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
 
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
   if (len == 0)
     {
       return 0;
@@ -464,15 +549,44 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
    */
 
   nread = 0;
+  i     = 0;
   while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      size_t n;
+
+      /* Move on to the next user buffer once this one is full */
+
+      if (off >= iov[i].iov_len)
         {
-          dev->d_rdndx = 0;
+          i++;
+          off = 0;
+          continue;
+        }
+
+      /* Copy the contiguous data up to the write index or to the end of
+       * the buffer.
+       */
+
+      if (dev->d_wrndx > dev->d_rdndx)
+        {
+          n = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          n = dev->d_bufsize - dev->d_rdndx;
         }
 
-      nread++;
+      n = MIN(n, iov[i].iov_len - off);
+      memcpy((FAR char *)iov[i].iov_base + off,
+             &dev->d_buffer[dev->d_rdndx], n);
+
+      off          += n;
+      nread        += n;
+      dev->d_rdndx += n;
+      if (dev->d_rdndx >= dev->d_bufsize)
+        {
+          dev->d_rdndx = 0;
+        }
     }
 
   /* Notify all poll/select waiters that they can write to the FIFO */
@@ -489,27 +603,59 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
     }
 
   nxsem_post(&dev->d_bfsem);
-  pipe_dumpbuffer("From PIPE:", start, nread);
   return nread;
 }
 
 /****************************************************************************
- * Name: pipecommon_write
+ * Name: pipecommon_read
  ****************************************************************************/
 
-ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
-                         size_t len)
+ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
+{
+  struct iovec iov;
+  ssize_t nread;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = len;
+
+  nread = pipecommon_readv(filep, &iov, 1);
+  if (nread > 0)
+    {
+      pipe_dumpbuffer("From PIPE:", (FAR uint8_t *)buffer, nread);
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: pipecommon_writev
+ *
+ * Description:
+ *   Write the buffers of 'iov' one after the other, holding the device
+ *   structure only once while there is room in the pipe.
+ *
+ ****************************************************************************/
+
+ssize_t pipecommon_writev(FAR struct file *filep,
+                          FAR const struct iovec *iov, int iovcnt)
 {
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
+  size_t                 len      = 0;
+  size_t                 off      = 0;
+  size_t                 n;
   int                    sval;
   int                    ret;
+  int                    i;
 
   DEBUGASSERT(dev);
-  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, len);
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
 
   /* Handle zero-length writes */
 
@@ -548,6 +694,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   /* Loop until all of the bytes have been written */
 
   last = 0;
+  i    = 0;
   for (; ; )
     {
       /* REVISIT:  "If all file descriptors referring to the read end of a
@@ -562,26 +709,48 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
           return nwritten == 0 ? -EPIPE : nwritten;
         }
 
-      /* Calculate the write index AFTER the next byte is written */
+      /* Calculate the contiguous free space at the write index.  One byte
+       * before the read index always stays free to tell a full buffer
+       * from an empty one.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      if (dev->d_rdndx > dev->d_wrndx)
+        {
+          n = dev->d_rdndx - dev->d_wrndx - 1;
+        }
+      else
         {
-          nxtwrndx = 0;
+          n = dev->d_bufsize - dev->d_wrndx - (dev->d_rdndx == 0);
         }
 
       /* Would the next write overflow the circular buffer? */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if (n > 0)
         {
-          /* No... copy the byte */
+          /* No... skip the user buffers already written and copy as much
+           * of the next one as fits
+           */
+
+          while (off >= iov[i].iov_len)
+            {
+              i++;
+              off = 0;
+            }
+
+          n = MIN(n, iov[i].iov_len - off);
+          memcpy(&dev->d_buffer[dev->d_wrndx],
+                 (FAR const char *)iov[i].iov_base + off, n);
 
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          off          += n;
+          dev->d_wrndx += n;
+          if (dev->d_wrndx >= dev->d_bufsize)
+            {
+              dev->d_wrndx = 0;
+            }
 
           /* Is the write complete? */
 
-          nwritten++;
+          nwritten += n;
           if ((size_t)nwritten >= len)
             {
               /* Notify all poll/select waiters that they can read from the
@@ -607,7 +776,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
         }
       else
         {
-          /* There is not enough room for the next byte.  Was anything
+          /* There is no room for the next byte.  Was anything
            * written in this pass?
            */
 
@@ -664,6 +833,23 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: pipecommon_write
+ ****************************************************************************/
+
+ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t len)
+{
+  struct iovec iov;
+
+  pipe_dumpbuffer("To PIPE:", (FAR uint8_t *)buffer, len);
+
+  iov.iov_base = (FAR void *)buffer;
+  iov.iov_len  = len;
+
+  return pipecommon_writev(filep, &iov, 1);
+}
+
 /****************************************************************************
  * Name: pipecommon_poll
  ****************************************************************************/
@@ -886,6 +1072,28 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      /* Size of the buffer */
+
+      case PIPEIOC_GETSIZE:
+        {
+          *(FAR int *)((uintptr_t)arg) = dev->d_bufsize - 1;
+          ret = 0;
+        }
+        break;
+
+      case PIPEIOC_SETSIZE:
+        {
+          if (arg == 0 || arg > CONFIG_DEV_PIPE_MAXSIZE)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              ret = pipecommon_resize(dev, arg);
+            }
+        }
+        break;
+
       default:
         ret = -ENOTTY;
         break;
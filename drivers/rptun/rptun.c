@@ -56,6 +56,10 @@
 
 #define RPTUNIOC_NONE               0
 
+/* The vrings that the kicks may be deferred for: svq and rvq */
+
+#define RPTUN_NOTIFY_NPENDING       2
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -83,6 +87,11 @@ struct rptun_priv_s
 #ifdef CONFIG_RPTUN_PING
   struct rpmsg_endpoint        ping;
 #endif
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+  pid_t                        batchtid;
+  int                          npending;
+  uint32_t                     pending[RPTUN_NOTIFY_NPENDING];
+#endif
 };
 
 struct rptun_bind_s
@@ -230,9 +239,62 @@ static inline void rptun_pm_action(FAR struct rptun_priv_s *priv,
 #  define rptun_pm_action(priv, stay)
 #endif
 
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+/* While the worker dispatches the received messages, the kicks of the
+ * messages sent and of the buffers released by the callbacks are deferred,
+ * and sent once per vring when the worker is done.
+ */
+
+static bool rptun_defer_notify(FAR struct rptun_priv_s *priv, uint32_t id)
+{
+  int i;
+
+  if (priv->batchtid != gettid())
+    {
+      return false;
+    }
+
+  for (i = 0; i < priv->npending; i++)
+    {
+      if (priv->pending[i] == id)
+        {
+          return true;
+        }
+    }
+
+  if (priv->npending >= RPTUN_NOTIFY_NPENDING)
+    {
+      return false;
+    }
+
+  priv->pending[priv->npending++] = id;
+  return true;
+}
+
+static void rptun_flush_notify(FAR struct rptun_priv_s *priv)
+{
+  int i;
+
+  for (i = 0; i < priv->npending; i++)
+    {
+      RPTUN_NOTIFY(priv->dev, priv->pending[i]);
+    }
+
+  priv->npending = 0;
+}
+#else
+#  define rptun_defer_notify(priv, id) false
+#  define rptun_flush_notify(priv)
+#endif
+
 static void rptun_worker(FAR void *arg)
 {
   FAR struct rptun_priv_s *priv = arg;
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+  pid_t batchtid = priv->batchtid;
+
+  priv->batchtid = gettid();
+#endif
 
   switch (priv->cmd)
     {
@@ -253,6 +315,11 @@ static void rptun_worker(FAR void *arg)
 
   priv->cmd = RPTUNIOC_NONE;
   remoteproc_get_notification(&priv->rproc, RPTUN_NOTIFY_ALL);
+
+  rptun_flush_notify(priv);
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+  priv->batchtid = batchtid;
+#endif
 }
 
 #ifdef CONFIG_RPTUN_WORKQUEUE
@@ -402,7 +469,11 @@ static int rptun_notify(FAR struct remoteproc *rproc, uint32_t id)
       rptun_pm_action(priv, true);
     }
 
-  RPTUN_NOTIFY(priv->dev, id);
+  if (!rptun_defer_notify(priv, id))
+    {
+      RPTUN_NOTIFY(priv->dev, id);
+    }
+
   return 0;
 }
 
@@ -454,8 +525,11 @@ static int rptun_notify_wait(FAR struct remoteproc *rproc, uint32_t id)
       return -EAGAIN;
     }
 
-  /* Wait to wakeup */
+  /* Send the deferred kicks: the remote may be waiting for them to release
+   * the buffers that we wait for.  Then wait to wakeup.
+   */
 
+  rptun_flush_notify(priv);
   nxsem_wait(&priv->semtx);
   rptun_worker(priv);
 
@@ -1191,6 +1265,9 @@ int rptun_initialize(FAR struct rptun_dev_s *dev)
     }
 
   priv->dev = dev;
+#ifdef CONFIG_RPTUN_NOTIFY_BATCH
+  priv->batchtid = INVALID_PROCESS_ID;
+#endif
 
   remoteproc_init(&priv->rproc, &g_rptun_ops, priv);
   metal_list_init(&priv->bind);
@@ -82,6 +82,8 @@ static int rptun_ping_ept_cb(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+/* Return the number of bytes sent, or a negated errno value */
+
 static int rptun_ping_once(FAR struct rpmsg_endpoint *ept,
                            int len, bool ack)
 {
@@ -139,6 +141,8 @@ int rptun_ping(FAR struct rpmsg_endpoint *ept,
   uint32_t min = UINT32_MAX;
   uint32_t max = 0;
   uint64_t total = 0;
+  uint64_t bytes = 0;
+  uint64_t ns;
   struct timespec ts;
   int i;
 
@@ -161,6 +165,7 @@ int rptun_ping(FAR struct rpmsg_endpoint *ept,
       min    = MIN(min, tm);
       max    = MAX(max, tm);
       total += tm;
+      bytes += ret;
 
       usleep(ping->sleep * USEC_PER_MSEC);
     }
@@ -177,6 +182,16 @@ int rptun_ping(FAR struct rpmsg_endpoint *ept,
   up_perf_convert(max, &ts);
   syslog(LOG_INFO, "max: s %" PRIu32 ", ns %ld\n", ts.tv_sec, ts.tv_nsec);
 
+  /* The throughput over the time spent in the sends, without the sleeps */
+
+  up_perf_convert(total / ping->times, &ts);
+  ns = ((uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec) * ping->times;
+  if (ns > 0)
+    {
+      syslog(LOG_INFO, "rate: %" PRIu64 " bytes, %" PRIu64 " KB/s\n",
+             bytes, bytes * NSEC_PER_SEC / 1024 / ns);
+    }
+
   return 0;
 }
 
@@ -48,10 +48,23 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#define L3GD20_CTRL_REG_1_DR_MASK (L3GD20_CTRL_REG_1_DR_1_BM | \
+                                   L3GD20_CTRL_REG_1_DR_0_BM)
+
+#define L3GD20_NODR (sizeof(g_l3gd20_odr) / sizeof(g_l3gd20_odr[0]))
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* An output data rate of the gyroscope */
+
+struct l3gd20_odr_s
+{
+  unsigned long interval;             /* Sampling interval, in us */
+  uint8_t       dr;                   /* DR bits of CTRL_REG1 */
+};
+
 struct l3gd20_dev_s
 {
   FAR struct l3gd20_dev_s *flink;     /* Supports a singly linked list of
@@ -61,11 +74,18 @@ struct l3gd20_dev_s
                                        * L3GD20 sensor */
   uint64_t timestamp;                 /* Units is microseconds */
   struct sensor_lowerhalf_s lower;    /* The struct of lower half driver */
+  uint8_t dr;                         /* DR bits of the data rate */
+  bool activated;                     /* The sensor is measuring */
 #if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
   struct work_s work;                 /* The work queue is responsible for
                                        * retrieving the data from the sensor
                                        * after the arrival of new data was
                                        * signalled in an interrupt */
+  struct sensor_batch_s batch;        /* The state of the FIFO */
+
+  /* The samples drained from the FIFO */
+
+  struct sensor_gyro fifo[L3GD20_FIFO_SIZE];
 #endif
 };
 
@@ -73,7 +93,8 @@ struct l3gd20_dev_s
  * Private Function Prototypes
  ****************************************************************************/
 
-#ifdef CONFIG_DEBUG_SENSORS_INFO
+#if defined(CONFIG_DEBUG_SENSORS_INFO) || \
+    CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
 static void l3gd20_read_register(FAR struct l3gd20_dev_s *dev,
                                  uint8_t const reg_addr, uint8_t *reg_data);
 #endif
@@ -81,18 +102,26 @@ static void l3gd20_write_register(FAR struct l3gd20_dev_s *dev,
                                   uint8_t const reg_addr,
                                   uint8_t const reg_data);
 static void l3gd20_reset(FAR struct l3gd20_dev_s *dev);
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE == 0
 static void l3gd20_read_measurement_data(FAR struct l3gd20_dev_s *dev,
                                          FAR struct sensor_gyro *data);
 static void l3gd20_read_gyroscope_data(FAR struct l3gd20_dev_s *dev,
                                        uint16_t *x_gyr, uint16_t *y_gyr,
                                        uint16_t *z_gyr);
+#endif
 static void l3gd20_read_temperature(FAR struct l3gd20_dev_s *dev,
                                     uint8_t * temperature);
 static int l3gd20_interrupt_handler(int irq, FAR void *context,
                                     FAR void *arg);
 static int l3gd20_activate(FAR struct sensor_lowerhalf_s *lower,
                            FAR struct file *filep, bool enable);
+static int l3gd20_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                               FAR struct file *filep,
+                               FAR unsigned long *period_us);
 #if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+static int l3gd20_batch(FAR struct sensor_lowerhalf_s *lower,
+                        FAR struct file *filep,
+                        FAR unsigned long *latency_us);
 static void l3gd20_worker(FAR void *arg);
 #else
 static int l3gd20_fetch(FAR struct sensor_lowerhalf_s *lower,
@@ -109,16 +138,27 @@ static int l3gd20_fetch(FAR struct sensor_lowerhalf_s *lower,
 static const struct sensor_ops_s g_l2gd20_ops =
 {
   .activate = l3gd20_activate,
-  .set_interval = NULL,
-  .batch = NULL,
+  .set_interval = l3gd20_set_interval,
 #if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+  .batch = l3gd20_batch,
   .fetch = NULL,
 #else
+  .batch = NULL,
   .fetch = l3gd20_fetch,
 #endif
   .control = NULL
 };
 
+/* The output data rates, from the slowest one */
+
+static const struct l3gd20_odr_s g_l3gd20_odr[] =
+{
+  { 10526, 0 },                                /* 95 Hz */
+  { 5263,  L3GD20_CTRL_REG_1_DR_0_BM },        /* 190 Hz */
+  { 2631,  L3GD20_CTRL_REG_1_DR_1_BM },        /* 380 Hz */
+  { 1315,  L3GD20_CTRL_REG_1_DR_MASK },        /* 760 Hz */
+};
+
 /* Single linked list to store instances of drivers */
 
 static struct l3gd20_dev_s *g_l3gd20_list = NULL;
@@ -127,7 +167,8 @@ static struct l3gd20_dev_s *g_l3gd20_list = NULL;
  * Private Functions
  ****************************************************************************/
 
-#ifdef CONFIG_DEBUG_SENSORS_INFO
+#if defined(CONFIG_DEBUG_SENSORS_INFO) || \
+    CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
 /****************************************************************************
  * Name: l3gd20_read_register
  ****************************************************************************/
@@ -213,6 +254,7 @@ static void l3gd20_reset(FAR struct l3gd20_dev_s *dev)
   up_mdelay(100);
 }
 
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE == 0
 /****************************************************************************
  * Name: l3gd20_read_measurement_data
  ****************************************************************************/
@@ -288,6 +330,8 @@ static void l3gd20_read_gyroscope_data(FAR struct l3gd20_dev_s *dev,
   SPI_LOCK(dev->spi, false);
 }
 
+#endif
+
 /****************************************************************************
  * Name: l3gd20_read_temperature
  ****************************************************************************/
@@ -324,6 +368,90 @@ static void l3gd20_read_temperature(FAR struct l3gd20_dev_s *dev,
   SPI_LOCK(dev->spi, false);
 }
 
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+/****************************************************************************
+ * Name: l3gd20_read_fifo
+ ****************************************************************************/
+
+static void l3gd20_read_fifo(FAR struct l3gd20_dev_s *dev,
+                             unsigned int count)
+{
+  uint8_t raw[L3GD20_FIFO_SIZE * L3GD20_FIFO_SAMPLE_SIZE];
+  FAR const uint8_t *sample;
+  uint8_t temperature = 0;
+  int16_t x_gyr = 0;
+  int16_t y_gyr = 0;
+  int16_t z_gyr = 0;
+  unsigned int i;
+
+  DEBUGASSERT(count <= L3GD20_FIFO_SIZE);
+
+  /* Read Temperature, once for the whole burst */
+
+  l3gd20_read_temperature(dev, &temperature);
+
+  /* Lock the SPI bus so that only one device can access it at the same
+   * time
+   */
+
+  SPI_LOCK(dev->spi, true);
+
+  /* Set CS to low which selects the L3GD20 */
+
+  SPI_SELECT(dev->spi, dev->config->spi_devid, true);
+
+  /* Read all the samples in a single burst:  In FIFO mode the address rolls
+   * back from OUT_Z_H to OUT_X_L, and each read of OUT_Z_H pops a sample.
+   */
+
+  SPI_SEND(dev->spi, (L3GD20_OUT_X_L_REG | 0x80 | 0x40));
+  SPI_RECVBLOCK(dev->spi, raw, count * L3GD20_FIFO_SAMPLE_SIZE);
+
+  /* Set CS to high which deselects the L3GD20 */
+
+  SPI_SELECT(dev->spi, dev->config->spi_devid, false);
+
+  /* Unlock the SPI bus */
+
+  SPI_LOCK(dev->spi, false);
+
+  for (i = 0; i < count; i++)
+    {
+      sample = &raw[i * L3GD20_FIFO_SAMPLE_SIZE];
+      x_gyr  = (int16_t)(sample[0] | (sample[1] << 8));
+      y_gyr  = (int16_t)(sample[2] | (sample[3] << 8));
+      z_gyr  = (int16_t)(sample[4] | (sample[5] << 8));
+
+      dev->fifo[i].x = (x_gyr / 180.0f) * (float)M_PI;
+      dev->fifo[i].y = (y_gyr / 180.0f) * (float)M_PI;
+      dev->fifo[i].z = (z_gyr / 180.0f) * (float)M_PI;
+      dev->fifo[i].temperature = temperature;
+    }
+
+  /* Feed sensor data to entropy pool */
+
+  add_sensor_randomness(((uint16_t)x_gyr << 16) ^
+                        ((uint16_t)y_gyr << 8) ^ (uint16_t)z_gyr);
+}
+
+/****************************************************************************
+ * Name: l3gd20_config_fifo
+ ****************************************************************************/
+
+static void l3gd20_config_fifo(FAR struct l3gd20_dev_s *dev)
+{
+  /* Stream mode, the watermark interrupt is raised when the FIFO holds
+   * more than WTM samples.
+   */
+
+  l3gd20_write_register(dev,
+                        L3GD20_FIFO_CTRL_REG,
+                        L3GD20_FIFO_CTRL_FMODE_CONT |
+                        ((dev->batch.watermark - 1) &
+                         L3GD20_FIFO_CTRL_WTM_MASK));
+}
+#endif
+
 /****************************************************************************
  * Name: l3gd20_interrupt_handler
  ****************************************************************************/
@@ -382,19 +510,56 @@ static int l3gd20_interrupt_handler(int irq, FAR void *context,
 
 static void l3gd20_worker(FAR void *arg)
 {
-  struct sensor_gyro temp;
-
   FAR struct l3gd20_dev_s *priv = (FAR struct l3gd20_dev_s *)(arg);
+  unsigned long period;
+  unsigned int count;
+  unsigned int i;
+  uint64_t last;
+  uint8_t src;
+
   DEBUGASSERT(priv != NULL);
 
-  /* Read out the latest sensor data */
+  /* Get the number of samples in the FIFO */
+
+  l3gd20_read_register(priv, L3GD20_FIFO_SRC_REG, &src);
+  if ((src & L3GD20_FIFO_SRC_OVRUN_BM) != 0)
+    {
+      count = L3GD20_FIFO_SIZE;
+    }
+  else
+    {
+      count = src & L3GD20_FIFO_SRC_FSS_MASK;
+    }
 
-  l3gd20_read_measurement_data(priv, &temp);
+  if (count == 0)
+    {
+      return;
+    }
+
+  /* Drain the FIFO */
+
+  l3gd20_read_fifo(priv, count);
+
+  /* The interrupt was raised by the sample that reached the watermark,
+   * the samples after it were taken while the work was pending.
+   */
+
+  last = priv->timestamp;
+  if (count > priv->batch.watermark)
+    {
+      last += (count - priv->batch.watermark) * priv->batch.interval;
+    }
+
+  period = sensor_batch_period(&priv->batch, last, count);
+  for (i = 0; i < count; i++)
+    {
+      priv->fifo[i].timestamp = last - (count - 1 - i) * period;
+    }
 
   /* push data to upper half driver */
 
-  priv->lower.push_event(priv->lower.priv, &temp,
-                         sizeof(struct sensor_gyro));
+  priv->lower.push_event(priv->lower.priv, priv->fifo,
+                         count * sizeof(struct sensor_gyro));
 }
 
 #else
@@ -434,7 +599,9 @@ static int l3gd20_activate(FAR struct sensor_lowerhalf_s *lower,
   FAR struct l3gd20_dev_s *priv = container_of(lower,
                                                FAR struct l3gd20_dev_s,
                                                lower);
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE == 0
   struct sensor_gyro temp;
+#endif
 
 #ifdef CONFIG_DEBUG_SENSORS_INFO
   uint8_t reg_content;
@@ -449,11 +616,26 @@ static int l3gd20_activate(FAR struct sensor_lowerhalf_s *lower,
 
       l3gd20_reset(priv);
 
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+      /* Enable the FIFO and the watermark signal on INT 2 */
+
+      l3gd20_write_register(priv,
+                            L3GD20_CTRL_REG_3,
+                            L3GD20_CTRL_REG_3_I2_WTM_BM);
+
+      l3gd20_write_register(priv,
+                            L3GD20_CTRL_REG_5,
+                            L3GD20_CTRL_REG_5_FIFO_EN_BM);
+
+      priv->batch.timestamp = 0;
+      l3gd20_config_fifo(priv);
+#else
       /* Enable DRDY signal on INT 2 */
 
       l3gd20_write_register(priv,
                             L3GD20_CTRL_REG_3,
                             L3GD20_CTRL_REG_3_I2_DRDY_BM);
+#endif
 
       /* Enable the maximum full scale mode.
        * Enable block data update for gyro sensor data.
@@ -466,20 +648,20 @@ static int l3gd20_activate(FAR struct sensor_lowerhalf_s *lower,
                             L3GD20_CTRL_REG_4_FS_1_BM |
                             L3GD20_CTRL_REG_4_FS_0_BM);
 
-      /* Enable X,Y,Z axis
-       * DR=00 -> Output data rate = 95 Hz, Cut-off = 12.5
-       */
+      /* Enable X,Y,Z axis at the output data rate of set_interval() */
 
       l3gd20_write_register(priv,
                             L3GD20_CTRL_REG_1,
                             L3GD20_CTRL_REG_1_POWERDOWN_BM |
                             L3GD20_CTRL_REG_1_X_EN_BM |
                             L3GD20_CTRL_REG_1_Y_EN_BM |
-                            L3GD20_CTRL_REG_1_Z_EN_BM);
+                            L3GD20_CTRL_REG_1_Z_EN_BM | priv->dr);
 
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE == 0
       /* Read measurement data to ensure DRDY is low */
 
       l3gd20_read_measurement_data(priv, &temp);
+#endif
 
       /* Read back the content of all control registers for debug purposes */
 
@@ -508,9 +690,87 @@ static int l3gd20_activate(FAR struct sensor_lowerhalf_s *lower,
       l3gd20_reset(priv);
     }
 
+  priv->activated = enable;
   return 0;
 }
 
+/****************************************************************************
+ * Name: l3gd20_set_interval
+ ****************************************************************************/
+
+static int l3gd20_set_interval(FAR struct sensor_lowerhalf_s *lower,
+                               FAR struct file *filep,
+                               FAR unsigned long *period_us)
+{
+  FAR struct l3gd20_dev_s *priv = container_of(lower,
+                                               FAR struct l3gd20_dev_s,
+                                               lower);
+  unsigned int i;
+
+  DEBUGASSERT(priv != NULL);
+
+  /* Take the slowest data rate that is fast enough */
+
+  for (i = 0; i < L3GD20_NODR - 1; i++)
+    {
+      if (g_l3gd20_odr[i].interval <= *period_us)
+        {
+          break;
+        }
+    }
+
+  priv->dr   = g_l3gd20_odr[i].dr;
+  *period_us = g_l3gd20_odr[i].interval;
+
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+  sensor_batch_interval(&priv->batch, *period_us);
+#endif
+
+  if (priv->activated)
+    {
+      l3gd20_write_register(priv,
+                            L3GD20_CTRL_REG_1,
+                            L3GD20_CTRL_REG_1_POWERDOWN_BM |
+                            L3GD20_CTRL_REG_1_X_EN_BM |
+                            L3GD20_CTRL_REG_1_Y_EN_BM |
+                            L3GD20_CTRL_REG_1_Z_EN_BM | priv->dr);
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+      l3gd20_config_fifo(priv);
+#endif
+    }
+
+  return 0;
+}
+
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
+/****************************************************************************
+ * Name: l3gd20_batch
+ ****************************************************************************/
+
+static int l3gd20_batch(FAR struct sensor_lowerhalf_s *lower,
+                        FAR struct file *filep,
+                        FAR unsigned long *latency_us)
+{
+  FAR struct l3gd20_dev_s *priv = container_of(lower,
+                                               FAR struct l3gd20_dev_s,
+                                               lower);
+
+  DEBUGASSERT(priv != NULL);
+
+  /* The samples already in the FIFO are kept when the watermark changes,
+   * they are drained by the next interrupt.
+   */
+
+  sensor_batch_latency(&priv->batch, latency_us);
+  if (priv->activated)
+    {
+      l3gd20_config_fifo(priv);
+    }
+
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -557,11 +817,22 @@ int l3gd20_register(int devno, FAR struct spi_dev_s *spi,
   priv->config           = config;
 #if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0
   priv->work.worker      = NULL;
+  sensor_batch_init(&priv->batch, L3GD20_FIFO_SIZE,
+                    g_l3gd20_odr[0].interval);
 #endif
   priv->timestamp        = 0;
+  priv->dr               = g_l3gd20_odr[0].dr;
+  priv->activated        = false;
 
   priv->lower.type = SENSOR_TYPE_GYROSCOPE;
+#if CONFIG_SENSORS_L3GD20_BUFFER_SIZE > 0 && \
+    CONFIG_SENSORS_L3GD20_BUFFER_SIZE < L3GD20_FIFO_SIZE
+  /* A burst drained from the FIFO must fit in the buffer */
+
+  priv->lower.nbuffer = L3GD20_FIFO_SIZE;
+#else
   priv->lower.nbuffer = CONFIG_SENSORS_L3GD20_BUFFER_SIZE;
+#endif
   priv->lower.ops = &g_l2gd20_ops;
   priv->lower.uncalibrated = true;
 
@@ -330,6 +330,37 @@ update:
   return ret;
 }
 
+static int sensor_init_buffer(FAR struct sensor_upperhalf_s *upper)
+{
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  if (circbuf_is_init(&upper->buffer))
+    {
+      return 0;
+    }
+
+  /* Initialize sensor buffer when data is first generated or the buffer
+   * is first mapped.
+   */
+
+  ret = circbuf_init(&upper->buffer, NULL, lower->nbuffer *
+                     upper->state.esize);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = circbuf_init(&upper->timing, NULL, lower->nbuffer *
+                     TIMING_BUF_ESIZE);
+  if (ret < 0)
+    {
+      circbuf_uninit(&upper->buffer);
+    }
+
+  return ret;
+}
+
 static void sensor_generate_timing(FAR struct sensor_upperhalf_s *upper,
                                    unsigned long nums)
 {
@@ -395,6 +426,57 @@ static void sensor_catch_up(FAR struct sensor_upperhalf_s *upper,
     }
 }
 
+#ifdef CONFIG_SENSORS_MMAP
+static void sensor_get_ring(FAR struct sensor_upperhalf_s *upper,
+                            FAR struct sensor_user_s *user,
+                            FAR struct sensor_ring_s *ring)
+{
+  if (!circbuf_is_empty(&upper->timing))
+    {
+      sensor_catch_up(upper, user);
+    }
+
+  ring->esize      = upper->state.esize;
+  ring->nbuffer    = upper->lower->nbuffer;
+  ring->head       = upper->timing.head / TIMING_BUF_ESIZE;
+  ring->tail       = upper->timing.tail / TIMING_BUF_ESIZE;
+  ring->pos        = user->bufferpos;
+  ring->generation = user->state.generation;
+}
+
+static int sensor_advance(FAR struct sensor_upperhalf_s *upper,
+                          FAR struct sensor_user_s *user,
+                          unsigned long nums)
+{
+  size_t head = upper->timing.head / TIMING_BUF_ESIZE;
+
+  if (circbuf_is_empty(&upper->timing))
+    {
+      return nums ? -ENODATA : 0;
+    }
+
+  /* The samples that were overwritten while the user held them are
+   * consumed too, the position only moves forward up to the head.
+   */
+
+  sensor_catch_up(upper, user);
+  if (nums > head - user->bufferpos)
+    {
+      return -EINVAL;
+    }
+
+  if (nums > 0)
+    {
+      user->bufferpos += nums;
+      circbuf_peekat(&upper->timing,
+                     (user->bufferpos - 1) * TIMING_BUF_ESIZE,
+                     &user->state.generation, TIMING_BUF_ESIZE);
+    }
+
+  return 0;
+}
+#endif
+
 static ssize_t sensor_do_samples(FAR struct sensor_upperhalf_s *upper,
                                  FAR struct sensor_user_s *user,
                                  FAR char *buffer, size_t len)
@@ -850,6 +932,51 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_SENSORS_MMAP
+      case FIOC_MMAP:
+        {
+          FAR void **ppv = (FAR void **)(uintptr_t)arg;
+
+          /* Map the circular buffer of data, the samples fetched from the
+           * lower half are not kept in it.
+           */
+
+          if (lower->ops->fetch)
+            {
+              ret = -ENOTSUP;
+              break;
+            }
+
+          DEBUGASSERT(ppv != NULL);
+          nxrmutex_lock(&upper->lock);
+          ret = sensor_init_buffer(upper);
+          if (ret >= 0)
+            {
+              *ppv = upper->buffer.base;
+            }
+
+          nxrmutex_unlock(&upper->lock);
+        }
+        break;
+
+      case SNIOC_GET_RING:
+        {
+          nxrmutex_lock(&upper->lock);
+          sensor_get_ring(upper, user,
+                          (FAR struct sensor_ring_s *)(uintptr_t)arg);
+          nxrmutex_unlock(&upper->lock);
+        }
+        break;
+
+      case SNIOC_ADVANCE:
+        {
+          nxrmutex_lock(&upper->lock);
+          ret = sensor_advance(upper, user, arg);
+          nxrmutex_unlock(&upper->lock);
+        }
+        break;
+#endif
+
       default:
 
         /* Lowerhalf driver process other cmd. */
@@ -940,7 +1067,6 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
                                  size_t bytes)
 {
   FAR struct sensor_upperhalf_s *upper = priv;
-  FAR struct sensor_lowerhalf_s *lower = upper->lower;
   FAR struct sensor_user_s *user;
   unsigned long envcount;
   int semcount;
@@ -953,26 +1079,11 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
     }
 
   nxrmutex_lock(&upper->lock);
-  if (!circbuf_is_init(&upper->buffer))
+  ret = sensor_init_buffer(upper);
+  if (ret < 0)
     {
-      /* Initialize sensor buffer when data is first generated */
-
-      ret = circbuf_init(&upper->buffer, NULL, lower->nbuffer *
-                         upper->state.esize);
-      if (ret < 0)
-        {
-          nxrmutex_unlock(&upper->lock);
-          return ret;
-        }
-
-      ret = circbuf_init(&upper->timing, NULL, lower->nbuffer *
-                         TIMING_BUF_ESIZE);
-      if (ret < 0)
-        {
-          circbuf_uninit(&upper->buffer);
-          nxrmutex_unlock(&upper->lock);
-          return ret;
-        }
+      nxrmutex_unlock(&upper->lock);
+      return ret;
     }
 
   circbuf_overwrite(&upper->buffer, data, bytes);
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * drivers/sensors/sensor_batch.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/sensors/sensor.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void sensor_batch_update(FAR struct sensor_batch_s *batch)
+{
+  unsigned long watermark = 1;
+
+  if (batch->latency > 0 && batch->interval > 0)
+    {
+      watermark = batch->latency / batch->interval;
+      if (watermark > batch->fifosize)
+        {
+          watermark = batch->fifosize;
+        }
+      else if (watermark < 1)
+        {
+          watermark = 1;
+        }
+    }
+
+  /* The FIFO is flushed by the lower half when it is reprogrammed, the
+   * next burst can't be related to the previous one.
+   */
+
+  batch->watermark = watermark;
+  batch->timestamp = 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void sensor_batch_init(FAR struct sensor_batch_s *batch,
+                       unsigned long fifosize, unsigned long interval)
+{
+  DEBUGASSERT(batch != NULL && fifosize > 0);
+
+  batch->fifosize = fifosize;
+  batch->interval = interval;
+  batch->latency  = 0;
+  sensor_batch_update(batch);
+}
+
+unsigned long sensor_batch_interval(FAR struct sensor_batch_s *batch,
+                                    unsigned long interval)
+{
+  batch->interval = interval;
+  sensor_batch_update(batch);
+  return batch->watermark;
+}
+
+unsigned long sensor_batch_latency(FAR struct sensor_batch_s *batch,
+                                   FAR unsigned long *latency_us)
+{
+  batch->latency = *latency_us;
+  sensor_batch_update(batch);
+
+  if (batch->latency > 0)
+    {
+      *latency_us = batch->watermark * batch->interval;
+    }
+
+  return batch->watermark;
+}
+
+unsigned long sensor_batch_period(FAR struct sensor_batch_s *batch,
+                                  uint64_t now, unsigned long count)
+{
+  unsigned long period = batch->interval;
+
+  /* The interval measured between the last samples of two bursts follows
+   * the drift of the sensor clock.  It is only trusted within a quarter of
+   * the nominal interval:  A lost interrupt or a FIFO overrun would skew
+   * it otherwise.
+   */
+
+  if (batch->timestamp != 0 && count > 0 && now > batch->timestamp)
+    {
+      unsigned long measured = (now - batch->timestamp) / count;
+
+      if (measured > period - period / 4 && measured < period + period / 4)
+        {
+          period = measured;
+        }
+    }
+
+  batch->timestamp = now;
+  return period;
+}
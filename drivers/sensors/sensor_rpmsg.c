@@ -728,6 +728,7 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
   FAR struct sensor_rpmsg_ept_s *sre;
   FAR struct sensor_rpmsg_data_s *msg;
   struct sensor_ustate_s state;
+  unsigned long timeout;
   uint64_t now;
   bool updated;
   int ret;
@@ -745,6 +746,19 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
       state.interval = 0;
     }
 
+  /* The events are coalesced in the buffer as long as the subscriber
+   * allows: Its batch latency, or half of its interval without batching.
+   */
+
+  if (state.latency > 0 && state.latency != ULONG_MAX)
+    {
+      timeout = state.latency;
+    }
+  else
+    {
+      timeout = state.interval / 2;
+    }
+
   sre = container_of(stub->ept, struct sensor_rpmsg_ept_s, ept);
   nxmutex_lock(&sre->lock);
 
@@ -803,12 +817,19 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
       sre->written += (sizeof(*cell) + ret + 0x7) & ~0x7;
     }
 
+  if (!sre->buffer)
+    {
+      nxmutex_unlock(&sre->lock);
+      return;
+    }
+
   /* If buffer timeout is expired, do rpmsg_send_nocopy, otherwise using
-   * delay work to send data.
+   * delay work to send data.  The buffer is shared by the subscribers of
+   * the endpoint, so it is sent by the earliest timeout of them.
    */
 
   now = sensor_get_timestamp();
-  if (sre->expire <= now && sre->buffer)
+  if (sre->expire <= now)
     {
       ret = rpmsg_send_nocopy(&sre->ept, sre->buffer, sre->written);
       sre->buffer = NULL;
@@ -820,10 +841,9 @@ static void sensor_rpmsg_push_event_one(FAR struct sensor_rpmsg_dev_s *dev,
     }
   else
     {
-      if (sre->expire == UINT64_MAX ||
-          sre->expire - now > state.interval / 2)
+      if (sre->expire == UINT64_MAX || sre->expire - now > timeout)
         {
-          sre->expire = now + state.interval / 2;
+          sre->expire = now + timeout;
         }
 
       work_queue(HPWORK, &sre->work, sensor_rpmsg_data_worker, sre,
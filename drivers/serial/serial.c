@@ -87,6 +87,9 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch,
                                 bool oktoblock);
+static int     uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, FAR size_t *nput,
+                               bool oktoblock);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev,
                                     FAR const char *buffer,
                                     size_t buflen);
@@ -192,7 +195,7 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
               nxsem_get_value(fds->sem, &semcount);
               if (semcount < 1)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
         }
@@ -339,6 +342,75 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/****************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy a buffer to the TX buffer, by contiguous regions.  When the TX
+ *   buffer is full, uart_putxmitchar() waits for space with the next byte.
+ *   The number of bytes copied is returned in 'nput', also on failure.
+ *
+ ****************************************************************************/
+
+static int uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                           size_t buflen, FAR size_t *nput, bool oktoblock)
+{
+  size_t nbytes;
+  int head;
+  int tail;
+  int ret;
+
+  *nput = 0;
+  while (*nput < buflen)
+    {
+      head = dev->xmit.head;
+      tail = dev->xmit.tail;
+
+      /* Leave one byte free between the head and the tail */
+
+      if (tail > head)
+        {
+          nbytes = tail - head - 1;
+        }
+      else
+        {
+          nbytes = dev->xmit.size - head - (tail == 0 ? 1 : 0);
+        }
+
+      if (nbytes == 0)
+        {
+          /* The TX buffer is full */
+
+          ret = uart_putxmitchar(dev, buffer[*nput], oktoblock);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          (*nput)++;
+          continue;
+        }
+
+      if (nbytes > buflen - *nput)
+        {
+          nbytes = buflen - *nput;
+        }
+
+      memcpy(&dev->xmit.buffer[head], &buffer[*nput], nbytes);
+
+      head += nbytes;
+      if (head >= dev->xmit.size)
+        {
+          head = 0;
+        }
+
+      dev->xmit.head = head;
+      *nput += nbytes;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: uart_putc
  ****************************************************************************/
@@ -1099,6 +1171,9 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten = buflen;
   bool              oktoblock;
+  bool              postproc;
+  size_t            nput;
+  size_t            nplain;
   int               ret;
   char              ch;
 
@@ -1162,59 +1237,97 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
 
   oktoblock = ((filep->f_oflags & O_NONBLOCK) == 0);
 
+  /* Does any character need output post-processing? */
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  postproc = (dev->tc_oflag & OPOST) != 0 &&
+             (dev->tc_oflag & (OCRNL | ONLCR | ONLRET)) != 0;
+#else
+  postproc = dev->isconsole;
+#endif
+
   /* Loop while we still have data to copy to the transmit buffer.
    * we add data to the head of the buffer; uart_xmitchars takes the
    * data from the end of the buffer.
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
-      ch  = *buffer++;
-      ret = OK;
-
-#ifdef CONFIG_SERIAL_TERMIOS
-      /* Do output post-processing */
+      /* Copy the characters up to the next one to post-process at once */
 
-      if ((dev->tc_oflag & OPOST) != 0)
+      nplain = buflen;
+      if (postproc)
         {
-          /* Mapping CR to NL? */
-
-          if ((ch == '\r') && (dev->tc_oflag & OCRNL) != 0)
+          for (nplain = 0; nplain < buflen; nplain++)
             {
-              ch = '\n';
+              if (buffer[nplain] == '\n' || buffer[nplain] == '\r')
+                {
+                  break;
+                }
             }
+        }
 
-          /* Are we interested in newline processing? */
+      if (nplain > 0)
+        {
+          ret     = uart_putxmitbuf(dev, buffer, nplain, &nput, oktoblock);
+          buffer += nput;
+          buflen -= nput;
+        }
+      else
+        {
+          ch  = *buffer;
+          ret = OK;
 
-          if ((ch == '\n') && (dev->tc_oflag & (ONLCR | ONLRET)) != 0)
+#ifdef CONFIG_SERIAL_TERMIOS
+          /* Do output post-processing */
+
+          if ((dev->tc_oflag & OPOST) != 0)
             {
-              ret = uart_putxmitchar(dev, '\r', oktoblock);
-            }
+              /* Mapping CR to NL? */
 
-          /* Specifically not handled:
-           *
-           * OXTABS - primarily a full-screen terminal optimization
-           * ONOEOT - Unix interoperability hack
-           * OLCUC  - Not specified by POSIX
-           * ONOCR  - low-speed interactive optimization
-           */
-        }
+              if ((ch == '\r') && (dev->tc_oflag & OCRNL) != 0)
+                {
+                  ch = '\n';
+                }
+
+              /* Are we interested in newline processing? */
+
+              if ((ch == '\n') && (dev->tc_oflag & (ONLCR | ONLRET)) != 0)
+                {
+                  ret = uart_putxmitchar(dev, '\r', oktoblock);
+                }
+
+              /* Specifically not handled:
+               *
+               * OXTABS - primarily a full-screen terminal optimization
+               * ONOEOT - Unix interoperability hack
+               * OLCUC  - Not specified by POSIX
+               * ONOCR  - low-speed interactive optimization
+               */
+            }
 
 #else /* !CONFIG_SERIAL_TERMIOS */
-      /* If this is the console, convert \n -> \r\n */
+          /* If this is the console, convert \n -> \r\n */
 
-      if (dev->isconsole && ch == '\n')
-        {
-          ret = uart_putxmitchar(dev, '\r', oktoblock);
-        }
+          if (dev->isconsole && ch == '\n')
+            {
+              ret = uart_putxmitchar(dev, '\r', oktoblock);
+            }
 #endif
 
-      /* Put the character into the transmit buffer */
+          /* Put the character into the transmit buffer */
 
-      if (ret >= 0)
-        {
-          ret = uart_putxmitchar(dev, ch, oktoblock);
+          if (ret >= 0)
+            {
+              ret = uart_putxmitchar(dev, ch, oktoblock);
+            }
+
+          if (ret >= 0)
+            {
+              buffer++;
+              buflen--;
+            }
         }
 
       /* uart_putxmitchar() might return an error under one of two
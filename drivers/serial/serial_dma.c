@@ -354,4 +354,155 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_circular
+ *
+ * Description:
+ *   Set up to receive bytes into the whole RX circular buffer using a DMA
+ *   in circular mode.  The lower half starts the DMA over xfer->buffer and
+ *   xfer->length in its dmareceive() method and never stops it:  Nothing
+ *   is lost between two events, and the idle-line event delivers the end
+ *   of a burst without waiting for the buffer to fill.  A typical lower
+ *   half calls this from its first dmarxfree() method, and
+ *   uart_recvchars_update() from the next ones.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_circular(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+
+  DEBUGASSERT(dev->ops->dmarxpos != NULL);
+
+  rxbuf->head   = 0;
+  rxbuf->tail   = 0;
+
+  xfer->buffer  = rxbuf->buffer;
+  xfer->length  = rxbuf->size;
+  xfer->nbuffer = NULL;
+  xfer->nlength = 0;
+  xfer->nbytes  = 0;
+
+  uart_dmareceive(dev);
+}
+#endif
+
+/****************************************************************************
+ * Name: uart_recvchars_update
+ *
+ * Description:
+ *   Move the head of the RX circular buffer to the position of the circular
+ *   DMA started by uart_recvchars_circular(), and wake up of any threads
+ *   that may have been waiting for new data to become available.  This is
+ *   called by the lower half on the half-transfer, transfer-complete and
+ *   idle-line events of the DMA.
+ *
+ *   The DMA does not wait for the reader:  If it overwrote bytes that were
+ *   not read yet, the oldest bytes are dropped so that the buffer holds
+ *   the latest ones.  RX flow control is the way to avoid it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_update(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  unsigned int nbuffered;
+  unsigned int nbytes;
+  unsigned int head;
+  unsigned int pos;
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  int signo;
+#endif
+
+  head = rxbuf->head;
+  pos  = uart_dmarxpos(dev) % rxbuf->size;
+  if (pos == head)
+    {
+      return;
+    }
+
+  nbytes = (pos + rxbuf->size - head) % rxbuf->size;
+  nbuffered = (head + rxbuf->size - rxbuf->tail) % rxbuf->size;
+
+  /* Describe the new bytes, in one or two contiguous regions */
+
+  xfer->buffer  = &rxbuf->buffer[head];
+  xfer->nbuffer = rxbuf->buffer;
+  xfer->nbytes  = nbytes;
+
+  if (pos > head)
+    {
+      xfer->length  = nbytes;
+      xfer->nlength = 0;
+    }
+  else
+    {
+      xfer->length  = rxbuf->size - head;
+      xfer->nlength = pos;
+    }
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  signo = uart_recvchars_check_special(dev);
+#endif
+
+  rxbuf->head = pos;
+
+  if (nbuffered + nbytes >= rxbuf->size)
+    {
+      /* The DMA overran the reader:  Keep the latest bytes */
+
+      rxbuf->tail = (pos + 1) % rxbuf->size;
+      nbuffered   = rxbuf->size - 1;
+    }
+  else
+    {
+      nbuffered += nbytes;
+    }
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+#ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+  /* Is the level now above the watermark level that we need to report? */
+
+  if (nbuffered >= (CONFIG_SERIAL_IFLOWCONTROL_UPPER_WATERMARK *
+                    rxbuf->size) / 100)
+    {
+      /* Let the lower level driver know that the watermark level has been
+       * crossed.  It will probably activate RX flow control.  The DMA goes
+       * on, up to the remaining space.
+       */
+
+      uart_rxflowcontrol(dev, nbuffered, true);
+    }
+#else
+  if (nbuffered >= rxbuf->size - 1)
+    {
+      uart_rxflowcontrol(dev, nbuffered, true);
+    }
+#endif
+#endif
+
+  xfer->nbytes = 0;
+  xfer->length = xfer->nlength = 0;
+
+  uart_datareceived(dev);
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGTSTP) || \
+    defined(CONFIG_TTY_FORCE_PANIC) || defined(CONFIG_TTY_LAUNCH)
+  /* Send the signal if necessary */
+
+  if (signo != 0)
+    {
+      nxsig_kill(dev->pid, signo);
+      uart_reset_sem(dev);
+    }
+#endif
+}
+#endif
+
 #endif /* CONFIG_SERIAL_TXDMA || CONFIG_SERIAL_RXDMA */
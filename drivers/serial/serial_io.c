@@ -60,20 +60,65 @@ void uart_xmitchars(FAR uart_dev_t *dev)
   irqstate_t flags = enter_critical_section();
 #endif
 
-  /* Send while we still have data in the TX buffer & room in the fifo */
-
-  while (dev->xmit.head != dev->xmit.tail && uart_txready(dev))
+  if (dev->ops->sendbuf != NULL)
     {
-      /* Send the next byte */
+      /* Fill the fifo with the contiguous regions of the TX buffer */
+
+      while (dev->xmit.head != dev->xmit.tail)
+        {
+          size_t len;
+          size_t sent;
+
+          if (dev->xmit.head > dev->xmit.tail)
+            {
+              len = dev->xmit.head - dev->xmit.tail;
+            }
+          else
+            {
+              len = dev->xmit.size - dev->xmit.tail;
+            }
+
+          sent    = uart_sendbuf(dev, &dev->xmit.buffer[dev->xmit.tail],
+                                 len);
+          nbytes += sent;
+
+          if (dev->xmit.tail + sent >= dev->xmit.size)
+            {
+              dev->xmit.tail = 0;
+            }
+          else
+            {
+              dev->xmit.tail += sent;
+            }
 
-      uart_send(dev, dev->xmit.buffer[dev->xmit.tail]);
-      nbytes++;
+          if (sent < len)
+            {
+              /* The fifo is full */
 
-      /* Increment the tail index */
+              break;
+            }
+        }
+    }
+
+  else
+    {
+      /* Send while we still have data in the TX buffer & room in the
+       * fifo
+       */
 
-      if (++(dev->xmit.tail) >= dev->xmit.size)
+      while (dev->xmit.head != dev->xmit.tail && uart_txready(dev))
         {
-          dev->xmit.tail = 0;
+          /* Send the next byte */
+
+          uart_send(dev, dev->xmit.buffer[dev->xmit.tail]);
+          nbytes++;
+
+          /* Increment the tail index */
+
+          if (++(dev->xmit.tail) >= dev->xmit.size)
+            {
+              dev->xmit.tail = 0;
+            }
         }
     }
 
@@ -0,0 +1,362 @@
+/****************************************************************************
+ * drivers/spi/spi_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spi/spi.h>
+#include <nuttx/spi/spi_transfer.h>
+
+#ifdef CONFIG_SPI_QUEUE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct spi_queue_s
+{
+  FAR struct spi_dev_s *spi;         /* The lower half of the bus */
+  FAR struct spi_request_s *head;    /* The requests, by priority */
+  sem_t wake;                        /* Posted when a request is queued */
+  sem_t exit;                        /* Posted when the thread exits */
+  bool stop;                         /* Stop the thread */
+};
+
+/* The request of spi_queue_transfer() */
+
+struct spi_queue_wait_s
+{
+  struct spi_request_s req;
+  sem_t done;                        /* Posted when the request completes */
+  int result;                        /* The result of spi_transfer() */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_remove
+ *
+ * Description:
+ *   Remove the request with the highest priority from the queue.  Called
+ *   in a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct spi_request_s *
+spi_queue_remove(FAR struct spi_queue_s *queue)
+{
+  FAR struct spi_request_s *req = queue->head;
+
+  if (req != NULL)
+    {
+      queue->head = req->flink;
+      req->flink  = NULL;
+    }
+
+  return req;
+}
+
+/****************************************************************************
+ * Name: spi_queue_thread
+ *
+ * Description:
+ *   Run the requests of the queue one at a time.
+ *
+ ****************************************************************************/
+
+static int spi_queue_thread(int argc, FAR char *argv[])
+{
+  FAR struct spi_queue_s *queue;
+  FAR struct spi_request_s *req;
+  irqstate_t flags;
+  int ret;
+
+  queue = (FAR struct spi_queue_s *)
+    ((uintptr_t)strtoul(argv[1], NULL, 16));
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&queue->wake);
+
+      flags = enter_critical_section();
+      req   = spi_queue_remove(queue);
+      leave_critical_section(flags);
+
+      if (req != NULL)
+        {
+          ret = queue->stop ? -ECANCELED : spi_transfer(queue->spi,
+                                                        req->seq);
+          req->done(req, ret);
+        }
+      else if (queue->stop)
+        {
+          break;
+        }
+    }
+
+  nxsem_post(&queue->exit);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_wakeup
+ *
+ * Description:
+ *   The completion of the requests of spi_queue_transfer().
+ *
+ ****************************************************************************/
+
+static void spi_queue_wakeup(FAR struct spi_request_s *req, int result)
+{
+  FAR struct spi_queue_wait_s *wait = (FAR struct spi_queue_wait_s *)req;
+
+  wait->result = result;
+  nxsem_post(&wait->done);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Create the queue of an SPI bus and start its thread.  All the devices
+ *   on the bus that use the queue share it.
+ *
+ * Input Parameters:
+ *   spi - An instance of the lower half SPI driver
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct spi_queue_s *spi_queue_initialize(FAR struct spi_dev_s *spi)
+{
+  FAR struct spi_queue_s *queue;
+  FAR char *argv[2];
+  char arg1[32];
+  int ret;
+
+  DEBUGASSERT(spi != NULL);
+
+  queue = kmm_zalloc(sizeof(struct spi_queue_s));
+  if (queue == NULL)
+    {
+      return NULL;
+    }
+
+  queue->spi = spi;
+  nxsem_init(&queue->wake, 0, 0);
+  nxsem_init(&queue->exit, 0, 0);
+  nxsem_set_protocol(&queue->wake, SEM_PRIO_NONE);
+  nxsem_set_protocol(&queue->exit, SEM_PRIO_NONE);
+
+  snprintf(arg1, sizeof(arg1), "%p", queue);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  ret = kthread_create("spi_queue", CONFIG_SPI_QUEUE_PRIORITY,
+                       CONFIG_SPI_QUEUE_STACKSIZE, spi_queue_thread, argv);
+  if (ret < 0)
+    {
+      spierr("ERROR: Failed to start the thread: %d\n", ret);
+      nxsem_destroy(&queue->wake);
+      nxsem_destroy(&queue->exit);
+      kmm_free(queue);
+      return NULL;
+    }
+
+  return queue;
+}
+
+/****************************************************************************
+ * Name: spi_queue_uninitialize
+ *
+ * Description:
+ *   Stop the thread of the queue and free it.  The requests still queued
+ *   are completed with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void spi_queue_uninitialize(FAR struct spi_queue_s *queue)
+{
+  DEBUGASSERT(queue != NULL);
+
+  queue->stop = true;
+  nxsem_post(&queue->wake);
+  nxsem_wait_uninterruptible(&queue->exit);
+
+  nxsem_destroy(&queue->wake);
+  nxsem_destroy(&queue->exit);
+  kmm_free(queue);
+}
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Queue a request by priority, after the requests of the same priority,
+ *   and return without waiting for it.  This may be called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   req   - The request, with its seq, priority and done set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_request_s *req)
+{
+  FAR struct spi_request_s **prev;
+  irqstate_t flags;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+  DEBUGASSERT(req->seq != NULL && req->done != NULL);
+
+  if (queue->stop)
+    {
+      return -ESHUTDOWN;
+    }
+
+  flags = enter_critical_section();
+
+  for (prev = &queue->head; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if ((*prev)->priority < req->priority)
+        {
+          break;
+        }
+    }
+
+  req->flink = *prev;
+  *prev      = req;
+
+  leave_critical_section(flags);
+
+  nxsem_post(&queue->wake);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a request that is not started yet from the queue.  Its done
+ *   callback is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -EBUSY if it is not in the queue
+ *   any longer.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_request_s *req)
+{
+  FAR struct spi_request_s **prev;
+  irqstate_t flags;
+  int ret = -EBUSY;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+
+  flags = enter_critical_section();
+
+  for (prev = &queue->head; *prev != NULL; prev = &(*prev)->flink)
+    {
+      if (*prev == req)
+        {
+          *prev      = req->flink;
+          req->flink = NULL;
+          ret        = OK;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  /* The thread takes one request per count of the semaphore, and finds the
+   * queue empty for the count of this one.
+   */
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ *
+ * Description:
+ *   Queue a sequence of transfers and wait for its completion.  This is
+ *   spi_transfer() for the devices that share the bus with the users of
+ *   the queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority)
+{
+  struct spi_queue_wait_s wait;
+  int ret;
+
+  wait.req.seq      = seq;
+  wait.req.priority = priority;
+  wait.req.done     = spi_queue_wakeup;
+  wait.req.arg      = NULL;
+
+  nxsem_init(&wait.done, 0, 0);
+  nxsem_set_protocol(&wait.done, SEM_PRIO_NONE);
+
+  ret = spi_queue_submit(queue, &wait.req);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&wait.done);
+      ret = wait.result;
+    }
+
+  nxsem_destroy(&wait.done);
+  return ret;
+}
+
+#endif /* CONFIG_SPI_QUEUE */
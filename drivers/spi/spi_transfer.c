@@ -30,11 +30,81 @@
 #include <debug.h>
 
 #include <nuttx/signal.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/spi/spi.h>
 #include <nuttx/spi/spi_transfer.h>
 
 #ifdef CONFIG_SPI_EXCHANGE
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_SEQUENCE
+/* The wait for a sequence run by the lower half */
+
+struct spi_seqwait_s
+{
+  sem_t done;                  /* Posted when the sequence completes */
+  int result;                  /* The result of the sequence */
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_SEQUENCE
+/****************************************************************************
+ * Name: spi_sequence_done
+ *
+ * Description:
+ *   Called by the lower half, possibly from its interrupt handler, when
+ *   the sequence completes.
+ *
+ ****************************************************************************/
+
+static void spi_sequence_done(FAR void *arg, int result)
+{
+  FAR struct spi_seqwait_s *wait = arg;
+
+  wait->result = result;
+  nxsem_post(&wait->done);
+}
+
+/****************************************************************************
+ * Name: spi_sequence
+ *
+ * Description:
+ *   Run the whole sequence in the lower half, and wait for its completion.
+ *
+ * Returned Value:
+ *   The result of the sequence, -ENOSYS or -ENOTSUP if the lower half
+ *   cannot run it.
+ *
+ ****************************************************************************/
+
+static int spi_sequence(FAR struct spi_dev_s *spi,
+                        FAR struct spi_sequence_s *seq)
+{
+  struct spi_seqwait_s wait;
+  int ret;
+
+  nxsem_init(&wait.done, 0, 0);
+  nxsem_set_protocol(&wait.done, SEM_PRIO_NONE);
+
+  ret = SPI_SEQUENCE(spi, seq, spi_sequence_done, &wait);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&wait.done);
+      ret = wait.result;
+    }
+
+  nxsem_destroy(&wait.done);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -85,6 +155,19 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
   SPI_SETMODE(spi, seq->mode);
   SPI_SETBITS(spi, seq->nbits);
 
+#ifdef CONFIG_SPI_SEQUENCE
+  /* Let the lower half run the whole sequence if it can */
+
+  ret = spi_sequence(spi, seq);
+  if (ret != -ENOSYS && ret != -ENOTSUP)
+    {
+      SPI_LOCK(spi, false);
+      return ret;
+    }
+
+  ret = OK;
+#endif
+
   /* Select the SPI device in preparation for the transfer.
    * REVISIT: This is redundant.
    */
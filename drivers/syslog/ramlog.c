@@ -89,6 +89,10 @@ static int     ramlog_readnotify(FAR struct ramlog_dev_s *priv);
 static void    ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                                  pollevent_t eventset);
 static int     ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+#ifndef CONFIG_RAMLOG_CRLF
+static size_t  ramlog_copybuf(FAR struct ramlog_dev_s *priv,
+                              FAR const char *buffer, size_t len);
+#endif
 
 /* Character driver methods */
 
@@ -361,6 +365,87 @@ again:
   return OK;
 }
 
+/****************************************************************************
+ * Name: ramlog_copybuf
+ *
+ * Description:
+ *   Copy a buffer to the circular buffer in at most two blocks, with the
+ *   interrupts disabled once.  Returns the number of bytes copied.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_RAMLOG_CRLF
+static size_t ramlog_copybuf(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len)
+{
+  irqstate_t flags;
+  size_t nwritten;
+  size_t space;
+  size_t chunk;
+  size_t head;
+
+#ifdef CONFIG_RAMLOG_SYSLOG
+  if (priv == &g_sysdev)
+    {
+      ramlog_initbuf();
+    }
+#endif
+
+  flags = enter_critical_section();
+
+  space = priv->rl_bufsize - 1 - ramlog_bufferused(priv);
+  if (len > space)
+    {
+#ifdef CONFIG_RAMLOG_OVERWRITE
+      /* Keep the latest data, overwriting the oldest one */
+
+      if (len > priv->rl_bufsize - 1)
+        {
+          buffer += len - (priv->rl_bufsize - 1);
+          len     = priv->rl_bufsize - 1;
+        }
+
+      priv->rl_tail = (priv->rl_tail + len - space) % priv->rl_bufsize;
+#else
+      /* Keep what fits, the remaining data is dropped */
+
+      len = space;
+#endif
+    }
+
+  head = priv->rl_head;
+  for (nwritten = 0; nwritten < len; nwritten += chunk)
+    {
+      chunk = priv->rl_bufsize - head;
+      if (chunk > len - nwritten)
+        {
+          chunk = len - nwritten;
+        }
+
+      memcpy(&priv->rl_buffer[head], &buffer[nwritten], chunk);
+      head += chunk;
+      if (head >= priv->rl_bufsize)
+        {
+          head = 0;
+        }
+    }
+
+  priv->rl_head = head;
+
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  /* The free byte before the tail marks the start of the data */
+
+  if (priv->rl_tail == (head + 1) % priv->rl_bufsize)
+    {
+      priv->rl_buffer[head] = '\0';
+    }
+#endif
+
+  leave_critical_section(flags);
+  return nwritten;
+}
+#endif
+
 /****************************************************************************
  * Name: ramlog_addbuf
  ****************************************************************************/
@@ -370,7 +455,9 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
 {
   int readers_waken;
   ssize_t nwritten;
+#ifdef CONFIG_RAMLOG_CRLF
   char ch;
+#endif
   int ret;
 
   ret = nxsem_wait(&priv->rl_exclsem);
@@ -379,6 +466,11 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
       return ret;
     }
 
+#ifndef CONFIG_RAMLOG_CRLF
+  /* Copy the buffer as a whole when it needs no CR/LF expansion */
+
+  nwritten = ramlog_copybuf(priv, buffer, len);
+#else
   for (nwritten = 0; (size_t)nwritten < len; nwritten++)
     {
       /* Get the next character to output */
@@ -397,6 +489,7 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
           break;
         }
     }
+#endif
 
   /* Was anything written? */
 
@@ -244,6 +244,58 @@ int syslog_add_intbuffer(int ch);
 int syslog_flush_intbuffer(bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_async_write
+ *
+ * Description:
+ *   Add a message to the staging buffer of the current CPU, to be written
+ *   to the SYSLOG channels by the low-priority work queue.
+ *
+ * Input Parameters:
+ *   buffer - The message
+ *   buflen - The length of the message
+ *
+ * Returned Value:
+ *   The length of the message if it was staged or dropped.  -EAGAIN if
+ *   the caller must write it to the channels itself.
+ *
+ * Assumptions:
+ *   May be called from any context.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+ssize_t syslog_async_write(FAR const char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_async
+ *
+ * Description:
+ *   Write the staged messages of all CPUs to the SYSLOG channels.
+ *
+ * Input Parameters:
+ *   force   - Use the force() method of the channel vs. the write() method.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+void syslog_flush_async(bool force);
+#endif
+
+/****************************************************************************
+ * Name: syslog_async_dropped
+ *
+ * Description:
+ *   Return the total number of messages dropped because a staging buffer
+ *   was full.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+uint32_t syslog_async_dropped(void);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
@@ -279,6 +331,27 @@ int syslog_putc(int ch);
 
 ssize_t syslog_write(FAR const char *buffer, size_t buflen);
 
+/****************************************************************************
+ * Name: syslog_binary
+ *
+ * Description:
+ *   Write a message to the SYSLOG channels as a binary record, leaving its
+ *   formatting to the host.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string, that must be in the image
+ *   ap       - The arguments
+ *
+ * Returned Value:
+ *   The size of the record written.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+int syslog_binary(int priority, FAR const IPTR char *fmt, FAR va_list *ap);
+#endif
+
 /****************************************************************************
  * Name: syslog_force
  *
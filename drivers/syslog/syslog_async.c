@@ -0,0 +1,331 @@
+/****************************************************************************
+ * drivers/syslog/syslog_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/init.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_ASYNC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define SYSLOG_ASYNC_NBUFFERS CONFIG_SMP_NCPUS
+#  define syslog_async_cpu()    up_cpu_index()
+#else
+#  define SYSLOG_ASYNC_NBUFFERS 1
+#  define syslog_async_cpu()    0
+#endif
+
+/* Barrier between the buffer contents and the indices */
+
+#ifdef CONFIG_SMP
+#  define syslog_async_barrier() SP_DMB()
+#else
+#  define syslog_async_barrier()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One staging buffer.  Only its CPU writes the head index and the drop
+ * count, with its local interrupts disabled; only the flush worker writes
+ * the tail index.  Neither takes a lock.  One byte stays free so that a
+ * full buffer is not taken for an empty one.
+ */
+
+struct syslog_async_s
+{
+  volatile size_t   sa_head;     /* Index of the next byte to write */
+  volatile size_t   sa_tail;     /* Index of the next byte to flush */
+  volatile uint32_t sa_dropped;  /* Number of messages dropped */
+  uint32_t          sa_reported; /* Number of drops already reported */
+  char              sa_buffer[CONFIG_SYSLOG_ASYNC_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_async_s g_syslog_async[SYSLOG_ASYNC_NBUFFERS];
+static struct work_s g_syslog_async_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_async_output
+ *
+ * Description:
+ *   Write a batch of buffered output to all SYSLOG channels.
+ *
+ ****************************************************************************/
+
+static void syslog_async_output(FAR const char *buffer, size_t buflen,
+                                bool force)
+{
+  FAR struct syslog_channel_s *channel;
+  size_t i;
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_SYSLOG_MAX_CHANNELS; ndx++)
+    {
+      channel = g_syslog_channel[ndx];
+      if (channel == NULL)
+        {
+          break;
+        }
+
+      if (force)
+        {
+          DEBUGASSERT(channel->sc_ops->sc_force != NULL);
+
+          for (i = 0; i < buflen; i++)
+            {
+              channel->sc_ops->sc_force(channel, buffer[i]);
+            }
+        }
+      else if (channel->sc_ops->sc_write != NULL)
+        {
+          channel->sc_ops->sc_write(channel, buffer, buflen);
+        }
+      else
+        {
+          DEBUGASSERT(channel->sc_ops->sc_putc != NULL);
+
+          for (i = 0; i < buflen; i++)
+            {
+              channel->sc_ops->sc_putc(channel, buffer[i]);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_async_worker
+ *
+ * Description:
+ *   Drain the staging buffers from the low-priority work queue.
+ *
+ ****************************************************************************/
+
+static void syslog_async_worker(FAR void *arg)
+{
+  syslog_flush_async(false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_async_write
+ *
+ * Description:
+ *   Add a message to the staging buffer of the current CPU, to be written
+ *   to the SYSLOG channels by the low-priority work queue.  This only
+ *   disables the local interrupts for the copy, so that it may be called
+ *   from any context without blocking.  A message is staged as a whole or
+ *   not at all:  The messages of different CPUs are not interleaved.
+ *
+ * Input Parameters:
+ *   buffer - The message
+ *   buflen - The length of the message
+ *
+ * Returned Value:
+ *   The length of the message if it was staged or dropped.  -EAGAIN if
+ *   the caller must write it to the channels itself:  Before the work
+ *   queue runs or, with CONFIG_SYSLOG_ASYNC_WRITETHROUGH, when the staging
+ *   buffer is full.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_async_write(FAR const char *buffer, size_t buflen)
+{
+  FAR struct syslog_async_s *sa;
+  irqstate_t flags;
+  size_t space;
+  size_t head;
+  size_t tail;
+  size_t len;
+  bool empty;
+
+  if (!OSINIT_OS_READY())
+    {
+      return -EAGAIN;
+    }
+
+  flags = up_irq_save();
+
+  sa   = &g_syslog_async[syslog_async_cpu()];
+  head = sa->sa_head;
+  tail = sa->sa_tail;
+
+  space = (tail + CONFIG_SYSLOG_ASYNC_BUFSIZE - head - 1) %
+          CONFIG_SYSLOG_ASYNC_BUFSIZE;
+  if (buflen > space)
+    {
+#ifdef CONFIG_SYSLOG_ASYNC_WRITETHROUGH
+      up_irq_restore(flags);
+      return -EAGAIN;
+#else
+      sa->sa_dropped++;
+      up_irq_restore(flags);
+      return buflen;
+#endif
+    }
+
+  /* Copy the message, in up to two contiguous regions */
+
+  len = CONFIG_SYSLOG_ASYNC_BUFSIZE - head;
+  if (len > buflen)
+    {
+      len = buflen;
+    }
+
+  memcpy(&sa->sa_buffer[head], buffer, len);
+  memcpy(sa->sa_buffer, &buffer[len], buflen - len);
+
+  /* Publish the message only once it is in the buffer */
+
+  syslog_async_barrier();
+  sa->sa_head = (head + buflen) % CONFIG_SYSLOG_ASYNC_BUFSIZE;
+  empty = head == tail;
+
+  up_irq_restore(flags);
+
+  /* The worker drains the buffer until it is empty:  It only needs to be
+   * scheduled for the first message.
+   */
+
+  if (empty && work_available(&g_syslog_async_work))
+    {
+      work_queue(LPWORK, &g_syslog_async_work, syslog_async_worker,
+                 NULL, 0);
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_async
+ *
+ * Description:
+ *   Write the staged messages of all CPUs to the SYSLOG channels, followed
+ *   by the count of the messages dropped since the last report.
+ *
+ * Input Parameters:
+ *   force - Use the force interface of the channels, as when the system
+ *           is crashing and the work queue no longer runs.
+ *
+ * Assumptions:
+ *   Only called from the work queue, or after the system crashed.
+ *
+ ****************************************************************************/
+
+void syslog_flush_async(bool force)
+{
+  FAR struct syslog_async_s *sa;
+  char report[40];
+  uint32_t dropped;
+  size_t head;
+  size_t tail;
+  size_t len;
+  int i;
+
+  for (i = 0; i < SYSLOG_ASYNC_NBUFFERS; i++)
+    {
+      sa = &g_syslog_async[i];
+
+      while ((head = sa->sa_head) != (tail = sa->sa_tail))
+        {
+          /* Read the message only after its index */
+
+          syslog_async_barrier();
+
+          len = head > tail ? head - tail :
+                CONFIG_SYSLOG_ASYNC_BUFSIZE - tail;
+          syslog_async_output(&sa->sa_buffer[tail], len, force);
+
+          /* Release the space only after it was read */
+
+          syslog_async_barrier();
+          sa->sa_tail = (tail + len) % CONFIG_SYSLOG_ASYNC_BUFSIZE;
+        }
+
+      dropped = sa->sa_dropped;
+      if (dropped != sa->sa_reported)
+        {
+          len = snprintf(report, sizeof(report),
+                         "[syslog: %" PRIu32 " messages dropped]\n",
+                         dropped - sa->sa_reported);
+          syslog_async_output(report, len, force);
+          sa->sa_reported = dropped;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_async_dropped
+ *
+ * Description:
+ *   Return the total number of messages dropped because a staging buffer
+ *   was full.
+ *
+ ****************************************************************************/
+
+uint32_t syslog_async_dropped(void)
+{
+  uint32_t dropped = 0;
+  int i;
+
+  for (i = 0; i < SYSLOG_ASYNC_NBUFFERS; i++)
+    {
+      dropped += g_syslog_async[i].sa_dropped;
+    }
+
+  return dropped;
+}
+
+#endif /* CONFIG_SYSLOG_ASYNC */
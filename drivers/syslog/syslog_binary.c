@@ -0,0 +1,364 @@
+/****************************************************************************
+ * drivers/syslog/syslog_binary.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/init.h>
+#include <nuttx/irq.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_BINARY
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of the encoding of one record */
+
+struct syslog_binary_state_s
+{
+  FAR struct syslog_binary_s *rec;   /* The record */
+  size_t next;                       /* Offset of the next argument */
+  size_t size;                       /* Room for the arguments */
+  bool truncated;                    /* An argument did not fit */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_binary_put
+ *
+ * Description:
+ *   Append an argument to the record, unless an earlier one was dropped.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_put(FAR struct syslog_binary_state_s *state,
+                              FAR const void *arg, size_t len)
+{
+  if (state->truncated || state->next + len > state->size)
+    {
+      state->truncated = true;
+      return;
+    }
+
+  memcpy(&state->rec->sb_args[state->next], arg, len);
+  state->next += len;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_putstr
+ *
+ * Description:
+ *   Append a string argument to the record, truncated to the room left so
+ *   that the arguments before it are kept.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_putstr(FAR struct syslog_binary_state_s *state,
+                                 FAR const char *str)
+{
+  size_t len;
+
+  if (state->truncated || state->next >= state->size)
+    {
+      state->truncated = true;
+      return;
+    }
+
+  if (str == NULL)
+    {
+      str = "(null)";
+    }
+
+  len = strnlen(str, state->size - state->next - 1);
+  memcpy(&state->rec->sb_args[state->next], str, len);
+  state->rec->sb_args[state->next + len] = '\0';
+  state->next += len + 1;
+}
+
+/****************************************************************************
+ * Name: syslog_binary_args
+ *
+ * Description:
+ *   Append the arguments of 'fmt' to the record.  Only the conversion
+ *   specifications are parsed, to take each argument with its type; the
+ *   flags, the field widths and the precisions are left to the decoder,
+ *   except '*' that takes an int argument.
+ *
+ ****************************************************************************/
+
+static void syslog_binary_args(FAR struct syslog_binary_state_s *state,
+                               FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  int lflag;
+  char c;
+
+  while ((c = *fmt++) != '\0')
+    {
+      if (c != '%')
+        {
+          continue;
+        }
+
+      /* Skip the flags, the width and the precision */
+
+      lflag = 0;
+      while ((c = *fmt++) != '\0')
+        {
+          if (c == '*')
+            {
+              int width = va_arg(*ap, int);
+
+              syslog_binary_put(state, &width, sizeof(width));
+            }
+          else if (strchr("-+ #0123456789.", c) == NULL)
+            {
+              break;
+            }
+        }
+
+      /* Then the length modifiers */
+
+      for (; c != '\0'; c = *fmt++)
+        {
+          if (c == 'l')
+            {
+              lflag++;
+            }
+          else if (c == 'L')
+            {
+              lflag = 'L';
+            }
+          else if (c == 'j')
+            {
+              lflag = 'j';
+            }
+          else if (c == 'z')
+            {
+              lflag = 'z';
+            }
+          else if (c == 't')
+            {
+              lflag = 't';
+            }
+          else if (c != 'h')
+            {
+              break;
+            }
+        }
+
+      switch (c)
+        {
+          case '\0':
+            return;
+
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+            if (lflag == 'j')
+              {
+                intmax_t im = va_arg(*ap, intmax_t);
+
+                syslog_binary_put(state, &im, sizeof(im));
+              }
+            else if (lflag == 'z')
+              {
+                size_t sz = va_arg(*ap, size_t);
+
+                syslog_binary_put(state, &sz, sizeof(sz));
+              }
+            else if (lflag == 't')
+              {
+                ptrdiff_t ptr = va_arg(*ap, ptrdiff_t);
+
+                syslog_binary_put(state, &ptr, sizeof(ptr));
+              }
+#ifdef CONFIG_HAVE_LONG_LONG
+            else if (lflag >= 2)
+              {
+                long long ll = va_arg(*ap, long long);
+
+                syslog_binary_put(state, &ll, sizeof(ll));
+              }
+#endif
+            else if (lflag == 1)
+              {
+                long l = va_arg(*ap, long);
+
+                syslog_binary_put(state, &l, sizeof(l));
+              }
+            else
+              {
+                int i = va_arg(*ap, int);
+
+                syslog_binary_put(state, &i, sizeof(i));
+              }
+            break;
+
+          case 'c':
+            {
+              int i = va_arg(*ap, int);
+
+              syslog_binary_put(state, &i, sizeof(i));
+            }
+            break;
+
+          case 'p':
+            {
+              uintptr_t p = (uintptr_t)va_arg(*ap, FAR void *);
+
+              syslog_binary_put(state, &p, sizeof(p));
+            }
+            break;
+
+          case 's':
+            syslog_binary_putstr(state, va_arg(*ap, FAR const char *));
+            break;
+
+          case 'n':
+            (void)va_arg(*ap, FAR void *);
+            break;
+
+#ifdef CONFIG_HAVE_DOUBLE
+          case 'a':
+          case 'A':
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+            {
+              double d;
+
+              /* The long doubles are recorded as doubles */
+
+#  ifdef CONFIG_HAVE_LONG_DOUBLE
+              if (lflag == 'L')
+                {
+                  d = va_arg(*ap, long double);
+                }
+              else
+#  endif
+                {
+                  d = va_arg(*ap, double);
+                }
+
+              syslog_binary_put(state, &d, sizeof(d));
+            }
+            break;
+#endif
+
+          default:
+            break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_binary
+ *
+ * Description:
+ *   Write a message to the SYSLOG channels as a binary record, without
+ *   formatting it:  Only the address of the format string and the values
+ *   of the arguments are recorded, and the message is formatted on the
+ *   host by tools/syslogdecode.py.  The arguments that do not fit in the
+ *   record are dropped and the record is marked as truncated.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string, that must be in the image
+ *   ap       - The arguments
+ *
+ * Returned Value:
+ *   The size of the record written.
+ *
+ ****************************************************************************/
+
+int syslog_binary(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
+{
+  struct syslog_binary_state_s state;
+  uint8_t data[SYSLOG_BINARY_MAXSIZE];
+  uint32_t ticks = 0;
+  uintptr_t addr = (uintptr_t)fmt;
+  size_t length;
+
+  state.rec       = (FAR struct syslog_binary_s *)data;
+  state.next      = 0;
+  state.size      = sizeof(data) - SIZEOF_SYSLOG_BINARY(0);
+  state.truncated = false;
+
+  /* Early debug output may come before the timer is running */
+
+  if (OSINIT_HW_READY())
+    {
+      ticks = (uint32_t)clock_systime_ticks();
+    }
+
+  syslog_binary_args(&state, fmt, ap);
+
+  length = SIZEOF_SYSLOG_BINARY(state.next);
+
+  state.rec->sb_magic    = SYSLOG_BINARY_MAGIC;
+  state.rec->sb_priority = priority;
+  state.rec->sb_cpu      = up_cpu_index();
+  state.rec->sb_length   = length;
+
+  if (state.truncated)
+    {
+      state.rec->sb_priority |= SYSLOG_BINARY_TRUNCATED;
+    }
+
+  memcpy(state.rec->sb_ticks, &ticks, sizeof(ticks));
+  memcpy(state.rec->sb_fmt, &addr, sizeof(addr));
+
+  /* Write the record in a single call so that it is not interleaved with
+   * other output.
+   */
+
+  return (int)syslog_write((FAR const char *)data, length);
+}
+
+#endif /* CONFIG_SYSLOG_BINARY */
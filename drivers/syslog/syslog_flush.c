@@ -74,6 +74,12 @@ int syslog_flush(void)
   syslog_flush_intbuffer(true);
 #endif
 
+#ifdef CONFIG_SYSLOG_ASYNC
+  /* Flush the messages staged for the work queue */
+
+  syslog_flush_async(true);
+#endif
+
   for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
     {
       if (g_syslog_channel[i] == NULL)
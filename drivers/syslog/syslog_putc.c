@@ -57,6 +57,17 @@ int syslog_putc(int ch)
 {
   int i;
 
+#ifdef CONFIG_SYSLOG_ASYNC
+  char c = ch;
+
+  /* Stage the character for the work queue if possible */
+
+  if (syslog_async_write(&c, 1) >= 0)
+    {
+      return ch;
+    }
+#endif
+
   /* Is this an attempt to do SYSLOG output from an interrupt handler? */
 
   if (up_interrupt_context() || sched_idletask())
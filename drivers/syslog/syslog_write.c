@@ -139,6 +139,18 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
 
 ssize_t syslog_write(FAR const char *buffer, size_t buflen)
 {
+#ifdef CONFIG_SYSLOG_ASYNC
+  ssize_t ret;
+
+  /* Stage the message for the work queue if possible */
+
+  ret = syslog_async_write(buffer, buflen);
+  if (ret >= 0)
+    {
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   if (!up_interrupt_context() && !sched_idletask())
     {
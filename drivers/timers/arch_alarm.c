@@ -24,8 +24,12 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/timers/arch_alarm.h>
 
 /****************************************************************************
@@ -39,12 +43,31 @@
 #define timespec_to_usec(ts) \
     ((uint64_t)(ts)->tv_sec * USEC_PER_SEC + (ts)->tv_nsec / NSEC_PER_USEC)
 
+#define timespec_to_nsec(ts) \
+    ((uint64_t)(ts)->tv_sec * NSEC_PER_SEC + (ts)->tv_nsec)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 static FAR struct oneshot_lowerhalf_s *g_oneshot_lower;
 
+/* The oneshot timer is shared by the scheduler and the hrtimers: It is
+ * programmed for the earliest of their expiration times.
+ */
+
+static struct timespec g_oneshot_maxdelay;
+static struct timespec g_oneshot_expire;  /* The time programmed */
+
+/* The alarm of the scheduler, or the time of the next tick */
+
+static struct timespec g_sched_expire;
+static bool g_sched_active;
+
+#ifdef CONFIG_HRTIMER
+static uint64_t g_hrtimer_expire = UINT64_MAX;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -57,6 +80,13 @@ static inline void timespec_from_usec(FAR struct timespec *ts,
   ts->tv_nsec   = microseconds * NSEC_PER_USEC;
 }
 
+static inline void timespec_from_nsec(FAR struct timespec *ts,
+                                      uint64_t nanoseconds)
+{
+  ts->tv_sec  = nanoseconds / NSEC_PER_SEC;
+  ts->tv_nsec = nanoseconds - (uint64_t)ts->tv_sec * NSEC_PER_SEC;
+}
+
 static void udelay_accurate(useconds_t microseconds)
 {
   struct timespec now;
@@ -120,31 +150,108 @@ static void udelay_coarse(useconds_t microseconds)
     }
 }
 
+static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
+                             FAR void *arg);
+
+/****************************************************************************
+ * Name: oneshot_restart
+ *
+ * Description:
+ *   Program the oneshot timer for the earliest of the expiration times of
+ *   the scheduler and of the hrtimers.  Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void oneshot_restart(void)
+{
+  struct timespec now;
+  struct timespec delta;
+  bool armed = false;
+
+  if (g_sched_active)
+    {
+      g_oneshot_expire = g_sched_expire;
+      armed = true;
+    }
+
+#ifdef CONFIG_HRTIMER
+  if (g_hrtimer_expire != UINT64_MAX)
+    {
+      struct timespec ts;
+
+      timespec_from_nsec(&ts, g_hrtimer_expire);
+      if (!armed || clock_timespec_compare(&ts, &g_oneshot_expire) < 0)
+        {
+          g_oneshot_expire = ts;
+          armed = true;
+        }
+    }
+#endif
+
+  ONESHOT_CANCEL(g_oneshot_lower, &delta);
+  if (!armed)
+    {
+      return;
+    }
+
+  /* A time beyond the maximum delay is reached in several steps */
+
+  ONESHOT_CURRENT(g_oneshot_lower, &now);
+  clock_timespec_subtract(&g_oneshot_expire, &now, &delta);
+  if (clock_timespec_compare(&delta, &g_oneshot_maxdelay) > 0)
+    {
+      delta = g_oneshot_maxdelay;
+      clock_timespec_add(&now, &delta, &g_oneshot_expire);
+    }
+
+  ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &delta);
+}
+
 static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
                              FAR void *arg)
 {
   struct timespec now;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  /* The lower half may round the delay down a little: The events due at
+   * the time programmed are due, even if the timer reads a bit earlier.
+   */
 
-#ifdef CONFIG_SCHED_TICKLESS
   ONESHOT_CURRENT(g_oneshot_lower, &now);
-  nxsched_alarm_expiration(&now);
-#else
-  struct timespec delta;
+  if (clock_timespec_compare(&now, &g_oneshot_expire) < 0)
+    {
+      now = g_oneshot_expire;
+    }
+
+#ifdef CONFIG_HRTIMER
+  if (g_hrtimer_expire <= timespec_to_nsec(&now))
+    {
+      g_hrtimer_expire = hrtimer_process(timespec_to_nsec(&now));
+    }
+#endif
 
-  do
+#ifdef CONFIG_SCHED_TICKLESS
+  if (g_sched_active && clock_timespec_compare(&g_sched_expire, &now) <= 0)
+    {
+      g_sched_active = false;
+      ONESHOT_CURRENT(g_oneshot_lower, &now);
+      nxsched_alarm_expiration(&now);
+    }
+#else
+  while (clock_timespec_compare(&g_sched_expire, &now) <= 0)
     {
       static uint64_t tick = 1;
-      struct timespec next;
 
       nxsched_process_timer();
-      timespec_from_usec(&next, ++tick * USEC_PER_TICK);
+      timespec_from_usec(&g_sched_expire, ++tick * USEC_PER_TICK);
       ONESHOT_CURRENT(g_oneshot_lower, &now);
-      clock_timespec_subtract(&next, &now, &delta);
     }
-  while (delta.tv_sec == 0 && delta.tv_nsec == 0);
-
-  ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &delta);
 #endif
+
+  oneshot_restart();
+  leave_critical_section(flags);
 }
 
 /****************************************************************************
@@ -153,21 +260,26 @@ static void oneshot_callback(FAR struct oneshot_lowerhalf_s *lower,
 
 void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower)
 {
+  irqstate_t flags;
 #ifdef CONFIG_SCHED_TICKLESS
-  struct timespec maxts;
   uint64_t maxticks;
+#endif
+
+  flags = enter_critical_section();
 
   g_oneshot_lower = lower;
-  ONESHOT_MAX_DELAY(g_oneshot_lower, &maxts);
-  maxticks = timespec_to_usec(&maxts) / USEC_PER_TICK;
+  ONESHOT_MAX_DELAY(g_oneshot_lower, &g_oneshot_maxdelay);
+
+#ifdef CONFIG_SCHED_TICKLESS
+  maxticks = timespec_to_usec(&g_oneshot_maxdelay) / USEC_PER_TICK;
   g_oneshot_maxticks = maxticks < UINT32_MAX ? maxticks : UINT32_MAX;
 #else
-  struct timespec ts;
-
-  g_oneshot_lower = lower;
-  timespec_from_usec(&ts, USEC_PER_TICK);
-  ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &ts);
+  timespec_from_usec(&g_sched_expire, USEC_PER_TICK);
+  g_sched_active = true;
 #endif
+
+  oneshot_restart();
+  leave_critical_section(flags);
 }
 
 /****************************************************************************
@@ -303,8 +415,18 @@ int weak_function up_alarm_cancel(FAR struct timespec *ts)
 
   if (g_oneshot_lower != NULL)
     {
+      irqstate_t flags = enter_critical_section();
+
+      g_sched_active = false;
+#ifdef CONFIG_HRTIMER
+      oneshot_restart();
+      ret = OK;
+#else
       ret = ONESHOT_CANCEL(g_oneshot_lower, ts);
+#endif
       ONESHOT_CURRENT(g_oneshot_lower, ts);
+
+      leave_critical_section(flags);
     }
 
   return ret;
@@ -342,18 +464,67 @@ int weak_function up_alarm_start(FAR const struct timespec *ts)
 
   if (g_oneshot_lower != NULL)
     {
-      struct timespec now;
-      struct timespec delta;
+      irqstate_t flags = enter_critical_section();
 
-      ONESHOT_CURRENT(g_oneshot_lower, &now);
-      clock_timespec_subtract(ts, &now, &delta);
-      ret = ONESHOT_START(g_oneshot_lower, oneshot_callback, NULL, &delta);
+      g_sched_expire = *ts;
+      g_sched_active = true;
+      oneshot_restart();
+      ret = OK;
+
+      leave_critical_section(flags);
     }
 
   return ret;
 }
 #endif
 
+#ifdef CONFIG_HRTIMER
+/****************************************************************************
+ * Name: up_alarm_hrtimer_start
+ *
+ * Description:
+ *   Program the oneshot timer for the first hrtimer to expire, along with
+ *   the alarm of the scheduler.  Called by the hrtimer logic in a critical
+ *   section.
+ *
+ * Input Parameters:
+ *   expired - The time of the first hrtimer to expire, in nanoseconds, or
+ *             UINT64_MAX if no hrtimer is active.
+ *
+ ****************************************************************************/
+
+void up_alarm_hrtimer_start(uint64_t expired)
+{
+  g_hrtimer_expire = expired;
+  if (g_oneshot_lower != NULL)
+    {
+      oneshot_restart();
+    }
+}
+
+/****************************************************************************
+ * Name: up_alarm_hrtimer_gettime
+ *
+ * Description:
+ *   Return the time of the oneshot timer in nanoseconds, or zero if it is
+ *   not initialized yet.
+ *
+ ****************************************************************************/
+
+uint64_t up_alarm_hrtimer_gettime(void)
+{
+  struct timespec now;
+
+  if (g_oneshot_lower == NULL ||
+      ONESHOT_CURRENT(g_oneshot_lower, &now) < 0)
+    {
+      return 0;
+    }
+
+  return timespec_to_nsec(&now);
+}
+#endif
+
 /****************************************************************************
  * Name: up_perf_*
  *
@@ -0,0 +1,253 @@
+/****************************************************************************
+ * drivers/timers/hrtimer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/timers/arch_alarm.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+RB_HEAD(hrtimer_tree_s, hrtimer_s);
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b);
+
+RB_GENERATE_STATIC(hrtimer_tree_s, hrtimer_s, node, hrtimer_compare);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The active timers, by expiration time */
+
+static struct hrtimer_tree_s g_hrtimer_tree =
+  RB_INITIALIZER(&g_hrtimer_tree);
+
+/* The callbacks are running: hrtimer_process() programs the next
+ * expiration when they are done.
+ */
+
+static bool g_hrtimer_processing;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_compare
+ *
+ * Description:
+ *   Order the timers by expiration time.  The timers that expire at the
+ *   same time are ordered by address, since the tree keys must be unique.
+ *
+ ****************************************************************************/
+
+static int hrtimer_compare(FAR struct hrtimer_s *a,
+                           FAR struct hrtimer_s *b)
+{
+  if (a->expired != b->expired)
+    {
+      return a->expired < b->expired ? -1 : 1;
+    }
+
+  if (a != b)
+    {
+      return (uintptr_t)a < (uintptr_t)b ? -1 : 1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Program the oneshot timer for the first timer of the tree, if it
+ *   changed from 'first'.  Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void hrtimer_reprogram(FAR struct hrtimer_s *first)
+{
+  FAR struct hrtimer_s *next;
+
+  if (g_hrtimer_processing)
+    {
+      return;
+    }
+
+  next = RB_MIN(hrtimer_tree_s, &g_hrtimer_tree);
+  if (next != first || next == NULL)
+    {
+      up_alarm_hrtimer_start(next != NULL ? next->expired : UINT64_MAX);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_init
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer, hrtimer_entry_t func,
+                  FAR void *arg)
+{
+  DEBUGASSERT(hrtimer != NULL && func != NULL);
+
+  hrtimer->expired = 0;
+  hrtimer->func    = func;
+  hrtimer->arg     = arg;
+  hrtimer->active  = false;
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t ns,
+                  enum hrtimer_mode_e mode)
+{
+  FAR struct hrtimer_s *first;
+  irqstate_t flags;
+
+  if (hrtimer == NULL || hrtimer->func == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (mode == HRTIMER_MODE_REL)
+    {
+      ns += hrtimer_gettime();
+    }
+
+  flags = enter_critical_section();
+
+  first = RB_MIN(hrtimer_tree_s, &g_hrtimer_tree);
+  if (hrtimer->active)
+    {
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+    }
+
+  hrtimer->expired = ns;
+  hrtimer->active  = true;
+  RB_INSERT(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+
+  /* A timer restarted while it was the first one moves in the tree */
+
+  hrtimer_reprogram(first == hrtimer ? NULL : first);
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct hrtimer_s *first;
+  irqstate_t flags;
+  int ret = -EINVAL;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  flags = enter_critical_section();
+
+  if (hrtimer->active)
+    {
+      first = RB_MIN(hrtimer_tree_s, &g_hrtimer_tree);
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+      hrtimer->active = false;
+
+      /* There is no need to reprogram the oneshot timer for the other
+       * timers: An early expiration just finds nothing to run.
+       */
+
+      if (first == hrtimer && RB_EMPTY(&g_hrtimer_tree))
+        {
+          hrtimer_reprogram(first);
+        }
+
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void)
+{
+  return up_alarm_hrtimer_gettime();
+}
+
+/****************************************************************************
+ * Name: hrtimer_process
+ ****************************************************************************/
+
+uint64_t hrtimer_process(uint64_t now)
+{
+  FAR struct hrtimer_s *hrtimer;
+
+  g_hrtimer_processing = true;
+
+  /* The callbacks may start and cancel any timer, so look for the first
+   * one again each time.
+   */
+
+  while ((hrtimer = RB_MIN(hrtimer_tree_s, &g_hrtimer_tree)) != NULL &&
+         hrtimer->expired <= now)
+    {
+      RB_REMOVE(hrtimer_tree_s, &g_hrtimer_tree, hrtimer);
+      hrtimer->active = false;
+      hrtimer->func(hrtimer);
+    }
+
+  g_hrtimer_processing = false;
+
+  return hrtimer != NULL ? hrtimer->expired : UINT64_MAX;
+}
+
+#endif /* CONFIG_HRTIMER */
@@ -310,23 +310,37 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
   FAR struct uart_buffer_s *xmit = &serdev->xmit;
   irqstate_t flags;
   uint16_t nbytes = 0;
+  uint16_t ncopy;
 
   /* Disable interrupts */
 
   flags = enter_critical_section();
 
   /* Transfer bytes while we have bytes available and there is room in the
-   * request.
+   * request.  The bytes are copied in (at most) two runs, before and after
+   * the wrap around of the circular buffer.
    */
 
   while (xmit->head != xmit->tail && nbytes < reqlen)
     {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
+      if (xmit->head > xmit->tail)
+        {
+          ncopy = xmit->head - xmit->tail;
+        }
+      else
+        {
+          ncopy = xmit->size - xmit->tail;
+        }
+
+      ncopy = MIN(ncopy, reqlen - nbytes);
+      memcpy(reqbuf, &xmit->buffer[xmit->tail], ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
 
       /* Increment the tail pointer */
 
-      if (++(xmit->tail) >= xmit->size)
+      xmit->tail += ncopy;
+      if (xmit->tail >= xmit->size)
         {
           xmit->tail = 0;
         }
@@ -404,6 +418,30 @@ static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
 
   while (!sq_empty(&priv->txfree))
     {
+#ifdef CONFIG_CDCACM_WRAGGREGATE
+      /* While a request is in flight, keep less than a packet of data in
+       * the TX buffer: its completion will send it, together with what is
+       * written in the meantime, instead of in a packet of its own.
+       */
+
+      if (priv->nwrq < CONFIG_CDCACM_NWRREQS)
+        {
+          FAR struct uart_buffer_s *xmit = &priv->serdev.xmit;
+          int nbuffered;
+
+          nbuffered = xmit->head - xmit->tail;
+          if (nbuffered < 0)
+            {
+              nbuffered += xmit->size;
+            }
+
+          if (nbuffered < ep->maxpacket)
+            {
+              break;
+            }
+        }
+#endif
+
       /* Peek at the request in the container at the head of the list */
 
       wrcontainer = (FAR struct cdcacm_wrreq_s *)sq_peek(&priv->txfree);
@@ -464,6 +502,8 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   FAR uint8_t *reqbuf;
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   unsigned int watermark;
+#else
+  uint16_t ncopy;
 #endif
   uint16_t reqlen;
   uint16_t nexthead;
@@ -523,6 +563,43 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
    * proper way to throttle a serial device.
    */
 
+#ifndef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+  /* Without watermarks to check after each byte, copy the data in (at
+   * most) two runs, before and after the wrap around of the circular
+   * buffer.  One byte of the buffer always stays free.
+   */
+
+  while (nexthead != recv->tail && nbytes < reqlen)
+    {
+      if (recv->tail > recv->head)
+        {
+          ncopy = recv->tail - recv->head - 1;
+        }
+      else
+        {
+          ncopy = recv->size - recv->head - (recv->tail == 0 ? 1 : 0);
+        }
+
+      ncopy = MIN(ncopy, reqlen - nbytes);
+      memcpy(&recv->buffer[recv->head], reqbuf, ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
+
+      /* Update the head index and check for wrap around */
+
+      recv->head += ncopy;
+      if (recv->head >= recv->size)
+        {
+          recv->head = 0;
+        }
+
+      nexthead = recv->head + 1;
+      if (nexthead >= recv->size)
+        {
+          nexthead = 0;
+        }
+    }
+#else
   while (nexthead != recv->tail && nbytes < reqlen)
     {
 #if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
@@ -570,6 +647,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
           nexthead = 0;
         }
     }
+#endif
 
 #if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
     !defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
@@ -64,10 +64,22 @@
 #  define CONFIG_RNDIS_NWRREQS  (2)
 #endif
 
+#ifndef CONFIG_RNDIS_PKTPERXFER
+#  define CONFIG_RNDIS_PKTPERXFER (1)
+#endif
+
+/* The bulk IN requests hold up to CONFIG_RNDIS_PKTPERXFER packet messages,
+ * each one padded to a multiple of 4 bytes as the next one follows it.
+ */
+
 #define RNDIS_PACKET_HDR_SIZE   (sizeof(struct rndis_packet_msg))
+#define RNDIS_PACKET_MSG_SIZE \
+  ((CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE + \
+    RNDIS_PACKET_HDR_SIZE + 3) & ~3)
 #define CONFIG_RNDIS_BULKIN_REQLEN \
+  (CONFIG_RNDIS_PKTPERXFER * RNDIS_PACKET_MSG_SIZE)
+#define CONFIG_RNDIS_BULKOUT_REQLEN \
   (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE + RNDIS_PACKET_HDR_SIZE)
-#define CONFIG_RNDIS_BULKOUT_REQLEN CONFIG_RNDIS_BULKIN_REQLEN
 
 #define RNDIS_NCONFIGS          (1)
 #define RNDIS_CONFIGID          (1)
@@ -144,6 +156,9 @@ struct rndis_dev_s
 
   uint8_t config;                        /* USB Configuration number */
   FAR struct rndis_req_s *net_req;       /* Pointer to request whose buffer is assigned to network */
+  uint16_t net_offset;                   /* Next packet offset in net_req */
+  uint8_t net_npkts;                     /* Packets packed in net_req */
+  uint32_t host_xfrsize;                 /* Host max bulk IN transfer size */
   FAR struct rndis_req_s *rx_req;        /* Pointer request container that holds RX buffer */
   size_t current_rx_received;            /* Number of bytes of current RX datagram received over USB */
   size_t current_rx_datagram_size;       /* Total number of bytes of the current RX datagram */
@@ -674,6 +689,8 @@ static bool rndis_allocnetreq(FAR struct rndis_dev_s *priv)
   priv->net_req = rndis_allocwrreq(priv);
   if (priv->net_req)
     {
+      priv->net_offset   = 0;
+      priv->net_npkts    = 0;
       priv->netdev.d_buf = &priv->net_req->req->buf[RNDIS_PACKET_HDR_SIZE];
       priv->netdev.d_len = CONFIG_NET_ETH_PKTSIZE;
     }
@@ -702,7 +719,9 @@ static void rndis_sendnetreq(FAR struct rndis_dev_s *priv)
 
   DEBUGASSERT(priv->net_req != NULL);
 
-  priv->net_req->req->priv = priv->net_req;
+  priv->net_req->req->priv  = priv->net_req;
+  priv->net_req->req->len   = priv->net_offset;
+  priv->net_req->req->flags = USBDEV_REQFLAGS_NULLPKT;
   EP_SUBMIT(priv->epbulkin, priv->net_req->req);
 
   priv->net_req            = NULL;
@@ -784,6 +803,8 @@ static void rndis_giverxreq(FAR struct rndis_dev_s *priv)
   DEBUGASSERT(priv->net_req == NULL);
 
   priv->net_req      = priv->rx_req;
+  priv->net_offset   = 0;
+  priv->net_npkts    = 0;
   priv->netdev.d_buf = &priv->net_req->req->buf[RNDIS_PACKET_HDR_SIZE];
   priv->netdev.d_len = CONFIG_NET_ETH_PKTSIZE;
   priv->rx_req       = NULL;
@@ -793,14 +814,15 @@ static void rndis_giverxreq(FAR struct rndis_dev_s *priv)
  * Name: rndis_fillrequest
  *
  * Description:
- *   Fills the RNDIS header to the request buffer
+ *   Fills the RNDIS header of the packet message of the network in the
+ *   request buffer
  *
  * Input Parameters:
  *   priv: pointer to RNDIS device driver structure
  *   req: the request whose buffer we should fill
  *
  * Returned Value:
- *   The total length of the request data
+ *   The length of the packet message, padded for the next one
  *
  * Assumptions:
  *   Caller holds the network lock
@@ -811,29 +833,53 @@ static uint16_t rndis_fillrequest(FAR struct rndis_dev_s *priv,
                                   FAR struct usbdev_req_s *req)
 {
   size_t datalen;
-
-  req->len = 0;
+  size_t msglen = 0;
 
   datalen = min(priv->netdev.d_len,
-                CONFIG_RNDIS_BULKIN_REQLEN - RNDIS_PACKET_HDR_SIZE);
+                RNDIS_PACKET_MSG_SIZE - RNDIS_PACKET_HDR_SIZE);
   if (datalen > 0)
     {
       /* Send the required headers */
 
       FAR struct rndis_packet_msg *msg =
-        (FAR struct rndis_packet_msg *)req->buf;
+        (FAR struct rndis_packet_msg *)&req->buf[priv->net_offset];
       memset(msg, 0, RNDIS_PACKET_HDR_SIZE);
 
+      msglen          = (RNDIS_PACKET_HDR_SIZE + datalen + 3) & ~3;
       msg->msgtype    = RNDIS_PACKET_MSG;
-      msg->msglen     = RNDIS_PACKET_HDR_SIZE + datalen;
+      msg->msglen     = msglen;
       msg->dataoffset = RNDIS_PACKET_HDR_SIZE - 8;
       msg->datalen    = datalen;
-
-      req->flags      = USBDEV_REQFLAGS_NULLPKT;
-      req->len        = datalen + RNDIS_PACKET_HDR_SIZE;
     }
 
-  return req->len;
+  return msglen;
+}
+
+/****************************************************************************
+ * Name: rndis_flushnetreq
+ *
+ * Description:
+ *   Submits the request buffer held by the network if it holds packet
+ *   messages, frees it otherwise.
+ *
+ * Input Parameters:
+ *   priv: pointer to RNDIS device driver structure
+ *
+ * Assumptions:
+ *   Caller holds the network lock
+ *
+ ****************************************************************************/
+
+static void rndis_flushnetreq(FAR struct rndis_dev_s *priv)
+{
+  if (priv->net_npkts > 0)
+    {
+      rndis_sendnetreq(priv);
+    }
+  else
+    {
+      rndis_freenetreq(priv);
+    }
 }
 
 /****************************************************************************
@@ -959,7 +1005,7 @@ static void rndis_rxdispatch(FAR void *arg)
 
   if (priv->net_req != NULL)
     {
-      rndis_freenetreq(priv);
+      rndis_flushnetreq(priv);
     }
 
   net_unlock();
@@ -1046,7 +1092,24 @@ static int rndis_transmit(FAR struct rndis_dev_s *priv)
 
   /* Queue the packet */
 
-  rndis_fillrequest(priv, priv->net_req->req);
+  priv->net_offset += rndis_fillrequest(priv, priv->net_req->req);
+  priv->net_npkts++;
+
+  /* Keep the request for the next packet if there is room for it in the
+   * request and in the transfers that the host accepts.  The request is
+   * submitted when it is full, or when the network has no more packets to
+   * send.
+   */
+
+  if (priv->net_npkts < CONFIG_RNDIS_PKTPERXFER &&
+      priv->net_offset + RNDIS_PACKET_MSG_SIZE <= priv->host_xfrsize)
+    {
+      priv->netdev.d_buf =
+        &priv->net_req->req->buf[priv->net_offset + RNDIS_PACKET_HDR_SIZE];
+      priv->netdev.d_len = CONFIG_NET_ETH_PKTSIZE;
+      return OK;
+    }
+
   rndis_sendnetreq(priv);
 
   if (!rndis_allocnetreq(priv))
@@ -1102,7 +1165,7 @@ static void rndis_txavail_work(FAR void *arg)
       devif_poll(&priv->netdev, rndis_txpoll);
       if (priv->net_req != NULL)
         {
-          rndis_freenetreq(priv);
+          rndis_flushnetreq(priv);
         }
     }
 
@@ -1369,9 +1432,17 @@ static int rndis_handle_control_message(FAR struct rndis_dev_s *priv,
     {
       case RNDIS_INITIALIZE_MSG:
         {
+          FAR struct rndis_initialize_msg *req =
+            (FAR struct rndis_initialize_msg *)dataout;
           FAR struct rndis_initialize_cmplt *resp;
           size_t respsize = sizeof(struct rndis_initialize_cmplt);
 
+          /* Several packet messages may be sent in one transfer, up to the
+           * transfer size of the host.
+           */
+
+          priv->host_xfrsize = req->xfrsize;
+
           resp = rndis_prepare_response(priv, respsize, cmd_hdr);
           if (!resp)
             {
@@ -1506,20 +1506,16 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
 
   memset(lun, 0, sizeof(struct usbmsc_lun_s));
 
-  /* Allocate an I/O buffer big enough to hold one hardware sector.  SCSI
-   * commands are processed one at a time so all LUNs may share a single I/O
-   * buffer.  The I/O buffer will be allocated so that is it as large as the
-   * largest block device sector size
+  /* Allocate an I/O buffer big enough to hold USBMSC_IOSECTORS hardware
+   * sectors.  SCSI commands are processed one at a time so all LUNs may
+   * share a single I/O buffer.  The I/O buffer will be allocated so that is
+   * it as large as the largest block device sector size
    */
 
   if (!priv->iobuffer)
     {
-#ifdef CONFIG_USBMSC_WRMULTIPLE
       priv->iobuffer = (FAR uint8_t *)kmm_malloc(geo.geo_sectorsize *
-                                                 CONFIG_USBMSC_NWRREQS);
-#else
-      priv->iobuffer = (FAR uint8_t *)kmm_malloc(geo.geo_sectorsize);
-#endif
+                                                 USBMSC_IOSECTORS);
       if (!priv->iobuffer)
         {
           usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_ALLOCIOBUFFER),
@@ -1527,17 +1523,14 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
           return -ENOMEM;
         }
 
-#ifdef CONFIG_USBMSC_WRMULTIPLE
-      priv->iosize = geo.geo_sectorsize * CONFIG_USBMSC_NWRREQS;
-#else
-      priv->iosize = geo.geo_sectorsize;
-#endif
+      priv->iosize = geo.geo_sectorsize * USBMSC_IOSECTORS;
     }
-  else if (priv->iosize < geo.geo_sectorsize)
+  else if (priv->iosize < geo.geo_sectorsize * USBMSC_IOSECTORS)
     {
       FAR void *tmp;
 
-      tmp = (FAR void *)kmm_realloc(priv->iobuffer, geo.geo_sectorsize);
+      tmp = (FAR void *)kmm_realloc(priv->iobuffer,
+                                    geo.geo_sectorsize * USBMSC_IOSECTORS);
       if (!tmp)
         {
           usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_REALLOCIOBUFFER),
@@ -1546,7 +1539,7 @@ int usbmsc_bindlun(FAR void *handle, FAR const char *drvrpath,
         }
 
       priv->iobuffer = (FAR uint8_t *)tmp;
-      priv->iosize   = geo.geo_sectorsize;
+      priv->iosize   = geo.geo_sectorsize * USBMSC_IOSECTORS;
     }
 
   lun->inode       = inode;
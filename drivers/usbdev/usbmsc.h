@@ -333,6 +333,24 @@
 #define USBMSC_DRVR_GEOMETRY(l,g) \
   ((l)->inode->u.i_bops->geometry((l)->inode,g))
 
+/* The number of sectors in iobuffer[]: the sectors of one block driver
+ * write with CONFIG_USBMSC_WRMULTIPLE, or of one block driver read with
+ * CONFIG_USBMSC_RDMULTIPLE, whichever is larger.
+ */
+
+#ifdef CONFIG_USBMSC_WRMULTIPLE
+#  define USBMSC_WRSECTORS CONFIG_USBMSC_NWRREQS
+#else
+#  define USBMSC_WRSECTORS 1
+#endif
+
+#if defined(CONFIG_USBMSC_RDMULTIPLE) && \
+    CONFIG_USBMSC_RDSECTORS > USBMSC_WRSECTORS
+#  define USBMSC_IOSECTORS CONFIG_USBMSC_RDSECTORS
+#else
+#  define USBMSC_IOSECTORS USBMSC_WRSECTORS
+#endif
+
 /* Everpresent MIN/MAX macros ***********************************************/
 
 #ifndef MIN
@@ -416,9 +434,10 @@ struct usbmsc_dev_s
   uint8_t           cbwdir:2;         /* Direction from CBW. See USBMSC_FLAGS_DIR* definitions */
   uint8_t           cdblen;           /* Length of cdb[] from CBW */
   uint8_t           cbwlun;           /* LUN from the CBW */
-  uint16_t          nsectbytes;       /* Bytes buffered in iobuffer[] */
+  uint32_t          nsectbytes;       /* Bytes buffered in iobuffer[] */
   uint16_t          nreqbytes;        /* Bytes buffered in head write requests */
-  uint16_t          iosize;           /* Size of iobuffer[] */
+  uint32_t          iosize;           /* Size of iobuffer[] */
+  uint32_t          iolen;            /* Bytes read into iobuffer[] */
   uint32_t          cbwlen;           /* Length of data from CBW */
   uint32_t          cbwtag;           /* Tag from the CBW */
   union
@@ -2222,7 +2222,8 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be read.
  *   sector     - holds the sector number of the next sector to be read
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   iolen      - holds the number of bytes read into the I/O buffer
+ *   nsectbytes - holds the number of bytes of the I/O buffer not sent yet
  *   nreqbytes  - holds the number of bytes currently buffered in the request
  *                at the head of the wrreqlist.
  *
@@ -2237,9 +2238,24 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   ssize_t nread;
   uint8_t *src;
   uint8_t *dest;
+  size_t nsectors;
+  int reqlen;
   int nbytes;
   int ret;
 
+  /* Fill the write requests up to their size, but in whole packets: a
+   * short packet would end the transfer for the host.
+   */
+
+#ifdef CONFIG_USBMSC_RDMULTIPLE
+  reqlen = CONFIG_USBMSC_BULKINREQLEN -
+           CONFIG_USBMSC_BULKINREQLEN % priv->epbulkin->maxpacket;
+  if (reqlen < priv->epbulkin->maxpacket)
+#endif
+    {
+      reqlen = priv->epbulkin->maxpacket;
+    }
+
   /* Loop transferring data until either (1) all of the data has been
    * transferred, or (2) we have used up all of the write requests that we
    * have available.
@@ -2253,10 +2269,19 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
 
       if (priv->nsectbytes <= 0)
         {
-          /* Yes.. read the next sector */
+          /* Yes.. read the next sectors.  The block driver reads them in
+           * one transfer while the write requests already submitted are
+           * sent to the host.
+           */
 
-          nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector, 1);
-          if (nread < 0)
+#ifdef CONFIG_USBMSC_RDMULTIPLE
+          nsectors = MIN(priv->u.xfrlen, priv->iosize / lun->sectorsize);
+#else
+          nsectors = 1;
+#endif
+          nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector,
+                                   nsectors);
+          if (nread <= 0)
             {
               usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL),
                        -nread);
@@ -2265,9 +2290,11 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
               break;
             }
 
-          priv->nsectbytes = lun->sectorsize;
-          priv->u.xfrlen--;
-          priv->sector++;
+          DEBUGASSERT((size_t)nread <= nsectors);
+          priv->iolen      = nread * lun->sectorsize;
+          priv->nsectbytes = priv->iolen;
+          priv->u.xfrlen  -= nread;
+          priv->sector    += nread;
         }
 
       /* Check if there is a request in the wrreqlist that we will be able to
@@ -2295,11 +2322,10 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * OR (2) all of the data available in the sector buffer.
        */
 
-      src    = &priv->iobuffer[lun->sectorsize - priv->nsectbytes];
+      src    = &priv->iobuffer[priv->iolen - priv->nsectbytes];
       dest   = &req->buf[priv->nreqbytes];
 
-      nbytes = MIN(priv->epbulkin->maxpacket - priv->nreqbytes,
-                   priv->nsectbytes);
+      nbytes = MIN(reqlen - priv->nreqbytes, priv->nsectbytes);
 
       /* Copy the data from the sector buffer to the USB request and update
        * counts
@@ -2314,7 +2340,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * then submit the request
        */
 
-      if (priv->nreqbytes >= priv->epbulkin->maxpacket ||
+      if (priv->nreqbytes >= reqlen ||
           (priv->u.xfrlen <= 0 && priv->nsectbytes <= 0))
         {
           /* Remove the request that we just filled from wrreqlist (we've
@@ -76,6 +76,24 @@
 #  error "Currently limited to 26 devices /dev/sda-z"
 #endif
 
+/* READ(10) and WRITE(10) transfer 65535 sectors at most */
+
+#ifndef CONFIG_USBHOST_MSC_MAXSECTORS
+#  define CONFIG_USBHOST_MSC_MAXSECTORS 65535
+#endif
+
+#ifndef CONFIG_USBHOST_MSC_IOALIGN
+#  define CONFIG_USBHOST_MSC_IOALIGN 0
+#endif
+
+#if CONFIG_USBHOST_MSC_IOALIGN > 1
+#  define USBHOST_IOMASK   (CONFIG_USBHOST_MSC_IOALIGN - 1)
+#  define USBHOST_IOBUFFER 1
+#  if (CONFIG_USBHOST_MSC_IOALIGN & USBHOST_IOMASK) != 0
+#    error "CONFIG_USBHOST_MSC_IOALIGN must be a power of two"
+#  endif
+#endif
+
 /* Driver support ***********************************************************/
 
 /* This format is used to construct the /dev/sd[n] device driver path.  It
@@ -124,6 +142,9 @@ struct usbhost_state_s
   size_t                  tbuflen;      /* Size of the allocated transfer buffer */
   usbhost_ep_t            bulkin;       /* Bulk IN endpoint */
   usbhost_ep_t            bulkout;      /* Bulk OUT endpoint */
+#ifdef USBHOST_IOBUFFER
+  FAR uint8_t            *iobuffer;     /* For the unaligned user buffers */
+#endif
 };
 
 /* This is how struct usbhost_state_s looks to the free list logic */
@@ -215,6 +236,15 @@ static inline int usbhost_tfree(FAR struct usbhost_state_s *priv);
 static FAR struct usbmsc_cbw_s *
        usbhost_cbwalloc(FAR struct usbhost_state_s *priv);
 
+/* Sector transfers */
+
+static ssize_t usbhost_rwcmd(FAR struct usbhost_state_s *priv,
+                             FAR uint8_t *buffer, blkcnt_t startsector,
+                             unsigned int nsectors, bool write);
+static ssize_t usbhost_rwsectors(FAR struct usbhost_state_s *priv,
+                                 FAR uint8_t *buffer, blkcnt_t startsector,
+                                 unsigned int nsectors, bool write);
+
 /* struct usbhost_registry_s methods */
 
 static struct usbhost_class_s *
@@ -1617,6 +1647,19 @@ static inline int usbhost_talloc(FAR struct usbhost_state_s *priv)
               priv->tbuffer == NULL);
   hport = priv->usbclass.hport;
 
+#ifdef USBHOST_IOBUFFER
+  /* The I/O buffer is optional: Without it, the unaligned buffers are
+   * transferred directly as well.
+   */
+
+  if (DRVR_IOALLOC(hport->drvr, &priv->iobuffer,
+                   CONFIG_USBHOST_MSC_IOBUFSIZE) < 0)
+    {
+      uwarn("WARNING: Failed to allocate the I/O buffer\n");
+      priv->iobuffer = NULL;
+    }
+#endif
+
   return DRVR_ALLOC(hport->drvr, &priv->tbuffer, &priv->tbuflen);
 }
 
@@ -1642,6 +1685,15 @@ static inline int usbhost_tfree(FAR struct usbhost_state_s *priv)
 
   DEBUGASSERT(priv != NULL && priv->usbclass.hport != NULL);
 
+#ifdef USBHOST_IOBUFFER
+  if (priv->iobuffer)
+    {
+      hport          = priv->usbclass.hport;
+      DRVR_IOFREE(hport->drvr, priv->iobuffer);
+      priv->iobuffer = NULL;
+    }
+#endif
+
   if (priv->tbuffer)
     {
       hport         = priv->usbclass.hport;
@@ -1684,6 +1736,162 @@ static FAR struct usbmsc_cbw_s *
   return cbw;
 }
 
+/****************************************************************************
+ * Name: usbhost_rwcmd
+ *
+ * Description:
+ *   Run one READ(10) or WRITE(10) command: Send the CBW, transfer the
+ *   sectors and receive the CSW.  The command is sent again if it is NAKed.
+ *
+ * Input Parameters:
+ *   priv        - A reference to the class instance.
+ *   buffer      - The data of the sectors, transferred directly
+ *   startsector - The first sector
+ *   nsectors    - The number of sectors, CONFIG_USBHOST_MSC_MAXSECTORS at
+ *                 most
+ *   write       - True for a WRITE(10) command
+ *
+ * Returned Value:
+ *   Zero or positive on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_rwcmd(FAR struct usbhost_state_s *priv,
+                             FAR uint8_t *buffer, blkcnt_t startsector,
+                             unsigned int nsectors, bool write)
+{
+  FAR struct usbhost_hubport_s *hport = priv->usbclass.hport;
+  FAR struct usbmsc_cbw_s *cbw;
+  FAR struct usbmsc_csw_s *csw;
+  ssize_t nbytes;
+
+  /* Loop in the event that EAGAIN is returned (mean that the transaction
+   * was NAKed and we should try again.
+   */
+
+  do
+    {
+      /* Construct and send the CBW (re-using the transfer buffer) */
+
+      cbw = usbhost_cbwalloc(priv);
+      if (write)
+        {
+          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
+        }
+      else
+        {
+          usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
+        }
+
+      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                             (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
+      if (nbytes < 0)
+        {
+          continue;
+        }
+
+      /* Transfer the user data */
+
+      nbytes = DRVR_TRANSFER(hport->drvr,
+                             write ? priv->bulkout : priv->bulkin,
+                             buffer, priv->blocksize * nsectors);
+      if (nbytes < 0)
+        {
+          continue;
+        }
+
+      /* Receive the CSW and check its status */
+
+      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                             priv->tbuffer, USBMSC_CSW_SIZEOF);
+      if (nbytes >= 0)
+        {
+          csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
+          if (csw->status != 0)
+            {
+              uerr("ERROR: CSW status error: %d\n", csw->status);
+              nbytes = -ENODEV;
+            }
+        }
+    }
+  while (nbytes == -EAGAIN);
+
+  return nbytes;
+}
+
+/****************************************************************************
+ * Name: usbhost_rwsectors
+ *
+ * Description:
+ *   Read or write sectors with as few commands as possible.  The buffers
+ *   are transferred directly when the host controller allows it, and
+ *   through the I/O buffer otherwise.
+ *
+ * Returned Value:
+ *   The number of sectors transferred on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_rwsectors(FAR struct usbhost_state_s *priv,
+                                 FAR uint8_t *buffer, blkcnt_t startsector,
+                                 unsigned int nsectors, bool write)
+{
+  unsigned int remaining = nsectors;
+  unsigned int nxfer;
+  FAR uint8_t *iobuffer;
+  size_t nbytes;
+  ssize_t ret;
+
+  while (remaining > 0)
+    {
+      nxfer    = remaining;
+      iobuffer = buffer;
+
+      if (nxfer > CONFIG_USBHOST_MSC_MAXSECTORS)
+        {
+          nxfer = CONFIG_USBHOST_MSC_MAXSECTORS;
+        }
+
+#ifdef USBHOST_IOBUFFER
+      if (priv->iobuffer != NULL &&
+          ((uintptr_t)buffer & USBHOST_IOMASK) != 0 &&
+          CONFIG_USBHOST_MSC_IOBUFSIZE >= priv->blocksize)
+        {
+          if (nxfer > CONFIG_USBHOST_MSC_IOBUFSIZE / priv->blocksize)
+            {
+              nxfer = CONFIG_USBHOST_MSC_IOBUFSIZE / priv->blocksize;
+            }
+
+          iobuffer = priv->iobuffer;
+        }
+#endif
+
+      nbytes = (size_t)nxfer * priv->blocksize;
+      if (write && iobuffer != buffer)
+        {
+          memcpy(iobuffer, buffer, nbytes);
+        }
+
+      ret = usbhost_rwcmd(priv, iobuffer, startsector, nxfer, write);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (!write && iobuffer != buffer)
+        {
+          memcpy(buffer, iobuffer, nbytes);
+        }
+
+      buffer      += nbytes;
+      startsector += nxfer;
+      remaining   -= nxfer;
+    }
+
+  return nsectors;
+}
+
 /****************************************************************************
  * Name: usbhost_create
  *
@@ -2028,15 +2236,12 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
                             blkcnt_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
   ssize_t nbytes = 0;
   int ret;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
 
   uinfo("startsector: %" PRIuOFF " nsectors: %u "
         "sectorsize: %" PRIu16 "\n", startsector, nsectors, priv->blocksize);
@@ -2054,71 +2259,14 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
     }
   else if (nsectors > 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
       ret = usbhost_takesem(&priv->exclsem);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
-        {
-          /* Loop in the event that EAGAIN is returned (mean that the
-           * transaction was NAKed and we should try again.
-           */
-
-          do
-            {
-              /* Assume some device failure */
-
-              nbytes = -ENODEV;
-
-              /* Construct and send the CBW */
-
-              usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-              if (nbytes >= 0)
-                {
-                  /* Receive the user data */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         buffer, priv->blocksize * nsectors);
-                  if (nbytes >= 0)
-                    {
-                      /* Receive the CSW */
-
-                      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                             priv->tbuffer,
-                                             USBMSC_CSW_SIZEOF);
-                      if (nbytes >= 0)
-                        {
-                          FAR struct usbmsc_csw_s *csw;
-
-                          /* Check the CSW status */
-
-                          csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                          if (csw->status != 0)
-                            {
-                              uerr("ERROR: CSW status error: %d\n",
-                                   csw->status);
-                              nbytes = -ENODEV;
-                            }
-                        }
-                    }
-                }
-            }
-          while (nbytes == -EAGAIN);
-        }
-
+      nbytes = usbhost_rwsectors(priv, buffer, startsector, nsectors,
+                                 false);
       usbhost_givesem(&priv->exclsem);
     }
 
@@ -2141,17 +2289,14 @@ static ssize_t usbhost_write(FAR struct inode *inode,
                              blkcnt_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes;
+  ssize_t nbytes = 0;
   int ret;
 
   uinfo("sector: %" PRIuOFF " nsectors: %u\n", startsector, nsectors);
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
 
   /* Check if the mass storage device is still connected */
 
@@ -2164,64 +2309,18 @@ static ssize_t usbhost_write(FAR struct inode *inode,
 
       nbytes = -ENODEV;
     }
-  else
+  else if (nsectors > 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
       ret = usbhost_takesem(&priv->exclsem);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
-        {
-          /* Assume some device failure */
-
-          nbytes = -ENODEV;
-
-          /* Construct and send the CBW */
-
-          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
-          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-          if (nbytes >= 0)
-            {
-              /* Send the user data */
-
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)buffer,
-                                     priv->blocksize * nsectors);
-              if (nbytes >= 0)
-                {
-                  /* Receive the CSW */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
-                  if (nbytes >= 0)
-                    {
-                      FAR struct usbmsc_csw_s *csw;
-
-                      /* Check the CSW status */
-
-                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                      if (csw->status != 0)
-                        {
-                          uerr("ERROR: CSW status error: %d\n", csw->status);
-                          nbytes = -ENODEV;
-                        }
-                    }
-                }
-            }
-        }
+      /* The data is only read, the cast is for the shared helper */
 
+      nbytes = usbhost_rwsectors(priv, (FAR uint8_t *)buffer, startsector,
+                                 nsectors, true);
       usbhost_givesem(&priv->exclsem);
     }
 
@@ -52,20 +52,36 @@
 #  define CONFIG_NET_USRSOCKDEV_NPOLLWAITERS 1
 #endif
 
+#ifndef CONFIG_NET_USRSOCKDEV_NREQUESTS
+#  define CONFIG_NET_USRSOCKDEV_NREQUESTS 4
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+struct usrsockdev_req_s
+{
+  FAR const struct iovec *iov;    /* Pending request buffers */
+  int                     iovcnt; /* Number of request buffers */
+  size_t                  pos;    /* Reader position on request buffer */
+};
+
+/* The pending requests are queued in a ring, in the order of their
+ * arrival.  The daemon reads them one after the other, and may read the
+ * next request before it has responded to the previous one.  A request
+ * leaves the queue once the daemon has acknowledged it, or has started
+ * reading the next one.
+ */
+
 struct usrsockdev_s
 {
-  sem_t   devsem; /* Lock for device node */
-  uint8_t ocount; /* The number of times the device has been opened */
-  struct
-  {
-    FAR const struct iovec *iov;    /* Pending request buffers */
-    int                     iovcnt; /* Number of request buffers */
-    size_t                  pos;    /* Reader position on request buffer */
-  } req;
+  sem_t   devsem;   /* Lock for device node */
+  sem_t   reqsem;   /* Counts the free request slots */
+  uint8_t ocount;   /* The number of times the device has been opened */
+  uint8_t reqhead;  /* Index of the request being read */
+  uint8_t reqcount; /* Number of queued requests */
+  struct usrsockdev_req_s req[CONFIG_NET_USRSOCKDEV_NREQUESTS];
   FAR struct pollfd *pollfds[CONFIG_NET_USRSOCKDEV_NPOLLWAITERS];
 };
 
@@ -111,7 +127,9 @@ static const struct file_operations g_usrsockdevops =
 
 static struct usrsockdev_s g_usrsockdev =
 {
-  NXSEM_INITIALIZER(1, PRIOINHERIT_FLAGS_DISABLE)
+  NXSEM_INITIALIZER(1, PRIOINHERIT_FLAGS_DISABLE),
+  NXSEM_INITIALIZER(CONFIG_NET_USRSOCKDEV_NREQUESTS,
+                    PRIOINHERIT_FLAGS_DISABLE)
 };
 
 /****************************************************************************
@@ -175,6 +193,60 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev,
     }
 }
 
+/****************************************************************************
+ * Name: usrsockdev_head
+ *
+ * Description:
+ *   Return the request being read by the daemon, NULL if none is queued.
+ *
+ ****************************************************************************/
+
+static FAR struct usrsockdev_req_s *
+usrsockdev_head(FAR struct usrsockdev_s *dev)
+{
+  return dev->reqcount > 0 ? &dev->req[dev->reqhead] : NULL;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_dequeue
+ *
+ * Description:
+ *   Remove the request being read from the queue and free its slot.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_dequeue(FAR struct usrsockdev_s *dev)
+{
+  FAR struct usrsockdev_req_s *req = &dev->req[dev->reqhead];
+
+  DEBUGASSERT(dev->reqcount > 0);
+
+  req->iov = NULL;
+  req->iovcnt = 0;
+  req->pos = 0;
+
+  if (++dev->reqhead >= CONFIG_NET_USRSOCKDEV_NREQUESTS)
+    {
+      dev->reqhead = 0;
+    }
+
+  dev->reqcount--;
+  nxsem_post(&dev->reqsem);
+}
+
+/****************************************************************************
+ * Name: usrsockdev_remaining
+ *
+ * Description:
+ *   Return true if the request has not been read completely.
+ *
+ ****************************************************************************/
+
+static bool usrsockdev_remaining(FAR struct usrsockdev_req_s *req)
+{
+  return usrsock_iovec_get(NULL, 0, req->iov, req->iovcnt, req->pos) >= 0;
+}
+
 /****************************************************************************
  * Name: usrsockdev_read
  ****************************************************************************/
@@ -183,6 +255,7 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
                                size_t len)
 {
   FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_req_s *req;
   FAR struct usrsockdev_s *dev;
   int ret;
 
@@ -208,16 +281,27 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
       return ret;
     }
 
+  /* Move to the next request once the current one has been read.  One
+   * read never returns more than one request.
+   */
+
+  req = usrsockdev_head(dev);
+  if (req && dev->reqcount > 1 && !usrsockdev_remaining(req))
+    {
+      usrsockdev_dequeue(dev);
+      req = usrsockdev_head(dev);
+    }
+
   /* Is request available? */
 
-  if (dev->req.iov)
+  if (req)
     {
       ssize_t rlen;
 
       /* Copy request to user-space. */
 
-      rlen = usrsock_iovec_get(buffer, len, dev->req.iov, dev->req.iovcnt,
-                               dev->req.pos);
+      rlen = usrsock_iovec_get(buffer, len, req->iov, req->iovcnt,
+                               req->pos);
       if (rlen < 0)
         {
           /* Tried reading beyond buffer. */
@@ -226,7 +310,7 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          dev->req.pos += rlen;
+          req->pos += rlen;
           len = rlen;
         }
     }
@@ -247,6 +331,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
                              int whence)
 {
   FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_req_s *req;
   FAR struct usrsockdev_s *dev;
   off_t pos;
   int ret;
@@ -268,15 +353,18 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
       return ret;
     }
 
-  /* Is request available? */
+  /* Is request available?  Seeking is relative to the request being
+   * read.
+   */
 
-  if (dev->req.iov)
+  req = usrsockdev_head(dev);
+  if (req)
     {
       ssize_t rlen;
 
       if (whence == SEEK_CUR)
         {
-          pos = dev->req.pos + offset;
+          pos = req->pos + offset;
         }
       else
         {
@@ -285,8 +373,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
 
       /* Copy request to user-space. */
 
-      rlen = usrsock_iovec_get(NULL, 0, dev->req.iov, dev->req.iovcnt,
-                               pos);
+      rlen = usrsock_iovec_get(NULL, 0, req->iov, req->iovcnt, pos);
       if (rlen < 0)
         {
           /* Tried seek beyond buffer. */
@@ -295,7 +382,7 @@ static off_t usrsockdev_seek(FAR struct file *filep, off_t offset,
         }
       else
         {
-          dev->req.pos = pos;
+          req->pos = pos;
         }
     }
   else
@@ -315,8 +402,10 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
                                 FAR const char *buffer, size_t len)
 {
   FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_req_s *req;
   FAR struct usrsockdev_s *dev;
-  bool req_done = false;
+  size_t nwritten = 0;
+  uint32_t ackxid;
   ssize_t ret = 0;
 
   if (len == 0)
@@ -341,16 +430,37 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
       return ret;
     }
 
-  ret = usrsock_response(buffer, len, &req_done);
-  if (req_done && dev->req.iov)
+  /* The daemon may write several responses and events at once. */
+
+  while (nwritten < len)
     {
-      dev->req.iov = NULL;
-      dev->req.pos = 0;
-      dev->req.iovcnt = 0;
+      ackxid = 0;
+      ret = usrsock_response(buffer + nwritten, len - nwritten, &ackxid);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      nwritten += ret;
+
+      /* The daemon acknowledged the request being read:  Release it, its
+       * buffers are no longer valid.
+       */
+
+      req = usrsockdev_head(dev);
+      if (ackxid != 0 && req &&
+          ((FAR const struct usrsock_request_common_s *)
+           req->iov[0].iov_base)->xid == ackxid)
+        {
+          usrsockdev_dequeue(dev);
+        }
     }
 
   usrsockdev_semgive(&dev->devsem);
-  return ret;
+
+  /* Report an error only if no message was handled. */
+
+  return nwritten > 0 ? (ssize_t)nwritten : ret;
 }
 
 /****************************************************************************
@@ -428,9 +538,11 @@ static int usrsockdev_close(FAR struct file *filep)
   dev->ocount--;
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
-  dev->req.iov = NULL;
-  dev->req.iovcnt = 0;
-  dev->req.pos = 0;
+
+  while (dev->reqcount > 0)
+    {
+      usrsockdev_dequeue(dev);
+    }
 
   usrsockdev_semgive(&dev->devsem);
   usrsock_abort();
@@ -505,9 +617,8 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       /* Notify the POLLIN event if pending request. */
 
-      if (dev->req.iov != NULL &&
-          !(usrsock_iovec_get(NULL, 0, dev->req.iov,
-                              dev->req.iovcnt, dev->req.pos) < 0))
+      if (dev->reqcount > 1 ||
+          (dev->reqcount > 0 && usrsockdev_remaining(usrsockdev_head(dev))))
         {
           eventset |= POLLIN;
         }
@@ -551,18 +662,26 @@ errout:
 int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
 {
   FAR struct usrsockdev_s *dev = &g_usrsockdev;
+  FAR struct usrsockdev_req_s *req;
   int ret = 0;
 
-  /* Set outstanding request for daemon to handle. */
+  /* Wait for a free request slot, then queue the request for daemon to
+   * handle.
+   */
 
+  net_lockedwait_uninterruptible(&dev->reqsem);
   net_lockedwait_uninterruptible(&dev->devsem);
 
   if (usrsockdev_is_opened(dev))
     {
-      DEBUGASSERT(dev->req.iov == NULL);
-      dev->req.iov = iov;
-      dev->req.pos = 0;
-      dev->req.iovcnt = iovcnt;
+      DEBUGASSERT(dev->reqcount < CONFIG_NET_USRSOCKDEV_NREQUESTS);
+
+      req = &dev->req[(dev->reqhead + dev->reqcount) %
+                      CONFIG_NET_USRSOCKDEV_NREQUESTS];
+      req->iov = iov;
+      req->pos = 0;
+      req->iovcnt = iovcnt;
+      dev->reqcount++;
 
       /* Notify daemon of new request. */
 
@@ -571,6 +690,7 @@ int usrsock_request(FAR struct iovec *iov, unsigned int iovcnt)
   else
     {
       ninfo("daemon abruptly closed /dev/usrsock.\n");
+      nxsem_post(&dev->reqsem);
       ret = -ENETDOWN;
     }
 
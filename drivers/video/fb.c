@@ -33,20 +33,46 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/video/fb.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The buffers whose age is tracked: the ones queued plus the front one */
+
+#ifdef CONFIG_FB_PANQUEUE
+#  define FB_NPANBUFFERS (CONFIG_FB_PANQUEUE_DEPTH + 1)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_FB_PANQUEUE
+/* The last submission of a buffer, for its age */
+
+struct fb_panbuf_s
+{
+  uint32_t xoffset;
+  uint32_t yoffset;
+  uint32_t seq;                   /* Number of its last pan request */
+};
+#endif
+
 /* This structure defines one framebuffer device.  Note that which is
  * everything in this structure is constant data set up and initialization
  * time.  Therefore, no there is requirement for serialized access to this
- * structure.
+ * structure.  The exception is the pan queue, which is protected by a
+ * critical section since fb_pandisplay_done() runs from interrupt handlers.
  */
 
 struct fb_chardev_s
@@ -56,6 +82,21 @@ struct fb_chardev_s
   size_t fblen;                   /* Size of the framebuffer */
   uint8_t plane;                  /* Video plan number */
   uint8_t bpp;                    /* Bits per pixel */
+
+#ifdef CONFIG_FB_PANQUEUE
+  /* The pan requests not displayed yet.  The one at head is with the
+   * driver.
+   */
+
+  struct fb_planeinfo_s panq[CONFIG_FB_PANQUEUE_DEPTH];
+  uint8_t panhead;                /* Index of the oldest request */
+  uint8_t pancount;               /* Number of requests queued */
+  uint32_t submitted;             /* Number of the pan requests submitted */
+  uint32_t displayed;             /* Number of the pan requests displayed */
+  struct fb_panbuf_s panbufs[FB_NPANBUFFERS];
+  sem_t pansem;                   /* Waits for room in the queue */
+  FAR struct pollfd *fds[CONFIG_FB_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -68,6 +109,10 @@ static ssize_t fb_write(FAR struct file *filep, FAR const char *buffer,
                         size_t buflen);
 static off_t   fb_seek(FAR struct file *filep, off_t offset, int whence);
 static int     fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+#ifdef CONFIG_FB_PANQUEUE
+static int     fb_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                       bool setup);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -81,7 +126,11 @@ static const struct file_operations fb_fops =
   fb_write,      /* write */
   fb_seek,       /* seek */
   fb_ioctl,      /* ioctl */
+#ifdef CONFIG_FB_PANQUEUE
+  fb_poll        /* poll */
+#else
   NULL           /* poll */
+#endif
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL         /* unlink */
 #endif
@@ -91,6 +140,196 @@ static const struct file_operations fb_fops =
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_FB_PANQUEUE
+/****************************************************************************
+ * Name: fb_pollnotify
+ *
+ * Description:
+ *   Notify the pollers that there is room in the pan queue.  Called in a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void fb_pollnotify(FAR struct fb_chardev_s *fb)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < CONFIG_FB_NPOLLWAITERS; i++)
+    {
+      fds = fb->fds[i];
+      if (fds != NULL && (fds->events & POLLOUT) != 0)
+        {
+          fds->revents |= POLLOUT;
+          poll_notify(fds);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fb_pansubmit
+ *
+ * Description:
+ *   Queue a pan request and pass it to the driver if the driver is idle.
+ *   Wait for room in the queue unless the file is non-blocking.
+ *
+ ****************************************************************************/
+
+static int fb_pansubmit(FAR struct fb_chardev_s *fb, int oflags,
+                        FAR const struct fb_planeinfo_s *pinfo)
+{
+  FAR struct fb_panbuf_s *buf;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  flags = enter_critical_section();
+
+  while (fb->pancount >= CONFIG_FB_PANQUEUE_DEPTH)
+    {
+      if ((oflags & O_NONBLOCK) != 0)
+        {
+          ret = -EAGAIN;
+          goto out;
+        }
+
+      ret = nxsem_wait(&fb->pansem);
+      if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  i = (fb->panhead + fb->pancount) % CONFIG_FB_PANQUEUE_DEPTH;
+  fb->panq[i] = *pinfo;
+  fb->submitted++;
+
+  if (fb->pancount++ == 0)
+    {
+      ret = fb->vtable->pandisplay(fb->vtable,
+                                   &fb->panq[fb->panhead]);
+      if (ret < 0)
+        {
+          fb->pancount--;
+          fb->submitted--;
+          goto out;
+        }
+    }
+
+  /* Remember the submission of the buffer, replacing the buffer submitted
+   * the longest time ago.
+   */
+
+  buf = &fb->panbufs[0];
+  for (i = 0; i < FB_NPANBUFFERS; i++)
+    {
+      if (fb->panbufs[i].xoffset == pinfo->xoffset &&
+          fb->panbufs[i].yoffset == pinfo->yoffset)
+        {
+          buf = &fb->panbufs[i];
+          break;
+        }
+
+      if ((int32_t)(fb->panbufs[i].seq - buf->seq) < 0)
+        {
+          buf = &fb->panbufs[i];
+        }
+    }
+
+  buf->xoffset = pinfo->xoffset;
+  buf->yoffset = pinfo->yoffset;
+  buf->seq     = fb->submitted;
+
+out:
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: fb_panstatus
+ ****************************************************************************/
+
+static void fb_panstatus(FAR struct fb_chardev_s *fb,
+                         FAR struct fb_panstatus_s *status)
+{
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+
+  status->submitted = fb->submitted;
+  status->displayed = fb->displayed;
+  status->age       = 0;
+
+  for (i = 0; i < FB_NPANBUFFERS; i++)
+    {
+      if (fb->panbufs[i].seq != 0 &&
+          fb->panbufs[i].xoffset == status->xoffset &&
+          fb->panbufs[i].yoffset == status->yoffset)
+        {
+          status->age = fb->submitted - fb->panbufs[i].seq + 1;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: fb_poll
+ *
+ * Description:
+ *   POLLOUT is set while a pan request can be queued without waiting,
+ *   meaning that the buffer displayed before the last request completes
+ *   is released.
+ *
+ ****************************************************************************/
+
+static int fb_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                   bool setup)
+{
+  FAR struct fb_chardev_s *fb;
+  irqstate_t flags;
+  int ret = OK;
+  int i;
+
+  DEBUGASSERT(filep != NULL && filep->f_inode != NULL);
+  fb = (FAR struct fb_chardev_s *)filep->f_inode->i_private;
+
+  flags = enter_critical_section();
+
+  if (setup)
+    {
+      for (i = 0; i < CONFIG_FB_NPOLLWAITERS; i++)
+        {
+          if (fb->fds[i] == NULL)
+            {
+              fb->fds[i] = fds;
+              fds->priv  = &fb->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_FB_NPOLLWAITERS)
+        {
+          ret = -EBUSY;
+        }
+      else if (fb->pancount < CONFIG_FB_PANQUEUE_DEPTH)
+        {
+          fb_pollnotify(fb);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      *(FAR struct pollfd **)fds->priv = NULL;
+      fds->priv = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: fb_read
  ****************************************************************************/
@@ -531,10 +770,27 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           DEBUGASSERT(pinfo != NULL && fb->vtable != NULL &&
                       fb->vtable->pandisplay != NULL);
+#ifdef CONFIG_FB_PANQUEUE
+          ret = fb_pansubmit(fb, filep->f_oflags, pinfo);
+#else
           ret = fb->vtable->pandisplay(fb->vtable, pinfo);
+#endif
         }
         break;
 
+#ifdef CONFIG_FB_PANQUEUE
+      case FBIOGET_PANSTATUS:
+        {
+          FAR struct fb_panstatus_s *status =
+            (FAR struct fb_panstatus_s *)((uintptr_t)arg);
+
+          DEBUGASSERT(status != NULL);
+          fb_panstatus(fb, status);
+          ret = OK;
+        }
+        break;
+#endif
+
       default:
         gerr("ERROR: Unsupported IOCTL command: %d\n", cmd);
         ret = -ENOTTY;
@@ -636,6 +892,12 @@ int fb_register(int display, int plane)
   fb->fblen  = pinfo.fblen;
   fb->bpp    = pinfo.bpp;
 
+#ifdef CONFIG_FB_PANQUEUE
+  fb->vtable->priv = fb;
+  nxsem_init(&fb->pansem, 0, 0);
+  nxsem_set_protocol(&fb->pansem, SEM_PRIO_NONE);
+#endif
+
   /* Clear the framebuffer memory */
 
   memset(pinfo.fbmem, 0, pinfo.fblen);
@@ -673,6 +935,10 @@ int fb_register(int display, int plane)
   if (ret < 0)
     {
       gerr("ERROR: register_driver() failed: %d\n", ret);
+#ifdef CONFIG_FB_PANQUEUE
+      fb->vtable->priv = NULL;
+      nxsem_destroy(&fb->pansem);
+#endif
       goto errout_with_fb;
     }
 
@@ -682,3 +948,66 @@ errout_with_fb:
   kmm_free(fb);
   return ret;
 }
+
+/****************************************************************************
+ * Name: fb_pandisplay_done
+ *
+ * Description:
+ *   Called by the framebuffer driver, typically from its vertical sync
+ *   interrupt handler, when the buffer of the last pandisplay() request is
+ *   scanned out.  The next queued request, if any, is passed to
+ *   pandisplay() and the pollers waiting for room in the queue are
+ *   notified.
+ *
+ * Input Parameters:
+ *   vtable - The framebuffer registered with fb_register()
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANQUEUE
+void fb_pandisplay_done(FAR struct fb_vtable_s *vtable)
+{
+  FAR struct fb_chardev_s *fb;
+  irqstate_t flags;
+  int semcount;
+  int ret;
+
+  DEBUGASSERT(vtable != NULL && vtable->priv != NULL);
+  fb = vtable->priv;
+
+  flags = enter_critical_section();
+
+  if (fb->pancount == 0)
+    {
+      leave_critical_section(flags);
+      return;
+    }
+
+  /* Retire the request displayed, start the next ones.  A request that
+   * the driver refuses is dropped as displayed.
+   */
+
+  do
+    {
+      fb->panhead = (fb->panhead + 1) % CONFIG_FB_PANQUEUE_DEPTH;
+      fb->pancount--;
+      fb->displayed++;
+
+      ret = fb->pancount > 0 ?
+            vtable->pandisplay(vtable, &fb->panq[fb->panhead]) : OK;
+    }
+  while (ret < 0);
+
+  nxsem_get_value(&fb->pansem, &semcount);
+  if (semcount < 0)
+    {
+      nxsem_post(&fb->pansem);
+    }
+
+  fb_pollnotify(fb);
+  leave_critical_section(flags);
+}
+#endif
@@ -0,0 +1,508 @@
+/****************************************************************************
+ * drivers/video/vnc/vnc_hextile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  undef  CONFIG_DEBUG_GRAPHICS_ERROR
+#  undef  CONFIG_DEBUG_GRAPHICS_WARN
+#  undef  CONFIG_DEBUG_GRAPHICS_INFO
+#  define CONFIG_DEBUG_ERROR          1
+#  define CONFIG_DEBUG_WARN           1
+#  define CONFIG_DEBUG_INFO           1
+#  define CONFIG_DEBUG_GRAPHICS       1
+#  define CONFIG_DEBUG_GRAPHICS_ERROR 1
+#  define CONFIG_DEBUG_GRAPHICS_WARN  1
+#  define CONFIG_DEBUG_GRAPHICS_INFO  1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the FramebufferUpdate header of a single rectangle */
+
+#define HEXTILE_HDRSIZE \
+  SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of the encoding of one rectangle */
+
+struct vnc_hextile_s
+{
+  FAR struct vnc_session_s *session;
+  union
+  {
+    vnc_convert8_t bpp8;
+    vnc_convert16_t bpp16;
+    vnc_convert32_t bpp32;
+  } convert;
+
+  unsigned int bytesperpixel;  /* Remote bytes per pixel */
+  bool bigendian;              /* Remote byte order */
+  bool bgvalid;                /* The client has the background of bg */
+  lfb_color_t bg;              /* The background of the previous tile */
+  size_t size;                 /* Number of bytes in outbuf */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile_pixel
+ *
+ * Description:
+ *   Convert a local pixel and write it in the remote format.
+ *
+ * Returned Value:
+ *   The address following the pixel.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_hextile_pixel(FAR struct vnc_hextile_s *enc,
+                                      FAR uint8_t *dest, lfb_color_t color)
+{
+  if (enc->bytesperpixel == 1)
+    {
+      *dest = enc->convert.bpp8(color);
+    }
+  else if (enc->bytesperpixel == 2)
+    {
+      if (enc->bigendian)
+        {
+          rfb_putbe16(dest, enc->convert.bpp16(color));
+        }
+      else
+        {
+          rfb_putle16(dest, enc->convert.bpp16(color));
+        }
+    }
+  else /* bytesperpixel == 4 */
+    {
+      if (enc->bigendian)
+        {
+          rfb_putbe32(dest, enc->convert.bpp32(color));
+        }
+      else
+        {
+          rfb_putle32(dest, enc->convert.bpp32(color));
+        }
+    }
+
+  return dest + enc->bytesperpixel;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_flush
+ *
+ * Description:
+ *   Send the encoded data in outbuf to the client.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on a network failure.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_flush(FAR struct vnc_hextile_s *enc)
+{
+  FAR const uint8_t *src = enc->session->outbuf;
+  ssize_t nsent;
+
+  /* Send until all of the bytes are out.  This may loop for the case where
+   * TCP write buffering is enabled and there are a limited number of IOBs
+   * available.
+   */
+
+  while (enc->size > 0)
+    {
+      nsent = psock_send(&enc->session->connect, src, enc->size, 0);
+      if (nsent < 0)
+        {
+          gerr("ERROR: Send Hextile FrameBufferUpdate failed: %d\n",
+               (int)nsent);
+          return (int)nsent;
+        }
+
+      DEBUGASSERT(nsent <= enc->size);
+      src       += nsent;
+      enc->size -= nsent;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_tile
+ *
+ * Description:
+ *   Encode one tile at the end of outbuf.  The background is the most
+ *   frequent of the first two colors of the tile.  The pixels of the other
+ *   colors are covered with the rectangles found by growing each uncovered
+ *   pixel to the right, then down.  The tile is sent raw if the rectangles
+ *   would not be smaller.
+ *
+ * Input Parameters:
+ *   enc  - The state of the encoding
+ *   x, y - The position of the tile in the local framebuffer
+ *   w, h - The size of the tile, at most VNC_TILESIZE
+ *
+ ****************************************************************************/
+
+static void vnc_hextile_tile(FAR struct vnc_hextile_s *enc,
+                             fb_coord_t x, fb_coord_t y,
+                             fb_coord_t w, fb_coord_t h)
+{
+  FAR const lfb_color_t *src;
+  FAR uint8_t *start;
+  FAR uint8_t *limit;
+  FAR uint8_t *dest;
+  FAR uint8_t *nsubrects;
+  uint16_t covered[VNC_TILESIZE];
+  uint16_t mask;
+  lfb_color_t color;
+  lfb_color_t c0;
+  lfb_color_t c1 = 0;
+  lfb_color_t bg;
+  unsigned int n0 = 0;
+  unsigned int n1 = 0;
+  unsigned int ncolors = 1;
+  unsigned int nrects = 0;
+  uint8_t subenc = 0;
+  int col;
+  int row;
+  int x2;
+  int y2;
+  int i;
+
+#define HEXTILE_PIXEL(c,r) \
+  (*(FAR const lfb_color_t *)((FAR const uint8_t *)src + \
+                              (r) * RFB_STRIDE + (c) * RFB_BYTESPERPIXEL))
+
+  src   = (FAR const lfb_color_t *)
+          (enc->session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * x);
+  start = enc->session->outbuf + enc->size;
+
+  /* Count the first two colors and whether there are more */
+
+  c0 = HEXTILE_PIXEL(0, 0);
+  for (row = 0; row < h; row++)
+    {
+      for (col = 0; col < w; col++)
+        {
+          color = HEXTILE_PIXEL(col, row);
+          if (color == c0)
+            {
+              n0++;
+            }
+          else if (ncolors == 1)
+            {
+              c1      = color;
+              ncolors = 2;
+              n1++;
+            }
+          else if (color == c1)
+            {
+              n1++;
+            }
+          else
+            {
+              ncolors = 3;
+            }
+        }
+    }
+
+  bg   = n0 >= n1 ? c0 : c1;
+  dest = start + 1;
+
+  if (!enc->bgvalid || bg != enc->bg)
+    {
+      subenc |= RFB_SUBENCODING_BACK;
+      dest    = vnc_hextile_pixel(enc, dest, bg);
+    }
+
+  if (ncolors > 1)
+    {
+      /* A raw tile is this long */
+
+      limit   = start + 1 + w * h * enc->bytesperpixel;
+      subenc |= RFB_SUBENCODING_ANY;
+
+      if (ncolors == 2)
+        {
+          subenc |= RFB_SUBENCODING_FORE;
+          dest    = vnc_hextile_pixel(enc, dest, bg == c0 ? c1 : c0);
+        }
+      else
+        {
+          subenc |= RFB_SUBENCODING_COLORED;
+        }
+
+      nsubrects = dest++;
+      memset(covered, 0, sizeof(covered));
+
+      for (row = 0; row < h; row++)
+        {
+          for (col = 0; col < w; col++)
+            {
+              color = HEXTILE_PIXEL(col, row);
+              if ((covered[row] & (1 << col)) != 0 || color == bg)
+                {
+                  continue;
+                }
+
+              /* Grow the rectangle to the right, then down */
+
+              for (x2 = col + 1;
+                   x2 < w && (covered[row] & (1 << x2)) == 0 &&
+                   HEXTILE_PIXEL(x2, row) == color;
+                   x2++);
+
+              mask = (uint16_t)(((1 << x2) - 1) & ~((1 << col) - 1));
+
+              for (y2 = row + 1; y2 < h && (covered[y2] & mask) == 0;
+                   y2++)
+                {
+                  for (i = col; i < x2; i++)
+                    {
+                      if (HEXTILE_PIXEL(i, y2) != color)
+                        {
+                          break;
+                        }
+                    }
+
+                  if (i < x2)
+                    {
+                      break;
+                    }
+
+                  covered[y2] |= mask;
+                }
+
+              /* Give up if the rectangles are not smaller than the raw
+               * pixels.
+               */
+
+              if (nrects >= UINT8_MAX ||
+                  dest + 2 + (ncolors > 2 ? enc->bytesperpixel : 0) > limit)
+                {
+                  goto raw;
+                }
+
+              if (ncolors > 2)
+                {
+                  dest = vnc_hextile_pixel(enc, dest, color);
+                }
+
+              *dest++ = (uint8_t)((col << 4) | row);
+              *dest++ = (uint8_t)(((x2 - col - 1) << 4) | (y2 - row - 1));
+              nrects++;
+
+              col = x2 - 1;
+            }
+        }
+
+      *nsubrects = (uint8_t)nrects;
+    }
+
+  *start       = subenc;
+  enc->bg      = bg;
+  enc->bgvalid = true;
+  enc->size    = dest - enc->session->outbuf;
+  return;
+
+raw:
+
+  /* Send the pixels.  The client forgets the background */
+
+  *start = RFB_SUBENCODING_RAW;
+  dest   = start + 1;
+
+  for (row = 0; row < h; row++)
+    {
+      for (col = 0; col < w; col++)
+        {
+          dest = vnc_hextile_pixel(enc, dest, HEXTILE_PIXEL(col, row));
+        }
+    }
+
+  enc->bgvalid = false;
+  enc->size    = dest - enc->session->outbuf;
+
+#undef HEXTILE_PIXEL
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding, if the client
+ *  supports it and the update buffer can hold one tile.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if Hextile coding was not performed (but no error was
+ *   encountered).  Otherwise, the size of the framebuffer update message
+ *   is returned on success or a negated errno value is returned on failure.
+ *   A failure is only returned in cases of a network failure and
+ *   unexpected internal failures.
+ *
+ ****************************************************************************/
+
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct fb_area_s *rect)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+  struct vnc_hextile_s enc;
+  size_t maxtile;
+  size_t total = 0;
+  fb_coord_t x;
+  fb_coord_t y;
+  int ret;
+
+  /* Check if the client supports the Hextile encoding */
+
+  if (!session->hextile || rect->w == 0 || rect->h == 0)
+    {
+      return 0;
+    }
+
+  /* The pixel format of the client may change at any time, but the tiles
+   * of a rectangle must all use the same one.
+   */
+
+  enc.session       = session;
+  enc.bytesperpixel = (session->bpp + 7) >> 3;
+  enc.bigendian     = session->bigendian;
+  enc.bgvalid       = false;
+  enc.bg            = 0;
+
+  /* The largest tile is a raw one */
+
+  maxtile = 1 + VNC_TILESIZE * VNC_TILESIZE * enc.bytesperpixel;
+  if (maxtile > VNCSERVER_UPDATE_BUFSIZE)
+    {
+      return 0;
+    }
+
+  switch (session->colorfmt)
+    {
+      case FB_FMT_RGB8_222:
+        enc.convert.bpp8 = vnc_convert_rgb8_222;
+        break;
+
+      case FB_FMT_RGB8_332:
+        enc.convert.bpp8 = vnc_convert_rgb8_332;
+        break;
+
+      case FB_FMT_RGB16_555:
+        enc.convert.bpp16 = vnc_convert_rgb16_555;
+        break;
+
+      case FB_FMT_RGB16_565:
+        enc.convert.bpp16 = vnc_convert_rgb16_565;
+        break;
+
+      case FB_FMT_RGB32:
+        enc.convert.bpp32 = vnc_convert_rgb32_888;
+        break;
+
+      default:
+        gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+        return -EINVAL;
+    }
+
+  /* Format the FramebufferUpdate message with a single rectangle */
+
+  update = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+
+  update->msgtype = RFB_FBUPDATE_MSG;
+  update->padding = 0;
+  rfb_putbe16(update->nrect, 1);
+
+  rfb_putbe16(update->rect[0].xpos, rect->x);
+  rfb_putbe16(update->rect[0].ypos, rect->y);
+  rfb_putbe16(update->rect[0].width, rect->w);
+  rfb_putbe16(update->rect[0].height, rect->h);
+  rfb_putbe32(update->rect[0].encoding, RFB_ENCODING_HEXTILE);
+
+  enc.size = HEXTILE_HDRSIZE;
+
+  /* Then the tiles, from left to right and top to bottom, sending the
+   * buffer whenever it might not hold the next tile.
+   */
+
+  for (y = rect->y; y < rect->y + rect->h; y += VNC_TILESIZE)
+    {
+      for (x = rect->x; x < rect->x + rect->w; x += VNC_TILESIZE)
+        {
+          if (enc.size + maxtile > VNCSERVER_UPDATE_BUFSIZE)
+            {
+              total += enc.size;
+              ret    = vnc_hextile_flush(&enc);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
+
+          vnc_hextile_tile(&enc, x, y,
+                           MIN(VNC_TILESIZE, rect->x + rect->w - x),
+                           MIN(VNC_TILESIZE, rect->y + rect->h - y));
+        }
+    }
+
+  total += enc.size;
+  ret    = vnc_hextile_flush(&enc);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->x, rect->y, rect->w, rect->h);
+  return (int)total;
+}
@@ -134,6 +134,10 @@
 #  define CONFIG_VNCSERVER_UPDATE_BUFSIZE 4096
 #endif
 
+#ifndef CONFIG_VNCSERVER_UPDATE_INTERVAL
+#  define CONFIG_VNCSERVER_UPDATE_INTERVAL 0
+#endif
+
 #define VNCSERVER_UPDATE_BUFSIZE \
   (CONFIG_VNCSERVER_UPDATE_BUFSIZE + SIZEOF_RFB_FRAMEBUFFERUPDATE_S(0))
 
@@ -143,6 +147,14 @@
 #define RFB_STRIDE          (RFB_BYTESPERPIXEL * CONFIG_VNCSERVER_SCREENWIDTH)
 #define RFB_SIZE            (RFB_STRIDE * CONFIG_VNCSERVER_SCREENHEIGHT)
 
+/* The tiles of the Hextile encoding and of the change detection */
+
+#define VNC_TILESIZE        16
+#define VNC_NTILESX \
+  ((CONFIG_VNCSERVER_SCREENWIDTH + VNC_TILESIZE - 1) / VNC_TILESIZE)
+#define VNC_NTILESY \
+  ((CONFIG_VNCSERVER_SCREENHEIGHT + VNC_TILESIZE - 1) / VNC_TILESIZE)
+
 /* RFB Port Number */
 
 #define RFB_PORT_BASE       5900
@@ -216,6 +228,9 @@ struct vnc_session_s
   volatile uint8_t bpp;        /* Remote bits per pixel */
   volatile bool bigendian;     /* True: Remote expect data in big-endian format */
   volatile bool rre;           /* True: Remote supports RRE encoding */
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  volatile bool hextile;       /* True: Remote supports Hextile encoding */
+#endif
   FAR uint8_t *fb;             /* Allocated local frame buffer */
 
   /* VNC client input support */
@@ -247,6 +262,12 @@ struct vnc_session_s
   sem_t vsyncsem;
 #endif
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+  /* The hashes of the tiles as they were last sent to the client */
+
+  uint32_t tilehash[VNC_NTILESX * VNC_NTILESY];
+#endif
+
   /* I/O buffers for misc network send/receive */
 
   uint8_t inbuf[CONFIG_VNCSERVER_INBUFFER_SIZE];
@@ -473,6 +494,31 @@ int vnc_receiver(FAR struct vnc_session_s *session);
 
 int vnc_rre(FAR struct vnc_session_s *session, FAR struct fb_area_s *rect);
 
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding, if the client
+ *  supports it and the update buffer can hold one tile.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if Hextile coding was not performed (but no error was
+ *   encountered).  Otherwise, the size of the framebuffer update message
+ *   is returned on success or a negated errno value is returned on failure.
+ *   A failure is only returned in cases of a network failure and
+ *   unexpected internal failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct fb_area_s *rect);
+#endif
+
 /****************************************************************************
  * Name: vnc_raw
  *
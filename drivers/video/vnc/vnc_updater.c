@@ -31,6 +31,9 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/signal.h>
+
 #if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
 #  undef  CONFIG_DEBUG_ERROR
 #  undef  CONFIG_DEBUG_WARN
@@ -334,6 +337,205 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
   sched_unlock();
 }
 
+/****************************************************************************
+ * Name: vnc_send_rectangle
+ *
+ * Description:
+ *  Send the framebuffer update of one rectangle with the best encoding that
+ *  the client supports.
+ *
+ * Returned Value:
+ *   The size of the framebuffer update message on success; a negated errno
+ *   value on a network failure.
+ *
+ ****************************************************************************/
+
+static int vnc_send_rectangle(FAR struct vnc_session_s *session,
+                              FAR struct fb_area_s *rect)
+{
+  int ret;
+
+  /* Attempt to use RRE encoding, which is best for a single color */
+
+  ret = vnc_rre(session, rect);
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  if (ret == 0)
+    {
+      ret = vnc_hextile(session, rect);
+    }
+#endif
+
+  if (ret == 0)
+    {
+      /* Perform the framebuffer update using the default RAW encoding */
+
+      ret = vnc_raw(session, rect);
+    }
+
+  return ret;
+}
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+/****************************************************************************
+ * Name: vnc_tile_hash
+ *
+ * Description:
+ *  Return the FNV-1a hash of the pixels of a tile of the local framebuffer.
+ *  A hash is never zero, which is the hash of the tiles not sent yet.
+ *
+ ****************************************************************************/
+
+static uint32_t vnc_tile_hash(FAR struct vnc_session_s *session,
+                              fb_coord_t x, fb_coord_t y,
+                              fb_coord_t w, fb_coord_t h)
+{
+  FAR const uint8_t *src;
+  uint32_t hash = 2166136261u;
+  size_t nbytes = w * RFB_BYTESPERPIXEL;
+  size_t i;
+
+  src = session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * x;
+  for (; h > 0; h--, src += RFB_STRIDE)
+    {
+      for (i = 0; i < nbytes; i++)
+        {
+          hash = (hash ^ src[i]) * 16777619u;
+        }
+    }
+
+  return hash != 0 ? hash : 1;
+}
+
+/****************************************************************************
+ * Name: vnc_update_tiles
+ *
+ * Description:
+ *  Send the tiles of a rectangle whose content changed since they were last
+ *  sent.  The rectangle is extended to whole tiles.  The changed tiles of a
+ *  tile row are sent in runs, and the runs of the same columns in
+ *  consecutive rows are sent as one rectangle.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - The rectangle in the local framebuffer.
+ *   force   - Send the whole rectangle, but still update the hashes.
+ *
+ * Returned Value:
+ *   Zero or a positive value on success; a negated errno value on a network
+ *   failure.
+ *
+ ****************************************************************************/
+
+static int vnc_update_tiles(FAR struct vnc_session_s *session,
+                            FAR struct fb_area_s *rect, bool force)
+{
+  struct fb_area_s pending;
+  struct fb_area_s run;
+  FAR uint32_t *hashp;
+  uint32_t hash;
+  fb_coord_t x1;
+  fb_coord_t y1;
+  fb_coord_t x2;
+  fb_coord_t y2;
+  fb_coord_t x;
+  fb_coord_t y;
+  fb_coord_t w;
+  fb_coord_t h;
+  bool changed;
+  int ret;
+
+  /* The tile-aligned bounds of the rectangle, clipped to the screen */
+
+  x1 = rect->x - rect->x % VNC_TILESIZE;
+  y1 = rect->y - rect->y % VNC_TILESIZE;
+  x2 = MIN((rect->x + rect->w + VNC_TILESIZE - 1) /
+           VNC_TILESIZE * VNC_TILESIZE, CONFIG_VNCSERVER_SCREENWIDTH);
+  y2 = MIN((rect->y + rect->h + VNC_TILESIZE - 1) /
+           VNC_TILESIZE * VNC_TILESIZE, CONFIG_VNCSERVER_SCREENHEIGHT);
+
+  pending.w = 0;
+  pending.h = 0;
+
+  for (y = y1; y < y2; y += VNC_TILESIZE)
+    {
+      h     = MIN(VNC_TILESIZE, y2 - y);
+      run.w = 0;
+      hashp = &session->tilehash[(y / VNC_TILESIZE) * VNC_NTILESX +
+                                 x1 / VNC_TILESIZE];
+
+      /* One more step past the last tile ends the last run */
+
+      for (x = x1; x < x2 || run.w > 0; x += VNC_TILESIZE, hashp++)
+        {
+          /* Find the end of a run of changed tiles */
+
+          changed = false;
+          if (x < x2)
+            {
+              w    = MIN(VNC_TILESIZE, x2 - x);
+              hash = vnc_tile_hash(session, x, y, w, h);
+              if (hash != *hashp)
+                {
+                  *hashp  = hash;
+                  changed = true;
+                }
+            }
+
+          if (changed || (force && x < x2))
+            {
+              if (run.w == 0)
+                {
+                  run.x = x;
+                  run.y = y;
+                  run.h = h;
+                }
+
+              run.w = x + w - run.x;
+              continue;
+            }
+
+          if (run.w == 0)
+            {
+              continue;
+            }
+
+          /* Extend the pending rectangle with the run if they have the
+           * same columns, or send the pending rectangle.
+           */
+
+          if (pending.w == run.w && pending.x == run.x &&
+              pending.y + pending.h == run.y)
+            {
+              pending.h += run.h;
+            }
+          else
+            {
+              if (pending.w > 0)
+                {
+                  ret = vnc_send_rectangle(session, &pending);
+                  if (ret < 0)
+                    {
+                      return ret;
+                    }
+                }
+
+              pending = run;
+            }
+
+          run.w = 0;
+        }
+    }
+
+  if (pending.w > 0)
+    {
+      return vnc_send_rectangle(session, &pending);
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: vnc_updater
  *
@@ -353,6 +555,10 @@ static FAR void *vnc_updater(FAR void *arg)
 {
   FAR struct vnc_session_s *session = (FAR struct vnc_session_s *)arg;
   FAR struct vnc_fbupdate_s *srcrect;
+#if CONFIG_VNCSERVER_UPDATE_INTERVAL > 0
+  clock_t lastupd = 0;
+  clock_t elapsed;
+#endif
   int ret;
 #ifdef CONFIG_FB_SYNC
   int val;
@@ -388,20 +594,38 @@ static FAR void *vnc_updater(FAR void *arg)
               srcrect->rect.x, srcrect->rect.y,
               srcrect->rect.w, srcrect->rect.h);
 
-      /* Attempt to use RRE encoding */
+#if CONFIG_VNCSERVER_UPDATE_INTERVAL > 0
+      /* Wait for the rest of the update interval.  The updates queued
+       * meanwhile are merged by vnc_update_rectangle().
+       */
 
-      ret = vnc_rre(session, &srcrect->rect);
-      if (ret == 0)
+      elapsed = clock_systime_ticks() - lastupd;
+      if (elapsed < MSEC2TICK(CONFIG_VNCSERVER_UPDATE_INTERVAL))
         {
-          /* Perform the framebuffer update using the default RAW encoding */
-
-          ret = vnc_raw(session, &srcrect->rect);
+          nxsig_usleep(TICK2USEC(MSEC2TICK(CONFIG_VNCSERVER_UPDATE_INTERVAL)
+                                 - elapsed));
         }
+#endif
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+      ret = vnc_update_tiles(session, &srcrect->rect, srcrect->whupd);
+#else
+      ret = vnc_send_rectangle(session, &srcrect->rect);
+#endif
 
       /* Release the update structure */
 
       vnc_free_update(session, srcrect);
 
+#if CONFIG_VNCSERVER_UPDATE_INTERVAL > 0
+      /* The interval starts when all of the queued updates are sent */
+
+      if (sq_empty(&session->updqueue))
+        {
+          lastupd = clock_systime_ticks();
+        }
+#endif
+
 #ifdef CONFIG_FB_SYNC
       ret = nxsem_get_value(&session->vsyncsem, &val);
 
@@ -549,8 +773,12 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
                          FAR const struct fb_area_s *rect, bool change)
 {
   FAR struct vnc_fbupdate_s *update;
+  FAR struct vnc_fbupdate_s *curr;
   struct fb_area_s intersection;
+  fb_coord_t x2;
+  fb_coord_t y2;
   bool whupd;
+  int val;
 
   intersection.x = rect->x;
   intersection.y = rect->y;
@@ -611,7 +839,6 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
             {
               /* Yes.. Discard all of the previously queued updates */
 
-              FAR struct vnc_fbupdate_s *curr;
               FAR struct vnc_fbupdate_s *next;
 
               updinfo("New whole screen update...\n");
@@ -640,6 +867,51 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
                */
 
               session->change |= change;
+
+              /* Nothing to do if a queued update contains this one */
+
+              for (curr = (FAR struct vnc_fbupdate_s *)
+                          session->updqueue.head;
+                   curr != NULL; curr = curr->flink)
+                {
+                  if (intersection.x >= curr->rect.x &&
+                      intersection.y >= curr->rect.y &&
+                      intersection.x + intersection.w <=
+                      curr->rect.x + curr->rect.w &&
+                      intersection.y + intersection.h <=
+                      curr->rect.y + curr->rect.h)
+                    {
+                      sched_unlock();
+                      return OK;
+                    }
+                }
+
+              /* Rather than waiting for the updater to free an update
+               * structure, merge this update with the last queued one.
+               */
+
+              curr = (FAR struct vnc_fbupdate_s *)session->updqueue.tail;
+              if (curr != NULL &&
+                  nxsem_get_value(&session->freesem, &val) >= 0 &&
+                  val <= 0)
+                {
+                  x2 = MAX(intersection.x + intersection.w,
+                           curr->rect.x + curr->rect.w);
+                  y2 = MAX(intersection.y + intersection.h,
+                           curr->rect.y + curr->rect.h);
+
+                  curr->rect.x = MIN(intersection.x, curr->rect.x);
+                  curr->rect.y = MIN(intersection.y, curr->rect.y);
+                  curr->rect.w = x2 - curr->rect.x;
+                  curr->rect.h = y2 - curr->rect.y;
+
+                  updinfo("Merged {(%d, %d),(%d, %d)}\n",
+                          curr->rect.x, curr->rect.y,
+                          curr->rect.w, curr->rect.h);
+
+                  sched_unlock();
+                  return OK;
+                }
             }
 
           /* Allocate an update structure... waiting if necessary */
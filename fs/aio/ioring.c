@@ -0,0 +1,564 @@
+/****************************************************************************
+ * fs/aio/ioring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioring.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/mutex.h>
+#include <nuttx/net/net.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_FS_IORING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The kernel state of one opened I/O ring.  It is protected by
+ * g_ioring_lock.
+ */
+
+struct ioring_file_s
+{
+  dq_entry_t node;              /* Link in g_ioring_pending */
+  FAR struct ioring_s *ring;    /* The ring shared with the application */
+  FAR struct filelist *list;    /* File list of the owner of the ring */
+  unsigned int sq_head;         /* The next submission to take */
+  unsigned int inflight;        /* Requests taken but not yet completed */
+  unsigned int nwaiters;        /* Number of threads waiting on waitsem */
+  bool queued;                  /* true: In g_ioring_pending */
+  bool closing;                 /* true: The ring is being closed */
+  sem_t waitsem;                /* Posted when a request completes */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int ioring_open(FAR struct file *filep);
+static int ioring_close(FAR struct file *filep);
+static int ioring_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_ioring_fops =
+{
+  ioring_open,   /* open */
+  ioring_close,  /* close */
+  NULL,          /* read */
+  NULL,          /* write */
+  NULL,          /* seek */
+  ioring_ioctl,  /* ioctl */
+  NULL           /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL         /* unlink */
+#endif
+};
+
+/* The rings with submissions that the workers may take */
+
+static mutex_t g_ioring_lock = NXMUTEX_INITIALIZER;
+static dq_queue_t g_ioring_pending;
+static sem_t g_ioring_sem = SEM_INITIALIZER(0);
+static bool g_ioring_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_ready
+ *
+ * Description:
+ *   Return true if there is a submission to take and room for its
+ *   completion.
+ *
+ ****************************************************************************/
+
+static bool ioring_ready(FAR struct ioring_file_s *priv)
+{
+  FAR struct ioring_s *ring = priv->ring;
+
+  return ring != NULL && !priv->closing && ring->sq_tail != priv->sq_head &&
+         ring->cq_tail - ring->cq_head + priv->inflight < ring->entries;
+}
+
+/****************************************************************************
+ * Name: ioring_queue
+ *
+ * Description:
+ *   Hand the ring to the workers if there is work to take.  Otherwise tell
+ *   the application that new submissions need IORINGIOC_ENTER.
+ *
+ * Assumptions:
+ *   g_ioring_lock is held
+ *
+ ****************************************************************************/
+
+static void ioring_queue(FAR struct ioring_file_s *priv)
+{
+  FAR struct ioring_s *ring = priv->ring;
+
+  if (priv->queued || ring == NULL)
+    {
+      return;
+    }
+
+  if (!ioring_ready(priv))
+    {
+      /* Set the flag before looking again, so that a submission made
+       * while the flag was clear is not missed.
+       */
+
+      ring->flags |= IORING_NEED_ENTER;
+      SP_DMB();
+
+      if (!ioring_ready(priv))
+        {
+          return;
+        }
+    }
+
+  ring->flags &= ~IORING_NEED_ENTER;
+  priv->queued = true;
+  dq_addlast(&priv->node, &g_ioring_pending);
+  nxsem_post(&g_ioring_sem);
+}
+
+/****************************************************************************
+ * Name: ioring_wakeup
+ *
+ * Description:
+ *   Wake up all threads waiting for completions of the ring.
+ *
+ * Assumptions:
+ *   g_ioring_lock is held
+ *
+ ****************************************************************************/
+
+static void ioring_wakeup(FAR struct ioring_file_s *priv)
+{
+  while (priv->nwaiters > 0)
+    {
+      priv->nwaiters--;
+      nxsem_post(&priv->waitsem);
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_execute
+ *
+ * Description:
+ *   Perform one request on the behalf of the owner of the ring.
+ *
+ ****************************************************************************/
+
+static ssize_t ioring_execute(FAR struct ioring_file_s *priv,
+                              FAR const struct ioring_sqe_s *sqe)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  if (sqe->sqe_opcode == IORING_OP_NOP)
+    {
+      return OK;
+    }
+
+  ret = files_getfilep(priv->list, sqe->sqe_fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (sqe->sqe_opcode)
+    {
+      case IORING_OP_READ:
+        if (sqe->sqe_off < 0)
+          {
+            return file_read(filep, sqe->sqe_addr, sqe->sqe_len);
+          }
+
+        return file_pread(filep, sqe->sqe_addr, sqe->sqe_len,
+                          sqe->sqe_off);
+
+      case IORING_OP_WRITE:
+        if (sqe->sqe_off < 0)
+          {
+            return file_write(filep, sqe->sqe_addr, sqe->sqe_len);
+          }
+
+        return file_pwrite(filep, sqe->sqe_addr, sqe->sqe_len,
+                           sqe->sqe_off);
+
+      case IORING_OP_FSYNC:
+        return file_fsync(filep);
+
+#ifdef CONFIG_NET
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        {
+          FAR struct socket *psock = file_socket(filep);
+
+          if (psock == NULL)
+            {
+              return -ENOTSOCK;
+            }
+
+          if (sqe->sqe_opcode == IORING_OP_SEND)
+            {
+              return psock_send(psock, sqe->sqe_addr, sqe->sqe_len,
+                                sqe->sqe_flags);
+            }
+
+          return psock_recv(psock, sqe->sqe_addr, sqe->sqe_len,
+                            sqe->sqe_flags);
+        }
+#endif
+
+      default:
+        return -EINVAL;
+    }
+}
+
+/****************************************************************************
+ * Name: ioring_worker
+ *
+ * Description:
+ *   The body of an I/O worker.  Each worker takes one submission at a time
+ *   from the rings in g_ioring_pending.  A ring with more submissions is
+ *   queued again at once so that the other workers can help.
+ *
+ ****************************************************************************/
+
+static int ioring_worker(int argc, FAR char *argv[])
+{
+  FAR struct ioring_file_s *priv;
+  FAR struct ioring_cqe_s *cqe;
+  FAR struct ioring_s *ring;
+  struct ioring_sqe_s sqe;
+  ssize_t res;
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_ioring_sem);
+
+      nxmutex_lock(&g_ioring_lock);
+      priv = (FAR struct ioring_file_s *)dq_remfirst(&g_ioring_pending);
+      if (priv == NULL)
+        {
+          nxmutex_unlock(&g_ioring_lock);
+          continue;
+        }
+
+      priv->queued = false;
+      if (!ioring_ready(priv))
+        {
+          ioring_queue(priv);
+          nxmutex_unlock(&g_ioring_lock);
+          continue;
+        }
+
+      /* Take the next submission.  It is copied so that the application
+       * may reuse the entry at once.
+       */
+
+      ring = priv->ring;
+      sqe  = ring->sqes[priv->sq_head & (ring->entries - 1)];
+      ring->sq_head = ++priv->sq_head;
+      priv->inflight++;
+
+      ioring_queue(priv);
+      nxmutex_unlock(&g_ioring_lock);
+
+      res = ioring_execute(priv, &sqe);
+
+      /* Post the completion */
+
+      nxmutex_lock(&g_ioring_lock);
+      cqe = &ring->cqes[ring->cq_tail & (ring->entries - 1)];
+      cqe->cqe_userdata = sqe.sqe_userdata;
+      cqe->cqe_res      = res;
+      SP_DMB();
+      ring->cq_tail++;
+
+      priv->inflight--;
+      ioring_wakeup(priv);
+      ioring_queue(priv);
+      nxmutex_unlock(&g_ioring_lock);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_start
+ *
+ * Description:
+ *   Start the pool of I/O workers when the driver is first opened.
+ *
+ * Assumptions:
+ *   g_ioring_lock is held
+ *
+ ****************************************************************************/
+
+static int ioring_start(void)
+{
+  int ret;
+  int i;
+
+  if (g_ioring_started)
+    {
+      return OK;
+    }
+
+  for (i = 0; i < CONFIG_FS_IORING_NWORKERS; i++)
+    {
+      ret = kthread_create("ioring", CONFIG_FS_IORING_PRIORITY,
+                           CONFIG_FS_IORING_STACKSIZE, ioring_worker, NULL);
+      if (ret < 0)
+        {
+          ferr("ERROR: Failed to start I/O worker: %d\n", ret);
+          if (i == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+    }
+
+  g_ioring_started = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_open
+ ****************************************************************************/
+
+static int ioring_open(FAR struct file *filep)
+{
+  FAR struct ioring_file_s *priv;
+  int ret;
+
+  priv = kmm_zalloc(sizeof(struct ioring_file_s));
+  if (priv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  priv->list = nxsched_get_files();
+  if (priv->list == NULL)
+    {
+      kmm_free(priv);
+      return -EPERM;
+    }
+
+  ret = nxmutex_lock(&g_ioring_lock);
+  if (ret < 0)
+    {
+      kmm_free(priv);
+      return ret;
+    }
+
+  ret = ioring_start();
+  nxmutex_unlock(&g_ioring_lock);
+  if (ret < 0)
+    {
+      kmm_free(priv);
+      return ret;
+    }
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&priv->waitsem, 0, 0);
+  nxsem_set_protocol(&priv->waitsem, SEM_PRIO_NONE);
+
+  filep->f_priv = priv;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_close
+ ****************************************************************************/
+
+static int ioring_close(FAR struct file *filep)
+{
+  FAR struct ioring_file_s *priv = filep->f_priv;
+
+  DEBUGASSERT(priv != NULL);
+
+  /* Stop taking submissions and wait for the requests in progress */
+
+  nxmutex_lock(&g_ioring_lock);
+  priv->closing = true;
+  if (priv->queued)
+    {
+      dq_rem(&priv->node, &g_ioring_pending);
+      priv->queued = false;
+    }
+
+  while (priv->inflight > 0)
+    {
+      priv->nwaiters++;
+      nxmutex_unlock(&g_ioring_lock);
+      nxsem_wait_uninterruptible(&priv->waitsem);
+      nxmutex_lock(&g_ioring_lock);
+    }
+
+  nxmutex_unlock(&g_ioring_lock);
+
+  nxsem_destroy(&priv->waitsem);
+  kmm_free(priv);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ioring_ioctl
+ ****************************************************************************/
+
+static int ioring_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct ioring_file_s *priv = filep->f_priv;
+  FAR struct ioring_s *ring;
+  unsigned int avail;
+  int ret;
+
+  DEBUGASSERT(priv != NULL);
+
+  ret = nxmutex_lock(&g_ioring_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case IORINGIOC_SETUP:
+        ring = (FAR struct ioring_s *)((uintptr_t)arg);
+        if (priv->ring != NULL)
+          {
+            ret = -EBUSY;
+          }
+        else if (ring == NULL || ring->entries == 0 ||
+                 (ring->entries & (ring->entries - 1)) != 0 ||
+                 ring->sqes == NULL || ring->cqes == NULL)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            ring->sq_head = ring->sq_tail;
+            ring->cq_tail = ring->cq_head;
+            ring->flags   = IORING_NEED_ENTER;
+            priv->sq_head = ring->sq_head;
+            priv->ring    = ring;
+          }
+        break;
+
+      case IORINGIOC_ENTER:
+        ring = priv->ring;
+        if (ring == NULL)
+          {
+            ret = -EINVAL;
+            break;
+          }
+
+        /* Start the new submissions and wait for the completions */
+
+        ioring_queue(priv);
+        for (; ; )
+          {
+            avail = ring->cq_tail - ring->cq_head;
+            if (avail >= arg ||
+                (priv->inflight == 0 && !priv->queued))
+              {
+                ret = avail;
+                break;
+              }
+
+            priv->nwaiters++;
+            nxmutex_unlock(&g_ioring_lock);
+            ret = nxsem_wait(&priv->waitsem);
+            nxmutex_lock(&g_ioring_lock);
+            if (ret < 0)
+              {
+                break;
+              }
+          }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&g_ioring_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ioring_register
+ *
+ * Description:
+ *   Register the I/O ring driver at 'path' (normally /dev/ioring)
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int ioring_register(FAR const char *path)
+{
+  return register_driver(path, &g_ioring_fops, 0666, NULL);
+}
+
+#endif /* CONFIG_FS_IORING */
@@ -39,6 +39,8 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 
@@ -52,6 +54,10 @@
 
 #define CROMFS_MAX_LINKS 64
 
+#ifndef CONFIG_FS_CROMFS_CACHE_NBLOCKS
+#  define CONFIG_FS_CROMFS_CACHE_NBLOCKS 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -68,11 +74,25 @@ struct cromfs_dir_s
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   uint32_t ff_offset;                       /* Cached block offset (zero means none) */
   uint16_t ff_ulen;                         /* Length of decompressed data in cache */
   FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+#endif
 };
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+/* One block of the cache of decompressed blocks shared by all open files */
+
+struct cromfs_cache_s
+{
+  uint32_t cc_offset;                       /* Block offset (zero means none) */
+  uint32_t cc_lastuse;                      /* Time stamp of the last use */
+  uint16_t cc_ulen;                         /* Length of decompressed data */
+  FAR uint8_t *cc_buffer;                   /* Decompressed data */
+};
+#endif
+
 /* This is the form of the callback from cromfs_foreach_node(): */
 
 typedef CODE int (*cromfs_foreach_t)(FAR const struct cromfs_volume_s *fs,
@@ -131,6 +151,16 @@ static int      cromfs_find_node(FAR const struct cromfs_volume_s *fs,
                   FAR const char *relpath,
                   FAR struct cromfs_nodeinfo_s *info,
                   FAR uint32_t *offset);
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+static FAR struct cromfs_cache_s *
+                cromfs_cache_get(FAR const struct cromfs_volume_s *fs,
+                  FAR const uint8_t *src, uint16_t clen);
+#ifdef CONFIG_FS_CROMFS_PREFETCH
+static void     cromfs_prefetch_worker(FAR void *arg);
+static void     cromfs_prefetch(FAR const struct cromfs_volume_s *fs,
+                  FAR const struct lzf_header_s *hdr);
+#endif
+#endif
 
 /* Common file system methods */
 
@@ -167,6 +197,29 @@ static int      cromfs_statfs(FAR struct inode *mountpt,
 static int      cromfs_stat(FAR struct inode *mountpt,
                   FAR const char *relpath, FAR struct stat *buf);
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+/* The cache of decompressed blocks.  There is only a single CROMFS image,
+ * so the cache is global.
+ */
+
+static struct cromfs_cache_s g_cromfs_cache[CONFIG_FS_CROMFS_CACHE_NBLOCKS];
+static mutex_t g_cromfs_cachelock = NXMUTEX_INITIALIZER;
+static uint32_t g_cromfs_cacheuse;
+
+#ifdef CONFIG_FS_CROMFS_PREFETCH
+/* The prefetch work.  g_cromfs_prefetch_fs is only changed while the work
+ * is not queued.
+ */
+
+static struct work_s g_cromfs_prefetch_work;
+static FAR const struct cromfs_volume_s *g_cromfs_prefetch_fs;
+#endif
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -717,6 +770,130 @@ static int cromfs_find_node(FAR const struct cromfs_volume_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: cromfs_cache_get
+ *
+ * Description:
+ *   Return the cache entry holding the decompressed data of the compressed
+ *   block at 'src'.  If the block is not in the cache, it is decompressed
+ *   into the least recently used entry.  Returns NULL if no buffer could be
+ *   allocated or the block could not be decompressed.
+ *
+ * Assumptions:
+ *   The caller holds g_cromfs_cachelock.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+static FAR struct cromfs_cache_s *
+                cromfs_cache_get(FAR const struct cromfs_volume_s *fs,
+                  FAR const uint8_t *src, uint16_t clen)
+{
+  FAR struct cromfs_cache_s *victim = NULL;
+  FAR struct cromfs_cache_s *cc;
+  unsigned int decomplen;
+  uint32_t voloffs;
+  int i;
+
+  voloffs = cromfs_addr2offset(fs, src);
+
+  for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+    {
+      cc = &g_cromfs_cache[i];
+      if (cc->cc_offset == voloffs)
+        {
+          cc->cc_lastuse = ++g_cromfs_cacheuse;
+          return cc;
+        }
+
+      /* Prefer an unused entry, then the least recently used one */
+
+      if (victim == NULL ||
+          (victim->cc_offset != 0 &&
+           (cc->cc_offset == 0 ||
+            (int32_t)(cc->cc_lastuse - victim->cc_lastuse) < 0)))
+        {
+          victim = cc;
+        }
+    }
+
+  if (victim->cc_buffer == NULL)
+    {
+      victim->cc_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
+      if (victim->cc_buffer == NULL)
+        {
+          return NULL;
+        }
+    }
+
+  decomplen = lzf_decompress(src, clen, victim->cc_buffer, fs->cv_bsize);
+  if (decomplen == 0)
+    {
+      ferr("ERROR: Failed to decompress block at %" PRIu32 "\n", voloffs);
+      victim->cc_offset = 0;
+      return NULL;
+    }
+
+  victim->cc_offset  = voloffs;
+  victim->cc_ulen    = decomplen;
+  victim->cc_lastuse = ++g_cromfs_cacheuse;
+  return victim;
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_prefetch_worker
+ *
+ * Description:
+ *   Decompress the block with header 'arg' into the cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_CROMFS_PREFETCH
+static void cromfs_prefetch_worker(FAR void *arg)
+{
+  FAR const struct lzf_type1_header_s *hdr1 =
+    (FAR const struct lzf_type1_header_s *)arg;
+  uint16_t clen;
+
+  clen = (uint16_t)hdr1->lzf_clen[0] << 8 | (uint16_t)hdr1->lzf_clen[1];
+
+  nxmutex_lock(&g_cromfs_cachelock);
+  cromfs_cache_get(g_cromfs_prefetch_fs,
+                   (FAR const uint8_t *)hdr1 + LZF_TYPE1_HDR_SIZE, clen);
+  nxmutex_unlock(&g_cromfs_cachelock);
+}
+
+/****************************************************************************
+ * Name: cromfs_prefetch
+ *
+ * Description:
+ *   Start decompressing the block with header 'hdr' into the cache on the
+ *   low priority work queue.  Nothing is done if the block is not
+ *   compressed or if another prefetch is still pending.
+ *
+ ****************************************************************************/
+
+static void cromfs_prefetch(FAR const struct cromfs_volume_s *fs,
+                            FAR const struct lzf_header_s *hdr)
+{
+  if (hdr->lzf_type != LZF_TYPE1_HDR)
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_cromfs_cachelock);
+  if (work_available(&g_cromfs_prefetch_work))
+    {
+      g_cromfs_prefetch_fs = fs;
+      work_queue(LPWORK, &g_cromfs_prefetch_work, cromfs_prefetch_worker,
+                 (FAR void *)hdr, 0);
+    }
+
+  nxmutex_unlock(&g_cromfs_cachelock);
+}
+#endif
+
 /****************************************************************************
  * Name: cromfs_open
  ****************************************************************************/
@@ -785,6 +962,7 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   /* Create a file buffer to support partial sector accesses */
 
   ff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
@@ -793,6 +971,7 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       kmm_free(ff);
       return -ENOMEM;
     }
+#endif
 
   /* Save the node in the open file instance */
 
@@ -819,11 +998,13 @@ static int cromfs_close(FAR struct file *filep)
   /* Get the open file instance from the file structure */
 
   ff = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Free all resources consumed by the opened file */
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   kmm_free(ff->ff_buffer);
+#endif
   kmm_free(ff);
 
   return OK;
@@ -865,7 +1046,7 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   /* Get the open file instance from the file structure */
 
   ff = (FAR struct cromfs_file_s *)filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Check for a read past the end of the file */
 
@@ -970,39 +1151,70 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+          FAR struct cromfs_cache_s *cc;
+
+          /* Copy the data from the cache of decompressed blocks */
+
+          copyoffs = (blkoffs >= filep->f_pos) ?
+                        0 : filep->f_pos - blkoffs;
+          DEBUGASSERT(ulen > copyoffs);
+          copysize = ulen - copyoffs;
+
+          if (copysize > remaining)  /* Clip to the size really needed */
+            {
+              copysize = remaining;
+            }
+
+          src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+
+          nxmutex_lock(&g_cromfs_cachelock);
+          cc = cromfs_cache_get(fs, src, clen);
+          if (cc == NULL)
+            {
+              nxmutex_unlock(&g_cromfs_cachelock);
+
+              /* Return what was read so far, if anything */
+
+              if (remaining == buflen)
+                {
+                  return -ENOMEM;
+                }
+
+              buflen -= remaining;
+              break;
+            }
+
+          finfo("blkoffs=%" PRIu32 " ulen=%" PRIu16 " clen=%" PRIu16
+                " cc_offset=%" PRIu32 " copyoffs=%u copysize=%u\n",
+                blkoffs, ulen, clen, cc->cc_offset, copyoffs, copysize);
+          DEBUGASSERT(cc->cc_ulen >= (copyoffs + copysize));
+
+          memcpy(dest, &cc->cc_buffer[copyoffs], copysize);
+          nxmutex_unlock(&g_cromfs_cachelock);
+#else
           /* If the source of the data is at the beginning of the compressed
            * data buffer and if the uncompressed data would not overrun the
            * buffer, then we can decompress directly into the user buffer.
+           * The intermediate decompression buffer is not involved, so its
+           * cached offset must be left alone.
            */
 
           if (filep->f_pos <= blkoffs && ulen <= remaining)
             {
-              uint32_t voloffs;
+              unsigned int decomplen;
 
               copyoffs = 0;
               copysize = ulen;
 
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
-
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
+              src       = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+              decomplen = lzf_decompress(src, clen, dest, remaining);
 
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
-
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32
-                    " ulen=%" PRIu16 " ff_offset=%" PRIu32 " copysize=%u\n",
-                    voloffs, blkoffs, ulen, ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
+              finfo("blkoffs=%" PRIu32 " ulen=%" PRIu16
+                    " decomplen=%u copysize=%u\n",
+                    blkoffs, ulen, decomplen, copysize);
+              DEBUGASSERT(decomplen >= copysize);
+              UNUSED(decomplen);
             }
           else
             {
@@ -1048,6 +1260,7 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
 
               memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
             }
+#endif
         }
 
       /* Adjust pointers counts and offset */
@@ -1057,6 +1270,18 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
       fpos      += copysize;
     }
 
+#ifdef CONFIG_FS_CROMFS_PREFETCH
+  /* If the read ended at the end of a block, the next read will probably
+   * start with the next block.  Decompress it in the background.
+   */
+
+  if (remaining == 0 && fpos == blkoffs + ulen &&
+      fpos < ff->ff_node->cn_size)
+    {
+      cromfs_prefetch(fs, nexthdr);
+    }
+#endif
+
   /* Update the file pointer */
 
   filep->f_pos = fpos;
@@ -1102,7 +1327,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   /* Get the open file instance from the file structure */
 
   oldff = oldp->f_priv;
-  DEBUGASSERT(oldff->ff_node != NULL && oldff->ff_buffer != NULL);
+  DEBUGASSERT(oldff->ff_node != NULL);
 
   /* Allocate and initialize an new open file instance referring to the
    * same node.
@@ -1114,6 +1339,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   /* Create a file buffer to support partial sector accesses */
 
   newff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
@@ -1122,6 +1348,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       kmm_free(newff);
       return -ENOMEM;
     }
+#endif
 
   /* Save the node in the open file instance */
 
@@ -1159,7 +1386,7 @@ static int cromfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
    */
 
   ff              = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   inode           = filep->f_inode;
   fs              = inode->i_private;
@@ -1438,8 +1665,31 @@ static int cromfs_bind(FAR struct inode *blkdriver, const void *data,
 static int cromfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
                         unsigned int flags)
 {
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  int i;
+#endif
+
   finfo("handle: %p blkdriver: %p flags: %02x\n",
         handle, blkdriver, flags);
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  /* Release the cache of decompressed blocks */
+
+#ifdef CONFIG_FS_CROMFS_PREFETCH
+  work_cancel(LPWORK, &g_cromfs_prefetch_work);
+#endif
+
+  nxmutex_lock(&g_cromfs_cachelock);
+  for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+    {
+      kmm_free(g_cromfs_cache[i].cc_buffer);
+      g_cromfs_cache[i].cc_buffer = NULL;
+      g_cromfs_cache[i].cc_offset = 0;
+    }
+
+  nxmutex_unlock(&g_cromfs_cachelock);
+#endif
+
   return OK;
 }
 
@@ -1139,10 +1139,20 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   if (cluster)
     {
       /* If the file has a cluster chain, follow it to the
-       * requested position.
+       * requested position.  Start from the cluster found by the last
+       * seek if that is not past the position and no clusters were freed
+       * since.
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+      if (ff->ff_seekcluster != 0 && ff->ff_seekgen == fs->fs_freegen &&
+          ff->ff_seekpos <= position)
+        {
+          cluster       = ff->ff_seekcluster;
+          filep->f_pos  = ff->ff_seekpos;
+          position     -= ff->ff_seekpos;
+        }
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1152,6 +1162,11 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
           ff->ff_currentcluster = cluster;
           if (position < clustersize)
             {
+              /* Remember where this cluster is for the next seek */
+
+              ff->ff_seekpos     = filep->f_pos;
+              ff->ff_seekcluster = cluster;
+              ff->ff_seekgen     = fs->fs_freegen;
               break;
             }
 
@@ -1533,6 +1548,7 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+  newff->ff_seekcluster      = 0;                          /* No seek hint */
 
   /* Attach the private date to the struct file instance */
 
@@ -2261,6 +2277,15 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  /* Write back the sectors still held in the sector cache */
+
+  if (fs->fs_mounted)
+    {
+      fat_updatefsinfo(fs);
+    }
+#endif
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2288,6 +2313,8 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* Release the mountpoint private data */
 
+  fat_cachefree(fs);
+
   if (fs->fs_buffer)
     {
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
@@ -39,6 +39,16 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_FAT_CACHE_NSECTORS
+#  define CONFIG_FAT_CACHE_NSECTORS 0
+#endif
+
+#ifndef CONFIG_FAT_READAHEAD_NSECTORS
+#  define CONFIG_FAT_READAHEAD_NSECTORS 0
+#endif
+
 /****************************************************************************
  * These offsets describes the master boot record (MBR).
  *
@@ -336,6 +346,11 @@
 
 #define UMOUNT_FORCED        8
 
+/* Sector cache flags (cs_flags) */
+
+#define FATCACHE_VALID       1
+#define FATCACHE_DIRTY       2
+
 /****************************************************************************
  * These offset describe the FSINFO sector
  */
@@ -858,6 +873,21 @@
  * is mounted with a fat32 filesystem.
  */
 
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+/* One sector of the FAT table or of a directory retained in the sector
+ * cache of the mountpoint.  Dirty sectors are written back when they are
+ * replaced or when the file system is synchronized.
+ */
+
+struct fat_cachesector_s
+{
+  off_t    cs_sector;              /* Sector buffered in cs_buffer */
+  uint32_t cs_lastuse;             /* fs_cachetime at the last access */
+  uint8_t  cs_flags;               /* See FATCACHE_* definitions */
+  uint8_t *cs_buffer;              /* Holds one sector from the device */
+};
+#endif
+
 struct fat_file_s;
 struct fat_mountpt_s
 {
@@ -887,6 +917,23 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  uint32_t fs_cachetime;           /* Counts sector cache accesses */
+
+  /* The CONFIG_FAT_CACHE_NSECTORS cached sectors */
+
+  FAR struct fat_cachesector_s *fs_cache;
+#endif
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+  off_t    fs_rasector;            /* First sector buffered in fs_rabuffer */
+  unsigned int fs_racount;         /* Sectors buffered in fs_rabuffer */
+  uint8_t *fs_rabuffer;            /* Holds the sectors read ahead */
+#endif
+#ifdef CONFIG_FAT_FREEBITMAP
+  uint32_t *fs_freemap;            /* One bit per cluster, set: free.
+                                    * NULL: not built yet */
+#endif
+  uint32_t fs_freegen;             /* Incremented when clusters are freed */
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -907,6 +954,9 @@ struct fat_file_s
   off_t    ff_startcluster;        /* Start cluster of file on media */
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
+  off_t    ff_seekpos;             /* File position of ff_seekcluster */
+  uint32_t ff_seekcluster;         /* Cluster of the last seek, 0: none */
+  uint32_t ff_seekgen;             /* fs_freegen at the last seek */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
 };
 
@@ -1033,6 +1083,11 @@ EXTERN time_t fat_fattime2systime(uint16_t fattime, uint16_t fatdate);
 EXTERN int    fat_mount(struct fat_mountpt_s *fs, bool writeable);
 EXTERN int    fat_checkmount(struct fat_mountpt_s *fs);
 
+/* Allocation of the sector cache and of the read-ahead buffer */
+
+EXTERN int    fat_cachealloc(struct fat_mountpt_s *fs);
+EXTERN void   fat_cachefree(struct fat_mountpt_s *fs);
+
 /* low-level hardware access */
 
 EXTERN int    fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,
@@ -30,6 +30,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <assert.h>
 #include <errno.h>
@@ -42,6 +43,20 @@
 #include "inode/inode.h"
 #include "fs_fat32.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of clusters that an allocation examines in the FAT before
+ * the free cluster bitmap is built.
+ */
+
+#define FAT_FREEMAP_SCANLIMIT   1024
+
+/* The size in bytes of the free cluster bitmap */
+
+#define FAT_FREEMAP_SIZE(fs)    ((((fs)->fs_nclusters + 31) >> 5) * 4)
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -263,6 +278,424 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one sector from the specified buffer.  If the sector lies in the
+ *   FAT region, then the change is made in the FAT copies as well.
+ *
+ ****************************************************************************/
+
+static int fat_writesector(struct fat_mountpt_s *fs, uint8_t *buffer,
+                           off_t sector)
+{
+  int ret;
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase && sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      int i;
+
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+/****************************************************************************
+ * Name: fat_cachefind
+ *
+ * Description:
+ *   Return the entry of the sector cache that holds the specified sector,
+ *   or NULL if the sector is not cached.
+ *
+ ****************************************************************************/
+
+static struct fat_cachesector_s *fat_cachefind(struct fat_mountpt_s *fs,
+                                               off_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      struct fat_cachesector_s *cs = &fs->fs_cache[i];
+
+      if ((cs->cs_flags & FATCACHE_VALID) != 0 && cs->cs_sector == sector)
+        {
+          return cs;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: fat_cachestore
+ *
+ * Description:
+ *   Copy one sector into the sector cache.  If the sector is not cached
+ *   yet, then the least recently used entry is replaced, writing it back
+ *   first if it is dirty.
+ *
+ ****************************************************************************/
+
+static int fat_cachestore(struct fat_mountpt_s *fs, off_t sector,
+                          uint8_t *buffer, bool dirty)
+{
+  struct fat_cachesector_s *cs;
+  int ret;
+  int i;
+
+  cs = fat_cachefind(fs, sector);
+  if (cs == NULL)
+    {
+      /* Prefer an unused entry, otherwise take the least recently used */
+
+      cs = &fs->fs_cache[0];
+      for (i = 1; i < CONFIG_FAT_CACHE_NSECTORS &&
+                  (cs->cs_flags & FATCACHE_VALID) != 0; i++)
+        {
+          struct fat_cachesector_s *next = &fs->fs_cache[i];
+
+          if ((next->cs_flags & FATCACHE_VALID) == 0 ||
+              (int32_t)(next->cs_lastuse - cs->cs_lastuse) < 0)
+            {
+              cs = next;
+            }
+        }
+
+      if ((cs->cs_flags & FATCACHE_DIRTY) != 0)
+        {
+          ret = fat_writesector(fs, cs->cs_buffer, cs->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      cs->cs_sector = sector;
+      cs->cs_flags  = FATCACHE_VALID;
+    }
+
+  memcpy(cs->cs_buffer, buffer, fs->fs_hwsectorsize);
+  cs->cs_lastuse = ++fs->fs_cachetime;
+  if (dirty)
+    {
+      cs->cs_flags |= FATCACHE_DIRTY;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachesync
+ *
+ * Description:
+ *   Write back all dirty sectors of the sector cache.
+ *
+ ****************************************************************************/
+
+static int fat_cachesync(struct fat_mountpt_s *fs)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      struct fat_cachesector_s *cs = &fs->fs_cache[i];
+
+      if ((cs->cs_flags & FATCACHE_DIRTY) != 0)
+        {
+          ret = fat_writesector(fs, cs->cs_buffer, cs->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+#endif
+
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+/****************************************************************************
+ * Name: fat_readahead
+ *
+ * Description:
+ *   Read one data sector into the specified buffer.  On sequential access,
+ *   the following sectors of the same cluster are read along with it into
+ *   the read-ahead buffer so that the next accesses need no transfer.
+ *
+ ****************************************************************************/
+
+static int fat_readahead(struct fat_mountpt_s *fs, uint8_t *buffer,
+                         off_t sector, bool sequential)
+{
+  off_t nsectors;
+  int ret;
+
+  if (fs->fs_racount > 0 && sector >= fs->fs_rasector &&
+      sector < fs->fs_rasector + fs->fs_racount)
+    {
+      memcpy(buffer, &fs->fs_rabuffer[(sector - fs->fs_rasector) *
+                                      fs->fs_hwsectorsize],
+             fs->fs_hwsectorsize);
+      return OK;
+    }
+
+  /* Do not read beyond the current cluster or the end of the volume */
+
+  nsectors = 1;
+  if (sequential && sector >= fs->fs_database)
+    {
+      nsectors = fs->fs_fatsecperclus -
+                 (sector - fs->fs_database) % fs->fs_fatsecperclus;
+      if (nsectors > CONFIG_FAT_READAHEAD_NSECTORS)
+        {
+          nsectors = CONFIG_FAT_READAHEAD_NSECTORS;
+        }
+
+      if (nsectors > fs->fs_hwnsectors - sector)
+        {
+          nsectors = fs->fs_hwnsectors - sector;
+        }
+    }
+
+  if (nsectors <= 1)
+    {
+      return fat_hwread(fs, buffer, sector, 1);
+    }
+
+  fs->fs_racount = 0;
+  ret = fat_hwread(fs, fs->fs_rabuffer, sector, nsectors);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  fs->fs_rasector = sector;
+  fs->fs_racount  = nsectors;
+  memcpy(buffer, fs->fs_rabuffer, fs->fs_hwsectorsize);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_freemapmark
+ *
+ * Description:
+ *   Record in the free cluster bitmap (if there is one) whether 'cluster'
+ *   is free.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEBITMAP
+static void fat_freemapmark(FAR struct fat_mountpt_s *fs, uint32_t cluster,
+                            bool isfree)
+{
+  if (fs->fs_freemap != NULL && cluster >= 2 && cluster < fs->fs_nclusters)
+    {
+      if (isfree)
+        {
+          fs->fs_freemap[cluster >> 5] |= (uint32_t)1 << (cluster & 31);
+        }
+      else
+        {
+          fs->fs_freemap[cluster >> 5] &= ~((uint32_t)1 << (cluster & 31));
+        }
+    }
+}
+#else
+#  define fat_freemapmark(fs, cluster, isfree)
+#endif
+
+/****************************************************************************
+ * Name: fat_freemapfind
+ *
+ * Description:
+ *   Find the first cluster after 'startcluster' (wrapping around at the end
+ *   of the volume) that is free according to the free cluster bitmap.
+ *
+ * Returned Value:
+ *   The cluster number, 0 if there is no free cluster.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FREEBITMAP
+static uint32_t fat_freemapfind(FAR struct fat_mountpt_s *fs,
+                                uint32_t startcluster)
+{
+  uint32_t nwords = (fs->fs_nclusters + 31) >> 5;
+  uint32_t cluster;
+  uint32_t bits;
+  uint32_t word;
+  uint32_t i;
+
+  cluster = startcluster + 1;
+  if (cluster >= fs->fs_nclusters)
+    {
+      cluster = 2;
+    }
+
+  /* One more word than the bitmap holds covers the wrap around.  The bits
+   * of the reserved clusters 0 and 1 and those past the end are never set.
+   */
+
+  for (i = 0; i <= nwords; i++)
+    {
+      word = cluster >> 5;
+      bits = fs->fs_freemap[word] & ((uint32_t)0xffffffff << (cluster & 31));
+      if (bits != 0)
+        {
+          return (word << 5) + ffs(bits) - 1;
+        }
+
+      cluster = (word + 1) << 5;
+      if (cluster >= fs->fs_nclusters)
+        {
+          cluster = 0;
+        }
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_findfree
+ *
+ * Description:
+ *   Find a free cluster after 'startcluster', wrapping around at the end of
+ *   the volume.
+ *
+ * Returned Value:
+ *   <0:error, 0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_findfree(FAR struct fat_mountpt_s *fs,
+                            uint32_t startcluster)
+{
+  off_t    startsector;
+  uint32_t newcluster;
+#ifdef CONFIG_FAT_FREEBITMAP
+  uint32_t nscanned = 0;
+
+  /* Search the bitmap if there is one.  The FAT remains the reference:
+   * Clusters that turn out to be used are removed from the bitmap.
+   */
+
+  while (fs->fs_freemap != NULL)
+    {
+      newcluster = fat_freemapfind(fs, startcluster);
+      if (newcluster == 0)
+        {
+          return 0;
+        }
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          return startsector;
+        }
+
+      fat_freemapmark(fs, newcluster, false);
+    }
+#endif
+
+  /* Loop until (1) we discover that there are not free clusters
+   * (return 0), an errors occurs (return -errno), or (3) we find
+   * the next cluster (return the new cluster number).
+   */
+
+  newcluster = startcluster;
+  for (; ; )
+    {
+      /* Examine the next cluster in the FAT */
+
+      newcluster++;
+      if (newcluster >= fs->fs_nclusters)
+        {
+          /* If we hit the end of the available clusters, then
+           * wrap back to the beginning because we might have
+           * started at a non-optimal place.  But don't continue
+           * past the start cluster.
+           */
+
+          newcluster = 2;
+          if (newcluster > startcluster)
+            {
+              /* We are back past the starting cluster, then there
+               * is no free cluster.
+               */
+
+              return 0;
+            }
+        }
+
+      /* We have a candidate cluster.  Check if the cluster number is
+       * mapped to a group of sectors.
+       */
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          /* Found have found a free cluster */
+
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          /* Some error occurred, return the error number */
+
+          return startsector;
+        }
+
+      /* We wrap all the back to the starting cluster?  If so, then
+       * there are no free clusters.
+       */
+
+      if (newcluster == startcluster)
+        {
+          return 0;
+        }
+
+#ifdef CONFIG_FAT_FREEBITMAP
+      /* The volume is getting full:  Build the bitmap and search there */
+
+      if (++nscanned == FAT_FREEMAP_SCANLIMIT &&
+          fat_computefreeclusters(fs) == OK && fs->fs_freemap != NULL)
+        {
+          return fat_findfree(fs, newcluster);
+        }
+#endif
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -531,6 +964,12 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+  ret = fat_cachealloc(fs);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -669,6 +1108,7 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+  fat_cachefree(fs);
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
@@ -717,11 +1157,106 @@ int fat_checkmount(struct fat_mountpt_s *fs)
       /* If we get here, the mount is NOT healthy */
 
       fs->fs_mounted = false;
+
+#ifdef CONFIG_FAT_FREEBITMAP
+      /* The bitmap does not describe the new media */
+
+      kmm_free(fs->fs_freemap);
+      fs->fs_freemap = NULL;
+#endif
     }
 
   return -ENODEV;
 }
 
+/****************************************************************************
+ * Name: fat_cachealloc
+ *
+ * Description:
+ *   Allocate the sector cache and the read-ahead buffer of a mountpoint as
+ *   configured.  The hardware sector size must be known.
+ *
+ ****************************************************************************/
+
+int fat_cachealloc(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  uint8_t *buffer;
+  int i;
+
+  fs->fs_cache = (FAR struct fat_cachesector_s *)
+    kmm_zalloc(CONFIG_FAT_CACHE_NSECTORS * sizeof(struct fat_cachesector_s));
+  if (fs->fs_cache == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  buffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_CACHE_NSECTORS * fs->fs_hwsectorsize);
+  if (buffer == NULL)
+    {
+      kmm_free(fs->fs_cache);
+      fs->fs_cache = NULL;
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      fs->fs_cache[i].cs_buffer = &buffer[i * fs->fs_hwsectorsize];
+    }
+#endif
+
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+  fs->fs_racount  = 0;
+  fs->fs_rabuffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_READAHEAD_NSECTORS * fs->fs_hwsectorsize);
+  if (fs->fs_rabuffer == NULL)
+    {
+      fat_cachefree(fs);
+      return -ENOMEM;
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_cachefree
+ *
+ * Description:
+ *   Free the sector cache, the read-ahead buffer and the free cluster
+ *   bitmap of a mountpoint.  Dirty sectors are not written back.
+ *
+ ****************************************************************************/
+
+void fat_cachefree(struct fat_mountpt_s *fs)
+{
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  if (fs->fs_cache != NULL)
+    {
+      fat_io_free(fs->fs_cache[0].cs_buffer,
+                  CONFIG_FAT_CACHE_NSECTORS * fs->fs_hwsectorsize);
+      kmm_free(fs->fs_cache);
+      fs->fs_cache = NULL;
+    }
+#endif
+
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+  if (fs->fs_rabuffer != NULL)
+    {
+      fat_io_free(fs->fs_rabuffer,
+                  CONFIG_FAT_READAHEAD_NSECTORS * fs->fs_hwsectorsize);
+      fs->fs_rabuffer = NULL;
+      fs->fs_racount  = 0;
+    }
+#endif
+
+#ifdef CONFIG_FAT_FREEBITMAP
+  kmm_free(fs->fs_freemap);
+  fs->fs_freemap = NULL;
+#endif
+}
+
 /****************************************************************************
  * Name: fat_hwread
  *
@@ -752,6 +1287,27 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
         }
     }
 
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  /* The sector cache may hold newer contents of the sectors read */
+
+  if (ret == OK && fs->fs_cache != NULL)
+    {
+      int i;
+
+      for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+        {
+          struct fat_cachesector_s *cs = &fs->fs_cache[i];
+
+          if ((cs->cs_flags & FATCACHE_DIRTY) != 0 &&
+              cs->cs_sector >= sector && cs->cs_sector < sector + nsectors)
+            {
+              memcpy(&buffer[(cs->cs_sector - sector) * fs->fs_hwsectorsize],
+                     cs->cs_buffer, fs->fs_hwsectorsize);
+            }
+        }
+    }
+#endif
+
   return ret;
 }
 
@@ -786,6 +1342,62 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
         }
     }
 
+  if (ret == OK)
+    {
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+      /* Update the cached copies of the sectors written.  They are clean
+       * now.
+       */
+
+      if (fs->fs_cache != NULL)
+        {
+          int i;
+
+          for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+            {
+              struct fat_cachesector_s *cs = &fs->fs_cache[i];
+              uint8_t *src;
+
+              if ((cs->cs_flags & FATCACHE_VALID) != 0 &&
+                  cs->cs_sector >= sector &&
+                  cs->cs_sector < sector + nsectors)
+                {
+                  src = &buffer[(cs->cs_sector - sector) *
+                                fs->fs_hwsectorsize];
+                  if (src != cs->cs_buffer)
+                    {
+                      memcpy(cs->cs_buffer, src, fs->fs_hwsectorsize);
+                    }
+
+                  cs->cs_flags &= ~FATCACHE_DIRTY;
+                }
+            }
+        }
+#endif
+
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+      /* Update the sectors read ahead */
+
+      if (fs->fs_racount > 0 && sector < fs->fs_rasector + fs->fs_racount &&
+          sector + nsectors > fs->fs_rasector)
+        {
+          off_t first = sector > fs->fs_rasector ? sector : fs->fs_rasector;
+          off_t raend = fs->fs_rasector + fs->fs_racount;
+          off_t last  = sector + nsectors;
+
+          if (last > raend)
+            {
+              last = raend;
+            }
+
+          memcpy(&fs->fs_rabuffer[(first - fs->fs_rasector) *
+                                  fs->fs_hwsectorsize],
+                 &buffer[(first - sector) * fs->fs_hwsectorsize],
+                 (last - first) * fs->fs_hwsectorsize);
+        }
+#endif
+    }
+
   return ret;
 }
 
@@ -1151,6 +1763,9 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
           return ret;
         }
 
+      fat_freemapmark(fs, cluster, true);
+      fs->fs_freegen++;
+
       /* Update FSINFINFO data */
 
       if (fs->fs_fsifreecount != 0xffffffff)
@@ -1182,7 +1797,7 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
 int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
 {
   off_t    startsector;
-  uint32_t newcluster;
+  int32_t  newcluster;
   uint32_t startcluster;
   int      ret;
 
@@ -1233,67 +1848,15 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
-  /* Loop until (1) we discover that there are not free clusters
-   * (return 0), an errors occurs (return -errno), or (3) we find
-   * the next cluster (return the new cluster number).
-   */
+  /* Find a free cluster */
 
-  newcluster = startcluster;
-  for (; ; )
+  newcluster = fat_findfree(fs, startcluster);
+  if (newcluster <= 0)
     {
-      /* Examine the next cluster in the FAT */
-
-      newcluster++;
-      if (newcluster >= fs->fs_nclusters)
-        {
-          /* If we hit the end of the available clusters, then
-           * wrap back to the beginning because we might have
-           * started at a non-optimal place.  But don't continue
-           * past the start cluster.
-           */
-
-          newcluster = 2;
-          if (newcluster > startcluster)
-            {
-              /* We are back past the starting cluster, then there
-               * is no free cluster.
-               */
-
-              return 0;
-            }
-        }
-
-      /* We have a candidate cluster.  Check if the cluster number is
-       * mapped to a group of sectors.
-       */
-
-      startsector = fat_getcluster(fs, newcluster);
-      if (startsector == 0)
-        {
-          /* Found have found a free cluster break out */
-
-          break;
-        }
-      else if (startsector < 0)
-        {
-          /* Some error occurred, return the error number */
-
-          return startsector;
-        }
-
-      /* We wrap all the back to the starting cluster?  If so, then
-       * there are no free clusters.
-       */
-
-      if (newcluster == startcluster)
-        {
-          return 0;
-        }
+      return newcluster;
     }
 
-  /* We get here only if we break out with an available cluster
-   * number in 'newcluster'  Now mark that cluster as in-use.
-   */
+  /* Now mark that cluster as in-use */
 
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
   if (ret < 0)
@@ -1303,6 +1866,8 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       return ret;
     }
 
+  fat_freemapmark(fs, newcluster, false);
+
   /* And link if to the start cluster (if any) */
 
   if (cluster)
@@ -1783,34 +2348,22 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
   if (fs->fs_dirty)
     {
-      /* Write the dirty sector */
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+      /* Keep the dirty sector in the sector cache.  It is written back
+       * when it is replaced or by fat_updatefsinfo().
+       */
+
+      ret = fat_cachestore(fs, fs->fs_currentsector, fs->fs_buffer, true);
+#else
+      /* Write the dirty sector (and its FAT copies) */
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
+#endif
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
@@ -1830,6 +2383,9 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  struct fat_cachesector_s *cs;
+#endif
   int ret;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
@@ -1849,6 +2405,19 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
           return ret;
         }
 
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+      /* Then take the sector from the sector cache if it is there */
+
+      cs = fat_cachefind(fs, sector);
+      if (cs != NULL)
+        {
+          memcpy(fs->fs_buffer, cs->cs_buffer, fs->fs_hwsectorsize);
+          cs->cs_lastuse       = ++fs->fs_cachetime;
+          fs->fs_currentsector = sector;
+          return OK;
+        }
+#endif
+
       /* Then read the specified sector into the cache */
 
       ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
@@ -1860,6 +2429,16 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
       /* Update the cached sector number */
 
       fs->fs_currentsector = sector;
+
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+      /* And retain a copy in the sector cache */
+
+      ret = fat_cachestore(fs, sector, fs->fs_buffer, false);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#endif
     }
 
   return OK;
@@ -1934,7 +2513,13 @@ int fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff,
 
       /* Then read the specified sector into the cache */
 
+#if CONFIG_FAT_READAHEAD_NSECTORS > 0
+      ret = fat_readahead(fs, ff->ff_buffer, sector,
+                          ff->ff_cachesector == 0 ||
+                          sector == ff->ff_cachesector + 1);
+#else
       ret = fat_hwread(fs, ff->ff_buffer, sector, 1);
+#endif
       if (ret < 0)
         {
           return ret;
@@ -2029,6 +2614,15 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
         }
     }
 
+#if CONFIG_FAT_CACHE_NSECTORS > 0
+  /* Write back the dirty sectors held in the sector cache */
+
+  if (ret == OK)
+    {
+      ret = fat_cachesync(fs);
+    }
+#endif
+
   return ret;
 }
 
@@ -2045,6 +2639,21 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
   /* We have to count the number of free clusters */
 
   uint32_t nfreeclusters = 0;
+
+#ifdef CONFIG_FAT_FREEBITMAP
+  /* Record the free clusters in the bitmap on the way */
+
+  if (fs->fs_freemap == NULL)
+    {
+      fs->fs_freemap = kmm_malloc(FAT_FREEMAP_SIZE(fs));
+    }
+
+  if (fs->fs_freemap != NULL)
+    {
+      memset(fs->fs_freemap, 0, FAT_FREEMAP_SIZE(fs));
+    }
+#endif
+
   if (fs->fs_type == FSTYPE_FAT12)
     {
       off_t sector;
@@ -2059,6 +2668,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if ((uint16_t)fat_getcluster(fs, sector) == 0)
             {
+              fat_freemapmark(fs, sector, true);
               nfreeclusters++;
             }
         }
@@ -2066,6 +2676,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
   else
     {
       unsigned int cluster;
+      uint32_t     clusterno = 0;
       off_t        fatsector;
       unsigned int offset;
       int          ret;
@@ -2086,6 +2697,10 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
               ret = fat_fscacheread(fs, fatsector);
               if (ret < 0)
                 {
+#ifdef CONFIG_FAT_FREEBITMAP
+                  kmm_free(fs->fs_freemap);
+                  fs->fs_freemap = NULL;
+#endif
                   return ret;
                 }
 
@@ -2105,6 +2720,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             {
               if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
                 {
+                  fat_freemapmark(fs, clusterno, true);
                   nfreeclusters++;
                 }
 
@@ -2114,11 +2730,14 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             {
               if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
                 {
+                  fat_freemapmark(fs, clusterno, true);
                   nfreeclusters++;
                 }
 
               offset += 4;
             }
+
+          clusterno++;
         }
     }
 
@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/fs/ioring.h>
+
 #include "rpmsgfs/rpmsgfs.h"
 #include "inode/inode.h"
 #include "aio/aio.h"
@@ -54,6 +56,12 @@ void fs_initialize(void)
 
 #endif
 
+#ifdef CONFIG_FS_IORING
+  /* Register the I/O ring driver */
+
+  ioring_register("/dev/ioring");
+#endif
+
 #ifdef CONFIG_FS_RPMSGFS_SERVER
   rpmsgfs_server_init();
 #endif
@@ -36,6 +36,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
@@ -50,6 +51,12 @@
 
 #define HOSTFS_RETRY_DELAY_MS       10
 
+#if CONFIG_FS_HOSTFS_ATTRCACHE_SIZE == 0
+#  define hostfs_attr_lookup(fs, relpath, buf) false
+#  define hostfs_attr_add(fs, relpath, buf)
+#  define hostfs_attr_flush(fs)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -249,6 +256,100 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+/****************************************************************************
+ * Name: hostfs_attr_slot
+ *
+ * Description: Return the attribute cache entry of 'relpath'
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE_SIZE > 0
+static FAR struct hostfs_attr_s *
+hostfs_attr_slot(FAR struct hostfs_mountpt_s *fs, FAR const char *relpath)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*relpath != '\0')
+    {
+      hash = (hash ^ (uint8_t)*relpath++) * 16777619u;
+    }
+
+  return &fs->fs_attr[hash % CONFIG_FS_HOSTFS_ATTRCACHE_SIZE];
+}
+
+/****************************************************************************
+ * Name: hostfs_attr_lookup
+ *
+ * Description: Return true if the attributes of 'relpath' are cached
+ *
+ ****************************************************************************/
+
+static bool hostfs_attr_lookup(FAR struct hostfs_mountpt_s *fs,
+                               FAR const char *relpath,
+                               FAR struct stat *buf)
+{
+  FAR struct hostfs_attr_s *attr = hostfs_attr_slot(fs, relpath);
+
+  if (attr->path[0] == '\0' || strcmp(attr->path, relpath) != 0)
+    {
+      return false;
+    }
+
+  if ((sclock_t)(clock_systime_ticks() - attr->expire) >= 0)
+    {
+      attr->path[0] = '\0';
+      return false;
+    }
+
+  memcpy(buf, &attr->st, sizeof(struct stat));
+  return true;
+}
+
+/****************************************************************************
+ * Name: hostfs_attr_add
+ *
+ * Description: Remember the attributes of 'relpath'
+ *
+ ****************************************************************************/
+
+static void hostfs_attr_add(FAR struct hostfs_mountpt_s *fs,
+                            FAR const char *relpath,
+                            FAR const struct stat *buf)
+{
+  FAR struct hostfs_attr_s *attr;
+
+  if (strlen(relpath) >= HOSTFS_ATTR_PATHLEN)
+    {
+      return;
+    }
+
+  attr         = hostfs_attr_slot(fs, relpath);
+  attr->expire = clock_systime_ticks() +
+                 MSEC2TICK(CONFIG_FS_HOSTFS_ATTRCACHE_MSEC);
+  memcpy(&attr->st, buf, sizeof(struct stat));
+  strlcpy(attr->path, relpath, sizeof(attr->path));
+}
+
+/****************************************************************************
+ * Name: hostfs_attr_flush
+ *
+ * Description:
+ *   Forget all cached attributes.  Called for each modification made
+ *   through the mount.
+ *
+ ****************************************************************************/
+
+static void hostfs_attr_flush(FAR struct hostfs_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_ATTRCACHE_SIZE; i++)
+    {
+      fs->fs_attr[i].path[0] = '\0';
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -298,6 +399,11 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Try to open the file in the host file system */
 
+  if ((oflags & (O_CREAT | O_TRUNC)) != 0)
+    {
+      hostfs_attr_flush(fs);
+    }
+
   hf->fd = host_open(path, oflags, mode);
   if (hf->fd < 0)
     {
@@ -530,6 +636,7 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+  hostfs_attr_flush(fs);
   ret = host_write(hf->fd, buffer, buflen);
   if (ret > 0)
     {
@@ -780,6 +887,7 @@ static int hostfs_fchstat(FAR const struct file *filep,
 
   /* Call the host to perform the change */
 
+  hostfs_attr_flush(fs);
   ret = host_fchstat(hf->fd, buf, flags);
 
   hostfs_semgive(fs);
@@ -825,6 +933,7 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
+  hostfs_attr_flush(fs);
   ret = host_ftruncate(hf->fd, length);
 
   hostfs_semgive(fs);
@@ -1240,6 +1349,7 @@ static int hostfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host fs to perform the unlink */
 
+  hostfs_attr_flush(fs);
   ret = host_unlink(path);
 
   hostfs_semgive(fs);
@@ -1280,6 +1390,7 @@ static int hostfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attr_flush(fs);
   ret = host_mkdir(path, mode);
 
   hostfs_semgive(fs);
@@ -1321,6 +1432,7 @@ int hostfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attr_flush(fs);
   ret = host_rmdir(path);
 
   hostfs_semgive(fs);
@@ -1365,6 +1477,7 @@ int hostfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
 
   /* Call the host FS to do the mkdir */
 
+  hostfs_attr_flush(fs);
   ret = host_rename(oldpath, newpath);
 
   hostfs_semgive(fs);
@@ -1399,6 +1512,12 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
       return ret;
     }
 
+  if (hostfs_attr_lookup(fs, relpath, buf))
+    {
+      hostfs_semgive(fs);
+      return OK;
+    }
+
   /* Append to the host's root directory */
 
   hostfs_mkpath(fs, relpath, path, sizeof(path));
@@ -1406,6 +1525,10 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
   /* Call the host FS to do the stat operation */
 
   ret = host_stat(path, buf);
+  if (ret >= 0)
+    {
+      hostfs_attr_add(fs, relpath, buf);
+    }
 
   hostfs_semgive(fs);
   return ret;
@@ -1445,6 +1568,7 @@ static int hostfs_chstat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the chstat operation */
 
+  hostfs_attr_flush(fs);
   ret = host_chstat(path, buf, flags);
 
   hostfs_semgive(fs);
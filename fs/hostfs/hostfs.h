@@ -28,8 +28,10 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 #include <nuttx/semaphore.h>
 
@@ -39,6 +41,14 @@
 
 #define HOSTFS_MAX_PATH     256
 
+#ifndef CONFIG_FS_HOSTFS_ATTRCACHE_SIZE
+#  define CONFIG_FS_HOSTFS_ATTRCACHE_SIZE 0
+#endif
+
+/* The longest relative path remembered by the attribute cache */
+
+#define HOSTFS_ATTR_PATHLEN 48
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -55,6 +65,19 @@ struct hostfs_ofile_s
   int                       fd;
 };
 
+/* One cached stat() result of the relative path.  The entry is unused if
+ * path is empty.
+ */
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE_SIZE > 0
+struct hostfs_attr_s
+{
+  clock_t                   expire;     /* The entry is stale from then on */
+  struct stat               st;         /* The result of host_stat() */
+  char                      path[HOSTFS_ATTR_PATHLEN];
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a hostfs filesystem.
@@ -65,6 +88,9 @@ struct hostfs_mountpt_s
   sem_t                      *fs_sem;       /* Used to assure thread-safe access */
   FAR struct hostfs_ofile_s  *fs_head;      /* A singly-linked list of open files */
   char                        fs_root[HOSTFS_MAX_PATH];
+#if CONFIG_FS_HOSTFS_ATTRCACHE_SIZE > 0
+  struct hostfs_attr_s        fs_attr[CONFIG_FS_HOSTFS_ATTRCACHE_SIZE];
+#endif
 };
 
 /****************************************************************************
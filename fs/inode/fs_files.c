@@ -35,9 +35,24 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Each array of rows is preceded by an entry that holds the base of the
+ * array that it replaced.
+ */
+
+#define FILES_BASE(f) ((f) != NULL ? (FAR struct file **)(f) - 1 : NULL)
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -76,13 +91,28 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return -EMFILE;
     }
 
-  tmp = kmm_realloc(list->fl_files, sizeof(FAR struct file *) * row);
+  /* fs_getfilep() may still be reading the current array of rows without
+   * holding the list semaphore, so it cannot be reallocated in place.  A
+   * new array is allocated instead, with one more leading entry that
+   * retains the previous array until the list is released.
+   */
+
+  tmp = kmm_malloc(sizeof(FAR struct file *) * (row + 1));
   DEBUGASSERT(tmp);
   if (tmp == NULL)
     {
       return -ENFILE;
     }
 
+  tmp[0] = (FAR struct file *)FILES_BASE(list->fl_files);
+  tmp++;
+
+  if (list->fl_rows > 0)
+    {
+      memcpy(tmp, list->fl_files,
+             sizeof(FAR struct file *) * list->fl_rows);
+    }
+
   i = list->fl_rows;
   do
     {
@@ -95,14 +125,19 @@ static int files_extend(FAR struct filelist *list, size_t row)
               kmm_free(tmp[i]);
             }
 
-          kmm_free(tmp);
+          kmm_free(FILES_BASE(tmp));
           return -ENFILE;
         }
     }
   while (++i < row);
 
-  list->fl_files = tmp;
-  list->fl_rows = row;
+  /* Publish the new array before the new number of rows.  A lock-free
+   * reader that sees the new number of rows also sees the new array.
+   */
+
+  *(FAR struct file ** volatile *)&list->fl_files = tmp;
+  SP_DMB();
+  *(FAR volatile uint8_t *)&list->fl_rows = row;
 
   /* Note: If assertion occurs, the fl_rows has a overflow.
    * And there may be file descriptors leak in system.
@@ -142,6 +177,7 @@ void files_initlist(FAR struct filelist *list)
 
 void files_releaselist(FAR struct filelist *list)
 {
+  FAR struct file **base;
   int i;
   int j;
 
@@ -162,7 +198,16 @@ void files_releaselist(FAR struct filelist *list)
       kmm_free(list->fl_files[i]);
     }
 
-  kmm_free(list->fl_files);
+  /* Free the array of rows and all of the arrays that it replaced */
+
+  base = FILES_BASE(list->fl_files);
+  while (base != NULL)
+    {
+      FAR struct file **prev = (FAR struct file **)base[0];
+
+      kmm_free(base);
+      base = prev;
+    }
 
   /* Destroy the semaphore */
 
@@ -322,6 +367,64 @@ out:
   return ret;
 }
 
+/****************************************************************************
+ * Name: files_getfilep
+ *
+ * Description:
+ *   Given a file descriptor of the file list 'list', return the
+ *   corresponding instance of struct file.
+ *
+ * Input Parameters:
+ *   list  - The file list
+ *   fd    - The file descriptor
+ *   filep - The location to return the struct file instance
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int files_getfilep(FAR struct filelist *list, int fd,
+                   FAR struct file **filep)
+{
+  FAR struct file **files;
+  int rows;
+
+  DEBUGASSERT(list != NULL && filep != NULL);
+  *filep = (FAR struct file *)NULL;
+
+  /* The list semaphore is not needed here:  Rows are only ever added and
+   * files_extend() publishes the array of rows before the number of rows,
+   * so the number of rows read first never exceeds the array read next.
+   * The arrays replaced stay allocated until the list is released.
+   */
+
+  rows  = *(FAR volatile uint8_t *)&list->fl_rows;
+  SP_DMB();
+  files = *(FAR struct file ** volatile *)&list->fl_files;
+
+  if (fd < 0 || fd >= rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
+    {
+      return -EBADF;
+    }
+
+  /* And return the file pointer from the list */
+
+  *filep = &files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                 [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+
+  /* if f_inode is NULL, fd was closed */
+
+  if (!(*filep)->f_inode)
+    {
+      *filep = (FAR struct file *)NULL;
+      return -EBADF;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: fs_getfilep
  *
@@ -342,7 +445,6 @@ out:
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
-  int ret;
 
   DEBUGASSERT(filep != NULL);
   *filep = (FAR struct file *)NULL;
@@ -361,37 +463,7 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  if (fd < 0 || fd >= list->fl_rows * CONFIG_NFILE_DESCRIPTORS_PER_BLOCK)
-    {
-      return -EBADF;
-    }
-
-  /* The descriptor is in a valid range to file descriptor... Get the
-   * thread-specific file list.
-   */
-
-  /* And return the file pointer from the list */
-
-  ret = _files_semtake(list);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
-  *filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                          [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
-
-  /* if f_inode is NULL, fd was closed */
-
-  if (!(*filep)->f_inode)
-    {
-      *filep = (FAR struct file *)NULL;
-      ret = -EBADF;
-    }
-
-  _files_semgive(list);
-
-  return ret;
+  return files_getfilep(list, fd, filep);
 }
 
 /****************************************************************************
@@ -0,0 +1,254 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The longest name that is remembered by a negative entry */
+
+#define INODE_CACHE_NAMELEN  15
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One cached look-up of the name of a node among its peers.  The entry is
+ * valid only as long as the inode tree has not been modified since it was
+ * made.
+ */
+
+struct inode_cache_s
+{
+  uint32_t gen;              /* Tree generation the entry belongs to */
+  uint32_t hash;             /* Hash of the parent and the name */
+  FAR struct inode *parent;  /* The parent of the peers, NULL: root level */
+  FAR struct inode *node;    /* The node found, NULL: negative entry */
+  FAR struct inode *peer;    /* The node to the "left" of the name */
+#ifdef CONFIG_FS_INODE_CACHE_NEGATIVE
+  char name[INODE_CACHE_NAMELEN + 1]; /* The name of a negative entry */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODE_CACHE_SIZE];
+
+/* Incremented each time that the inode tree is modified.  Zero never
+ * identifies a valid entry.
+ */
+
+static uint32_t g_inode_cache_gen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Hash the parent and the path segment 'name' (up to the next '/').
+ *   Return the length of the segment in 'len'.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_cache_hash(FAR struct inode *parent,
+                                 FAR const char *name, FAR size_t *len)
+{
+  uint32_t hash = (uint32_t)(uintptr_t)parent * 2654435761u;
+  FAR const char *ptr;
+
+  for (ptr = name; *ptr != '\0' && *ptr != '/'; ptr++)
+    {
+      hash = (hash ^ (uint8_t)*ptr) * 16777619u;
+    }
+
+  *len = ptr - name;
+  return hash;
+}
+
+/****************************************************************************
+ * Name: inode_cache_match
+ *
+ * Description:
+ *   Return true if the path segment 'name' of length 'len' is 'nname'.
+ *
+ ****************************************************************************/
+
+static bool inode_cache_match(FAR const char *name, size_t len,
+                              FAR const char *nname)
+{
+  return strncmp(name, nname, len) == 0 && nname[len] == '\0';
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the path segment 'name' among the children of 'parent' in the
+ *   cache.
+ *
+ * Input Parameters:
+ *   parent - The parent node, NULL for the children of the root
+ *   name   - The path segment, terminated by '/' or the end of the string
+ *   node   - The location to return the node found (NULL: no such node)
+ *   peer   - The location to return the node to the "left" of the name
+ *
+ * Returned Value:
+ *   OK if the look-up is in the cache, -ENOENT if it is not.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+int inode_cache_lookup(FAR struct inode *parent, FAR const char *name,
+                       FAR struct inode **node, FAR struct inode **peer)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash;
+  size_t len;
+
+  hash  = inode_cache_hash(parent, name, &len);
+  entry = &g_inode_cache[hash % CONFIG_FS_INODE_CACHE_SIZE];
+
+  if (entry->gen != g_inode_cache_gen || entry->hash != hash ||
+      entry->parent != parent)
+    {
+      return -ENOENT;
+    }
+
+  if (entry->node != NULL)
+    {
+      if (!inode_cache_match(name, len, entry->node->i_name))
+        {
+          return -ENOENT;
+        }
+    }
+#ifdef CONFIG_FS_INODE_CACHE_NEGATIVE
+  else if (!inode_cache_match(name, len, entry->name))
+#else
+  else
+#endif
+    {
+      return -ENOENT;
+    }
+
+  *node = entry->node;
+  *peer = entry->peer;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of looking up the path segment 'name' among the
+ *   children of 'parent'.  'node' is NULL if there is no such child.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR struct inode *parent, FAR const char *name,
+                     FAR struct inode *node, FAR struct inode *peer)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash;
+  size_t len;
+
+  hash = inode_cache_hash(parent, name, &len);
+
+#ifdef CONFIG_FS_INODE_CACHE_NEGATIVE
+  if (node == NULL && len > INODE_CACHE_NAMELEN)
+    {
+      return;
+    }
+#else
+  if (node == NULL)
+    {
+      return;
+    }
+#endif
+
+  entry         = &g_inode_cache[hash % CONFIG_FS_INODE_CACHE_SIZE];
+  entry->gen    = g_inode_cache_gen;
+  entry->hash   = hash;
+  entry->parent = parent;
+  entry->node   = node;
+  entry->peer   = peer;
+
+#ifdef CONFIG_FS_INODE_CACHE_NEGATIVE
+  if (node == NULL)
+    {
+      memcpy(entry->name, name, len);
+      entry->name[len] = '\0';
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Invalidate all cached look-ups.  Called each time a node is added to
+ *   or removed from the inode tree.
+ *
+ * Assumptions:
+ *   The caller holds the inode semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  if (++g_inode_cache_gen == 0)
+    {
+      /* Entries made before the counter wrapped must not become valid */
+
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cache_gen = 1;
+    }
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
@@ -40,6 +40,10 @@
  ****************************************************************************/
 
 static int _inode_compare(FAR const char *fname, FAR struct inode *node);
+static FAR struct inode *_inode_findpeer(FAR struct inode *node,
+                                         FAR struct inode *above,
+                                         FAR const char *name,
+                                         FAR struct inode **left);
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
 static int _inode_linktarget(FAR struct inode *node,
                              FAR struct inode_search_s *desc);
@@ -133,6 +137,78 @@ static int _inode_compare(FAR const char *fname, FAR struct inode *node)
     }
 }
 
+/****************************************************************************
+ * Name: _inode_findpeer
+ *
+ * Description:
+ *   Find the node with the name at the head of 'name' in the ordered list
+ *   of peers beginning with 'node'.  Return the node, or NULL, and in
+ *   'left' the node to the "left" of the name.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+static FAR struct inode *_inode_findpeer(FAR struct inode *node,
+                                         FAR struct inode *above,
+                                         FAR const char *name,
+                                         FAR struct inode **left)
+{
+  FAR struct inode *peer = NULL;
+
+#ifdef CONFIG_FS_INODE_CACHE
+  if (inode_cache_lookup(above, name, &node, left) >= 0)
+    {
+      return node;
+    }
+#endif
+
+  while (node != NULL)
+    {
+      int result = _inode_compare(name, node);
+
+      /* Case 1:  The name is less than the name of the node.
+       * Since the names are ordered, these means that there
+       * is no peer node with this name and that there can be
+       * no match in the filesystem.
+       */
+
+      if (result < 0)
+        {
+          node = NULL;
+          break;
+        }
+
+      /* Case 2: the name is greater than the name of the node.
+       * In this case, the name may still be in the list to the
+       * "right"
+       */
+
+      else if (result > 0)
+        {
+          /* Continue looking to the "right" of this inode. */
+
+          peer = node;
+          node = node->i_peer;
+        }
+
+      /* The names match */
+
+      else
+        {
+          break;
+        }
+    }
+
+#ifdef CONFIG_FS_INODE_CACHE
+  inode_cache_add(above, name, node, peer);
+#endif
+
+  *left = peer;
+  return node;
+}
+
 /****************************************************************************
  * Name: _inode_linktarget
  *
@@ -244,150 +320,126 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (node != NULL)
     {
-      int result = _inode_compare(name, node);
-
-      /* Case 1:  The name is less than the name of the node.
-       * Since the names are ordered, these means that there
-       * is no peer node with this name and that there can be
-       * no match in the filesystem.
-       */
+      /* Find the name among the peers of this level */
 
-      if (result < 0)
+      node = _inode_findpeer(node, above, name, &left);
+      if (node == NULL)
         {
-          node = NULL;
           break;
         }
 
-      /* Case 2: the name is greater than the name of the node.
-       * In this case, the name may still be in the list to the
-       * "right"
+      /* The names match.  Now there are three remaining possibilities:
+       *   (1) This is the node that we are looking for.
+       *   (2) The node we are looking for is "below" this one.
+       *   (3) This node is a mountpoint and will absorb all requests
+       *       below this one
        */
 
-      else if (result > 0)
+      name = inode_nextname(name);
+      if (*name == '\0' || INODE_IS_MOUNTPT(node))
         {
-          /* Continue looking to the "right" of this inode. */
+          /* Either (1) we are at the end of the path, so this must be
+           * the node we are looking for or else (2) this node is a
+           * mountpoint and will handle the remaining part of the
+           * pathname
+           */
 
-          left = node;
-          node = node->i_peer;
+          relpath = name;
+          ret = OK;
+          break;
         }
-
-      /* The names match */
-
       else
         {
-          /* Now there are three remaining possibilities:
-           *   (1) This is the node that we are looking for.
-           *   (2) The node we are looking for is "below" this one.
-           *   (3) This node is a mountpoint and will absorb all requests
-           *       below this one
-           */
+          /* More nodes to be examined in the path "below" this one. */
 
-          name = inode_nextname(name);
-          if (*name == '\0' || INODE_IS_MOUNTPT(node))
-            {
-              /* Either (1) we are at the end of the path, so this must be
-               * the node we are looking for or else (2) this node is a
-               * mountpoint and will handle the remaining part of the
-               * pathname
-               */
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+          /* Was the node a soft link?  If so, then we need need to
+           * continue below the target of the link, not the link itself.
+           */
 
-              relpath = name;
-              ret = OK;
-              break;
-            }
-          else
+          if (INODE_IS_SOFTLINK(node))
             {
-              /* More nodes to be examined in the path "below" this one. */
+              int status;
 
-#ifdef CONFIG_PSEUDOFS_SOFTLINKS
-              /* Was the node a soft link?  If so, then we need need to
-               * continue below the target of the link, not the link itself.
+              /* If this intermediate inode in the is a soft link, then
+               * (1) recursively look-up the inode referenced by the
+               * soft link, and (2) continue searching with that inode
+               * instead.
                */
 
-              if (INODE_IS_SOFTLINK(node))
+              status = _inode_linktarget(node, desc);
+              if (status < 0)
                 {
-                  int status;
-
-                  /* If this intermediate inode in the is a soft link, then
-                   * (1) recursively look-up the inode referenced by the
-                   * soft link, and (2) continue searching with that inode
-                   * instead.
+                  /* Probably means that the target of the symbolic link
+                   * does not exist.
                    */
 
-                  status = _inode_linktarget(node, desc);
-                  if (status < 0)
+                  ret = status;
+                  break;
+                }
+              else
+                {
+                  FAR struct inode *newnode = desc->node;
+
+                  if (newnode != node)
                     {
-                      /* Probably means that the target of the symbolic link
-                       * does not exist.
+                      /* The node was a valid symbolic link and we have
+                       * jumped to a different, spot in the pseudo file
+                       * system tree.
                        */
 
-                      ret = status;
-                      break;
-                    }
-                  else
-                    {
-                      FAR struct inode *newnode = desc->node;
+                      /* Check if this took us to a mountpoint. */
 
-                      if (newnode != node)
+                      if (INODE_IS_MOUNTPT(newnode))
                         {
-                          /* The node was a valid symbolic link and we have
-                           * jumped to a different, spot in the pseudo file
-                           * system tree.
+                          /* Return the mountpoint information.
+                           * NOTE that the last path to the link target
+                           * was already set by _inode_linktarget().
                            */
 
-                          /* Check if this took us to a mountpoint. */
+                          node    = newnode;
+                          above   = desc->parent;
+                          left    = desc->peer;
+                          ret     = OK;
 
-                          if (INODE_IS_MOUNTPT(newnode))
+                          if (*desc->relpath != '\0')
                             {
-                              /* Return the mountpoint information.
-                               * NOTE that the last path to the link target
-                               * was already set by _inode_linktarget().
-                               */
+                              char *buffer = NULL;
 
-                              node    = newnode;
-                              above   = desc->parent;
-                              left    = desc->peer;
-                              ret     = OK;
-
-                              if (*desc->relpath != '\0')
+                              asprintf(&buffer,
+                                       "%s/%s", desc->relpath, name);
+                              if (buffer != NULL)
                                 {
-                                  char *buffer = NULL;
-
-                                  asprintf(&buffer,
-                                           "%s/%s", desc->relpath, name);
-                                  if (buffer != NULL)
-                                    {
-                                      kmm_free(desc->buffer);
-                                      desc->buffer = buffer;
-                                      relpath = buffer;
-                                    }
-                                  else
-                                    {
-                                      ret = -ENOMEM;
-                                    }
+                                  kmm_free(desc->buffer);
+                                  desc->buffer = buffer;
+                                  relpath = buffer;
                                 }
                               else
                                 {
-                                  relpath = name;
+                                  ret = -ENOMEM;
                                 }
-
-                              break;
+                            }
+                          else
+                            {
+                              relpath = name;
                             }
 
-                          /* Continue from this new inode. */
-
-                          node = newnode;
+                          break;
                         }
+
+                      /* Continue from this new inode. */
+
+                      node = newnode;
                     }
                 }
+            }
 #endif
 
-              /* Keep looking at the next level "down" */
+          /* Keep looking at the next level "down" */
 
-              above = node;
-              left  = NULL;
-              node  = node->i_child;
-            }
+          above = node;
+          left  = NULL;
+          node  = node->i_child;
         }
     }
 
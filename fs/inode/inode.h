@@ -53,6 +53,10 @@
     } \
   while (0)
 
+#ifndef CONFIG_FS_INODE_CACHE
+#  define inode_cache_invalidate()
+#endif
+
 #define RELEASE_SEARCH(d) \
   do \
     { \
@@ -202,6 +206,55 @@ int inode_checkflags(FAR struct inode *inode, int oflags);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the path segment 'name' among the children of 'parent' in the
+ *   path look-up cache.  On success, return the node found (NULL if there
+ *   is no such node) and the node to the "left" of the name.
+ *
+ * Returned Value:
+ *   OK if the look-up is in the cache, -ENOENT if it is not.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+int inode_cache_lookup(FAR struct inode *parent, FAR const char *name,
+                       FAR struct inode **node, FAR struct inode **peer);
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember the result of looking up the path segment 'name' among the
+ *   children of 'parent'.  'node' is NULL if there is no such child.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR struct inode *parent, FAR const char *name,
+                     FAR struct inode *node, FAR struct inode *peer);
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Invalidate all cached look-ups because the inode tree was modified.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void);
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
@@ -26,6 +26,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nuttx/fs/fs.h>
@@ -39,6 +40,15 @@
 #include "littlefs/lfs.h"
 #include "littlefs/lfs_util.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Format requests of the mount options */
+
+#define LITTLEFS_FORCEFORMAT  (1 << 0)  /* -o forceformat */
+#define LITTLEFS_AUTOFORMAT   (1 << 1)  /* -o autoformat */
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -1018,6 +1028,66 @@ static int littlefs_sync_block(FAR const struct lfs_config *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description:
+ *   Parse the comma separated mount options.  The options we support are:
+ *
+ *     forceformat         Format the device before mounting it
+ *     autoformat          Format the device if it cannot be mounted
+ *     cache_size=<n>      The size of the caches in bytes
+ *     lookahead_size=<n>  The size of the lookahead buffer in bytes
+ *
+ ****************************************************************************/
+
+static int littlefs_parse_options(FAR const char *data,
+                                  FAR struct lfs_config *cfg,
+                                  FAR int *format)
+{
+  FAR char *options;
+  FAR char *saveptr;
+  FAR char *ptr;
+
+  *format = 0;
+  if (data == NULL)
+    {
+      return OK;
+    }
+
+  options = strdup(data);
+  if (options == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ptr = strtok_r(options, ",", &saveptr);
+  while (ptr != NULL)
+    {
+      if (strcmp(ptr, "forceformat") == 0)
+        {
+          *format |= LITTLEFS_FORCEFORMAT;
+        }
+      else if (strcmp(ptr, "autoformat") == 0)
+        {
+          *format |= LITTLEFS_AUTOFORMAT;
+        }
+      else if (strncmp(ptr, "cache_size=", 11) == 0)
+        {
+          cfg->cache_size = strtoul(&ptr[11], NULL, 0);
+        }
+      else if (strncmp(ptr, "lookahead_size=", 15) == 0)
+        {
+          cfg->lookahead_size = strtoul(&ptr[15], NULL, 0);
+        }
+
+      ptr = strtok_r(NULL, ",", &saveptr);
+    }
+
+  kmm_free(options);
+  return OK;
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -1026,6 +1096,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  int format;
   int ret;
 
   /* Open the block driver */
@@ -1113,10 +1184,42 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.block_size     = fs->geo.erasesize;
   fs->cfg.block_count    = fs->geo.neraseblocks;
   fs->cfg.block_cycles   = CONFIG_FS_LITTLEFS_BLOCK_CYCLE;
-  fs->cfg.cache_size     = fs->geo.blocksize *
-                           CONFIG_FS_LITTLEFS_BLOCK_FACTOR;
+#if CONFIG_FS_LITTLEFS_CACHE_SIZE > 0
+  fs->cfg.cache_size     = CONFIG_FS_LITTLEFS_CACHE_SIZE;
+#else
+  fs->cfg.cache_size     = fs->cfg.read_size;
+#endif
+#if CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE > 0
+  fs->cfg.lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
+#else
   fs->cfg.lookahead_size = lfs_min(lfs_alignup(fs->cfg.block_count, 64) / 8,
                                    fs->cfg.read_size);
+#endif
+
+  /* The mount options may override the cache and lookahead sizes */
+
+  ret = littlefs_parse_options(data, &fs->cfg, &format);
+  if (ret < 0)
+    {
+      goto errout_with_fs;
+    }
+
+  /* littlefs requires the caches to hold whole read and program units and
+   * to fit evenly into an erase block.
+   */
+
+  if (fs->cfg.cache_size == 0 ||
+      fs->cfg.cache_size % fs->cfg.read_size != 0 ||
+      fs->cfg.cache_size % fs->cfg.prog_size != 0 ||
+      fs->cfg.block_size % fs->cfg.cache_size != 0 ||
+      fs->cfg.lookahead_size == 0 || fs->cfg.lookahead_size % 8 != 0)
+    {
+      ferr("ERROR: Invalid cache size %lu or lookahead size %lu\n",
+           (unsigned long)fs->cfg.cache_size,
+           (unsigned long)fs->cfg.lookahead_size);
+      ret = -EINVAL;
+      goto errout_with_fs;
+    }
 
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
@@ -1124,7 +1227,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if ((format & LITTLEFS_FORCEFORMAT) != 0)
     {
       ret = littlefs_convert_result(lfs_format(&fs->lfs, &fs->cfg));
       if (ret < 0)
@@ -1138,7 +1241,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != -EFAULT || !data || strcmp(data, "autoformat"))
+      if (ret != -EFAULT || (format & LITTLEFS_AUTOFORMAT) == 0)
         {
           goto errout_with_fs;
         }
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "inode/inode.h"
+#include "fs_rammap.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_msync_
+ ****************************************************************************/
+
+static int file_msync_(FAR void *addr, size_t len, int flags)
+{
+#ifdef CONFIG_FS_RAMMAP
+  FAR struct fs_rammap_s *curr;
+  uintptr_t start = (uintptr_t)addr;
+  int ret;
+#endif
+
+  if ((flags & ~(MS_ASYNC | MS_SYNC | MS_INVALIDATE)) != 0 ||
+      (flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_FS_RAMMAP
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Find the region containing the start address */
+
+  for (curr = g_rammaps.head; curr; curr = curr->flink)
+    {
+      if (start >= (uintptr_t)curr->addr &&
+          start < (uintptr_t)curr->addr + curr->length)
+        {
+          break;
+        }
+    }
+
+  if (curr == NULL)
+    {
+      ferr("ERROR: Region not found\n");
+      ret = -ENOMEM;
+    }
+  else
+    {
+      /* MS_ASYNC is performed synchronously, too: There is nobody else to
+       * do the write back later.
+       */
+
+      ret = rammap_sync(curr, start - (uintptr_t)curr->addr, len);
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
+  return ret;
+#else
+  /* Files are mapped directly from the media: There is nothing to write */
+
+  return OK;
+#endif /* CONFIG_FS_RAMMAP */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   Write the changes of a writable MAP_SHARED mapping of a file that was
+ *   copied into RAM (see CONFIG_FS_RAMMAP) back to the file.  Mappings of
+ *   all other kinds have nothing to write back.
+ *
+ * Input Parameters:
+ *   addr  - An address within the mapping
+ *   len   - The number of bytes to write back
+ *   flags - MS_ASYNC or MS_SYNC, optionally with MS_INVALIDATE
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set:
+ *
+ *     EINVAL
+ *       'flags' is invalid.
+ *     ENOMEM
+ *       'addr' is not within a mapped region.
+ *     EIO
+ *       The changes could not be written back.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *addr, size_t len, int flags)
+{
+  int ret;
+
+  ret = file_msync_(addr, len, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+}
@@ -106,7 +106,28 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
 
   if (length >= curr->length)
     {
-      /* Yes.. remove the mapping from the list */
+      /* Yes.. the region stays in place as long as other mappers of a
+       * MAP_SHARED region remain.
+       */
+
+      if (--curr->crefs > 0)
+        {
+          goto out_with_semaphore;
+        }
+
+      /* Write back the changes of the last mapper.  A failure cannot be
+       * reported to anybody who could still do something about it.
+       */
+
+      rammap_sync(curr, 0, curr->length);
+      file_close(&curr->file);
+
+      if (curr->inode != NULL)
+        {
+          inode_release(curr->inode);
+        }
+
+      /* Remove the mapping from the list */
 
       if (prev)
         {
@@ -135,22 +156,39 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
 
   else
     {
+      /* The other mappers of a shared region still use the memory */
+
+      if (curr->crefs > 1)
+        {
+          ferr("ERROR: Cannot unmap a part of a shared region\n");
+          ret = -ENOSYS;
+          goto errout_with_semaphore;
+        }
+
+      rammap_sync(curr, offset, length);
+
       if (kernel)
         {
-          newaddr = kmm_realloc(curr->addr,
-                               sizeof(struct fs_rammap_s) + length);
+          newaddr = kmm_realloc(curr,
+                                sizeof(struct fs_rammap_s) + offset);
         }
       else
         {
-          newaddr = kumm_realloc(curr->addr,
-                                sizeof(struct fs_rammap_s) + length);
+          newaddr = kumm_realloc(curr,
+                                 sizeof(struct fs_rammap_s) + offset);
         }
 
-      DEBUGASSERT(newaddr == (FAR void *)(curr->addr));
+      DEBUGASSERT(newaddr == (FAR void *)curr);
       UNUSED(newaddr); /* May not be used */
-      curr->length = length;
+      curr->length = offset;
+
+      if (curr->filelen > offset)
+        {
+          curr->filelen = offset;
+        }
     }
 
+out_with_semaphore:
   nxsem_post(&g_rammaps.exclsem);
   return OK;
 
@@ -26,9 +26,12 @@
 
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -40,6 +43,14 @@
 
 #ifdef CONFIG_FS_RAMMAP
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -51,6 +62,73 @@ struct fs_allmaps_s g_rammaps =
   SEM_INITIALIZER(1)
 };
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_ident
+ *
+ * Description:
+ *   Return a value that tells apart the files opened on the same inode.
+ *   Driver and pseudo-files are identified by their inode alone.  Files
+ *   on a mounted volume are identified by their serial number, if the file
+ *   system provides one, or else by their open file structure, so that at
+ *   least the mappers of the same open file share the region.
+ *
+ ****************************************************************************/
+
+static uintptr_t rammap_ident(FAR struct file *filep)
+{
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  struct stat buf;
+
+  if (INODE_IS_MOUNTPT(filep->f_inode))
+    {
+      if (file_fstat(filep, &buf) >= 0 && buf.st_ino != 0)
+        {
+          return (uintptr_t)buf.st_ino;
+        }
+
+      return (uintptr_t)filep->f_priv;
+    }
+#endif
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: rammap_find
+ *
+ * Description:
+ *   Find a MAP_SHARED region of the file that starts at 'offset' and is at
+ *   least 'length' bytes long and add a reference to it.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+static FAR struct fs_rammap_s *rammap_find(FAR struct file *filep,
+                                           uintptr_t ident, size_t length,
+                                           off_t offset, bool kernel)
+{
+  FAR struct fs_rammap_s *curr;
+
+  for (curr = g_rammaps.head; curr != NULL; curr = curr->flink)
+    {
+      if (curr->inode == filep->f_inode && curr->ident == ident &&
+          curr->offset == offset && curr->length >= length &&
+          curr->kernel == kernel && curr->crefs < UINT16_MAX)
+        {
+          curr->crefs++;
+          return curr;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -66,6 +144,8 @@ struct fs_allmaps_s g_rammaps =
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -81,29 +161,43 @@ struct fs_allmaps_s g_rammaps =
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped)
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           int prot, int flags, bool kernel, FAR void **mapped)
 {
   FAR struct fs_rammap_s *map;
   FAR uint8_t *alloc;
   FAR uint8_t *rdbuffer;
+  bool shared = (flags & MAP_SHARED) != 0;
+  uintptr_t ident = 0;
   ssize_t nread;
-  off_t fpos;
+  size_t remaining;
   int ret;
 
-  /* There is a major design flaw that I have not yet thought of fix for:
-   * The goal is to have a single region of memory that represents a single
-   * file and can be shared by many threads.  That is, given a filename a
-   * thread should be able to open the file, get a file descriptor, and
-   * call mmap() to get a memory region.  Different file descriptors opened
-   * with the same file path should get the same memory region when mapped.
-   *
-   * The design flaw is that I don't have sufficient knowledge to know that
-   * these different file descriptors map to the same file.  So, for the time
-   * being, a new memory region is created each time that rammap() is called.
-   * Not very useful!
+  /* Different mappers of the same MAP_SHARED region of a file get the same
+   * memory so that they see each other's changes.  MAP_PRIVATE mappings
+   * always get a copy of their own.
    */
 
+  if (shared)
+    {
+      ident = rammap_ident(filep);
+
+      ret = nxsem_wait(&g_rammaps.exclsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      map = rammap_find(filep, ident, length, offset, kernel);
+      nxsem_post(&g_rammaps.exclsem);
+
+      if (map != NULL)
+        {
+          *mapped = map->addr;
+          return OK;
+        }
+    }
+
   /* Allocate a region of memory of the specified size */
 
   alloc = kernel ?
@@ -122,27 +216,19 @@ int rammap(FAR struct file *filep, size_t length,
   map->addr   = alloc + sizeof(struct fs_rammap_s);
   map->length = length;
   map->offset = offset;
+  map->crefs  = 1;
+  map->kernel = kernel;
 
-  /* Seek to the specified file offset */
-
-  fpos = file_seek(filep, offset, SEEK_SET);
-  if (fpos < 0)
-    {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
-       */
-
-      ferr("ERROR: Seek to position %d failed\n", (int)offset);
-      ret = fpos;
-      goto errout_with_region;
-    }
-
-  /* Read the file data into the memory region */
+  /* Read the file data into the memory region.  The file position is left
+   * untouched.
+   */
 
-  rdbuffer = map->addr;
-  while (length > 0)
+  rdbuffer  = map->addr;
+  remaining = length;
+  while (remaining > 0)
     {
-      nread = file_read(filep, rdbuffer, length);
+      nread = file_pread(filep, rdbuffer, remaining,
+                         offset + (rdbuffer - (FAR uint8_t *)map->addr));
       if (nread < 0)
         {
           /* Handle the special case where the read was interrupted by a
@@ -159,6 +245,8 @@ int rammap(FAR struct file *filep, size_t length,
               ret = nread;
               goto errout_with_region;
             }
+
+          continue;
         }
 
       /* Check for end of file. */
@@ -170,20 +258,48 @@ int rammap(FAR struct file *filep, size_t length,
 
       /* Increment number of bytes read */
 
-      rdbuffer += nread;
-      length   -= nread;
+      rdbuffer  += nread;
+      remaining -= nread;
     }
 
   /* Zero any memory beyond the amount read from the file */
 
-  memset(rdbuffer, 0, length);
+  memset(rdbuffer, 0, remaining);
+  map->filelen = length - remaining;
+
+  /* A writable MAP_SHARED region keeps its own reference to the file so
+   * that the changes can be written back after the file descriptor has
+   * been closed.
+   */
+
+  if (shared)
+    {
+      ret = inode_addref(filep->f_inode);
+      if (ret < 0)
+        {
+          goto errout_with_region;
+        }
+
+      map->inode = filep->f_inode;
+      map->ident = ident;
+
+      if ((prot & PROT_WRITE) != 0 && (filep->f_oflags & O_WROK) != 0)
+        {
+          ret = file_dup2(filep, &map->file);
+          if (ret < 0)
+            {
+              ferr("ERROR: file_dup2() failed: %d\n", ret);
+              goto errout_with_file;
+            }
+        }
+    }
 
   /* Add the buffer to the list of regions */
 
   ret = nxsem_wait(&g_rammaps.exclsem);
   if (ret < 0)
     {
-      goto errout_with_region;
+      goto errout_with_file;
     }
 
   map->flink = g_rammaps.head;
@@ -193,6 +309,14 @@ int rammap(FAR struct file *filep, size_t length,
   *mapped = map->addr;
   return OK;
 
+errout_with_file:
+  file_close(&map->file);
+
+  if (map->inode != NULL)
+    {
+      inode_release(map->inode);
+    }
+
 errout_with_region:
   if (kernel)
     {
@@ -206,4 +330,59 @@ errout_with_region:
   return ret;
 }
 
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write the part of a writable MAP_SHARED region that starts 'offset'
+ *   bytes into the region and extends for 'length' bytes back to the file.
+ *   Only the part of the region that was read from the file is written, so
+ *   writing back never extends the file.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length)
+{
+  FAR const uint8_t *wrbuffer;
+  ssize_t nwritten;
+
+  if (map->file.f_inode == NULL || offset >= map->filelen)
+    {
+      return OK;
+    }
+
+  length   = MIN(length, map->filelen - offset);
+  wrbuffer = (FAR const uint8_t *)map->addr + offset;
+
+  while (length > 0)
+    {
+      nwritten = file_pwrite(&map->file, wrbuffer, length,
+                             map->offset + offset);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write back failed: offset=%d ret=%d\n",
+               (int)(map->offset + offset), (int)nwritten);
+          return nwritten;
+        }
+      else if (nwritten == 0)
+        {
+          return -EIO;
+        }
+
+      wrbuffer += nwritten;
+      offset   += nwritten;
+      length   -= nwritten;
+    }
+
+  return OK;
+}
+
 #endif /* CONFIG_FS_RAMMAP */
@@ -28,6 +28,10 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 
 #ifdef CONFIG_FS_RAMMAP
@@ -48,9 +52,13 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes to a writable MAP_SHARED mapping reach the file only when
+ *   msync() is called or when the region is unmapped; all other mappings
+ *   are never written back.
  * - There are not access privileges.
+ *
+ * MAP_SHARED regions of the same file and offset are shared between all
+ * mappers and freed when the last of them unmaps the region.
  */
 
 struct fs_rammap_s
@@ -59,6 +67,12 @@ struct fs_rammap_s
   FAR void           *addr;        /* Start of allocated memory */
   size_t              length;      /* Length of region */
   off_t               offset;      /* File offset */
+  FAR struct inode   *inode;       /* The inode of a MAP_SHARED region */
+  uintptr_t           ident;       /* Identifies the file within 'inode' */
+  size_t              filelen;     /* Bytes of the region backed by the file */
+  uint16_t            crefs;       /* Number of mappers of the region */
+  bool                kernel;      /* Allocated with kmm_malloc() */
+  struct file         file;        /* Write-back file (f_inode may be NULL) */
 };
 
 /* This structure defines all "mapped" files */
@@ -92,6 +106,8 @@ extern struct fs_allmaps_s g_rammaps;
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -107,8 +123,26 @@ extern struct fs_allmaps_s g_rammaps;
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped);
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           int prot, int flags, bool kernel, FAR void **mapped);
+
+/****************************************************************************
+ * Name: rammap_sync
+ *
+ * Description:
+ *   Write the part of a writable MAP_SHARED region that starts 'offset'
+ *   bytes into the region and extends for 'length' bytes back to the file.
+ *   Regions without a write-back file are silently ignored.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The caller holds g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+int rammap_sync(FAR struct fs_rammap_s *map, size_t offset, size_t length);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_FS_RAMMAP_H */
@@ -125,7 +125,7 @@ static int nxmq_file_poll(FAR struct file *filep,
 
       /* Immediately notify on any of the requested events */
 
-      if (msgq->nmsgs < msgq->maxmsgs)
+      if (!nxmq_isfull(msgq))
         {
           eventset |= (fds->events & POLLOUT);
         }
@@ -390,7 +390,7 @@ void nxmq_pollnotify(FAR struct mqueue_inode_s *msgq, pollevent_t eventset)
               nxsem_get_value(fds->sem, &semcount);
               if (semcount < 1)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
         }
@@ -49,6 +49,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <time.h>
 #include <nuttx/semaphore.h>
 
 #include "rpc.h"
@@ -57,10 +58,31 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_NFS_LOOKUP_CACHE_SIZE
+#  define CONFIG_NFS_LOOKUP_CACHE_SIZE 0
+#endif
+
+/* The longest name remembered by the look-up cache */
+
+#define NFS_LOOKUP_NAMELEN 31
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One cached LOOKUP result.  The entry is unused if the name is empty. */
+
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+struct nfs_lookup_s
+{
+  clock_t                   l_expire;         /* The entry is stale from then on */
+  struct file_handle        l_dir;            /* The directory looked in */
+  struct file_handle        l_obj;            /* The object found */
+  struct nfs_fattr          l_fattr;          /* The attributes of the object */
+  char                      l_name[NFS_LOOKUP_NAMELEN + 1];
+};
+#endif
+
 /* Mount structure. One mount structure is allocated for each NFS mount. This
  * structure holds NFS specific information for mount.
  */
@@ -79,6 +101,9 @@ struct nfsmount
   uint16_t                  nm_wsize;         /* Max size of write RPC */
   uint16_t                  nm_readdirsize;   /* Size of a readdir RPC */
   uint16_t                  nm_buflen;        /* Size of I/O buffer */
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+  struct nfs_lookup_s       nm_lookup[CONFIG_NFS_LOOKUP_CACHE_SIZE];
+#endif
 
   /* Set aside memory on the stack to hold the largest call message.
    * NOTE that for the case of the write call message, it is the reply
@@ -70,6 +70,11 @@ struct nfsnode
   struct timespec     n_ctime;      /* File creation time */
   nfsfh_t             n_fhandle;    /* NFS File Handle */
   uint64_t            n_size;       /* Current size of file */
+#ifdef CONFIG_NFS_READAHEAD
+  FAR uint8_t        *n_rabuf;      /* Read-ahead data (nm_rsize bytes) */
+  uint64_t            n_raoff;      /* File offset of the read-ahead data */
+  size_t              n_ralen;      /* Number of bytes in n_rabuf */
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
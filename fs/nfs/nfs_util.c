@@ -36,6 +36,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+
 #include "rpc.h"
 #include "nfs.h"
 #include "nfs_proto.h"
@@ -47,6 +49,140 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nfs_lookup_slot
+ *
+ * Description:
+ *   Return the look-up cache entry of 'name' in the directory 'dir'.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+static FAR struct nfs_lookup_s *
+nfs_lookup_slot(FAR struct nfsmount *nmp, FAR const char *name,
+                FAR const struct file_handle *dir)
+{
+  FAR const uint8_t *ptr = (FAR const uint8_t *)&dir->handle;
+  uint32_t hash = 2166136261u;
+  uint32_t i;
+
+  for (i = 0; i < dir->length; i++)
+    {
+      hash = (hash ^ ptr[i]) * 16777619u;
+    }
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return &nmp->nm_lookup[hash % CONFIG_NFS_LOOKUP_CACHE_SIZE];
+}
+
+/****************************************************************************
+ * Name: nfs_lookup_cached
+ *
+ * Description:
+ *   Return true if the look-up of 'name' in the directory 'fhandle' is
+ *   cached.  In that case, 'fhandle' is replaced with the handle of the
+ *   object found.
+ *
+ ****************************************************************************/
+
+static bool nfs_lookup_cached(FAR struct nfsmount *nmp,
+                              FAR const char *name,
+                              FAR struct file_handle *fhandle,
+                              FAR struct nfs_fattr *obj_attributes)
+{
+  FAR struct nfs_lookup_s *entry = nfs_lookup_slot(nmp, name, fhandle);
+
+  if (entry->l_name[0] == '\0' || strcmp(entry->l_name, name) != 0 ||
+      entry->l_dir.length != fhandle->length ||
+      memcmp(&entry->l_dir.handle, &fhandle->handle, fhandle->length) != 0)
+    {
+      return false;
+    }
+
+  if ((sclock_t)(clock_systime_ticks() - entry->l_expire) >= 0)
+    {
+      entry->l_name[0] = '\0';
+      return false;
+    }
+
+  memcpy(fhandle, &entry->l_obj, sizeof(struct file_handle));
+  if (obj_attributes)
+    {
+      memcpy(obj_attributes, &entry->l_fattr, sizeof(struct nfs_fattr));
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: nfs_lookup_add
+ *
+ * Description:
+ *   Remember the look-up of 'name' in the directory 'dir'.
+ *
+ ****************************************************************************/
+
+static void nfs_lookup_add(FAR struct nfsmount *nmp, FAR const char *name,
+                           FAR const struct file_handle *dir,
+                           FAR const struct file_handle *obj,
+                           FAR const struct nfs_fattr *fattr)
+{
+  FAR struct nfs_lookup_s *entry;
+
+  if (strlen(name) > NFS_LOOKUP_NAMELEN)
+    {
+      return;
+    }
+
+  entry           = nfs_lookup_slot(nmp, name, dir);
+  entry->l_expire = clock_systime_ticks() +
+                    MSEC2TICK(CONFIG_NFS_LOOKUP_CACHE_MSEC);
+  memcpy(&entry->l_dir, dir, sizeof(struct file_handle));
+  memcpy(&entry->l_obj, obj, sizeof(struct file_handle));
+  memcpy(&entry->l_fattr, fattr, sizeof(struct nfs_fattr));
+  strlcpy(entry->l_name, name, sizeof(entry->l_name));
+}
+
+/****************************************************************************
+ * Name: nfs_lookup_flush
+ *
+ * Description:
+ *   Forget all cached look-ups if the RPC 'procnum' modifies the server.
+ *
+ ****************************************************************************/
+
+static void nfs_lookup_flush(FAR struct nfsmount *nmp, int procnum)
+{
+  int i;
+
+  switch (procnum)
+    {
+      case NFSPROC_SETATTR:
+      case NFSPROC_WRITE:
+      case NFSPROC_CREATE:
+      case NFSPROC_MKDIR:
+      case NFSPROC_SYMLINK:
+      case NFSPROC_MKNOD:
+      case NFSPROC_REMOVE:
+      case NFSPROC_RMDIR:
+      case NFSPROC_RENAME:
+      case NFSPROC_LINK:
+        for (i = 0; i < CONFIG_NFS_LOOKUP_CACHE_SIZE; i++)
+          {
+            nmp->nm_lookup[i].l_name[0] = '\0';
+          }
+        break;
+
+      default:
+        break;
+    }
+}
+#endif
+
 static inline int nfs_pathsegment(FAR const char **path, FAR char *buffer,
                                   FAR char *terminator)
 {
@@ -123,6 +259,10 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
   struct nfs_reply_header replyh;
   int error;
 
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+  nfs_lookup_flush(nmp, procnum);
+#endif
+
   error = rpcclnt_request(clnt, procnum, NFS_PROG, NFS_VER3,
                           request, reqlen, response, resplen);
   if (error != 0)
@@ -201,6 +341,9 @@ int nfs_lookup(FAR struct nfsmount *nmp, FAR const char *filename,
   int reqlen;
   int namelen;
   int error = 0;
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+  struct file_handle dir;
+#endif
 
   DEBUGASSERT(nmp && filename && fhandle);
 
@@ -213,6 +356,18 @@ int nfs_lookup(FAR struct nfsmount *nmp, FAR const char *filename,
       return -E2BIG;
     }
 
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+  /* The cache does not hold the attributes of the directory */
+
+  if (dir_attributes == NULL &&
+      nfs_lookup_cached(nmp, filename, fhandle, obj_attributes))
+    {
+      return OK;
+    }
+
+  memcpy(&dir, fhandle, sizeof(struct file_handle));
+#endif
+
   /* Initialize the request */
 
   ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.lookup.lookup;
@@ -284,6 +439,10 @@ int nfs_lookup(FAR struct nfsmount *nmp, FAR const char *filename,
           memcpy(obj_attributes, ptr, sizeof(struct nfs_fattr));
         }
 
+#if CONFIG_NFS_LOOKUP_CACHE_SIZE > 0
+      nfs_lookup_add(nmp, filename, &dir, fhandle,
+                     (FAR const struct nfs_fattr *)ptr);
+#endif
       ptr += uint32_increment(sizeof(struct nfs_fattr));
     }
 
@@ -422,6 +422,10 @@ static int nfs_filechstat(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
 
   finfo("Changing file status\n");
 
+#ifdef CONFIG_NFS_READAHEAD
+  np->n_ralen = 0;
+#endif
+
   /* Create the SETATTR RPC call arguments */
 
   ptr    = (FAR uint32_t *)&nmp->nm_msgbuffer.setattr.setattr;
@@ -860,6 +864,9 @@ static int nfs_close(FAR struct file *filep)
 
               /* Then deallocate the file structure and return success */
 
+#ifdef CONFIG_NFS_READAHEAD
+              kmm_free(np->n_rabuf);
+#endif
               kmm_free(np);
               ret = OK;
               break;
@@ -888,9 +895,12 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
   FAR struct nfsnode        *np;
   ssize_t                    readsize;
   ssize_t                    tmp;
-  ssize_t                    bytesread;
+  ssize_t                    bytesread = 0;
   size_t                     reqlen;
   FAR uint32_t              *ptr;
+#ifdef CONFIG_NFS_READAHEAD
+  ssize_t                    wanted;
+#endif
   int                        ret = 0;
 
   finfo("Read %zu bytes from offset %jd\n",
@@ -924,9 +934,32 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
       finfo("Read size truncated to %zu\n", buflen);
     }
 
+#ifdef CONFIG_NFS_READAHEAD
+  /* Take what the read-ahead buffer holds first */
+
+  if (np->n_ralen > 0 && filep->f_pos >= np->n_raoff &&
+      filep->f_pos < np->n_raoff + np->n_ralen)
+    {
+      bytesread = np->n_raoff + np->n_ralen - filep->f_pos;
+      if (bytesread > buflen)
+        {
+          bytesread = buflen;
+        }
+
+      memcpy(buffer, np->n_rabuf + (filep->f_pos - np->n_raoff), bytesread);
+      filep->f_pos += bytesread;
+      buffer       += bytesread;
+    }
+
+  if (bytesread < buflen && np->n_rabuf == NULL)
+    {
+      np->n_rabuf = kmm_malloc(nmp->nm_rsize);
+    }
+#endif
+
   /* Now loop until we fill the user buffer (or hit the end of the file) */
 
-  for (bytesread = 0; bytesread < buflen; )
+  while (bytesread < buflen)
     {
       /* Make sure that the attempted read size does not exceed the RPC
        * maximum
@@ -938,6 +971,16 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
           readsize = nmp->nm_rsize;
         }
 
+#ifdef CONFIG_NFS_READAHEAD
+      /* Read a full block and keep the rest for the next read */
+
+      wanted = readsize;
+      if (np->n_rabuf != NULL)
+        {
+          readsize = nmp->nm_rsize;
+        }
+#endif
+
       /* Make sure that the attempted read size does not exceed the IO buffer
        * size
        */
@@ -1021,6 +1064,16 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
       readsize = fxdr_unsigned(uint32_t, *ptr);
       ptr++;
 
+#ifdef CONFIG_NFS_READAHEAD
+      if (readsize > wanted)
+        {
+          np->n_raoff = filep->f_pos + wanted;
+          np->n_ralen = readsize - wanted;
+          memcpy(np->n_rabuf, (FAR uint8_t *)ptr + wanted, np->n_ralen);
+          readsize    = wanted;
+        }
+#endif
+
       /* Copy the read data into the user buffer */
 
       memcpy(buffer, ptr, readsize);
@@ -1088,6 +1141,10 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       return (ssize_t)ret;
     }
 
+#ifdef CONFIG_NFS_READAHEAD
+  np->n_ralen = 0;
+#endif
+
   /* Check if the file size would exceed the range of off_t */
 
   if (np->n_size + buflen < np->n_size)
@@ -241,6 +241,16 @@ struct nxffs_blkentry_s
   uint16_t                  foffset;  /* Offset to start of data */
 };
 
+/* One entry of the RAM index of the inodes */
+
+#ifdef CONFIG_NXFFS_INDEX
+struct nxffs_index_s
+{
+  uint32_t                  hash;      /* Hash of the file name */
+  off_t                     hoffset;   /* FLASH offset to the inode header */
+};
+#endif
+
 /* This structure describes the state of one open file.  This structure
  * is protected by the volume semaphore.
  */
@@ -287,6 +297,12 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#ifdef CONFIG_NXFFS_INDEX
+  bool                      idxvalid;  /* The index may be used */
+  bool                      idxfull;   /* Some inodes are not in the index */
+  uint16_t                  nindex;    /* Number of entries in the index */
+  struct nxffs_index_s      index[CONFIG_NXFFS_INDEX_SIZE];
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -1050,6 +1066,42 @@ int nxffs_rdblkhdr(FAR struct nxffs_volume_s *volume, off_t offset,
 
 int nxffs_rminode(FAR struct nxffs_volume_s *volume, FAR const char *name);
 
+/****************************************************************************
+ * Name: nxffs_index_reset, nxffs_index_invalidate, nxffs_index_add,
+ *       nxffs_index_remove and nxffs_index_find
+ *
+ * Description:
+ *   Maintain the RAM index of the inode headers:
+ *
+ *   - nxffs_index_reset() empties the index and makes it valid before the
+ *     volume is scanned and nxffs_index_add() is called for every inode.
+ *   - nxffs_index_invalidate() discards the index when inodes move.  The
+ *     next nxffs_index_find() rebuilds it.
+ *   - nxffs_index_add() and nxffs_index_remove() record an inode header
+ *     written to or deleted from FLASH.
+ *   - nxffs_index_find() looks up an inode by name.  It returns OK with
+ *     the inode in 'entry', -ENOENT if the inode certainly does not exist
+ *     or -EAGAIN if the volume has to be scanned.
+ *
+ * Defined in nxffs_index.c
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFFS_INDEX
+void nxffs_index_reset(FAR struct nxffs_volume_s *volume);
+void nxffs_index_invalidate(FAR struct nxffs_volume_s *volume);
+void nxffs_index_add(FAR struct nxffs_volume_s *volume,
+                     FAR const struct nxffs_entry_s *entry);
+void nxffs_index_remove(FAR struct nxffs_volume_s *volume, off_t hoffset);
+int nxffs_index_find(FAR struct nxffs_volume_s *volume,
+                     FAR const char *name, FAR struct nxffs_entry_s *entry);
+#else
+#  define nxffs_index_reset(v)
+#  define nxffs_index_invalidate(v)
+#  define nxffs_index_add(v,e)
+#  define nxffs_index_remove(v,o)
+#endif
+
 /****************************************************************************
  * Name: nxffs_pack
  *
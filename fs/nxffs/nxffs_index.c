@@ -0,0 +1,219 @@
+/****************************************************************************
+ * fs/nxffs/nxffs_index.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "nxffs.h"
+
+#ifdef CONFIG_NXFFS_INDEX
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_index_hash
+ *
+ * Description:
+ *   Hash a file name (FNV-1a).
+ *
+ ****************************************************************************/
+
+static uint32_t nxffs_index_hash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_build
+ *
+ * Description:
+ *   Rebuild the index by scanning all inodes from the first valid one.
+ *
+ ****************************************************************************/
+
+static void nxffs_index_build(FAR struct nxffs_volume_s *volume)
+{
+  struct nxffs_entry_s entry;
+  off_t offset;
+
+  nxffs_index_reset(volume);
+
+  offset = volume->inoffset;
+  while (nxffs_nextentry(volume, offset, &entry) == OK)
+    {
+      nxffs_index_add(volume, &entry);
+      offset = nxffs_inodeend(volume, &entry);
+      nxffs_freeentry(&entry);
+    }
+
+  finfo("Indexed %u inodes%s\n", volume->nindex,
+        volume->idxfull ? " (index full)" : "");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxffs_index_reset
+ ****************************************************************************/
+
+void nxffs_index_reset(FAR struct nxffs_volume_s *volume)
+{
+  volume->nindex   = 0;
+  volume->idxfull  = false;
+  volume->idxvalid = true;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_invalidate
+ ****************************************************************************/
+
+void nxffs_index_invalidate(FAR struct nxffs_volume_s *volume)
+{
+  volume->idxvalid = false;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_add
+ ****************************************************************************/
+
+void nxffs_index_add(FAR struct nxffs_volume_s *volume,
+                     FAR const struct nxffs_entry_s *entry)
+{
+  FAR struct nxffs_index_s *index;
+
+  if (!volume->idxvalid)
+    {
+      return;
+    }
+
+  if (volume->nindex >= CONFIG_NXFFS_INDEX_SIZE)
+    {
+      /* Misses must fall back to scanning the FLASH from now on */
+
+      volume->idxfull = true;
+      return;
+    }
+
+  index          = &volume->index[volume->nindex++];
+  index->hash    = nxffs_index_hash(entry->name);
+  index->hoffset = entry->hoffset;
+}
+
+/****************************************************************************
+ * Name: nxffs_index_remove
+ ****************************************************************************/
+
+void nxffs_index_remove(FAR struct nxffs_volume_s *volume, off_t hoffset)
+{
+  int i;
+
+  if (!volume->idxvalid)
+    {
+      return;
+    }
+
+  for (i = 0; i < volume->nindex; i++)
+    {
+      if (volume->index[i].hoffset == hoffset)
+        {
+          /* Fill the hole with the last entry */
+
+          volume->index[i] = volume->index[--volume->nindex];
+          return;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxffs_index_find
+ ****************************************************************************/
+
+int nxffs_index_find(FAR struct nxffs_volume_s *volume,
+                     FAR const char *name, FAR struct nxffs_entry_s *entry)
+{
+  FAR struct nxffs_index_s *index;
+  uint32_t hash;
+  int ret;
+  int i;
+
+  if (!volume->idxvalid)
+    {
+      nxffs_index_build(volume);
+    }
+
+  hash = nxffs_index_hash(name);
+  for (i = 0; i < volume->nindex; i++)
+    {
+      index = &volume->index[i];
+      if (index->hash != hash)
+        {
+          continue;
+        }
+
+      /* Read the inode header.  A valid header must start right at the
+       * recorded offset, otherwise the index is stale.
+       */
+
+      ret = nxffs_nextentry(volume, index->hoffset, entry);
+      if (ret == OK && entry->hoffset == index->hoffset)
+        {
+          if (strcmp(name, entry->name) == 0)
+            {
+              return OK;
+            }
+
+          /* Another name with the same hash */
+
+          nxffs_freeentry(entry);
+          continue;
+        }
+
+      if (ret == OK)
+        {
+          nxffs_freeentry(entry);
+        }
+
+      ferr("ERROR: Stale index entry at %jd\n", (intmax_t)index->hoffset);
+      nxffs_index_invalidate(volume);
+      return -EAGAIN;
+    }
+
+  return volume->idxfull ? -EAGAIN : -ENOENT;
+}
+
+#endif /* CONFIG_NXFFS_INDEX */
@@ -344,6 +344,10 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
   int nerased;
   int ret;
 
+  /* The scan below visits every inode: Rebuild the index on the way */
+
+  nxffs_index_reset(volume);
+
   /* Get the offset to the first valid block on the FLASH */
 
   block = 0;
@@ -389,6 +393,7 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
 
       /* Discard this entry and set the next offset. */
 
+      nxffs_index_add(volume, &entry);
       offset = nxffs_inodeend(volume, &entry);
       nxffs_freeentry(&entry);
     }
@@ -401,6 +406,7 @@ int nxffs_limits(FAR struct nxffs_volume_s *volume)
         {
           /* Discard the entry and guess the next offset. */
 
+          nxffs_index_add(volume, &entry);
           offset = nxffs_inodeend(volume, &entry);
           nxffs_freeentry(&entry);
         }
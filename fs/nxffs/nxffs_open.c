@@ -1256,6 +1256,10 @@ int nxffs_wrinode(FAR struct nxffs_volume_s *volume,
       ferr("ERROR: Failed to write inode header block %jd: %d\n",
            (intmax_t)volume->ioblock, -ret);
     }
+  else
+    {
+      nxffs_index_add(volume, entry);
+    }
 
   /* The volume is now available for other writers */
 
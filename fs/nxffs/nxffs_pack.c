@@ -1272,6 +1272,10 @@ int nxffs_pack(FAR struct nxffs_volume_s *volume)
   int i;
   int ret = OK;
 
+  /* Packing moves the inodes: The index is rebuilt on the next look-up */
+
+  nxffs_index_invalidate(volume);
+
   /* Get the offset to the first valid inode entry */
 
   wrfile = NULL;
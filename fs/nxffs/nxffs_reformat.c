@@ -279,6 +279,10 @@ int nxffs_reformat(FAR struct nxffs_volume_s *volume)
       return ret;
     }
 
+  /* The volume holds no inodes now */
+
+  nxffs_index_reset(volume);
+
   /* Check for bad blocks */
 
   ret = nxffs_badblocks(volume);
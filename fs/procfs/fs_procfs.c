@@ -63,16 +63,23 @@
 extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations pm_operations;
 extern const struct procfs_operations irq_operations;
+extern const struct procfs_operations balance_operations;
+extern const struct procfs_operations tcbcache_operations;
+extern const struct procfs_operations bench_operations;
+extern const struct procfs_operations boot_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations memdump_operations;
 extern const struct procfs_operations mempool_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations locks_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 extern const struct procfs_operations tcbinfo_operations;
+extern const struct procfs_operations snapshot_operations;
+extern const struct procfs_operations opstat_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -103,6 +110,21 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "[0-9]*",        &proc_operations,            PROCFS_DIR_TYPE    },
 #endif
 
+#if defined(CONFIG_SCHED_IDLE_BALANCE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_BALANCE)
+  { "balance",       &balance_operations,         PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_SCHED_BENCH) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_BENCH)
+  { "bench",         &bench_operations,           PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_BOOT_PROFILE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_BOOT)
+  { "boot",          &boot_operations,            PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CPULOAD)
   { "cpuload",       &cpuload_operations,         PROCFS_FILE_TYPE   },
 #endif
@@ -115,6 +137,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SPINLOCK_STATISTICS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_LOCKS)
+  { "locks",         &locks_operations,           PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
@@ -142,6 +169,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/mount",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_FS_OPSTATS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_OPSTAT)
+  { "fs/opstat",     &opstat_operations,          PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_USAGE
   { "fs/usage",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -173,6 +205,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "self/**",       &proc_operations,            PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_FS_PROCFS_SNAPSHOT)
+  { "snapshot",      &snapshot_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -184,6 +220,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if defined(CONFIG_DEBUG_TCBINFO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_TCBINFO)
   { "tcbinfo",       &tcbinfo_operations,         PROCFS_FILE_TYPE   },
 #endif
+
+#if defined(CONFIG_SCHED_TCB_CACHE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_TCBCACHE)
+  { "tcbcache",      &tcbcache_operations,        PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
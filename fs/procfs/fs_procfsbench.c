@@ -0,0 +1,315 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_BENCH) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_BENCH)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of results and the size of the buffer that holds
+ * them formatted.
+ */
+
+#define BENCH_NRESULTS 32
+#define BENCH_BUFSIZE  (80 * (BENCH_NRESULTS + 1))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct bench_file_s
+{
+  struct procfs_file_s base;    /* Base open file structure */
+  size_t size;                  /* Number of valid characters in buffer[] */
+  char buffer[BENCH_BUFSIZE];   /* The results */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     bench_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     bench_close(FAR struct file *filep);
+static ssize_t bench_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     bench_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     bench_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations bench_operations =
+{
+  bench_open,       /* open */
+  bench_close,      /* close */
+  bench_read,       /* read */
+  NULL,             /* write */
+
+  bench_dup,        /* dup */
+
+  NULL,             /* opendir */
+  NULL,             /* closedir */
+  NULL,             /* readdir */
+  NULL,             /* rewinddir */
+
+  bench_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bench_open
+ ****************************************************************************/
+
+static int bench_open(FAR struct file *filep, FAR const char *relpath,
+                      int oflags, mode_t mode)
+{
+  FAR struct bench_file_s *attr;
+  FAR struct sched_bench_s *results;
+  int nresults;
+  int i;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct bench_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Run the benchmarks now, so that all of the reads return the results of
+   * the same run.
+   */
+
+  results = kmm_malloc(BENCH_NRESULTS * sizeof(struct sched_bench_s));
+  if (!results)
+    {
+      kmm_free(attr);
+      return -ENOMEM;
+    }
+
+  nresults = nxsched_bench(results, BENCH_NRESULTS);
+  if (nresults < 0)
+    {
+      ferr("ERROR: nxsched_bench failed: %d\n", nresults);
+      kmm_free(results);
+      kmm_free(attr);
+      return nresults;
+    }
+
+  /* Format the results, one line per benchmark, with the times in
+   * nanoseconds.
+   */
+
+  attr->size = procfs_snprintf(attr->buffer, BENCH_BUFSIZE,
+                               "name,nsamples,min,p50,p90,p99,max\n");
+
+  for (i = 0; i < nresults && attr->size < BENCH_BUFSIZE; i++)
+    {
+      attr->size += procfs_snprintf(&attr->buffer[attr->size],
+                                    BENCH_BUFSIZE - attr->size,
+                                    "%s,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                                    results[i].name,
+                                    (unsigned long)results[i].nsamples,
+                                    (unsigned long)results[i].min,
+                                    (unsigned long)results[i].p50,
+                                    (unsigned long)results[i].p90,
+                                    (unsigned long)results[i].p99,
+                                    (unsigned long)results[i].max);
+    }
+
+  kmm_free(results);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_close
+ ****************************************************************************/
+
+static int bench_close(FAR struct file *filep)
+{
+  FAR struct bench_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct bench_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_read
+ ****************************************************************************/
+
+static ssize_t bench_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen)
+{
+  FAR struct bench_file_s *attr;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct bench_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset = filep->f_pos;
+
+  /* Return the results of the run of bench_open() */
+
+  ret = procfs_memcpy(attr->buffer, attr->size, buffer, buflen, &offset);
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bench_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int bench_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct bench_file_s *oldattr;
+  FAR struct bench_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct bench_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct bench_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct bench_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int bench_stat(const char *relpath, struct stat *buf)
+{
+  /* "bench" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_SCHED_BENCH && !CONFIG_FS_PROCFS_EXCLUDE_BENCH */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -0,0 +1,305 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsboot.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/init.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_BOOT_PROFILE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_BOOT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the buffer that holds the formatted profile */
+
+#define BOOT_LINESIZE 64
+#define BOOT_BUFSIZE  (BOOT_LINESIZE * (CONFIG_BOOT_PROFILE_NRECORDS + 1))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct boot_file_s
+{
+  struct procfs_file_s base;    /* Base open file structure */
+  size_t size;                  /* Number of valid characters in buffer[] */
+  char buffer[BOOT_BUFSIZE];    /* The profile */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     boot_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     boot_close(FAR struct file *filep);
+static ssize_t boot_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     boot_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     boot_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations boot_operations =
+{
+  boot_open,     /* open */
+  boot_close,    /* close */
+  boot_read,     /* read */
+  NULL,          /* write */
+
+  boot_dup,      /* dup */
+
+  NULL,          /* opendir */
+  NULL,          /* closedir */
+  NULL,          /* readdir */
+  NULL,          /* rewinddir */
+
+  boot_stat      /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: boot_open
+ ****************************************************************************/
+
+static int boot_open(FAR struct file *filep, FAR const char *relpath,
+                      int oflags, mode_t mode)
+{
+  FAR struct boot_file_s *attr;
+  FAR struct boot_record_s *records;
+  int nrecords;
+  int i;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct boot_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a copy of the profile now, so that all of the reads see the
+   * same one.
+   */
+
+  records = kmm_malloc(CONFIG_BOOT_PROFILE_NRECORDS *
+                       sizeof(struct boot_record_s));
+  if (!records)
+    {
+      kmm_free(attr);
+      return -ENOMEM;
+    }
+
+  nrecords = nx_boot_profile(records, CONFIG_BOOT_PROFILE_NRECORDS);
+
+  /* Format the profile, one line per stage, with the times in
+   * microseconds since power up.
+   */
+
+  attr->size = procfs_snprintf(attr->buffer, BOOT_BUFSIZE,
+                               "name,cpu,start,end,result\n");
+
+  for (i = 0; i < nrecords && attr->size < BOOT_BUFSIZE; i++)
+    {
+      attr->size += procfs_snprintf(&attr->buffer[attr->size],
+                                    BOOT_BUFSIZE - attr->size,
+                                    "%s,%u,%lu,%lu,%d\n",
+                                    records[i].name,
+                                    (unsigned int)records[i].cpu,
+                                    (unsigned long)records[i].start,
+                                    (unsigned long)records[i].end,
+                                    (int)records[i].result);
+    }
+
+  kmm_free(records);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boot_close
+ ****************************************************************************/
+
+static int boot_close(FAR struct file *filep)
+{
+  FAR struct boot_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct boot_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boot_read
+ ****************************************************************************/
+
+static ssize_t boot_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen)
+{
+  FAR struct boot_file_s *attr;
+  off_t offset;
+  ssize_t ret;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct boot_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset = filep->f_pos;
+
+  /* Return the profile copied by boot_open() */
+
+  ret = procfs_memcpy(attr->buffer, attr->size, buffer, buflen, &offset);
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: boot_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int boot_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct boot_file_s *oldattr;
+  FAR struct boot_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct boot_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct boot_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct boot_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: boot_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int boot_stat(const char *relpath, struct stat *buf)
+{
+  /* "boot" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_BOOT_PROFILE && !CONFIG_FS_PROCFS_EXCLUDE_BOOT */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
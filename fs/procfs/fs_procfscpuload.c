@@ -57,6 +57,16 @@
 
 #define CPULOAD_LINELEN 16
 
+/* With exact accounting, one more line reports the interrupt load of each
+ * CPU.
+ */
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+#  define CPULOAD_BUFLEN  (CPULOAD_LINELEN * (1 + CONFIG_SMP_NCPUS))
+#else
+#  define CPULOAD_BUFLEN  CPULOAD_LINELEN
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -67,7 +77,7 @@ struct cpuload_file_s
 {
   struct procfs_file_s  base;   /* Base open file structure */
   unsigned int linesize;        /* Number of valid characters in line[] */
-  char line[CPULOAD_LINELEN];   /* Pre-allocated buffer for formatted lines */
+  char line[CPULOAD_BUFLEN];    /* Pre-allocated buffer for formatted lines */
 };
 
 /****************************************************************************
@@ -204,6 +214,9 @@ static ssize_t cpuload_read(FAR struct file *filep, FAR char *buffer,
       struct cpuload_s cpuload;
       uint32_t intpart;
       uint32_t fracpart;
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+      int cpu;
+#endif
 
       /* Sample the counts for the IDLE thread.  clock_cpuload should only
        * fail if the PID is not valid.  This, however, should never happen
@@ -234,6 +247,36 @@ static ssize_t cpuload_read(FAR struct file *filep, FAR char *buffer,
                                  "%3" PRId32 ".%01" PRId32 "%%\n",
                                  intpart, fracpart);
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+      /* Then the share of the time that each CPU spent in interrupt
+       * handlers.
+       */
+
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          DEBUGVERIFY(clock_cpuload_irq(cpu, &cpuload));
+
+          if (cpuload.total > 0)
+            {
+              uint32_t tmp;
+
+              tmp      = (1000 * cpuload.active) / cpuload.total;
+              intpart  = tmp / 10;
+              fracpart = tmp - 10 * intpart;
+            }
+          else
+            {
+              intpart  = 0;
+              fracpart = 0;
+            }
+
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      CPULOAD_BUFLEN - linesize,
+                                      "irq%d %3" PRId32 ".%01" PRId32
+                                      "%%\n", cpu, intpart, fracpart);
+        }
+#endif
+
       /* Save the linesize in case we are re-entered with f_pos > 0 */
 
       attr->linesize = linesize;
@@ -39,6 +39,7 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -67,6 +68,12 @@ struct critmon_file_s
   struct procfs_file_s  base;   /* Base open file structure */
   unsigned int linesize;        /* Number of valid characters in line[] */
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Snapshot of the wakeup latency histograms taken at f_pos 0 */
+
+  uint32_t wakeup[CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS]
+                 [CRITMON_WAKEUP_NBUCKETS];
+#endif
 };
 
 /****************************************************************************
@@ -248,6 +255,66 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: critmon_read_wakeup
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+static ssize_t critmon_read_wakeup(FAR struct critmon_file_s *attr,
+                                   FAR char *buffer, size_t buflen,
+                                   FAR off_t *offset)
+{
+  struct timespec mintime;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize = 0;
+  int band;
+  int bucket;
+
+  /* Generate one line for each bucket that is in use:  The lowest
+   * priority of the band, the lower bound of the latencies in the bucket
+   * and the number of latencies.
+   */
+
+  for (band = 0; band < CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS; band++)
+    {
+      for (bucket = 0; bucket < CRITMON_WAKEUP_NBUCKETS; bucket++)
+        {
+          if (attr->wakeup[band][bucket] == 0)
+            {
+              continue;
+            }
+
+          up_perf_convert((uint32_t)1 << bucket, &mintime);
+
+          linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                                     "wakeup,%d,%lu.%09lu,%lu\n",
+                                     (band * (SCHED_PRIORITY_MAX + 1) +
+                                      CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS
+                                      - 1) /
+                                     CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS,
+                                     (unsigned long)mintime.tv_sec,
+                                     (unsigned long)mintime.tv_nsec,
+                                     (unsigned long)
+                                     attr->wakeup[band][bucket]);
+          copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                                   offset);
+
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          if (buflen == 0)
+            {
+              return totalsize;
+            }
+        }
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read
  ****************************************************************************/
@@ -270,6 +337,22 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   ret    = 0;
   offset = filep->f_pos;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Take (and reset) the wakeup latency histograms when the file is read
+   * from the beginning, so that they stay stable throughout the reads.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      irqstate_t flags = enter_critical_section();
+
+      memcpy(attr->wakeup, g_wakeup_hist, sizeof(attr->wakeup));
+      memset(g_wakeup_hist, 0, sizeof(g_wakeup_hist));
+
+      leave_critical_section(flags);
+    }
+#endif
+
   /* Get the status for each CPU  */
 
   for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
@@ -278,13 +361,20 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
                                         &offset, cpu);
 
       ret += nbytes;
-      if (ret > buflen)
+      if (ret >= buflen)
         {
           break;
         }
+    }
+
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Then the wakeup latency histograms */
 
-      offset += nbytes;
+  if (ret < buflen)
+    {
+      ret += critmon_read_wakeup(attr, buffer + ret, buflen - ret, &offset);
     }
+#endif
 
   if (ret > 0)
     {
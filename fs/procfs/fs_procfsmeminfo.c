@@ -385,6 +385,229 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
     }
 #endif
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Followed by the statistics of the per-CPU chunk caches */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s%11s%11s\n", "cache",
+                                   "hits", "misses", "drains", "cached",
+                                   "nchunks");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (totalsize < buflen)
+        {
+          struct mm_percpuinfo_s cinfo;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          mm_percpu_info(entry->heap, &cinfo);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu%11lu%11lu\n",
+                                       entry->name,
+                                       (unsigned long)cinfo.nhits,
+                                       (unsigned long)cinfo.nmisses,
+                                       (unsigned long)cinfo.ndrains,
+                                       (unsigned long)cinfo.cachedsize,
+                                       (unsigned long)cinfo.ncached);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+  /* Followed by the allocation statistics */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s%11s%11s\n", "stats",
+                                   "mallocs", "frees", "failed", "used",
+                                   "peak");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (totalsize < buflen)
+        {
+          struct mm_statsinfo_s sinfo;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          mm_stats_info(entry->heap, &sinfo);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu%11lu%11lu\n",
+                                       entry->name,
+                                       (unsigned long)sinfo.nmallocs,
+                                       (unsigned long)sinfo.nfrees,
+                                       (unsigned long)sinfo.nfailed,
+                                       (unsigned long)sinfo.usedsize,
+                                       (unsigned long)sinfo.peaksize);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+
+  /* Followed by the size histograms of every heap, only the non-empty
+   * size classes are shown.
+   */
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      struct mm_statsinfo_s sinfo;
+      int ndx;
+
+      if (totalsize >= buflen)
+        {
+          break;
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      mm_stats_info(entry->heap, &sinfo);
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%12s:%11s%11s%11s\n", entry->name,
+                                   "nalloc", "nfree", "freesize");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+
+      for (ndx = 0; ndx < sinfo.nclasses; ndx++)
+        {
+          if (totalsize >= buflen)
+            {
+              break;
+            }
+
+          if (sinfo.nalloc[ndx] == 0 && sinfo.nfree[ndx] == 0)
+            {
+              continue;
+            }
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12lu:%11lu%11lu%11lu\n",
+                                       1ul << (sinfo.minshift + ndx),
+                                       (unsigned long)sinfo.nalloc[ndx],
+                                       (unsigned long)sinfo.nfree[ndx],
+                                       (unsigned long)sinfo.freesize[ndx]);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+  /* Followed by the state of the heap profilers */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s\n", "profile",
+                                   "sampled", "live", "dropped");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (totalsize < buflen)
+        {
+          struct mm_profileinfo_s pinfo;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          mm_profile_info(entry->heap, &pinfo);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%12s:%11lu%11lu%11lu\n",
+                                       entry->name,
+                                       (unsigned long)pinfo.nsampled,
+                                       (unsigned long)pinfo.nlive,
+                                       (unsigned long)pinfo.ndropped);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
+#ifdef CONFIG_MM_REGION_ATTR
+  /* Followed by the usage of each heap region */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%13s%11s%11s%11s%11s%6s\n", "region",
+                                   "total", "used", "free", "largest",
+                                   "fast");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      struct mallinfo rinfo;
+      int region;
+      int attr;
+
+      for (region = 0;
+           totalsize < buflen &&
+           (attr = mm_region_getattr(entry->heap, region)) >= 0 &&
+           mm_region_mallinfo(entry->heap, region, &rinfo) >= 0;
+           region++)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%10s/%-2d%11lu%11lu%11lu%11lu%6s\n",
+                                       entry->name, region,
+                                       (unsigned long)rinfo.arena,
+                                       (unsigned long)rinfo.uordblks,
+                                       (unsigned long)rinfo.fordblks,
+                                       (unsigned long)rinfo.mxordblk,
+                                       (attr & MM_REGION_FAST) ?
+                                       "yes" : "no");
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -0,0 +1,313 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsopstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/fs/opstat.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_FS_OPSTATS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_OPSTAT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define OPSTAT_LINELEN 96
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct opstat_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  unsigned int linesize;        /* Number of valid characters in line[] */
+  char line[OPSTAT_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     opstat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     opstat_close(FAR struct file *filep);
+static ssize_t opstat_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t opstat_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     opstat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     opstat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations opstat_operations =
+{
+  opstat_open,        /* open */
+  opstat_close,       /* close */
+  opstat_read,        /* read */
+  opstat_write,       /* write */
+
+  opstat_dup,         /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  opstat_stat         /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: opstat_usec
+ *
+ * Description:
+ *   Convert a time in the units of up_perf_gettime() to microseconds
+ *   without overflowing the intermediate product.
+ *
+ ****************************************************************************/
+
+static uint64_t opstat_usec(uint64_t time, uint32_t freq)
+{
+  return (time / freq) * 1000000 + (time % freq) * 1000000 / freq;
+}
+
+/****************************************************************************
+ * Name: opstat_open
+ ****************************************************************************/
+
+static int opstat_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct opstat_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct opstat_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: opstat_close
+ ****************************************************************************/
+
+static int opstat_close(FAR struct file *filep)
+{
+  FAR struct opstat_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct opstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: opstat_read
+ *
+ * Description:
+ *   Generate one comma separated line per operation:
+ *   name,count,errors,bytes,total usec,max usec
+ *
+ ****************************************************************************/
+
+static ssize_t opstat_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  struct fs_opstat_s stats[FS_OPSTAT_NOPS];
+  FAR struct opstat_file_s *attr;
+  size_t linesize;
+  uint32_t freq;
+  off_t offset;
+  ssize_t ret;
+  int op;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct opstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  ret    = 0;
+  offset = filep->f_pos;
+  freq   = up_perf_getfreq();
+  if (freq == 0)
+    {
+      return -ENOSYS;
+    }
+
+  fs_opstat_get(stats);
+
+  for (op = 0; op < FS_OPSTAT_NOPS && ret < buflen; op++)
+    {
+      linesize = procfs_snprintf(attr->line, OPSTAT_LINELEN,
+                                 "%s,%" PRIu32 ",%" PRIu32 ",%" PRIu64
+                                 ",%" PRIu64 ",%" PRIu64 "\n",
+                                 fs_opstat_name(op), stats[op].count,
+                                 stats[op].errors, stats[op].bytes,
+                                 opstat_usec(stats[op].time, freq),
+                                 opstat_usec(stats[op].maxtime, freq));
+      ret += procfs_memcpy(attr->line, linesize, buffer + ret,
+                           buflen - ret, &offset);
+    }
+
+  if (ret > 0)
+    {
+      filep->f_pos += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: opstat_write
+ *
+ * Description:
+ *   Any write clears the statistics.
+ *
+ ****************************************************************************/
+
+static ssize_t opstat_write(FAR struct file *filep, FAR const char *buffer,
+                            size_t buflen)
+{
+  fs_opstat_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: opstat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int opstat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct opstat_file_s *oldattr;
+  FAR struct opstat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct opstat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct opstat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct opstat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: opstat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int opstat_stat(const char *relpath, struct stat *buf)
+{
+  /* "fs/opstat" is a file that can be read and written (to reset it) */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_OPSTATS && !CONFIG_FS_PROCFS_EXCLUDE_OPSTAT */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -914,6 +914,41 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 
   /* Generate output for maximum time thread running */
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  linesize = procfs_snprintf(procfile->line, STATUS_LINELEN, "%lu.%09lu,",
+                             (unsigned long)maxtime.tv_sec,
+                             (unsigned long)maxtime.tv_nsec);
+  copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining,
+                           &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Convert and generate output for maximum time from ready-to-run until
+   * running.
+   */
+
+  if (tcb->wakeup_max > 0)
+    {
+      up_perf_convert(tcb->wakeup_max, &maxtime);
+    }
+  else
+    {
+      maxtime.tv_sec = 0;
+      maxtime.tv_nsec = 0;
+    }
+
+  /* Reset the maximum */
+
+  tcb->wakeup_max = 0;
+#endif
+
   linesize = procfs_snprintf(procfile->line, STATUS_LINELEN, "%lu.%09lu\n",
                              (unsigned long)maxtime.tv_sec,
                              (unsigned long)maxtime.tv_nsec);
@@ -1102,6 +1137,24 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile,
   remaining -= copysize;
 #endif
 
+#ifdef CONFIG_STACK_SAMPLING
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Show the deepest stack use sampled */
+
+  linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN, "%-12s%ld\n",
+                               "StackPeak:", (long)tcb->stack_sampled);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining,
+                             &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  remaining -= copysize;
+#endif
+
   return totalsize;
 }
 
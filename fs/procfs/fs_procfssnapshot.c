@@ -0,0 +1,483 @@
+/****************************************************************************
+ * fs/procfs/fs_procfssnapshot.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_FS_PROCFS_SNAPSHOT)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The whole snapshot is taken
+ * when the file is opened, so that all reads see the same data.
+ */
+
+struct snapshot_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  size_t size;                    /* Size of the snapshot */
+  FAR uint8_t *data;              /* The snapshot */
+};
+
+/* The state of the enumeration of the tasks */
+
+struct snapshot_enum_s
+{
+  FAR struct procfs_snapshot_task_s *task; /* The next record */
+  uint32_t ntasks;                         /* Number of records filled */
+  uint32_t maxtasks;                       /* Number of records available */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Helpers */
+
+static void    snapshot_count(FAR struct tcb_s *tcb, FAR void *arg);
+static void    snapshot_task(FAR struct tcb_s *tcb, FAR void *arg);
+static int     snapshot_take(FAR struct snapshot_file_s *snapfile);
+
+/* File system methods */
+
+static int     snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     snapshot_close(FAR struct file *filep);
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     snapshot_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     snapshot_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+extern FAR struct procfs_meminfo_entry_s *g_procfs_meminfo;
+#endif
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations snapshot_operations =
+{
+  snapshot_open,   /* open */
+  snapshot_close,  /* close */
+  snapshot_read,   /* read */
+  NULL,            /* write */
+  snapshot_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  snapshot_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: snapshot_count
+ ****************************************************************************/
+
+static void snapshot_count(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  (*(FAR uint32_t *)arg)++;
+}
+
+/****************************************************************************
+ * Name: snapshot_task
+ *
+ * Description:
+ *   Fill in the record of one task.  Runs in the critical section of
+ *   nxsched_foreach(), so the slow stack usage check is left to the
+ *   caller.
+ *
+ ****************************************************************************/
+
+static void snapshot_task(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct snapshot_enum_s *info = (FAR struct snapshot_enum_s *)arg;
+  FAR struct procfs_snapshot_task_s *task;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+
+  if (info->ntasks >= info->maxtasks)
+    {
+      return;
+    }
+
+  task             = info->task++;
+  info->ntasks++;
+
+  task->pid        = tcb->pid;
+  task->group      = tcb->group != NULL ? tcb->group->tg_pid : tcb->pid;
+  task->state      = tcb->task_state;
+  task->priority   = tcb->sched_priority;
+#ifdef CONFIG_SMP
+  task->cpu        = tcb->cpu;
+#endif
+  task->flags      = tcb->flags;
+  task->stacksize  = tcb->adj_stack_size;
+
+#ifdef CONFIG_SCHED_CPULOAD
+  if (clock_cpuload(tcb->pid, &cpuload) >= 0)
+    {
+      task->loadactive = cpuload.active;
+    }
+#endif
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  strlcpy(task->name, tcb->name, PROCFS_SNAPSHOT_NAMELEN);
+#endif
+}
+
+/****************************************************************************
+ * Name: snapshot_take
+ *
+ * Description:
+ *   Allocate and fill in the snapshot of the open file.
+ *
+ ****************************************************************************/
+
+static int snapshot_take(FAR struct snapshot_file_s *snapfile)
+{
+  FAR struct procfs_snapshot_s *hdr;
+  FAR struct procfs_snapshot_heap_s *heap;
+  FAR struct procfs_snapshot_task_s *task;
+  struct snapshot_enum_s info;
+  uint32_t nheaps = 0;
+  uint32_t ntasks = 0;
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+  FAR const struct procfs_meminfo_entry_s *entry;
+#endif
+#ifdef CONFIG_STACK_COLORATION
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  uint32_t i;
+#endif
+
+  /* Size the snapshot.  Tasks created after the count are not reported. */
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      nheaps++;
+    }
+#endif
+
+  nxsched_foreach(snapshot_count, &ntasks);
+  if (ntasks > CONFIG_FS_PROCFS_MAX_TASKS)
+    {
+      ntasks = CONFIG_FS_PROCFS_MAX_TASKS;
+    }
+
+  snapfile->size = sizeof(struct procfs_snapshot_s) +
+                   nheaps * sizeof(struct procfs_snapshot_heap_s) +
+                   ntasks * sizeof(struct procfs_snapshot_task_s);
+  snapfile->data = kmm_zalloc(snapfile->size);
+  if (snapfile->data == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  hdr  = (FAR struct procfs_snapshot_s *)snapfile->data;
+  heap = (FAR struct procfs_snapshot_heap_s *)(hdr + 1);
+  task = (FAR struct procfs_snapshot_task_s *)(heap + nheaps);
+
+  hdr->version  = PROCFS_SNAPSHOT_VERSION;
+  hdr->hdrsize  = sizeof(struct procfs_snapshot_s);
+  hdr->heapsize = sizeof(struct procfs_snapshot_heap_s);
+  hdr->tasksize = sizeof(struct procfs_snapshot_task_s);
+  hdr->uptime   = (uint32_t)clock_systime_ticks();
+
+#ifdef CONFIG_SCHED_CPULOAD
+    {
+      struct cpuload_s cpuload;
+
+      if (clock_cpuload(0, &cpuload) >= 0)
+        {
+          hdr->loadtotal = cpuload.total;
+        }
+    }
+#endif
+
+#ifdef CONFIG_MM_IOB
+    {
+      struct iob_stats_s stats;
+
+      iob_getstats(&stats);
+      hdr->iob_ntotal    = stats.ntotal;
+      hdr->iob_nfree     = stats.nfree;
+      hdr->iob_nwait     = stats.nwait;
+      hdr->iob_nthrottle = stats.nthrottle;
+    }
+#endif
+
+  /* The heaps */
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
+  for (entry = g_procfs_meminfo; entry != NULL && hdr->nheaps < nheaps;
+       entry = entry->next, heap++)
+    {
+      struct mallinfo minfo;
+
+      mm_mallinfo(entry->heap, &minfo);
+      strlcpy(heap->name, entry->name, PROCFS_SNAPSHOT_NAMELEN);
+      heap->total   = minfo.arena;
+      heap->used    = minfo.uordblks;
+      heap->free    = minfo.fordblks;
+      heap->largest = minfo.mxordblk;
+      heap->nused   = minfo.aordblks;
+      heap->nfree   = minfo.ordblks;
+      hdr->nheaps++;
+    }
+#endif
+
+  /* The tasks */
+
+  info.task     = task;
+  info.ntasks   = 0;
+  info.maxtasks = ntasks;
+  nxsched_foreach(snapshot_task, &info);
+  hdr->ntasks   = info.ntasks;
+
+  /* The stack usage is not checked by snapshot_task():  That would keep
+   * the interrupts disabled during the stack scans of all tasks.  Check
+   * the stacks one task at a time.
+   */
+
+#ifdef CONFIG_STACK_COLORATION
+  for (i = 0; i < info.ntasks; i++)
+    {
+      flags = enter_critical_section();
+      tcb   = nxsched_get_tcb(task[i].pid);
+      if (tcb != NULL)
+        {
+          task[i].stackused = up_check_tcbstack(tcb);
+        }
+
+      leave_critical_section(flags);
+    }
+#endif
+
+  /* Report only the records filled in */
+
+  snapfile->size = sizeof(struct procfs_snapshot_s) +
+                   hdr->nheaps * sizeof(struct procfs_snapshot_heap_s) +
+                   hdr->ntasks * sizeof(struct procfs_snapshot_task_s);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_open
+ ****************************************************************************/
+
+static int snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct snapshot_file_s *snapfile;
+  int ret;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  snapfile = (FAR struct snapshot_file_s *)
+    kmm_zalloc(sizeof(struct snapshot_file_s));
+  if (!snapfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  ret = snapshot_take(snapfile);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to take the snapshot: %d\n", ret);
+      kmm_free(snapfile);
+      return ret;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)snapfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_close
+ ****************************************************************************/
+
+static int snapshot_close(FAR struct file *filep)
+{
+  FAR struct snapshot_file_s *snapfile;
+
+  /* Recover our private data from the struct file instance */
+
+  snapfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(snapfile);
+
+  /* Release the snapshot and the file attributes structure */
+
+  kmm_free(snapfile->data);
+  kmm_free(snapfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_read
+ ****************************************************************************/
+
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct snapshot_file_s *snapfile;
+  off_t offset;
+  size_t copysize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  snapfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(snapfile);
+
+  copysize = procfs_memcpy((FAR const char *)snapfile->data, snapfile->size,
+                           buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  filep->f_pos += copysize;
+  return copysize;
+}
+
+/****************************************************************************
+ * Name: snapshot_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int snapshot_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct snapshot_file_s *oldattr;
+  FAR struct snapshot_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct snapshot_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container holding a copy of the snapshot */
+
+  newattr = (FAR struct snapshot_file_s *)
+    kmm_malloc(sizeof(struct snapshot_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, sizeof(struct snapshot_file_s));
+
+  newattr->data = kmm_malloc(oldattr->size);
+  if (newattr->data == NULL)
+    {
+      kmm_free(newattr);
+      return -ENOMEM;
+    }
+
+  memcpy(newattr->data, oldattr->data, oldattr->size);
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int snapshot_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "snapshot" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_FS_PROCFS_SNAPSHOT */
@@ -406,6 +406,20 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = bytesleft;
     }
 
+  /* Directly accessible media need no sector handling:  Copy all of the
+   * data at once.
+   */
+
+  if (rm->rm_xipbase != NULL && buflen > 0)
+    {
+      memcpy(userbuffer,
+             rm->rm_xipbase + rf->rf_startoffset + filep->f_pos, buflen);
+
+      filep->f_pos += buflen;
+      readsize      = buflen;
+      buflen        = 0;
+    }
+
   /* Loop until either (1) all data has been transferred, or (2) an
    * error occurs.
    */
@@ -1191,6 +1205,9 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
 #ifdef CONFIG_FS_ROMFS_CACHE_NODE
       romfs_freenode(rm->rm_root);
+#endif
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+      kmm_free(rm->rm_hash);
 #endif
       nxsem_destroy(&rm->rm_sem);
       kmm_free(rm);
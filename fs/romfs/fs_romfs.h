@@ -122,11 +122,16 @@
  */
 
 struct romfs_file_s;
+struct romfs_nodehash_s;
 struct romfs_mountpt_s
 {
   FAR struct inode *rm_blkdriver; /* The block driver inode that hosts the romfs */
 #ifdef CONFIG_FS_ROMFS_CACHE_NODE
   FAR struct romfs_nodeinfo_s *rm_root; /* The node for root node */
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+  FAR struct romfs_nodehash_s *rm_hash; /* Hash table of all cached nodes */
+  uint32_t rm_hashmask;                 /* Number of hash entries - 1 */
+#endif
 #else
   uint32_t rm_rootoffset;         /* Saved offset to the first root directory entry */
 #endif
@@ -171,6 +176,19 @@ struct romfs_nodeinfo_s
 #endif
 };
 
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+/* One entry of the hash table of cached nodes.  The directory of a node is
+ * identified by the child array (rn_child) of the directory.
+ */
+
+struct romfs_nodehash_s
+{
+  uint32_t rh_hash;                        /* Hash of the directory and name */
+  FAR struct romfs_nodeinfo_s **rh_dir;    /* rn_child of the directory */
+  FAR struct romfs_nodeinfo_s *rh_node;    /* The node, NULL: unused entry */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -213,6 +231,9 @@ int  romfs_datastart(FAR struct romfs_mountpt_s *rm,
 #ifdef CONFIG_FS_ROMFS_CACHE_NODE
 void romfs_freenode(FAR struct romfs_nodeinfo_s *node);
 #endif
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+void romfs_hashnodes(FAR struct romfs_mountpt_s *rm);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
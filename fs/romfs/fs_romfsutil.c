@@ -314,6 +314,132 @@ static int romfs_nodeinfo_compare(FAR const void *a, FAR const void *b)
 }
 #endif
 
+/****************************************************************************
+ * Name: romfs_namehash
+ *
+ * Description:
+ *   Hash the name of an entry of the directory with the child array 'dir'
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+static uint32_t romfs_namehash(FAR struct romfs_nodeinfo_s **dir,
+                               FAR const char *name, size_t len)
+{
+  uint32_t hash = (uint32_t)(uintptr_t)dir * 2654435761u;
+
+  while (len-- > 0)
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: romfs_hashsearch
+ *
+ * Description:
+ *   Look up an entry of the directory with the child array 'dir' in the
+ *   hash table of the cached nodes.
+ *
+ ****************************************************************************/
+
+static FAR struct romfs_nodeinfo_s *
+romfs_hashsearch(FAR struct romfs_mountpt_s *rm,
+                 FAR struct romfs_nodeinfo_s **dir,
+                 FAR const char *name, size_t len)
+{
+  FAR struct romfs_nodehash_s *entry;
+  uint32_t hash;
+  uint32_t ndx;
+
+  hash = romfs_namehash(dir, name, len);
+  for (ndx = hash & rm->rm_hashmask; ; ndx = (ndx + 1) & rm->rm_hashmask)
+    {
+      entry = &rm->rm_hash[ndx];
+      if (entry->rh_node == NULL)
+        {
+          return NULL;
+        }
+
+      if (entry->rh_hash == hash && entry->rh_dir == dir &&
+          entry->rh_node->rn_namesize == len &&
+          memcmp(entry->rh_node->rn_name, name, len) == 0)
+        {
+          return entry->rh_node;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: romfs_countnodes
+ *
+ * Description:
+ *   Return the number of nodes below a directory node
+ *
+ ****************************************************************************/
+
+static size_t romfs_countnodes(FAR struct romfs_nodeinfo_s *nodeinfo)
+{
+  size_t count = 0;
+  int i;
+
+  if (IS_DIRECTORY(nodeinfo->rn_next))
+    {
+      for (i = 0; i < nodeinfo->rn_count; i++)
+        {
+          count += 1 + romfs_countnodes(nodeinfo->rn_child[i]);
+        }
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: romfs_hashinsert
+ *
+ * Description:
+ *   Add all nodes below a directory node to the hash table
+ *
+ ****************************************************************************/
+
+static void romfs_hashinsert(FAR struct romfs_mountpt_s *rm,
+                             FAR struct romfs_nodeinfo_s *nodeinfo)
+{
+  FAR struct romfs_nodeinfo_s *child;
+  uint32_t hash;
+  uint32_t ndx;
+  int i;
+
+  if (!IS_DIRECTORY(nodeinfo->rn_next))
+    {
+      return;
+    }
+
+  for (i = 0; i < nodeinfo->rn_count; i++)
+    {
+      child = nodeinfo->rn_child[i];
+      hash  = romfs_namehash(nodeinfo->rn_child, child->rn_name,
+                             child->rn_namesize);
+
+      /* Linear probing: The table is never more than half full */
+
+      ndx = hash & rm->rm_hashmask;
+      while (rm->rm_hash[ndx].rh_node != NULL)
+        {
+          ndx = (ndx + 1) & rm->rm_hashmask;
+        }
+
+      rm->rm_hash[ndx].rh_hash = hash;
+      rm->rm_hash[ndx].rh_dir  = nodeinfo->rn_child;
+      rm->rm_hash[ndx].rh_node = child;
+
+      romfs_hashinsert(rm, child);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_searchdir
  *
@@ -331,6 +457,23 @@ static inline int romfs_searchdir(FAR struct romfs_mountpt_s *rm,
   FAR struct romfs_nodeinfo_s **cnodeinfo;
   struct romfs_entryname_s entry;
 
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+  FAR struct romfs_nodeinfo_s *hnodeinfo;
+
+  if (rm->rm_hash != NULL)
+    {
+      hnodeinfo = romfs_hashsearch(rm, nodeinfo->rn_child, entryname,
+                                   entrylen);
+      if (hnodeinfo == NULL)
+        {
+          return -ENOENT;
+        }
+
+      memcpy(nodeinfo, hnodeinfo, sizeof(*nodeinfo));
+      return OK;
+    }
+#endif
+
   entry.re_name = entryname;
   entry.re_len = entrylen;
   cnodeinfo = bsearch(&entry, nodeinfo->rn_child, nodeinfo->rn_count,
@@ -789,6 +932,10 @@ int romfs_fsconfigure(FAR struct romfs_mountpt_s *rm)
       romfs_freenode(rm->rm_root);
       return ndx;
     }
+
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+  romfs_hashnodes(rm);
+#endif
 #else
   rm->rm_rootoffset = ROMFS_ALIGNUP(ROMFS_VHDR_VOLNAME + strlen(name) + 1);
 #endif
@@ -918,6 +1065,48 @@ void romfs_freenode(FAR struct romfs_nodeinfo_s *nodeinfo)
 }
 #endif
 
+/****************************************************************************
+ * Name: romfs_hashnodes
+ *
+ * Description:
+ *   Build the hash table of all cached nodes when the filesystem is
+ *   mounted.  Without the table (e.g., if it cannot be allocated), the
+ *   directories are searched with bsearch().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_ROMFS_NODE_HASH
+void romfs_hashnodes(FAR struct romfs_mountpt_s *rm)
+{
+  size_t count;
+  size_t size;
+
+  count = romfs_countnodes(rm->rm_root);
+  if (count == 0)
+    {
+      return;
+    }
+
+  /* Keep the table at most half full */
+
+  size = 4;
+  while (size < 2 * count)
+    {
+      size <<= 1;
+    }
+
+  rm->rm_hash = kmm_zalloc(size * sizeof(struct romfs_nodehash_s));
+  if (rm->rm_hash == NULL)
+    {
+      fwarn("WARNING: No memory for the hash of %zu nodes\n", count);
+      return;
+    }
+
+  rm->rm_hashmask = size - 1;
+  romfs_hashinsert(rm, rm->rm_root);
+}
+#endif
+
 /****************************************************************************
  * Name: romfs_finddirentry
  *
@@ -48,6 +48,14 @@
 
 #define RPMSGFS_RETRY_DELAY_MS       10
 
+#ifndef CONFIG_FS_RPMSGFS_READAHEAD
+#  define CONFIG_FS_RPMSGFS_READAHEAD 0
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -68,6 +76,11 @@ struct rpmsgfs_ofile_s
   int16_t                    crefs;    /* Reference count */
   mode_t                     oflags;   /* Open mode */
   int                        fd;
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  FAR char                   *rabuf;   /* Read-ahead buffer */
+  size_t                     rahead;   /* Offset of the next byte in rabuf */
+  size_t                     ratail;   /* Number of bytes in rabuf */
+#endif
 };
 
 /* This structure represents the overall mountpoint state.  An instance of
@@ -282,6 +295,32 @@ static void rpmsgfs_mkpath(FAR struct rpmsgfs_mountpt_s *fs,
     }
 }
 
+/****************************************************************************
+ * Name: rpmsgfs_radrop
+ *
+ * Description:
+ *   Discard the read-ahead data and move the remote file position back to
+ *   the position seen by the application.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+static void rpmsgfs_radrop(FAR struct rpmsgfs_mountpt_s *fs,
+                           FAR struct rpmsgfs_ofile_s *hf)
+{
+  if (hf->ratail > hf->rahead)
+    {
+      rpmsgfs_client_lseek(fs->handle, hf->fd,
+                           -(off_t)(hf->ratail - hf->rahead), SEEK_CUR);
+    }
+
+  hf->rahead = 0;
+  hf->ratail = 0;
+}
+#else
+#  define rpmsgfs_radrop(fs, hf)
+#endif
+
 /****************************************************************************
  * Name: rpmsgfs_open
  ****************************************************************************/
@@ -372,6 +411,12 @@ static int rpmsgfs_open(FAR struct file *filep, FAR const char *relpath,
   hf->oflags = oflags;
   fs->fs_head = hf;
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  hf->rabuf  = NULL;
+  hf->rahead = 0;
+  hf->ratail = 0;
+#endif
+
   ret = OK;
   goto errout_with_semaphore;
 
@@ -470,6 +515,9 @@ static int rpmsgfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  kmm_free(hf->rabuf);
+#endif
   kmm_free(hf);
 
 okout:
@@ -509,6 +557,46 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
       return ret;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+  /* Small reads of read-only files go through the read-ahead buffer, so
+   * that each round trip to the remote core fetches a full buffer.
+   */
+
+  if ((hf->oflags & O_WROK) == 0 && buflen < CONFIG_FS_RPMSGFS_READAHEAD)
+    {
+      if (hf->rahead >= hf->ratail)
+        {
+          if (hf->rabuf == NULL)
+            {
+              hf->rabuf = kmm_malloc(CONFIG_FS_RPMSGFS_READAHEAD);
+            }
+
+          if (hf->rabuf != NULL)
+            {
+              ret = rpmsgfs_client_read(fs->handle, hf->fd, hf->rabuf,
+                                        CONFIG_FS_RPMSGFS_READAHEAD);
+              hf->rahead = 0;
+              hf->ratail = ret > 0 ? ret : 0;
+              if (ret <= 0)
+                {
+                  goto errout_with_semaphore;
+                }
+            }
+        }
+
+      if (hf->rahead < hf->ratail)
+        {
+          ret = MIN(buflen, hf->ratail - hf->rahead);
+          memcpy(buffer, hf->rabuf + hf->rahead, ret);
+          hf->rahead   += ret;
+          filep->f_pos += ret;
+          goto errout_with_semaphore;
+        }
+    }
+
+  rpmsgfs_radrop(fs, hf);
+#endif
+
   /* Call the host to perform the read */
 
   ret = rpmsgfs_client_read(fs->handle, hf->fd, buffer, buflen);
@@ -517,6 +605,9 @@ static ssize_t rpmsgfs_read(FAR struct file *filep, FAR char *buffer,
       filep->f_pos += ret;
     }
 
+#if CONFIG_FS_RPMSGFS_READAHEAD > 0
+errout_with_semaphore:
+#endif
   rpmsgfs_semgive(fs);
   return ret;
 }
@@ -607,6 +698,7 @@ static off_t rpmsgfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Call our internal routine to perform the seek */
 
+  rpmsgfs_radrop(fs, hf);
   ret = rpmsgfs_client_lseek(fs->handle, hf->fd, offset, whence);
   if (ret >= 0)
     {
@@ -650,6 +742,7 @@ static int rpmsgfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Call our internal routine to perform the ioctl */
 
+  rpmsgfs_radrop(fs, hf);
   ret = rpmsgfs_client_ioctl(fs->handle, hf->fd, cmd, arg);
 
   rpmsgfs_semgive(fs);
@@ -30,6 +30,8 @@
 #include <nuttx/mm/mm.h>
 
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <string.h>
 #include <assert.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -47,6 +49,8 @@ static ssize_t sock_file_read(FAR struct file *filep, FAR char *buffer,
                               size_t buflen);
 static ssize_t sock_file_write(FAR struct file *filep,
                                FAR const char *buffer, size_t buflen);
+static ssize_t sock_file_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt);
 static int sock_file_ioctl(FAR struct file *filep, int cmd,
                            unsigned long arg);
 static int sock_file_poll(FAR struct file *filep, struct pollfd *fds,
@@ -58,16 +62,18 @@ static int sock_file_poll(FAR struct file *filep, struct pollfd *fds,
 
 static const struct file_operations g_sock_fileops =
 {
-  sock_file_open,   /* open */
-  sock_file_close,  /* close */
-  sock_file_read,   /* read */
-  sock_file_write,  /* write */
-  NULL,             /* seek */
-  sock_file_ioctl,  /* ioctl */
-  sock_file_poll    /* poll */
+  sock_file_open,    /* open */
+  sock_file_close,   /* close */
+  sock_file_read,    /* read */
+  sock_file_write,   /* write */
+  NULL,              /* seek */
+  sock_file_ioctl,   /* ioctl */
+  sock_file_poll     /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
-  , NULL            /* unlink */
+  , NULL             /* unlink */
 #endif
+  , NULL             /* readv */
+  , sock_file_writev /* writev */
 };
 
 static struct inode g_sock_inode =
@@ -129,6 +135,56 @@ static ssize_t sock_file_write(FAR struct file *filep,
   return psock_send(filep->f_priv, buffer, buflen, 0);
 }
 
+static ssize_t sock_file_writev(FAR struct file *filep,
+                                FAR const struct iovec *iov, int iovcnt)
+{
+  struct msghdr msg;
+  ssize_t ntotal = 0;
+  ssize_t ret;
+  int i;
+
+  if (iovcnt == 0)
+    {
+      return 0;
+    }
+
+  /* Send all buffers as one message: A datagram is not split */
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov    = (FAR struct iovec *)iov;
+  msg.msg_iovlen = iovcnt;
+
+  ret = psock_sendmsg(filep->f_priv, &msg, 0);
+  if (ret != -ENOTSUP)
+    {
+      return ret;
+    }
+
+  /* The address family supports only one buffer per message */
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      ret = psock_send(filep->f_priv, iov[i].iov_base, iov[i].iov_len, 0);
+      if (ret < 0)
+        {
+          return ntotal > 0 ? ntotal : ret;
+        }
+
+      ntotal += ret;
+      if ((size_t)ret < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+
 static int sock_file_ioctl(FAR struct file *filep, int cmd,
                            unsigned long arg)
 {
@@ -456,6 +456,68 @@ spiffs_objlu_find_free_objid_compact_callback(FAR struct spiffs_s *fs,
   return SPIFFS_VIS_COUNTINUE;
 }
 
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+/****************************************************************************
+ * Name: spiffs_lucache_slot and spiffs_namecache_slot
+ *
+ * Description:
+ *   Return the cache entry for an object ID and span index or for a name.
+ *
+ ****************************************************************************/
+
+static FAR struct spiffs_lucache_s *
+spiffs_lucache_slot(FAR struct spiffs_s *fs, int16_t objid, int16_t spndx)
+{
+  uint32_t key = (uint16_t)objid * 31u + (uint16_t)spndx;
+
+  return &fs->lucache[key % CONFIG_SPIFFS_LUCACHE_SIZE];
+}
+
+static uint32_t spiffs_namecache_hash(FAR const uint8_t *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ *name++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: spiffs_lucache_forget
+ *
+ * Description:
+ *   Drop all cache entries referring to the pages 'pgndx' through
+ *   'pgndx' + 'npages' - 1.
+ *
+ ****************************************************************************/
+
+static void spiffs_lucache_forget(FAR struct spiffs_s *fs, int16_t pgndx,
+                                  int npages)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_SPIFFS_LUCACHE_SIZE; i++)
+    {
+      if (fs->lucache[i].pgndx >= pgndx &&
+          fs->lucache[i].pgndx < pgndx + npages)
+        {
+          fs->lucache[i].pgndx = 0;
+        }
+
+      if (fs->namecache[i].pgndx >= pgndx &&
+          fs->namecache[i].pgndx < pgndx + npages)
+        {
+          fs->namecache[i].pgndx = 0;
+        }
+    }
+}
+#else
+#  define spiffs_lucache_forget(fs, pgndx, npages)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -760,6 +822,9 @@ int spiffs_erase_block(FAR struct spiffs_s *fs, int16_t blkndx)
   int32_t size  = SPIFFS_GEO_BLOCK_SIZE(fs);
   int ret;
 
+  spiffs_lucache_forget(fs, SPIFFS_PAGE_FOR_BLOCK(fs, blkndx),
+                        SPIFFS_GEO_PAGES_PER_BLOCK(fs));
+
   /* Here we ignore the return value and just try erasing the block */
 
   while (size > 0)
@@ -977,10 +1042,39 @@ int spiffs_objlu_find_id_and_span(FAR struct spiffs_s *fs, int16_t objid,
                                   int16_t spndx, int16_t exclusion_pgndx,
                                   FAR int16_t *pgndx)
 {
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  FAR struct spiffs_lucache_s *slot;
+#endif
   int16_t blkndx;
   int entry;
   int ret;
 
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  /* Check the cached page with the same test as the lookup scan */
+
+  slot = spiffs_lucache_slot(fs, objid, spndx);
+  if (slot->pgndx != 0 && slot->objid == objid && slot->spndx == spndx)
+    {
+      blkndx = SPIFFS_BLOCK_FOR_PAGE(fs, slot->pgndx);
+      entry  = SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs, slot->pgndx);
+
+      ret = spiffs_objlu_find_id_and_span_callback(fs, objid, blkndx, entry,
+                              exclusion_pgndx ? &exclusion_pgndx : 0,
+                              &spndx);
+      if (ret == OK)
+        {
+          if (pgndx != NULL)
+            {
+              *pgndx = slot->pgndx;
+            }
+
+          return OK;
+        }
+
+      slot->pgndx = 0;
+    }
+#endif
+
   ret = spiffs_foreach_objlu(fs, fs->lu_blkndx, fs->lu_entry,
                              SPIFFS_VIS_CHECK_ID, objid,
                              spiffs_objlu_find_id_and_span_callback,
@@ -1002,6 +1096,15 @@ int spiffs_objlu_find_id_and_span(FAR struct spiffs_s *fs, int16_t objid,
       *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
     }
 
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  if (ret == OK)
+    {
+      slot->objid = objid;
+      slot->spndx = spndx;
+      slot->pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+    }
+#endif
+
   fs->lu_blkndx = blkndx;
   fs->lu_entry  = entry;
 
@@ -1276,6 +1379,8 @@ int spiffs_page_delete(FAR struct spiffs_s *fs, int16_t pgndx)
   uint8_t flags;
   int ret;
 
+  spiffs_lucache_forget(fs, pgndx, 1);
+
   /* Mark deleted entry in source object lookup */
 
   int16_t d_objid = SPIFFS_OBJID_DELETED;
@@ -2754,10 +2859,42 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
                              const uint8_t name[CONFIG_SPIFFS_NAME_MAX],
                              FAR int16_t *pgndx)
 {
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  FAR struct spiffs_namecache_s *slot;
+  uint32_t hash;
+#endif
   int16_t blkndx;
   int entry;
   int ret;
 
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  /* Check the cached page with the same test as the lookup scan.  Any
+   * object ID with SPIFFS_OBJID_NDXFLAG lets the test read the header.
+   */
+
+  hash = spiffs_namecache_hash(name);
+  slot = &fs->namecache[hash % CONFIG_SPIFFS_LUCACHE_SIZE];
+  if (slot->pgndx != 0 && slot->hash == hash)
+    {
+      blkndx = SPIFFS_BLOCK_FOR_PAGE(fs, slot->pgndx);
+      entry  = SPIFFS_OBJ_LOOKUP_ENTRY_FOR_PAGE(fs, slot->pgndx);
+
+      ret = spiffs_find_objhdr_pgndx_callback(fs, SPIFFS_OBJID_NDXFLAG,
+                                              blkndx, entry, name, NULL);
+      if (ret == OK)
+        {
+          if (pgndx != NULL)
+            {
+              *pgndx = slot->pgndx;
+            }
+
+          return OK;
+        }
+
+      slot->pgndx = 0;
+    }
+#endif
+
   ret = spiffs_foreach_objlu(fs, fs->lu_blkndx, fs->lu_entry,
                              0, 0, spiffs_find_objhdr_pgndx_callback,
                              name, 0, &blkndx, &entry);
@@ -2777,6 +2914,14 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
       *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
     }
 
+#if CONFIG_SPIFFS_LUCACHE_SIZE > 0
+  if (ret == OK)
+    {
+      slot->hash  = hash;
+      slot->pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+    }
+#endif
+
   fs->lu_blkndx = blkndx;
   fs->lu_entry  = entry;
 
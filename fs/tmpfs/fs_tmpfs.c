@@ -53,6 +53,15 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+#  define TMPFS_NCHUNKS(size) \
+     (((size) + CONFIG_FS_TMPFS_CHUNKSIZE - 1) / CONFIG_FS_TMPFS_CHUNKSIZE)
+#endif
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
 #define tmpfs_lock(fs) \
            nxrmutex_lock(&fs->tfs_lock)
 #define tmpfs_lock_object(to) \
@@ -91,6 +100,11 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static void tmpfs_read_file(FAR struct tmpfs_file_s *tfo,
+              FAR char *buffer, off_t pos, size_t buflen);
+static ssize_t tmpfs_write_file(FAR struct tmpfs_file_s *tfo,
+              FAR const char *buffer, off_t pos, size_t buflen);
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -258,6 +272,87 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
  * Name: tmpfs_realloc_file
  ****************************************************************************/
 
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  FAR uint8_t **newchunks;
+  size_t nchunks;
+  size_t nentries;
+  size_t index;
+  size_t rem;
+
+  nchunks = TMPFS_NCHUNKS(newsize);
+
+  /* Are we growing or shrinking the file? */
+
+  if (newsize < tfo->tfo_size)
+    {
+      /* Shrinking ... Free the chunks beyond the new end of the file and
+       * clear the rest of the new last chunk, so that the file reads back
+       * zeros if it is extended again.
+       */
+
+      for (index = nchunks; index < tfo->tfo_nchunks; index++)
+        {
+          if (tfo->tfo_chunks[index] != NULL)
+            {
+              kmm_free(tfo->tfo_chunks[index]);
+              tfo->tfo_chunks[index] = NULL;
+              tfo->tfo_alloc        -= CONFIG_FS_TMPFS_CHUNKSIZE;
+            }
+        }
+
+      rem = newsize % CONFIG_FS_TMPFS_CHUNKSIZE;
+      if (rem > 0 && tfo->tfo_chunks[nchunks - 1] != NULL)
+        {
+          memset(tfo->tfo_chunks[nchunks - 1] + rem, 0,
+                 CONFIG_FS_TMPFS_CHUNKSIZE - rem);
+        }
+
+      /* Release the chunk table of an empty file */
+
+      if (newsize == 0)
+        {
+          kmm_free(tfo->tfo_chunks);
+          tfo->tfo_alloc  -= tfo->tfo_nchunks * sizeof(FAR uint8_t *);
+          tfo->tfo_chunks  = NULL;
+          tfo->tfo_nchunks = 0;
+        }
+    }
+  else if (nchunks > tfo->tfo_nchunks)
+    {
+      /* Growing beyond the chunk table.  Only the table is reallocated,
+       * doubling its size (but by no more than 64 entries) to keep appends
+       * cheap.  The chunks themselves are allocated when they are written.
+       */
+
+      nentries = MIN(2 * tfo->tfo_nchunks, tfo->tfo_nchunks + 64);
+      if (nentries < nchunks)
+        {
+          nentries = nchunks;
+        }
+
+      newchunks = kmm_realloc(tfo->tfo_chunks,
+                              nentries * sizeof(FAR uint8_t *));
+      if (newchunks == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      memset(&newchunks[tfo->tfo_nchunks], 0,
+             (nentries - tfo->tfo_nchunks) * sizeof(FAR uint8_t *));
+
+      tfo->tfo_alloc  += (nentries - tfo->tfo_nchunks) *
+                         sizeof(FAR uint8_t *);
+      tfo->tfo_chunks  = newchunks;
+      tfo->tfo_nchunks = nentries;
+    }
+
+  tfo->tfo_size = newsize;
+  return OK;
+}
+#else
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
                               size_t newsize)
 {
@@ -311,6 +406,131 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   tfo->tfo_data  = newdata;
   return OK;
 }
+#endif
+
+/****************************************************************************
+ * Name: tmpfs_read_file
+ *
+ * Description:
+ *   Copy 'buflen' bytes of file data at 'pos' to 'buffer'.  The range must
+ *   lie within the file.
+ *
+ ****************************************************************************/
+
+static void tmpfs_read_file(FAR struct tmpfs_file_s *tfo,
+                            FAR char *buffer, off_t pos, size_t buflen)
+{
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  FAR uint8_t *chunk;
+  size_t offset;
+  size_t ncopy;
+
+  while (buflen > 0)
+    {
+      chunk  = tfo->tfo_chunks[pos / CONFIG_FS_TMPFS_CHUNKSIZE];
+      offset = pos % CONFIG_FS_TMPFS_CHUNKSIZE;
+      ncopy  = MIN(buflen, CONFIG_FS_TMPFS_CHUNKSIZE - offset);
+
+      /* Holes read back as zeros */
+
+      if (chunk != NULL)
+        {
+          memcpy(buffer, chunk + offset, ncopy);
+        }
+      else
+        {
+          memset(buffer, 0, ncopy);
+        }
+
+      buffer += ncopy;
+      pos    += ncopy;
+      buflen -= ncopy;
+    }
+#else
+  memcpy(buffer, &tfo->tfo_data[pos], buflen);
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_write_file
+ *
+ * Description:
+ *   Copy 'buflen' bytes from 'buffer' to the file data at 'pos'.  The range
+ *   must lie within the file.  Returns the number of bytes written or
+ *   -ENOMEM if not even the first chunk could be allocated.
+ *
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_file(FAR struct tmpfs_file_s *tfo,
+                                FAR const char *buffer, off_t pos,
+                                size_t buflen)
+{
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  FAR uint8_t **chunk;
+  ssize_t nwritten = 0;
+  size_t offset;
+  size_t ncopy;
+
+  while (buflen > 0)
+    {
+      chunk  = &tfo->tfo_chunks[pos / CONFIG_FS_TMPFS_CHUNKSIZE];
+      offset = pos % CONFIG_FS_TMPFS_CHUNKSIZE;
+      ncopy  = MIN(buflen, CONFIG_FS_TMPFS_CHUNKSIZE - offset);
+
+      /* Fill the hole with a new chunk */
+
+      if (*chunk == NULL)
+        {
+          *chunk = kmm_zalloc(CONFIG_FS_TMPFS_CHUNKSIZE);
+          if (*chunk == NULL)
+            {
+              return nwritten > 0 ? nwritten : -ENOMEM;
+            }
+
+          tfo->tfo_alloc += CONFIG_FS_TMPFS_CHUNKSIZE;
+        }
+
+      memcpy(*chunk + offset, buffer, ncopy);
+
+      buffer   += ncopy;
+      pos      += ncopy;
+      buflen   -= ncopy;
+      nwritten += ncopy;
+    }
+
+  return nwritten;
+#else
+  memcpy(&tfo->tfo_data[pos], buffer, buflen);
+  return buflen;
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_file
+ *
+ * Description:
+ *   Free the data of a file object
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo)
+{
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  size_t index;
+
+  for (index = 0; index < tfo->tfo_nchunks; index++)
+    {
+      if (tfo->tfo_chunks[index] != NULL)
+        {
+          kmm_free(tfo->tfo_chunks[index]);
+        }
+    }
+
+  kmm_free(tfo->tfo_chunks);
+#else
+  kmm_free(tfo->tfo_data);
+#endif
+}
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -348,7 +568,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
     }
 
@@ -522,7 +742,12 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
   tfo->tfo_refs  = 1;
   tfo->tfo_flags = 0;
   tfo->tfo_size  = 0;
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  tfo->tfo_nchunks = 0;
+  tfo->tfo_chunks  = NULL;
+#else
   tfo->tfo_data  = NULL;
+#endif
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1073,7 +1298,11 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1149,7 +1378,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_file(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1442,7 +1671,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
       return OK;
     }
@@ -1488,7 +1717,11 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   nread    = buflen;
   endpos   = startpos + buflen;
 
-  if (endpos > tfo->tfo_size)
+  if (startpos >= tfo->tfo_size)
+    {
+      nread  = 0;
+    }
+  else if (endpos > tfo->tfo_size)
     {
       endpos = tfo->tfo_size;
       nread  = endpos - startpos;
@@ -1496,7 +1729,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
+  tmpfs_read_file(tfo, buffer, startpos, nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1514,6 +1747,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct tmpfs_file_s *tfo;
   ssize_t nwritten;
+  size_t oldsize;
   off_t startpos;
   off_t endpos;
   int ret;
@@ -1537,8 +1771,8 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
   /* Handle attempts to write beyond the end of the file */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
   endpos   = startpos + buflen;
+  oldsize  = tfo->tfo_size;
 
   if (endpos > tfo->tfo_size)
     {
@@ -1551,9 +1785,26 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
         }
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the user buffer to the memory object */
+
+  nwritten = tmpfs_write_file(tfo, buffer, startpos, buflen);
+  if (nwritten < (ssize_t)buflen)
+    {
+      /* Out of memory.  Do not extend the file beyond the data written. */
+
+      endpos = startpos + (nwritten > 0 ? nwritten : 0);
+      if (endpos < tfo->tfo_size)
+        {
+          tmpfs_realloc_file(tfo, endpos > oldsize ? endpos : oldsize);
+        }
+
+      if (nwritten < 0)
+        {
+          ret = nwritten;
+          goto errout_with_lock;
+        }
+    }
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
   filep->f_pos += nwritten;
 
   /* Release the lock on the file */
@@ -1644,6 +1895,14 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   DEBUGASSERT(tfo != NULL);
 
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  /* No ioctl command is supported:  The file data stored in chunks is not
+   * contiguous and cannot be mapped directly.
+   */
+
+  UNUSED(tfo);
+  UNUSED(ppv);
+#else
   /* Only one ioctl command is supported */
 
   if (cmd == FIOC_MMAP && ppv != NULL)
@@ -1655,6 +1914,7 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       *ppv = (FAR void *)tfo->tfo_data;
       return OK;
     }
+#endif
 
   ferr("ERROR: Invalid cmd: %d\n", cmd);
   return -ENOTTY;
@@ -1787,14 +2047,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
           goto errout_with_lock;
         }
 
+#if CONFIG_FS_TMPFS_CHUNKSIZE == 0
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  Chunked files read back zeros beyond the old end already.
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2237,7 +2499,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_file(tfo);
       kmm_free(tfo);
     }
 
@@ -102,6 +102,12 @@ struct tmpfs_directory_s
 #define SIZEOF_TMPFS_DIRECTORY(n) ((n) * sizeof(struct tmpfs_dirent_s))
 
 /* The form of a regular file memory object
+ *
+ * The file data is either kept in one contiguous buffer or, if
+ * CONFIG_FS_TMPFS_CHUNKSIZE is non-zero, in chunks of that size.  Chunks
+ * are allocated when they are first written; a chunk that was never
+ * written is a hole and reads back as zeros.  The bytes of the chunks
+ * beyond the end of the file are always zero.
  *
  * NOTE that in this very simplified implementation, there is no per-open
  * state.  The file memory object also serves as the open file object,
@@ -123,7 +129,12 @@ struct tmpfs_file_s
 
   uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
   size_t        tfo_size;  /* Valid file size */
+#if CONFIG_FS_TMPFS_CHUNKSIZE > 0
+  size_t        tfo_nchunks; /* Number of entries in tfo_chunks */
+  FAR uint8_t **tfo_chunks;  /* The chunks of file data, NULL: a hole */
+#else
   FAR uint8_t  *tfo_data;  /* File data starts here */
+#endif
 };
 
 /* This structure represents one instance of a TMPFS file system */
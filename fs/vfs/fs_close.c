@@ -30,6 +30,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -56,10 +57,12 @@
 int file_close(FAR struct file *filep)
 {
   struct inode *inode;
+  uint32_t start;
   int ret = OK;
 
   DEBUGASSERT(filep != NULL);
   inode = filep->f_inode;
+  start = fs_opstat_start();
 
   /* Check if the struct file is open (i.e., assigned an inode) */
 
@@ -86,5 +89,6 @@ int file_close(FAR struct file *filep)
       filep->f_priv   = NULL;
     }
 
+  fs_opstat_record(FS_OPSTAT_CLOSE, start, ret);
   return ret;
 }
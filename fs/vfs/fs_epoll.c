@@ -29,31 +29,69 @@
 #include <inttypes.h>
 #include <stdint.h>
 #include <poll.h>
+#include <queue.h>
 #include <errno.h>
 #include <string.h>
 #include <debug.h>
 #include <semaphore.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/signal.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The state of a registered file descriptor */
+
+#define EPOLL_NODE_IDLE     0  /* Waiting for an event */
+#define EPOLL_NODE_READY    1  /* In the ready list */
+#define EPOLL_NODE_REARM    2  /* Reported level-triggered, poll again */
+#define EPOLL_NODE_DISABLED 3  /* Reported EPOLLONESHOT, wait for MOD */
+
+/* The bits of epoll_event::events that are not passed to the driver */
+
+#define EPOLL_NODE_FLAGS    (EPOLLONESHOT | EPOLLET | POLLMASK)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One file descriptor registered with epoll_ctl().  The file descriptor
+ * stays set up for poll until it is removed again; the notifiers of the
+ * driver link it into the ready list through epoll_notify().
+ */
+
+struct epoll_head;
+struct epoll_node
+{
+  dq_entry_t node;                 /* In the set or the free list */
+  dq_entry_t rnode;                /* In the ready or the rearm list */
+  FAR struct epoll_head *eph;      /* The epoll instance */
+  uint8_t state;                   /* See EPOLL_NODE_* */
+  uint32_t events;                 /* The events given to epoll_ctl() */
+  epoll_data_t data;               /* The data given to epoll_ctl() */
+  struct pollfd pfd;               /* Set up for poll on the driver */
+};
+
 struct epoll_head
 {
-  int size;
-  int occupied;
   int crefs;
-  sem_t sem;
-  struct file fp;
-  struct inode in;
-  FAR epoll_data_t *data;
-  FAR struct pollfd *poll;
+  mutex_t lock;                    /* Protects the set and the free list */
+  sem_t waitsem;                   /* Posted on events */
+  int npending;                    /* Posts of waitsem by epoll_notify() */
+  dq_queue_t setup;                /* The registered file descriptors */
+  dq_queue_t free;                 /* The unused nodes */
+  dq_queue_t ready;                /* Nodes with events to report */
+  dq_queue_t rearm;                /* Nodes to poll again */
+  FAR struct pollfd *fds;          /* A poll on the epoll descriptor */
+  struct epoll_node node[1];       /* Actual size given to epoll_create() */
 };
 
 /****************************************************************************
@@ -124,92 +162,398 @@ static FAR struct epoll_head *epoll_head_from_fd(int fd)
   return (FAR struct epoll_head *)filep->f_priv;
 }
 
+/****************************************************************************
+ * Name: epoll_notify
+ *
+ * Description:
+ *   The poll callback of a registered file descriptor.  Called by the
+ *   driver, possibly from an interrupt handler, after it updated revents.
+ *
+ ****************************************************************************/
+
+static void epoll_notify(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node *epn = (FAR struct epoll_node *)fds->arg;
+  FAR struct epoll_head *eph = epn->eph;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (epn->state == EPOLL_NODE_IDLE && fds->revents != 0)
+    {
+      epn->state = EPOLL_NODE_READY;
+      dq_addlast(&epn->rnode, &eph->ready);
+
+      eph->npending++;
+      nxsem_post(&eph->waitsem);
+
+      if (eph->fds != NULL)
+        {
+          eph->fds->revents |= eph->fds->events & POLLIN;
+          if (eph->fds->revents != 0)
+            {
+              poll_notify(eph->fds);
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_scan
+ *
+ * Description:
+ *   Move the registered file descriptors with pending events into the
+ *   ready list.  This is only needed for drivers that post the semaphore
+ *   of the pollfd directly instead of calling poll_notify().
+ *
+ ****************************************************************************/
+
+static void epoll_scan(FAR struct epoll_head *eph)
+{
+  FAR struct epoll_node *epn;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  for (epn = (FAR struct epoll_node *)dq_peek(&eph->setup);
+       epn != NULL;
+       epn = (FAR struct epoll_node *)dq_next(&epn->node))
+    {
+      if (epn->state == EPOLL_NODE_IDLE && epn->pfd.revents != 0)
+        {
+          epn->state = EPOLL_NODE_READY;
+          dq_addlast(&epn->rnode, &eph->ready);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_drain
+ *
+ * Description:
+ *   Consume the pending posts of the wait semaphore after a wakeup.  If any
+ *   of them did not come from epoll_notify(), some driver reported events
+ *   without running the callback, so look for them.
+ *
+ ****************************************************************************/
+
+static void epoll_drain(FAR struct epoll_head *eph)
+{
+  irqstate_t flags;
+  int nposts = 1;
+  bool scan;
+
+  flags = enter_critical_section();
+  while (nxsem_trywait(&eph->waitsem) == OK)
+    {
+      nposts++;
+    }
+
+  scan = nposts > eph->npending;
+  eph->npending = scan ? 0 : eph->npending - nposts;
+  leave_critical_section(flags);
+
+  if (scan)
+    {
+      epoll_scan(eph);
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_fdpoll
+ *
+ * Description:
+ *   Set up or tear down the poll of a registered file descriptor.
+ *
+ ****************************************************************************/
+
+static int epoll_fdpoll(FAR struct epoll_node *epn, bool setup)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(epn->pfd.fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_poll(filep, &epn->pfd, setup);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Start to monitor a registered file descriptor.  The driver reports the
+ *   events already in effect immediately.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_head *eph,
+                       FAR struct epoll_node *epn)
+{
+  epn->eph         = eph;
+  epn->state       = EPOLL_NODE_IDLE;
+  epn->pfd.events  = (epn->events & ~EPOLL_NODE_FLAGS) | POLLERR | POLLHUP;
+  epn->pfd.revents = 0;
+  epn->pfd.sem     = &eph->waitsem;
+  epn->pfd.priv    = NULL;
+  epn->pfd.arg     = epn;
+  epn->pfd.cb      = epoll_notify;
+
+  return epoll_fdpoll(epn, true);
+}
+
+/****************************************************************************
+ * Name: epoll_teardown
+ *
+ * Description:
+ *   Stop to monitor a registered file descriptor and forget its events.
+ *
+ ****************************************************************************/
+
+static void epoll_teardown(FAR struct epoll_head *eph,
+                           FAR struct epoll_node *epn)
+{
+  irqstate_t flags;
+
+  epoll_fdpoll(epn, false);
+
+  flags = enter_critical_section();
+  if (epn->state == EPOLL_NODE_READY)
+    {
+      dq_rem(&epn->rnode, &eph->ready);
+    }
+  else if (epn->state == EPOLL_NODE_REARM)
+    {
+      dq_rem(&epn->rnode, &eph->rearm);
+    }
+
+  epn->state       = EPOLL_NODE_IDLE;
+  epn->pfd.revents = 0;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_rearm
+ *
+ * Description:
+ *   Poll the level-triggered file descriptors reported by the last wait
+ *   once more.  The driver reports them again if their events are still in
+ *   effect.
+ *
+ ****************************************************************************/
+
+static void epoll_rearm(FAR struct epoll_head *eph)
+{
+  FAR struct epoll_node *epn;
+
+  while ((epn = (FAR struct epoll_node *)dq_peek(&eph->rearm)) != NULL)
+    {
+      epoll_teardown(eph, epn);
+      epoll_fdpoll(epn, true);
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Take up to 'maxevents' file descriptors from the ready list.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node *epn;
+  irqstate_t flags;
+  int i = 0;
+
+  flags = enter_critical_section();
+  while (i < maxevents &&
+         (epn = (FAR struct epoll_node *)dq_remfirst(&eph->ready)) != NULL)
+    {
+      evs[i].data     = epn->data;
+      evs[i++].events = epn->pfd.revents;
+      epn->pfd.revents = 0;
+
+      if ((epn->events & EPOLLONESHOT) != 0)
+        {
+          epn->state = EPOLL_NODE_DISABLED;
+        }
+      else if ((epn->events & EPOLLET) != 0)
+        {
+          epn->state = EPOLL_NODE_IDLE;
+        }
+      else
+        {
+          epn->state = EPOLL_NODE_REARM;
+          dq_addlast(&epn->rnode, &eph->rearm);
+        }
+    }
+
+  if (eph->fds != NULL && dq_empty(&eph->ready))
+    {
+      eph->fds->revents &= ~POLLIN;
+    }
+
+  leave_critical_section(flags);
+  return i;
+}
+
+static FAR struct epoll_node *epoll_find(FAR struct epoll_head *eph, int fd)
+{
+  FAR struct epoll_node *epn;
+
+  for (epn = (FAR struct epoll_node *)dq_peek(&eph->setup);
+       epn != NULL;
+       epn = (FAR struct epoll_node *)dq_next(&epn->node))
+    {
+      if (epn->pfd.fd == fd)
+        {
+          break;
+        }
+    }
+
+  return epn;
+}
+
 static int epoll_do_open(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_priv;
   int ret;
 
-  ret = nxsem_wait(&eph->sem);
+  ret = nxmutex_lock(&eph->lock);
   if (ret < 0)
     {
       return ret;
     }
 
   eph->crefs++;
-  nxsem_post(&eph->sem);
+  nxmutex_unlock(&eph->lock);
   return ret;
 }
 
 static int epoll_do_close(FAR struct file *filep)
 {
   FAR struct epoll_head *eph = filep->f_priv;
+  FAR struct epoll_node *epn;
   int ret;
 
-  ret = nxsem_wait(&eph->sem);
+  ret = nxmutex_lock(&eph->lock);
   if (ret < 0)
     {
       return ret;
     }
 
   eph->crefs--;
-  nxsem_post(&eph->sem);
   if (eph->crefs <= 0)
     {
+      while ((epn = (FAR struct epoll_node *)
+                    dq_remfirst(&eph->setup)) != NULL)
+        {
+          epoll_teardown(eph, epn);
+        }
+
+      nxmutex_unlock(&eph->lock);
+      nxmutex_destroy(&eph->lock);
+      nxsem_destroy(&eph->waitsem);
       kmm_free(eph);
+      return ret;
     }
 
+  nxmutex_unlock(&eph->lock);
   return ret;
 }
 
 static int epoll_do_poll(FAR struct file *filep,
                          FAR struct pollfd *fds, bool setup)
 {
-  return OK;
+  FAR struct epoll_head *eph = filep->f_priv;
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      if (eph->fds != NULL)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          eph->fds = fds;
+          if (!dq_empty(&eph->ready))
+            {
+              fds->revents |= fds->events & POLLIN;
+              if (fds->revents != 0)
+                {
+                  poll_notify(fds);
+                }
+            }
+        }
+    }
+  else if (eph->fds == fds)
+    {
+      eph->fds = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
 }
 
 static int epoll_do_create(int size, int flags)
 {
   FAR struct epoll_head *eph;
-  int reserve = size + 1;
   int fd;
+  int i;
+
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return -1;
+    }
 
   eph = (FAR struct epoll_head *)
         kmm_zalloc(sizeof(struct epoll_head) +
-                   sizeof(epoll_data_t) * reserve +
-                   sizeof(struct pollfd) * reserve);
+                   sizeof(struct epoll_node) * (size - 1));
   if (eph == NULL)
     {
       set_errno(ENOMEM);
       return -1;
     }
 
-  nxsem_init(&eph->sem, 0, 0);
-  nxsem_set_protocol(&eph->sem, SEM_PRIO_NONE);
-  eph->size = size;
-  eph->data = (FAR epoll_data_t *)(eph + 1);
-  eph->poll = (FAR struct pollfd *)(eph->data + reserve);
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
 
-  INODE_SET_DRIVER(&eph->in);
-  eph->in.u.i_ops = &g_epoll_ops;
-  eph->fp.f_inode = &eph->in;
-  eph->in.i_private = eph;
+  nxmutex_init(&eph->lock);
+  nxsem_init(&eph->waitsem, 0, 0);
+  nxsem_set_protocol(&eph->waitsem, SEM_PRIO_NONE);
+  eph->crefs = 1;
 
-  eph->poll[0].ptr = &eph->fp;
-  eph->poll[0].events = POLLIN | POLLFILE;
+  for (i = 0; i < size; i++)
+    {
+      dq_addlast(&eph->node[i].node, &eph->free);
+    }
 
   /* Alloc the file descriptor */
 
   fd = files_allocate(&g_epoll_inode, flags, 0, eph, 0);
   if (fd < 0)
     {
-      nxsem_destroy(&eph->sem);
+      nxmutex_destroy(&eph->lock);
+      nxsem_destroy(&eph->waitsem);
       kmm_free(eph);
       set_errno(-fd);
       return -1;
     }
 
   inode_addref(&g_epoll_inode);
-  nxsem_post(&eph->sem);
   return fd;
 }
 
@@ -269,17 +613,27 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a file descriptor of an epoll instance.  The file
+ *   descriptor stays set up for poll while it is registered, so it must be
+ *   removed with EPOLL_CTL_DEL before it is closed.
  *
  * Input Parameters:
+ *   epfd - The epoll descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The file descriptor to operate on
+ *   ev   - The events and the data to report, ignored by EPOLL_CTL_DEL
  *
  * Returned Value:
+ *   Zero on success.  On error, -1 is returned, and errno is set
+ *   appropriately.
  *
  ****************************************************************************/
 
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
   FAR struct epoll_head *eph;
-  int i;
+  FAR struct epoll_node *epn;
+  int ret;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -287,88 +641,98 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
       return -1;
     }
 
+  ret = nxmutex_lock(&eph->lock);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return -1;
+    }
+
+  epn = epoll_find(eph, fd);
+
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        if (eph->occupied >= eph->size)
+        finfo("%08x CTL ADD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn != NULL)
           {
-            set_errno(ENOMEM);
-            return -1;
+            ret = -EEXIST;
+            break;
           }
 
-        for (i = 1; i <= eph->occupied; i++)
+        epn = (FAR struct epoll_node *)dq_remfirst(&eph->free);
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                set_errno(EEXIST);
-                return -1;
-              }
+            ret = -ENOMEM;
+            break;
           }
 
-        eph->data[++eph->occupied]      = ev->data;
-        eph->poll[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->poll[eph->occupied].fd     = fd;
-
-        break;
+        epn->pfd.fd = fd;
+        epn->events = ev->events;
+        epn->data   = ev->data;
 
-      case EPOLL_CTL_DEL:
-        for (i = 1; i <= eph->occupied; i++)
+        ret = epoll_setup(eph, epn);
+        if (ret < 0)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                if (i != eph->occupied)
-                  {
-                    memmove(&eph->data[i], &eph->data[i + 1],
-                            sizeof(epoll_data_t) * (eph->occupied - i));
-                    memmove(&eph->poll[i], &eph->poll[i + 1],
-                            sizeof(struct pollfd) * (eph->occupied - i));
-                  }
-
-                break;
-              }
+            epoll_teardown(eph, epn);
+            dq_addlast(&epn->node, &eph->free);
+            break;
           }
 
-        if (i > eph->occupied)
+        dq_addlast(&epn->node, &eph->setup);
+        break;
+
+      case EPOLL_CTL_DEL:
+        if (epn == NULL)
           {
-            set_errno(ENOENT);
-            return -1;
+            ret = -ENOENT;
+            break;
           }
 
-        eph->occupied--;
+        dq_rem(&epn->node, &eph->setup);
+        epoll_teardown(eph, epn);
+        dq_addlast(&epn->node, &eph->free);
         break;
 
       case EPOLL_CTL_MOD:
-        finfo("%08x CTL MOD(%d): fd=%d ev=%08" PRIx32 "\n",
-              epfd, eph->occupied, fd, ev->events);
-        for (i = 1; i <= eph->occupied; i++)
+        finfo("%08x CTL MOD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+        if (epn == NULL)
           {
-            if (eph->poll[i].fd == fd)
-              {
-                eph->data[i]        = ev->data;
-                eph->poll[i].events = ev->events | POLLERR | POLLHUP;
-                break;
-              }
+            ret = -ENOENT;
+            break;
           }
 
-        if (i > eph->occupied)
+        /* Polling the driver again re-arms EPOLLONESHOT and reports the
+         * events in effect for the new event mask.
+         */
+
+        epoll_teardown(eph, epn);
+        epn->events = ev->events;
+        epn->data   = ev->data;
+
+        ret = epoll_setup(eph, epn);
+        if (ret < 0)
           {
-            set_errno(ENOENT);
-            return -1;
+            dq_rem(&epn->node, &eph->setup);
+            epoll_teardown(eph, epn);
+            dq_addlast(&epn->node, &eph->free);
           }
 
         break;
 
       default:
-        set_errno(EINVAL);
-        return -1;
+        ret = -EINVAL;
+        break;
     }
 
-  if (eph->poll[0].sem)
+  nxmutex_unlock(&eph->lock);
+
+  if (ret < 0)
     {
-      eph->poll[0].revents |= eph->poll[0].events;
-      nxsem_post(eph->poll[0].sem);
+      set_errno(-ret);
+      return -1;
     }
 
   return 0;
@@ -376,18 +740,36 @@ int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 
 /****************************************************************************
  * Name: epoll_pwait
+ *
+ * Description:
+ *   Wait for events on the file descriptors registered with an epoll
+ *   instance.  Only the file descriptors in the ready list are visited, so
+ *   the cost of a wait does not depend on the number of registered file
+ *   descriptors.
+ *
+ * Input Parameters:
+ *   epfd      - The epoll descriptor
+ *   evs       - The array receiving the events
+ *   maxevents - The size of the 'evs' array
+ *   timeout   - The timeout in milliseconds, -1 waits forever
+ *   sigmask   - The signal mask to install while waiting, or NULL
+ *
+ * Returned Value:
+ *   The number of events stored in 'evs', zero on timeout.  On error, -1 is
+ *   returned, and errno is set appropriately.
+ *
  ****************************************************************************/
 
 int epoll_pwait(int epfd, FAR struct epoll_event *evs,
                 int maxevents, int timeout, FAR const sigset_t *sigmask)
 {
   FAR struct epoll_head *eph;
-  struct timespec expire;
-  struct timespec curr;
-  struct timespec diff;
-  int counter;
-  int rc;
-  int i;
+  sigset_t oldmask;
+  clock_t deadline = 0;
+  clock_t now;
+  int waitret;
+  int ret;
+  int rc = 0;
 
   eph = epoll_head_from_fd(epfd);
   if (eph == NULL)
@@ -395,61 +777,98 @@ int epoll_pwait(int epfd, FAR struct epoll_event *evs,
       return -1;
     }
 
-  if (timeout >= 0)
+  if (evs == NULL || maxevents <= 0)
     {
-      expire.tv_sec  = timeout / 1000;
-      expire.tv_nsec = timeout % 1000 * 1000;
-
-      clock_systime_timespec(&curr);
-      clock_timespec_add(&curr, &expire, &expire);
+      set_errno(EINVAL);
+      return -1;
     }
 
-again:
-  if (timeout < 0)
+  if (timeout > 0)
     {
-      rc = ppoll(eph->poll, eph->occupied + 1, NULL, sigmask);
+      /* Round timeout up to next full tick as poll() does */
+
+      deadline = clock_systime_ticks() +
+                 ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+                 MSEC_PER_TICK;
     }
-  else
-    {
-      clock_systime_timespec(&curr);
-      clock_timespec_subtract(&expire, &curr, &diff);
 
-      rc = ppoll(eph->poll, eph->occupied + 1, &diff, sigmask);
+  if (sigmask != NULL)
+    {
+      nxsig_procmask(SIG_SETMASK, sigmask, &oldmask);
     }
 
-  if (rc <= 0)
+  ret = nxmutex_lock(&eph->lock);
+  if (ret < 0)
     {
-      return rc;
+      goto errout;
     }
-  else if (eph->poll[0].revents != 0)
+
+  /* Poll the level-triggered descriptors reported last time */
+
+  epoll_rearm(eph);
+
+  for (; ; )
     {
-      if (--rc == 0)
+      rc = epoll_collect(eph, evs, maxevents);
+      if (rc > 0 || timeout == 0)
+        {
+          break;
+        }
+
+      nxmutex_unlock(&eph->lock);
+
+      if (timeout < 0)
+        {
+          waitret = nxsem_wait(&eph->waitsem);
+        }
+      else
+        {
+          now     = clock_systime_ticks();
+          waitret = (sclock_t)(deadline - now) > 0 ?
+                    nxsem_tickwait(&eph->waitsem, deadline - now) :
+                    -ETIMEDOUT;
+        }
+
+      if (waitret < 0 && waitret != -ETIMEDOUT)
+        {
+          ret = waitret;
+          goto errout;
+        }
+
+      ret = nxmutex_lock(&eph->lock);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      if (waitret == OK)
+        {
+          epoll_drain(eph);
+        }
+      else
         {
-          goto again;
+          /* Timed out:  Collect what is ready once more */
+
+          epoll_scan(eph);
+          timeout = 0;
         }
     }
 
-  if (rc > maxevents)
+  nxmutex_unlock(&eph->lock);
+
+errout:
+  if (sigmask != NULL)
     {
-      rc = maxevents;
+      nxsig_procmask(SIG_SETMASK, &oldmask, NULL);
     }
 
-  /* Iterate over non NULL event fds */
-
-  for (i = 0, counter = 1; i < rc && counter <= eph->occupied; counter++)
+  if (ret < 0)
     {
-      if (eph->poll[counter].revents != 0)
-        {
-          evs[i].data     = eph->data[counter];
-          evs[i++].events = eph->poll[counter].revents;
-          if (eph->poll[counter].events & EPOLLONESHOT)
-            {
-              eph->poll[counter].events = 0; /* Disable oneshot internally */
-            }
-        }
+      set_errno(-ret);
+      return -1;
     }
 
-  return i;
+  return rc;
 }
 
 /****************************************************************************
@@ -160,7 +160,7 @@ static void eventfd_pollnotify(FAR struct eventfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
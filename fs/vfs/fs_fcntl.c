@@ -221,6 +221,39 @@ static int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
         {
           ret = file_ioctl(filep, FIOC_FILEPATH, va_arg(ap, FAR char *));
         }
+        break;
+
+      case F_SETPIPE_SZ:
+        /* Set the buffer size of a pipe or FIFO to the third argument, arg,
+         * taken as type int.  The size set is returned.
+         */
+
+        {
+          int size = va_arg(ap, int);
+
+          ret = file_ioctl(filep, PIPEIOC_SETSIZE, (unsigned long)size);
+          if (ret >= 0)
+            {
+              ret = size;
+            }
+        }
+        break;
+
+      case F_GETPIPE_SZ:
+        /* Return the buffer size of a pipe or FIFO.  There is no third
+         * argument.
+         */
+
+        {
+          int size;
+
+          ret = file_ioctl(filep, PIPEIOC_GETSIZE, &size);
+          if (ret >= 0)
+            {
+              ret = size;
+            }
+        }
+        break;
 
       default:
         break;
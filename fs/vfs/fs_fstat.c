@@ -31,6 +31,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 #include <nuttx/mtd/mtd.h>
 #include "inode/inode.h"
 
@@ -162,6 +163,7 @@ static int proxy_fstat(FAR struct file *filep, FAR struct inode *inode,
 int file_fstat(FAR struct file *filep, FAR struct stat *buf)
 {
   FAR struct inode *inode;
+  uint32_t start;
   int ret;
 
   DEBUGASSERT(filep != NULL);
@@ -181,6 +183,8 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf)
    * are dealing with.
    */
 
+  start = fs_opstat_start();
+
 #ifndef CONFIG_DISABLE_MOUNTPOINT
   if (INODE_IS_MOUNTPT(inode))
     {
@@ -219,6 +223,7 @@ int file_fstat(FAR struct file *filep, FAR struct stat *buf)
         }
     }
 
+  fs_opstat_record(FS_OPSTAT_FSTAT, start, ret);
   return ret;
 }
 
@@ -32,6 +32,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 #include <nuttx/fs/ioctl.h>
 
 #include "inode/inode.h"
@@ -93,6 +94,7 @@ int file_fsync(FAR struct file *filep)
 int fsync(int fd)
 {
   FAR struct file *filep;
+  uint32_t start;
   int ret;
 
   /* fsync() is a cancellation point */
@@ -111,7 +113,9 @@ int fsync(int fd)
 
   /* Perform the fsync operation */
 
+  start = fs_opstat_start();
   ret = file_fsync(filep);
+  fs_opstat_record(FS_OPSTAT_FSYNC, start, ret);
   if (ret < 0)
     {
       goto errout;
@@ -30,6 +30,8 @@
 #include <errno.h>
 #include <assert.h>
 
+#include <nuttx/fs/opstat.h>
+
 #include "inode/inode.h"
 
 /****************************************************************************
@@ -123,6 +125,7 @@ off_t file_seek(FAR struct file *filep, off_t offset, int whence)
 off_t nx_seek(int fd, off_t offset, int whence)
 {
   FAR struct file *filep;
+  uint32_t start;
   off_t ret;
 
   /* Get the file structure corresponding to the file descriptor. */
@@ -137,7 +140,10 @@ off_t nx_seek(int fd, off_t offset, int whence)
 
   /* Then let file_seek do the real work */
 
-  return file_seek(filep, offset, whence);
+  start = fs_opstat_start();
+  ret = file_seek(filep, offset, whence);
+  fs_opstat_record(FS_OPSTAT_SEEK, start, ret);
+  return ret;
 }
 
 /****************************************************************************
@@ -31,6 +31,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -60,9 +61,11 @@ int mkdir(const char *pathname, mode_t mode)
 {
   struct inode_search_s desc;
   FAR struct inode *inode;
+  uint32_t start;
   int errcode;
   int ret;
 
+  start = fs_opstat_start();
   mode &= ~getumask();
 
   /* Find the inode that includes this path */
@@ -165,6 +168,7 @@ int mkdir(const char *pathname, mode_t mode)
   /* Directory successfully created */
 
   RELEASE_SEARCH(&desc);
+  fs_opstat_record(FS_OPSTAT_MKDIR, start, OK);
   return OK;
 
 errout_with_inode:
@@ -172,6 +176,7 @@ errout_with_inode:
 
 errout_with_search:
   RELEASE_SEARCH(&desc);
+  fs_opstat_record(FS_OPSTAT_MKDIR, start, -errcode);
   set_errno(errcode);
   return ERROR;
 }
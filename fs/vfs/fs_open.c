@@ -35,6 +35,7 @@
 
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 #include "driver/driver.h"
@@ -227,12 +228,15 @@ errout_with_search:
 static int nx_vopen(FAR const char *path, int oflags, va_list ap)
 {
   struct file filep;
+  uint32_t start;
   int ret;
   int fd;
 
   /* Let file_vopen() do all of the work */
 
+  start = fs_opstat_start();
   ret = file_vopen(&filep, path, oflags, getumask(), ap);
+  fs_opstat_record(FS_OPSTAT_OPEN, start, ret);
   if (ret < 0)
     {
       return ret;
@@ -321,12 +325,15 @@ int inode_checkflags(FAR struct inode *inode, int oflags)
 
 int file_open(FAR struct file *filep, FAR const char *path, int oflags, ...)
 {
+  uint32_t start;
   va_list ap;
   int ret;
 
+  start = fs_opstat_start();
   va_start(ap, oflags);
   ret = file_vopen(filep, path, oflags, 0, ap);
   va_end(ap);
+  fs_opstat_record(FS_OPSTAT_OPEN, start, ret);
 
   return ret;
 }
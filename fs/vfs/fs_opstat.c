@@ -0,0 +1,123 @@
+/****************************************************************************
+ * fs/vfs/fs_opstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/fs/opstat.h>
+
+#ifdef CONFIG_FS_OPSTATS
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct fs_opstat_s g_fs_opstat[FS_OPSTAT_NOPS];
+
+static FAR const char * const g_fs_opstat_names[FS_OPSTAT_NOPS] =
+{
+  "open", "close", "read", "write", "seek", "fsync",
+  "stat", "fstat", "readdir", "mkdir", "unlink", "rename"
+};
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fs_opstat_record
+ ****************************************************************************/
+
+void fs_opstat_record(int op, uint32_t start, ssize_t ret)
+{
+  FAR struct fs_opstat_s *stat;
+  uint32_t elapsed;
+  irqstate_t flags;
+
+  DEBUGASSERT(op >= 0 && op < FS_OPSTAT_NOPS);
+
+  elapsed = up_perf_gettime() - start;
+  stat    = &g_fs_opstat[op];
+
+  flags = enter_critical_section();
+
+  stat->count++;
+  stat->time += elapsed;
+  if (elapsed > stat->maxtime)
+    {
+      stat->maxtime = elapsed;
+    }
+
+  if (ret < 0)
+    {
+      stat->errors++;
+    }
+  else if (op == FS_OPSTAT_READ || op == FS_OPSTAT_WRITE)
+    {
+      stat->bytes += ret;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: fs_opstat_get
+ ****************************************************************************/
+
+void fs_opstat_get(FAR struct fs_opstat_s *stats)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memcpy(stats, g_fs_opstat, sizeof(g_fs_opstat));
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: fs_opstat_reset
+ ****************************************************************************/
+
+void fs_opstat_reset(void)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_fs_opstat, 0, sizeof(g_fs_opstat));
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: fs_opstat_name
+ ****************************************************************************/
+
+FAR const char *fs_opstat_name(int op)
+{
+  DEBUGASSERT(op >= 0 && op < FS_OPSTAT_NOPS);
+  return g_fs_opstat_names[op];
+}
+
+#endif /* CONFIG_FS_OPSTATS */
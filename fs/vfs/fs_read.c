@@ -25,13 +25,16 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <sched.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/cancelpt.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -64,10 +67,12 @@
 ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
 {
   FAR struct inode *inode;
+  uint32_t start;
   int ret = -EBADF;
 
   DEBUGASSERT(filep);
   inode = filep->f_inode;
+  start = fs_opstat_start();
 
   /* Was this file opened for read access? */
 
@@ -94,6 +99,11 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
                                      (size_t)nbytes);
     }
 
+  /* Directories are read by readdir() */
+
+  fs_opstat_record((filep->f_oflags & O_DIRECTORY) != 0 ?
+                   FS_OPSTAT_READDIR : FS_OPSTAT_READ, start, ret);
+
   /* Return the number of bytes read (or possibly an error code) */
 
   return ret;
@@ -177,3 +187,158 @@ ssize_t read(int fd, FAR void *buf, size_t nbytes)
   leave_cancellation_point();
   return ret;
 }
+
+/****************************************************************************
+ * Name: file_readv
+ *
+ * Description:
+ *   file_readv() is an internal OS interface.  It is functionally similar
+ *   to the standard readv() interface except:
+ *
+ *    - It does not modify the errno variable,
+ *    - It is not a cancellation point,
+ *    - It accepts a file structure instance instead of file descriptor.
+ *
+ *   The driver's readv method is used if it provides one.  Otherwise the
+ *   buffers are filled one after the other with file_read() until a read
+ *   returns less than requested.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read on success, 0 on if an end-of-file condition,
+ *   or a negated errno value on any failure.  If an error occurs after
+ *   some data was read, the number of bytes read is returned.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep,
+                   FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct inode *inode;
+  ssize_t ntotal = 0;
+  ssize_t nread;
+  int i;
+
+  DEBUGASSERT(filep);
+  inode = filep->f_inode;
+
+  if (iovcnt < 0 || iovcnt > IOV_MAX || (iov == NULL && iovcnt > 0))
+    {
+      return -EINVAL;
+    }
+
+  if ((filep->f_oflags & O_RDOK) == 0)
+    {
+      return -EACCES;
+    }
+
+  /* Mountpoints share only the first methods with drivers */
+
+  if (inode != NULL && !INODE_IS_MOUNTPT(inode) && inode->u.i_ops &&
+      inode->u.i_ops->readv)
+    {
+      return inode->u.i_ops->readv(filep, iov, iovcnt);
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      /* Ignore zero-length reads */
+
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nread = file_read(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nread < 0)
+        {
+          return ntotal > 0 ? ntotal : nread;
+        }
+
+      ntotal += nread;
+
+      /* Stop on an end-of-file condition or a short read */
+
+      if ((size_t)nread < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+
+/****************************************************************************
+ * Name: nx_readv
+ *
+ * Description:
+ *   nx_readv() is an internal OS interface.  It is functionally similar to
+ *   the standard readv() interface except:
+ *
+ *    - It does not modify the errno variable, and
+ *    - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - File descriptor to read from
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read on success, 0 on if an end-of-file condition,
+ *   or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_readv(filep, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: readv
+ *
+ * Description:
+ *   The standard, POSIX readv interface.  See include/sys/uio.h.
+ *
+ * Input Parameters:
+ *   fd     - File descriptor to read from
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read on success, 0 on if an end-of-file condition,
+ *   or -1 on failure with errno set appropriately.
+ *
+ ****************************************************************************/
+
+ssize_t readv(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* readv() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nx_readv(fd, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
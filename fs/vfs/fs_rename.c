@@ -33,6 +33,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -461,8 +462,11 @@ int rename(FAR const char *oldpath, FAR const char *newpath)
 {
   struct inode_search_s olddesc;
   FAR struct inode *oldinode;
+  uint32_t start;
   int ret;
 
+  start = fs_opstat_start();
+
   /* Ignore paths that are interpreted as the root directory which has no
    * name and cannot be moved
    */
@@ -516,6 +520,7 @@ errout_with_oldsearch:
   RELEASE_SEARCH(&olddesc);
 
 errout:
+  fs_opstat_record(FS_OPSTAT_RENAME, start, ret);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -28,6 +28,7 @@
 #include <sys/time.h>
 
 #include <string.h>
+#include <strings.h>
 #include <poll.h>
 #include <errno.h>
 #include <assert.h>
@@ -39,6 +40,49 @@
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_SELECT_NSTACKFDS
+#  define CONFIG_FS_SELECT_NSTACKFDS 8
+#endif
+
+/* The number of 32-bit words of the sets that cover 'nfds' descriptors */
+
+#define SELECT_NWORDS(nfds) (((nfds) + 31) >> 5)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: select_word
+ *
+ * Description:
+ *   Return the word 'ndx' of the set 'set' (NULL: the empty set), limited
+ *   to the descriptors below 'nfds'.
+ *
+ ****************************************************************************/
+
+static inline uint32_t select_word(FAR fd_set *set, int ndx, int nfds)
+{
+  uint32_t word;
+
+  if (set == NULL)
+    {
+      return 0;
+    }
+
+  word = set->arr[ndx];
+  if (((ndx + 1) << 5) > nfds)
+    {
+      word &= (UINT32_C(1) << _FD_BIT(nfds)) - 1;
+    }
+
+  return word;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -55,9 +99,10 @@
  *
  *   NOTE: poll() is the fundamental API for performing such monitoring
  *   operation under NuttX.  select() is provided for compatibility and
- *   is simply a layer of added logic on top of poll().  As such, select()
- *   is more wasteful of resources and poll() is the recommended API to be
- *   used.
+ *   is simply a layer of added logic on top of poll().  The descriptor
+ *   sets are scanned a word at a time and small pollfd lists are kept on
+ *   the stack (see CONFIG_FS_SELECT_NSTACKFDS) so that no heap allocation
+ *   is needed in the common case.
  *
  * Input Parameters:
  *   nfds - the maximum fd number (+1) of any descriptor in any of the
@@ -78,9 +123,12 @@
 int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
            FAR fd_set *exceptfds, FAR struct timeval *timeout)
 {
-  struct pollfd *pollset = NULL;
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  struct pollfd pollstack[CONFIG_FS_SELECT_NSTACKFDS];
+#endif
+  FAR struct pollfd *pollset = NULL;
   int errcode = OK;
-  int fd;
+  int nwords;
   int npfds;
   int msec;
   int ndx;
@@ -90,36 +138,37 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
 
   enter_cancellation_point();
 
-  if (nfds < 0)
+  if (nfds < 0 || nfds > FD_SETSIZE)
     {
       errcode = EINVAL;
       goto errout;
     }
 
-  /* How many pollfd structures do we need to allocate? */
-
-  /* Initialize the descriptor list for poll() */
+  /* How many pollfd structures do we need?  Count a word of the three
+   * sets at a time.
+   */
 
-  for (fd = 0, npfds = 0; fd < nfds; fd++)
+  nwords = SELECT_NWORDS(nfds);
+  for (ndx = 0, npfds = 0; ndx < nwords; ndx++)
     {
-      /* Check if any monitor operation is requested on this fd */
-
-      if ((readfds   && FD_ISSET(fd, readfds))  ||
-          (writefds  && FD_ISSET(fd, writefds)) ||
-          (exceptfds && FD_ISSET(fd, exceptfds)))
-        {
-          /* Yes.. increment the count of pollfds structures needed */
-
-          npfds++;
-        }
+      npfds += popcount(select_word(readfds, ndx, nfds) |
+                        select_word(writefds, ndx, nfds) |
+                        select_word(exceptfds, ndx, nfds));
     }
 
-  /* Allocate the descriptor list for poll() */
+  /* Use the stack for small descriptor lists */
 
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  if (npfds <= CONFIG_FS_SELECT_NSTACKFDS)
+    {
+      pollset = pollstack;
+    }
+  else
+#endif
   if (npfds > 0)
     {
       pollset = (FAR struct pollfd *)
-        kmm_zalloc(npfds * sizeof(struct pollfd));
+        kmm_malloc(npfds * sizeof(struct pollfd));
 
       if (pollset == NULL)
         {
@@ -128,52 +177,39 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
         }
     }
 
-  /* Initialize the descriptor list for poll() */
+  /* Initialize the descriptor list for poll(), skipping the empty words */
 
-  for (fd = 0, ndx = 0; fd < nfds; fd++)
+  for (ndx = 0, npfds = 0; ndx < nwords; ndx++)
     {
-      int incr = 0;
-
-      /* The readfs set holds the set of FDs that the caller can be assured
-       * of reading from without blocking.  Note that POLLHUP is included as
-       * a read-able condition.  POLLHUP will be reported at the end-of-file
-       * or when a connection is lost.  In either case, the read() can then
-       * be performed without blocking.
-       */
-
-      if (readfds && FD_ISSET(fd, readfds))
-        {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLIN;
-          incr                 = 1;
-        }
-
-      /* The writefds set holds the set of FDs that the caller can be assured
-       * of writing to without blocking.
-       */
+      uint32_t rd = select_word(readfds, ndx, nfds);
+      uint32_t wr = select_word(writefds, ndx, nfds);
+      uint32_t ex = select_word(exceptfds, ndx, nfds);
+      uint32_t all = rd | wr | ex;
 
-      if (writefds && FD_ISSET(fd, writefds))
+      while (all != 0)
         {
-          pollset[ndx].fd      = fd;
-          pollset[ndx].events |= POLLOUT;
-          incr                 = 1;
-        }
+          int bit = ffs((int)all) - 1;
+          uint32_t mask = UINT32_C(1) << bit;
+
+          /* The readfs set holds the set of FDs that the caller can be
+           * assured of reading from without blocking.  The writefds set
+           * holds the set of FDs that the caller can be assured of writing
+           * to without blocking.  The exceptfds set holds the set of FDs
+           * that are watched for exceptions.  POLLERR is always reported;
+           * POLLPRI remembers the membership for the conversion back.
+           */
 
-      /* The exceptfds set holds the set of FDs that are watched for
-       * exceptions
-       */
+          pollset[npfds].fd      = (ndx << 5) + bit;
+          pollset[npfds].events  = ((rd & mask) ? POLLIN : 0) |
+                                   ((wr & mask) ? POLLOUT : 0) |
+                                   ((ex & mask) ? POLLPRI : 0);
+          pollset[npfds].revents = 0;
+          npfds++;
 
-      if (exceptfds && FD_ISSET(fd, exceptfds))
-        {
-          pollset[ndx].fd      = fd;
-          incr                  = 1;
+          all &= ~mask;
         }
-
-      ndx += incr;
     }
 
-  DEBUGASSERT(ndx == npfds);
-
   /* Convert the timeout to milliseconds */
 
   if (timeout)
@@ -216,53 +252,56 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
       memset(exceptfds, 0, sizeof(fd_set));
     }
 
-  /* Convert the poll descriptor list back into selects 3 bitsets */
+  /* Convert the poll descriptor list back into selects 3 bitsets.  Only
+   * the sets that a descriptor was requested in are reported.
+   */
 
   if (ret > 0)
     {
       ret = 0;
       for (ndx = 0; ndx < npfds; ndx++)
         {
+          FAR struct pollfd *pfd = &pollset[ndx];
+
           /* Check for read conditions.  Note that POLLHUP is included as a
            * read condition.  POLLHUP will be reported when no more data will
            * be available (such as when a connection is lost).  In either
            * case, the read() can then be performed without blocking.
            */
 
-          if (readfds)
+          if ((pfd->events & POLLIN) != 0 &&
+              (pfd->revents & (POLLIN | POLLHUP)) != 0)
             {
-              if (pollset[ndx].revents & (POLLIN | POLLHUP))
-                {
-                  FD_SET(pollset[ndx].fd, readfds);
-                  ret++;
-                }
+              FD_SET(pfd->fd, readfds);
+              ret++;
             }
 
           /* Check for write conditions */
 
-          if (writefds)
+          if ((pfd->events & POLLOUT) != 0 &&
+              (pfd->revents & (POLLOUT | POLLHUP)) != 0)
             {
-              if (pollset[ndx].revents & (POLLOUT | POLLHUP))
-                {
-                  FD_SET(pollset[ndx].fd, writefds);
-                  ret++;
-                }
+              FD_SET(pfd->fd, writefds);
+              ret++;
             }
 
           /* Check for exceptions */
 
-          if (exceptfds)
+          if ((pfd->events & POLLPRI) != 0 &&
+              (pfd->revents & (POLLERR | POLLPRI)) != 0)
             {
-              if (pollset[ndx].revents & POLLERR)
-                {
-                  FD_SET(pollset[ndx].fd, exceptfds);
-                  ret++;
-                }
+              FD_SET(pfd->fd, exceptfds);
+              ret++;
             }
         }
     }
 
-  kmm_free(pollset);
+#if CONFIG_FS_SELECT_NSTACKFDS > 0
+  if (pollset != pollstack)
+#endif
+    {
+      kmm_free(pollset);
+    }
 
   /* Did poll() fail above? */
 
@@ -25,16 +25,108 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <errno.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: copyfile_direct
+ *
+ * Description:
+ *   Transfer up to 'count' bytes from the current position of 'infile' to
+ *   'outfile' without an intermediate buffer.  This is only possible if
+ *   the content of the input file can be addressed directly in memory
+ *   (FIOC_MMAP, e.g. ROMFS on XIP media or TMPFS).
+ *
+ * Returned Value:
+ *   The number of bytes transferred or a negated errno value.  -ENOTTY
+ *   means that the input file cannot be accessed directly.
+ *
+ ****************************************************************************/
+
+static ssize_t copyfile_direct(FAR struct file *outfile,
+                               FAR struct file *infile, size_t count)
+{
+  FAR const uint8_t *addr;
+  struct stat buf;
+  ssize_t nbyteswritten;
+  size_t ntransferred;
+  off_t pos;
+  int ret;
+
+  ret = file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&addr));
+  if (ret < 0)
+    {
+      return -ENOTTY;
+    }
+
+  ret = file_fstat(infile, &buf);
+  if (ret < 0)
+    {
+      return -ENOTTY;
+    }
+
+  pos = file_seek(infile, 0, SEEK_CUR);
+  if (pos < 0)
+    {
+      return pos;
+    }
+
+  if (pos >= buf.st_size)
+    {
+      return 0;
+    }
+
+  if (count > buf.st_size - pos)
+    {
+      count = buf.st_size - pos;
+    }
+
+  for (ntransferred = 0; ntransferred < count; )
+    {
+      nbyteswritten = file_write(outfile, addr + pos + ntransferred,
+                                 count - ntransferred);
+      if (nbyteswritten < 0)
+        {
+          /* EINTR is not an error (but will still stop the copy) if some
+           * data has been transferred.
+           */
+
+          if (nbyteswritten != -EINTR || ntransferred == 0)
+            {
+              return nbyteswritten;
+            }
+
+          break;
+        }
+
+      ntransferred += nbyteswritten;
+    }
+
+  /* Advance the file position past the data transferred */
+
+  pos = file_seek(infile, pos + ntransferred, SEEK_SET);
+  if (pos < 0)
+    {
+      return pos;
+    }
+
+  return ntransferred;
+}
+
+/****************************************************************************
+ * Name: copyfile
+ ****************************************************************************/
+
 static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
                         off_t *offset, size_t count)
 {
@@ -69,6 +161,15 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
         }
     }
 
+  /* Transfer directly from the input file if it is in memory */
+
+  nbyteswritten = copyfile_direct(outfile, infile, count);
+  if (nbyteswritten != -ENOTTY)
+    {
+      ntransferred = nbyteswritten;
+      goto out;
+    }
+
   /* Allocate an I/O buffer */
 
   iobuffer = kmm_malloc(CONFIG_SENDFILE_BUFSIZE);
@@ -196,6 +297,8 @@ static ssize_t copyfile(FAR struct file *outfile, FAR struct file *infile,
 
   kmm_free(iobuffer);
 
+out:
+
   /* Return the current file position */
 
   if (offset)
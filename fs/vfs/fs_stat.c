@@ -34,6 +34,7 @@
 #include "inode/inode.h"
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/opstat.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -162,6 +163,9 @@ errout_with_search:
 
 int nx_stat(FAR const char *path, FAR struct stat *buf, int resolve)
 {
+  uint32_t start;
+  int ret;
+
   /* Sanity checks */
 
   if (path == NULL  || buf == NULL)
@@ -178,7 +182,10 @@ int nx_stat(FAR const char *path, FAR struct stat *buf, int resolve)
    * recursive if soft link support is enabled.
    */
 
-  return stat_recursive(path, buf, resolve);
+  start = fs_opstat_start();
+  ret = stat_recursive(path, buf, resolve);
+  fs_opstat_record(FS_OPSTAT_STAT, start, ret);
+  return ret;
 }
 
 /****************************************************************************
@@ -190,7 +190,7 @@ static void timerfd_pollnotify(FAR struct timerfd_priv_s *dev,
 
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
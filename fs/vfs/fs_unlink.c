@@ -30,6 +30,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -59,8 +60,11 @@ int nx_unlink(FAR const char *pathname)
 {
   struct inode_search_s desc;
   FAR struct inode *inode;
+  uint32_t start;
   int ret;
 
+  start = fs_opstat_start();
+
   /* Get an inode for this file (without deference the final node in the path
    * which may be a symbolic link)
    */
@@ -189,6 +193,7 @@ int nx_unlink(FAR const char *pathname)
 
   inode_release(inode);
   RELEASE_SEARCH(&desc);
+  fs_opstat_record(FS_OPSTAT_UNLINK, start, OK);
   return OK;
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) || !defined(CONFIG_DISABLE_PSEUDOFS_OPERATIONS)
@@ -198,6 +203,7 @@ errout_with_inode:
 
 errout_with_search:
   RELEASE_SEARCH(&desc);
+  fs_opstat_record(FS_OPSTAT_UNLINK, start, ret);
   return ret;
 }
 
@@ -25,13 +25,16 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <sched.h>
 #include <errno.h>
 #include <assert.h>
 
 #include <nuttx/cancelpt.h>
+#include <nuttx/fs/opstat.h>
 
 #include "inode/inode.h"
 
@@ -68,6 +71,8 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
                    size_t nbytes)
 {
   FAR struct inode *inode;
+  uint32_t start;
+  ssize_t ret;
 
   /* Was this file opened for write access? */
 
@@ -86,7 +91,10 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
 
   /* Yes, then let the driver perform the write */
 
-  return inode->u.i_ops->write(filep, buf, nbytes);
+  start = fs_opstat_start();
+  ret = inode->u.i_ops->write(filep, buf, nbytes);
+  fs_opstat_record(FS_OPSTAT_WRITE, start, ret);
+  return ret;
 }
 
 /****************************************************************************
@@ -209,3 +217,150 @@ ssize_t write(int fd, FAR const void *buf, size_t nbytes)
   leave_cancellation_point();
   return ret;
 }
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Equivalent to the standard writev() function except that is accepts a
+ *   struct file instance instead of a file descriptor, does not modify the
+ *   errno variable and is not a cancellation point.
+ *
+ *   The driver's writev method is used if it provides one.  Otherwise the
+ *   buffers are written one after the other with file_write() until a
+ *   write transfers less than requested.
+ *
+ * Input Parameters:
+ *   filep  - Instance of struct file to use with the write
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned.  On any failure,
+ *  a negated errno value is returned.  If an error occurs after some data
+ *  was written, the number of bytes written is returned.
+ *
+ ****************************************************************************/
+
+ssize_t file_writev(FAR struct file *filep,
+                    FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct inode *inode;
+  ssize_t ntotal = 0;
+  ssize_t nwritten;
+  int i;
+
+  if (iovcnt < 0 || iovcnt > IOV_MAX || (iov == NULL && iovcnt > 0))
+    {
+      return -EINVAL;
+    }
+
+  if ((filep->f_oflags & O_WROK) == 0)
+    {
+      return -EACCES;
+    }
+
+  /* Mountpoints share only the first methods with drivers */
+
+  inode = filep->f_inode;
+  if (inode != NULL && !INODE_IS_MOUNTPT(inode) && inode->u.i_ops &&
+      inode->u.i_ops->writev)
+    {
+      return inode->u.i_ops->writev(filep, iov, iovcnt);
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      /* Ignore zero-length writes */
+
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = file_write(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nwritten < 0)
+        {
+          return ntotal > 0 ? ntotal : nwritten;
+        }
+
+      ntotal += nwritten;
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal;
+}
+
+/****************************************************************************
+ * Name: nx_writev
+ *
+ * Description:
+ *  nx_writev() is an internal OS function.  It is functionally equivalent
+ *  to writev() except that:
+ *
+ *  - It does not modify the errno variable, and
+ *  - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - file descriptor to write to
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned.  On any failure,
+ *  a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret >= 0)
+    {
+      ret = file_writev(filep, iov, iovcnt);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *  The standard, POSIX writev interface.  See include/sys/uio.h.
+ *
+ * Input Parameters:
+ *   fd     - file descriptor to write to
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *  On success, the number of bytes written are returned.  On error, -1 is
+ *  returned, and errno is set appropriately (see write()).
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nx_writev(fd, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -64,6 +64,19 @@
 #define NXBE_STATE_CLRMODAL(nxbe) \
   do { (nxbe)->flags &= ~NXBE_STATE_MODAL; } while (0)
 
+/* Discard the cached visible regions of all of the windows.  This must be
+ * done whenever a window is added to or removed from the hierarchy, and
+ * whenever one changes its position, size or place in the hierarchy,
+ * before anything is redrawn.  Zero is never a valid generation.
+ */
+
+#ifdef CONFIG_NX_CLIPCACHE
+#  define NXBE_CLIPINVALIDATE(nxbe) \
+  do { if (++(nxbe)->clipgen == 0) (nxbe)->clipgen = 1; } while (0)
+#else
+#  define NXBE_CLIPINVALIDATE(nxbe)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -175,6 +188,13 @@ struct nxbe_plane_s
 
   NX_DRIVERTYPE *driver;
   NX_PLANEINFOTYPE pinfo;
+
+#ifdef CONFIG_NX_UPDATE_BATCH
+  /* The regions updated since the last nxbe_notify_flush() */
+
+  uint8_t ndamage;
+  struct nxgl_rect_s damage[CONFIG_NX_UPDATE_NRECTS];
+#endif
 };
 
 /* Clipping *****************************************************************/
@@ -226,6 +246,10 @@ struct nxbe_state_s
 {
   uint8_t flags;                     /* NXBE_STATE_* flags */
 
+#ifdef CONFIG_NX_CLIPCACHE
+  uint32_t clipgen;                  /* See NXBE_CLIPINVALIDATE() */
+#endif
+
 #if defined(CONFIG_NX_SWCURSOR) || defined(CONFIG_NX_HWCURSOR)
   /* Cursor support */
 
@@ -305,13 +329,30 @@ int nxbe_colormap(FAR NX_DRIVERTYPE *dev);
  *   interface.  This is the function that will handle the notification.  It
  *   receives the rectangular region that was updated on the provided plane.
  *
+ *   If CONFIG_NX_UPDATE_BATCH=y, the region is only accumulated and the
+ *   notification is deferred to nxbe_notify_flush().
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_NX_UPDATE
-void nxbe_notify_rectangle(FAR NX_DRIVERTYPE *dev,
+void nxbe_notify_rectangle(FAR struct nxbe_plane_s *plane,
                            FAR const struct nxgl_rect_s *rect);
 #endif
 
+/****************************************************************************
+ * Name: nxbe_notify_flush
+ *
+ * Description:
+ *   Notify the external logic of the regions accumulated by
+ *   nxbe_notify_rectangle() in all of the color planes, one call for each
+ *   merged region.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_BATCH
+void nxbe_notify_flush(FAR struct nxbe_state_s *be);
+#endif
+
 /****************************************************************************
  * Name: nx_configure
  *
@@ -806,6 +847,44 @@ void nxbe_clipper(FAR struct nxbe_window_s *wnd,
                   FAR struct nxbe_clipops_s *cops,
                   FAR struct nxbe_plane_s *plane);
 
+/****************************************************************************
+ * Name: nxbe_clipvisible
+ *
+ * Description:
+ *   Call the visible callback for each part of a rectangle of the window
+ *   that is not obscured by the windows above it, in no particular order.
+ *   The obscured callback is not called.  If CONFIG_NX_CLIPCACHE=y, the
+ *   rectangle is clipped against the cached visible parts of the window;
+ *   otherwise this is the same as nxbe_clipper(wnd->above, ...).
+ *
+ * Input Parameters:
+ *   wnd   - The window to be clipped (not the window above it).
+ *   dest  - The region of concern, within the bounds of the window.
+ *   cops  - The callbacks to handle the visible parts.
+ *   plane - The raster operations to be used by the callback functions.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_clipvisible(FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *dest,
+                      FAR struct nxbe_clipops_s *cops,
+                      FAR struct nxbe_plane_s *plane);
+
+/****************************************************************************
+ * Name: nxbe_clipfree
+ *
+ * Description:
+ *   Free the cached visible parts of a window that is being closed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_CLIPCACHE
+void nxbe_clipfree(FAR struct nxbe_window_s *wnd);
+#endif
+
 /****************************************************************************
  * Name: nxbe_clipnull
  *
@@ -51,8 +51,8 @@ struct nx_bitmap_s
  * Name: bitmap_clipcopy
  *
  * Description:
- *  Called from nxbe_clipper() to performed the fill operation on visible
- *  portions of the rectangle.
+ *  Called from nxbe_clipvisible() to performed the fill operation on
+ *  visible portions of the rectangle.
  *
  ****************************************************************************/
 
@@ -70,7 +70,7 @@ static void bitmap_clipcopy(FAR struct nxbe_clipops_s *cops,
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
 
-  nxbe_notify_rectangle(plane->driver, rect);
+  nxbe_notify_rectangle(plane, rect);
 #endif
 }
 
@@ -266,8 +266,7 @@ void nxbe_bitmap_dev(FAR struct nxbe_window_s *wnd,
       info.origin.y      = offset.y;
       info.stride        = stride;
 
-      nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipvisible(wnd, &remaining, &info.cops, &wnd->be->plane[i]);
     }
 }
 
@@ -39,6 +39,7 @@
  ****************************************************************************/
 
 #define NX_INITIAL_STACKSIZE (32)
+#define NX_INITIAL_CLIPSIZE  (4)
 
 /****************************************************************************
  * Private Types
@@ -63,6 +64,19 @@ struct nxbe_clipstack_s
   struct nxbe_cliprect_s   *stack; /* The stack of deferred rectangles */
 };
 
+/* This structure is the container used to collect the visible parts of a
+ * window into its cache.
+ */
+
+#ifdef CONFIG_NX_CLIPCACHE
+struct nxbe_clipcache_s
+{
+  struct nxbe_clipops_s     cops;
+  FAR struct nxbe_window_s *wnd;
+  bool                      error; /* Failed to grow the cache */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -135,6 +149,45 @@ static inline bool nxbe_poprectangle(struct nxbe_clipstack_s *stack,
   return false;
 }
 
+/****************************************************************************
+ * Name: nxbe_clipcache
+ *
+ * Description:
+ *  Called from nxbe_clipper() to add a visible part of the window to its
+ *  cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_CLIPCACHE
+static void nxbe_clipcache(FAR struct nxbe_clipops_s *cops,
+                           FAR struct nxbe_plane_s *plane,
+                           FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxbe_clipcache_s *info = (FAR struct nxbe_clipcache_s *)cops;
+  FAR struct nxbe_window_s *wnd = info->wnd;
+
+  if (wnd->nclip >= wnd->mxclip)
+    {
+      int mxclip = wnd->mxclip ? 2 * wnd->mxclip : NX_INITIAL_CLIPSIZE;
+      FAR struct nxgl_rect_s *newclip;
+
+      newclip = kmm_realloc(wnd->clip, sizeof(struct nxgl_rect_s) * mxclip);
+      if (!newclip)
+        {
+          gerr("ERROR: Failed to reallocate the clip cache\n");
+          info->error = true;
+          return;
+        }
+
+      wnd->clip   = newclip;
+      wnd->mxclip = mxclip;
+    }
+
+  nxgl_rectcopy(&wnd->clip[wnd->nclip], rect);
+  wnd->nclip++;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -262,3 +315,93 @@ void nxbe_clipnull(FAR struct nxbe_clipops_s *cops,
                    FAR const struct nxgl_rect_s *rect)
 {
 }
+
+/****************************************************************************
+ * Name: nxbe_clipvisible
+ *
+ * Description:
+ *   Call the visible callback for each part of a rectangle of the window
+ *   that is not obscured by the windows above it.
+ *
+ * Input Parameters:
+ *   wnd   - The window to be clipped (not the window above it).
+ *   dest  - The region of concern, within the bounds of the window.
+ *   cops  - The callbacks to handle the visible parts.
+ *   plane - The raster operations to be used by the callback functions.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_clipvisible(FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *dest,
+                      FAR struct nxbe_clipops_s *cops,
+                      FAR struct nxbe_plane_s *plane)
+{
+#ifdef CONFIG_NX_CLIPCACHE
+  FAR struct nxbe_state_s *be = wnd->be;
+  struct nxgl_rect_s rect;
+  int i;
+
+  /* Collect the visible parts of the whole window again if anything
+   * changed in the hierarchy since the last time.
+   */
+
+  if (wnd->clipgen != be->clipgen)
+    {
+      struct nxbe_clipcache_s info;
+
+      info.cops.visible  = nxbe_clipcache;
+      info.cops.obscured = nxbe_clipnull;
+      info.wnd           = wnd;
+      info.error         = false;
+
+      wnd->nclip = 0;
+      nxgl_rectintersect(&rect, &wnd->bounds, &be->bkgd.bounds);
+      nxbe_clipper(wnd->above, &rect, NX_CLIPORDER_DEFAULT,
+                   &info.cops, plane);
+
+      wnd->clipgen = info.error ? 0 : be->clipgen;
+    }
+
+  if (wnd->clipgen == be->clipgen)
+    {
+      for (i = 0; i < wnd->nclip; i++)
+        {
+          nxgl_rectintersect(&rect, dest, &wnd->clip[i]);
+          if (!nxgl_nullrect(&rect))
+            {
+              cops->visible(cops, plane, &rect);
+            }
+        }
+
+      return;
+    }
+
+  /* Out of memory, clip against the windows above this time */
+#endif
+
+  nxbe_clipper(wnd->above, dest, NX_CLIPORDER_DEFAULT, cops, plane);
+}
+
+/****************************************************************************
+ * Name: nxbe_clipfree
+ *
+ * Description:
+ *   Free the cached visible parts of a window that is being closed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_CLIPCACHE
+void nxbe_clipfree(FAR struct nxbe_window_s *wnd)
+{
+  if (wnd->clip != NULL)
+    {
+      kmm_free(wnd->clip);
+      wnd->clip   = NULL;
+      wnd->nclip  = 0;
+      wnd->mxclip = 0;
+    }
+}
+#endif
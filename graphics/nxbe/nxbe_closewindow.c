@@ -113,6 +113,10 @@ void nxbe_closewindow(FAR struct nxbe_window_s *wnd)
 
       wnd->below->above = wnd->above;
 
+      /* The visible parts of the windows change */
+
+      NXBE_CLIPINVALIDATE(be);
+
       /* Redraw the windows that were below us (and may now be exposed) */
 
       nxbe_redrawbelow(be, wnd->below, &wnd->bounds);
@@ -137,6 +141,12 @@ void nxbe_closewindow(FAR struct nxbe_window_s *wnd)
     }
 #endif
 
+#ifdef CONFIG_NX_CLIPCACHE
+  /* Free the cached visible parts of the window */
+
+  nxbe_clipfree(wnd);
+#endif
+
   /* Then discard the window structure.  Here we assume that the user-space
    * allocator was used.
    */
@@ -83,6 +83,10 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
 
   nxgl_colorcopy(be->bgcolor, g_bgcolor);
 
+  /* Start the generation of the cached visible parts of the windows */
+
+  NXBE_CLIPINVALIDATE(be);
+
   /* Check the number of color planes */
 
 #ifdef CONFIG_DEBUG_GRAPHICS
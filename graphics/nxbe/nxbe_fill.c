@@ -49,8 +49,8 @@ struct nxbe_fill_s
  * Name: nxbe_clipfill
  *
  * Description:
- *  Called from nxbe_clipper() to performed the fill operation on visible
- *  portions of the rectangle.
+ *  Called from nxbe_clipvisible() to performed the fill operation on
+ *  visible portions of the rectangle.
  *
  ****************************************************************************/
 
@@ -67,7 +67,7 @@ static void nxbe_clipfill(FAR struct nxbe_clipops_s *cops,
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
 
-  nxbe_notify_rectangle(plane->driver, rect);
+  nxbe_notify_rectangle(plane, rect);
 #endif
 }
 
@@ -109,8 +109,7 @@ static inline void nxbe_fill_dev(FAR struct nxbe_window_s *wnd,
       info.cops.obscured = nxbe_clipnull;
       info.color         = color[i];
 
-      nxbe_clipper(wnd->above, rect, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipvisible(wnd, rect, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Backup and redraw the cursor in the affected region.
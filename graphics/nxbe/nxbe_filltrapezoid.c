@@ -62,8 +62,8 @@ struct nxbe_filltrap_s
  * Name: nxbe_clipfilltrapezoid
  *
  * Description:
- *  Called from nxbe_clipper() to performed the fill operation on visible
- *  portions of the rectangle.
+ *  Called from nxbe_clipvisible() to performed the fill operation on
+ *  visible portions of the rectangle.
  *
  ****************************************************************************/
 
@@ -91,7 +91,7 @@ static void nxbe_clipfilltrapezoid(FAR struct nxbe_clipops_s *cops,
                      MIN(fillinfo->trap.bot.x2, rect->pt2.x));
   update.pt2.y = MIN(fillinfo->trap.bot.y, rect->pt2.y);
 
-  nxbe_notify_rectangle(plane->driver, &update);
+  nxbe_notify_rectangle(plane, &update);
 #endif
 }
 
@@ -140,8 +140,7 @@ nxbe_filltrapezoid_dev(FAR struct nxbe_window_s *wnd,
        */
 
       info.color = color[i];
-      nxbe_clipper(wnd->above, bounds, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipvisible(wnd, bounds, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Backup and redraw the cursor in the modified region.
@@ -91,6 +91,10 @@ void nxbe_lower(FAR struct nxbe_window_s *wnd)
   wnd->above     = be->bkgd.above;
   be->bkgd.above = wnd;
 
+  /* The visible parts of the windows change */
+
+  NXBE_CLIPINVALIDATE(be);
+
   /* Redraw the windows that were below us (but now are above) */
 
   nxbe_redrawbelow(be, below, &wnd->bounds);
@@ -24,10 +24,106 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 #include <nuttx/nx/nxglib.h>
 
 #include "nxbe.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_notify_area
+ *
+ * Description:
+ *   Return the number of pixels in a rectangle.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_BATCH
+static uint32_t nxbe_notify_area(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+
+/****************************************************************************
+ * Name: nxbe_notify_merge
+ *
+ * Description:
+ *   Add a region to the regions accumulated in the plane.  A region is
+ *   merged with an accumulated one when their bounding box is not larger
+ *   than the two of them:  This merges the regions that contain each other
+ *   and the adjacent strips, and never updates more pixels than the
+ *   separate updates would.  The bounding box is then merged again with the
+ *   others.  When there is no room for the region, it is merged with the
+ *   region that grows the least.
+ *
+ ****************************************************************************/
+
+static void nxbe_notify_merge(FAR struct nxbe_plane_s *plane,
+                              FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s merged;
+  struct nxgl_rect_s bounds;
+  uint32_t mingrowth;
+  uint32_t growth;
+  uint32_t area;
+  int best;
+  int i;
+
+  nxgl_rectcopy(&merged, rect);
+
+  for (; ; )
+    {
+      area = nxbe_notify_area(&merged);
+      best = -1;
+      mingrowth = UINT32_MAX;
+
+      for (i = 0; i < plane->ndamage; i++)
+        {
+          nxgl_rectunion(&bounds, &plane->damage[i], &merged);
+          growth = nxbe_notify_area(&bounds) -
+                   nxbe_notify_area(&plane->damage[i]);
+          if (growth <= area)
+            {
+              best = i;
+              break;
+            }
+
+          if (growth < mingrowth)
+            {
+              mingrowth = growth;
+              best      = i;
+            }
+        }
+
+      if (i >= plane->ndamage)
+        {
+          /* Nothing to merge with.  Add the region if there is room */
+
+          if (plane->ndamage < CONFIG_NX_UPDATE_NRECTS)
+            {
+              nxgl_rectcopy(&plane->damage[plane->ndamage], &merged);
+              plane->ndamage++;
+              return;
+            }
+        }
+
+      /* Remove the region merged with and try again with the bounding box,
+       * which may now cover, or touch, some other region.
+       */
+
+      nxgl_rectunion(&merged, &plane->damage[best], &merged);
+
+      plane->ndamage--;
+      nxgl_rectcopy(&plane->damage[best], &plane->damage[plane->ndamage]);
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,12 +150,49 @@
  ****************************************************************************/
 
 #ifdef CONFIG_NX_UPDATE
-void nxbe_notify_rectangle(FAR NX_DRIVERTYPE *dev,
+void nxbe_notify_rectangle(FAR struct nxbe_plane_s *plane,
                            FAR const struct nxgl_rect_s *rect)
 {
+#ifdef CONFIG_NX_UPDATE_BATCH
+  nxbe_notify_merge(plane, rect);
+#else
   struct fb_area_s area;
 
   nxgl_rect2area(&area, rect);
-  dev->updatearea(dev, &area);
+  plane->driver->updatearea(plane->driver, &area);
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: nxbe_notify_flush
+ *
+ * Description:
+ *   Notify the external logic of the regions accumulated by
+ *   nxbe_notify_rectangle() in all of the color planes, one call for each
+ *   merged region.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_BATCH
+void nxbe_notify_flush(FAR struct nxbe_state_s *be)
+{
+  FAR struct nxbe_plane_s *plane;
+  struct fb_area_s area;
+  int i;
+  int j;
+
+  for (i = 0; i < be->vinfo.nplanes; i++)
+    {
+      plane = &be->plane[i];
+
+      for (j = 0; j < plane->ndamage; j++)
+        {
+          nxgl_rect2area(&area, &plane->damage[j]);
+          plane->driver->updatearea(plane->driver, &area);
+        }
+
+      plane->ndamage = 0;
+    }
 }
 #endif
@@ -101,12 +101,10 @@ void nxbe_redraw(FAR struct nxbe_state_s *be,
 #if CONFIG_NX_NPLANES > 1
       for (i = 0; i < be->vinfo.nplanes; i++)
         {
-          nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
-                       &info.cops, &be->plane[i]);
+          nxbe_clipvisible(wnd, &remaining, &info.cops, &be->plane[i]);
         }
 #else
-      nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &be->plane[0]);
+      nxbe_clipvisible(wnd, &remaining, &info.cops, &be->plane[0]);
 #endif
     }
 }
@@ -49,8 +49,8 @@ struct nxbe_setpixel_s
  * Name: nxbe_clipfill
  *
  * Description:
- *  Called from nxbe_clipper() to performed the fill operation on visible
- *  portions of the rectangle.
+ *  Called from nxbe_clipvisible() to performed the fill operation on
+ *  visible portions of the rectangle.
  *
  ****************************************************************************/
 
@@ -67,7 +67,7 @@ static void nxbe_clipfill(FAR struct nxbe_clipops_s *cops,
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
 
-  nxbe_notify_rectangle(plane->driver, rect);
+  nxbe_notify_rectangle(plane, rect);
 #endif
 }
 
@@ -128,8 +128,7 @@ static void nxbe_setpixel_dev(FAR struct nxbe_window_s *wnd,
 
       /* Draw the point (if it is visible) */
 
-      nxbe_clipper(wnd->above, &rect, NX_CLIPORDER_DEFAULT,
-                   &info.cops, &wnd->be->plane[i]);
+      nxbe_clipvisible(wnd, &rect, &info.cops, &wnd->be->plane[i]);
 
 #ifdef CONFIG_NX_SWCURSOR
       /* Update cursor backup memory and redraw the cursor in the modified
@@ -64,6 +64,10 @@ void nxbe_setposition(FAR struct nxbe_window_s *wnd,
   nxgl_rectcopy(&before, &wnd->bounds);
   nxgl_rectoffset(&wnd->bounds, &rect, pos->x, pos->y);
 
+  /* The visible parts of the windows change */
+
+  NXBE_CLIPINVALIDATE(wnd->be);
+
   /* Get the union of the 'before' bounding box and the 'after' bounding
    * this union is the region of the display that must be updated.
    */
@@ -275,6 +275,10 @@ void nxbe_setsize(FAR struct nxbe_window_s *wnd,
 
   nxgl_rectintersect(&wnd->bounds, &wnd->bounds, &wnd->be->bkgd.bounds);
 
+  /* The visible parts of the windows change */
+
+  NXBE_CLIPINVALIDATE(wnd->be);
+
   /* Report the new size/position.  The application needs to know the new
    * size before getting redraw requests.
    */
@@ -57,6 +57,10 @@ void nxbe_show_window(FAR struct nxbe_window_s *wnd)
 
   NXBE_CLRHIDDEN(wnd);
 
+  /* The visible parts of the windows change */
+
+  NXBE_CLIPINVALIDATE(be);
+
   /* Restore the window to the top of the hierarchy.  Exception:  If the top
    * window is a modal window, then only raise it to second highest.
    */
@@ -146,6 +150,10 @@ void nxbe_hide_window(FAR struct nxbe_window_s *wnd)
 
   wnd->below->above = wnd->above;
 
+  /* The visible parts of the windows change */
+
+  NXBE_CLIPINVALIDATE(be);
+
   /* Redraw the windows that were below us (and may now be exposed) */
 
   nxbe_redrawbelow(be, wnd->below, &wnd->bounds);
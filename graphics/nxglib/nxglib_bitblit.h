@@ -27,7 +27,9 @@
 
 #include <nuttx/config.h>
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -105,52 +107,18 @@
 #  define NXGL_ALIGNUP(x)          (((x) + NXGL_PIXELMASK) & ~NXGL_PIXELMASK)
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr = (FAR uint8_t*)(dest); \
-     int        _nby = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+   memset((dest), (value), NXGL_SCALEX(width))
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     int        _nby  = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #elif NXGLIB_BITSPERPIXEL == 24
 
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr  = (FAR uint8_t*)(dest); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-         *_ptr++ = (value) >> 8; \
-         *_ptr++ = (value) >> 16; \
-       } \
-   }
+   nxgl_memset24((FAR uint8_t *)(dest), (value), (width))
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -169,28 +137,21 @@
    }
 
 #endif /* CONFIG_NX_ANTIALIASING */
-#else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
-
-#  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
-     nxgl_coord_t     _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+#else /* NXGLIB_BITSPERPIXEL == 8, 16 or 32 */
+
+#  if NXGLIB_BITSPERPIXEL == 8
+#    define NXGL_MEMSET(dest,value,width) \
+     memset((dest), (value), (width))
+#  elif NXGLIB_BITSPERPIXEL == 16
+#    define NXGL_MEMSET(dest,value,width) \
+     nxgl_memset16((FAR uint16_t *)(dest), (value), (width))
+#  else
+#    define NXGL_MEMSET(dest,value,width) \
+     nxgl_memset32((FAR uint32_t *)(dest), (value), (width))
+#  endif
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -226,6 +187,99 @@ extern "C"
  * Public Functions Definitions
  ****************************************************************************/
 
+/* The runs of 8 bits or less are filled by memset() and all runs are copied
+ * by memmove(), which the C library does a word or more at a time; memmove()
+ * because nxgl_moverectangle() moves the rows within themselves on
+ * horizontal moves.  The wider pixels are filled by the words below, four
+ * words per iteration, which the compilers also turn into vector stores
+ * where there are any.
+ */
+
+#if NXGLIB_BITSPERPIXEL == 16
+static inline void nxgl_memset16(FAR uint16_t *dest, uint16_t color,
+                                 size_t npixels)
+{
+  FAR uint32_t *wdest;
+  uint32_t wide;
+
+  /* Align the destination to a word, two pixels */
+
+  if (((uintptr_t)dest & 2) != 0 && npixels > 0)
+    {
+      *dest++ = color;
+      npixels--;
+    }
+
+  wide  = (uint32_t)color << 16 | color;
+  wdest = (FAR uint32_t *)dest;
+
+  for (; npixels >= 8; npixels -= 8)
+    {
+      wdest[0] = wide;
+      wdest[1] = wide;
+      wdest[2] = wide;
+      wdest[3] = wide;
+      wdest   += 4;
+    }
+
+  for (; npixels >= 2; npixels -= 2)
+    {
+      *wdest++ = wide;
+    }
+
+  if (npixels > 0)
+    {
+      *(FAR uint16_t *)wdest = color;
+    }
+}
+#endif
+
+#if NXGLIB_BITSPERPIXEL == 24
+static inline void nxgl_memset24(FAR uint8_t *dest, uint32_t color,
+                                 size_t npixels)
+{
+  uint8_t pattern[12];
+  int i;
+
+  /* Four pixels make three words: fill by 12 bytes at a time */
+
+  for (i = 0; i < 12; i += 3)
+    {
+      pattern[i]     = color;
+      pattern[i + 1] = color >> 8;
+      pattern[i + 2] = color >> 16;
+    }
+
+  for (; npixels >= 4; npixels -= 4)
+    {
+      memcpy(dest, pattern, 12);
+      dest += 12;
+    }
+
+  memcpy(dest, pattern, 3 * npixels);
+}
+#endif
+
+#if NXGLIB_BITSPERPIXEL == 32
+static inline void nxgl_memset32(FAR uint32_t *dest, uint32_t color,
+                                 size_t npixels)
+{
+  for (; npixels >= 4; npixels -= 4)
+    {
+      dest[0] = color;
+      dest[1] = color;
+      dest[2] = color;
+      dest[3] = color;
+      dest   += 4;
+    }
+
+  while (npixels-- > 0)
+    {
+      *dest++ = color;
+    }
+}
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
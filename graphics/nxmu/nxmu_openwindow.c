@@ -178,6 +178,10 @@ void nxmu_openwindow(FAR struct nxbe_state_s *be,
           be->topwnd->above = wnd;
           be->topwnd        = wnd;
         }
+
+      /* The visible parts of the windows change */
+
+      NXBE_CLIPINVALIDATE(be);
     }
 
   /* Report the initial size/position of the window to the client */
@@ -270,6 +270,10 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
   struct nxmu_state_s    nxmu;
   FAR struct nxsvrmsg_s *msg;
   char                   buffer[NX_MXSVRMSGLEN];
+#ifdef CONFIG_NX_UPDATE_BATCH
+  struct mq_attr         attr;
+  int                    nbatched = 0;
+#endif
   int                    nbytes;
   int                    ret;
 
@@ -295,6 +299,22 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
 
   for (; ; )
     {
+#ifdef CONFIG_NX_UPDATE_BATCH
+      /* Update the display once all of the queued messages are processed,
+       * so that the display is updated once for a burst of drawing
+       * operations.
+       */
+
+      if (nbatched >= CONFIG_NX_UPDATE_NMSGS ||
+          mq_getattr(nxmu.conn.crdmq, &attr) < 0 || attr.mq_curmsgs == 0)
+        {
+          nxbe_notify_flush(&nxmu.be);
+          nbatched = 0;
+        }
+
+      nbatched++;
+#endif
+
       /* Receive the next server message */
 
       nbytes = nxmq_receive(nxmu.conn.crdmq, buffer, NX_MXSVRMSGLEN, 0);
@@ -364,6 +384,13 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
             {
               FAR struct nxsvrmsg_synch_s *synch =
                 (FAR struct nxsvrmsg_synch_s *)buffer;
+
+#ifdef CONFIG_NX_UPDATE_BATCH
+              /* The display is up to date when the client is synched */
+
+              nxbe_notify_flush(&nxmu.be);
+              nbatched = 0;
+#endif
               nxmu_event(synch->wnd, NXEVENT_SYNCHED, synch->arg);
             }
             break;
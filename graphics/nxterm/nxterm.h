@@ -142,6 +142,14 @@ struct nxterm_state_s
   struct nxterm_bitmap_s cursor;
   struct nxterm_bitmap_s bm[CONFIG_NXTERM_MXCHARS];
 
+#ifdef CONFIG_NXTERM_RENDERLINE
+  /* Line rendering */
+
+  uint16_t pending;                          /* First bm[] not rendered yet */
+  size_t linesize;                           /* Size of linebuf */
+  FAR uint8_t *linebuf;                      /* Holds a line being rendered */
+#endif
+
   /* Keyboard input support */
 
 #ifdef CONFIG_NXTERM_NXKBDIN
@@ -228,6 +236,14 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv);
 void nxterm_fillchar(FAR struct nxterm_state_s *priv,
                      FAR const struct nxgl_rect_s *rect,
                      FAR const struct nxterm_bitmap_s *bm);
+#ifdef CONFIG_NXTERM_RENDERLINE
+int nxterm_renderrow(FAR struct nxterm_state_s *priv,
+                     FAR const struct nxgl_rect_s *rect,
+                     FAR const struct nxterm_bitmap_s *bm, int nbm);
+void nxterm_flush(FAR struct nxterm_state_s *priv);
+#else
+#  define nxterm_flush(p)
+#endif
 
 void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch);
 void nxterm_showcursor(FAR struct nxterm_state_s *priv);
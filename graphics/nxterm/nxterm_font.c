@@ -33,6 +33,18 @@
 
 #include "nxterm.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a < b) ? a : b)
+#endif
+
+#ifndef MAX
+#  define MAX(a,b) ((a > b) ? a : b)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -238,6 +250,10 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv)
   int ndx;
   int ret = -ENOENT;
 
+  /* The character to erase must be on the display */
+
+  nxterm_flush(priv);
+
   /* Is there a character on the display? */
 
   if (priv->nchars > 0)
@@ -259,6 +275,9 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv)
       /* Decrement nchars to discard this character */
 
       priv->nchars = ndx;
+#ifdef CONFIG_NXTERM_RENDERLINE
+      priv->pending = ndx;
+#endif
     }
 
   return ret;
@@ -389,3 +408,201 @@ void nxterm_fillchar(FAR struct nxterm_state_s *priv,
       DEBUGASSERT(ret >= 0);
     }
 }
+
+#ifdef CONFIG_NXTERM_RENDERLINE
+/****************************************************************************
+ * Name: nxterm_renderrow
+ *
+ * Description:
+ *   Render a part of a row of text with a single bitmap.  The region is
+ *   filled with the background color, then the glyphs of the characters on
+ *   the row of rect->pt1.y are copied into it.  The region must not be
+ *   higher than the font.
+ *
+ * Input Parameters:
+ *   priv - Driver data structure
+ *   rect - The region to render, on the row of the characters
+ *   bm   - The characters to consider
+ *   nbm  - The number of characters in bm
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure, in which case
+ *   nothing was rendered.
+ *
+ ****************************************************************************/
+
+int nxterm_renderrow(FAR struct nxterm_state_s *priv,
+                     FAR const struct nxgl_rect_s *rect,
+                     FAR const struct nxterm_bitmap_s *bm, int nbm)
+{
+  FAR const struct nxfonts_glyph_s *glyph;
+  FAR const void *src;
+  FAR uint8_t *dest;
+  FAR uint8_t *ptr;
+  nxgl_mxpixel_t bgcolor = priv->wndo.wcolor[0];
+  nxgl_coord_t width;
+  nxgl_coord_t height;
+  nxgl_coord_t x1;
+  nxgl_coord_t x2;
+  size_t stride;
+  size_t size;
+  int row;
+  int col;
+  int i;
+
+  width  = rect->pt2.x - rect->pt1.x + 1;
+  height = rect->pt2.y - rect->pt1.y + 1;
+  if (width <= 0 || height <= 0)
+    {
+      return OK;
+    }
+
+  DEBUGASSERT(height <= priv->fheight);
+
+  /* Get a buffer large enough for the region */
+
+  stride = (size_t)width * (CONFIG_NXTERM_BPP >> 3);
+  size   = stride * height;
+
+  if (size > priv->linesize)
+    {
+      if (priv->linebuf != NULL)
+        {
+          kmm_free(priv->linebuf);
+          priv->linesize = 0;
+        }
+
+      priv->linebuf = (FAR uint8_t *)kmm_malloc(size);
+      if (priv->linebuf == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      priv->linesize = size;
+    }
+
+  /* Fill the first row with the background color, then copy it */
+
+  ptr = priv->linebuf;
+  for (col = 0; col < width; col++)
+    {
+#if CONFIG_NXTERM_BPP == 8
+      *ptr++ = (uint8_t)bgcolor;
+#elif CONFIG_NXTERM_BPP == 16
+      *(FAR uint16_t *)ptr = (uint16_t)bgcolor;
+      ptr += sizeof(uint16_t);
+#else
+      *(FAR uint32_t *)ptr = (uint32_t)bgcolor;
+      ptr += sizeof(uint32_t);
+#endif
+    }
+
+  for (row = 1; row < height; row++)
+    {
+      memcpy(&priv->linebuf[row * stride], priv->linebuf, stride);
+    }
+
+  /* Copy the visible part of each glyph of the row */
+
+  for (i = 0; i < nbm; i++)
+    {
+      if (bm[i].pos.y != rect->pt1.y || BM_ISSPACE(&bm[i]))
+        {
+          continue;
+        }
+
+      glyph = nxf_cache_getglyph(priv->fcache, bm[i].code);
+      if (glyph == NULL)
+        {
+          continue;
+        }
+
+      x1 = MAX(bm[i].pos.x, rect->pt1.x);
+      x2 = MIN(bm[i].pos.x + glyph->width - 1, rect->pt2.x);
+      if (x1 > x2)
+        {
+          continue;
+        }
+
+      dest = &priv->linebuf[(x1 - rect->pt1.x) * (CONFIG_NXTERM_BPP >> 3)];
+      ptr  = (FAR uint8_t *)&glyph->bitmap[(x1 - bm[i].pos.x) *
+                                           (CONFIG_NXTERM_BPP >> 3)];
+      size = (x2 - x1 + 1) * (CONFIG_NXTERM_BPP >> 3);
+
+      for (row = 0; row < MIN(height, glyph->height); row++)
+        {
+          memcpy(dest, ptr, size);
+          dest += stride;
+          ptr  += glyph->stride;
+        }
+    }
+
+  /* Send the whole region at once */
+
+  src = (FAR const void *)priv->linebuf;
+  return priv->ops->bitmap(priv, rect, &src, &rect->pt1,
+                           (unsigned int)stride);
+}
+
+/****************************************************************************
+ * Name: nxterm_flush
+ *
+ * Description:
+ *   Render the characters added by nxterm_putc() since the last flush.
+ *   Each run of adjacent characters on a row is sent as one bitmap.
+ *
+ ****************************************************************************/
+
+void nxterm_flush(FAR struct nxterm_state_s *priv)
+{
+  FAR const struct nxterm_bitmap_s *bm;
+  FAR const struct nxfonts_glyph_s *glyph;
+  struct nxgl_rect_s rect;
+  nxgl_coord_t next;
+  int first;
+  int i;
+
+  for (first = priv->pending; first < priv->nchars; first = i)
+    {
+      /* Find the end of the run of the characters that follow each other
+       * on the row of the first one.
+       */
+
+      rect.pt1.x = priv->bm[first].pos.x;
+      rect.pt1.y = priv->bm[first].pos.y;
+      next       = rect.pt1.x;
+
+      for (i = first; i < priv->nchars; i++)
+        {
+          bm = &priv->bm[i];
+          if (bm->pos.y != rect.pt1.y || bm->pos.x != next)
+            {
+              break;
+            }
+
+          glyph = NULL;
+          if (!BM_ISSPACE(bm))
+            {
+              glyph = nxf_cache_getglyph(priv->fcache, bm->code);
+            }
+
+          next += glyph != NULL ? glyph->width : priv->spwidth;
+        }
+
+      rect.pt2.x = next - 1;
+      rect.pt2.y = rect.pt1.y + priv->fheight - 1;
+
+      if (nxterm_renderrow(priv, &rect, &priv->bm[first], i - first) < 0)
+        {
+          /* Out of memory, render the characters one at a time */
+
+          for (bm = &priv->bm[first]; bm < &priv->bm[i]; bm++)
+            {
+              nxterm_fillchar(priv, NULL, bm);
+            }
+        }
+    }
+
+  priv->pending = priv->nchars;
+}
+#endif
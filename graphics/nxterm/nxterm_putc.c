@@ -112,10 +112,16 @@ void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch)
    */
 
   bm = nxterm_addchar(priv, ch);
+#ifndef CONFIG_NXTERM_RENDERLINE
   if (bm)
     {
       nxterm_fillchar(priv, NULL, bm);
     }
+#else
+  /* The character is rendered with the rest of its line by nxterm_flush() */
+
+  UNUSED(bm);
+#endif
 }
 
 /****************************************************************************
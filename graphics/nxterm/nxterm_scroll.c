@@ -37,6 +37,14 @@
 
 #include "nxterm.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a < b) ? a : b)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -78,6 +86,33 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
       rect.pt1.y = row;
       rect.pt2.y = row + scrollheight - 1;
 
+#ifdef CONFIG_NXTERM_RENDERLINE
+      /* Render the text of the row with a single bitmap, then clear the
+       * line separation below it.
+       */
+
+      rect.pt2.y = row + MIN(scrollheight, priv->fheight) - 1;
+      ret = nxterm_renderrow(priv, &rect, priv->bm, priv->nchars);
+      if (ret >= 0)
+        {
+          if (scrollheight > priv->fheight)
+            {
+              rect.pt1.y = row + priv->fheight;
+              rect.pt2.y = row + scrollheight - 1;
+
+              ret = priv->ops->fill(priv, &rect, priv->wndo.wcolor);
+              if (ret < 0)
+                {
+                  gerr("ERROR: Fill failed: %d\n", get_errno());
+                }
+            }
+
+          continue;
+        }
+
+      rect.pt2.y = row + scrollheight - 1;
+#endif
+
       /* Clear the region */
 
       ret = priv->ops->fill(priv, &rect, priv->wndo.wcolor);
@@ -171,6 +206,10 @@ void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight)
   int i;
   int j;
 
+  /* Render the characters that are not on the display yet */
+
+  nxterm_flush(priv);
+
   /* Adjust the vertical position of each character */
 
   for (i = 0; i < priv->nchars; )
@@ -211,6 +250,10 @@ void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight)
         }
     }
 
+#ifdef CONFIG_NXTERM_RENDERLINE
+  priv->pending = priv->nchars;
+#endif
+
   /* And move the next display position up by one line as well */
 
   priv->fpos.y -= scrollheight;
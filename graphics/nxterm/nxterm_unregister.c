@@ -73,6 +73,15 @@ void nxterm_unregister(FAR struct nxterm_state_s *priv)
 
   nxf_cache_disconnect(priv->fcache);
 
+#ifdef CONFIG_NXTERM_RENDERLINE
+  /* Free the line buffer */
+
+  if (priv->linebuf != NULL)
+    {
+      kmm_free(priv->linebuf);
+    }
+#endif
+
   /* Unregister the driver */
 
   snprintf(devname, NX_DEVNAME_SIZE, NX_DEVNAME_FORMAT, priv->minor);
@@ -239,6 +239,36 @@ struct dq_frame_f32_s
 
 typedef struct dq_frame_f32_s dq_frame_f32_t;
 
+/* The frames and the angles of several motors, in structure-of-arrays
+ * layout, for the batch transforms.  Each array has one element per
+ * motor.
+ */
+
+struct abc_frame_f32_soa_s
+{
+  FAR float *a;                  /* A components */
+  FAR float *b;                  /* B components */
+  FAR float *c;                  /* C components */
+};
+
+struct ab_frame_f32_soa_s
+{
+  FAR float *a;                  /* Alpha components */
+  FAR float *b;                  /* Beta components */
+};
+
+struct dq_frame_f32_soa_s
+{
+  FAR float *d;                  /* Direct components */
+  FAR float *q;                  /* Quadrature components */
+};
+
+struct phase_angle_f32_soa_s
+{
+  FAR float *sin;                /* Phase angle sines */
+  FAR float *cos;                /* Phase angle cosines */
+};
+
 /* Space Vector Modulation data for 3-phase system */
 
 struct svm3_state_f32_s
@@ -501,6 +531,23 @@ void park_transform(FAR phase_angle_f32_t *angle, FAR ab_frame_f32_t *ab,
 void inv_park_transform(FAR phase_angle_f32_t *angle, FAR dq_frame_f32_t *dq,
                         FAR ab_frame_f32_t *ab);
 
+/* Transformation functions for n motors at once */
+
+void clarke_transform_batch(FAR const struct abc_frame_f32_soa_s *abc,
+                            FAR const struct ab_frame_f32_soa_s *ab,
+                            size_t n);
+void inv_clarke_transform_batch(FAR const struct ab_frame_f32_soa_s *ab,
+                                FAR const struct abc_frame_f32_soa_s *abc,
+                                size_t n);
+void park_transform_batch(FAR const struct phase_angle_f32_soa_s *angle,
+                          FAR const struct ab_frame_f32_soa_s *ab,
+                          FAR const struct dq_frame_f32_soa_s *dq,
+                          size_t n);
+void inv_park_transform_batch(FAR const struct phase_angle_f32_soa_s *angle,
+                              FAR const struct dq_frame_f32_soa_s *dq,
+                              FAR const struct ab_frame_f32_soa_s *ab,
+                              size_t n);
+
 /* Phase angle related functions */
 
 void angle_norm(FAR float *angle, float per, float bottom, float top);
@@ -229,6 +229,36 @@ struct dq_frame_b16_s
 
 typedef struct dq_frame_b16_s dq_frame_b16_t;
 
+/* The frames and the angles of several motors, in structure-of-arrays
+ * layout, for the batch transforms.  Each array has one element per
+ * motor.
+ */
+
+struct abc_frame_b16_soa_s
+{
+  FAR b16_t *a;                  /* A components */
+  FAR b16_t *b;                  /* B components */
+  FAR b16_t *c;                  /* C components */
+};
+
+struct ab_frame_b16_soa_s
+{
+  FAR b16_t *a;                  /* Alpha components */
+  FAR b16_t *b;                  /* Beta components */
+};
+
+struct dq_frame_b16_soa_s
+{
+  FAR b16_t *d;                  /* Direct components */
+  FAR b16_t *q;                  /* Quadrature components */
+};
+
+struct phase_angle_b16_soa_s
+{
+  FAR b16_t *sin;                /* Phase angle sines */
+  FAR b16_t *cos;                /* Phase angle cosines */
+};
+
 /* Space Vector Modulation data for 3-phase system */
 
 struct svm3_state_b16_s
@@ -491,6 +521,25 @@ void park_transform_b16(FAR phase_angle_b16_t *angle, FAR ab_frame_b16_t *ab,
 void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
                             FAR dq_frame_b16_t *dq, FAR ab_frame_b16_t *ab);
 
+/* Transformation functions for n motors at once */
+
+void clarke_transform_batch_b16(FAR const struct abc_frame_b16_soa_s *abc,
+                                FAR const struct ab_frame_b16_soa_s *ab,
+                                size_t n);
+void inv_clarke_transform_batch_b16(
+                                FAR const struct ab_frame_b16_soa_s *ab,
+                                FAR const struct abc_frame_b16_soa_s *abc,
+                                size_t n);
+void park_transform_batch_b16(FAR const struct phase_angle_b16_soa_s *angle,
+                              FAR const struct ab_frame_b16_soa_s *ab,
+                              FAR const struct dq_frame_b16_soa_s *dq,
+                              size_t n);
+void inv_park_transform_batch_b16(
+                              FAR const struct phase_angle_b16_soa_s *angle,
+                              FAR const struct dq_frame_b16_soa_s *dq,
+                              FAR const struct ab_frame_b16_soa_s *ab,
+                              size_t n);
+
 /* Phase angle related functions */
 
 void angle_norm_b16(FAR b16_t *angle, b16_t per, b16_t bottom, b16_t top);
@@ -100,6 +100,11 @@
 #define F_ADD_SEALS 16 /* Add the bit-mask argument arg to the set of seals of the inode */
 #define F_GET_SEALS 17 /* Get (as the function result) the current set of seals of the inode */
 
+/* Set and get the buffer size of a pipe or FIFO (linux) */
+
+#define F_SETPIPE_SZ 18
+#define F_GETPIPE_SZ 19
+
 /* For posix fcntl() and lockf() */
 
 #define F_RDLCK     0  /* Take out a read lease */
@@ -34,6 +34,13 @@
 
 #define MQ_NONBLOCK O_NONBLOCK
 
+/* Non-standard mq_flags bit that may be set in the attributes passed to
+ * mq_open() when the queue is created.  The messages of such a queue are
+ * kept in slots preallocated with the queue (see CONFIG_MQUEUE_RING).
+ */
+
+#define MQ_RING     (1 << 15)
+
 /********************************************************************************
  * Public Type Declarations
  ********************************************************************************/
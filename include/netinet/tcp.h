@@ -26,6 +26,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -56,4 +57,46 @@
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
 
+/* Select the congestion control algorithm, "newreno" or "cubic".
+ * Argument: The name as a string of up to TCP_CA_NAME_MAX bytes.
+ */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 5)
+
+#define TCP_CA_NAME_MAX 16
+
+/* Get the statistics of the connection.  Argument: struct tcp_info */
+
+#define TCP_INFO       (__SO_PROTOCOL + 6)
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* The statistics returned by the TCP_INFO socket option.  The field names
+ * are those of Linux, but the structure holds only a subset of its fields
+ * and is not binary compatible with it.  The times are in microseconds.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;          /* The state of the connection */
+  uint8_t  tcpi_retransmits;    /* Retransmissions of the current segment */
+  uint16_t tcpi_snd_mss;        /* The maximum segment size */
+  uint32_t tcpi_rto;            /* The retransmission timeout */
+  uint32_t tcpi_rtt;            /* The smoothed round trip time */
+  uint32_t tcpi_rttvar;         /* The round trip time variation */
+  uint32_t tcpi_snd_ssthresh;   /* Slow start threshold, 0: no congestion
+                                 * control */
+  uint32_t tcpi_snd_cwnd;       /* Congestion window in bytes, 0: no
+                                 * congestion control */
+  uint32_t tcpi_snd_wnd;        /* The receive window of the peer */
+  uint32_t tcpi_unacked;        /* Bytes sent but not acknowledged */
+  uint32_t tcpi_notsent_bytes;  /* Bytes queued but not sent yet */
+  uint32_t tcpi_rcv_queued;     /* Bytes received but not read yet */
+  uint32_t tcpi_total_retrans;  /* Segments retransmitted */
+  uint64_t tcpi_bytes_acked;    /* Bytes sent and acknowledged */
+  uint64_t tcpi_bytes_received; /* Bytes received in sequence */
+};
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -28,6 +28,42 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Packet socket options (level SOL_PACKET) */
+
+#define SOL_PACKET            263
+
+#define PACKET_RX_RING        5  /* Set up a memory-mapped receive ring */
+#define PACKET_TX_RING        13 /* Set up a memory-mapped transmit ring */
+
+/* Frame status words of the memory-mapped rings.  A receive frame belongs
+ * to the kernel while TP_STATUS_KERNEL and to the application otherwise; a
+ * transmit frame is queued by the application with TP_STATUS_SEND_REQUEST
+ * and returned by the kernel with TP_STATUS_AVAILABLE once sent.
+ */
+
+#define TP_STATUS_KERNEL          0
+#define TP_STATUS_USER            (1 << 0)
+#define TP_STATUS_LOSING          (1 << 2) /* Frames were dropped before */
+
+#define TP_STATUS_AVAILABLE       0
+#define TP_STATUS_SEND_REQUEST    (1 << 0)
+#define TP_STATUS_WRONG_FORMAT    (1 << 2) /* Not sent:  Frame too long */
+
+/* Each frame begins with a struct tpacket_hdr, followed by the struct
+ * sockaddr_ll of the frame.  Received data starts at tp_mac; data to send
+ * starts at TPACKET_ALIGN(sizeof(struct tpacket_hdr)).
+ */
+
+#define TPACKET_ALIGNMENT     16
+#define TPACKET_ALIGN(x)      (((x) + TPACKET_ALIGNMENT - 1) & \
+                               ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN        (TPACKET_ALIGN(sizeof(struct tpacket_hdr)) + \
+                               sizeof(struct sockaddr_ll))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -43,4 +79,32 @@ struct sockaddr_ll
   unsigned char  sll_addr[8];
 };
 
+/* The geometry of a memory-mapped ring, given to PACKET_RX_RING and
+ * PACKET_TX_RING.  The frames are tp_frame_size bytes apart and may not
+ * cross a block:  tp_block_size must be a multiple of tp_frame_size, which
+ * must be a multiple of TPACKET_ALIGNMENT.  The ring is mapped with mmap()
+ * on the socket, the receive ring first.
+ */
+
+struct tpacket_req
+{
+  unsigned int   tp_block_size;  /* Minimal size of contiguous block */
+  unsigned int   tp_block_nr;    /* Number of blocks */
+  unsigned int   tp_frame_size;  /* Size of frame */
+  unsigned int   tp_frame_nr;    /* Total number of frames */
+};
+
+/* The header at the start of each frame of a ring */
+
+struct tpacket_hdr
+{
+  unsigned long  tp_status;      /* TP_STATUS_* */
+  unsigned int   tp_len;         /* Length of the frame */
+  unsigned int   tp_snaplen;     /* Length of the data held in the ring */
+  unsigned short tp_mac;         /* Offset of the frame in the slot */
+  unsigned short tp_net;         /* Offset of the network header */
+  unsigned int   tp_sec;         /* Time of reception */
+  unsigned int   tp_usec;
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
@@ -58,6 +59,17 @@
 #  define CONFIG_ADC_NPOLLWAITERS 2
 #endif
 
+#if !defined(CONFIG_ADC_STREAM_BUFSIZE)
+#  define CONFIG_ADC_STREAM_BUFSIZE 16384
+#endif
+
+/* The size of a block of samples returned by read() in streaming mode,
+ * with its header and the padding that keeps the next header aligned.
+ */
+
+#define ADC_BLOCK_SIZE(nbytes) \
+  ((sizeof(struct adc_block_s) + (nbytes) + 7) & ~7)
+
 #define ADC_RESET(dev)         ((dev)->ad_ops->ao_reset((dev)))
 #define ADC_SETUP(dev)         ((dev)->ad_ops->ao_setup((dev)))
 #define ADC_SHUTDOWN(dev)      ((dev)->ad_ops->ao_shutdown((dev)))
@@ -101,6 +113,27 @@ struct adc_callback_s
    */
 
   CODE int (*au_reset)(FAR struct adc_dev_s *dev);
+
+#ifdef CONFIG_ADC_STREAM
+  /* This method is called from the lower half, platform-specific ADC logic
+   * when a DMA block of samples is complete, in streaming mode.  The block
+   * is copied to the stream of the upper half, so the lower half may
+   * reuse its buffer on return.
+   *
+   * Input Parameters:
+   *   dev    - The ADC device structure that was previously registered by
+   *            adc_register()
+   *   data   - The samples, in the format of the lower half
+   *   nbytes - The size of the block, in bytes
+   *
+   * Returned Value:
+   *   Zero on success; -ENOMEM if the block was dropped because the
+   *   stream is full.
+   */
+
+  CODE int (*au_receiveblock)(FAR struct adc_dev_s *dev,
+                              FAR const void *data, size_t nbytes);
+#endif
 };
 
 /* This describes on ADC message */
@@ -122,6 +155,36 @@ struct adc_fifo_s
   struct adc_msg_s af_buffer[CONFIG_ADC_FIFOSIZE];
 };
 
+#ifdef CONFIG_ADC_STREAM
+/* In streaming mode, read() returns whole blocks of samples, each one
+ * made of this header followed by ab_nbytes of samples, in the format of
+ * the lower half, and padded to ADC_BLOCK_SIZE(ab_nbytes).
+ */
+
+struct adc_block_s
+{
+  struct timespec ab_time;               /* Time of the end of the block */
+  uint32_t     ab_seq;                   /* Sequence number of the block */
+  uint32_t     ab_dropped;               /* Number of blocks dropped just
+                                          * before this one (overruns) */
+  uint32_t     ab_nbytes;                /* Size of the samples */
+  uint32_t     ab_reserved;
+};
+
+/* This describes the stream of blocks of samples */
+
+struct adc_stream_s
+{
+  FAR uint8_t *as_buffer;                /* CONFIG_ADC_STREAM_BUFSIZE bytes */
+  size_t       as_head;                  /* Bytes read, free running */
+  size_t       as_tail;                  /* Bytes queued, free running */
+  uint32_t     as_seq;                   /* Sequence of the next block */
+  uint32_t     as_dropped;               /* Blocks dropped since the last */
+  uint32_t     as_overruns;              /* Blocks dropped in total */
+  sem_t        as_rdsem;                 /* Serializes the readers */
+};
+#endif
+
 /* This structure defines all of the operations provided by the architecture
  * specific logic.  All fields must be provided with non-NULL function
  * pointers by the caller of adc_register().
@@ -192,6 +255,9 @@ struct adc_dev_s
   sem_t                       ad_recvsem;    /* Used to wakeup user waiting for space in ad_recv.buffer */
   struct adc_fifo_s           ad_recv;       /* Describes receive FIFO */
   bool                        ad_isovr;      /* Flag to indicate an ADC overrun */
+#ifdef CONFIG_ADC_STREAM
+  struct adc_stream_s         ad_stream;     /* Blocks of samples from DMA */
+#endif
 
   /* The following is a list of poll structures of threads waiting for
    * driver events.  The 'struct pollfd' reference for each open is also
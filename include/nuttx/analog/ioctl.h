@@ -63,9 +63,15 @@
                                                  * IN: None
                                                  * OUT: Number of samples
                                                  * waiting to be read */
+#define ANIOC_STREAM_OVERRUNS   _ANIOC(0x0007)  /* Get the number of blocks
+                                                 * of samples dropped in
+                                                 * streaming mode
+                                                 * IN: None
+                                                 * OUT: Number of blocks
+                                                 * dropped since opened */
 
 #define AN_FIRST          0x0001          /* First common command */
-#define AN_NCMDS          6               /* Number of common commands */
+#define AN_NCMDS          7               /* Number of common commands */
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half driver to the lower-half driver via the ioctl()
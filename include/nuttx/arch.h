@@ -1516,6 +1516,24 @@ void up_trigger_irq(int irq);
 int up_prioritize_irq(int irq, int priority);
 #endif
 
+/****************************************************************************
+ * Name: up_affinity_irq
+ *
+ * Description:
+ *   Route an IRQ to the set of CPUs 'cpuset' in the interrupt controller.
+ *
+ *   Since this API is not supported on all architectures, it should be
+ *   avoided in common implementations where possible.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+int up_affinity_irq(int irq, cpu_set_t cpuset);
+#endif
+
 #ifdef CONFIG_ARCH_HAVE_TRUSTZONE
 
 /****************************************************************************
@@ -2111,6 +2129,25 @@ int up_cpu_paused(int cpu);
 int up_cpu_resume(int cpu);
 #endif
 
+/****************************************************************************
+ * Name: up_send_smp_call
+ *
+ * Description:
+ *   Raise the SMP call inter-processor interrupt on the CPUs in 'cpuset'.
+ *   The interrupt handler must call nxsched_smp_call_handler().
+ *
+ * Input Parameters:
+ *   cpuset - The set of CPUs to interrupt
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+int up_send_smp_call(cpu_set_t cpuset);
+#endif
+
 /****************************************************************************
  * Name: up_romgetc
  *
@@ -2507,6 +2544,31 @@ int arch_phy_irq(FAR const char *intf, xcpt_t handler, void *arg,
                  phy_enable_t *enable);
 #endif
 
+/****************************************************************************
+ * Name: up_chksum
+ *
+ * Description:
+ *   Calculate the raw Internet checksum over the memory region described
+ *   by data and len, exactly as the generic chksum() in net/utils does.
+ *   All of the network checksums are built on this sum, so it is worth an
+ *   implementation that uses the carry flag or the SIMD unit of the
+ *   architecture.  data need not be aligned.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call.  This
+ *          should be zero on the first call.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value in host byte order.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARCH_CHKSUM
+uint16_t up_chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
+#endif
+
 /****************************************************************************
  * Debug interfaces exported by the architecture-specific logic
  ****************************************************************************/
@@ -112,6 +112,8 @@
 #define AUDIOIOC_UNREGISTERMQ       _AUDIOIOC(15)
 #define AUDIOIOC_HWRESET            _AUDIOIOC(16)
 #define AUDIOIOC_SETBUFFERINFO      _AUDIOIOC(17)
+#define AUDIOIOC_ALLOCPOOL          _AUDIOIOC(18)
+#define AUDIOIOC_FREEPOOL           _AUDIOIOC(19)
 
 /* Audio Device Types *******************************************************/
 
@@ -470,6 +472,38 @@ struct audio_buf_desc_s
   } u;
 };
 
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+/* A pool of buffers allocated at once with AUDIOIOC_ALLOCPOOL, in memory
+ * shared by the application and the driver.  The buffers are enqueued with
+ * AUDIOIOC_ENQUEUEBUFFER as usual, but the driver returns them through the
+ * done ring instead of the message queue.  The driver advances head, the
+ * application advances tail with apb_pool_dequeue(), and polls the audio
+ * device for POLLIN to wait for a buffer.
+ */
+
+struct audio_pool_s
+{
+  uint16_t            nbuffers;           /* Number of buffers */
+  apb_samp_t          nbytes;             /* Size of each buffer in bytes */
+  volatile uint32_t   head;               /* Count of the buffers done */
+  volatile uint32_t   tail;               /* Count of the buffers taken */
+  FAR struct ap_buffer_s *apb[CONFIG_AUDIO_POOL_MAXBUFFERS];
+  uint8_t             done[CONFIG_AUDIO_POOL_MAXBUFFERS]; /* apb indices */
+};
+
+/* Structure for allocating a pool with the AUDIOIOC_ALLOCPOOL ioctl */
+
+struct audio_pool_desc_s
+{
+#ifdef CONFIG_AUDIO_MULTI_SESSION
+  FAR void            *session;           /* Associated channel */
+#endif
+  uint16_t            nbuffers;           /* Number of buffers */
+  apb_samp_t          nbytes;             /* Size of each buffer (period) */
+  FAR struct audio_pool_s **ppool;        /* Pointer to receive the pool */
+};
+#endif
+
 /* Typedef for lower-level to upper-level callback for buffer dequeuing */
 
 #ifdef CONFIG_AUDIO_MULTI_SESSION
@@ -776,6 +810,19 @@ void apb_free(FAR struct ap_buffer_s *apb);
 
 void apb_reference(FAR struct ap_buffer_s *apb);
 
+/****************************************************************************
+ * Name: apb_pool_dequeue
+ *
+ * Take the next buffer returned by the driver from a pool allocated with
+ * AUDIOIOC_ALLOCPOOL, without blocking.  Returns NULL if there is none;
+ * poll the audio device for POLLIN to wait for one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+FAR struct ap_buffer_s *apb_pool_dequeue(FAR struct audio_pool_s *pool);
+#endif
+
 /****************************************************************************
  * Platform-Dependent "Lower-Half" Audio Driver Interfaces
  ****************************************************************************/
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * include/nuttx/audio/audio_dsp.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_AUDIO_AUDIO_DSP_H
+#define __INCLUDE_NUTTX_AUDIO_AUDIO_DSP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef CONFIG_AUDIO_DSP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The gains are Q15 fractions: AUDIO_DSP_GAIN_UNITY is the largest one,
+ * 1.0 - 2^-15.
+ */
+
+#define AUDIO_DSP_GAIN_UNITY  INT16_MAX
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* The samples are signed 16 bit in host byte order unless stated
+ * otherwise, and the counts are in samples, not in bytes.  The buffers do
+ * not need to be aligned.
+ */
+
+/****************************************************************************
+ * Name: audio_dsp_u8tos16
+ *
+ * Description:
+ *   Convert unsigned 8 bit samples, as in 8 bit WAV files, to signed 16 bit
+ *   samples.  dst must not overlap src.
+ *
+ ****************************************************************************/
+
+void audio_dsp_u8tos16(FAR int16_t *dst, FAR const uint8_t *src,
+                       size_t nsamples);
+
+/****************************************************************************
+ * Name: audio_dsp_s16tou8
+ *
+ * Description:
+ *   Convert signed 16 bit samples to unsigned 8 bit samples, keeping the
+ *   most significant bits.  dst may be the same buffer as src.
+ *
+ ****************************************************************************/
+
+void audio_dsp_s16tou8(FAR uint8_t *dst, FAR const int16_t *src,
+                       size_t nsamples);
+
+/****************************************************************************
+ * Name: audio_dsp_swap16
+ *
+ * Description:
+ *   Swap the bytes of 16 bit samples in place, converting them between
+ *   little and big endian.
+ *
+ ****************************************************************************/
+
+void audio_dsp_swap16(FAR void *buf, size_t nsamples);
+
+/****************************************************************************
+ * Name: audio_dsp_interleave
+ *
+ * Description:
+ *   Interleave nframes samples of each of the nchannels buffers of src
+ *   into dst, which holds nframes * nchannels samples.
+ *
+ ****************************************************************************/
+
+void audio_dsp_interleave(FAR int16_t *dst,
+                          FAR const int16_t * FAR const *src,
+                          unsigned int nchannels, size_t nframes);
+
+/****************************************************************************
+ * Name: audio_dsp_deinterleave
+ *
+ * Description:
+ *   The reverse of audio_dsp_interleave(): split nframes frames of
+ *   nchannels samples from src into the nchannels buffers of dst.
+ *
+ ****************************************************************************/
+
+void audio_dsp_deinterleave(FAR int16_t * FAR const *dst,
+                            FAR const int16_t *src,
+                            unsigned int nchannels, size_t nframes);
+
+/****************************************************************************
+ * Name: audio_dsp_gain
+ *
+ * Description:
+ *   Scale the samples of src by the Q15 gain into dst, with rounding.  dst
+ *   may be the same buffer as src.
+ *
+ ****************************************************************************/
+
+void audio_dsp_gain(FAR int16_t *dst, FAR const int16_t *src,
+                    int16_t gain, size_t nsamples);
+
+/****************************************************************************
+ * Name: audio_dsp_mix
+ *
+ * Description:
+ *   Mix the nsrc streams of src into dst, adding each stream in turn with
+ *   saturation.  dst may be the same buffer as the first stream, so that a
+ *   stream can be mixed into the output accumulated so far.
+ *
+ ****************************************************************************/
+
+void audio_dsp_mix(FAR int16_t *dst, FAR const int16_t * FAR const *src,
+                   unsigned int nsrc, size_t nsamples);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_AUDIO_DSP */
+#endif /* __INCLUDE_NUTTX_AUDIO_AUDIO_DSP_H */
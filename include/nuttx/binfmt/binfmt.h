@@ -134,7 +134,8 @@ struct binfmt_s
   /* Unload module callback */
 
   CODE int (*coredump)(FAR struct memory_region_s *regions,
-                       FAR struct lib_outstream_s *stream);
+                       FAR struct lib_outstream_s *stream,
+                       pid_t pid);
 };
 
 /****************************************************************************
@@ -196,6 +197,14 @@ int unregister_binfmt(FAR struct binfmt_s *binfmt);
  * Description:
  *   This function for generating core dump stream.
  *
+ * Input Parameters:
+ *   regions - The memory regions to dump, ended by an empty one, or NULL
+ *   stream  - The stream that receives the dump
+ *   pid     - The task to dump, usually the one that crashed: Its state
+ *             and its stack are dumped, besides the regions.  If pid is
+ *             negative, the state of all the tasks is dumped, and only the
+ *             regions.
+ *
  * Returned Value:
  *   This is a NuttX internal function so it follows the convention that
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -204,7 +213,7 @@ int unregister_binfmt(FAR struct binfmt_s *binfmt);
  ****************************************************************************/
 
 int core_dump(FAR struct memory_region_s *regions,
-              FAR struct lib_outstream_s *stream);
+              FAR struct lib_outstream_s *stream, pid_t pid);
 
 /****************************************************************************
  * Name: load_module
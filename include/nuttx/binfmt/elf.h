@@ -94,6 +94,10 @@ struct elf_loadinfo_s
 
   uintptr_t         textalloc;   /* .text memory allocated when ELF file was loaded */
   uintptr_t         dataalloc;   /* .bss/.data memory allocated when ELF file was loaded */
+  uintptr_t         textstart;   /* Address of the first .text section */
+#ifdef CONFIG_ELF_XIP
+  uintptr_t         xipbase;     /* Address of the file in memory, or zero */
+#endif
   size_t            textsize;    /* Size of the ELF .text memory allocation */
   size_t            datasize;    /* Size of the ELF .bss/.data memory allocation */
   size_t            textalign;   /* Necessary alignment of .text */
@@ -143,6 +147,7 @@ struct elf_dumpinfo_s
 {
   FAR struct memory_region_s *regions;
   FAR struct lib_outstream_s *stream;
+  pid_t                       pid;  /* The task to dump, or all if < 0 */
 };
 #endif
 
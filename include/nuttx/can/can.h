@@ -32,6 +32,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <sys/time.h>
 
 #include <nuttx/list.h>
 #include <nuttx/fs/fs.h>
@@ -116,6 +117,30 @@
  *                   is returned with the errno variable set to indicate the
  *                   nature of the error (for example, ETIMEDOUT)
  *
+ * CANIOC_ADD_RDFILTER:
+ *   Description:    Add an ID/mask filter to the open file.  A file with
+ *                   filters receives only the messages that match one of
+ *                   them, and the error reports; a file without filters
+ *                   receives all messages.  The filters are applied by the
+ *                   upper half for each file, in addition to the hardware
+ *                   filters of CANIOC_ADD_STDFILTER/CANIOC_ADD_EXTFILTER,
+ *                   which apply to all the files of the device.
+ *   Argument:       A reference to struct canioc_rdfilter_s
+ *   Returned Value: Zero (OK) is returned on success.  Otherwise -1 (ERROR)
+ *                   is returned with the errno variable set to indicate the
+ *                   nature of the error (ENOSPC if the file has
+ *                   CONFIG_CAN_NRDFILTERS filters already).
+ *   Dependencies:   CONFIG_CAN_NRDFILTERS > 0, file opened for reading
+ *
+ * CANIOC_DEL_RDFILTERS:
+ *   Description:    Remove all the filters of the open file, which then
+ *                   receives all messages again.
+ *   Argument:       None
+ *   Returned Value: Zero (OK) is returned on success.  Otherwise -1 (ERROR)
+ *                   is returned with the errno variable set to indicate the
+ *                   nature of the error.
+ *   Dependencies:   CONFIG_CAN_NRDFILTERS > 0, file opened for reading
+ *
  * Ioctl commands that may or may not be supported by the lower half CAN driver.
  *
  * CANIOC_ADD_STDFILTER:
@@ -229,9 +254,11 @@
 #define CANIOC_BUSOFF_RECOVERY    _CANIOC(10)
 #define CANIOC_SET_NART           _CANIOC(11)
 #define CANIOC_SET_ABOM           _CANIOC(12)
+#define CANIOC_ADD_RDFILTER       _CANIOC(13)
+#define CANIOC_DEL_RDFILTERS      _CANIOC(14)
 
 #define CAN_FIRST                 0x0001         /* First common command */
-#define CAN_NCMDS                 12             /* Ten common commands */
+#define CAN_NCMDS                 14             /* Fourteen common commands */
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half CAN driver to the lower-half CAN driver via the co_ioctl()
@@ -433,6 +460,9 @@
  *               Bit 7:      Unused
  *   Bytes 5-12: CAN data    Size determined by DLC
  *
+ * With CONFIG_CAN_TIMESTAMP=y, the header is followed by the time of
+ * reception of the message, before the data.
+ *
  * NOTE: The error indication if valid only on message reports received from the
  * CAN driver; it is ignored on transmission.  When the error bit is set, the
  * message ID is an encoded set of error indications (see CAN_ERROR_* definitions).
@@ -461,6 +491,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_esi    : 1; /* Error State Indicator */
 #endif
   uint8_t      ch_unused : 1; /* FIXME: This field is useless, kept for backward compatibility */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time of reception, CLOCK_MONOTONIC */
+#endif
 } end_packed_struct;
 
 #else
@@ -478,6 +511,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_esi    : 1; /* Error State Indicator */
 #endif
   uint8_t      ch_unused : 1; /* FIXME: This field is useless, kept for backward compatibility */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time of reception, CLOCK_MONOTONIC */
+#endif
 } end_packed_struct;
 #endif
 
@@ -598,13 +634,31 @@ struct can_ops_s
  *
  *   The elements of 'cd_ops', and 'cd_priv'
  *
+ * and cd_hwtstamp, set if the lower half provides the ch_ts of the
+ * messages that it passes to can_receive().
+ *
  * The common logic will initialize all semaphores.
  */
 
+/* CANIOC_ADD_RDFILTER: A message matches if the bits of its ID that are
+ * set in rf_mask are the ones of rf_id.
+ */
+
+struct canioc_rdfilter_s
+{
+  uint32_t              rf_id;           /* 11- or 29-bit ID */
+  uint32_t              rf_mask;         /* The bits of the ID to compare */
+  uint8_t               rf_extid;        /* 1=Match the extended IDs */
+};
+
 struct can_reader_s
 {
   struct list_node     list;
   struct can_rxfifo_s  fifo;             /* Describes receive FIFO */
+#if CONFIG_CAN_NRDFILTERS > 0
+  uint8_t              nfilters;         /* Number of filters, 0=all pass */
+  struct canioc_rdfilter_s filters[CONFIG_CAN_NRDFILTERS];
+#endif
 };
 
 struct can_dev_s
@@ -626,6 +680,9 @@ struct can_dev_s
   struct can_rtrwait_s cd_rtr[CONFIG_CAN_NPENDINGRTR];
   FAR const struct can_ops_s *cd_ops;    /* Arch-specific operations */
   FAR void            *cd_priv;          /* Used by the arch-specific logic */
+#ifdef CONFIG_CAN_TIMESTAMP
+  bool                 cd_hwtstamp;      /* The lower half sets ch_ts */
+#endif
 
   FAR struct pollfd   *cd_fds[CONFIG_CAN_NPOLLWAITERS];
 };
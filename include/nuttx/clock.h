@@ -215,8 +215,29 @@ struct cpuload_s
 
 #ifdef CONFIG_SYSTEM_TIME64
 typedef int64_t sclock_t;
+#  define SCLOCK_MAX INT64_MAX
 #else
 typedef int32_t sclock_t;
+#  define SCLOCK_MAX INT32_MAX
+#endif
+
+/* This structure holds the time data that the OS publishes to user space
+ * on every timer tick so that clock_gettime() does not need a system call
+ * (see CONFIG_CLOCK_VDATA).  The instance resides in user space and is
+ * referenced by struct userspace_s.
+ *
+ * cv_seq is odd while the OS updates the data.  Readers retry until they
+ * saw the same even value before and after reading the data.
+ */
+
+#ifdef CONFIG_CLOCK_VDATA
+struct clock_vdata_s
+{
+  volatile uint32_t cv_seq;        /* Sequence counter of the updates */
+  volatile clock_t  cv_ticks;      /* System timer ticks since power up */
+  volatile time_t   cv_basesec;    /* Time-of-day at tick zero, seconds */
+  volatile long     cv_basensec;   /* Time-of-day at tick zero, nsec */
+};
 #endif
 
 /****************************************************************************
@@ -231,6 +252,14 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_CLOCK_VDATA
+/* The time data published to user space by the OS.  This resides in the
+ * user-space C library.
+ */
+
+EXTERN struct clock_vdata_s g_clock_vdata;
+#endif
+
 /* Access to raw system clock ***********************************************/
 
 /* Direct access to the system timer/counter is supported only if (1) the
@@ -481,6 +510,26 @@ int clock_systime_timespec(FAR struct timespec *ts);
 int clock_cpuload(int pid, FAR struct cpuload_s *cpuload);
 #endif
 
+/****************************************************************************
+ * Name:  clock_cpuload_irq
+ *
+ * Description:
+ *   Return the load measurement data of the interrupt handlers of a CPU.
+ *   The active count is the time the CPU spent in interrupt handlers.
+ *
+ * Input Parameters:
+ *   cpu - The CPU of interest
+ *   cpuload - The location to return the CPU load
+ *
+ * Returned Value:
+ *   OK (0) on success; -EINVAL if 'cpu' is not a valid CPU index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+int clock_cpuload_irq(int cpu, FAR struct cpuload_s *cpuload);
+#endif
+
 /****************************************************************************
  * Name:  nxsched_oneshot_extclk
  *
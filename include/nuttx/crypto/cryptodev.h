@@ -50,6 +50,7 @@
 #define CIOCGSESSION            101
 #define CIOCFSESSION            102
 #define CIOCCRYPT               103
+#define CIOCNCRYPTM             104 /* Run a batch of struct crypt_op */
 
 typedef char *caddr_t;
 
@@ -77,4 +78,20 @@ struct crypt_op
   caddr_t iv;
 };
 
+/* CIOCNCRYPTM runs 'count' operations in one call and returns the result
+ * of each in its 'status'.
+ */
+
+struct crypt_n_op
+{
+  struct crypt_op op;
+  int status;         /* returns: 0 or a negated errno value */
+};
+
+struct crypt_mop
+{
+  unsigned count;
+  FAR struct crypt_n_op *reqs;
+};
+
 #endif /* __INCLUDE_NUTTX_CRYPTO_CRYPTODEV_H */
@@ -39,6 +39,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_DRVR_WRNBUFFERS
+#  define CONFIG_DRVR_WRNBUFFERS 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -53,6 +57,17 @@ typedef CODE ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer,
 typedef CODE ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer,
                                    off_t startblock, size_t nblocks);
 
+/* A write buffer that was parked to make room for writes elsewhere */
+
+#if defined(CONFIG_DRVR_WRITEBUFFER) && CONFIG_DRVR_WRNBUFFERS > 1
+struct rwb_wrpark_s
+{
+  uint8_t      *buffer;          /* Allocated write buffer */
+  uint16_t      nblocks;         /* Number of blocks in the buffer */
+  off_t         blockstart;      /* First block in the buffer */
+};
+#endif
+
 /* This structure holds the state of the buffers.  In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
@@ -132,6 +147,9 @@ struct rwbuffer_s
   uint8_t      *wrbuffer;        /* Allocated write buffer */
   uint16_t      wrnblocks;       /* Number of blocks in write buffer */
   off_t         wrblockstart;    /* First block in write buffer */
+#if CONFIG_DRVR_WRNBUFFERS > 1
+  struct rwb_wrpark_s wrpark[CONFIG_DRVR_WRNBUFFERS - 1];
+#endif
 #endif
 
   /* This is the state of the read-ahead buffering */
@@ -141,6 +159,8 @@ struct rwbuffer_s
   uint8_t      *rhbuffer;        /* Allocated read-ahead buffer */
   uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
   off_t         rhblockstart;    /* First block in read-ahead buffer */
+  uint16_t      rhwindow;        /* Read-ahead size for the current stream */
+  off_t         rhnextblock;     /* Block after the last one read */
 #endif
 };
 
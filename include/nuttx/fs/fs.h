@@ -93,10 +93,13 @@
 
 /* Stream flags for the fs_flags field of in struct file_struct */
 
-#define __FS_FLAG_EOF   (1 << 0) /* EOF detected by a read operation */
-#define __FS_FLAG_ERROR (1 << 1) /* Error detected by any operation */
-#define __FS_FLAG_LBF   (1 << 2) /* Line buffered */
-#define __FS_FLAG_UBF   (1 << 3) /* Buffer allocated by caller of setvbuf */
+#define __FS_FLAG_EOF      (1 << 0) /* EOF detected by a read operation */
+#define __FS_FLAG_ERROR    (1 << 1) /* Error detected by any operation */
+#define __FS_FLAG_LBF      (1 << 2) /* Line buffered */
+#define __FS_FLAG_UBF      (1 << 3) /* Buffer allocated by caller of setvbuf */
+#define __FS_FLAG_BYCALLER (1 << 4) /* Locked by the caller, see
+                                     * __fsetlocking */
+#define __FS_FLAG_COOKIE   (1 << 5) /* Created by fopencookie() */
 
 /* Inode i_flags values:
  *
@@ -174,6 +177,7 @@ struct inode;
 struct stat;
 struct statfs;
 struct pollfd;
+struct iovec;
 struct mtd_dev_s;
 
 /* The internal representation of type DIR is just a container for an inode
@@ -225,6 +229,15 @@ struct file_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Optional vectored I/O.  If not provided, readv() and writev() call
+   * read() and write() once for each buffer.
+   */
+
+  ssize_t (*readv)(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+  ssize_t (*writev)(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
 };
 
 /* This structure provides information about the state of a block driver */
@@ -904,6 +917,28 @@ int nx_open(FAR const char *path, int oflags, ...);
 
 int fs_getfilep(int fd, FAR struct file **filep);
 
+/****************************************************************************
+ * Name: files_getfilep
+ *
+ * Description:
+ *   Given a file descriptor of the file list 'list', return the
+ *   corresponding instance of struct file.  This is fs_getfilep() for the
+ *   file list of another task group.
+ *
+ * Input Parameters:
+ *   list  - The file list
+ *   fd    - The file descriptor
+ *   filep - The location to return the struct file instance
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int files_getfilep(FAR struct filelist *list, int fd,
+                   FAR struct file **filep);
+
 /****************************************************************************
  * Name: file_close
  *
@@ -1100,6 +1135,25 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes);
 
 ssize_t nx_read(int fd, FAR void *buf, size_t nbytes);
 
+/****************************************************************************
+ * Name: file_readv and nx_readv
+ *
+ * Description:
+ *   Equivalent to the standard readv() function except that they do not
+ *   modify the errno variable and are not cancellation points.
+ *   file_readv() accepts a file structure instance instead of a file
+ *   descriptor.
+ *
+ * Returned Value:
+ *   The number of bytes read on success, 0 on an end-of-file condition, or
+ *   a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep,
+                   FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt);
+
 /****************************************************************************
  * Name: file_write
  *
@@ -1156,6 +1210,25 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
 
 ssize_t nx_write(int fd, FAR const void *buf, size_t nbytes);
 
+/****************************************************************************
+ * Name: file_writev and nx_writev
+ *
+ * Description:
+ *   Equivalent to the standard writev() function except that they do not
+ *   modify the errno variable and are not cancellation points.
+ *   file_writev() accepts a file structure instance instead of a file
+ *   descriptor.
+ *
+ * Returned Value:
+ *   The number of bytes written on success or a negated errno value on any
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_writev(FAR struct file *filep,
+                    FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt);
+
 /****************************************************************************
  * Name: file_pread
  *
@@ -1374,6 +1447,21 @@ int nx_fcntl(int fd, int cmd, ...);
 
 int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Signal the poller of 'fds' after the revents of 'fds' were updated.
+ *   This runs the callback of 'fds' if one was installed, otherwise it
+ *   posts the semaphore of 'fds'.  May be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   fds - The structure describing the events that occurred
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
 /****************************************************************************
  * Name: nx_poll
  *
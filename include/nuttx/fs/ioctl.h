@@ -89,6 +89,7 @@
 #define _MTRIOBASE      (0x3100) /* Motor device ioctl commands */
 #define _MATHIOBASE     (0x3200) /* MATH device ioctl commands */
 #define _MMCSDIOBASE    (0x3300) /* MMCSD device ioctl commands */
+#define _IORINGBASE     (0x3400) /* I/O ring driver ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -417,6 +418,14 @@
                                              *       (default)
                                              *     1=fre when empty
                                              * OUT: None */
+#define PIPEIOC_GETSIZE   _PIPEIOC(0x0002)  /* Get the buffer size
+                                             * IN: Pointer to int
+                                             * OUT: Buffer size in bytes */
+#define PIPEIOC_SETSIZE   _PIPEIOC(0x0003)  /* Set the buffer size
+                                             * IN: unsigned long integer
+                                             *     size in bytes, up to
+                                             *     CONFIG_DEV_PIPE_MAXSIZE
+                                             * OUT: None */
 
 /* RTC driver ioctl definitions *********************************************/
 
@@ -581,6 +590,11 @@
 #define _MMCSDIOCVALID(c)   (_IOC_TYPE(c) == _MMCSDIOBASE)
 #define _MMCSDIOC(nr)       _IOC(_MMCSDIOBASE, nr)
 
+/* I/O ring driver **********************************************************/
+
+#define _IORINGIOCVALID(c)  (_IOC_TYPE(c) == _IORINGBASE)
+#define _IORINGIOC(nr)      _IOC(_IORINGBASE, nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
@@ -0,0 +1,152 @@
+/****************************************************************************
+ * include/nuttx/fs/ioring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_IORING_H
+#define __INCLUDE_NUTTX_FS_IORING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+
+#ifdef CONFIG_FS_IORING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The I/O ring driver (/dev/ioring) shares a submission queue (SQ) and a
+ * completion queue (CQ) with the application.  The application fills in
+ * submission queue entries and advances sq_tail; the I/O workers of the
+ * kernel consume them, advance sq_head and post one completion queue entry
+ * per request at cq_tail.  The application consumes completions and
+ * advances cq_head.  As long as the workers are busy with a ring, they
+ * pick up new submissions without any further system call.
+ *
+ * IORINGIOC_SETUP
+ *   Description: Attach the ring to the opened driver
+ *   Argument:    A pointer to struct ioring_s
+ *   Returned:    Zero (OK) on success
+ *
+ * IORINGIOC_ENTER
+ *   Description: Start the processing of the new submissions and wait
+ *                until at least 'arg' completions are available
+ *   Argument:    The minimum number of completions
+ *   Returned:    The number of completions available
+ */
+
+#define IORINGIOC_SETUP     _IORINGIOC(0x0001)
+#define IORINGIOC_ENTER     _IORINGIOC(0x0002)
+
+/* The operations of a submission queue entry */
+
+#define IORING_OP_NOP       0  /* No operation */
+#define IORING_OP_READ      1  /* read() or pread() */
+#define IORING_OP_WRITE     2  /* write() or pwrite() */
+#define IORING_OP_FSYNC     3  /* fsync() */
+#define IORING_OP_SEND      4  /* send() with sqe_flags */
+#define IORING_OP_RECV      5  /* recv() with sqe_flags */
+
+/* Bits of ioring_s::flags set by the kernel */
+
+#define IORING_NEED_ENTER   (1 << 0)  /* The workers are idle: New
+                                       * submissions need IORINGIOC_ENTER */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A submission queue entry */
+
+struct ioring_sqe_s
+{
+  uint8_t  sqe_opcode;         /* IORING_OP_* */
+  int      sqe_fd;             /* The file or socket descriptor */
+  off_t    sqe_off;            /* The file offset, -1: current position */
+  FAR void *sqe_addr;          /* The buffer */
+  size_t   sqe_len;            /* The size of the buffer */
+  int      sqe_flags;          /* Flags of IORING_OP_SEND/RECV */
+  FAR void *sqe_userdata;      /* Returned in the completion entry */
+};
+
+/* A completion queue entry */
+
+struct ioring_cqe_s
+{
+  FAR void *cqe_userdata;      /* sqe_userdata of the request */
+  ssize_t   cqe_res;           /* The result or a negated errno value */
+};
+
+/* The ring shared by the application and the kernel.  'entries' is the
+ * size of both queues and must be a power of two.  The indexes run freely
+ * and are masked with (entries - 1).  The CQ never overflows: No more
+ * requests are started than there is room for their completions.
+ */
+
+struct ioring_s
+{
+  unsigned int entries;                 /* Number of SQ and CQ entries */
+  volatile unsigned int sq_head;        /* Advanced by the kernel */
+  volatile unsigned int sq_tail;        /* Advanced by the application */
+  volatile unsigned int cq_head;        /* Advanced by the application */
+  volatile unsigned int cq_tail;        /* Advanced by the kernel */
+  volatile unsigned int flags;          /* IORING_* flags */
+  FAR struct ioring_sqe_s *sqes;        /* The submission queue */
+  FAR struct ioring_cqe_s *cqes;        /* The completion queue */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ioring_register
+ *
+ * Description:
+ *   Register the I/O ring driver at 'path' (normally /dev/ioring)
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int ioring_register(FAR const char *path);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_IORING */
+#endif /* __INCLUDE_NUTTX_FS_IORING_H */
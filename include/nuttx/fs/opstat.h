@@ -0,0 +1,143 @@
+/****************************************************************************
+ * include/nuttx/fs/opstat.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_OPSTAT_H
+#define __INCLUDE_NUTTX_FS_OPSTAT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The VFS operations that are accounted for */
+
+#define FS_OPSTAT_OPEN      0   /* open() */
+#define FS_OPSTAT_CLOSE     1   /* close() */
+#define FS_OPSTAT_READ      2   /* read() of a file */
+#define FS_OPSTAT_WRITE     3   /* write() */
+#define FS_OPSTAT_SEEK      4   /* lseek() */
+#define FS_OPSTAT_FSYNC     5   /* fsync() */
+#define FS_OPSTAT_STAT      6   /* stat() */
+#define FS_OPSTAT_FSTAT     7   /* fstat() */
+#define FS_OPSTAT_READDIR   8   /* readdir(), i.e. read() of a directory */
+#define FS_OPSTAT_MKDIR     9   /* mkdir() */
+#define FS_OPSTAT_UNLINK    10  /* unlink() */
+#define FS_OPSTAT_RENAME    11  /* rename() */
+#define FS_OPSTAT_NOPS      12
+
+#ifdef CONFIG_FS_OPSTATS
+#  define fs_opstat_start() up_perf_gettime()
+#else
+#  define fs_opstat_start() 0
+#  define fs_opstat_record(op, start, ret) ((void)(start))
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The statistics of one operation.  The times are in the units of
+ * up_perf_gettime().
+ */
+
+struct fs_opstat_s
+{
+  uint32_t count;           /* Number of calls */
+  uint32_t errors;          /* Number of calls that failed */
+  uint64_t bytes;           /* Bytes transferred by READ and WRITE */
+  uint64_t time;            /* Total time spent in the calls */
+  uint32_t maxtime;         /* Longest single call */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_FS_OPSTATS
+
+/****************************************************************************
+ * Name: fs_opstat_record
+ *
+ * Description:
+ *   Account for one call of the operation 'op' that started at 'start'
+ *   (a value of fs_opstat_start()) and returned 'ret'.  A negative 'ret'
+ *   is an error; otherwise it is the number of bytes for READ and WRITE.
+ *
+ ****************************************************************************/
+
+void fs_opstat_record(int op, uint32_t start, ssize_t ret);
+
+/****************************************************************************
+ * Name: fs_opstat_get
+ *
+ * Description:
+ *   Return a consistent copy of the statistics of all FS_OPSTAT_NOPS
+ *   operations in 'stats'.
+ *
+ ****************************************************************************/
+
+void fs_opstat_get(FAR struct fs_opstat_s *stats);
+
+/****************************************************************************
+ * Name: fs_opstat_reset
+ *
+ * Description:
+ *   Clear the statistics of all operations.
+ *
+ ****************************************************************************/
+
+void fs_opstat_reset(void);
+
+/****************************************************************************
+ * Name: fs_opstat_name
+ *
+ * Description:
+ *   Return the name of the operation 'op'.
+ *
+ ****************************************************************************/
+
+FAR const char *fs_opstat_name(int op);
+
+#endif /* CONFIG_FS_OPSTATS */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_FS_OPSTAT_H */
@@ -144,6 +144,61 @@ struct procfs_meminfo_entry_s
 #endif
 };
 
+#ifdef CONFIG_FS_PROCFS_SNAPSHOT
+/* The binary layout of /proc/snapshot.  One read returns a header followed
+ * by 'nheaps' heap records and 'ntasks' task records, all taken at the
+ * same time when the file is opened.  Readers must step through the
+ * records with the sizes in the header, so that fields may be appended in
+ * later versions.  The heap and task names are NUL terminated.
+ */
+
+#define PROCFS_SNAPSHOT_VERSION  1
+#define PROCFS_SNAPSHOT_NAMELEN  16
+
+struct procfs_snapshot_s
+{
+  uint16_t version;             /* PROCFS_SNAPSHOT_VERSION */
+  uint16_t hdrsize;             /* sizeof(struct procfs_snapshot_s) */
+  uint16_t heapsize;            /* sizeof(struct procfs_snapshot_heap_s) */
+  uint16_t tasksize;            /* sizeof(struct procfs_snapshot_task_s) */
+  uint32_t nheaps;              /* Number of heap records */
+  uint32_t ntasks;              /* Number of task records */
+  uint32_t uptime;              /* System time in clock ticks */
+  uint32_t loadtotal;           /* CPU load interval, 0 if not available */
+  int32_t  iob_ntotal;          /* IOB statistics, 0 if not available */
+  int32_t  iob_nfree;
+  int32_t  iob_nwait;
+  int32_t  iob_nthrottle;
+};
+
+struct procfs_snapshot_heap_s
+{
+  char     name[PROCFS_SNAPSHOT_NAMELEN];
+  uint32_t total;               /* Size of the heap */
+  uint32_t used;                /* Bytes in use */
+  uint32_t free;                /* Free bytes */
+  uint32_t largest;             /* Largest free chunk */
+  uint32_t nused;               /* Number of allocated chunks */
+  uint32_t nfree;               /* Number of free chunks */
+};
+
+struct procfs_snapshot_task_s
+{
+  int32_t  pid;                 /* Thread ID */
+  int32_t  group;               /* Task group ID (PID of the main thread) */
+  uint8_t  state;               /* tstate_t */
+  uint8_t  priority;            /* Current priority */
+  uint8_t  cpu;                 /* CPU of a running thread */
+  uint8_t  pad;
+  uint16_t flags;               /* TCB_FLAG_* */
+  uint16_t pad2;
+  uint32_t stacksize;           /* Stack size */
+  uint32_t stackused;           /* Stack used, 0 if not available */
+  uint32_t loadactive;          /* Active ticks in the CPU load interval */
+  char     name[PROCFS_SNAPSHOT_NAMELEN];
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
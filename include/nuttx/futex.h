@@ -0,0 +1,101 @@
+/****************************************************************************
+ * include/nuttx/futex.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FUTEX_H
+#define __INCLUDE_NUTTX_FUTEX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: futex_wait
+ *
+ * Description:
+ *   Block the calling thread on the futex word at 'uaddr' if it still holds
+ *   the value 'val'.  The check and the blocking are atomic with respect to
+ *   futex_wake(), so a wake-up that follows a change of the word is never
+ *   lost.  The futex is identified by the address alone.  Callers must
+ *   tolerate spurious wake-ups and check the word again.
+ *
+ * Input Parameters:
+ *   uaddr   - The address of the futex word
+ *   val     - The value that the futex word is expected to hold
+ *   abstime - The absolute CLOCK_REALTIME time to wait until or NULL to
+ *             wait forever
+ *
+ * Returned Value:
+ *   Zero (OK) if woken up by futex_wake(), otherwise an errno value as the
+ *   pthread interfaces return it:
+ *
+ *   EAGAIN    - The futex word did not hold 'val'.
+ *   ETIMEDOUT - 'abstime' has passed.
+ *   EINTR     - A signal was received.
+ *   EINVAL    - An argument is not valid.
+ *
+ ****************************************************************************/
+
+int futex_wait(FAR volatile uint32_t *uaddr, uint32_t val,
+               FAR const struct timespec *abstime);
+
+/****************************************************************************
+ * Name: futex_wake
+ *
+ * Description:
+ *   Wake up to 'nwake' threads blocked on the futex word at 'uaddr', in the
+ *   order in which they started waiting.
+ *
+ * Input Parameters:
+ *   uaddr - The address of the futex word
+ *   nwake - The maximum number of threads to wake up
+ *
+ * Returned Value:
+ *   The number of threads woken up.
+ *
+ ****************************************************************************/
+
+int futex_wake(FAR volatile uint32_t *uaddr, int nwake);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
+#endif /* __INCLUDE_NUTTX_FUTEX_H */
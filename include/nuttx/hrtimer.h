@@ -0,0 +1,175 @@
+/****************************************************************************
+ * include/nuttx/hrtimer.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HRTIMER_H
+#define __INCLUDE_NUTTX_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/tree.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HRTIMER_ISACTIVE(h)  ((h)->active)
+
+/****************************************************************************
+ * Public Type Declarations
+ ****************************************************************************/
+
+/* How the time given to hrtimer_start() is interpreted */
+
+enum hrtimer_mode_e
+{
+  HRTIMER_MODE_ABS = 0,          /* Nanoseconds of hrtimer_gettime() */
+  HRTIMER_MODE_REL               /* Nanoseconds from now */
+};
+
+struct hrtimer_s;
+
+/* This is the form of the function that is called when the timer expires.
+ * It is called from the interrupt handler of the oneshot timer, in a
+ * critical section, and may restart the timer: A periodic timer restarts
+ * itself at hrtimer->expired plus its period, with HRTIMER_MODE_ABS, so
+ * that the period does not drift with the latency of the callbacks.
+ */
+
+typedef CODE void (*hrtimer_entry_t)(FAR struct hrtimer_s *hrtimer);
+
+struct hrtimer_s
+{
+  RB_ENTRY(hrtimer_s) node;      /* The tree of the active timers */
+  uint64_t            expired;   /* The expiration time, in nanoseconds */
+  hrtimer_entry_t     func;      /* The function to call on expiration */
+  FAR void           *arg;       /* The argument of the function */
+  bool                active;    /* The timer is in the tree */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: hrtimer_init
+ *
+ * Description:
+ *   Initialize a high-resolution timer.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer, allocated and owned by the caller
+ *   func    - The function to call when the timer expires
+ *   arg     - The argument for func, kept in hrtimer->arg
+ *
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer, hrtimer_entry_t func,
+                  FAR void *arg);
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start the timer, or restart it if it is active already.  The timers
+ *   are programmed in the oneshot lower half directly, and so expire with
+ *   its resolution rather than with the one of the system tick.  A time
+ *   already passed expires the timer at once.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer, initialized by hrtimer_init()
+ *   ns      - The expiration time, in nanoseconds
+ *   mode    - HRTIMER_MODE_ABS if ns is a time of hrtimer_gettime(), or
+ *             HRTIMER_MODE_REL if it is a delay from now
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler and from the callbacks.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t ns,
+                  enum hrtimer_mode_e mode);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Stop a timer before it expires.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the timer is not active.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the time of the oneshot lower half, in nanoseconds since it was
+ *   initialized.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void);
+
+/****************************************************************************
+ * Name: hrtimer_process
+ *
+ * Description:
+ *   Run the callbacks of the timers expired at the time 'now'.  Called by
+ *   the oneshot timer logic in a critical section.
+ *
+ * Returned Value:
+ *   The expiration time of the next timer, or UINT64_MAX if none is
+ *   active.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_process(uint64_t now);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_HRTIMER_H */
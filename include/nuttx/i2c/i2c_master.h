@@ -171,6 +171,36 @@
 #  define I2C_RESET(d) ((d)->ops->reset(d))
 #endif
 
+/****************************************************************************
+ * Name: I2C_TRANSFER_ASYNC
+ *
+ * Description:
+ *   Start a sequence of I2C transfers as I2C_TRANSFER() does, and return
+ *   without waiting for its completion.  The messages must stay valid
+ *   until the callback is called.  This is an optional method, used by
+ *   the queue of the bus (see i2c_queue_initialize()).
+ *
+ * Input Parameters:
+ *   dev      - Device-specific state data
+ *   msgs     - A pointer to a set of message descriptors
+ *   count    - The number of transfers to perform
+ *   callback - Called with 'arg' and the result of the transfers from the
+ *              interrupt handler of the lower half, when they complete.
+ *              It is not called if I2C_TRANSFER_ASYNC() fails.
+ *   arg      - The argument of the callback
+ *
+ * Returned Value:
+ *   Zero (OK) if the transfers were started; -ENOSYS if the lower half
+ *   does not support them; any other negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2C_ASYNC
+#  define I2C_TRANSFER_ASYNC(d,m,c,f,a) \
+  (((d)->ops->transfer_async) ? \
+   ((d)->ops->transfer_async(d,m,c,f,a)) : -ENOSYS)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -179,6 +209,10 @@
 
 struct i2c_master_s;
 struct i2c_msg_s;
+
+#ifdef CONFIG_I2C_ASYNC
+typedef CODE void (*i2c_callback_t)(FAR void *arg, int result);
+#endif
 struct i2c_ops_s
 {
   CODE int (*transfer)(FAR struct i2c_master_s *dev,
@@ -186,6 +220,11 @@ struct i2c_ops_s
 #ifdef CONFIG_I2C_RESET
   CODE int (*reset)(FAR struct i2c_master_s *dev);
 #endif
+#ifdef CONFIG_I2C_ASYNC
+  CODE int (*transfer_async)(FAR struct i2c_master_s *dev,
+                             FAR struct i2c_msg_s *msgs, int count,
+                             i2c_callback_t callback, FAR void *arg);
+#endif
 };
 
 /* This structure contains the full state of I2C as needed for a specific
@@ -234,6 +273,29 @@ struct i2c_transfer_s
   size_t msgc;                /* Number of messages in the array. */
 };
 
+#ifdef CONFIG_I2C_QUEUE
+/* A sequence of I2C transfers queued with i2c_queue_submit().  The
+ * request and its messages belong to the queue until 'done' is called
+ * with the result of the transfers.
+ */
+
+struct i2c_request_s;
+typedef CODE void (*i2c_reqdone_t)(FAR struct i2c_request_s *req,
+                                   int result);
+
+struct i2c_request_s
+{
+  FAR struct i2c_request_s *flink; /* Used by the queue */
+  FAR struct i2c_msg_s *msgv;      /* Array of I2C messages */
+  int msgc;                        /* Number of messages in the array */
+  uint8_t priority;                /* Higher priorities run first */
+  i2c_reqdone_t done;              /* Called when the transfers complete */
+  FAR void *arg;                   /* For the use of 'done' */
+};
+
+struct i2c_queue_s;                /* Opaque, one for each I2C bus */
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -347,6 +409,75 @@ int i2c_read(FAR struct i2c_master_s *dev,
              FAR const struct i2c_config_s *config,
              FAR uint8_t *buffer, int buflen);
 
+#ifdef CONFIG_I2C_QUEUE
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Create the queue of an I2C bus.  If the lower half supports
+ *   I2C_TRANSFER_ASYNC(), the requests run back-to-back from its interrupt
+ *   handler and their callbacks are called there.  Otherwise the queue
+ *   starts a thread that runs them with I2C_TRANSFER() and calls their
+ *   callbacks.  Either way, the callbacks must not block.
+ *
+ * Input Parameters:
+ *   i2c - An instance of the lower half I2C driver
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct i2c_queue_s *i2c_queue_initialize(FAR struct i2c_master_s *i2c);
+
+/****************************************************************************
+ * Name: i2c_queue_uninitialize
+ *
+ * Description:
+ *   Wait for the request in progress and free the queue.  The requests
+ *   still queued are completed with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void i2c_queue_uninitialize(FAR struct i2c_queue_s *queue);
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Queue a request by priority, after the requests of the same priority,
+ *   and return without waiting for it.  This may be called from an
+ *   interrupt handler or from the callback of another request.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request, with its msgv, msgc, priority and done set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request that is not started yet from the queue.  Its done
+ *   callback is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -EBUSY if it is not in the queue
+ *   any longer.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -44,6 +44,27 @@
 #define OSINIT_IDLELOOP()        (g_nx_initstate >= OSINIT_IDLELOOP)
 #define OSINIT_OS_INITIALIZING() (g_nx_initstate  < OSINIT_OSREADY)
 
+/* Run one step of the boot sequence, recording it in the boot profile */
+
+#ifdef CONFIG_BOOT_PROFILE
+#  define NX_BOOT_PROFILE(name, call) \
+     do \
+       { \
+         int stage_ = nx_boot_begin(name); \
+         call; \
+         nx_boot_end(stage_, OK); \
+       } \
+     while (0)
+#else
+#  define NX_BOOT_PROFILE(name, call) call
+#  define nx_boot_begin(name)         (-1)
+#  define nx_boot_end(stage, result)
+#endif
+
+/* The largest number of stages that nx_boot_run() can order */
+
+#define BOOT_STAGES_MAX          32
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -71,6 +92,32 @@ enum nx_initstate_e
   OSINIT_IDLELOOP  = 6   /* The OS enter idle loop */
 };
 
+/* One stage of the initialization run by nx_boot_run().  'depends' is the
+ * bit mask of the indices of the stages in the same array that must be
+ * complete before this one starts.
+ */
+
+struct boot_stage_s
+{
+  FAR const char *name;                /* Name of the stage in the profile */
+  CODE int (*init)(FAR void *arg);     /* Returns OK or a negated errno */
+  FAR void *arg;                       /* The argument of init() */
+  uint32_t depends;                    /* Stages that must complete first */
+};
+
+/* One record of the boot profile.  The times are in microseconds since
+ * power up.
+ */
+
+struct boot_record_s
+{
+  FAR const char *name;                /* Name of the stage */
+  uint32_t start;                      /* The stage started */
+  uint32_t end;                        /* The stage completed */
+  int16_t result;                      /* OK or a negated errno */
+  uint8_t cpu;                         /* The CPU that ran the stage */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -104,6 +151,81 @@ int CONFIG_INIT_ENTRYPOINT(int argc, char *argv[]);
 
 void nx_start(void) noreturn_function;
 
+/* Functions contained in nx_bootstage.c ************************************/
+
+#ifdef CONFIG_BOOT_PROFILE
+
+/****************************************************************************
+ * Name: nx_boot_begin
+ *
+ * Description:
+ *   Record the start of a stage of the boot sequence in the boot profile
+ *   and in the note driver.
+ *
+ * Input Parameters:
+ *   name - The name of the stage, which must stay valid after the boot
+ *
+ * Returned Value:
+ *   The index of the record, to be passed to nx_boot_end(); -1 if the
+ *   profile is full.
+ *
+ ****************************************************************************/
+
+int nx_boot_begin(FAR const char *name);
+
+/****************************************************************************
+ * Name: nx_boot_end
+ *
+ * Description:
+ *   Record the end of the stage started by nx_boot_begin().
+ *
+ ****************************************************************************/
+
+void nx_boot_end(int stage, int result);
+
+/****************************************************************************
+ * Name: nx_boot_profile
+ *
+ * Description:
+ *   Copy the boot profile, in the order in which the stages started.
+ *
+ * Returned Value:
+ *   The number of records copied.
+ *
+ ****************************************************************************/
+
+int nx_boot_profile(FAR struct boot_record_s *records, int nrecords);
+#endif
+
+#ifdef CONFIG_BOOT_PARALLEL
+
+/****************************************************************************
+ * Name: nx_boot_run
+ *
+ * Description:
+ *   Run the stages of an initialization as soon as the stages they depend
+ *   on are complete, on up to CONFIG_BOOT_PARALLEL_NTHREADS kernel threads
+ *   and on the caller, which returns when all of them are done.  This lets
+ *   the slow, independent probes of a board, such as the detection of an
+ *   SD card or the negotiation of an Ethernet PHY, overlap.  The stages
+ *   that depend on a stage that failed are skipped with -ECANCELED.
+ *
+ *   Before the OS is ready, the stages all run on the caller, in the order
+ *   of their dependencies.
+ *
+ * Input Parameters:
+ *   stages  - The stages
+ *   nstages - The number of stages, up to BOOT_STAGES_MAX
+ *
+ * Returned Value:
+ *   Zero (OK) if all of the stages succeeded; otherwise the result of the
+ *   first one of the array that failed.
+ *
+ ****************************************************************************/
+
+int nx_boot_run(FAR const struct boot_stage_s *stages, int nstages);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
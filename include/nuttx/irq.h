@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #ifndef __ASSEMBLY__
+# include <sys/types.h>
 # include <stdint.h>
 # include <stdbool.h>
 #endif
@@ -48,6 +49,12 @@
 
 #  define irq_detach(irq) irq_attach(irq, NULL, NULL)
 
+/* The top half of a threaded interrupt handler returns IRQ_WAKE_THREAD to
+ * run the bottom half on the IRQ thread.
+ */
+
+#  define IRQ_WAKE_THREAD 1
+
 /* Maximum/minimum values of IRQ integer types */
 
 #  if NR_IRQS <= 256
@@ -154,6 +161,32 @@ int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
 #  define irqchain_detach(irq, isr, arg) irq_detach(irq)
 #endif
 
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Configure the IRQ subsystem so that IRQ number 'irq' is handled by a
+ *   threaded interrupt handler:  The top half 'isr' runs in interrupt
+ *   context and should do no more than quiesce the interrupt source.  If
+ *   it returns IRQ_WAKE_THREAD (or if 'isr' is NULL), the bottom half
+ *   'isrthread' is run with the same 'arg' on a dedicated kernel thread
+ *   with the given priority, stack size and, in SMP builds, CPU affinity
+ *   (zero means any CPU).  The context argument of the bottom half is
+ *   NULL.
+ *
+ *   Attaching again replaces the handlers and thread of the IRQ.  Passing
+ *   a NULL 'isrthread' detaches the IRQ and deletes its thread.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IRQ_THREAD
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size, cpu_set_t affinity);
+#endif
+
 /****************************************************************************
  * Name: enter_critical_section
  *
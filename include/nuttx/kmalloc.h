@@ -93,6 +93,11 @@ extern "C"
 
 #  define kmm_calloc(n,s)        calloc(n,s)
 #  define kmm_malloc(s)          malloc(s)
+#  if defined(CONFIG_MM_REGION_ATTR) && defined(CONFIG_BUILD_FLAT)
+#    define kmm_malloc_flags(s,f) mm_malloc_flags(g_mmheap,s,f)
+#  else
+#    define kmm_malloc_flags(s,f) malloc(s)
+#  endif
 #  define kmm_malloc_size(p)     malloc_size(p)
 #  define kmm_zalloc(s)          zalloc(s)
 #  define kmm_realloc(p,s)       realloc(p,s)
@@ -108,6 +113,13 @@ extern "C"
 
 #endif
 
+/* Allocations with a preference for the fast or the slow memory regions,
+ * see CONFIG_MM_REGION_ATTR.  Both fall back to any memory.
+ */
+
+#define kmm_malloc_fast(s)       kmm_malloc_flags(s, MM_ALLOC_FAST)
+#define kmm_malloc_slow(s)       kmm_malloc_flags(s, MM_ALLOC_SLOW)
+
 #ifdef CONFIG_MM_KERNEL_HEAP
 /****************************************************************************
  * Group memory management
@@ -0,0 +1,65 @@
+/****************************************************************************
+ * include/nuttx/lib/math_vector.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LIB_MATH_VECTOR_H
+#define __INCLUDE_NUTTX_LIB_MATH_VECTOR_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+#ifdef CONFIG_LIBM_VECTOR
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* dst[i] = f(src[i]) for i < n, with the accuracy of the CONFIG_LIBM_FASTF
+ * functions.  dst may be the same array as src.  The loops run through
+ * branchless versions of the functions, which the compilers vectorize for
+ * NEON, Helium or the RISC-V V extension, and only the special arguments,
+ * as the NaNs, the infinities or the large arguments of sinf() and cosf(),
+ * take the scalar path.
+ */
+
+void vexpf(FAR float *dst, FAR const float *src, size_t n);
+void vlogf(FAR float *dst, FAR const float *src, size_t n);
+void vsinf(FAR float *dst, FAR const float *src, size_t n);
+void vcosf(FAR float *dst, FAR const float *src, size_t n);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_LIBM_VECTOR */
+#endif /* __INCLUDE_NUTTX_LIB_MATH_VECTOR_H */
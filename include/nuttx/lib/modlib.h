@@ -192,6 +192,10 @@ struct mod_loadinfo_s
 
   uintptr_t         textalloc;   /* .text memory allocated when module was loaded */
   uintptr_t         datastart;   /* Start of.bss/.data memory in .text allocation */
+  uintptr_t         textstart;   /* Address of the first .text section */
+#ifdef CONFIG_MODLIB_XIP
+  uintptr_t         xipbase;     /* Address of the file in memory, or zero */
+#endif
   size_t            textsize;    /* Size of the module .text memory allocation */
   size_t            datasize;    /* Size of the module .bss/.data memory allocation */
   size_t            textalign;   /* Necessary alignment of .text */
@@ -200,6 +204,9 @@ struct mod_loadinfo_s
   Elf_Ehdr          ehdr;        /* Buffered module file header */
   FAR Elf_Shdr     *shdr;        /* Buffered module section headers */
   uint8_t          *iobuffer;    /* File I/O buffer */
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+  FAR char         *strtab;      /* Cached symbol string table */
+#endif
 
   uint16_t          symtabidx;   /* Symbol table section index */
   uint16_t          strtabidx;   /* String table section index */
@@ -26,6 +26,8 @@
  * For multiple writer and one reader there is only a need to lock the
  * writer. And vice versa for only one writer and multiple reader there is
  * only a need to lock the reader.
+ * When the reader and the writer run on different CPUs, enable
+ * CONFIG_MM_CIRCBUF_SPSC to order the accesses to the head and the tail.
  */
 
 /****************************************************************************
@@ -34,6 +36,7 @@
 
 #include <stdbool.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 /****************************************************************************
  * Public Types
@@ -337,6 +340,74 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
                            FAR const void *src, size_t bytes);
 
+/****************************************************************************
+ * Name: circbuf_reserve
+ *
+ * Description:
+ *   Get the free space of the circular buffer so that the writer can fill
+ *   it in place, e.g. by DMA, instead of copying through circbuf_write().
+ *   The space is returned as two segments, the second one is only used
+ *   when the space wraps around the end of the buffer.  The data becomes
+ *   visible to the reader with circbuf_commit().
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   iov   - Array of two segments receiving the free space.
+ *
+ * Returned Value:
+ *   The total number of free bytes in the two segments.
+ ****************************************************************************/
+
+size_t circbuf_reserve(FAR struct circbuf_s *circ, FAR struct iovec *iov);
+
+/****************************************************************************
+ * Name: circbuf_commit
+ *
+ * Description:
+ *   Add 'bytes' of data written into the space obtained by
+ *   circbuf_reserve() to the circular buffer.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   bytes - Number of bytes written, at most the reserved space.
+ ****************************************************************************/
+
+void circbuf_commit(FAR struct circbuf_s *circ, size_t bytes);
+
+/****************************************************************************
+ * Name: circbuf_acquire
+ *
+ * Description:
+ *   Get the data of the circular buffer so that the reader can process it
+ *   in place instead of copying it out through circbuf_read().  The data
+ *   is returned as two segments, the second one is only used when the data
+ *   wraps around the end of the buffer.  The space is given back to the
+ *   writer with circbuf_release().
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   iov   - Array of two segments receiving the data.
+ *
+ * Returned Value:
+ *   The total number of bytes of data in the two segments.
+ ****************************************************************************/
+
+size_t circbuf_acquire(FAR struct circbuf_s *circ, FAR struct iovec *iov);
+
+/****************************************************************************
+ * Name: circbuf_release
+ *
+ * Description:
+ *   Remove 'bytes' of data obtained by circbuf_acquire() from the circular
+ *   buffer.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   bytes - Number of bytes consumed, at most the acquired data.
+ ****************************************************************************/
+
+void circbuf_release(FAR struct circbuf_s *circ, size_t bytes);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
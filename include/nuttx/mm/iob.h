@@ -70,6 +70,12 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* The jumbo I/O buffers must be larger than the normal ones */
+
+#if defined(CONFIG_IOB_JUMBO) && CONFIG_IOB_JUMBO_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#  error CONFIG_IOB_JUMBO_BUFSIZE <= CONFIG_IOB_BUFSIZE
+#endif
+
 /* Default config of alignment and head padding size */
 
 #if !defined(CONFIG_IOB_ALIGNMENT)
@@ -88,8 +94,14 @@
 
 /* IOB helpers */
 
+#ifdef CONFIG_IOB_JUMBO
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -105,6 +117,10 @@
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
+ *
+ * The I/O buffers of the jumbo pool (CONFIG_IOB_JUMBO) use the same
+ * structure, but their io_data extends to CONFIG_IOB_JUMBO_BUFSIZE bytes.
+ * Use IOB_BUFSIZE() to get the size of the data area of an I/O buffer.
  */
 
 struct iob_s
@@ -115,12 +131,15 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if CONFIG_IOB_BUFSIZE < 256 && !defined(CONFIG_IOB_JUMBO)
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
   uint16_t io_len;      /* Length of the data in the entry */
   uint16_t io_offset;   /* Data begins at this offset */
+#endif
+#ifdef CONFIG_IOB_JUMBO
+  uint16_t io_bufsize;  /* Size of io_data, see IOB_BUFSIZE() */
 #endif
   unsigned int io_pktlen; /* Total length of the packet */
 
@@ -216,6 +235,83 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data.  If 'len' does not fit
+ *   into a normal I/O buffer, a buffer of the jumbo pool is taken when one
+ *   is free so that the data needs a shorter chain.  Otherwise this is the
+ *   same as iob_alloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_len(bool throttled, unsigned int len);
+
+/****************************************************************************
+ * Name: iob_tryalloc_len
+ *
+ * Description:
+ *   Same as iob_alloc_len() but without waiting for a buffer to become
+ *   free, i.e. the same as iob_tryalloc() when no jumbo buffer is taken.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_len(bool throttled, unsigned int len);
+
+/****************************************************************************
+ * Name: iob_tryalloc_jumbo
+ *
+ * Description:
+ *   Try to allocate an I/O buffer of CONFIG_IOB_JUMBO_BUFSIZE bytes from
+ *   the jumbo pool.  The jumbo pool is not throttled and it is never
+ *   waited for.  The buffer is freed with the normal IOB functions.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_JUMBO
+FAR struct iob_s *iob_tryalloc_jumbo(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Try to allocate a chain of 'n' I/O buffers, linked through io_flink,
+ *   without waiting.  The buffers are taken in a single critical section.
+ *   Either all buffers are allocated or none.
+ *
+ * Input Parameters:
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *   n         - The number of I/O buffers in the chain.
+ *
+ * Returned Value:
+ *   The head of the chain, or NULL if fewer than 'n' buffers are free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(bool throttled, unsigned int n);
+
+/****************************************************************************
+ * Name: iob_alloc_chain
+ *
+ * Description:
+ *   Allocate a chain of 'n' I/O buffers, linked through io_flink.  If the
+ *   chain cannot be taken at once, the buffers are allocated one by one,
+ *   waiting for each buffer to become free when not called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   throttled - An indication of the IOB allocation is "throttled"
+ *   n         - The number of I/O buffers in the chain.
+ *
+ * Returned Value:
+ *   The head of the chain, or NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_chain(bool throttled, unsigned int n);
+
 /****************************************************************************
  * Name: iob_navail
  *
@@ -305,7 +401,7 @@ void iob_notifier_teardown(int key);
  *
  * Description:
  *   Free an entire buffer chain, starting at the beginning of the I/O
- *   buffer chain
+ *   buffer chain.  The buffers are returned in a single critical section.
  *
  ****************************************************************************/
 
@@ -0,0 +1,290 @@
+//***************************************************************************
+// include/nuttx/mm/memory_resource.hxx
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+#ifndef __INCLUDE_NUTTX_MM_MEMORY_RESOURCE_HXX
+#define __INCLUDE_NUTTX_MM_MEMORY_RESOURCE_HXX
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<memory_resource>)
+#  include <memory_resource>
+#else
+#  include <experimental/memory_resource>
+#endif
+
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
+
+//***************************************************************************
+// Namespace
+//***************************************************************************
+
+// Memory resources that let the polymorphic allocators of the C++ library
+// allocate from a NuttX memory pool, from a separate heap created with
+// mm_initialize(), or from a buffer of the caller, instead of from the
+// shared heap.  The pool and heap resources are thread safe, as pools and
+// heaps are; the arena resource is not.
+
+namespace nuttx
+{
+#if __has_include(<memory_resource>)
+  namespace pmr = std::pmr;
+#else
+  namespace pmr = std::experimental::pmr;
+#endif
+
+  namespace detail
+  {
+    // Report an allocation failure the way operator new would
+
+    [[noreturn]] inline void throw_bad_alloc()
+    {
+#ifdef __cpp_exceptions
+      throw std::bad_alloc();
+#else
+      std::abort();
+#endif
+    }
+  }
+
+  //*************************************************************************
+  // Name: mempool_resource
+  //
+  // Description:
+  //   Allocate the blocks that fit in the blocks of a memory pool from the
+  //   pool and the others from the upstream resource.  The pool must be
+  //   initialized with mempool_init() and outlive the resource.
+  //
+  //*************************************************************************
+
+  class mempool_resource : public pmr::memory_resource
+  {
+  public:
+    explicit mempool_resource(FAR struct mempool_s *pool,
+                              FAR pmr::memory_resource *upstream =
+                                pmr::get_default_resource())
+      : m_pool(pool), m_upstream(upstream)
+    {
+    }
+
+    FAR pmr::memory_resource *upstream_resource() const
+    {
+      return m_upstream;
+    }
+
+  protected:
+    FAR void *do_allocate(std::size_t bytes, std::size_t align) override
+    {
+      if (fits(bytes, align))
+        {
+          FAR void *blk = mempool_alloc(m_pool);
+
+          if (blk != NULL)
+            {
+              return blk;
+            }
+
+          detail::throw_bad_alloc();
+        }
+
+      return m_upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(FAR void *ptr, std::size_t bytes,
+                       std::size_t align) override
+    {
+      if (fits(bytes, align))
+        {
+          mempool_free(m_pool, ptr);
+        }
+      else
+        {
+          m_upstream->deallocate(ptr, bytes, align);
+        }
+    }
+
+    bool do_is_equal(const pmr::memory_resource &other)
+      const noexcept override
+    {
+      return this == &other;
+    }
+
+  private:
+    // The blocks follow a pointer in memory chunks of the heap, so they
+    // are aligned on a pointer at most.
+
+    bool fits(std::size_t bytes, std::size_t align) const
+    {
+      std::size_t blkalign = m_pool->bsize & -m_pool->bsize;
+
+      if (blkalign > sizeof(FAR void *))
+        {
+          blkalign = sizeof(FAR void *);
+        }
+
+      return bytes <= m_pool->bsize && align <= blkalign;
+    }
+
+    FAR struct mempool_s *m_pool;
+    FAR pmr::memory_resource *m_upstream;
+  };
+
+  //*************************************************************************
+  // Name: heap_resource
+  //
+  // Description:
+  //   Allocate from a heap created with mm_initialize(), which must
+  //   outlive the resource.
+  //
+  //*************************************************************************
+
+  class heap_resource : public pmr::memory_resource
+  {
+  public:
+    explicit heap_resource(FAR struct mm_heap_s *heap)
+      : m_heap(heap)
+    {
+    }
+
+    FAR struct mm_heap_s *heap() const
+    {
+      return m_heap;
+    }
+
+  protected:
+    FAR void *do_allocate(std::size_t bytes, std::size_t align) override
+    {
+      FAR void *ptr = align <= alignof(std::max_align_t) ?
+                      mm_malloc(m_heap, bytes) :
+                      mm_memalign(m_heap, align, bytes);
+
+      if (ptr == NULL)
+        {
+          detail::throw_bad_alloc();
+        }
+
+      return ptr;
+    }
+
+    void do_deallocate(FAR void *ptr, std::size_t bytes,
+                       std::size_t align) override
+    {
+      mm_free(m_heap, ptr);
+    }
+
+    bool do_is_equal(const pmr::memory_resource &other)
+      const noexcept override
+    {
+      return this == &other;
+    }
+
+  private:
+    FAR struct mm_heap_s *m_heap;
+  };
+
+  //*************************************************************************
+  // Name: arena_resource
+  //
+  // Description:
+  //   Allocate from a buffer of the caller by bumping a pointer, without
+  //   ever releasing memory until release() or the destruction of the
+  //   resource.  When the buffer is used up, the allocations go to the
+  //   upstream resource, which fails them by default, so that a latency
+  //   critical path never falls back to a heap by surprise.
+  //
+  //*************************************************************************
+
+  class arena_resource : public pmr::memory_resource
+  {
+  public:
+    arena_resource(FAR void *buffer, std::size_t size,
+                   FAR pmr::memory_resource *upstream =
+                     pmr::null_memory_resource())
+      : m_base((FAR uint8_t *)buffer), m_size(size), m_used(0),
+        m_upstream(upstream)
+    {
+    }
+
+    arena_resource(const arena_resource &) = delete;
+    arena_resource &operator=(const arena_resource &) = delete;
+
+    // Make all of the buffer available again.  This invalidates all the
+    // allocations from the buffer.
+
+    void release()
+    {
+      m_used = 0;
+    }
+
+    std::size_t used() const
+    {
+      return m_used;
+    }
+
+  protected:
+    FAR void *do_allocate(std::size_t bytes, std::size_t align) override
+    {
+      uintptr_t start = (uintptr_t)m_base + m_used;
+      std::size_t pad = (align - (start & (align - 1))) & (align - 1);
+
+      if (pad <= m_size - m_used && bytes <= m_size - m_used - pad)
+        {
+          m_used += pad + bytes;
+          return (FAR void *)(start + pad);
+        }
+
+      return m_upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(FAR void *ptr, std::size_t bytes,
+                       std::size_t align) override
+    {
+      // The memory of the buffer is only released by release()
+
+      if ((uintptr_t)ptr - (uintptr_t)m_base >= m_size)
+        {
+          m_upstream->deallocate(ptr, bytes, align);
+        }
+    }
+
+    bool do_is_equal(const pmr::memory_resource &other)
+      const noexcept override
+    {
+      return this == &other;
+    }
+
+  private:
+    FAR uint8_t *m_base;
+    std::size_t m_size;
+    std::size_t m_used;
+    FAR pmr::memory_resource *m_upstream;
+  };
+}
+
+#endif // __INCLUDE_NUTTX_MM_MEMORY_RESOURCE_HXX
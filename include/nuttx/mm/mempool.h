@@ -44,6 +44,26 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+struct mempool_s;
+typedef CODE FAR void *(*mempool_alloc_t)(FAR struct mempool_s *pool,
+                                          size_t size);
+typedef CODE void (*mempool_free_t)(FAR struct mempool_s *pool,
+                                    FAR void *addr);
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+/* This structure describes the cache of free blocks owned by one CPU.  It
+ * is only accessed by its CPU with the local interrupts disabled.
+ */
+
+struct mempool_magazine_s
+{
+  FAR sq_entry_t *blks[CONFIG_MM_MEMPOOL_MAGAZINE_SIZE];
+  size_t          count;   /* The number of cached blocks */
+  size_t          nhits;   /* The number of allocations from the cache */
+  size_t          nmisses; /* The number of allocations missed the cache */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -61,6 +81,55 @@ struct mempool_s
   size_t     nused;      /* The number of used block in mempool */
   spinlock_t lock;       /* The protect lock to mempool */
   sem_t      wait;       /* The semaphore of waiter get free block */
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  /* The per-CPU caches of free blocks, the blocks in them are counted in
+   * nused.
+   */
+
+  struct mempool_magazine_s mag[CONFIG_SMP_NCPUS];
+#endif
+
+  /* The optional hooks to get and release the memory of the pool, they
+   * default to kmm_malloc and kmm_free if NULL.  The caller must set them
+   * (and priv) before mempool_init.
+   */
+
+  mempool_alloc_t alloc; /* Get memory for the initial and expand blocks */
+  mempool_free_t  free;  /* Release memory got by alloc */
+  FAR void       *priv;  /* The private data of the alloc/free hooks */
+};
+
+/* This structure describes a set of memory pools of different block sizes,
+ * which serves the small allocations of a heap.
+ */
+
+typedef CODE FAR void *(*mempool_multiple_alloc_t)(FAR void *arg,
+                                                   size_t alignment,
+                                                   size_t size);
+typedef CODE void (*mempool_multiple_free_t)(FAR void *arg, FAR void *addr);
+
+struct mempool_multiple_chunk_s
+{
+  uintptr_t             addr; /* The base address of the expand chunk */
+  FAR struct mempool_s *pool; /* The pool owns the chunk */
+};
+
+struct mempool_multiple_s
+{
+  FAR struct mempool_s    *pools;      /* The memory pools, sorted by bsize */
+  size_t                   npools;     /* The number of memory pools */
+  size_t                   expandsize; /* The size of every expand chunk */
+  mempool_multiple_alloc_t alloc;      /* Get memory from the backing heap */
+  mempool_multiple_free_t  free;       /* Release memory to the backing heap */
+  FAR void                *arg;        /* The argument of alloc/free */
+
+  /* The hash table to map an expand chunk to the pool owns it */
+
+  FAR struct mempool_multiple_chunk_s *chunks;
+  size_t                   nchunks;    /* The number of used entries */
+  size_t                   maxchunks;  /* The number of entries */
+  spinlock_t               lock;       /* The protect lock of the table */
 };
 
 struct mempoolinfo_s
@@ -71,6 +140,11 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  unsigned long ncached;  /* This is the number of blocks in the magazines */
+  unsigned long nhits;    /* This is the number of magazine hits */
+  unsigned long nmisses;  /* This is the number of magazine misses */
+#endif
 };
 
 /****************************************************************************
@@ -204,6 +278,153 @@ void mempool_procfs_register(FAR struct mempool_procfs_entry_s *entry,
 void mempool_procfs_unregister(FAR struct mempool_procfs_entry_s *entry);
 #endif
 
+/****************************************************************************
+ * Name: mempool_multiple_init
+ *
+ * Description:
+ *   Initialize a set of memory pools.  Every pool gets its blocks from
+ *   chunks of expandsize bytes, aligned to expandsize, so the owner of a
+ *   block can be found from its address alone.
+ *
+ * Input Parameters:
+ *   mpool      - Address of the memory pools to be used.
+ *   name       - The name of memory pools.
+ *   bsizes     - The block sizes of the pools, in ascending order.
+ *   npools     - The number of the pools.
+ *   alloc      - The function to get memory from the backing heap.
+ *   free       - The function to release memory to the backing heap.
+ *   arg        - The argument of alloc and free.
+ *   expandsize - The size of every expand chunk, must be a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_init(FAR struct mempool_multiple_s *mpool,
+                          FAR const char *name,
+                          FAR const size_t *bsizes, size_t npools,
+                          mempool_multiple_alloc_t alloc,
+                          mempool_multiple_free_t free, FAR void *arg,
+                          size_t expandsize);
+
+/****************************************************************************
+ * Name: mempool_multiple_alloc
+ *
+ * Description:
+ *   Allocate a block from the smallest pool of the set that fits size.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   size  - The size of the block.
+ *
+ * Returned Value:
+ *   The pointer to the allocated block on success; NULL if size is too
+ *   large for the pools or on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_multiple_alloc(FAR struct mempool_multiple_s *mpool,
+                                 size_t size);
+
+/****************************************************************************
+ * Name: mempool_multiple_realloc
+ *
+ * Description:
+ *   Change the size of a block allocated by mempool_multiple_alloc.  The
+ *   new block is taken from the backing heap if size is too large for the
+ *   pools.
+ *
+ * Input Parameters:
+ *   mpool  - Address of the memory pools to be used.
+ *   oldblk - The pointer of the block owned by the pools.
+ *   size   - The new size of the block.
+ *
+ * Returned Value:
+ *   The pointer to the block on success; NULL on any failure, and the old
+ *   block is kept.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_multiple_realloc(FAR struct mempool_multiple_s *mpool,
+                                   FAR void *oldblk, size_t size);
+
+/****************************************************************************
+ * Name: mempool_multiple_free
+ *
+ * Description:
+ *   Release a block to the pool of the set that owns it.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   blk   - The pointer of memory block.
+ *
+ * Returned Value:
+ *   Zero on success; -EINVAL if blk isn't owned by the pools.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_free(FAR struct mempool_multiple_s *mpool,
+                          FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_multiple_alloc_size
+ *
+ * Description:
+ *   Get the usable size of a block owned by the pools.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   blk   - The pointer of memory block.
+ *
+ * Returned Value:
+ *   The block size on success; -EINVAL if blk isn't owned by the pools.
+ *
+ ****************************************************************************/
+
+ssize_t mempool_multiple_alloc_size(FAR struct mempool_multiple_s *mpool,
+                                    FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_multiple_deinit
+ *
+ * Description:
+ *   Deallocate a set of memory pools.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if any block is still in use.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_deinit(FAR struct mempool_multiple_s *mpool);
+
+/****************************************************************************
+ * Name: mempool_multiple_heap_init
+ *
+ * Description:
+ *   Initialize the pools in front of the small allocations of a heap, as
+ *   configured by CONFIG_MM_HEAP_MEMPOOL_xxx.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   heap  - The heap that backs the pools.
+ *   name  - The name of memory pools.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+struct mm_heap_s;
+int mempool_multiple_heap_init(FAR struct mempool_multiple_s *mpool,
+                               FAR struct mm_heap_s *heap,
+                               FAR const char *name);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -29,6 +29,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -92,12 +93,95 @@
 #  undef CONFIG_MM_KERNEL_HEAP
 #endif
 
+/* Region attributes, see mm_region_setattr() */
+
+#define MM_REGION_FAST       (1 << 0)  /* Fast memory, e.g. internal SRAM */
+
+/* Allocation flags, see mm_malloc_flags() */
+
+#define MM_ALLOC_FAST        (1 << 0)  /* Prefer the MM_REGION_FAST regions */
+#define MM_ALLOC_SLOW        (1 << 1)  /* Prefer the other regions */
+#define MM_ALLOC_NOFALLBACK  (1 << 2)  /* Don't use the other regions */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
 struct mm_heap_s; /* Forward reference */
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* This describes the state of the per-CPU chunk caches of one heap */
+
+struct mm_percpuinfo_s
+{
+  size_t nhits;      /* Allocations satisfied from the caches */
+  size_t nmisses;    /* Cacheable allocations that went to the heap */
+  size_t ndrains;    /* Batches drained back to the heap */
+  size_t ncached;    /* Number of chunks currently held in the caches */
+  size_t cachedsize; /* Total size of the cached chunks */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+/* The maximum number of size classes in the heap histograms.  Class n
+ * holds the chunks of size [2^(minshift + n), 2^(minshift + n + 1)), the
+ * last class also holds all larger chunks.
+ */
+
+#define MM_STATS_NCLASSES 32
+
+/* This describes the allocation statistics of one heap */
+
+struct mm_statsinfo_s
+{
+  size_t nmallocs;                    /* Successful allocations */
+  size_t nfrees;                      /* Frees */
+  size_t nfailed;                     /* Failed heap searches */
+  size_t usedsize;                    /* Current size of allocated chunks */
+  size_t peaksize;                    /* Peak size of allocated chunks */
+  int    minshift;                    /* log2 of the size of class 0 */
+  int    nclasses;                    /* Number of valid size classes */
+  size_t nalloc[MM_STATS_NCLASSES];   /* Allocations per size class */
+  size_t nfree[MM_STATS_NCLASSES];    /* Free chunks per size class */
+  size_t freesize[MM_STATS_NCLASSES]; /* Size of the free chunks per class */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+/* The sampling heap profiler reports through the note driver, as
+ * NOTE_DUMP_BINARY notes with these event numbers.  The payload follows
+ * the layouts below, the alloc backtrace is cut after the last non-NULL
+ * entry.
+ */
+
+#define MM_PROFILE_NOTE_ALLOC 0xa0
+#define MM_PROFILE_NOTE_FREE  0xa1
+
+struct mm_profile_alloc_s
+{
+  uint32_t  id;                                      /* Sample number */
+  uint32_t  size;                                    /* Requested size */
+  uintptr_t addr;                                    /* Allocated memory */
+  FAR void *backtrace[CONFIG_MM_HEAP_PROFILE_DEPTH]; /* Allocation site */
+};
+
+struct mm_profile_free_s
+{
+  uint32_t  id;                                   /* Sample number */
+  uint32_t  lifetime;                             /* Lifetime in ticks */
+  uintptr_t addr;                                 /* Freed memory */
+};
+
+/* This describes the state of the heap profiler of one heap */
+
+struct mm_profileinfo_s
+{
+  size_t nsampled;   /* Allocations sampled */
+  size_t nlive;      /* Sampled allocations not yet freed */
+  size_t ndropped;   /* Samples dropped because the table was full */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -146,6 +230,20 @@ EXTERN FAR struct mm_heap_s *g_mmheap;
 EXTERN FAR struct mm_heap_s *g_kmmheap;
 #endif
 
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+/* These are the pools serve the small allocations of the heaps */
+
+struct mempool_multiple_s;
+
+#  ifdef CONFIG_BUILD_FLAT
+EXTERN struct mempool_multiple_s g_mmpool;
+#  endif
+
+#  ifdef CONFIG_MM_KERNEL_HEAP
+EXTERN struct mempool_multiple_s g_kmmpool;
+#  endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -182,10 +280,20 @@ void kmm_addregion(FAR void *heapstart, size_t heapsize);
 
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
 
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *mm_malloc_flags(FAR struct mm_heap_s *heap, size_t size,
+                          unsigned int flags);
+#endif
+
 /* Functions contained in kmm_malloc.c **************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 FAR void *kmm_malloc(size_t size);
+#  ifdef CONFIG_MM_REGION_ATTR
+FAR void *kmm_malloc_flags(size_t size, unsigned int flags);
+#  else
+#    define kmm_malloc_flags(s,f) kmm_malloc(s)
+#  endif
 #endif
 
 /* Functions contained in mm_malloc_size.c **********************************/
@@ -303,6 +411,19 @@ int mm_mallinfo_task(FAR struct mm_heap_s *heap,
                      FAR struct mallinfo_task *info);
 #endif
 
+#ifdef CONFIG_MM_REGION_ATTR
+int mm_region_mallinfo(FAR struct mm_heap_s *heap, int region,
+                       FAR struct mallinfo *info);
+#endif
+
+/* Functions contained in mm_region.c ***************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+int mm_region_setattr(FAR struct mm_heap_s *heap, FAR void *mem,
+                      unsigned int attr);
+int mm_region_getattr(FAR struct mm_heap_s *heap, int region);
+#endif
+
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -312,6 +433,27 @@ struct mallinfo_task kmm_mallinfo_task(pid_t pid);
 #  endif
 #endif
 
+/* Functions contained in mm_percpu.c ***************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+void mm_percpu_info(FAR struct mm_heap_s *heap,
+                    FAR struct mm_percpuinfo_s *info);
+#endif
+
+/* Functions contained in mm_stats.c ****************************************/
+
+#ifdef CONFIG_MM_HEAP_STATS
+int mm_stats_info(FAR struct mm_heap_s *heap,
+                  FAR struct mm_statsinfo_s *info);
+#endif
+
+/* Functions contained in mm_profile.c **************************************/
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+void mm_profile_info(FAR struct mm_heap_s *heap,
+                     FAR struct mm_profileinfo_s *info);
+#endif
+
 /* Functions contained in mm_memdump.c **************************************/
 
 void mm_memdump(FAR struct mm_heap_s *heap, pid_t pid);
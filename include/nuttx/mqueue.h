@@ -79,10 +79,23 @@
 #  define _MQ_TIMEDRECEIVE(d,m,l,p,t) mq_timedreceive(d,m,l,p,t)
 #endif
 
+/* Check if there is no room for another message in the message queue.
+ * The slots borrowed from a ring message queue count as used.
+ */
+
+#ifdef CONFIG_MQUEUE_RING
+#  define nxmq_isfull(msgq) \
+     ((msgq)->nmsgs + (msgq)->nborrowed >= (msgq)->maxmsgs)
+#else
+#  define nxmq_isfull(msgq) ((msgq)->nmsgs >= (msgq)->maxmsgs)
+#endif
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
 
+struct mqueue_ring_s; /* Forward reference */
+
 /* This structure defines a message queue */
 
 struct mqueue_inode_s
@@ -102,6 +115,10 @@ struct mqueue_inode_s
   pid_t ntpid;                /* Notification: Receiving Task's PID */
   struct sigevent ntevent;    /* Notification description */
   struct sigwork_s ntwork;    /* Notification work */
+#endif
+#ifdef CONFIG_MQUEUE_RING
+  int16_t nborrowed;              /* Slots borrowed, not published */
+  FAR struct mqueue_ring_s *ring; /* Preallocated slots, NULL if none */
 #endif
   FAR struct pollfd *fds[CONFIG_FS_MQUEUE_NPOLLWAITERS];
 };
@@ -707,6 +724,82 @@ int file_mq_setattr(FAR struct file *mq, FAR const struct mq_attr *mq_stat,
 
 int file_mq_getattr(FAR struct file *mq, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQUEUE_RING
+/****************************************************************************
+ * Name: file_mq_borrow
+ *
+ * Description:
+ *   Reserve a free slot of a message queue created with the MQ_RING flag
+ *   and return its payload buffer.  The caller builds the message in place
+ *   and passes the buffer to file_mq_publish(), so the message is never
+ *   copied on the sending side.  The borrowed slot counts as used until it
+ *   is published.  If all slots are in use, the call blocks unless the
+ *   message queue was opened with O_NONBLOCK or unless it is called from
+ *   an interrupt handler.
+ *
+ * Input Parameters:
+ *   mq     - Message queue descriptor
+ *   buffer - The location to return the payload buffer of the slot, which
+ *            is at least mq_msgsize bytes long.
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure:
+ *
+ *   EAGAIN   All slots are in use and the caller may not wait.
+ *   EINVAL   The message queue has no preallocated slots.
+ *   EPERM    Message queue opened not opened for writing.
+ *   EINTR    The call was interrupted by a signal handler.
+ *
+ ****************************************************************************/
+
+int file_mq_borrow(FAR struct file *mq, FAR void **buffer);
+
+/****************************************************************************
+ * Name: file_mq_publish
+ *
+ * Description:
+ *   Queue the message built in a slot obtained with file_mq_borrow().  The
+ *   message is received like one sent by file_mq_send().  On failure, the
+ *   slot remains borrowed.
+ *
+ * Input Parameters:
+ *   mq     - Message queue descriptor
+ *   buffer - The payload buffer returned by file_mq_borrow()
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message, less than
+ *            CONFIG_MQUEUE_RING_NLANES
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK) is
+ *   returned on success.  A negated errno value is returned on failure:
+ *
+ *   EINVAL   The buffer is not a borrowed slot, or the priority is
+ *            invalid.
+ *   EMSGSIZE 'msglen' was greater than the maxmsgsize attribute of the
+ *            message queue.
+ *
+ ****************************************************************************/
+
+int file_mq_publish(FAR struct file *mq, FAR void *buffer, size_t msglen,
+                    unsigned int prio);
+
+/****************************************************************************
+ * Name: nxmq_borrow and nxmq_publish
+ *
+ * Description:
+ *   The same as file_mq_borrow() and file_mq_publish(), but take a message
+ *   queue descriptor.
+ *
+ ****************************************************************************/
+
+int nxmq_borrow(mqd_t mqdes, FAR void **buffer);
+int nxmq_publish(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                 unsigned int prio);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
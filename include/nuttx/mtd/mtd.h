@@ -280,6 +280,25 @@ FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd);
 
 int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd);
 
+/****************************************************************************
+ * Name: ftl_log_initialize_by_path
+ *
+ * Description:
+ *   Initialize to provide a log-structured block driver wrapper around an
+ *   MTD interface.  This is what ftl_initialize_by_path() does when
+ *   CONFIG_FTL_LOG is selected.
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG
+int ftl_log_initialize_by_path(FAR const char *path,
+                               FAR struct mtd_dev_s *mtd);
+#endif
+
 /****************************************************************************
  * Name: ftl_initialize
  *
@@ -62,11 +62,27 @@
  * nand_dev_s.
  */
 
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+/* A page of the page cache */
+
+struct nand_cache_s
+{
+  off_t block;                /* Block of the page, -1 if unused */
+  unsigned int page;          /* Page inside the block */
+  uint32_t age;               /* Last use, for the LRU replacement */
+  FAR uint8_t *data;          /* The data area of the page */
+};
+#endif
+
 struct nand_dev_s
 {
   struct mtd_dev_s mtd;       /* Externally visible part of the driver */
   FAR struct nand_raw_s *raw; /* Retained reference to the lower half */
   sem_t exclsem;              /* For exclusive access to the NAND FLASH */
+#if CONFIG_MTD_NAND_PAGECACHE > 0
+  uint32_t age;               /* Counter of the uses of the cache */
+  struct nand_cache_s cache[CONFIG_MTD_NAND_PAGECACHE];
+#endif
 };
 
 /****************************************************************************
@@ -59,6 +59,10 @@
 #define NANDMODEL_DATAWIDTH16 (1 << 0)  /* NAND uses a 16-bit databus */
 #define NANDMODEL_COPYBACK    (1 << 1)  /* NAND supports the copy-back function
                                          * (internal page-to-page copy) */
+#define NANDMODEL_CACHEREAD   (1 << 2)  /* NAND supports the sequential cache
+                                         * read commands */
+#define NANDMODEL_MULTIPLANE  (1 << 3)  /* NAND supports the multi-plane
+                                         * program and erase */
 
 /****************************************************************************
  * Public Types
@@ -78,6 +82,10 @@ struct nand_model_s
   /* Spare area placement scheme */
 
   FAR const struct nand_scheme_s *scheme;
+
+  /* Number of planes, zero or one without NANDMODEL_MULTIPLANE */
+
+  uint8_t  nplanes;
 };
 
 /****************************************************************************
@@ -369,6 +377,43 @@ unsigned int nandmodel_getsparesize(FAR const struct nand_model_s *model);
 
 #define nandmodel_havecopyback(m) (((m)->options & NANDMODEL_COPYBACK) != 0)
 
+/****************************************************************************
+ * Name: nandmodel_havecacheread
+ *
+ * Description:
+ *   Returns true if the device supports the sequential cache read.
+ *   Otherwise returns false.
+ *
+ * Input Parameters:
+ *   model  Pointer to a nand_model_s instance.
+ *
+ * Returned Value:
+ *   Returns true if the device supports the sequential cache read.
+ *   Otherwise returns false.
+ *
+ ****************************************************************************/
+
+#define nandmodel_havecacheread(m) \
+  (((m)->options & NANDMODEL_CACHEREAD) != 0)
+
+/****************************************************************************
+ * Name: nandmodel_getplanes
+ *
+ * Description:
+ *   Returns the number of planes that a multi-plane operation addresses.
+ *
+ * Input Parameters:
+ *   model  Pointer to a nand_model_s instance.
+ *
+ * Returned Value:
+ *   The number of planes, one if the device has no multi-plane operations.
+ *
+ ****************************************************************************/
+
+#define nandmodel_getplanes(m) \
+  ((((m)->options & NANDMODEL_MULTIPLANE) != 0 && (m)->nplanes > 1) ? \
+   (m)->nplanes : 1)
+
 #undef EXTERN
 #ifdef __cplusplus
 }
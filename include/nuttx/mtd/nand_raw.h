@@ -226,6 +226,45 @@
 #  define NAND_WRITEPAGE(r,b,p,d,s) ((r)->rawwrite(r,b,p,d,s))
 #endif
 
+/****************************************************************************
+ * Name: NAND_READPAGES
+ * Description:
+ *   Reads the data areas of consecutive pages of a block with the
+ *   sequential cache read commands, with the ECC checking of
+ *   NAND_READPAGE.  Optional, NULL if the lower half doesn't support it.
+ * Input Parameters:
+ *   raw    - Lower-half, raw NAND FLASH interface
+ *   block  - Number of the block where the pages to read reside.
+ *   page   - Number of the first page to read inside the given block.
+ *   npages - Number of pages to read, up to the end of the block.
+ *   data   - Buffer where the data areas will be stored.
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_CACHEREAD
+#  define NAND_READPAGES(r,b,p,n,d) ((r)->readpages(r,b,p,n,d))
+#endif
+
+/****************************************************************************
+ * Name: NAND_ERASEBLOCKS
+ * Description:
+ *   Erases one block in each of several planes with a single multi-plane
+ *   erase.  Optional, NULL if the lower half doesn't support it.
+ * Input Parameters:
+ *   raw     - Lower-half, raw NAND FLASH interface
+ *   block   - Number of the first block to erase, aligned to the number of
+ *             planes.
+ *   nblocks - Number of consecutive blocks to erase, up to the number of
+ *             planes.
+ * Returned Value:
+ *   OK is returned in success; a negated errno value is returned on failure.
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_NAND_MULTIPLANE
+#  define NAND_ERASEBLOCKS(r,b,n) ((r)->eraseblocks(r,b,n))
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -262,6 +301,17 @@ struct nand_raw_s
                         FAR const void *spare);
 #endif
 
+#ifdef CONFIG_MTD_NAND_CACHEREAD
+  CODE int (*readpages)(FAR struct nand_raw_s *raw, off_t block,
+                        unsigned int page, unsigned int npages,
+                        FAR void *data);
+#endif
+
+#ifdef CONFIG_MTD_NAND_MULTIPLANE
+  CODE int (*eraseblocks)(FAR struct nand_raw_s *raw, off_t block,
+                          unsigned int nblocks);
+#endif
+
 #if defined(CONFIG_MTD_NAND_SWECC) || defined(CONFIG_MTD_NAND_HWECC)
   /* ECC working buffers */
 
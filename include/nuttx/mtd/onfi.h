@@ -48,6 +48,22 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Bits of the features field */
+
+#define ONFI_FEATURE_BUSWIDTH16  (1 << 0)  /* 16-bit data bus */
+#define ONFI_FEATURE_MULTILUN    (1 << 1)  /* Multiple LUN operations */
+#define ONFI_FEATURE_NONSEQPROG  (1 << 2)  /* Non-sequential page program */
+#define ONFI_FEATURE_MULTIPLANE  (1 << 3)  /* Multi-plane operations */
+
+/* Bits of the optional commands field */
+
+#define ONFI_OPTCMD_CACHEPROG    (1 << 0)  /* Page cache program */
+#define ONFI_OPTCMD_READCACHE    (1 << 1)  /* Read cache commands */
+#define ONFI_OPTCMD_FEATURES     (1 << 2)  /* Get/Set features */
+#define ONFI_OPTCMD_STATUSENH    (1 << 3)  /* Read status enhanced */
+#define ONFI_OPTCMD_COPYBACK     (1 << 4)  /* Copyback */
+#define ONFI_OPTCMD_UNIQUEID     (1 << 5)  /* Read unique ID */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -61,6 +77,9 @@ struct onfi_pgparam_s
   uint8_t luns;           /* Number of logical units */
   uint8_t eccsize;        /* Number of bits of ECC correction */
   uint8_t model;          /* Device model */
+  uint8_t planebits;      /* Number of plane (interleaved) address bits */
+  uint16_t features;      /* Features supported, ONFI_FEATURE_* */
+  uint16_t optcmds;       /* Optional commands supported, ONFI_OPTCMD_* */
   uint16_t sparesize;     /* Number of spare bytes per page */
   uint16_t pagesperblock; /* Number of pages per block */
   uint16_t blocksperlun;  /* Number of blocks per logical unit (LUN) */
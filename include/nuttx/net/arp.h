@@ -74,6 +74,12 @@
 #define ARPHRD_IEEE80211    801  /* IEEE 802.11 */
 #define ARPHRD_IEEE802154   804  /* IEEE 802.15.4 */
 
+/* States of an ARP table entry */
+
+#define ARP_STATE_INCOMPLETE 1   /* Request sent, no reply yet */
+#define ARP_STATE_REACHABLE  2   /* Recently confirmed */
+#define ARP_STATE_STALE      3   /* Not confirmed recently, still used */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -84,8 +90,10 @@ struct arp_entry_s
 {
   in_addr_t                at_ipaddr;   /* IP address */
   struct ether_addr        at_ethaddr;  /* Hardware address */
-  clock_t                  at_time;     /* Time of last usage */
+  clock_t                  at_time;     /* Time of last confirmation */
   FAR struct net_driver_s *at_dev;      /* The device driver structure */
+  uint32_t                 at_hits;     /* Number of successful look-ups */
+  uint8_t                  at_state;    /* See ARP_STATE_* definitions */
 };
 
 /****************************************************************************
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * include/nuttx/net/napi.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NET_NAPI_H
+#define __INCLUDE_NUTTX_NET_NAPI_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+
+#include <nuttx/wqueue.h>
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NETDEV_NAPI_BUDGET
+#  define CONFIG_NETDEV_NAPI_BUDGET 16
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Batched receive polling.  Instead of processing each frame from its own
+ * interrupt, the interrupt handler of the driver calls napi_schedule().
+ * That masks the receive interrupt and schedules the poller on the work
+ * queue.  The poller calls the 'poll' method of the driver with the
+ * network locked.  'poll' processes up to 'budget' received frames (and
+ * normally also the completed transmissions) and returns the number of
+ * frames processed:
+ *
+ * - If fewer than 'budget', the ring is empty.  The poller unmasks the
+ *   receive interrupt with 'rxint' and goes idle until the next
+ *   napi_schedule().  Unmasking the interrupt while frames are pending
+ *   must raise it again, or 'rxint' must check the ring and call
+ *   napi_schedule() itself.
+ * - Otherwise, the poller unlocks the network and requeues itself, so that
+ *   other work and other network users get their turn between batches.
+ *
+ * Example:
+ *
+ *   static int drv_interrupt(int irq, FAR void *context, FAR void *arg)
+ *   {
+ *     FAR struct drv_driver_s *priv = arg;
+ *
+ *     napi_schedule(&priv->napi);
+ *     return OK;
+ *   }
+ */
+
+struct napi_s
+{
+  FAR void *priv;                /* For the use of the driver */
+
+  /* Process up to 'budget' frames, return the number processed.  Called
+   * with the network locked.
+   */
+
+  CODE int (*poll)(FAR struct napi_s *napi, int budget);
+
+  /* Mask (enable == false) or unmask the receive interrupt.  May be called
+   * from the interrupt handler.
+   */
+
+  CODE void (*rxint)(FAR struct napi_s *napi, bool enable);
+
+  int budget;                    /* Frames per poll */
+  volatile bool scheduled;       /* The poller is pending or running */
+  struct work_s work;            /* The poller work */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: napi_init
+ *
+ * Description:
+ *   Initialize the poller of a driver.
+ *
+ * Input Parameters:
+ *   napi   - The poller to initialize
+ *   priv   - For the use of the driver
+ *   poll   - Process up to 'budget' frames, see struct napi_s
+ *   rxint  - Mask or unmask the receive interrupt
+ *   budget - Frames per poll, 0: CONFIG_NETDEV_NAPI_BUDGET
+ *
+ ****************************************************************************/
+
+void napi_init(FAR struct napi_s *napi, FAR void *priv,
+               CODE int (*poll)(FAR struct napi_s *napi, int budget),
+               CODE void (*rxint)(FAR struct napi_s *napi, bool enable),
+               int budget);
+
+/****************************************************************************
+ * Name: napi_schedule
+ *
+ * Description:
+ *   Mask the receive interrupt and schedule the poller, unless it is
+ *   already pending.  Normally called from the interrupt handler.
+ *
+ ****************************************************************************/
+
+void napi_schedule(FAR struct napi_s *napi);
+
+/****************************************************************************
+ * Name: napi_disable
+ *
+ * Description:
+ *   Cancel the poller, e.g. when the interface is brought down.  The
+ *   receive interrupt stays masked.
+ *
+ ****************************************************************************/
+
+void napi_disable(FAR struct napi_s *napi);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_NETDEV_NAPI */
+#endif /* __INCLUDE_NUTTX_NET_NAPI_H */
@@ -46,6 +46,22 @@
 #  define CONFIG_NET_IPv6_NCONF_ENTRIES 8
 #endif
 
+#ifndef CONFIG_NET_IPv6_NCONF_HASH_SIZE
+#  define CONFIG_NET_IPv6_NCONF_HASH_SIZE 0
+#endif
+
+#ifndef CONFIG_NET_IPv6_NCONF_REACHABLE
+#  define CONFIG_NET_IPv6_NCONF_REACHABLE 30
+#endif
+
+/* States of a Neighbor Table entry (RFC 4861, section 7.3.2) */
+
+#define NEIGHBOR_STATE_INCOMPLETE 1  /* Solicitation sent, no answer yet */
+#define NEIGHBOR_STATE_REACHABLE  2  /* Recently confirmed */
+#define NEIGHBOR_STATE_STALE      3  /* Not confirmed recently, still used */
+#define NEIGHBOR_STATE_DELAY      4  /* Used while stale, awaiting a hint */
+#define NEIGHBOR_STATE_PROBE      5  /* Unicast solicitations being sent */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -81,7 +97,9 @@ struct neighbor_entry_s
 {
   net_ipv6addr_t         ne_ipaddr;  /* IPv6 address of the Neighbor */
   struct neighbor_addr_s ne_addr;    /* Link layer address of the Neighbor */
-  clock_t                ne_time;    /* For aging, units of tick */
+  clock_t                ne_time;    /* Time of the last state change,
+                                      * units of tick */
+  uint8_t                ne_state;   /* See NEIGHBOR_STATE_* definitions */
 };
 
 #ifdef __cplusplus
@@ -149,7 +149,7 @@ enum net_lltype_e
 
 /* This defines a bitmap big enough for one bit for each socket option */
 
-typedef uint16_t sockopt_t;
+typedef uint32_t sockopt_t;
 
 /* This defines the storage size of a timeout value.  This effects only
  * range of supported timeout values.  With an LSB in seciseconds, the
@@ -168,6 +168,7 @@ typedef uint8_t sockcaps_t;
  */
 
 struct file;    /* Forward reference */
+struct iob_s;   /* Forward reference */
 struct stat;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
@@ -204,6 +205,11 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+#ifdef CONFIG_NET_RECVIOB
+  CODE ssize_t    (*si_recviob)(FAR struct socket *psock,
+                    FAR struct iob_s **iob, int flags,
+                    FAR struct sockaddr *from, FAR socklen_t *fromlen);
+#endif
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -350,7 +356,13 @@ ssize_t net_ioctl_arglen(int cmd);
  * Name: net_lock
  *
  * Description:
- *   Take the network lock
+ *   Take the network lock.
+ *
+ *   The ARP table, the IPv6 neighbor table and the in-memory routing tables
+ *   have their own locks and do not rely on the network lock.  Those locks
+ *   rank below the network lock:  They may be taken with the network lock
+ *   held, but the network lock must not be taken while holding one of
+ *   them.
  *
  * Input Parameters:
  *   None
@@ -893,6 +905,62 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_recvmmsg / psock_sendmmsg
+ *
+ * Description:
+ *   Receive or send up to 'vlen' messages with a single call.  These are
+ *   the internal OS versions of recvmmsg() and sendmmsg():  They are not
+ *   cancellation points, do not modify the errno variable and accept the
+ *   internal socket structure as an input.
+ *
+ * Returned Value:
+ *   The number of messages transferred; msg_len of each holds its size.
+ *   If the first message fails, a negated errno value.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recviob
+ *
+ * Description:
+ *   Receive without copying, for in-kernel users of a socket.  Instead of
+ *   copying the data into a caller buffer, hand out the I/O buffer chain
+ *   that holds it:  All of the buffered data of a stream socket, or the
+ *   next datagram of a datagram socket.  The caller owns the chain and
+ *   must release it with iob_free_chain().  Only sockets whose address
+ *   family provides si_recviob support this (currently AF_INET and
+ *   AF_INET6 TCP and UDP).
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iob     - The location to return the I/O buffer chain
+ *   flags   - Receive flags (MSG_DONTWAIT)
+ *   from    - The location to return the address of the sender of a
+ *             datagram (may be NULL)
+ *   fromlen - The size of 'from' on input, the size of the address on
+ *             output
+ *
+ * Returned Value:
+ *   The number of bytes in the chain returned in 'iob'; the chain is
+ *   returned only if this is positive.  Zero if the peer has performed an
+ *   orderly shutdown (or for an empty datagram).  A negated errno value on
+ *   failure; -EOPNOTSUPP if the socket does not support this interface.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECVIOB
+ssize_t psock_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                      int flags, FAR struct sockaddr *from,
+                      FAR socklen_t *fromlen);
+#endif
+
 /****************************************************************************
  * Name: psock_send
  *
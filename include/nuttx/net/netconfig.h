@@ -464,6 +464,14 @@
 #  endif
 #endif
 
+/* The number of data segments that one TCP connection may send each time
+ * that the network device is polled.
+ */
+
+#ifndef CONFIG_NET_TCP_POLL_BURST
+#  define CONFIG_NET_TCP_POLL_BURST 1
+#endif
+
 /* The maximum number of simultaneously listening TCP ports.
  *
  * Each listening TCP port requires 2 bytes of memory.
@@ -680,6 +688,12 @@
 #  define CONFIG_NET_ARP_MAXAGE 120
 #endif
 
+#ifndef CONFIG_NET_ARP_REACHABLE
+/* The time in seconds until an unconfirmed ARP table entry becomes stale */
+
+#  define CONFIG_NET_ARP_REACHABLE 30
+#endif
+
 /* Usrsock configuration options */
 
 /* The maximum amount of concurrent usrsock connections, Default: 6 */
@@ -52,6 +52,7 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <time.h>
 #include <queue.h>
 
 #include <net/if.h>
@@ -153,6 +154,35 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Checksum offload capabilities of a device (d_csumoff).  An RX flag means
+ * that the hardware verifies that checksum and never passes a packet with
+ * a bad one.  A TX flag means that the hardware inserts that checksum:
+ * The stack sets the field to zero instead of computing it, except in the
+ * packets that it only modifies, such as echo replies, whose field stays
+ * valid.
+ */
+
+#define NETDEV_CSUM_RX_IPv4    (1 << 0)  /* IPv4 header */
+#define NETDEV_CSUM_RX_TCP     (1 << 1)  /* TCP over IPv4 and IPv6 */
+#define NETDEV_CSUM_RX_UDP     (1 << 2)  /* UDP over IPv4 and IPv6 */
+#define NETDEV_CSUM_TX_IPv4    (1 << 4)  /* IPv4 header */
+#define NETDEV_CSUM_TX_TCP     (1 << 5)  /* TCP over IPv4 and IPv6 */
+#define NETDEV_CSUM_TX_UDP     (1 << 6)  /* UDP over IPv4 and IPv6 */
+#define NETDEV_CSUM_TX_ICMP    (1 << 7)  /* ICMP over IPv4 */
+
+/* Packets that never leave memory need no checksum at all */
+
+#define NETDEV_CSUM_LOOPBACK   (NETDEV_CSUM_RX_IPv4 | NETDEV_CSUM_RX_TCP | \
+                                NETDEV_CSUM_RX_UDP | NETDEV_CSUM_TX_IPv4 | \
+                                NETDEV_CSUM_TX_TCP | NETDEV_CSUM_TX_UDP | \
+                                NETDEV_CSUM_TX_ICMP)
+
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+#  define NETDEV_CSUM_OFFLOAD(dev,f) (((dev)->d_csumoff & (f)) != 0)
+#else
+#  define NETDEV_CSUM_OFFLOAD(dev,f) (0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -255,6 +285,12 @@ struct net_driver_s
 #endif
 
   uint16_t d_pktsize;           /* Maximum packet size */
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  uint8_t d_csumoff;            /* Checksum offloads, see NETDEV_CSUM_* */
+#endif
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+  uint8_t d_nqueues;            /* Number of TX/RX queues, 0 or 1: Single */
+#endif
 
   /* Link layer address */
 
@@ -348,6 +384,35 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NETDEV_TSO
+  /* TCP segmentation offload.  A driver whose hardware can split a TCP
+   * packet into segments sets d_tsomax to the largest TCP payload that it
+   * accepts in one packet; d_buf must be large enough for that payload
+   * plus the headers, and the IP length limits it to 65535 bytes in
+   * total.  Zero disables the offload.
+   *
+   * The stack sets d_tsomss with each TCP packet that it sends with a
+   * payload larger than the MSS.  The driver must then send that packet
+   * as segments of d_tsomss bytes of payload each.  d_tsomss is not
+   * cleared:  The driver segments only the TCP packets whose payload
+   * exceeds it.  At worst, a packet of another connection with a larger
+   * MSS is split into smaller but still valid segments.
+   */
+
+  uint16_t d_tsomax;
+  uint16_t d_tsomss;
+#endif
+
+#if defined(CONFIG_NET_CAN) && defined(CONFIG_NET_TIMESTAMP)
+  /* A CAN driver whose controller time stamps the received frames sets
+   * d_rxtime to the time of reception of the frame in d_buf before it
+   * calls can_input(), which clears it.  Zero:  The frame is time stamped
+   * by can_input().
+   */
+
+  struct timespec d_rxtime;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -549,6 +614,29 @@ int sixlowpan_input(FAR struct radio_driver_s *ieee,
 
 int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback);
 
+/****************************************************************************
+ * Name: devif_poll_queue
+ *
+ * Description:
+ *   The multi-queue version of devif_poll().  Poll only the TCP and UDP
+ *   connections whose flows map to TX queue 'queue' of the device (see
+ *   netdev_flowqueue()).  Polling queue 0 also performs all of the other
+ *   polling operations of devif_poll(), for ARP, ICMP, IGMP, forwarding,
+ *   etc.  A driver with d_nqueues queues calls devif_poll_queue() for each
+ *   queue that can accept another outgoing packet; the callback then sends
+ *   the packet on that queue.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+int devif_poll_queue(FAR struct net_driver_s *dev, int queue,
+                     devif_poll_callback_t callback);
+#endif
+
 /****************************************************************************
  * Name: neighbor_out
  *
@@ -632,9 +720,6 @@ int netdev_carrier_off(FAR struct net_driver_s *dev);
  *
  *   See RFC1071.
  *
- *   If CONFIG_NET_ARCH_CHKSUM is defined, then this function must be
- *   provided by architecture-specific logic.
- *
  * Input Parameters:
  *
  *   buf - A pointer to the buffer over which the checksum is to be computed.
@@ -679,9 +764,6 @@ void net_incr32(FAR uint8_t *op32, uint16_t op16);
  *   The IPv4 header checksum is the Internet checksum of the 20 bytes of
  *   the IPv4 header.
  *
- *   If CONFIG_NET_ARCH_CHKSUM is defined, then this function must be
- *   provided by architecture-specific logic.
- *
  * Returned Value:
  *   The IPv4 header checksum of the IPv4 header in the d_buf buffer.
  *
@@ -737,4 +819,36 @@ uint16_t ipv4_chksum(FAR struct net_driver_s *dev);
 
 int netdev_lladdrsize(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_flowhash
+ *
+ * Description:
+ *   Hash the remote address (4 or 16 bytes, network order) and the ports
+ *   (network order, zero if none) of a flow.  netdev_flowqueue() maps the
+ *   hash to a queue of the device.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+uint32_t netdev_flowhash(FAR const void *raddr, size_t addrlen,
+                         uint16_t lport, uint16_t rport);
+
+#  define netdev_flowqueue(dev,hash) \
+     ((dev)->d_nqueues > 1 ? (int)((hash) % (dev)->d_nqueues) : 0)
+
+/****************************************************************************
+ * Name: netdev_rxqueue
+ *
+ * Description:
+ *   Software receive side steering:  For a driver whose hardware does not
+ *   spread the received packets over its queues, return the queue that
+ *   should process the packet in d_buf, by the flow of the packet.  Each
+ *   queue is normally processed by its own work item, so that the receive
+ *   work of different flows can run on different CPUs.
+ *
+ ****************************************************************************/
+
+int netdev_rxqueue(FAR struct net_driver_s *dev);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -354,6 +354,13 @@
    (a)[4] == 0 && (a)[5] == 0 && (a)[6] == 0 && \
    (((a)[7] & HTONS(0xff00)) == 0x0000))
 
+/* The number of 32-bit words in the map of the 8-byte units of a packet
+ * that were received during its reassembly.
+ */
+
+#define SIXLOWPAN_REASS_MAPWORDS \
+  (((CONFIG_NET_6LOWPAN_PKTSIZE + 7) / 8 + 31) / 32)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -387,6 +394,13 @@ struct sixlowpan_reassbuf_s
 
   FAR struct sixlowpan_reassbuf_s *rb_flink;
 
+  /* Supports the hash table of the active reassembly buffers, keyed by
+   * source address, tag and size.  rb_hash is the index of the chain.
+   */
+
+  FAR struct sixlowpan_reassbuf_s *rb_hlink;
+  uint8_t rb_hash;
+
   /* Fragmentation is handled frame by frame and requires that certain
    * state information be retained from frame to frame.  That additional
    * information follows the externally visible packet buffer.
@@ -433,6 +447,15 @@ struct sixlowpan_reassbuf_s
 
   uint16_t rb_boffset;
 
+  /* The 8-byte units of the packet received so far, counted from
+   * rb_boffset as the fragment offsets are, and the number of these units.
+   * The reassembly is complete when all units up to rb_pktlen have been
+   * received, in whatever order the fragments arrived.
+   */
+
+  uint32_t rb_fragmap[SIXLOWPAN_REASS_MAPWORDS];
+  uint16_t rb_nunits;
+
   /* The source MAC address of the fragments being merged */
 
   struct netdev_varaddr_s rb_fragsrc;
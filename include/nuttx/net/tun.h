@@ -59,6 +59,13 @@
 #define IFF_MASK         0x7f
 #define IFF_NO_PI        0x80
 
+/* With IFF_BATCH, read() and write() transfer several packets at once.  Each
+ * packet is preceded by its length in bytes, as a uint16_t in host byte
+ * order and without padding.
+ */
+
+#define IFF_BATCH        0x0100
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -286,7 +286,7 @@ void usrsock_abort(void);
  ****************************************************************************/
 
 ssize_t usrsock_response(FAR const char *buffer, size_t len,
-                         FAR bool *req_done);
+                         FAR uint32_t *ackxid);
 
 /****************************************************************************
  * Name: usrsock_request() - finish usrsock's request
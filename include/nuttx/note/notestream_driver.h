@@ -0,0 +1,125 @@
+/****************************************************************************
+ * include/nuttx/note/notestream_driver.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H
+#define __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The note stream starts with a struct notestream_header_s that describes
+ * the layout of the notes, followed by the notes of <nuttx/sched_note.h>
+ * as they are recorded, each one starting with its length.  Two records of
+ * the stream itself use the note types that the scheduler does not:  The
+ * names of the tasks that exist when the stream is opened, and the count of
+ * the notes that were lost because the buffer was full.  As in the notes,
+ * the multi-byte fields are little endian.
+ */
+
+#define NOTESTREAM_MAGIC        "NXTR"
+#define NOTESTREAM_VERSION      1
+
+/* Flags of the header */
+
+#define NOTESTREAM_FLAG_LITTLE  0x01  /* Little endian target */
+#define NOTESTREAM_FLAG_SMP     0x02  /* The notes have nc_cpu */
+#define NOTESTREAM_FLAG_HIRES   0x04  /* The time is nc_systime_sec/nsec */
+
+/* Types of the records of the stream */
+
+#define NOTESTREAM_TASKNAME     0xfe  /* struct notestream_taskname_s */
+#define NOTESTREAM_DROPPED      0xff  /* struct notestream_dropped_s */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The header of the stream, sent each time the stream is opened */
+
+struct notestream_header_s
+{
+  uint8_t nh_magic[4];              /* NOTESTREAM_MAGIC */
+  uint8_t nh_version;               /* NOTESTREAM_VERSION */
+  uint8_t nh_flags;                 /* NOTESTREAM_FLAG_* */
+  uint8_t nh_ncpus;                 /* Number of CPUs */
+  uint8_t nh_pidsize;               /* sizeof(pid_t) */
+  uint8_t nh_timesize;              /* sizeof(time_t) or sizeof(clock_t) */
+  uint8_t nh_longsize;              /* sizeof(long) */
+  uint8_t nh_ptrsize;               /* sizeof(uintptr_t) */
+  uint8_t nh_reserved;
+  uint8_t nh_usec_per_tick[4];      /* Microseconds per clock tick */
+};
+
+/* The name of a task that was started before the stream was opened */
+
+struct notestream_taskname_s
+{
+  uint8_t nt_length;                /* Length of the record */
+  uint8_t nt_type;                  /* NOTESTREAM_TASKNAME */
+  uint8_t nt_pid[sizeof(pid_t)];    /* ID of the thread/task */
+  char    nt_name[1];               /* Name terminated by '\0' */
+};
+
+/* The count of the notes lost since the previous such record */
+
+struct notestream_dropped_s
+{
+  uint8_t nd_length;                /* Length of the record */
+  uint8_t nd_type;                  /* NOTESTREAM_DROPPED */
+  uint8_t nd_count[4];              /* Number of notes lost */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#if defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT)
+
+/****************************************************************************
+ * Name: notestream_register
+ *
+ * Description:
+ *   Start the thread that streams the notes to the configured device, TCP
+ *   port or RTT channel.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   Zero on success.  A negated errno value is returned on a failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_NOTESTREAM
+int notestream_register(void);
+#endif
+
+#endif /* defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT) */
+
+#endif /* __INCLUDE_NUTTX_NOTE_NOTESTREAM_DRIVER_H */
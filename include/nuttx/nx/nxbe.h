@@ -175,6 +175,15 @@ struct nxbe_window_s
                                        */
 #endif
 
+#ifdef CONFIG_NX_CLIPCACHE
+  /* The visible parts of the window, kept by nxbe_clipvisible() */
+
+  uint32_t clipgen;                   /* nxbe_state_s clipgen of the cache */
+  uint16_t nclip;                     /* Number of visible rectangles */
+  uint16_t mxclip;                    /* The capacity of clip[] */
+  FAR struct nxgl_rect_s *clip;       /* The visible rectangles */
+#endif
+
   /* Client state information this is provide in window callbacks
    * Set by nx_openwindow, nx_requestbkgd, nxtk_openwindow, or
    * nxtk_opentoolbar and persists for the life of the window.
@@ -210,11 +210,25 @@
  */
 
 /****************************************************************************
- * Public Data
+ * Public Types
  ****************************************************************************/
 
 #ifndef __ASSEMBLY__
 
+#ifdef CONFIG_PAGING_STATS
+struct pg_stats_s
+{
+  uint32_t nfaults;     /* The page faults handled by pg_miss() */
+  uint32_t nfills;      /* The pages filled for a faulting task */
+  uint32_t nmapped;     /* The faults on a page that was mapped meanwhile */
+  uint32_t nprefetch;   /* The pages filled ahead of a fault */
+};
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -297,6 +311,19 @@ extern "C"
 
 void pg_miss(void);
 
+/****************************************************************************
+ * Name: pg_getstats
+ *
+ * Description:
+ *   Return the counts of the page faults and of the page fills since boot.
+ *   The fault rate is the difference of two samples over their interval.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PAGING_STATS
+void pg_getstats(FAR struct pg_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Public Functions -- Provided by architecture-specific logic to common
  *                     paging logic.
@@ -448,6 +475,34 @@ int up_fillpage(FAR struct tcb_s *tcb, FAR void *vpage,
                 up_pgcallback_t pg_callback);
 #endif
 
+/****************************************************************************
+ * Name: up_nextpage()
+ *
+ * Description:
+ *   Set up the architecture-specific context information of tcb so that
+ *   up_checkmapping(), up_allocpage() and up_fillpage() operate on the
+ *   page that follows the fault page of ftcb.  This is used for the
+ *   prefetch fills, with a context that belongs to no task.  tcb and ftcb
+ *   may be the same, to step through the pages.
+ *
+ * Input Parameters:
+ *   tcb  - The context to set up
+ *   ftcb - The context of the preceding page
+ *
+ * Returned Value:
+ *   True if the next page is in the paged region, false if it is not and
+ *   tcb was left unchanged.
+ *
+ * Assumptions:
+ *   - This function is called from the normal tasking context (but with
+ *     interrupts disabled).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PAGING_PREFETCH
+bool up_nextpage(FAR struct tcb_s *tcb, FAR const struct tcb_s *ftcb);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -96,19 +96,21 @@
 #define TCB_FLAG_NONCANCELABLE     (1 << 2)                      /* Bit 2: Pthread is non-cancelable */
 #define TCB_FLAG_CANCEL_DEFERRED   (1 << 3)                      /* Bit 3: Deferred (vs asynch) cancellation type */
 #define TCB_FLAG_CANCEL_PENDING    (1 << 4)                      /* Bit 4: Pthread cancel is pending */
-#define TCB_FLAG_POLICY_SHIFT      (5)                           /* Bit 5-6: Scheduling policy */
-#define TCB_FLAG_POLICY_MASK       (3 << TCB_FLAG_POLICY_SHIFT)
+#define TCB_FLAG_POLICY_SHIFT      (5)                           /* Bit 5-7: Scheduling policy */
+#define TCB_FLAG_POLICY_MASK       (7 << TCB_FLAG_POLICY_SHIFT)
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
 #  define TCB_FLAG_SCHED_OTHER     (3 << TCB_FLAG_POLICY_SHIFT)  /* Other scheding policy */
-#define TCB_FLAG_CPU_LOCKED        (1 << 8)                      /* Bit 7: Locked to this CPU */
+#  define TCB_FLAG_SCHED_DEADLINE  (4 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
+#define TCB_FLAG_CPU_LOCKED        (1 << 8)                      /* Bit 8: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 9)                      /* Bit 8: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 10)                     /* Bit 9: In a system call */
 #define TCB_FLAG_EXIT_PROCESSING   (1 << 11)                     /* Bit 10: Exitting */
 #define TCB_FLAG_FREE_STACK        (1 << 12)                     /* Bit 12: Free stack after exit */
 #define TCB_FLAG_HEAPCHECK         (1 << 13)                     /* Bit 13: Heap check */
-                                                                 /* Bits 14-15: Available */
+#define TCB_FLAG_COND_MORPHED      (1 << 14)                     /* Bit 14: Moved to the mutex of a condition */
+                                                                 /* Bit 15: Available */
 
 /* Values for struct task_group tg_flags */
 
@@ -307,6 +309,54 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s ********************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure is an allocated "plug-in" to the main TCB structure.  It is
+ * allocated when the deadline scheduling policy is assigned to a thread.
+ */
+
+struct deadline_s
+{
+  FAR struct tcb_s *tcb;            /* The parent TCB structure                 */
+  struct wdog_s timer;              /* Timer starting each period               */
+  uint8_t   hi_priority;            /* Priority while within the budget         */
+  bool      throttled;              /* Budget of this period is used up         */
+  uint16_t  bandwidth;              /* Admitted share of the CPU, per mille     */
+  uint32_t  runtime;                /* Execution budget per period              */
+  uint32_t  deadline;               /* Deadline relative to the period start    */
+  uint32_t  period;                 /* Period of the thread                     */
+  clock_t   absdeadline;            /* Deadline of the current period           */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
+/* struct smp_call_s ********************************************************/
+
+#ifdef CONFIG_SMP_CALL
+
+/* This is the type of a function run on another CPU by nxsched_smp_call() */
+
+typedef CODE void (*nxsched_smp_call_t)(FAR void *arg);
+
+/* This structure describes one request to run a function on another CPU.
+ * It is queued for the target CPU until that CPU takes the request in its
+ * SMP call interrupt handler.
+ */
+
+struct smp_call_s
+{
+  sq_entry_t node;                  /* Supports a singly linked list        */
+  nxsched_smp_call_t func;          /* The function to run                  */
+  FAR void *arg;                    /* The argument of the function         */
+  volatile bool pending;            /* Queued or (if wait) not yet complete */
+  bool      wait;                   /* The requester waits for completion   */
+  uint8_t   cpu;                    /* The target CPU                       */
+};
+
+#endif /* CONFIG_SMP_CALL */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -368,6 +418,25 @@ struct stackinfo_s
                                          /* from the stack.                     */
 };
 
+/* struct sched_bench_s *****************************************************/
+
+#ifdef CONFIG_SCHED_BENCH
+/* The result of one benchmark of nxsched_bench().  The times are in
+ * nanoseconds.
+ */
+
+struct sched_bench_s
+{
+  FAR const char *name;                  /* Name of the benchmark */
+  uint32_t  nsamples;                    /* Number of samples */
+  uint32_t  min;                         /* Shortest sample */
+  uint32_t  p50;                         /* Median */
+  uint32_t  p90;                         /* 90th percentile */
+  uint32_t  p99;                         /* 99th percentile */
+  uint32_t  max;                         /* Longest sample */
+};
+#endif
+
 /* struct task_group_s ******************************************************/
 
 /* All threads created by pthread_create belong in the same task group (along
@@ -403,6 +472,10 @@ struct join_s;                      /* Forward reference
 struct binary_s;                    /* Forward reference                        */
                                     /* Defined in include/nuttx/binfmt/binfmt.h */
 #endif
+#ifndef CONFIG_DISABLE_ENVIRON
+struct environ_s;                   /* Forward reference                        */
+                                    /* Defined in sched/environ/environ.h       */
+#endif
 
 struct task_group_s
 {
@@ -480,7 +553,7 @@ struct task_group_s
 #ifndef CONFIG_DISABLE_ENVIRON
   /* Environment variables **************************************************/
 
-  FAR char **tg_envp;               /* Allocated environment strings            */
+  FAR struct environ_s *tg_env;     /* Environment, possibly shared             */
 #endif
 
 #ifndef CONFIG_DISABLE_POSIX_TIMERS
@@ -581,15 +654,22 @@ struct tcb_s
 #endif
   int16_t  errcode;                      /* Used to pass error information  */
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   int32_t  timeslice;                    /* RR timeslice OR Sporadic budget */
                                          /* interval remaining              */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  FAR struct deadline_s *deadline;       /* Deadline scheduling parameters  */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  sclock_t timerslack;                   /* Slack of sleeps, in ticks       */
+#endif
 
   /* Stack-Related Fields ***************************************************/
 
@@ -601,6 +681,9 @@ struct tcb_s
   FAR void *stack_base_ptr;              /* Adjusted initial stack pointer  */
                                          /* after the frame has been        */
                                          /* removed from the stack.         */
+#ifdef CONFIG_STACK_SAMPLING
+  size_t    stack_sampled;               /* Deepest stack use sampled       */
+#endif
 
   /* External Module Support ************************************************/
 
@@ -618,7 +701,15 @@ struct tcb_s
   sigset_t   sigwaitmask;                /* Waiting for pending signals     */
   sq_queue_t sigpendactionq;             /* List of pending signal actions  */
   sq_queue_t sigpostedq;                 /* List of posted signals          */
+#if CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0
+  sq_queue_t sigpoolq;                   /* Free private signal actions     */
+  FAR void  *sigpool;                    /* Private signal actions          */
+#endif
   siginfo_t  sigunbinfo;                 /* Signal info when task unblocked */
+#ifdef CONFIG_SMP_CALL
+  struct smp_call_s sigcall;             /* Signal action request for the   */
+                                         /* CPU that runs the thread        */
+#endif
 
   /* POSIX Named Message Queue Fields ***************************************/
 
@@ -632,10 +723,19 @@ struct tcb_s
   FAR struct pthread_mutex_s *mhead;     /* List of mutexes held by thread  */
 #endif
 
+  /* Condition variable support *********************************************/
+
+#if !defined(CONFIG_DISABLE_PTHREAD) && !defined(CONFIG_PTHREAD_MUTEX_FUTEX)
+  FAR struct pthread_mutex_s *condmutex; /* Mutex of the condition waited on */
+#endif
+
   /* CPU load monitoring support ********************************************/
 
 #ifdef CONFIG_SCHED_CPULOAD
   uint32_t ticks;                        /* Number of ticks on this thread */
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  uint32_t tick_start;                   /* Perf count when last accounted */
+#endif
 #endif
 
   /* Pre-emption monitor support ********************************************/
@@ -647,6 +747,10 @@ struct tcb_s
   uint32_t crit_max;                     /* Max time in critical section        */
   uint32_t run_start;                    /* Time when thread begin run          */
   uint32_t run_max;                      /* Max time thread run                 */
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  uint32_t wakeup_start;                 /* Time when made ready-to-run         */
+  uint32_t wakeup_max;                   /* Max time ready-to-run until running */
+#endif
 #endif
 
   /* State save areas *******************************************************/
@@ -772,8 +876,37 @@ extern "C"
 
 EXTERN uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
+
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+/* Histograms of the wakeup latencies per priority band.  Bucket 'n' counts
+ * the latencies in the range [2^n, 2^(n+1)) of up_perf_gettime() counts.
+ */
+
+#define CRITMON_WAKEUP_NBUCKETS 32
+#define CRITMON_WAKEUP_BAND(prio) \
+  ((prio) * CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS / (SCHED_PRIORITY_MAX + 1))
+
+EXTERN uint32_t g_wakeup_hist[CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS]
+                             [CRITMON_WAKEUP_NBUCKETS];
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+/* Number of tasks pulled by the IDLE task of each CPU */
+
+EXTERN uint32_t g_balance_migrations[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+/* Thread creations served (hits) or not (misses) by the TCB cache and the
+ * number of TCBs currently held by it.
+ */
+
+EXTERN uint32_t g_tcbcache_hits;
+EXTERN uint32_t g_tcbcache_misses;
+EXTERN uint16_t g_tcbcache_nentries;
+#endif
+
 #ifdef CONFIG_DEBUG_TCBINFO
 EXTERN const struct tcbinfo_s g_tcbinfo;
 #endif
@@ -1360,6 +1493,70 @@ int nxsched_set_affinity(pid_t pid, size_t cpusetsize,
                          FAR const cpu_set_t *mask);
 #endif
 
+/****************************************************************************
+ * Name: nxsched_smp_call
+ *
+ * Description:
+ *   Run the function 'func' with the argument 'arg' on the CPU 'cpu' and
+ *   wait until it has returned.  The function runs in the SMP call
+ *   interrupt handler of the target CPU, which continues with its current
+ *   task afterwards.  Unlike up_cpu_pause(), the target CPU is not held
+ *   while the caller works; it applies the change itself.
+ *
+ *   The caller must not hold the critical section since the function may
+ *   need to take it.
+ *
+ * Input Parameters:
+ *   cpu  - The index of the target CPU
+ *   func - The function to run on the target CPU
+ *   arg  - The argument passed to the function
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+int nxsched_smp_call(int cpu, nxsched_smp_call_t func, FAR void *arg);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_smp_call_async
+ *
+ * Description:
+ *   Queue the request 'call' (with its func and arg set) for the CPU 'cpu'
+ *   and return without waiting.  A request that is still pending is not
+ *   queued again.  The request is taken off the queue before its function
+ *   runs, so the function must not rely on the memory of the request
+ *   staying valid.
+ *
+ * Input Parameters:
+ *   cpu  - The index of the target CPU
+ *   call - The request to queue
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+int nxsched_smp_call_async(int cpu, FAR struct smp_call_s *call);
+void nxsched_smp_call_cancel(FAR struct smp_call_s *call);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_smp_call_handler
+ *
+ * Description:
+ *   Run all requests queued for this CPU.  This is the handler of the
+ *   inter-processor interrupt raised by up_send_smp_call().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+int nxsched_smp_call_handler(int irq, FAR void *context, FAR void *arg);
+#endif
+
 /****************************************************************************
  * Name: nxsched_get_stackinfo
  *
@@ -1382,6 +1579,27 @@ int nxsched_set_affinity(pid_t pid, size_t cpusetsize,
 
 int nxsched_get_stackinfo(pid_t pid, FAR struct stackinfo_s *stackinfo);
 
+/****************************************************************************
+ * Name: nxsched_bench
+ *
+ * Description:
+ *   Run the benchmarks of the kernel primitives in a thread of priority
+ *   CONFIG_SCHED_BENCH_PRIORITY and wait for their results.  Only one run
+ *   may be in progress at a time.
+ *
+ * Input Parameters:
+ *   results  - The location to return the results
+ *   nresults - The number of entries of results
+ *
+ * Returned Value:
+ *   The number of results on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_BENCH
+int nxsched_bench(FAR struct sched_bench_s *results, int nresults);
+#endif
+
 /****************************************************************************
  * Name: nx_wait/nx_waitid/nx_waitpid
  ****************************************************************************/
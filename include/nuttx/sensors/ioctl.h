@@ -341,4 +341,20 @@
 
 #define SNIOC_GET_USTATE           _SNIOC(0x0092)
 
+/* Command:      SNIOC_GET_RING
+ * Description:  Get the sequence numbers of the circular buffer of data
+ *               mapped by mmap() and the position of the user in it.
+ * Argument:     This is the ring pointer(struct sensor_ring_s)
+ */
+
+#define SNIOC_GET_RING             _SNIOC(0x0093)
+
+/* Command:      SNIOC_ADVANCE
+ * Description:  Consume the samples read in place from the circular
+ *               buffer of data mapped by mmap(), without copying them.
+ * Argument:     The number of samples consumed.
+ */
+
+#define SNIOC_ADVANCE              _SNIOC(0x0094)
+
 #endif /* __INCLUDE_NUTTX_SENSORS_IOCTL_H */
@@ -156,11 +156,14 @@
 #define L3GD20_FIFO_CTRL_FM_0_BM           (1 << 5)
 #define L3GD20_FIFO_CTRL_FM_1_BM           (1 << 6)
 #define L3GD20_FIFO_CTRL_FM_2_BM           (1 << 7)
+#define L3GD20_FIFO_CTRL_WTM_MASK          (0x1f)
 #define L3GD20_FIFO_CTRL_FMODE_BYPASS      (0)
-#define L3GD20_FIFO_CTRL_FMODE_FIFO        (L3GD20_FIFO_CTRL_FM0)
-#define L3GD20_FIFO_CTRL_FMODE_CONT        (L3GD20_FIFO_CTRL_FM1)
-#define L3GD20_FIFO_CTRL_FMODE_CONT_FIFO   (L3GD20_FIFO_CTRL_FM1 | L3GD20_FIFO_CTRL_FM0)
-#define L3GD20_FIFO_CTRL_FMODE_BYPASS_CONT (L3GD20_FIFO_CTRL_FM2 | L3GD20_FIFO_CTRL_FM1)
+#define L3GD20_FIFO_CTRL_FMODE_FIFO        (L3GD20_FIFO_CTRL_FM_0_BM)
+#define L3GD20_FIFO_CTRL_FMODE_CONT        (L3GD20_FIFO_CTRL_FM_1_BM)
+#define L3GD20_FIFO_CTRL_FMODE_CONT_FIFO \
+  (L3GD20_FIFO_CTRL_FM_1_BM | L3GD20_FIFO_CTRL_FM_0_BM)
+#define L3GD20_FIFO_CTRL_FMODE_BYPASS_CONT \
+  (L3GD20_FIFO_CTRL_FM_2_BM | L3GD20_FIFO_CTRL_FM_1_BM)
 
 /* FIFO status control register */
 
@@ -172,6 +175,12 @@
 #define L3GD20_FIFO_SRC_EMPTY_BM           (1 << 5)
 #define L3GD20_FIFO_SRC_OVRUN_BM           (1 << 6)
 #define L3GD20_FIFO_SRC_WTM_BM             (1 << 7)
+#define L3GD20_FIFO_SRC_FSS_MASK           (0x1f)
+
+/* The FIFO holds 32 samples of the 3 axes */
+
+#define L3GD20_FIFO_SIZE                   (32)
+#define L3GD20_FIFO_SAMPLE_SIZE            (6)
 
 /* Gyroscope interrupt configuration */
 
@@ -985,6 +985,24 @@ struct sensor_ustate_s
   unsigned long generation;    /* The recent generation of circular buffer */
 };
 
+/* This structure describes the circular buffer of data mapped by mmap():
+ * The sample of sequence number 'seq' is at offset
+ * (seq % nbuffer) * esize of the mapping and is valid while
+ * tail <= seq < head.
+ */
+
+#ifdef CONFIG_SENSORS_MMAP
+struct sensor_ring_s
+{
+  unsigned long esize;         /* The element size of circular buffer */
+  unsigned long nbuffer;       /* The number of elements of circular buffer */
+  unsigned long head;          /* The sequence number of the next sample */
+  unsigned long tail;          /* The sequence number of the oldest sample */
+  unsigned long pos;           /* The sequence number of the next sample for user */
+  unsigned long generation;    /* The generation of the last sample of user */
+};
+#endif
+
 /* This structure describes the register info for the user sensor */
 
 #ifdef CONFIG_USENSOR
@@ -1010,6 +1028,21 @@ struct sensor_ioctl_s
   char data[1];                /* The argument buf of ioctl */
 };
 
+/* This structure describes the hardware FIFO of a lower half, used by the
+ * sensor_batch_* helpers to choose the FIFO watermark from the requested
+ * batch latency and to give each sample drained from the FIFO its own
+ * timestamp.
+ */
+
+struct sensor_batch_s
+{
+  unsigned long fifosize;      /* The number of samples of the FIFO */
+  unsigned long interval;      /* The sampling interval, in us */
+  unsigned long latency;       /* The batch latency, in us */
+  unsigned long watermark;     /* The number of samples per interrupt */
+  uint64_t      timestamp;     /* The timestamp of the last sample drained */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1180,6 +1213,81 @@ void sensor_rpmsg_unregister(FAR struct sensor_lowerhalf_s *lower);
 int sensor_rpmsg_initialize(void);
 #endif
 
+/****************************************************************************
+ * Name: sensor_batch_init
+ *
+ * Description:
+ *   Initialize the FIFO state of a lower half, out of batch mode.
+ *
+ * Input Parameters:
+ *   batch    - The FIFO state to initialize.
+ *   fifosize - The number of samples that the hardware FIFO holds.
+ *   interval - The initial sampling interval, in us.
+ ****************************************************************************/
+
+void sensor_batch_init(FAR struct sensor_batch_s *batch,
+                       unsigned long fifosize, unsigned long interval);
+
+/****************************************************************************
+ * Name: sensor_batch_interval
+ *
+ * Description:
+ *   Record a new sampling interval, called from set_interval().  The
+ *   watermark is recomputed with the latency it gave before.
+ *
+ * Input Parameters:
+ *   batch    - The FIFO state.
+ *   interval - The new sampling interval, in us.
+ *
+ * Returned Value:
+ *   The number of samples per watermark interrupt.
+ ****************************************************************************/
+
+unsigned long sensor_batch_interval(FAR struct sensor_batch_s *batch,
+                                    unsigned long interval);
+
+/****************************************************************************
+ * Name: sensor_batch_latency
+ *
+ * Description:
+ *   Compute the FIFO watermark from the requested batch latency, called
+ *   from batch().  The latency is rounded down to a whole number of
+ *   samples that fits in the FIFO and returned to the upper half, a
+ *   latency of zero leaves batch mode.
+ *
+ * Input Parameters:
+ *   batch      - The FIFO state.
+ *   latency_us - The requested latency, in us, updated with the latency
+ *                really used.
+ *
+ * Returned Value:
+ *   The number of samples per watermark interrupt, one out of batch mode.
+ ****************************************************************************/
+
+unsigned long sensor_batch_latency(FAR struct sensor_batch_s *batch,
+                                   FAR unsigned long *latency_us);
+
+/****************************************************************************
+ * Name: sensor_batch_period
+ *
+ * Description:
+ *   Estimate the real sampling interval of the samples drained from the
+ *   FIFO in one burst, from the timestamp of the interrupt and of the
+ *   previous burst, so that the sample i of the burst is given the
+ *   timestamp:  now - (count - 1 - i) * period.
+ *
+ * Input Parameters:
+ *   batch - The FIFO state.
+ *   now   - The timestamp of the watermark interrupt, in us.
+ *   count - The number of samples drained.
+ *
+ * Returned Value:
+ *   The interval between the samples drained, in us.
+ ****************************************************************************/
+
+unsigned long sensor_batch_period(FAR struct sensor_batch_s *batch,
+                                  uint64_t now, unsigned long count);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
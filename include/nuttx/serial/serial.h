@@ -87,6 +87,7 @@
 #define uart_txempty(dev)        dev->ops->txempty(dev)
 #define uart_send(dev,ch)        dev->ops->send(dev,ch)
 #define uart_receive(dev,s)      dev->ops->receive(dev,s)
+#define uart_sendbuf(dev,b,l)    dev->ops->sendbuf(dev,b,l)
 
 #ifdef CONFIG_SERIAL_TXDMA
 #define uart_dmasend(dev)      \
@@ -102,6 +103,9 @@
 
 #define uart_dmarxfree(dev)    \
   ((dev)->ops->dmarxfree ? (dev)->ops->dmarxfree(dev) : -ENOSYS)
+
+#define uart_dmarxpos(dev)     \
+  ((dev)->ops->dmarxpos ? (dev)->ops->dmarxpos(dev) : (dev)->recv.head)
 #endif
 
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
@@ -254,6 +258,24 @@ struct uart_ops_s
    */
 
   CODE bool (*txempty)(FAR struct uart_dev_s *dev);
+
+#ifdef CONFIG_SERIAL_RXDMA
+  /* Return the index in the RX buffer at which a circular DMA will write
+   * the next byte.  Only for DMAs started by uart_recvchars_circular().
+   * Last so that the positional initializers of the other drivers leave
+   * it NULL.
+   */
+
+  CODE size_t (*dmarxpos)(FAR struct uart_dev_s *dev);
+#endif
+
+  /* Send up to 'len' bytes, as many as the TX FIFO accepts, and return
+   * how many were sent.  Optional:  Without it, uart_xmitchars() sends one
+   * byte at a time with send().
+   */
+
+  CODE size_t (*sendbuf)(FAR struct uart_dev_s *dev, FAR const char *buf,
+                         size_t len);
 };
 
 /* This is the device structure used by the driver.  The caller of
@@ -484,6 +506,37 @@ void uart_recvchars_dma(FAR uart_dev_t *dev);
 void uart_recvchars_done(FAR uart_dev_t *dev);
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_circular
+ *
+ * Description:
+ *  Set up to receive bytes into the whole RX circular buffer using a DMA
+ *  in circular mode, which the lower half starts in its dmareceive()
+ *  method and does not stop.  The lower half then calls
+ *  uart_recvchars_update() on its half-transfer, transfer-complete and
+ *  idle-line events, and provides the DMA position in dmarxpos().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_circular(FAR uart_dev_t *dev);
+#endif
+
+/****************************************************************************
+ * Name: uart_recvchars_update
+ *
+ * Description:
+ *  Move the head of the RX circular buffer to the position of a circular
+ *  DMA and wake up of any threads that may have been waiting for new data.
+ *  The events must be frequent enough that the DMA does not write a whole
+ *  buffer between two calls.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_update(FAR uart_dev_t *dev);
+#endif
+
 /****************************************************************************
  * Name: uart_reset_sem
  *
@@ -434,6 +434,38 @@
 #  define SPI_TRIGGER(d) \
   (((d)->ops->trigger) ? ((d)->ops->trigger(d)) : -ENOSYS)
 
+/****************************************************************************
+ * Name: SPI_SEQUENCE
+ *
+ * Description:
+ *   Start a whole sequence of transfers (see spi_transfer()), for example
+ *   as chained DMA descriptors, including the selection and de-selection
+ *   of the device, and return without waiting for its completion.  The
+ *   frequency, mode and number of bits of the sequence are already set and
+ *   the bus is locked.  This is an optional method, used by spi_transfer()
+ *   when the lower half provides it.
+ *
+ * Input Parameters:
+ *   dev  - Device-specific state data
+ *   seq  - The sequence of transfers
+ *   done - Called with 'arg' and the result of the sequence when it
+ *          completes, possibly from the interrupt handler.  It is not
+ *          called if SPI_SEQUENCE() fails.
+ *   arg  - The argument of 'done'
+ *
+ * Returned Value:
+ *   OK       - The sequence was started
+ *   -ENOSYS  - The lower half does not support sequences
+ *   -ENOTSUP - The lower half cannot run this sequence, for example
+ *              because of delays between its transfers
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_SEQUENCE
+#  define SPI_SEQUENCE(d,s,c,a) \
+  (((d)->ops->sequence) ? ((d)->ops->sequence(d,s,c,a)) : -ENOSYS)
+#endif
+
 /* SPI Device Macros ********************************************************/
 
 /* This builds a SPI devid from its type and index */
@@ -485,6 +517,13 @@
 
 typedef CODE void (*spi_mediachange_t)(FAR void *arg);
 
+/* The completion of a sequence started with SPI_SEQUENCE() */
+
+#ifdef CONFIG_SPI_SEQUENCE
+struct spi_sequence_s;
+typedef CODE void (*spi_seqdone_t)(FAR void *arg, int result);
+#endif
+
 /* If the board supports multiple SPI devices types, this enumeration
  * identifies which is selected or de-selected.
  * There may be more than one instance of each type on a bus, see below.
@@ -577,6 +616,11 @@ struct spi_ops_s
 #endif
   CODE int      (*registercallback)(FAR struct spi_dev_s *dev,
                   spi_mediachange_t callback, void *arg);
+#ifdef CONFIG_SPI_SEQUENCE
+  CODE int      (*sequence)(FAR struct spi_dev_s *dev,
+                  FAR struct spi_sequence_s *seq, spi_seqdone_t done,
+                  FAR void *arg);
+#endif
 };
 
 /* SPI private data.  This structure only defines the initial fields of the
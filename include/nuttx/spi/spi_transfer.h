@@ -112,6 +112,28 @@ struct spi_sequence_s
   FAR struct spi_trans_s *trans;
 };
 
+#ifdef CONFIG_SPI_QUEUE
+/* A sequence of SPI transactions queued with spi_queue_submit().  The
+ * request belongs to the queue until 'done' is called, on the thread of
+ * the queue, with the result of spi_transfer().
+ */
+
+struct spi_request_s;
+typedef CODE void (*spi_reqdone_t)(FAR struct spi_request_s *req,
+                                   int result);
+
+struct spi_request_s
+{
+  FAR struct spi_request_s *flink; /* Used by the queue */
+  FAR struct spi_sequence_s *seq;  /* The sequence of transfers */
+  uint8_t priority;                /* Higher priorities run first */
+  spi_reqdone_t done;              /* Called when the transfers complete */
+  FAR void *arg;                   /* For the use of 'done' */
+};
+
+struct spi_queue_s;                /* Opaque, one for each SPI bus */
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -161,6 +183,88 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq);
 int spi_register(FAR struct spi_dev_s *spi, int bus);
 #endif
 
+#ifdef CONFIG_SPI_QUEUE
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Create the queue of an SPI bus and start its thread.  All the devices
+ *   on the bus that use the queue share it.
+ *
+ * Input Parameters:
+ *   spi - An instance of the lower half SPI driver
+ *
+ * Returned Value:
+ *   The queue on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct spi_queue_s *spi_queue_initialize(FAR struct spi_dev_s *spi);
+
+/****************************************************************************
+ * Name: spi_queue_uninitialize
+ *
+ * Description:
+ *   Stop the thread of the queue and free it.  The requests still queued
+ *   are completed with -ECANCELED.
+ *
+ ****************************************************************************/
+
+void spi_queue_uninitialize(FAR struct spi_queue_s *queue);
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Queue a request by priority, after the requests of the same priority,
+ *   and return without waiting for it.  This may be called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   req   - The request, with its seq, priority and done set
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_request_s *req);
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a request that is not started yet from the queue.  Its done
+ *   callback is not called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; -EBUSY if it is not in the queue
+ *   any longer.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_request_s *req);
+
+/****************************************************************************
+ * Name: spi_queue_transfer
+ *
+ * Description:
+ *   Queue a sequence of transfers and wait for its completion.  This is
+ *   spi_transfer() for the devices that share the bus with the users of
+ *   the queue.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_queue_transfer(FAR struct spi_queue_s *queue,
+                       FAR struct spi_sequence_s *seq, uint8_t priority);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
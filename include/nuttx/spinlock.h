@@ -81,6 +81,28 @@ typedef uint8_t spinlock_t;
 #  define __SP_UNLOCK_FUNCTION 1
 #endif
 
+/* A ticket spinlock keeps the ticket being served in the low nibble of the
+ * spinlock_t and the next ticket to hand out in the next nibble: It is
+ * unlocked when they are equal.  SP_LOCKED is then the state of a lock
+ * that handed out its first ticket, and the values of up_testset() must
+ * only be compared with SP_UNLOCKED.
+ */
+
+#ifdef CONFIG_TICKET_SPINLOCK
+#  if CONFIG_SMP_NCPUS > 15
+#    error "Ticket spinlocks support up to 15 CPUs"
+#  endif
+
+#  undef  SP_LOCKED
+#  define SP_LOCKED            0x10
+#  define SP_TICKET_OWNER(v)   ((v) & 0x0f)
+#  define SP_TICKET_NEXT(v)    (((v) >> 4) & 0x0f)
+
+#  ifndef __SP_UNLOCK_FUNCTION
+#    define __SP_UNLOCK_FUNCTION 1
+#  endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -301,7 +323,11 @@ void spin_unlock_wo_note(FAR volatile spinlock_t *lock);
  ****************************************************************************/
 
 /* bool spin_islocked(FAR spinlock_t lock); */
-#define spin_islocked(l) (*(l) == SP_LOCKED)
+#ifdef CONFIG_TICKET_SPINLOCK
+#  define spin_islocked(l) (SP_TICKET_OWNER(*(l)) != SP_TICKET_NEXT(*(l)))
+#else
+#  define spin_islocked(l) (*(l) == SP_LOCKED)
+#endif
 
 /****************************************************************************
  * Name: spin_setbit
@@ -425,4 +451,64 @@ void spin_unlock_irqrestore(spinlock_t *lock, irqstate_t flags);
 #  define spin_unlock_irqrestore(l, f) up_irq_restore(f)
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_irqsave_stat
+ *
+ * Description:
+ *   The same as spin_lock_irqsave(), but the acquisition of a named lock is
+ *   accounted in 'stat'.  Without CONFIG_SPINLOCK_STATISTICS, 'stat' is not
+ *   referenced and needs not exist.
+ *
+ * Input Parameters:
+ *   lock - Caller specific spinlock, not NULL.
+ *   stat - The statistics of the lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_stat(lock);
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+/* The statistics of a named lock */
+
+struct spinlock_stat_s
+{
+  FAR struct spinlock_stat_s *flink;     /* Next registered lock */
+  FAR const char *name;                  /* Name of the lock */
+  volatile uint32_t nlocks;              /* Number of acquisitions */
+  volatile uint32_t ncontended;          /* Those that had to spin */
+};
+
+#  define SPINLOCK_STAT_INITIALIZER(n) { NULL, (n), 0, 0 }
+
+irqstate_t spin_lock_irqsave_stat(FAR spinlock_t *lock,
+                                  FAR struct spinlock_stat_s *stat);
+
+/****************************************************************************
+ * Name: spin_stat_register
+ *
+ * Description:
+ *   Make the statistics of a named lock visible in the procfs file
+ *   "locks".  The statistics must stay valid forever.
+ *
+ ****************************************************************************/
+
+void spin_stat_register(FAR struct spinlock_stat_s *stat);
+
+/****************************************************************************
+ * Name: spin_stat_first
+ *
+ * Description:
+ *   Return the first registered lock, the others follow through 'flink'.
+ *   Registered locks are never removed, the list may be walked without
+ *   locking.
+ *
+ ****************************************************************************/
+
+FAR struct spinlock_stat_s *spin_stat_first(void);
+#else
+#  define spin_lock_irqsave_stat(l, s) spin_lock_irqsave(l)
+#endif
+
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
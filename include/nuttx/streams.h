@@ -134,6 +134,16 @@ struct lib_memsostream_s
   size_t                 buflen;  /* Size of the buffer in bytes */
 };
 
+/* This is a stream that operates on a memory buffer that it grows */
+
+struct lib_growoutstream_s
+{
+  struct lib_outstream_s public;
+  FAR char              *buffer;  /* The data, NUL terminated */
+  size_t                 buflen;  /* Size of the buffer in bytes */
+  size_t                 chunk;   /* The buffer grows by multiples of it */
+};
+
 /* These are streams that operate on a FILE */
 
 struct lib_stdinstream_s
@@ -195,9 +205,19 @@ struct lib_lzfoutstream_s
   FAR struct lib_outstream_s *backend;
   lzf_state_t                 state;
   size_t                      offset;
-  char                        in[LZF_STREAM_BLOCKSIZE];
+  char                        in[LZF_TYPE0_HDR_SIZE + LZF_STREAM_BLOCKSIZE];
   char                        out[LZF_MAX_HDR_SIZE + LZF_STREAM_BLOCKSIZE];
 };
+
+struct lib_lzfinstream_s
+{
+  struct lib_instream_s       public;
+  FAR struct lib_instream_s  *backend;
+  size_t                      offset;
+  size_t                      len;
+  char                        in[LZF_MAX_HDR_SIZE + LZF_STREAM_BLOCKSIZE];
+  char                        out[LZF_STREAM_BLOCKSIZE];
+};
 #endif
 
 #ifndef CONFIG_DISABLE_MOUNTPOINT
@@ -258,6 +278,34 @@ void lib_memsistream(FAR struct lib_memsistream_s *instream,
 void lib_memsostream(FAR struct lib_memsostream_s *outstream,
                      FAR char *bufstart, int buflen);
 
+/****************************************************************************
+ * Name: lib_growoutstream
+ *
+ * Description:
+ *   Initializes a stream that writes to a buffer allocated with
+ *   lib_realloc(), which grows by multiples of 'chunk' bytes, at least
+ *   doubling.  The data at outstream->buffer is always NUL terminated
+ *   once something is written; its size is outstream->public.nput.
+ *   Defined in lib/stream/lib_growoutstream.c.
+ *
+ *   The encoders may also write in place: lib_growoutstream_reserve()
+ *   returns the address where the next 'len' bytes go, and
+ *   lib_growoutstream_commit() then appends the 'len' bytes written there.
+ *   lib_growoutstream_detach() gives the buffer to the caller, who frees
+ *   it with lib_free(), and makes the stream empty again.
+ *
+ ****************************************************************************/
+
+void lib_growoutstream(FAR struct lib_growoutstream_s *outstream,
+                       size_t chunk);
+FAR char *
+lib_growoutstream_reserve(FAR struct lib_growoutstream_s *outstream,
+                          size_t len);
+void lib_growoutstream_commit(FAR struct lib_growoutstream_s *outstream,
+                              size_t len);
+FAR char *
+lib_growoutstream_detach(FAR struct lib_growoutstream_s *outstream);
+
 /****************************************************************************
  * Name: lib_stdinstream, lib_stdoutstream
  *
@@ -387,6 +435,29 @@ void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *stream,
                       FAR struct lib_outstream_s *backend);
 #endif
 
+/****************************************************************************
+ * Name: lib_lzfinstream
+ *
+ * Description:
+ *  LZF decompressing pipeline stream.  It reads the blocks written by
+ *  lib_lzfoutstream() from the backend and decompresses them one at a
+ *  time, so that it needs no more memory than two blocks.
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lzfinstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZF
+void lib_lzfinstream(FAR struct lib_lzfinstream_s *stream,
+                     FAR struct lib_instream_s *backend);
+#endif
+
 /****************************************************************************
  * Name: lib_blkoutstream_open
  *
@@ -27,6 +27,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -55,6 +57,23 @@ struct symtab_s
   FAR const void *sym_value;         /* The value associated with the string */
 };
 
+#ifdef CONFIG_SYMTAB_HASH
+/* struct symtab_hash_s is a hash index of a symbol table, in the style of
+ * the GNU hash sections of ELF: The symbols of each bucket are chained in
+ * their order in the table, and their full hashes are kept so that most
+ * of the string compares of the collisions are avoided.
+ */
+
+struct symtab_hash_s
+{
+  FAR const struct symtab_s *symtab; /* The indexed symbol table */
+  FAR uint32_t *hashes;              /* The hash of each symbol name */
+  FAR uint32_t *buckets;             /* 1 + the first symbol of each bucket */
+  FAR uint32_t *chains;              /* 1 + the next symbol of the bucket */
+  uint32_t nbuckets;                 /* The number of buckets, a power of 2 */
+};
+#endif
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -119,6 +138,59 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 void symtab_sortbyname(FAR struct symtab_s *symtab, int nsyms);
 
+#ifdef CONFIG_SYMTAB_HASH
+/****************************************************************************
+ * Name: symtab_hashname
+ *
+ * Description:
+ *   Return the GNU hash of a symbol name: h = h * 33 + c, from 5381.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hashname(FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build the hash index of a symbol table.  The table must not change
+ *   while the index is in use.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the index cannot be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms);
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Free the memory of an index built by symtab_hashinit().
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash);
+
+/****************************************************************************
+ * Name: symtab_hashfind
+ *
+ * Description:
+ *   Find the symbol with the matching name with the hash index.  This
+ *   gives the same result as symtab_findbyname() on the indexed table.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_hashfind(FAR const struct symtab_hash_s *hash, FAR const char *name);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
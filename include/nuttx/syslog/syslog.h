@@ -31,6 +31,7 @@
 
 #include <sys/types.h>
 #include <stdarg.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -117,6 +118,34 @@ struct syslog_channel_s
   /* Implementation specific logic may follow */
 };
 
+#ifdef CONFIG_SYSLOG_BINARY
+/* With CONFIG_SYSLOG_BINARY, each syslog() message is written to the
+ * channels as one such record, in the byte order of the target, instead
+ * of formatted text.  The format string is identified by its address and
+ * the arguments follow in their native sizes, the strings inline with
+ * their NUL terminator.  tools/syslogdecode.py formats the records with
+ * the strings of the ELF file of the image.
+ */
+
+#define SYSLOG_BINARY_MAGIC     0xa5   /* sb_magic of each record */
+#define SYSLOG_BINARY_TRUNCATED 0x80   /* sb_priority: arguments missing */
+#define SYSLOG_BINARY_MAXSIZE   255    /* Maximum size of a record */
+
+begin_packed_struct struct syslog_binary_s
+{
+  uint8_t sb_magic;                    /* SYSLOG_BINARY_MAGIC */
+  uint8_t sb_priority;                 /* Priority, SYSLOG_BINARY_TRUNCATED */
+  uint8_t sb_cpu;                      /* CPU that logged the message */
+  uint8_t sb_length;                   /* Record size, header included */
+  uint8_t sb_ticks[sizeof(uint32_t)];  /* System time in clock ticks */
+  uint8_t sb_fmt[sizeof(uintptr_t)];   /* Address of the format string */
+  uint8_t sb_args[1];                  /* The arguments */
+} end_packed_struct;
+
+#define SIZEOF_SYSLOG_BINARY(n) (sizeof(struct syslog_binary_s) + \
+                                 ((n) - 1) * sizeof(uint8_t))
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -26,6 +26,9 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdint.h>
+
 #include <nuttx/timers/oneshot.h>
 
 /****************************************************************************
@@ -44,6 +47,11 @@ extern "C"
 
 void up_alarm_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower);
 
+#ifdef CONFIG_HRTIMER
+void up_alarm_hrtimer_start(uint64_t expired);
+uint64_t up_alarm_hrtimer_gettime(void);
+#endif
+
 #else
 
 #  define up_alarm_set_lowerhalf(lower)
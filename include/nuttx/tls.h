@@ -204,6 +204,9 @@ struct tls_info_s
 #endif
 
   int tl_errno;                        /* Per-thread error number */
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  pid_t tl_tid;                        /* The thread ID, owner of mutexes */
+#endif
 };
 
 /****************************************************************************
@@ -286,6 +286,12 @@
                                                * Argument: read-only struct
                                                *           fb_planeinfo_s* */
 
+#ifdef CONFIG_FB_PANQUEUE
+#  define FBIOGET_PANSTATUS   _FBIOC(0x0017)  /* Get pan queue status
+                                               * Argument: read/write struct
+                                               *           fb_panstatus_s* */
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -329,6 +335,26 @@ struct fb_planeinfo_s
   uint32_t   yoffset;      /* Offset from virtual to visible resolution */
 };
 
+#ifdef CONFIG_FB_PANQUEUE
+/* This structure reports the progress of the queued FBIOPAN_DISPLAY
+ * requests.  The pan request number N is displayed when displayed - N is
+ * not negative (as a signed 32-bit value), so the requests numbers serve
+ * as fences.  xoffset and yoffset select the buffer whose age is returned.
+ */
+
+struct fb_panstatus_s
+{
+  uint32_t   submitted;    /* Number of the pan requests submitted */
+  uint32_t   displayed;    /* Number of the pan requests displayed */
+  uint32_t   xoffset;      /* In: Horizontal offset of the buffer */
+  uint32_t   yoffset;      /* In: Vertical offset of the buffer */
+  uint32_t   age;          /* Out: The buffer holds the frame submitted
+                            * age requests ago (1 for the last one); 0 if
+                            * the buffer was never submitted.
+                            */
+};
+#endif
+
 /* This structure describes an area. */
 
 struct fb_area_s
@@ -591,7 +617,10 @@ struct fb_vtable_s
 # endif
 #endif
 
-  /* Pan display for multiple buffers. */
+  /* Pan display for multiple buffers.  With CONFIG_FB_PANQUEUE, this
+   * only latches the buffer for the next vertical sync, and the driver
+   * calls fb_pandisplay_done() once the buffer is scanned out.
+   */
 
   int (*pandisplay)(FAR struct fb_vtable_s *vtable,
                     FAR struct fb_planeinfo_s *pinfo);
@@ -613,6 +642,12 @@ struct fb_vtable_s
   /* Enable/disable panel power (0: full off). */
 
   int (*setpower)(FAR struct fb_vtable_s *vtable, int power);
+
+#ifdef CONFIG_FB_PANQUEUE
+  /* Set by fb_register(), for use by fb_pandisplay_done() */
+
+  FAR void *priv;
+#endif
 };
 
 /****************************************************************************
@@ -721,6 +756,28 @@ void up_fbuninitialize(int display);
 
 int fb_register(int display, int plane);
 
+/****************************************************************************
+ * Name: fb_pandisplay_done
+ *
+ * Description:
+ *   Called by the framebuffer driver, typically from its vertical sync
+ *   interrupt handler, when the buffer of the last pandisplay() request is
+ *   scanned out.  The next queued request, if any, is passed to
+ *   pandisplay() and the pollers waiting for room in the queue are
+ *   notified.
+ *
+ * Input Parameters:
+ *   vtable - The framebuffer registered with fb_register()
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANQUEUE
+void fb_pandisplay_done(FAR struct fb_vtable_s *vtable);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
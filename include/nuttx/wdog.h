@@ -71,12 +71,22 @@ typedef CODE void (*wdentry_t)(wdparm_t arg);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  FAR struct wdog_s *prev;       /* And doubly linked lists */
+#endif
   wdparm_t           arg;        /* Callback argument */
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t            expired;    /* Time when the delay expires */
+#else
   sclock_t           lag;        /* Timer associated with the delay */
+#endif
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  sclock_t           slack;      /* Ticks that the expiration may be late */
+#endif
 };
 
 /****************************************************************************
@@ -130,6 +140,36 @@ extern "C"
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg);
 
+/****************************************************************************
+ * Name: wd_start_slack
+ *
+ * Description:
+ *   This function is the same as wd_start() but lets the watchdog expire
+ *   up to 'slack' ticks late.  The interval timer is then programmed for
+ *   the latest time that serves all the watchdogs within their slacks, so
+ *   that nearby expirations are handled by a single timer interrupt.
+ *   Without CONFIG_SCHED_TIMER_SLACK, the slack is ignored.
+ *
+ * Input Parameters:
+ *   wdog     - Watchdog ID
+ *   delay    - Delay count in clock ticks
+ *   slack    - The allowed delay of the expiration in clock ticks
+ *   wdentry  - Function to call on timeout
+ *   arg      - Parameter to pass to wdentry.
+ *
+ * Returned Value:
+ *   See wd_start().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+int wd_start_slack(FAR struct wdog_s *wdog, sclock_t delay, sclock_t slack,
+                   wdentry_t wdentry, wdparm_t arg);
+#else
+#  define wd_start_slack(wdog, delay, slack, wdentry, arg) \
+     wd_start(wdog, delay, wdentry, arg)
+#endif
+
 /****************************************************************************
  * Name: wd_cancel
  *
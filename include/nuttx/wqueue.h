@@ -81,6 +81,8 @@
  *   user-mode work queue will be created.
  * CONFIG_LIBC_USRWORKPRIORITY - The minimum execution priority of the lower
  *   priority worker thread.  Default: 100
+ * CONFIG_LIBC_USRWORKNTHREADS - The number of threads in the user-mode
+ *   queue's thread pool.  Default: 1
  * CONFIG_LIBC_USRWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: 2048.
  */
@@ -238,6 +240,10 @@
 
 typedef CODE void (*worker_t)(FAR void *arg);
 
+/* A kernel work queue created by work_queue_create(), opaque to users */
+
+struct kwork_wqueue_s;
+
 /* Defines one entry in the work queue.  The user only needs this structure
  * in order to declare instances of the work structure.  Handling of all
  * fields is performed by the work APIs
@@ -256,6 +262,13 @@ struct work_s
   } u;
   worker_t  worker;         /* Work callback */
   FAR void *arg;            /* Callback argument */
+
+  /* The kernel work queue of queued work */
+
+  FAR struct kwork_wqueue_s *wq;
+#ifdef CONFIG_WQUEUE_PRIORITY
+  uint8_t   prio;           /* See work_setpriority() */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
@@ -363,6 +376,59 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_create
+ *
+ * Description:
+ *   Create a kernel work queue served by its own pool of worker threads.
+ *   This lets a class of clients, such as the storage drivers, keep slow
+ *   work away from the latency sensitive work of the shared queues.  The
+ *   work queue exists until the system is reset.
+ *
+ * Input Parameters:
+ *   name       - Name of the worker threads
+ *   priority   - Priority of the worker threads
+ *   stack_size - Stack size of each worker thread
+ *   nthreads   - Number of worker threads
+ *
+ * Returned Value:
+ *   The work queue to be used with work_queue_wq() and work_cancel_wq() on
+ *   success; NULL on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
+                                             int priority, int stack_size,
+                                             int nthreads);
+#endif
+
+/****************************************************************************
+ * Name: work_queue_wq
+ *
+ * Description:
+ *   Queue work to be performed on a work queue created by
+ *   work_queue_create().  See work_queue().
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.
+ *   arg    - The argument that will be passed to the worker callback.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -385,6 +451,29 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
 int work_cancel(int qid, FAR struct work_s *work);
 
+/****************************************************************************
+ * Name: work_cancel_wq
+ *
+ * Description:
+ *   Cancel work previously queued with work_queue_wq().
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The previously queued work structure to cancel
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ *   -ENOENT - There is no such work queued.
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work);
+#endif
+
 /****************************************************************************
  * Name: work_foreach
  *
@@ -421,6 +510,29 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_setpriority
+ *
+ * Description:
+ *   Set the priority of the work.  Work is performed before any pending
+ *   work of lower priority in the same work queue, work of the same
+ *   priority in the order in which it was queued.  The priority of work
+ *   that is zero-initialized is zero.  The priority applies the next time
+ *   that the work is queued.
+ *
+ * Input Parameters:
+ *   work - The work queue structure.
+ *   prio - The priority, higher values are performed first.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WQUEUE_PRIORITY
+#  define work_setpriority(work, p) ((work)->prio = (uint8_t)(p))
+#endif
+
 /****************************************************************************
  * Name: work_timeleft
  *
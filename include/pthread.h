@@ -307,6 +307,9 @@ struct pthread_mutex_s
   uint8_t type;     /* Type of the mutex.  See PTHREAD_MUTEX_* definitions */
   int16_t nlocks;   /* The number of recursive locks held */
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  volatile uint32_t futex; /* 0: unlocked, 1: locked, 2: locked, contended */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEX_T_DEFINED
@@ -369,6 +372,14 @@ typedef bool pthread_once_t;
 #define __PTHREAD_ONCE_T_DEFINED 1
 #endif
 
+#ifdef CONFIG_PTHREAD_RWLOCK_FUTEX
+struct pthread_rwlock_s
+{
+  volatile uint32_t state; /* Readers, waiting writers and lock flags */
+  volatile uint32_t rseq;  /* The futex that the readers wait on */
+  volatile uint32_t wseq;  /* The futex that the writers wait on */
+};
+#else
 struct pthread_rwlock_s
 {
   pthread_mutex_t lock;
@@ -377,14 +388,19 @@ struct pthread_rwlock_s
   unsigned int num_writers;
   bool write_in_progress;
 };
+#endif
 
 typedef struct pthread_rwlock_s pthread_rwlock_t;
 
 typedef int pthread_rwlockattr_t;
 
-#define PTHREAD_RWLOCK_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER, \
-                                     PTHREAD_COND_INITIALIZER, \
-                                     0, 0, false}
+#ifdef CONFIG_PTHREAD_RWLOCK_FUTEX
+#  define PTHREAD_RWLOCK_INITIALIZER {0, 0, 0}
+#else
+#  define PTHREAD_RWLOCK_INITIALIZER {PTHREAD_MUTEX_INITIALIZER, \
+                                      PTHREAD_COND_INITIALIZER, \
+                                      0, 0, false}
+#endif
 
 #ifdef CONFIG_PTHREAD_SPINLOCKS
 /* This (non-standard) structure represents a pthread spinlock */
@@ -112,6 +112,30 @@ struct va_format
   FAR va_list *va;
 };
 
+/* The functions of a stream created by fopencookie().  They follow the
+ * conventions of read(), write(), lseek() and close(), except that seek
+ * returns the new offset in *offset and zero on success.  A NULL read or
+ * write fails the reads or ignores the writes, and a NULL seek fails the
+ * seeks.
+ */
+
+typedef CODE ssize_t cookie_read_function_t(FAR void *cookie,
+                                            FAR char *buf, size_t size);
+typedef CODE ssize_t cookie_write_function_t(FAR void *cookie,
+                                             FAR const char *buf,
+                                             size_t size);
+typedef CODE int cookie_seek_function_t(FAR void *cookie,
+                                        FAR off_t *offset, int whence);
+typedef CODE int cookie_close_function_t(FAR void *cookie);
+
+typedef struct
+{
+  FAR cookie_read_function_t  *read;
+  FAR cookie_write_function_t *write;
+  FAR cookie_seek_function_t  *seek;
+  FAR cookie_close_function_t *close;
+} cookie_io_functions_t;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -140,14 +164,18 @@ int    feof(FAR FILE *stream);
 int    ferror(FAR FILE *stream);
 int    fileno(FAR FILE *stream);
 int    fgetc(FAR FILE *stream);
+int    fgetc_unlocked(FAR FILE *stream);
 int    fgetpos(FAR FILE *stream, FAR fpos_t *pos);
 FAR char *fgets(FAR char *s, int n, FAR FILE *stream);
 FAR FILE *fopen(FAR const char *path, FAR const char *type);
 int    fprintf(FAR FILE *stream, FAR const IPTR char *format, ...)
        printflike(2, 3);
 int    fputc(int c, FAR FILE *stream);
+int    fputc_unlocked(int c, FAR FILE *stream);
 int    fputs(FAR const IPTR char *s, FAR FILE *stream);
 size_t fread(FAR void *ptr, size_t size, size_t n_items, FAR FILE *stream);
+size_t fread_unlocked(FAR void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
 FAR FILE *freopen(FAR const char *path, FAR const char *mode,
          FAR FILE *stream);
 int    fscanf(FAR FILE *stream, FAR const IPTR char *fmt, ...)
@@ -159,8 +187,12 @@ long   ftell(FAR FILE *stream);
 off_t  ftello(FAR FILE *stream);
 size_t fwrite(FAR const void *ptr, size_t size, size_t n_items,
          FAR FILE *stream);
+size_t fwrite_unlocked(FAR const void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
 int     getc(FAR FILE *stream);
+int     getc_unlocked(FAR FILE *stream);
 int     getchar(void);
+int     getchar_unlocked(void);
 ssize_t getdelim(FAR char **lineptr, size_t *n, int delimiter,
          FAR FILE *stream);
 ssize_t getline(FAR char **lineptr, size_t *n, FAR FILE *stream);
@@ -168,6 +200,10 @@ FAR char *gets(FAR char *s);
 FAR char *gets_s(FAR char *s, rsize_t n);
 void   rewind(FAR FILE *stream);
 
+void   flockfile(FAR FILE *stream);
+int    ftrylockfile(FAR FILE *stream);
+void   funlockfile(FAR FILE *stream);
+
 void   setbuf(FAR FILE *stream, FAR char *buf);
 int    setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size);
 
@@ -180,7 +216,9 @@ int    ungetc(int c, FAR FILE *stream);
 void   perror(FAR const char *s);
 int    printf(FAR const IPTR char *fmt, ...) printflike(1, 2);
 int    putc(int c, FAR FILE *stream);
+int    putc_unlocked(int c, FAR FILE *stream);
 int    putchar(int c);
+int    putchar_unlocked(int c);
 int    puts(FAR const IPTR char *s);
 int    rename(FAR const char *oldpath, FAR const char *newpath);
 int    sprintf(FAR char *buf, FAR const IPTR char *fmt, ...)
@@ -220,6 +258,13 @@ int    dprintf(int fd, FAR const IPTR char *fmt, ...) printflike(2, 3);
 int    vdprintf(int fd, FAR const IPTR char *fmt, va_list ap)
        printflike(2, 0);
 
+/* Operations on memory and on user defined streams */
+
+FAR FILE *fopencookie(FAR void *cookie, FAR const char *mode,
+                      cookie_io_functions_t io_funcs);
+FAR FILE *fmemopen(FAR void *buf, size_t size, FAR const char *mode);
+FAR FILE *open_memstream(FAR char **bufp, FAR size_t *sizep);
+
 /* Operations on paths */
 
 FAR FILE *tmpfile(void);
@@ -97,6 +97,13 @@ typedef unsigned int nfds_t;
 
 typedef uint32_t pollevent_t;
 
+/* The callback a notifier may run instead of posting the semaphore of a
+ * pollfd, see poll_notify().
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the NuttX variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -119,6 +126,8 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  FAR void    *arg;     /* The argument of the callback */
+  pollcb_t     cb;      /* Run by poll_notify() in place of posting sem */
 };
 
 /****************************************************************************
@@ -67,12 +67,27 @@
  *
  *      char myname[CONFIG_TASK_NAME_SIZE];
  *      prctl(PR_GET_NAME_EXT, myname, pid);
+ *
+ *  PR_SET_TIMERSLACK
+ *    Set the timer slack of the calling thread to the value of required
+ *    arg2 (unsigned long), in nanoseconds.  The sleeps and timed signal
+ *    waits of the thread may end up to this much late, so that their
+ *    wake-ups can be coalesced.  Zero makes them exact.  Requires
+ *    CONFIG_SCHED_TIMER_SLACK.  As an example:
+ *
+ *      prctl(PR_SET_TIMERSLACK, 50000);
+ *
+ *  PR_GET_TIMERSLACK
+ *    Return the timer slack of the calling thread in nanoseconds, as the
+ *    returned value of prctl().
  */
 
-#define PR_SET_NAME     1
-#define PR_GET_NAME     2
-#define PR_SET_NAME_EXT 3
-#define PR_GET_NAME_EXT 4
+#define PR_SET_NAME       1
+#define PR_GET_NAME       2
+#define PR_SET_NAME_EXT   3
+#define PR_GET_NAME_EXT   4
+#define PR_SET_TIMERSLACK 5
+#define PR_GET_TIMERSLACK 6
 
 /****************************************************************************
  * Public Type Definitions
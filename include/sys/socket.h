@@ -125,6 +125,10 @@
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
 
+/* recvmmsg(): Only the first message may block. */
+
+#define MSG_WAITFORONE 0x10000
+
 /* Protocol levels supported by get/setsockopt(): */
 
 #define SOL_SOCKET       1 /* Only socket-level options supported */
@@ -202,6 +206,12 @@
                             */
 #define SO_BINDTODEVICE 17 /* Bind this socket to a specific network device.
                             */
+#define SO_REUSEPORT    18 /* Allow several sockets to bind the same local
+                            * address and port, incoming connections and
+                            * datagrams are distributed among them (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -324,6 +334,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* One message of recvmmsg() and sendmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* Number of bytes transmitted */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -361,6 +379,8 @@ static inline FAR struct cmsghdr *cmsg_nxthdr(FAR struct msghdr *__msg,
  * Public Function Prototypes
  ****************************************************************************/
 
+struct timespec; /* Forward reference */
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -401,6 +421,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -65,6 +65,18 @@ enum
 #  undef SYSCALL_LOOKUP
 };
 
+/* One call of syscall_batch(): The number of the system call, SYS_xxx,
+ * its parameters, and the return value of the call when it is done.  The
+ * unused parameters are ignored.
+ */
+
+struct syscall_batch_s
+{
+  uintptr_t nbr;
+  uintptr_t parm[6];
+  uintptr_t result;
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -99,6 +111,32 @@ EXTERN const char *g_funcnames[SYS_nsyscalls];
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: syscall_batch
+ *
+ * Description:
+ *   Run the system calls of an array, in order, with a single trap into
+ *   the kernel.  This saves the cost of the trap for the small calls that
+ *   an application makes in a row, such as a sem_post() after a write().
+ *   The return value of each call is stored in its result field.  The
+ *   errno of a call that fails is overwritten by the next one that fails.
+ *
+ * Input Parameters:
+ *   calls  - The array of calls
+ *   ncalls - The number of calls in the array
+ *
+ * Returned Value:
+ *   The number of calls run.  If a call has an invalid number, or is one
+ *   that cannot run in a batch (syscall_batch() itself and vfork()), the
+ *   calls after it are not run and the errno is set to ENOSYS.  ERROR is
+ *   returned if no call could run.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSCALL_BATCH
+int syscall_batch(FAR struct syscall_batch_s *calls, int ncalls);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
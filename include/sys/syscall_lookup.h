@@ -55,6 +55,10 @@ SYSCALL_LOOKUP(nxsched_get_stackinfo,      2)
 
 SYSCALL_LOOKUP(sysinfo,                    1)
 
+#ifdef CONFIG_SYSCALL_BATCH
+  SYSCALL_LOOKUP(syscall_batch,            2)
+#endif
+
 SYSCALL_LOOKUP(gethostname,                2)
 SYSCALL_LOOKUP(sethostname,                2)
 
@@ -167,7 +171,9 @@ SYSCALL_LOOKUP(clock_nanosleep,            4)
 
 SYSCALL_LOOKUP(clock,                      0)
 SYSCALL_LOOKUP(clock_getres,               2)
-SYSCALL_LOOKUP(clock_gettime,              2)
+#ifndef CONFIG_CLOCK_VDATA
+  SYSCALL_LOOKUP(clock_gettime,            2)
+#endif
 SYSCALL_LOOKUP(clock_settime,              2)
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   SYSCALL_LOOKUP(adjtime,                  2)
@@ -199,6 +205,8 @@ SYSCALL_LOOKUP(read,                       3)
 SYSCALL_LOOKUP(write,                      3)
 SYSCALL_LOOKUP(pread,                      4)
 SYSCALL_LOOKUP(pwrite,                     4)
+SYSCALL_LOOKUP(readv,                      3)
+SYSCALL_LOOKUP(writev,                     3)
 #ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1)
   SYSCALL_LOOKUP(aio_write,                1)
@@ -249,6 +257,7 @@ SYSCALL_LOOKUP(lutimens,                   2)
 SYSCALL_LOOKUP(futimens,                   2)
 
 #if defined(CONFIG_FS_RAMMAP)
+  SYSCALL_LOOKUP(msync,                    3)
   SYSCALL_LOOKUP(munmap,                   2)
 #endif
 
@@ -305,8 +314,13 @@ SYSCALL_LOOKUP(futimens,                   2)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1)
   SYSCALL_LOOKUP(pthread_mutex_init,       2)
   SYSCALL_LOOKUP(pthread_mutex_timedlock,  2)
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  SYSCALL_LOOKUP(futex_wait,               3)
+  SYSCALL_LOOKUP(futex_wake,               2)
+#else
   SYSCALL_LOOKUP(pthread_mutex_trylock,    1)
   SYSCALL_LOOKUP(pthread_mutex_unlock,     1)
+#endif
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1)
 #endif
@@ -360,9 +374,11 @@ SYSCALL_LOOKUP(futimens,                   2)
   SYSCALL_LOOKUP(recv,                     4)
   SYSCALL_LOOKUP(recvfrom,                 6)
   SYSCALL_LOOKUP(recvmsg,                  3)
+  SYSCALL_LOOKUP(recvmmsg,                 5)
   SYSCALL_LOOKUP(send,                     4)
   SYSCALL_LOOKUP(sendto,                   6)
   SYSCALL_LOOKUP(sendmsg,                  3)
+  SYSCALL_LOOKUP(sendmmsg,                 4)
   SYSCALL_LOOKUP(setsockopt,               5)
   SYSCALL_LOOKUP(socket,                   3)
   SYSCALL_LOOKUP(socketpair,               4)
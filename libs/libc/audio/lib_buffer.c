@@ -168,4 +168,34 @@ void apb_reference(FAR struct ap_buffer_s *apb)
   apb_semgive(apb);
 }
 
+/****************************************************************************
+ * Name: apb_pool_dequeue
+ *
+ * Take the next buffer returned by the driver from a pool allocated with
+ * AUDIOIOC_ALLOCPOOL, without blocking.  Returns NULL if there is none;
+ * poll the audio device for POLLIN to wait for one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_AUDIO_BUFFER_POOL
+FAR struct ap_buffer_s *apb_pool_dequeue(FAR struct audio_pool_s *pool)
+{
+  FAR struct ap_buffer_s *apb;
+  uint32_t tail = pool->tail;
+
+  if (tail == pool->head)
+    {
+      return NULL;
+    }
+
+  /* Only the driver writes head and only the application writes tail, so
+   * no lock is needed.
+   */
+
+  apb = pool->apb[pool->done[tail % pool->nbuffers]];
+  pool->tail = tail + 1;
+  return apb;
+}
+#endif
+
 #endif /* CONFIG_AUDIO */
@@ -0,0 +1,325 @@
+/****************************************************************************
+ * libs/libc/audio/lib_dsp.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/audio/audio_dsp.h>
+
+#if defined(CONFIG_AUDIO_DSP_SIMD) && defined(__ARM_FEATURE_MVE) && \
+    (__ARM_FEATURE_MVE & 1) != 0
+#  include <arm_mve.h>
+#  define AUDIO_DSP_VECTOR 1
+#elif defined(CONFIG_AUDIO_DSP_SIMD) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define AUDIO_DSP_VECTOR 1
+#elif defined(CONFIG_AUDIO_DSP_SIMD) && defined(__ARM_FEATURE_SIMD32)
+#  include <arm_acle.h>
+#  define AUDIO_DSP_SIMD32 1
+#endif
+
+#ifdef CONFIG_AUDIO_DSP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of 16 bit samples in a vector register of Helium and NEON */
+
+#define AUDIO_DSP_LANES 8
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_dsp_sat16
+ ****************************************************************************/
+
+static inline int16_t audio_dsp_sat16(int32_t value)
+{
+  if (value > INT16_MAX)
+    {
+      return INT16_MAX;
+    }
+  else if (value < INT16_MIN)
+    {
+      return INT16_MIN;
+    }
+
+  return (int16_t)value;
+}
+
+/****************************************************************************
+ * Name: audio_dsp_accumulate
+ *
+ * Description:
+ *   Add the samples of src to dst with saturation.
+ *
+ ****************************************************************************/
+
+static void audio_dsp_accumulate(FAR int16_t *dst, FAR const int16_t *src,
+                                 size_t nsamples)
+{
+  size_t i = 0;
+
+#if defined(AUDIO_DSP_VECTOR)
+  for (; i + AUDIO_DSP_LANES <= nsamples; i += AUDIO_DSP_LANES)
+    {
+      vst1q_s16(&dst[i], vqaddq_s16(vld1q_s16(&dst[i]),
+                                    vld1q_s16(&src[i])));
+    }
+#elif defined(AUDIO_DSP_SIMD32)
+  for (; i + 2 <= nsamples; i += 2)
+    {
+      int16x2_t a;
+      int16x2_t b;
+
+      /* memcpy() lets the compiler use unaligned word accesses */
+
+      memcpy(&a, &dst[i], sizeof(a));
+      memcpy(&b, &src[i], sizeof(b));
+      a = __qadd16(a, b);
+      memcpy(&dst[i], &a, sizeof(a));
+    }
+#endif
+
+  for (; i < nsamples; i++)
+    {
+      dst[i] = audio_dsp_sat16((int32_t)dst[i] + src[i]);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: audio_dsp_u8tos16
+ ****************************************************************************/
+
+void audio_dsp_u8tos16(FAR int16_t *dst, FAR const uint8_t *src,
+                       size_t nsamples)
+{
+  size_t i;
+
+  DEBUGASSERT(dst != NULL && src != NULL);
+
+  /* A plain loop, which the compilers vectorize on their own */
+
+  for (i = 0; i < nsamples; i++)
+    {
+      dst[i] = (int16_t)(((int)src[i] - 128) * 256);
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_s16tou8
+ ****************************************************************************/
+
+void audio_dsp_s16tou8(FAR uint8_t *dst, FAR const int16_t *src,
+                       size_t nsamples)
+{
+  size_t i;
+
+  DEBUGASSERT(dst != NULL && src != NULL);
+
+  /* Going forward is safe in place, each sample is written below the ones
+   * that are not read yet.
+   */
+
+  for (i = 0; i < nsamples; i++)
+    {
+      dst[i] = (uint8_t)((src[i] >> 8) + 128);
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_swap16
+ ****************************************************************************/
+
+void audio_dsp_swap16(FAR void *buf, size_t nsamples)
+{
+  FAR uint8_t *ptr = buf;
+  uint8_t tmp;
+  size_t i = 0;
+
+  DEBUGASSERT(buf != NULL || nsamples == 0);
+
+#ifdef AUDIO_DSP_VECTOR
+  for (; i + AUDIO_DSP_LANES <= nsamples; i += AUDIO_DSP_LANES)
+    {
+      vst1q_u8(&ptr[2 * i], vrev16q_u8(vld1q_u8(&ptr[2 * i])));
+    }
+#endif
+
+  for (; i < nsamples; i++)
+    {
+      tmp            = ptr[2 * i];
+      ptr[2 * i]     = ptr[2 * i + 1];
+      ptr[2 * i + 1] = tmp;
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_interleave
+ ****************************************************************************/
+
+void audio_dsp_interleave(FAR int16_t *dst,
+                          FAR const int16_t * FAR const *src,
+                          unsigned int nchannels, size_t nframes)
+{
+  unsigned int ch;
+  size_t i;
+
+  DEBUGASSERT(dst != NULL && src != NULL);
+
+  /* Stereo is the common case, give it a loop of its own */
+
+  if (nchannels == 2)
+    {
+      FAR const int16_t *left  = src[0];
+      FAR const int16_t *right = src[1];
+
+      for (i = 0; i < nframes; i++)
+        {
+          dst[2 * i]     = left[i];
+          dst[2 * i + 1] = right[i];
+        }
+
+      return;
+    }
+
+  for (ch = 0; ch < nchannels; ch++)
+    {
+      FAR const int16_t *in = src[ch];
+      FAR int16_t *out = &dst[ch];
+
+      for (i = 0; i < nframes; i++)
+        {
+          *out = in[i];
+          out += nchannels;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_deinterleave
+ ****************************************************************************/
+
+void audio_dsp_deinterleave(FAR int16_t * FAR const *dst,
+                            FAR const int16_t *src,
+                            unsigned int nchannels, size_t nframes)
+{
+  unsigned int ch;
+  size_t i;
+
+  DEBUGASSERT(dst != NULL && src != NULL);
+
+  if (nchannels == 2)
+    {
+      FAR int16_t *left  = dst[0];
+      FAR int16_t *right = dst[1];
+
+      for (i = 0; i < nframes; i++)
+        {
+          left[i]  = src[2 * i];
+          right[i] = src[2 * i + 1];
+        }
+
+      return;
+    }
+
+  for (ch = 0; ch < nchannels; ch++)
+    {
+      FAR const int16_t *in = &src[ch];
+      FAR int16_t *out = dst[ch];
+
+      for (i = 0; i < nframes; i++)
+        {
+          out[i] = *in;
+          in    += nchannels;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_gain
+ ****************************************************************************/
+
+void audio_dsp_gain(FAR int16_t *dst, FAR const int16_t *src,
+                    int16_t gain, size_t nsamples)
+{
+  size_t i = 0;
+
+  DEBUGASSERT(dst != NULL && src != NULL);
+
+  /* The rounding doubling multiply gives the same results as the scalar
+   * loop: (src * gain + 2^14) >> 15, saturated.
+   */
+
+#ifdef AUDIO_DSP_VECTOR
+  for (; i + AUDIO_DSP_LANES <= nsamples; i += AUDIO_DSP_LANES)
+    {
+      vst1q_s16(&dst[i], vqrdmulhq_n_s16(vld1q_s16(&src[i]), gain));
+    }
+#endif
+
+  for (; i < nsamples; i++)
+    {
+      dst[i] = audio_dsp_sat16(((int32_t)src[i] * gain + 0x4000) >> 15);
+    }
+}
+
+/****************************************************************************
+ * Name: audio_dsp_mix
+ ****************************************************************************/
+
+void audio_dsp_mix(FAR int16_t *dst, FAR const int16_t * FAR const *src,
+                   unsigned int nsrc, size_t nsamples)
+{
+  unsigned int k;
+
+  DEBUGASSERT(dst != NULL && (src != NULL || nsrc == 0));
+
+  if (nsrc == 0)
+    {
+      memset(dst, 0, nsamples * sizeof(int16_t));
+      return;
+    }
+
+  if (dst != src[0])
+    {
+      memcpy(dst, src[0], nsamples * sizeof(int16_t));
+    }
+
+  for (k = 1; k < nsrc; k++)
+    {
+      audio_dsp_accumulate(dst, src[k], nsamples);
+    }
+}
+
+#endif /* CONFIG_AUDIO_DSP */
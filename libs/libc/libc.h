@@ -53,6 +53,11 @@
 
 #define LIB_BUFLEN_UNKNOWN INT_MAX
 
+/* A stream is open if it has a file descriptor or a cookie */
+
+#define lib_stream_isopen(s) \
+  ((s)->fs_fd >= 0 || ((s)->fs_flags & __FS_FLAG_COOKIE) != 0)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -92,13 +97,26 @@ FAR char *__dtoa(double d, int mode, int ndigits, FAR int *decpt,
 
 int lib_mode2oflags(FAR const char *mode);
 
+/* Defined in lib_fopencookie.c */
+
+#ifdef CONFIG_FILE_STREAM
+ssize_t lib_stream_read(FAR FILE *stream, FAR void *buf, size_t size);
+ssize_t lib_stream_write(FAR FILE *stream, FAR const void *buf,
+                         size_t size);
+off_t lib_stream_seek(FAR FILE *stream, off_t offset, int whence);
+int lib_stream_close(FAR FILE *stream);
+#endif
+
 /* Defined in lib_libfwrite.c */
 
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfgets.c */
 
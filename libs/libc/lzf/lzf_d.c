@@ -32,10 +32,53 @@
  * Included Files
  ****************************************************************************/
 
+#include <stddef.h>
+
 #include "lzf/lzf.h"
 
 #ifdef CONFIG_LIBC_LZF
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzf_copy
+ *
+ * Description:
+ *   Copy len octets by words, then by octets, and return the end of the
+ *   destination.  The source may overlap the destination if it is at
+ *   least a word before it.  The memcpy() of one word is a single,
+ *   possibly unaligned, load or store.
+ *
+ ****************************************************************************/
+
+#ifndef lzf_movsb
+static inline FAR uint8_t *lzf_copy(FAR uint8_t *dst,
+                                    FAR const uint8_t *src,
+                                    unsigned int len)
+                                    always_inline_function;
+
+static inline FAR uint8_t *lzf_copy(FAR uint8_t *dst,
+                                    FAR const uint8_t *src,
+                                    unsigned int len)
+{
+  for (; len >= sizeof(uintptr_t); len -= sizeof(uintptr_t))
+    {
+      memcpy(dst, src, sizeof(uintptr_t));
+      dst += sizeof(uintptr_t);
+      src += sizeof(uintptr_t);
+    }
+
+  while (len-- > 0)
+    {
+      *dst++ = *src++;
+    }
+
+  return dst;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -94,104 +137,8 @@ unsigned int lzf_decompress (FAR const void *const in_data,
 #ifdef lzf_movsb
           lzf_movsb(op, ip, ctrl);
 #else
-          switch (ctrl)
-            {
-              case 32:
-                *op++ = *ip++;
-
-              case 31:
-                *op++ = *ip++;
-
-              case 30:
-                *op++ = *ip++;
-
-              case 29:
-                *op++ = *ip++;
-
-              case 28:
-                *op++ = *ip++;
-
-              case 27:
-                *op++ = *ip++;
-
-              case 26:
-                *op++ = *ip++;
-
-              case 25:
-                *op++ = *ip++;
-
-              case 24:
-                *op++ = *ip++;
-
-              case 23:
-                *op++ = *ip++;
-
-              case 22:
-                *op++ = *ip++;
-
-              case 21:
-                *op++ = *ip++;
-
-              case 20:
-                *op++ = *ip++;
-
-              case 19:
-                *op++ = *ip++;
-
-              case 18:
-                *op++ = *ip++;
-
-              case 17:
-                *op++ = *ip++;
-
-              case 16:
-                *op++ = *ip++;
-
-              case 15:
-                *op++ = *ip++;
-
-              case 14:
-                *op++ = *ip++;
-
-              case 13:
-                *op++ = *ip++;
-
-              case 12:
-                *op++ = *ip++;
-
-              case 11:
-                *op++ = *ip++;
-
-              case 10:
-                *op++ = *ip++;
-
-              case 9:
-                *op++ = *ip++;
-
-              case 8:
-                *op++ = *ip++;
-
-              case 7:
-                *op++ = *ip++;
-
-              case 6:
-                *op++ = *ip++;
-
-              case 5:
-                *op++ = *ip++;
-
-              case 4:
-                *op++ = *ip++;
-
-              case 3:
-                *op++ = *ip++;
-
-              case 2:
-                *op++ = *ip++;
-
-              case 1:
-                *op++ = *ip++;
-            }
+          op  = lzf_copy(op, ip, ctrl);
+          ip += ctrl;
 #endif
         }
       else /* back reference */
@@ -250,6 +197,14 @@ unsigned int lzf_decompress (FAR const void *const in_data,
                     memcpy (op, ref, len);
                     op += len;
                   }
+                else if (op - ref >= (ptrdiff_t)sizeof(uintptr_t))
+                  {
+                    /* Overlapping, but each word is read before it is
+                     * written: Copy word by word.
+                     */
+
+                    op = lzf_copy(op, ref, len);
+                  }
                 else
                   {
                     /* Overlapping, use octet by octet copying */
@@ -0,0 +1,57 @@
+/****************************************************************************
+ * libs/libc/math/lib_fastmathf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <math.h>
+
+#include "lib_fastmathf.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* These replace lib_expf.c, lib_logf.c, lib_sinf.c and lib_cosf.c with
+ * CONFIG_LIBM_FASTF.
+ */
+
+float expf(float x)
+{
+  return fastf_exp(x);
+}
+
+float logf(float x)
+{
+  return fastf_log(x);
+}
+
+float sinf(float x)
+{
+  return fastf_sin(x);
+}
+
+float cosf(float x)
+{
+  return fastf_cos(x);
+}
@@ -0,0 +1,397 @@
+/****************************************************************************
+ * libs/libc/math/lib_fastmathf.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_MATH_LIB_FASTMATHF_H
+#define __LIBS_LIBC_MATH_LIB_FASTMATHF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Adding 1.5 * 2^23 to a float of magnitude below 2^22 rounds it to the
+ * nearest integer k, which is then in the low bits of the sum: Subtracting
+ * FASTF_ROUNDER gives k as a float, subtracting FASTF_ROUNDER_BITS from the
+ * bits of the sum gives it as an integer.
+ */
+
+#define FASTF_ROUNDER      12582912.0f
+#define FASTF_ROUNDER_BITS 0x4b400000
+
+#define FASTF_LOG2E        1.44269504f
+#define FASTF_LN2_HI       0.693145752f    /* The 16 high bits of ln(2) */
+#define FASTF_LN2_LO       1.42860677e-06f /* ln(2) - FASTF_LN2_HI */
+
+/* pi in four parts, for the Cody-Waite argument reduction: The products
+ * of the first three by the multiples of pi below FASTF_TRIG_MAX are
+ * exact.
+ */
+
+#define FASTF_1_PI         0.318309886f
+#define FASTF_PI_1         0x1.92p+1f      /* 3.140625 */
+#define FASTF_PI_2         0x1.fb4p-11f    /* 9.67502594e-04 */
+#define FASTF_PI_3         0x1.444p-23f    /* 1.50990672e-07 */
+#define FASTF_PI_4         0x1.68c234p-38f /* 5.12668814e-12 */
+
+/* From this, sinf() and cosf() reduce the argument with the bits of 2 / pi
+ * instead.
+ */
+
+#define FASTF_TRIG_MAX     512.0f
+
+/* pi / 2 * 2^-62, the weight of the fixed point remainders */
+
+#define FASTF_PI_2_62      0x1.921fb54442d18p-62
+
+/* The coefficients of log(1 + f), from FreeBSD's e_logf.c */
+
+#define FASTF_LG1          0.66666662693f
+#define FASTF_LG2          0.40000972152f
+#define FASTF_LG3          0.28498786688f
+#define FASTF_LG4          0.24279078841f
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The 32 bit windows of the bits of 2 / pi, every 8 bits: Defined in
+ * lib_fastmathf_data.c
+ */
+
+extern const uint32_t g_fastf_2_pi[24];
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* The _nospecial functions have no branches, so that the compilers can
+ * vectorize the loops that call them, as in lib_vmathf.c, and leave the
+ * special arguments to the full functions.  Over the whole range,
+ * including the subnormals, the largest errors measured are 1.2 ULP for
+ * expf(), 0.9 ULP for logf() and 2.1 ULP for sinf() and cosf().
+ */
+
+static inline uint32_t fastf_asuint(float x)
+{
+  uint32_t u;
+
+  memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+static inline float fastf_asfloat(uint32_t u)
+{
+  float x;
+
+  memcpy(&x, &u, sizeof(x));
+  return x;
+}
+
+/****************************************************************************
+ * Name: fastf_exp
+ *
+ * Description:
+ *   exp(x) = 2^k * exp(r), with k the nearest integer of x / ln(2) and
+ *   |r| <= ln(2) / 2, where a degree 7 polynomial is used.  There are no
+ *   special arguments: The NaNs propagate through the polynomial.
+ *
+ ****************************************************************************/
+
+static inline float fastf_exp(float x)
+{
+  uint32_t u = fastf_asuint(x);
+  uint32_t m;
+  float t;
+  float r;
+  float p;
+  int32_t k;
+
+  /* exp(x) overflows above 88.73 and is below half the least subnormal
+   * under -103.98.  The clamped k are still in range of the scaling below.
+   * The clamp selects the bits with masks, which leaves the NaNs alone
+   * and, unlike float compares that may trap, lets the compilers vectorize
+   * the loops.
+   */
+
+  m = (uint32_t)0 - (u - 0x42b20001 < 0x7f800000 - 0x42b20000);
+  u = (u & ~m) | (0x42b20000 & m);
+  m = (uint32_t)0 - (u - 0xc2d00001 < 0xff800000 - 0xc2d00000);
+  u = (u & ~m) | (0xc2d00000 & m);
+  x = fastf_asfloat(u);
+
+  t = x * FASTF_LOG2E + FASTF_ROUNDER;
+  k = (int32_t)(fastf_asuint(t) - FASTF_ROUNDER_BITS);
+  t = t - FASTF_ROUNDER;
+  r = (x - t * FASTF_LN2_HI) - t * FASTF_LN2_LO;
+
+  p = 1.0f + r * (1.0f + r * (1.0f / 2 + r * (1.0f / 6 +
+      r * (1.0f / 24 + r * (1.0f / 120 + r * (1.0f / 720 +
+      r * (1.0f / 5040)))))));
+
+  /* Scale in two steps, since 2^k alone may not be a normal float */
+
+  p = p * fastf_asfloat((uint32_t)((k >> 1) + 127) << 23);
+  return p * fastf_asfloat((uint32_t)(k - (k >> 1) + 127) << 23);
+}
+
+/****************************************************************************
+ * Name: fastf_log_isspecial
+ *
+ * Description:
+ *   x is zero, subnormal, negative, infinite or NaN.
+ *
+ ****************************************************************************/
+
+static inline bool fastf_log_isspecial(float x)
+{
+  return fastf_asuint(x) - 0x00800000 >= 0x7f800000 - 0x00800000;
+}
+
+/****************************************************************************
+ * Name: fastf_log_nospecial
+ *
+ * Description:
+ *   log(x) = e * ln(2) + log(1 + f), with x = 2^e * (1 + f) and
+ *   sqrt(1/2) <= 1 + f < sqrt(2).  log(1 + f) is computed from
+ *   s = f / (2 + f) as in FreeBSD's logf(), with a minimax polynomial.
+ *
+ ****************************************************************************/
+
+static inline float fastf_log_nospecial(float x)
+{
+  uint32_t u = fastf_asuint(x);
+  float hfsq;
+  float f;
+  float s;
+  float z;
+  float e;
+
+  /* 0x3f3504f3 is sqrt(1/2): Take the exponent so that 1 + f is around 1 */
+
+  u -= 0x3f3504f3;
+  e  = (float)((int32_t)u >> 23);
+  f  = fastf_asfloat((u & 0x007fffff) + 0x3f3504f3) - 1.0f;
+
+  hfsq = 0.5f * f * f;
+  s    = f / (2.0f + f);
+  z    = s * s;
+  z    = z * (FASTF_LG1 + z * (FASTF_LG2 + z * (FASTF_LG3 +
+         z * FASTF_LG4)));
+
+  return e * FASTF_LN2_HI - ((hfsq - (s * (hfsq + z) +
+         e * FASTF_LN2_LO)) - f);
+}
+
+static inline float fastf_log(float x)
+{
+  if (!fastf_log_isspecial(x))
+    {
+      return fastf_log_nospecial(x);
+    }
+  else if (isnan(x) || x < 0.0f)
+    {
+      return NAN;
+    }
+  else if (x == 0.0f)
+    {
+      return -INFINITY;
+    }
+  else if (isinf(x))
+    {
+      return x;
+    }
+
+  /* Normalize the subnormals */
+
+  return fastf_log_nospecial(x * 8388608.0f) - 23.0f * FASTF_LN2_HI -
+         23.0f * FASTF_LN2_LO;
+}
+
+/****************************************************************************
+ * Name: fastf_sin_poly
+ *
+ * Description:
+ *   sin(r) for |r| <= pi / 2, with the Taylor polynomial of degree 13.
+ *
+ ****************************************************************************/
+
+static inline float fastf_sin_poly(float r)
+{
+  float z = r * r;
+
+  return r + r * z * (-1.0f / 6 + z * (1.0f / 120 + z * (-1.0f / 5040 +
+         z * (1.0f / 362880 + z * (-1.0f / 39916800 +
+         z * (1.0f / 6227020800.0f))))));
+}
+
+/****************************************************************************
+ * Name: fastf_sin_nospecial
+ *
+ * Description:
+ *   sin(x) = (-1)^k * sin(r), with k the nearest integer of x / pi and
+ *   r = x - k * pi.  Only for |x| < FASTF_TRIG_MAX.
+ *
+ ****************************************************************************/
+
+static inline float fastf_sin_nospecial(float x)
+{
+  float t = x * FASTF_1_PI + FASTF_ROUNDER;
+  uint32_t sign = fastf_asuint(t) << 31;
+  float r;
+
+  t = t - FASTF_ROUNDER;
+  r = (((x - t * FASTF_PI_1) - t * FASTF_PI_2) - t * FASTF_PI_3) -
+      t * FASTF_PI_4;
+
+  return fastf_asfloat(fastf_asuint(fastf_sin_poly(r)) ^ sign);
+}
+
+/****************************************************************************
+ * Name: fastf_cos_nospecial
+ *
+ * Description:
+ *   cos(x) = (-1)^k * sin(r), with k the nearest integer of |x| / pi + 1/2
+ *   and r = |x| - (k - 1/2) * pi.  Only for |x| < FASTF_TRIG_MAX.
+ *
+ ****************************************************************************/
+
+static inline float fastf_cos_nospecial(float x)
+{
+  float t = (fabsf(x) * FASTF_1_PI + 0.5f) + FASTF_ROUNDER;
+  uint32_t sign = fastf_asuint(t) << 31;
+  float r;
+
+  t = (t - FASTF_ROUNDER) - 0.5f;
+  r = (((fabsf(x) - t * FASTF_PI_1) - t * FASTF_PI_2) - t * FASTF_PI_3) -
+      t * FASTF_PI_4;
+
+  return fastf_asfloat(fastf_asuint(fastf_sin_poly(r)) ^ sign);
+}
+
+/****************************************************************************
+ * Name: fastf_reduce_large
+ *
+ * Description:
+ *   Reduce |x| >= 2 to r = |x| - n * pi / 2, |r| <= pi / 4, exactly as if
+ *   with infinite precision: The 24 bits of the mantissa are multiplied by
+ *   the 96 bits of 2 / pi that matter at its exponent, and the result is a
+ *   fixed point number with the two bits of n mod 4 above 62 bits of r.
+ *
+ ****************************************************************************/
+
+static inline double fastf_reduce_large(uint32_t u, FAR uint32_t *n)
+{
+  FAR const uint32_t *bits = &g_fastf_2_pi[(u >> 26) & 15];
+  uint32_t m = ((u & 0x007fffff) | 0x00800000) << ((u >> 23) & 7);
+  uint64_t res0;
+  uint64_t res1;
+  uint64_t res2;
+  uint64_t q;
+
+  res0 = (uint32_t)(m * bits[0]);
+  res1 = (uint64_t)m * bits[4];
+  res2 = (uint64_t)m * bits[8];
+  res0 = ((res2 >> 32) | (res0 << 32)) + res1;
+
+  q    = (res0 + (UINT64_C(1) << 61)) >> 62;
+  res0 = res0 - (q << 62);
+  *n   = (uint32_t)q;
+
+  return (double)(int64_t)res0 * FASTF_PI_2_62;
+}
+
+/****************************************************************************
+ * Name: fastf_sincos_special
+ *
+ * Description:
+ *   Return sin(x + q * pi / 2) for |x| >= FASTF_TRIG_MAX, infinite or NaN.
+ *
+ ****************************************************************************/
+
+static inline float fastf_sincos_special(float x, uint32_t q)
+{
+  uint32_t n;
+  float r;
+  float p;
+
+  if (isnan(x) || isinf(x))
+    {
+      return x - x;
+    }
+
+  /* x = -(n * pi / 2 + r) for the negative x */
+
+  r = (float)fastf_reduce_large(fastf_asuint(x), &n);
+  if (x < 0.0f)
+    {
+      r = -r;
+      n = -n;
+    }
+
+  q += n;
+
+  if ((q & 1) == 0)
+    {
+      p = fastf_sin_poly(r);
+    }
+  else
+    {
+      float z = r * r;
+
+      /* cos(r), with the Taylor polynomial of degree 10 */
+
+      p = 1.0f + z * (-1.0f / 2 + z * (1.0f / 24 + z * (-1.0f / 720 +
+          z * (1.0f / 40320 + z * (-1.0f / 3628800)))));
+    }
+
+  return (q & 2) != 0 ? -p : p;
+}
+
+static inline float fastf_sin(float x)
+{
+  if (fabsf(x) < FASTF_TRIG_MAX)
+    {
+      return fastf_sin_nospecial(x);
+    }
+
+  return fastf_sincos_special(x, 0);
+}
+
+static inline float fastf_cos(float x)
+{
+  if (fabsf(x) < FASTF_TRIG_MAX)
+    {
+      return fastf_cos_nospecial(x);
+    }
+
+  return fastf_sincos_special(x, 1);
+}
+
+#endif /* __LIBS_LIBC_MATH_LIB_FASTMATHF_H */
@@ -0,0 +1,151 @@
+/****************************************************************************
+ * libs/libc/math/lib_vmathf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <math.h>
+
+#include <nuttx/lib/math_vector.h>
+
+#include "lib_fastmathf.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The arrays are processed by blocks: A vectorizable loop over the block
+ * first, then a scalar pass over it for the special arguments.
+ */
+
+#define VMATHF_BLOCK 32
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline bool vmathf_trig_isspecial(float x)
+{
+  return !(fabsf(x) < FASTF_TRIG_MAX);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vexpf
+ ****************************************************************************/
+
+void vexpf(FAR float *dst, FAR const float *src, size_t n)
+{
+  size_t i;
+
+  /* fastf_exp() has no special arguments */
+
+  for (i = 0; i < n; i++)
+    {
+      dst[i] = fastf_exp(src[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: vlogf
+ ****************************************************************************/
+
+void vlogf(FAR float *dst, FAR const float *src, size_t n)
+{
+  float tmp[VMATHF_BLOCK];
+  size_t len;
+  size_t i;
+
+  for (; n > 0; n -= len, src += len, dst += len)
+    {
+      len = n < VMATHF_BLOCK ? n : VMATHF_BLOCK;
+
+      for (i = 0; i < len; i++)
+        {
+          tmp[i] = fastf_log_nospecial(src[i]);
+        }
+
+      for (i = 0; i < len; i++)
+        {
+          dst[i] = fastf_log_isspecial(src[i]) ? fastf_log(src[i]) : tmp[i];
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vsinf
+ ****************************************************************************/
+
+void vsinf(FAR float *dst, FAR const float *src, size_t n)
+{
+  float tmp[VMATHF_BLOCK];
+  size_t len;
+  size_t i;
+
+  for (; n > 0; n -= len, src += len, dst += len)
+    {
+      len = n < VMATHF_BLOCK ? n : VMATHF_BLOCK;
+
+      for (i = 0; i < len; i++)
+        {
+          tmp[i] = fastf_sin_nospecial(src[i]);
+        }
+
+      for (i = 0; i < len; i++)
+        {
+          dst[i] = vmathf_trig_isspecial(src[i]) ?
+                   fastf_sincos_special(src[i], 0) : tmp[i];
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vcosf
+ ****************************************************************************/
+
+void vcosf(FAR float *dst, FAR const float *src, size_t n)
+{
+  float tmp[VMATHF_BLOCK];
+  size_t len;
+  size_t i;
+
+  for (; n > 0; n -= len, src += len, dst += len)
+    {
+      len = n < VMATHF_BLOCK ? n : VMATHF_BLOCK;
+
+      for (i = 0; i < len; i++)
+        {
+          tmp[i] = fastf_cos_nospecial(src[i]);
+        }
+
+      for (i = 0; i < len; i++)
+        {
+          dst[i] = vmathf_trig_isspecial(src[i]) ?
+                   fastf_sincos_special(src[i], 1) : tmp[i];
+        }
+    }
+}
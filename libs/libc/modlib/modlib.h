@@ -112,6 +112,38 @@ int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
 int modlib_symvalue(FAR struct module_s *modp,
                     FAR struct mod_loadinfo_s *loadinfo, FAR Elf_Sym *sym);
 
+/****************************************************************************
+ * Name: modlib_loadstrtab
+ *
+ * Description:
+ *   Read the whole string table of the symbols into memory, so that the
+ *   names of the symbols are not read from the file for each relocation.
+ *   The table is released by modlib_freebuffers().
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  The symbol names are read from the file if this fails.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+int modlib_loadstrtab(FAR struct mod_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find a symbol of the kernel symbol table, selected by
+ *   modlib_setsymtab(), by name.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry, or NULL if it is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name);
+
 /****************************************************************************
  * Name: modlib_loadshdrs
  *
@@ -565,6 +565,18 @@ int modlib_bind(FAR struct module_s *modp,
       return -ENOMEM;
     }
 
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+  /* Read the symbol names in one go.  Without memory for them, they are
+   * read one at a time into the I/O buffer as usual.
+   */
+
+  ret = modlib_loadstrtab(loadinfo);
+  if (ret < 0)
+    {
+      binfo("Symbol names read from the file: %d\n", ret);
+    }
+#endif
+
   /* Process relocations in every allocated section */
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
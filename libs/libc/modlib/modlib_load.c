@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -34,6 +35,8 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/lib/modlib.h>
 
 #include "libc.h"
@@ -63,6 +66,49 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: modlib_xipsection
+ *
+ * Description:
+ *   Return true if the section can be used in place in the memory mapped
+ *   file: It is read-only, aligned in the file and relocated by no
+ *   relocation section, since the relocations cannot be written there.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_XIP
+static bool modlib_xipsection(FAR struct mod_loadinfo_s *loadinfo, int index)
+{
+  FAR Elf_Shdr *shdr = &loadinfo->shdr[index];
+  int i;
+
+  if (loadinfo->xipbase == 0 || shdr->sh_type == SHT_NOBITS ||
+      (shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) != SHF_ALLOC)
+    {
+      return false;
+    }
+
+  if (shdr->sh_addralign > 1 &&
+      ((loadinfo->xipbase + shdr->sh_offset) &
+       (shdr->sh_addralign - 1)) != 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      if ((loadinfo->shdr[i].sh_type == SHT_REL ||
+           loadinfo->shdr[i].sh_type == SHT_RELA) &&
+          loadinfo->shdr[i].sh_info == index)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: modlib_elfsize
  *
@@ -94,6 +140,15 @@ static void modlib_elfsize(struct mod_loadinfo_s *loadinfo)
        * execution.
        */
 
+#ifdef CONFIG_MODLIB_XIP
+      /* The sections used in place need no memory */
+
+      if (modlib_xipsection(loadinfo, i))
+        {
+          continue;
+        }
+#endif
+
       if ((shdr->sh_flags & SHF_ALLOC) != 0)
         {
           /* SHF_WRITE indicates that the section address space is write-
@@ -167,6 +222,21 @@ static inline int modlib_loadfile(FAR struct mod_loadinfo_s *loadinfo)
           continue;
         }
 
+#ifdef CONFIG_MODLIB_XIP
+      if (modlib_xipsection(loadinfo, i))
+        {
+          shdr->sh_addr = loadinfo->xipbase + shdr->sh_offset;
+          binfo("%d. XIP at %08lx\n", i, (unsigned long)shdr->sh_addr);
+
+          if (loadinfo->textstart == 0)
+            {
+              loadinfo->textstart = shdr->sh_addr;
+            }
+
+          continue;
+        }
+#endif
+
       /* SHF_WRITE indicates that the section address space is write-
        * able
        */
@@ -182,6 +252,13 @@ static inline int modlib_loadfile(FAR struct mod_loadinfo_s *loadinfo)
 
       *pptr = (FAR uint8_t *)_ALIGN_UP((uintptr_t)*pptr, shdr->sh_addralign);
 
+      /* The entry point is relative to the first .text section */
+
+      if (pptr == &text && loadinfo->textstart == 0)
+        {
+          loadinfo->textstart = (uintptr_t)*pptr;
+        }
+
       /* SHT_NOBITS indicates that there is no data in the file for the
        * section.
        */
@@ -255,6 +332,18 @@ int modlib_load(FAR struct mod_loadinfo_s *loadinfo)
       goto errout_with_buffers;
     }
 
+#ifdef CONFIG_MODLIB_XIP
+  /* The read-only sections are used in place if the file is mapped in
+   * memory, as the files of a romfs in flash are.
+   */
+
+  if (_NX_IOCTL(loadinfo->filfd, FIOC_MMAP,
+                (unsigned long)((uintptr_t)&loadinfo->xipbase)) < 0)
+    {
+      loadinfo->xipbase = 0;
+    }
+#endif
+
   /* Determine total size to allocate */
 
   modlib_elfsize(loadinfo);
@@ -33,6 +33,7 @@
 
 #include <nuttx/lib/modlib.h>
 
+#include "libc.h"
 #include "modlib/modlib.h"
 
 /****************************************************************************
@@ -63,7 +64,8 @@ struct mod_exportinfo_s
  * Name: modlib_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name, in loadinfo->iobuffer[] or in the cached string
+ *   table.
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -76,7 +78,7 @@ struct mod_exportinfo_s
  ****************************************************************************/
 
 static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
-                          FAR const Elf_Sym *sym)
+                          FAR const Elf_Sym *sym, FAR const char **name)
 {
   FAR uint8_t *buffer;
   off_t  offset;
@@ -94,6 +96,23 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
       return -ESRCH;
     }
 
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+  if (loadinfo->strtab != NULL)
+    {
+      /* The cached table is NUL terminated by modlib_loadstrtab() */
+
+      if (sym->st_name >= loadinfo->shdr[loadinfo->strtabidx].sh_size)
+        {
+          berr("ERROR: Bad symbol name offset\n");
+          return -EINVAL;
+        }
+
+      *name = loadinfo->strtab + sym->st_name;
+      return OK;
+    }
+#endif
+
+  *name  = (FAR const char *)loadinfo->iobuffer;
   offset = loadinfo->shdr[loadinfo->strtabidx].sh_offset + sym->st_name;
 
   /* Loop until we get the entire symbol name into memory */
@@ -145,6 +164,10 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
           berr("ERROR: mod_reallocbuffer failed: %d\n", ret);
           return ret;
         }
+
+      /* The buffer may have moved */
+
+      *name = (FAR const char *)loadinfo->iobuffer;
     }
 
   /* We will not get here */
@@ -280,6 +303,58 @@ int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
   return modlib_read(loadinfo, (FAR uint8_t *)sym, sizeof(Elf_Sym), offset);
 }
 
+/****************************************************************************
+ * Name: modlib_loadstrtab
+ *
+ * Description:
+ *   Read the whole string table of the symbols into memory.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+int modlib_loadstrtab(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR Elf_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+  int ret;
+
+  if (loadinfo->strtab != NULL)
+    {
+      return OK;
+    }
+
+  if (strtab->sh_offset + strtab->sh_size > loadinfo->filelen)
+    {
+      berr("ERROR: String table beyond the end of file\n");
+      return -EINVAL;
+    }
+
+  loadinfo->strtab = lib_malloc(strtab->sh_size + 1);
+  if (loadinfo->strtab == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = modlib_read(loadinfo, (FAR uint8_t *)loadinfo->strtab,
+                    strtab->sh_size, strtab->sh_offset);
+  if (ret < 0)
+    {
+      berr("ERROR: modlib_read failed: %d\n", ret);
+      lib_free(loadinfo->strtab);
+      loadinfo->strtab = NULL;
+      return ret;
+    }
+
+  /* Terminate the last name, in case the file is corrupted */
+
+  loadinfo->strtab[strtab->sh_size] = '\0';
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: modlib_symvalue
  *
@@ -309,8 +384,8 @@ int modlib_symvalue(FAR struct module_s *modp,
 {
   FAR const struct symtab_s *symbol;
   struct mod_exportinfo_s exportinfo;
+  FAR const char *name;
   uintptr_t secbase;
-  int nsymbols;
   int ret;
 
   switch (sym->st_shndx)
@@ -335,7 +410,7 @@ int modlib_symvalue(FAR struct module_s *modp,
       {
         /* Get the name of the undefined symbol */
 
-        ret = modlib_symname(loadinfo, sym);
+        ret = modlib_symname(loadinfo, sym, &name);
         if (ret < 0)
           {
             /* There are a few relocations for a few architectures that do
@@ -354,7 +429,7 @@ int modlib_symvalue(FAR struct module_s *modp,
          * recently installed will take precedence.
          */
 
-        exportinfo.name   = (FAR const char *)loadinfo->iobuffer;
+        exportinfo.name   = name;
         exportinfo.modp   = modp;
         exportinfo.symbol = NULL;
 
@@ -374,9 +449,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         if (symbol == NULL)
           {
-            modlib_getsymtab(&symbol, &nsymbols);
-            symbol = symtab_findbyname(symbol, exportinfo.name,
-                                       nsymbols);
+            symbol = modlib_findsymbol(name);
           }
 
         /* Was the symbol found from any exporter? */
@@ -384,7 +457,7 @@ int modlib_symvalue(FAR struct module_s *modp,
         if (symbol == NULL)
           {
             berr("ERROR: SHN_UNDEF: Exported symbol \"%s\" not found\n",
-                 loadinfo->iobuffer);
+                 name);
             return -ENOENT;
           }
 
@@ -394,7 +467,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         binfo("SHN_UNDEF: name=%s "
               "%08" PRIxPTR "+%08" PRIxPTR "=%08" PRIxPTR "\n",
-              loadinfo->iobuffer,
+              name,
               (uintptr_t)sym->st_value, (uintptr_t)symbol->sym_value,
               (uintptr_t)(sym->st_value + symbol->sym_value));
 
@@ -24,11 +24,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <assert.h>
 
 #include <nuttx/symtab.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -63,6 +66,13 @@ extern int CONFIG_MODLIB_NSYMBOLS_VAR;
 static FAR const struct symtab_s *g_modlib_symtab;
 static FAR int g_modlib_nsymbols;
 
+#ifdef CONFIG_SYMTAB_HASH
+/* The hash index of g_modlib_symtab, built by the first lookup */
+
+static struct symtab_hash_s g_modlib_hash;
+static bool g_modlib_hashed;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -125,5 +135,67 @@ void modlib_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   modlib_registry_lock();
   g_modlib_symtab   = symtab;
   g_modlib_nsymbols = nsymbols;
+
+#ifdef CONFIG_SYMTAB_HASH
+  if (g_modlib_hashed)
+    {
+      symtab_hashfree(&g_modlib_hash);
+      g_modlib_hashed = false;
+    }
+#endif
+
   modlib_registry_unlock();
 }
+
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find a symbol of the kernel symbol table by name.  With
+ *   CONFIG_SYMTAB_HASH, the table is indexed by the first lookup, and the
+ *   search falls back to symtab_findbyname() if there is no memory for
+ *   the index.
+ *
+ * Input Parameters:
+ *   name - The name of the symbol
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry, or NULL if it is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name)
+{
+  FAR const struct symtab_s *symtab;
+  int nsymbols;
+
+  modlib_getsymtab(&symtab, &nsymbols);
+
+#ifdef CONFIG_SYMTAB_HASH
+  modlib_registry_lock();
+
+  /* The table may have been changed since modlib_getsymtab() */
+
+  if (symtab == g_modlib_symtab)
+    {
+      if (!g_modlib_hashed)
+        {
+          g_modlib_hashed = symtab_hashinit(&g_modlib_hash, symtab,
+                                            nsymbols) >= 0;
+        }
+
+      if (g_modlib_hashed)
+        {
+          FAR const struct symtab_s *symbol;
+
+          symbol = symtab_hashfind(&g_modlib_hash, name);
+          modlib_registry_unlock();
+          return symbol;
+        }
+    }
+
+  modlib_registry_unlock();
+#endif
+
+  return symtab_findbyname(symtab, name, nsymbols);
+}
@@ -95,5 +95,13 @@ int modlib_freebuffers(struct mod_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+#ifdef CONFIG_MODLIB_STRTAB_CACHE
+  if (loadinfo->strtab != NULL)
+    {
+      lib_free(loadinfo->strtab);
+      loadinfo->strtab    = NULL;
+    }
+#endif
+
   return OK;
 }
@@ -76,6 +76,14 @@
 #  define CONFIG_NETDB_DNSCLIENT_LIFESEC 3600
 #endif
 
+#ifndef CONFIG_NETDB_DNSCLIENT_NEGATIVE_LIFESEC
+#  define CONFIG_NETDB_DNSCLIENT_NEGATIVE_LIFESEC 60
+#endif
+
+#ifndef CONFIG_NETDB_DNSCLIENT_HASH_SIZE
+#  define CONFIG_NETDB_DNSCLIENT_HASH_SIZE 0
+#endif
+
 #ifndef CONFIG_NETDB_RESOLVCONF_PATH
 #  define CONFIG_NETDB_RESOLVCONF_PATH "/etc/resolv.conf"
 #endif
@@ -185,7 +193,8 @@ int dns_bind(sa_family_t family);
  *     the returned addresses.
  *
  * Returned Value:
- *   Returns zero (OK) if the query was successful.
+ *   Returns zero (OK) if the query was successful.  -ENXIO is returned if
+ *   the name server reported that the name does not exist.
  *
  ****************************************************************************/
 
@@ -201,7 +210,9 @@ int dns_query(FAR const char *hostname, FAR union dns_addr_u *addr,
  * Input Parameters:
  *   hostname - The hostname string to be cached.
  *   addr     - The IP addresses associated with the hostname.
- *   naddr    - The count of the IP addresses.
+ *   naddr    - The count of the IP addresses.  Zero records that the name
+ *     does not exist.
+ *   ttl      - The time to live of the answer in seconds
  *
  * Returned Value:
  *   None
@@ -210,7 +221,8 @@ int dns_query(FAR const char *hostname, FAR union dns_addr_u *addr,
 
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
 void dns_save_answer(FAR const char *hostname,
-                     FAR const union dns_addr_u *addr, int naddr);
+                     FAR const union dns_addr_u *addr, int naddr,
+                     uint32_t ttl);
 #endif
 
 /****************************************************************************
@@ -246,7 +258,9 @@ void dns_clear_answer(void);
  *   If the host name was successfully found in the DNS name resolution
  *   cache, zero (OK) will be returned.  Otherwise, some negated errno
  *   value will be returned, typically -ENOENT meaning that the hostname
- *   was not found in the cache.
+ *   was not found in the cache.  -ENXIO means that the name is cached as
+ *   non-existent, and -ESTALE that the entry is about to expire and that
+ *   the caller should query the name again to refresh it.
  *
  ****************************************************************************/
 
@@ -24,7 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/time.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 #include <assert.h>
@@ -39,7 +43,8 @@
  * Private Types
  ****************************************************************************/
 
-/* This described one entry in the cache of resolved hostnames.
+/* This described one entry in the cache of resolved hostnames.  An entry
+ * with no address caches a name that does not exist.
  *
  * REVISIT: this consumes extra space, especially when multiple
  * addresses per name are stored.
@@ -47,8 +52,13 @@
 
 struct dns_cache_s
 {
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+  FAR struct dns_cache_s *hnext; /* Next entry with the same hash */
+#endif
   time_t            ctime;      /* Creation time */
+  uint32_t          life;       /* Life in seconds, zero if unused */
+#ifdef CONFIG_NETDB_DNSCLIENT_PREFETCH
+  bool              refresh;    /* A caller is refreshing the entry */
 #endif
   char              name[CONFIG_NETDB_DNSCLIENT_NAMESIZE];
   uint8_t           naddr;      /* How many addresses per name */
@@ -59,17 +69,149 @@ struct dns_cache_s
  * Private Data
  ****************************************************************************/
 
-static uint8_t g_dns_head;        /* Head of the circular, DNS resolver cache */
-static uint8_t g_dns_tail;        /* Tail of the circular, DNS resolver cache */
-
 /* This is the DNS resolver cache */
 
 static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
 
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+/* The used entries of g_dns_cache hashed by their name */
+
+static FAR struct dns_cache_s *g_dns_hash[CONFIG_NETDB_DNSCLIENT_HASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: dns_now
+ *
+ * Description:
+ *   Return the current time in seconds.
+ *
+ ****************************************************************************/
+
+static time_t dns_now(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (time_t)now.tv_sec;
+}
+
+/****************************************************************************
+ * Name: dns_remaining
+ *
+ * Description:
+ *   Return the remaining life of an entry in seconds;  zero if the entry is
+ *   unused or has expired.
+ *
+ ****************************************************************************/
+
+static uint32_t dns_remaining(FAR struct dns_cache_s *entry, time_t now)
+{
+  uint32_t elapsed = (uint32_t)now - (uint32_t)entry->ctime;
+
+  return elapsed < entry->life ? entry->life - elapsed : 0;
+}
+
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+/****************************************************************************
+ * Name: dns_hash
+ *
+ * Description:
+ *   Return the head of the hash chain of a name.  Only the part of the name
+ *   that fits in the cache entries is hashed.
+ *
+ ****************************************************************************/
+
+static FAR struct dns_cache_s **dns_hash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  for (i = 0; i < CONFIG_NETDB_DNSCLIENT_NAMESIZE - 1 && name[i] != '\0';
+       i++)
+    {
+      hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+  return &g_dns_hash[hash % CONFIG_NETDB_DNSCLIENT_HASH_SIZE];
+}
+#endif
+
+/****************************************************************************
+ * Name: dns_free_entry
+ *
+ * Description:
+ *   Return an entry to the unused state.
+ *
+ ****************************************************************************/
+
+static void dns_free_entry(FAR struct dns_cache_s *entry)
+{
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+  FAR struct dns_cache_s **link;
+
+  if (entry->life != 0)
+    {
+      for (link = dns_hash(entry->name); *link != NULL;
+           link = &(*link)->hnext)
+        {
+          if (*link == entry)
+            {
+              *link = entry->hnext;
+              break;
+            }
+        }
+    }
+#endif
+
+  memset(entry, 0, sizeof(*entry));
+}
+
+/****************************************************************************
+ * Name: dns_search
+ *
+ * Description:
+ *   Find the used entry of a name, whether expired or not.  Because the
+ *   names are truncated to CONFIG_NETDB_DNSCLIENT_NAMESIZE, this has the
+ *   possibility of aliasing two names and returning the wrong entry from
+ *   the cache.
+ *
+ ****************************************************************************/
+
+static FAR struct dns_cache_s *dns_search(FAR const char *hostname)
+{
+  FAR struct dns_cache_s *entry;
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+
+  for (entry = *dns_hash(hostname); entry != NULL; entry = entry->hnext)
+    {
+      if (strncmp(hostname, entry->name,
+                  CONFIG_NETDB_DNSCLIENT_NAMESIZE) == 0)
+        {
+          return entry;
+        }
+    }
+#else
+  int ndx;
+
+  for (ndx = 0; ndx < CONFIG_NETDB_DNSCLIENT_ENTRIES; ndx++)
+    {
+      entry = &g_dns_cache[ndx];
+      if (entry->life != 0 &&
+          strncmp(hostname, entry->name,
+                  CONFIG_NETDB_DNSCLIENT_NAMESIZE) == 0)
+        {
+          return entry;
+        }
+    }
+#endif
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -78,12 +220,18 @@ static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
  * Name: dns_save_answer
  *
  * Description:
- *   Save the last resolved hostname in the DNS cache
+ *   Save the last resolved hostname in the DNS cache.  The entry lives for
+ *   the TTL of the answer, but no longer than CONFIG_NETDB_DNSCLIENT_LIFESEC
+ *   or, for a name that does not exist, than
+ *   CONFIG_NETDB_DNSCLIENT_NEGATIVE_LIFESEC.  A new name replaces an unused
+ *   or expired entry, else the entry closest to its expiry.
  *
  * Input Parameters:
  *   hostname - The hostname string to be cached.
  *   addr     - The IP addresses associated with the hostname.
- *   naddr    - The count of the IP addresses.
+ *   naddr    - The count of the IP addresses.  Zero records that the name
+ *     does not exist.
+ *   ttl      - The time to live of the answer in seconds
  *
  * Returned Value:
  *   None
@@ -91,64 +239,95 @@ static struct dns_cache_s g_dns_cache[CONFIG_NETDB_DNSCLIENT_ENTRIES];
  ****************************************************************************/
 
 void dns_save_answer(FAR const char *hostname,
-                     FAR const union dns_addr_u *addr, int naddr)
+                     FAR const union dns_addr_u *addr, int naddr,
+                     uint32_t ttl)
 {
   FAR struct dns_cache_s *entry;
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  struct timespec now;
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+  FAR struct dns_cache_s **head;
 #endif
-  int next;
+  uint32_t remaining;
+  time_t now;
   int ndx;
 
   naddr = MIN(naddr, CONFIG_NETDB_MAX_IPADDR);
-  DEBUGASSERT(naddr >= 1 && naddr <= UCHAR_MAX);
+  DEBUGASSERT(naddr >= 0 && naddr <= UCHAR_MAX);
+
+  if (naddr == 0)
+    {
+      ttl = MIN(ttl, CONFIG_NETDB_DNSCLIENT_NEGATIVE_LIFESEC);
+    }
+#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
+  else
+    {
+      ttl = MIN(ttl, CONFIG_NETDB_DNSCLIENT_LIFESEC);
+    }
+#endif
 
   /* Get exclusive access to the DNS cache */
 
   dns_semtake();
 
-  /* Get the index to the new head of the list */
+  now   = dns_now();
+  entry = dns_search(hostname);
 
-  ndx  = g_dns_head;
-  next = ndx + 1;
-  if (next >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
+  if (ttl == 0)
     {
-      next = 0;
-    }
-
-  /* If the next head pointer would match the tail index, then increment
-   * the tail index, discarding the oldest mapping in the cache.
-   */
+      /* The answer must not be cached:  Forget any previous answer, too */
 
-  if (next == g_dns_tail)
-    {
-      int tmp = g_dns_tail + 1;
-      if (tmp >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
+      if (entry != NULL)
         {
-          tmp = 0;
+          dns_free_entry(entry);
         }
 
-      g_dns_tail = tmp;
+      dns_semgive();
+      return;
     }
 
-  /* Save the answer in the cache */
+  if (entry == NULL)
+    {
+      /* Pick the entry to replace.  This walk is only needed for names
+       * that are not cached yet.
+       */
 
-  entry = &g_dns_cache[ndx];
+      entry     = &g_dns_cache[0];
+      remaining = dns_remaining(entry, now);
 
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  /* Get the current time */
+      for (ndx = 1; ndx < CONFIG_NETDB_DNSCLIENT_ENTRIES && remaining > 0;
+           ndx++)
+        {
+          uint32_t tmp = dns_remaining(&g_dns_cache[ndx], now);
+          if (tmp < remaining)
+            {
+              entry     = &g_dns_cache[ndx];
+              remaining = tmp;
+            }
+        }
 
-  clock_gettime(CLOCK_MONOTONIC, &now);
-  entry->ctime = (time_t)now.tv_sec;
+      dns_free_entry(entry);
+      strlcpy(entry->name, hostname, CONFIG_NETDB_DNSCLIENT_NAMESIZE);
+
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+      head          = dns_hash(entry->name);
+      entry->hnext  = *head;
+      *head         = entry;
 #endif
+    }
 
-  strlcpy(entry->name, hostname, CONFIG_NETDB_DNSCLIENT_NAMESIZE);
-  memcpy(&entry->addr, addr, naddr * sizeof(*addr));
-  entry->naddr = naddr;
+  /* Save the answer in the cache */
 
-  /* Save the updated head index */
+  entry->ctime   = now;
+  entry->life    = ttl;
+#ifdef CONFIG_NETDB_DNSCLIENT_PREFETCH
+  entry->refresh = false;
+#endif
 
-  g_dns_head = next;
+  if (naddr > 0)
+    {
+      memcpy(&entry->addr, addr, naddr * sizeof(*addr));
+    }
+
+  entry->naddr = naddr;
   dns_semgive();
 }
 
@@ -169,10 +348,12 @@ void dns_clear_answer(void)
 
   dns_semtake();
 
-  /* Reset the circular of DNS cache */
+  /* Return all the entries to the unused state */
 
-  g_dns_head = 0;
-  g_dns_tail = 0;
+  memset(g_dns_cache, 0, sizeof(g_dns_cache));
+#if CONFIG_NETDB_DNSCLIENT_HASH_SIZE > 0
+  memset(g_dns_hash, 0, sizeof(g_dns_hash));
+#endif
 
   dns_semgive();
 }
@@ -195,7 +376,9 @@ void dns_clear_answer(void)
  *   If the host name was successfully found in the DNS name resolution
  *   cache, zero (OK) will be returned.  Otherwise, some negated errno
  *   value will be returned, typically -ENOENT meaning that the hostname
- *   was not found in the cache.
+ *   was not found in the cache.  -ENXIO means that the name is cached as
+ *   non-existent, and -ESTALE that the entry is about to expire and that
+ *   the caller should query the name again to refresh it.
  *
  ****************************************************************************/
 
@@ -203,85 +386,62 @@ int dns_find_answer(FAR const char *hostname, FAR union dns_addr_u *addr,
                     FAR int *naddr)
 {
   FAR struct dns_cache_s *entry;
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  struct timespec now;
-  uint32_t elapsed;
+  uint32_t remaining;
   int ret;
-#endif
-  int next;
-  int ndx;
 
   /* Get exclusive access to the DNS cache */
 
   dns_semtake();
 
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-  /* Get the current time */
-
-  ret = clock_gettime(CLOCK_MONOTONIC, &now);
-#endif
-
-  for (ndx = g_dns_tail; ndx != g_dns_head; ndx = next)
+  entry = dns_search(hostname);
+  if (entry == NULL)
     {
-      entry = &g_dns_cache[ndx];
+      ret = -ENOENT;
+      goto out;
+    }
 
-      /* Advance the index for the next time through the loop, handling
-       * wrapping to the beginning of the circular buffer.
-       */
+  remaining = dns_remaining(entry, dns_now());
+  if (remaining == 0)
+    {
+      /* This entry has expired.  Free it for the next answer. */
 
-      next = ndx + 1;
-      if (next >= CONFIG_NETDB_DNSCLIENT_ENTRIES)
-        {
-          next = 0;
-        }
+      dns_free_entry(entry);
+      ret = -ENOENT;
+    }
+  else if (entry->naddr == 0)
+    {
+      /* The name server said that the name does not exist */
 
-#if CONFIG_NETDB_DNSCLIENT_LIFESEC > 0
-      /* Check if this entry has expired
-       * REVISIT: Does not this calculation assume that the sizeof(time_t)
-       * is equal to the sizeof(uint32_t)?
+      ret = -ENXIO;
+    }
+#ifdef CONFIG_NETDB_DNSCLIENT_PREFETCH
+  else if (!entry->refresh && remaining <= entry->life / 10)
+    {
+      /* Leave the refresh to this caller;  the others keep using the
+       * entry meanwhile.
        */
 
-      elapsed = (uint32_t)now.tv_sec - (uint32_t)entry->ctime;
-      if (ret >= 0 && elapsed > CONFIG_NETDB_DNSCLIENT_LIFESEC)
-        {
-          /* This entry has expired.  Increment the tail index to exclude
-           * this entry on future traversals.
-           */
-
-          g_dns_tail = next;
-        }
-      else
+      entry->refresh = true;
+      ret = -ESTALE;
+    }
 #endif
-        {
-          /* The entry has not expired, check for a name match. Because
-           * the names are truncated to CONFIG_NETDB_DNSCLIENT_NAMESIZE,
-           * this has the possibility of aliasing two names and returning
-           * the wrong entry from the cache.
-           */
-
-          if (strncmp(hostname, entry->name,
-                      CONFIG_NETDB_DNSCLIENT_NAMESIZE) == 0)
-            {
-              /* We have a match.  Return the resolved host address */
-
-              /* Make sure that the address will fit in the caller-provided
-               * buffer.
-               */
+  else
+    {
+      /* We have a match.  Return the resolved host address */
 
-              *naddr = MIN(*naddr, entry->naddr);
+      /* Make sure that the address will fit in the caller-provided
+       * buffer.
+       */
 
-              /* Return the address information */
+      *naddr = MIN(*naddr, entry->naddr);
 
-              memcpy(addr, &entry->addr, *naddr * sizeof(*addr));
+      /* Return the address information */
 
-              dns_semgive();
-              return OK;
-            }
-        }
+      memcpy(addr, &entry->addr, *naddr * sizeof(*addr));
+      ret = OK;
     }
 
-  ret = -ENOENT;
-
+out:
   dns_semgive();
   return ret;
 }
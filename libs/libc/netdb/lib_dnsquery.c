@@ -48,6 +48,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
@@ -99,6 +101,7 @@ struct dns_query_info_s
   uint16_t id;                                     /* Query ID */
   uint16_t rectype;                                /* Queried record type */
   uint16_t qnamelen;                               /* Queried hostname length */
+  uint32_t ttl;                                    /* TTL of the response */
   char qname[CONFIG_NETDB_DNSCLIENT_NAMESIZE + 2]; /* Queried hostname in
                                                     * encoded format + NUL */
 };
@@ -167,6 +170,100 @@ static FAR uint8_t *dns_parse_name(FAR uint8_t *query, FAR uint8_t *queryend)
   return query;
 }
 
+/****************************************************************************
+ * Name: dns_answer_ttl
+ *
+ * Description:
+ *   Return the TTL of an answer in seconds.  A TTL with the most significant
+ *   bit set is treated as zero (RFC 2181, section 8).
+ *
+ ****************************************************************************/
+
+static uint32_t dns_answer_ttl(FAR const struct dns_answer_s *ans)
+{
+  uint16_t ttl[2];
+  uint32_t ret;
+
+  /* N.B. Unaligned access may occur here */
+
+  memcpy(ttl, ans->ttl, sizeof(ttl));
+  ret = ((uint32_t)NTOHS(ttl[0]) << 16) | NTOHS(ttl[1]);
+  return (ret & 0x80000000) != 0 ? 0 : ret;
+}
+
+/****************************************************************************
+ * Name: dns_negative_ttl
+ *
+ * Description:
+ *   Return how long the non-existence of a name may be cached:  The lesser
+ *   of the TTL and of the MINIMUM field of the SOA record of the authority
+ *   section (RFC 2308, section 5), or zero without a SOA record.
+ *
+ * Input Parameters:
+ *   nameptr     - The first record after the question
+ *   endofbuffer - The end of the response
+ *   nrecords    - The number of answer and authority records
+ *
+ ****************************************************************************/
+
+static uint32_t dns_negative_ttl(FAR uint8_t *nameptr,
+                                 FAR uint8_t *endofbuffer,
+                                 unsigned int nrecords)
+{
+  FAR struct dns_answer_s *ans;
+  FAR uint8_t *rdata;
+  FAR uint8_t *rdend;
+  uint32_t minimum;
+  uint32_t ttl;
+
+  for (; nrecords > 0; nrecords--)
+    {
+      nameptr = dns_parse_name(nameptr, endofbuffer);
+      if (nameptr == endofbuffer || nameptr + 10 > endofbuffer)
+        {
+          break;
+        }
+
+      ans   = (FAR struct dns_answer_s *)nameptr;
+      rdata = nameptr + 10;
+      rdend = rdata + NTOHS(ans->len);
+      if (rdend > endofbuffer)
+        {
+          break;
+        }
+
+      if (ans->type == HTONS(DNS_RECTYPE_SOA) &&
+          ans->class == HTONS(DNS_CLASS_IN))
+        {
+          /* Skip MNAME and RNAME, then SERIAL, REFRESH, RETRY and EXPIRE,
+           * to reach MINIMUM.
+           */
+
+          rdata = dns_parse_name(rdata, rdend);
+          if (rdata == rdend)
+            {
+              break;
+            }
+
+          rdata = dns_parse_name(rdata, rdend);
+          if (rdata == rdend || rdata + 20 > rdend)
+            {
+              break;
+            }
+
+          minimum = ((uint32_t)rdata[16] << 24) |
+                    ((uint32_t)rdata[17] << 16) |
+                    ((uint32_t)rdata[18] << 8) | rdata[19];
+          ttl     = dns_answer_ttl(ans);
+          return (minimum & 0x80000000) != 0 ? 0 : MIN(ttl, minimum);
+        }
+
+      nameptr = rdend;
+    }
+
+  return 0;
+}
+
 /****************************************************************************
  * Name: dns_alloc_id
  *
@@ -319,8 +416,10 @@ static int dns_send_query(int sd, FAR const char *name,
  *   Called when new UDP data arrives
  *
  * Returned Value:
- *   Returns number of valid IP address responses.  Negated errno value is
- *   returned in all other cases.
+ *   Returns number of valid IP address responses;  qinfo->ttl is set to the
+ *   least TTL of these.  -ENXIO means that the name does not exist and
+ *   qinfo->ttl is set to how long this may be cached.  Negated errno value
+ *   is returned in all other cases.
  *
  ****************************************************************************/
 
@@ -374,9 +473,12 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
         NTOHS(hdr->numquestions), NTOHS(hdr->numanswers),
         NTOHS(hdr->numauthrr), NTOHS(hdr->numextrarr));
 
-  /* Check for error */
+  /* Check for error.  A name that does not exist is only reported once
+   * the response is known to answer the question.
+   */
 
-  if ((hdr->flags2 & DNS_FLAG2_ERR_MASK) != 0)
+  if ((hdr->flags2 & DNS_FLAG2_ERR_MASK) != DNS_FLAG2_ERR_NONE &&
+      (hdr->flags2 & DNS_FLAG2_ERR_MASK) != DNS_FLAG2_ERR_NAME)
     {
       nerr("ERROR: DNS reported error: flags2=%02x\n", hdr->flags2);
       return -EPROTO;
@@ -454,8 +556,17 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
 
   nameptr += sizeof(struct dns_question_s);
 
+  if ((hdr->flags2 & DNS_FLAG2_ERR_MASK) == DNS_FLAG2_ERR_NAME)
+    {
+      nerr("ERROR: DNS reported error: flags2=%02x\n", hdr->flags2);
+      qinfo->ttl = dns_negative_ttl(nameptr, endofbuffer,
+                                    nanswers + NTOHS(hdr->numauthrr));
+      return -ENXIO;
+    }
+
   ret = OK;
   naddr_read = 0;
+  qinfo->ttl = UINT32_MAX;
 
   for (; nanswers > 0; nanswers--)
     {
@@ -500,6 +611,7 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
           inaddr->sin_family      = AF_INET;
           inaddr->sin_port        = 0;
           inaddr->sin_addr.s_addr = ans->u.ipv4.s_addr;
+          qinfo->ttl              = MIN(qinfo->ttl, dns_answer_ttl(ans));
 
           if (++naddr_read >= naddr)
             {
@@ -533,6 +645,7 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
           inaddr->sin6_family     = AF_INET6;
           inaddr->sin6_port       = 0;
           memcpy(inaddr->sin6_addr.s6_addr, ans->u.ipv6.s6_addr, 16);
+          qinfo->ttl              = MIN(qinfo->ttl, dns_answer_ttl(ans));
 
           if (++naddr_read >= naddr)
             {
@@ -568,7 +681,8 @@ static int dns_recv_response(int sd, FAR union dns_addr_u *addr, int naddr,
  *   addrlen  - Length of the DNS name server address.
  *
  * Returned Value:
- *   Returns one (1) if the query was successful.  Zero is returned in all
+ *   Returns one (1) if the query was successful, and -ENXIO if the name
+ *   does not exist;  both stop the traversal.  Zero is returned in all
  *   other cases.  The result field of the query structure is set to a
  *   negated errno value indicate the reason for the last failure (only).
  *
@@ -579,6 +693,7 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
 {
   FAR struct dns_query_s *query = (FAR struct dns_query_s *)arg;
   FAR struct dns_query_info_s qinfo;
+  uint32_t ttl = UINT32_MAX;
   int next = 0;
   int retries;
   int ret;
@@ -616,6 +731,7 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
           if (ret >= 0)
             {
               next += ret;
+              ttl   = MIN(ttl, qinfo.ttl);
             }
           else
             {
@@ -623,6 +739,13 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
               query->result = ret;
             }
         }
+
+      /* A name that does not exist has no address of any family */
+
+      if (ret == -ENXIO)
+        {
+          break;
+        }
 #endif
 
 #ifdef CONFIG_NET_IPv4
@@ -645,6 +768,7 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
           if (ret >= 0)
             {
               next += ret;
+              ttl   = MIN(ttl, qinfo.ttl);
             }
           else
             {
@@ -659,7 +783,7 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
           /* Save the answer in the DNS cache */
 
-          dns_save_answer(query->hostname, query->addr, next);
+          dns_save_answer(query->hostname, query->addr, next, ttl);
 #endif
           /* Return 1 to indicate to (1) stop the traversal, and (2)
            * indicate that the address was found.
@@ -676,6 +800,20 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
     }
 
   close(sd);
+
+  if (query->result == -ENXIO)
+    {
+#if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
+      /* Remember that the name does not exist */
+
+      dns_save_answer(query->hostname, NULL, 0, qinfo.ttl);
+#endif
+
+      /* The other name servers would only confirm it */
+
+      return -ENXIO;
+    }
+
   return 0;
 }
 
@@ -699,7 +837,8 @@ static int dns_query_callback(FAR void *arg, FAR struct sockaddr *addr,
  *     the returned addresses.
  *
  * Returned Value:
- *   Returns zero (OK) if the query was successful.
+ *   Returns zero (OK) if the query was successful.  -ENXIO is returned if
+ *   the name does not exist.  Otherwise a negated errno value is returned.
  *
  ****************************************************************************/
 
@@ -720,7 +859,7 @@ int dns_query(FAR const char *hostname, FAR union dns_addr_u *addr,
    *
    *  1 - The query was successful.
    *  0 - Look up failed
-   * <0 - Some other failure (?, shouldn't happen)
+   * <0 - The name does not exist (-ENXIO) or some other failure
    */
 
   ret = dns_foreach_nameserver(dns_query_callback, &query);
@@ -718,6 +718,10 @@ int gethostentbyname_r(FAR const char *name,
                        FAR struct hostent_s *host, FAR char *buf,
                        size_t buflen, FAR int *h_errnop)
 {
+#if defined(CONFIG_NETDB_DNSCLIENT) && CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
+  int ret;
+#endif
+
   DEBUGASSERT(name != NULL && host != NULL && buf != NULL);
 
   /* Make sure that the h_errno has a non-error code */
@@ -753,21 +757,38 @@ int gethostentbyname_r(FAR const char *name,
 #if CONFIG_NETDB_DNSCLIENT_ENTRIES > 0
   /* Check if we already have this hostname mapping cached */
 
-  if (lib_find_answer(name, host, buf, buflen) >= 0)
+  ret = lib_find_answer(name, host, buf, buflen);
+  if (ret >= 0)
     {
       /* Found the address mapping in the cache */
 
       return OK;
     }
-#endif
 
-  /* Try to get the host address using the DNS name server */
+  /* Do not ask the name servers again for a name that does not exist */
 
-  if (lib_dns_lookup(name, host, buf, buflen) >= 0)
+  if (ret != -ENXIO)
+#endif
     {
-      /* Successful DNS lookup! */
+      /* Try to get the host address using the DNS name server */
 
-      return OK;
+      if (lib_dns_lookup(name, host, buf, buflen) >= 0)
+        {
+          /* Successful DNS lookup! */
+
+          return OK;
+        }
+
+#ifdef CONFIG_NETDB_DNSCLIENT_PREFETCH
+      /* The refresh of an entry about to expire failed:  Keep using the
+       * entry until it does expire.
+       */
+
+      if (ret == -ESTALE && lib_find_answer(name, host, buf, buflen) >= 0)
+        {
+          return OK;
+        }
+#endif
     }
 #endif /* CONFIG_NETDB_DNSCLIENT */
 
@@ -24,7 +24,12 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/tls.h>
 
 /****************************************************************************
  * Public Functions
@@ -82,6 +87,36 @@
 
 int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 {
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+  uint32_t unlocked = 0;
+
+  if (mutex != NULL)
+    {
+      /* Take an unlocked mutex without entering the OS */
+
+      if (__atomic_compare_exchange_n(&mutex->futex, &unlocked, 1, false,
+                                      __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+          mutex->pid    = tls_get_info()->tl_tid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          mutex->nlocks = 1;
+#endif
+          return OK;
+        }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      /* Only the holder changes the lock count of a recursive mutex */
+
+      if (mutex->type == PTHREAD_MUTEX_RECURSIVE &&
+          mutex->pid == tls_get_info()->tl_tid && mutex->nlocks < INT16_MAX)
+        {
+          mutex->nlocks++;
+          return OK;
+        }
+#endif
+    }
+#endif
+
   /* pthread_mutex_lock() is equivalent to pthread_mutex_timedlock() when
    * the absolute time delay is a NULL value.
    */
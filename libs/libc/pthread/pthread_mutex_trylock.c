@@ -0,0 +1,103 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_trylock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/tls.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_trylock
+ *
+ * Description:
+ *   The function pthread_mutex_trylock() is identical to the
+ *   pthread_mutex_lock() except that if the mutex object referenced by
+ *   mutex is currently locked (by any thread, including the current
+ *   thread), the call returns immediately with the errno EBUSY.
+ *
+ *   If a thread holding a PTHREAD_MUTEX_RECURSIVE mutex calls this
+ *   function, the lock count is incremented and the call succeeds.
+ *
+ *   With futex mutexes, this never enters the OS.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+{
+  uint32_t unlocked = 0;
+  pid_t mytid;
+
+  DEBUGASSERT(mutex != NULL);
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  mytid = tls_get_info()->tl_tid;
+  if (__atomic_compare_exchange_n(&mutex->futex, &unlocked, 1, false,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      mutex->pid    = mytid;
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      mutex->nlocks = 1;
+#endif
+      return OK;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  /* Check if recursive mutex was locked by the calling thread. */
+
+  if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->pid == mytid)
+    {
+      if (mutex->nlocks < INT16_MAX)
+        {
+          mutex->nlocks++;
+          return OK;
+        }
+
+      return EOVERFLOW;
+    }
+#endif
+
+  return EBUSY;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_unlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/futex.h>
+#include <nuttx/tls.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_unlock
+ *
+ * Description:
+ *   The pthread_mutex_unlock() function releases the mutex object referenced
+ *   by mutex.  A PTHREAD_MUTEX_RECURSIVE mutex becomes available when the
+ *   lock count reaches zero.
+ *
+ *   With futex mutexes, the OS is only entered to wake up a waiter of a
+ *   contended mutex.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be unlocked.
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+{
+  DEBUGASSERT(mutex != NULL);
+  if (mutex == NULL)
+    {
+      return EINVAL;
+    }
+
+  /* The unlock operation is only performed if the mutex is actually
+   * locked.
+   */
+
+  if (mutex->futex == 0)
+    {
+      return EPERM;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  /* Error checking is performed for the ERRORCHECK and RECURSIVE mutex
+   * types, never for the non-robust NORMAL mutex.
+   */
+
+  if (mutex->type != PTHREAD_MUTEX_NORMAL &&
+      mutex->pid != tls_get_info()->tl_tid)
+    {
+      return EPERM;
+    }
+
+  if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->nlocks > 1)
+    {
+      mutex->nlocks--;
+      return OK;
+    }
+
+  mutex->nlocks = 0;
+#endif
+
+  /* Nullify the pid, then release the futex word and wake up one waiter
+   * if the mutex is contended.
+   */
+
+  mutex->pid = INVALID_PROCESS_ID;
+  if (__atomic_exchange_n(&mutex->futex, 0, __ATOMIC_RELEASE) == 2)
+    {
+      futex_wake(&mutex->futex, 1);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
@@ -0,0 +1,391 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_rwlock_futex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/futex.h>
+
+#ifdef CONFIG_PTHREAD_RWLOCK_FUTEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The state word holds the number of readers, the number of writers
+ * waiting, a flag telling that readers wait and a flag telling that a
+ * writer holds the lock.  The readers wait on the rseq futex and the
+ * writers on the wseq futex, so that an unlock only wakes up the threads
+ * that can take the lock: all the readers, or one writer.
+ */
+
+#define RW_READERS_MASK   0x00007fff
+#define RW_WRITER_ONE     0x00008000
+#define RW_WRITERS_MASK   0x3fff8000
+#define RW_READERS_WAIT   0x40000000
+#define RW_WRLOCKED       0x80000000
+
+#define RW_READERS(s)     ((s) & RW_READERS_MASK)
+#define RW_WRITERS(s)     ((s) & RW_WRITERS_MASK)
+
+/* The waiting writers keep new readers out with the writer preference */
+
+#ifdef CONFIG_PTHREAD_RWLOCK_PREFER_WRITER
+#  define RW_RDBLOCKED    (RW_WRLOCKED | RW_WRITERS_MASK)
+#else
+#  define RW_RDBLOCKED    RW_WRLOCKED
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwlock_cas
+ ****************************************************************************/
+
+static inline bool rwlock_cas(FAR pthread_rwlock_t *rw_lock,
+                              FAR uint32_t *state, uint32_t newstate)
+{
+  return __atomic_compare_exchange_n(&rw_lock->state, state, newstate,
+                                     false, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_RELAXED);
+}
+
+/****************************************************************************
+ * Name: rwlock_wake
+ *
+ * Description:
+ *   Wake up the threads waiting on a sequence futex.  The sequence changes
+ *   first, so that a thread about to wait on its old value does not block.
+ *
+ ****************************************************************************/
+
+static void rwlock_wake(FAR volatile uint32_t *seq, int nwake)
+{
+  __atomic_fetch_add(seq, 1, __ATOMIC_RELEASE);
+  futex_wake(seq, nwake);
+}
+
+/****************************************************************************
+ * Name: rwlock_abstime
+ *
+ * Description:
+ *   Convert an absolute time of 'clockid' into the CLOCK_REALTIME time that
+ *   futex_wait() expects.
+ *
+ ****************************************************************************/
+
+static FAR const struct timespec *
+rwlock_abstime(clockid_t clockid, FAR const struct timespec *ts,
+               FAR struct timespec *realtime)
+{
+  struct timespec now;
+  struct timespec delay;
+
+  if (ts == NULL || clockid == CLOCK_REALTIME)
+    {
+      return ts;
+    }
+
+  if (clock_gettime(clockid, &now) < 0 || ts->tv_nsec < 0 ||
+      ts->tv_nsec >= NSEC_PER_SEC)
+    {
+      return ts;
+    }
+
+  clock_timespec_subtract(ts, &now, &delay);
+  clock_gettime(CLOCK_REALTIME, &now);
+  clock_timespec_add(&now, &delay, realtime);
+  return realtime;
+}
+
+/****************************************************************************
+ * Name: rwlock_rdlock
+ ****************************************************************************/
+
+static int rwlock_rdlock(FAR pthread_rwlock_t *rw_lock, bool wait,
+                         FAR const struct timespec *abstime)
+{
+  uint32_t state = __atomic_load_n(&rw_lock->state, __ATOMIC_RELAXED);
+  uint32_t seq;
+  int err;
+
+  for (; ; )
+    {
+      if ((state & RW_RDBLOCKED) == 0)
+        {
+          if (RW_READERS(state) == RW_READERS_MASK)
+            {
+              return EAGAIN;
+            }
+
+          if (rwlock_cas(rw_lock, &state, state + 1))
+            {
+              return OK;
+            }
+
+          continue;
+        }
+
+      if (!wait)
+        {
+          return EBUSY;
+        }
+
+      /* Read the sequence before telling that a reader waits: A writer
+       * that unlocks after that changes it.
+       */
+
+      seq = __atomic_load_n(&rw_lock->rseq, __ATOMIC_ACQUIRE);
+      if ((state & RW_READERS_WAIT) == 0 &&
+          !rwlock_cas(rw_lock, &state, state | RW_READERS_WAIT))
+        {
+          continue;
+        }
+
+      err = futex_wait(&rw_lock->rseq, seq, abstime);
+      if (err == ETIMEDOUT || err == EINVAL)
+        {
+          return err;
+        }
+
+      state = __atomic_load_n(&rw_lock->state, __ATOMIC_RELAXED);
+    }
+}
+
+/****************************************************************************
+ * Name: rwlock_wrlock
+ ****************************************************************************/
+
+static int rwlock_wrlock(FAR pthread_rwlock_t *rw_lock, bool wait,
+                         FAR const struct timespec *abstime)
+{
+  uint32_t waiting = 0;
+  uint32_t state;
+  uint32_t seq;
+  int err;
+
+  for (; ; )
+    {
+      seq   = __atomic_load_n(&rw_lock->wseq, __ATOMIC_ACQUIRE);
+      state = __atomic_load_n(&rw_lock->state, __ATOMIC_RELAXED);
+
+      if ((state & RW_WRLOCKED) == 0 && RW_READERS(state) == 0)
+        {
+          if (rwlock_cas(rw_lock, &state,
+                         (state - waiting) | RW_WRLOCKED))
+            {
+              return OK;
+            }
+
+          continue;
+        }
+
+      if (!wait)
+        {
+          return EBUSY;
+        }
+
+      /* Count this writer among the waiting ones once, so that the unlocks
+       * wake it up.
+       */
+
+      if (waiting == 0)
+        {
+          if (RW_WRITERS(state) == RW_WRITERS_MASK)
+            {
+              return EAGAIN;
+            }
+
+          if (!rwlock_cas(rw_lock, &state, state + RW_WRITER_ONE))
+            {
+              continue;
+            }
+
+          waiting = RW_WRITER_ONE;
+        }
+
+      err = futex_wait(&rw_lock->wseq, seq, abstime);
+      if (err == ETIMEDOUT || err == EINVAL)
+        {
+          break;
+        }
+    }
+
+  /* Give up.  A wake-up may have been meant for this writer, pass it on to
+   * the next writer, or to the readers if it was the last one.
+   */
+
+  state = __atomic_sub_fetch(&rw_lock->state, RW_WRITER_ONE,
+                             __ATOMIC_ACQ_REL);
+  while ((state & RW_WRLOCKED) == 0 && RW_WRITERS(state) == 0 &&
+         (state & RW_READERS_WAIT) != 0)
+    {
+      if (rwlock_cas(rw_lock, &state, state & ~RW_READERS_WAIT))
+        {
+          rwlock_wake(&rw_lock->rseq, INT_MAX);
+          return err;
+        }
+    }
+
+  if ((state & RW_WRLOCKED) == 0 && RW_READERS(state) == 0 &&
+      RW_WRITERS(state) != 0)
+    {
+      rwlock_wake(&rw_lock->wseq, 1);
+    }
+
+  return err;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int pthread_rwlock_init(FAR pthread_rwlock_t *lock,
+                        FAR const pthread_rwlockattr_t *attr)
+{
+  if (attr != NULL)
+    {
+      return ENOSYS;
+    }
+
+  lock->state = 0;
+  lock->rseq  = 0;
+  lock->wseq  = 0;
+  return OK;
+}
+
+int pthread_rwlock_destroy(FAR pthread_rwlock_t *lock)
+{
+  return lock->state != 0 ? EBUSY : OK;
+}
+
+int pthread_rwlock_tryrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return rwlock_rdlock(rw_lock, false, NULL);
+}
+
+int pthread_rwlock_clockrdlock(FAR pthread_rwlock_t *rw_lock,
+                               clockid_t clockid,
+                               FAR const struct timespec *ts)
+{
+  struct timespec realtime;
+
+  return rwlock_rdlock(rw_lock, true,
+                       rwlock_abstime(clockid, ts, &realtime));
+}
+
+int pthread_rwlock_timedrdlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  return rwlock_rdlock(rw_lock, true, ts);
+}
+
+int pthread_rwlock_rdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return rwlock_rdlock(rw_lock, true, NULL);
+}
+
+int pthread_rwlock_trywrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return rwlock_wrlock(rw_lock, false, NULL);
+}
+
+int pthread_rwlock_clockwrlock(FAR pthread_rwlock_t *rw_lock,
+                               clockid_t clockid,
+                               FAR const struct timespec *ts)
+{
+  struct timespec realtime;
+
+  return rwlock_wrlock(rw_lock, true,
+                       rwlock_abstime(clockid, ts, &realtime));
+}
+
+int pthread_rwlock_timedwrlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  return rwlock_wrlock(rw_lock, true, ts);
+}
+
+int pthread_rwlock_wrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return rwlock_wrlock(rw_lock, true, NULL);
+}
+
+int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
+{
+  uint32_t state = __atomic_load_n(&rw_lock->state, __ATOMIC_RELAXED);
+  uint32_t newstate;
+
+  for (; ; )
+    {
+      if ((state & RW_WRLOCKED) != 0)
+        {
+          /* The readers go on waiting while writers wait, if the writers
+           * are preferred.
+           */
+
+          newstate = state & ~RW_WRLOCKED;
+          if ((newstate & RW_RDBLOCKED) == 0)
+            {
+              newstate &= ~RW_READERS_WAIT;
+            }
+        }
+      else if (RW_READERS(state) > 0)
+        {
+          newstate = state - 1;
+        }
+      else
+        {
+          return EINVAL;
+        }
+
+      if (rwlock_cas(rw_lock, &state, newstate))
+        {
+          break;
+        }
+    }
+
+  if ((state & RW_READERS_WAIT) != 0 &&
+      (newstate & RW_READERS_WAIT) == 0)
+    {
+      rwlock_wake(&rw_lock->rseq, INT_MAX);
+    }
+
+  if (RW_READERS(newstate) == 0 && RW_WRITERS(newstate) != 0)
+    {
+      rwlock_wake(&rw_lock->wseq, 1);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_RWLOCK_FUTEX */
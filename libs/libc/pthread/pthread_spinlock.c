@@ -186,7 +186,7 @@ int pthread_spin_lock(pthread_spinlock_t *lock)
   do
     {
 #ifdef CONFIG_BUILD_FLAT
-      ret = up_testset(&lock->sp_lock) == SP_LOCKED ? 1 : 0;
+      ret = up_testset(&lock->sp_lock) != SP_UNLOCKED ? 1 : 0;
 #else
       ret = boardctl(BOARDIOC_TESTSET, (uintptr_t)&lock->sp_lock);
 #endif
@@ -304,14 +304,14 @@ int pthread_spin_unlock(pthread_spinlock_t *lock)
   pthread_t me = pthread_self();
 
   DEBUGASSERT(lock != NULL &&
-              lock->sp_lock == SP_LOCKED &&
+              lock->sp_lock != SP_UNLOCKED &&
               lock->sp_holder == me);
 
   if (lock == NULL)
     {
       return EINVAL;
     }
-  else if (lock->sp_lock != SP_LOCKED || lock->sp_holder != me)
+  else if (lock->sp_lock == SP_UNLOCKED || lock->sp_holder != me)
     {
       return EPERM;
     }
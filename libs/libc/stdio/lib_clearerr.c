@@ -48,6 +48,6 @@
 
 void clearerr(FAR FILE *stream)
 {
-  stream->fs_flags &= (__FS_FLAG_LBF | __FS_FLAG_UBF);
+  stream->fs_flags &= ~(__FS_FLAG_EOF | __FS_FLAG_ERROR);
 }
 #endif /* CONFIG_FILE_STREAM */
@@ -38,8 +38,10 @@
  ****************************************************************************/
 
 #include <math.h>
+#include <string.h>
 
 #include "lib_dtoa_engine.h"
+#include "lib_ultoa_invert.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -59,6 +61,35 @@
 #define MAX(a, b)     ((a) > (b) ? (a) : (b))
 #define MIN(a, b)     ((a) < (b) ? (a) : (b))
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+/****************************************************************************
+ * Name: dtoa_dec8
+ *
+ * Description:
+ *   Write the eight decimal digits of val, most significant first, two
+ *   digits per 32 bit division.
+ *
+ ****************************************************************************/
+
+static void dtoa_dec8(uint32_t val, FAR char *str)
+{
+  FAR const char *pair;
+  int i;
+
+  for (i = 6; i >= 0; i -= 2)
+    {
+      pair       = &g_ultoa_digits2[2 * (val % 100)];
+      val       /= 100;
+      str[i]     = pair[0];
+      str[i + 1] = pair[1];
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -150,6 +181,17 @@ int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
       /* Now convert mantissa to decimal. */
 
       uint64_t mant = (uint64_t) x;
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+      char digits[16];
+
+      /* The mantissa has 16 digits: Split it in two halves of 8 digits with
+       * the only 64 bit division.
+       */
+
+      dtoa_dec8(mant / 100000000, digits);
+      dtoa_dec8(mant % 100000000, &digits[8]);
+      memcpy(dtoa->digits, digits, max_digits);
+#else
       uint64_t decimal = MIN_MANT_INT;
 
       /* Compute digits */
@@ -160,6 +202,7 @@ int __dtoa_engine(double x, FAR struct dtoa_s *dtoa, int max_digits,
           mant %= decimal;
           decimal /= 10;
         }
+#endif
     }
 
   dtoa->digits[max_digits] = '\0';
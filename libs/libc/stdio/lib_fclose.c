@@ -111,25 +111,20 @@ int fclose(FAR FILE *stream)
 
       lib_stream_semgive(slist);
 
-      /* Check that the underlying file descriptor corresponds to an an open
-       * file.
+      /* Close the file descriptor or the cookie and save the return
+       * status.
        */
 
-      if (stream->fs_fd >= 0)
-        {
-          /* Close the file descriptor and save the return status */
-
-          status = close(stream->fs_fd);
+      status = lib_stream_close(stream);
 
-          /* If close() returns an error but flush() did not then make sure
-           * that we return the close() error condition.
-           */
+      /* If close() returns an error but flush() did not then make sure
+       * that we return the close() error condition.
+       */
 
-          if (ret == OK)
-            {
-              ret = status;
-              errcode = get_errno();
-            }
+      if (ret == OK && status < 0)
+        {
+          ret = status;
+          errcode = get_errno();
         }
 
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
@@ -48,3 +48,23 @@ int fgetc(FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * fgetc_unlocked
+ ****************************************************************************/
+
+int fgetc_unlocked(FAR FILE *stream)
+{
+  unsigned char ch;
+  ssize_t ret;
+
+  ret = lib_fread_unlocked(&ch, 1, stream);
+  if (ret > 0)
+    {
+      return ch;
+    }
+  else
+    {
+      return EOF;
+    }
+}
@@ -0,0 +1,261 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_fmemopen.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct fmemopen_cookie_s
+{
+  FAR char *buf;        /* The buffer of the stream */
+  size_t    size;       /* The size of the buffer */
+  size_t    len;        /* The size of the data in the buffer */
+  size_t    pos;        /* The current position */
+  bool      allocated;  /* fmemopen() allocated the buffer */
+  bool      append;     /* The writes go at the end of the data */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fmemopen_read
+ ****************************************************************************/
+
+static ssize_t fmemopen_read(FAR void *cookie, FAR char *buf, size_t size)
+{
+  FAR struct fmemopen_cookie_s *mem = cookie;
+
+  if (size > mem->len - mem->pos)
+    {
+      size = mem->pos < mem->len ? mem->len - mem->pos : 0;
+    }
+
+  memcpy(buf, &mem->buf[mem->pos], size);
+  mem->pos += size;
+  return size;
+}
+
+/****************************************************************************
+ * Name: fmemopen_write
+ ****************************************************************************/
+
+static ssize_t fmemopen_write(FAR void *cookie, FAR const char *buf,
+                              size_t size)
+{
+  FAR struct fmemopen_cookie_s *mem = cookie;
+
+  if (mem->append)
+    {
+      mem->pos = mem->len;
+    }
+
+  if (size > mem->size - mem->pos)
+    {
+      size = mem->size - mem->pos;
+      if (size == 0)
+        {
+          set_errno(ENOSPC);
+          return ERROR;
+        }
+    }
+
+  memcpy(&mem->buf[mem->pos], buf, size);
+  mem->pos += size;
+  if (mem->pos > mem->len)
+    {
+      mem->len = mem->pos;
+
+      /* Keep the data NUL terminated while there is room for it */
+
+      if (mem->len < mem->size)
+        {
+          mem->buf[mem->len] = '\0';
+        }
+    }
+
+  return size;
+}
+
+/****************************************************************************
+ * Name: fmemopen_seek
+ ****************************************************************************/
+
+static int fmemopen_seek(FAR void *cookie, FAR off_t *offset, int whence)
+{
+  FAR struct fmemopen_cookie_s *mem = cookie;
+  off_t pos;
+
+  switch (whence)
+    {
+      case SEEK_SET:
+        pos = *offset;
+        break;
+
+      case SEEK_CUR:
+        pos = mem->pos + *offset;
+        break;
+
+      case SEEK_END:
+        pos = mem->len + *offset;
+        break;
+
+      default:
+        set_errno(EINVAL);
+        return ERROR;
+    }
+
+  if (pos < 0 || pos > mem->size)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  mem->pos = pos;
+  *offset  = pos;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fmemopen_close
+ ****************************************************************************/
+
+static int fmemopen_close(FAR void *cookie)
+{
+  FAR struct fmemopen_cookie_s *mem = cookie;
+
+  if (mem->allocated)
+    {
+      lib_free(mem->buf);
+    }
+
+  lib_free(mem);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fmemopen
+ *
+ * Description:
+ *   Open a stream on the 'size' bytes at 'buf', or on a buffer that it
+ *   allocates and frees on fclose() if 'buf' is NULL.  The stream is not
+ *   buffered: The reads and the writes copy directly between the memory and
+ *   the caller.
+ *
+ ****************************************************************************/
+
+FAR FILE *fmemopen(FAR void *buf, size_t size, FAR const char *mode)
+{
+  cookie_io_functions_t funcs =
+    {
+      fmemopen_read, fmemopen_write, fmemopen_seek, fmemopen_close
+    };
+
+  FAR struct fmemopen_cookie_s *mem;
+  FAR FILE *stream;
+  int oflags;
+
+  oflags = lib_mode2oflags(mode);
+  if (oflags < 0)
+    {
+      return NULL;
+    }
+
+  if (size == 0)
+    {
+      set_errno(EINVAL);
+      return NULL;
+    }
+
+  mem = lib_zalloc(sizeof(struct fmemopen_cookie_s));
+  if (mem == NULL)
+    {
+      set_errno(ENOMEM);
+      return NULL;
+    }
+
+  if (buf == NULL)
+    {
+      buf = lib_zalloc(size);
+      if (buf == NULL)
+        {
+          lib_free(mem);
+          set_errno(ENOMEM);
+          return NULL;
+        }
+
+      mem->allocated = true;
+    }
+
+  mem->buf  = buf;
+  mem->size = size;
+
+  /* "r" reads all of the buffer, "w" truncates it and "a" appends to the
+   * string that it holds.
+   */
+
+  if ((oflags & O_APPEND) != 0)
+    {
+      mem->len    = strnlen(buf, size);
+      mem->pos    = mem->len;
+      mem->append = true;
+    }
+  else if ((oflags & O_TRUNC) != 0)
+    {
+      mem->buf[0] = '\0';
+    }
+  else
+    {
+      mem->len = size;
+    }
+
+  stream = fopencookie(mem, mode, funcs);
+  if (stream == NULL)
+    {
+      fmemopen_close(mem);
+      return NULL;
+    }
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  setvbuf(stream, NULL, _IONBF, 0);
+#endif
+
+  return stream;
+}
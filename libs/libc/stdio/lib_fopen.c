@@ -122,6 +122,20 @@ FAR FILE *fopen(FAR const char *path, FAR const char *mode)
           set_errno(-ret);
           filep = NULL;
         }
+
+#if defined(CONFIG_STDIO_FOPEN_BUFFER_SIZE) && \
+    CONFIG_STDIO_FOPEN_BUFFER_SIZE > CONFIG_STDIO_BUFFER_SIZE
+      /* Give the file its larger buffer, keeping the embedded one if it
+       * cannot be allocated.
+       */
+
+      if (filep != NULL)
+        {
+          setvbuf(filep, NULL,
+                  (filep->fs_flags & __FS_FLAG_LBF) != 0 ? _IOLBF : _IOFBF,
+                  CONFIG_STDIO_FOPEN_BUFFER_SIZE);
+        }
+#endif
     }
 
   return filep;
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_fopencookie.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The read and write functions return the negated errno value like
+ * _NX_READ() and _NX_WRITE() do, inside the OS of the protected and kernel
+ * builds.
+ */
+
+#if !defined(CONFIG_BUILD_FLAT) && defined(__KERNEL__)
+#  define COOKIE_RETURN(r) ((r) < 0 ? -get_errno() : (r))
+#else
+#  define COOKIE_RETURN(r) (r)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The streams of fopencookie() are allocated with their functions, so that
+ * the other streams do not pay for them.
+ */
+
+struct lib_cookiefile_s
+{
+  FILE                  file;   /* Must be first */
+  FAR void             *cookie;
+  cookie_io_functions_t funcs;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline FAR struct lib_cookiefile_s *lib_cookiefile(FAR FILE *stream)
+{
+  return (FAR struct lib_cookiefile_s *)stream;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_stream_read, lib_stream_write
+ *
+ * Description:
+ *   Read or write the file descriptor or the cookie of the stream.  They
+ *   return what _NX_READ() and _NX_WRITE() return.
+ *
+ ****************************************************************************/
+
+ssize_t lib_stream_read(FAR FILE *stream, FAR void *buf, size_t size)
+{
+  FAR struct lib_cookiefile_s *cfile;
+  ssize_t ret;
+
+  if ((stream->fs_flags & __FS_FLAG_COOKIE) == 0)
+    {
+      return _NX_READ(stream->fs_fd, buf, size);
+    }
+
+  cfile = lib_cookiefile(stream);
+  if (cfile->funcs.read == NULL)
+    {
+      set_errno(EBADF);
+      return COOKIE_RETURN(ERROR);
+    }
+
+  ret = cfile->funcs.read(cfile->cookie, buf, size);
+  return COOKIE_RETURN(ret);
+}
+
+ssize_t lib_stream_write(FAR FILE *stream, FAR const void *buf,
+                         size_t size)
+{
+  FAR struct lib_cookiefile_s *cfile;
+  ssize_t ret;
+
+  if ((stream->fs_flags & __FS_FLAG_COOKIE) == 0)
+    {
+      return _NX_WRITE(stream->fs_fd, buf, size);
+    }
+
+  /* A stream without write function discards the data */
+
+  cfile = lib_cookiefile(stream);
+  if (cfile->funcs.write == NULL)
+    {
+      return size;
+    }
+
+  ret = cfile->funcs.write(cfile->cookie, buf, size);
+  return COOKIE_RETURN(ret);
+}
+
+/****************************************************************************
+ * Name: lib_stream_seek, lib_stream_close
+ *
+ * Description:
+ *   Seek or close the file descriptor or the cookie of the stream.  They
+ *   return what lseek() and close() return.
+ *
+ ****************************************************************************/
+
+off_t lib_stream_seek(FAR FILE *stream, off_t offset, int whence)
+{
+  FAR struct lib_cookiefile_s *cfile;
+
+  if ((stream->fs_flags & __FS_FLAG_COOKIE) == 0)
+    {
+      return lseek(stream->fs_fd, offset, whence);
+    }
+
+  cfile = lib_cookiefile(stream);
+  if (cfile->funcs.seek == NULL)
+    {
+      set_errno(ESPIPE);
+      return ERROR;
+    }
+
+  if (cfile->funcs.seek(cfile->cookie, &offset, whence) < 0)
+    {
+      return ERROR;
+    }
+
+  return offset;
+}
+
+int lib_stream_close(FAR FILE *stream)
+{
+  FAR struct lib_cookiefile_s *cfile;
+
+  if ((stream->fs_flags & __FS_FLAG_COOKIE) == 0)
+    {
+      return stream->fs_fd >= 0 ? close(stream->fs_fd) : OK;
+    }
+
+  cfile = lib_cookiefile(stream);
+  return cfile->funcs.close != NULL ? cfile->funcs.close(cfile->cookie) :
+         OK;
+}
+
+/****************************************************************************
+ * Name: fopencookie
+ *
+ * Description:
+ *   Open a stream that reads, writes, seeks and closes through the
+ *   functions of io_funcs, which receive the cookie, rather than through
+ *   a file descriptor.  fileno() fails on the stream with EBADF.
+ *
+ ****************************************************************************/
+
+FAR FILE *fopencookie(FAR void *cookie, FAR const char *mode,
+                      cookie_io_functions_t io_funcs)
+{
+  FAR struct lib_cookiefile_s *cfile;
+  FAR struct streamlist *slist;
+  FAR FILE *stream;
+  int oflags;
+
+  oflags = lib_mode2oflags(mode);
+  if (oflags < 0)
+    {
+      return NULL;
+    }
+
+  cfile = lib_zalloc(sizeof(struct lib_cookiefile_s));
+  if (cfile == NULL)
+    {
+      set_errno(ENOMEM);
+      return NULL;
+    }
+
+  cfile->cookie = cookie;
+  cfile->funcs  = io_funcs;
+
+  stream = &cfile->file;
+  lib_sem_initialize(stream);
+
+#if !defined(CONFIG_STDIO_DISABLE_BUFFERING) && CONFIG_STDIO_BUFFER_SIZE > 0
+  stream->fs_bufstart = stream->fs_buffer;
+  stream->fs_bufend   = &stream->fs_bufstart[CONFIG_STDIO_BUFFER_SIZE];
+  stream->fs_bufpos   = stream->fs_bufstart;
+  stream->fs_bufread  = stream->fs_bufstart;
+  stream->fs_flags    = __FS_FLAG_UBF; /* Fake setvbuf and fclose */
+#endif
+
+  stream->fs_fd       = -1;
+  stream->fs_oflags   = oflags;
+  stream->fs_flags   |= __FS_FLAG_COOKIE;
+
+  /* Add the stream to the list, as fdopen() does */
+
+  slist = nxsched_get_streams();
+  lib_stream_semtake(slist);
+
+  if (slist->sl_tail != NULL)
+    {
+      slist->sl_tail->fs_next = stream;
+    }
+  else
+    {
+      slist->sl_head = stream;
+    }
+
+  slist->sl_tail = stream;
+  lib_stream_semgive(slist);
+
+  return stream;
+}
@@ -83,5 +83,5 @@ int fseeko(FAR FILE *stream, off_t offset, int whence)
 
   /* Perform the fseeko on the underlying file descriptor */
 
-  return lseek(stream->fs_fd, offset, whence) == (off_t)-1 ? ERROR : OK;
+  return lib_stream_seek(stream, offset, whence) == (off_t)-1 ? ERROR : OK;
 }
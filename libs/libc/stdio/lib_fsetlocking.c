@@ -0,0 +1,97 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_fsetlocking.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <errno.h>
+
+#include <nuttx/mutex.h>
+#include <nuttx/fs/fs.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __fsetlocking
+ *
+ * Description:
+ *   Select the type of locking of the stream.  With FSETLOCKING_BYCALLER
+ *   the stdio functions do not lock the stream any longer, as if they were
+ *   all the _unlocked variants: The stream is used by a single thread, or
+ *   the caller locks it with flockfile().  FSETLOCKING_INTERNAL restores
+ *   the default locking, and FSETLOCKING_QUERY changes nothing.
+ *
+ * Returned Value:
+ *   The type of locking before the call, FSETLOCKING_INTERNAL or
+ *   FSETLOCKING_BYCALLER; or ERROR with errno set on failure.
+ *
+ ****************************************************************************/
+
+int __fsetlocking(FAR FILE *stream, int type)
+{
+  int ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  if (type < FSETLOCKING_QUERY || type > FSETLOCKING_BYCALLER)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  /* Change the type under the lock itself: lib_take_semaphore() and
+   * lib_give_semaphore() must not see it change in between.
+   */
+
+  nxrmutex_lock(&stream->fs_lock);
+#endif
+
+  ret = (stream->fs_flags & __FS_FLAG_BYCALLER) != 0 ?
+        FSETLOCKING_BYCALLER : FSETLOCKING_INTERNAL;
+
+  if (type == FSETLOCKING_BYCALLER)
+    {
+      stream->fs_flags |= __FS_FLAG_BYCALLER;
+    }
+  else if (type == FSETLOCKING_INTERNAL)
+    {
+      stream->fs_flags &= ~__FS_FLAG_BYCALLER;
+    }
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  nxrmutex_unlock(&stream->fs_lock);
+#endif
+
+  return ret;
+}
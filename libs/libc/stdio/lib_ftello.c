@@ -110,7 +110,7 @@ off_t ftello(FAR FILE *stream)
    * file pointer, but will return its current setting
    */
 
-  position = lseek(stream->fs_fd, 0, SEEK_CUR);
+  position = lib_stream_seek(stream, 0, SEEK_CUR);
   if (position != (off_t)-1)
     {
       return position - lib_getoffset(stream);
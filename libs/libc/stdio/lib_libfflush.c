@@ -66,7 +66,7 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
 
   /* Return EBADF if the file is not opened for writing */
 
-  if (stream->fs_fd < 0 || (stream->fs_oflags & O_WROK) == 0)
+  if (!lib_stream_isopen(stream) || (stream->fs_oflags & O_WROK) == 0)
     {
       return -EBADF;
     }
@@ -114,7 +114,7 @@ ssize_t lib_fflush(FAR FILE *stream, bool bforce)
         {
           /* Perform the write */
 
-          bytes_written = _NX_WRITE(stream->fs_fd, src, nbuffer);
+          bytes_written = lib_stream_write(stream, src, nbuffer);
           if (bytes_written < 0)
             {
               /* Write failed.  The cause of the failure is in 'errno'.
@@ -134,7 +134,7 @@ FAR char *lib_fgets(FAR char *buf, size_t buflen, FILE *stream,
 
   /* Sanity checks */
 
-  if (!stream || !buf || stream->fs_fd < 0)
+  if (!stream || !buf || !lib_stream_isopen(stream))
     {
       return NULL;
     }
@@ -59,7 +59,14 @@ void lib_sem_initialize(FAR struct file_struct *stream)
 
 void lib_take_semaphore(FAR struct file_struct *stream)
 {
-  nxrmutex_lock(&stream->fs_lock);
+  /* The caller of __fsetlocking(FSETLOCKING_BYCALLER) does the locking,
+   * if any is needed.
+   */
+
+  if ((stream->fs_flags & __FS_FLAG_BYCALLER) == 0)
+    {
+      nxrmutex_lock(&stream->fs_lock);
+    }
 }
 
 /****************************************************************************
@@ -68,7 +75,10 @@ void lib_take_semaphore(FAR struct file_struct *stream)
 
 void lib_give_semaphore(FAR struct file_struct *stream)
 {
-  nxrmutex_unlock(&stream->fs_lock);
+  if ((stream->fs_flags & __FS_FLAG_BYCALLER) == 0)
+    {
+      nxrmutex_unlock(&stream->fs_lock);
+    }
 }
 
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
@@ -41,10 +41,14 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   Read from the stream, which the caller has locked.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest = (FAR unsigned char *)ptr;
   ssize_t bytes_read;
@@ -62,10 +66,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -153,7 +153,7 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
 
                   if (remaining > buffer_available)
                     {
-                      bytes_read = _NX_READ(stream->fs_fd, dest, remaining);
+                      bytes_read = lib_stream_read(stream, dest, remaining);
                       if (bytes_read < 0)
                         {
                           if (count - remaining > 0)
@@ -196,7 +196,7 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
                        * into the buffer.
                        */
 
-                      bytes_read = _NX_READ(stream->fs_fd,
+                      bytes_read = lib_stream_read(stream,
                                             stream->fs_bufread,
                                             buffer_available);
                       if (bytes_read < 0)
@@ -241,7 +241,7 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
 
           while (remaining > 0)
             {
-              bytes_read = _NX_READ(stream->fs_fd, dest, remaining);
+              bytes_read = lib_stream_read(stream, dest, remaining);
               if (bytes_read < 0)
                 {
                   if (count - remaining > 0)
@@ -298,7 +298,6 @@ shortread:
           stream->fs_flags |= __FS_FLAG_EOF;
         }
 
-      lib_give_semaphore(stream);
       return count - remaining;
     }
 
@@ -306,6 +305,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return ERROR;
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -40,15 +40,23 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fwrite
+ * Name: lib_fwrite_unlocked
+ *
+ * Description:
+ *   Write to the stream, which the caller has locked.  The requests of at
+ *   least the size of the buffer bypass it: Once the data already buffered
+ *   is flushed, they are written directly from the caller's memory.
+ *
  ****************************************************************************/
 
-ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream)
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 {
   FAR const unsigned char *start = ptr;
   FAR const unsigned char *src   = ptr;
   ssize_t ret = ERROR;
+  size_t bufsize;
   size_t gulp_size;
 
   /* Make sure that writing to this stream is allowed */
@@ -71,7 +79,7 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   if (stream->fs_bufstart == NULL)
     {
-      ret = _NX_WRITE(stream->fs_fd, ptr, count);
+      ret = lib_stream_write(stream, ptr, count);
       if (ret < 0)
         {
           _NX_SETERRNO(ret);
@@ -81,10 +89,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
       goto errout;
     }
 
-  /* Get exclusive access to the stream */
-
-  lib_take_semaphore(stream);
-
   /* If the buffer is currently being used for read access, then
    * discard all of the read-ahead data.  We do not support concurrent
    * buffered read/write access.
@@ -92,14 +96,41 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   if (lib_rdflush(stream) < 0)
     {
-      goto errout_with_semaphore;
+      goto errout;
     }
 
-  /* Determine the number of bytes left in the buffer */
+  /* The buffer may have been resized by setvbuf() */
 
-  gulp_size = stream->fs_bufend - stream->fs_bufpos;
-  if (gulp_size != CONFIG_STDIO_BUFFER_SIZE || count < gulp_size)
+  bufsize = stream->fs_bufend - stream->fs_bufstart;
+
+  while (count > 0)
     {
+      /* Write the large requests directly when the buffer is empty,
+       * instead of copying them through it.
+       */
+
+      if (stream->fs_bufpos == stream->fs_bufstart && count >= bufsize)
+        {
+          ret = lib_stream_write(stream, src, count);
+          if (ret < 0)
+            {
+              _NX_SETERRNO(ret);
+              ret = ERROR;
+              goto errout;
+            }
+          else if (ret == 0)
+            {
+              break;
+            }
+
+          src   += ret;
+          count -= ret;
+          continue;
+        }
+
+      /* Determine the number of bytes left in the buffer */
+
+      gulp_size = stream->fs_bufend - stream->fs_bufpos;
       if (gulp_size > count)
         {
           /* Yes, clip the gulp to the size of the user data */
@@ -107,58 +138,30 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
           gulp_size = count;
         }
 
-      /* Adjust the number of bytes remaining to be transferred
-       * on the next pass through the loop (might be zero).
-       */
-
-      count -= gulp_size;
-
       /* Transfer the data into the buffer */
 
       memcpy(stream->fs_bufpos, src, gulp_size);
       stream->fs_bufpos += gulp_size;
-      src += gulp_size;
+      src   += gulp_size;
+      count -= gulp_size;
 
-      /* Is the buffer full? */
+      /* Is the buffer full?  Flush all of it, so that the rest of a large
+       * request can bypass the buffer.
+       */
 
       if (stream->fs_bufpos >= stream->fs_bufend)
         {
-          /* Flush the buffered data to the IO stream */
-
-          int bytes_buffered = lib_fflush(stream, false);
-          if (bytes_buffered < 0)
+          if (lib_fflush(stream, true) < 0)
             {
-              goto errout_with_semaphore;
+              goto errout;
             }
         }
     }
 
-  if (count >= CONFIG_STDIO_BUFFER_SIZE)
-    {
-      ret = _NX_WRITE(stream->fs_fd, src, count);
-      if (ret < 0)
-        {
-          _NX_SETERRNO(ret);
-          ret = ERROR;
-          goto errout_with_semaphore;
-        }
-
-      src += ret;
-    }
-  else if (count > 0)
-    {
-      memcpy(stream->fs_bufpos, src, count);
-      stream->fs_bufpos += count;
-      src += count;
-    }
-
   /* Return the number of bytes written */
 
   ret = (uintptr_t)src - (uintptr_t)start;
 
-errout_with_semaphore:
-  lib_give_semaphore(stream);
-
 errout:
   if (ret < 0)
     {
@@ -169,7 +172,7 @@ errout:
 }
 #else
 {
-  ssize_t ret = _NX_WRITE(stream->fs_fd, ptr, count);
+  ssize_t ret = lib_stream_write(stream, ptr, count);
   if (ret < 0)
     {
       stream->fs_flags |= __FS_FLAG_ERROR;
@@ -179,3 +182,24 @@ errout:
   return ret;
 }
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
+
+/****************************************************************************
+ * Name: lib_fwrite
+ ****************************************************************************/
+
+ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  lib_take_semaphore(stream);
+  ret = lib_fwrite_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -0,0 +1,227 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_openmemstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/streams.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct memstream_cookie_s
+{
+  struct lib_growoutstream_s stream; /* The data written so far */
+  FAR char                 **bufp;   /* Where the buffer is published */
+  FAR size_t                *sizep;  /* Where the size is published */
+  size_t                     pos;    /* The current position */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memstream_update
+ *
+ * Description:
+ *   Publish the buffer and the size, the smaller of the current position
+ *   and of the size of the data.
+ *
+ ****************************************************************************/
+
+static void memstream_update(FAR struct memstream_cookie_s *mem)
+{
+  size_t len = mem->stream.public.nput;
+
+  *mem->bufp  = mem->stream.buffer;
+  *mem->sizep = mem->pos < len ? mem->pos : len;
+}
+
+/****************************************************************************
+ * Name: memstream_write
+ ****************************************************************************/
+
+static ssize_t memstream_write(FAR void *cookie, FAR const char *buf,
+                               size_t size)
+{
+  FAR struct memstream_cookie_s *mem = cookie;
+  size_t len = mem->stream.public.nput;
+  size_t end = mem->pos + size;
+  FAR char *dest;
+
+  /* Grow the data up to the end of the write, with zeros if the position
+   * is past its end.
+   */
+
+  if (end > len)
+    {
+      dest = lib_growoutstream_reserve(&mem->stream, end - len);
+      if (dest == NULL)
+        {
+          set_errno(ENOMEM);
+          return ERROR;
+        }
+
+      if (mem->pos > len)
+        {
+          memset(dest, 0, mem->pos - len);
+        }
+
+      lib_growoutstream_commit(&mem->stream, end - len);
+    }
+
+  memcpy(&mem->stream.buffer[mem->pos], buf, size);
+  mem->pos = end;
+  memstream_update(mem);
+  return size;
+}
+
+/****************************************************************************
+ * Name: memstream_seek
+ ****************************************************************************/
+
+static int memstream_seek(FAR void *cookie, FAR off_t *offset, int whence)
+{
+  FAR struct memstream_cookie_s *mem = cookie;
+  off_t pos;
+
+  switch (whence)
+    {
+      case SEEK_SET:
+        pos = *offset;
+        break;
+
+      case SEEK_CUR:
+        pos = mem->pos + *offset;
+        break;
+
+      case SEEK_END:
+        pos = mem->stream.public.nput + *offset;
+        break;
+
+      default:
+        set_errno(EINVAL);
+        return ERROR;
+    }
+
+  if (pos < 0 || pos >= INT_MAX)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  mem->pos = pos;
+  *offset  = pos;
+  memstream_update(mem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memstream_close
+ ****************************************************************************/
+
+static int memstream_close(FAR void *cookie)
+{
+  FAR struct memstream_cookie_s *mem = cookie;
+
+  memstream_update(mem);
+  lib_free(mem);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: open_memstream
+ *
+ * Description:
+ *   Open a stream for writing to a buffer that grows as needed.  The
+ *   buffer and the size of the data are published in *bufp and *sizep on
+ *   each write, fflush() and fclose().  The data is NUL terminated, and the
+ *   caller frees the buffer with free() after fclose().  The stream is not
+ *   buffered: The writes copy the data into the final buffer directly.
+ *
+ ****************************************************************************/
+
+FAR FILE *open_memstream(FAR char **bufp, FAR size_t *sizep)
+{
+  cookie_io_functions_t funcs =
+    {
+      NULL, memstream_write, memstream_seek, memstream_close
+    };
+
+  FAR struct memstream_cookie_s *mem;
+  FAR FILE *stream;
+
+  if (bufp == NULL || sizep == NULL)
+    {
+      set_errno(EINVAL);
+      return NULL;
+    }
+
+  mem = lib_zalloc(sizeof(struct memstream_cookie_s));
+  if (mem == NULL)
+    {
+      set_errno(ENOMEM);
+      return NULL;
+    }
+
+  /* Allocate the buffer now, so that *bufp is valid before any write */
+
+  lib_growoutstream(&mem->stream, 0);
+  if (lib_growoutstream_reserve(&mem->stream, 0) == NULL)
+    {
+      lib_free(mem);
+      set_errno(ENOMEM);
+      return NULL;
+    }
+
+  mem->bufp  = bufp;
+  mem->sizep = sizep;
+  memstream_update(mem);
+
+  stream = fopencookie(mem, "w", funcs);
+  if (stream == NULL)
+    {
+      lib_free(lib_growoutstream_detach(&mem->stream));
+      lib_free(mem);
+      return NULL;
+    }
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  setvbuf(stream, NULL, _IONBF, 0);
+#endif
+
+  return stream;
+}
@@ -133,7 +133,7 @@ int setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size)
 
   /* Return EBADF if the file is not open */
 
-  if (stream->fs_fd < 0)
+  if (!lib_stream_isopen(stream))
     {
       errcode = EBADF;
       goto errout_with_semaphore;
@@ -37,8 +37,71 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdint.h>
+
 #include "lib_ultoa_invert.h"
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+const char g_ultoa_digits2[200] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+/****************************************************************************
+ * Name: ultoa_invert_dec32
+ *
+ * Description:
+ *   Convert val to decimal, least significant digit first, two digits per
+ *   division.  At least 'ndigits' digits are written, padded with zeros.
+ *
+ ****************************************************************************/
+
+static FAR char *ultoa_invert_dec32(uint32_t val, FAR char *str,
+                                    int ndigits)
+{
+  FAR char *end = str + ndigits;
+  FAR const char *pair;
+
+  while (val >= 100)
+    {
+      pair   = &g_ultoa_digits2[2 * (val % 100)];
+      val   /= 100;
+      *str++ = pair[1];
+      *str++ = pair[0];
+    }
+
+  if (val >= 10)
+    {
+      pair   = &g_ultoa_digits2[2 * val];
+      *str++ = pair[1];
+      *str++ = pair[0];
+    }
+  else
+    {
+      *str++ = '0' + val;
+    }
+
+  while (str < end)
+    {
+      *str++ = '0';
+    }
+
+  return str;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -57,6 +120,38 @@ FAR char *__ultoa_invert(unsigned long val, FAR char *str, int base)
       base &= ~XTOA_UPPER;
     }
 
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+  if (base == 10)
+    {
+      /* Peel nine digits off the values that do not fit in 32 bits, so
+       * that the rest is done with 32 bit divisions.
+       */
+
+      while (val > UINT32_MAX)
+        {
+          str = ultoa_invert_dec32(val % 1000000000, str, 9);
+          val = val / 1000000000;
+        }
+
+      return ultoa_invert_dec32(val, str, 1);
+    }
+  else if (base == 16 || base == 8)
+    {
+      FAR const char *xdigits = upper ? "0123456789ABCDEF" :
+                                        "0123456789abcdef";
+      int shift = base == 16 ? 4 : 3;
+
+      do
+        {
+          *str++ = xdigits[val & (base - 1)];
+          val  >>= shift;
+        }
+      while (val);
+
+      return str;
+    }
+#endif
+
   do
     {
       int v;
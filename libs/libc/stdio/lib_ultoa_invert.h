@@ -61,6 +61,18 @@
 #define XTOA_PREFIX  0x0100    /* Put prefix for octal or hex */
 #define XTOA_UPPER   0x0200    /* Use upper case letters */
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_PRINTF_FASTDIGITS
+/* The two decimal digits of 00 to 99, for the conversions that divide by
+ * 100 instead of 10.
+ */
+
+extern const char g_ultoa_digits2[200];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
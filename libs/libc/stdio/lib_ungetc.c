@@ -53,7 +53,7 @@ int ungetc(int c, FAR FILE *stream)
 
   /* Stream must be open for read access */
 
-  if ((stream->fs_fd < 0) || ((stream->fs_oflags & O_RDOK) == 0))
+  if (!lib_stream_isopen(stream) || ((stream->fs_oflags & O_RDOK) == 0))
     {
       set_errno(EBADF);
       return EOF;
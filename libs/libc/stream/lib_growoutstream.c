@@ -0,0 +1,192 @@
+/****************************************************************************
+ * libs/libc/stream/lib_growoutstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include <assert.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: growoutstream_puts
+ ****************************************************************************/
+
+static int growoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const void *buf, int len)
+{
+  FAR struct lib_growoutstream_s *gthis =
+                                 (FAR struct lib_growoutstream_s *)this;
+  FAR char *dest;
+
+  DEBUGASSERT(this);
+
+  dest = lib_growoutstream_reserve(gthis, len);
+  if (dest == NULL)
+    {
+      return 0;
+    }
+
+  memcpy(dest, buf, len);
+  lib_growoutstream_commit(gthis, len);
+  return len;
+}
+
+/****************************************************************************
+ * Name: growoutstream_putc
+ ****************************************************************************/
+
+static void growoutstream_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  char tmp = ch;
+  growoutstream_puts(this, &tmp, 1);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_growoutstream
+ *
+ * Description:
+ *   Initializes a stream that writes to a buffer that it grows.
+ *
+ * Input Parameters:
+ *   outstream - User allocated, uninitialized instance of struct
+ *               lib_growoutstream_s to be initialized.
+ *   chunk     - The buffer grows by multiples of this size, which is
+ *               rounded up to a power of two.  Zero selects 128 bytes.
+ *
+ * Returned Value:
+ *   None (outstream initialized).
+ *
+ ****************************************************************************/
+
+void lib_growoutstream(FAR struct lib_growoutstream_s *outstream,
+                       size_t chunk)
+{
+  outstream->public.put   = growoutstream_putc;
+  outstream->public.puts  = growoutstream_puts;
+  outstream->public.flush = lib_noflush;
+  outstream->public.nput  = 0;
+  outstream->buffer       = NULL;
+  outstream->buflen       = 0;
+  outstream->chunk        = 128;
+
+  while (outstream->chunk < chunk)
+    {
+      outstream->chunk <<= 1;
+    }
+}
+
+/****************************************************************************
+ * Name: lib_growoutstream_reserve
+ *
+ * Description:
+ *   Make room for 'len' more bytes and their NUL terminator.
+ *
+ * Returned Value:
+ *   The address where the next byte goes; NULL if the buffer cannot grow.
+ *
+ ****************************************************************************/
+
+FAR char *
+lib_growoutstream_reserve(FAR struct lib_growoutstream_s *outstream,
+                          size_t len)
+{
+  size_t nput = outstream->public.nput;
+  FAR char *buffer;
+  size_t buflen;
+
+  if (len >= outstream->buflen - nput || outstream->buffer == NULL)
+    {
+      if (len >= INT_MAX - nput)
+        {
+          return NULL;
+        }
+
+      /* Double the buffer at least, so that appending a byte at a time
+       * takes a constant time on average.
+       */
+
+      buflen = nput + len + 1;
+      if (buflen < 2 * outstream->buflen)
+        {
+          buflen = 2 * outstream->buflen;
+        }
+
+      buflen = (buflen + outstream->chunk - 1) & ~(outstream->chunk - 1);
+      buffer = lib_realloc(outstream->buffer, buflen);
+      if (buffer == NULL)
+        {
+          return NULL;
+        }
+
+      buffer[nput]      = '\0';
+      outstream->buffer = buffer;
+      outstream->buflen = buflen;
+    }
+
+  return &outstream->buffer[nput];
+}
+
+/****************************************************************************
+ * Name: lib_growoutstream_commit
+ *
+ * Description:
+ *   Append the 'len' bytes written at the address that
+ *   lib_growoutstream_reserve() returned for at least as many bytes.
+ *
+ ****************************************************************************/
+
+void lib_growoutstream_commit(FAR struct lib_growoutstream_s *outstream,
+                              size_t len)
+{
+  DEBUGASSERT(outstream->buffer != NULL &&
+              len < outstream->buflen - outstream->public.nput);
+
+  outstream->public.nput += len;
+  outstream->buffer[outstream->public.nput] = '\0';
+}
+
+/****************************************************************************
+ * Name: lib_growoutstream_detach
+ *
+ * Description:
+ *   Return the buffer, NULL if nothing was written, and empty the stream.
+ *
+ ****************************************************************************/
+
+FAR char *lib_growoutstream_detach(FAR struct lib_growoutstream_s *outstream)
+{
+  FAR char *buffer = outstream->buffer;
+
+  outstream->public.nput = 0;
+  outstream->buffer      = NULL;
+  outstream->buflen      = 0;
+  return buffer;
+}
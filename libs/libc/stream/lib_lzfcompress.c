@@ -44,7 +44,8 @@ static int lzfoutstream_flush(FAR struct lib_outstream_s *this)
 
   if (stream->offset > 0)
     {
-      outlen = lzf_compress(stream->in, stream->offset,
+      outlen = lzf_compress(&stream->in[LZF_TYPE0_HDR_SIZE],
+                            stream->offset,
                             &stream->out[LZF_MAX_HDR_SIZE],
                             stream->offset, stream->state, &header);
       if (outlen > 0)
@@ -79,7 +80,8 @@ static int lzfoutstream_puts(FAR struct lib_outstream_s *this,
       copyin = stream->offset + total > LZF_STREAM_BLOCKSIZE ?
                LZF_STREAM_BLOCKSIZE - stream->offset : total;
 
-      memcpy(stream->in + stream->offset, ptr, copyin);
+      memcpy(&stream->in[LZF_TYPE0_HDR_SIZE + stream->offset], ptr,
+             copyin);
 
       ptr            += copyin;
       stream->offset += copyin;
@@ -88,7 +90,8 @@ static int lzfoutstream_puts(FAR struct lib_outstream_s *this,
 
       if (stream->offset == LZF_STREAM_BLOCKSIZE)
         {
-          outlen = lzf_compress(stream->in, stream->offset,
+          outlen = lzf_compress(&stream->in[LZF_TYPE0_HDR_SIZE],
+                                stream->offset,
                                 &stream->out[LZF_MAX_HDR_SIZE],
                                 stream->offset, stream->state,
                                 &header);
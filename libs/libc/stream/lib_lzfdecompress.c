@@ -0,0 +1,180 @@
+/****************************************************************************
+ * libs/libc/stream/lib_lzfdecompress.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <nuttx/streams.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfinstream_read
+ *
+ * Description:
+ *   Read len octets from the backend.  Return false at its end.
+ *
+ ****************************************************************************/
+
+static bool lzfinstream_read(FAR struct lib_lzfinstream_s *stream,
+                             FAR char *buf, size_t len)
+{
+  FAR struct lib_instream_s *backend = stream->backend;
+  int ch;
+
+  while (len-- > 0)
+    {
+      ch = backend->get(backend);
+      if (ch == EOF)
+        {
+          return false;
+        }
+
+      *buf++ = ch;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: lzfinstream_fill
+ *
+ * Description:
+ *   Read the next block from the backend and decompress it.  Return false
+ *   at the end of the backend or if the block is not valid.
+ *
+ ****************************************************************************/
+
+static bool lzfinstream_fill(FAR struct lib_lzfinstream_s *stream)
+{
+  FAR struct lzf_type1_header_s *header =
+    (FAR struct lzf_type1_header_s *)stream->in;
+  size_t clen;
+  size_t ulen;
+
+  if (!lzfinstream_read(stream, stream->in, LZF_TYPE0_HDR_SIZE) ||
+      header->lzf_magic[0] != 'Z' || header->lzf_magic[1] != 'V')
+    {
+      return false;
+    }
+
+  clen = (header->lzf_clen[0] << 8) | header->lzf_clen[1];
+
+  if (header->lzf_type == LZF_TYPE0_HDR)
+    {
+      /* Uncompressed, read it straight into the output buffer */
+
+      if (clen > LZF_STREAM_BLOCKSIZE ||
+          !lzfinstream_read(stream, stream->out, clen))
+        {
+          return false;
+        }
+
+      ulen = clen;
+    }
+  else if (header->lzf_type == LZF_TYPE1_HDR)
+    {
+      if (!lzfinstream_read(stream, &stream->in[LZF_TYPE0_HDR_SIZE],
+                            LZF_TYPE1_HDR_SIZE - LZF_TYPE0_HDR_SIZE))
+        {
+          return false;
+        }
+
+      ulen = (header->lzf_ulen[0] << 8) | header->lzf_ulen[1];
+      if (clen > LZF_STREAM_BLOCKSIZE || ulen > LZF_STREAM_BLOCKSIZE ||
+          !lzfinstream_read(stream, &stream->in[LZF_MAX_HDR_SIZE], clen) ||
+          lzf_decompress(&stream->in[LZF_MAX_HDR_SIZE], clen,
+                         stream->out, ulen) != ulen)
+        {
+          return false;
+        }
+    }
+  else
+    {
+      return false;
+    }
+
+  stream->offset = 0;
+  stream->len    = ulen;
+  return true;
+}
+
+/****************************************************************************
+ * Name: lzfinstream_getc
+ ****************************************************************************/
+
+static int lzfinstream_getc(FAR struct lib_instream_s *this)
+{
+  FAR struct lib_lzfinstream_s *stream =
+                                (FAR struct lib_lzfinstream_s *)this;
+
+  /* The empty blocks are skipped */
+
+  while (stream->offset >= stream->len)
+    {
+      if (!lzfinstream_fill(stream))
+        {
+          return EOF;
+        }
+    }
+
+  this->nget++;
+  return (unsigned char)stream->out[stream->offset++];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lzfinstream
+ *
+ * Description:
+ *  LZF decompressing pipeline stream, the reverse of lib_lzfoutstream()
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lzfinstream_s to be initialized.
+ *   backend - Stream backend port, which gives the compressed blocks.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lzfinstream(FAR struct lib_lzfinstream_s *stream,
+                     FAR struct lib_instream_s *backend)
+{
+  if (stream == NULL || backend == NULL)
+    {
+      return;
+    }
+
+  memset(stream, 0, sizeof(*stream));
+  stream->public.get = lzfinstream_getc;
+  stream->backend    = backend;
+}
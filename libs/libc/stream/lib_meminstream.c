@@ -45,7 +45,7 @@ static int meminstream_getc(FAR struct lib_instream_s *this)
 
   if (this->nget < mthis->buflen)
     {
-      ret = mthis->buffer[this->nget];
+      ret = (unsigned char)mthis->buffer[this->nget];
       this->nget++;
     }
   else
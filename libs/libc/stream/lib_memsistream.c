@@ -45,7 +45,7 @@ static int memsistream_getc(FAR struct lib_sistream_s *this)
 
   if (mthis->offset < mthis->buflen)
     {
-      ret = mthis->buffer[mthis->offset];
+      ret = (unsigned char)mthis->buffer[mthis->offset];
       mthis->offset++;
       this->nget++;
     }
@@ -54,7 +54,7 @@ static int rawsistream_getc(FAR struct lib_sistream_s *this)
   if (nread == 1)
     {
       this->nget++;
-      return ch;
+      return (unsigned char)ch;
     }
 
   /* Return EOF on any failure to read from the incoming byte stream. The
@@ -26,6 +26,8 @@
 
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +51,30 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip the words without c, in which the XOR has no zero byte */
+
+  if (n >= STRING_WORDSIZE)
+    {
+      FAR const uintptr_t *w;
+      uintptr_t cc = STRING_REPEAT(c);
+
+      for (; STRING_UNALIGNED(p); p++, n--)
+        {
+          if (*p == (unsigned char)c)
+            {
+              return (FAR void *)p;
+            }
+        }
+
+      for (w = (FAR const uintptr_t *)p;
+           n >= STRING_WORDSIZE && !STRING_HASZERO(*w ^ cc);
+           w++, n -= STRING_WORDSIZE);
+
+      p = (FAR const unsigned char *)w;
+    }
+#endif
+
   while (n--)
     {
       if (*p == (unsigned char)c)
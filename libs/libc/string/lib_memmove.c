@@ -26,6 +26,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -43,6 +45,29 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Going forward, each word is read before the destination reaches
+       * it, as with the bytes.
+       */
+
+      if (count >= STRING_WORDSIZE && STRING_COALIGNED(tmp, s))
+        {
+          while (STRING_UNALIGNED(tmp))
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          while (count >= STRING_WORDSIZE)
+            {
+              *(FAR uintptr_t *)tmp = *(FAR const uintptr_t *)s;
+              tmp   += STRING_WORDSIZE;
+              s     += STRING_WORDSIZE;
+              count -= STRING_WORDSIZE;
+            }
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -53,6 +78,25 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      if (count >= STRING_WORDSIZE && STRING_COALIGNED(tmp, s))
+        {
+          while (STRING_UNALIGNED(tmp))
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          while (count >= STRING_WORDSIZE)
+            {
+              tmp   -= STRING_WORDSIZE;
+              s     -= STRING_WORDSIZE;
+              count -= STRING_WORDSIZE;
+              *(FAR uintptr_t *)tmp = *(FAR const uintptr_t *)s;
+            }
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
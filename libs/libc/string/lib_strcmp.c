@@ -26,15 +26,58 @@
 
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 #ifndef CONFIG_LIBC_ARCH_STRCMP
 #undef strcmp /* See mm/README.txt */
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* The aligned words may extend past the end of the strings, but never to
+ * another page.
+ */
+
+nosanitize_address
+#endif
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register int result;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip the equal words, up to the word with the end of the strings or
+   * with the first difference, which the byte loop finds.
+   */
+
+  if (STRING_COALIGNED(cs, ct))
+    {
+      FAR const uintptr_t *ws;
+      FAR const uintptr_t *wt;
+
+      for (; STRING_UNALIGNED(cs); cs++, ct++)
+        {
+          if ((result = (unsigned char)*cs - (unsigned char)*ct) != 0 ||
+              *cs == '\0')
+            {
+              return result;
+            }
+        }
+
+      ws = (FAR const uintptr_t *)cs;
+      wt = (FAR const uintptr_t *)ct;
+
+      while (*ws == *wt && !STRING_HASZERO(*ws))
+        {
+          ws++;
+          wt++;
+        }
+
+      cs = (FAR const char *)ws;
+      ct = (FAR const char *)wt;
+    }
+#endif
+
   for (; ; )
     {
       if ((result = (unsigned char)*cs - (unsigned char)*ct++) != 0 ||
@@ -0,0 +1,68 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The speed optimized string functions move and scan whole machine words,
+ * 32 or 64 bits as uintptr_t, with bytes only for the unaligned head and
+ * tail.
+ */
+
+#define STRING_WORDSIZE     sizeof(uintptr_t)
+#define STRING_WORDMASK     (STRING_WORDSIZE - 1)
+
+/* The address is not aligned to a word */
+
+#define STRING_UNALIGNED(p) (((uintptr_t)(p) & STRING_WORDMASK) != 0)
+
+/* The two addresses can be aligned to a word together */
+
+#define STRING_COALIGNED(a, b) \
+  ((((uintptr_t)(a) ^ (uintptr_t)(b)) & STRING_WORDMASK) == 0)
+
+/* A word with each byte set to 0x01 and 0x80, and a word with each byte
+ * set to the byte c.
+ */
+
+#define STRING_ONES         ((uintptr_t)-1 / 0xff)
+#define STRING_HIGHS        (STRING_ONES << 7)
+#define STRING_REPEAT(c)    (STRING_ONES * (unsigned char)(c))
+
+/* Non zero if a byte of the word x is zero.  The lowest zero byte is
+ * always flagged, the bytes above it may be flagged falsely: The callers
+ * find the byte itself with a byte loop.
+ */
+
+#define STRING_HASZERO(x)   ((((x) - STRING_ONES) & ~(x)) & STRING_HIGHS)
+
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
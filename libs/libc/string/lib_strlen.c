@@ -26,16 +26,41 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 #ifndef CONFIG_LIBC_ARCH_STRLEN
 #undef strlen /* See mm/README.txt */
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+/* The aligned words may extend past the end of the string, but never to
+ * another page.
+ */
+
+nosanitize_address
+#endif
 size_t strlen(const char *s)
 {
-  const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+  const char *sc = s;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+
+  for (; STRING_UNALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  for (w = (FAR const uintptr_t *)sc; !STRING_HASZERO(*w); w++);
+  sc = (const char *)w;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
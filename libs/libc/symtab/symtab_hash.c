@@ -0,0 +1,158 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hashname
+ ****************************************************************************/
+
+uint32_t symtab_hashname(FAR const char *name)
+{
+  FAR const unsigned char *ptr = (FAR const unsigned char *)name;
+  uint32_t h = 5381;
+
+  while (*ptr != '\0')
+    {
+      h = (h << 5) + h + *ptr++;
+    }
+
+  return h;
+}
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms)
+{
+  uint32_t nbuckets = 1;
+  uint32_t b;
+  int i;
+
+  DEBUGASSERT(hash != NULL && (symtab != NULL || nsyms == 0));
+
+  memset(hash, 0, sizeof(*hash));
+  if (nsyms <= 0)
+    {
+      return OK;
+    }
+
+  /* One bucket per symbol at most, so the chains stay short */
+
+  while (nbuckets < (uint32_t)nsyms)
+    {
+      nbuckets <<= 1;
+    }
+
+  hash->hashes = lib_malloc((2 * nsyms + nbuckets) * sizeof(uint32_t));
+  if (hash->hashes == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  hash->chains   = hash->hashes + nsyms;
+  hash->buckets  = hash->chains + nsyms;
+  hash->nbuckets = nbuckets;
+  hash->symtab   = symtab;
+  memset(hash->buckets, 0, nbuckets * sizeof(uint32_t));
+
+  /* Add the symbols from the end at the heads of the chains, so that each
+   * chain is in the order of the table, as searched by symtab_findbyname()
+   */
+
+  for (i = nsyms - 1; i >= 0; i--)
+    {
+      hash->hashes[i]  = symtab_hashname(symtab[i].sym_name);
+      b                = hash->hashes[i] & (nbuckets - 1);
+      hash->chains[i]  = hash->buckets[b];
+      hash->buckets[b] = i + 1;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash)
+{
+  DEBUGASSERT(hash != NULL);
+
+  lib_free(hash->hashes);
+  memset(hash, 0, sizeof(*hash));
+}
+
+/****************************************************************************
+ * Name: symtab_hashfind
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_hashfind(FAR const struct symtab_hash_s *hash, FAR const char *name)
+{
+  uint32_t h;
+  uint32_t i;
+
+  DEBUGASSERT(hash != NULL && name != NULL);
+
+  if (hash->nbuckets == 0)
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_SYMTAB_DECORATED
+  if (name[0] == '_')
+    {
+      name++;
+    }
+#endif
+
+  h = symtab_hashname(name);
+
+  for (i = hash->buckets[h & (hash->nbuckets - 1)]; i != 0;
+       i = hash->chains[i - 1])
+    {
+      if (hash->hashes[i - 1] == h &&
+          strcmp(name, hash->symtab[i - 1].sym_name) == 0)
+        {
+          return &hash->symtab[i - 1];
+        }
+    }
+
+  return NULL;
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * libs/libc/time/lib_clockgettime.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All fields of the time data are volatile.  Without SMP support, no
+ * hardware memory barrier is required in addition.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+#if defined(CONFIG_CLOCK_VDATA) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The time data published by the OS on every timer tick.  The board's
+ * struct userspace_s instance references it.
+ */
+
+struct clock_vdata_s g_clock_vdata;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_gettime
+ *
+ * Description:
+ *   Clock Functions based on POSIX APIs.  This reads the time data that
+ *   the OS publishes to user space and does not require a system call.
+ *
+ ****************************************************************************/
+
+int clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+  FAR volatile struct clock_vdata_s *vdata = &g_clock_vdata;
+  clock_t ticks;
+  time_t basesec;
+  long basensec;
+  uint32_t seq;
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t usecs;
+#else
+  uint32_t msecs;
+#endif
+  uint32_t secs;
+
+  if (tp == NULL || (clock_id != CLOCK_MONOTONIC &&
+                     clock_id != CLOCK_BOOTTIME &&
+                     clock_id != CLOCK_REALTIME))
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* Take a consistent snapshot:  Retry while the OS updates the data */
+
+  do
+    {
+      while (((seq = vdata->cv_seq) & 1) != 0)
+        {
+        }
+
+      SP_DMB();
+      ticks    = vdata->cv_ticks;
+      basesec  = vdata->cv_basesec;
+      basensec = vdata->cv_basensec;
+      SP_DMB();
+    }
+  while (vdata->cv_seq != seq);
+
+  /* Convert the ticks to the time since power up, as
+   * clock_systime_timespec() does.
+   */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+  usecs       = TICK2USEC((uint64_t)ticks);
+  tp->tv_sec  = (time_t)(usecs / USEC_PER_SEC);
+  tp->tv_nsec = (long)(usecs % USEC_PER_SEC) * NSEC_PER_USEC;
+#else
+  msecs       = TICK2MSEC(ticks);
+  secs        = msecs / MSEC_PER_SEC;
+  tp->tv_sec  = (time_t)secs;
+  tp->tv_nsec = (long)(msecs - secs * MSEC_PER_SEC) * NSEC_PER_MSEC;
+#endif
+
+  /* CLOCK_REALTIME adds the time-of-day base */
+
+  if (clock_id == CLOCK_REALTIME)
+    {
+      tp->tv_sec  += basesec;
+      tp->tv_nsec += basensec;
+      if (tp->tv_nsec >= NSEC_PER_SEC)
+        {
+          secs         = tp->tv_nsec / NSEC_PER_SEC;
+          tp->tv_sec  += secs;
+          tp->tv_nsec -= secs * NSEC_PER_SEC;
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_CLOCK_VDATA && !__KERNEL__ */
@@ -290,6 +290,7 @@ struct state_s
                     (2 * (MY_TZNAME_MAX + 1)))];
   struct lsinfo_s lsis[TZ_MAX_LEAPS];
   int defaulttype;            /* For early times or if no transitions */
+  int lastidx;                /* The transition after the last lookup */
 };
 
 struct rule_s
@@ -1745,21 +1746,33 @@ static FAR struct tm *localsub(FAR const time_t *timep,
     }
   else
     {
-      int lo = 1;
+      /* The conversions are mostly of times near the previous one: Try
+       * the interval of the last lookup before searching.  The hint is
+       * checked before it is used, so the threads may share it.
+       */
+
+      int lo = sp->lastidx;
       int hi = sp->timecnt;
 
-      while (lo < hi)
+      if (lo < 1 || lo > hi || t < sp->ats[lo - 1] ||
+          (lo < hi && t >= sp->ats[lo]))
         {
-          int mid = (lo + hi) >> 1;
-
-          if (t < sp->ats[mid])
-            {
-              hi = mid;
-            }
-          else
+          lo = 1;
+          while (lo < hi)
             {
-              lo = mid + 1;
+              int mid = (lo + hi) >> 1;
+
+              if (t < sp->ats[mid])
+                {
+                  hi = mid;
+                }
+              else
+                {
+                  lo = mid + 1;
+                }
             }
+
+          sp->lastidx = lo;
         }
 
       i = (int)sp->types[lo - 1];
@@ -2513,8 +2526,18 @@ void tzset(void)
     }
 #endif
 
-  tz_semtake(&g_lcl_sem);
+  /* The time zone rarely changes: Check the TZ without the lock first.
+   * The conversions read the state without the lock anyway.
+   */
+
   name = getenv("TZ");
+  if (name == NULL ? g_lcl_isset < 0 :
+      g_lcl_isset > 0 && strcmp(g_lcl_tzname, name) == 0)
+    {
+      return;
+    }
+
+  tz_semtake(&g_lcl_sem);
   if (name == NULL)
     {
       tzsetwall();
@@ -93,15 +93,16 @@ static int work_qcancel(FAR struct usr_wqueue_s *wqueue,
           curr = curr->flink;
         }
 
-      /* Check if the work was found in the list.  If not, then an OS
-       * error has occurred because the work is marked active!
-       */
+      /* If the work is not delayed, it is ready to be performed */
 
-      DEBUGASSERT(curr);
+      if (curr == NULL)
+        {
+          dq_rem(&work->u.s.dq, &wqueue->ready);
+        }
 
       /* Now, remove the work from the work queue */
 
-      if (prev)
+      else if (prev)
         {
           /* Remove the work from mid- or end-of-queue */
 
@@ -90,9 +90,16 @@ static int work_qqueue(FAR struct usr_wqueue_s *wqueue,
   work->arg    = arg;                /* Callback argument */
   work->u.s.qtime = clock() + delay; /* Delay until work performed */
 
-  /* Do the easy case first -- when the work queue is empty. */
+  /* Work without delay goes straight to the ready queue */
 
-  if (wqueue->q.head == NULL)
+  if (delay == 0)
+    {
+      work_qready(wqueue, work);
+    }
+
+  /* Do the easy case first -- when the delayed work queue is empty. */
+
+  else if (wqueue->q.head == NULL)
     {
       /* Add the watchdog to the head == tail of the queue. */
 
@@ -150,6 +157,40 @@ static int work_qqueue(FAR struct usr_wqueue_s *wqueue,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qready
+ *
+ * Description:
+ *   Add work to the ready queue and wake up one worker thread.  The queue
+ *   is searched from the tail so that work of a single priority is queued
+ *   in constant time.
+ *
+ ****************************************************************************/
+
+void work_qready(FAR struct usr_wqueue_s *wqueue, FAR struct work_s *work)
+{
+#ifdef CONFIG_WQUEUE_PRIORITY
+  FAR dq_entry_t *prev;
+
+  for (prev = dq_tail(&wqueue->ready);
+       prev != NULL && ((FAR struct work_s *)prev)->prio < work->prio;
+       prev = dq_prev(prev));
+
+  if (prev == NULL)
+    {
+      dq_addfirst(&work->u.s.dq, &wqueue->ready);
+    }
+  else
+    {
+      dq_addafter(prev, &work->u.s.dq, &wqueue->ready);
+    }
+#else
+  dq_addlast(&work->u.s.dq, &wqueue->ready);
+#endif
+
+  _SEM_POST(&wqueue->wake);
+}
+
 /****************************************************************************
  * Name: work_queue
  *
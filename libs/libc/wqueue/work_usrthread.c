@@ -85,10 +85,10 @@ struct usr_wqueue_s g_usrwork;
 
 static void work_process(FAR struct usr_wqueue_s *wqueue)
 {
-  volatile FAR struct work_s *work;
+  FAR struct work_s *work;
   worker_t worker;
   FAR void *arg;
-  sclock_t elapsed;
+  sclock_t remaining;
   clock_t next;
   int ret;
 
@@ -105,77 +105,79 @@ static void work_process(FAR struct usr_wqueue_s *wqueue)
       return;
     }
 
-  /* And check each entry in the work queue.  Since we have locked the
-   * work queue we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
-  while (work)
+  for (; ; )
     {
-      /* Is this work ready? It is ready if there is no delay or if
-       * the delay has elapsed.  is the time that the work was added
-       * to the work queue. Therefore a delay of equal or less than
-       * zero will always execute immediately.
+      /* Move the delayed work whose delay has elapsed to the ready queue.
+       * The delayed work is sorted by expiration time, so stop at the
+       * first one that is not due yet.
        */
 
-      elapsed = clock() - work->u.s.qtime;
+      while ((work = (FAR struct work_s *)wqueue->q.head) != NULL)
+        {
+          remaining = work->u.s.qtime - clock();
+          if (remaining > 0)
+            {
+              break;
+            }
 
-      /* Is this delay work ready? */
+          dq_remfirst(&wqueue->q);
+          work_qready(wqueue, work);
+        }
 
-      if (elapsed >= 0)
+      /* Take the ready work of the highest priority, if any.  The other
+       * worker threads may take the rest while this one is busy with it.
+       */
+
+      work = (FAR struct work_s *)dq_remfirst(&wqueue->ready);
+      if (work == NULL)
         {
-          /* Remove the ready-to-execute work from the list */
+          if (wqueue->q.head != NULL)
+            {
+              next = remaining;
+            }
 
-          dq_remfirst(&wqueue->q);
+          break;
+        }
 
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued).
+       */
 
-          worker = work->worker;
+      worker = work->worker;
 
-          /* Check for a race condition where the work may be nullified
-           * before it is removed from the queue.
-           */
+      /* Check for a race condition where the work may be nullified
+       * before it is removed from the queue.
+       */
 
-          if (worker != NULL)
-            {
-              /* Extract the work argument before unlocking the work queue */
+      if (worker != NULL)
+        {
+          /* Extract the work argument before unlocking the work queue */
 
-              arg = work->arg;
+          arg = work->arg;
 
-              /* Mark the work as no longer being queued */
+          /* Mark the work as no longer being queued */
 
-              work->worker = NULL;
+          work->worker = NULL;
 
-              /* Do the work.  Unlock the work queue while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
+          /* Do the work.  Unlock the work queue while the work is being
+           * performed... we don't have any idea how long this will take!
+           */
 
-              _SEM_POST(&wqueue->lock);
-              worker(arg);
+          _SEM_POST(&wqueue->lock);
+          worker(arg);
 
-              /* Now, unfortunately, since we unlocked the work queue we
-               * don't know the state of the work list and we will have to
-               * start back at the head of the list.
-               */
+          /* Now, unfortunately, since we unlocked the work queue we
+           * don't know the state of the work list and we will have to
+           * start back at the head of the list.
+           */
 
-              ret = _SEM_WAIT(&wqueue->lock);
-              if (ret < 0)
-                {
-                  /* Break out earlier if we were awakened by a signal */
+          ret = _SEM_WAIT(&wqueue->lock);
+          if (ret < 0)
+            {
+              /* Break out earlier if we were awakened by a signal */
 
-                  return;
-                }
+              return;
             }
-
-          work = (FAR struct work_s *)wqueue->q.head;
-        }
-      else
-        {
-          next = work->u.s.qtime - clock();
-          break;
         }
     }
 
@@ -272,7 +274,9 @@ static pthread_addr_t work_usrthread(pthread_addr_t arg)
 
 int work_usrstart(void)
 {
-  int ret;
+  int ret = -EINVAL;
+  int pid = 0;
+  int wndx;
 #ifndef CONFIG_BUILD_PROTECTED
   pthread_t usrwork;
   pthread_attr_t attr;
@@ -289,48 +293,57 @@ int work_usrstart(void)
   /* Initialize the work queue */
 
   dq_init(&g_usrwork.q);
+  dq_init(&g_usrwork.ready);
 
-#ifdef CONFIG_BUILD_PROTECTED
-
-  /* Start a user-mode worker thread for use by applications. */
-
-  ret = task_create("uwork",
-                    CONFIG_LIBC_USRWORKPRIORITY,
-                    CONFIG_LIBC_USRWORKSTACKSIZE,
-                    (main_t)work_usrthread,
-                    ((FAR char * const *)NULL));
-  if (ret < 0)
-    {
-      int errcode = get_errno();
-      DEBUGASSERT(errcode > 0);
-      return -errcode;
-    }
-
-  return ret;
-#else
-  /* Start a user-mode worker thread for use by applications. */
-
+#ifndef CONFIG_BUILD_PROTECTED
   pthread_attr_init(&attr);
   pthread_attr_setstacksize(&attr, CONFIG_LIBC_USRWORKSTACKSIZE);
 
   pthread_attr_getschedparam(&attr, &param);
   param.sched_priority = CONFIG_LIBC_USRWORKPRIORITY;
   pthread_attr_setschedparam(&attr, &param);
+#endif
 
-  ret = pthread_create(&usrwork, &attr, work_usrthread, NULL);
-  if (ret != 0)
-    {
-      return -ret;
-    }
-
-  /* Detach because the return value and completion status will not be
-   * requested.
+  /* Start the pool of user-mode worker threads for use by applications.
+   * The ID of the first one is returned.
    */
 
-  pthread_detach(usrwork);
+  for (wndx = 0; wndx < CONFIG_LIBC_USRWORKNTHREADS; wndx++)
+    {
+#ifdef CONFIG_BUILD_PROTECTED
+      ret = task_create("uwork",
+                        CONFIG_LIBC_USRWORKPRIORITY,
+                        CONFIG_LIBC_USRWORKSTACKSIZE,
+                        (main_t)work_usrthread,
+                        ((FAR char * const *)NULL));
+      if (ret < 0)
+        {
+          int errcode = get_errno();
+          DEBUGASSERT(errcode > 0);
+          return -errcode;
+        }
+#else
+      ret = pthread_create(&usrwork, &attr, work_usrthread, NULL);
+      if (ret != 0)
+        {
+          return -ret;
+        }
 
-  return (pid_t)usrwork;
+      /* Detach because the return value and completion status will not be
+       * requested.
+       */
+
+      pthread_detach(usrwork);
+      ret = (pid_t)usrwork;
 #endif
+
+      if (wndx == 0)
+        {
+          pid = ret;
+        }
+    }
+
+  return pid;
 }
 
-#endif /* CONFIG_LIBC_USRWORK && !__KERNEL__*/
+#endif /* CONFIG_LIBC_USRWORK && !__KERNEL__ */
@@ -46,9 +46,10 @@
 
 struct usr_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s q;      /* The delayed work, by expiration time */
+  struct dq_queue_s ready;  /* The work to perform now, by priority */
   sem_t             lock;   /* exclusive access to user-mode work queue */
-  sem_t             wake;   /* The wake-up semaphore of the  usrthread */
+  sem_t             wake;   /* The wake-up semaphore of the usrthreads */
 };
 
 /****************************************************************************
@@ -63,5 +64,17 @@ extern struct usr_wqueue_s g_usrwork;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qready
+ *
+ * Description:
+ *   Add work to the ready queue and wake up one worker thread.  With
+ *   CONFIG_WQUEUE_PRIORITY, the work goes behind all ready work of the
+ *   same or higher priority.  Called with the work queue locked.
+ *
+ ****************************************************************************/
+
+void work_qready(FAR struct usr_wqueue_s *wqueue, FAR struct work_s *work);
+
 #endif /* CONFIG_LIBC_USRWORK && !__KERNEL__*/
 #endif /* __LIBS_LIBC_WQUEUE_WQUEUE_H */
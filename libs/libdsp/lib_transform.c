@@ -24,6 +24,23 @@
 
 #include <dsp.h>
 
+#if defined(CONFIG_LIBDSP_SIMD) && defined(__ARM_FEATURE_MVE) && \
+    (__ARM_FEATURE_MVE & 2) != 0
+#  include <arm_mve.h>
+#  define LIBDSP_VECTOR 1
+#elif defined(CONFIG_LIBDSP_SIMD) && defined(__ARM_NEON)
+#  include <arm_neon.h>
+#  define LIBDSP_VECTOR 1
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of floats in a vector register of Helium and NEON */
+
+#define LIBDSP_LANES 4
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -147,3 +164,207 @@ void inv_park_transform(FAR phase_angle_f32_t *angle,
   ab->a = angle->cos * dq->d - angle->sin * dq->q;
   ab->b = angle->cos * dq->q + angle->sin * dq->d;
 }
+
+/****************************************************************************
+ * Name: clarke_transform_batch
+ *
+ * Description:
+ *   Clarke transform of the abc frames of n motors, with Helium or NEON
+ *   if CONFIG_LIBDSP_SIMD is set.  The output arrays may be the input
+ *   ones, as for all the batch transforms.
+ *
+ * Input Parameters:
+ *   abc - (in) the abc frames
+ *   ab  - (out) the alpha-beta frames
+ *   n   - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch(FAR const struct abc_frame_f32_soa_s *abc,
+                            FAR const struct ab_frame_f32_soa_s *ab,
+                            size_t n)
+{
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+#ifdef LIBDSP_VECTOR
+  for (; i + LIBDSP_LANES <= n; i += LIBDSP_LANES)
+    {
+      float32x4_t a = vld1q_f32(&abc->a[i]);
+      float32x4_t b = vld1q_f32(&abc->b[i]);
+
+      vst1q_f32(&ab->a[i], a);
+      vst1q_f32(&ab->b[i], vaddq_f32(vmulq_n_f32(a, ONE_BY_SQRT3_F),
+                                     vmulq_n_f32(b, TWO_BY_SQRT3_F)));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float a = abc->a[i];
+
+      ab->a[i] = a;
+      ab->b[i] = ONE_BY_SQRT3_F*a + TWO_BY_SQRT3_F*abc->b[i];
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch
+ *
+ * Description:
+ *   Inverse Clarke transform of the alpha-beta frames of n motors.
+ *
+ * Input Parameters:
+ *   ab  - (in) the alpha-beta frames
+ *   abc - (out) the abc frames
+ *   n   - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch(FAR const struct ab_frame_f32_soa_s *ab,
+                                FAR const struct abc_frame_f32_soa_s *abc,
+                                size_t n)
+{
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(abc != NULL);
+
+#ifdef LIBDSP_VECTOR
+  for (; i + LIBDSP_LANES <= n; i += LIBDSP_LANES)
+    {
+      float32x4_t a = vld1q_f32(&ab->a[i]);
+      float32x4_t b = vaddq_f32(vmulq_n_f32(a, -0.5f),
+                                vmulq_n_f32(vld1q_f32(&ab->b[i]),
+                                            SQRT3_BY_TWO_F));
+
+      vst1q_f32(&abc->a[i], a);
+      vst1q_f32(&abc->b[i], b);
+      vst1q_f32(&abc->c[i], vsubq_f32(vnegq_f32(a), b));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float a = ab->a[i];
+      float b = -0.5f*a + SQRT3_BY_TWO_F*ab->b[i];
+
+      abc->a[i] = a;
+      abc->b[i] = b;
+      abc->c[i] = -a - b;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch
+ *
+ * Description:
+ *   Park transform of the alpha-beta frames of n motors.
+ *
+ * Input Parameters:
+ *   angle - (in) the sines and cosines of the phase angles
+ *   ab    - (in) the alpha-beta frames
+ *   dq    - (out) the direct-quadrature frames
+ *   n     - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch(FAR const struct phase_angle_f32_soa_s *angle,
+                          FAR const struct ab_frame_f32_soa_s *ab,
+                          FAR const struct dq_frame_f32_soa_s *dq,
+                          size_t n)
+{
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+#ifdef LIBDSP_VECTOR
+  for (; i + LIBDSP_LANES <= n; i += LIBDSP_LANES)
+    {
+      float32x4_t s = vld1q_f32(&angle->sin[i]);
+      float32x4_t c = vld1q_f32(&angle->cos[i]);
+      float32x4_t a = vld1q_f32(&ab->a[i]);
+      float32x4_t b = vld1q_f32(&ab->b[i]);
+
+      vst1q_f32(&dq->d[i], vaddq_f32(vmulq_f32(c, a), vmulq_f32(s, b)));
+      vst1q_f32(&dq->q[i], vsubq_f32(vmulq_f32(c, b), vmulq_f32(s, a)));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float s = angle->sin[i];
+      float c = angle->cos[i];
+      float a = ab->a[i];
+      float b = ab->b[i];
+
+      dq->d[i] = c * a + s * b;
+      dq->q[i] = c * b - s * a;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch
+ *
+ * Description:
+ *   Inverse Park transform of the direct-quadrature frames of n motors.
+ *
+ * Input Parameters:
+ *   angle - (in) the sines and cosines of the phase angles
+ *   dq    - (in) the direct-quadrature frames
+ *   ab    - (out) the alpha-beta frames
+ *   n     - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch(FAR const struct phase_angle_f32_soa_s *angle,
+                              FAR const struct dq_frame_f32_soa_s *dq,
+                              FAR const struct ab_frame_f32_soa_s *ab,
+                              size_t n)
+{
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+#ifdef LIBDSP_VECTOR
+  for (; i + LIBDSP_LANES <= n; i += LIBDSP_LANES)
+    {
+      float32x4_t s = vld1q_f32(&angle->sin[i]);
+      float32x4_t c = vld1q_f32(&angle->cos[i]);
+      float32x4_t d = vld1q_f32(&dq->d[i]);
+      float32x4_t q = vld1q_f32(&dq->q[i]);
+
+      vst1q_f32(&ab->a[i], vsubq_f32(vmulq_f32(c, d), vmulq_f32(s, q)));
+      vst1q_f32(&ab->b[i], vaddq_f32(vmulq_f32(c, q), vmulq_f32(s, d)));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float s = angle->sin[i];
+      float c = angle->cos[i];
+      float d = dq->d[i];
+      float q = dq->q[i];
+
+      ab->a[i] = c * d - s * q;
+      ab->b[i] = c * q + s * d;
+    }
+}
@@ -149,3 +149,158 @@ void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
   ab->a = b16mulb16(angle->cos, dq->d) - b16mulb16(angle->sin, dq->q);
   ab->b = b16mulb16(angle->cos, dq->q) + b16mulb16(angle->sin, dq->d);
 }
+
+/****************************************************************************
+ * Name: clarke_transform_batch_b16
+ *
+ * Description:
+ *   Clarke transform of the abc frames of n motors.  The output arrays may
+ *   be the input ones, as for all the batch transforms.
+ *
+ * Input Parameters:
+ *   abc - (in) the abc frames
+ *   ab  - (out) the alpha-beta frames
+ *   n   - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch_b16(FAR const struct abc_frame_b16_soa_s *abc,
+                                FAR const struct ab_frame_b16_soa_s *ab,
+                                size_t n)
+{
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t a = abc->a[i];
+
+      ab->a[i] = a;
+      ab->b[i] = (b16mulb16(ONE_BY_SQRT3_B16, a) +
+                  b16mulb16(TWO_BY_SQRT3_B16, abc->b[i]));
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch_b16
+ *
+ * Description:
+ *   Inverse Clarke transform of the alpha-beta frames of n motors.
+ *
+ * Input Parameters:
+ *   ab  - (in) the alpha-beta frames
+ *   abc - (out) the abc frames
+ *   n   - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch_b16(
+                                FAR const struct ab_frame_b16_soa_s *ab,
+                                FAR const struct abc_frame_b16_soa_s *abc,
+                                size_t n)
+{
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(abc != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t a = ab->a[i];
+      b16_t b = (b16mulb16(-b16HALF, a) +
+                 b16mulb16(SQRT3_BY_TWO_B16, ab->b[i]));
+
+      abc->a[i] = a;
+      abc->b[i] = b;
+      abc->c[i] = (-a - b);
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch_b16
+ *
+ * Description:
+ *   Park transform of the alpha-beta frames of n motors.
+ *
+ * Input Parameters:
+ *   angle - (in) the sines and cosines of the phase angles
+ *   ab    - (in) the alpha-beta frames
+ *   dq    - (out) the direct-quadrature frames
+ *   n     - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch_b16(FAR const struct phase_angle_b16_soa_s *angle,
+                              FAR const struct ab_frame_b16_soa_s *ab,
+                              FAR const struct dq_frame_b16_soa_s *dq,
+                              size_t n)
+{
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t s = angle->sin[i];
+      b16_t c = angle->cos[i];
+      b16_t a = ab->a[i];
+      b16_t b = ab->b[i];
+
+      dq->d[i] = b16mulb16(c, a) + b16mulb16(s, b);
+      dq->q[i] = b16mulb16(c, b) - b16mulb16(s, a);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch_b16
+ *
+ * Description:
+ *   Inverse Park transform of the direct-quadrature frames of n motors.
+ *
+ * Input Parameters:
+ *   angle - (in) the sines and cosines of the phase angles
+ *   dq    - (in) the direct-quadrature frames
+ *   ab    - (out) the alpha-beta frames
+ *   n     - (in) the number of motors
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch_b16(
+                              FAR const struct phase_angle_b16_soa_s *angle,
+                              FAR const struct dq_frame_b16_soa_s *dq,
+                              FAR const struct ab_frame_b16_soa_s *ab,
+                              size_t n)
+{
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t s = angle->sin[i];
+      b16_t c = angle->cos[i];
+      b16_t d = dq->d[i];
+      b16_t q = dq->q[i];
+
+      ab->a[i] = b16mulb16(c, d) - b16mulb16(s, q);
+      ab->b[i] = b16mulb16(c, q) + b16mulb16(s, d);
+    }
+}
@@ -26,74 +26,6 @@
 #include <fixedmath.h>
 #include <nuttx/video/rgbcolors.h>
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: nxglib_rgb24_blend and nxglib_rgb565_blend
- *
- * Description:
- *   Blend a single RGB color component.  This is *not* alpha blending:
- *   component2 is assumed to be opaque and "under" a semi-transparent
- *   component1.
- *
- *   The frac1 value could be though as related to the 1/alpha value for
- *   component1.
- *   However, the background, component2, is always treated as though
- *   alpha == 1.
- *
- *   This algorithm is used to handle endpoints as part of the
- *   implementation of anti-aliasing without transparency.
- *
- * Input Parameters:
- *   component1 - The semi-transparent, foreground 8-bit color component
- *   component2 - The opaque, background color component
- *   frac1  - The fractional amount of component1 to blend into component2
- *
- * Returned Value:
- *   The blended 8-bit color component.
- *
- ****************************************************************************/
-
-#if !defined(CONFIG_NX_DISABLE_16BPP) || !defined(CONFIG_NX_DISABLE_24BPP) || \
-    !defined(CONFIG_NX_DISABLE_32BPP)
-
-static uint8_t nxglib_blend_component(uint8_t component1, uint8_t component2,
-                                     ub8_t frac1)
-{
-  uint16_t blend;
-  uint32_t blendb8;
-
-  /* Use a uint32_t for the intermediate calculation.  Due to rounding this
-   * value could exceed ub8MAX (0xffff == 255.999..).
-   *
-   * Hmm.. that might not actually be possible but this gives me piece of
-   * mind and there should not be any particular overhead on a 32-bit
-   * processor.
-   */
-
-  blendb8 = (uint32_t)((ub16_t)component1 * frac1) +
-            (uint32_t)((ub16_t)component2 * (b8ONE - frac1)) +
-            (uint32_t)b8HALF;
-
-  /* Now we can snap it down to 16-bits and check for the overflow
-   * condition.
-   */
-
-  blend = ub8toi(blendb8);
-  if (blend > 255)
-    {
-      blend = 255;
-    }
-
-  /* Return the blended value */
-
-  return (uint8_t)blend;
-}
-
-#endif
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -127,10 +59,8 @@ static uint8_t nxglib_blend_component(uint8_t component1, uint8_t component2,
 
 uint32_t nxglib_rgb24_blend(uint32_t color1, uint32_t color2, ub16_t frac1)
 {
-  uint8_t r;
-  uint8_t g;
-  uint8_t b;
-  uint8_t bg;
+  uint32_t rb;
+  uint32_t g;
   ub8_t fracb8;
 
   /* Convert the fraction to ub8_t.  We don't need that much precision to
@@ -153,23 +83,18 @@ uint32_t nxglib_rgb24_blend(uint32_t color1, uint32_t color2, ub16_t frac1)
       return color2;
     }
 
-  /* Separate and blend each component */
-
-  r  = RGB24RED(color1);
-  bg = RGB24RED(color2);
-  r  = nxglib_blend_component(r, bg, fracb8);
-
-  g  = RGB24GREEN(color1);
-  bg = RGB24GREEN(color2);
-  g  = nxglib_blend_component(g, bg, fracb8);
+  /* Blend red and blue together, and then green: There are 8 free bits
+   * above each component for the products, and the differences wrap
+   * around in the same way.
+   */
 
-  b  = RGB24BLUE(color1);
-  bg = RGB24BLUE(color2);
-  b  = nxglib_blend_component(b, bg, fracb8);
+  rb = color2 & 0xff00ff;
+  rb = (rb + ((((color1 & 0xff00ff) - rb) * fracb8) >> 8)) & 0xff00ff;
 
-  /* Recombine and return the blended value */
+  g  = color2 & 0x00ff00;
+  g  = (g + ((((color1 & 0x00ff00) - g) * fracb8) >> 8)) & 0x00ff00;
 
-  return RGBTO24(r, g, b);
+  return rb | g;
 }
 
 #endif
@@ -178,44 +103,37 @@ uint32_t nxglib_rgb24_blend(uint32_t color1, uint32_t color2, ub16_t frac1)
 
 uint16_t nxglib_rgb565_blend(uint16_t color1, uint16_t color2, ub16_t frac1)
 {
-  uint8_t r;
-  uint8_t g;
-  uint8_t b;
-  uint8_t bg;
-  ub8_t fracb8;
+  uint32_t fg;
+  uint32_t bg;
+  uint32_t frac;
 
-  /* Convert the fraction to ub8_t.  We don't need that much precision. */
+  /* Convert the fraction to five bits, which is enough for the five and
+   * six bit components.
+   */
 
-  fracb8 = ub16toub8(frac1);
+  frac = (ub16toub8(frac1) + 4) >> 3;
 
   /* Some limit checks */
 
-  if (fracb8 >= b8ONE)
+  if (frac >= 32)
     {
       return color1;
     }
-  else if (fracb8 == 0)
+  else if (frac == 0)
     {
       return color2;
     }
 
-  /* Separate and blend each component */
-
-  r  = RGB16RED(color1);
-  bg = RGB16RED(color2);
-  r  = nxglib_blend_component(r, bg, fracb8);
-
-  g  = RGB16GREEN(color1);
-  bg = RGB16GREEN(color2);
-  g  = nxglib_blend_component(g, bg, fracb8);
-
-  b  = RGB16BLUE(color1);
-  bg = RGB16BLUE(color2);
-  b  = nxglib_blend_component(b, bg, fracb8);
+  /* Spread the components so that there are five free bits above each of
+   * them, 00000gggggg00000rrrrr000000bbbbb, and blend them all in a single
+   * multiplication.
+   */
 
-  /* Recombine and return the blended value */
+  fg = (color1 | ((uint32_t)color1 << 16)) & 0x07e0f81f;
+  bg = (color2 | ((uint32_t)color2 << 16)) & 0x07e0f81f;
+  bg = (bg + (((fg - bg) * frac) >> 5)) & 0x07e0f81f;
 
-  return RGBTO24(r, g, b);
+  return (uint16_t)(bg | (bg >> 16));
 }
 
 #endif
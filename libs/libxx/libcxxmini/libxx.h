@@ -0,0 +1,114 @@
+//***************************************************************************
+// libs/libxx/libcxxmini/libxx.h
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+
+#ifndef __LIBS_LIBXX_LIBCXXMINI_LIBXX_H
+#define __LIBS_LIBXX_LIBCXXMINI_LIBXX_H
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstddef>
+
+#include <nuttx/lib/lib.h>
+
+//***************************************************************************
+// Public Types
+//***************************************************************************
+
+// The type of the alignment of the aligned operator new, as in <new>
+
+#ifdef __cpp_aligned_new
+namespace std
+{
+  enum class align_val_t : std::size_t;
+}
+#endif
+
+//***************************************************************************
+// Public Function Prototypes
+//***************************************************************************
+
+#ifdef CONFIG_LIBCXXMINI_POOL
+
+//***************************************************************************
+// Name: libxx_pool_alloc
+//
+// Description:
+//   Allocate a small object from the pool.  Return NULL if the object is
+//   too large for the pool or if the pool is exhausted; the object must
+//   then be allocated from the heap.
+//
+//***************************************************************************
+
+FAR void *libxx_pool_alloc(std::size_t nbytes);
+
+//***************************************************************************
+// Name: libxx_pool_free
+//
+// Description:
+//   Return an object to the pool and return true, or return false if it
+//   was not allocated from the pool.  The nbytes of the sized delete
+//   operators save the lookup of the size class, zero means unknown.
+//
+//***************************************************************************
+
+bool libxx_pool_free(FAR void *ptr, std::size_t nbytes);
+
+#endif
+
+//***************************************************************************
+// Name: libxx_alloc
+//
+// Description:
+//   The allocation and release of operator new and delete
+//
+//***************************************************************************
+
+static inline FAR void *libxx_alloc(std::size_t nbytes)
+{
+#ifdef CONFIG_LIBCXXMINI_POOL
+  FAR void *alloc = libxx_pool_alloc(nbytes);
+
+  if (alloc != NULL)
+    {
+      return alloc;
+    }
+#endif
+
+  return lib_malloc(nbytes);
+}
+
+static inline void libxx_free(FAR void *ptr, std::size_t nbytes)
+{
+#ifdef CONFIG_LIBCXXMINI_POOL
+  if (libxx_pool_free(ptr, nbytes))
+    {
+      return;
+    }
+#endif
+
+  lib_free(ptr);
+}
+
+#endif // __LIBS_LIBXX_LIBCXXMINI_LIBXX_H
@@ -23,7 +23,7 @@
 
 #include <nuttx/config.h>
 
-#include <nuttx/lib/lib.h>
+#include "libxx.h"
 
 //***************************************************************************
 // Operators
@@ -35,5 +35,5 @@
 
 void operator delete[](FAR void *ptr) throw()
 {
-  lib_free(ptr);
+  libxx_free(ptr, 0);
 }
@@ -26,7 +26,7 @@
 
 #include <cstddef>
 
-#include <nuttx/lib/lib.h>
+#include "libxx.h"
 
 #ifdef CONFIG_HAVE_CXX14
 
@@ -40,7 +40,7 @@
 
 void operator delete[](FAR void *ptr, std::size_t size)
 {
-  lib_free(ptr);
+  libxx_free(ptr, size);
 }
 
 #endif /* CONFIG_HAVE_CXX14 */
@@ -0,0 +1,109 @@
+//***************************************************************************
+// libs/libxx/libcxxmini/libxx_new_aligned.cxx
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+#include <assert.h>
+#include <cstddef>
+#include <debug.h>
+
+#include "libxx.h"
+
+#ifdef __cpp_aligned_new
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_memalign
+//
+// Description:
+//   The allocation of the aligned operator new, which is never from the
+//   pool: The aligned operator delete needs not look it up.
+//
+//***************************************************************************
+
+static FAR void *libxx_memalign(std::size_t nbytes, std::align_val_t align)
+{
+  // We have to allocate something
+
+  if (nbytes < 1)
+    {
+      nbytes = 1;
+    }
+
+  FAR void *alloc = lib_memalign((std::size_t)align, nbytes);
+
+#ifdef CONFIG_DEBUG_ERROR
+  if (alloc == 0)
+    {
+      _err("ERROR: Failed to allocate\n");
+    }
+#endif
+
+  DEBUGASSERT(alloc != NULL);
+  return alloc;
+}
+
+//***************************************************************************
+// Operators
+//***************************************************************************
+
+//***************************************************************************
+// Name: new, new[], delete and delete[] of over-aligned types
+//***************************************************************************
+
+FAR void *operator new(std::size_t nbytes, std::align_val_t align)
+{
+  return libxx_memalign(nbytes, align);
+}
+
+FAR void *operator new[](std::size_t nbytes, std::align_val_t align)
+{
+  return libxx_memalign(nbytes, align);
+}
+
+void operator delete(FAR void *ptr, std::align_val_t align) throw()
+{
+  lib_free(ptr);
+}
+
+void operator delete[](FAR void *ptr, std::align_val_t align) throw()
+{
+  lib_free(ptr);
+}
+
+void operator delete(FAR void *ptr, std::size_t size,
+                     std::align_val_t align) throw()
+{
+  lib_free(ptr);
+}
+
+void operator delete[](FAR void *ptr, std::size_t size,
+                       std::align_val_t align) throw()
+{
+  lib_free(ptr);
+}
+
+#endif // __cpp_aligned_new
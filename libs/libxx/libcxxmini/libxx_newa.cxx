@@ -26,7 +26,7 @@
 #include <cstddef>
 #include <debug.h>
 
-#include <nuttx/lib/lib.h>
+#include "libxx.h"
 
 //***************************************************************************
 // Pre-processor Definitions
@@ -65,7 +65,7 @@ FAR void *operator new[](std::size_t nbytes)
 
   // Perform the allocation
 
-  FAR void *alloc = lib_malloc(nbytes);
+  FAR void *alloc = libxx_alloc(nbytes);
 
 #ifdef CONFIG_DEBUG_ERROR
   if (alloc == 0)
@@ -0,0 +1,201 @@
+//***************************************************************************
+// libs/libxx/libcxxmini/libxx_pool.cxx
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstdint>
+#include <assert.h>
+
+#include <nuttx/semaphore.h>
+
+#include "libxx.h"
+
+#ifdef CONFIG_LIBCXXMINI_POOL
+
+//***************************************************************************
+// Pre-processor Definitions
+//***************************************************************************
+
+// The pool is cut in pages as it is used, each page in blocks of one size
+// class.  The classes are powers of two, from the smallest block aligned
+// for any object to LIBXX_POOL_MAXSIZE.
+
+#define LIBXX_POOL_MINSHIFT  (sizeof(FAR void *) > 4 ? 4 : 3)
+#define LIBXX_POOL_MINSIZE   (1 << LIBXX_POOL_MINSHIFT)
+#define LIBXX_POOL_NCLASSES  (8 - LIBXX_POOL_MINSHIFT)
+#define LIBXX_POOL_MAXSIZE   (LIBXX_POOL_MINSIZE << (LIBXX_POOL_NCLASSES - 1))
+#define LIBXX_POOL_PAGESIZE  (4 * LIBXX_POOL_MAXSIZE)
+#define LIBXX_POOL_NPAGES \
+  (CONFIG_LIBCXXMINI_POOL_SIZE / LIBXX_POOL_PAGESIZE)
+
+//***************************************************************************
+// Private Types
+//***************************************************************************
+
+struct libxx_block_s
+{
+  FAR struct libxx_block_s *flink;
+};
+
+//***************************************************************************
+// Private Data
+//***************************************************************************
+
+static uint8_t g_pool[LIBXX_POOL_NPAGES * LIBXX_POOL_PAGESIZE]
+  aligned_data(LIBXX_POOL_MINSIZE);
+
+// The size class of each page in use
+
+static uint8_t g_pool_pageclass[LIBXX_POOL_NPAGES];
+
+// The number of pages in use and the free blocks of each class
+
+static unsigned int g_pool_npages;
+static FAR struct libxx_block_s *g_pool_free[LIBXX_POOL_NCLASSES];
+static sem_t g_pool_lock = SEM_INITIALIZER(1);
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_pool_class
+//***************************************************************************
+
+static inline unsigned int libxx_pool_class(std::size_t nbytes)
+{
+  unsigned int cls = 0;
+
+  while ((std::size_t)LIBXX_POOL_MINSIZE << cls < nbytes)
+    {
+      cls++;
+    }
+
+  return cls;
+}
+
+//***************************************************************************
+// Name: libxx_pool_grow
+//
+// Description:
+//   Cut a new page in blocks of a size class.  Called with the pool locked.
+//
+//***************************************************************************
+
+static bool libxx_pool_grow(unsigned int cls)
+{
+  std::size_t size = (std::size_t)LIBXX_POOL_MINSIZE << cls;
+  FAR uint8_t *page;
+  std::size_t offset;
+
+  if (g_pool_npages >= LIBXX_POOL_NPAGES)
+    {
+      return false;
+    }
+
+  g_pool_pageclass[g_pool_npages] = cls;
+  page = &g_pool[g_pool_npages++ * LIBXX_POOL_PAGESIZE];
+
+  for (offset = 0; offset < LIBXX_POOL_PAGESIZE; offset += size)
+    {
+      FAR struct libxx_block_s *block =
+        (FAR struct libxx_block_s *)&page[offset];
+
+      block->flink     = g_pool_free[cls];
+      g_pool_free[cls] = block;
+    }
+
+  return true;
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_pool_alloc
+//***************************************************************************
+
+FAR void *libxx_pool_alloc(std::size_t nbytes)
+{
+  FAR struct libxx_block_s *block = NULL;
+  unsigned int cls;
+
+  if (nbytes > LIBXX_POOL_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  cls = libxx_pool_class(nbytes);
+
+  while (_SEM_WAIT(&g_pool_lock) < 0);
+
+  if (g_pool_free[cls] != NULL || libxx_pool_grow(cls))
+    {
+      block            = g_pool_free[cls];
+      g_pool_free[cls] = block->flink;
+    }
+
+  _SEM_POST(&g_pool_lock);
+  return block;
+}
+
+//***************************************************************************
+// Name: libxx_pool_free
+//***************************************************************************
+
+bool libxx_pool_free(FAR void *ptr, std::size_t nbytes)
+{
+  FAR struct libxx_block_s *block = (FAR struct libxx_block_s *)ptr;
+  std::size_t offset = (uintptr_t)ptr - (uintptr_t)g_pool;
+  unsigned int cls;
+
+  if (offset >= sizeof(g_pool))
+    {
+      return false;
+    }
+
+  // The size of the sized delete operators gives the class right away
+
+  if (nbytes > 0)
+    {
+      cls = libxx_pool_class(nbytes);
+      DEBUGASSERT(cls == g_pool_pageclass[offset / LIBXX_POOL_PAGESIZE]);
+    }
+  else
+    {
+      cls = g_pool_pageclass[offset / LIBXX_POOL_PAGESIZE];
+    }
+
+  while (_SEM_WAIT(&g_pool_lock) < 0);
+
+  block->flink     = g_pool_free[cls];
+  g_pool_free[cls] = block;
+
+  _SEM_POST(&g_pool_lock);
+  return true;
+}
+
+#endif // CONFIG_LIBCXXMINI_POOL
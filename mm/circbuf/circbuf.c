@@ -37,9 +37,67 @@
 #include <nuttx/mm/circbuf.h>
 
 /****************************************************************************
- * Private Types
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* In the lock-free single producer / single consumer mode, the writer
+ * publishes the data with a release store of the head and the reader
+ * gives the space back with a release store of the tail.  The matching
+ * acquire loads make sure that each side sees the data or the space of the
+ * other side before the new index.
+ */
+
+#ifdef CONFIG_MM_CIRCBUF_SPSC
+#  define circbuf_load(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#  define circbuf_store(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else
+#  define circbuf_load(p)     (*(p))
+#  define circbuf_store(p, v) (*(p) = (v))
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: circbuf_region
+ *
+ * Description:
+ *   Describe 'bytes' of the buffer space starting at the position 'pos' as
+ *   up to two contiguous segments, the second one being used on wrap.
+ *
+ ****************************************************************************/
+
+static size_t circbuf_region(FAR struct circbuf_s *circ, size_t pos,
+                             size_t bytes, FAR struct iovec *iov)
+{
+  size_t off;
+  size_t len;
+
+  if (!circ->size)
+    {
+      bytes = 0;
+      off   = 0;
+    }
+  else
+    {
+      off   = pos % circ->size;
+    }
+
+  len = circ->size - off;
+  if (bytes < len)
+    {
+      len = bytes;
+    }
+
+  iov[0].iov_base = circ->base + off;
+  iov[0].iov_len  = len;
+  iov[1].iov_base = circ->base;
+  iov[1].iov_len  = bytes - len;
+
+  return bytes;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -209,7 +267,7 @@ size_t circbuf_size(FAR struct circbuf_s *circ)
 size_t circbuf_used(FAR struct circbuf_s *circ)
 {
   DEBUGASSERT(circ);
-  return circ->head - circ->tail;
+  return circbuf_load(&circ->head) - circbuf_load(&circ->tail);
 }
 
 /****************************************************************************
@@ -379,7 +437,7 @@ ssize_t circbuf_read(FAR struct circbuf_s *circ,
   DEBUGASSERT(dst || !bytes);
 
   bytes = circbuf_peek(circ, dst, bytes);
-  circ->tail += bytes;
+  circbuf_store(&circ->tail, circ->tail + bytes);
 
   return bytes;
 }
@@ -416,7 +474,7 @@ ssize_t circbuf_skip(FAR struct circbuf_s *circ, size_t bytes)
       bytes = len;
     }
 
-  circ->tail += bytes;
+  circbuf_store(&circ->tail, circ->tail + bytes);
 
   return bytes;
 }
@@ -470,7 +528,7 @@ ssize_t circbuf_write(FAR struct circbuf_s *circ,
 
   memcpy(circ->base + off, src, space);
   memcpy(circ->base, src + space, bytes - space);
-  circ->head += bytes;
+  circbuf_store(&circ->head, circ->head + bytes);
 
   return bytes;
 }
@@ -538,3 +596,103 @@ ssize_t circbuf_overwrite(FAR struct circbuf_s *circ,
 
   return overwrite;
 }
+
+/****************************************************************************
+ * Name: circbuf_reserve
+ *
+ * Description:
+ *   Get the free space of the circular buffer so that the writer can fill
+ *   it in place, e.g. by DMA, instead of copying through circbuf_write().
+ *   The space is returned as two segments, the second one is only used
+ *   when the space wraps around the end of the buffer.  The data becomes
+ *   visible to the reader with circbuf_commit().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   iov   - Array of two segments receiving the free space.
+ *
+ * Returned Value:
+ *   The total number of free bytes in the two segments.
+ ****************************************************************************/
+
+size_t circbuf_reserve(FAR struct circbuf_s *circ, FAR struct iovec *iov)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(iov);
+
+  return circbuf_region(circ, circ->head, circbuf_space(circ), iov);
+}
+
+/****************************************************************************
+ * Name: circbuf_commit
+ *
+ * Description:
+ *   Add 'bytes' of data written into the space obtained by
+ *   circbuf_reserve() to the circular buffer.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   bytes - Number of bytes written, at most the reserved space.
+ ****************************************************************************/
+
+void circbuf_commit(FAR struct circbuf_s *circ, size_t bytes)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(bytes <= circbuf_space(circ));
+
+  circbuf_store(&circ->head, circ->head + bytes);
+}
+
+/****************************************************************************
+ * Name: circbuf_acquire
+ *
+ * Description:
+ *   Get the data of the circular buffer so that the reader can process it
+ *   in place instead of copying it out through circbuf_read().  The data
+ *   is returned as two segments, the second one is only used when the data
+ *   wraps around the end of the buffer.  The space is given back to the
+ *   writer with circbuf_release().
+ *
+ * Note :
+ *   That with only one concurrent reader and one concurrent writer,
+ *   you don't need extra locking to use these api.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   iov   - Array of two segments receiving the data.
+ *
+ * Returned Value:
+ *   The total number of bytes of data in the two segments.
+ ****************************************************************************/
+
+size_t circbuf_acquire(FAR struct circbuf_s *circ, FAR struct iovec *iov)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(iov);
+
+  return circbuf_region(circ, circ->tail, circbuf_used(circ), iov);
+}
+
+/****************************************************************************
+ * Name: circbuf_release
+ *
+ * Description:
+ *   Remove 'bytes' of data obtained by circbuf_acquire() from the circular
+ *   buffer.
+ *
+ * Input Parameters:
+ *   circ  - Address of the circular buffer to be used.
+ *   bytes - Number of bytes consumed, at most the acquired data.
+ ****************************************************************************/
+
+void circbuf_release(FAR struct circbuf_s *circ, size_t bytes)
+{
+  DEBUGASSERT(circ);
+  DEBUGASSERT(bytes <= circbuf_used(circ));
+
+  circbuf_store(&circ->tail, circ->tail + bytes);
+}
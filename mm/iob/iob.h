@@ -48,6 +48,14 @@
 #  define iobinfo                _none
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Check if an I/O buffer belongs to the jumbo pool */
+
+#ifdef CONFIG_IOB_JUMBO
+#  define IOB_ISJUMBO(p)         ((p)->io_bufsize != CONFIG_IOB_BUFSIZE)
+#else
+#  define IOB_ISJUMBO(p)         false
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -60,6 +68,13 @@ extern FAR struct iob_s *g_iob_freelist;
 
 extern FAR struct iob_s *g_iob_committed;
 
+#ifdef CONFIG_IOB_JUMBO
+/* A list of all free, unallocated jumbo I/O buffers and their number */
+
+extern FAR struct iob_s *g_iob_jumbolist;
+extern unsigned int g_iob_njumbo;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -119,6 +134,71 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_tryalloc_list
+ *
+ * Description:
+ *   Take up to 'n' I/O buffers from the free list in a single critical
+ *   section and add them to the head of '*list', linked through io_flink.
+ *   The buffers are not reinitialized.  The number of buffers taken is
+ *   returned.
+ *
+ ****************************************************************************/
+
+unsigned int iob_tryalloc_list(bool throttled, unsigned int n,
+                               FAR struct iob_s **list);
+
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Return a list of I/O buffers, linked through io_flink, to the free list
+ *   in a single critical section.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_percpu_alloc, iob_percpu_free, iob_percpu_free_chain
+ *
+ * Description:
+ *   Allocate and free I/O buffers through the cache of the current CPU.
+ *   The cached buffers are accounted as allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+FAR struct iob_s *iob_percpu_alloc(void);
+bool iob_percpu_free(FAR struct iob_s *iob);
+FAR struct iob_s *iob_percpu_free_chain(FAR struct iob_s *iob);
+#endif
+
+/****************************************************************************
+ * Name: iob_percpu_flush
+ *
+ * Description:
+ *   Return the I/O buffers held by the caches of all CPUs to the free list.
+ *   true is returned if any buffer was returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+bool iob_percpu_flush(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_percpu_count
+ *
+ * Description:
+ *   Return the number of I/O buffers held by the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+unsigned int iob_percpu_count(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -235,9 +235,240 @@ FAR struct iob_s *iob_alloc(bool throttled)
  ****************************************************************************/
 
 FAR struct iob_s *iob_tryalloc(bool throttled)
+{
+  FAR struct iob_s *iob = NULL;
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* Try the cache of this CPU first.  If the free list is exhausted, the
+   * buffers held by the caches of all CPUs are given back before failing.
+   */
+
+  iob = iob_percpu_alloc();
+  if (iob == NULL && iob_tryalloc_list(throttled, 1, &iob) == 0 &&
+      iob_percpu_flush())
+    {
+      iob_tryalloc_list(throttled, 1, &iob);
+    }
+#else
+  iob_tryalloc_list(throttled, 1, &iob);
+#endif
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_jumbo
+ *
+ * Description:
+ *   Try to allocate an I/O buffer from the jumbo pool.  The jumbo pool is
+ *   not throttled and it is never waited for, an allocation that fails can
+ *   always fall back to a chain of normal I/O buffers.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_JUMBO
+FAR struct iob_s *iob_tryalloc_jumbo(void)
 {
   FAR struct iob_s *iob;
   irqstate_t flags;
+
+  flags = enter_critical_section();
+  iob   = g_iob_jumbolist;
+  if (iob != NULL)
+    {
+      g_iob_jumbolist = iob->io_flink;
+      g_iob_njumbo--;
+    }
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+#endif
+
+/****************************************************************************
+ * Name: iob_alloc_len
+ *
+ * Description:
+ *   Allocate an I/O buffer for 'len' bytes of data, taking a jumbo I/O
+ *   buffer if the data does not fit into a normal one.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_len(bool throttled, unsigned int len)
+{
+#ifdef CONFIG_IOB_JUMBO
+  FAR struct iob_s *iob;
+
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_jumbo();
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+#endif
+
+  return iob_alloc(throttled);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_len
+ *
+ * Description:
+ *   Try to allocate an I/O buffer for 'len' bytes of data without waiting,
+ *   taking a jumbo I/O buffer if the data does not fit into a normal one.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_len(bool throttled, unsigned int len)
+{
+#ifdef CONFIG_IOB_JUMBO
+  FAR struct iob_s *iob;
+
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      iob = iob_tryalloc_jumbo();
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+#endif
+
+  return iob_tryalloc(throttled);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_chain
+ *
+ * Description:
+ *   Try to allocate a chain of 'n' I/O buffers, linked through io_flink,
+ *   without waiting.  The buffers are taken from the free list in a
+ *   single critical section.  Either all of the buffers or none are
+ *   allocated.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_chain(bool throttled, unsigned int n)
+{
+  FAR struct iob_s *chain = NULL;
+  FAR struct iob_s *iob;
+  unsigned int count;
+
+  DEBUGASSERT(n > 0);
+
+  count = iob_tryalloc_list(throttled, n, &chain);
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  if (count < n && iob_percpu_flush())
+    {
+      count += iob_tryalloc_list(throttled, n - count, &chain);
+    }
+#endif
+
+  if (count < n)
+    {
+      if (chain != NULL)
+        {
+          iob_free_list(chain);
+        }
+
+      return NULL;
+    }
+
+  /* Put the I/O buffers in a known state */
+
+  for (iob = chain; iob != NULL; iob = iob->io_flink)
+    {
+      iob->io_len    = 0;
+      iob->io_offset = 0;
+      iob->io_pktlen = 0;
+    }
+
+  return chain;
+}
+
+/****************************************************************************
+ * Name: iob_alloc_chain
+ *
+ * Description:
+ *   Allocate a chain of 'n' I/O buffers, linked through io_flink, waiting
+ *   as necessary.  If the buffers are not available at once, they are
+ *   allocated one at a time with iob_alloc().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_chain(bool throttled, unsigned int n)
+{
+  FAR struct iob_s *chain;
+  FAR struct iob_s *iob;
+
+  chain = iob_tryalloc_chain(throttled, n);
+  if (chain != NULL || up_interrupt_context() || sched_idletask())
+    {
+      return chain;
+    }
+
+  while (n-- > 0)
+    {
+      iob = iob_alloc(throttled);
+      if (iob == NULL)
+        {
+          if (chain != NULL)
+            {
+              iob_free_chain(chain);
+            }
+
+          return NULL;
+        }
+
+      iob->io_flink = chain;
+      chain         = iob;
+    }
+
+  return chain;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_list
+ *
+ * Description:
+ *   Take up to 'n' I/O buffers from the head of the free list, in a single
+ *   critical section, and add them to the list at '*list'.  The buffers are
+ *   not reinitialized.
+ *
+ * Returned Value:
+ *   The number of buffers taken.
+ *
+ ****************************************************************************/
+
+unsigned int iob_tryalloc_list(bool throttled, unsigned int n,
+                               FAR struct iob_s **list)
+{
+  FAR struct iob_s *iob;
+  unsigned int count = 0;
+  irqstate_t flags;
 #if CONFIG_IOB_THROTTLE > 0
   FAR sem_t *sem;
 #endif
@@ -254,58 +485,58 @@ FAR struct iob_s *iob_tryalloc(bool throttled)
 
   flags = enter_critical_section();
 
+  while (count < n)
+    {
 #if CONFIG_IOB_THROTTLE > 0
-  /* If there are free I/O buffers for this allocation */
+      /* If there are no free I/O buffers for this allocation */
 
-  if (sem->semcount > 0 ||
-      (throttled && g_iob_sem.semcount - CONFIG_IOB_THROTTLE > 0))
+      if (sem->semcount <= 0 &&
+          (!throttled || g_iob_sem.semcount - CONFIG_IOB_THROTTLE <= 0))
+        {
+          break;
+        }
 #endif
-    {
+
       /* Take the I/O buffer from the head of the free list */
 
       iob = g_iob_freelist;
-      if (iob != NULL)
+      if (iob == NULL)
         {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
+          break;
+        }
+
+      /* Remove the I/O buffer from the free list and decrement the
+       * counting semaphore(s) that tracks the number of available
+       * IOBs.
+       */
 
-          g_iob_freelist = iob->io_flink;
+      g_iob_freelist = iob->io_flink;
+      iob->io_flink  = *list;
+      *list          = iob;
+      count++;
 
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
+      /* Take a semaphore count.  Note that we cannot do this in
+       * in the orthodox way by calling nxsem_wait() or nxsem_trywait()
+       * because this function may be called from an interrupt
+       * handler. Fortunately we know at at least one free buffer
+       * so a simple decrement is all that is needed.
+       */
 
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
+      g_iob_sem.semcount--;
+      DEBUGASSERT(g_iob_sem.semcount >= 0);
 
 #if CONFIG_IOB_THROTTLE > 0
-          /* The throttle semaphore is a little more complicated because
-           * it can be negative!  Decrementing is still safe, however.
-           *
-           * Note: usually g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE.
-           * But it can be smaller than that if there are blocking threads.
-           */
+      /* The throttle semaphore is a little more complicated because
+       * it can be negative!  Decrementing is still safe, however.
+       *
+       * Note: usually g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE.
+       * But it can be smaller than that if there are blocking threads.
+       */
 
-          g_throttle_sem.semcount--;
+      g_throttle_sem.semcount--;
 #endif
-
-          leave_critical_section(flags);
-
-          /* Put the I/O buffer in a known state */
-
-          iob->io_flink  = NULL; /* Not in a chain */
-          iob->io_len    = 0;    /* Length of the data in the entry */
-          iob->io_offset = 0;    /* Offset to the beginning of data */
-          iob->io_pktlen = 0;    /* Total length of the packet */
-          return iob;
-        }
     }
 
   leave_critical_section(flags);
-  return NULL;
+  return count;
 }
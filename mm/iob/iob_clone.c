@@ -62,6 +62,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
   unsigned int avail2;
   unsigned int offset1;
   unsigned int offset2;
+  unsigned int remain;
 
   DEBUGASSERT(iob2->io_len == 0 && iob2->io_offset == 0 &&
               iob2->io_pktlen == 0 && iob2->io_flink == NULL);
@@ -71,6 +72,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
    */
 
   iob2->io_pktlen = iob1->io_pktlen;
+  remain          = iob1->io_pktlen;
 
   /* Handle special case where there are empty buffers at the head
    * the list.
@@ -100,7 +102,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
        */
 
       dest   = &iob2->io_data[offset2];
-      avail2 = CONFIG_IOB_BUFSIZE - offset2;
+      avail2 = IOB_BUFSIZE(iob2) - offset2;
 
       /* Copy the smaller of the two and update the srce and destination
        * offsets.
@@ -111,6 +113,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
 
       offset1 += ncopy;
       offset2 += ncopy;
+      remain  -= MIN(remain, ncopy);
 
       /* Have we taken all of the data from the source I/O buffer? */
 
@@ -137,7 +140,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
        * transferred?
        */
 
-      if (offset2 >= CONFIG_IOB_BUFSIZE && iob1 != NULL)
+      if (offset2 >= IOB_BUFSIZE(iob2) && iob1 != NULL)
         {
           FAR struct iob_s *next;
 
@@ -145,7 +148,7 @@ int iob_clone(FAR struct iob_s *iob1, FAR struct iob_s *iob2, bool throttled)
            * destination I/O buffer chain.
            */
 
-          next = iob_alloc(throttled);
+          next = iob_alloc_len(throttled, remain);
           if (!next)
             {
               ioberr("ERROR: Failed to allocate an I/O buffer\n");
@@ -74,10 +74,6 @@
 FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 {
   FAR struct iob_s *next = iob->io_flink;
-  irqstate_t flags;
-#ifdef CONFIG_IOB_NOTIFIER
-  int16_t navail;
-#endif
 
   iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
           iob, iob->io_pktlen, iob->io_len, next);
@@ -112,7 +108,43 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
               next, next->io_pktlen, next->io_len);
     }
 
-  /* Free the I/O buffer by adding it to the head of the free or the
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* Keep the I/O buffer in the cache of this CPU if possible */
+
+  if (!IOB_ISJUMBO(iob) && iob_percpu_free(iob))
+    {
+      return next;
+    }
+#endif
+
+  /* Return the I/O buffer to the free list */
+
+  iob->io_flink = NULL;
+  iob_free_list(iob);
+
+  /* And return the I/O buffer after the one that was freed */
+
+  return next;
+}
+
+/****************************************************************************
+ * Name: iob_free_list
+ *
+ * Description:
+ *   Return a list of I/O buffers, linked through io_flink, to the free list
+ *   in a single critical section.  The packet lengths are not maintained.
+ *
+ ****************************************************************************/
+
+void iob_free_list(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *next;
+  irqstate_t flags;
+#ifdef CONFIG_IOB_NOTIFIER
+  int16_t navail;
+#endif
+
+  /* Free the I/O buffers by adding them to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
    * interrupts very briefly.
@@ -120,57 +152,71 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 
   flags = enter_critical_section();
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
+  for (; iob != NULL; iob = next)
     {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-    }
-  else
-    {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
-    }
+      next = iob->io_flink;
 
-  /* Signal that an IOB is available.  If there is a thread blocked,
-   * waiting for an IOB, this will wake up exactly one thread.  The
-   * semaphore count will correctly indicated that the awakened task
-   * owns an IOB and should find it in the committed list.
-   */
+#ifdef CONFIG_IOB_JUMBO
+      /* Nobody waits for a jumbo I/O buffer */
+
+      if (IOB_ISJUMBO(iob))
+        {
+          iob->io_flink   = g_iob_jumbolist;
+          g_iob_jumbolist = iob;
+          g_iob_njumbo++;
+          DEBUGASSERT(g_iob_njumbo <= CONFIG_IOB_JUMBO_NBUFFERS);
+          continue;
+        }
+#endif
+
+      /* Which list?  If there is a task waiting for an IOB, then put
+       * the IOB on either the free list or on the committed list where
+       * it is reserved for that allocation (and not available to
+       * iob_tryalloc()).
+       */
+
+      if (g_iob_sem.semcount < 0)
+        {
+          iob->io_flink   = g_iob_committed;
+          g_iob_committed = iob;
+        }
+      else
+        {
+          iob->io_flink   = g_iob_freelist;
+          g_iob_freelist  = iob;
+        }
 
-  nxsem_post(&g_iob_sem);
-  DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
+      /* Signal that an IOB is available.  If there is a thread blocked,
+       * waiting for an IOB, this will wake up exactly one thread.  The
+       * semaphore count will correctly indicated that the awakened task
+       * owns an IOB and should find it in the committed list.
+       */
+
+      nxsem_post(&g_iob_sem);
+      DEBUGASSERT(g_iob_sem.semcount <= CONFIG_IOB_NBUFFERS);
 
 #if CONFIG_IOB_THROTTLE > 0
-  nxsem_post(&g_throttle_sem);
-  DEBUGASSERT(g_throttle_sem.semcount <=
-              (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
+      nxsem_post(&g_throttle_sem);
+      DEBUGASSERT(g_throttle_sem.semcount <=
+                  (CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE));
 #endif
 
 #ifdef CONFIG_IOB_NOTIFIER
-  /* Check if the IOB was claimed by a thread that is blocked waiting
-   * for an IOB.
-   */
-
-  navail = iob_navail(false);
-  if (navail > 0 && (navail & IOB_MASK) == 0)
-    {
-      /* Signal any threads that have requested a signal notification
-       * when an IOB becomes available.
+      /* Check if the IOB was claimed by a thread that is blocked waiting
+       * for an IOB.
        */
 
-      iob_notifier_signal();
-    }
+      navail = iob_navail(false);
+      if (navail > 0 && (navail & IOB_MASK) == 0)
+        {
+          /* Signal any threads that have requested a signal notification
+           * when an IOB becomes available.
+           */
+
+          iob_notifier_signal();
+        }
 #endif
+    }
 
   leave_critical_section(flags);
-
-  /* And return the I/O buffer after the one that was freed */
-
-  return next;
 }
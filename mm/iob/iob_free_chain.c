@@ -44,12 +44,16 @@
 
 void iob_free_chain(FAR struct iob_s *iob)
 {
-  FAR struct iob_s *next;
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* Keep as many IOBs as possible in the cache of this CPU */
 
-  /* Free each IOB in the chain -- one at a time to keep the count straight */
+  iob = iob_percpu_free_chain(iob);
+#endif
 
-  for (; iob; iob = next)
+  /* Return the others to the free list in one operation */
+
+  if (iob != NULL)
     {
-      next = iob_free(iob);
+      iob_free_list(iob);
     }
 }
@@ -42,6 +42,20 @@
 #define IOB_BUFFER_SIZE   (IOB_ALIGN_SIZE * CONFIG_IOB_NBUFFERS + \
                            CONFIG_IOB_ALIGNMENT - 1)
 
+/* A jumbo I/O Buffer is an iob_s whose io_data is extended to
+ * CONFIG_IOB_JUMBO_BUFSIZE bytes.
+ */
+
+#ifdef CONFIG_IOB_JUMBO
+#  define IOB_JUMBO_ALIGN_SIZE \
+     ROUNDUP(ROUNDUP(offsetof(struct iob_s, io_data) + \
+                     CONFIG_IOB_JUMBO_BUFSIZE, sizeof(uintptr_t)), \
+             CONFIG_IOB_ALIGNMENT)
+#  define IOB_JUMBO_BUFFER_SIZE \
+     (IOB_JUMBO_ALIGN_SIZE * CONFIG_IOB_JUMBO_NBUFFERS + \
+      CONFIG_IOB_ALIGNMENT - 1)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -57,6 +71,15 @@ static uint8_t g_iob_buffer[IOB_BUFFER_SIZE] locate_data(IOB_SECTION);
 static uint8_t g_iob_buffer[IOB_BUFFER_SIZE];
 #endif
 
+#ifdef CONFIG_IOB_JUMBO
+#  ifdef IOB_SECTION
+static uint8_t g_iob_jumbo_buffer[IOB_JUMBO_BUFFER_SIZE]
+                 locate_data(IOB_SECTION);
+#  else
+static uint8_t g_iob_jumbo_buffer[IOB_JUMBO_BUFFER_SIZE];
+#  endif
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* This is a pool of pre-allocated iob_qentry_s buffers */
 
@@ -75,6 +98,13 @@ FAR struct iob_s *g_iob_freelist;
 
 FAR struct iob_s *g_iob_committed;
 
+#ifdef CONFIG_IOB_JUMBO
+/* A list of all free, unallocated jumbo I/O buffers and their number */
+
+FAR struct iob_s *g_iob_jumbolist;
+unsigned int g_iob_njumbo;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -136,10 +166,33 @@ void iob_initialize(void)
 
       /* Add the pre-allocate I/O buffer to the head of the free list */
 
-      iob->io_flink  = g_iob_freelist;
-      g_iob_freelist = iob;
+#ifdef CONFIG_IOB_JUMBO
+      iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+#endif
+      iob->io_flink   = g_iob_freelist;
+      g_iob_freelist  = iob;
     }
 
+#ifdef CONFIG_IOB_JUMBO
+  /* Do the same for the jumbo I/O buffers */
+
+  buf = ROUNDUP((uintptr_t)g_iob_jumbo_buffer +
+                offsetof(struct iob_s, io_head), CONFIG_IOB_ALIGNMENT) -
+        offsetof(struct iob_s, io_head);
+
+  for (i = 0; i < CONFIG_IOB_JUMBO_NBUFFERS; i++)
+    {
+      FAR struct iob_s *iob =
+        (FAR struct iob_s *)(buf + i * IOB_JUMBO_ALIGN_SIZE);
+
+      iob->io_bufsize = CONFIG_IOB_JUMBO_BUFSIZE;
+      iob->io_flink   = g_iob_jumbolist;
+      g_iob_jumbolist = iob;
+    }
+
+  g_iob_njumbo = CONFIG_IOB_JUMBO_NBUFFERS;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
       /* Add each I/O buffer chain queue container to the free list */
 
@@ -55,6 +55,12 @@ int iob_navail(bool throttled)
     {
       ret = navail;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* The IOBs held by the per-CPU caches can be allocated as well */
+
+      ret += iob_percpu_count();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
       /* Subtract the throttle value is so requested */
 
@@ -0,0 +1,312 @@
+/****************************************************************************
+ * mm/iob/iob_percpu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The IOBs cached by one CPU.  The lock is only contended when another CPU
+ * flushes the cache.
+ */
+
+struct iob_percpu_s
+{
+  spinlock_t        lock;
+  FAR struct iob_s *head;        /* Cached IOBs, linked through io_flink */
+  unsigned int      count;       /* Number of cached IOBs */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_percpu_s g_iob_percpu[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_percpu_cacheable
+ *
+ * Description:
+ *   The cached IOBs are accounted as allocated.  They are only kept while
+ *   the free list still has IOBs for all kinds of allocation, so that a
+ *   task never waits for an IOB that is held in a cache.  An allocation
+ *   that finds the free list empty flushes the caches first, with the
+ *   semaphore counts already at zero, so the frees racing with it bypass
+ *   the caches.
+ *
+ * Assumptions:
+ *   The lock of the cache is held.
+ *
+ ****************************************************************************/
+
+static inline bool iob_percpu_cacheable(void)
+{
+#if CONFIG_IOB_THROTTLE > 0
+  return g_iob_sem.semcount > 0 && g_throttle_sem.semcount > 0;
+#else
+  return g_iob_sem.semcount > 0;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_percpu_alloc
+ *
+ * Description:
+ *   Take an IOB from the cache of this CPU.  If the cache is empty, it is
+ *   refilled with a batch of IOBs from the free list.  The refill honors
+ *   the throttle so that the caches never hold the IOBs reserved for
+ *   unthrottled allocations.
+ *
+ * Returned Value:
+ *   An IOB that is not reinitialized or NULL.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_percpu_alloc(void)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *list = NULL;
+  FAR struct iob_s *tail;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  unsigned int count;
+
+  cache = &g_iob_percpu[up_cpu_index()];
+
+  flags = spin_lock_irqsave(&cache->lock);
+  iob   = cache->head;
+  if (iob != NULL)
+    {
+      cache->head = iob->io_flink;
+      cache->count--;
+    }
+
+  spin_unlock_irqrestore(&cache->lock, flags);
+
+  if (iob != NULL)
+    {
+      return iob;
+    }
+
+  /* Refill the cache with one batch taken in a single critical section */
+
+  count = iob_tryalloc_list(true, CONFIG_IOB_PERCPU_CACHE_BATCH, &list);
+  if (count == 0)
+    {
+      return NULL;
+    }
+
+  iob  = list;
+  list = list->io_flink;
+  if (list != NULL)
+    {
+      for (tail = list; tail->io_flink != NULL; tail = tail->io_flink)
+        {
+        }
+
+      flags          = spin_lock_irqsave(&cache->lock);
+      tail->io_flink = cache->head;
+      cache->head    = list;
+      cache->count  += count - 1;
+      spin_unlock_irqrestore(&cache->lock, flags);
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_free
+ *
+ * Description:
+ *   Put an IOB into the cache of this CPU.  If the cache is full, a batch
+ *   of IOBs is returned to the free list at once.
+ *
+ * Returned Value:
+ *   true if the IOB was cached, false if it must go to the free list.
+ *
+ ****************************************************************************/
+
+bool iob_percpu_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *drain = NULL;
+  FAR struct iob_s *tmp;
+  irqstate_t flags;
+  int i;
+
+  cache = &g_iob_percpu[up_cpu_index()];
+
+  flags = spin_lock_irqsave(&cache->lock);
+  if (!iob_percpu_cacheable())
+    {
+      spin_unlock_irqrestore(&cache->lock, flags);
+      return false;
+    }
+
+  if (cache->count >= CONFIG_IOB_PERCPU_CACHE_SIZE)
+    {
+      for (i = 0; i < CONFIG_IOB_PERCPU_CACHE_BATCH; i++)
+        {
+          tmp           = cache->head;
+          cache->head   = tmp->io_flink;
+          tmp->io_flink = drain;
+          drain         = tmp;
+        }
+
+      cache->count -= CONFIG_IOB_PERCPU_CACHE_BATCH;
+    }
+
+  iob->io_flink = cache->head;
+  cache->head   = iob;
+  cache->count++;
+  spin_unlock_irqrestore(&cache->lock, flags);
+
+  if (drain != NULL)
+    {
+      iob_free_list(drain);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_free_chain
+ *
+ * Description:
+ *   Put as many IOBs of a chain as fit into the cache of this CPU.  The
+ *   caches don't hold jumbo IOBs, caching stops at the first one.
+ *
+ * Returned Value:
+ *   The rest of the chain, to be returned to the free list.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_percpu_free_chain(FAR struct iob_s *iob)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *next;
+  irqstate_t flags;
+
+  cache = &g_iob_percpu[up_cpu_index()];
+
+  flags = spin_lock_irqsave(&cache->lock);
+  if (iob_percpu_cacheable())
+    {
+      while (iob != NULL && !IOB_ISJUMBO(iob) &&
+             cache->count < CONFIG_IOB_PERCPU_CACHE_SIZE)
+        {
+          next          = iob->io_flink;
+          iob->io_flink = cache->head;
+          cache->head   = iob;
+          cache->count++;
+          iob           = next;
+        }
+    }
+
+  spin_unlock_irqrestore(&cache->lock, flags);
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_flush
+ *
+ * Description:
+ *   Return the IOBs held by the caches of all CPUs to the free list.
+ *
+ * Returned Value:
+ *   true if any IOB was returned.
+ *
+ ****************************************************************************/
+
+bool iob_percpu_flush(void)
+{
+  FAR struct iob_percpu_s *cache;
+  FAR struct iob_s *list;
+  irqstate_t flags;
+  bool ret = false;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &g_iob_percpu[cpu];
+
+      flags        = spin_lock_irqsave(&cache->lock);
+      list         = cache->head;
+      cache->head  = NULL;
+      cache->count = 0;
+      spin_unlock_irqrestore(&cache->lock, flags);
+
+      if (list != NULL)
+        {
+          iob_free_list(list);
+          ret = true;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: iob_percpu_count
+ *
+ * Description:
+ *   Return the number of IOBs held by the caches of all CPUs.  The value is
+ *   sampled without locking.
+ *
+ ****************************************************************************/
+
+unsigned int iob_percpu_count(void)
+{
+  unsigned int count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += g_iob_percpu[cpu].count;
+    }
+
+  return count;
+}
+
+#endif /* CONFIG_IOB_PERCPU_CACHE */
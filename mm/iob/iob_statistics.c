@@ -65,6 +65,12 @@ void iob_getstats(FAR struct iob_stats_s *stats)
       stats->nwait = 0;
     }
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* The IOBs held by the per-CPU caches are accounted as allocated */
+
+  stats->nfree += iob_percpu_count();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
   nxsem_get_value(&g_throttle_sem, &stats->nthrottle);
   if (stats->nthrottle < 0)
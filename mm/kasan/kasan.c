@@ -28,6 +28,7 @@
 #include <debug.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "kasan.h"
 
@@ -72,17 +73,26 @@ static sem_t g_lock = SEM_INITIALIZER(1);
 static FAR struct kasan_region_s *g_region;
 static uint32_t g_region_init;
 
+/* The lowest and highest address covered by any region.  Most accesses go
+ * to the stack or to static data, these are rejected without walking the
+ * region list.
+ */
+
+static uintptr_t g_region_begin;
+static uintptr_t g_region_end;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static FAR uintptr_t *kasan_mem_to_shadow(FAR const void *ptr, size_t size,
-                                          unsigned int *bit)
+static inline FAR struct kasan_region_s *
+kasan_find_region(FAR const void *ptr, size_t size)
 {
   FAR struct kasan_region_s *region;
   uintptr_t addr = (uintptr_t)ptr;
 
-  if (g_region_init != KASAN_INIT_VALUE)
+  if (g_region_init != KASAN_INIT_VALUE ||
+      addr < g_region_begin || addr >= g_region_end)
     {
       return NULL;
     }
@@ -92,16 +102,30 @@ static FAR uintptr_t *kasan_mem_to_shadow(FAR const void *ptr, size_t size,
       if (addr >= region->begin && addr < region->end)
         {
           DEBUGASSERT(addr + size <= region->end);
-          addr -= region->begin;
-          addr /= KASAN_SHADOW_SCALE;
-          *bit  = addr % KASAN_BITS_PER_WORD;
-          return &region->shadow[addr / KASAN_BITS_PER_WORD];
+          return region;
         }
     }
 
   return NULL;
 }
 
+static FAR uintptr_t *kasan_mem_to_shadow(FAR const void *ptr, size_t size,
+                                          unsigned int *bit)
+{
+  FAR struct kasan_region_s *region;
+  uintptr_t addr;
+
+  region = kasan_find_region(ptr, size);
+  if (region == NULL)
+    {
+      return NULL;
+    }
+
+  addr  = ((uintptr_t)ptr - region->begin) / KASAN_SHADOW_SCALE;
+  *bit  = addr % KASAN_BITS_PER_WORD;
+  return &region->shadow[addr / KASAN_BITS_PER_WORD];
+}
+
 static void kasan_report(FAR const void *addr, size_t size, bool is_write)
 {
   static int recursion;
@@ -117,13 +141,69 @@ static void kasan_report(FAR const void *addr, size_t size, bool is_write)
   --recursion;
 }
 
-static bool kasan_is_poisoned(FAR const void *addr, size_t size)
+/* Check every shadow bit covering [addr, addr + size).  The aligned
+ * accesses generated by the compiler are covered by a single shadow word,
+ * longer ranges are tested a whole shadow word at a time.
+ */
+
+static inline bool kasan_is_poisoned(FAR const void *addr, size_t size)
 {
+  FAR struct kasan_region_s *region;
   FAR uintptr_t *p;
+  uintptr_t first;
+  uintptr_t nbit;
   unsigned int bit;
 
-  p = kasan_mem_to_shadow(addr + size - 1, 1, &bit);
-  return p && ((*p >> bit) & 1);
+  if (size == 0)
+    {
+      return false;
+    }
+
+  region = kasan_find_region(addr, size);
+  if (region == NULL)
+    {
+      return false;
+    }
+
+  first = ((uintptr_t)addr - region->begin) / KASAN_SHADOW_SCALE;
+  nbit  = ((uintptr_t)addr - region->begin + size - 1) /
+          KASAN_SHADOW_SCALE - first + 1;
+  p     = &region->shadow[first / KASAN_BITS_PER_WORD];
+  bit   = first % KASAN_BITS_PER_WORD;
+
+  if (bit + nbit <= KASAN_BITS_PER_WORD)
+    {
+      uintptr_t mask = UINTPTR_MAX >> (KASAN_BITS_PER_WORD - nbit) << bit;
+
+      return (*p & mask) != 0;
+    }
+
+  if (*p++ & KASAN_FIRST_WORD_MASK(bit))
+    {
+      return true;
+    }
+
+  nbit -= KASAN_BITS_PER_WORD - bit;
+  while (nbit >= KASAN_BITS_PER_WORD)
+    {
+      if (*p++ != 0)
+        {
+          return true;
+        }
+
+      nbit -= KASAN_BITS_PER_WORD;
+    }
+
+  return nbit && (*p & KASAN_LAST_WORD_MASK(nbit)) != 0;
+}
+
+static inline void kasan_check(FAR const void *addr, size_t size,
+                               bool is_write)
+{
+  if (kasan_is_poisoned(addr, size))
+    {
+      kasan_report(addr, size, is_write);
+    }
 }
 
 static void kasan_set_poison(FAR const void *addr, size_t size,
@@ -131,37 +211,53 @@ static void kasan_set_poison(FAR const void *addr, size_t size,
 {
   FAR uintptr_t *p;
   unsigned int bit;
-  unsigned int nbit;
   uintptr_t mask;
+  size_t nword;
 
-  p = kasan_mem_to_shadow(addr, size, &bit);
-  DEBUGASSERT(p != NULL);
+  /* Memory outside of the registered regions is not tracked */
 
-  nbit = KASAN_BITS_PER_WORD - bit % KASAN_BITS_PER_WORD;
-  mask = KASAN_FIRST_WORD_MASK(bit);
+  p = kasan_mem_to_shadow(addr, size, &bit);
+  if (p == NULL)
+    {
+      return;
+    }
 
   size /= KASAN_SHADOW_SCALE;
-  while (size >= nbit)
+  if (size == 0)
     {
-      if (poisoned)
-        {
-          *p++ |= mask;
-        }
-      else
-        {
-          *p++ &= ~mask;
-        }
+      return;
+    }
 
-      bit  += nbit;
-      size -= nbit;
+  if (bit + size <= KASAN_BITS_PER_WORD)
+    {
+      mask = UINTPTR_MAX >> (KASAN_BITS_PER_WORD - size) << bit;
+      size = 0;
+    }
+  else
+    {
+      mask  = KASAN_FIRST_WORD_MASK(bit);
+      size -= KASAN_BITS_PER_WORD - bit;
+    }
 
-      nbit = KASAN_BITS_PER_WORD;
-      mask = UINTPTR_MAX;
+  if (poisoned)
+    {
+      *p++ |= mask;
     }
+  else
+    {
+      *p++ &= ~mask;
+    }
+
+  /* Fill the whole shadow words in between at once */
+
+  nword = size / KASAN_BITS_PER_WORD;
+  memset(p, poisoned ? 0xff : 0, nword * KASAN_BYTES_PER_WORD);
+  p    += nword;
+  size %= KASAN_BITS_PER_WORD;
 
   if (size)
     {
-      mask &= KASAN_LAST_WORD_MASK(bit + size);
+      mask = KASAN_LAST_WORD_MASK(size);
       if (poisoned)
         {
           *p |= mask;
@@ -202,6 +298,17 @@ void kasan_register(FAR void *addr, FAR size_t *size)
   _SEM_WAIT(&g_lock);
   region->next  = g_region;
   g_region      = region;
+
+  if (g_region_init != KASAN_INIT_VALUE || region->begin < g_region_begin)
+    {
+      g_region_begin = region->begin;
+    }
+
+  if (g_region_init != KASAN_INIT_VALUE || region->end > g_region_end)
+    {
+      g_region_end = region->end;
+    }
+
   g_region_init = KASAN_INIT_VALUE;
   _SEM_POST(&g_lock);
 
@@ -209,6 +316,42 @@ void kasan_register(FAR void *addr, FAR size_t *size)
   *size -= KASAN_REGION_SIZE(*size);
 }
 
+bool kasan_heap_enabled(FAR const char *name)
+{
+  FAR const char *list = CONFIG_MM_KASAN_HEAPS;
+  FAR const char *next;
+  size_t len;
+
+  if (*list == '\0')
+    {
+      return true;
+    }
+
+  if (name == NULL)
+    {
+      return false;
+    }
+
+  len = strlen(name);
+  while (*list != '\0')
+    {
+      next = strchr(list, ',');
+      if (next == NULL)
+        {
+          next = list + strlen(list);
+        }
+
+      if (next - list == len && strncmp(list, name, len) == 0)
+        {
+          return true;
+        }
+
+      list = *next != '\0' ? next + 1 : next;
+    }
+
+  return false;
+}
+
 /* Exported functions called from the compiler generated code */
 
 void __sanitizer_annotate_contiguous_container(FAR const void *beg,
@@ -296,68 +439,62 @@ void __asan_report_store1_noabort(FAR void *addr)
 
 void __asan_loadN_noabort(FAR void *addr, size_t size)
 {
-  if (kasan_is_poisoned(addr, size))
-    {
-      kasan_report(addr, size, false);
-    }
+  kasan_check(addr, size, false);
 }
 
 void __asan_storeN_noabort(FAR void * addr, size_t size)
 {
-  if (kasan_is_poisoned(addr, size))
-    {
-      kasan_report(addr, size, true);
-    }
+  kasan_check(addr, size, true);
 }
 
 void __asan_load16_noabort(FAR void *addr)
 {
-  __asan_loadN_noabort(addr, 16);
+  kasan_check(addr, 16, false);
 }
 
 void __asan_store16_noabort(FAR void *addr)
 {
-  __asan_storeN_noabort(addr, 16);
+  kasan_check(addr, 16, true);
 }
 
 void __asan_load8_noabort(FAR void *addr)
 {
-  __asan_loadN_noabort(addr, 8);
+  kasan_check(addr, 8, false);
 }
 
 void __asan_store8_noabort(FAR void *addr)
 {
-  __asan_storeN_noabort(addr, 8);
+  kasan_check(addr, 8, true);
 }
 
 void __asan_load4_noabort(FAR void *addr)
 {
-  __asan_loadN_noabort(addr, 4);
+  kasan_check(addr, 4, false);
 }
 
 void __asan_store4_noabort(FAR void *addr)
 {
-  __asan_storeN_noabort(addr, 4);
+  kasan_check(addr, 4, true);
 }
 
 void __asan_load2_noabort(FAR void *addr)
 {
-  __asan_loadN_noabort(addr, 2);
+  kasan_check(addr, 2, false);
 }
 
 void __asan_store2_noabort(FAR void *addr)
 {
-  __asan_storeN_noabort(addr, 2);
+  kasan_check(addr, 2, true);
 }
 
 void __asan_load1_noabort(FAR void *addr)
 {
-  __asan_loadN_noabort(addr, 1);
+  kasan_check(addr, 1, false);
 }
 
 void __asan_store1_noabort(FAR void *addr)
 {
-  __asan_storeN_noabort(addr, 1);
+  kasan_check(addr, 1, true);
 }
 
 void __asan_loadN(FAR void *addr, size_t size)
@@ -419,3 +556,29 @@ void __asan_store1(FAR void *addr)
 {
   __asan_store1_noabort(addr);
 }
+
+/* Called instead of memcpy(), memmove() and memset() by code built with
+ * the kernel-address mem-intrinsic prefix (GCC:
+ * --param asan-kernel-mem-intrinsic-prefix=1).  The whole range is checked
+ * once instead of byte by byte inside the instrumented string functions.
+ */
+
+FAR void *__asan_memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  kasan_check(src, n, false);
+  kasan_check(dest, n, true);
+  return memcpy(dest, src, n);
+}
+
+FAR void *__asan_memmove(FAR void *dest, FAR const void *src, size_t n)
+{
+  kasan_check(src, n, false);
+  kasan_check(dest, n, true);
+  return memmove(dest, src, n);
+}
+
+FAR void *__asan_memset(FAR void *s, int c, size_t n)
+{
+  kasan_check(s, n, true);
+  return memset(s, c, n);
+}
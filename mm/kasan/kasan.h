@@ -25,6 +25,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /****************************************************************************
@@ -35,6 +36,7 @@
 #  define kasan_poison(addr, size)
 #  define kasan_unpoison(addr, size)
 #  define kasan_register(addr, size)
+#  define kasan_heap_enabled(name) false
 #endif
 
 /****************************************************************************
@@ -105,6 +107,23 @@ void kasan_unpoison(FAR const void *addr, size_t size);
 
 void kasan_register(FAR void *addr, FAR size_t *size);
 
+/****************************************************************************
+ * Name: kasan_heap_enabled
+ *
+ * Description:
+ *   Return whether the named heap should be registered to KASan, i.e. it
+ *   is listed in CONFIG_MM_KASAN_HEAPS or that list is empty
+ *
+ * Input Parameters:
+ *   name - The heap name
+ *
+ * Returned Value:
+ *   true if the heap is sanitized.
+ *
+ ****************************************************************************/
+
+bool kasan_heap_enabled(FAR const char *name);
+
 #endif /* CONFIG_MM_KASAN */
 
 #undef EXTERN
@@ -24,7 +24,10 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
+
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -42,6 +45,21 @@
 
 FAR void *kmm_calloc(size_t n, size_t elem_size)
 {
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  /* The threshold check also assures that n * elem_size can't overflow */
+
+  if (n > 0 && elem_size > 0 &&
+      n <= CONFIG_MM_HEAP_MEMPOOL_THRESHOLD / elem_size)
+    {
+      FAR void *mem = mempool_multiple_alloc(&g_kmmpool, n * elem_size);
+      if (mem != NULL)
+        {
+          memset(mem, 0, n * elem_size);
+          return mem;
+        }
+    }
+#endif
+
   return mm_calloc(g_kmmheap, n, elem_size);
 }
 
@@ -28,6 +28,7 @@
 #include <debug.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -53,6 +54,14 @@
 void kmm_free(FAR void *mem)
 {
   DEBUGASSERT((mem == NULL) || kmm_heapmember(mem));
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  if (mempool_multiple_free(&g_kmmpool, mem) >= 0)
+    {
+      return;
+    }
+#endif
+
   mm_free(g_kmmheap, mem);
 }
 
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -36,6 +37,12 @@
 
 FAR struct mm_heap_s *g_kmmheap;
 
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+/* These are the pools serve the small allocations of the kernel heap */
+
+struct mempool_multiple_s g_kmmpool;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,6 +66,12 @@ FAR struct mm_heap_s *g_kmmheap;
 void kmm_initialize(FAR void *heap_start, size_t heap_size)
 {
   g_kmmheap = mm_initialize("Kmem", heap_start, heap_size);
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  /* Small allocations go to the heap directly if that fails */
+
+  mempool_multiple_heap_init(&g_kmmpool, g_kmmheap, "Kmem");
+#endif
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -48,7 +49,38 @@
 
 FAR void *kmm_malloc(size_t size)
 {
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  FAR void *mem = mempool_multiple_alloc(&g_kmmpool, size);
+  if (mem != NULL)
+    {
+      return mem;
+    }
+#endif
+
   return mm_malloc(g_kmmheap, size);
 }
 
+/****************************************************************************
+ * Name: kmm_malloc_flags
+ *
+ * Description:
+ *   Allocate memory from the kernel heap, preferring the regions selected
+ *   by the MM_ALLOC_* flags.
+ *
+ * Input Parameters:
+ *   size  - Size (in bytes) of the memory region to be allocated.
+ *   flags - The MM_ALLOC_* flags.
+ *
+ * Returned Value:
+ *   The address of the allocated memory (NULL on failure to allocate)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *kmm_malloc_flags(size_t size, unsigned int flags)
+{
+  return mm_malloc_flags(g_kmmheap, size, flags);
+}
+#endif
+
 #endif /* CONFIG_MM_KERNEL_HEAP */
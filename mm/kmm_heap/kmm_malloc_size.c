@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -34,6 +35,14 @@
 
 size_t kmm_malloc_size(FAR void *mem)
 {
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  ssize_t size = mempool_multiple_alloc_size(&g_kmmpool, mem);
+  if (size >= 0)
+    {
+      return size;
+    }
+#endif
+
   return mm_malloc_size(mem);
 }
 
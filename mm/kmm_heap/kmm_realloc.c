@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -49,6 +50,17 @@
 
 FAR void *kmm_realloc(FAR void *oldmem, size_t newsize)
 {
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  if (oldmem == NULL)
+    {
+      return kmm_malloc(newsize);
+    }
+  else if (mempool_multiple_alloc_size(&g_kmmpool, oldmem) >= 0)
+    {
+      return mempool_multiple_realloc(&g_kmmpool, oldmem, newsize);
+    }
+#endif
+
   return mm_realloc(g_kmmheap, oldmem, newsize);
 }
 
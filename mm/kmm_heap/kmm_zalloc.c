@@ -24,7 +24,10 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
+
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 
@@ -48,6 +51,15 @@
 
 FAR void *kmm_zalloc(size_t size)
 {
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  FAR void *mem = mempool_multiple_alloc(&g_kmmpool, size);
+  if (mem != NULL)
+    {
+      memset(mem, 0, size);
+      return mem;
+    }
+#endif
+
   return mm_zalloc(g_kmmheap, size);
 }
 
@@ -23,10 +23,22 @@
  ****************************************************************************/
 
 #include <stdbool.h>
+#include <string.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/mempool.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of blocks moved between a magazine and the shared list at a
+ * time.
+ */
+
+#define MEMPOOL_MAGAZINE_BATCH ((CONFIG_MM_MEMPOOL_MAGAZINE_SIZE + 1) / 2)
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -41,6 +53,170 @@ static inline void mempool_add_list(FAR sq_queue_t *list, FAR void *base,
     }
 }
 
+static inline FAR void *mempool_malloc(FAR struct mempool_s *pool,
+                                       size_t size)
+{
+  if (pool->alloc != NULL)
+    {
+      return pool->alloc(pool, size);
+    }
+  else
+    {
+      return kmm_malloc(size);
+    }
+}
+
+static inline void mempool_mfree(FAR struct mempool_s *pool, FAR void *addr)
+{
+  if (pool->free != NULL)
+    {
+      pool->free(pool, addr);
+    }
+  else
+    {
+      kmm_free(addr);
+    }
+}
+
+static inline bool mempool_is_interrupt(FAR struct mempool_s *pool,
+                                        FAR void *blk)
+{
+  FAR char *base;
+
+  if (pool->ninterrupt == 0)
+    {
+      return false;
+    }
+
+  base = (FAR char *)(sq_peek(&pool->elist) + 1);
+  return (FAR char *)blk >= base &&
+         (FAR char *)blk < base + pool->ninterrupt * pool->bsize;
+}
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+
+/****************************************************************************
+ * Name: mempool_magazine_alloc
+ *
+ * Description:
+ *   Take a block from the magazine of the current CPU, refilling it from
+ *   the shared list by a batch if it is empty.  Only the pools that expand
+ *   use the magazines: a waiter of a fixed size pool must see every free
+ *   block.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_magazine_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_magazine_s *mag;
+  FAR sq_entry_t *blk = NULL;
+  irqstate_t flags;
+  irqstate_t lflags;
+
+  if (pool->nexpand == 0)
+    {
+      return NULL;
+    }
+
+  flags = up_irq_save();
+  mag = &pool->mag[up_cpu_index()];
+  if (mag->count > 0)
+    {
+      mag->nhits++;
+      blk = mag->blks[--mag->count];
+    }
+  else
+    {
+      mag->nmisses++;
+
+      lflags = spin_lock_irqsave(&pool->lock);
+      while (mag->count < MEMPOOL_MAGAZINE_BATCH &&
+             (blk = sq_remfirst(&pool->list)) != NULL)
+        {
+          mag->blks[mag->count++] = blk;
+          pool->nused++;
+        }
+
+      spin_unlock_irqrestore(&pool->lock, lflags);
+
+      blk = mag->count > 0 ? mag->blks[--mag->count] : NULL;
+    }
+
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_free
+ *
+ * Description:
+ *   Put a block into the magazine of the current CPU, returning a batch of
+ *   blocks to the shared list first if it is full.
+ *
+ ****************************************************************************/
+
+static bool mempool_magazine_free(FAR struct mempool_s *pool,
+                                  FAR void *blk)
+{
+  FAR struct mempool_magazine_s *mag;
+  irqstate_t flags;
+  irqstate_t lflags;
+  size_t i;
+
+  if (pool->nexpand == 0 || mempool_is_interrupt(pool, blk))
+    {
+      return false;
+    }
+
+  flags = up_irq_save();
+  mag = &pool->mag[up_cpu_index()];
+  if (mag->count == CONFIG_MM_MEMPOOL_MAGAZINE_SIZE)
+    {
+      lflags = spin_lock_irqsave(&pool->lock);
+      for (i = 0; i < MEMPOOL_MAGAZINE_BATCH; i++)
+        {
+          sq_addfirst(mag->blks[--mag->count], &pool->list);
+        }
+
+      pool->nused -= MEMPOOL_MAGAZINE_BATCH;
+      spin_unlock_irqrestore(&pool->lock, lflags);
+    }
+
+  mag->blks[mag->count++] = blk;
+  up_irq_restore(flags);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mempool_magazine_flush
+ *
+ * Description:
+ *   Return the blocks of all magazines to the shared list.  The pool must
+ *   not be in use by the other CPUs.
+ *
+ ****************************************************************************/
+
+static void mempool_magazine_flush(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_magazine_s *mag;
+  irqstate_t flags;
+  int cpu;
+
+  flags = spin_lock_irqsave(&pool->lock);
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      mag = &pool->mag[cpu];
+      while (mag->count > 0)
+        {
+          sq_addfirst(mag->blks[--mag->count], &pool->list);
+          pool->nused--;
+        }
+    }
+
+  spin_unlock_irqrestore(&pool->lock, flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -79,6 +255,9 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name,
     }
 
   pool->nused = 0;
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  memset(pool->mag, 0, sizeof(pool->mag));
+#endif
   pool->bsize = bsize;
   pool->nexpand = nexpand;
   pool->ninterrupt = ninterrupt;
@@ -89,7 +268,7 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name,
     {
       FAR sq_entry_t *base;
 
-      base = kmm_malloc(sizeof(*base) + bsize * count);
+      base = mempool_malloc(pool, sizeof(*base) + bsize * count);
       if (base == NULL)
         {
           return -ENOMEM;
@@ -138,6 +317,14 @@ FAR void *mempool_alloc(FAR struct mempool_s *pool)
       return NULL;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  blk = mempool_magazine_alloc(pool);
+  if (blk != NULL)
+    {
+      return blk;
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = sq_remfirst(&pool->list);
@@ -156,7 +343,8 @@ retry:
           spin_unlock_irqrestore(&pool->lock, flags);
           if (pool->nexpand != 0)
             {
-              blk = kmm_malloc(sizeof(*blk) + pool->bsize * pool->nexpand);
+              blk = mempool_malloc(pool, sizeof(*blk) +
+                                   pool->bsize * pool->nexpand);
               if (blk == NULL)
                 {
                   return NULL;
@@ -200,17 +388,21 @@ out_with_lock:
 void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 {
   irqstate_t flags;
-  FAR char *base;
 
   if (blk == NULL || pool == NULL)
     {
       return;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  if (mempool_magazine_free(pool, blk))
+    {
+      return;
+    }
+#endif
+
   flags = spin_lock_irqsave(&pool->lock);
-  base = (FAR char *)(sq_peek(&pool->elist) + 1);
-  if (pool->ninterrupt && (FAR char *)blk >= base &&
-      (FAR char *)blk < base + pool->ninterrupt * pool->bsize)
+  if (mempool_is_interrupt(pool, blk))
     {
       sq_addfirst(blk, &pool->ilist);
     }
@@ -250,6 +442,9 @@ void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
 int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  int cpu;
+#endif
 
   if (pool == NULL || info == NULL)
     {
@@ -262,6 +457,24 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
   info->aordblks = pool->nused;
   info->arena = (pool->nused + info->ordblks + info->iordblks) * pool->bsize;
   spin_unlock_irqrestore(&pool->lock, flags);
+
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  /* The magazines are sampled without locking, it's only a snapshot */
+
+  info->ncached = 0;
+  info->nhits = 0;
+  info->nmisses = 0;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      info->ncached += pool->mag[cpu].count;
+      info->nhits += pool->mag[cpu].nhits;
+      info->nmisses += pool->mag[cpu].nmisses;
+    }
+
+  info->aordblks = info->aordblks > info->ncached ?
+                   info->aordblks - info->ncached : 0;
+#endif
+
   info->sizeblks = pool->bsize;
   if (pool->nexpand == 0)
     {
@@ -297,6 +510,10 @@ int mempool_deinit(FAR struct mempool_s *pool)
       return -EINVAL;
     }
 
+#ifdef CONFIG_MM_MEMPOOL_MAGAZINE
+  mempool_magazine_flush(pool);
+#endif
+
   if (pool->nused != 0)
     {
       return -EBUSY;
@@ -308,7 +525,7 @@ int mempool_deinit(FAR struct mempool_s *pool)
 
   while ((blk = sq_remfirst(&pool->elist)) != NULL)
     {
-      kmm_free(blk);
+      mempool_mfree(pool, blk);
     }
 
   nxsem_destroy(&pool->wait);
@@ -0,0 +1,637 @@
+/****************************************************************************
+ * mm/mempool/mempool_multiple.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The alignment of the blocks returned by the pools, the same as the
+ * alignment guaranteed by malloc.
+ */
+
+#define MEMPOOL_MULTIPLE_ALIGN   (2 * sizeof(uintptr_t))
+#define MEMPOOL_MULTIPLE_ALIGNUP(s) \
+  (((s) + MEMPOOL_MULTIPLE_ALIGN - 1) & ~(MEMPOOL_MULTIPLE_ALIGN - 1))
+
+/* The initial number of entries of the chunk hash table.  The table is
+ * doubled whenever it becomes half full.
+ */
+
+#define MEMPOOL_MULTIPLE_NCHUNKS 16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_multiple_hash
+ ****************************************************************************/
+
+static inline size_t
+mempool_multiple_hash(FAR struct mempool_multiple_s *mpool, uintptr_t addr,
+                      size_t maxchunks)
+{
+  return ((addr / mpool->expandsize) * 2654435761u) & (maxchunks - 1);
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_insert
+ *
+ * Description:
+ *   Add a chunk to the hash table, the table must have a free entry.
+ *
+ ****************************************************************************/
+
+static void mempool_multiple_insert(FAR struct mempool_multiple_s *mpool,
+                                    FAR struct mempool_multiple_chunk_s *tab,
+                                    size_t maxchunks, uintptr_t addr,
+                                    FAR struct mempool_s *pool)
+{
+  size_t i = mempool_multiple_hash(mpool, addr, maxchunks);
+
+  while (tab[i].addr != 0)
+    {
+      i = (i + 1) & (maxchunks - 1);
+    }
+
+  tab[i].addr = addr;
+  tab[i].pool = pool;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_find
+ *
+ * Description:
+ *   Find the pool that owns blk.  Only the hash table is consulted, so blk
+ *   may be any pointer.
+ *
+ ****************************************************************************/
+
+static FAR struct mempool_s *
+mempool_multiple_find(FAR struct mempool_multiple_s *mpool, FAR void *blk)
+{
+  FAR struct mempool_s *pool = NULL;
+  uintptr_t addr;
+  irqstate_t flags;
+  size_t i;
+
+  if (blk == NULL || mpool->npools == 0)
+    {
+      return NULL;
+    }
+
+  addr = (uintptr_t)blk & ~(mpool->expandsize - 1);
+
+  flags = spin_lock_irqsave(&mpool->lock);
+  if (mpool->chunks != NULL)
+    {
+      i = mempool_multiple_hash(mpool, addr, mpool->maxchunks);
+      while (mpool->chunks[i].addr != 0)
+        {
+          if (mpool->chunks[i].addr == addr)
+            {
+              pool = mpool->chunks[i].pool;
+              break;
+            }
+
+          i = (i + 1) & (mpool->maxchunks - 1);
+        }
+    }
+
+  spin_unlock_irqrestore(&mpool->lock, flags);
+  return pool;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_add
+ *
+ * Description:
+ *   Record a new expand chunk of pool, growing the hash table if needed.
+ *
+ ****************************************************************************/
+
+static int mempool_multiple_add(FAR struct mempool_multiple_s *mpool,
+                                uintptr_t addr, FAR struct mempool_s *pool)
+{
+  FAR struct mempool_multiple_chunk_s *old;
+  FAR struct mempool_multiple_chunk_s *tab;
+  irqstate_t flags;
+  size_t maxchunks;
+  size_t i;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&mpool->lock);
+      if (2 * (mpool->nchunks + 1) <= mpool->maxchunks)
+        {
+          mempool_multiple_insert(mpool, mpool->chunks, mpool->maxchunks,
+                                  addr, pool);
+          mpool->nchunks++;
+          spin_unlock_irqrestore(&mpool->lock, flags);
+          return 0;
+        }
+
+      maxchunks = mpool->maxchunks ? 2 * mpool->maxchunks :
+                  MEMPOOL_MULTIPLE_NCHUNKS;
+      spin_unlock_irqrestore(&mpool->lock, flags);
+
+      /* Allocate the new table without holding the lock */
+
+      tab = mpool->alloc(mpool->arg, MEMPOOL_MULTIPLE_ALIGN,
+                         maxchunks * sizeof(*tab));
+      if (tab == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      memset(tab, 0, maxchunks * sizeof(*tab));
+
+      flags = spin_lock_irqsave(&mpool->lock);
+      if (mpool->maxchunks < maxchunks)
+        {
+          for (i = 0; i < mpool->maxchunks; i++)
+            {
+              if (mpool->chunks[i].addr != 0)
+                {
+                  mempool_multiple_insert(mpool, tab, maxchunks,
+                                          mpool->chunks[i].addr,
+                                          mpool->chunks[i].pool);
+                }
+            }
+
+          old              = mpool->chunks;
+          mpool->chunks    = tab;
+          mpool->maxchunks = maxchunks;
+          tab              = old;
+        }
+
+      spin_unlock_irqrestore(&mpool->lock, flags);
+
+      /* Free either the old table or the one lost the race */
+
+      if (tab != NULL)
+        {
+          mpool->free(mpool->arg, tab);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_expand
+ *
+ * Description:
+ *   The alloc hook of every pool of the set.  The memory is taken from an
+ *   aligned chunk of expandsize bytes, so that the blocks (which follow the
+ *   sq_entry_t header of the expand list) are aligned too.
+ *
+ ****************************************************************************/
+
+static FAR void *mempool_multiple_expand(FAR struct mempool_s *pool,
+                                         size_t size)
+{
+  FAR struct mempool_multiple_s *mpool = pool->priv;
+  FAR char *base;
+
+  DEBUGASSERT(size + MEMPOOL_MULTIPLE_ALIGN - sizeof(sq_entry_t) <=
+              mpool->expandsize);
+
+  base = mpool->alloc(mpool->arg, mpool->expandsize, mpool->expandsize);
+  if (base == NULL)
+    {
+      return NULL;
+    }
+
+  if (mempool_multiple_add(mpool, (uintptr_t)base, pool) < 0)
+    {
+      mpool->free(mpool->arg, base);
+      return NULL;
+    }
+
+  return base + MEMPOOL_MULTIPLE_ALIGN - sizeof(sq_entry_t);
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_release
+ *
+ * Description:
+ *   The free hook of every pool of the set.
+ *
+ ****************************************************************************/
+
+static void mempool_multiple_release(FAR struct mempool_s *pool,
+                                     FAR void *addr)
+{
+  FAR struct mempool_multiple_s *mpool = pool->priv;
+
+  mpool->free(mpool->arg,
+              (FAR void *)((uintptr_t)addr & ~(mpool->expandsize - 1)));
+}
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+static FAR void *mempool_multiple_heap_alloc(FAR void *arg,
+                                             size_t alignment, size_t size)
+{
+  return mm_memalign(arg, alignment, size);
+}
+
+static void mempool_multiple_heap_free(FAR void *arg, FAR void *addr)
+{
+  mm_free(arg, addr);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_multiple_init
+ *
+ * Description:
+ *   Initialize a set of memory pools.  Every pool gets its blocks from
+ *   chunks of expandsize bytes, aligned to expandsize, so the owner of a
+ *   block can be found from its address alone.
+ *
+ * Input Parameters:
+ *   mpool      - Address of the memory pools to be used.
+ *   name       - The name of memory pools.
+ *   bsizes     - The block sizes of the pools, in ascending order.
+ *   npools     - The number of the pools.
+ *   alloc      - The function to get memory from the backing heap.
+ *   free       - The function to release memory to the backing heap.
+ *   arg        - The argument of alloc and free.
+ *   expandsize - The size of every expand chunk, must be a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_init(FAR struct mempool_multiple_s *mpool,
+                          FAR const char *name,
+                          FAR const size_t *bsizes, size_t npools,
+                          mempool_multiple_alloc_t alloc,
+                          mempool_multiple_free_t free, FAR void *arg,
+                          size_t expandsize)
+{
+  FAR struct mempool_s *pools;
+  size_t bsize;
+  size_t i;
+  int ret;
+
+  if (mpool == NULL || bsizes == NULL || npools == 0 || alloc == NULL ||
+      free == NULL || (expandsize & (expandsize - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < npools; i++)
+    {
+      bsize = bsizes[i];
+      if (bsize == 0 || bsize % MEMPOOL_MULTIPLE_ALIGN != 0 ||
+          (i > 0 && bsize <= bsizes[i - 1]) ||
+          bsize + MEMPOOL_MULTIPLE_ALIGN > expandsize)
+        {
+          return -EINVAL;
+        }
+    }
+
+  pools = alloc(arg, MEMPOOL_MULTIPLE_ALIGN, npools * sizeof(*pools));
+  if (pools == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(pools, 0, npools * sizeof(*pools));
+
+  mpool->npools     = 0;
+  mpool->expandsize = expandsize;
+  mpool->alloc      = alloc;
+  mpool->free       = free;
+  mpool->arg        = arg;
+  mpool->chunks     = NULL;
+  mpool->nchunks    = 0;
+  mpool->maxchunks  = 0;
+
+  for (i = 0; i < npools; i++)
+    {
+      pools[i].alloc = mempool_multiple_expand;
+      pools[i].free  = mempool_multiple_release;
+      pools[i].priv  = mpool;
+
+      ret = mempool_init(&pools[i], name, bsizes[i], 0,
+                         (expandsize - MEMPOOL_MULTIPLE_ALIGN) / bsizes[i],
+                         0);
+      if (ret < 0)
+        {
+          while (i-- > 0)
+            {
+              mempool_deinit(&pools[i]);
+            }
+
+          free(arg, pools);
+          return ret;
+        }
+    }
+
+  /* Publish the pools only when all of them are ready */
+
+  mpool->pools  = pools;
+  mpool->npools = npools;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_alloc
+ *
+ * Description:
+ *   Allocate a block from the smallest pool of the set that fits size.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   size  - The size of the block.
+ *
+ * Returned Value:
+ *   The pointer to the allocated block on success; NULL if size is too
+ *   large for the pools or on any failure.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_multiple_alloc(FAR struct mempool_multiple_s *mpool,
+                                 size_t size)
+{
+  size_t low = 0;
+  size_t high;
+  size_t mid;
+
+  if (size == 0 || mpool->npools == 0 ||
+      size > mpool->pools[mpool->npools - 1].bsize)
+    {
+      return NULL;
+    }
+
+  /* Find the smallest pool that fits */
+
+  high = mpool->npools - 1;
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      if (mpool->pools[mid].bsize < size)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  return mempool_alloc(&mpool->pools[low]);
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_realloc
+ *
+ * Description:
+ *   Change the size of a block allocated by mempool_multiple_alloc.  The
+ *   new block is taken from the backing heap if size is too large for the
+ *   pools.
+ *
+ * Input Parameters:
+ *   mpool  - Address of the memory pools to be used.
+ *   oldblk - The pointer of the block owned by the pools.
+ *   size   - The new size of the block.
+ *
+ * Returned Value:
+ *   The pointer to the block on success; NULL on any failure, and the old
+ *   block is kept.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_multiple_realloc(FAR struct mempool_multiple_s *mpool,
+                                   FAR void *oldblk, size_t size)
+{
+  FAR struct mempool_s *pool;
+  FAR void *blk;
+
+  pool = mempool_multiple_find(mpool, oldblk);
+  DEBUGASSERT(pool != NULL);
+
+  if (size == 0)
+    {
+      mempool_free(pool, oldblk);
+      return NULL;
+    }
+
+  /* Keep the old block if it is large enough and not much too large */
+
+  if (size <= pool->bsize && (pool == mpool->pools ||
+                              size > (pool - 1)->bsize))
+    {
+      return oldblk;
+    }
+
+  blk = mempool_multiple_alloc(mpool, size);
+  if (blk == NULL)
+    {
+      blk = mpool->alloc(mpool->arg, MEMPOOL_MULTIPLE_ALIGN, size);
+      if (blk == NULL)
+        {
+          return NULL;
+        }
+    }
+
+  memcpy(blk, oldblk, size < pool->bsize ? size : pool->bsize);
+  mempool_free(pool, oldblk);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_free
+ *
+ * Description:
+ *   Release a block to the pool of the set that owns it.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   blk   - The pointer of memory block.
+ *
+ * Returned Value:
+ *   Zero on success; -EINVAL if blk isn't owned by the pools.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_free(FAR struct mempool_multiple_s *mpool,
+                          FAR void *blk)
+{
+  FAR struct mempool_s *pool;
+
+  pool = mempool_multiple_find(mpool, blk);
+  if (pool == NULL)
+    {
+      return -EINVAL;
+    }
+
+  mempool_free(pool, blk);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_alloc_size
+ *
+ * Description:
+ *   Get the usable size of a block owned by the pools.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   blk   - The pointer of memory block.
+ *
+ * Returned Value:
+ *   The block size on success; -EINVAL if blk isn't owned by the pools.
+ *
+ ****************************************************************************/
+
+ssize_t mempool_multiple_alloc_size(FAR struct mempool_multiple_s *mpool,
+                                    FAR void *blk)
+{
+  FAR struct mempool_s *pool;
+
+  pool = mempool_multiple_find(mpool, blk);
+  if (pool == NULL)
+    {
+      return -EINVAL;
+    }
+
+  return pool->bsize;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_deinit
+ *
+ * Description:
+ *   Deallocate a set of memory pools.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if any block is still in use.
+ *
+ ****************************************************************************/
+
+int mempool_multiple_deinit(FAR struct mempool_multiple_s *mpool)
+{
+  struct mempoolinfo_s info;
+  size_t npools;
+  size_t i;
+
+  if (mpool == NULL)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < mpool->npools; i++)
+    {
+      mempool_info(&mpool->pools[i], &info);
+      if (info.aordblks != 0)
+        {
+          return -EBUSY;
+        }
+    }
+
+  npools        = mpool->npools;
+  mpool->npools = 0;
+
+  for (i = 0; i < npools; i++)
+    {
+      mempool_deinit(&mpool->pools[i]);
+    }
+
+  if (mpool->chunks != NULL)
+    {
+      mpool->free(mpool->arg, mpool->chunks);
+      mpool->chunks = NULL;
+    }
+
+  mpool->free(mpool->arg, mpool->pools);
+  mpool->pools     = NULL;
+  mpool->nchunks   = 0;
+  mpool->maxchunks = 0;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mempool_multiple_heap_init
+ *
+ * Description:
+ *   Initialize the pools in front of the small allocations of a heap, as
+ *   configured by CONFIG_MM_HEAP_MEMPOOL_xxx.  The block sizes are spread
+ *   evenly up to CONFIG_MM_HEAP_MEMPOOL_THRESHOLD.
+ *
+ * Input Parameters:
+ *   mpool - Address of the memory pools to be used.
+ *   heap  - The heap that backs the pools.
+ *   name  - The name of memory pools.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+int mempool_multiple_heap_init(FAR struct mempool_multiple_s *mpool,
+                               FAR struct mm_heap_s *heap,
+                               FAR const char *name)
+{
+  size_t bsizes[CONFIG_MM_HEAP_MEMPOOL_NPOOLS];
+  size_t npools = 0;
+  size_t bsize;
+  int i;
+
+  for (i = 1; i <= CONFIG_MM_HEAP_MEMPOOL_NPOOLS; i++)
+    {
+      bsize = MEMPOOL_MULTIPLE_ALIGNUP(CONFIG_MM_HEAP_MEMPOOL_THRESHOLD * i /
+                                       CONFIG_MM_HEAP_MEMPOOL_NPOOLS);
+      if (npools == 0 || bsize > bsizes[npools - 1])
+        {
+          bsizes[npools++] = bsize;
+        }
+    }
+
+  return mempool_multiple_init(mpool, name, bsizes, npools,
+                               mempool_multiple_heap_alloc,
+                               mempool_multiple_heap_free, heap,
+                               CONFIG_MM_HEAP_MEMPOOL_EXPAND);
+}
+#endif
@@ -25,6 +25,8 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <errno.h>
+#include <strings.h>
 
 #include <nuttx/mm/gran.h>
 
@@ -32,6 +34,93 @@
 
 #ifdef CONFIG_GRAN
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_search
+ *
+ * Description:
+ *   Search the GAT for a run of ngranules free granules, starting at or
+ *   after granule 'start' and ending before granule 'end'.  The GAT is
+ *   scanned a whole word at a time, ffs() locates the first free granule
+ *   of a candidate run and then the first allocated granule after it.
+ *
+ * Input Parameters:
+ *   priv      - The granule heap state structure.
+ *   start     - The first granule to consider.
+ *   end       - One past the last granule that the run may use.
+ *   ngranules - The number of contiguous granules needed.
+ *
+ * Returned Value:
+ *   The number of the first granule of the run; -ENOMEM if there is none.
+ *
+ ****************************************************************************/
+
+static int gran_search(FAR struct gran_s *priv, unsigned int start,
+                       unsigned int end, unsigned int ngranules)
+{
+  unsigned int granno = start;
+  unsigned int gatidx;
+  unsigned int last;
+  uint32_t     curr;
+
+  while (granno + ngranules <= end)
+    {
+      /* Find the first free granule at or after granno, treating the
+       * granules below granno as allocated.
+       */
+
+      gatidx = granno >> 5;
+      curr   = priv->gat[gatidx] | ((1u << (granno & 31)) - 1);
+      while (curr == 0xffffffff)
+        {
+          if (++gatidx << 5 >= end)
+            {
+              return -ENOMEM;
+            }
+
+          curr = priv->gat[gatidx];
+        }
+
+      granno = (gatidx << 5) + ffs(~curr) - 1;
+      last   = granno + ngranules;
+      if (last > end)
+        {
+          return -ENOMEM;
+        }
+
+      /* Then find the first allocated granule after it, which ends the
+       * run of free granules.
+       */
+
+      gatidx = granno >> 5;
+      curr   = priv->gat[gatidx] & ~((1u << (granno & 31)) - 1);
+      while (curr == 0)
+        {
+          if (++gatidx << 5 >= last)
+            {
+              return granno;
+            }
+
+          curr = priv->gat[gatidx];
+        }
+
+      start = (gatidx << 5) + ffs(curr) - 1;
+      if (start >= last)
+        {
+          return granno;
+        }
+
+      /* The run is too short, continue after the allocated granule */
+
+      granno = start + 1;
+    }
+
+  return -ENOMEM;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -42,9 +131,9 @@
  * Description:
  *   Allocate memory from the granule heap.
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
+ *   With CONFIG_GRAN_NEXTFIT, the search starts after the last allocation
+ *   and wraps around to the start of the heap, otherwise the lowest free
+ *   run of granules is returned.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
@@ -62,189 +151,71 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
   unsigned int ngranules;
   size_t       tmpmask;
   uintptr_t    alloc;
-  uint32_t     curr;
-  uint32_t     next;
-  uint32_t     mask;
-  int          granidx;
-  int          gatidx;
-  int          bitidx;
-  int          shift;
+  int          granno;
   int          ret;
 
-  DEBUGASSERT(priv != NULL && size <= 32 * (1 << priv->log2gran));
+  DEBUGASSERT(priv != NULL);
 
-  if (priv != NULL && size > 0)
+  if (priv == NULL || size == 0)
     {
-      /* Get exclusive access to the GAT */
-
-      ret = gran_enter_critical(priv);
-      if (ret < 0)
-        {
-          return NULL;
-        }
-
-      /* How many contiguous granules we we need to find? */
-
-      tmpmask   = (1 << priv->log2gran) - 1;
-      ngranules = (size + tmpmask) >> priv->log2gran;
+      return NULL;
+    }
 
-      /* Then create mask for that number of granules */
+  /* How many contiguous granules we we need to find? */
 
-      DEBUGASSERT(ngranules <= 32);
-      mask = 0xffffffff >> (32 - ngranules);
+  tmpmask = (1 << priv->log2gran) - 1;
+  if (size > (size_t)priv->ngranules << priv->log2gran)
+    {
+      return NULL;
+    }
 
-      /* Now search the granule allocation table for that number
-       * of contiguous
-       */
+  ngranules = (size + tmpmask) >> priv->log2gran;
 
-      for (granidx = 0; granidx < priv->ngranules; granidx += 32)
-        {
-          /* Get the GAT index associated with the granule table entry */
+  /* Get exclusive access to the GAT */
 
-          gatidx = granidx >> 5;
-          curr = priv->gat[gatidx];
+  ret = gran_enter_critical(priv);
+  if (ret < 0)
+    {
+      return NULL;
+    }
 
-          /* Handle the case where there are no free granules in the entry */
+  /* Now search the granule allocation table for that number of contiguous
+   * free granules.
+   */
 
-          if (curr == 0xffffffff)
-            {
-              continue;
-            }
+#ifdef CONFIG_GRAN_NEXTFIT
+  granno = gran_search(priv, priv->hint, priv->ngranules, ngranules);
+  if (granno < 0 && priv->hint > 0)
+    {
+      /* Wrap around, the runs starting before the hint are left */
 
-          /* Get the next entry from the GAT to support a 64 bit shift */
+      unsigned int end = priv->hint + ngranules - 1;
 
-          if (granidx + 32 < priv->ngranules)
-            {
-              next = priv->gat[gatidx + 1];
-            }
+      granno = gran_search(priv, 0, end < priv->ngranules ?
+                           end : priv->ngranules, ngranules);
+    }
+#else
+  granno = gran_search(priv, 0, priv->ngranules, ngranules);
+#endif
 
-          /* Use all ones when are at the last entry in the GAT (meaning
-           * nothing can be allocated.
-           */
+  if (granno < 0)
+    {
+      gran_leave_critical(priv);
+      return NULL;
+    }
 
-          else
-            {
-              next = 0xffffffff;
-            }
+  /* Mark these granules allocated */
 
-          /* Search through the allocations in the 'curr' GAT entry
-           * to see if we can satisfy the allocation starting in that
-           * entry.
-           *
-           * This loop continues until either all of the bits have been
-           * examined (bitidx >= 32), or until there are insufficient
-           * granules left to satisfy the allocation.
-           */
-
-          alloc = priv->heapstart + (granidx << priv->log2gran);
-
-          for (bitidx = 0;
-               bitidx < 32 &&
-               (granidx + bitidx + ngranules) <= priv->ngranules;
-              )
-            {
-              /* Break out if there are no further free bits in 'curr'.
-               * All of the zero bits might have gotten shifted out.
-               */
-
-              if (curr == 0xffffffff)
-                {
-                  break;
-                }
-
-              /* Check for the first zero bit in the lower or upper 16-bits.
-               * From the test above, we know that at least one of the 32-
-               * bits in 'curr' is zero.
-               */
-
-              else if ((curr & 0x0000ffff) == 0x0000ffff)
-                {
-                  /* Not in the lower 16 bits.  The first free bit must be
-                   * in the upper 16 bits.
-                   */
-
-                  shift = 16;
-                }
-
-              /* We know that the first free bit is now within the lower 16
-               * bits of 'curr'.  Is it in the upper or lower byte?
-               */
-
-              else if ((curr & 0x0000ff) == 0x000000ff)
-                {
-                  /* Not in the lower 8 bits.  The first free bit must be in
-                   * the upper 8 bits.
-                   */
-
-                  shift = 8;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower nibble?
-               */
-
-              else if ((curr & 0x00000f) == 0x0000000f)
-                {
-                  /* Not in the lower 4 bits.  The first free bit must be in
-                   * the upper 4 bits.
-                   */
-
-                  shift = 4;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower pair?
-               */
-
-              else if ((curr & 0x000003) == 0x00000003)
-                {
-                  /* Not in the lower 2 bits.  The first free bit must be in
-                   * the upper 2 bits.
-                   */
-
-                  shift = 2;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Check if we have the allocation at this
-               * bit position.
-               */
-
-              else if ((curr & mask) == 0)
-                {
-                  /* Yes.. mark these granules allocated */
-
-                  gran_mark_allocated(priv, alloc, ngranules);
-
-                  /* And return the allocation address */
-
-                  gran_leave_critical(priv);
-                  return (FAR void *)alloc;
-                }
-
-              /* The free allocation does not start at this position */
-
-              else
-                {
-                  shift = 1;
-                }
-
-              /* Set up for the next time through the loop.  Perform a 64
-               * bit shift to move to the next gran position and increment
-               * to the next candidate allocation address.
-               */
-
-              alloc  += (shift << priv->log2gran);
-              curr    = (curr >> shift) | (next << (32 - shift));
-              next  >>= shift;
-              bitidx += shift;
-            }
-        }
+  alloc = priv->heapstart + ((uintptr_t)granno << priv->log2gran);
+  gran_mark_allocated(priv, alloc, ngranules);
 
-      gran_leave_critical(priv);
-    }
+#ifdef CONFIG_GRAN_NEXTFIT
+  priv->hint = granno + ngranules < priv->ngranules ?
+               granno + ngranules : 0;
+#endif
 
-  return NULL;
+  gran_leave_critical(priv);
+  return (FAR void *)alloc;
 }
 
 #endif /* CONFIG_GRAN */
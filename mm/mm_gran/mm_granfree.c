@@ -59,11 +59,11 @@ void gran_free(GRAN_HANDLE handle, FAR void *memory, size_t size)
   unsigned int gatbit;
   unsigned int granmask;
   unsigned int ngranules;
-  unsigned int avail;
+  unsigned int nbits;
   uint32_t     gatmask;
   int          ret;
 
-  DEBUGASSERT(priv != NULL && memory && size <= 32 * (1 << priv->log2gran));
+  DEBUGASSERT(priv != NULL && memory);
 
   /* Get exclusive access to the GAT */
 
@@ -95,38 +95,20 @@ void gran_free(GRAN_HANDLE handle, FAR void *memory, size_t size)
   granmask =  (1 << priv->log2gran) - 1;
   ngranules = (size + granmask) >> priv->log2gran;
 
-  /* Clear bits in the GAT entry or entries */
+  /* Clear bits in the GAT entries, a whole entry at a time */
 
-  avail = 32 - gatbit;
-  if (ngranules > avail)
-    {
-      /* Clear bits in the first GAT entry */
-
-      gatmask = (0xffffffff << gatbit);
-      DEBUGASSERT((priv->gat[gatidx] & gatmask) == gatmask);
-
-      priv->gat[gatidx] &= ~gatmask;
-      ngranules -= avail;
-
-      /* Clear bits in the second GAT entry */
+  DEBUGASSERT(granno + ngranules <= priv->ngranules);
 
-      gatmask = 0xffffffff >> (32 - ngranules);
-      DEBUGASSERT((priv->gat[gatidx + 1] & gatmask) == gatmask);
-
-      priv->gat[gatidx + 1] &= ~gatmask;
-    }
-
-  /* Handle the case where where all of the granules came from one entry */
-
-  else
+  while (ngranules > 0)
     {
-      /* Clear bits in a single GAT entry */
-
-      gatmask   = 0xffffffff >> (32 - ngranules);
+      nbits     = ngranules < 32 - gatbit ? ngranules : 32 - gatbit;
+      gatmask   = 0xffffffff >> (32 - nbits);
       gatmask <<= gatbit;
       DEBUGASSERT((priv->gat[gatidx] & gatmask) == gatmask);
 
-      priv->gat[gatidx] &= ~gatmask;
+      priv->gat[gatidx++] &= ~gatmask;
+      ngranules -= nbits;
+      gatbit     = 0;
     }
 
   gran_leave_critical(priv);
@@ -0,0 +1,572 @@
+/****************************************************************************
+ * mm/mm_gran/mm_pgbuddy.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/pgalloc.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_MM_PGALLOC_BUDDY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+
+/* CONFIG_MM_PGALLOC_BUDDY - Use the binary buddy page allocator instead of
+ *   the granule allocator based one.
+ * CONFIG_MM_PGALLOC_BUDDY_MAXORDER - Log base 2 of the largest block, in
+ *   pages, that is kept on the free lists.  Larger requests can't be
+ *   satisfied.
+ */
+
+/* Debug */
+
+#ifdef CONFIG_DEBUG_PGALLOC
+#  define pgaerr                    _err
+#  define pgawarn                   _warn
+#  define pgainfo                   _info
+#else
+#  define pgaerr                    merr
+#  define pgawarn                   mwarn
+#  define pgainfo                   minfo
+#endif
+
+#define PGBUDDY_NORDERS             (CONFIG_MM_PGALLOC_BUDDY_MAXORDER + 1)
+
+/* Page indices are 16-bit, like the counts returned in struct pginfo_s */
+
+#define PGBUDDY_NIL                 UINT16_MAX
+#define PGBUDDY_MAXPAGES            UINT16_MAX
+
+/* Value of g_pgbuddy.order[] for a page that is not the first page of a
+ * free block.
+ */
+
+#define PGBUDDY_NOTFREE             UINT8_MAX
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The free list links of one page.  Only used for the first page of a free
+ * block.  The links are kept out of the pages themselves because the page
+ * memory is physical memory that may not be accessible at its physical
+ * address.
+ */
+
+struct pgbuddy_link_s
+{
+  uint16_t flink;                   /* Next free block of the same order */
+  uint16_t blink;                   /* Previous free block of the same order */
+};
+
+/* The state of the buddy page allocator */
+
+struct pgbuddy_s
+{
+  uintptr_t heapstart;              /* The aligned start of the page heap */
+  uint16_t npages;                  /* The total number of pages */
+  uint16_t nfree;                   /* The number of free pages */
+  uint16_t head[PGBUDDY_NORDERS];   /* Free lists, one per block order */
+  sem_t exclsem;                    /* For exclusive access to the lists */
+  FAR struct pgbuddy_link_s *link;  /* Free list links, one per page */
+  FAR uint8_t *order;               /* Order of a free block, per page */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The state of the page allocator */
+
+static struct pgbuddy_s g_pgbuddy;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pgbuddy_insert
+ *
+ * Description:
+ *   Add the free block starting at page 'ndx' to the free list of 'order'.
+ *   No coalescing is done.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_insert(unsigned int ndx, unsigned int order)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int next = priv->head[order];
+
+  priv->link[ndx].flink = next;
+  priv->link[ndx].blink = PGBUDDY_NIL;
+  if (next != PGBUDDY_NIL)
+    {
+      priv->link[next].blink = ndx;
+    }
+
+  priv->head[order] = ndx;
+  priv->order[ndx]  = order;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_remove
+ *
+ * Description:
+ *   Remove the free block starting at page 'ndx' from the free list of
+ *   'order'.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_remove(unsigned int ndx, unsigned int order)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int next = priv->link[ndx].flink;
+  unsigned int prev = priv->link[ndx].blink;
+
+  DEBUGASSERT(priv->order[ndx] == order);
+
+  if (prev != PGBUDDY_NIL)
+    {
+      priv->link[prev].flink = next;
+    }
+  else
+    {
+      priv->head[order] = next;
+    }
+
+  if (next != PGBUDDY_NIL)
+    {
+      priv->link[next].blink = prev;
+    }
+
+  priv->order[ndx] = PGBUDDY_NOTFREE;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_free_block
+ *
+ * Description:
+ *   Free the block of 2**order pages starting at page 'ndx', merging it
+ *   with its buddy for as long as the buddy is free too.  The caller
+ *   accounts for the freed pages.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_free_block(unsigned int ndx, unsigned int order)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int buddy;
+
+  while (order < CONFIG_MM_PGALLOC_BUDDY_MAXORDER)
+    {
+      buddy = ndx ^ (1u << order);
+      if (buddy >= priv->npages || priv->order[buddy] != order)
+        {
+          break;
+        }
+
+      pgbuddy_remove(buddy, order);
+      ndx &= ~(1u << order);
+      order++;
+    }
+
+  pgbuddy_insert(ndx, order);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_free_range
+ *
+ * Description:
+ *   Free the pages in [start, end) by splitting the range into the largest
+ *   naturally aligned blocks that fit.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_free_range(unsigned int start, unsigned int end)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int order;
+
+  DEBUGASSERT(start <= end && end <= priv->npages);
+
+  priv->nfree += end - start;
+  while (start < end)
+    {
+      order = 0;
+      while (order < CONFIG_MM_PGALLOC_BUDDY_MAXORDER &&
+             (start & ((2u << order) - 1)) == 0 &&
+             start + (2u << order) <= end)
+        {
+          order++;
+        }
+
+      pgbuddy_free_block(start, order);
+      start += 1u << order;
+    }
+}
+
+/****************************************************************************
+ * Name: pgbuddy_find_free
+ *
+ * Description:
+ *   Return the first page of the free block that contains page 'ndx' and
+ *   its order, or PGBUDDY_NIL if the page is not free.
+ *
+ ****************************************************************************/
+
+static unsigned int pgbuddy_find_free(unsigned int ndx,
+                                      FAR unsigned int *order)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int head;
+  unsigned int i;
+
+  for (i = 0; i < PGBUDDY_NORDERS; i++)
+    {
+      head = ndx & ~((1u << i) - 1);
+      if (priv->order[head] == i)
+        {
+          *order = i;
+          return head;
+        }
+    }
+
+  return PGBUDDY_NIL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_pginitialize
+ *
+ * Description:
+ *   Initialize the page allocator.
+ *
+ * Input Parameters:
+ *   heap_start - The physical address of the start of memory region that
+ *                will be used for the page allocator heap
+ *   heap_size  - The size (in bytes) of the memory region that will be used
+ *                for the page allocator heap.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginitialize(FAR void *heap_start, size_t heap_size)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  uintptr_t heapend = (uintptr_t)heap_start + heap_size;
+  size_t npages;
+  unsigned int i;
+
+  priv->heapstart = MM_PGALIGNUP(heap_start);
+  npages = heapend > priv->heapstart ?
+           (heapend - priv->heapstart) >> MM_PGSHIFT : 0;
+
+  if (npages > PGBUDDY_MAXPAGES)
+    {
+      pgawarn("WARNING: Only %u of %zu pages are managed\n",
+              PGBUDDY_MAXPAGES, npages);
+      npages = PGBUDDY_MAXPAGES;
+    }
+
+  priv->npages = npages;
+  priv->link   = kmm_malloc(npages * (sizeof(struct pgbuddy_link_s) + 1));
+  DEBUGASSERT(priv->link != NULL);
+
+  priv->order  = (FAR uint8_t *)&priv->link[npages];
+  memset(priv->order, PGBUDDY_NOTFREE, npages);
+
+  for (i = 0; i < PGBUDDY_NORDERS; i++)
+    {
+      priv->head[i] = PGBUDDY_NIL;
+    }
+
+  nxsem_init(&priv->exclsem, 0, 1);
+
+  /* Initially all of the pages are free */
+
+  pgbuddy_free_range(0, npages);
+}
+
+/****************************************************************************
+ * Name: mm_pgreserve
+ *
+ * Description:
+ *   Reserve memory in the page memory pool.  This will reserve the pages
+ *   that contain the start and end addresses plus all of the pages
+ *   in between.  This should be done early in the initialization sequence
+ *   before any other allocations are made.
+ *
+ *   Reserved memory can never be allocated (it can be freed however which
+ *   essentially unreserves the memory).
+ *
+ * Input Parameters:
+ *   start  - The address of the beginning of the region to be reserved.
+ *   size   - The size of the region to be reserved
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgreserve(uintptr_t start, size_t size)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  uintptr_t heapend = priv->heapstart +
+                      ((uintptr_t)priv->npages << MM_PGSHIFT);
+  uintptr_t end = start + size;
+  unsigned int ndx;
+  unsigned int last;
+  unsigned int head;
+  unsigned int bend;
+  unsigned int order;
+
+  /* Clip the region to the page heap */
+
+  start = MM_PGALIGNDOWN(start);
+  end   = MM_PGALIGNUP(end);
+
+  if (start < priv->heapstart)
+    {
+      start = priv->heapstart;
+    }
+
+  if (end > heapend)
+    {
+      end = heapend;
+    }
+
+  if (start >= end)
+    {
+      return;
+    }
+
+  ndx  = (start - priv->heapstart) >> MM_PGSHIFT;
+  last = (end - priv->heapstart) >> MM_PGSHIFT;
+
+  nxsem_wait_uninterruptible(&priv->exclsem);
+
+  /* Take each free block overlapping the region off the free lists and
+   * give back the parts of it that lie outside of the region.
+   */
+
+  while (ndx < last)
+    {
+      head = pgbuddy_find_free(ndx, &order);
+      if (head == PGBUDDY_NIL)
+        {
+          ndx++;
+          continue;
+        }
+
+      bend = head + (1u << order);
+
+      pgbuddy_remove(head, order);
+      priv->nfree -= 1u << order;
+
+      pgbuddy_free_range(head, ndx);
+      if (bend > last)
+        {
+          pgbuddy_free_range(last, bend);
+          bend = last;
+        }
+
+      ndx = bend;
+    }
+
+  nxsem_post(&priv->exclsem);
+}
+
+/****************************************************************************
+ * Name: mm_pgalloc
+ *
+ * Description:
+ *   Allocate page memory from the page memory pool.
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.  NOTE:  This is an unmapped
+ *   physical address and cannot be used until it is appropriately mapped.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc(unsigned int npages)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int order;
+  unsigned int ndx;
+  unsigned int i;
+
+  if (npages == 0)
+    {
+      return 0;
+    }
+
+  /* Get the order of the smallest block that can hold npages */
+
+  for (order = 0; order < PGBUDDY_NORDERS; order++)
+    {
+      if ((1u << order) >= npages)
+        {
+          break;
+        }
+    }
+
+  if (order >= PGBUDDY_NORDERS)
+    {
+      pgaerr("ERROR: %u pages exceeds the largest block\n", npages);
+      return 0;
+    }
+
+  nxsem_wait_uninterruptible(&priv->exclsem);
+
+  /* Find the smallest free block that is large enough */
+
+  for (i = order; i < PGBUDDY_NORDERS; i++)
+    {
+      if (priv->head[i] != PGBUDDY_NIL)
+        {
+          break;
+        }
+    }
+
+  if (i >= PGBUDDY_NORDERS)
+    {
+      nxsem_post(&priv->exclsem);
+      return 0;
+    }
+
+  ndx = priv->head[i];
+  pgbuddy_remove(ndx, i);
+  priv->nfree -= 1u << i;
+
+  /* Split it, putting the upper halves back on the free lists */
+
+  while (i > order)
+    {
+      i--;
+      pgbuddy_insert(ndx + (1u << i), i);
+      priv->nfree += 1u << i;
+    }
+
+  /* Give back the pages beyond npages */
+
+  pgbuddy_free_range(ndx + npages, ndx + (1u << order));
+
+  nxsem_post(&priv->exclsem);
+
+  return priv->heapstart + ((uintptr_t)ndx << MM_PGSHIFT);
+}
+
+/****************************************************************************
+ * Name: mm_pgfree
+ *
+ * Description:
+ *   Return page memory to the page memory pool.
+ *
+ * Input Parameters:
+ *   paddr  - A physical address to a page in the page memory pool previously
+ *            allocated by mm_pgalloc.
+ *   npages - The number of contiguous pages to be return to the page memory
+ *            pool, beginning with the page at paddr;
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgfree(uintptr_t paddr, unsigned int npages)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  unsigned int ndx;
+
+  DEBUGASSERT(MM_ISALIGNED(paddr) && paddr >= priv->heapstart);
+
+  ndx = (paddr - priv->heapstart) >> MM_PGSHIFT;
+  DEBUGASSERT(ndx + npages <= priv->npages);
+
+  nxsem_wait_uninterruptible(&priv->exclsem);
+  DEBUGASSERT(priv->order[ndx] == PGBUDDY_NOTFREE);
+  pgbuddy_free_range(ndx, ndx + npages);
+  nxsem_post(&priv->exclsem);
+}
+
+/****************************************************************************
+ * Name: mm_pginfo
+ *
+ * Description:
+ *   Return information about the page allocator.  mxfree is the size of
+ *   the largest free block, i.e. the largest request that can be satisfied.
+ *
+ * Input Parameters:
+ *   info   - Memory location to return the page allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginfo(FAR struct pginfo_s *info)
+{
+  FAR struct pgbuddy_s *priv = &g_pgbuddy;
+  int i;
+
+  DEBUGASSERT(info != NULL);
+
+  nxsem_wait_uninterruptible(&priv->exclsem);
+
+  info->ntotal = priv->npages;
+  info->nfree  = priv->nfree;
+  info->mxfree = 0;
+
+  for (i = CONFIG_MM_PGALLOC_BUDDY_MAXORDER; i >= 0; i--)
+    {
+      if (priv->head[i] != PGBUDDY_NIL)
+        {
+          info->mxfree = 1u << i;
+          break;
+        }
+    }
+
+  nxsem_post(&priv->exclsem);
+}
+
+#endif /* CONFIG_MM_PGALLOC_BUDDY */
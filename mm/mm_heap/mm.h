@@ -28,6 +28,7 @@
 #include <nuttx/config.h>
 
 #include <nuttx/fs/procfs.h>
+#include <nuttx/spinlock.h>
 
 #include <assert.h>
 #include <execinfo.h>
@@ -145,6 +146,22 @@
 # define MMSIZE_MAX      UINT32_MAX
 #endif
 
+/* Per-CPU cache: One list per granule size up to the largest cached chunk */
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+#  define MM_PERCPU_NCLASSES   (CONFIG_MM_PERCPU_CACHE_MAXSIZE >> MM_MIN_SHIFT)
+#  define MM_PERCPU_MAXCHUNK   (MM_PERCPU_NCLASSES << MM_MIN_SHIFT)
+#  define MM_PERCPU_NDX(s)     (((s) >> MM_MIN_SHIFT) - 1)
+#endif
+
+/* The mask of all regions of a heap, see mm_region_mask() */
+
+#define MM_REGION_ALL          (~0u)
+
+#if defined(CONFIG_MM_REGION_ATTR) && CONFIG_MM_REGIONS > 32
+#  error CONFIG_MM_REGION_ATTR supports at most 32 regions
+#endif
+
 #define MM_IS_ALLOCATED(n) \
   ((int)((FAR struct mm_allocnode_s *)(n)->preceding) < 0)
 
@@ -212,6 +229,67 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* This describes the cache of free chunks owned by one CPU.  The chunks
+ * are linked through their user data with struct mm_delaynode_s and stay
+ * marked as allocated in the heap.
+ */
+
+struct mm_percpu_s
+{
+  FAR struct mm_delaynode_s *head[MM_PERCPU_NCLASSES];
+  uint8_t count[MM_PERCPU_NCLASSES];
+  size_t nhits;                             /* Allocations from the cache */
+  size_t nmisses;                           /* Cacheable allocations missed */
+  size_t ndrains;                           /* Batches returned to the heap */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+/* This describes the allocation statistics of one heap.  The histogram is
+ * indexed by the nodelist index of the chunk size.
+ */
+
+struct mm_stats_s
+{
+  spinlock_t lock;                          /* Protects the counters */
+  size_t nmallocs;                          /* Successful allocations */
+  size_t nfrees;                            /* Frees */
+  size_t nfailed;                           /* Failed heap searches */
+  size_t usedsize;                          /* Size of the allocated chunks */
+  size_t peaksize;                          /* Peak of usedsize */
+  size_t nalloc[MM_NNODES];                 /* Allocations per size class */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+/* The size of the hash table of the live samples, kept at most half full */
+
+#define MM_PROFILE_NSLOTS (2 * CONFIG_MM_HEAP_PROFILE_NSAMPLES)
+
+/* This describes one sampled allocation that was not freed yet */
+
+struct mm_profile_sample_s
+{
+  uintptr_t addr;                           /* Allocated memory, 0 if unused */
+  uint32_t  id;                             /* Sample number */
+  uint32_t  time;                           /* Allocation time in ticks */
+};
+
+/* This describes the state of the sampling heap profiler */
+
+struct mm_profile_s
+{
+  spinlock_t lock;                          /* Protects the fields below */
+  size_t countdown;                         /* Bytes/allocations to sample */
+  size_t nsampled;                          /* Allocations sampled */
+  size_t nlive;                             /* Entries used in samples[] */
+  size_t ndropped;                          /* Samples dropped, table full */
+  uint32_t nextid;                          /* Number of the next sample */
+  struct mm_profile_sample_s samples[MM_PROFILE_NSLOTS];
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -235,6 +313,12 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_REGION_ATTR
+  /* The MM_REGION_* attributes of each region */
+
+  uint8_t mm_regionattr[CONFIG_MM_REGIONS];
+#endif
+
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
@@ -248,6 +332,30 @@ struct mm_heap_s
 
   FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Per-CPU caches of small, recently freed chunks */
+
+  struct mm_percpu_s mm_percpu[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+  /* Allocation statistics */
+
+  struct mm_stats_s mm_stats;
+#endif
+
+#ifdef CONFIG_MM_HEAP_PROFILE
+  /* Sampling heap profiler */
+
+  struct mm_profile_s mm_profile;
+#endif
+
+#ifdef CONFIG_MM_KASAN
+  /* True if the regions of this heap are registered to KASan */
+
+  bool mm_kasan;
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -288,4 +396,64 @@ int mm_size2ndx(size_t size);
 void mm_foreach(FAR struct mm_heap_s *heap, mmchunk_handler_t handler,
                 FAR void *arg);
 
+#ifdef CONFIG_MM_REGION_ATTR
+/* Functions contained in mm_region.c ***************************************/
+
+unsigned int mm_region_mask(FAR struct mm_heap_s *heap, unsigned int flags);
+#endif
+
+#ifdef CONFIG_MM_HEAP_STATS
+/* Functions contained in mm_stats.c ****************************************/
+
+void mm_stats_alloc(FAR struct mm_heap_s *heap, size_t chunksize);
+void mm_stats_free(FAR struct mm_heap_s *heap, size_t chunksize);
+void mm_stats_resize(FAR struct mm_heap_s *heap, size_t oldsize,
+                     size_t newsize);
+void mm_stats_fail(FAR struct mm_heap_s *heap);
+#else
+#  define mm_stats_alloc(heap, chunksize)
+#  define mm_stats_free(heap, chunksize)
+#  define mm_stats_resize(heap, oldsize, newsize)
+#  define mm_stats_fail(heap)
+#endif
+
+/* The profiler reports through the note driver, which is only available to
+ * kernel code.
+ */
+
+#if defined(CONFIG_MM_HEAP_PROFILE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+/* Functions contained in mm_profile.c **************************************/
+
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem,
+                      size_t size);
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_profile_move(FAR struct mm_heap_s *heap, FAR void *oldmem,
+                     FAR void *newmem);
+#else
+#  define mm_profile_alloc(heap, mem, size)
+#  define mm_profile_free(heap, mem)
+#  define mm_profile_move(heap, oldmem, newmem)
+#endif
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* Functions contained in mm_free.c *****************************************/
+
+void mm_freelist(FAR struct mm_heap_s *heap,
+                 FAR struct mm_delaynode_s *list);
+
+/* Functions contained in mm_percpu.c ***************************************/
+
+FAR void *mm_percpu_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_percpu_free(FAR struct mm_heap_s *heap, FAR void *mem,
+                    FAR struct mm_delaynode_s **drain);
+size_t mm_percpu_batchsize(size_t size);
+FAR struct mm_delaynode_s *mm_percpu_split(FAR struct mm_heap_s *heap,
+                                           FAR struct mm_allocnode_s *node,
+                                           size_t size);
+void mm_percpu_fill(FAR struct mm_heap_s *heap,
+                    FAR struct mm_delaynode_s *list);
+bool mm_percpu_flush(FAR struct mm_heap_s *heap);
+#endif
+
 #endif /* __MM_MM_HEAP_MM_H */
@@ -55,45 +55,19 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_free
+ * Name: mm_freechunk
  *
  * Description:
  *   Returns a chunk of memory to the list of free nodes,  merging with
- *   adjacent free chunks if possible.
+ *   adjacent free chunks if possible.  The caller holds the semaphore.
  *
  ****************************************************************************/
 
-void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+static void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
   FAR struct mm_freenode_s *next;
-  int ret;
-
-  UNUSED(ret);
-  minfo("Freeing %p\n", mem);
-
-  /* Protect against attempts to free a NULL reference */
-
-  if (!mem)
-    {
-      return;
-    }
-
-  if (mm_takesemaphore(heap) == false)
-    {
-      /* Meet -ESRCH return, which means we are in situations
-       * during context switching(See mm_takesemaphore() & getpid()).
-       * Then add to the delay list.
-       */
-
-      mm_add_delaylist(heap, mem);
-      return;
-    }
 
   kasan_poison(mem, mm_malloc_size(mem));
 
@@ -173,6 +147,113 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a chunk of memory to the list of free nodes,  merging with
+ *   adjacent free chunks if possible.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+#ifdef CONFIG_MM_PERCPU_CACHE
+  FAR struct mm_delaynode_s *drain;
+#endif
+#ifdef CONFIG_MM_HEAP_STATS
+  size_t chunksize;
+#endif
 
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (!mem)
+    {
+      return;
+    }
+
+#ifdef CONFIG_MM_HEAP_STATS
+  chunksize = mm_malloc_size(mem) + SIZEOF_MM_ALLOCNODE;
+#endif
+
+  /* Report a sampled allocation before the memory can be reused */
+
+  mm_profile_free(heap, mem);
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Small chunks are kept in the cache of this CPU */
+
+  if (mm_percpu_free(heap, mem, &drain))
+    {
+      mm_stats_free(heap, chunksize);
+      mm_freelist(heap, drain);
+      return;
+    }
+#endif
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      /* Meet -ESRCH return, which means we are in situations
+       * during context switching(See mm_takesemaphore() & getpid()).
+       * Then add to the delay list.
+       */
+
+      mm_add_delaylist(heap, mem);
+      return;
+    }
+
+  mm_stats_free(heap, chunksize);
+  mm_freechunk(heap, mem);
   mm_givesemaphore(heap);
 }
+
+/****************************************************************************
+ * Name: mm_freelist
+ *
+ * Description:
+ *   Return a list of chunks to the heap, holding the semaphore only once.
+ *   The chunks bypass the per-CPU caches.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+void mm_freelist(FAR struct mm_heap_s *heap,
+                 FAR struct mm_delaynode_s *list)
+{
+  FAR struct mm_delaynode_s *next;
+
+  if (list == NULL)
+    {
+      return;
+    }
+
+  if (mm_takesemaphore(heap) == false)
+    {
+      while (list != NULL)
+        {
+          next = list->flink;
+          mm_add_delaylist(heap, list);
+          list = next;
+        }
+
+      return;
+    }
+
+  while (list != NULL)
+    {
+      next = list->flink;
+      mm_freechunk(heap, list);
+      list = next;
+    }
+
+  mm_givesemaphore(heap);
+}
+#endif
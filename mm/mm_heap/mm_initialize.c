@@ -90,7 +90,12 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   /* Register to KASan for access check */
 
-  kasan_register(heapstart, &heapsize);
+#ifdef CONFIG_MM_KASAN
+  if (heap->mm_kasan)
+    {
+      kasan_register(heapstart, &heapsize);
+    }
+#endif
 
   ret = mm_takesemaphore(heap);
   DEBUGASSERT(ret);
@@ -218,6 +223,10 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_KASAN
+  heap->mm_kasan = kasan_heap_enabled(name);
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
 #  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
   heap->mm_procfs.name = name;
@@ -27,6 +27,8 @@
 #include <malloc.h>
 #include <assert.h>
 #include <debug.h>
+#include <errno.h>
+#include <string.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -126,8 +128,56 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
   DEBUGASSERT(info->uordblks + info->fordblks == heap->mm_heapsize);
 
   return OK;
+#undef region
 }
 
+/****************************************************************************
+ * Name: mm_region_mallinfo
+ *
+ * Description:
+ *   Return the heap information of one region of the heap.  -EINVAL is
+ *   returned if the heap has no such region.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+int mm_region_mallinfo(FAR struct mm_heap_s *heap, int region,
+                       FAR struct mallinfo *info)
+{
+  FAR struct mm_allocnode_s *node;
+
+  DEBUGASSERT(info);
+
+  if (region < 0 || region >= heap->mm_nregions)
+    {
+      return -EINVAL;
+    }
+
+  memset(info, 0, sizeof(*info));
+
+  if (!mm_takesemaphore(heap))
+    {
+      return -EINVAL;
+    }
+
+  for (node = heap->mm_heapstart[region];
+       node < heap->mm_heapend[region];
+       node = (FAR struct mm_allocnode_s *)((FAR char *)node + node->size))
+    {
+      mallinfo_handler(node, info);
+    }
+
+  mm_givesemaphore(heap);
+
+  info->arena     = (FAR char *)heap->mm_heapend[region] -
+                    (FAR char *)heap->mm_heapstart[region] +
+                    SIZEOF_MM_ALLOCNODE;
+  info->uordblks += SIZEOF_MM_ALLOCNODE; /* account for the tail node */
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: mm_mallinfo_task
  *
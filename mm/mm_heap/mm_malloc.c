@@ -75,6 +75,87 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
 #endif
 }
 
+/****************************************************************************
+ * Name: mm_inregions
+ *
+ * Description:
+ *   Return true if the free chunk lies in one of the regions of the mask.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+static bool mm_inregions(FAR struct mm_heap_s *heap,
+                         FAR struct mm_freenode_s *node,
+                         unsigned int regions)
+{
+  int region;
+
+  if (regions == MM_REGION_ALL)
+    {
+      return true;
+    }
+
+  for (region = 0; region < heap->mm_nregions; region++)
+    {
+      if ((FAR void *)node >= (FAR void *)heap->mm_heapstart[region] &&
+          (FAR void *)node < (FAR void *)heap->mm_heapend[region])
+        {
+          return (regions & (1u << region)) != 0;
+        }
+    }
+
+  return false;
+}
+#else
+#  define mm_inregions(heap, node, regions) true
+#endif
+
+/****************************************************************************
+ * Name: mm_findchunk
+ *
+ * Description:
+ *   Find the smallest free chunk of at least 'size' bytes in the regions
+ *   of the mask.  The caller must hold the heap semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_freenode_s *mm_findchunk(FAR struct mm_heap_s *heap,
+                                              size_t size,
+                                              unsigned int regions)
+{
+  FAR struct mm_freenode_s *node;
+  int ndx;
+
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      ndx = MM_NNODES - 1;
+    }
+  else
+    {
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
+    }
+
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && (node->size < size || !mm_inregions(heap, node, regions));
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+    }
+
+  return node;
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 void mm_dump_handler(FAR struct tcb_s *tcb, FAR void *arg)
 {
@@ -88,26 +169,25 @@ void mm_dump_handler(FAR struct tcb_s *tcb, FAR void *arg)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_malloc
+ * Name: mm_malloc_regions
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *  Find the smallest chunk in the regions of the mask that satisfies the
+ *  request. Take the memory from that chunk, save the remaining, smaller
+ *  chunk (if any).
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+static FAR void *mm_malloc_regions(FAR struct mm_heap_s *heap, size_t size,
+                                   unsigned int regions)
 {
   FAR struct mm_freenode_s *node;
   size_t alignsize;
+#ifdef CONFIG_MM_PERCPU_CACHE
+  FAR struct mm_delaynode_s *batch = NULL;
+  size_t chunksize;
+#endif
   FAR void *ret = NULL;
-  int ndx;
   bool val;
 
   /* Free the delay list first */
@@ -136,37 +216,47 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
   DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
 
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  val = mm_takesemaphore(heap);
-  DEBUGASSERT(val);
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Small chunks are first looked up in the cache of this CPU, which
+   * doesn't need the heap semaphore.  The cached chunks may come from any
+   * region.
    */
 
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES - 1;
-    }
-  else
+  chunksize = alignsize;
+  if (regions == MM_REGION_ALL)
     {
-      /* Convert the request size into a nodelist index */
+      ret = mm_percpu_alloc(heap, alignsize);
+      if (ret != NULL)
+        {
+          node = (FAR struct mm_freenode_s *)
+                 ((FAR char *)ret - SIZEOF_MM_ALLOCNODE);
+          mm_stats_alloc(heap, alignsize);
+          goto out;
+        }
+
+      /* On a miss, try to take a whole batch of chunks while we hold the
+       * semaphore.
+       */
 
-      ndx = mm_size2ndx(alignsize);
+      alignsize = mm_percpu_batchsize(chunksize);
     }
+#endif
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
+  /* We need to hold the MM semaphore while we muck with the nodelist. */
 
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
+  val = mm_takesemaphore(heap);
+  DEBUGASSERT(val);
+
+  node = mm_findchunk(heap, alignsize, regions);
+#ifdef CONFIG_MM_PERCPU_CACHE
+  if (node == NULL && alignsize > chunksize)
     {
-      DEBUGASSERT(node->blink->flink == node);
+      /* There is no room for a whole batch, just get the one chunk */
+
+      alignsize = chunksize;
+      node = mm_findchunk(heap, alignsize, regions);
     }
+#endif
 
   /* If we found a node with non-zero size, then this is one to use. Since
    * the list is ordered, we know that it must be the best fitting chunk
@@ -231,16 +321,53 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       /* Handle the case of an exact size match */
 
       node->preceding |= MM_ALLOC_BIT;
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+      /* Carve the rest of the batch into chunks for the cache */
+
+      if (alignsize > chunksize)
+        {
+          batch = mm_percpu_split(heap, (FAR struct mm_allocnode_s *)node,
+                                  chunksize);
+          alignsize = chunksize;
+        }
+#endif
+
       ret = (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
+  if (ret != NULL)
+    {
+      mm_stats_alloc(heap, node->size);
+    }
+  else
+    {
+      mm_stats_fail(heap);
+    }
+
   DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
   mm_givesemaphore(heap);
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  if (batch != NULL)
+    {
+      mm_percpu_fill(heap, batch);
+    }
+  else if (ret == NULL && mm_percpu_flush(heap))
+    {
+      /* Memory was held in the cache of this CPU, try again */
+
+      return mm_malloc_regions(heap, size, regions);
+    }
+
+out:
+#endif
+
   if (ret)
     {
       MM_ADD_BACKTRACE(heap, node);
       kasan_unpoison(ret, mm_malloc_size(ret));
+      mm_profile_alloc(heap, ret, size);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
       memset(ret, 0xaa, alignsize - SIZEOF_MM_ALLOCNODE);
 #endif
@@ -273,3 +400,55 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   return ret;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  return mm_malloc_regions(heap, size, MM_REGION_ALL);
+}
+
+/****************************************************************************
+ * Name: mm_malloc_flags
+ *
+ * Description:
+ *  Allocate memory from the regions preferred by the MM_ALLOC_* flags.
+ *  Unless MM_ALLOC_NOFALLBACK is given, the allocation falls back to any
+ *  region of the heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *mm_malloc_flags(FAR struct mm_heap_s *heap, size_t size,
+                          unsigned int flags)
+{
+  unsigned int regions = mm_region_mask(heap, flags);
+  FAR void *ret = NULL;
+
+  if (regions != 0)
+    {
+      ret = mm_malloc_regions(heap, size, regions);
+    }
+
+  if (ret == NULL && regions != MM_REGION_ALL &&
+      (flags & MM_ALLOC_NOFALLBACK) == 0)
+    {
+      ret = mm_malloc_regions(heap, size, MM_REGION_ALL);
+    }
+
+  return ret;
+}
+#endif
@@ -57,6 +57,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size_t mask = (size_t)(alignment - 1);
   size_t allocsize;
   size_t newsize;
+#ifdef CONFIG_MM_HEAP_STATS
+  size_t rawsize;
+#endif
   bool ret;
 
   /* Make sure that alignment is less than half max size_t */
@@ -127,6 +130,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
    */
 
   node = (FAR struct mm_allocnode_s *)(rawchunk - SIZEOF_MM_ALLOCNODE);
+#ifdef CONFIG_MM_HEAP_STATS
+  rawsize = node->size;
+#endif
 
   /* Find the aligned subregion */
 
@@ -223,9 +229,11 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       mm_shrinkchunk(heap, node, size);
     }
 
+  mm_stats_resize(heap, rawsize, node->size);
   mm_givesemaphore(heap);
 
   MM_ADD_BACKTRACE(heap, node);
+  mm_profile_move(heap, (FAR void *)rawchunk, (FAR void *)alignedchunk);
 
   kasan_unpoison((FAR void *)alignedchunk,
                  mm_malloc_size((FAR void *)alignedchunk));
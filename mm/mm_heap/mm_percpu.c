@@ -0,0 +1,402 @@
+/****************************************************************************
+ * mm/mm_heap/mm_percpu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+#include "kasan/kasan.h"
+
+/* The per-CPU caches rely on disabling the local interrupts, which is only
+ * possible for kernel code.  User-space heaps just bypass the caches.
+ */
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#  define MM_PERCPU_ENABLED 1
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_percpu_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes from the cache of the current CPU.
+ *   The heap semaphore is not needed.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The aligned chunk size, including the chunk header
+ *
+ * Returned Value:
+ *   The user memory of the cached chunk or NULL on a cache miss.
+ *
+ ****************************************************************************/
+
+FAR void *mm_percpu_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+#ifdef MM_PERCPU_ENABLED
+  FAR struct mm_percpu_s *percpu;
+  FAR struct mm_delaynode_s *mem;
+  irqstate_t flags;
+  int ndx;
+
+  if (size > MM_PERCPU_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_PERCPU_NDX(size);
+
+  flags  = up_irq_save();
+  percpu = &heap->mm_percpu[up_cpu_index()];
+  mem    = percpu->head[ndx];
+  if (mem != NULL)
+    {
+      percpu->head[ndx] = mem->flink;
+      percpu->count[ndx]--;
+      percpu->nhits++;
+    }
+  else
+    {
+      percpu->nmisses++;
+    }
+
+  up_irq_restore(flags);
+  return mem;
+#else
+  return NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_percpu_free
+ *
+ * Description:
+ *   Put a chunk into the cache of the current CPU.  If the cache list is
+ *   already full, a batch of older chunks is removed first and returned in
+ *   'drain'; the caller must give those back to the heap with
+ *   mm_freelist().
+ *
+ * Input Parameters:
+ *   heap  - The selected heap
+ *   mem   - The user memory to be freed
+ *   drain - Location to return the chunks evicted from the cache
+ *
+ * Returned Value:
+ *   true if the chunk is now cached, false if it must be freed to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_percpu_free(FAR struct mm_heap_s *heap, FAR void *mem,
+                    FAR struct mm_delaynode_s **drain)
+{
+#ifdef MM_PERCPU_ENABLED
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_percpu_s *percpu;
+  irqstate_t flags;
+  int ndx;
+  int i;
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  if (node->size > MM_PERCPU_MAXCHUNK)
+    {
+      return false;
+    }
+
+  /* The chunk can't be reused immediately while the OS is in the middle of
+   * a context switch (e.g. it may still be the running thread's stack).
+   * Let the normal free path put it on the delay list.
+   */
+
+  if (getpid() < 0)
+    {
+      return false;
+    }
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  /* Poison the memory before the chunk becomes visible to an allocation
+   * from interrupt level.
+   */
+
+  kasan_poison(mem, mm_malloc_size(mem));
+
+  ndx   = MM_PERCPU_NDX(node->size);
+  *drain = NULL;
+
+  flags  = up_irq_save();
+  percpu = &heap->mm_percpu[up_cpu_index()];
+
+  if (percpu->count[ndx] >= CONFIG_MM_PERCPU_CACHE_DEPTH)
+    {
+      for (i = 0; i < CONFIG_MM_PERCPU_CACHE_BATCH; i++)
+        {
+          tmp               = percpu->head[ndx];
+          percpu->head[ndx] = tmp->flink;
+          tmp->flink        = *drain;
+          *drain            = tmp;
+        }
+
+      percpu->count[ndx] -= CONFIG_MM_PERCPU_CACHE_BATCH;
+      percpu->ndrains++;
+    }
+
+  tmp                = mem;
+  tmp->flink         = percpu->head[ndx];
+  percpu->head[ndx]  = tmp;
+  percpu->count[ndx]++;
+
+  up_irq_restore(flags);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_percpu_batchsize
+ *
+ * Description:
+ *   Return the size of the region to take from the heap on a cache miss
+ *   for a chunk of 'size' bytes.
+ *
+ ****************************************************************************/
+
+size_t mm_percpu_batchsize(size_t size)
+{
+#ifdef MM_PERCPU_ENABLED
+  if (size <= MM_PERCPU_MAXCHUNK)
+    {
+      return size * CONFIG_MM_PERCPU_CACHE_BATCH;
+    }
+#endif
+
+  return size;
+}
+
+/****************************************************************************
+ * Name: mm_percpu_split
+ *
+ * Description:
+ *   Split an allocated chunk obtained for a whole batch into allocated
+ *   chunks of 'size' bytes.  The first chunk stays in 'node', the others
+ *   are returned as a list to be passed to mm_percpu_fill().  The last
+ *   chunk absorbs any bytes left over.
+ *
+ * Assumptions:
+ *   The caller holds the heap semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_delaynode_s *mm_percpu_split(FAR struct mm_heap_s *heap,
+                                           FAR struct mm_allocnode_s *node,
+                                           size_t size)
+{
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_allocnode_s *prev = node;
+  FAR struct mm_allocnode_s *piece;
+  FAR struct mm_allocnode_s *next;
+  size_t total = node->size;
+  size_t chunksize;
+  size_t offset;
+
+  DEBUGASSERT(total >= 2 * size);
+
+  next       = (FAR struct mm_allocnode_s *)((FAR char *)node + total);
+  node->size = size;
+
+  for (offset = size; offset < total; offset += chunksize)
+    {
+      chunksize = total - offset < 2 * size ? total - offset : size;
+
+      piece            = (FAR struct mm_allocnode_s *)
+                         ((FAR char *)node + offset);
+      piece->size      = chunksize;
+      piece->preceding = prev->size | MM_ALLOC_BIT;
+      MM_ADD_BACKTRACE(heap, piece);
+
+      tmp        = (FAR struct mm_delaynode_s *)
+                   ((FAR char *)piece + SIZEOF_MM_ALLOCNODE);
+      tmp->flink = list;
+      list       = tmp;
+      prev       = piece;
+    }
+
+  next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
+  return list;
+}
+
+/****************************************************************************
+ * Name: mm_percpu_fill
+ *
+ * Description:
+ *   Move a list of allocated chunks into the cache of the current CPU.
+ *   Chunks that don't fit are given back to the heap.
+ *
+ ****************************************************************************/
+
+void mm_percpu_fill(FAR struct mm_heap_s *heap,
+                    FAR struct mm_delaynode_s *list)
+{
+#ifdef MM_PERCPU_ENABLED
+  FAR struct mm_delaynode_s *drain = NULL;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_percpu_s *percpu;
+  irqstate_t flags;
+  int ndx;
+
+  for (tmp = list; tmp != NULL; tmp = tmp->flink)
+    {
+      kasan_poison(tmp, mm_malloc_size(tmp));
+    }
+
+  flags  = up_irq_save();
+  percpu = &heap->mm_percpu[up_cpu_index()];
+
+  while (list != NULL)
+    {
+      tmp  = list;
+      list = list->flink;
+      node = (FAR struct mm_allocnode_s *)
+             ((FAR char *)tmp - SIZEOF_MM_ALLOCNODE);
+      ndx  = MM_PERCPU_NDX(node->size);
+
+      if (node->size <= MM_PERCPU_MAXCHUNK &&
+          percpu->count[ndx] < CONFIG_MM_PERCPU_CACHE_DEPTH)
+        {
+          tmp->flink        = percpu->head[ndx];
+          percpu->head[ndx] = tmp;
+          percpu->count[ndx]++;
+        }
+      else
+        {
+          tmp->flink = drain;
+          drain      = tmp;
+        }
+    }
+
+  up_irq_restore(flags);
+  mm_freelist(heap, drain);
+#else
+  mm_freelist(heap, list);
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_percpu_flush
+ *
+ * Description:
+ *   Give all chunks cached by the current CPU back to the heap.  This is
+ *   used when an allocation fails, before reporting the failure.
+ *
+ * Returned Value:
+ *   true if any chunk was returned to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_percpu_flush(FAR struct mm_heap_s *heap)
+{
+#ifdef MM_PERCPU_ENABLED
+  FAR struct mm_delaynode_s *drain = NULL;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_percpu_s *percpu;
+  irqstate_t flags;
+  int ndx;
+
+  flags  = up_irq_save();
+  percpu = &heap->mm_percpu[up_cpu_index()];
+
+  for (ndx = 0; ndx < MM_PERCPU_NCLASSES; ndx++)
+    {
+      while ((tmp = percpu->head[ndx]) != NULL)
+        {
+          percpu->head[ndx] = tmp->flink;
+          tmp->flink        = drain;
+          drain             = tmp;
+        }
+
+      percpu->count[ndx] = 0;
+    }
+
+  up_irq_restore(flags);
+
+  if (drain != NULL)
+    {
+      mm_freelist(heap, drain);
+      return true;
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: mm_percpu_info
+ *
+ * Description:
+ *   Return the statistics of the per-CPU caches of the selected heap.  The
+ *   values are sampled without locking and are only a snapshot.
+ *
+ ****************************************************************************/
+
+void mm_percpu_info(FAR struct mm_heap_s *heap,
+                    FAR struct mm_percpuinfo_s *info)
+{
+  FAR struct mm_percpu_s *percpu;
+  int cpu;
+  int ndx;
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      percpu         = &heap->mm_percpu[cpu];
+      info->nhits   += percpu->nhits;
+      info->nmisses += percpu->nmisses;
+      info->ndrains += percpu->ndrains;
+
+      for (ndx = 0; ndx < MM_PERCPU_NCLASSES; ndx++)
+        {
+          info->ncached    += percpu->count[ndx];
+          info->cachedsize += (size_t)percpu->count[ndx] *
+                              ((ndx + 1) << MM_MIN_SHIFT);
+        }
+    }
+}
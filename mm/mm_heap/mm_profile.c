@@ -0,0 +1,323 @@
+/****************************************************************************
+ * mm/mm_heap/mm_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <execinfo.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#  define MM_PROFILE_ENABLED 1
+#endif
+
+/* Every allocation counts its size, or one, against the sampling interval */
+
+#ifdef CONFIG_MM_HEAP_PROFILE_ALLOCS
+#  define MM_PROFILE_WEIGHT(size) 1
+#else
+#  define MM_PROFILE_WEIGHT(size) (size)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef MM_PROFILE_ENABLED
+
+/****************************************************************************
+ * Name: mm_profile_hash
+ ****************************************************************************/
+
+static inline size_t mm_profile_hash(uintptr_t addr)
+{
+  return ((addr / MM_MIN_CHUNK) * 2654435761u) % MM_PROFILE_NSLOTS;
+}
+
+/****************************************************************************
+ * Name: mm_profile_find
+ *
+ * Description:
+ *   Return the slot of the live sample of 'addr', or -1 if the allocation
+ *   was not sampled.
+ *
+ ****************************************************************************/
+
+static int mm_profile_find(FAR struct mm_profile_s *prof, uintptr_t addr)
+{
+  size_t i = mm_profile_hash(addr);
+
+  while (prof->samples[i].addr != 0)
+    {
+      if (prof->samples[i].addr == addr)
+        {
+          return i;
+        }
+
+      i = (i + 1) % MM_PROFILE_NSLOTS;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: mm_profile_insert
+ *
+ * Description:
+ *   Add a live sample, the table must have a free slot.
+ *
+ ****************************************************************************/
+
+static void mm_profile_insert(FAR struct mm_profile_s *prof, uintptr_t addr,
+                              uint32_t id, uint32_t time)
+{
+  size_t i = mm_profile_hash(addr);
+
+  while (prof->samples[i].addr != 0)
+    {
+      i = (i + 1) % MM_PROFILE_NSLOTS;
+    }
+
+  prof->samples[i].addr = addr;
+  prof->samples[i].id   = id;
+  prof->samples[i].time = time;
+  prof->nlive++;
+}
+
+/****************************************************************************
+ * Name: mm_profile_remove
+ *
+ * Description:
+ *   Remove the live sample in slot 'i'.  The following entries of the probe
+ *   sequence are shifted back so that no tombstones are needed.
+ *
+ ****************************************************************************/
+
+static void mm_profile_remove(FAR struct mm_profile_s *prof, size_t i)
+{
+  size_t j = i;
+  size_t k;
+
+  for (; ; )
+    {
+      prof->samples[i].addr = 0;
+
+      do
+        {
+          j = (j + 1) % MM_PROFILE_NSLOTS;
+          if (prof->samples[j].addr == 0)
+            {
+              prof->nlive--;
+              return;
+            }
+
+          /* Entry j may move to i only if its home slot k is not in the
+           * cyclic range (i, j].
+           */
+
+          k = mm_profile_hash(prof->samples[j].addr);
+        }
+      while (i <= j ? (i < k && k <= j) : (i < k || k <= j));
+
+      prof->samples[i] = prof->samples[j];
+      i = j;
+    }
+}
+
+#endif /* MM_PROFILE_ENABLED */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef MM_PROFILE_ENABLED
+
+/****************************************************************************
+ * Name: mm_profile_alloc
+ *
+ * Description:
+ *   Account an allocation of 'size' bytes against the sampling interval.
+ *   When the interval expires, the allocation is recorded and reported with
+ *   its backtrace through the note driver.
+ *
+ ****************************************************************************/
+
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem,
+                      size_t size)
+{
+  FAR struct mm_profile_s *prof = &heap->mm_profile;
+  struct mm_profile_alloc_s note;
+  irqstate_t flags;
+  int depth;
+
+  flags = spin_lock_irqsave(&prof->lock);
+
+  if (prof->countdown > MM_PROFILE_WEIGHT(size))
+    {
+      prof->countdown -= MM_PROFILE_WEIGHT(size);
+      spin_unlock_irqrestore(&prof->lock, flags);
+      return;
+    }
+
+  prof->countdown = CONFIG_MM_HEAP_PROFILE_INTERVAL;
+
+  if (prof->nlive >= CONFIG_MM_HEAP_PROFILE_NSAMPLES)
+    {
+      prof->ndropped++;
+      spin_unlock_irqrestore(&prof->lock, flags);
+      return;
+    }
+
+  note.id   = prof->nextid++;
+  note.size = size;
+  note.addr = (uintptr_t)mem;
+  mm_profile_insert(prof, note.addr, note.id, clock_systime_ticks());
+  prof->nsampled++;
+
+  spin_unlock_irqrestore(&prof->lock, flags);
+
+  depth = backtrace(note.backtrace, CONFIG_MM_HEAP_PROFILE_DEPTH);
+  if (depth < 0)
+    {
+      depth = 0;
+    }
+
+  SCHED_NOTE_DUMP(MM_PROFILE_NOTE_ALLOC, &note,
+                  offsetof(struct mm_profile_alloc_s, backtrace) +
+                  depth * sizeof(FAR void *));
+}
+
+/****************************************************************************
+ * Name: mm_profile_free
+ *
+ * Description:
+ *   Report the free of a sampled allocation with its lifetime.
+ *
+ ****************************************************************************/
+
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_profile_s *prof = &heap->mm_profile;
+  struct mm_profile_free_s note;
+  irqstate_t flags;
+  int i;
+
+  /* Most allocations are not sampled, don't take the lock without any
+   * live sample.
+   */
+
+  if (prof->nlive == 0)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&prof->lock);
+
+  i = mm_profile_find(prof, (uintptr_t)mem);
+  if (i < 0)
+    {
+      spin_unlock_irqrestore(&prof->lock, flags);
+      return;
+    }
+
+  note.id       = prof->samples[i].id;
+  note.lifetime = clock_systime_ticks() - prof->samples[i].time;
+  note.addr     = (uintptr_t)mem;
+  mm_profile_remove(prof, i);
+
+  spin_unlock_irqrestore(&prof->lock, flags);
+
+  SCHED_NOTE_DUMP(MM_PROFILE_NOTE_FREE, &note, sizeof(note));
+}
+
+/****************************************************************************
+ * Name: mm_profile_move
+ *
+ * Description:
+ *   Follow a sampled allocation whose address changed without a new
+ *   allocation, i.e. memalign() giving back the leading part of a chunk.
+ *   No note is generated, the free is matched by the sample number.
+ *
+ ****************************************************************************/
+
+void mm_profile_move(FAR struct mm_heap_s *heap, FAR void *oldmem,
+                     FAR void *newmem)
+{
+  FAR struct mm_profile_s *prof = &heap->mm_profile;
+  irqstate_t flags;
+  uint32_t time;
+  uint32_t id;
+  int i;
+
+  if (prof->nlive == 0 || oldmem == newmem)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&prof->lock);
+
+  i = mm_profile_find(prof, (uintptr_t)oldmem);
+  if (i >= 0)
+    {
+      id   = prof->samples[i].id;
+      time = prof->samples[i].time;
+      mm_profile_remove(prof, i);
+      mm_profile_insert(prof, (uintptr_t)newmem, id, time);
+    }
+
+  spin_unlock_irqrestore(&prof->lock, flags);
+}
+
+#endif /* MM_PROFILE_ENABLED */
+
+/****************************************************************************
+ * Name: mm_profile_info
+ *
+ * Description:
+ *   Return the state of the heap profiler.  The values are sampled without
+ *   locking and are only a snapshot.
+ *
+ ****************************************************************************/
+
+void mm_profile_info(FAR struct mm_heap_s *heap,
+                     FAR struct mm_profileinfo_s *info)
+{
+  DEBUGASSERT(info);
+
+  info->nsampled = heap->mm_profile.nsampled;
+  info->nlive    = heap->mm_profile.nlive;
+  info->ndropped = heap->mm_profile.ndropped;
+}
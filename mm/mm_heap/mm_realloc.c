@@ -132,6 +132,7 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
       /* Then return the original address */
 
+      mm_stats_resize(heap, oldsize, oldnode->size);
       mm_givesemaphore(heap);
 
       MM_ADD_BACKTRACE(heap, oldnode);
@@ -337,9 +338,11 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
             }
         }
 
+      mm_stats_resize(heap, oldsize, oldnode->size);
       mm_givesemaphore(heap);
 
       MM_ADD_BACKTRACE(heap, (FAR char *)newmem - SIZEOF_MM_ALLOCNODE);
+      mm_profile_move(heap, oldmem, newmem);
 
       kasan_unpoison(newmem, mm_malloc_size(newmem));
       if (newmem != oldmem)
@@ -0,0 +1,145 @@
+/****************************************************************************
+ * mm/mm_heap/mm_region.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The region masks have one bit per region */
+
+#if CONFIG_MM_REGIONS > 32
+#  error CONFIG_MM_REGIONS must be 32 or less with CONFIG_MM_REGION_ATTR
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_region_setattr
+ *
+ * Description:
+ *   Set the MM_REGION_* attributes of the heap region containing 'mem',
+ *   typically right after the region was added with mm_addregion().  The
+ *   regions have no attributes by default.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - Any address inside of the region
+ *   attr - The new attributes of the region
+ *
+ * Returned Value:
+ *   Zero on success, -ENOENT if 'mem' is not in a region of the heap.
+ *
+ ****************************************************************************/
+
+int mm_region_setattr(FAR struct mm_heap_s *heap, FAR void *mem,
+                      unsigned int attr)
+{
+  int region;
+
+  DEBUGASSERT(heap);
+
+  for (region = 0; region < heap->mm_nregions; region++)
+    {
+      if (mem >= (FAR void *)heap->mm_heapstart[region] &&
+          mem <= (FAR void *)heap->mm_heapend[region])
+        {
+          heap->mm_regionattr[region] = attr;
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: mm_region_getattr
+ *
+ * Description:
+ *   Return the MM_REGION_* attributes of a region, or -EINVAL if the heap
+ *   has no such region.
+ *
+ ****************************************************************************/
+
+int mm_region_getattr(FAR struct mm_heap_s *heap, int region)
+{
+  DEBUGASSERT(heap);
+
+  if (region < 0 || region >= heap->mm_nregions)
+    {
+      return -EINVAL;
+    }
+
+  return heap->mm_regionattr[region];
+}
+
+/****************************************************************************
+ * Name: mm_region_mask
+ *
+ * Description:
+ *   Return the mask of the regions preferred by the MM_ALLOC_* flags of an
+ *   allocation, MM_REGION_ALL if every region qualifies.
+ *
+ ****************************************************************************/
+
+unsigned int mm_region_mask(FAR struct mm_heap_s *heap, unsigned int flags)
+{
+  unsigned int regions = 0;
+  bool fast;
+  int region;
+
+  if ((flags & (MM_ALLOC_FAST | MM_ALLOC_SLOW)) == 0)
+    {
+      return MM_REGION_ALL;
+    }
+
+  for (region = 0; region < heap->mm_nregions; region++)
+    {
+      fast = (heap->mm_regionattr[region] & MM_REGION_FAST) != 0;
+      if ((flags & MM_ALLOC_FAST) ? fast : !fast)
+        {
+          regions |= 1u << region;
+        }
+    }
+
+  /* Don't filter the free chunks if all regions qualify */
+
+  if (regions == (heap->mm_nregions >= 32 ? ~0u :
+                  (1u << heap->mm_nregions) - 1))
+    {
+      return MM_REGION_ALL;
+    }
+
+  return regions;
+}
@@ -0,0 +1,213 @@
+/****************************************************************************
+ * mm/mm_heap/mm_stats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The counters are also updated by the per-CPU caches without the heap
+ * semaphore, so kernel code protects them with a spinlock.  User-space
+ * heaps always update them with the heap semaphore held.
+ */
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#  define mm_stats_lock(heap)         spin_lock_irqsave(&(heap)->mm_stats.lock)
+#  define mm_stats_unlock(heap, flags) \
+     spin_unlock_irqrestore(&(heap)->mm_stats.lock, flags)
+#else
+#  define mm_stats_lock(heap)         0
+#  define mm_stats_unlock(heap, flags) ((void)(flags))
+#endif
+
+static_assert(MM_NNODES <= MM_STATS_NCLASSES,
+              "Too many size classes for struct mm_statsinfo_s\n");
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_stats_alloc
+ *
+ * Description:
+ *   Account an allocated chunk of 'chunksize' bytes.
+ *
+ ****************************************************************************/
+
+void mm_stats_alloc(FAR struct mm_heap_s *heap, size_t chunksize)
+{
+  FAR struct mm_stats_s *stats = &heap->mm_stats;
+  irqstate_t flags;
+
+  flags = mm_stats_lock(heap);
+
+  stats->nmallocs++;
+  stats->nalloc[mm_size2ndx(chunksize)]++;
+  stats->usedsize += chunksize;
+  if (stats->usedsize > stats->peaksize)
+    {
+      stats->peaksize = stats->usedsize;
+    }
+
+  mm_stats_unlock(heap, flags);
+}
+
+/****************************************************************************
+ * Name: mm_stats_free
+ *
+ * Description:
+ *   Account a freed chunk of 'chunksize' bytes.
+ *
+ ****************************************************************************/
+
+void mm_stats_free(FAR struct mm_heap_s *heap, size_t chunksize)
+{
+  FAR struct mm_stats_s *stats = &heap->mm_stats;
+  irqstate_t flags;
+
+  flags = mm_stats_lock(heap);
+
+  stats->nfrees++;
+  stats->usedsize -= chunksize;
+
+  mm_stats_unlock(heap, flags);
+}
+
+/****************************************************************************
+ * Name: mm_stats_resize
+ *
+ * Description:
+ *   Account an allocated chunk resized in place by realloc or memalign.
+ *
+ ****************************************************************************/
+
+void mm_stats_resize(FAR struct mm_heap_s *heap, size_t oldsize,
+                     size_t newsize)
+{
+  FAR struct mm_stats_s *stats = &heap->mm_stats;
+  irqstate_t flags;
+
+  flags = mm_stats_lock(heap);
+
+  stats->usedsize = stats->usedsize - oldsize + newsize;
+  if (stats->usedsize > stats->peaksize)
+    {
+      stats->peaksize = stats->usedsize;
+    }
+
+  mm_stats_unlock(heap, flags);
+}
+
+/****************************************************************************
+ * Name: mm_stats_fail
+ *
+ * Description:
+ *   Account a search of the free lists that found no large enough chunk.
+ *
+ ****************************************************************************/
+
+void mm_stats_fail(FAR struct mm_heap_s *heap)
+{
+  irqstate_t flags;
+
+  flags = mm_stats_lock(heap);
+  heap->mm_stats.nfailed++;
+  mm_stats_unlock(heap, flags);
+}
+
+/****************************************************************************
+ * Name: mm_stats_info
+ *
+ * Description:
+ *   Return the allocation statistics of the selected heap and a histogram
+ *   of its free chunks per nodelist bucket.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   info - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int mm_stats_info(FAR struct mm_heap_s *heap,
+                  FAR struct mm_statsinfo_s *info)
+{
+  FAR struct mm_freenode_s *node;
+  irqstate_t flags;
+  int ndx;
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+  info->minshift = MM_MIN_SHIFT;
+  info->nclasses = MM_NNODES;
+
+  flags = mm_stats_lock(heap);
+
+  info->nmallocs = heap->mm_stats.nmallocs;
+  info->nfrees   = heap->mm_stats.nfrees;
+  info->nfailed  = heap->mm_stats.nfailed;
+  info->usedsize = heap->mm_stats.usedsize;
+  info->peaksize = heap->mm_stats.peaksize;
+  memcpy(info->nalloc, heap->mm_stats.nalloc,
+         sizeof(heap->mm_stats.nalloc));
+
+  mm_stats_unlock(heap, flags);
+
+  /* The free chunks are kept in one list ordered by size, with the
+   * zero-sized mm_nodelist[] entries as dividers.
+   */
+
+  if (!mm_takesemaphore(heap))
+    {
+      return -EBUSY;
+    }
+
+  for (node = heap->mm_nodelist[0].flink; node != NULL; node = node->flink)
+    {
+      if (node->size != 0)
+        {
+          ndx = mm_size2ndx(node->size);
+          info->nfree[ndx]++;
+          info->freesize[ndx] += node->size;
+        }
+    }
+
+  mm_givesemaphore(heap);
+  return OK;
+}
@@ -46,6 +46,15 @@
 #define SRFLAG_INUSE     (1 << 0) /* Bit 0: Region is in use */
 #define SRFLAG_UNLINKED  (1 << 1) /* Bit 1: Region perists while references */
 
+/* The large pages that up_shmat() maps with a single page table entry */
+
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+#  define SHM_LPSHIFT    CONFIG_ARCH_SHM_LARGEPAGE_SHIFT
+#  define SHM_LPSIZE     ((uintptr_t)1 << SHM_LPSHIFT)
+#  define SHM_LPMASK     (SHM_LPSIZE - 1)
+#  define SHM_LPNPAGES   (SHM_LPSIZE >> MM_PGSHIFT)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -36,6 +36,62 @@
 
 #ifdef CONFIG_MM_SHM
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: shm_valloc
+ *
+ * Description:
+ *   Set aside the virtual address space of a region.  With
+ *   CONFIG_ARCH_SHM_LARGEPAGE, the space of a region that holds a large page
+ *   is aligned like its physical pages, so that up_shmat() can map them with
+ *   a single page table entry.
+ *
+ ****************************************************************************/
+
+static uintptr_t shm_valloc(FAR struct task_group_s *group, size_t size)
+{
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+  uintptr_t vaddr;
+  uintptr_t lvaddr;
+  uintptr_t end;
+  size_t extra = SHM_LPSIZE - MM_PGSIZE;
+
+  if (size >= SHM_LPSIZE)
+    {
+      vaddr = (uintptr_t)gran_alloc(group->tg_shm.gs_handle, size + extra);
+      if (vaddr != 0)
+        {
+          /* Give the unaligned head and the tail back */
+
+          lvaddr = (vaddr + SHM_LPMASK) & ~SHM_LPMASK;
+          end    = vaddr + size + extra;
+
+          if (lvaddr > vaddr)
+            {
+              gran_free(group->tg_shm.gs_handle, (FAR void *)vaddr,
+                        lvaddr - vaddr);
+            }
+
+          if (end > lvaddr + size)
+            {
+              gran_free(group->tg_shm.gs_handle,
+                        (FAR void *)(lvaddr + size),
+                        end - lvaddr - size);
+            }
+
+          return lvaddr;
+        }
+
+      /* The large pages are mapped page by page in any other space */
+    }
+#endif
+
+  return (uintptr_t)gran_alloc(group->tg_shm.gs_handle, size);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -128,8 +184,7 @@ FAR void *shmat(int shmid, FAR const void *shmaddr, int shmflg)
 
   /* Set aside a virtual address space to span this physical region */
 
-  vaddr = (uintptr_t)gran_alloc(group->tg_shm.gs_handle,
-                                region->sr_ds.shm_segsz);
+  vaddr = shm_valloc(group, region->sr_ds.shm_segsz);
   if (vaddr == 0)
     {
       shmerr("ERROR: gran_alloc() failed\n");
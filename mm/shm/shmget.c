@@ -131,6 +131,54 @@ static int shm_reserve(key_t key, int shmflg)
   return -ENOSPC;
 }
 
+/****************************************************************************
+ * Name: shm_lpalloc
+ *
+ * Description:
+ *   Allocate one large page: SHM_LPNPAGES physically contiguous pages
+ *   aligned to SHM_LPSIZE.  The page allocator does not align its blocks,
+ *   so allocate enough pages to hold an aligned large page and give the
+ *   head and the tail back.
+ *
+ * Returned Value:
+ *   The physical address of the large page; zero if there is no block of
+ *   free pages large enough.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+static uintptr_t shm_lpalloc(void)
+{
+  unsigned int npages = 2 * SHM_LPNPAGES - 1;
+  uintptr_t paddr;
+  uintptr_t lpaddr;
+  uintptr_t lpend;
+  uintptr_t end;
+
+  paddr = mm_pgalloc(npages);
+  if (paddr == 0)
+    {
+      return 0;
+    }
+
+  lpaddr = (paddr + SHM_LPMASK) & ~SHM_LPMASK;
+  lpend  = lpaddr + SHM_LPSIZE;
+  end    = paddr + ((uintptr_t)npages << MM_PGSHIFT);
+
+  if (lpaddr > paddr)
+    {
+      mm_pgfree(paddr, (lpaddr - paddr) >> MM_PGSHIFT);
+    }
+
+  if (end > lpend)
+    {
+      mm_pgfree(lpend, (end - lpend) >> MM_PGSHIFT);
+    }
+
+  return lpaddr;
+}
+#endif
+
 /****************************************************************************
  * Name: shm_extend
  *
@@ -154,6 +202,10 @@ static int shm_extend(int shmid, size_t size)
   FAR struct shm_region_s *region =  &g_shminfo.si_region[shmid];
   unsigned int pgalloc;
   unsigned int pgneeded;
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+  uintptr_t paddr;
+  unsigned int i;
+#endif
 
   /* This is the number of pages that are needed to satisfy the allocation */
 
@@ -167,6 +219,30 @@ static int shm_extend(int shmid, size_t size)
 
   while (pgalloc < pgneeded && pgalloc < CONFIG_ARCH_SHM_NPAGES)
     {
+#ifdef CONFIG_ARCH_SHM_LARGEPAGE
+      /* Allocate a whole large page when the rest of the region spans one
+       * and the region is still large page aligned.  The list still holds
+       * each page so that the region is freed page by page as before.
+       */
+
+      if ((pgalloc & (SHM_LPNPAGES - 1)) == 0 &&
+          pgneeded - pgalloc >= SHM_LPNPAGES &&
+          CONFIG_ARCH_SHM_NPAGES - pgalloc >= SHM_LPNPAGES)
+        {
+          paddr = shm_lpalloc();
+          if (paddr != 0)
+            {
+              for (i = 0; i < SHM_LPNPAGES; i++)
+                {
+                  region->sr_pages[pgalloc++] = paddr;
+                  paddr += MM_PGSIZE;
+                }
+
+              continue;
+            }
+        }
+#endif
+
       /* Allocate one more physical page */
 
       region->sr_pages[pgalloc] = mm_pgalloc(1);
@@ -0,0 +1,1420 @@
+/****************************************************************************
+ * mm/tlsf/mm_tlsf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* This is a two-level segregated fit (TLSF) heap.  Free blocks are kept in
+ * FL x SL lists: the first level splits sizes by powers of two, the second
+ * level splits each power of two range into 2^CONFIG_MM_TLSF_SL_SHIFT
+ * linear ranges.  Two levels of bitmaps tell which lists are non-empty, so
+ * both malloc() and free() complete in a bounded number of steps that does
+ * not depend on the number of free blocks.
+ *
+ * A block found through the bitmaps is always large enough for the request
+ * (good fit instead of best fit): the request is rounded up to the start of
+ * the next second level range before the lookup.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <malloc.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <syslog.h>
+#include <unistd.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/mm/mm.h>
+
+#include "kasan/kasan.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All blocks and all user memory are aligned to TLSF_ALIGN */
+
+#if UINTPTR_MAX <= UINT32_MAX
+#  define TLSF_ALIGN_SHIFT  3
+#  define TLSF_FL_MAX       30  /* Blocks up to 1Gb */
+#  define TLSF_PTR_WIDTH    11
+#else
+#  define TLSF_ALIGN_SHIFT  4
+#  define TLSF_FL_MAX       32  /* Blocks up to 4Gb */
+#  define TLSF_PTR_WIDTH    19
+#endif
+
+#define TLSF_ALIGN          (1 << TLSF_ALIGN_SHIFT)
+#define TLSF_ALIGN_MASK     (TLSF_ALIGN - 1)
+#define TLSF_ALIGN_UP(a)    (((a) + TLSF_ALIGN_MASK) & ~TLSF_ALIGN_MASK)
+#define TLSF_ALIGN_DOWN(a)  ((a) & ~TLSF_ALIGN_MASK)
+
+/* Second level: 2^SL_SHIFT linear ranges per power of two */
+
+#define TLSF_SL_SHIFT       CONFIG_MM_TLSF_SL_SHIFT
+#define TLSF_SL_COUNT       (1 << TLSF_SL_SHIFT)
+
+/* First level: all blocks smaller than TLSF_SMALL_BLOCK go to list 0, which
+ * is split linearly in TLSF_ALIGN steps.
+ */
+
+#define TLSF_FL_SHIFT       (TLSF_SL_SHIFT + TLSF_ALIGN_SHIFT)
+#define TLSF_FL_COUNT       (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK    (1 << TLSF_FL_SHIFT)
+
+/* Bit 0 of the block size tells that the block is free */
+
+#define TLSF_FREE_BIT       0x1
+
+/* Block header and sizes */
+
+#define TLSF_HDRSIZE        TLSF_ALIGN_UP(offsetof(struct tlsf_block_s, \
+                                                   next_free))
+#define TLSF_MINBLOCK       TLSF_ALIGN_UP(sizeof(struct tlsf_block_s))
+
+#define TLSF_BLOCK(mem)     ((FAR struct tlsf_block_s *) \
+                             ((FAR char *)(mem) - TLSF_HDRSIZE))
+#define TLSF_DATA(blk)      ((FAR void *)((FAR char *)(blk) + TLSF_HDRSIZE))
+
+#if CONFIG_MM_BACKTRACE == 0
+#  define TLSF_ADD_BACKTRACE(heap, blk) \
+     do \
+       { \
+         (blk)->pid = getpid(); \
+       } \
+     while (0)
+#elif CONFIG_MM_BACKTRACE > 0
+#  define TLSF_ADD_BACKTRACE(heap, blk) \
+     do \
+       { \
+         (blk)->pid = getpid(); \
+         if ((heap)->mm_procfs.backtrace) \
+           { \
+             memset((blk)->backtrace, 0, sizeof((blk)->backtrace)); \
+             backtrace((blk)->backtrace, CONFIG_MM_BACKTRACE); \
+           } \
+         else \
+           { \
+             (blk)->backtrace[0] = 0; \
+           } \
+       } \
+     while (0)
+#else
+#  define TLSF_ADD_BACKTRACE(heap, blk)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This describes one block of the heap.  Allocated blocks only carry the
+ * header up to next_free, the free list links live in the user data.
+ */
+
+struct tlsf_block_s
+{
+#if CONFIG_MM_BACKTRACE >= 0
+  pid_t pid;                                /* The pid for caller */
+#  if CONFIG_MM_BACKTRACE > 0
+  FAR void *backtrace[CONFIG_MM_BACKTRACE]; /* The backtrace buffer for caller */
+#  endif
+#endif
+  FAR struct tlsf_block_s *prev_phys;       /* Physically preceding block */
+  size_t size;                              /* Block size and free bit */
+  FAR struct tlsf_block_s *next_free;       /* Free list links, only valid */
+  FAR struct tlsf_block_s *prev_free;       /* in free blocks */
+};
+
+struct mm_delaynode_s
+{
+  FAR struct mm_delaynode_s *flink;
+};
+
+/* This describes one heap (possibly with multiple regions) */
+
+struct mm_heap_s
+{
+  /* Mutually exclusive access to this data set is enforced with
+   * the following un-named semaphore.
+   */
+
+  sem_t mm_semaphore;
+
+  /* This is the size of the heap provided to mm */
+
+  size_t mm_heapsize;
+
+  /* This is the first block and the terminal block of each region */
+
+  FAR struct tlsf_block_s *mm_heapstart[CONFIG_MM_REGIONS];
+  FAR struct tlsf_block_s *mm_heapend[CONFIG_MM_REGIONS];
+
+#if CONFIG_MM_REGIONS > 1
+  int mm_nregions;
+#endif
+
+  /* The first level bitmap has one bit per first level index, tells if
+   * any list of that range is non-empty.  The second level bitmaps have
+   * one bit per free list.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[TLSF_FL_COUNT];
+  FAR struct tlsf_block_s *mm_blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+  /* Free delay list, for some situations where we can't do free
+   * immdiately.
+   */
+
+  FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
+
+#ifdef CONFIG_MM_KASAN
+  /* True if the regions of this heap are registered to KASan */
+
+  bool mm_kasan;
+#endif
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
+  struct procfs_meminfo_entry_s mm_procfs;
+#endif
+};
+
+/* This describes the callback for tlsf_foreach */
+
+typedef CODE void (*tlsf_handler_t)(FAR struct tlsf_block_s *blk,
+                                    FAR void *arg);
+
+struct tlsf_dumpinfo_s
+{
+  pid_t pid;
+  int   blks;
+  int   size;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tlsf_takesemaphore and tlsf_givesemaphore
+ *
+ * Description:
+ *   Take or give the heap semaphore.  This follows the same rules as the
+ *   default heap manager: in interrupt context (non-SMP) the heap may be
+ *   accessed directly if nobody holds it, and during context switches
+ *   (getpid() < 0) the caller must defer the operation.
+ *
+ ****************************************************************************/
+
+static bool tlsf_takesemaphore(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  if (up_interrupt_context())
+    {
+#if !defined(CONFIG_SMP)
+      int val;
+
+      _SEM_GETVALUE(&heap->mm_semaphore, &val);
+      return val > 0;
+#else
+      return false;
+#endif
+    }
+  else
+#endif
+
+  if (getpid() < 0)
+    {
+      return false;
+    }
+  else
+    {
+      int ret;
+
+      do
+        {
+          ret = _SEM_WAIT(&heap->mm_semaphore);
+          if (ret < 0)
+            {
+              ret = _SEM_ERRVAL(ret);
+              DEBUGASSERT(ret == -EINTR || ret == -ECANCELED);
+            }
+        }
+      while (ret < 0);
+
+      return true;
+    }
+}
+
+static void tlsf_givesemaphore(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  if (up_interrupt_context())
+    {
+      return;
+    }
+#endif
+
+  DEBUGVERIFY(_SEM_POST(&heap->mm_semaphore));
+}
+
+static void tlsf_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  FAR struct mm_delaynode_s *tmp = mem;
+  irqstate_t flags;
+
+  /* Delay the deallocation until a more appropriate time. */
+
+  flags = enter_critical_section();
+
+  tmp->flink = heap->mm_delaylist[up_cpu_index()];
+  heap->mm_delaylist[up_cpu_index()] = tmp;
+
+  leave_critical_section(flags);
+#endif
+}
+
+static void tlsf_free_delaylist(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  FAR struct mm_delaynode_s *tmp;
+  irqstate_t flags;
+
+  /* Move the delay list to local */
+
+  flags = enter_critical_section();
+
+  tmp = heap->mm_delaylist[up_cpu_index()];
+  heap->mm_delaylist[up_cpu_index()] = NULL;
+
+  leave_critical_section(flags);
+
+  while (tmp)
+    {
+      FAR void *address = tmp;
+
+      tmp = tmp->flink;
+      mm_free(heap, address);
+    }
+#endif
+}
+
+/* Block helpers */
+
+static inline size_t tlsf_size(FAR struct tlsf_block_s *blk)
+{
+  return blk->size & ~TLSF_FREE_BIT;
+}
+
+static inline bool tlsf_isfree(FAR struct tlsf_block_s *blk)
+{
+  return (blk->size & TLSF_FREE_BIT) != 0;
+}
+
+static inline FAR struct tlsf_block_s *
+tlsf_next(FAR struct tlsf_block_s *blk)
+{
+  return (FAR struct tlsf_block_s *)((FAR char *)blk + tlsf_size(blk));
+}
+
+/****************************************************************************
+ * Name: tlsf_mapping
+ *
+ * Description:
+ *   Map a block size to its first and second level index.
+ *
+ ****************************************************************************/
+
+static void tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  if (size < TLSF_SMALL_BLOCK)
+    {
+      *fl = 0;
+      *sl = size >> TLSF_ALIGN_SHIFT;
+    }
+  else
+    {
+      int msb = flsl(size) - 1;
+
+      *fl = msb - TLSF_FL_SHIFT + 1;
+      *sl = (size >> (msb - TLSF_SL_SHIFT)) ^ TLSF_SL_COUNT;
+    }
+}
+
+/****************************************************************************
+ * Name: tlsf_mapping_search
+ *
+ * Description:
+ *   Like tlsf_mapping(), but round the size up to the next list so that
+ *   every block of the resulting list can satisfy the request.
+ *
+ ****************************************************************************/
+
+static void tlsf_mapping_search(size_t size, FAR int *fl, FAR int *sl)
+{
+  if (size >= TLSF_SMALL_BLOCK)
+    {
+      size += (1ul << (flsl(size) - 1 - TLSF_SL_SHIFT)) - 1;
+    }
+
+  tlsf_mapping(size, fl, sl);
+}
+
+/****************************************************************************
+ * Name: tlsf_find
+ *
+ * Description:
+ *   Find the first non-empty list at (fl, sl) or above with two bitmap
+ *   lookups.
+ *
+ ****************************************************************************/
+
+static FAR struct tlsf_block_s *tlsf_find(FAR struct mm_heap_s *heap,
+                                          int fl, int sl)
+{
+  uint32_t map;
+
+  if (fl >= TLSF_FL_COUNT)
+    {
+      return NULL;
+    }
+
+  map = heap->mm_slbitmap[fl] & (~0u << sl);
+  if (map == 0)
+    {
+      /* Nothing in this first level range, look at the larger ones */
+
+      map = fl + 1 < TLSF_FL_COUNT ? heap->mm_flbitmap & (~0u << (fl + 1)) :
+                                     0;
+      if (map == 0)
+        {
+          return NULL;
+        }
+
+      fl  = ffs(map) - 1;
+      map = heap->mm_slbitmap[fl];
+    }
+
+  sl = ffs(map) - 1;
+  return heap->mm_blocks[fl][sl];
+}
+
+/****************************************************************************
+ * Name: tlsf_insert and tlsf_remove
+ *
+ * Description:
+ *   Add or remove a free block to/from its free list.
+ *
+ ****************************************************************************/
+
+static void tlsf_insert(FAR struct mm_heap_s *heap,
+                        FAR struct tlsf_block_s *blk)
+{
+  FAR struct tlsf_block_s *head;
+  int fl;
+  int sl;
+
+  tlsf_mapping(tlsf_size(blk), &fl, &sl);
+  DEBUGASSERT(fl < TLSF_FL_COUNT);
+
+  head           = heap->mm_blocks[fl][sl];
+  blk->next_free = head;
+  blk->prev_free = NULL;
+  if (head != NULL)
+    {
+      head->prev_free = blk;
+    }
+
+  heap->mm_blocks[fl][sl] = blk;
+  heap->mm_flbitmap      |= 1u << fl;
+  heap->mm_slbitmap[fl]  |= 1u << sl;
+}
+
+static void tlsf_remove(FAR struct mm_heap_s *heap,
+                        FAR struct tlsf_block_s *blk)
+{
+  int fl;
+  int sl;
+
+  tlsf_mapping(tlsf_size(blk), &fl, &sl);
+
+  if (blk->next_free != NULL)
+    {
+      blk->next_free->prev_free = blk->prev_free;
+    }
+
+  if (blk->prev_free != NULL)
+    {
+      blk->prev_free->next_free = blk->next_free;
+    }
+  else
+    {
+      DEBUGASSERT(heap->mm_blocks[fl][sl] == blk);
+      heap->mm_blocks[fl][sl] = blk->next_free;
+      if (blk->next_free == NULL)
+        {
+          heap->mm_slbitmap[fl] &= ~(1u << sl);
+          if (heap->mm_slbitmap[fl] == 0)
+            {
+              heap->mm_flbitmap &= ~(1u << fl);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tlsf_release
+ *
+ * Description:
+ *   Mark a block as free, merge it with its free neighbours and put the
+ *   result into the free lists.
+ *
+ ****************************************************************************/
+
+static void tlsf_release(FAR struct mm_heap_s *heap,
+                         FAR struct tlsf_block_s *blk)
+{
+  FAR struct tlsf_block_s *prev = blk->prev_phys;
+  FAR struct tlsf_block_s *next = tlsf_next(blk);
+
+  if (tlsf_isfree(next))
+    {
+      tlsf_remove(heap, next);
+      blk->size += tlsf_size(next);
+      next = tlsf_next(blk);
+      next->prev_phys = blk;
+    }
+
+  if (prev != NULL && tlsf_isfree(prev))
+    {
+      tlsf_remove(heap, prev);
+      prev->size     += tlsf_size(blk);
+      next->prev_phys = prev;
+      blk             = prev;
+    }
+
+  blk->size |= TLSF_FREE_BIT;
+  tlsf_insert(heap, blk);
+}
+
+/****************************************************************************
+ * Name: tlsf_trim
+ *
+ * Description:
+ *   Give back the tail of an allocated block beyond 'size' bytes, if the
+ *   tail is large enough to form a block of its own.
+ *
+ ****************************************************************************/
+
+static void tlsf_trim(FAR struct mm_heap_s *heap,
+                      FAR struct tlsf_block_s *blk, size_t size)
+{
+  FAR struct tlsf_block_s *rest;
+  size_t blksize = tlsf_size(blk);
+
+  if (blksize >= size + TLSF_MINBLOCK)
+    {
+      rest            = (FAR struct tlsf_block_s *)((FAR char *)blk + size);
+      rest->size      = blksize - size;
+      rest->prev_phys = blk;
+      tlsf_next(rest)->prev_phys = rest;
+      blk->size       = size;
+      tlsf_release(heap, rest);
+    }
+}
+
+/****************************************************************************
+ * Name: tlsf_adjust
+ *
+ * Description:
+ *   Convert a request size into a block size.  Returns zero on overflow.
+ *
+ ****************************************************************************/
+
+static size_t tlsf_adjust(size_t size)
+{
+  size_t blksize = TLSF_ALIGN_UP(size + TLSF_HDRSIZE);
+
+  if (blksize < size)
+    {
+      return 0;
+    }
+
+  return blksize < TLSF_MINBLOCK ? TLSF_MINBLOCK : blksize;
+}
+
+/****************************************************************************
+ * Name: tlsf_alloc
+ *
+ * Description:
+ *   Take a free block of at least 'size' bytes out of the free lists in
+ *   constant time.  The caller holds the heap semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct tlsf_block_s *tlsf_alloc(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct tlsf_block_s *blk;
+  int fl;
+  int sl;
+
+  tlsf_mapping_search(size, &fl, &sl);
+  blk = tlsf_find(heap, fl, sl);
+  if (blk != NULL)
+    {
+      DEBUGASSERT(tlsf_size(blk) >= size);
+      tlsf_remove(heap, blk);
+      blk->size &= ~TLSF_FREE_BIT;
+    }
+
+  return blk;
+}
+
+static void tlsf_foreach(FAR struct mm_heap_s *heap, tlsf_handler_t handler,
+                         FAR void *arg)
+{
+  FAR struct tlsf_block_s *blk;
+#if CONFIG_MM_REGIONS > 1
+  int nregions = heap->mm_nregions;
+#else
+  int nregions = 1;
+#endif
+  int region;
+  bool ret;
+
+  ret = tlsf_takesemaphore(heap);
+  if (!ret)
+    {
+      return;
+    }
+
+  for (region = 0; region < nregions; region++)
+    {
+      for (blk = heap->mm_heapstart[region];
+           blk < heap->mm_heapend[region];
+           blk = tlsf_next(blk))
+        {
+          handler(blk, arg);
+        }
+    }
+
+  tlsf_givesemaphore(heap);
+}
+
+static void tlsf_mallinfo_handler(FAR struct tlsf_block_s *blk,
+                                  FAR void *arg)
+{
+  FAR struct mallinfo *info = arg;
+  size_t size = tlsf_size(blk);
+
+  if (tlsf_isfree(blk))
+    {
+      info->ordblks++;
+      info->fordblks += size;
+      if (size > info->mxordblk)
+        {
+          info->mxordblk = size;
+        }
+    }
+  else
+    {
+      info->aordblks++;
+      info->uordblks += size;
+    }
+}
+
+#if CONFIG_MM_BACKTRACE >= 0
+static void tlsf_mallinfo_task_handler(FAR struct tlsf_block_s *blk,
+                                       FAR void *arg)
+{
+  FAR struct mallinfo_task *info = arg;
+
+  if (!tlsf_isfree(blk) && blk->pid == info->pid)
+    {
+      info->aordblks++;
+      info->uordblks += tlsf_size(blk);
+    }
+}
+#endif
+
+static void tlsf_memdump_handler(FAR struct tlsf_block_s *blk,
+                                 FAR void *arg)
+{
+  FAR struct tlsf_dumpinfo_s *info = arg;
+  size_t size = tlsf_size(blk);
+
+  if (!tlsf_isfree(blk))
+    {
+#if CONFIG_MM_BACKTRACE < 0
+      if (info->pid == -1)
+#else
+      if (info->pid == -1 || blk->pid == info->pid)
+#endif
+        {
+#if CONFIG_MM_BACKTRACE < 0
+          syslog(LOG_INFO, "%12zu%*p\n", size, TLSF_PTR_WIDTH,
+                 TLSF_DATA(blk));
+#else
+#  if CONFIG_MM_BACKTRACE > 0
+          int i;
+          FAR const char *format = " %0*p";
+#  endif
+          char buf[CONFIG_MM_BACKTRACE * TLSF_PTR_WIDTH + 1];
+
+          buf[0] = '\0';
+#  if CONFIG_MM_BACKTRACE > 0
+          for (i = 0; i < CONFIG_MM_BACKTRACE && blk->backtrace[i]; i++)
+            {
+              sprintf(buf + i * TLSF_PTR_WIDTH, format,
+                      TLSF_PTR_WIDTH - 1, blk->backtrace[i]);
+            }
+#  endif
+
+          syslog(LOG_INFO, "%6d%12zu%*p%s\n", (int)blk->pid, size,
+                 TLSF_PTR_WIDTH, TLSF_DATA(blk), buf);
+#endif
+          info->blks++;
+          info->size += size;
+        }
+    }
+  else if (info->pid <= -2)
+    {
+      info->blks++;
+      info->size += size;
+      syslog(LOG_INFO, "%12zu%*p\n", size, TLSF_PTR_WIDTH, TLSF_DATA(blk));
+    }
+}
+
+#ifdef CONFIG_DEBUG_MM
+static void tlsf_check_handler(FAR struct tlsf_block_s *blk, FAR void *arg)
+{
+  FAR struct tlsf_block_s *next = tlsf_next(blk);
+
+  ASSERT(tlsf_size(blk) >= TLSF_HDRSIZE);
+  ASSERT(next->prev_phys == blk);
+
+  if (tlsf_isfree(blk))
+    {
+      int fl;
+      int sl;
+
+      /* Free blocks are always fully merged and on the list of their
+       * size.
+       */
+
+      ASSERT(!tlsf_isfree(next));
+      ASSERT(blk->prev_phys == NULL || !tlsf_isfree(blk->prev_phys));
+
+      tlsf_mapping(tlsf_size(blk), &fl, &sl);
+      ASSERT(*(FAR uint32_t *)arg & (1u << fl));
+      ASSERT(blk->prev_free == NULL || blk->prev_free->next_free == blk);
+      ASSERT(blk->next_free == NULL || blk->next_free->prev_free == blk);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addregion
+ *
+ * Description:
+ *   This function adds a region of contiguous memory to the selected heap.
+ *
+ * Input Parameters:
+ *   heap      - The selected heap
+ *   heapstart - Start of the heap region
+ *   heapsize  - Size of the heap region
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
+                  size_t heapsize)
+{
+  FAR struct tlsf_block_s *blk;
+  FAR struct tlsf_block_s *end;
+  uintptr_t heapbase;
+  uintptr_t heapend;
+  bool ret;
+#if CONFIG_MM_REGIONS > 1
+  int IDX;
+
+  IDX = heap->mm_nregions;
+
+  /* Writing past CONFIG_MM_REGIONS would have catastrophic consequences */
+
+  DEBUGASSERT(IDX < CONFIG_MM_REGIONS);
+  if (IDX >= CONFIG_MM_REGIONS)
+    {
+      return;
+    }
+
+#else
+# define IDX 0
+#endif
+
+  /* Register to KASan for access check */
+
+#ifdef CONFIG_MM_KASAN
+  if (heap->mm_kasan)
+    {
+      kasan_register(heapstart, &heapsize);
+    }
+#endif
+
+  heapbase = TLSF_ALIGN_UP((uintptr_t)heapstart);
+  heapend  = TLSF_ALIGN_DOWN((uintptr_t)heapstart + heapsize);
+  DEBUGASSERT(heapend > heapbase + TLSF_MINBLOCK + TLSF_HDRSIZE);
+
+  minfo("Region %d: base=%p size=%zu\n", IDX + 1, (FAR void *)heapbase,
+        (size_t)(heapend - heapbase));
+
+  ret = tlsf_takesemaphore(heap);
+  DEBUGASSERT(ret);
+  UNUSED(ret);
+
+  heap->mm_heapsize += heapend - heapbase;
+
+  /* One free block covering the region, followed by a terminal block that
+   * looks permanently allocated so that no merge runs past the region.
+   */
+
+  blk            = (FAR struct tlsf_block_s *)heapbase;
+  end            = (FAR struct tlsf_block_s *)(heapend - TLSF_HDRSIZE);
+  blk->prev_phys = NULL;
+  blk->size      = (uintptr_t)end - heapbase;
+  end->prev_phys = blk;
+  end->size      = TLSF_HDRSIZE;
+  TLSF_ADD_BACKTRACE(heap, end);
+
+  heap->mm_heapstart[IDX] = blk;
+  heap->mm_heapend[IDX]   = end;
+
+#undef IDX
+
+#if CONFIG_MM_REGIONS > 1
+  heap->mm_nregions++;
+#endif
+
+  tlsf_release(heap, blk);
+  tlsf_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_initialize
+ *
+ * Description:
+ *   Initialize the selected heap data structures, providing the initial
+ *   heap region.
+ *
+ * Input Parameters:
+ *   name      - The heap procfs name
+ *   heapstart - Start of the initial heap region
+ *   heapsize  - Size of the initial heap region
+ *
+ * Returned Value:
+ *   Return the address of a new heap instance.
+ *
+ ****************************************************************************/
+
+FAR struct mm_heap_s *mm_initialize(FAR const char *name,
+                                    FAR void *heapstart, size_t heapsize)
+{
+  FAR struct mm_heap_s *heap;
+  uintptr_t heap_adj;
+
+  minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
+
+  /* Reserve a block space for mm_heap_s context */
+
+  heap_adj  = TLSF_ALIGN_UP((uintptr_t)heapstart);
+  heapsize -= heap_adj - (uintptr_t)heapstart;
+
+  DEBUGASSERT(heapsize > sizeof(struct mm_heap_s));
+  heap      = (FAR struct mm_heap_s *)heap_adj;
+  heapsize -= sizeof(struct mm_heap_s);
+  heapstart = (FAR char *)heap_adj + sizeof(struct mm_heap_s);
+
+  memset(heap, 0, sizeof(struct mm_heap_s));
+  _SEM_INIT(&heap->mm_semaphore, 0, 1);
+
+#ifdef CONFIG_MM_KASAN
+  heap->mm_kasan = kasan_heap_enabled(name);
+#endif
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  heap->mm_procfs.name = name;
+  heap->mm_procfs.heap = heap;
+#    ifdef CONFIG_MM_BACKTRACE_DEFAULT
+  heap->mm_procfs.backtrace = true;
+#    endif
+#  endif
+#endif
+
+  mm_addregion(heap, heapstart, heapsize);
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  procfs_register_meminfo(&heap->mm_procfs);
+#  endif
+#endif
+
+  return heap;
+}
+
+/****************************************************************************
+ * Name: mm_uninitialize
+ *
+ * Description:
+ *   Uninitialize the selected heap data structures.
+ *
+ ****************************************************************************/
+
+void mm_uninitialize(FAR struct mm_heap_s *heap)
+{
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+  procfs_unregister_meminfo(&heap->mm_procfs);
+#  endif
+#endif
+  _SEM_DESTROY(&heap->mm_semaphore);
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *   Take a free block from the first non-empty list that is guaranteed to
+ *   satisfy the request, and give back the part that is not needed.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct tlsf_block_s *blk;
+  FAR void *ret = NULL;
+  size_t blksize;
+
+  /* Free the delay list first */
+
+  tlsf_free_delaylist(heap);
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1 || (blksize = tlsf_adjust(size)) == 0)
+    {
+      return NULL;
+    }
+
+  if (!tlsf_takesemaphore(heap))
+    {
+      return NULL;
+    }
+
+  blk = tlsf_alloc(heap, blksize);
+  if (blk != NULL)
+    {
+      tlsf_trim(heap, blk, blksize);
+      ret = TLSF_DATA(blk);
+    }
+
+  tlsf_givesemaphore(heap);
+
+  if (ret != NULL)
+    {
+      TLSF_ADD_BACKTRACE(heap, blk);
+      kasan_unpoison(ret, mm_malloc_size(ret));
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(ret, 0xaa, mm_malloc_size(ret));
+#endif
+      minfo("Allocated %p, size %zu\n", ret, blksize);
+    }
+  else
+    {
+      mwarn("WARNING: Allocation failed, size %zu\n", blksize);
+#ifdef CONFIG_MM_PANIC_ON_FAILURE
+      PANIC();
+#endif
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_free
+ *
+ * Description:
+ *   Returns a block to the free lists, merging with adjacent free blocks.
+ *
+ ****************************************************************************/
+
+void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct tlsf_block_s *blk;
+
+  minfo("Freeing %p\n", mem);
+
+  /* Protect against attempts to free a NULL reference */
+
+  if (mem == NULL)
+    {
+      return;
+    }
+
+  if (!tlsf_takesemaphore(heap))
+    {
+      /* We are in the middle of a context switch, delay the free */
+
+      tlsf_add_delaylist(heap, mem);
+      return;
+    }
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+  kasan_poison(mem, mm_malloc_size(mem));
+
+  blk = TLSF_BLOCK(mem);
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(!tlsf_isfree(blk));
+
+  tlsf_release(heap, blk);
+  tlsf_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_realloc
+ *
+ * Description:
+ *   Shrink or grow an allocation in place when possible, otherwise move it
+ *   to a new block.
+ *
+ ****************************************************************************/
+
+FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
+                     size_t size)
+{
+  FAR struct tlsf_block_s *blk;
+  FAR struct tlsf_block_s *next;
+  FAR void *newmem;
+  size_t blksize;
+  size_t oldsize;
+
+  if (oldmem == NULL)
+    {
+      return mm_malloc(heap, size);
+    }
+
+  if (size < 1)
+    {
+      mm_free(heap, oldmem);
+      return NULL;
+    }
+
+  blksize = tlsf_adjust(size);
+  if (blksize == 0 || !tlsf_takesemaphore(heap))
+    {
+      return NULL;
+    }
+
+  DEBUGASSERT(mm_heapmember(heap, oldmem));
+
+  blk     = TLSF_BLOCK(oldmem);
+  oldsize = tlsf_size(blk);
+  next    = tlsf_next(blk);
+
+  if (blksize > oldsize && tlsf_isfree(next) &&
+      oldsize + tlsf_size(next) >= blksize)
+    {
+      /* Grow into the following free block */
+
+      tlsf_remove(heap, next);
+      blk->size += tlsf_size(next);
+      tlsf_next(blk)->prev_phys = blk;
+      kasan_unpoison(oldmem, tlsf_size(blk) - TLSF_HDRSIZE);
+    }
+
+  if (blksize <= tlsf_size(blk))
+    {
+      tlsf_trim(heap, blk, blksize);
+      tlsf_givesemaphore(heap);
+      return oldmem;
+    }
+
+  tlsf_givesemaphore(heap);
+
+  /* No room, move the data to a new block */
+
+  newmem = mm_malloc(heap, size);
+  if (newmem != NULL)
+    {
+      memcpy(newmem, oldmem, oldsize - TLSF_HDRSIZE);
+      mm_free(heap, oldmem);
+    }
+
+  return newmem;
+}
+
+/****************************************************************************
+ * Name: mm_calloc
+ *
+ * Descriptor:
+ *   mm_calloc() calculates the size of the allocation and calls mm_zalloc()
+ *
+ ****************************************************************************/
+
+FAR void *mm_calloc(FAR struct mm_heap_s *heap, size_t n, size_t elem_size)
+{
+  if (n > 0 && SIZE_MAX / n < elem_size)
+    {
+      return NULL;
+    }
+
+  return mm_zalloc(heap, n * elem_size);
+}
+
+/****************************************************************************
+ * Name: mm_zalloc
+ *
+ * Description:
+ *   mm_zalloc calls mm_malloc, then zeroes out the allocated chunk.
+ *
+ ****************************************************************************/
+
+FAR void *mm_zalloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR void *alloc = mm_malloc(heap, size);
+
+  if (alloc != NULL)
+    {
+      memset(alloc, 0, size);
+    }
+
+  return alloc;
+}
+
+/****************************************************************************
+ * Name: mm_memalign
+ *
+ * Description:
+ *   memalign requests more than enough space from the free lists, then
+ *   gives back the leading and trailing parts of the block.  Like
+ *   mm_malloc(), the lookup is done in constant time.
+ *
+ ****************************************************************************/
+
+FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
+                      size_t size)
+{
+  FAR struct tlsf_block_s *blk;
+  FAR struct tlsf_block_s *aligned;
+  uintptr_t mem;
+  size_t blksize;
+  size_t gap;
+
+  if (alignment <= TLSF_ALIGN)
+    {
+      return mm_malloc(heap, size);
+    }
+
+  /* The alignment must be a power of two */
+
+  if ((alignment & (alignment - 1)) != 0)
+    {
+      return NULL;
+    }
+
+  tlsf_free_delaylist(heap);
+
+  blksize = tlsf_adjust(size);
+  if (size < 1 || blksize == 0 ||
+      blksize + alignment + TLSF_MINBLOCK < blksize)
+    {
+      return NULL;
+    }
+
+  if (!tlsf_takesemaphore(heap))
+    {
+      return NULL;
+    }
+
+  blk = tlsf_alloc(heap, blksize + alignment + TLSF_MINBLOCK);
+  if (blk == NULL)
+    {
+      tlsf_givesemaphore(heap);
+      return NULL;
+    }
+
+  /* The leading gap must be either empty or a valid block */
+
+  mem = ((uintptr_t)TLSF_DATA(blk) + alignment - 1) & ~(alignment - 1);
+  gap = mem - (uintptr_t)TLSF_DATA(blk);
+  while (gap != 0 && gap < TLSF_MINBLOCK)
+    {
+      mem += alignment;
+      gap += alignment;
+    }
+
+  if (gap != 0)
+    {
+      aligned            = TLSF_BLOCK(mem);
+      aligned->size      = tlsf_size(blk) - gap;
+      aligned->prev_phys = blk;
+      tlsf_next(aligned)->prev_phys = aligned;
+      blk->size          = gap;
+      tlsf_release(heap, blk);
+      blk                = aligned;
+    }
+
+  tlsf_trim(heap, blk, blksize);
+  tlsf_givesemaphore(heap);
+
+  TLSF_ADD_BACKTRACE(heap, blk);
+  kasan_unpoison((FAR void *)mem, mm_malloc_size((FAR void *)mem));
+  return (FAR void *)mem;
+}
+
+/****************************************************************************
+ * Name: mm_malloc_size
+ ****************************************************************************/
+
+size_t mm_malloc_size(FAR void *mem)
+{
+  return tlsf_size(TLSF_BLOCK(mem)) - TLSF_HDRSIZE;
+}
+
+/****************************************************************************
+ * Name: mm_heapmember
+ *
+ * Description:
+ *   Check if an address lies in the heap.
+ *
+ ****************************************************************************/
+
+bool mm_heapmember(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+#if CONFIG_MM_REGIONS > 1
+  int nregions = heap->mm_nregions;
+#else
+  int nregions = 1;
+#endif
+  int i;
+
+  for (i = 0; i < nregions; i++)
+    {
+      if (mem > (FAR void *)heap->mm_heapstart[i] &&
+          mem < (FAR void *)heap->mm_heapend[i])
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: mm_brkaddr
+ *
+ * Description:
+ *   Return the break address of a heap region.  Zero is returned if the
+ *   memory region is not initialized.
+ *
+ ****************************************************************************/
+
+FAR void *mm_brkaddr(FAR struct mm_heap_s *heap, int region)
+{
+  uintptr_t brkaddr;
+
+#if CONFIG_MM_REGIONS > 1
+  DEBUGASSERT(heap && region < heap->mm_nregions);
+#else
+  DEBUGASSERT(heap && region == 0);
+#endif
+
+  brkaddr = (uintptr_t)heap->mm_heapend[region];
+  return brkaddr ? (FAR void *)(brkaddr + TLSF_HDRSIZE) : 0;
+}
+
+/****************************************************************************
+ * Name: mm_extend
+ *
+ * Description:
+ *   Extend a heap region by add a block of (virtually) contiguous memory
+ *   to the end of the heap.
+ *
+ ****************************************************************************/
+
+void mm_extend(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
+               int region)
+{
+  FAR struct tlsf_block_s *oldend;
+  FAR struct tlsf_block_s *newend;
+  bool ret;
+
+  DEBUGASSERT(heap && mem && size >= TLSF_MINBLOCK);
+#if CONFIG_MM_REGIONS > 1
+  DEBUGASSERT((size_t)region < (size_t)heap->mm_nregions);
+#else
+  DEBUGASSERT(region == 0);
+#endif
+
+  ret = tlsf_takesemaphore(heap);
+  DEBUGASSERT(ret);
+  UNUSED(ret);
+
+  /* The old terminal block becomes a free block that spans the new memory
+   * and a new terminal block is placed at the end.
+   */
+
+  oldend = heap->mm_heapend[region];
+  DEBUGASSERT((uintptr_t)oldend + TLSF_HDRSIZE == (uintptr_t)mem);
+
+  newend = (FAR struct tlsf_block_s *)
+           (TLSF_ALIGN_DOWN((uintptr_t)mem + size) - TLSF_HDRSIZE);
+  newend->prev_phys = oldend;
+  newend->size      = TLSF_HDRSIZE;
+  oldend->size      = (uintptr_t)newend - (uintptr_t)oldend;
+
+  heap->mm_heapsize       += (uintptr_t)newend - (uintptr_t)oldend;
+  heap->mm_heapend[region] = newend;
+
+  tlsf_release(heap, oldend);
+  tlsf_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_mallinfo
+ *
+ * Description:
+ *   mallinfo returns a copy of updated current heap information.
+ *
+ ****************************************************************************/
+
+int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
+{
+#if CONFIG_MM_REGIONS > 1
+  int region = heap->mm_nregions;
+#else
+# define region 1
+#endif
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(*info));
+  tlsf_foreach(heap, tlsf_mallinfo_handler, info);
+
+  info->arena     = heap->mm_heapsize;
+  info->uordblks += region * TLSF_HDRSIZE; /* account for the tail blocks */
+
+#undef region
+
+  return OK;
+}
+
+#if CONFIG_MM_BACKTRACE >= 0
+int mm_mallinfo_task(FAR struct mm_heap_s *heap,
+                     FAR struct mallinfo_task *info)
+{
+  DEBUGASSERT(info);
+
+  info->uordblks = 0;
+  info->aordblks = 0;
+  tlsf_foreach(heap, tlsf_mallinfo_task_handler, info);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: mm_memdump
+ *
+ * Description:
+ *   mm_memdump returns a memory info about specified pid of task/thread.
+ *   if pid equals -1, this function will dump all allocated node and output
+ *   backtrace for every allocated node for this heap, if pid equals -2, this
+ *   function will dump all free node for this heap, and if pid is greater
+ *   than or equal to 0, will dump pid allocated node and output backtrace.
+ *
+ ****************************************************************************/
+
+void mm_memdump(FAR struct mm_heap_s *heap, pid_t pid)
+{
+  struct tlsf_dumpinfo_s info;
+
+  if (pid >= -1)
+    {
+      syslog(LOG_INFO, "Dump all used memory node info:\n");
+#if CONFIG_MM_BACKTRACE < 0
+      syslog(LOG_INFO, "%12s%*s\n", "Size", TLSF_PTR_WIDTH, "Address");
+#else
+      syslog(LOG_INFO, "%6s%12s%*s %s\n", "PID", "Size", TLSF_PTR_WIDTH,
+             "Address", "Backtrace");
+#endif
+    }
+  else
+    {
+      syslog(LOG_INFO, "Dump all free memory node info:\n");
+      syslog(LOG_INFO, "%12s%*s\n", "Size", TLSF_PTR_WIDTH, "Address");
+    }
+
+  info.blks = 0;
+  info.size = 0;
+  info.pid  = pid;
+  tlsf_foreach(heap, tlsf_memdump_handler, &info);
+
+  syslog(LOG_INFO, "%12s%12s\n", "Total Blks", "Total Size");
+  syslog(LOG_INFO, "%12d%12d\n", info.blks, info.size);
+}
+
+/****************************************************************************
+ * Name: mm_checkcorruption
+ *
+ * Description:
+ *   Verify the physical block chain and the free list invariants.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM
+void mm_checkcorruption(FAR struct mm_heap_s *heap)
+{
+  tlsf_foreach(heap, tlsf_check_handler, &heap->mm_flbitmap);
+}
+#endif
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -69,6 +70,21 @@ FAR void *calloc(size_t n, size_t elem_size)
   return ret;
 
 #else
+#ifdef USR_MEMPOOL
+  /* The threshold check also assures that n * elem_size can't overflow */
+
+  if (n > 0 && elem_size > 0 &&
+      n <= CONFIG_MM_HEAP_MEMPOOL_THRESHOLD / elem_size)
+    {
+      FAR void *mem = mempool_multiple_alloc(USR_MEMPOOL, n * elem_size);
+      if (mem != NULL)
+        {
+          memset(mem, 0, n * elem_size);
+          return mem;
+        }
+    }
+#endif
+
   /* Use mm_calloc() because it implements the clear */
 
   return mm_calloc(USR_HEAP, n, elem_size);
@@ -46,5 +46,12 @@
 #undef free /* See mm/README.txt */
 void free(FAR void *mem)
 {
+#ifdef USR_MEMPOOL
+  if (mempool_multiple_free(USR_MEMPOOL, mem) >= 0)
+    {
+      return;
+    }
+#endif
+
   mm_free(USR_HEAP, mem);
 }
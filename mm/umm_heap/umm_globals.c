@@ -52,6 +52,10 @@
 FAR struct mm_heap_s *g_mmheap;
 #endif
 
+#ifdef USR_MEMPOOL
+struct mempool_multiple_s g_mmpool;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -30,6 +30,7 @@
 #include <nuttx/addrenv.h>
 #include <nuttx/userspace.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/mm/mempool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -59,6 +60,14 @@
 #  define USR_HEAP g_mmheap
 #endif
 
+/* The small allocations are served by the pools in front of the user heap
+ * only in the flat build, the pools are not accessible from user space.
+ */
+
+#if defined(CONFIG_MM_HEAP_MEMPOOL) && defined(CONFIG_BUILD_FLAT)
+#  define USR_MEMPOOL (&g_mmpool)
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -86,6 +86,12 @@ void umm_initialize(FAR void *heap_start, size_t heap_size)
 #else
   USR_HEAP = mm_initialize("Umem", heap_start, heap_size);
 #endif
+
+#ifdef USR_MEMPOOL
+  /* Small allocations go to the heap directly if that fails */
+
+  mempool_multiple_heap_init(USR_MEMPOOL, USR_HEAP, "Umem");
+#endif
 }
 
 /****************************************************************************
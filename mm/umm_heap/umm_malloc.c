@@ -57,6 +57,14 @@ FAR void *malloc(size_t size)
 
   return memalign(sizeof(FAR void *), size);
 #else
+#ifdef USR_MEMPOOL
+  FAR void *mem = mempool_multiple_alloc(USR_MEMPOOL, size);
+  if (mem != NULL)
+    {
+      return mem;
+    }
+#endif
+
   /* Use mm_malloc() because it implements the clear */
 
   return mm_malloc(USR_HEAP, size);
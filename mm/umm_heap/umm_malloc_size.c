@@ -28,6 +28,8 @@
 
 #include <nuttx/mm/mm.h>
 
+#include "umm_heap/umm_heap.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -35,5 +37,13 @@
 #undef malloc_size /* See mm/README.txt */
 size_t malloc_size(FAR void *mem)
 {
+#ifdef USR_MEMPOOL
+  ssize_t size = mempool_multiple_alloc_size(USR_MEMPOOL, mem);
+  if (size >= 0)
+    {
+      return size;
+    }
+#endif
+
   return mm_malloc_size(mem);
 }
@@ -94,6 +94,21 @@ FAR void *realloc(FAR void *oldmem, size_t size)
 
   return mem;
 #else
+#ifdef USR_MEMPOOL
+  /* A block owned by the pools is moved to the heap when it grows beyond
+   * the pools, and new small blocks are taken from the pools.
+   */
+
+  if (oldmem == NULL)
+    {
+      return malloc(size);
+    }
+  else if (mempool_multiple_alloc_size(USR_MEMPOOL, oldmem) >= 0)
+    {
+      return mempool_multiple_realloc(USR_MEMPOOL, oldmem, size);
+    }
+#endif
+
   return mm_realloc(USR_HEAP, oldmem, size);
 #endif
 }
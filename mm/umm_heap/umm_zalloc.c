@@ -64,6 +64,15 @@ FAR void *zalloc(size_t size)
   return alloc;
 
 #else
+#ifdef USR_MEMPOOL
+  FAR void *mem = mempool_multiple_alloc(USR_MEMPOOL, size);
+  if (mem != NULL)
+    {
+      memset(mem, 0, size);
+      return mem;
+    }
+#endif
+
   /* Use mm_zalloc() because it implements the clear */
 
   return mm_zalloc(USR_HEAP, size);
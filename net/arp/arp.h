@@ -303,23 +303,6 @@ void arp_notify(in_addr_t ipaddr);
 #  define arp_notify(i)
 #endif
 
-/****************************************************************************
- * Name: arp_lookup
- *
- * Description:
- *   Find the ARP entry corresponding to this IP address in the ARP table.
- *
- * Input Parameters:
- *   ipaddr - Refers to an IP address in network order
- *
- * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
- *
- ****************************************************************************/
-
-FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr);
-
 /****************************************************************************
  * Name: arp_find
  *
@@ -334,9 +317,6 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr);
  *             used simply to determine if the Ethernet MAC address is
  *             available.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 struct ether_addr;  /* Forward reference */
@@ -351,12 +331,12 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr);
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the association was removed; -ENOENT if there was none.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr);
+int arp_delete(in_addr_t ipaddr);
 
 /****************************************************************************
  * Name: arp_cleanup
@@ -367,9 +347,6 @@ void arp_delete(in_addr_t ipaddr);
  * Input Parameters:
  *   dev  - The device driver structure
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 void arp_cleanup(FAR struct net_driver_s *dev);
@@ -390,14 +367,27 @@ void arp_cleanup(FAR struct net_driver_s *dev);
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_reserve
+ *
+ * Description:
+ *   Record that the MAC address of 'ipaddr' is being asked for with an ARP
+ *   request.  A new entry is created in the incomplete state; an existing
+ *   entry is not modified.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure that sends the request
+ *   ipaddr  - The IP address as an inaddr_t
+ *
+ ****************************************************************************/
+
+void arp_reserve(FAR struct net_driver_s *dev, in_addr_t ipaddr);
+
 /****************************************************************************
  * Name: arp_hdr_update
  *
@@ -414,9 +404,6 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
@@ -437,9 +424,6 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -481,9 +465,10 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_wait(n,t) (0)
 #  define arp_notify(i)
 #  define arp_find(i,e) (-ENOSYS)
-#  define arp_delete(i)
+#  define arp_delete(i) (-ENOSYS)
 #  define arp_cleanup(d)
 #  define arp_update(d,i,m);
+#  define arp_reserve(d,i)
 #  define arp_hdr_update(d,i,m);
 #  define arp_snapshot(s,n) (0)
 #  define arp_dump(arp)
@@ -104,6 +104,10 @@ void arp_format(FAR struct net_driver_s *dev, in_addr_t ipaddr)
 
   eth->type        = HTONS(ETHTYPE_ARP);
   dev->d_len       = sizeof(struct arp_hdr_s) + ETH_HDRLEN;
+
+  /* Remember that the address is being resolved */
+
+  arp_reserve(dev, ipaddr);
 }
 
 #endif /* CONFIG_NET_ARP */
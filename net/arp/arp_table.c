@@ -47,6 +47,7 @@
 #ifdef CONFIG_NET
 
 #include <sys/ioctl.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <debug.h>
@@ -55,6 +56,7 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/mutex.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -70,7 +72,8 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
+#define ARP_MAXAGE_TICK    SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
+#define ARP_REACHABLE_TICK SEC2TICK(CONFIG_NET_ARP_REACHABLE)
 
 /****************************************************************************
  * Private Types
@@ -82,18 +85,123 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One slot of the ARP table */
+
+struct arp_table_s
+{
+  struct arp_entry_s      entry;       /* The address mapping */
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+  FAR struct arp_table_s *hnext;       /* Next entry with the same hash */
+#endif
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 /* The table of known address mappings */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_table_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+/* The used entries of g_arptable hashed by their IP address */
+
+static FAR struct arp_table_s *g_arphash[CONFIG_NET_ARP_HASH_SIZE];
+#endif
+
+/* Protects g_arptable.  The ARP table has its own lock so that it may be
+ * accessed without the network lock, e.g. by the ARP ioctl commands.  The
+ * network lock must never be taken while this lock is held.
+ */
+
+static mutex_t g_arplock = NXMUTEX_INITIALIZER;
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+/****************************************************************************
+ * Name: arp_hash
+ *
+ * Description:
+ *   Return the head of the hash chain of the IP address 'ipaddr'.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_s **arp_hash(in_addr_t ipaddr)
+{
+  uint32_t hash = (uint32_t)ipaddr * 2654435761u;
+
+  return &g_arphash[(hash >> 16) % CONFIG_NET_ARP_HASH_SIZE];
+}
+
+/****************************************************************************
+ * Name: arp_hash_remove
+ *
+ * Description:
+ *   Remove a used entry from its hash chain.
+ *
+ ****************************************************************************/
+
+static void arp_hash_remove(FAR struct arp_table_s *tabptr)
+{
+  FAR struct arp_table_s **link;
+
+  for (link = arp_hash(tabptr->entry.at_ipaddr); *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == tabptr)
+        {
+          *link = tabptr->hnext;
+          break;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_free_entry
+ *
+ * Description:
+ *   Return an entry to the unused state.
+ *
+ ****************************************************************************/
+
+static void arp_free_entry(FAR struct arp_table_s *tabptr)
+{
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+  if (tabptr->entry.at_ipaddr != 0)
+    {
+      arp_hash_remove(tabptr);
+    }
+#endif
+
+  memset(tabptr, 0, sizeof(*tabptr));
+}
+
+/****************************************************************************
+ * Name: arp_age
+ *
+ * Description:
+ *   Bring the state of a used entry up to date:  A reachable entry that
+ *   has not been confirmed for CONFIG_NET_ARP_REACHABLE seconds becomes
+ *   stale.  Return true if the entry is still valid at all.
+ *
+ ****************************************************************************/
+
+static bool arp_age(FAR struct arp_entry_s *entry, clock_t now)
+{
+  clock_t age = now - entry->at_time;
+
+  if (entry->at_state == ARP_STATE_REACHABLE && age > ARP_REACHABLE_TICK)
+    {
+      entry->at_state = ARP_STATE_STALE;
+    }
+
+  return age <= ARP_MAXAGE_TICK;
+}
+
 /****************************************************************************
  * Name: arp_match
  *
@@ -141,25 +249,55 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_rank
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return the eviction rank of an entry;  the lowest rank is replaced
+ *   first:  Unused and expired entries, then incomplete, stale and finally
+ *   reachable entries.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static int arp_rank(FAR struct arp_entry_s *entry, clock_t now)
 {
-  if (e1->at_ipaddr == 0)
+  if (entry->at_ipaddr == 0 || !arp_age(entry, now))
     {
-      return e1;
+      return 0;
     }
-  else if (e2->at_ipaddr == 0)
+
+  switch (entry->at_state)
     {
-      return e2;
+      case ARP_STATE_INCOMPLETE:
+        return 1;
+
+      case ARP_STATE_STALE:
+        return 2;
+
+      default:
+        return 3;
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+}
+
+/****************************************************************************
+ * Name: arp_return_old_entry
+ *
+ * Description:
+ *   Compare and return the entry to be replaced first.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_s *
+arp_return_old_entry(FAR struct arp_table_s *e1, FAR struct arp_table_s *e2,
+                     clock_t now)
+{
+  int rank1 = arp_rank(&e1->entry, now);
+  int rank2 = arp_rank(&e2->entry, now);
+
+  if (rank1 != rank2)
+    {
+      return rank1 < rank2 ? e1 : e2;
+    }
+  else if ((int)(e1->entry.at_time - e2->entry.at_time) <= 0)
     {
       return e1;
     }
@@ -169,6 +307,130 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
     }
 }
 
+/****************************************************************************
+ * Name: arp_search
+ *
+ * Description:
+ *   Find the used entry of this IP address in the ARP table, whatever its
+ *   state and age.
+ *
+ * Assumptions:
+ *   The caller holds g_arplock.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_s *arp_search(in_addr_t ipaddr)
+{
+  FAR struct arp_table_s *tabptr;
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+
+  for (tabptr = *arp_hash(ipaddr); tabptr != NULL; tabptr = tabptr->hnext)
+    {
+      if (net_ipv4addr_cmp(ipaddr, tabptr->entry.at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+#else
+  int i;
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+    {
+      tabptr = &g_arptable[i];
+      if (tabptr->entry.at_ipaddr != 0 &&
+          net_ipv4addr_cmp(ipaddr, tabptr->entry.at_ipaddr))
+        {
+          return tabptr;
+        }
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_lookup
+ *
+ * Description:
+ *   Find the ARP entry corresponding to this IP address in the ARP table.
+ *   Incomplete and expired entries are not returned.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Assumptions:
+ *   The caller holds g_arplock.  The return value will become unstable
+ *   when the lock is released.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
+{
+  FAR struct arp_table_s *tabptr;
+
+  tabptr = arp_search(ipaddr);
+  if (tabptr != NULL && tabptr->entry.at_state != ARP_STATE_INCOMPLETE &&
+      arp_age(&tabptr->entry, clock_systime_ticks()))
+    {
+      return &tabptr->entry;
+    }
+
+  /* Not found */
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_allocate
+ *
+ * Description:
+ *   Return the entry of 'ipaddr', or replace the entry to be evicted first
+ *   with a new entry for it.  The caller is responsible for the remaining
+ *   fields of a new entry.
+ *
+ * Assumptions:
+ *   The caller holds g_arplock.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_table_s *arp_allocate(in_addr_t ipaddr, clock_t now,
+                                            FAR bool *found)
+{
+  FAR struct arp_table_s *tabptr;
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+  FAR struct arp_table_s **head;
+#endif
+  int i;
+
+  tabptr = arp_search(ipaddr);
+  *found = tabptr != NULL;
+  if (tabptr != NULL)
+    {
+      return tabptr;
+    }
+
+  /* Not in the table: Pick the entry to replace.  This walk is only needed
+   * for addresses seen for the first time.
+   */
+
+  tabptr = &g_arptable[0];
+  for (i = 1; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+    {
+      tabptr = arp_return_old_entry(tabptr, &g_arptable[i], now);
+    }
+
+  arp_free_entry(tabptr);
+  tabptr->entry.at_ipaddr = ipaddr;
+
+#if CONFIG_NET_ARP_HASH_SIZE > 0
+  head          = arp_hash(ipaddr);
+  tabptr->hnext = *head;
+  *head         = tabptr;
+#endif
+
+  return tabptr;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -189,55 +451,71 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
-
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
-   */
-
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
-    {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
+  FAR struct arp_table_s *tabptr;
+  clock_t now = clock_systime_ticks();
+  bool found;
 
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
+  nxmutex_lock(&g_arplock);
 
-          tabptr = &g_arptable[i];
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
+  /* Find the entry of the IP address.  If there is none, the IP -> MAC
+   * address mapping replaces the entry to be evicted first.
+   */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
-    }
+  tabptr = arp_allocate(ipaddr, now, &found);
 
   /* Now, tabptr is the ARP table entry which we will fill with the new
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
-  tabptr->at_time = clock_systime_ticks();
+  memcpy(tabptr->entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  tabptr->entry.at_dev   = dev;
+  tabptr->entry.at_time  = now;
+  tabptr->entry.at_state = ARP_STATE_REACHABLE;
+
+  nxmutex_unlock(&g_arplock);
   return OK;
 }
 
+/****************************************************************************
+ * Name: arp_reserve
+ *
+ * Description:
+ *   Record that the MAC address of 'ipaddr' is being asked for with an ARP
+ *   request.  A new entry is created in the incomplete state; an existing
+ *   entry is not modified.  Incomplete entries are not used by
+ *   arp_find() and are the first ones to be replaced.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure that sends the request
+ *   ipaddr  - The IP address as an inaddr_t
+ *
+ ****************************************************************************/
+
+void arp_reserve(FAR struct net_driver_s *dev, in_addr_t ipaddr)
+{
+  FAR struct arp_table_s *tabptr;
+  clock_t now = clock_systime_ticks();
+  bool found;
+
+  nxmutex_lock(&g_arplock);
+
+  tabptr = arp_allocate(ipaddr, now, &found);
+  if (!found)
+    {
+      tabptr->entry.at_dev   = dev;
+      tabptr->entry.at_time  = now;
+      tabptr->entry.at_state = ARP_STATE_INCOMPLETE;
+    }
+
+  nxmutex_unlock(&g_arplock);
+}
+
 /****************************************************************************
  * Name: arp_hdr_update
  *
@@ -254,9 +532,6 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
@@ -269,43 +544,6 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
   arp_update(dev, ipaddr, ethaddr);
 }
 
-/****************************************************************************
- * Name: arp_lookup
- *
- * Description:
- *   Find the ARP entry corresponding to this IP address in the ARP table.
- *
- * Input Parameters:
- *   ipaddr - Refers to an IP address in network order
- *
- * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
- *
- ****************************************************************************/
-
-FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
-{
-  FAR struct arp_entry_s *tabptr;
-  int i;
-
-  /* Check if the IPv4 address is already in the ARP table. */
-
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
-    {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
-    }
-
-  /* Not found */
-
-  return NULL;
-}
-
 /****************************************************************************
  * Name: arp_find
  *
@@ -320,9 +558,6 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
  *             used simply to determine if the Ethernet MAC address is
  *             available.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
@@ -332,6 +567,8 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
   /* Check if the IPv4 address is already in the ARP table. */
 
+  nxmutex_lock(&g_arplock);
+
   tabptr = arp_lookup(ipaddr);
   if (tabptr != NULL)
     {
@@ -344,13 +581,18 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
           memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
         }
 
+      tabptr->at_hits++;
+
       /* Return success in any case meaning that a valid Ethernet MAC
        * address mapping is available for the IP address.
        */
 
+      nxmutex_unlock(&g_arplock);
       return OK;
     }
 
+  nxmutex_unlock(&g_arplock);
+
   /* No.. check if the IPv4 address is the address assigned to a local
    * Ethernet network device.  If so, return a mapping of that IP address
    * to the Ethernet MAC address assigned to the network device.
@@ -378,24 +620,31 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the association was removed; -ENOENT if there was none.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr)
+int arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_table_s *tabptr;
+  int ret = -ENOENT;
+
+  nxmutex_lock(&g_arplock);
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
+  tabptr = arp_search(ipaddr);
   if (tabptr != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Return the entry to the unused state to "delete" it */
 
-      tabptr->at_ipaddr = 0;
+      arp_free_entry(tabptr);
+      ret = OK;
     }
+
+  nxmutex_unlock(&g_arplock);
+  return ret;
 }
 
 /****************************************************************************
@@ -407,22 +656,23 @@ void arp_delete(in_addr_t ipaddr)
  * Input Parameters:
  *   dev  - The device driver structure
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
   int i;
 
+  nxmutex_lock(&g_arplock);
+
   for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
     {
-      if (dev == g_arptable[i].at_dev)
+      if (dev == g_arptable[i].entry.at_dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_free_entry(&g_arptable[i]);
         }
     }
+
+  nxmutex_unlock(&g_arplock);
 }
 
 /****************************************************************************
@@ -440,9 +690,6 @@ void arp_cleanup(FAR struct net_driver_s *dev)
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -454,21 +701,26 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
   unsigned int ncopied;
   int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-empty, non-expired entries in the ARP table, including
+   * the incomplete ones.
+   */
+
+  nxmutex_lock(&g_arplock);
 
   for (i = 0, now = clock_systime_ticks(), ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      tabptr = &g_arptable[i].entry;
+      if (tabptr->at_ipaddr != 0 && arp_age(tabptr, now))
         {
           memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
           ncopied++;
         }
     }
 
+  nxmutex_unlock(&g_arplock);
+
   /* Return the number of entries copied into the user buffer */
 
   return ncopied;
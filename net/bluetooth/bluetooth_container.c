@@ -109,7 +109,8 @@ void bluetooth_container_initialize(void)
  *
  *   This function will first attempt to allocate from the g_free_container
  *   list.  If that the list is empty, then the meta-data structure will be
- *   allocated from the dynamic memory pool.
+ *   allocated from the dynamic memory pool, unless
+ *   CONFIG_NET_BLUETOOTH_DYNAMIC_CONTAINERS is disabled.
  *
  * Input Parameters:
  *   None
@@ -142,9 +143,13 @@ FAR struct bluetooth_container_s *bluetooth_container_allocate(void)
   else
     {
       net_unlock();
+#ifdef CONFIG_NET_BLUETOOTH_DYNAMIC_CONTAINERS
       container = (FAR struct bluetooth_container_s *)
         kmm_malloc((sizeof (struct bluetooth_container_s)));
       pool     = BLUETOOTH_POOL_DYNAMIC;
+#else
+      return NULL;
+#endif
     }
 
   /* We have successfully allocated memory from some source? */
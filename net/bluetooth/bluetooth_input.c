@@ -76,6 +76,52 @@ static int bluetooth_count_frames(FAR struct bluetooth_conn_s *conn)
 }
 #endif
 
+/****************************************************************************
+ * Name: bluetooth_dequeue_frame
+ *
+ * Description:
+ *   Drop the oldest frame of the connection's RX queue and return its
+ *   container for reuse.
+ *
+ * Input Parameters:
+ *   conn   - The socket connection structure.
+ *
+ * Returned Value:
+ *   The container of the dropped frame.
+ *
+ ****************************************************************************/
+
+static FAR struct bluetooth_container_s *
+bluetooth_dequeue_frame(FAR struct bluetooth_conn_s *conn)
+{
+  FAR struct bluetooth_container_s *container;
+
+  /* Remove the container from the head of the RX input queue. */
+
+  container           = conn->bc_rxhead;
+  DEBUGASSERT(container != NULL && container->bn_iob != NULL);
+  conn->bc_rxhead     = container->bn_flink;
+  container->bn_flink = NULL;
+
+  /* Did the RX queue become empty? */
+
+  if (conn->bc_rxhead == NULL)
+    {
+      conn->bc_rxtail = NULL;
+    }
+
+#if CONFIG_NET_BLUETOOTH_BACKLOG > 0
+  DEBUGASSERT(conn->bc_backlog > 0);
+  conn->bc_backlog--;
+#endif
+
+  /* Free the IOB, but keep the container */
+
+  iob_free(container->bn_iob);
+  container->bn_iob = NULL;
+  return container;
+}
+
 /****************************************************************************
  * Name: bluetooth_queue_frame
  *
@@ -97,11 +143,36 @@ static int bluetooth_queue_frame(FAR struct bluetooth_conn_s *conn,
                                   FAR struct iob_s *frame,
                                   FAR struct bluetooth_frame_meta_s *meta)
 {
-  FAR struct bluetooth_container_s *container;
+  FAR struct bluetooth_container_s *container = NULL;
+
+#if CONFIG_NET_BLUETOOTH_BACKLOG > 0
+  /* If the connection has used up its backlog, then the new frame takes
+   * the container of the oldest frame, which is dropped.  A connection
+   * thus never holds more than CONFIG_NET_BLUETOOTH_BACKLOG containers of
+   * the shared pool.
+   */
 
-  /* Allocate a container for the frame */
+  if (conn->bc_backlog >= CONFIG_NET_BLUETOOTH_BACKLOG)
+    {
+      DEBUGASSERT(conn->bc_backlog == CONFIG_NET_BLUETOOTH_BACKLOG);
+      container = bluetooth_dequeue_frame(conn);
+    }
+  else
+#endif
+    {
+      /* Allocate a container for the frame */
+
+      container = bluetooth_container_allocate();
+      if (container == NULL && conn->bc_rxhead != NULL)
+        {
+          /* No container is left:  Drop the oldest frame of this
+           * connection rather than the new one.
+           */
+
+          container = bluetooth_dequeue_frame(conn);
+        }
+    }
 
-  container = bluetooth_container_allocate();
   if (container == NULL)
     {
       nerr("ERROR: Failed to allocate a container\n");
@@ -132,42 +203,9 @@ static int bluetooth_queue_frame(FAR struct bluetooth_conn_s *conn,
   conn->bc_rxtail = container;
 
 #if CONFIG_NET_BLUETOOTH_BACKLOG > 0
-  /* If incrementing the count would exceed the maximum bc_backlog value,
-   * then delete the oldest frame from the head of the RX queue.
-   */
-
-  if (conn->bc_backlog >= CONFIG_NET_BLUETOOTH_BACKLOG)
-    {
-      DEBUGASSERT(conn->bc_backlog == CONFIG_NET_BLUETOOTH_BACKLOG);
-
-      /* Remove the container from the tail RX input queue. */
-
-      container           = conn->bc_rxhead;
-      DEBUGASSERT(container != NULL);
-      conn->bc_rxhead     = container->bn_flink;
-      container->bn_flink = NULL;
-
-      /* Did the RX queue become empty? */
-
-      if (conn->bc_rxhead == NULL)
-        {
-          conn->bc_rxtail = NULL;
-        }
-
-      DEBUGASSERT(container != NULL && container->bn_iob != NULL);
-
-      /* Free both the IOB and the container */
-
-      iob_free(container->bn_iob);
-      bluetooth_container_free(container);
-    }
-  else
-    {
-      /* Increment the count of frames in the queue. */
-
-      conn->bc_backlog++;
-    }
+  /* Increment the count of frames in the queue. */
 
+  conn->bc_backlog++;
   DEBUGASSERT((int)conn->bc_backlog == bluetooth_count_frames(conn));
 #endif
 
@@ -164,6 +164,13 @@ static ssize_t
       /* Copy the new packet data into the user buffer */
 
       copylen = iob->io_len - iob->io_offset;
+      if (copylen > pstate->ir_buflen)
+        {
+          /* Truncate the frame to the size of the user buffer */
+
+          copylen = pstate->ir_buflen;
+        }
+
       memcpy(pstate->ir_buffer, &iob->io_data[iob->io_offset], copylen);
 
       ninfo("Received %d bytes\n", (int)copylen);
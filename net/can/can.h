@@ -107,6 +107,9 @@ struct can_conn_s
 #endif
   struct can_filter filters[CONFIG_NET_CAN_RAW_FILTER_MAX];
   int32_t filter_count;
+# ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+  int32_t hwfilter_count;            /* Filters pushed to the controller */
+# endif
 # ifdef CONFIG_NET_CAN_RAW_TX_DEADLINE
   int32_t tx_deadline;
 # endif
@@ -403,6 +406,63 @@ int can_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len);
 #endif
 
+/****************************************************************************
+ * Name: can_hwfilter_offload
+ *
+ * Description:
+ *   Push the CAN_RAW_FILTER filters of a connection down to the acceptance
+ *   filters of its device, so that the frames matching none are dropped by
+ *   the controller.  This is only possible for a connection bound to a
+ *   device that no other connection receives from, and only if all of its
+ *   filters can be expressed by the controller.  Otherwise, or if the
+ *   driver rejects a filter, the frames are filtered in software only.
+ *   The software filters always apply, the hardware filters only reduce
+ *   the load.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+void can_hwfilter_offload(FAR struct can_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: can_hwfilter_release
+ *
+ * Description:
+ *   Remove the acceptance filters that can_hwfilter_offload() added for a
+ *   connection.  The filters are removed with the same arguments as they
+ *   were added; this must precede any change of the filters of the
+ *   connection, of its device, and its close.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+void can_hwfilter_release(FAR struct can_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: can_hwfilter_unshare
+ *
+ * Description:
+ *   Remove the acceptance filters of the other connections that receive
+ *   from the device of 'conn' (from all devices if 'conn' is not bound),
+ *   since these filters would hide frames from 'conn'.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection that starts receiving
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+void can_hwfilter_unshare(FAR struct can_conn_s *conn);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
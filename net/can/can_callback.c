@@ -130,7 +130,18 @@ uint16_t can_callback(FAR struct net_driver_s *dev,
           struct timeval *tv = (struct timeval *)
                                                 &dev->d_appdata[dev->d_len];
           dev->d_len += sizeof(struct timeval);
-          clock_systime_timespec(ts);
+
+          /* Prefer the time stamp of the controller */
+
+          if (dev->d_rxtime.tv_sec != 0 || dev->d_rxtime.tv_nsec != 0)
+            {
+              *ts = dev->d_rxtime;
+            }
+          else
+            {
+              clock_systime_timespec(ts);
+            }
+
           tv->tv_usec = ts->tv_nsec / 1000;
         }
 #endif
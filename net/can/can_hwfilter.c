@@ -0,0 +1,246 @@
+/****************************************************************************
+ * net/can/can_hwfilter.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <net/if.h>
+#include <netpacket/can.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ioctl.h>
+
+#include "can/can.h"
+
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_hwfilter_convert
+ *
+ * Description:
+ *   Convert a CAN_RAW_FILTER filter to a controller acceptance filter.
+ *   Only the filters that select one frame format can be converted:  The
+ *   controllers filter the standard and the extended IDs separately.
+ *
+ * Returned Value:
+ *   The SIOCACAN*FILTER command to add the filter; zero if the filter
+ *   cannot be offloaded.
+ *
+ ****************************************************************************/
+
+static int can_hwfilter_convert(FAR const struct can_filter *filter,
+                                FAR struct can_ioctl_filter_s *hwfilter)
+{
+  if ((filter->can_id & CAN_INV_FILTER) != 0 ||
+      (filter->can_mask & CAN_EFF_FLAG) == 0)
+    {
+      return 0;
+    }
+
+  memset(hwfilter, 0, sizeof(struct can_ioctl_filter_s));
+  hwfilter->ftype = CAN_FILTER_MASK;
+  hwfilter->fprio = CAN_MSGPRIO_LOW;
+
+  if ((filter->can_id & CAN_EFF_FLAG) != 0)
+    {
+      hwfilter->fid1 = filter->can_id & CAN_EFF_MASK;
+      hwfilter->fid2 = filter->can_mask & CAN_EFF_MASK;
+      return SIOCACANEXTFILTER;
+    }
+
+  hwfilter->fid1 = filter->can_id & CAN_SFF_MASK;
+  hwfilter->fid2 = filter->can_mask & CAN_SFF_MASK;
+  return SIOCACANSTDFILTER;
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_shared
+ *
+ * Description:
+ *   Return true if a connection other than 'conn' receives the frames of
+ *   'dev'.  An unbound connection receives the frames of all devices.
+ *
+ ****************************************************************************/
+
+static bool can_hwfilter_shared(FAR struct can_conn_s *conn,
+                                FAR struct net_driver_s *dev)
+{
+  FAR struct can_conn_s *other = NULL;
+
+  while ((other = can_nextconn(other)) != NULL)
+    {
+      if (other != conn && (other->dev == NULL || other->dev == dev))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_hwfilter_offload
+ *
+ * Description:
+ *   Push the CAN_RAW_FILTER filters of a connection down to the acceptance
+ *   filters of its device, so that the frames matching none are dropped by
+ *   the controller.  This is only possible for a connection bound to a
+ *   device that no other connection receives from, and only if all of its
+ *   filters can be expressed by the controller.  Otherwise, or if the
+ *   driver rejects a filter, the frames are filtered in software only.
+ *   The software filters always apply, the hardware filters only reduce
+ *   the load.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *
+ ****************************************************************************/
+
+void can_hwfilter_offload(FAR struct can_conn_s *conn)
+{
+  FAR struct net_driver_s *dev;
+  struct can_ioctl_filter_s hwfilter;
+  int i;
+
+  DEBUGASSERT(conn != NULL && conn->hwfilter_count == 0);
+
+  net_lock();
+
+  dev = conn->dev;
+  if (dev == NULL || dev->d_ioctl == NULL || conn->filter_count <= 0 ||
+      can_hwfilter_shared(conn, dev))
+    {
+      goto out;
+    }
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      if (can_hwfilter_convert(&conn->filters[i], &hwfilter) == 0)
+        {
+          goto out;
+        }
+    }
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      int cmd = can_hwfilter_convert(&conn->filters[i], &hwfilter);
+
+      if (dev->d_ioctl(dev, cmd, (unsigned long)(uintptr_t)&hwfilter) < 0)
+        {
+          /* Do not leave a partial set of filters in the controller */
+
+          nwarn("WARNING: Filter offload failed on %s\n", dev->d_ifname);
+          can_hwfilter_release(conn);
+          break;
+        }
+
+      conn->hwfilter_count++;
+    }
+
+out:
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_release
+ *
+ * Description:
+ *   Remove the acceptance filters that can_hwfilter_offload() added for a
+ *   connection.  The filters are removed with the same arguments as they
+ *   were added; this must precede any change of the filters of the
+ *   connection, of its device, and its close.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *
+ ****************************************************************************/
+
+void can_hwfilter_release(FAR struct can_conn_s *conn)
+{
+  FAR struct net_driver_s *dev;
+  struct can_ioctl_filter_s hwfilter;
+  int cmd;
+  int i;
+
+  DEBUGASSERT(conn != NULL);
+
+  net_lock();
+
+  dev = conn->dev;
+  for (i = 0; i < conn->hwfilter_count; i++)
+    {
+      cmd = can_hwfilter_convert(&conn->filters[i], &hwfilter);
+      dev->d_ioctl(dev, cmd == SIOCACANEXTFILTER ?
+                   SIOCDCANEXTFILTER : SIOCDCANSTDFILTER,
+                   (unsigned long)(uintptr_t)&hwfilter);
+    }
+
+  conn->hwfilter_count = 0;
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: can_hwfilter_unshare
+ *
+ * Description:
+ *   Remove the acceptance filters of the other connections that receive
+ *   from the device of 'conn' (from all devices if 'conn' is not bound),
+ *   since these filters would hide frames from 'conn'.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection that starts receiving
+ *
+ ****************************************************************************/
+
+void can_hwfilter_unshare(FAR struct can_conn_s *conn)
+{
+  FAR struct can_conn_s *other = NULL;
+
+  net_lock();
+
+  while ((other = can_nextconn(other)) != NULL)
+    {
+      if (other != conn && other->hwfilter_count > 0 &&
+          (conn->dev == NULL || other->dev == conn->dev))
+        {
+          can_hwfilter_release(other);
+        }
+    }
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_CAN_RAW_FILTER_OFFLOAD */
@@ -26,6 +26,7 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
+#include <stdbool.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -127,6 +128,49 @@ const uint8_t len_to_can_dlc[65] =
     15,
 };
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_recv_filter
+ *
+ * Description:
+ *   Return true if the frame with the CAN ID 'id' passes one of the
+ *   CAN_RAW_FILTER filters of the connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+static bool can_recv_filter(FAR struct can_conn_s *conn, canid_t id)
+{
+  int32_t i;
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      if (conn->filters[i].can_id & CAN_INV_FILTER)
+        {
+          if ((id & conn->filters[i].can_mask) !=
+                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
+                conn->filters[i].can_mask))
+            {
+              return true;
+            }
+        }
+      else
+        {
+          if ((id & conn->filters[i].can_mask) ==
+                (conn->filters[i].can_id & conn->filters[i].can_mask))
+            {
+              return true;
+            }
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -165,6 +209,18 @@ int can_input(struct net_driver_s *dev)
         {
           uint16_t flags;
 
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+          /* Check the receive filters before the frame is copied to the
+           * read-ahead buffers of the connection.
+           */
+
+          if (!can_recv_filter(conn,
+                               ((FAR struct can_frame *)dev->d_buf)->can_id))
+            {
+              continue;
+            }
+#endif
+
           /* Setup for the application callback */
 
           dev->d_appdata = dev->d_buf;
@@ -194,6 +250,13 @@ int can_input(struct net_driver_s *dev)
     }
   while (conn);
 
+#ifdef CONFIG_NET_TIMESTAMP
+  /* The time stamp of the controller belongs to this frame only */
+
+  dev->d_rxtime.tv_sec  = 0;
+  dev->d_rxtime.tv_nsec = 0;
+#endif
+
   return ret;
 }
 
@@ -92,6 +92,9 @@ int can_setsockopt(FAR struct socket *psock, int option,
       case CAN_RAW_FILTER:
         if (value_len == 0)
           {
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+            can_hwfilter_release(conn);
+#endif
             conn->filter_count = 0;
             ret = OK;
           }
@@ -106,6 +109,10 @@ int can_setsockopt(FAR struct socket *psock, int option,
           }
         else
           {
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+            can_hwfilter_release(conn);
+#endif
+
         count = value_len / sizeof(struct can_filter);
 
         for (int i = 0; i < count; i++)
@@ -115,6 +122,10 @@ int can_setsockopt(FAR struct socket *psock, int option,
 
         conn->filter_count = count;
 
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+            can_hwfilter_offload(conn);
+#endif
+
             ret = OK;
           }
         break;
@@ -38,6 +38,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/net/net.h>
+#include <nuttx/fs/fs.h>
 
 #include "can/can.h"
 #include "netdev/netdev.h"
@@ -151,7 +152,7 @@ static uint16_t can_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -229,6 +230,12 @@ static int can_setup(FAR struct socket *psock, int protocol)
 
       conn->crefs = 1;
 
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+      /* Until bound, the socket receives from all devices */
+
+      can_hwfilter_unshare(conn);
+#endif
+
       /* Attach the connection instance to the socket */
 
       psock->s_conn = conn;
@@ -329,6 +336,12 @@ static int can_bind(FAR struct socket *psock,
   canaddr = (FAR struct sockaddr_can *)addr;
   conn    = (FAR struct can_conn_s *)psock->s_conn;
 
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+  /* The acceptance filters of the previous device no longer apply */
+
+  can_hwfilter_release(conn);
+#endif
+
   /* Bind CAN device to socket */
 
 #ifdef CONFIG_NETDEV_IFINDEX
@@ -339,6 +352,15 @@ static int can_bind(FAR struct socket *psock,
   conn->dev = netdev_findbyname((const char *)&netdev_name);
 #endif
 
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+  /* Share the device with the other sockets, or filter in the controller
+   * if this socket is its only receiver.
+   */
+
+  can_hwfilter_unshare(conn);
+  can_hwfilter_offload(conn);
+#endif
+
   return OK;
 }
 
@@ -618,7 +640,7 @@ static int can_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
         {
           /* Yes.. then signal the poll logic */
 
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
 
 errout_with_lock:
@@ -682,6 +704,9 @@ static int can_close(FAR struct socket *psock)
 
       /* Free the connection structure */
 
+#ifdef CONFIG_NET_CAN_RAW_FILTER_OFFLOAD
+      can_hwfilter_release(conn);
+#endif
       conn->crefs = 0;
       can_free(psock->s_conn);
 
@@ -55,10 +55,28 @@
 void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
                     unsigned int len, unsigned int offset)
 {
-  if (dev == NULL || len == 0 || len >= NETDEV_PKTSIZE(dev))
+  unsigned int maxlen;
+
+  if (dev == NULL)
+    {
+      nerr("devif_iob_send error, no device\n");
+      return;
+    }
+
+  maxlen = NETDEV_PKTSIZE(dev);
+#ifdef CONFIG_NETDEV_TSO
+  /* d_buf of a TSO capable device holds d_tsomax bytes of payload */
+
+  if (dev->d_tsomax >= maxlen)
+    {
+      maxlen = dev->d_tsomax + 1;
+    }
+#endif
+
+  if (len == 0 || len >= maxlen)
     {
       nerr("devif_iob_send error, %p, send len: %u, pkt len: %u\n",
-                                          dev, len, NETDEV_PKTSIZE(dev));
+                                          dev, len, maxlen);
       return;
     }
 
@@ -85,11 +85,25 @@ static bool is_loopback(FAR struct net_driver_s *dev)
 
 int devif_loopback(FAR struct net_driver_s *dev)
 {
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  uint8_t csumoff;
+#endif
+
   if (!is_loopback(dev))
     {
       return 0;
     }
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  /* The looped back packets never reach the wire:  Neither verify the
+   * checksums, which may have been left to the hardware of the device, nor
+   * compute those of the replies.
+   */
+
+  csumoff = dev->d_csumoff;
+  dev->d_csumoff = NETDEV_CSUM_LOOPBACK;
+#endif
+
   /* Loop while if there is data "sent" to ourself.
    * Sending, of course, just means relaying back through the network.
    */
@@ -142,5 +156,9 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_CSUM_OFFLOAD
+  dev->d_csumoff = csumoff;
+#endif
+
   return 1;
 }
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/clock.h>
@@ -44,9 +45,26 @@
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
 #include "mld/mld.h"
+#include "neighbor/neighbor.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Poll the connections of all queues */
+
+#define DEVIF_ALLQUEUES -1
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+#  define TCP_DOMAIN(conn) ((conn)->domain)
+#elif defined(CONFIG_NET_IPv4)
+#  define TCP_DOMAIN(conn) PF_INET
+#else
+#  define TCP_DOMAIN(conn) PF_INET6
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -520,6 +538,64 @@ static inline int devif_poll_mld(FAR struct net_driver_s *dev,
 }
 #endif /* CONFIG_NET_MLD */
 
+/****************************************************************************
+ * Name: devif_conn_inqueue
+ *
+ * Description:
+ *   Return true if the flow of a TCP or UDP connection maps to TX queue
+ *   'queue' of the device, or if 'queue' is DEVIF_ALLQUEUES.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_MULTIQUEUE) && \
+    (defined(NET_TCP_HAVE_STACK) || defined(NET_UDP_HAVE_STACK))
+static bool devif_conn_inqueue(FAR struct net_driver_s *dev, int queue,
+                               uint8_t domain,
+                               FAR const union ip_binding_u *u,
+                               uint16_t lport, uint16_t rport)
+{
+  FAR const void *raddr;
+  size_t addrlen;
+
+  if (queue == DEVIF_ALLQUEUES || dev->d_nqueues <= 1)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET)
+#endif
+    {
+      raddr   = &u->ipv4.raddr;
+      addrlen = sizeof(in_addr_t);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else if (ip6_is_ipv4addr((FAR struct in6_addr *)u->ipv6.raddr))
+    {
+      /* Sent as IPv4 packets */
+
+      raddr   = &u->ipv6.raddr[6];
+      addrlen = sizeof(in_addr_t);
+    }
+  else
+#endif
+    {
+      raddr   = u->ipv6.raddr;
+      addrlen = sizeof(net_ipv6addr_t);
+    }
+#endif
+
+  return netdev_flowqueue(dev, netdev_flowhash(raddr, addrlen,
+                                               lport, rport)) == queue;
+}
+#else
+#  define devif_conn_inqueue(dev, queue, domain, u, lport, rport) (true)
+#endif
+
 /****************************************************************************
  * Name: devif_poll_udp_connections
  *
@@ -534,6 +610,7 @@ static inline int devif_poll_mld(FAR struct net_driver_s *dev,
 
 #ifdef NET_UDP_HAVE_STACK
 static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
+                                      int queue,
                                       devif_poll_callback_t callback)
 {
   FAR struct udp_conn_s *conn = NULL;
@@ -548,8 +625,16 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
       /* Skip UDP connections that are bound to other polling devices */
 
-      if (dev == conn->dev)
+      if (dev != conn->dev)
+        {
+          continue;
+        }
 #endif
+
+      /* Skip UDP connections that belong to other queues */
+
+      if (devif_conn_inqueue(dev, queue, conn->domain, &conn->u,
+                             conn->lport, conn->rport))
         {
           /* Perform the UDP TX poll */
 
@@ -567,6 +652,8 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 
   return bstop;
 }
+#else
+#  define devif_poll_udp_connections(dev, queue, callback) (0)
 #endif /* NET_UDP_HAVE_STACK */
 
 /****************************************************************************
@@ -583,69 +670,67 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 
 #ifdef NET_TCP_HAVE_STACK
 static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
+                                             int queue,
                                              devif_poll_callback_t callback)
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
+  int burst;
+  bool data;
 
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
-      /* Skip TCP connections that are bound to other polling devices */
+      /* Skip TCP connections that are bound to other polling devices or
+       * that belong to other queues.
+       */
 
-      if (dev == conn->dev)
+      if (dev == conn->dev &&
+          devif_conn_inqueue(dev, queue, TCP_DOMAIN(conn), &conn->u,
+                             conn->lport, conn->rport))
         {
-          /* Perform the TCP TX poll */
+          /* Poll the connection again while it sends data and the driver
+           * accepts more packets.
+           */
 
-          tcp_poll(dev, conn);
+          burst = CONFIG_NET_TCP_POLL_BURST;
+          do
+            {
+              /* Perform the TCP TX poll */
 
-          /* Perform any necessary conversions on outgoing packets */
+              tcp_poll(dev, conn);
+              data = dev->d_sndlen > 0;
 
-          devif_packet_conversion(dev, DEVIF_TCP);
+              /* Perform any necessary conversions on outgoing packets */
 
-          /* Call back into the driver */
+              devif_packet_conversion(dev, DEVIF_TCP);
 
-          bstop = callback(dev);
+              /* Call back into the driver */
+
+              bstop = callback(dev);
+            }
+          while (!bstop && data && --burst > 0);
         }
     }
 
   return bstop;
 }
 #else
-# define devif_poll_tcp_connections(dev, callback) (0)
+#  define devif_poll_tcp_connections(dev, queue, callback) (0)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: devif_poll
+ * Name: devif_poll_all
  *
  * Description:
- *   This function will traverse each active network connection structure and
- *   will perform network polling operations. devif_poll() may be called
- *   asynchronously with the network driver can accept another outgoing
- *   packet.
- *
- *   This function will call the provided callback function for every active
- *   connection. Polling will continue until all connections have been polled
- *   or until the user-supplied function returns a non-zero value (which it
- *   should do only if it cannot accept further write data).
- *
- *   When the callback function is called, there may be an outbound packet
- *   waiting for service in the device packet buffer, and if so the d_len
- *   field is set to a value larger than zero. The device driver should then
- *   send out the packet.
- *
- * Assumptions:
- *   This function is called from the MAC device driver with the network
- *   locked.
+ *   Perform all of the polling operations.  The TCP and UDP connections are
+ *   limited to those of 'queue', or all if 'queue' is DEVIF_ALLQUEUES.
  *
  ****************************************************************************/
 
-int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
+static int devif_poll_all(FAR struct net_driver_s *dev, int queue,
+                          devif_poll_callback_t callback)
 {
   int bstop = false;
 
@@ -659,6 +744,15 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   bstop = arp_poll(dev, callback);
   if (!bstop)
 #endif
+#ifdef CONFIG_NET_ICMPv6
+    {
+      /* Check for pending Neighbor Unreachability Detection probes */
+
+      bstop = neighbor_poll(dev, callback);
+    }
+
+  if (!bstop)
+#endif
 #ifdef CONFIG_NET_PKT
     {
       /* Check for pending packet socket transfer */
@@ -719,7 +813,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
        * action.
        */
 
-      bstop = devif_poll_tcp_connections(dev, callback);
+      bstop = devif_poll_tcp_connections(dev, queue, callback);
     }
 
   if (!bstop)
@@ -730,7 +824,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
        * the poll action
        */
 
-      bstop = devif_poll_udp_connections(dev, callback);
+      bstop = devif_poll_udp_connections(dev, queue, callback);
     }
 
   if (!bstop)
@@ -771,4 +865,75 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   return bstop;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_poll
+ *
+ * Description:
+ *   This function will traverse each active network connection structure and
+ *   will perform network polling operations. devif_poll() may be called
+ *   asynchronously with the network driver can accept another outgoing
+ *   packet.
+ *
+ *   This function will call the provided callback function for every active
+ *   connection. Polling will continue until all connections have been polled
+ *   or until the user-supplied function returns a non-zero value (which it
+ *   should do only if it cannot accept further write data).
+ *
+ *   When the callback function is called, there may be an outbound packet
+ *   waiting for service in the device packet buffer, and if so the d_len
+ *   field is set to a value larger than zero. The device driver should then
+ *   send out the packet.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
+{
+  return devif_poll_all(dev, DEVIF_ALLQUEUES, callback);
+}
+
+/****************************************************************************
+ * Name: devif_poll_queue
+ *
+ * Description:
+ *   The multi-queue version of devif_poll().  Poll only the TCP and UDP
+ *   connections whose flows map to TX queue 'queue' of the device.  Polling
+ *   queue 0 also performs all of the other polling operations.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+int devif_poll_queue(FAR struct net_driver_s *dev, int queue,
+                     devif_poll_callback_t callback)
+{
+  int bstop;
+
+  DEBUGASSERT(queue >= 0 && (queue == 0 || queue < dev->d_nqueues));
+
+  if (queue == 0)
+    {
+      return devif_poll_all(dev, queue, callback);
+    }
+
+  bstop = devif_poll_tcp_connections(dev, queue, callback);
+  if (!bstop)
+    {
+      bstop = devif_poll_udp_connections(dev, queue, callback);
+    }
+
+  return bstop;
+}
+#endif
+
 #endif /* CONFIG_NET */
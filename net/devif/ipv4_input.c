@@ -331,7 +331,8 @@ int ipv4_input(FAR struct net_driver_s *dev)
     }
 #endif
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_CSUM_OFFLOAD(dev, NETDEV_CSUM_RX_IPv4) &&
+      ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
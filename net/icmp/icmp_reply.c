@@ -146,7 +146,10 @@ void icmp_reply(FAR struct net_driver_s *dev, int type, int code)
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!NETDEV_CSUM_OFFLOAD(dev, NETDEV_CSUM_TX_IPv4))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   net_ipv4addr_hdrcopy(ipv4->destipaddr, ipv4->srcipaddr);
   net_ipv4addr_hdrcopy(ipv4->srcipaddr, &dev->d_ipaddr);
@@ -161,10 +164,13 @@ void icmp_reply(FAR struct net_driver_s *dev, int type, int code)
   /* Calculate the ICMP checksum. */
 
   icmp->icmpchksum  = 0;
-  icmp->icmpchksum  = ~icmp_chksum(dev, datalen + sizeof(*icmp));
-  if (icmp->icmpchksum == 0)
+  if (!NETDEV_CSUM_OFFLOAD(dev, NETDEV_CSUM_TX_ICMP))
     {
-      icmp->icmpchksum = 0xffff;
+      icmp->icmpchksum = ~icmp_chksum(dev, datalen + sizeof(*icmp));
+      if (icmp->icmpchksum == 0)
+        {
+          icmp->icmpchksum = 0xffff;
+        }
     }
 
   ninfo("Outgoing ICMP packet length: %d (%d)\n",
@@ -243,8 +243,11 @@ void icmpv6_poll(FAR struct net_driver_s *dev,
  *   Set up to send an ICMPv6 Neighbor Solicitation message
  *
  * Input Parameters:
- *   dev    - Reference to a device driver structure
- *   ipaddr - IP address of Neighbor to be solicited
+ *   dev        - Reference to a device driver structure
+ *   ipaddr     - IP address of Neighbor to be solicited
+ *   destipaddr - Destination of a unicast solicitation verifying a cached
+ *                address, or NULL to resolve 'ipaddr' with a multicast
+ *                solicitation
  *
  * Returned Value:
  *   None
@@ -252,7 +255,8 @@ void icmpv6_poll(FAR struct net_driver_s *dev,
  ****************************************************************************/
 
 void icmpv6_solicit(FAR struct net_driver_s *dev,
-                    FAR const net_ipv6addr_t ipaddr);
+                    FAR const net_ipv6addr_t ipaddr,
+                    FAR const net_ipv6addr_t destipaddr);
 
 /****************************************************************************
  * Name: icmpv6_rsolicit
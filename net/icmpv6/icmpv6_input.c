@@ -251,7 +251,8 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
               {
                 /* Save the sender's address mapping in our Neighbor Table. */
 
-                neighbor_add(dev, ipv6->srcipaddr, sol->srclladdr);
+                neighbor_add(dev, ipv6->srcipaddr, sol->srclladdr,
+                             ICMPv6_NADV_FLAG_O);
               }
 
             /* Yes.. Send a neighbor advertisement back to where the neighbor
@@ -282,8 +283,6 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
          *
          * Missing checks:
          *   optlen = 1 (8 octets)
-         *   Should only update Neighbor Table if
-         *     [O]verride bit is set in flags
          */
 
         adv = ICMPv6ADVERTISE;
@@ -297,7 +296,9 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
               {
                 /* Save the sender's address mapping in our Neighbor Table. */
 
-                neighbor_add(dev, ipv6->srcipaddr, adv->tgtlladdr);
+                neighbor_add(dev, ipv6->srcipaddr, adv->tgtlladdr,
+                             adv->flags[0] &
+                             (ICMPv6_NADV_FLAG_S | ICMPv6_NADV_FLAG_O));
               }
 
 #ifdef CONFIG_NET_ICMPv6_NEIGHBOR
@@ -378,7 +379,8 @@ void icmpv6_input(FAR struct net_driver_s *dev, unsigned int iplen)
                   {
                     FAR struct icmpv6_srclladdr_s *sllopt =
                                       (FAR struct icmpv6_srclladdr_s *)opt;
-                    neighbor_add(dev, ipv6->srcipaddr, sllopt->srclladdr);
+                    neighbor_add(dev, ipv6->srcipaddr, sllopt->srclladdr,
+                                 ICMPv6_NADV_FLAG_O);
                   }
                   break;
 
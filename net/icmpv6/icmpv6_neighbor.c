@@ -114,7 +114,7 @@ static uint16_t icmpv6_neighbor_eventhandler(FAR struct net_driver_s *dev,
        * Copy the packet data into the device packet buffer and send it.
        */
 
-      icmpv6_solicit(dev, state->snd_ipaddr);
+      icmpv6_solicit(dev, state->snd_ipaddr, NULL);
 
       IFF_SET_IPv6(dev->d_flags);
 
@@ -35,6 +35,7 @@
 #include "devif/devif.h"
 #include "netdev/netdev.h"
 #include "utils/utils.h"
+#include "neighbor/neighbor.h"
 #include "icmpv6/icmpv6.h"
 
 #ifdef CONFIG_NET_ICMPv6
@@ -73,9 +74,15 @@ static const uint16_t g_icmpv_mcastaddr[6] =
  *   - The IPv6 header
  *   - The ICMPv6 Neighbor Solicitation Message
  *
+ *   A multicast solicitation resolves an unknown address, and it leaves an
+ *   INCOMPLETE entry in the Neighbor Table until it is answered.  A unicast
+ *   solicitation verifies the cached address of a neighbor.
+ *
  * Input Parameters:
  *   dev - Reference to a device driver structure
  *   ipaddr - IP address of Neighbor to be solicited
+ *   destipaddr - Destination of a unicast solicitation, or NULL to send a
+ *     multicast solicitation
  *
  * Returned Value:
  *   None
@@ -83,7 +90,8 @@ static const uint16_t g_icmpv_mcastaddr[6] =
  ****************************************************************************/
 
 void icmpv6_solicit(FAR struct net_driver_s *dev,
-                    FAR const net_ipv6addr_t ipaddr)
+                    FAR const net_ipv6addr_t ipaddr,
+                    FAR const net_ipv6addr_t destipaddr)
 {
   FAR struct ipv6_hdr_s *ipv6;
   FAR struct icmpv6_neighbor_solicit_s *sol;
@@ -107,11 +115,24 @@ void icmpv6_solicit(FAR struct net_driver_s *dev,
   ipv6->proto   = IP_PROTO_ICMP6;          /* Next header */
   ipv6->ttl     = 255;                     /* Hop limit */
 
-  /* Set the multicast destination IP address */
+  if (destipaddr != NULL)
+    {
+      /* Set the unicast destination IP address */
+
+      net_ipv6addr_copy(ipv6->destipaddr, destipaddr);
+    }
+  else
+    {
+      /* Set the multicast destination IP address */
+
+      memcpy(ipv6->destipaddr, g_icmpv_mcastaddr, 6*sizeof(uint16_t));
+      ipv6->destipaddr[6] = ipaddr[6] | HTONS(0xff00);
+      ipv6->destipaddr[7] = ipaddr[7];
+
+      /* Remember that the address is being resolved */
 
-  memcpy(ipv6->destipaddr, g_icmpv_mcastaddr, 6*sizeof(uint16_t));
-  ipv6->destipaddr[6] = ipaddr[6] | HTONS(0xff00);
-  ipv6->destipaddr[7] = ipaddr[7];
+      neighbor_reserve(dev, ipaddr);
+    }
 
   /* Add out IPv6 address as the source address */
 
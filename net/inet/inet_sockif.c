@@ -96,6 +96,11 @@ static ssize_t    inet_sendfile(FAR struct socket *psock,
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+#ifdef CONFIG_NET_RECVIOB
+static ssize_t    inet_recviob(FAR struct socket *psock,
+                    FAR struct iob_s **iob, int flags,
+                    FAR struct sockaddr *from, FAR socklen_t *fromlen);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -122,6 +127,10 @@ static const struct sock_intf_s g_inet_sockif =
   ,
   inet_sendfile     /* si_sendfile */
 #endif
+#ifdef CONFIG_NET_RECVIOB
+  ,
+  inet_recviob      /* si_recviob */
+#endif
 };
 
 /****************************************************************************
@@ -1537,6 +1546,44 @@ static ssize_t inet_sendfile(FAR struct socket *psock,
 }
 #endif
 
+/****************************************************************************
+ * Name: inet_recviob
+ *
+ * Description:
+ *   Implements the zero-copy receive interface (psock_recviob()) for the
+ *   AF_INET and AF_INET6 address families.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECVIOB
+static ssize_t inet_recviob(FAR struct socket *psock,
+                            FAR struct iob_s **iob, int flags,
+                            FAR struct sockaddr *from,
+                            FAR socklen_t *fromlen)
+{
+  switch (psock->s_type)
+    {
+#ifdef NET_TCP_HAVE_STACK
+    case SOCK_STREAM:
+      if (fromlen != NULL)
+        {
+          *fromlen = 0;
+        }
+
+      return psock_tcp_recviob(psock, iob, flags);
+#endif
+
+#ifdef NET_UDP_HAVE_STACK
+    case SOCK_DGRAM:
+      return psock_udp_recviob(psock, iob, flags, from, fromlen);
+#endif
+
+    default:
+      return -EOPNOTSUPP;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: inet_recvmsg
  *
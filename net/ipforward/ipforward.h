@@ -29,7 +29,14 @@
 
 #include <stdint.h>
 
+#include <nuttx/net/ip.h>
+
 #undef HAVE_FWDALLOC
+
+#ifndef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  define ipfwd_flushflows()
+#endif
+
 #ifdef CONFIG_NET_IPFORWARD
 
 /****************************************************************************
@@ -240,6 +247,54 @@ int ipfwd_forward(FAR struct forward_s *fwd);
 
 void ipfwd_poll(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: ipv4_flow_finddev and ipv6_flow_finddev
+ *
+ * Description:
+ *   Return the device on which to forward the packets from 'srcipaddr' to
+ *   'destipaddr'.  The device found by netdev_findby_ripv4/6addr() for the
+ *   first packet of a flow is remembered for the following packets.
+ *
+ * Returned Value:
+ *   The forwarding device; NULL if the destination is not routable.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#ifdef CONFIG_NET_IPv4
+FAR struct net_driver_s *ipv4_flow_finddev(in_addr_t srcipaddr,
+                                           in_addr_t destipaddr);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+FAR struct net_driver_s *ipv6_flow_finddev(const net_ipv6addr_t srcipaddr,
+                                           const net_ipv6addr_t destipaddr);
+#endif
+#else
+#  define ipv4_flow_finddev(s,d) netdev_findby_ripv4addr(s,d)
+#  define ipv6_flow_finddev(s,d) netdev_findby_ripv6addr(s,d)
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flushflows
+ *
+ * Description:
+ *   Forget all flows after a change of the routing table, or of the state
+ *   or the addresses of a network device.  The next packet of each flow
+ *   looks up its route again.
+ *
+ * Assumptions:
+ *   Called from normal user mode, without a route table lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flushflows(void);
+#endif
+
 /****************************************************************************
  * Name: ipfwd_dropstats
  *
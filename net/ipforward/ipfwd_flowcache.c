@@ -0,0 +1,220 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flowcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_IPFORWARD_NFLOWS
+#  define CONFIG_NET_IPFORWARD_NFLOWS 16
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A flow is identified by the addresses of its packets, which are all that
+ * the route look-up depends on.  Each address pair hashes to one entry in
+ * a direct-mapped table; a colliding flow replaces the entry.
+ */
+
+#ifdef CONFIG_NET_IPv4
+struct ipv4_flow_s
+{
+  FAR struct net_driver_s *fl_dev;      /* Egress device, NULL: unused */
+  in_addr_t                fl_srcaddr;  /* Source address of the flow */
+  in_addr_t                fl_destaddr; /* Destination address of the flow */
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+struct ipv6_flow_s
+{
+  FAR struct net_driver_s *fl_dev;      /* Egress device, NULL: unused */
+  net_ipv6addr_t           fl_srcaddr;  /* Source address of the flow */
+  net_ipv6addr_t           fl_destaddr; /* Destination address of the flow */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static struct ipv4_flow_s g_ipv4_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static struct ipv6_flow_s g_ipv6_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_flowhash
+ *
+ * Description:
+ *   Fold a 32-bit hash of the addresses into an index of the flow table.
+ *
+ ****************************************************************************/
+
+static unsigned int ipfwd_flowhash(uint32_t hash)
+{
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash % CONFIG_NET_IPFORWARD_NFLOWS;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_finddev
+ *
+ * Description:
+ *   Return the device on which to forward the packets from 'srcipaddr' to
+ *   'destipaddr'.  The device found by netdev_findby_ripv4addr() for the
+ *   first packet of a flow is remembered for the following packets.
+ *
+ * Returned Value:
+ *   The forwarding device; NULL if the destination is not routable.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+FAR struct net_driver_s *ipv4_flow_finddev(in_addr_t srcipaddr,
+                                           in_addr_t destipaddr)
+{
+  FAR struct ipv4_flow_s *flow;
+
+  flow = &g_ipv4_flows[ipfwd_flowhash(srcipaddr ^ destipaddr)];
+  if (flow->fl_dev == NULL ||
+      !net_ipv4addr_cmp(flow->fl_srcaddr, srcipaddr) ||
+      !net_ipv4addr_cmp(flow->fl_destaddr, destipaddr))
+    {
+      /* A new flow:  Look up its route */
+
+      flow->fl_dev = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      net_ipv4addr_copy(flow->fl_srcaddr, srcipaddr);
+      net_ipv4addr_copy(flow->fl_destaddr, destipaddr);
+    }
+
+  return flow->fl_dev;
+}
+#endif
+
+/****************************************************************************
+ * Name: ipv6_flow_finddev
+ *
+ * Description:
+ *   Return the device on which to forward the packets from 'srcipaddr' to
+ *   'destipaddr'.  The device found by netdev_findby_ripv6addr() for the
+ *   first packet of a flow is remembered for the following packets.
+ *
+ * Returned Value:
+ *   The forwarding device; NULL if the destination is not routable.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+FAR struct net_driver_s *ipv6_flow_finddev(const net_ipv6addr_t srcipaddr,
+                                           const net_ipv6addr_t destipaddr)
+{
+  FAR struct ipv6_flow_s *flow;
+  uint32_t hash = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      hash ^= ((uint32_t)srcipaddr[i] << 16 | srcipaddr[i + 1]) ^
+              ((uint32_t)destipaddr[i] << 16 | destipaddr[i + 1]);
+    }
+
+  flow = &g_ipv6_flows[ipfwd_flowhash(hash)];
+  if (flow->fl_dev == NULL ||
+      !net_ipv6addr_cmp(flow->fl_srcaddr, srcipaddr) ||
+      !net_ipv6addr_cmp(flow->fl_destaddr, destipaddr))
+    {
+      /* A new flow:  Look up its route */
+
+      flow->fl_dev = netdev_findby_ripv6addr(srcipaddr, destipaddr);
+      net_ipv6addr_copy(flow->fl_srcaddr, srcipaddr);
+      net_ipv6addr_copy(flow->fl_destaddr, destipaddr);
+    }
+
+  return flow->fl_dev;
+}
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flushflows
+ *
+ * Description:
+ *   Forget all flows after a change of the routing table, or of the state
+ *   or the addresses of a network device.  The next packet of each flow
+ *   looks up its route again.
+ *
+ * Assumptions:
+ *   Called from normal user mode, without a route table lock held.  The
+ *   network is locked here.
+ *
+ ****************************************************************************/
+
+void ipfwd_flushflows(void)
+{
+  net_lock();
+
+#ifdef CONFIG_NET_IPv4
+  memset(g_ipv4_flows, 0, sizeof(g_ipv4_flows));
+#endif
+#ifdef CONFIG_NET_IPv6
+  memset(g_ipv6_flows, 0, sizeof(g_ipv6_flows));
+#endif
+
+  net_unlock();
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
@@ -117,11 +117,9 @@ struct local_conn_s
   uint8_t lc_proto;              /* SOCK_STREAM or SOCK_DGRAM */
   uint8_t lc_type;               /* See enum local_type_e */
   uint8_t lc_state;              /* See enum local_state_e */
-  struct file lc_infile;         /* File for read-only FIFO (peers) */
-  struct file lc_outfile;        /* File descriptor of write-only FIFO (peers) */
+  struct file lc_infile;         /* Read-only FIFO or pipe (peers) */
+  struct file lc_outfile;        /* Write-only FIFO or pipe (peers) */
   char lc_path[UNIX_PATH_MAX];   /* Path assigned by bind() */
-  int32_t lc_instance_id;        /* Connection instance ID for stream
-                                  * server<->client connection pair */
 #ifdef CONFIG_NET_LOCAL_SCM
   FAR struct local_conn_s *
                         lc_peer; /* Peer connection instance */
@@ -136,7 +134,6 @@ struct local_conn_s
   /* SOCK_STREAM fields common to both client and server */
 
   sem_t lc_waitsem;            /* Use to wait for a connection to be accepted */
-  sem_t lc_donesem;            /* Use to wait for client connected done */
   FAR struct socket *lc_psock; /* A reference to the socket structure */
 
   /* The following is a list if poll structures of threads waiting for
@@ -481,15 +478,25 @@ int local_getaddr(FAR struct local_conn_s *conn, FAR struct sockaddr *addr,
 int local_sync(FAR struct file *filep);
 
 /****************************************************************************
- * Name: local_create_fifos
+ * Name: local_create_pipes
  *
  * Description:
- *   Create the FIFO pair needed for a SOCK_STREAM connection.
+ *   Create the pair of ring buffers of a SOCK_STREAM connection and open
+ *   them on both peers.  These are anonymous pipes:  No FIFO is created in
+ *   the VFS for the connection.
+ *
+ * Input Parameters:
+ *   client - The connecting peer
+ *   server - The accepted peer
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_LOCAL_STREAM
-int local_create_fifos(FAR struct local_conn_s *conn);
+int local_create_pipes(FAR struct local_conn_s *client,
+                       FAR struct local_conn_s *server);
 #endif
 
 /****************************************************************************
@@ -505,18 +512,6 @@ int local_create_halfduplex(FAR struct local_conn_s *conn,
                             FAR const char *path);
 #endif
 
-/****************************************************************************
- * Name: local_release_fifos
- *
- * Description:
- *   Release references to the FIFO pair used for a SOCK_STREAM connection.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_release_fifos(FAR struct local_conn_s *conn);
-#endif
-
 /****************************************************************************
  * Name: local_release_halfduplex
  *
@@ -529,54 +524,6 @@ int local_release_fifos(FAR struct local_conn_s *conn);
 int local_release_halfduplex(FAR struct local_conn_s *conn);
 #endif
 
-/****************************************************************************
- * Name: local_open_client_rx
- *
- * Description:
- *   Only the client-side Rx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_rx(FAR struct local_conn_s *client, bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_open_client_tx
- *
- * Description:
- *   Only the client-side Tx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_tx(FAR struct local_conn_s *client, bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_open_server_rx
- *
- * Description:
- *   Only the server-side Rx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_rx(FAR struct local_conn_s *server, bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_open_server_tx
- *
- * Description:
- *   Only the server-side Tx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_tx(FAR struct local_conn_s *server, bool nonblock);
-#endif
-
 /****************************************************************************
  * Name: local_open_receiver
  *
@@ -645,16 +592,6 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds);
 
 int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
 
-/****************************************************************************
- * Name: local_generate_instance_id
- *
- * Description:
- *   Generate instance ID for stream
- *
- ****************************************************************************/
-
-int32_t local_generate_instance_id(void);
-
 #undef EXTERN
 #ifdef __cplusplus
 }
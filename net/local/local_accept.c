@@ -174,44 +174,25 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 #endif /* CONFIG_NET_LOCAL_SCM */
 
               strlcpy(conn->lc_path, client->lc_path, sizeof(conn->lc_path));
-              conn->lc_instance_id = client->lc_instance_id;
 
-              /* Open the server-side write-only FIFO.  This should not
-               * block.
+              /* Create the ring buffers of the connection and open them on
+               * both sides.  This does not block.
                */
 
-              ret = local_open_server_tx(conn, false);
+              ret = local_create_pipes(client, conn);
               if (ret < 0)
                 {
-                  nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-                     conn->lc_path, ret);
+                  nerr("ERROR: Failed to create pipes for %s: %d\n",
+                       conn->lc_path, ret);
                 }
             }
 
-          /* Do we have a connection?  Is the write-side FIFO opened? */
+          /* Do we have a connection?  Are the pipes opened? */
 
           if (ret == OK)
             {
-              DEBUGASSERT(conn->lc_outfile.f_inode != NULL);
-
-              /* Open the server-side read-only FIFO.  This should not
-               * block because the client side has already opening it
-               * for writing.
-               */
-
-              ret = local_open_server_rx(conn, false);
-              if (ret < 0)
-                {
-                   nerr("ERROR: Failed to open read-only FIFOs for %s: %d\n",
-                        conn->lc_path, ret);
-                }
-            }
-
-          /* Do we have a connection?  Are the FIFOs opened? */
-
-          if (ret == OK)
-            {
-              DEBUGASSERT(conn->lc_infile.f_inode != NULL);
+              DEBUGASSERT(conn->lc_infile.f_inode != NULL &&
+                          conn->lc_outfile.f_inode != NULL);
 
               /* Return the address family */
 
@@ -230,24 +211,42 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               newsock->s_sockif = psock->s_sockif;
               newsock->s_conn   = (FAR void *)conn;
             }
+          else if (conn != NULL)
+            {
+              /* Undo the connection.  This also closes the pipes on both
+               * sides if they were opened.
+               */
+
+#ifdef CONFIG_NET_LOCAL_SCM
+              client->lc_peer = NULL;
+              conn->lc_peer   = NULL;
+#endif /* CONFIG_NET_LOCAL_SCM */
+
+              if (client->lc_infile.f_inode != NULL)
+                {
+                  file_close(&client->lc_infile);
+                }
+
+              if (client->lc_outfile.f_inode != NULL)
+                {
+                  file_close(&client->lc_outfile);
+                }
+
+              local_free(conn);
+            }
 
           /* Signal the client with the result of the connection */
 
           client->u.client.lc_result = ret;
           if (client->lc_state == LOCAL_STATE_CONNECTING)
             {
-              client->lc_state = LOCAL_STATE_CONNECTED;
-              _SO_SETERRNO(client->lc_psock, ret);
+              client->lc_state = ret == OK ? LOCAL_STATE_CONNECTED :
+                                             LOCAL_STATE_BOUND;
+              _SO_SETERRNO(client->lc_psock, -ret);
               local_event_pollnotify(client, POLLOUT);
             }
 
           nxsem_post(&client->lc_waitsem);
-
-          if (ret == OK)
-            {
-              ret = net_lockedwait(&client->lc_donesem);
-            }
-
           return ret;
         }
 
@@ -124,10 +124,6 @@ FAR struct local_conn_s *local_alloc(void)
 
       nxsem_init(&conn->lc_waitsem, 0, 0);
       nxsem_set_protocol(&conn->lc_waitsem, SEM_PRIO_NONE);
-
-      nxsem_init(&conn->lc_donesem, 0, 0);
-      nxsem_set_protocol(&conn->lc_donesem, SEM_PRIO_NONE);
-
 #endif
 
       /* This semaphore is used for sending safely in multithread.
@@ -178,7 +174,7 @@ void local_free(FAR struct local_conn_s *conn)
 
   net_unlock();
 
-  /* Make sure that the read-only FIFO is closed */
+  /* Make sure that the read-only FIFO or pipe is closed */
 
   if (conn->lc_infile.f_inode != NULL)
     {
@@ -186,7 +182,7 @@ void local_free(FAR struct local_conn_s *conn)
       conn->lc_infile.f_inode = NULL;
     }
 
-  /* Make sure that the write-only FIFO is closed */
+  /* Make sure that the write-only FIFO or pipe is closed */
 
   if (conn->lc_outfile.f_inode != NULL)
     {
@@ -209,11 +205,7 @@ void local_free(FAR struct local_conn_s *conn)
 #endif /* CONFIG_NET_LOCAL_SCM */
 
 #ifdef CONFIG_NET_LOCAL_STREAM
-  /* Destroy all FIFOs associted with the connection */
-
-  local_release_fifos(conn);
   nxsem_destroy(&conn->lc_waitsem);
-  nxsem_destroy(&conn->lc_donesem);
 #endif
 
   /* Destory sem associated with the connection */
@@ -105,36 +105,12 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
-  /* Create the FIFOs needed for the connection */
-
-  ret = local_create_fifos(client);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to create FIFOs for %s: %d\n",
-           client->lc_path, ret);
-
-      return ret;
-    }
-
-  /* Open the client-side write-only FIFO.  This should not block and should
-   * prevent the server-side from blocking as well.
+  /* Set the busy "result" before giving the semaphore.  The ring buffers
+   * of the connection are created by the server when it accepts it.
    */
 
-  ret = local_open_client_tx(client, nonblock);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-           client->lc_path, ret);
-
-      goto errout_with_fifos;
-    }
-
-  DEBUGASSERT(client->lc_outfile.f_inode != NULL);
-
-  /* Set the busy "result" before giving the semaphore. */
-
   client->u.client.lc_result = -EBUSY;
-  client->lc_state = LOCAL_STATE_ACCEPT;
+  client->lc_state = nonblock ? LOCAL_STATE_CONNECTING : LOCAL_STATE_ACCEPT;
 
   /* Add ourself to the list of waiting connections and notify the server. */
 
@@ -146,87 +122,40 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
       _local_semgive(&server->lc_waitsem);
     }
 
-  /* Wait for the server to accept the connections */
-
-  if (!nonblock)
+  if (nonblock)
     {
-      do
-        {
-          _local_semtake(&client->lc_waitsem);
-          ret = client->u.client.lc_result;
-        }
-      while (ret == -EBUSY);
-
-      /* Did we successfully connect? */
-
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to connect: %d\n", ret);
-          goto errout_with_outfd;
-        }
+      return -EINPROGRESS;
     }
 
-  /* Yes.. open the read-only FIFO */
+  /* Wait for the server to accept the connections */
 
-  ret = local_open_client_rx(client, nonblock);
-  if (ret < 0)
+  do
     {
-      nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-           client->lc_path, ret);
-      goto errout_with_outfd;
+      _local_semtake(&client->lc_waitsem);
+      ret = client->u.client.lc_result;
     }
+  while (ret == -EBUSY);
 
-  DEBUGASSERT(client->lc_infile.f_inode != NULL);
+  /* Did we successfully connect? */
 
-  nxsem_post(&client->lc_donesem);
-
-  if (!nonblock)
+  if (ret < 0)
     {
-      client->lc_state = LOCAL_STATE_CONNECTED;
+      nerr("ERROR: Failed to connect: %d\n", ret);
+      client->lc_state = LOCAL_STATE_BOUND;
       return ret;
     }
 
-  client->lc_state = LOCAL_STATE_CONNECTING;
-  return -EINPROGRESS;
+  DEBUGASSERT(client->lc_infile.f_inode != NULL &&
+              client->lc_outfile.f_inode != NULL);
 
-errout_with_outfd:
-  file_close(&client->lc_outfile);
-  client->lc_outfile.f_inode = NULL;
-
-errout_with_fifos:
-  local_release_fifos(client);
-  client->lc_state = LOCAL_STATE_BOUND;
-  return ret;
+  client->lc_state = LOCAL_STATE_CONNECTED;
+  return OK;
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
-/****************************************************************************
- * Name: local_generate_instance_id
- *
- * Description:
- *   Generate instance ID for stream
- *
- ****************************************************************************/
-
-int32_t local_generate_instance_id(void)
-{
-  static int32_t g_next_instance_id = 0;
-  int32_t id;
-
-  /* Called from local_connect with net_lock held. */
-
-  id = g_next_instance_id++;
-  if (g_next_instance_id < 0)
-    {
-      g_next_instance_id = 0;
-    }
-
-  return id;
-}
-
 /****************************************************************************
  * Name: psock_local_connect
  *
@@ -308,7 +237,6 @@ int psock_local_connect(FAR struct socket *psock,
                 client->lc_proto = conn->lc_proto;
                 strlcpy(client->lc_path, unaddr->sun_path,
                         sizeof(client->lc_path));
-                client->lc_instance_id = local_generate_instance_id();
 
                 /* The client is now bound to an address */
 
@@ -38,81 +38,28 @@
 #include <assert.h>
 #include <debug.h>
 
+#include "socket/socket.h"
 #include "local/local.h"
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define LOCAL_CS_SUFFIX    "CS"  /* Name of the client-to-server FIFO */
-#define LOCAL_SC_SUFFIX    "SC"  /* Name of the server-to-client FIFO */
 #define LOCAL_HD_SUFFIX    "HD"  /* Name of the half duplex datagram FIFO */
 #define LOCAL_SUFFIX_LEN   2
 
 #define LOCAL_FULLPATH_LEN (UNIX_PATH_MAX + LOCAL_SUFFIX_LEN)
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: local_cs_name
- *
- * Description:
- *   Create the name of the client-to-server FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-static inline void local_cs_name(FAR struct local_conn_s *conn,
-                                 FAR char *path)
-{
-  if (conn->lc_instance_id < 0)
-    {
-      snprintf(path, LOCAL_FULLPATH_LEN - 1,
-               CONFIG_NET_LOCAL_VFS_PATH "/%s" LOCAL_CS_SUFFIX,
-               conn->lc_path);
-    }
-  else
-    {
-      snprintf(path, LOCAL_FULLPATH_LEN - 1,
-               CONFIG_NET_LOCAL_VFS_PATH "/%s" LOCAL_CS_SUFFIX "%" PRIx32,
-               conn->lc_path, conn->lc_instance_id);
-    }
+/* The ring buffers of connected stream sockets are anonymous pipes */
 
-  path[LOCAL_FULLPATH_LEN - 1] = '\0';
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
+#if defined(CONFIG_NET_LOCAL_STREAM) && CONFIG_DEV_PIPE_SIZE <= 0
+#  error Unix domain stream sockets require CONFIG_DEV_PIPE_SIZE > 0
+#endif
 
 /****************************************************************************
- * Name: local_sc_name
- *
- * Description:
- *   Create the name of the server-to-client FIFO.
- *
+ * Private Functions
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-static inline void local_sc_name(FAR struct local_conn_s *conn,
-                                 FAR char *path)
-{
-  if (conn->lc_instance_id < 0)
-    {
-      snprintf(path, LOCAL_FULLPATH_LEN - 1,
-               CONFIG_NET_LOCAL_VFS_PATH "/%s" LOCAL_SC_SUFFIX,
-               conn->lc_path);
-    }
-  else
-    {
-      snprintf(path, LOCAL_FULLPATH_LEN - 1,
-               CONFIG_NET_LOCAL_VFS_PATH "/%s" LOCAL_SC_SUFFIX "%" PRIx32,
-               conn->lc_path, conn->lc_instance_id);
-    }
-
-  path[LOCAL_FULLPATH_LEN - 1] = '\0';
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
 /****************************************************************************
  * Name: local_hd_name
  *
@@ -138,6 +85,7 @@ static inline void local_hd_name(FAR const char *inpath, FAR char *outpath)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LOCAL_DGRAM
 static bool local_fifo_exists(FAR const char *path)
 {
   struct stat buf;
@@ -190,43 +138,6 @@ static int local_create_fifo(FAR const char *path)
   return OK;
 }
 
-/****************************************************************************
- * Name: local_release_fifo
- *
- * Description:
- *   Release a reference from one of the FIFOs used in a connection.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM /* Currently not used by datagram code */
-static int local_release_fifo(FAR const char *path)
-{
-  int ret;
-
-  /* Unlink the client-to-server FIFO if it exists. */
-
-  if (local_fifo_exists(path))
-    {
-      /* Un-linking the FIFO removes the FIFO from the namespace.  It will
-       * also mark the FIFO device "unlinked".  When all of the open
-       * references to the FIFO device are closed, the resources consumed
-       * by the device instance will also be freed.
-       */
-
-      ret = nx_unlink(path);
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to unlink FIFO %s: %d\n", path, ret);
-          return ret;
-        }
-    }
-
-  /* The FIFO does not exist or we successfully unlinked it. */
-
-  return OK;
-}
-#endif
-
 /****************************************************************************
  * Name: local_rx_open
  *
@@ -320,38 +231,71 @@ static int local_set_policy(FAR struct file *filep, unsigned long policy)
 
   return ret;
 }
+#endif /* CONFIG_NET_LOCAL_DGRAM */
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: local_create_fifos
+ * Name: local_create_pipes
  *
  * Description:
- *   Create the FIFO pair needed for a SOCK_STREAM connection.
+ *   Create the pair of ring buffers of a SOCK_STREAM connection and open
+ *   them on both peers.  These are anonymous pipes:  No FIFO is created in
+ *   the VFS for the connection.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_LOCAL_STREAM
-int local_create_fifos(FAR struct local_conn_s *conn)
+int local_create_pipes(FAR struct local_conn_s *client,
+                       FAR struct local_conn_s *server)
 {
-  char path[LOCAL_FULLPATH_LEN];
+  FAR struct file *filep[2];
   int ret;
 
-  /* Create the client-to-server FIFO if it does not already exist. */
+  /* Create the client-to-server pipe */
+
+  filep[0] = &server->lc_infile;
+  filep[1] = &client->lc_outfile;
+
+  ret = file_pipe(filep, CONFIG_NET_LOCAL_STREAM_BUFSIZE, 0);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to create the client-to-server pipe: %d\n", ret);
+      return ret;
+    }
 
-  local_cs_name(conn, path);
-  ret = local_create_fifo(path);
-  if (ret >= 0)
+  /* Create the server-to-client pipe */
+
+  filep[0] = &client->lc_infile;
+  filep[1] = &server->lc_outfile;
+
+  ret = file_pipe(filep, CONFIG_NET_LOCAL_STREAM_BUFSIZE, 0);
+  if (ret < 0)
     {
-      /* Create the server-to-client FIFO if it does not already exist. */
+      nerr("ERROR: Failed to create the server-to-client pipe: %d\n", ret);
 
-      local_sc_name(conn, path);
-      ret = local_create_fifo(path);
+      file_close(&server->lc_infile);
+      file_close(&client->lc_outfile);
+      return ret;
     }
 
-  return ret;
+  /* Each peer blocks on its ends as its socket was configured */
+
+  if (_SS_ISNONBLOCK(client->lc_conn.s_flags))
+    {
+      client->lc_infile.f_oflags  |= O_NONBLOCK;
+      client->lc_outfile.f_oflags |= O_NONBLOCK;
+    }
+
+  if (_SS_ISNONBLOCK(server->lc_conn.s_flags))
+    {
+      server->lc_infile.f_oflags  |= O_NONBLOCK;
+      server->lc_outfile.f_oflags |= O_NONBLOCK;
+    }
+
+  return OK;
 }
 #endif /* CONFIG_NET_LOCAL_STREAM */
 
@@ -376,37 +320,6 @@ int local_create_halfduplex(FAR struct local_conn_s *conn,
 }
 #endif /* CONFIG_NET_LOCAL_DGRAM */
 
-/****************************************************************************
- * Name: local_release_fifos
- *
- * Description:
- *   Release references to the FIFO pair used for a SOCK_STREAM connection.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_release_fifos(FAR struct local_conn_s *conn)
-{
-  char path[LOCAL_FULLPATH_LEN];
-  int ret1;
-  int ret2;
-
-  /* Destroy the client-to-server FIFO if it exists. */
-
-  local_sc_name(conn, path);
-  ret1 = local_release_fifo(path);
-
-  /* Destroy the server-to-client FIFO if it exists. */
-
-  local_cs_name(conn, path);
-  ret2 = local_release_fifo(path);
-
-  /* Return a failure if one occurred. */
-
-  return ret1 < 0 ? ret1 : ret2;
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
 /****************************************************************************
  * Name: local_release_halfduplex
  *
@@ -446,134 +359,6 @@ int local_release_halfduplex(FAR struct local_conn_s *conn)
 }
 #endif /* CONFIG_NET_LOCAL_DGRAM */
 
-/****************************************************************************
- * Name: local_open_client_rx
- *
- * Description:
- *   Open the client-side of the server-to-client FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_rx(FAR struct local_conn_s *client, bool nonblock)
-{
-  char path[LOCAL_FULLPATH_LEN];
-  int ret;
-
-  /* Get the server-to-client path name */
-
-  local_sc_name(client, path);
-
-  /* Then open the file for read-only access */
-
-  ret = local_rx_open(client, path, nonblock);
-  if (ret == OK)
-    {
-      /* Policy: Free FIFO resources when the last reference is closed */
-
-      ret = local_set_policy(&client->lc_infile, 0);
-    }
-
-  return ret;
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
-/****************************************************************************
- * Name: local_open_client_tx
- *
- * Description:
- *   Open the client-side of the client-to-server FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_tx(FAR struct local_conn_s *client, bool nonblock)
-{
-  char path[LOCAL_FULLPATH_LEN];
-  int ret;
-
-  /* Get the client-to-server path name */
-
-  local_cs_name(client, path);
-
-  /* Then open the file for write-only access */
-
-  ret = local_tx_open(client, path, nonblock);
-  if (ret == OK)
-    {
-      /* Policy: Free FIFO resources when the last reference is closed */
-
-      ret = local_set_policy(&client->lc_outfile, 0);
-    }
-
-  return ret;
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
-/****************************************************************************
- * Name: local_open_server_rx
- *
- * Description:
- *   Open the server-side of the client-to-server FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_rx(FAR struct local_conn_s *server, bool nonblock)
-{
-  char path[LOCAL_FULLPATH_LEN];
-  int ret;
-
-  /* Get the client-to-server path name */
-
-  local_cs_name(server, path);
-
-  /* Then open the file for write-only access */
-
-  ret = local_rx_open(server, path, nonblock);
-  if (ret == OK)
-    {
-      /* Policy: Free FIFO resources when the last reference is closed */
-
-      ret = local_set_policy(&server->lc_infile, 0);
-    }
-
-  return ret;
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
-/****************************************************************************
- * Name: local_open_server_tx
- *
- * Description:
- *   Only the server-side of the server-to-client FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_tx(FAR struct local_conn_s *server, bool nonblock)
-{
-  char path[LOCAL_FULLPATH_LEN];
-  int ret;
-
-  /* Get the server-to-client path name */
-
-  local_sc_name(server, path);
-
-  /* Then open the file for read-only access */
-
-  ret = local_tx_open(server, path, nonblock);
-  if (ret == OK)
-    {
-      /* Policy: Free FIFO resources when the last reference is closed */
-
-      ret = local_set_policy(&server->lc_outfile, 0);
-    }
-
-  return ret;
-}
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
 /****************************************************************************
  * Name: local_open_receiver
  *
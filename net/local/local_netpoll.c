@@ -36,6 +36,27 @@
 #include "socket/socket.h"
 #include "local/local.h"
 
+/****************************************************************************
+ * Name: local_inout_poll_cb
+ *
+ * Description:
+ *   Forward the events of a shadow pollfd to the pollfd of the socket as
+ *   soon as they occur, so that pollers which keep the socket set up
+ *   (epoll) see them without a teardown.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_inout_poll_cb(FAR struct pollfd *fds)
+{
+  FAR struct pollfd *originfds = fds->arg;
+
+  originfds->revents |= fds->revents;
+  fds->revents = 0;
+  poll_notify(originfds);
+}
+#endif
+
 /****************************************************************************
  * Name: local_event_pollsetup
  ****************************************************************************/
@@ -136,7 +157,7 @@ void local_event_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %08" PRIx32 "\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -217,10 +238,14 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
           shadowfds[0].fd     = 1; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
+          shadowfds[0].arg    = fds;
+          shadowfds[0].cb     = local_inout_poll_cb;
           shadowfds[0].events = fds->events & ~POLLOUT;
 
           shadowfds[1].fd     = 0; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
+          shadowfds[1].arg    = fds;
+          shadowfds[1].cb     = local_inout_poll_cb;
           shadowfds[1].events = fds->events & ~POLLIN;
 
           net_unlock();
@@ -289,7 +314,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
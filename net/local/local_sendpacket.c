@@ -120,6 +120,7 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
   FAR const struct iovec *iov;
   int ret = -EINVAL;
   uint16_t len16;
+  int nsent;
 
   if (preamble)
     {
@@ -138,7 +139,11 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
         }
     }
 
-  for (len16 = 0, iov = buf; iov != end; iov++)
+  /* The count is not limited to the 16-bit packet length:  A stream may
+   * send more than 64KiB at once.
+   */
+
+  for (nsent = 0, iov = buf; iov != end; iov++)
     {
       ret = local_fifo_write(filep, iov->iov_base, iov->iov_len);
       if (ret < 0)
@@ -148,7 +153,7 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
 
       if (ret > 0)
         {
-          len16 += ret;
+          nsent += ret;
           if (ret != iov->iov_len)
             {
               break;
@@ -156,7 +161,7 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
         }
     }
 
-  return len16 > 0 ? len16 : ret;
+  return nsent > 0 ? nsent : ret;
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL */
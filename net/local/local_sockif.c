@@ -771,7 +771,6 @@ static int local_socketpair(FAR struct socket *psocks[2])
 #if defined(CONFIG_NET_LOCAL_STREAM) || defined(CONFIG_NET_LOCAL_DGRAM)
   FAR struct local_conn_s *conns[2];
 #ifdef CONFIG_NET_LOCAL_STREAM
-  bool nonblock;
   int ret;
 #endif /* CONFIG_NET_LOCAL_STREAM */
   int i;
@@ -797,58 +796,22 @@ static int local_socketpair(FAR struct socket *psocks[2])
 #endif /* CONFIG_NET_LOCAL_DGRAM */
 
 #ifdef CONFIG_NET_LOCAL_STREAM
-  conns[0]->lc_instance_id = conns[1]->lc_instance_id
-                           = local_generate_instance_id();
+  /* Create the ring buffers of the connection */
 
-  /* Create the FIFOs needed for the connection */
-
-  ret = local_create_fifos(conns[0]);
-  if (ret < 0)
-    {
-      goto errout;
-    }
-
-  nonblock = _SS_ISNONBLOCK(conns[0]->lc_conn.s_flags);
-
-  /* Open the client-side write-only FIFO. */
-
-  ret = local_open_client_tx(conns[0], nonblock);
-  if (ret < 0)
-    {
-      goto errout;
-    }
-
-  /* Open the server-side read-only FIFO. */
-
-  ret = local_open_server_rx(conns[1], nonblock);
+  ret = local_create_pipes(conns[0], conns[1]);
   if (ret < 0)
     {
-      goto errout;
+      return ret;
     }
 
-  /* Open the server-side write-only FIFO. */
-
-  ret = local_open_server_tx(conns[1], nonblock);
-  if (ret < 0)
-    {
-      goto errout;
-    }
-
-  /* Open the client-side read-only FIFO */
-
-  ret = local_open_client_rx(conns[0], nonblock);
-  if (ret < 0)
-    {
-      goto errout;
-    }
+#ifdef CONFIG_NET_LOCAL_SCM
+  conns[0]->lc_peer = conns[1];
+  conns[1]->lc_peer = conns[0];
+#endif /* CONFIG_NET_LOCAL_SCM */
 
   conns[0]->lc_state = conns[1]->lc_state
                      = LOCAL_STATE_CONNECTED;
   return OK;
-
-errout:
-  local_release_fifos(conns[0]);
-  return ret;
 #endif /* CONFIG_NET_LOCAL_STREAM */
 #else
   return -EOPNOTSUPP;
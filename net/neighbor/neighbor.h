@@ -30,6 +30,7 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -37,15 +38,54 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Neighbor Unreachability Detection timing (RFC 4861, section 10) */
+
+#define NEIGHBOR_REACHABLE_TICK SEC2TICK(CONFIG_NET_IPv6_NCONF_REACHABLE)
+#define NEIGHBOR_DELAY_TICK     SEC2TICK(5) /* DELAY_FIRST_PROBE_TIME */
+#define NEIGHBOR_RETRANS_TICK   SEC2TICK(1) /* RETRANS_TIMER */
+#define NEIGHBOR_MAX_PROBES     3           /* MAX_UNICAST_SOLICIT */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One slot of the Neighbor table */
+
+struct neighbor_table_s
+{
+  struct neighbor_entry_s       entry;   /* The address mapping */
+  FAR struct net_driver_s      *dev;     /* The device of the neighbor */
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+  FAR struct neighbor_table_s  *hnext;   /* Next entry with the same hash */
+#endif
+  uint8_t                       probes;  /* Solicitations sent in PROBE */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  g_neighbor_lock must be held when accessing
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct neighbor_table_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern mutex_t g_neighbor_lock;
+
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+/* The used entries of g_neighbors hashed by their IPv6 address */
+
+extern FAR struct neighbor_table_s *
+g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+#endif
+
+/* The number of entries in the PROBE state */
+
+extern unsigned int g_neighbor_nprobes;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -53,12 +93,70 @@ extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the head of the hash chain of the IPv6 address 'ipaddr'.
+ *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+FAR struct neighbor_table_s **neighbor_hash(const net_ipv6addr_t ipaddr);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_setstate
+ *
+ * Description:
+ *   Move a Neighbor Table entry to a new state at time 'now'.
+ *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
+ ****************************************************************************/
+
+void neighbor_setstate(FAR struct neighbor_table_s *neighbor, uint8_t state,
+                       clock_t now);
+
+/****************************************************************************
+ * Name: neighbor_age
+ *
+ * Description:
+ *   Bring the state of a used entry up to date:  A reachable entry that has
+ *   not been confirmed for CONFIG_NET_IPv6_NCONF_REACHABLE seconds becomes
+ *   stale.
+ *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
+ ****************************************************************************/
+
+void neighbor_age(FAR struct neighbor_table_s *neighbor, clock_t now);
+
+/****************************************************************************
+ * Name: neighbor_freeentry
+ *
+ * Description:
+ *   Return a Neighbor Table entry to the unused state.
+ *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
+ ****************************************************************************/
+
+void neighbor_freeentry(FAR struct neighbor_table_s *neighbor);
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
  * Description:
- *   Find an entry in the Neighbor Table.  This interface is internal to
- *   the neighbor implementation; Consider using neighbor_lookup() instead;
+ *   Find an entry in the Neighbor Table, whatever its state.  This
+ *   interface is internal to the neighbor implementation; Consider using
+ *   neighbor_lookup() instead;
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address to use in the lookup;
@@ -67,21 +165,30 @@ struct net_driver_s; /* Forward reference */
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
  *   returned if there is no matching entry in the Neighbor Table.
  *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
  ****************************************************************************/
 
-FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
+FAR struct neighbor_table_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
 /****************************************************************************
  * Name: neighbor_add
  *
  * Description:
  *   Add the new address association to the Neighbor Table (if it is not
- *   already there).
+ *   already there), following the rules of RFC 4861, section 7.2.5:  A
+ *   solicited advertisement makes the entry reachable, any other new or
+ *   changed link layer address makes it stale.  Without the Override flag,
+ *   a different link layer address does not replace a known one.
  *
  * Input Parameters:
  *   dev    - Driver instance associated with the MAC
  *   ipaddr - The IPv6 address of the mapping.
  *   addr   - The link layer address of the mapping
+ *   flags  - ICMPv6_NADV_FLAG_S and ICMPv6_NADV_FLAG_O of a Neighbor
+ *            Advertisement.  A Neighbor Solicitation or a Router
+ *            Advertisement carries ICMPv6_NADV_FLAG_O only.
  *
  * Returned Value:
  *   None
@@ -89,7 +196,28 @@ FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
  ****************************************************************************/
 
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
-                  FAR uint8_t *addr);
+                  FAR uint8_t *addr, uint8_t flags);
+
+/****************************************************************************
+ * Name: neighbor_reserve
+ *
+ * Description:
+ *   Record that the link layer address of 'ipaddr' is being asked for with
+ *   a Neighbor Solicitation.  A new entry is created in the INCOMPLETE
+ *   state; an existing entry is not modified.  Incomplete entries are not
+ *   used by neighbor_lookup() and are the first ones to be replaced.
+ *
+ * Input Parameters:
+ *   dev    - The device that sends the solicitation
+ *   ipaddr - The IPv6 address being solicited
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_reserve(FAR struct net_driver_s *dev,
+                      FAR const net_ipv6addr_t ipaddr);
 
 /****************************************************************************
  * Name:  neighbor_lookup
@@ -117,9 +245,9 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
  * Name: neighbor_update
  *
  * Description:
- *   Reset time on the Neighbor Table entry associated with the IPv6 address.
- *   This makes the associated entry the most recently used and not a
- *   candidate for removal.
+ *   Confirm the reachability of the neighbor with this IPv6 address, e.g.
+ *   on a hint from an upper layer protocol.  The entry becomes reachable
+ *   again and is the last candidate for removal.
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address of the entry to be updated
@@ -162,6 +290,47 @@ void neighbor_update(const net_ipv6addr_t ipaddr);
 void neighbor_ethernet_out(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: neighbor_poll
+ *
+ * Description:
+ *   Send the next unicast Neighbor Solicitation that is due for an entry in
+ *   the PROBE state on this device, and remove the entries whose probes
+ *   were all left unanswered.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure being polled
+ *   callback - The driver callback to send the solicitation
+ *
+ * Returned Value:
+ *   The return value of the callback; zero if nothing was sent.
+ *
+ * Assumptions:
+ *   This function is called from devif_poll() with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ICMPv6
+int neighbor_poll(FAR struct net_driver_s *dev,
+                  devif_poll_callback_t callback);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_cleanup
+ *
+ * Description:
+ *   Remove all the Neighbor Table entries of a device.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_cleanup(FAR struct net_driver_s *dev);
+
 /****************************************************************************
  * Name: neighbor_snapshot
  *
@@ -177,9 +346,6 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev);
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
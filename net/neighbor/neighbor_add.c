@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
@@ -33,11 +34,113 @@
 
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/icmpv6.h>
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_rank
+ *
+ * Description:
+ *   Return the eviction rank of an entry;  the lowest rank is replaced
+ *   first:  Unused entries, then incomplete, stale and finally the entries
+ *   in use.
+ *
+ ****************************************************************************/
+
+static int neighbor_rank(FAR struct neighbor_table_s *neighbor, clock_t now)
+{
+  if (net_ipv6addr_cmp(neighbor->entry.ne_ipaddr, g_ipv6_unspecaddr))
+    {
+      return 0;
+    }
+
+  neighbor_age(neighbor, now);
+  switch (neighbor->entry.ne_state)
+    {
+      case NEIGHBOR_STATE_INCOMPLETE:
+        return 1;
+
+      case NEIGHBOR_STATE_STALE:
+        return 2;
+
+      default:
+        return 3;
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_allocentry
+ *
+ * Description:
+ *   Return the entry of 'ipaddr', or replace the entry to be evicted first
+ *   with a new entry for it.  The caller is responsible for the state and
+ *   the link layer address of a new entry.
+ *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
+ ****************************************************************************/
+
+static FAR struct neighbor_table_s *
+neighbor_allocentry(FAR struct net_driver_s *dev,
+                    FAR const net_ipv6addr_t ipaddr, clock_t now,
+                    FAR bool *found)
+{
+  FAR struct neighbor_table_s *neighbor;
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+  FAR struct neighbor_table_s **head;
+#endif
+  int rank;
+  int i;
+
+  neighbor = neighbor_findentry(ipaddr);
+  *found = neighbor != NULL;
+  if (neighbor != NULL)
+    {
+      return neighbor;
+    }
+
+  /* Not in the table: Pick the entry to replace, the oldest one within the
+   * lowest rank.  This walk is only needed for new neighbors.
+   */
+
+  neighbor = &g_neighbors[0];
+  rank     = neighbor_rank(neighbor, now);
+
+  for (i = 1; i < CONFIG_NET_IPv6_NCONF_ENTRIES && rank > 0; ++i)
+    {
+      FAR struct neighbor_table_s *candidate = &g_neighbors[i];
+      int crank = neighbor_rank(candidate, now);
+      sclock_t delta = candidate->entry.ne_time - neighbor->entry.ne_time;
+
+      if (crank < rank || (crank == rank && delta < 0))
+        {
+          neighbor = candidate;
+          rank     = crank;
+        }
+    }
+
+  neighbor_freeentry(neighbor);
+  net_ipv6addr_copy(neighbor->entry.ne_ipaddr, ipaddr);
+  neighbor->dev = dev;
+
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+  head            = neighbor_hash(ipaddr);
+  neighbor->hnext = *head;
+  *head           = neighbor;
+#endif
+
+  return neighbor;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -47,12 +150,18 @@
  *
  * Description:
  *   Add the new address association to the Neighbor Table (if it is not
- *   already there).
+ *   already there), following the rules of RFC 4861, section 7.2.5:  A
+ *   solicited advertisement makes the entry reachable, any other new or
+ *   changed link layer address makes it stale.  Without the Override flag,
+ *   a different link layer address does not replace a known one.
  *
  * Input Parameters:
  *   dev    - Driver instance associated with the MAC
  *   ipaddr - The IPv6 address of the mapping.
  *   addr   - The link layer address of the mapping
+ *   flags  - ICMPv6_NADV_FLAG_S and ICMPv6_NADV_FLAG_O of a Neighbor
+ *            Advertisement.  A Neighbor Solicitation or a Router
+ *            Advertisement carries ICMPv6_NADV_FLAG_O only.
  *
  * Returned Value:
  *   None
@@ -60,55 +169,96 @@
  ****************************************************************************/
 
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
-                  FAR uint8_t *addr)
+                  FAR uint8_t *addr, uint8_t flags)
 {
-  uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
+  FAR struct neighbor_table_s *neighbor;
+  clock_t now = clock_systime_ticks();
+  uint8_t llsize;
+  bool changed;
+  bool found;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  nxmutex_lock(&g_neighbor_lock);
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  neighbor = neighbor_allocentry(dev, ipaddr, now, &found);
+  llsize   = netdev_lladdrsize(dev);
+  changed  = !found ||
+             neighbor->entry.ne_state == NEIGHBOR_STATE_INCOMPLETE ||
+             neighbor->entry.ne_addr.na_lltype != dev->d_lltype ||
+             memcmp(&neighbor->entry.ne_addr.u, addr, llsize) != 0;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  if (changed && found &&
+      neighbor->entry.ne_state != NEIGHBOR_STATE_INCOMPLETE &&
+      (flags & ICMPv6_NADV_FLAG_O) == 0)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      /* Keep the known address, but it is no longer to be trusted */
+
+      neighbor_age(neighbor, now);
+      if (neighbor->entry.ne_state == NEIGHBOR_STATE_REACHABLE)
+        {
+          neighbor_setstate(neighbor, NEIGHBOR_STATE_STALE, now);
+        }
+    }
+  else
+    {
+      if (changed)
         {
-          oldest_ndx = i;
-          break;
+          neighbor->dev                     = dev;
+          neighbor->entry.ne_addr.na_lltype = dev->d_lltype;
+          neighbor->entry.ne_addr.na_llsize = llsize;
+          memcpy(&neighbor->entry.ne_addr.u, addr, llsize);
         }
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+      if ((flags & ICMPv6_NADV_FLAG_S) != 0)
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          neighbor_setstate(neighbor, NEIGHBOR_STATE_REACHABLE, now);
+        }
+      else if (changed)
+        {
+          neighbor_setstate(neighbor, NEIGHBOR_STATE_STALE, now);
         }
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  /* Dump the contents of the new entry */
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor_dumpentry("Added entry", &neighbor->entry);
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  nxmutex_unlock(&g_neighbor_lock);
+}
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+/****************************************************************************
+ * Name: neighbor_reserve
+ *
+ * Description:
+ *   Record that the link layer address of 'ipaddr' is being asked for with
+ *   a Neighbor Solicitation.  A new entry is created in the INCOMPLETE
+ *   state; an existing entry is not modified.  Incomplete entries are not
+ *   used by neighbor_lookup() and are the first ones to be replaced.
+ *
+ * Input Parameters:
+ *   dev    - The device that sends the solicitation
+ *   ipaddr - The IPv6 address being solicited
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
 
-  /* Dump the contents of the new entry */
+void neighbor_reserve(FAR struct net_driver_s *dev,
+                      FAR const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_table_s *neighbor;
+  clock_t now = clock_systime_ticks();
+  bool found;
+
+  nxmutex_lock(&g_neighbor_lock);
+
+  neighbor = neighbor_allocentry(dev, ipaddr, now, &found);
+  if (!found)
+    {
+      neighbor_setstate(neighbor, NEIGHBOR_STATE_INCOMPLETE, now);
+    }
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  nxmutex_unlock(&g_neighbor_lock);
 }
@@ -120,12 +120,13 @@ static void neighbor_dump_address(FAR const void *buf, unsigned int buflen)
 void neighbor_dumpentry(FAR const char *msg,
                         FAR struct neighbor_entry_s *neighbor)
 {
-  ninfo("%s: %04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
+  ninfo("%s: %04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x state %u\n",
         msg,
         NTOHS(neighbor->ne_ipaddr[0]), NTOHS(neighbor->ne_ipaddr[1]),
         NTOHS(neighbor->ne_ipaddr[2]), NTOHS(neighbor->ne_ipaddr[3]),
         NTOHS(neighbor->ne_ipaddr[4]), NTOHS(neighbor->ne_ipaddr[5]),
-        NTOHS(neighbor->ne_ipaddr[6]), NTOHS(neighbor->ne_ipaddr[7]));
+        NTOHS(neighbor->ne_ipaddr[6]), NTOHS(neighbor->ne_ipaddr[7]),
+        neighbor->ne_state);
 
   neighbor_dump_address(&neighbor->ne_addr.u,
                         neighbor->ne_addr.na_llsize);
@@ -174,7 +174,7 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
            * message.
            */
 
-          icmpv6_solicit(dev, ipaddr);
+          icmpv6_solicit(dev, ipaddr, NULL);
 #else
           /* What to do here? We need the laddr, but no way to get it. */
 
@@ -37,8 +37,9 @@
  * Name: neighbor_findentry
  *
  * Description:
- *   Find an entry in the Neighbor Table.  This interface is internal to
- *   the neighbor implementation; Consider using neighbor_lookup() instead;
+ *   Find an entry in the Neighbor Table, whatever its state.  This
+ *   interface is internal to the neighbor implementation; Consider using
+ *   neighbor_lookup() instead;
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address to use in the lookup;
@@ -47,22 +48,38 @@
  *   The Neighbor Table entry corresponding to the IPv6 address;  NULL is
  *   returned if there is no matching entry in the Neighbor Table.
  *
+ * Assumptions:
+ *   The caller holds g_neighbor_lock.
+ *
  ****************************************************************************/
 
-FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
+FAR struct neighbor_table_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
+  FAR struct neighbor_table_s *neighbor;
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+
+  for (neighbor = *neighbor_hash(ipaddr); neighbor != NULL;
+       neighbor = neighbor->hnext)
+    {
+      if (net_ipv6addr_cmp(neighbor->entry.ne_ipaddr, ipaddr))
+        {
+          neighbor_dumpentry("Entry found", &neighbor->entry);
+          return neighbor;
+        }
+    }
+#else
   int i;
 
   for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
+      neighbor = &g_neighbors[i];
+      if (net_ipv6addr_cmp(neighbor->entry.ne_ipaddr, ipaddr))
         {
-          neighbor_dumpentry("Entry found", neighbor);
+          neighbor_dumpentry("Entry found", &neighbor->entry);
           return neighbor;
         }
     }
+#endif
 
   neighbor_dumpipaddr("Not found", ipaddr);
   return NULL;
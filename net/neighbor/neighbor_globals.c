@@ -24,18 +24,142 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+#include <string.h>
+
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  g_neighbor_lock must be held when accessing
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct neighbor_table_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+/* The used entries of g_neighbors hashed by their IPv6 address */
+
+FAR struct neighbor_table_s *
+g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+#endif
+
+/* The number of entries in the PROBE state, so that neighbor_poll() needs
+ * not walk the table when none is being probed.
+ */
+
+unsigned int g_neighbor_nprobes;
+
+/* Protects g_neighbors independently of the network lock.  The network lock
+ * must never be taken while this lock is held.
+ */
+
+mutex_t g_neighbor_lock = NXMUTEX_INITIALIZER;
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the head of the hash chain of the IPv6 address 'ipaddr'.  The
+ *   hash is taken over the interface identifier, which is what differs
+ *   between the neighbors of one link.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+FAR struct neighbor_table_s **neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash = ((uint32_t)ipaddr[4] << 16 | ipaddr[5]) ^
+                  ((uint32_t)ipaddr[6] << 16 | ipaddr[7]);
+
+  hash *= 2654435761u;
+  return &g_neighbor_hash[(hash >> 16) % CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+}
+#endif
+
+/****************************************************************************
+ * Name: neighbor_setstate
+ *
+ * Description:
+ *   Move a Neighbor Table entry to a new state at time 'now'.
+ *
+ ****************************************************************************/
+
+void neighbor_setstate(FAR struct neighbor_table_s *neighbor, uint8_t state,
+                       clock_t now)
+{
+  if (neighbor->entry.ne_state == NEIGHBOR_STATE_PROBE)
+    {
+      g_neighbor_nprobes--;
+    }
+
+  if (state == NEIGHBOR_STATE_PROBE)
+    {
+      g_neighbor_nprobes++;
+      neighbor->probes = 0;
+    }
+
+  neighbor->entry.ne_state = state;
+  neighbor->entry.ne_time  = now;
+}
+
+/****************************************************************************
+ * Name: neighbor_age
+ *
+ * Description:
+ *   Bring the state of a used entry up to date:  A reachable entry that has
+ *   not been confirmed for CONFIG_NET_IPv6_NCONF_REACHABLE seconds becomes
+ *   stale.  It keeps the time of its confirmation.
+ *
+ ****************************************************************************/
+
+void neighbor_age(FAR struct neighbor_table_s *neighbor, clock_t now)
+{
+  if (neighbor->entry.ne_state == NEIGHBOR_STATE_REACHABLE &&
+      now - neighbor->entry.ne_time > NEIGHBOR_REACHABLE_TICK)
+    {
+      neighbor->entry.ne_state = NEIGHBOR_STATE_STALE;
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_freeentry
+ *
+ * Description:
+ *   Return a Neighbor Table entry to the unused state.
+ *
+ ****************************************************************************/
+
+void neighbor_freeentry(FAR struct neighbor_table_s *neighbor)
+{
+  if (!net_ipv6addr_cmp(neighbor->entry.ne_ipaddr, g_ipv6_unspecaddr))
+    {
+#if CONFIG_NET_IPv6_NCONF_HASH_SIZE > 0
+      FAR struct neighbor_table_s **link;
+
+      for (link = neighbor_hash(neighbor->entry.ne_ipaddr); *link != NULL;
+           link = &(*link)->hnext)
+        {
+          if (*link == neighbor)
+            {
+              *link = neighbor->hnext;
+              break;
+            }
+        }
+#endif
+
+      if (neighbor->entry.ne_state == NEIGHBOR_STATE_PROBE)
+        {
+          g_neighbor_nprobes--;
+        }
+    }
+
+  memset(neighbor, 0, sizeof(*neighbor));
+}
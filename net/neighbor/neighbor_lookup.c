@@ -96,6 +96,11 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
  *
  * Description:
  *   Find an entry in the Neighbor Table and return its link layer address.
+ *   This is a use of the entry in the sense of RFC 4861, section 7.3.3:
+ *   A stale entry enters the DELAY state, and an entry still delayed after
+ *   DELAY_FIRST_PROBE_TIME enters the PROBE state, in which neighbor_poll()
+ *   verifies the cached address.  The address is returned in all of these
+ *   states, but not while the entry is incomplete.
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address to use in the lookup;
@@ -113,30 +118,51 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
 int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
                     FAR struct neighbor_addr_s *laddr)
 {
-  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_table_s *neighbor;
   struct neighbor_table_info_s info;
 
   /* Check if the IPv6 address is already in the neighbor table. */
 
+  nxmutex_lock(&g_neighbor_lock);
+
   neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  if (neighbor != NULL &&
+      neighbor->entry.ne_state != NEIGHBOR_STATE_INCOMPLETE)
     {
+      clock_t now = clock_systime_ticks();
+
+      /* Start the unreachability detection of an unconfirmed entry */
+
+      neighbor_age(neighbor, now);
+      if (neighbor->entry.ne_state == NEIGHBOR_STATE_STALE)
+        {
+          neighbor_setstate(neighbor, NEIGHBOR_STATE_DELAY, now);
+        }
+      else if (neighbor->entry.ne_state == NEIGHBOR_STATE_DELAY &&
+               now - neighbor->entry.ne_time >= NEIGHBOR_DELAY_TICK)
+        {
+          neighbor_setstate(neighbor, NEIGHBOR_STATE_PROBE, now);
+        }
+
       /* Yes.. return the link layer address if the caller has provided a
        * non-NULL address in 'laddr'.
        */
 
       if (laddr != NULL)
         {
-          memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
+          memcpy(laddr, &neighbor->entry.ne_addr, sizeof(*laddr));
         }
 
       /* Return success in any case meaning that a valid link layer
        * address mapping is available for the IPv6 address.
        */
 
+      nxmutex_unlock(&g_neighbor_lock);
       return OK;
     }
 
+  nxmutex_unlock(&g_neighbor_lock);
+
   /* No.. check if the IPv6 address is the address assigned to a local
    * network device.  If so, return a mapping of that IPv6 address
    * to the linker layer address assigned to the network device.
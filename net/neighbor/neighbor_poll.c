@@ -0,0 +1,139 @@
+/****************************************************************************
+ * net/neighbor/neighbor_poll.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/net/netdev.h>
+
+#include "icmpv6/icmpv6.h"
+#include "neighbor/neighbor.h"
+
+#ifdef CONFIG_NET_ICMPv6
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_probe_due
+ *
+ * Description:
+ *   Find an entry of 'dev' in the PROBE state whose next probe is due and
+ *   return its address in 'ipaddr'.  The entries that exhausted their
+ *   probes are removed on the way.
+ *
+ ****************************************************************************/
+
+static bool neighbor_probe_due(FAR struct net_driver_s *dev,
+                               FAR net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_table_s *neighbor;
+  clock_t now = clock_systime_ticks();
+  bool due = false;
+  int i;
+
+  nxmutex_lock(&g_neighbor_lock);
+
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES && !due; i++)
+    {
+      neighbor = &g_neighbors[i];
+      if (neighbor->entry.ne_state != NEIGHBOR_STATE_PROBE ||
+          neighbor->dev != dev ||
+          (neighbor->probes > 0 &&
+           now - neighbor->entry.ne_time < NEIGHBOR_RETRANS_TICK))
+        {
+          continue;
+        }
+
+      if (neighbor->probes >= NEIGHBOR_MAX_PROBES)
+        {
+          /* None of the probes was answered: The neighbor is gone */
+
+          neighbor_dumpentry("Unreachable", &neighbor->entry);
+          neighbor_freeentry(neighbor);
+          continue;
+        }
+
+      neighbor->probes++;
+      neighbor->entry.ne_time = now;
+      net_ipv6addr_copy(ipaddr, neighbor->entry.ne_ipaddr);
+      due = true;
+    }
+
+  nxmutex_unlock(&g_neighbor_lock);
+  return due;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_poll
+ *
+ * Description:
+ *   Send the next unicast Neighbor Solicitation that is due for an entry in
+ *   the PROBE state on this device, and remove the entries whose probes
+ *   were all left unanswered.  The packets to the neighbor are still sent
+ *   to the cached address meanwhile.
+ *
+ * Input Parameters:
+ *   dev      - The device driver structure being polled
+ *   callback - The driver callback to send the solicitation
+ *
+ * Returned Value:
+ *   The return value of the callback; zero if nothing was sent.
+ *
+ * Assumptions:
+ *   This function is called from devif_poll() with the network locked.
+ *
+ ****************************************************************************/
+
+int neighbor_poll(FAR struct net_driver_s *dev,
+                  devif_poll_callback_t callback)
+{
+  net_ipv6addr_t ipaddr;
+
+  /* Nothing to do unless some neighbor is being probed */
+
+  if (g_neighbor_nprobes == 0 || !neighbor_probe_due(dev, ipaddr))
+    {
+      return 0;
+    }
+
+  dev->d_len    = 0;
+  dev->d_sndlen = 0;
+
+  icmpv6_solicit(dev, ipaddr, ipaddr);
+  IFF_SET_IPv6(dev->d_flags);
+
+  /* Call back into the driver */
+
+  return callback(dev);
+}
+
+#endif /* CONFIG_NET_ICMPv6 */
@@ -53,9 +53,6 @@
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
@@ -66,11 +63,13 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
 
   /* Copy all non-empty entries in the Neighbor table. */
 
+  nxmutex_lock(&g_neighbor_lock);
+
   for (i = 0, ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
        i++)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i].entry;
 
       /* An unused entry table entry will be nullified.  In particularly,
        * the Neighbor IP address will be all zero (i.e., the unspecified
@@ -85,6 +84,8 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
         }
     }
 
+  nxmutex_unlock(&g_neighbor_lock);
+
   /* Return the number of entries copied into the user buffer */
 
   return ncopied;
@@ -34,9 +34,10 @@
  * Name: neighbor_update
  *
  * Description:
- *   Reset time on the Neighbor Table entry associated with the IPv6 address.
- *   This makes the associated entry the most recently used and not a
- *   candidate for removal.
+ *   Confirm the reachability of the neighbor with this IPv6 address, e.g.
+ *   on a hint from an upper layer protocol.  The entry becomes reachable
+ *   again and is the last candidate for removal.  An incomplete entry has
+ *   no link layer address to confirm and is not modified.
  *
  * Input Parameters:
  *   ipaddr - The IPv6 address of the entry to be updated
@@ -48,11 +49,17 @@
 
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
-  struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_table_s *neighbor;
+
+  nxmutex_lock(&g_neighbor_lock);
 
   neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  if (neighbor != NULL &&
+      neighbor->entry.ne_state != NEIGHBOR_STATE_INCOMPLETE)
     {
-      neighbor->ne_time = clock_systime_ticks();
+      neighbor_setstate(neighbor, NEIGHBOR_STATE_REACHABLE,
+                        clock_systime_ticks());
     }
+
+  nxmutex_unlock(&g_neighbor_lock);
 }
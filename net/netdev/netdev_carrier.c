@@ -38,6 +38,7 @@
 #include "netdev/netdev.h"
 #include "netlink/netlink.h"
 #include "arp/arp.h"
+#include "neighbor/neighbor.h"
 
 /****************************************************************************
  * Public Functions
@@ -96,6 +97,9 @@ int netdev_carrier_off(FAR struct net_driver_s *dev)
 
       devif_dev_event(dev, NETDEV_DOWN);
       arp_cleanup(dev);
+#ifdef CONFIG_NET_IPv6
+      neighbor_cleanup(dev);
+#endif
 
       return OK;
     }
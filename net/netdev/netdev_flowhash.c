@@ -0,0 +1,199 @@
+/****************************************************************************
+ * net/netdev/netdev_flowhash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_MULTIQUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IP_MF          0x20  /* More fragments flag in ipoffset[0] */
+#define IP_OFFMASK0    0x1f  /* Fragment offset bits in ipoffset[0] */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_hashmix
+ ****************************************************************************/
+
+static uint32_t netdev_hashmix(uint32_t hash, uint32_t value)
+{
+  hash ^= value * 0xcc9e2d51u;
+  hash  = (hash << 13) | (hash >> 19);
+  return hash * 5 + 0xe6546b64u;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_flowhash
+ *
+ * Description:
+ *   Hash the remote address and the ports of a flow.  The same flow gives
+ *   the same hash whether it is computed from a connection or from a
+ *   received packet.
+ *
+ * Input Parameters:
+ *   raddr   - The remote IP address, in network order
+ *   addrlen - The size of the address: 4 (IPv4) or 16 (IPv6)
+ *   lport   - The local port, in network order (zero if none)
+ *   rport   - The remote port, in network order (zero if none)
+ *
+ * Returned Value:
+ *   The hash of the flow
+ *
+ ****************************************************************************/
+
+uint32_t netdev_flowhash(FAR const void *raddr, size_t addrlen,
+                         uint16_t lport, uint16_t rport)
+{
+  FAR const uint8_t *ptr = raddr;
+  uint32_t hash = 0;
+  uint32_t word;
+
+  for (; addrlen >= sizeof(word); addrlen -= sizeof(word))
+    {
+      memcpy(&word, ptr, sizeof(word));
+      hash = netdev_hashmix(hash, word);
+      ptr += sizeof(word);
+    }
+
+  hash = netdev_hashmix(hash, ((uint32_t)lport << 16) | rport);
+
+  /* Final avalanche, so that the low bits used to select the queue depend
+   * on all of the input.
+   */
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/****************************************************************************
+ * Name: netdev_rxqueue
+ *
+ * Description:
+ *   Select the queue that should process the packet in d_buf, for drivers
+ *   whose hardware does not steer the received packets by itself.  IPv4
+ *   and IPv6 packets are spread over the queues by flow, TCP and UDP
+ *   packets including the ports.  All other packets go to queue 0.
+ *
+ * Input Parameters:
+ *   dev - The device that received the packet in d_buf (d_len bytes)
+ *
+ * Returned Value:
+ *   The queue index, 0 to d_nqueues - 1
+ *
+ ****************************************************************************/
+
+int netdev_rxqueue(FAR struct net_driver_s *dev)
+{
+  FAR const uint8_t *ip = &dev->d_buf[NET_LL_HDRLEN(dev)];
+  FAR const uint8_t *raddr = NULL;
+  FAR const uint16_t *ports = NULL;
+  size_t addrlen = 0;
+  unsigned int len;
+
+  if (dev->d_nqueues <= 1 || dev->d_len <= NET_LL_HDRLEN(dev))
+    {
+      return 0;
+    }
+
+  len = dev->d_len - NET_LL_HDRLEN(dev);
+
+#ifdef CONFIG_NET_IPv4
+  if ((ip[0] & 0xf0) == 0x40 && len >= IPv4_HDRLEN)
+    {
+      FAR const struct ipv4_hdr_s *ipv4 =
+        (FAR const struct ipv4_hdr_s *)ip;
+      unsigned int hdrlen;
+
+      raddr   = (FAR const uint8_t *)ipv4->srcipaddr;
+      addrlen = sizeof(ipv4->srcipaddr);
+      hdrlen  = (ipv4->vhl & 0x0f) << 2;
+
+      /* Only the first fragment carries the ports; leave them out of the
+       * hash of all the fragments.
+       */
+
+      if ((ipv4->proto == IP_PROTO_TCP || ipv4->proto == IP_PROTO_UDP) &&
+          (ipv4->ipoffset[0] & (IP_MF | IP_OFFMASK0)) == 0 &&
+          ipv4->ipoffset[1] == 0 && len >= hdrlen + 4)
+        {
+          ports = (FAR const uint16_t *)(ip + hdrlen);
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((ip[0] & 0xf0) == 0x60 && len >= IPv6_HDRLEN)
+    {
+      FAR const struct ipv6_hdr_s *ipv6 =
+        (FAR const struct ipv6_hdr_s *)ip;
+
+      raddr   = (FAR const uint8_t *)ipv6->srcipaddr;
+      addrlen = sizeof(ipv6->srcipaddr);
+
+      /* Packets with extension headers are hashed on the address only */
+
+      if ((ipv6->proto == IP_PROTO_TCP || ipv6->proto == IP_PROTO_UDP) &&
+          len >= IPv6_HDRLEN + 4)
+        {
+          ports = (FAR const uint16_t *)(ip + IPv6_HDRLEN);
+        }
+    }
+#endif
+
+  if (raddr == NULL)
+    {
+      return 0;
+    }
+
+  /* The source of a received packet is the remote end of the flow */
+
+  return netdev_flowqueue(dev,
+                          netdev_flowhash(raddr, addrlen,
+                                          ports != NULL ? ports[1] : 0,
+                                          ports != NULL ? ports[0] : 0));
+}
+
+#endif /* CONFIG_NETDEV_MULTIQUEUE */
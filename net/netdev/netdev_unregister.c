@@ -37,6 +37,7 @@
 
 #include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -143,6 +144,10 @@ int netdev_unregister(FAR struct net_driver_s *dev)
             }
 
           curr->flink = NULL;
+
+          /* Forget the flows forwarded on the device */
+
+          ipfwd_flushflows();
         }
 
 #ifdef CONFIG_NETDEV_IFINDEX
@@ -575,12 +575,17 @@ static int netlink_get_ipv4route(NETLINK_HANDLE handle,
   struct nlroute_info_s info;
   int ret;
 
-  /* Visit each routing table entry */
+  /* Visit each routing table entry.  The handler takes the network lock
+   * and the network lock must be taken before the routing table lock.
+   */
 
   info.handle = handle;
   info.req    = req;
 
+  net_lock();
   ret = net_foreachroute_ipv4(netlink_ipv4_route, &info);
+  net_unlock();
+
   if (ret < 0)
     {
       return ret;
@@ -668,12 +673,17 @@ static int netlink_get_ip6vroute(NETLINK_HANDLE handle,
   struct nlroute_info_s info;
   int ret;
 
-  /* Visit each routing table entry */
+  /* Visit each routing table entry.  The handler takes the network lock
+   * and the network lock must be taken before the routing table lock.
+   */
 
   info.handle = handle;
   info.req    = req;
 
+  net_lock();
   ret = net_foreachroute_ipv6(netlink_ipv6_route, &info);
+  net_unlock();
+
   if (ret < 0)
     {
       return ret;
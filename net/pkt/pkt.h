@@ -49,9 +49,23 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* A memory-mapped ring of frames (see include/netpacket/packet.h) */
+
+#ifdef CONFIG_NET_PKT_MMAP
+struct pkt_ring_s
+{
+  FAR uint8_t *pr_base;      /* First frame; NULL until mapped */
+  uint32_t     pr_framesize; /* Distance between two frames */
+  uint32_t     pr_framenr;   /* Number of frames; zero: no ring */
+  uint32_t     pr_head;      /* Next frame to fill (RX) or to send (TX) */
+  bool         pr_losing;    /* RX:  Frames were dropped on a full ring */
+};
+#endif
+
 /* Representation of a packet socket connection */
 
 struct devif_callback_s; /* Forward reference */
+struct pollfd;           /* Forward reference */
 
 struct pkt_conn_s
 {
@@ -65,6 +79,17 @@ struct pkt_conn_s
   uint8_t    ifindex;
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
+
+#ifdef CONFIG_NET_PKT_MMAP
+  /* Memory-mapped rings.  Both live in one allocation, made when the
+   * application maps them.
+   */
+
+  FAR uint8_t       *ringmem; /* Memory of both rings; NULL: not mapped */
+  struct pkt_ring_s  rxring;  /* Receive ring */
+  struct pkt_ring_s  txring;  /* Transmit ring */
+  FAR struct pollfd *pollfd;  /* Poll waiter on the rings */
+#endif
 };
 
 /****************************************************************************
@@ -284,6 +309,130 @@ void pkt_poll(FAR struct net_driver_s *dev, FAR struct pkt_conn_s *conn);
 ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.  PACKET_RX_RING and
+ *   PACKET_TX_RING set the geometry of the memory-mapped rings; they must
+ *   be set before the rings are mapped.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_map
+ *
+ * Description:
+ *   Allocate the rings set up with PACKET_RX_RING and PACKET_TX_RING and
+ *   return their address for mmap() (FIOC_MMAP).  Once mapped, received
+ *   frames are stored in the receive ring instead of being passed to
+ *   recvmsg().
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   addr - The location to return the address of the rings
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+int pkt_ring_map(FAR struct pkt_conn_s *conn, FAR void **addr);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Free the rings of a packet socket connection when it is closed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+void pkt_ring_release(FAR struct pkt_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Store a received frame in the next frame of the receive ring and
+ *   notify the poll waiter.  The frame is dropped if the ring is full.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received packet
+ *   conn - The packet socket connection with a mapped receive ring
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send the frames queued in the transmit ring with
+ *   TP_STATUS_SEND_REQUEST, in ring order, and wait until they are sent.
+ *   This is what send() without data does on a socket with a mapped
+ *   transmit ring.
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure if nothing
+ *   was sent.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+ssize_t pkt_ring_send(FAR struct socket *psock);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down the poll of a socket with mapped rings:  POLLIN
+ *   while the receive ring holds frames for the application, POLLOUT while
+ *   a frame of the transmit ring is available.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSYS if the rings are not mapped; another
+ *   negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_MMAP
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -72,6 +72,16 @@ int pkt_input(struct net_driver_s *dev)
   int ret = OK;
 
   conn = pkt_active(pbuf);
+#ifdef CONFIG_NET_PKT_MMAP
+  if (conn != NULL && conn->rxring.pr_base != NULL)
+    {
+      /* The frame goes to the memory-mapped receive ring */
+
+      pkt_ring_input(dev, conn);
+      return OK;
+    }
+#endif
+
   if (conn)
     {
       uint16_t flags;
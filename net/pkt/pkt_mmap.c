@@ -0,0 +1,634 @@
+/****************************************************************************
+ * net/pkt/pkt_mmap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+#include <assert.h>
+#include <poll.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/arp.h>
+#include <nuttx/net/ethernet.h>
+
+#include "netdev/netdev.h"
+#include "devif/devif.h"
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_MMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Offsets in a frame of the address, of received data and of data to send */
+
+#define PKT_RING_ADDROFF  TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+#define PKT_RING_RXOFF    TPACKET_ALIGN(TPACKET_HDRLEN)
+#define PKT_RING_TXOFF    PKT_RING_ADDROFF
+
+#define PKT_RING_FRAME(r,i) \
+  ((FAR struct tpacket_hdr *)((r)->pr_base + (i) * (r)->pr_framesize))
+
+#define PKTBUF ((FAR struct eth_hdr_s *)dev->d_buf)
+
+/* The status words are volatile.  Without SMP support, no hardware memory
+ * barrier is required in addition.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of pkt_ring_send() while the device sends the frames */
+
+struct pkt_ringsend_s
+{
+  FAR struct pkt_conn_s       *rs_conn;  /* The connection sending */
+  FAR struct devif_callback_s *rs_cb;    /* Reference to callback instance */
+  sem_t                        rs_sem;   /* Signals the end of the send */
+  ssize_t                      rs_sent;  /* The number of bytes sent */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_status
+ *
+ * Description:
+ *   Read or write the status word of a frame, which is shared with the
+ *   application.
+ *
+ ****************************************************************************/
+
+static inline unsigned long pkt_ring_status(FAR struct tpacket_hdr *hdr)
+{
+  return *(FAR volatile unsigned long *)&hdr->tp_status;
+}
+
+static inline void pkt_ring_setstatus(FAR struct tpacket_hdr *hdr,
+                                      unsigned long status)
+{
+  /* The frame contents must be visible before the status word */
+
+  SP_DMB();
+  *(FAR volatile unsigned long *)&hdr->tp_status = status;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_pollnotify
+ *
+ * Description:
+ *   Notify the poll waiter of the rings of new events.
+ *
+ ****************************************************************************/
+
+static void pkt_ring_pollnotify(FAR struct pkt_conn_s *conn,
+                                pollevent_t eventset)
+{
+  FAR struct pollfd *fds = conn->pollfd;
+
+  if (fds != NULL)
+    {
+      eventset &= fds->events;
+      if (eventset != 0)
+        {
+          fds->revents |= eventset;
+          nxsem_post(fds->sem);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_setreq
+ *
+ * Description:
+ *   Validate and save the geometry of a ring.
+ *
+ ****************************************************************************/
+
+static int pkt_ring_setreq(FAR struct pkt_ring_s *ring,
+                           FAR const struct tpacket_req *req)
+{
+  /* No frames:  Remove the ring */
+
+  if (req->tp_frame_nr == 0 || req->tp_block_nr == 0)
+    {
+      ring->pr_framesize = 0;
+      ring->pr_framenr   = 0;
+      return OK;
+    }
+
+  if (req->tp_frame_size < PKT_RING_RXOFF + ETH_HDRLEN ||
+      (req->tp_frame_size % TPACKET_ALIGNMENT) != 0 ||
+      req->tp_block_size < req->tp_frame_size ||
+      (req->tp_block_size % req->tp_frame_size) != 0 ||
+      req->tp_frame_nr != req->tp_block_size / req->tp_frame_size *
+                          req->tp_block_nr)
+    {
+      return -EINVAL;
+    }
+
+  ring->pr_framesize = req->tp_frame_size;
+  ring->pr_framenr   = req->tp_frame_nr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ringsend_eventhandler
+ *
+ * Description:
+ *   Send the next frame of the transmit ring on each poll of the device,
+ *   and wake up the sending thread once no more frames are queued.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static uint16_t pkt_ringsend_eventhandler(FAR struct net_driver_s *dev,
+                                          FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct pkt_ringsend_s *pstate = pvpriv;
+  FAR struct pkt_ring_s *ring;
+  FAR struct tpacket_hdr *hdr;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  /* Wait for the next poll if the device buffer is busy */
+
+  if (dev->d_sndlen > 0 || (flags & PKT_NEWDATA) != 0)
+    {
+      return flags;
+    }
+
+  ring = &pstate->rs_conn->txring;
+  hdr  = PKT_RING_FRAME(ring, ring->pr_head);
+
+  if (pkt_ring_status(hdr) == TP_STATUS_SEND_REQUEST)
+    {
+      if (hdr->tp_len > ring->pr_framesize - PKT_RING_TXOFF ||
+          hdr->tp_len > NETDEV_PKTSIZE(dev))
+        {
+          pkt_ring_setstatus(hdr, TP_STATUS_WRONG_FORMAT);
+        }
+      else
+        {
+          devif_pkt_send(dev, (FAR uint8_t *)hdr + PKT_RING_TXOFF,
+                         hdr->tp_len);
+          pstate->rs_sent += hdr->tp_len;
+
+          /* Make sure no ARP request overwrites this frame.  This flag
+           * will be cleared in arp_out().
+           */
+
+          IFF_SET_NOARP(dev->d_flags);
+          pkt_ring_setstatus(hdr, TP_STATUS_AVAILABLE);
+        }
+
+      ring->pr_head = (ring->pr_head + 1) % ring->pr_framenr;
+      pkt_ring_pollnotify(pstate->rs_conn, POLLOUT);
+
+      hdr = PKT_RING_FRAME(ring, ring->pr_head);
+      if (pkt_ring_status(hdr) == TP_STATUS_SEND_REQUEST)
+        {
+          /* More frames:  Send the next one on the next poll */
+
+          netdev_txnotify_dev(dev);
+          return flags;
+        }
+    }
+
+  /* All queued frames are sent.  Don't allow any further call backs and
+   * wake up the thread.
+   */
+
+  pstate->rs_cb->flags = 0;
+  pstate->rs_cb->priv  = NULL;
+  pstate->rs_cb->event = NULL;
+
+  nxsem_post(&pstate->rs_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.  PACKET_RX_RING and
+ *   PACKET_TX_RING set the geometry of the memory-mapped rings; they must
+ *   be set before the rings are mapped.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn;
+  int ret;
+
+  if (psock->s_domain != PF_PACKET)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (option != PACKET_RX_RING && option != PACKET_TX_RING)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (value == NULL || value_len < sizeof(struct tpacket_req))
+    {
+      return -EINVAL;
+    }
+
+  conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  net_lock();
+  if (conn->ringmem != NULL)
+    {
+      /* The geometry cannot change once the rings are mapped */
+
+      ret = -EBUSY;
+    }
+  else
+    {
+      ret = pkt_ring_setreq(option == PACKET_RX_RING ?
+                            &conn->rxring : &conn->txring,
+                            (FAR const struct tpacket_req *)value);
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_map
+ *
+ * Description:
+ *   Allocate the rings set up with PACKET_RX_RING and PACKET_TX_RING and
+ *   return their address for mmap() (FIOC_MMAP).  Once mapped, received
+ *   frames are stored in the receive ring instead of being passed to
+ *   recvmsg().
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   addr - The location to return the address of the rings
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_ring_map(FAR struct pkt_conn_s *conn, FAR void **addr)
+{
+  size_t rxsize;
+  size_t txsize;
+
+  DEBUGASSERT(conn != NULL && addr != NULL);
+
+  net_lock();
+  if (conn->ringmem == NULL)
+    {
+      rxsize = (size_t)conn->rxring.pr_framesize * conn->rxring.pr_framenr;
+      txsize = (size_t)conn->txring.pr_framesize * conn->txring.pr_framenr;
+      if (rxsize + txsize == 0)
+        {
+          net_unlock();
+          return -EINVAL;
+        }
+
+      /* The memory is shared with the application.  All frames start
+       * with TP_STATUS_KERNEL (RX) or TP_STATUS_AVAILABLE (TX), both zero.
+       */
+
+      conn->ringmem = kumm_zalloc(rxsize + txsize);
+      if (conn->ringmem == NULL)
+        {
+          net_unlock();
+          return -ENOMEM;
+        }
+
+      conn->rxring.pr_base = rxsize > 0 ? conn->ringmem : NULL;
+      conn->txring.pr_base = txsize > 0 ? conn->ringmem + rxsize : NULL;
+    }
+
+  *addr = conn->ringmem;
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Free the rings of a packet socket connection when it is closed.
+ *
+ ****************************************************************************/
+
+void pkt_ring_release(FAR struct pkt_conn_s *conn)
+{
+  if (conn->ringmem != NULL)
+    {
+      kumm_free(conn->ringmem);
+      conn->ringmem        = NULL;
+      conn->rxring.pr_base = NULL;
+      conn->txring.pr_base = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Store a received frame in the next frame of the receive ring and
+ *   notify the poll waiter.  The frame is dropped if the ring is full.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received packet
+ *   conn - The packet socket connection with a mapped receive ring
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  FAR struct tpacket_hdr *hdr;
+  FAR struct sockaddr_ll *addr;
+  struct timespec ts;
+  unsigned long status;
+  size_t snaplen;
+
+  hdr = PKT_RING_FRAME(ring, ring->pr_head);
+  if (pkt_ring_status(hdr) != TP_STATUS_KERNEL)
+    {
+      /* The application did not release the frame yet:  Drop */
+
+      ring->pr_losing = true;
+      NETDEV_RXDROPPED(dev);
+      return;
+    }
+
+  /* Copy the frame, truncated to the size of the slot */
+
+  snaplen = ring->pr_framesize - PKT_RING_RXOFF;
+  if (snaplen > dev->d_len)
+    {
+      snaplen = dev->d_len;
+    }
+
+  memcpy((FAR uint8_t *)hdr + PKT_RING_RXOFF, dev->d_buf, snaplen);
+
+  /* Then the address of the sender */
+
+  addr = (FAR struct sockaddr_ll *)((FAR uint8_t *)hdr + PKT_RING_ADDROFF);
+  memset(addr, 0, sizeof(struct sockaddr_ll));
+  addr->sll_family   = AF_PACKET;
+  addr->sll_protocol = PKTBUF->type;
+  addr->sll_ifindex  = dev->d_ifindex;
+  addr->sll_hatype   = ARPHRD_ETHER;
+  addr->sll_halen    = ETHER_ADDR_LEN;
+  memcpy(addr->sll_addr, PKTBUF->src, ETHER_ADDR_LEN);
+
+  clock_systime_timespec(&ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = snaplen;
+  hdr->tp_mac     = PKT_RING_RXOFF;
+  hdr->tp_net     = PKT_RING_RXOFF + ETH_HDRLEN;
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / NSEC_PER_USEC;
+
+  /* Hand the frame to the application */
+
+  status = TP_STATUS_USER;
+  if (ring->pr_losing)
+    {
+      status |= TP_STATUS_LOSING;
+      ring->pr_losing = false;
+    }
+
+  pkt_ring_setstatus(hdr, status);
+  ring->pr_head = (ring->pr_head + 1) % ring->pr_framenr;
+
+  pkt_ring_pollnotify(conn, POLLIN);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send the frames queued in the transmit ring with
+ *   TP_STATUS_SEND_REQUEST, in ring order, and wait until they are sent.
+ *   This is what send() without data does on a socket with a mapped
+ *   transmit ring.
+ *
+ * Returned Value:
+ *   The number of bytes sent; a negated errno value on failure if nothing
+ *   was sent.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  FAR struct pkt_ring_s *ring = &conn->txring;
+  FAR struct net_driver_s *dev;
+  struct pkt_ringsend_s state;
+  int ret = OK;
+
+  DEBUGASSERT(ring->pr_base != NULL);
+
+  /* Get the device driver that will service this transfer */
+
+  dev = pkt_find_device(conn);
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  net_lock();
+
+  /* Nothing to do if the next frame is not queued */
+
+  if (pkt_ring_status(PKT_RING_FRAME(ring, ring->pr_head)) !=
+      TP_STATUS_SEND_REQUEST)
+    {
+      net_unlock();
+      return 0;
+    }
+
+  memset(&state, 0, sizeof(struct pkt_ringsend_s));
+  state.rs_conn = conn;
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&state.rs_sem, 0, 0);
+  nxsem_set_protocol(&state.rs_sem, SEM_PRIO_NONE);
+
+  state.rs_cb = pkt_callback_alloc(dev, conn);
+  if (state.rs_cb != NULL)
+    {
+      state.rs_cb->flags = PKT_POLL;
+      state.rs_cb->priv  = (FAR void *)&state;
+      state.rs_cb->event = pkt_ringsend_eventhandler;
+
+      /* Notify the device driver that new TX data is available and wait
+       * until all queued frames are sent (or a signal is received).
+       */
+
+      netdev_txnotify_dev(dev);
+      ret = net_lockedwait(&state.rs_sem);
+
+      pkt_callback_free(dev, conn, state.rs_cb);
+    }
+  else
+    {
+      ret = -EBUSY;
+    }
+
+  nxsem_destroy(&state.rs_sem);
+  net_unlock();
+
+  return state.rs_sent > 0 ? state.rs_sent : (ssize_t)ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down the poll of a socket with mapped rings:  POLLIN
+ *   while the receive ring holds frames for the application, POLLOUT while
+ *   a frame of the transmit ring is available.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOSYS if the rings are not mapped; another
+ *   negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup)
+{
+  FAR struct pkt_ring_s *ring;
+  pollevent_t eventset = 0;
+
+  if (conn->ringmem == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  if (!setup)
+    {
+      if (conn->pollfd == fds)
+        {
+          conn->pollfd = NULL;
+        }
+
+      return OK;
+    }
+
+  if (conn->pollfd != NULL)
+    {
+      return -EBUSY;
+    }
+
+  conn->pollfd = fds;
+
+  /* The application consumes the frames in order, so the receive ring
+   * holds frames for it unless the last frame filled was released.
+   */
+
+  ring = &conn->rxring;
+  if (ring->pr_base != NULL)
+    {
+      uint32_t prev = (ring->pr_head + ring->pr_framenr - 1) %
+                      ring->pr_framenr;
+
+      if (pkt_ring_status(PKT_RING_FRAME(ring, prev)) != TP_STATUS_KERNEL)
+        {
+          eventset |= POLLIN;
+        }
+    }
+
+  ring = &conn->txring;
+  if (ring->pr_base == NULL ||
+      pkt_ring_status(PKT_RING_FRAME(ring, ring->pr_head)) ==
+      TP_STATUS_AVAILABLE)
+    {
+      eventset |= POLLOUT;
+    }
+
+  pkt_ring_pollnotify(conn, eventset);
+  return OK;
+}
+
+#endif /* CONFIG_NET_PKT_MMAP */
@@ -155,12 +155,23 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags)
 {
-  FAR const void *buf = msg->msg_iov->iov_base;
-  size_t len = msg->msg_iov->iov_len;
+  FAR const void *buf;
+  size_t len;
   FAR struct net_driver_s *dev;
   struct send_s state;
   int ret = OK;
 
+#ifdef CONFIG_NET_PKT_MMAP
+  /* A send without data flushes the memory-mapped transmit ring */
+
+  if (psock != NULL && psock->s_conn != NULL &&
+      ((FAR struct pkt_conn_s *)psock->s_conn)->txring.pr_base != NULL &&
+      (msg->msg_iovlen == 0 || msg->msg_iov->iov_len == 0))
+    {
+      return pkt_ring_send(psock);
+    }
+#endif
+
   /* Validity check, only single iov supported */
 
   if (msg->msg_iovlen != 1)
@@ -168,6 +179,9 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENOTSUP;
     }
 
+  buf = msg->msg_iov->iov_base;
+  len = msg->msg_iov->iov_len;
+
   if (msg->msg_name != NULL)
     {
       /* pkt_sendto */
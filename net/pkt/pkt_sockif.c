@@ -34,6 +34,7 @@
 
 #include <netpacket/packet.h>
 
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 
@@ -65,6 +66,8 @@ static int        pkt_accept(FAR struct socket *psock,
 static int        pkt_poll_local(FAR struct socket *psock,
                     FAR struct pollfd *fds, bool setup);
 static int        pkt_close(FAR struct socket *psock);
+static int        pkt_ioctl(FAR struct socket *psock, int cmd,
+                    unsigned long arg);
 
 /****************************************************************************
  * Public Data
@@ -84,7 +87,8 @@ const struct sock_intf_s g_pkt_sockif =
   pkt_poll_local,  /* si_poll */
   pkt_sendmsg,     /* si_sendmsg */
   pkt_recvmsg,     /* si_recvmsg */
-  pkt_close        /* si_close */
+  pkt_close,       /* si_close */
+  pkt_ioctl        /* si_ioctl */
 };
 
 /****************************************************************************
@@ -492,7 +496,19 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_MMAP
+  int ret;
+
+  /* Only the memory-mapped rings can be polled */
+
+  net_lock();
+  ret = pkt_ring_poll(psock->s_conn, fds, setup);
+  net_unlock();
+
+  return ret;
+#else
   return -ENOSYS;
+#endif
 }
 
 /****************************************************************************
@@ -530,6 +546,9 @@ static int pkt_close(FAR struct socket *psock)
               /* Yes... free the connection structure */
 
               conn->crefs = 0;          /* No more references on the connection */
+#ifdef CONFIG_NET_PKT_MMAP
+              pkt_ring_release(conn);   /* Free the memory-mapped rings */
+#endif
               pkt_free(psock->s_conn);  /* Free network resources */
             }
           else
@@ -547,6 +566,35 @@ static int pkt_close(FAR struct socket *psock)
     }
 }
 
+/****************************************************************************
+ * Name: pkt_ioctl
+ *
+ * Description:
+ *   This function performs packet socket specific operations:  FIOC_MMAP
+ *   maps the memory-mapped rings.
+ *
+ * Parameters:
+ *   psock    A reference to the socket structure of the socket
+ *   cmd      The ioctl command
+ *   arg      The argument of the ioctl cmd
+ *
+ ****************************************************************************/
+
+static int pkt_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
+{
+  switch (cmd)
+    {
+#ifdef CONFIG_NET_PKT_MMAP
+      case FIOC_MMAP:
+        return pkt_ring_map(psock->s_conn,
+                            (FAR void **)((uintptr_t)arg));
+#endif
+
+      default:
+        return -ENOTTY;
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
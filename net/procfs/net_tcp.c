@@ -31,7 +31,9 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/net/netstats.h>
 
 #include "procfs/procfs.h"
@@ -43,10 +45,16 @@
 
 #ifdef CONFIG_NET_TCP
 
+#ifdef CONFIG_NET_TCP_INFO
+#  define TCP_INFOLEN 48
+#else
+#  define TCP_INFOLEN 0
+#endif
+
 #ifdef CONFIG_NET_IPv6
-#  define TCP_LINELEN 180
+#  define TCP_LINELEN (180 + TCP_INFOLEN)
 #else
-#  define TCP_LINELEN 120
+#  define TCP_LINELEN (120 + TCP_INFOLEN)
 #endif
 
 /****************************************************************************
@@ -60,6 +68,9 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
   int addrlen = (domain == PF_INET) ?
                 INET_ADDRSTRLEN : INET6_ADDRSTRLEN;
   FAR struct tcp_conn_s *conn = NULL;
+#ifdef CONFIG_NET_TCP_INFO
+  struct tcp_info info;
+#endif
   char remote[addrlen + 1];
   char local[addrlen + 1];
   int len = 0;
@@ -133,6 +144,21 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
 #endif
                       (conn->readahead) ? conn->readahead->io_pktlen : 0);
 
+#ifdef CONFIG_NET_TCP_INFO
+      /* The round trip time in ms, the retransmitted segments and the bytes
+       * sent (ACKed) and received.
+       */
+
+      tcp_info_get(conn, &info);
+      len += snprintf(buffer + len, buflen - len,
+                      " %5" PRIu32 " %5" PRIu32
+                      " %10" PRIu64 " %10" PRIu64,
+                      info.tcpi_rtt / USEC_PER_MSEC,
+                      info.tcpi_total_retrans,
+                      info.tcpi_bytes_acked,
+                      info.tcpi_bytes_received);
+#endif
+
       len += snprintf(buffer + len, buflen - len,
                       " %*s:%-6" PRIu16 " %*s:%-6" PRIu16 "\n",
                       (domain == PF_INET6) ? addrlen / 2 : addrlen,
@@ -188,6 +214,10 @@ ssize_t netprocfs_read_tcpstats(FAR struct netprocfs_file_s *priv,
                                           "txsz   "
 #endif
                                           "rxsz "
+#ifdef CONFIG_NET_TCP_INFO
+                                          "  rtt  retr    txbytes"
+                                          "    rxbytes "
+#endif
                                           "%-*s "
                                           "%-*s\n"
                                           ,
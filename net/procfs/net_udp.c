@@ -43,10 +43,16 @@
 
 #ifdef CONFIG_NET_UDP
 
+#ifdef CONFIG_NET_UDP_STATS
+#  define UDP_STATSLEN 56
+#else
+#  define UDP_STATSLEN 0
+#endif
+
 #ifdef CONFIG_NET_IPv6
-#  define UDP_LINELEN 180
+#  define UDP_LINELEN (180 + UDP_STATSLEN)
 #else
-#  define UDP_LINELEN 120
+#  define UDP_LINELEN (120 + UDP_STATSLEN)
 #endif
 
 /****************************************************************************
@@ -124,6 +130,14 @@ static ssize_t netprocfs_udpstats(FAR struct netprocfs_file_s *priv,
 #endif
                       iob_get_queue_size(&conn->readahead));
 
+#ifdef CONFIG_NET_UDP_STATS
+      len += snprintf(buffer + len, buflen - len,
+                      " %8" PRIu32 " %8" PRIu32 " %6" PRIu32
+                      " %10" PRIu64 " %10" PRIu64,
+                      conn->rx_packets, conn->tx_packets, conn->drops,
+                      conn->rx_bytes, conn->tx_bytes);
+#endif
+
       len += snprintf(buffer + len, buflen - len,
                       " %*s:%-6" PRIu16 " %*s:%-6" PRIu16 "\n",
                       (domain == PF_INET6) ? addrlen / 2 : addrlen,
@@ -179,6 +193,10 @@ ssize_t netprocfs_read_udpstats(FAR struct netprocfs_file_s *priv,
                                          "txsz   "
 #endif
                                          "rxsz "
+#ifdef CONFIG_NET_UDP_STATS
+                                         "   rxpkt    txpkt   drop "
+                                         "   rxbytes    txbytes "
+#endif
                                           "%-*s "
                                           "%-*s\n"
                                           ,
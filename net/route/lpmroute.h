@@ -0,0 +1,113 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#ifdef CONFIG_NET_ROUTE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_ROUTE_LPM
+#  define net_lpmroute_ipv4(t,h,a) net_foreachroute_ipv4(h,a)
+#  define net_lpmroute_ipv6(t,h,a) net_foreachroute_ipv6(h,a)
+#  define net_flushlpm_ipv4()
+#  define net_flushlpm_ipv6()
+#endif
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Call 'handler' for the routes of the routing table whose network
+ *   contains 'target', the longest prefix first, until it returns a
+ *   non-zero value.  The routes are found in a longest-prefix match trie
+ *   that is built from the routing table when it is first needed after a
+ *   change.  The handler receives a copy of the route.
+ *
+ *   If the trie cannot be built (out of memory, or a netmask that is not a
+ *   prefix), the routes are passed in the order of net_foreachroute_ipv4/6
+ *   instead.
+ *
+ * Input Parameters:
+ *   target  - The address to look up (network order)
+ *   handler - Will be called for each matching route.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero if no handler returned a non-zero value; otherwise, the value
+ *   returned by the last handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg);
+#else
+#  define net_lpmroute_ipv4(t,h,a) (0)
+#endif
+
+#ifdef CONFIG_NET_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg);
+#else
+#  define net_lpmroute_ipv6(t,h,a) (0)
+#endif
+
+/****************************************************************************
+ * Name: net_flushlpm_ipv4 and net_flushlpm_ipv6
+ *
+ * Description:
+ *   Discard the trie after a change of the routing table.  The next look-up
+ *   rebuilds it.  This may be called with any lock held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void net_flushlpm_ipv4(void);
+#else
+#  define net_flushlpm_ipv4()
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void net_flushlpm_ipv6(void);
+#else
+#  define net_flushlpm_ipv6()
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
+#endif /* CONFIG_NET_ROUTE */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -34,6 +34,8 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "ipforward/ipforward.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -84,6 +86,8 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   nwritten = net_writeroute_ipv4(&fshandle, &route);
 
   net_closeroute_ipv4(&fshandle);
+  net_flushlpm_ipv4();
+  ipfwd_flushflows();
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -118,6 +122,8 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   nwritten = net_writeroute_ipv6(&fshandle, &route);
 
   net_closeroute_ipv6(&fshandle);
+  net_flushlpm_ipv6();
+  ipfwd_flushflows();
   return nwritten >= 0 ? 0 : (int)nwritten;
 }
 #endif
@@ -34,6 +34,8 @@
 
 #include <arch/irq.h>
 
+#include "ipforward/ipforward.h"
+#include "route/lpmroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -77,15 +79,17 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   net_ipv4addr_copy(route->router, router);
   net_ipv4_dumproute("New route", route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv4();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
-  net_unlock();
+  net_unlock_ramroute_ipv4();
+  net_flushlpm_ipv4();
+  ipfwd_flushflows();
   return OK;
 }
 #endif
@@ -112,15 +116,17 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   net_ipv6addr_copy(route->router, router);
   net_ipv6_dumproute("New route", route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv6();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
-  net_unlock();
+  net_unlock_ramroute_ipv6();
+  net_flushlpm_ipv6();
+  ipfwd_flushflows();
   return OK;
 }
 #endif
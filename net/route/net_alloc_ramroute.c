@@ -46,10 +46,12 @@
 
 #ifdef CONFIG_ROUTE_IPv4_RAMROUTE
 FAR struct net_route_ipv4_queue_s g_ipv4_routes;
+rmutex_t g_ipv4_routelock = NXRMUTEX_INITIALIZER;
 #endif
 
 #ifdef CONFIG_ROUTE_IPv6_RAMROUTE
 FAR struct net_route_ipv6_queue_s g_ipv6_routes;
+rmutex_t g_ipv6_routelock = NXRMUTEX_INITIALIZER;
 #endif
 
 /****************************************************************************
@@ -150,15 +152,15 @@ FAR struct net_route_ipv4_s *net_allocroute_ipv4(void)
 {
   FAR struct net_route_ipv4_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv4();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv4_remfirst(&g_free_ipv4routes);
 
-  net_unlock();
+  net_unlock_ramroute_ipv4();
   return &route->entry;
 }
 #endif
@@ -168,15 +170,15 @@ FAR struct net_route_ipv6_s *net_allocroute_ipv6(void)
 {
   FAR struct net_route_ipv6_entry_s *route;
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv6();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv6_remfirst(&g_free_ipv6routes);
 
-  net_unlock();
+  net_unlock_ramroute_ipv6();
   return &route->entry;
 }
 #endif
@@ -200,15 +202,15 @@ void net_freeroute_ipv4(FAR struct net_route_ipv4_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv4();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_free_ipv4routes);
-  net_unlock();
+  net_unlock_ramroute_ipv4();
 }
 #endif
 
@@ -217,15 +219,15 @@ void net_freeroute_ipv6(FAR struct net_route_ipv6_s *route)
 {
   DEBUGASSERT(route);
 
-  /* Get exclusive address to the networking data structures */
+  /* Get exclusive address to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv6();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_free_ipv6routes);
-  net_unlock();
+  net_unlock_ramroute_ipv6();
 }
 #endif
 
@@ -37,7 +37,9 @@
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
+#include "ipforward/ipforward.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
@@ -253,6 +255,8 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_flushcache_ipv4();
 #endif
 
+  net_flushlpm_ipv4();
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -318,6 +322,7 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv4();
+  ipfwd_flushflows();
   return ret;
 }
 #endif
@@ -404,6 +409,8 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_flushcache_ipv6();
 #endif
 
+  net_flushlpm_ipv6();
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -469,6 +476,7 @@ errout_with_fshandle:
 
 errout_with_lock:
   net_unlockroute_ipv6();
+  ipfwd_flushflows();
   return ret;
 }
 #endif
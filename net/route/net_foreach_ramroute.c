@@ -66,7 +66,7 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
 
   /* Prevent concurrent access to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv4();
 
   /* Visit each entry in the routing table */
 
@@ -80,9 +80,9 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_unlock_ramroute_ipv4();
   return ret;
 }
 #endif
@@ -96,7 +96,7 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
 
   /* Prevent concurrent access to the routing table */
 
-  net_lock();
+  net_lock_ramroute_ipv6();
 
   /* Visit each entry in the routing table */
 
@@ -110,9 +110,9 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  net_unlock_ramroute_ipv6();
   return ret;
 }
 #endif
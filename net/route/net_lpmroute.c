@@ -0,0 +1,733 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_NET_ROUTE) && defined(CONFIG_ROUTE_LPM)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LPM_NONE      0xffff      /* No node or route */
+#define LPM_MAXROUTES 0x7fff      /* So that 2 nodes per route fit in 16 bits */
+#define LPM_MAXBYTES  16          /* The size of the largest address */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the path-compressed binary trie.  Each node stands for the
+ * first 'plen' bits of 'key'; only these bits are significant.  The
+ * children extend the prefix with a longer one whose next bit is 0 or 1.
+ * A node that is not the prefix of a route only exists to join two
+ * branches, so that the trie never has more than two nodes per route.
+ */
+
+struct lpm_node_s
+{
+  uint8_t  key[LPM_MAXBYTES];     /* The prefix (network order) */
+  uint8_t  plen;                  /* The length of the prefix in bits */
+  uint16_t route;                 /* The first route of this prefix */
+  uint16_t child[2];              /* The longer prefixes */
+};
+
+/* A trie with a copy of the routes it was built from, allocated as one
+ * block.  A new trie replaces the old one with the network locked, so a
+ * look-up always sees either the old or the new routing table.
+ */
+
+struct lpm_trie_s
+{
+  uint16_t root;                  /* The shortest prefix */
+  uint16_t nnodes;                /* The number of nodes in use */
+  uint16_t nroutes;               /* The number of routes copied */
+  uint16_t maxroutes;             /* Room for this number of routes */
+  size_t   rsize;                 /* The size of one route */
+  FAR struct lpm_node_s *nodes;   /* 2 * maxroutes nodes */
+  FAR uint8_t *routes;            /* maxroutes routes */
+  FAR uint16_t *rnext;            /* The next route with the same prefix */
+};
+
+/* A trie and the routing table generation it was built from */
+
+struct lpm_table_s
+{
+  FAR struct lpm_trie_s *trie;    /* The trie, NULL: linear look-ups */
+  unsigned int gen;               /* Incremented on each change */
+  unsigned int built;             /* The generation of the trie */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static struct lpm_table_s g_ipv4_lpm =
+{
+  NULL, 1, 0
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static struct lpm_table_s g_ipv6_lpm =
+{
+  NULL, 1, 0
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_bit
+ *
+ * Description:
+ *   Return the bit 'bit' of 'key', counting from the most significant bit
+ *   of the first byte.
+ *
+ ****************************************************************************/
+
+static inline int lpm_bit(FAR const uint8_t *key, int bit)
+{
+  return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits that 'key1' and 'key2' have in
+ *   common, up to 'maxlen'.  The first 'start' bits are known to be equal.
+ *
+ ****************************************************************************/
+
+static int lpm_common(FAR const uint8_t *key1, FAR const uint8_t *key2,
+                      int start, int maxlen)
+{
+  int bit = start;
+
+  while ((bit & 7) != 0 && bit < maxlen &&
+         lpm_bit(key1, bit) == lpm_bit(key2, bit))
+    {
+      bit++;
+    }
+
+  while (bit + 8 <= maxlen && key1[bit >> 3] == key2[bit >> 3])
+    {
+      bit += 8;
+    }
+
+  while (bit < maxlen && lpm_bit(key1, bit) == lpm_bit(key2, bit))
+    {
+      bit++;
+    }
+
+  return bit;
+}
+
+/****************************************************************************
+ * Name: lpm_prefixlen
+ *
+ * Description:
+ *   Return the length of the prefix of the netmask 'mask' of 'nbytes'
+ *   bytes, or -EINVAL if the mask is not a prefix.
+ *
+ ****************************************************************************/
+
+static int lpm_prefixlen(FAR const uint8_t *mask, int nbytes)
+{
+  uint8_t byte;
+  int plen = 0;
+  int i;
+
+  for (i = 0; i < nbytes && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < nbytes)
+    {
+      for (byte = mask[i]; (byte & 0x80) != 0; byte <<= 1)
+        {
+          plen++;
+        }
+
+      if (byte != 0)
+        {
+          return -EINVAL;
+        }
+
+      for (i++; i < nbytes; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_newnode
+ *
+ * Description:
+ *   Allocate a node of the trie for the first 'plen' bits of 'key'.
+ *
+ ****************************************************************************/
+
+static uint16_t lpm_newnode(FAR struct lpm_trie_s *trie,
+                            FAR const uint8_t *key, int plen)
+{
+  FAR struct lpm_node_s *node;
+  uint16_t index = trie->nnodes++;
+
+  DEBUGASSERT(index < 2 * (trie->maxroutes + 1));
+
+  node           = &trie->nodes[index];
+  memcpy(node->key, key, LPM_MAXBYTES);
+  node->plen     = plen;
+  node->route    = LPM_NONE;
+  node->child[0] = LPM_NONE;
+  node->child[1] = LPM_NONE;
+  return index;
+}
+
+/****************************************************************************
+ * Name: lpm_addroute
+ *
+ * Description:
+ *   Append the route 'route' to the routes of the prefix of 'node'.  Routes
+ *   with the same prefix keep the order of the routing table.
+ *
+ ****************************************************************************/
+
+static void lpm_addroute(FAR struct lpm_trie_s *trie,
+                         FAR struct lpm_node_s *node, uint16_t route)
+{
+  FAR uint16_t *link;
+
+  for (link = &node->route; *link != LPM_NONE; link = &trie->rnext[*link]);
+
+  trie->rnext[route] = LPM_NONE;
+  *link              = route;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Insert the route 'route' for the first 'plen' bits of 'key' into the
+ *   trie.
+ *
+ ****************************************************************************/
+
+static void lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       int plen, uint16_t route)
+{
+  FAR struct lpm_node_s *node;
+  FAR uint16_t *link = &trie->root;
+  uint16_t index;
+  int common;
+  int start = 0;
+
+  while (*link != LPM_NONE)
+    {
+      node   = &trie->nodes[*link];
+      common = lpm_common(key, node->key, start,
+                          plen < node->plen ? plen : node->plen);
+
+      if (common == node->plen)
+        {
+          /* The node is a prefix of the new one */
+
+          if (plen == node->plen)
+            {
+              lpm_addroute(trie, node, route);
+              return;
+            }
+
+          start = node->plen;
+          link  = &node->child[lpm_bit(key, node->plen)];
+          continue;
+        }
+
+      /* The new prefix ends or diverges within the prefix of the node:
+       * Insert a node for the common part above it.
+       */
+
+      index = lpm_newnode(trie, key, common);
+      trie->nodes[index].child[lpm_bit(node->key, common)] = *link;
+      *link = index;
+
+      if (common == plen)
+        {
+          lpm_addroute(trie, &trie->nodes[index], route);
+          return;
+        }
+
+      link = &trie->nodes[index].child[lpm_bit(key, common)];
+      break;
+    }
+
+  index = lpm_newnode(trie, key, plen);
+  lpm_addroute(trie, &trie->nodes[index], route);
+  *link = index;
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the nodes with routes whose prefix matches 'key' of 'nbits' bits
+ *   in 'path', the shortest prefix first.  Return the number of nodes.
+ *   'path' must have room for nbits + 1 nodes.
+ *
+ ****************************************************************************/
+
+static int lpm_lookup(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                      int nbits, FAR uint16_t *path)
+{
+  FAR struct lpm_node_s *node;
+  uint16_t index = trie->root;
+  int depth = 0;
+  int start = 0;
+
+  while (index != LPM_NONE)
+    {
+      node = &trie->nodes[index];
+      if (lpm_common(key, node->key, start, node->plen) < node->plen)
+        {
+          break;
+        }
+
+      if (node->route != LPM_NONE)
+        {
+          path[depth++] = index;
+        }
+
+      if (node->plen >= nbits)
+        {
+          break;
+        }
+
+      start = node->plen;
+      index = node->child[lpm_bit(key, node->plen)];
+    }
+
+  return depth;
+}
+
+/****************************************************************************
+ * Name: lpm_alloc
+ *
+ * Description:
+ *   Allocate an empty trie for 'maxroutes' routes of 'rsize' bytes.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_trie_s *lpm_alloc(unsigned int maxroutes,
+                                        size_t rsize)
+{
+  FAR struct lpm_trie_s *trie;
+  size_t nodesize;
+  size_t routesize;
+
+  if (maxroutes > LPM_MAXROUTES)
+    {
+      nerr("ERROR: Too many routes for the trie: %u\n", maxroutes);
+      return NULL;
+    }
+
+  /* The routes are rounded up to the alignment of the nodes */
+
+  nodesize  = 2 * (maxroutes + 1) * sizeof(struct lpm_node_s);
+  routesize = (maxroutes * rsize + sizeof(uintptr_t) - 1) &
+              ~(sizeof(uintptr_t) - 1);
+
+  trie = kmm_malloc(sizeof(struct lpm_trie_s) + nodesize + routesize +
+                    maxroutes * sizeof(uint16_t));
+  if (trie == NULL)
+    {
+      nerr("ERROR: Failed to allocate the trie for %u routes\n", maxroutes);
+      return NULL;
+    }
+
+  trie->root      = LPM_NONE;
+  trie->nnodes    = 0;
+  trie->nroutes   = 0;
+  trie->maxroutes = maxroutes;
+  trie->rsize     = rsize;
+  trie->nodes     = (FAR struct lpm_node_s *)(trie + 1);
+  trie->routes    = (FAR uint8_t *)trie->nodes + nodesize;
+  trie->rnext     = (FAR uint16_t *)(trie->routes + routesize);
+  return trie;
+}
+
+/****************************************************************************
+ * Name: lpm_add
+ *
+ * Description:
+ *   Copy one route into the trie.  Return 0 to continue with the next
+ *   route, 1 if the trie is full or -EINVAL if the route cannot be put in
+ *   the trie.
+ *
+ ****************************************************************************/
+
+static int lpm_add(FAR struct lpm_trie_s *trie, FAR const void *route,
+                   FAR const void *target, FAR const void *netmask,
+                   int nbytes)
+{
+  uint8_t key[LPM_MAXBYTES];
+  uint16_t index;
+  int plen;
+
+  if (trie->nroutes >= trie->maxroutes)
+    {
+      /* The table has grown since it was counted.  That change will flush
+       * the trie again.
+       */
+
+      return 1;
+    }
+
+  plen = lpm_prefixlen(netmask, nbytes);
+  if (plen < 0)
+    {
+      nwarn("WARNING: Netmask is not a prefix, no trie\n");
+      return plen;
+    }
+
+  memset(key, 0, LPM_MAXBYTES);
+  memcpy(key, target, nbytes);
+
+  index = trie->nroutes++;
+  memcpy(trie->routes + index * trie->rsize, route, trie->rsize);
+  lpm_insert(trie, key, plen, index);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lpm_replace
+ *
+ * Description:
+ *   Replace the trie of 'table' by 'trie' built from generation 'gen'.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void lpm_replace(FAR struct lpm_table_s *table,
+                        FAR struct lpm_trie_s *trie, unsigned int gen)
+{
+  FAR struct lpm_trie_s *old = table->trie;
+
+  table->trie  = trie;
+  table->built = gen;
+
+  if (old != NULL)
+    {
+      kmm_free(old);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_ipv4_count
+ *
+ * Description:
+ *   Count the IPv4 routes
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static int lpm_ipv4_count(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  (*(FAR unsigned int *)arg)++;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lpm_ipv4_add
+ *
+ * Description:
+ *   Copy one IPv4 route into the trie
+ *
+ ****************************************************************************/
+
+static int lpm_ipv4_add(FAR struct net_route_ipv4_s *route, FAR void *arg)
+{
+  return lpm_add((FAR struct lpm_trie_s *)arg, route, &route->target,
+                 &route->netmask, sizeof(in_addr_t));
+}
+
+/****************************************************************************
+ * Name: lpm_ipv4_build
+ *
+ * Description:
+ *   Build the IPv4 trie from the routing table.  If that fails, the
+ *   look-ups fall back to net_foreachroute_ipv4() until the next change.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void lpm_ipv4_build(void)
+{
+  FAR struct lpm_trie_s *trie;
+  unsigned int gen = g_ipv4_lpm.gen;
+  unsigned int nroutes = 0;
+
+  net_foreachroute_ipv4(lpm_ipv4_count, &nroutes);
+
+  trie = lpm_alloc(nroutes, sizeof(struct net_route_ipv4_s));
+  if (trie != NULL &&
+      net_foreachroute_ipv4(lpm_ipv4_add, trie) < 0)
+    {
+      kmm_free(trie);
+      trie = NULL;
+    }
+
+  lpm_replace(&g_ipv4_lpm, trie, gen);
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: lpm_ipv6_count
+ *
+ * Description:
+ *   Count the IPv6 routes
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+static int lpm_ipv6_count(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  (*(FAR unsigned int *)arg)++;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: lpm_ipv6_add
+ *
+ * Description:
+ *   Copy one IPv6 route into the trie
+ *
+ ****************************************************************************/
+
+static int lpm_ipv6_add(FAR struct net_route_ipv6_s *route, FAR void *arg)
+{
+  return lpm_add((FAR struct lpm_trie_s *)arg, route, route->target,
+                 route->netmask, sizeof(net_ipv6addr_t));
+}
+
+/****************************************************************************
+ * Name: lpm_ipv6_build
+ *
+ * Description:
+ *   Build the IPv6 trie from the routing table.  If that fails, the
+ *   look-ups fall back to net_foreachroute_ipv6() until the next change.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void lpm_ipv6_build(void)
+{
+  FAR struct lpm_trie_s *trie;
+  unsigned int gen = g_ipv6_lpm.gen;
+  unsigned int nroutes = 0;
+
+  net_foreachroute_ipv6(lpm_ipv6_count, &nroutes);
+
+  trie = lpm_alloc(nroutes, sizeof(struct net_route_ipv6_s));
+  if (trie != NULL &&
+      net_foreachroute_ipv6(lpm_ipv6_add, trie) < 0)
+    {
+      kmm_free(trie);
+      trie = NULL;
+    }
+
+  lpm_replace(&g_ipv6_lpm, trie, gen);
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4
+ *
+ * Description:
+ *   Call 'handler' for the IPv4 routes whose network contains 'target',
+ *   the longest prefix first.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+int net_lpmroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                      FAR void *arg)
+{
+  FAR struct lpm_trie_s *trie;
+  uint16_t path[32 + 1];
+  uint16_t route;
+  int depth;
+  int ret = 0;
+
+  net_lock();
+
+  if (g_ipv4_lpm.built != g_ipv4_lpm.gen)
+    {
+      lpm_ipv4_build();
+    }
+
+  trie = g_ipv4_lpm.trie;
+  if (trie == NULL)
+    {
+      net_unlock();
+      return net_foreachroute_ipv4(handler, arg);
+    }
+
+  depth = lpm_lookup(trie, (FAR const uint8_t *)&target, 32, path);
+  while (depth-- > 0 && ret == 0)
+    {
+      for (route = trie->nodes[path[depth]].route;
+           route != LPM_NONE && ret == 0;
+           route = trie->rnext[route])
+        {
+          ret = handler((FAR struct net_route_ipv4_s *)
+                        (trie->routes + route * trie->rsize), arg);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: net_flushlpm_ipv4
+ *
+ * Description:
+ *   Discard the IPv4 trie after a change of the routing table.
+ *
+ ****************************************************************************/
+
+void net_flushlpm_ipv4(void)
+{
+  /* No lock is needed:  The look-ups compare the generation with the
+   * network locked, and any store to it differs from the generation of
+   * the trie.
+   */
+
+  g_ipv4_lpm.gen++;
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv6
+ *
+ * Description:
+ *   Call 'handler' for the IPv6 routes whose network contains 'target',
+ *   the longest prefix first.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target,
+                      route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct lpm_trie_s *trie;
+  uint16_t path[128 + 1];
+  uint16_t route;
+  int depth;
+  int ret = 0;
+
+  net_lock();
+
+  if (g_ipv6_lpm.built != g_ipv6_lpm.gen)
+    {
+      lpm_ipv6_build();
+    }
+
+  trie = g_ipv6_lpm.trie;
+  if (trie == NULL)
+    {
+      net_unlock();
+      return net_foreachroute_ipv6(handler, arg);
+    }
+
+  depth = lpm_lookup(trie, (FAR const uint8_t *)target, 128, path);
+  while (depth-- > 0 && ret == 0)
+    {
+      for (route = trie->nodes[path[depth]].route;
+           route != LPM_NONE && ret == 0;
+           route = trie->rnext[route])
+        {
+          ret = handler((FAR struct net_route_ipv6_s *)
+                        (trie->routes + route * trie->rsize), arg);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: net_flushlpm_ipv6
+ *
+ * Description:
+ *   Discard the IPv6 trie after a change of the routing table.
+ *
+ ****************************************************************************/
+
+void net_flushlpm_ipv6(void)
+{
+  /* No lock is needed:  The look-ups compare the generation with the
+   * network locked, and any store to it differs from the generation of
+   * the trie.
+   */
+
+  g_ipv6_lpm.gen++;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+#endif /* CONFIG_NET_ROUTE && CONFIG_ROUTE_LPM */
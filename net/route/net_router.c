@@ -34,6 +34,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -108,8 +109,8 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
                                (FAR struct route_ipv4_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  With
+   * CONFIG_ROUTE_LPM, the first is the one with the longest prefix.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
@@ -152,8 +153,8 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
                                 (FAR struct route_ipv6_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  With
+   * CONFIG_ROUTE_LPM, the first is the one with the longest prefix.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask))
@@ -224,7 +225,7 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+      ret = net_lpmroute_ipv4(target, net_ipv4_match, &match);
     }
 
   /* Did we find a route? */
@@ -299,7 +300,7 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+      ret = net_lpmroute_ipv6(target, net_ipv6_match, &match);
     }
 
   /* Did we find a route? */
@@ -27,6 +27,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/mutex.h>
+
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -45,6 +47,18 @@
 #  define CONFIG_ROUTE_MAX_IPv6_RAMROUTES 4
 #endif
 
+/* Lock the routing table and the free list.  The RAM routing tables have
+ * their own locks so that they are not serialized by the network lock.
+ * The locks are recursive because the handlers of net_foreachroute_ipv4/6
+ * may free the entry that they are visiting.  The network lock must never
+ * be taken while one of these locks is held.
+ */
+
+#define net_lock_ramroute_ipv4()   nxrmutex_lock(&g_ipv4_routelock)
+#define net_unlock_ramroute_ipv4() nxrmutex_unlock(&g_ipv4_routelock)
+#define net_lock_ramroute_ipv6()   nxrmutex_lock(&g_ipv6_routelock)
+#define net_unlock_ramroute_ipv6() nxrmutex_unlock(&g_ipv6_routelock)
+
 /* Routing table initializer */
 
 #define ramroute_init(rr) \
@@ -105,12 +119,14 @@ struct net_route_ipv6_queue_s
 /* The in-memory routing tables are represented as singly linked lists. */
 
 extern struct net_route_ipv4_queue_s g_ipv4_routes;
+extern rmutex_t g_ipv4_routelock;
 #endif
 
 #if defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 /* The in-memory routing tables are represented as singly linked lists. */
 
 extern struct net_route_ipv6_queue_s g_ipv6_routes;
+extern rmutex_t g_ipv6_routelock;
 #endif
 
 /****************************************************************************
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <inttypes.h>
 #include <poll.h>
 #include <stdio.h>
 #include <string.h>
@@ -78,6 +79,15 @@ begin_packed_struct struct rpmsg_socket_data_s
   char                           data[0];
 } end_packed_struct;
 
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+struct rpmsg_socket_hold_s
+{
+  FAR void                       *rxbuf; /* The held rpmsg rx buffer */
+  FAR uint8_t                    *data;  /* The data not read yet */
+  uint32_t                       len;    /* The size of the data not read */
+};
+#endif
+
 struct rpmsg_socket_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -101,6 +111,16 @@ struct rpmsg_socket_conn_s
   uint32_t                       recvlen;
   FAR struct circbuf_s           recvbuf;
 
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+  /* The held rx buffers, read after the data of recvbuf.  Data is only
+   * held while recvbuf is empty, so that it is received in order.
+   */
+
+  struct rpmsg_socket_hold_s     hold[CONFIG_NET_RPMSG_RXHOLD_NBUFFERS];
+  uint8_t                        holdhead;
+  uint8_t                        holdcount;
+#endif
+
   FAR struct socket              *psock;
   FAR struct rpmsg_socket_conn_s *next;
 
@@ -261,6 +281,72 @@ static void rpmsg_socket_free(FAR struct rpmsg_socket_conn_s *conn)
   kmm_free(conn);
 }
 
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+static void rpmsg_socket_flush_hold(FAR struct rpmsg_socket_conn_s *conn)
+{
+  FAR struct rpmsg_socket_hold_s *hold;
+  ssize_t written;
+
+  /* Copy the held data into recvbuf, in order, and give the rx buffers
+   * back.  The flow control guarantees that it fits.
+   */
+
+  while (conn->holdcount > 0)
+    {
+      hold = &conn->hold[conn->holdhead];
+
+      written = circbuf_write(&conn->recvbuf, hold->data, hold->len);
+      if (written != hold->len)
+        {
+          nerr("circbuf_write overflow, %zu, %" PRIu32 "\n",
+               written, hold->len);
+        }
+
+      rpmsg_release_rx_buffer(&conn->ept, hold->rxbuf);
+      conn->holdhead = (conn->holdhead + 1) %
+                       CONFIG_NET_RPMSG_RXHOLD_NBUFFERS;
+      conn->holdcount--;
+    }
+}
+
+static ssize_t rpmsg_socket_read_hold(FAR struct rpmsg_socket_conn_s *conn,
+                                      FAR void *buf, size_t len, bool dgram)
+{
+  FAR struct rpmsg_socket_hold_s *hold = &conn->hold[conn->holdhead];
+  uint32_t datalen;
+  ssize_t ret;
+
+  if (dgram)
+    {
+      /* The held buffer holds one datagram, behind its length */
+
+      memcpy(&datalen, hold->data, sizeof(uint32_t));
+      ret = MIN(datalen, len);
+      memcpy(buf, hold->data + sizeof(uint32_t), ret);
+      conn->recvpos += datalen + sizeof(uint32_t);
+      hold->len = 0;
+    }
+  else
+    {
+      ret = MIN(hold->len, len);
+      memcpy(buf, hold->data, ret);
+      conn->recvpos += ret;
+      hold->data += ret;
+      hold->len  -= ret;
+    }
+
+  if (hold->len == 0)
+    {
+      rpmsg_release_rx_buffer(&conn->ept, hold->rxbuf);
+      conn->holdhead = (conn->holdhead + 1) %
+                       CONFIG_NET_RPMSG_RXHOLD_NBUFFERS;
+      conn->holdcount--;
+    }
+
+  return ret;
+}
+#endif
+
 static int rpmsg_socket_wakeup(FAR struct rpmsg_socket_conn_s *conn)
 {
   struct rpmsg_socket_data_s msg;
@@ -369,6 +455,30 @@ static int rpmsg_socket_ept_cb(FAR struct rpmsg_endpoint *ept,
               nxsem_post(&conn->recvsem);
             }
 
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+          if (len >= CONFIG_NET_RPMSG_RXHOLD_THRESHOLD &&
+              conn->holdcount < CONFIG_NET_RPMSG_RXHOLD_NBUFFERS &&
+              circbuf_is_empty(&conn->recvbuf))
+            {
+              FAR struct rpmsg_socket_hold_s *hold;
+
+              hold = &conn->hold[(conn->holdhead + conn->holdcount) %
+                                 CONFIG_NET_RPMSG_RXHOLD_NBUFFERS];
+              hold->rxbuf = data;
+              hold->data  = buf;
+              hold->len   = len;
+              conn->holdcount++;
+
+              rpmsg_hold_rx_buffer(ept, data);
+              rpmsg_socket_pollnotify(conn, POLLIN);
+              len = 0;
+            }
+          else
+            {
+              rpmsg_socket_flush_hold(conn);
+            }
+#endif
+
           if (len > 0)
             {
               ssize_t written;
@@ -408,6 +518,12 @@ static inline void rpmsg_socket_destroy_ept(
           conn->backlog = -1;
         }
 
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+      /* Keep the data held for the reads that follow */
+
+      rpmsg_socket_flush_hold(conn);
+#endif
+
       rpmsg_destroy_ept(&conn->ept);
       rpmsg_socket_post(&conn->sendsem);
       rpmsg_socket_post(&conn->recvsem);
@@ -894,6 +1010,12 @@ static int rpmsg_socket_poll(FAR struct socket *psock,
                 {
                   eventset |= (fds->events & POLLIN);
                 }
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+              else if (conn->holdcount > 0)
+                {
+                  eventset |= (fds->events & POLLIN);
+                }
+#endif
 
               rpmsg_socket_unlock(&conn->recvlock);
             }
@@ -1217,11 +1339,23 @@ static ssize_t rpmsg_socket_recvmsg(FAR struct socket *psock,
 
           conn->recvpos += datalen + sizeof(uint32_t);
         }
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+      else if (conn->holdcount > 0)
+        {
+          ret = rpmsg_socket_read_hold(conn, buf, len, true);
+        }
+#endif
     }
   else
     {
       ret = circbuf_read(&conn->recvbuf, buf, len);
       conn->recvpos +=  ret > 0 ? ret : 0;
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+      if (ret <= 0 && conn->holdcount > 0)
+        {
+          ret = rpmsg_socket_read_hold(conn, buf, len, false);
+        }
+#endif
     }
 
   if (ret > 0)
@@ -1315,11 +1449,25 @@ static int rpmsg_socket_ioctl(FAR struct socket *psock,
 {
   FAR struct rpmsg_socket_conn_s *conn = psock->s_conn;
   int ret = OK;
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+  int i;
+#endif
 
   switch (cmd)
     {
       case FIONREAD:
         *(FAR int *)((uintptr_t)arg) = circbuf_used(&conn->recvbuf);
+#ifdef CONFIG_NET_RPMSG_RXHOLD
+        rpmsg_socket_lock(&conn->recvlock);
+        for (i = 0; i < conn->holdcount; i++)
+          {
+            *(FAR int *)((uintptr_t)arg) +=
+              conn->hold[(conn->holdhead + i) %
+                         CONFIG_NET_RPMSG_RXHOLD_NBUFFERS].len;
+          }
+
+        rpmsg_socket_unlock(&conn->recvlock);
+#endif
         break;
 
       case FIONSPACE:
@@ -532,9 +532,12 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
       FAR struct sixlowpan_reassbuf_s *reass;
       FAR struct iob_s *qhead;
       FAR struct iob_s *qtail;
+      FAR struct iob_s *pool;
       FAR uint8_t *frame1;
       FAR uint8_t *fragptr;
       uint16_t frag1_hdrlen;
+      uint16_t fragn_paysize;
+      unsigned int nfrags;
 
       /* Recover the reassembly buffer from the driver d_buf. */
 
@@ -626,16 +629,41 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
       frame1         = iob->io_data;
       frag1_hdrlen   = g_frame_hdrlen;
 
+      /* Take the IOBs of all of the following fragments from the pool at
+       * once.  If not enough are free now, they are allocated one by one
+       * below, waiting as necessary.
+       */
+
+      fragn_paysize  = (framelen - frag1_hdrlen + SIXLOWPAN_FRAG1_HDR_LEN -
+                        SIXLOWPAN_FRAGN_HDR_LEN) &
+                       SIXLOWPAN_DISPATCH_FRAG_MASK;
+      pool           = NULL;
+      if (fragn_paysize > 0)
+        {
+          nfrags = (buflen + protosize - outlen + fragn_paysize - 1) /
+                   fragn_paysize;
+          if (nfrags > 0)
+            {
+              pool = iob_tryalloc_chain(false, nfrags);
+            }
+        }
+
       while (outlen < (buflen + protosize))
         {
           uint16_t fragn_hdrlen;
 
-          /* Allocate an IOB to hold the next fragment, waiting if
-           * necessary.
-           */
+          /* Get an IOB to hold the next fragment, waiting if necessary. */
 
-          iob = net_ioballoc(false);
-          DEBUGASSERT(iob != NULL);
+          if (pool != NULL)
+            {
+              iob  = pool;
+              pool = iob->io_flink;
+            }
+          else
+            {
+              iob = net_ioballoc(false);
+              DEBUGASSERT(iob != NULL);
+            }
 
           /* Initialize the IOB */
 
@@ -705,6 +733,14 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
           qhead->io_pktlen += iob->io_len;
         }
 
+      /* All of the IOBs taken should have been used */
+
+      DEBUGASSERT(pool == NULL);
+      if (pool != NULL)
+        {
+          iob_free_chain(pool);
+        }
+
       /* Submit all of the fragments to the MAC.  We send all frames back-
        * to-back like this to minimize any possible condition where some
        * frame which is not a fragment from this sequence from intervening.
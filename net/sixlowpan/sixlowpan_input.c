@@ -291,6 +291,7 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
   uint8_t protosize  = 0;     /* Length of the protocol header (treated like payload) */
   bool isfrag        = false; /* true: Frame is a fragment */
   bool isfrag1       = false; /* true: Frame is the first fragment of the series */
+  bool complete      = true;  /* true: The IP packet is complete */
   int reqsize;                /* Required buffer size */
   int hdrsize;                /* Size of the IEEE802.15.4 header */
   int ret;
@@ -360,7 +361,7 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
 
         /* Allocate a new reassembly buffer */
 
-        reass = sixlowpan_reass_allocate(fragtag, &fragsrc);
+        reass = sixlowpan_reass_allocate(fragtag, fragsize, &fragsrc);
         if (reass == NULL)
           {
             nerr("ERROR: Failed to allocate a reassembly buffer\n");
@@ -398,10 +399,10 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
           }
 
         /* Find the existing reassembly buffer
-         * with the same tag and source address
+         * with the same tag, size and source address
          */
 
-        reass = sixlowpan_reass_find(fragtag, &fragsrc);
+        reass = sixlowpan_reass_find(fragtag, fragsize, &fragsrc);
         if (reass == NULL)
           {
             nerr("ERROR: Failed to find a reassembly buffer for tag=%04x\n",
@@ -409,16 +410,6 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
             return -ENOENT;
           }
 
-       if (fragsize != reass->rb_pktlen)
-        {
-          /* The packet is a fragment but its size does not match. */
-
-          nwarn("WARNING: Dropping 6LoWPAN packet. Bad fragsize: %u vs %u\n",
-                fragsize, reass->rb_pktlen);
-          ret = -EPERM;
-          goto errout_with_reass;
-        }
-
         radio->r_dev.d_buf  = reass->rb_buf;
         radio->r_dev.d_len  = 0;
 
@@ -565,6 +556,13 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
        */
 
       reass->rb_accumlen = g_uncomp_hdrlen + (fragoffset << 3) + paysize;
+
+      /* The fragments may arrive in any order:  Track the parts of the
+       * packet received.
+       */
+
+      complete = sixlowpan_reass_addfrag(reass, fragoffset << 3,
+                                         reqsize - reass->rb_boffset);
     }
   else
     {
@@ -578,7 +576,7 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
   ninfo("rb_accumlen=%d rb_pktlen=%d paysize=%d\n",
          reass->rb_accumlen, reass->rb_pktlen, paysize);
 
-  if (reass->rb_accumlen == 0 || reass->rb_accumlen >= reass->rb_pktlen)
+  if (complete)
     {
       ninfo("IP packet ready (length %d)\n", reass->rb_pktlen);
 
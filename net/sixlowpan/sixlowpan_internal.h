@@ -743,6 +743,7 @@ void sixlowpan_reass_initialize(void);
  *
  * Input Parameters:
  *   reasstag - The reassembly tag for subsequent lookup.
+ *   pktlen   - The size of the packet, for subsequent lookup.
  *   fragsrc  - The source address of the fragment.
  *
  * Returned Value:
@@ -756,7 +757,7 @@ void sixlowpan_reass_initialize(void);
  ****************************************************************************/
 
 FAR struct sixlowpan_reassbuf_s *
-  sixlowpan_reass_allocate(uint16_t reasstag,
+  sixlowpan_reass_allocate(uint16_t reasstag, uint16_t pktlen,
                            FAR const struct netdev_varaddr_s *fragsrc);
 
 /****************************************************************************
@@ -764,10 +765,11 @@ FAR struct sixlowpan_reassbuf_s *
  *
  * Description:
  *   Find a previously allocated, active reassembly buffer with the specified
- *   reassembly tag.
+ *   reassembly tag, packet size and source address.
  *
  * Input Parameters:
  *   reasstag - The reassembly tag to match.
+ *   pktlen   - The size of the packet to match.
  *   fragsrc  - The source address of the fragment.
  *
  * Returned Value:
@@ -779,9 +781,33 @@ FAR struct sixlowpan_reassbuf_s *
  ****************************************************************************/
 
 FAR struct sixlowpan_reassbuf_s *
-  sixlowpan_reass_find(uint16_t reasstag,
+  sixlowpan_reass_find(uint16_t reasstag, uint16_t pktlen,
                        FAR const struct netdev_varaddr_s *fragsrc);
 
+/****************************************************************************
+ * Name: sixlowpan_reass_addfrag
+ *
+ * Description:
+ *   Record the reception of the part of a fragmented packet from 'offset'
+ *   to 'end', both counted from rb_boffset, and tell whether the packet is
+ *   complete.
+ *
+ * Input Parameters:
+ *   reass  - The reassembly buffer of the packet
+ *   offset - The offset of the fragment, a multiple of 8
+ *   end    - The offset of the end of the fragment
+ *
+ * Returned Value:
+ *   True if all of the packet has been received.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool sixlowpan_reass_addfrag(FAR struct sixlowpan_reassbuf_s *reass,
+                             uint16_t offset, uint16_t end);
+
 /****************************************************************************
  * Name: sixlowpan_reass_free
  *
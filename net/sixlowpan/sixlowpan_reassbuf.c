@@ -44,6 +44,10 @@
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+#ifndef CONFIG_NET_6LOWPAN_NREASSHASH
+#  define CONFIG_NET_6LOWPAN_NREASSHASH 8
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -59,6 +63,13 @@ static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
 static FAR struct sixlowpan_reassbuf_s *g_active_reass;
 
+/* The active reassembly buffers again, hashed for the look-up of each
+ * received fragment.
+ */
+
+static FAR struct sixlowpan_reassbuf_s *
+              g_reass_hash[CONFIG_NET_6LOWPAN_NREASSHASH];
+
 /* Pool of pre-allocated reassembly buffer structures */
 
 static struct sixlowpan_reassbuf_s
@@ -100,6 +111,30 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
   return false;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_reass_hash
+ *
+ * Description:
+ *   Return the index in g_reass_hash of the reassembly buffers with the
+ *   specified tag, packet size and source address.
+ *
+ ****************************************************************************/
+
+static uint8_t sixlowpan_reass_hash(uint16_t reasstag, uint16_t pktlen,
+                                FAR const struct netdev_varaddr_s *fragsrc)
+{
+  uint32_t hash = ((uint32_t)reasstag << 16) ^ pktlen;
+  int i;
+
+  for (i = 0; i < fragsrc->nv_addrlen; i++)
+    {
+      hash = (hash << 5) + hash + fragsrc->nv_addr[i];
+    }
+
+  hash ^= hash >> 16;
+  return hash % CONFIG_NET_6LOWPAN_NREASSHASH;
+}
+
 /****************************************************************************
  * Name: sixlowpan_reass_expire
  *
@@ -203,6 +238,28 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
     }
 
   reass->rb_flink = NULL;
+
+  /* And from its hash chain */
+
+  for (prev = NULL, curr = g_reass_hash[reass->rb_hash];
+       curr != NULL && curr != reass;
+       prev = curr, curr = curr->rb_hlink)
+    {
+    }
+
+  if (curr != NULL)
+    {
+      if (prev == NULL)
+        {
+          g_reass_hash[reass->rb_hash] = reass->rb_hlink;
+        }
+      else
+        {
+          prev->rb_hlink = reass->rb_hlink;
+        }
+    }
+
+  reass->rb_hlink = NULL;
 }
 
 /****************************************************************************
@@ -263,6 +320,7 @@ void sixlowpan_reass_initialize(void)
  *
  * Input Parameters:
  *   reasstag - The reassembly tag for subsequent lookup.
+ *   pktlen   - The size of the packet, for subsequent lookup.
  *   fragsrc  - The source address of the fragment.
  *
  * Returned Value:
@@ -276,7 +334,7 @@ void sixlowpan_reass_initialize(void)
  ****************************************************************************/
 
 FAR struct sixlowpan_reassbuf_s *
-  sixlowpan_reass_allocate(uint16_t reasstag,
+  sixlowpan_reass_allocate(uint16_t reasstag, uint16_t pktlen,
                            FAR const struct netdev_varaddr_s *fragsrc)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
@@ -322,12 +380,19 @@ FAR struct sixlowpan_reassbuf_s *
       reass->rb_pool     = pool;
       reass->rb_active   = true;
       reass->rb_reasstag = reasstag;
+      reass->rb_pktlen   = pktlen;
       reass->rb_time     = clock_systime_ticks();
 
-      /* Add the reassembly buffer to the list of active reassembly buffers */
+      /* Add the reassembly buffer to the list of active reassembly buffers
+       * and to its hash chain.
+       */
 
       reass->rb_flink   = g_active_reass;
       g_active_reass    = reass;
+
+      reass->rb_hash    = sixlowpan_reass_hash(reasstag, pktlen, fragsrc);
+      reass->rb_hlink   = g_reass_hash[reass->rb_hash];
+      g_reass_hash[reass->rb_hash] = reass;
     }
 
   return reass;
@@ -338,10 +403,11 @@ FAR struct sixlowpan_reassbuf_s *
  *
  * Description:
  *   Find a previously allocated, active reassembly buffer with the specified
- *   reassembly tag.
+ *   reassembly tag, packet size and source address.
  *
  * Input Parameters:
  *   reasstag - The reassembly tag to match.
+ *   pktlen   - The size of the packet to match.
  *   fragsrc  - The source address of the fragment.
  *
  * Returned Value:
@@ -353,31 +419,37 @@ FAR struct sixlowpan_reassbuf_s *
  ****************************************************************************/
 
 FAR struct sixlowpan_reassbuf_s *
-  sixlowpan_reass_find(uint16_t reasstag,
+  sixlowpan_reass_find(uint16_t reasstag, uint16_t pktlen,
                        FAR const struct netdev_varaddr_s *fragsrc)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
 
-  /* First, removed any expired or inactive reassembly buffers (we don't want
-   * to return old reassembly buffer with the same tag)
-   */
-
-  sixlowpan_reass_expire();
-
-  /* Now search for the matching reassembly buffer in the remainng, active
-   * reassembly buffers.
+  /* Search for the matching reassembly buffer in its hash chain.  Expired
+   * buffers are freed by sixlowpan_reass_allocate(), only the one found
+   * is checked here (we don't want to return old reassembly buffer with
+   * the same tag).
    */
 
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  for (reass = g_reass_hash[sixlowpan_reass_hash(reasstag, pktlen, fragsrc)];
+       reass != NULL;
+       reass = reass->rb_hlink)
     {
-      /* In order to be a match, it must have the same reassembly tag as
-       * well as source address (different sources might use the same
-       * reassembly tag).
+      /* In order to be a match, it must have the same reassembly tag and
+       * size as well as source address (different sources might use the
+       * same reassembly tag).
        */
 
-      if (reass->rb_reasstag == reasstag &&
+      if (reass->rb_active && reass->rb_reasstag == reasstag &&
+          reass->rb_pktlen == pktlen &&
           sixlowpan_compare_fragsrc(reass, fragsrc))
         {
+          if (clock_systime_ticks() - reass->rb_time >= NET_6LOWPAN_TIMEOUT)
+            {
+              nwarn("WARNING: Reassembly timed out\n");
+              sixlowpan_reass_free(reass);
+              return NULL;
+            }
+
           return reass;
         }
     }
@@ -387,6 +459,64 @@ FAR struct sixlowpan_reassbuf_s *
   return NULL;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_reass_addfrag
+ *
+ * Description:
+ *   Record the reception of the part of a fragmented packet from 'offset'
+ *   to 'end', both counted from rb_boffset, and tell whether the packet is
+ *   complete.
+ *
+ * Input Parameters:
+ *   reass  - The reassembly buffer of the packet
+ *   offset - The offset of the fragment, a multiple of 8
+ *   end    - The offset of the end of the fragment
+ *
+ * Returned Value:
+ *   True if all of the packet has been received.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool sixlowpan_reass_addfrag(FAR struct sixlowpan_reassbuf_s *reass,
+                             uint16_t offset, uint16_t end)
+{
+  uint16_t nunits;
+  uint16_t unit;
+
+  /* The number of 8-byte units of the packet after rb_boffset */
+
+  if (reass->rb_pktlen <= reass->rb_boffset)
+    {
+      return true;
+    }
+
+  nunits = (reass->rb_pktlen - reass->rb_boffset + 7) >> 3;
+  if (nunits > SIXLOWPAN_REASS_MAPWORDS * 32)
+    {
+      nunits = SIXLOWPAN_REASS_MAPWORDS * 32;
+    }
+
+  /* Mark the units of the fragment.  Only the last fragment may end within
+   * a unit.  A fragment received twice is counted once.
+   */
+
+  for (unit = offset >> 3; unit < nunits && unit < (end + 7) >> 3; unit++)
+    {
+      uint32_t bit = (uint32_t)1 << (unit & 31);
+
+      if ((reass->rb_fragmap[unit >> 5] & bit) == 0)
+        {
+          reass->rb_fragmap[unit >> 5] |= bit;
+          reass->rb_nunits++;
+        }
+    }
+
+  return reass->rb_nunits >= nunits;
+}
+
 /****************************************************************************
  * Name: sixlowpan_reass_free
  *
@@ -0,0 +1,196 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   Receive up to 'vlen' messages from a socket with a single call.  This
+ *   is an internal OS interface.  It is functionally equivalent to
+ *   recvmmsg() except that it is not a cancellation point, it does not
+ *   modify the errno variable and it accepts the internal socket structure
+ *   as an input.
+ *
+ *   Datagram sockets of the INET families, CAN and Bluetooth sockets keep
+ *   the network locked between the messages of the batch, so that it is
+ *   taken only once per call.  A CAN socket returns one frame per message,
+ *   with its own time stamp when SO_TIMESTAMP is set.  A Bluetooth socket
+ *   returns one frame of its RX queue per message.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The messages to receive
+ *   vlen    - The number of messages in 'msgvec'
+ *   flags   - Receive flags, including MSG_WAITFORONE
+ *   timeout - Stop after the first message received once this time has
+ *             elapsed (NULL: no timeout)
+ *
+ * Returned Value:
+ *   The number of messages received; msg_len of each holds its size.  If
+ *   the first message fails, a negated errno value.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  clock_t deadline = 0;
+  unsigned int i;
+  ssize_t ret = OK;
+  bool locked;
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (timeout != NULL)
+    {
+      sclock_t ticks;
+
+      ret = clock_time2ticks(timeout, &ticks);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      deadline = clock_systime_ticks() + ticks;
+    }
+
+  locked = (psock->s_type == SOCK_DGRAM &&
+            (psock->s_domain == PF_INET || psock->s_domain == PF_INET6)) ||
+           psock->s_domain == PF_CAN || psock->s_domain == PF_BLUETOOTH;
+  if (locked)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      /* Wait only for the first message if so requested */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - deadline) >= 0)
+        {
+          i++;
+          break;
+        }
+    }
+
+  if (locked)
+    {
+      net_unlock();
+    }
+
+  /* Report an error only if no message was received.  Otherwise, the error
+   * will be reported by the next receive.
+   */
+
+  return i > 0 ? (int)i : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   The recvmmsg() call receives up to 'vlen' messages from a socket in a
+ *   single call.  Each message is received as by recvmsg(), and msg_len of
+ *   each mmsghdr is set to the size of the message.  With MSG_WAITFORONE,
+ *   only the first message may block.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The messages to receive
+ *   vlen     The number of messages in 'msgvec'
+ *   flags    Receive flags
+ *   timeout  Stop after the first message received once this time has
+ *            elapsed (NULL: no timeout)
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set appropriately (see recvmsg()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  psock = sockfd_socket(sockfd);
+  ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
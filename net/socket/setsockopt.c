@@ -33,6 +33,7 @@
 #include <assert.h>
 #include <arch/irq.h>
 
+#include <netpacket/packet.h>
 #include <nuttx/net/net.h>
 #include <netdev/netdev.h>
 
@@ -43,6 +44,7 @@
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 #include "can/can.h"
+#include "pkt/pkt.h"
 
 /****************************************************************************
  * Public Functions
@@ -157,6 +159,7 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
 #endif
       case SO_OOBINLINE:  /* Leaves received out-of-band data inline */
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
+      case SO_REUSEPORT:  /* Allow several sockets on the same port */
         {
           int setting;
 
@@ -569,6 +572,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_MMAP
+      case SOL_PACKET:    /* Packet socket options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -ENOPROTOOPT;
         break;
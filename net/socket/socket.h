@@ -63,6 +63,7 @@
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
 #define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
 #define _SO_BINDTODEVICE _SO_BIT(SO_BINDTODEVICE)
+#define _SO_REUSEPORT    _SO_BIT(SO_REUSEPORT)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
@@ -91,6 +92,16 @@
 #  define _SO_TIMEOUT(t) (UINT_MAX)
 #endif /* CONFIG_NET_SOCKOPTS */
 
+/* True if SO_REUSEPORT is set on the connection 'c' (a protocol
+ * connection structure that begins with struct socket_conn_s sconn).
+ */
+
+#ifdef CONFIG_NET_SOCKOPTS
+#  define _SO_ISREUSEPORT(c) _SO_GETOPT((c)->sconn.s_options, SO_REUSEPORT)
+#else
+#  define _SO_ISREUSEPORT(c) false
+#endif
+
 /* Macro to set socket errors */
 
 #ifdef CONFIG_NET_SOCKOPTS
@@ -97,6 +97,11 @@
 /* The TCP options flags */
 
 #define TCP_WSCALE            0x01U /* Window Scale option enabled */
+#define TCP_SACK              0x02U /* Selective ACK option enabled */
+
+/* The number of SACK blocks remembered per connection */
+
+#define TCP_SACK_NBLOCKS      4
 
 /* After receiving 3 duplicate ACKs, TCP performs a retransmission
  * (RFC 5681 (3.2))
@@ -104,6 +109,15 @@
 
 #define TCP_FAST_RETRANSMISSION_THRESH 3
 
+/* Leave delayed ACK for the next CONFIG_NET_TCP_QUICKACK data segments */
+
+#if defined(CONFIG_NET_TCP_DELAYED_ACK) && CONFIG_NET_TCP_QUICKACK > 0
+#  define tcp_enter_quickack(conn) \
+     ((conn)->rx_quickack = CONFIG_NET_TCP_QUICKACK)
+#else
+#  define tcp_enter_quickack(conn)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -112,6 +126,7 @@ struct file;      /* Forward reference */
 struct sockaddr;  /* Forward reference */
 struct socket;    /* Forward reference */
 struct pollfd;    /* Forward reference */
+struct tcp_info;  /* Forward reference */
 
 /* Representation of a TCP connection.
  *
@@ -136,6 +151,52 @@ struct tcp_poll_s
   FAR struct devif_callback_s *cb; /* Needed to teardown the poll */
 };
 
+#ifdef CONFIG_NET_TCP_CC
+/* The operations of a congestion control algorithm.  They are called with
+ * the network locked and update conn->cwnd and conn->ssthresh.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+
+  /* Reset the private state of the algorithm */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* 'acked' bytes of new data were ACKed outside of a fast recovery */
+
+  CODE void (*ack)(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+  /* A loss was detected by duplicate ACKs or by a time-out */
+
+  CODE void (*loss)(FAR struct tcp_conn_s *conn, bool timeout);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* The state of CUBIC.  The windows are in bytes. */
+
+struct tcp_cubic_s
+{
+  clock_t  epoch;                  /* Start of the epoch, 0: none */
+  uint32_t wmax;                   /* Window before the last reduction */
+  uint32_t lastwmax;               /* wmax before the last reduction */
+  uint32_t west;                   /* Window estimated for Reno */
+  uint32_t k;                      /* Time to regain wmax (msec) */
+};
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* One block of data received by the peer above the cumulative ACK */
+
+struct tcp_sack_s
+{
+  uint32_t left;                   /* First sequence number of the block */
+  uint32_t right;                  /* Sequence number following the block */
+};
+#endif
+
 struct tcp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -194,6 +255,7 @@ struct tcp_conn_s
 #ifdef CONFIG_NET_TCP_DELAYED_ACK
   uint8_t  rx_unackseg;   /* Number of un-ACKed received segments */
   uint8_t  rx_acktimer;   /* Time since last ACK sent (units: half-seconds) */
+  uint8_t  rx_quickack;   /* Number of segments still ACKed at once */
 #endif
   uint16_t lport;         /* The local TCP port, in network byte order */
   uint16_t rport;         /* The remoteTCP port, in network byte order */
@@ -226,6 +288,48 @@ struct tcp_conn_s
 #endif
   uint16_t flags;         /* Flags of TCP-specific options */
 
+#ifdef CONFIG_NET_TCP_SACK
+  /* The SACK scoreboard: The data reported as received by the peer above
+   * the cumulative ACK, as disjoint blocks sorted by sequence number.
+   */
+
+  struct tcp_sack_s sack[TCP_SACK_NBLOCKS];
+  uint8_t  nsacks;        /* Number of valid blocks in sack[] */
+  bool     sack_recovery; /* Retransmitting the holes of the scoreboard */
+  uint32_t sack_recover;  /* The recovery ends when this is ACKed */
+  uint32_t sack_rexmit;   /* Next sequence number that may be resent */
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control.  The window is set up by the first send.  A NULL
+   * algorithm selects the default one.
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t cwnd;          /* Congestion window, 0: not set up yet */
+  uint32_t ssthresh;      /* Slow start threshold */
+  uint32_t cc_recover;    /* The fast recovery ends when this is ACKed */
+  bool     cc_recovery;   /* In fast recovery */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  struct tcp_cubic_s cubic;
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_INFO
+  /* Statistics reported by TCP_INFO.  The round trip time is measured on
+   * one segment at a time, never on a retransmitted one (RFC 6298).
+   */
+
+  bool     rtt_timing;     /* A segment is being timed */
+  clock_t  rtt_start;      /* Time the timed segment was sent */
+  uint32_t rtt_seq;        /* The timed segment is ACKed by this */
+  uint32_t srtt;           /* Smoothed round trip time in usec */
+  uint32_t rttvar;         /* Round trip time variation in usec */
+  uint32_t total_retrans;  /* Number of segments retransmitted */
+  uint64_t bytes_acked;    /* Number of bytes sent and ACKed */
+  uint64_t bytes_received; /* Number of bytes received in sequence */
+#endif
+
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
    * network.
@@ -275,6 +379,15 @@ struct tcp_conn_s
   FAR struct tcp_backlog_s *backlog;
 #endif
 
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  /* Chains of the hash tables of the active connections (see
+   * tcp_conn.c)
+   */
+
+  FAR struct tcp_conn_s    *hnext;  /* Next with the same port/address hash */
+  FAR struct tcp_conn_s    *pnext;  /* Next with the same local port hash */
+#endif
+
 #ifdef CONFIG_NET_TCP_KEEPALIVE
   /* There fields manage TCP/IP keep-alive.  All times are in units of the
    * system clock tick.
@@ -872,6 +985,29 @@ void tcp_update_retrantimer(FAR struct tcp_conn_s *conn, int timeout);
 void tcp_update_keeptimer(FAR struct tcp_conn_s *conn, int timeout);
 #endif
 
+/****************************************************************************
+ * Name: tcp_update_acktimer
+ *
+ * Description:
+ *   Start the delayed ACK TCP timer for the provided TCP connection, after
+ *   an ACK has been deferred
+ *
+ * Input Parameters:
+ *   conn - The TCP "connection" with a delayed ACK
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   conn is not NULL.
+ *   The connection (conn) is bound to the polling device (dev).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+void tcp_update_acktimer(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_stop_timer
  *
@@ -1392,6 +1528,20 @@ int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 ssize_t psock_tcp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive without copying:  Take all of the data buffered in the
+ *   read-ahead I/O buffer chain of the connection (see psock_recviob()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECVIOB
+ssize_t psock_tcp_recviob(FAR struct socket *psock,
+                          FAR struct iob_s **iob, int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_tcp_send
  *
@@ -2019,6 +2169,197 @@ int tcp_ioctl(FAR struct tcp_conn_s *conn, int cmd, unsigned long arg);
 void tcp_sendbuffer_notify(FAR struct tcp_conn_s *conn);
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+#ifdef CONFIG_NET_TCP_SACK
+/****************************************************************************
+ * Name: tcp_sack_update
+ *
+ * Description:
+ *   Update the SACK scoreboard of the connection from the SACK option of
+ *   the received segment 'tcp' and discard the blocks that are now covered
+ *   by the cumulative acknowledgment 'ackno'.
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_update(FAR struct tcp_conn_s *conn,
+                     FAR struct tcp_hdr_s *tcp, uint32_t ackno);
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the first range of unacknowledged data, not reported by the peer
+ *   and not yet retransmitted in this recovery, that lies below the highest
+ *   SACK block.
+ *
+ * Returned Value:
+ *   true if a hole was found; its start and length are returned in 'seq'
+ *   and 'len'.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn,
+                       FAR uint32_t *seq, FAR uint32_t *len);
+
+/****************************************************************************
+ * Name: tcp_sack_covered
+ *
+ * Description:
+ *   Return true if the 'len' bytes starting at 'seq' have all been
+ *   reported as received by the peer.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_covered(FAR struct tcp_conn_s *conn, uint32_t seq,
+                      uint32_t len);
+
+/****************************************************************************
+ * Name: tcp_sack_reset
+ *
+ * Description:
+ *   Forget the SACK scoreboard and leave the SACK recovery.
+ *
+ ****************************************************************************/
+
+void tcp_sack_reset(FAR struct tcp_conn_s *conn);
+#endif /* CONFIG_NET_TCP_SACK */
+
+#ifdef CONFIG_NET_TCP_CC
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm called 'name' for the
+ *   connection.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of the connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_window
+ *
+ * Description:
+ *   Return the congestion window of the connection, setting it up to the
+ *   initial window first if needed.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_window(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window after 'acked' bytes of new data were
+ *   acknowledged by 'ackno'.
+ *
+ * Returned Value:
+ *   true if 'ackno' is a partial acknowledgment during a fast recovery:
+ *   The segment at 'ackno' is lost too and should be retransmitted.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                uint32_t acked);
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window after a loss detected by duplicate ACKs
+ *   (timeout == false), which starts a fast recovery, or by the
+ *   retransmission timer.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout);
+
+/****************************************************************************
+ * Name: tcp_newreno_ack
+ *
+ * Description:
+ *   The slow start and congestion avoidance of RFC 5681.  Also used by the
+ *   other algorithms for their slow start.
+ *
+ ****************************************************************************/
+
+void tcp_newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/****************************************************************************
+ * Name: tcp_cubic_ops
+ *
+ * Description:
+ *   Return the operations of the CUBIC congestion control algorithm.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cubic_ops(void);
+#endif
+#endif /* CONFIG_NET_TCP_CC */
+
+#ifdef CONFIG_NET_TCP_INFO
+/****************************************************************************
+ * Name: tcp_info_sent
+ *
+ * Description:
+ *   Account for a data segment of 'len' bytes at 'seq' that is being sent.
+ *   The segment is timed if no other one is, unless it is retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_sent(FAR struct tcp_conn_s *conn, uint32_t seq,
+                   uint16_t len, bool rexmit);
+
+/****************************************************************************
+ * Name: tcp_info_acked
+ *
+ * Description:
+ *   Account for 'acked' bytes of new data acknowledged by 'ackno', and
+ *   update the round trip time if the timed segment is acknowledged.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_acked(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                    uint32_t acked);
+
+/****************************************************************************
+ * Name: tcp_info_get
+ *
+ * Description:
+ *   Return the statistics of the connection for the TCP_INFO socket option
+ *   and the procfs.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_get(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info);
+#endif /* CONFIG_NET_TCP_INFO */
+
 #ifdef __cplusplus
 }
 #endif
@@ -54,6 +54,7 @@
 #include <nuttx/net/tcp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -127,11 +128,46 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        *    traffic and better performance but seems non-compliant.
        */
 
-      if (conn->rx_unackseg > 0 || dev->d_sndlen > 0 ||
-          result != TCP_SNDACK)
+      if (dev->d_sndlen > 0 || result != TCP_SNDACK)
         {
           /* Reset the delayed ACK state and send the ACK with this packet. */
 
+          conn->rx_unackseg = 0;
+        }
+#if CONFIG_NET_TCP_QUICKACK > 0
+      else if (conn->rx_quickack > 0)
+        {
+          /* ACK at once at the start of the connection and after a loss */
+
+          conn->rx_quickack--;
+          conn->rx_unackseg = 0;
+        }
+#endif
+      else if (conn->rx_unackseg > 0)
+        {
+#ifdef CONFIG_NET_TCP_ACK_COALESCE
+          if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+            {
+              /* The ACK is due.  Leave it to the next poll of the device
+               * (see tcp_poll()), which runs after the segments received
+               * in the meantime and ACKs them all at once.
+               */
+
+              if (conn->rx_unackseg++ == 1)
+                {
+                  netdev_txnotify_dev(dev);
+                }
+              else if (conn->rx_unackseg == 0)
+                {
+                  conn->rx_unackseg = UINT8_MAX;
+                }
+
+              return;
+            }
+#endif
+
+          /* Reset the delayed ACK state and send the ACK with this packet. */
+
           conn->rx_unackseg = 0;
         }
       else
@@ -142,6 +178,7 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
            */
 
           conn->rx_unackseg = 1;
+          tcp_update_acktimer(conn);
           return;
         }
     }
@@ -230,7 +267,12 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * MSS (the minimum of the MSS and the available window).
        */
 
+#ifdef CONFIG_NETDEV_TSO
+      DEBUGASSERT(dev->d_sndlen <= conn->mss ||
+                  dev->d_sndlen <= dev->d_tsomax);
+#else
       DEBUGASSERT(dev->d_sndlen <= conn->mss);
+#endif
 
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || defined(CONFIG_NET_SENDFILE)
 
@@ -339,6 +381,9 @@ void tcp_rexmit(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
           saveseq = tcp_getsequence(conn->sndseq);
           tcp_setsequence(conn->sndseq, conn->rexmit_seq);
+#ifdef CONFIG_NET_TCP_INFO
+          tcp_info_sent(conn, conn->rexmit_seq, dev->d_sndlen, true);
+#endif
 
           tcp_send(dev, conn, TCP_ACK | TCP_PSH, dev->d_sndlen + hdrlen);
 
@@ -355,7 +400,21 @@ void tcp_rexmit(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   if (dev->d_sndlen > 0 && conn->tx_unacked > 0)
 #endif
     {
-      uint32_t seq;
+      uint32_t seq = tcp_getsequence(conn->sndseq);
+
+#ifdef CONFIG_NET_TCP_INFO
+      /* The buffered send logic accounts for its own segments */
+
+#if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_NET_SENDFILE)
+      if (conn->sendfile)
+#endif
+#if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || defined(CONFIG_NET_SENDFILE)
+        {
+          tcp_info_sent(conn, seq, dev->d_sndlen,
+                        (result & TCP_REXMIT) != 0);
+        }
+#endif
+#endif
 
       /* We always set the ACK flag in response packets adding the length of
        * the IP and TCP headers.
@@ -365,7 +424,6 @@ void tcp_rexmit(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
       /* Advance sndseq */
 
-      seq = tcp_getsequence(conn->sndseq);
       tcp_setsequence(conn->sndseq, seq + dev->d_sndlen);
     }
 
@@ -109,6 +109,9 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
         }
 
       net_incr32(conn->rcvseq, recvlen);
+#ifdef CONFIG_NET_TCP_INFO
+      conn->bytes_received += recvlen;
+#endif
     }
 
   /* In any event, the new data has now been handled */
@@ -264,7 +267,7 @@ uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
 
       if (iob == NULL)
         {
-          iob = iob_tryalloc(throttled);
+          iob = iob_tryalloc_len(throttled, buflen - copied);
           if (iob == NULL)
             {
               continue;
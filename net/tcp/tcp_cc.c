@@ -0,0 +1,353 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_newreno_loss(FAR struct tcp_conn_s *conn, bool timeout);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct tcp_cc_ops_s g_tcp_newreno =
+{
+  "newreno",            /* name */
+  NULL,                 /* init */
+  tcp_newreno_ack,      /* ack */
+  tcp_newreno_loss      /* loss */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_ops
+ *
+ * Description:
+ *   Return the congestion control algorithm of the connection.
+ *
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s *tcp_cc_ops(FAR struct tcp_conn_s *conn)
+{
+  if (conn->cc == NULL)
+    {
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+      conn->cc = tcp_cubic_ops();
+#else
+      conn->cc = &g_tcp_newreno;
+#endif
+    }
+
+  return conn->cc;
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_loss
+ *
+ * Description:
+ *   Set the slow start threshold to half of the data in flight (RFC 5681,
+ *   equation 4).  The window is not inflated during the fast recovery.
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  uint32_t ssthresh = conn->tx_unacked / 2;
+
+  if (ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  conn->ssthresh = ssthresh;
+  conn->cwnd     = timeout ? conn->mss : ssthresh;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm called 'name' for the
+ *   connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   name - The name of the algorithm: "newreno" or "cubic"
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+
+  if (strcmp(name, g_tcp_newreno.name) == 0)
+    {
+      ops = &g_tcp_newreno;
+    }
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  else if (strcmp(name, tcp_cubic_ops()->name) == 0)
+    {
+      ops = tcp_cubic_ops();
+    }
+#endif
+  else
+    {
+      return -ENOENT;
+    }
+
+  /* The window is kept, only the state of the algorithm starts over */
+
+  conn->cc = ops;
+  if (ops->init != NULL)
+    {
+      ops->init(conn);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of the connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn)
+{
+  return tcp_cc_ops(conn)->name;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_window
+ *
+ * Description:
+ *   Return the congestion window of the connection, setting it up to the
+ *   initial window of RFC 5681 (section 3.1) first if needed.
+ *
+ * Assumptions:
+ *   The network is locked and the MSS of the connection is known.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_window(FAR struct tcp_conn_s *conn)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  uint32_t mss;
+
+  if (conn->cwnd == 0)
+    {
+      /* Assume the default MSS of RFC 879 if none is known yet */
+
+      mss = conn->mss > 0 ? conn->mss : 536;
+      if (mss > 2190)
+        {
+          conn->cwnd = 2 * mss;
+        }
+      else if (mss > 1095)
+        {
+          conn->cwnd = 3 * mss;
+        }
+      else
+        {
+          conn->cwnd = 4 * mss;
+        }
+
+      conn->ssthresh    = UINT32_MAX;
+      conn->cc_recovery = false;
+
+      ops = tcp_cc_ops(conn);
+      if (ops->init != NULL)
+        {
+          ops->init(conn);
+        }
+    }
+
+  return conn->cwnd;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Update the congestion window after 'acked' bytes of new data were
+ *   acknowledged by 'ackno'.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   ackno - The acknowledgment number received
+ *   acked - The number of bytes newly acknowledged
+ *
+ * Returned Value:
+ *   true if 'ackno' is a partial acknowledgment during a fast recovery
+ *   (RFC 6582):  The segment at 'ackno' is lost too and should be
+ *   retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                uint32_t acked)
+{
+  uint32_t cwnd = tcp_cc_window(conn);
+
+  if (conn->cc_recovery)
+    {
+      if (TCP_SEQ_LT(ackno, conn->cc_recover))
+        {
+          return true;
+        }
+
+      /* Everything outstanding at the loss has been ACKed */
+
+      conn->cc_recovery = false;
+      conn->cwnd        = conn->ssthresh;
+      return false;
+    }
+
+  /* Do not grow the window while much less than it is in use, the
+   * application or the receive window of the peer is the limit then.
+   */
+
+  if (2 * (conn->tx_unacked + acked) >= cwnd)
+    {
+      tcp_cc_ops(conn)->ack(conn, acked);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window after a loss detected by duplicate ACKs
+ *   (timeout == false), which starts a fast recovery, or by the
+ *   retransmission timer.
+ *
+ * Assumptions:
+ *   The network is locked.  When called for a time-out, the data in flight
+ *   has not been requeued yet.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  tcp_cc_window(conn);
+
+  if (!timeout && conn->cc_recovery)
+    {
+      /* The window is reduced only once per window of data */
+
+      return;
+    }
+
+  if (timeout && conn->nrtx > 1)
+    {
+      /* The same data timed out again: Keep the threshold (RFC 5681) */
+
+      conn->cwnd = conn->mss;
+    }
+  else
+    {
+      tcp_cc_ops(conn)->loss(conn, timeout);
+    }
+
+  ninfo("CC: %s loss cwnd=%" PRIu32 " ssthresh=%" PRIu32 "\n",
+        timeout ? "timeout" : "dupack", conn->cwnd, conn->ssthresh);
+
+  conn->cc_recovery = !timeout;
+  conn->cc_recover  = conn->sndseq_max;
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_ack
+ *
+ * Description:
+ *   The slow start and congestion avoidance of RFC 5681 (equations 2 and
+ *   3).  Also used by the other algorithms for their slow start.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_newreno_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t mss = conn->mss;
+  uint32_t incr;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      incr = acked < mss ? acked : mss;
+    }
+  else
+    {
+      incr = mss * mss / conn->cwnd;
+      if (incr == 0)
+        {
+          incr = 1;
+        }
+    }
+
+  if (conn->cwnd + incr > conn->cwnd)
+    {
+      conn->cwnd += incr;
+    }
+}
+
+#endif /* CONFIG_NET_TCP_CC */
@@ -0,0 +1,270 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC 8312:  beta_cubic = 0.7 and C = 0.4, scaled by
+ * 1024 and 10.  alpha_cubic = 3 * (1 - beta) / (1 + beta) of the Reno
+ * friendly region, scaled by 1024.
+ */
+
+#define CUBIC_BETA         717
+#define CUBIC_C            4
+#define CUBIC_ALPHA        542
+
+/* The time from the start of the epoch is clamped to this many msec away
+ * from K, so that the cube of it times the MSS does not overflow.
+ */
+
+#define CUBIC_MAXDELTA     100000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void tcp_cubic_loss(FAR struct tcp_conn_s *conn, bool timeout);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",              /* name */
+  tcp_cubic_init,       /* init */
+  tcp_cubic_ack,        /* ack */
+  tcp_cubic_loss        /* loss */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of 'x' (rounded down).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_init
+ ****************************************************************************/
+
+static void tcp_cubic_init(FAR struct tcp_conn_s *conn)
+{
+  memset(&conn->cubic, 0, sizeof(struct tcp_cubic_s));
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ack
+ *
+ * Description:
+ *   Grow the window towards W_cubic(t) = C * (t - K)^3 + W_max, or along
+ *   the estimated Reno window if that is larger (RFC 8312, section 4).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t mss = conn->mss;
+  clock_t now;
+  int64_t delta;
+  int64_t target;
+  uint32_t incr;
+
+  if (cwnd < conn->ssthresh)
+    {
+      tcp_newreno_ack(conn, acked);
+      return;
+    }
+
+  now = clock_systime_ticks();
+  if (cubic->epoch == 0)
+    {
+      /* A new epoch of congestion avoidance starts.  K is the time in
+       * msec that W_cubic takes to grow back to W_max:
+       * K = cbrt((W_max - cwnd) / C), with the windows in segments.
+       */
+
+      cubic->epoch = now != 0 ? now : 1;
+      if (cwnd < cubic->wmax)
+        {
+          cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->wmax - cwnd) *
+                                    (10000000000ull / CUBIC_C) / mss);
+        }
+      else
+        {
+          cubic->k    = 0;
+          cubic->wmax = cwnd;
+        }
+
+      cubic->west = cwnd;
+    }
+
+  delta = (int64_t)TICK2MSEC(now - cubic->epoch) - cubic->k;
+  if (delta > CUBIC_MAXDELTA)
+    {
+      delta = CUBIC_MAXDELTA;
+    }
+  else if (delta < -CUBIC_MAXDELTA)
+    {
+      delta = -CUBIC_MAXDELTA;
+    }
+
+  /* C * delta^3 with delta in msec (1e9 msec^3 per sec^3), in bytes */
+
+  target = (delta * delta * delta * CUBIC_C / 100000) * mss / 100000;
+  target += cubic->wmax;
+
+  /* The Reno friendly region grows by alpha_cubic segments per RTT */
+
+  cubic->west += (uint32_t)((uint64_t)acked * mss * CUBIC_ALPHA / 1024 /
+                            cwnd);
+  if (target < cubic->west)
+    {
+      target = cubic->west;
+    }
+
+  /* Never more than 1.5 times the window in one RTT */
+
+  if (target > cwnd + (int64_t)cwnd / 2)
+    {
+      target = cwnd + (int64_t)cwnd / 2;
+    }
+
+  if (target > cwnd)
+    {
+      incr = (uint32_t)((target - cwnd) * acked / cwnd);
+    }
+  else
+    {
+      incr = (uint32_t)((uint64_t)mss * acked / (100 * (uint64_t)cwnd));
+    }
+
+  if (cwnd + incr > cwnd)
+    {
+      conn->cwnd = cwnd + incr;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_loss
+ *
+ * Description:
+ *   Remember the window at the loss as W_max, with fast convergence, and
+ *   reduce the window by beta_cubic (RFC 8312, sections 4.5 and 4.6).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cubic;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t ssthresh;
+
+  cubic->epoch = 0;
+  if (cwnd < cubic->lastwmax)
+    {
+      /* The available bandwidth decreases: Release some for new flows */
+
+      cubic->wmax = (uint32_t)((uint64_t)cwnd * (1024 + CUBIC_BETA) / 2048);
+    }
+  else
+    {
+      cubic->wmax = cwnd;
+    }
+
+  cubic->lastwmax = cwnd;
+
+  ssthresh = (uint32_t)((uint64_t)cwnd * CUBIC_BETA / 1024);
+  if (ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  conn->ssthresh = ssthresh;
+  conn->cwnd     = timeout ? conn->mss : ssthresh;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_ops
+ *
+ * Description:
+ *   Return the operations of the CUBIC congestion control algorithm.
+ *
+ ****************************************************************************/
+
+FAR const struct tcp_cc_ops_s *tcp_cubic_ops(void)
+{
+  return &g_tcp_cubic;
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -44,6 +44,7 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP)
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 #include <assert.h>
@@ -65,6 +66,7 @@
 
 #include "devif/devif.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "tcp/tcp.h"
 #include "arp/arp.h"
 #include "icmpv6/icmpv6.h"
@@ -76,6 +78,23 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* The active connections that may match an incoming segment or use a local
+ * port:  Either the chain of one hash bucket or the whole active list.
+ */
+
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+#  define tcp_nexthash(c) ((c)->hnext)
+#  define tcp_nextport(c) ((c)->pnext)
+#else
+#  define tcp_nexthash(c) ((FAR struct tcp_conn_s *)(c)->sconn.node.flink)
+#  define tcp_nextport(c) ((FAR struct tcp_conn_s *)(c)->sconn.node.flink)
+#endif
+
+/* The number of 16-bit words of an IP address */
+
+#define IPv4_ADDRWORDS (sizeof(in_addr_t) / sizeof(uint16_t))
+#define IPv6_ADDRWORDS (sizeof(net_ipv6addr_t) / sizeof(uint16_t))
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,10 +113,169 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+/* The active connections hashed by the local port, the remote port and the
+ * remote address, and hashed by the local port alone.  The local address
+ * is not part of the hash because a connection bound to INADDR_ANY matches
+ * any destination address.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_HASH_SIZE];
+static FAR struct tcp_conn_s *g_tcp_porthash[CONFIG_NET_TCP_HASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+/****************************************************************************
+ * Name: tcp_porthash
+ *
+ * Description:
+ *   Return the bucket of the local port hash table for 'lport'.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_porthash(uint16_t lport)
+{
+  return (lport ^ (lport >> 8)) % CONFIG_NET_TCP_HASH_SIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_connhash
+ *
+ * Description:
+ *   Return the bucket of the connection hash table for the local and the
+ *   remote port and the remote address of 'nwords' 16-bit words.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_connhash(uint16_t lport, uint16_t rport,
+                                 FAR const uint16_t *raddr, int nwords)
+{
+  uint32_t hash = ((uint32_t)lport << 16) | rport;
+  int i;
+
+  for (i = 0; i < nwords; i++)
+    {
+      hash = (hash ^ raddr[i]) * 16777619u;
+    }
+
+  return (hash ^ (hash >> 16)) % CONFIG_NET_TCP_HASH_SIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_connbucket
+ *
+ * Description:
+ *   Return the bucket of the connection hash table for 'conn'.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_connbucket(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_connhash(conn->lport, conn->rport,
+                          (FAR const uint16_t *)&conn->u.ipv4.raddr,
+                          IPv4_ADDRWORDS);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_connhash(conn->lport, conn->rport, conn->u.ipv6.raddr,
+                          IPv6_ADDRWORDS);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_hash_remove
+ *
+ * Description:
+ *   Remove 'conn' from the chain starting at 'head' using the link at
+ *   'offset' in the connection structure.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_remove(FAR struct tcp_conn_s **head,
+                            FAR struct tcp_conn_s *conn, size_t offset)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = head; *link != NULL;
+       link = (FAR struct tcp_conn_s **)((FAR char *)*link + offset))
+    {
+      if (*link == conn)
+        {
+          *link = *(FAR struct tcp_conn_s **)((FAR char *)conn + offset);
+          break;
+        }
+    }
+}
+#endif /* CONFIG_NET_TCP_HASH_SIZE > 0 */
+
+/****************************************************************************
+ * Name: tcp_addactive
+ *
+ * Description:
+ *   Put a connection whose ports and remote address are set into the list
+ *   and the hash tables of the active connections.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_addactive(FAR struct tcp_conn_s *conn)
+{
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  FAR struct tcp_conn_s **head;
+
+  head        = &g_tcp_connhash[tcp_connbucket(conn)];
+  conn->hnext = *head;
+  *head       = conn;
+
+  head        = &g_tcp_porthash[tcp_porthash(conn->lport)];
+  conn->pnext = *head;
+  *head       = conn;
+#endif
+
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+}
+
+/****************************************************************************
+ * Name: tcp_remactive
+ *
+ * Description:
+ *   Remove a connection from the list and the hash tables of the active
+ *   connections.
+ *
+ * Assumptions:
+ *   This function is called with the network locked.
+ *
+ ****************************************************************************/
+
+static void tcp_remactive(FAR struct tcp_conn_s *conn)
+{
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  tcp_hash_remove(&g_tcp_connhash[tcp_connbucket(conn)], conn,
+                  offsetof(struct tcp_conn_s, hnext));
+  tcp_hash_remove(&g_tcp_porthash[tcp_porthash(conn->lport)], conn,
+                  offsetof(struct tcp_conn_s, pnext));
+#endif
+
+  dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -108,17 +286,26 @@ static dq_queue_t g_active_tcp_connections;
  *   Primary uses: (1) to determine if a port number is available, (2) to
  *   To identify the socket that will accept new connections on a local port.
  *
+ *   If 'bindconn' is the connection that binds the port and SO_REUSEPORT is
+ *   set on it, the connections that set SO_REUSEPORT as well do not count.
+ *
  ****************************************************************************/
 
 static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
-               uint16_t portno)
+               uint16_t portno, FAR struct tcp_conn_s *bindconn)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  conn = g_tcp_porthash[tcp_porthash(portno)];
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
+  for (; conn != NULL; conn = tcp_nextport(conn))
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -130,6 +317,14 @@ static FAR struct tcp_conn_s *
 #endif
          )
         {
+          /* Sockets that all set SO_REUSEPORT may share the port */
+
+          if (bindconn != NULL && _SO_ISREUSEPORT(bindconn) &&
+              _SO_ISREUSEPORT(conn))
+            {
+              continue;
+            }
+
           /* If there are multiple interface devices, then the local IP
            * address of the connection must also match.  INADDR_ANY is a
            * special case:  There can only be instance of a port number
@@ -182,6 +377,7 @@ static FAR struct tcp_conn_s *
  * Input Parameters:
  *   portno -- the selected port number in network order. Zero means no port
  *     selected.
+ *   conn -- the connection that binds the port, NULL if none.
  *
  * Returned Value:
  *   Selected or verified port number in network order on success, a negated
@@ -199,7 +395,7 @@ static FAR struct tcp_conn_s *
 
 static int tcp_selectport(uint8_t domain,
                           FAR const union ip_addr_u *ipaddr,
-                          uint16_t portno)
+                          uint16_t portno, FAR struct tcp_conn_s *conn)
 {
   static uint16_t g_last_tcp_port;
   ssize_t ret;
@@ -251,7 +447,7 @@ static int tcp_selectport(uint8_t domain,
 
           portno = HTONS(g_last_tcp_port);
         }
-      while (tcp_listener(domain, ipaddr, portno));
+      while (tcp_listener(domain, ipaddr, portno, NULL));
     }
   else
     {
@@ -259,7 +455,7 @@ static int tcp_selectport(uint8_t domain,
        * connection is using this local port.
        */
 
-      if (tcp_listener(domain, ipaddr, portno))
+      if (tcp_listener(domain, ipaddr, portno, conn))
         {
           /* It is in use... return EADDRINUSE */
 
@@ -293,10 +489,17 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  conn = g_tcp_connhash[tcp_connhash(tcp->destport, tcp->srcport,
+                                     (FAR const uint16_t *)&srcipaddr,
+                                     IPv4_ADDRWORDS)];
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -332,7 +535,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_nexthash(conn);
     }
 
   return conn;
@@ -360,10 +563,16 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#if CONFIG_NET_TCP_HASH_SIZE > 0
+  conn = g_tcp_connhash[tcp_connhash(tcp->destport, tcp->srcport,
+                                     ip->srcipaddr, IPv6_ADDRWORDS)];
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -399,7 +608,7 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+      conn = tcp_nexthash(conn);
     }
 
   return conn;
@@ -436,7 +645,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET,
                        (FAR const union ip_addr_u *)&addr->sin_addr.s_addr,
-                       addr->sin_port);
+                       addr->sin_port, conn);
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -503,7 +712,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET6,
                 (FAR const union ip_addr_u *)addr->sin6_addr.in6_u.u6_addr16,
-                addr->sin6_port);
+                addr->sin6_port, conn);
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -789,7 +998,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     {
       /* Remove the connection from the active list */
 
-      dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_remactive(conn);
     }
 
   /* Release any read-ahead buffers attached to the connection */
@@ -1058,7 +1267,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_addactive(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1166,7 +1375,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET,
                                 (FAR const union ip_addr_u *)
-                                &conn->u.ipv4.laddr, 0);
+                                &conn->u.ipv4.laddr, 0, NULL);
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1181,7 +1390,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET6,
                                 (FAR const union ip_addr_u *)
-                                conn->u.ipv6.laddr, 0);
+                                conn->u.ipv6.laddr, 0, NULL);
         }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -1331,7 +1540,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_addactive(conn);
   ret = OK;
 
 errout_with_lock:
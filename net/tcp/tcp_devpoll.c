@@ -56,6 +56,40 @@
 #include "devif/devif.h"
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_poll_ack
+ *
+ * Description:
+ *   Send the ACK that tcp_appsend() deferred for the segments received
+ *   since the last poll, unless it was just sent with data.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure to use in the send operation
+ *   conn - The TCP connection with the deferred ACK
+ *
+ * Assumptions:
+ *   It is called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_ACK_COALESCE
+static void tcp_poll_ack(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn)
+{
+  if (dev->d_len == 0 && conn->rx_unackseg > 1 &&
+      (conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+    {
+      conn->rx_unackseg = 0;
+      conn->rx_acktimer = 0;
+      tcp_synack(dev, conn, TCP_ACK);
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +127,9 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
     {
       conn->timeout = false;
       tcp_timer(dev, conn);
+#ifdef CONFIG_NET_TCP_ACK_COALESCE
+      tcp_poll_ack(dev, conn);
+#endif
       return;
     }
 
@@ -131,6 +168,9 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
       /* Handle the callback response */
 
       tcp_appsend(dev, conn, result);
+#ifdef CONFIG_NET_TCP_ACK_COALESCE
+      tcp_poll_ack(dev, conn);
+#endif
     }
 }
 
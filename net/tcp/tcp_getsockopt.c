@@ -26,6 +26,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -82,9 +83,10 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_INFO)
+  /* Keep alive, congestion control and TCP_INFO options are the only TCP
+   * protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -105,10 +107,9 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
-
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -221,6 +222,56 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* The congestion control algorithm */
+        if (*value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            FAR const char *name;
+
+            net_lock();
+            name = tcp_cc_name(conn);
+            net_unlock();
+
+            /* Silently truncate the name to the size of the buffer */
+
+            strlcpy(value, name, *value_len);
+            if (*value_len > strlen(name) + 1)
+              {
+                *value_len = strlen(name) + 1;
+              }
+
+            ret = OK;
+          }
+        break;
+#endif /* CONFIG_NET_TCP_CC */
+
+#ifdef CONFIG_NET_TCP_INFO
+      case TCP_INFO: /* The statistics of the connection */
+        {
+          struct tcp_info info;
+
+          net_lock();
+          tcp_info_get(conn, &info);
+          net_unlock();
+
+          /* Silently truncate the statistics to the size of the buffer */
+
+          if (*value_len > sizeof(struct tcp_info))
+            {
+              *value_len = sizeof(struct tcp_info);
+            }
+
+          memcpy(value, &info, *value_len);
+          ret = OK;
+        }
+        break;
+#endif /* CONFIG_NET_TCP_INFO */
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -231,7 +282,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
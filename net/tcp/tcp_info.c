@@ -0,0 +1,187 @@
+/****************************************************************************
+ * net/tcp/tcp_info.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <netinet/tcp.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_INFO
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_info_sent
+ *
+ * Description:
+ *   Account for a data segment of 'len' bytes at 'seq' that is being sent.
+ *   The segment is timed if no other one is, unless it is retransmitted.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection
+ *   seq    - The sequence number of the segment
+ *   len    - The number of data bytes in the segment
+ *   rexmit - True if the segment is retransmitted
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_sent(FAR struct tcp_conn_s *conn, uint32_t seq,
+                   uint16_t len, bool rexmit)
+{
+  if (rexmit)
+    {
+      /* The ACK of a retransmitted segment cannot be told apart from the
+       * ACK of the original one:  Stop timing (Karn's algorithm).
+       */
+
+      conn->total_retrans++;
+      conn->rtt_timing = false;
+    }
+  else if (!conn->rtt_timing)
+    {
+      conn->rtt_timing = true;
+      conn->rtt_start  = clock_systime_ticks();
+      conn->rtt_seq    = TCP_SEQ_ADD(seq, len);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_info_acked
+ *
+ * Description:
+ *   Account for 'acked' bytes of new data acknowledged by 'ackno', and
+ *   update the round trip time if the timed segment is acknowledged.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   ackno - The acknowledgment number received
+ *   acked - The number of bytes newly acknowledged
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_acked(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                    uint32_t acked)
+{
+  uint32_t rtt;
+  uint32_t delta;
+
+  conn->bytes_acked += acked;
+
+  if (!conn->rtt_timing || TCP_SEQ_LT(ackno, conn->rtt_seq))
+    {
+      return;
+    }
+
+  conn->rtt_timing = false;
+  rtt = TICK2USEC(clock_systime_ticks() - conn->rtt_start);
+
+  /* Update the estimates as RFC 6298 (2.2, 2.3) */
+
+  if (conn->srtt == 0)
+    {
+      conn->srtt   = rtt;
+      conn->rttvar = rtt / 2;
+    }
+  else
+    {
+      delta        = conn->srtt > rtt ? conn->srtt - rtt : rtt - conn->srtt;
+      conn->rttvar = conn->rttvar - (conn->rttvar >> 2) + (delta >> 2);
+      conn->srtt   = conn->srtt - (conn->srtt >> 3) + (rtt >> 3);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_info_get
+ *
+ * Description:
+ *   Return the statistics of the connection for the TCP_INFO socket option
+ *   and the procfs.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   info - The location to return the statistics
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_info_get(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info)
+{
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+#endif
+
+  memset(info, 0, sizeof(struct tcp_info));
+
+  info->tcpi_state          = conn->tcpstateflags & TCP_STATE_MASK;
+  info->tcpi_retransmits    = conn->nrtx;
+  info->tcpi_snd_mss        = conn->mss;
+  info->tcpi_rto            = conn->rto * (USEC_PER_SEC / HSEC_PER_SEC);
+  info->tcpi_rtt            = conn->srtt;
+  info->tcpi_rttvar         = conn->rttvar;
+#ifdef CONFIG_NET_TCP_CC
+  info->tcpi_snd_ssthresh   = conn->ssthresh;
+  info->tcpi_snd_cwnd       = conn->cwnd;
+#endif
+  info->tcpi_snd_wnd        = conn->snd_wnd;
+  info->tcpi_unacked        = conn->tx_unacked;
+  info->tcpi_total_retrans  = conn->total_retrans;
+  info->tcpi_bytes_acked    = conn->bytes_acked;
+  info->tcpi_bytes_received = conn->bytes_received;
+
+  if (conn->readahead != NULL)
+    {
+      info->tcpi_rcv_queued = conn->readahead->io_pktlen;
+    }
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  /* The buffers of the write queue may have been sent in part */
+
+  for (entry = sq_peek(&conn->write_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      info->tcpi_notsent_bytes += TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
+    }
+#endif
+}
+
+#endif /* CONFIG_NET_TCP_INFO */
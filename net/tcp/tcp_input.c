@@ -324,7 +324,8 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_CSUM_OFFLOAD(dev, NETDEV_CSUM_RX_TCP) &&
+      tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -488,6 +489,14 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                       conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                       conn->flags    |= TCP_WSCALE;
                     }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                          dev->d_buf[hdrlen + 1 + i] ==
+                          TCP_OPT_SACK_PERM_LEN)
+                    {
+                      conn->flags |= TCP_SACK;
+                    }
 #endif
                   else
                     {
@@ -663,6 +672,9 @@ found:
           if (TCP_SEQ_LT(seq, rcvseq))
             {
               uint32_t trimlen = TCP_SEQ_SUB(rcvseq, seq);
+#if defined(CONFIG_NET_TCP_DELAYED_ACK) && CONFIG_NET_TCP_QUICKACK > 0
+              uint16_t seglen = dev->d_len;
+#endif
 
               if (tcp_trim_head(dev, tcp, trimlen))
                 {
@@ -671,14 +683,29 @@ found:
                    * E.g. a keep-alive segment.
                    */
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK) && CONFIG_NET_TCP_QUICKACK > 0
+                  if (seglen > 1)
+                    {
+                      /* Data received again, not a keep-alive probe:  Our
+                       * ACK may have been lost or delayed too long.
+                       */
+
+                      tcp_enter_quickack(conn);
+                    }
+#endif
+
                   tcp_send(dev, conn, TCP_ACK, tcpiplen);
                   return;
                 }
             }
           else
             {
-              /* We never queue out-of-order segments. */
+              /* We never queue out-of-order segments.  A segment is
+               * missing:  ACK the ones that follow at once, so that the
+               * peer recovers quickly.
+               */
 
+              tcp_enter_quickack(conn);
               tcp_send(dev, conn, TCP_ACK, tcpiplen);
               return;
             }
@@ -730,6 +757,14 @@ found:
 
       if (TCP_SEQ_LTE(ackseq, unackseq))
         {
+#ifdef CONFIG_NET_TCP_INFO
+          if (conn->tx_unacked > unackseq - ackseq)
+            {
+              tcp_info_acked(conn, ackseq,
+                             conn->tx_unacked - (unackseq - ackseq));
+            }
+#endif
+
           /* Calculate the new number of outstanding, unacknowledged bytes */
 
           conn->tx_unacked = unackseq - ackseq;
@@ -840,6 +875,7 @@ found:
              */
 
             conn->tcpstateflags = TCP_ESTABLISHED;
+            tcp_enter_quickack(conn);
 
             /* Wake up any listener waiting for a connection on this port */
 
@@ -953,6 +989,14 @@ found:
                         conn->rcv_scale = CONFIG_NET_TCP_WINDOW_SCALE_FACTOR;
                         conn->flags    |= TCP_WSCALE;
                       }
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                            dev->d_buf[hdrlen + 1 + i] ==
+                            TCP_OPT_SACK_PERM_LEN)
+                      {
+                        conn->flags |= TCP_SACK;
+                      }
 #endif
                     else
                       {
@@ -975,6 +1019,7 @@ found:
               }
 
             conn->tcpstateflags = TCP_ESTABLISHED;
+            tcp_enter_quickack(conn);
             memcpy(conn->rcvseq, tcp->seqno, 4);
             conn->rcv_adv = tcp_getsequence(conn->rcvseq);
             tcp_snd_wnd_init(conn, tcp);
@@ -53,6 +53,7 @@
 
 #include "devif/devif.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -141,6 +142,127 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
   return NULL;
 }
 
+/****************************************************************************
+ * Name: tcp_samelistener
+ *
+ * Description:
+ *   Return true if 'other' is bound to the same local address and port as
+ *   'listener', and both set SO_REUSEPORT.
+ *
+ ****************************************************************************/
+
+static bool tcp_samelistener(FAR struct tcp_conn_s *listener,
+                             FAR struct tcp_conn_s *other)
+{
+  if (other == NULL || other->lport != listener->lport ||
+      !_SO_ISREUSEPORT(other))
+    {
+      return false;
+    }
+
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+  if (other->domain != listener->domain)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (listener->domain == PF_INET6)
+#  endif
+    {
+      return net_ipv6addr_cmp(other->u.ipv6.laddr, listener->u.ipv6.laddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      return net_ipv4addr_cmp(other->u.ipv4.laddr, listener->u.ipv4.laddr);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_reuseport_select
+ *
+ * Description:
+ *   Select the listener that accepts the new connection 'conn' among the
+ *   listeners that share the address and the port of 'listener' with
+ *   SO_REUSEPORT.  The remote address and port are hashed, so that the
+ *   connections are spread evenly over the listeners, e.g. over one
+ *   listener per CPU with each accept loop running on its own CPU.
+ *
+ * Assumptions:
+ *   This function is called from network logic with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s *
+tcp_reuseport_select(FAR struct tcp_conn_s *listener,
+                     FAR struct tcp_conn_s *conn)
+{
+  FAR const uint16_t *raddr;
+  uint32_t hash = conn->rport;
+  int nwords;
+  int count = 0;
+  int ndx;
+  int i;
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#  endif
+    {
+      raddr  = conn->u.ipv6.raddr;
+      nwords = sizeof(net_ipv6addr_t) / sizeof(uint16_t);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      raddr  = (FAR const uint16_t *)&conn->u.ipv4.raddr;
+      nwords = sizeof(in_addr_t) / sizeof(uint16_t);
+    }
+#endif
+
+  for (i = 0; i < nwords; i++)
+    {
+      hash = (hash ^ raddr[i]) * 16777619u;
+    }
+
+  hash ^= hash >> 16;
+
+  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+    {
+      if (tcp_samelistener(listener, tcp_listenports[ndx]))
+        {
+          count++;
+        }
+    }
+
+  if (count > 1)
+    {
+      count = hash % count;
+      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+        {
+          if (tcp_samelistener(listener, tcp_listenports[ndx]) &&
+              count-- == 0)
+            {
+              return tcp_listenports[ndx];
+            }
+        }
+    }
+
+  return listener;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -189,6 +311,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+  FAR struct tcp_conn_s *listener;
   int ndx;
   int ret;
 
@@ -198,13 +321,18 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 
   net_lock();
 
-  /* First, check if there is already a socket listening on this port */
+  /* First, check if there is already a socket listening on this port.
+   * Sockets that all set SO_REUSEPORT may listen on the same port.
+   */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  if (tcp_islistener(&conn->u, conn->lport, conn->domain))
+  listener = tcp_findlistener(&conn->u, conn->lport, conn->domain);
 #else
-  if (tcp_islistener(&conn->u, conn->lport))
+  listener = tcp_findlistener(&conn->u, conn->lport);
 #endif
+
+  if (listener != NULL &&
+      !(_SO_ISREUSEPORT(conn) && tcp_samelistener(conn, listener)))
     {
       /* Yes, then we must refuse this request */
 
@@ -292,6 +420,18 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
 #endif
   if (listener != NULL)
     {
+      /* Several sockets may listen on the port with SO_REUSEPORT.  Select
+       * one of them, the accepted connection inherits the option.
+       */
+
+      if (_SO_ISREUSEPORT(listener))
+        {
+          listener = tcp_reuseport_select(listener, conn);
+#ifdef CONFIG_NET_SOCKOPTS
+          _SO_SETOPT(conn->sconn.s_options, SO_REUSEPORT);
+#endif
+        }
+
       /* Yes, there is a listener.  Is it accepting connections now? */
 
       if (listener->accept)
@@ -209,6 +209,9 @@ static inline uint16_t tcp_newdata(FAR struct net_driver_s *dev,
     }
 
   net_incr32(conn->rcvseq, recvlen);
+#ifdef CONFIG_NET_TCP_INFO
+  conn->bytes_received += recvlen;
+#endif
 
   /* Indicate no data in the buffer */
 
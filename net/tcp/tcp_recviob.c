@@ -0,0 +1,232 @@
+/****************************************************************************
+ * net/tcp/tcp_recviob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/tcp.h>
+
+#include "netdev/netdev.h"
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+#include "socket/socket.h"
+
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_RECVIOB)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct tcp_recviob_s
+{
+  FAR struct tcp_conn_s       *ir_conn;  /* The connection waited on */
+  FAR struct devif_callback_s *ir_cb;    /* Reference to callback instance */
+  sem_t                        ir_sem;   /* Signals new data or loss */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_recviob_eventhandler
+ *
+ * Description:
+ *   Wake up the waiting thread on new data or on the loss of the
+ *   connection.  TCP_NEWDATA is left set, so that tcp_callback() appends
+ *   the new data to the read-ahead buffers, where the thread takes it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static uint16_t tcp_recviob_eventhandler(FAR struct net_driver_s *dev,
+                                         FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct tcp_recviob_s *pstate = pvpriv;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  if ((flags & TCP_DISCONN_EVENTS) != 0)
+    {
+      /* Handle loss-of-connection event, unless we got here recursively
+       * through tcp_lost_connection().
+       */
+
+      if (_SS_ISCONNECTED(pstate->ir_conn->sconn.s_flags))
+        {
+          tcp_lost_connection(pstate->ir_conn, pstate->ir_cb, flags);
+        }
+    }
+  else if ((flags & TCP_NEWDATA) == 0 || dev->d_len == 0)
+    {
+      return flags;
+    }
+
+  /* Don't allow any further callbacks and wake up the thread */
+
+  pstate->ir_cb->flags = 0;
+  pstate->ir_cb->priv  = NULL;
+  pstate->ir_cb->event = NULL;
+
+  nxsem_post(&pstate->ir_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: tcp_recviob_wait
+ *
+ * Description:
+ *   Wait for new data or for the loss of the connection.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int tcp_recviob_wait(FAR struct tcp_conn_s *conn)
+{
+  struct tcp_recviob_s state;
+  int ret;
+
+  state.ir_conn = conn;
+  nxsem_init(&state.ir_sem, 0, 0);
+  nxsem_set_protocol(&state.ir_sem, SEM_PRIO_NONE);
+
+  state.ir_cb = tcp_callback_alloc(conn);
+  if (state.ir_cb == NULL)
+    {
+      nxsem_destroy(&state.ir_sem);
+      return -EBUSY;
+    }
+
+  state.ir_cb->flags = (TCP_NEWDATA | TCP_DISCONN_EVENTS);
+  state.ir_cb->priv  = (FAR void *)&state;
+  state.ir_cb->event = tcp_recviob_eventhandler;
+
+  ret = net_timedwait(&state.ir_sem, _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+  if (ret == -ETIMEDOUT)
+    {
+      ret = -EAGAIN;
+    }
+
+  tcp_callback_free(conn, state.ir_cb);
+  nxsem_destroy(&state.ir_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_tcp_recviob
+ *
+ * Description:
+ *   Receive without copying:  Take all of the data buffered in the
+ *   read-ahead I/O buffer chain of the connection, waiting for data first
+ *   if there is none and the socket may block.
+ *
+ * Input Parameters:
+ *   psock - The TCP socket
+ *   iob   - The location to return the I/O buffer chain
+ *   flags - Receive flags (MSG_DONTWAIT)
+ *
+ * Returned Value:
+ *   The number of bytes in the chain returned in 'iob', which the caller
+ *   must release with iob_free_chain().  Zero on an orderly shutdown by
+ *   the peer; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t psock_tcp_recviob(FAR struct socket *psock,
+                          FAR struct iob_s **iob, int flags)
+{
+  FAR struct tcp_conn_s *conn;
+  ssize_t ret;
+
+  net_lock();
+
+  conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  for (; ; )
+    {
+      if (conn->readahead != NULL)
+        {
+          /* Hand out the whole read-ahead chain */
+
+          *iob = conn->readahead;
+          conn->readahead = NULL;
+          ret = (*iob)->io_pktlen;
+
+          /* The receive window has opened */
+
+          if (tcp_should_send_recvwindow(conn))
+            {
+              netdev_txnotify_dev(conn->dev);
+            }
+
+          break;
+        }
+
+      if (!_SS_ISCONNECTED(conn->sconn.s_flags))
+        {
+          /* End-of-file after a graceful close */
+
+          ret = _SS_ISCLOSED(conn->sconn.s_flags) ? 0 : -ENOTCONN;
+          break;
+        }
+
+      if (_SS_ISNONBLOCK(conn->sconn.s_flags) ||
+          (flags & MSG_DONTWAIT) != 0)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      ret = tcp_recviob_wait(conn);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* NET_TCP_HAVE_STACK && CONFIG_NET_RECVIOB */
@@ -0,0 +1,335 @@
+/****************************************************************************
+ * net/tcp/tcp_sack.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_SACK
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_remove
+ *
+ * Description:
+ *   Remove 'n' blocks starting at index 'i' from the scoreboard.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_remove(FAR struct tcp_conn_s *conn, unsigned int i,
+                            unsigned int n)
+{
+  memmove(&conn->sack[i], &conn->sack[i + n],
+          (conn->nsacks - i - n) * sizeof(struct tcp_sack_s));
+  conn->nsacks -= n;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_trim
+ *
+ * Description:
+ *   Discard the parts of the scoreboard that are covered by the cumulative
+ *   acknowledgment 'ackno'.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_trim(FAR struct tcp_conn_s *conn, uint32_t ackno)
+{
+  unsigned int i;
+
+  for (i = 0; i < conn->nsacks; i++)
+    {
+      if (TCP_SEQ_GT(conn->sack[i].right, ackno))
+        {
+          break;
+        }
+    }
+
+  tcp_sack_remove(conn, 0, i);
+
+  if (conn->nsacks > 0 && TCP_SEQ_LT(conn->sack[0].left, ackno))
+    {
+      conn->sack[0].left = ackno;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_add
+ *
+ * Description:
+ *   Merge one SACK block received from the peer into the scoreboard.  The
+ *   scoreboard is kept sorted and its blocks never overlap or touch.  If it
+ *   is full, the highest block is dropped:  That data is resent by the
+ *   retransmission timer if it has to be.
+ *
+ ****************************************************************************/
+
+static void tcp_sack_add(FAR struct tcp_conn_s *conn, uint32_t ackno,
+                         uint32_t left, uint32_t right)
+{
+  FAR struct tcp_sack_s *blk;
+  unsigned int i;
+
+  /* Ignore the blocks that are empty, already covered by the cumulative
+   * ACK or that report data that was never sent (RFC 2018, section 5).
+   */
+
+  if (!TCP_SEQ_GT(right, left) || !TCP_SEQ_GT(right, ackno) ||
+      TCP_SEQ_GT(right, conn->sndseq_max))
+    {
+      return;
+    }
+
+  if (TCP_SEQ_LT(left, ackno))
+    {
+      left = ackno;
+    }
+
+  /* Absorb all of the blocks that overlap or touch the new one */
+
+  for (i = 0; i < conn->nsacks; )
+    {
+      blk = &conn->sack[i];
+      if (TCP_SEQ_LT(right, blk->left) || TCP_SEQ_GT(left, blk->right))
+        {
+          i++;
+          continue;
+        }
+
+      if (TCP_SEQ_LT(blk->left, left))
+        {
+          left = blk->left;
+        }
+
+      if (TCP_SEQ_GT(blk->right, right))
+        {
+          right = blk->right;
+        }
+
+      tcp_sack_remove(conn, i, 1);
+    }
+
+  /* Insert the merged block at its place */
+
+  for (i = 0; i < conn->nsacks; i++)
+    {
+      if (TCP_SEQ_LT(left, conn->sack[i].left))
+        {
+          break;
+        }
+    }
+
+  if (conn->nsacks >= TCP_SACK_NBLOCKS)
+    {
+      if (i >= TCP_SACK_NBLOCKS)
+        {
+          return;
+        }
+
+      conn->nsacks--;
+    }
+
+  memmove(&conn->sack[i + 1], &conn->sack[i],
+          (conn->nsacks - i) * sizeof(struct tcp_sack_s));
+
+  conn->sack[i].left  = left;
+  conn->sack[i].right = right;
+  conn->nsacks++;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_sack_update
+ *
+ * Description:
+ *   Update the SACK scoreboard of the connection from the SACK option of
+ *   the received segment 'tcp' and discard the blocks that are now covered
+ *   by the cumulative acknowledgment 'ackno'.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   tcp   - The TCP header of the received segment
+ *   ackno - The acknowledgment number of the received segment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the network driver with the network locked.
+ *
+ ****************************************************************************/
+
+void tcp_sack_update(FAR struct tcp_conn_s *conn,
+                     FAR struct tcp_hdr_s *tcp, uint32_t ackno)
+{
+  FAR uint8_t *opt = tcp->optdata;
+  unsigned int optlen;
+  unsigned int i;
+  unsigned int j;
+
+  tcp_sack_trim(conn, ackno);
+
+  if ((tcp->tcpoffset & 0xf0) <= 0x50)
+    {
+      return;
+    }
+
+  optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  for (i = 0; i < optlen; )
+    {
+      if (opt[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+
+      /* All other options have a length field.  Stop at the first one
+       * that is malformed.
+       */
+
+      if (i + 1 >= optlen || opt[i + 1] < 2 || i + opt[i + 1] > optlen)
+        {
+          break;
+        }
+
+      if (opt[i] == TCP_OPT_SACK)
+        {
+          for (j = i + 2; j + 8 <= i + opt[i + 1]; j += 8)
+            {
+              tcp_sack_add(conn, ackno, tcp_getsequence(&opt[j]),
+                           tcp_getsequence(&opt[j + 4]));
+            }
+        }
+
+      i += opt[i + 1];
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_sack_nexthole
+ *
+ * Description:
+ *   Find the first range of unacknowledged data, not reported by the peer
+ *   and not yet retransmitted in this recovery, that lies below the highest
+ *   SACK block.
+ *
+ *   The search starts at conn->sack_rexmit, which the caller keeps at or
+ *   above the last cumulative acknowledgment.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection of interest
+ *   seq   - The location to return the start of the hole
+ *   len   - The location to return the length of the hole
+ *
+ * Returned Value:
+ *   true if a hole was found.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_nexthole(FAR struct tcp_conn_s *conn,
+                       FAR uint32_t *seq, FAR uint32_t *len)
+{
+  FAR struct tcp_sack_s *blk;
+  uint32_t start = conn->sack_rexmit;
+  unsigned int i;
+
+  for (i = 0; i < conn->nsacks; i++)
+    {
+      blk = &conn->sack[i];
+      if (TCP_SEQ_LT(start, blk->left))
+        {
+          *seq = start;
+          *len = TCP_SEQ_SUB(blk->left, start);
+          return true;
+        }
+
+      if (TCP_SEQ_LT(start, blk->right))
+        {
+          start = blk->right;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_covered
+ *
+ * Description:
+ *   Return true if the 'len' bytes starting at 'seq' have all been
+ *   reported as received by the peer.
+ *
+ ****************************************************************************/
+
+bool tcp_sack_covered(FAR struct tcp_conn_s *conn, uint32_t seq,
+                      uint32_t len)
+{
+  uint32_t end = TCP_SEQ_ADD(seq, len);
+  unsigned int i;
+
+  for (i = 0; i < conn->nsacks; i++)
+    {
+      if (TCP_SEQ_LTE(conn->sack[i].left, seq) &&
+          TCP_SEQ_GTE(conn->sack[i].right, end))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_sack_reset
+ *
+ * Description:
+ *   Forget the SACK scoreboard and leave the SACK recovery.
+ *
+ ****************************************************************************/
+
+void tcp_sack_reset(FAR struct tcp_conn_s *conn)
+{
+  conn->nsacks        = 0;
+  conn->sack_recovery = false;
+}
+
+#endif /* CONFIG_NET_TCP_SACK */
@@ -290,6 +290,91 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: psock_sack_rexmit
+ *
+ * Description:
+ *   During a SACK recovery, retransmit up to one MSS of the first hole in
+ *   the data reported as received by the peer.
+ *
+ * Input Parameters:
+ *   dev  - The structure of the network driver that caused the event
+ *   conn - The TCP connection of interest
+ *
+ * Returned Value:
+ *   true if a segment was set up to be retransmitted.
+ *
+ * Assumptions:
+ *   The network is locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+static bool psock_sack_rexmit(FAR struct net_driver_s *dev,
+                              FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+  FAR sq_entry_t *entry;
+  uint32_t offset;
+  uint32_t seq;
+  uint32_t len;
+
+  if (dev->d_sndlen > 0 || !tcp_sack_nexthole(conn, &seq, &len))
+    {
+      return false;
+    }
+
+  /* Find the write buffer that holds the start of the hole */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (TCP_SEQ_GTE(seq, TCP_WBSEQNO(wrb)) &&
+          TCP_SEQ_LT(seq, TCP_WBSEQNO(wrb) + TCP_WBPKTLEN(wrb)))
+        {
+          break;
+        }
+    }
+
+  if (entry == NULL)
+    {
+      return false;
+    }
+
+  /* Retransmit no more than one segment and stay within the buffer */
+
+  offset = TCP_SEQ_SUB(seq, TCP_WBSEQNO(wrb));
+  if (len > TCP_WBPKTLEN(wrb) - offset)
+    {
+      len = TCP_WBPKTLEN(wrb) - offset;
+    }
+
+  if (len > conn->mss)
+    {
+      len = conn->mss;
+    }
+
+  ninfo("SACK: wrb=%p rexmit seq=%" PRIu32 " len=%" PRIu32 "\n",
+        wrb, seq, len);
+
+  tcp_setsequence(conn->sndseq, seq);
+
+#ifdef NEED_IPDOMAIN_SUPPORT
+  send_ipselect(dev, conn);
+#endif
+  devif_iob_send(dev, TCP_WBIOB(wrb), len, offset);
+#ifdef CONFIG_NET_TCP_INFO
+  tcp_info_sent(conn, seq, len, true);
+#endif
+
+  /* Do not resend this range again during this recovery */
+
+  conn->sack_rexmit = TCP_SEQ_ADD(seq, len);
+  tcp_update_retrantimer(conn, conn->rto);
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -317,6 +402,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
   uint32_t rexmitno = 0;
 #endif
+#ifdef CONFIG_NET_TCP_SACK
+  bool sackrexmit = false;
+#endif
 
   /* Get the TCP connection pointer reliably from
    * the corresponding TCP socket.
@@ -356,6 +444,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_CC
+      uint32_t acked = 0;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -419,6 +510,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                 {
                   ninfo("ACK: wrb=%p Freeing write buffer\n", wrb);
 
+#ifdef CONFIG_NET_TCP_CC
+                  acked += TCP_WBPKTLEN(wrb);
+#endif
+
                   /* Yes... Remove the write buffer from ACK waiting queue */
 
                   sq_rem(entry, &conn->unacked_q);
@@ -455,6 +550,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
                   ninfo("ACK: wrb=%p trim %u bytes\n", wrb, trimlen);
 
+#ifdef CONFIG_NET_TCP_CC
+                  acked += trimlen;
+#endif
+
                   TCP_WBTRIM(wrb, trimlen);
                   TCP_WBSEQNO(wrb) += trimlen;
                   TCP_WBSENT(wrb) -= trimlen;
@@ -515,6 +614,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
                 " nacked=%" PRIu32 " sent=%u ackno=%" PRIu32 "\n",
                 wrb, TCP_WBSEQNO(wrb), nacked, TCP_WBSENT(wrb), ackno);
 
+#ifdef CONFIG_NET_TCP_CC
+          acked += nacked;
+#endif
+
           /* Trim the ACKed bytes from the beginning of the write buffer. */
 
           TCP_WBTRIM(wrb, nacked);
@@ -524,6 +627,62 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%" PRIu32 " pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_CC
+      /* Reduce the congestion window when the duplicate ACKs signal a
+       * loss, otherwise grow it.  A partial ACK during the fast recovery
+       * retransmits the next lost segment (NewReno).
+       */
+
+      if (rexmitno != 0)
+        {
+          tcp_cc_loss(conn, false);
+        }
+      else if (acked > 0 && tcp_cc_ack(conn, ackno, acked))
+        {
+          rexmitno = ackno;
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+      if ((conn->flags & TCP_SACK) != 0)
+        {
+          tcp_sack_update(conn, tcp, ackno);
+
+          /* The recovery ends when all of the data that was outstanding
+           * when it started has been ACKed (RFC 6675).
+           */
+
+          if (conn->sack_recovery && TCP_SEQ_GTE(ackno, conn->sack_recover))
+            {
+              conn->sack_recovery = false;
+            }
+
+          /* The duplicate ACK threshold starts a new recovery */
+
+          if (rexmitno != 0 && !conn->sack_recovery)
+            {
+              conn->sack_recovery = true;
+              conn->sack_recover  = conn->sndseq_max;
+              conn->sack_rexmit   = ackno;
+            }
+
+          if (TCP_SEQ_LT(conn->sack_rexmit, ackno))
+            {
+              conn->sack_rexmit = ackno;
+            }
+
+          /* Each ACK received during the recovery retransmits one hole.
+           * Without any SACK block, fall back to the fast retransmit.
+           */
+
+          if (conn->sack_recovery && conn->nsacks > 0)
+            {
+              sackrexmit = true;
+              rexmitno   = 0;
+            }
+        }
+#endif
     }
 
   /* Check for a loss of connection */
@@ -603,6 +762,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            */
 
           devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, 0);
+#ifdef CONFIG_NET_TCP_INFO
+          tcp_info_sent(conn, TCP_WBSEQNO(wrb), sndlen, true);
+#endif
 
           /* Reset the retransmission timer. */
 
@@ -615,6 +777,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+  if (sackrexmit && psock_sack_rexmit(dev, conn))
+    {
+      /* Continue waiting */
+
+      return flags;
+    }
+#endif
+
   /* Check if we are being asked to retransmit data */
 
   if ((flags & TCP_REXMIT) != 0)
@@ -624,6 +795,21 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Restart from a window of one segment */
+
+      tcp_cc_loss(conn, true);
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+      /* The peer may discard the data that it has reported with SACK
+       * (RFC 2018, section 8):  After a time-out, all of the unacknowledged
+       * data is sent again and the scoreboard is rebuilt from scratch.
+       */
+
+      tcp_sack_reset(conn);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -814,6 +1000,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       uint32_t predicted_seqno;
       uint32_t seq;
       uint32_t snd_wnd_edge;
+#ifdef CONFIG_NET_TCP_CC
+      uint32_t cwnd;
+#endif
       size_t sndlen;
 
       /* Peek at the head of the write queue (but don't remove anything
@@ -842,14 +1031,39 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       seq = TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb);
       snd_wnd_edge = conn->snd_wl2 + conn->snd_wnd;
+
+#ifdef CONFIG_NET_TCP_CC
+      /* The data in flight must not exceed the congestion window either */
+
+      cwnd = tcp_cc_window(conn);
+      if (cwnd <= conn->tx_unacked)
+        {
+          snd_wnd_edge = seq;
+        }
+      else if (TCP_SEQ_LT(seq + (cwnd - conn->tx_unacked), snd_wnd_edge))
+        {
+          snd_wnd_edge = seq + (cwnd - conn->tx_unacked);
+        }
+#endif
+
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
+          uint32_t maxlen = conn->mss;
+
+#ifdef CONFIG_NETDEV_TSO
+          /* The hardware splits larger packets into segments of one MSS */
+
+          if (dev->d_tsomax > maxlen)
+            {
+              maxlen = dev->d_tsomax;
+            }
+#endif
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -889,6 +1103,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
            */
 
           devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
+#ifdef CONFIG_NETDEV_TSO
+          dev->d_tsomss = conn->mss;
+#endif
+#ifdef CONFIG_NET_TCP_INFO
+          /* The buffers sent again after a time-out count retransmissions */
+
+          tcp_info_sent(conn, tcp_getsequence(conn->sndseq), sndlen,
+                        TCP_WBNRTX(wrb) > 0);
+#endif
 
           /* Remember how much data we send out now so that we know
            * when everything has been acknowledged.  Just increment
@@ -42,6 +42,7 @@
 #include <arch/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -78,6 +79,7 @@ struct sendfile_s
   FAR struct socket *snd_sock;             /* Points to the parent socket structure */
   FAR struct devif_callback_s *snd_cb;     /* Reference to callback instance */
   FAR struct file   *snd_file;             /* File structure of the input file */
+  FAR const uint8_t *snd_data;             /* Input file data in memory or NULL */
   sem_t              snd_sem;              /* Used to wake up the waiting thread */
   off_t              snd_foffset;          /* Input file offset */
   size_t             snd_flen;             /* File length */
@@ -101,6 +103,49 @@ struct sendfile_s
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_read
+ *
+ * Description:
+ *   Copy 'len' bytes at 'offset' from the start of the transfer into the
+ *   packet buffer.  The data is copied straight from memory if the input
+ *   file is directly accessible, otherwise it is read from the file.
+ *
+ * Returned Value:
+ *   Zero (OK) on success or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int sendfile_read(FAR struct sendfile_s *pstate,
+                         FAR struct net_driver_s *dev, uint32_t offset,
+                         uint32_t len)
+{
+  ssize_t ret;
+
+  if (pstate->snd_data != NULL)
+    {
+      memcpy(dev->d_appdata, pstate->snd_data + offset, len);
+      return OK;
+    }
+
+  ret = file_seek(pstate->snd_file, pstate->snd_foffset + offset,
+                  SEEK_SET);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to lseek: %d\n", (int)ret);
+      return (int)ret;
+    }
+
+  ret = file_read(pstate->snd_file, dev->d_appdata, len);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
+      return (int)ret;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -280,19 +325,9 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
        * happen until the polling cycle completes).
        */
 
-      ret = file_seek(pstate->snd_file,
-                      pstate->snd_foffset + pstate->snd_acked, SEEK_SET);
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to lseek: %d\n", ret);
-          pstate->snd_sent = ret;
-          goto end_wait;
-        }
-
-      ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+      ret = sendfile_read(pstate, dev, pstate->snd_acked, sndlen);
       if (ret < 0)
         {
-          nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
           pstate->snd_sent = ret;
           goto end_wait;
         }
@@ -358,19 +393,9 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
+          ret = sendfile_read(pstate, dev, pstate->snd_sent, sndlen);
           if (ret < 0)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
-
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-          if (ret < 0)
-            {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
               pstate->snd_sent = ret;
               goto end_wait;
             }
@@ -443,6 +468,7 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+  struct stat buf;
   off_t startpos;
   int ret;
 
@@ -521,6 +547,36 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   state.snd_flen    = count;                       /* Number of bytes to send */
   state.snd_file    = infile;                      /* File to read from */
 
+  /* If the content of the file is directly accessible in memory, the
+   * packets are filled from there without seeking and reading the file.
+   */
+
+  if (file_ioctl(infile, FIOC_MMAP,
+                 (unsigned long)((uintptr_t)&state.snd_data)) >= 0 &&
+      file_fstat(infile, &buf) >= 0)
+    {
+      if (state.snd_foffset >= buf.st_size)
+        {
+          state.snd_flen = 0;
+        }
+      else if (state.snd_flen > buf.st_size - state.snd_foffset)
+        {
+          state.snd_flen = buf.st_size - state.snd_foffset;
+        }
+
+      state.snd_data += state.snd_foffset;
+    }
+  else
+    {
+      state.snd_data = NULL;
+    }
+
+  if (state.snd_flen == 0)
+    {
+      ret = OK;
+      goto errout_locked;
+    }
+
   /* Allocate resources to receive a callback */
 
   state.snd_cb = tcp_callback_alloc(conn);
@@ -579,6 +635,18 @@ errout_locked:
 #endif
   net_unlock();
 
+  /* The file position was not moved if the data was taken from memory */
+
+  if (state.snd_data != NULL && state.snd_sent > 0)
+    {
+      off_t newpos = file_seek(infile, state.snd_foffset + state.snd_sent,
+                               SEEK_SET);
+      if (newpos < 0)
+        {
+          return newpos;
+        }
+    }
+
   /* Return the current file position */
 
   if (offset)
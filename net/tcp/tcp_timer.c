@@ -70,9 +70,9 @@
 /* Per RFC 1122:  "... an ACK should not be excessively delayed; in
  * particular, the delay MUST be less than 0.5 seconds ..."
  *
- * NOTE:  We only have 0.5 timing resolution here so the delay will be
- * between 0.5 and 1.0 seconds, and may be delayed further, depending on the
- * polling rate of the the driver (often 1 second).
+ * NOTE:  We only have 0.5 timing resolution here.  The delay is timed by
+ * the per-connection timer, so it does not depend on the polling rate of
+ * the driver.
  */
 
 #define ACK_DELAY (1)
@@ -114,6 +114,23 @@ static int tcp_get_timeout(FAR struct tcp_conn_s *conn)
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+  /* A pending delayed ACK is only serviced when there is no outstanding
+   * data (see tcp_timer()).
+   */
+
+  if (conn->rx_unackseg > 0 && conn->tx_unacked == 0)
+    {
+      int ackdelay = conn->rx_acktimer < ACK_DELAY ?
+                     ACK_DELAY - conn->rx_acktimer : 1;
+
+      if (timeout == 0 || timeout > ackdelay)
+        {
+          timeout = ackdelay;
+        }
+    }
+#endif
+
   return timeout;
 }
 
@@ -138,18 +155,21 @@ static int tcp_get_timeout(FAR struct tcp_conn_s *conn)
 
 static void tcp_timer_expiry(FAR void *arg)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn = arg;
 
   net_lock();
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+  /* The connection structures are never returned to the heap, and
+   * tcp_free() cancels the timer and marks the connection TCP_CLOSED
+   * before putting it in the free list.  So only the state needs to be
+   * checked, not the list of all active connections.
+   */
+
+  if (conn->tcpstateflags != TCP_CLOSED &&
+      conn->tcpstateflags != TCP_ALLOCATED && conn->dev != NULL)
     {
-      if (conn == arg)
-        {
-          conn->timeout = true;
-          netdev_txnotify_dev(conn->dev);
-          break;
-        }
+      conn->timeout = true;
+      netdev_txnotify_dev(conn->dev);
     }
 
   net_unlock();
@@ -250,6 +270,32 @@ void tcp_update_keeptimer(FAR struct tcp_conn_s *conn, int timeout)
 }
 #endif
 
+/****************************************************************************
+ * Name: tcp_update_acktimer
+ *
+ * Description:
+ *   Start the delayed ACK TCP timer for the provided TCP connection, after
+ *   an ACK has been deferred
+ *
+ * Input Parameters:
+ *   conn - The TCP "connection" with a delayed ACK
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   conn is not NULL.
+ *   The connection (conn) is bound to the polling device (dev).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+void tcp_update_acktimer(FAR struct tcp_conn_s *conn)
+{
+  tcp_update_timer(conn);
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_stop_timer
  *
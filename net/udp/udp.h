@@ -129,6 +129,16 @@ struct udp_conn_s
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
 
+#ifdef CONFIG_NET_UDP_STATS
+  /* Statistics shown in /proc/net/udp */
+
+  uint32_t rx_packets;    /* Datagrams received */
+  uint32_t tx_packets;    /* Datagrams sent */
+  uint32_t drops;         /* Datagrams dropped, no buffer */
+  uint64_t rx_bytes;      /* Bytes received */
+  uint64_t tx_bytes;      /* Bytes sent */
+#endif
+
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Write buffering
    *
@@ -144,6 +154,12 @@ struct udp_conn_s
   FAR struct devif_callback_s *sndcb;
 #endif
 
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+  /* Chain of the local port hash table (see udp_conn.c) */
+
+  FAR struct udp_conn_s *hnext;   /* Next with the same local port hash */
+#endif
+
   /* The following is a list of poll structures of threads waiting for
    * socket events.
    */
@@ -257,6 +273,17 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
 uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u);
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.  Zero
+ *   releases the port.
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno);
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -704,6 +731,22 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
 ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive without copying:  Take the next datagram from the read-ahead
+ *   queue of the connection (see psock_recviob()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_RECVIOB
+ssize_t psock_udp_recviob(FAR struct socket *psock,
+                          FAR struct iob_s **iob, int flags,
+                          FAR struct sockaddr *from,
+                          FAR socklen_t *fromlen);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_sendto
  *
@@ -89,6 +89,9 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     {
       iob = iob_remove_queue(&conn->readahead);
       iob_free_chain(iob);
+#ifdef CONFIG_NET_UDP_STATS
+      conn->drops++;
+#endif
     }
 #endif
 
@@ -295,6 +298,9 @@ net_dataevent(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
 #ifdef CONFIG_NET_STATISTICS
       g_netstats.udp.drop++;
+#endif
+#ifdef CONFIG_NET_UDP_STATS
+      conn->drops++;
 #endif
     }
 
@@ -331,6 +337,14 @@ uint16_t udp_callback(FAR struct net_driver_s *dev,
 
   if (conn)
     {
+#ifdef CONFIG_NET_UDP_STATS
+      if ((flags & UDP_NEWDATA) != 0)
+        {
+          conn->rx_packets++;
+          conn->rx_bytes += dev->d_len;
+        }
+#endif
+
       /* Perform the callback */
 
       flags = devif_conn_event(dev, flags, conn->sconn.list);
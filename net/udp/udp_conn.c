@@ -66,6 +66,7 @@
 #include "devif/devif.h"
 #include "netdev/netdev.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -75,6 +76,16 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* The connections that may use a local port:  Either the chain of one hash
+ * bucket or the whole active list.
+ */
+
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+#  define udp_nextport(c) ((c)->hnext)
+#else
+#  define udp_nextport(c) ((FAR struct udp_conn_s *)(c)->sconn.node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,6 +105,15 @@ static sem_t g_free_sem = SEM_INITIALIZER(1);
 
 static dq_queue_t g_active_udp_connections;
 
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+/* The active connections with a local port, hashed by the local port.  The
+ * local address is not part of the hash because a connection bound to
+ * INADDR_ANY receives the datagrams sent to any address.
+ */
+
+static FAR struct udp_conn_s *g_udp_porthash[CONFIG_NET_UDP_HASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -113,11 +133,50 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+/****************************************************************************
+ * Name: udp_porthash
+ *
+ * Description:
+ *   Return the bucket of the local port hash table for 'lport'.
+ *
+ ****************************************************************************/
+
+static inline unsigned int udp_porthash(uint16_t lport)
+{
+  return (lport ^ (lport >> 8)) % CONFIG_NET_UDP_HASH_SIZE;
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_firstport
+ *
+ * Description:
+ *   Return the first connection that may use the local port 'lport'.  The
+ *   following ones are found with udp_nextport().
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR struct udp_conn_s *udp_firstport(uint16_t lport)
+{
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+  return g_udp_porthash[udp_porthash(lport)];
+#else
+  UNUSED(lport);
+  return (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
  * Description:
- *   Find the UDP connection that uses this local port number.
+ *   Find the UDP connection that uses this local port number.  If
+ *   'bindconn' is the connection that binds the port and SO_REUSEPORT is
+ *   set on it, the connections that set SO_REUSEPORT as well are ignored.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -126,14 +185,24 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             FAR union ip_binding_u *ipaddr,
-                                            uint16_t portno)
+                                            uint16_t portno,
+                                            FAR struct udp_conn_s *bindconn)
 {
-  FAR struct udp_conn_s *conn = NULL;
+  FAR struct udp_conn_s *conn;
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure that may use the port. */
 
-  while ((conn = udp_nextconn(conn)) != NULL)
+  for (conn = udp_firstport(portno); conn != NULL;
+       conn = udp_nextport(conn))
     {
+      /* Sockets that all set SO_REUSEPORT may share the port */
+
+      if (bindconn != NULL && _SO_ISREUSEPORT(bindconn) &&
+          _SO_ISREUSEPORT(conn))
+        {
+          continue;
+        }
+
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
        * reference to the connection structure.  INADDR_ANY is a special
@@ -172,6 +241,106 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   return NULL;
 }
 
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   Select the connection that receives a datagram among the unconnected
+ *   connections that share the local address and port of 'conn' with
+ *   SO_REUSEPORT.  The source address and port of the datagram are hashed,
+ *   so that each peer is served by the same socket and the peers are
+ *   spread evenly over the sockets.
+ *
+ * Input Parameters:
+ *   conn    - The first matching connection
+ *   srcport - The source port of the datagram
+ *   srcaddr - The source address of the datagram
+ *   nwords  - The number of 16-bit words of 'srcaddr'
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *
+udp_reuseport_select(FAR struct udp_conn_s *conn, uint16_t srcport,
+                     FAR const uint16_t *srcaddr, int nwords)
+{
+  FAR struct udp_conn_s *other;
+  uint32_t hash = srcport;
+  int count = 0;
+  int pass;
+  int i;
+
+  for (i = 0; i < nwords; i++)
+    {
+      hash = (hash ^ srcaddr[i]) * 16777619u;
+    }
+
+  hash ^= hash >> 16;
+
+  /* Count the sockets of the group on the first pass, pick one on the
+   * second.
+   */
+
+  for (pass = 0; pass < 2; pass++)
+    {
+      for (other = udp_firstport(conn->lport); other != NULL;
+           other = udp_nextport(other))
+        {
+          if (other->lport != conn->lport || other->domain != conn->domain ||
+              !_SO_ISREUSEPORT(other) || _UDP_ISCONNECTMODE(other->flags))
+            {
+              continue;
+            }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+          if (conn->domain == PF_INET)
+#endif
+            {
+              if (!net_ipv4addr_cmp(other->u.ipv4.laddr,
+                                    conn->u.ipv4.laddr))
+                {
+                  continue;
+                }
+            }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+          else
+#endif
+            {
+              if (!net_ipv6addr_cmp(other->u.ipv6.laddr,
+                                    conn->u.ipv6.laddr))
+                {
+                  continue;
+                }
+            }
+#endif
+
+          if (pass == 0)
+            {
+              count++;
+            }
+          else if (count-- == 0)
+            {
+              return other;
+            }
+        }
+
+      if (count <= 1)
+        {
+          break;
+        }
+
+      count = hash % count;
+    }
+
+  return conn;
+}
+
 /****************************************************************************
  * Name: udp_ipv4_active
  *
@@ -194,8 +363,8 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
-  while (conn)
+  conn = udp_firstport(udp->destport);
+  while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
        * to be used. If so, then the following checks are performed:
@@ -305,9 +474,18 @@ static inline FAR struct udp_conn_s *
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection that may use the port */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+      conn = udp_nextport(conn);
+    }
+
+  /* Distribute the datagrams among the sockets sharing the port */
+
+  if (conn != NULL && _SO_ISREUSEPORT(conn) &&
+      !_UDP_ISCONNECTMODE(conn->flags))
+    {
+      conn = udp_reuseport_select(conn, udp->srcport, ip->srcipaddr,
+                                  sizeof(in_addr_t) / sizeof(uint16_t));
     }
 
   return conn;
@@ -333,7 +511,7 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
-  conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+  conn = udp_firstport(udp->destport);
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -444,9 +622,18 @@ static inline FAR struct udp_conn_s *
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next connection that may use the port */
+
+      conn = udp_nextport(conn);
+    }
+
+  /* Distribute the datagrams among the sockets sharing the port */
 
-      conn = (FAR struct udp_conn_s *)conn->sconn.node.flink;
+  if (conn != NULL && _SO_ISREUSEPORT(conn) &&
+      !_UDP_ISCONNECTMODE(conn->flags))
+    {
+      conn = udp_reuseport_select(conn, udp->srcport, ip->srcipaddr,
+                                  sizeof(net_ipv6addr_t) / sizeof(uint16_t));
     }
 
   return conn;
@@ -555,7 +742,7 @@ uint16_t udp_select_port(uint8_t domain, FAR union ip_binding_u *u)
           g_last_udp_port = 4096;
         }
     }
-  while (udp_find_conn(domain, u, HTONS(g_last_udp_port)) != NULL);
+  while (udp_find_conn(domain, u, HTONS(g_last_udp_port), NULL) != NULL);
 
   /* Initialize and return the connection structure, bind it to the
    * port number
@@ -666,7 +853,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -760,6 +947,52 @@ FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: udp_setport
+ *
+ * Description:
+ *   Set the local port number (network byte order) of a connection.  Zero
+ *   releases the port.  All changes of the local port of an allocated
+ *   connection must go through this function so that the connection is
+ *   found by the port look-ups.
+ *
+ ****************************************************************************/
+
+void udp_setport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#if CONFIG_NET_UDP_HASH_SIZE > 0
+  FAR struct udp_conn_s **link;
+
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      for (link = &g_udp_porthash[udp_porthash(conn->lport)];
+           *link != NULL; link = &(*link)->hnext)
+        {
+          if (*link == conn)
+            {
+              *link = conn->hnext;
+              break;
+            }
+        }
+    }
+
+  conn->lport = portno;
+
+  if (portno != 0)
+    {
+      link        = &g_udp_porthash[udp_porthash(portno)];
+      conn->hnext = *link;
+      *link       = conn;
+    }
+
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_bind
  *
@@ -826,8 +1059,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -839,16 +1072,16 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * and port ?
        */
 
-      if (udp_find_conn(conn->domain, &conn->u, portno) == NULL)
+      if (udp_find_conn(conn->domain, &conn->u, portno, conn) == NULL)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
-          ret         = OK;
+          udp_setport(conn, portno);
+          ret = OK;
         }
       else
         {
-          ret         = -EADDRINUSE;
+          ret = -EADDRINUSE;
         }
 
       net_unlock();
@@ -896,7 +1129,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = HTONS(udp_select_port(conn->domain, &conn->u));
+      udp_setport(conn, HTONS(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
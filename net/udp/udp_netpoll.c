@@ -30,6 +30,7 @@
 #include <debug.h>
 
 #include <nuttx/net/net.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 
 #include "devif/devif.h"
@@ -102,7 +103,7 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -231,7 +232,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 errout_with_lock:
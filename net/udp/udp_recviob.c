@@ -0,0 +1,266 @@
+/****************************************************************************
+ * net/udp/udp_recviob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/udp.h>
+
+#include "devif/devif.h"
+#include "udp/udp.h"
+#include "socket/socket.h"
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_RECVIOB)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct udp_recviob_s
+{
+  FAR struct devif_callback_s *ir_cb;     /* Reference to callback instance */
+  sem_t                        ir_sem;    /* Signals new data or loss */
+  int                          ir_result; /* OK or a negated errno value */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: udp_recviob_eventhandler
+ *
+ * Description:
+ *   Wake up the waiting thread on a new datagram or when the device goes
+ *   down.  UDP_NEWDATA is left set, so that udp_callback() queues the
+ *   datagram in the read-ahead buffers, where the thread takes it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static uint16_t udp_recviob_eventhandler(FAR struct net_driver_s *dev,
+                                         FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct udp_recviob_s *pstate = pvpriv;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  if ((flags & NETDEV_DOWN) != 0)
+    {
+      pstate->ir_result = -ENETUNREACH;
+    }
+  else if ((flags & UDP_NEWDATA) == 0)
+    {
+      return flags;
+    }
+
+  /* Don't allow any further callbacks and wake up the thread */
+
+  pstate->ir_cb->flags = 0;
+  pstate->ir_cb->priv  = NULL;
+  pstate->ir_cb->event = NULL;
+
+  nxsem_post(&pstate->ir_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: udp_recviob_wait
+ *
+ * Description:
+ *   Wait for a new datagram.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int udp_recviob_wait(FAR struct udp_conn_s *conn)
+{
+  FAR struct net_driver_s *dev;
+  struct udp_recviob_s state;
+  int ret;
+
+  /* The device may be NULL if the socket is bound to INADDR_ANY.  No
+   * NETDEV_DOWN notifications will be received in that case.
+   */
+
+  dev = udp_find_laddr_device(conn);
+
+  state.ir_result = OK;
+  nxsem_init(&state.ir_sem, 0, 0);
+  nxsem_set_protocol(&state.ir_sem, SEM_PRIO_NONE);
+
+  state.ir_cb = udp_callback_alloc(dev, conn);
+  if (state.ir_cb == NULL)
+    {
+      nxsem_destroy(&state.ir_sem);
+      return -EBUSY;
+    }
+
+  state.ir_cb->flags = (UDP_NEWDATA | NETDEV_DOWN);
+  state.ir_cb->priv  = (FAR void *)&state;
+  state.ir_cb->event = udp_recviob_eventhandler;
+
+  ret = net_timedwait(&state.ir_sem, _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+  if (ret == -ETIMEDOUT)
+    {
+      ret = -EAGAIN;
+    }
+  else if (ret >= 0)
+    {
+      ret = state.ir_result;
+    }
+
+  udp_callback_free(dev, conn, state.ir_cb);
+  nxsem_destroy(&state.ir_sem);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive without copying:  Take the next datagram from the read-ahead
+ *   queue of the connection, waiting for one first if there is none and
+ *   the socket may block.
+ *
+ * Input Parameters:
+ *   psock   - The UDP socket
+ *   iob     - The location to return the I/O buffer chain
+ *   flags   - Receive flags (MSG_DONTWAIT)
+ *   from    - The location to return the address of the sender (may be
+ *             NULL)
+ *   fromlen - The size of 'from' on input, the size of the address on
+ *             output
+ *
+ * Returned Value:
+ *   The number of bytes in the chain returned in 'iob', which the caller
+ *   must release with iob_free_chain().  Zero for an empty datagram, with
+ *   no chain.  A negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_recviob(FAR struct socket *psock,
+                          FAR struct iob_s **iob, int flags,
+                          FAR struct sockaddr *from,
+                          FAR socklen_t *fromlen)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  FAR struct iob_s *dgram;
+  uint8_t src_addr_size;
+  unsigned int offset;
+  ssize_t ret;
+
+  net_lock();
+
+  while ((dgram = iob_remove_queue(&conn->readahead)) == NULL)
+    {
+      if (_SS_ISNONBLOCK(conn->sconn.s_flags) ||
+          (flags & MSG_DONTWAIT) != 0)
+        {
+          net_unlock();
+          return -EAGAIN;
+        }
+
+      ret = udp_recviob_wait(conn);
+      if (ret < 0)
+        {
+          net_unlock();
+          return ret;
+        }
+    }
+
+  net_unlock();
+
+  /* Strip the meta-data that udp_datahandler() stored ahead of the
+   * payload:  The size of the address, the address and the interface
+   * index.
+   */
+
+  if (iob_copyout(&src_addr_size, dgram, sizeof(uint8_t), 0) !=
+      sizeof(uint8_t))
+    {
+      iob_free_chain(dgram);
+      return -EIO;
+    }
+
+  offset = sizeof(uint8_t);
+  if (from != NULL)
+    {
+      if (*fromlen > src_addr_size)
+        {
+          *fromlen = src_addr_size;
+        }
+
+      iob_copyout((FAR uint8_t *)from, dgram, *fromlen, offset);
+    }
+
+  offset += src_addr_size;
+#ifdef CONFIG_NETDEV_IFINDEX
+  offset += sizeof(uint8_t);
+#endif
+
+  if (dgram->io_pktlen < offset)
+    {
+      iob_free_chain(dgram);
+      return -EIO;
+    }
+
+  ret = dgram->io_pktlen - offset;
+  if (ret == 0)
+    {
+      /* An empty datagram */
+
+      iob_free_chain(dgram);
+      *iob = NULL;
+      return 0;
+    }
+
+  *iob = iob_trimhead(dgram, offset);
+  return ret;
+}
+
+#endif /* NET_UDP_HAVE_STACK && CONFIG_NET_RECVIOB */
@@ -93,6 +93,8 @@ struct usrsock_conn_s
   {
     sem_t    sem;               /* Request semaphore (only one outstanding request) */
     uint32_t xid;               /* Expected message exchange id */
+    uint32_t ackxid;            /* Exchange id for which waiting ack */
+    sem_t    acksem;            /* Request acknowledgment notification */
     bool     inprogress;        /* Request was received but daemon is still processing */
     uint16_t valuelen;          /* Length of value from daemon */
     uint16_t valuelen_nontrunc; /* Actual length of value at daemon */
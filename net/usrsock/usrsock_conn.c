@@ -126,6 +126,8 @@ FAR struct usrsock_conn_s *usrsock_alloc(void)
       /* Make sure that the connection is marked as uninitialized */
 
       nxsem_init(&conn->resp.sem, 0, 1);
+      nxsem_init(&conn->resp.acksem, 0, 0);
+      nxsem_set_protocol(&conn->resp.acksem, SEM_PRIO_NONE);
       conn->usockid = -1;
       conn->state = USRSOCK_CONN_STATE_UNINITIALIZED;
 
@@ -162,6 +164,7 @@ void usrsock_free(FAR struct usrsock_conn_s *conn)
   /* Reset structure */
 
   nxsem_destroy(&conn->resp.sem);
+  nxsem_destroy(&conn->resp.acksem);
   memset(conn, 0, sizeof(*conn));
 
   /* Free the connection */
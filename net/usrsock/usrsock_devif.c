@@ -46,15 +46,14 @@
  * Private Types
  ****************************************************************************/
 
+/* Several requests, from different connections, may be outstanding at
+ * the same time.  Each connection waits for the acknowledgment of its own
+ * request, identified by its exchange id.
+ */
+
 struct usrsock_req_s
 {
-  sem_t    sem;               /* Request semaphore (only one outstanding
-                               * request) */
-  sem_t    acksem;            /* Request acknowledgment notification */
   uint32_t newxid;            /* New transcation Id */
-  uint32_t ackxid;            /* Exchange id for which waiting ack */
-  uint16_t nbusy;             /* Number of requests blocked from different
-                               * threads */
 
   /* Connection instance to receive data buffers. */
 
@@ -72,10 +71,6 @@ struct usrsock_req_s
 
 static struct usrsock_req_s g_usrsock_req =
 {
-  NXSEM_INITIALIZER(1, PRIOINHERIT_FLAGS_DISABLE),
-  NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE),
-  0,
-  0,
   0,
   NULL
 };
@@ -402,11 +397,10 @@ usrsock_handle_datareq_response(FAR struct usrsock_conn_s *conn,
  ****************************************************************************/
 
 static ssize_t usrsock_handle_req_response(FAR const void *buffer,
-                                           size_t len, FAR bool *req_done)
+                                           size_t len, FAR uint32_t *ackxid)
 {
   FAR const struct usrsock_message_req_ack_s *hdr = buffer;
   FAR struct usrsock_conn_s *conn = NULL;
-  FAR struct usrsock_req_s *req = &g_usrsock_req;
   ssize_t (*handle_response)(FAR struct usrsock_conn_s *conn,
                              FAR const void *buffer,
                              size_t len);
@@ -455,19 +449,19 @@ static ssize_t usrsock_handle_req_response(FAR const void *buffer,
       goto unlock_out;
     }
 
-  if (req->ackxid == hdr->xid)
+  if (conn->resp.ackxid == hdr->xid)
     {
-      req->ackxid = 0;
-      if (req_done)
+      conn->resp.ackxid = 0;
+      if (ackxid)
         {
-          *req_done = true;
+          *ackxid = hdr->xid;
         }
 
       /* Signal that request was received and read by daemon and
        * acknowledgment response was received.
        */
 
-      nxsem_post(&req->acksem);
+      nxsem_post(&conn->resp.acksem);
     }
 
   conn->resp.events = hdr->head.events | USRSOCK_EVENT_REQ_COMPLETE;
@@ -483,7 +477,7 @@ unlock_out:
  ****************************************************************************/
 
 static ssize_t usrsock_handle_message(FAR const void *buffer, size_t len,
-                                      FAR bool *req_done)
+                                      FAR uint32_t *ackxid)
 {
   FAR const struct usrsock_message_common_s *common = buffer;
 
@@ -494,7 +488,7 @@ static ssize_t usrsock_handle_message(FAR const void *buffer, size_t len,
 
   if (USRSOCK_MESSAGE_IS_REQ_RESPONSE(common->flags))
     {
-      return usrsock_handle_req_response(buffer, len, req_done);
+      return usrsock_handle_req_response(buffer, len, ackxid);
     }
 
   return -EINVAL;
@@ -506,10 +500,20 @@ static ssize_t usrsock_handle_message(FAR const void *buffer, size_t len,
 
 /****************************************************************************
  * Name: usrsock_response() - handle usrsock request's ack/response
+ *
+ * Description:
+ *   Handle one message from the daemon, together with the data that
+ *   follows a data response, or the continuation of the data of a data
+ *   response.  The bytes after the message are left for the next call, so
+ *   that the device may pass several messages written at once.
+ *
+ *   If the message acknowledges a request, its exchange id is returned in
+ *   'ackxid' (when not NULL).
+ *
  ****************************************************************************/
 
 ssize_t usrsock_response(FAR const char *buffer, size_t len,
-                         FAR bool *req_done)
+                         FAR uint32_t *ackxid)
 {
   FAR struct usrsock_req_s *req = &g_usrsock_req;
   FAR struct usrsock_conn_s *conn;
@@ -531,7 +535,7 @@ ssize_t usrsock_response(FAR const char *buffer, size_t len,
 
       /* Handle message. */
 
-      ret = usrsock_handle_message(buffer, len, req_done);
+      ret = usrsock_handle_message(buffer, len, ackxid);
       if (ret >= 0)
         {
           buffer += ret;
@@ -544,9 +548,11 @@ ssize_t usrsock_response(FAR const char *buffer, size_t len,
     {
       conn = req->datain_conn;
 
-      /* Copy data from user-space. */
+      /* Copy data from user-space, directly into the receive buffers of
+       * the request.
+       */
 
-      if (len != 0)
+      if (len != 0 && conn->resp.datain.pos < conn->resp.datain.total)
         {
           ret = usrsock_iovec_put(conn->resp.datain.iov,
                                   conn->resp.datain.iovcnt,
@@ -614,13 +620,10 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
   FAR struct usrsock_req_s *req = &g_usrsock_req;
   int ret;
 
-  /* Get exchange id. */
+  /* Get exchange id (net_lock held). */
 
   req_head = iov[0].iov_base;
 
-  /* Set outstanding request for daemon to handle. */
-
-  net_lockedwait_uninterruptible(&req->sem);
   if (++req->newxid == 0)
     {
       ++req->newxid;
@@ -632,22 +635,26 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
 
   conn->resp.xid = req_head->xid;
   conn->resp.result = -EACCES;
+  conn->resp.ackxid = req_head->xid;
 
-  req->ackxid = req_head->xid;
+  /* Queue the request for daemon to handle.  The requests of the other
+   * connections may be outstanding at the same time.
+   */
 
   ret = usrsock_request(iov, iovcnt);
   if (ret == OK)
     {
-      /* Wait ack for request. */
+      /* Wait ack for request.  The request buffers must stay valid until
+       * then.
+       */
 
-      ++req->nbusy; /* net_lock held. */
-      net_lockedwait_uninterruptible(&req->acksem);
-      --req->nbusy; /* net_lock held. */
+      net_lockedwait_uninterruptible(&conn->resp.acksem);
+    }
+  else
+    {
+      conn->resp.ackxid = 0;
     }
 
-  /* Free request line for next command. */
-
-  nxsem_post(&req->sem);
   return ret;
 }
 
@@ -657,9 +664,7 @@ int usrsock_do_request(FAR struct usrsock_conn_s *conn,
 
 void usrsock_abort(void)
 {
-  FAR struct usrsock_req_s *req = &g_usrsock_req;
   FAR struct usrsock_conn_s *conn = NULL;
-  int ret;
 
   net_lock();
 
@@ -671,38 +676,15 @@ void usrsock_abort(void)
       conn->resp.xid = 0;
       conn->resp.events = USRSOCK_EVENT_ABORT;
       usrsock_event(conn);
-    }
 
-  do
-    {
-      /* Give other threads short time window to complete recently completed
-       * requests.
-       */
+      /* Wake-up the request waiting for its acknowledgment. */
 
-      ret = net_timedwait(&req->sem, 10);
-      if (ret < 0)
+      if (conn->resp.ackxid != 0)
         {
-          if (ret != -ETIMEDOUT && ret != -EINTR)
-            {
-              ninfo("net_timedwait errno: %d\n", ret);
-              DEBUGASSERT(false);
-            }
+          conn->resp.ackxid = 0;
+          nxsem_post(&conn->resp.acksem);
         }
-      else
-        {
-          nxsem_post(&req->sem);
-        }
-
-      /* Wake-up pending requests. */
-
-      if (req->nbusy == 0)
-        {
-          break;
-        }
-
-      nxsem_post(&req->acksem);
     }
-  while (true);
 
   net_unlock();
 }
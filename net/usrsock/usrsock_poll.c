@@ -37,6 +37,7 @@
 #include <sys/socket.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
+#include <nuttx/fs/fs.h>
 #include <nuttx/net/usrsock.h>
 
 #include "usrsock/usrsock.h"
@@ -118,7 +119,7 @@ static uint16_t poll_event(FAR struct net_driver_s *dev,
   if (eventset)
     {
       info->fds->revents |= eventset;
-      nxsem_post(info->fds->sem);
+      poll_notify(info->fds);
     }
 
   return flags;
@@ -269,7 +270,7 @@ static int usrsock_pollsetup(FAR struct socket *psock,
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 errout_unlock:
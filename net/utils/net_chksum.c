@@ -25,6 +25,11 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+
 #include "utils/utils.h"
 
 /****************************************************************************
@@ -50,41 +55,119 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
+#ifdef CONFIG_NET_ARCH_CHKSUM
+uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+{
+  return up_chksum(sum, data, len);
+}
+#else
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *data32;
+  unsigned int nbytes = len;
+  uint32_t acc = 0;
+  uint32_t w;
+  bool odd = false;
+
+  if (nbytes == 0)
+    {
+      return sum;
+    }
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* The data is summed as aligned 16-bit words in the native byte order
+   * (RFC 1071, section 2).  If the data starts at an odd address, the
+   * first byte is the second half of a word and all of the bytes are
+   * summed in swapped positions:  Swap the sum back at the end.
+   */
 
-  while (dataptr < last_byte)
+  if (((uintptr_t)data & 1) != 0)
     {
-      /* At least two more bytes */
+#ifdef CONFIG_ENDIAN_BIG
+      acc = data[0];
+#else
+      acc = (uint32_t)data[0] << 8;
+#endif
+      data++;
+      nbytes--;
+      odd = true;
+    }
+
+  if (((uintptr_t)data & 2) != 0 && nbytes >= 2)
+    {
+      acc    += *(FAR const uint16_t *)data;
+      data   += 2;
+      nbytes -= 2;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Sum 16 bytes per iteration.  The 32-bit accumulator cannot overflow:
+   * A packet holds less than 64KiB and each word adds less than 2^17.
+   */
 
-      dataptr += 2;
+  data32 = (FAR const uint32_t *)data;
+  while (nbytes >= 16)
+    {
+      w    = data32[0];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = data32[1];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = data32[2];
+      acc += (w & 0xffff) + (w >> 16);
+      w    = data32[3];
+      acc += (w & 0xffff) + (w >> 16);
+
+      data32 += 4;
+      nbytes -= 16;
     }
 
-  if (dataptr == last_byte)
+  while (nbytes >= 4)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      w    = *data32++;
+      acc += (w & 0xffff) + (w >> 16);
+      nbytes -= 4;
     }
 
-  /* Return sum in host byte order. */
+  data = (FAR const uint8_t *)data32;
+  if (nbytes >= 2)
+    {
+      acc    += *(FAR const uint16_t *)data;
+      data   += 2;
+      nbytes -= 2;
+    }
+
+  if (nbytes > 0)
+    {
+      /* The last byte is the first half of a word */
+
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint32_t)data[0] << 8;
+#else
+      acc += data[0];
+#endif
+    }
+
+  /* Fold the carries back into 16 bits */
+
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  if (odd)
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+  /* Return the sum in host byte order, i.e. as the sum of big-endian
+   * words, added to the sum carried over.
+   */
+
+#ifndef CONFIG_ENDIAN_BIG
+  acc = ((acc & 0xff) << 8) | (acc >> 8);
+#endif
+
+  sum += (uint16_t)acc;
+  if (sum < (uint16_t)acc)
+    {
+      sum++; /* carry */
+    }
 
   return sum;
 }
@@ -101,9 +184,6 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
  *
  *   See RFC1071.
  *
- *   If CONFIG_NET_ARCH_CHKSUM is defined, then this function must be
- *   provided by architecture-specific logic.
- *
  * Input Parameters:
  *
  *   buf - A pointer to the buffer over which the checksum is to be computed.
@@ -116,11 +196,9 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t net_chksum(FAR uint16_t *data, uint16_t len)
 {
   return HTONS(chksum(0, (uint8_t *)data, len));
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
 
 #endif /* CONFIG_NET */
@@ -61,7 +61,7 @@
  *
  ****************************************************************************/
 
-#if !defined(CONFIG_NET_ARCH_CHKSUM) && defined(CONFIG_NET_IPv4)
+#ifdef CONFIG_NET_IPv4
 uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 {
   FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
@@ -103,7 +103,7 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
   sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_NET_IPv4 */
 
 /****************************************************************************
  * Name: ipv6_upperlayer_chksum
@@ -125,7 +125,7 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
  *
  ****************************************************************************/
 
-#if !defined(CONFIG_NET_ARCH_CHKSUM) && defined(CONFIG_NET_IPv6)
+#ifdef CONFIG_NET_IPv6
 uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
                                 uint8_t proto, unsigned int iplen)
 {
@@ -170,7 +170,7 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
   sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_NET_IPv6 */
 
 /****************************************************************************
  * Name: ipv4_chksum
@@ -181,15 +181,12 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
  *   The IPv4 header checksum is the Internet checksum of the 20 bytes of
  *   the IPv4 header.
  *
- *   If CONFIG_NET_ARCH_CHKSUM is defined, then this function must be
- *   provided by architecture-specific logic.
- *
  * Returned Value:
  *   The IPv4 header checksum of the IPv4 header in the d_buf buffer.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NET_ARCH_CHKSUM)
+#ifdef CONFIG_NET_IPv4
 uint16_t ipv4_chksum(FAR struct net_driver_s *dev)
 {
   FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
@@ -203,6 +200,6 @@ uint16_t ipv4_chksum(FAR struct net_driver_s *dev)
   sum = chksum(0, &dev->d_buf[NET_LL_HDRLEN(dev)], iphdrlen);
   return (sum == 0) ? 0xffff : HTONS(sum);
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* CONFIG_NET_IPv4 */
 
 #endif /* CONFIG_NET */
@@ -222,9 +222,6 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
  *
  *   See RFC1071.
  *
- *   If CONFIG_NET_ARCH_CHKSUM is defined, then this function must be
- *   provided by architecture-specific logic.
- *
  * Input Parameters:
  *
  *   buf - A pointer to the buffer over which the checksum is to be computed.
@@ -83,6 +83,12 @@ void clock_timer(void);
 #  define clock_timer()
 #endif
 
+#ifdef CONFIG_CLOCK_VDATA
+void clock_vdata_update(void);
+#else
+#  define clock_vdata_update()
+#endif
+
 int  clock_abstime2ticks(clockid_t clockid,
                          FAR const struct timespec *abstime,
                          FAR sclock_t *ticks);
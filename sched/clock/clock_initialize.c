@@ -419,5 +419,9 @@ void clock_timer(void)
   /* Increment the per-tick system counter */
 
   g_system_timer++;
+
+  /* Publish the new time to user space */
+
+  clock_vdata_update();
 }
 #endif
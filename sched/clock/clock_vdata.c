@@ -0,0 +1,89 @@
+/****************************************************************************
+ * sched/clock/clock_vdata.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/userspace.h>
+
+#include "clock/clock.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All fields of the time data are volatile.  Without SMP support, no
+ * hardware memory barrier is required in addition.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+#ifdef CONFIG_CLOCK_VDATA
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_vdata_update
+ *
+ * Description:
+ *   Publish the current system timer and time-of-day base to the time data
+ *   in user space.  clock_gettime() in user space reads the data without a
+ *   system call.
+ *
+ *   This must be called on every timer tick and whenever the time-of-day
+ *   base changes.
+ *
+ ****************************************************************************/
+
+void clock_vdata_update(void)
+{
+  FAR struct clock_vdata_s *vdata = USERSPACE->us_clockvdata;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(NULL);
+
+  /* An odd sequence number tells the readers that an update is ongoing */
+
+  vdata->cv_seq++;
+  SP_DMB();
+
+  vdata->cv_ticks    = clock_systime_ticks();
+  vdata->cv_basesec  = g_basetime.tv_sec;
+  vdata->cv_basensec = g_basetime.tv_nsec;
+
+  SP_DMB();
+  vdata->cv_seq++;
+
+  spin_unlock_irqrestore(NULL, flags);
+}
+
+#endif /* CONFIG_CLOCK_VDATA */
@@ -0,0 +1,214 @@
+/****************************************************************************
+ * sched/environ/env_addvar.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#ifndef CONFIG_DISABLE_ENVIRON
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "environ/environ.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The smallest allocations of the string array and of the hash table */
+
+#define ENV_MINALLOC 8
+#define ENV_MINHASH  16
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: env_rehash
+ *
+ * Description:
+ *   Reallocate the hash table of an environment so that it can index
+ *   'nvars' variables and index all strings of the environment again.
+ *
+ * Input Parameters:
+ *   group - The task group owning the environment
+ *   env   - The environment to index
+ *   nvars - The number of variables that the hash table must hold
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.  The previous table is kept
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int env_rehash(FAR struct task_group_s *group, FAR struct environ_s *env,
+               size_t nvars)
+{
+  FAR uint16_t *hash;
+  uint32_t nhash;
+  uint32_t mask;
+  uint32_t slot;
+  int i;
+
+  DEBUGASSERT(env != NULL && nvars <= ENV_MAXVARS && env->ev_envc <= nvars);
+
+  /* Keep the load factor at or below one half */
+
+  for (nhash = ENV_MINHASH; nhash < 2 * nvars; nhash <<= 1)
+    {
+    }
+
+  hash = group_zalloc(group, sizeof(*hash) * nhash);
+  if (hash == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  mask = nhash - 1;
+  for (i = 0; i < env->ev_envc; i++)
+    {
+      for (slot = env_hashname(env->ev_envp[i]) & mask;
+           hash[slot] != 0;
+           slot = (slot + 1) & mask)
+        {
+        }
+
+      hash[slot] = i + 1;
+    }
+
+  if (env->ev_hash != NULL)
+    {
+      group_free(group, env->ev_hash);
+    }
+
+  env->ev_hash  = hash;
+  env->ev_nhash = nhash;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: env_addvar
+ *
+ * Description:
+ *   Add a new name=value string to the (unshared) environment of the task
+ *   group.  The variable must not exist in the environment.
+ *
+ * Input Parameters:
+ *   group - The task group with the environment
+ *   pvar  - The name=value string, allocated with group_malloc().  It
+ *           belongs to the environment on success.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Pre-emption is disabled by caller
+ *
+ ****************************************************************************/
+
+int env_addvar(FAR struct task_group_s *group, FAR char *pvar)
+{
+  FAR struct environ_s *env;
+  FAR char **envp;
+  uint32_t mask;
+  uint32_t slot;
+  size_t nalloc;
+  int ret;
+
+  DEBUGASSERT(group != NULL && pvar != NULL);
+
+  /* Create an empty environment if there is none */
+
+  env = group->tg_env;
+  if (env == NULL)
+    {
+      ret = env_copy(group, NULL, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      env = group->tg_env;
+    }
+
+  DEBUGASSERT(env->ev_crefs == 1);
+
+  if (env->ev_envc >= ENV_MAXVARS)
+    {
+      return -ENOMEM;
+    }
+
+  /* Grow the string array, keeping room for the NULL terminator */
+
+  if (env->ev_envc + 1 >= env->ev_nalloc)
+    {
+      nalloc = env->ev_nalloc < ENV_MINALLOC ?
+               ENV_MINALLOC : 2 * (size_t)env->ev_nalloc;
+      if (nalloc > ENV_MAXVARS + 1)
+        {
+          nalloc = ENV_MAXVARS + 1;
+        }
+
+      envp = group_realloc(group, env->ev_envp, sizeof(*envp) * nalloc);
+      if (envp == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      env->ev_envp   = envp;
+      env->ev_nalloc = nalloc;
+    }
+
+  /* Grow the hash table */
+
+  if (2 * ((size_t)env->ev_envc + 1) > env->ev_nhash)
+    {
+      ret = env_rehash(group, env, env->ev_envc + 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Append the string and index it */
+
+  env->ev_envp[env->ev_envc]     = pvar;
+  env->ev_envp[env->ev_envc + 1] = NULL;
+
+  mask = env->ev_nhash - 1;
+  for (slot = env_hashname(pvar) & mask;
+       env->ev_hash[slot] != 0;
+       slot = (slot + 1) & mask)
+    {
+    }
+
+  env->ev_hash[slot] = ++env->ev_envc;
+  return OK;
+}
+
+#endif /* CONFIG_DISABLE_ENVIRON */
@@ -27,27 +27,195 @@
 #ifndef CONFIG_DISABLE_ENVIRON
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <sched.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 
 #include "sched/sched.h"
 #include "environ/environ.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: env_shareable
+ *
+ * Description:
+ *   Return true if the environment of the task group 'parent' may be shared
+ *   with the task group 'group'.  Both must use the same memory allocator
+ *   and the same address space.
+ *
+ ****************************************************************************/
+
+static bool env_shareable(FAR struct task_group_s *parent,
+                          FAR struct task_group_s *group)
+{
+#ifdef CONFIG_ARCH_ADDRENV
+  return false;
+#else
+  return ((parent->tg_flags ^ group->tg_flags) & GROUP_FLAG_PRIVILEGED) == 0;
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: env_copy
+ *
+ * Description:
+ *   Create a private environment for the task group from 'envc' name=value
+ *   strings.  Any previous environment of the group is not released.
+ *
+ * Input Parameters:
+ *   group - The task group to receive the environment
+ *   envcp - The name=value strings to copy
+ *   envc  - The number of strings in envcp
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   Not called from an interrupt handler
+ *
+ ****************************************************************************/
+
+int env_copy(FAR struct task_group_s *group, FAR char * const *envcp,
+             size_t envc)
+{
+  FAR struct environ_s *env;
+  size_t i;
+
+  DEBUGASSERT(group != NULL && (envcp != NULL || envc == 0));
+
+  if (envc > ENV_MAXVARS)
+    {
+      return -ENOMEM;
+    }
+
+  env = group_zalloc(group, sizeof(struct environ_s));
+  if (env == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  env->ev_envp = group_zalloc(group, sizeof(*env->ev_envp) * (envc + 1));
+  if (env->ev_envp == NULL)
+    {
+      goto errout_with_env;
+    }
+
+  env->ev_crefs  = 1;
+  env->ev_nalloc = envc + 1;
+
+  /* Duplicate the strings.  The array is NULL terminated at any time. */
+
+  for (i = 0; i < envc; i++)
+    {
+      env->ev_envp[i] = group_malloc(group, strlen(envcp[i]) + 1);
+      if (env->ev_envp[i] == NULL)
+        {
+          goto errout_with_strings;
+        }
+
+      strcpy(env->ev_envp[i], envcp[i]);
+      env->ev_envc++;
+    }
+
+  if (env_rehash(group, env, envc) < 0)
+    {
+      goto errout_with_strings;
+    }
+
+  group->tg_env = env;
+  return OK;
+
+errout_with_strings:
+  for (i = 0; env->ev_envp[i] != NULL; i++)
+    {
+      group_free(group, env->ev_envp[i]);
+    }
+
+  group_free(group, env->ev_envp);
+
+errout_with_env:
+  group_free(group, env);
+  return -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Make sure that the environment of the task group is not shared with
+ *   other task groups before it is modified.  Indexes into the environment
+ *   remain valid.
+ *
+ * Input Parameters:
+ *   group - The task group whose environment will be modified
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Pre-emption is disabled by caller
+ *
+ ****************************************************************************/
+
+int env_unshare(FAR struct task_group_s *group)
+{
+  FAR struct environ_s *shared;
+  FAR struct environ_s *copy;
+  int ret;
+
+  DEBUGASSERT(group != NULL);
+
+  shared = group->tg_env;
+  if (shared == NULL || shared->ev_crefs == 1)
+    {
+      return OK;
+    }
+
+  /* The shared environment is never modified, so it may be copied while
+   * other task groups use it.
+   */
+
+  ret = env_copy(group, shared->ev_envp, shared->ev_envc);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* env_copy() installed the private copy.  Drop the reference to the
+   * shared environment, the other task groups may have released it
+   * meanwhile.
+   */
+
+  copy          = group->tg_env;
+  group->tg_env = shared;
+  env_release(group);
+
+  group->tg_env = copy;
+  return OK;
+}
+
 /****************************************************************************
  * Name: env_dup
  *
  * Description:
  *   Copy the internal environment structure of a task.  This is the action
- *   that is performed when a new task is created: The new task has a
- *   private, exact duplicate of the parent task's environment.
+ *   that is performed when a new task is created: The new task has an exact
+ *   duplicate of the parent task's environment.  The environment of the
+ *   parent task group is shared until one of the task groups modifies it.
+ *   An environment provided by the caller is always copied.
  *
  * Input Parameters:
  *   group - The child task group to receive the newly allocated copy of
@@ -63,8 +231,9 @@
 
 int env_dup(FAR struct task_group_s *group, FAR char * const *envcp)
 {
-  FAR struct tcb_s *ptcb = this_task();
-  FAR char **envp = NULL;
+  FAR struct task_group_s *parent = this_task()->group;
+  FAR struct environ_s *env;
+  irqstate_t flags;
   size_t envc = 0;
   int ret = OK;
 
@@ -76,64 +245,45 @@ int env_dup(FAR struct task_group_s *group, FAR char * const *envcp)
 
   sched_lock();
 
-  /* Is there an environment ? */
-
-  if (envcp || (envcp = ptcb->group->tg_envp) != NULL)
+  env = parent->tg_env;
+  if (envcp == NULL || (env != NULL && envcp == env->ev_envp))
     {
-      /* Count the strings */
-
-      while (envcp[envc] != NULL)
-        {
-          envc++;
-        }
-
-      /* A special case is that the parent has an "empty" environment
-       * allocation, i.e., there is an allocation in place but it
-       * contains no variable definitions and, hence, envc == 0.
+      /* Inherit the environment of the parent.  A special case is that the
+       * parent has an "empty" environment allocation, i.e., there is an
+       * allocation in place but it contains no variable definitions.
        */
 
-      if (envc > 0)
+      if (env != NULL && env->ev_envc > 0)
         {
-          /* There is an environment, duplicate it */
-
-          envp = group_malloc(group, sizeof(*envp) * (envc + 1));
-          if (envp == NULL)
+          if (env_shareable(parent, group))
             {
-              /* The parent's environment can not be inherited due to a
-               * failure in the allocation of the child environment.
-               */
+              /* Share it until it is modified */
 
-              ret = -ENOMEM;
+              flags = enter_critical_section();
+              env->ev_crefs++;
+              leave_critical_section(flags);
+
+              group->tg_env = env;
             }
           else
             {
-              envp[envc] = NULL;
-
-              /* Duplicate the parent environment. */
-
-              while (envc-- > 0)
-                {
-                  envp[envc] = group_malloc(group, strlen(envcp[envc]) + 1);
-                  if (envp[envc] == NULL)
-                    {
-                      while (envp[++envc] != NULL)
-                        {
-                          group_free(group, envp[envc]);
-                        }
-
-                      group_free(group, envp);
-                      ret = -ENOMEM;
-                      break;
-                    }
-
-                  strcpy(envp[envc], envcp[envc]);
-                }
+              ret = env_copy(group, env->ev_envp, env->ev_envc);
             }
         }
+    }
+  else
+    {
+      /* Count the strings */
 
-      /* Save the child environment allocation. */
+      while (envcp[envc] != NULL)
+        {
+          envc++;
+        }
 
-      group->tg_envp = envp;
+      if (envc > 0)
+        {
+          ret = env_copy(group, envcp, envc);
+        }
     }
 
   sched_unlock();
@@ -27,9 +27,11 @@
 #ifndef CONFIG_DISABLE_ENVIRON
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <sched.h>
 #include <assert.h>
+#include <errno.h>
 
 #include "environ/environ.h"
 
@@ -63,6 +65,27 @@ static bool env_cmpname(const char *pszname, const char *peqname)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: env_hashname
+ *
+ * Description:
+ *   Return the hash of a variable name.  The name ends with '\0' or '='.
+ *   This is the 32-bit FNV-1a hash.
+ *
+ ****************************************************************************/
+
+uint32_t env_hashname(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  for (; *name != '\0' && *name != '='; name++)
+    {
+      hash = (hash ^ (uint8_t)*name) * 16777619u;
+    }
+
+  return hash;
+}
+
 /****************************************************************************
  * Name: env_findvar
  *
@@ -85,24 +108,31 @@ static bool env_cmpname(const char *pszname, const char *peqname)
 
 int env_findvar(FAR struct task_group_s *group, FAR const char *pname)
 {
-  int i;
+  FAR struct environ_s *env;
+  uint32_t mask;
+  uint32_t slot;
+  int index;
 
   /* Verify input parameters */
 
   DEBUGASSERT(group != NULL && pname != NULL);
 
-  if (group->tg_envp == NULL)
+  env = group->tg_env;
+  if (env == NULL || env->ev_envc == 0)
     {
       return -ENOENT;
     }
 
-  /* Search for a name=value string with matching name */
+  /* Probe the hash table for a name=value string with matching name */
 
-  for (i = 0; group->tg_envp[i] != NULL; i++)
+  mask = env->ev_nhash - 1;
+  for (slot = env_hashname(pname) & mask;
+       (index = env->ev_hash[slot]) != 0;
+       slot = (slot + 1) & mask)
     {
-      if (env_cmpname(pname, group->tg_envp[i]))
+      if (env_cmpname(pname, env->ev_envp[index - 1]))
         {
-          return i;
+          return index - 1;
         }
     }
 
@@ -72,16 +72,16 @@ int env_foreach(FAR struct task_group_s *group,
 
   DEBUGASSERT(group != NULL && cb != NULL);
 
-  if (group->tg_envp == NULL)
+  if (group->tg_env == NULL)
     {
       return ret;
     }
 
-  for (i = 0; group->tg_envp[i] != NULL; i++)
+  for (i = 0; group->tg_env->ev_envp[i] != NULL; i++)
     {
       /* Perform the callback */
 
-      ret = cb(arg, group->tg_envp[i]);
+      ret = cb(arg, group->tg_env->ev_envp[i]);
 
       /* Terminate the traversal early if the callback so requests by
        * returning a non-zero value.
@@ -86,7 +86,7 @@ FAR char *getenv(FAR const char *name)
 
   /* It does!  Get the value sub-string from the name=value string */
 
-  pvalue = strchr(group->tg_envp[ret], '=');
+  pvalue = strchr(group->tg_env->ev_envp[ret], '=');
   if (pvalue == NULL)
     {
       /* The name=value string has no '='  This is a bug! */
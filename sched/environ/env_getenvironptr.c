@@ -29,6 +29,7 @@
 #include <sched.h>
 #include <stdlib.h>
 #include "sched/sched.h"
+#include "environ/environ.h"
 
 #undef get_environ_ptr
 
@@ -56,7 +57,7 @@ FAR char **get_environ_ptr(void)
 {
   FAR struct tcb_s *tcb = this_task();
 
-  return tcb->group->tg_envp;
+  return tcb->group->tg_env ? tcb->group->tg_env->ev_envp : NULL;
 }
 
 #endif /* CONFIG_DISABLE_ENVIRON */
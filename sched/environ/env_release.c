@@ -30,6 +30,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 
 #include "environ/environ.h"
@@ -61,29 +62,50 @@
 
 void env_release(FAR struct task_group_s *group)
 {
+  FAR struct environ_s *env;
+  irqstate_t flags;
+  int crefs;
   int i;
 
   DEBUGASSERT(group != NULL);
 
-  if (group->tg_envp)
+  env = group->tg_env;
+  if (env)
     {
-      /* Free any allocate environment strings */
+      /* Drop the reference of this task group.  The environment may still
+       * be shared with other task groups.
+       */
 
-      for (i = 0; group->tg_envp[i] != NULL; i++)
+      flags = enter_critical_section();
+      crefs = --env->ev_crefs;
+      leave_critical_section(flags);
+
+      if (crefs == 0)
         {
-          group_free(group, group->tg_envp[i]);
-        }
+          /* Free any allocate environment strings */
+
+          for (i = 0; env->ev_envp[i] != NULL; i++)
+            {
+              group_free(group, env->ev_envp[i]);
+            }
 
-      /* Free the environment */
+          /* Free the environment */
 
-      group_free(group, group->tg_envp);
+          group_free(group, env->ev_envp);
+          if (env->ev_hash != NULL)
+            {
+              group_free(group, env->ev_hash);
+            }
+
+          group_free(group, env);
+        }
     }
 
   /* In any event, make sure that all environment-related variables in the
    * task group structure are reset to initial values.
    */
 
-  group->tg_envp = NULL;
+  group->tg_env = NULL;
 }
 
 #endif /* CONFIG_DISABLE_ENVIRON */
@@ -26,7 +26,7 @@
 
 #ifndef CONFIG_DISABLE_ENVIRON
 
-#include <string.h>
+#include <stdint.h>
 #include <sched.h>
 #include <assert.h>
 
@@ -61,37 +61,86 @@
 
 void env_removevar(FAR struct task_group_s *group, int index)
 {
-  DEBUGASSERT(group != NULL && index >= 0);
+  FAR struct environ_s *env;
+  FAR char *pvar;
+  uint32_t mask;
+  uint32_t slot;
+  uint32_t next;
+  uint32_t home;
+  int last;
 
-  /* Free the allocate environment string */
+  DEBUGASSERT(group != NULL && group->tg_env != NULL && index >= 0);
 
-  group_free(group, group->tg_envp[index]);
+  env  = group->tg_env;
+  DEBUGASSERT(env->ev_crefs == 1 && index < env->ev_envc);
 
-  /* Move all of the environment strings after the removed one 'down.'
-   * this is inefficient, but robably not high duty.
-   */
+  pvar = env->ev_envp[index];
+  last = env->ev_envc - 1;
+  mask = env->ev_nhash - 1;
+
+  /* Find the hash table entry of the removed string */
 
-  do
+  for (slot = env_hashname(pvar) & mask;
+       env->ev_hash[slot] != index + 1;
+       slot = (slot + 1) & mask)
     {
-      group->tg_envp[index] = group->tg_envp[index + 1];
+      DEBUGASSERT(env->ev_hash[slot] != 0);
     }
-  while (group->tg_envp[++index] != NULL);
 
-  /* Free the old environment (if there was one) */
+  /* Delete it and move the following entries of the probe sequence back
+   * so that no lookup stops at the free entry too early.
+   */
 
-  if (index == 1)
+  for (; ; )
     {
-      group_free(group, group->tg_envp);
-      group->tg_envp = NULL;
+      env->ev_hash[slot] = 0;
+
+      for (next = (slot + 1) & mask; env->ev_hash[next] != 0;
+           next = (next + 1) & mask)
+        {
+          /* The entry may move to 'slot' unless its home entry lies
+           * cyclically in (slot, next].
+           */
+
+          home = env_hashname(env->ev_envp[env->ev_hash[next] - 1]) & mask;
+          if (slot <= next ? (home <= slot || home > next) :
+                             (home <= slot && home > next))
+            {
+              break;
+            }
+        }
+
+      if (env->ev_hash[next] == 0)
+        {
+          break;
+        }
+
+      env->ev_hash[slot] = env->ev_hash[next];
+      slot = next;
     }
-  else
-    {
-      /* Reallocate the environment to reclaim a little memory */
 
-      group->tg_envp = group_realloc(group, group->tg_envp,
-                                     sizeof(*group->tg_envp) * (index + 1));
-      DEBUGASSERT(group->tg_envp != NULL);
+  /* Move the last string into the free position of the array.  This keeps
+   * the removal O(1) (on average) but changes the order of the strings.
+   */
+
+  if (index != last)
+    {
+      for (slot = env_hashname(env->ev_envp[last]) & mask;
+           env->ev_hash[slot] != last + 1;
+           slot = (slot + 1) & mask)
+        {
+        }
+
+      env->ev_hash[slot]   = index + 1;
+      env->ev_envp[index]  = env->ev_envp[last];
     }
+
+  env->ev_envp[last] = NULL;
+  env->ev_envc       = last;
+
+  /* Free the allocate environment string */
+
+  group_free(group, pvar);
 }
 
 #endif /* CONFIG_DISABLE_ENVIRON */
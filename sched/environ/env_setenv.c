@@ -70,10 +70,9 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
   FAR struct tcb_s *rtcb;
   FAR struct task_group_s *group;
   FAR char *pvar;
-  FAR char **envp;
-  int envc = 0;
   int varlen;
   int ret = OK;
+  int idx;
 
   /* Verify input parameter */
 
@@ -114,24 +113,26 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 
   /* Check if the variable already exists */
 
-  if (group->tg_envp && (ret = env_findvar(group, name)) >= 0)
+  idx = env_findvar(group, name);
+  if (idx >= 0 && !overwrite)
     {
-      /* It does! Do we have permission to overwrite the existing value? */
-
-      if (!overwrite)
-        {
-          /* No.. then just return success */
+      /* It does, but we do not have permission to overwrite the existing
+       * value.  Just return success.
+       */
 
-          sched_unlock();
-          return OK;
-        }
+      sched_unlock();
+      return OK;
+    }
 
-      /* Yes.. just remove the name=value pair from the environment.  It will
-       * be added again below.  Note that we are responsible for reallocating
-       * the environment buffer; this will happen below.
-       */
+  /* The environment will be modified.  Make sure that it is not shared
+   * with other task groups.
+   */
 
-      env_removevar(group, ret);
+  ret = env_unshare(group);
+  if (ret < 0)
+    {
+      ret = -ret;
+      goto errout_with_lock;
     }
 
   /* Get the size of the new name=value string.
@@ -140,7 +141,7 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 
   varlen = strlen(name) + strlen(value) + 2;
 
-  /* Then allocate or reallocate the environment buffer */
+  /* Then allocate the new name=value string */
 
   pvar = group_malloc(group, varlen);
   if (pvar == NULL)
@@ -149,41 +150,29 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
       goto errout_with_lock;
     }
 
-  if (group->tg_envp)
+  sprintf(pvar, "%s=%s", name, value);
+
+  if (idx >= 0)
     {
-      while (group->tg_envp[envc] != NULL)
-        {
-          envc++;
-        }
+      /* Replace the existing name=value string.  The name is the same, so
+       * the index remains valid.
+       */
 
-      envp = group_realloc(group, group->tg_envp,
-                           sizeof(*envp) * (envc + 2));
-      if (envp == NULL)
-        {
-          ret = ENOMEM;
-          goto errout_with_var;
-        }
+      group_free(group, group->tg_env->ev_envp[idx]);
+      group->tg_env->ev_envp[idx] = pvar;
     }
   else
     {
-      envp = group_malloc(group, sizeof(*envp) * 2);
-      if (envp == NULL)
+      /* Add the new name=value string to the environment */
+
+      ret = env_addvar(group, pvar);
+      if (ret < 0)
         {
-          ret = ENOMEM;
+          ret = -ret;
           goto errout_with_var;
         }
     }
 
-  envp[envc++] = pvar;
-  envp[envc]   = NULL;
-
-  /* Save the new buffer */
-
-  group->tg_envp = envp;
-
-  /* Now, put the new name=value string into the environment buffer */
-
-  sprintf(pvar, "%s=%s", name, value);
   sched_unlock();
   return OK;
 
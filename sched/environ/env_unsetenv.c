@@ -62,6 +62,7 @@ int unsetenv(FAR const char *name)
   FAR struct tcb_s *rtcb = this_task();
   FAR struct task_group_s *group = rtcb->group;
   int idx;
+  int ret;
 
   DEBUGASSERT(group);
 
@@ -78,7 +79,17 @@ int unsetenv(FAR const char *name)
   sched_lock();
   if (group && (idx = env_findvar(group, name)) >= 0)
     {
-      /* It does!  Remove the name=value pair from the environment. */
+      /* It does!  Remove the name=value pair from a private copy of the
+       * environment.
+       */
+
+      ret = env_unshare(group);
+      if (ret < 0)
+        {
+          sched_unlock();
+          set_errno(-ret);
+          return ERROR;
+        }
 
       env_removevar(group, idx);
     }
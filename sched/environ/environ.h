@@ -26,6 +26,9 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdint.h>
+
 #include <nuttx/sched.h>
 
 /****************************************************************************
@@ -37,6 +40,37 @@
 #  define env_release(group)   (0)
 #else
 
+/* The largest number of variables in one environment.  The hash table of
+ * such an environment still has no more than 32768 entries.
+ */
+
+#define ENV_MAXVARS 16384
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure holds the environment of a task group.  The name=value
+ * strings are kept in a NULL terminated array that is also used as the
+ * 'environ' of the tasks.  A hash table with linear probing indexes the
+ * strings by name.
+ *
+ * A new task group shares the environment of its parent (copy-on-write):
+ * ev_crefs counts the task groups using the environment.  A shared
+ * environment is never modified; env_unshare() must be called to get a
+ * private copy first.
+ */
+
+struct environ_s
+{
+  uint16_t ev_crefs;           /* Number of task groups sharing this */
+  uint16_t ev_envc;            /* Number of name=value strings */
+  uint16_t ev_nalloc;          /* Allocated entries in ev_envp */
+  uint16_t ev_nhash;           /* Entries in ev_hash, a power of two */
+  FAR uint16_t *ev_hash;       /* Index + 1 of a string in ev_envp or 0 */
+  FAR char **ev_envp;          /* NULL terminated name=value strings */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -59,8 +93,9 @@ extern "C"
  * Description:
  *   Copy the internal environment structure of a task.  This is the action
  *   that is performed when a new task is created:
- *   The new task has a private, exact duplicate of the parent task's
- *    environment.
+ *   The new task has an exact duplicate of the parent task's environment.
+ *   The environment of the parent is shared until one of the task groups
+ *   modifies it.
  *
  * Input Parameters:
  *   group - The child task group to receive the newly allocated copy of the
@@ -100,6 +135,105 @@ int env_dup(FAR struct task_group_s *group, FAR char * const *envp);
 
 void env_release(FAR struct task_group_s *group);
 
+/****************************************************************************
+ * Name: env_copy
+ *
+ * Description:
+ *   Create a private environment for the task group from 'envc' name=value
+ *   strings.  Any previous environment of the group is not released.
+ *
+ * Input Parameters:
+ *   group - The task group to receive the environment
+ *   envcp - The name=value strings to copy
+ *   envc  - The number of strings in envcp
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   Not called from an interrupt handler
+ *
+ ****************************************************************************/
+
+int env_copy(FAR struct task_group_s *group, FAR char * const *envcp,
+             size_t envc);
+
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Make sure that the environment of the task group is not shared with
+ *   other task groups before it is modified.  Indexes into the environment
+ *   remain valid.
+ *
+ * Input Parameters:
+ *   group - The task group whose environment will be modified
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Pre-emption is disabled by caller
+ *
+ ****************************************************************************/
+
+int env_unshare(FAR struct task_group_s *group);
+
+/****************************************************************************
+ * Name: env_hashname
+ *
+ * Description:
+ *   Return the hash of a variable name.  The name ends with '\0' or '='.
+ *
+ ****************************************************************************/
+
+uint32_t env_hashname(FAR const char *name);
+
+/****************************************************************************
+ * Name: env_rehash
+ *
+ * Description:
+ *   Reallocate the hash table of an environment so that it can index
+ *   'nvars' variables and index all strings of the environment again.
+ *
+ * Input Parameters:
+ *   group - The task group owning the environment
+ *   env   - The environment to index
+ *   nvars - The number of variables that the hash table must hold
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.  The previous table is kept
+ *   on failure.
+ *
+ ****************************************************************************/
+
+int env_rehash(FAR struct task_group_s *group, FAR struct environ_s *env,
+               size_t nvars);
+
+/****************************************************************************
+ * Name: env_addvar
+ *
+ * Description:
+ *   Add a new name=value string to the (unshared) environment of the task
+ *   group.  The variable must not exist in the environment.
+ *
+ * Input Parameters:
+ *   group - The task group with the environment
+ *   pvar  - The name=value string, allocated with group_malloc().  It
+ *           belongs to the environment on success.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM on failure.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Pre-emption is disabled by caller
+ *
+ ****************************************************************************/
+
+int env_addvar(FAR struct task_group_s *group, FAR char *pvar);
+
 /****************************************************************************
  * Name: env_findvar
  *
@@ -139,7 +273,8 @@ int env_findvar(FAR struct task_group_s *group, FAR const char *pname);
  * Assumptions:
  *   - Not called from an interrupt handler
  *   - Caller has pre-emption disabled
- *   - Caller will reallocate the environment structure to the correct size
+ *   - The environment is not shared (see env_unshare())
+ *   - The last name=value pair is moved to 'index'
  *
  ****************************************************************************/
 
@@ -0,0 +1,448 @@
+/****************************************************************************
+ * sched/init/nx_bootstage.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/init.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/sched_note.h>
+
+#include "sched/sched.h"
+
+#if defined(CONFIG_BOOT_PROFILE) || defined(CONFIG_BOOT_PARALLEL)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_BOOT_PARALLEL
+/* The state of one nx_boot_run(), shared by the caller and its threads */
+
+struct boot_run_s
+{
+  FAR const struct boot_stage_s *stages;
+  uint32_t all;                        /* The bits of all of the stages */
+  uint32_t started;                    /* The stages started or skipped */
+  uint32_t done;                       /* The stages complete or skipped */
+  uint32_t failed;                     /* The stages failed or skipped */
+  int running;                         /* The number of stages running */
+  int nwaiting;                        /* The number of threads waiting */
+  mutex_t lock;                        /* Protects the fields above */
+  sem_t wait;                          /* Posted when a stage completes */
+  sem_t exit;                          /* Posted when a thread exits */
+  int result[BOOT_STAGES_MAX];         /* The results of the stages */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_BOOT_PROFILE
+static struct boot_record_s g_boot_records[CONFIG_BOOT_PROFILE_NRECORDS];
+static int g_boot_nrecords;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BOOT_PROFILE
+/****************************************************************************
+ * Name: nx_boot_time
+ *
+ * Description:
+ *   Return the time since power up in microseconds.  This is zero until
+ *   the system timer runs.
+ *
+ ****************************************************************************/
+
+static uint32_t nx_boot_time(void)
+{
+  struct timespec ts;
+
+  if (clock_systime_timespec(&ts) < 0)
+    {
+      return 0;
+    }
+
+  return (uint32_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+#endif
+
+#ifdef CONFIG_BOOT_PARALLEL
+/****************************************************************************
+ * Name: nx_boot_wakeup
+ *
+ * Description:
+ *   Wake up the threads waiting for a stage to complete.  Called with the
+ *   lock held.
+ *
+ ****************************************************************************/
+
+static void nx_boot_wakeup(FAR struct boot_run_s *run)
+{
+  while (run->nwaiting > 0)
+    {
+      run->nwaiting--;
+      nxsem_post(&run->wait);
+    }
+}
+
+/****************************************************************************
+ * Name: nx_boot_next
+ *
+ * Description:
+ *   Return the index of a stage that can start, or -1 if there is none.
+ *   The stages that depend on a failed one are skipped on the way.  Called
+ *   with the lock held.
+ *
+ ****************************************************************************/
+
+static int nx_boot_next(FAR struct boot_run_s *run, int nstages)
+{
+  uint32_t depends;
+  uint32_t bit;
+  int i;
+
+  for (i = 0; i < nstages; i++)
+    {
+      bit = UINT32_C(1) << i;
+      if ((run->started & bit) != 0)
+        {
+          continue;
+        }
+
+      depends = run->stages[i].depends & run->all & ~bit;
+      if ((depends & run->failed) != 0)
+        {
+          /* Skipping a stage may skip the stages before it that depend on
+           * it, so look from the start again.
+           */
+
+          run->started  |= bit;
+          run->done     |= bit;
+          run->failed   |= bit;
+          run->result[i] = -ECANCELED;
+          i = -1;
+        }
+      else if ((depends & ~run->done) == 0)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: nx_boot_worker
+ *
+ * Description:
+ *   Run the stages that are ready until all of them are started.  This is
+ *   the body of the caller of nx_boot_run() and of its threads.
+ *
+ ****************************************************************************/
+
+static void nx_boot_worker(FAR struct boot_run_s *run, int nstages)
+{
+  FAR const struct boot_stage_s *stage;
+  uint32_t bit;
+  int record;
+  int i;
+
+  nxmutex_lock(&run->lock);
+
+  while (run->started != run->all)
+    {
+      i = nx_boot_next(run, nstages);
+      if (i < 0)
+        {
+          if (run->started == run->all)
+            {
+              break;
+            }
+
+          if (run->running == 0)
+            {
+              /* Nothing is running, that could complete the dependencies
+               * of the stages left: They depend on each other.
+               */
+
+              for (i = 0; i < nstages; i++)
+                {
+                  if ((run->started & (UINT32_C(1) << i)) == 0)
+                    {
+                      serr("ERROR: Boot stage %s: circular dependency\n",
+                           run->stages[i].name);
+                      run->result[i] = -EDEADLK;
+                    }
+                }
+
+              run->started = run->all;
+              run->done    = run->all;
+              run->failed  = run->all;
+              nx_boot_wakeup(run);
+              break;
+            }
+
+          /* Wait for a stage running on another thread */
+
+          run->nwaiting++;
+          nxmutex_unlock(&run->lock);
+          nxsem_wait_uninterruptible(&run->wait);
+          nxmutex_lock(&run->lock);
+          continue;
+        }
+
+      bit            = UINT32_C(1) << i;
+      stage          = &run->stages[i];
+      run->started  |= bit;
+      run->running++;
+      nxmutex_unlock(&run->lock);
+
+      record = nx_boot_begin(stage->name);
+      run->result[i] = stage->init(stage->arg);
+      nx_boot_end(record, run->result[i]);
+      UNUSED(record);
+
+      if (run->result[i] < 0)
+        {
+          serr("ERROR: Boot stage %s failed: %d\n",
+               stage->name, run->result[i]);
+        }
+
+      nxmutex_lock(&run->lock);
+      run->running--;
+      run->done |= bit;
+      if (run->result[i] < 0)
+        {
+          run->failed |= bit;
+        }
+
+      nx_boot_wakeup(run);
+    }
+
+  nxmutex_unlock(&run->lock);
+}
+
+/****************************************************************************
+ * Name: nx_boot_thread
+ ****************************************************************************/
+
+static int nx_boot_thread(int argc, FAR char *argv[])
+{
+  FAR struct boot_run_s *run;
+
+  DEBUGASSERT(argc == 3);
+
+  run = (FAR struct boot_run_s *)((uintptr_t)strtoul(argv[1], NULL, 16));
+  nx_boot_worker(run, atoi(argv[2]));
+
+  nxsem_post(&run->exit);
+  return OK;
+}
+#endif /* CONFIG_BOOT_PARALLEL */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BOOT_PROFILE
+/****************************************************************************
+ * Name: nx_boot_begin
+ ****************************************************************************/
+
+int nx_boot_begin(FAR const char *name)
+{
+  FAR struct boot_record_s *record;
+  irqstate_t flags;
+  int stage = -1;
+
+  DEBUGASSERT(name != NULL);
+
+  sched_note_begin(SCHED_NOTE_IP, name);
+
+  flags = enter_critical_section();
+
+  if (g_boot_nrecords < CONFIG_BOOT_PROFILE_NRECORDS)
+    {
+      stage          = g_boot_nrecords++;
+      record         = &g_boot_records[stage];
+      record->name   = name;
+      record->start  = nx_boot_time();
+      record->end    = record->start;
+      record->result = -EINPROGRESS;
+      record->cpu    = this_cpu();
+    }
+
+  leave_critical_section(flags);
+  return stage;
+}
+
+/****************************************************************************
+ * Name: nx_boot_end
+ ****************************************************************************/
+
+void nx_boot_end(int stage, int result)
+{
+  FAR struct boot_record_s *record;
+
+  if (stage >= 0 && stage < CONFIG_BOOT_PROFILE_NRECORDS)
+    {
+      /* Only the owner of the record writes it */
+
+      record         = &g_boot_records[stage];
+      record->end    = nx_boot_time();
+      record->result = result;
+
+      sched_note_end(SCHED_NOTE_IP, record->name);
+    }
+}
+
+/****************************************************************************
+ * Name: nx_boot_profile
+ ****************************************************************************/
+
+int nx_boot_profile(FAR struct boot_record_s *records, int nrecords)
+{
+  irqstate_t flags;
+  int i;
+
+  DEBUGASSERT(records != NULL || nrecords == 0);
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < nrecords && i < g_boot_nrecords; i++)
+    {
+      records[i] = g_boot_records[i];
+    }
+
+  leave_critical_section(flags);
+  return i;
+}
+#endif /* CONFIG_BOOT_PROFILE */
+
+#ifdef CONFIG_BOOT_PARALLEL
+/****************************************************************************
+ * Name: nx_boot_run
+ ****************************************************************************/
+
+int nx_boot_run(FAR const struct boot_stage_s *stages, int nstages)
+{
+  FAR struct boot_run_s *run;
+  FAR char *argv[3];
+  char arg1[32];
+  char arg2[16];
+  int nthreads = 0;
+  int ret = OK;
+  int i;
+
+  if (stages == NULL || nstages <= 0 || nstages > BOOT_STAGES_MAX)
+    {
+      return -EINVAL;
+    }
+
+  /* The state is too large for the small stacks of the boot threads */
+
+  run = kmm_zalloc(sizeof(struct boot_run_s));
+  if (run == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  run->stages = stages;
+  run->all    = nstages == BOOT_STAGES_MAX ? UINT32_MAX :
+                (UINT32_C(1) << nstages) - 1;
+
+  nxmutex_init(&run->lock);
+  nxsem_init(&run->wait, 0, 0);
+  nxsem_init(&run->exit, 0, 0);
+  nxsem_set_protocol(&run->wait, SEM_PRIO_NONE);
+  nxsem_set_protocol(&run->exit, SEM_PRIO_NONE);
+
+  /* The caller runs stages too, so a single stage needs no thread */
+
+  if (OSINIT_OS_READY())
+    {
+      snprintf(arg1, sizeof(arg1), "%p", run);
+      snprintf(arg2, sizeof(arg2), "%d", nstages);
+      argv[0] = arg1;
+      argv[1] = arg2;
+      argv[2] = NULL;
+
+      while (nthreads < CONFIG_BOOT_PARALLEL_NTHREADS &&
+             nthreads < nstages - 1)
+        {
+          ret = kthread_create("boot", CONFIG_BOOT_PARALLEL_PRIORITY,
+                               CONFIG_BOOT_PARALLEL_STACKSIZE,
+                               nx_boot_thread, argv);
+          if (ret < 0)
+            {
+              swarn("WARNING: Failed to start a boot thread: %d\n", ret);
+              break;
+            }
+
+          nthreads++;
+        }
+    }
+
+  nx_boot_worker(run, nstages);
+
+  while (nthreads-- > 0)
+    {
+      nxsem_wait_uninterruptible(&run->exit);
+    }
+
+  ret = OK;
+  for (i = 0; i < nstages; i++)
+    {
+      if (run->result[i] < 0)
+        {
+          ret = run->result[i];
+          break;
+        }
+    }
+
+  nxsem_destroy(&run->exit);
+  nxsem_destroy(&run->wait);
+  nxmutex_destroy(&run->lock);
+  kmm_free(run);
+  return ret;
+}
+#endif /* CONFIG_BOOT_PARALLEL */
+
+#endif /* CONFIG_BOOT_PROFILE || CONFIG_BOOT_PARALLEL */
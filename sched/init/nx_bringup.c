@@ -243,9 +243,13 @@ static inline void nx_start_application(void)
    * configured.
    */
 
-  board_late_initialize();
+  NX_BOOT_PROFILE("board_late_initialize", board_late_initialize());
 #endif
 
+  /* Mark the time at which the application starts in the boot profile */
+
+  nx_boot_end(nx_boot_begin("init"), OK);
+
 #if defined(CONFIG_INIT_ENTRY)
 
   /* Start the application initialization task.  In a flat build, this is
@@ -79,6 +79,12 @@ void nx_idle_trampoline(void)
 
   for (; ; )
     {
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+      /* Pull a ready-to-run task that could not be started elsewhere */
+
+      nxsched_idle_balance();
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
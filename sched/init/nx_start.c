@@ -517,6 +517,9 @@ void nx_start(void)
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+      FAR struct tls_info_s *info;
+#endif
       int hashndx;
 
       /* Assign the process ID(s) of ZERO to the idle task(s) */
@@ -549,6 +552,13 @@ void nx_start(void)
 
       tls_init_info(&g_idletcb[i].cmn);
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+      /* The PID of the IDLE task is already known, save it in its TLS */
+
+      info = (FAR struct tls_info_s *)g_idletcb[i].cmn.stack_alloc_ptr;
+      info->tl_tid = i;
+#endif
+
       /* Complete initialization of the IDLE group.  Suppress retention
        * of child status in the IDLE group.
        */
@@ -621,11 +631,11 @@ void nx_start(void)
    * that are different for each  processor and hardware platform.
    */
 
-  up_initialize();
+  NX_BOOT_PROFILE("up_initialize", up_initialize());
 
   /* Initialize common drivers */
 
-  drivers_initialize();
+  NX_BOOT_PROFILE("drivers_initialize", drivers_initialize());
 
 #ifdef CONFIG_BOARD_EARLY_INITIALIZE
   /* Call the board-specific up_initialize() extension to support
@@ -633,7 +643,7 @@ void nx_start(void)
    * that cannot wait until board_late_initialize.
    */
 
-  board_early_initialize();
+  NX_BOOT_PROFILE("board_early_initialize", board_early_initialize());
 #endif
 
   /* Hardware resources are now available */
@@ -705,6 +715,12 @@ void nx_start(void)
   sinfo("CPU0: Beginning Idle Loop\n");
   for (; ; )
     {
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+      /* Pull a ready-to-run task that could not be started elsewhere */
+
+      nxsched_idle_balance();
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -67,6 +67,15 @@ struct irq_info_s
   uint32_t lscount;  /* Number of interrupts on this IRQ (LS) */
 #endif
   uint32_t time;     /* Maximum execution time on this IRQ */
+  uint32_t mintime;  /* Minimum execution time on this IRQ */
+#ifdef CONFIG_HAVE_LONG_LONG
+  uint64_t totaltime; /* Sum of the execution times on this IRQ */
+#else
+  uint32_t totaltime; /* Sum of the execution times on this IRQ */
+#endif
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+  cpu_set_t affinity; /* CPUs selected to take this IRQ (0 = default) */
+#endif
 #endif
 };
 
@@ -120,6 +129,12 @@ extern volatile cpu_set_t g_cpu_irqset;
 /* Handles nested calls to enter_critical section from interrupt handlers */
 
 extern volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+/* The contention statistics of g_cpu_irqlock */
+
+extern struct spinlock_stat_s g_cpu_irqstat;
+#endif
 #endif
 
 /****************************************************************************
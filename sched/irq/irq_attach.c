@@ -123,6 +123,9 @@ int irq_attach(int irq, xcpt_t isr, FAR void *arg)
       g_irqvector[ndx].mscount = 0;
       g_irqvector[ndx].lscount = 0;
 #endif
+      g_irqvector[ndx].time      = 0;
+      g_irqvector[ndx].mintime   = 0;
+      g_irqvector[ndx].totaltime = 0;
 #endif
 
       leave_critical_section(flags);
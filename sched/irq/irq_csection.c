@@ -56,6 +56,12 @@ volatile cpu_set_t g_cpu_irqset;
 /* Handles nested calls to enter_critical section from interrupt handlers */
 
 volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+/* The contention statistics of g_cpu_irqlock */
+
+struct spinlock_stat_s g_cpu_irqstat = SPINLOCK_STAT_INITIALIZER("csection");
+#endif
 #endif
 
 /****************************************************************************
@@ -108,6 +114,9 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #ifdef CONFIG_SMP
 static bool irq_waitlock(int cpu)
 {
+#ifdef CONFIG_SPINLOCK_STATISTICS
+  bool contended = false;
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = current_task(cpu);
 
@@ -122,6 +131,10 @@ static bool irq_waitlock(int cpu)
 
   while (spin_trylock_wo_note(&g_cpu_irqlock) == SP_LOCKED)
     {
+#ifdef CONFIG_SPINLOCK_STATISTICS
+      contended = true;
+#endif
+
       /* Is a pause request pending? */
 
       if (up_cpu_pausereq(cpu))
@@ -142,6 +155,14 @@ static bool irq_waitlock(int cpu)
 
   /* We have g_cpu_irqlock! */
 
+#ifdef CONFIG_SPINLOCK_STATISTICS
+  g_cpu_irqstat.nlocks++;
+  if (contended)
+    {
+      g_cpu_irqstat.ncontended++;
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
@@ -553,7 +574,7 @@ void leave_critical_section(irqstate_t flags)
                    */
 
                   if (g_pendingtasks.head != NULL &&
-                      !nxsched_islocked_global())
+                      !nxsched_islocked_tcb(rtcb))
                     {
                       /* Release any ready-to-run tasks that have collected
                        * in g_pendingtasks.  NOTE: This operation has a very
@@ -94,6 +94,12 @@
                { \
                  g_irqvector[ndx].time = delta.tv_nsec; \
                } \
+             if (g_irqvector[ndx].mintime == 0 || \
+                 delta.tv_nsec < g_irqvector[ndx].mintime) \
+               { \
+                 g_irqvector[ndx].mintime = delta.tv_nsec; \
+               } \
+             g_irqvector[ndx].totaltime += delta.tv_nsec; \
            } \
          if (CONFIG_SCHED_CRITMONITOR_MAXTIME_IRQ > 0 && \
              elapsed > CONFIG_SCHED_CRITMONITOR_MAXTIME_IRQ) \
@@ -166,11 +172,23 @@ void irq_dispatch(int irq, FAR void *context)
   sched_note_irqhandler(irq, vector, true);
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* Start measuring the time spent in the interrupt handler */
+
+  nxsched_cpuload_irqenter();
+#endif
+
   /* Then dispatch to the interrupt handler */
 
   CALL_VECTOR(ndx, vector, irq, context, arg);
   UNUSED(ndx);
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* Charge the time spent in the handler to this CPU's interrupt load */
+
+  nxsched_cpuload_irqleave();
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
   /* Notify that we are leaving from the interrupt handler */
 
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 
 #include "irq/irq.h"
 
@@ -81,5 +82,11 @@ void irq_initialize(void)
   irqchain_initialize();
 #endif
 
+#ifdef CONFIG_SPINLOCK_STATISTICS
+  /* Report the contention of the critical section */
+
+  spin_stat_register(&g_cpu_irqstat);
+#endif
+
   up_irqinitialize();
 }
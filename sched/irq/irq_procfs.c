@@ -26,6 +26,7 @@
 
 #include <sys/stat.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
 #include <string.h>
 #include <assert.h>
@@ -47,26 +48,45 @@
 
 /* Output format:
  *
- *            1111111111222222222233333333334444444444
- *   1234567890123456789012345678901234567890123456789
+ *            1111111111222222222233333333334444444444555555555566666666
+ *   1234567890123456789012345678901234567890123456789012345678901234567
  *
- *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME
- *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD
+ *   IRQ HANDLER  ARGUMENT    COUNT    RATE     MIN  AVG  MAX AFFINITY
+ *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD DDDD DDDD XXXXXXXX
+ *
+ * MIN, AVG and MAX are the handler execution times in microseconds.  The
+ * AFFINITY column is only present if the architecture can route IRQs to
+ * CPUs.
  *
  * NOTE:  This assumes that an address can be represented in 32-bits.  In
  * the typical configuration where CONFIG_HAVE_LONG_LONG=y, the COUNT field
  * may not be wide enough.
  */
 
-#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
-#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+#  define HDR_FMT \
+     "IRQ HANDLER  ARGUMENT    COUNT    RATE     MIN  AVG  MAX AFFINITY\n"
+#  define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu %4lu %4lu %08lx\n"
+#else
+#  define HDR_FMT \
+     "IRQ HANDLER  ARGUMENT    COUNT    RATE     MIN  AVG  MAX\n"
+#  define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu %4lu %4lu\n"
+#endif
 
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic (plus a couple of
  * bytes).
  */
 
-#define IRQ_LINELEN 50
+#define IRQ_LINELEN 72
+
+/* The size of the buffer holding one "<irq> <cpuset>" affinity command */
+
+#define IRQ_CMDLEN  32
+
+/* The bit set of all CPUs */
+
+#define IRQ_ALLCPUS ((1ul << CONFIG_SMP_NCPUS) - 1)
 
 /****************************************************************************
  * Private Types
@@ -100,6 +120,10 @@ static int     irq_open(FAR struct file *filep, FAR const char *relpath,
 static int     irq_close(FAR struct file *filep);
 static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+static ssize_t irq_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+#endif
 static int     irq_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     irq_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -118,7 +142,11 @@ const struct procfs_operations irq_operations =
   irq_open,       /* open */
   irq_close,      /* close */
   irq_read,       /* read */
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+  irq_write,      /* write */
+#else
   NULL,           /* write */
+#endif
 
   irq_dup,        /* dup */
 
@@ -151,6 +179,7 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   unsigned long intpart;
   unsigned long fracpart;
   unsigned long count;
+  unsigned long avgtime;
 
   DEBUGASSERT(irqfile != NULL);
 
@@ -166,7 +195,9 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   info->mscount = 0;
   info->lscount = 0;
 #endif
-  info->time    = 0;
+  info->time      = 0;
+  info->mintime   = 0;
+  info->totaltime = 0;
   leave_critical_section(flags);
 
   /* Don't bother if count == 0.
@@ -230,6 +261,8 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
     {
       count = (unsigned long)copy.count;
     }
+
+  avgtime = (unsigned long)(copy.totaltime / copy.count);
 #else
 #  error Missing logic
 #endif
@@ -241,7 +274,13 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
                       (unsigned long)((uintptr_t)copy.handler),
                       (unsigned long)((uintptr_t)copy.arg),
                       count, intpart, fracpart,
-                      (unsigned long)copy.time / 1000);
+                      (unsigned long)copy.mintime / 1000,
+                      avgtime / 1000,
+                      (unsigned long)copy.time / 1000
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+                      , (unsigned long)copy.affinity
+#endif
+                      );
 
   copysize  = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                             irqfile->remaining, &irqfile->offset);
@@ -275,6 +314,7 @@ static int irq_open(FAR struct file *filep, FAR const char *relpath,
 
   finfo("Open '%s'\n", relpath);
 
+#ifndef CONFIG_ARCH_HAVE_IRQAFFINITY
   /* This PROCFS file is read-only.  Any attempt to open with write access
    * is not permitted.
    */
@@ -284,6 +324,7 @@ static int irq_open(FAR struct file *filep, FAR const char *relpath,
       ferr("ERROR: Only O_RDONLY supported\n");
       return -EACCES;
     }
+#endif
 
   /* Allocate a container to hold the file attributes */
 
@@ -367,6 +408,70 @@ static ssize_t irq_read(FAR struct file *filep, FAR char *buffer,
   return irqfile->ncopied;
 }
 
+/****************************************************************************
+ * Name: irq_write
+ *
+ * Description:
+ *   Route an IRQ to a set of CPUs.  The command has the form
+ *   "<irq> <cpuset>" where <cpuset> is a bit set of CPUs, for example
+ *   "35 0x2" routes IRQ 35 to CPU 1.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+static ssize_t irq_write(FAR struct file *filep, FAR const char *buffer,
+                         size_t buflen)
+{
+  char cmd[IRQ_CMDLEN];
+  FAR char *endptr;
+  unsigned long irq;
+  unsigned long cpuset;
+  irqstate_t flags;
+  int ndx;
+  int ret;
+
+  if (buflen >= IRQ_CMDLEN)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(cmd, buffer, buflen);
+  cmd[buflen] = '\0';
+
+  irq    = strtoul(cmd, &endptr, 10);
+  if (endptr == cmd || irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+  cpuset = strtoul(endptr, &endptr, 0);
+  if (cpuset == 0 || (cpuset & ~IRQ_ALLCPUS) != 0)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_ARCH_MINIMAL_VECTORTABLE
+  ndx = g_irqmap[irq];
+  if ((unsigned)ndx >= CONFIG_ARCH_NUSER_INTERRUPTS)
+    {
+      return -EINVAL;
+    }
+#else
+  ndx = irq;
+#endif
+
+  flags = enter_critical_section();
+  ret   = up_affinity_irq(irq, (cpu_set_t)cpuset);
+  if (ret >= 0)
+    {
+      g_irqvector[ndx].affinity = (cpu_set_t)cpuset;
+    }
+
+  leave_critical_section(flags);
+  return ret < 0 ? ret : buflen;
+}
+#endif
+
 /****************************************************************************
  * Name: irq_dup
  *
@@ -415,10 +520,15 @@ static int irq_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 static int irq_stat(const char *relpath, struct stat *buf)
 {
-  /* "irqs" is the name for a read-only file */
+  /* "irqs" is the name for a read-only file, unless the IRQ affinity can
+   * be written.
+   */
 
   memset(buf, 0, sizeof(struct stat));
   buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+#ifdef CONFIG_ARCH_HAVE_IRQAFFINITY
+  buf->st_mode |= S_IWUSR;
+#endif
   return OK;
 }
 
@@ -45,6 +45,13 @@ static volatile spinlock_t g_irq_spin = SP_UNLOCKED;
 
 static volatile uint8_t g_irq_spin_count[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SPINLOCK_STATISTICS
+/* The list of the registered named locks and its protection */
+
+static FAR struct spinlock_stat_s *g_spin_stats;
+static spinlock_t g_spin_statlock;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -157,4 +164,75 @@ void spin_unlock_irqrestore(spinlock_t *lock, irqstate_t flags)
   up_irq_restore(flags);
 }
 
+#ifdef CONFIG_SPINLOCK_STATISTICS
+
+/****************************************************************************
+ * Name: spin_lock_irqsave_stat
+ *
+ * Description:
+ *   The same as spin_lock_irqsave(), but the acquisition of the lock is
+ *   accounted in 'stat'.  The counters are updated while the lock is held.
+ *
+ * Input Parameters:
+ *   lock - Caller specific spinlock, not NULL.
+ *   stat - The statistics of the lock.
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_stat(lock);
+ *
+ ****************************************************************************/
+
+irqstate_t spin_lock_irqsave_stat(FAR spinlock_t *lock,
+                                  FAR struct spinlock_stat_s *stat)
+{
+  irqstate_t ret;
+
+  DEBUGASSERT(lock != NULL && stat != NULL);
+
+  ret = up_irq_save();
+
+  if (spin_trylock(lock) == SP_LOCKED)
+    {
+      spin_lock(lock);
+      stat->ncontended++;
+    }
+
+  stat->nlocks++;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spin_stat_register
+ *
+ * Description:
+ *   Make the statistics of a named lock visible in the procfs file
+ *   "locks".  The statistics must stay valid forever.
+ *
+ ****************************************************************************/
+
+void spin_stat_register(FAR struct spinlock_stat_s *stat)
+{
+  irqstate_t flags;
+
+  flags        = spin_lock_irqsave(&g_spin_statlock);
+  stat->flink  = g_spin_stats;
+  g_spin_stats = stat;
+  spin_unlock_irqrestore(&g_spin_statlock, flags);
+}
+
+/****************************************************************************
+ * Name: spin_stat_first
+ *
+ * Description:
+ *   Return the first registered lock, the others follow through 'flink'.
+ *
+ ****************************************************************************/
+
+FAR struct spinlock_stat_s *spin_stat_first(void)
+{
+  return g_spin_stats;
+}
+
+#endif /* CONFIG_SPINLOCK_STATISTICS */
 #endif /* CONFIG_SMP */
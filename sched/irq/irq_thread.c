@@ -0,0 +1,242 @@
+/****************************************************************************
+ * sched/irq/irq_thread.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+
+#include "irq/irq.h"
+
+#if defined(CONFIG_IRQ_THREAD) && NR_IRQS > 0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure pairs the top half of a threaded interrupt handler with
+ * the kernel thread that runs its bottom half.
+ */
+
+struct irq_thread_s
+{
+  xcpt_t isr;        /* Top half, runs in interrupt context (may be NULL) */
+  xcpt_t isrthread;  /* Bottom half, runs on the IRQ thread */
+  FAR void *arg;     /* The argument provided to both handlers */
+  sem_t sem;         /* Posted by the top half to wake the IRQ thread */
+  pid_t pid;         /* The PID of the IRQ thread */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The threaded handler attached to each IRQ, if any */
+
+static FAR struct irq_thread_s *g_irqthread[NR_IRQS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_thread_isr
+ *
+ * Description:
+ *   The interrupt handler attached to a threaded IRQ.  Runs the top half,
+ *   then wakes the IRQ thread if the top half asks for it.
+ *
+ ****************************************************************************/
+
+static int irq_thread_isr(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct irq_thread_s *info = (FAR struct irq_thread_s *)arg;
+  int ret = IRQ_WAKE_THREAD;
+
+  if (info->isr != NULL)
+    {
+      ret = info->isr(irq, context, info->arg);
+    }
+
+  if (ret == IRQ_WAKE_THREAD)
+    {
+      nxsem_post(&info->sem);
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: irq_thread_main
+ *
+ * Description:
+ *   The body of an IRQ thread.  argv[1] holds the IRQ number.
+ *
+ ****************************************************************************/
+
+static int irq_thread_main(int argc, FAR char *argv[])
+{
+  FAR struct irq_thread_s *info;
+  int irq;
+
+  DEBUGASSERT(argc == 2);
+  irq  = atoi(argv[1]);
+  info = g_irqthread[irq];
+  DEBUGASSERT(info != NULL);
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&info->sem);
+      info->isrthread(irq, NULL, info->arg);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Configure the IRQ subsystem so that IRQ number 'irq' is dispatched to
+ *   the top half 'isr' in interrupt context and to the bottom half
+ *   'isrthread' on a dedicated kernel thread.  See include/nuttx/irq.h.
+ *
+ ****************************************************************************/
+
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size, cpu_set_t affinity)
+{
+  FAR struct irq_thread_s *info;
+  FAR char *argv[2];
+  char arg1[12];
+  char name[16];
+  pid_t pid;
+  int ret;
+
+  if ((unsigned)irq >= NR_IRQS)
+    {
+      return -EINVAL;
+    }
+
+  /* Detach the top half and delete any IRQ thread of this IRQ first */
+
+  info = g_irqthread[irq];
+  if (info != NULL)
+    {
+      irq_detach(irq);
+      kthread_delete(info->pid);
+      nxsem_destroy(&info->sem);
+
+      g_irqthread[irq] = NULL;
+      kmm_free(info);
+    }
+
+  if (isrthread == NULL)
+    {
+      return OK;
+    }
+
+  info = (FAR struct irq_thread_s *)kmm_zalloc(sizeof(struct irq_thread_s));
+  if (info == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  info->isr       = isr;
+  info->isrthread = isrthread;
+  info->arg       = arg;
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&info->sem, 0, 0);
+  nxsem_set_protocol(&info->sem, SEM_PRIO_NONE);
+
+  g_irqthread[irq] = info;
+
+  snprintf(arg1, sizeof(arg1), "%d", irq);
+  snprintf(name, sizeof(name), "irq%d", irq);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  pid = kthread_create(name, priority, stack_size, irq_thread_main, argv);
+  if (pid < 0)
+    {
+      ret = pid;
+      goto errout_with_info;
+    }
+
+  info->pid = pid;
+
+#ifdef CONFIG_SMP
+  if (affinity != 0)
+    {
+      ret = nxsched_set_affinity(pid, sizeof(cpu_set_t), &affinity);
+      if (ret < 0)
+        {
+          goto errout_with_thread;
+        }
+    }
+#else
+  UNUSED(affinity);
+#endif
+
+  /* Only now attach the top half.  Wake-ups that occur before the thread
+   * first waits are counted by the semaphore.
+   */
+
+  ret = irq_attach(irq, irq_thread_isr, info);
+  if (ret < 0)
+    {
+      goto errout_with_thread;
+    }
+
+  return OK;
+
+errout_with_thread:
+  kthread_delete(pid);
+
+errout_with_info:
+  g_irqthread[irq] = NULL;
+  nxsem_destroy(&info->sem);
+  kmm_free(info);
+  return ret;
+}
+
+#endif /* CONFIG_IRQ_THREAD && NR_IRQS > 0 */
@@ -77,6 +77,13 @@ int file_mq_getattr(FAR struct file *mq, FAR struct mq_attr *mq_stat)
   mq_stat->mq_flags   = mq->f_oflags;
   mq_stat->mq_curmsgs = msgq->nmsgs;
 
+#ifdef CONFIG_MQUEUE_RING
+  if (msgq->ring != NULL)
+    {
+      mq_stat->mq_flags |= MQ_RING;
+    }
+#endif
+
   return 0;
 }
 
@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 
 #include "mqueue/mqueue.h"
 
@@ -46,6 +47,14 @@ struct list_node g_msgfree = LIST_INITIAL_VALUE(g_msgfree);
 
 struct list_node g_msgfreeirq = LIST_INITIAL_VALUE(g_msgfreeirq);
 
+/* g_msgfreelock protects both lists of free messages */
+
+spinlock_t g_msgfreelock;
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+struct spinlock_stat_s g_msgfreestat = SPINLOCK_STAT_INITIALIZER("mqueue");
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -119,4 +128,8 @@ void nxmq_initialize(void)
 
   mq_msgblockalloc(&g_msgfreeirq, CONFIG_PREALLOC_MQ_IRQ_MSGS,
                    MQ_ALLOC_IRQ);
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+  spin_stat_register(&g_msgfreestat);
+#endif
 }
@@ -29,6 +29,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
 
 #include "mqueue/mqueue.h"
 
@@ -54,6 +55,8 @@
 
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
 {
+  irqstate_t flags;
+
   /* If this is a generally available pre-allocated message,
    * then just put it back in the free list.
    */
@@ -61,10 +64,12 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
   if (mqmsg->type == MQ_ALLOC_FIXED)
     {
       /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
+       * list from interrupt handlers and other CPUs.
        */
 
+      flags = spin_lock_irqsave_stat(&g_msgfreelock, &g_msgfreestat);
       list_add_tail(&g_msgfree, &mqmsg->node);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -74,10 +79,12 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
   else if (mqmsg->type == MQ_ALLOC_IRQ)
     {
       /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
+       * list from interrupt handlers and other CPUs.
        */
 
+      flags = spin_lock_irqsave_stat(&g_msgfreelock, &g_msgfreestat);
       list_add_tail(&g_msgfreeirq, &mqmsg->node);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
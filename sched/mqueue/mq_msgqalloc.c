@@ -66,6 +66,7 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
                     FAR struct mqueue_inode_s **pmsgq)
 {
   FAR struct mqueue_inode_s *msgq;
+  size_t ringsize = 0;
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
@@ -77,10 +78,28 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       return -EINVAL;
     }
 
-  /* Allocate memory for the new message queue. */
+  /* A ring message queue needs a fixed number of slots */
+
+  if (attr && (attr->mq_flags & MQ_RING) != 0)
+    {
+#ifdef CONFIG_MQUEUE_RING
+      if (attr->mq_maxmsg == 0 || attr->mq_maxmsg > INT16_MAX)
+        {
+          return -EINVAL;
+        }
+
+      ringsize = nxmq_ring_size(attr);
+#else
+      return -ENOSYS;
+#endif
+    }
+
+  /* Allocate memory for the new message queue, followed by the slots of a
+   * ring message queue.
+   */
 
   msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+    kmm_zalloc(sizeof(struct mqueue_inode_s) + ringsize);
 
   if (msgq)
     {
@@ -98,6 +117,13 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
           msgq->maxmsgsize = MQ_MAX_BYTES;
         }
 
+#ifdef CONFIG_MQUEUE_RING
+      if (ringsize > 0)
+        {
+          nxmq_ring_initialize(msgq, msgq + 1);
+        }
+#endif
+
 #ifndef CONFIG_DISABLE_MQUEUE_NOTIFICATION
       msgq->ntpid = INVALID_PROCESS_ID;
 #endif
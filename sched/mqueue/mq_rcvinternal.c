@@ -155,8 +155,7 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 
   /* Get the message from the head of the queue */
 
-  while ((newmsg = (FAR struct mqueue_msg_s *)
-                   list_remove_head(&msgq->msglist)) == NULL)
+  while ((newmsg = nxmq_remove_msg(msgq)) == NULL)
     {
       /* The queue is empty!  Should we block until there the above condition
        * has been satisfied?
@@ -210,7 +209,10 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 
   if (newmsg)
     {
-      if (msgq->nmsgs-- == msgq->maxmsgs)
+      bool full = nxmq_isfull(msgq);
+
+      msgq->nmsgs--;
+      if (full && !nxmq_isfull(msgq))
         {
           nxmq_pollnotify(msgq, POLLOUT);
         }
@@ -273,7 +275,14 @@ ssize_t nxmq_do_receive(FAR struct mqueue_inode_s *msgq,
 
   /* We are done with the message.  Deallocate it now. */
 
-  nxmq_free_msg(mqmsg);
+  if (nxmq_isring(msgq))
+    {
+      nxmq_ring_free(msgq, mqmsg);
+    }
+  else
+    {
+      nxmq_free_msg(mqmsg);
+    }
 
   /* Check if any tasks are waiting for the MQ not full event. */
 
@@ -0,0 +1,388 @@
+/****************************************************************************
+ * sched/mqueue/mq_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQUEUE_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size of the slot holding a message of 'n' bytes */
+
+#define MQ_RING_SLOTSIZE(n) \
+  (((offsetof(struct mqueue_msg_s, mail) + (n)) + sizeof(uintptr_t) - 1) & \
+   ~(sizeof(uintptr_t) - 1))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_ring_size
+ *
+ * Description:
+ *   Return the size of the memory to allocate after struct mqueue_inode_s
+ *   for a ring message queue with the attributes 'attr'.
+ *
+ ****************************************************************************/
+
+size_t nxmq_ring_size(FAR const struct mq_attr *attr)
+{
+  return sizeof(struct mqueue_ring_s) +
+         attr->mq_maxmsg * MQ_RING_SLOTSIZE(attr->mq_msgsize);
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_initialize
+ *
+ * Description:
+ *   Set up the slots of a new ring message queue in the memory 'mem' of
+ *   the size returned by nxmq_ring_size().  maxmsgs and maxmsgsize must be
+ *   set already.
+ *
+ ****************************************************************************/
+
+void nxmq_ring_initialize(FAR struct mqueue_inode_s *msgq, FAR void *mem)
+{
+  FAR struct mqueue_ring_s *ring = mem;
+  FAR struct mqueue_msg_s *mqmsg;
+  int i;
+
+  ring->slotsize = MQ_RING_SLOTSIZE(msgq->maxmsgsize);
+  ring->slots    = (FAR char *)(ring + 1);
+
+  list_initialize(&ring->freelist);
+  for (i = 0; i < CONFIG_MQUEUE_RING_NLANES; i++)
+    {
+      list_initialize(&ring->lane[i]);
+    }
+
+  for (i = 0; i < msgq->maxmsgs; i++)
+    {
+      mqmsg       = (FAR struct mqueue_msg_s *)
+                    (ring->slots + i * ring->slotsize);
+      mqmsg->type = MQ_ALLOC_RING;
+      list_add_tail(&ring->freelist, &mqmsg->node);
+    }
+
+  msgq->ring = ring;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_alloc
+ *
+ * Description:
+ *   Take a free slot of a ring message queue.
+ *
+ * Returned Value:
+ *   The slot or NULL if all slots are in use.
+ *
+ * Assumptions:
+ *   Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_ring_alloc(FAR struct mqueue_inode_s *msgq)
+{
+  return (FAR struct mqueue_msg_s *)list_remove_head(&msgq->ring->freelist);
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_free
+ *
+ * Description:
+ *   Return a slot to the free slots of its ring message queue.
+ *
+ * Assumptions:
+ *   Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+void nxmq_ring_free(FAR struct mqueue_inode_s *msgq,
+                    FAR struct mqueue_msg_s *mqmsg)
+{
+  DEBUGASSERT(mqmsg->type == MQ_ALLOC_RING);
+  list_add_head(&msgq->ring->freelist, &mqmsg->node);
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_add
+ *
+ * Description:
+ *   Queue a message at the end of the lane of its priority.
+ *
+ * Assumptions:
+ *   Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+void nxmq_ring_add(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
+{
+  FAR struct mqueue_ring_s *ring = msgq->ring;
+
+  DEBUGASSERT(mqmsg->priority < CONFIG_MQUEUE_RING_NLANES);
+
+  list_add_tail(&ring->lane[mqmsg->priority], &mqmsg->node);
+  ring->lanemap |= (uint32_t)1 << mqmsg->priority;
+}
+
+/****************************************************************************
+ * Name: nxmq_ring_remove
+ *
+ * Description:
+ *   Remove the oldest message of the highest priority lane that is not
+ *   empty.
+ *
+ * Returned Value:
+ *   The message or NULL if the message queue is empty.
+ *
+ * Assumptions:
+ *   Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_ring_remove(FAR struct mqueue_inode_s *msgq)
+{
+  FAR struct mqueue_ring_s *ring = msgq->ring;
+  FAR struct list_node *lane;
+  FAR struct list_node *node;
+  int prio;
+
+  if (ring->lanemap == 0)
+    {
+      return NULL;
+    }
+
+  /* lanemap is a uint32_t, so lane 31 is still positive as long long */
+
+  prio = flsll((long long)ring->lanemap) - 1;
+  lane = &ring->lane[prio];
+  node = list_remove_head(lane);
+
+  if (list_is_empty(lane))
+    {
+      ring->lanemap &= ~((uint32_t)1 << prio);
+    }
+
+  return (FAR struct mqueue_msg_s *)node;
+}
+
+/****************************************************************************
+ * Name: file_mq_borrow
+ *
+ * Description:
+ *   Reserve a free slot of a ring message queue and return its payload
+ *   buffer.  See include/nuttx/mqueue.h.
+ *
+ ****************************************************************************/
+
+int file_mq_borrow(FAR struct file *mq, FAR void **buffer)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret = OK;
+
+  if (mq->f_inode == NULL)
+    {
+      return -EBADF;
+    }
+
+  msgq = mq->f_inode->i_private;
+  if (msgq == NULL || !nxmq_isring(msgq) || buffer == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if ((mq->f_oflags & O_WROK) == 0)
+    {
+      return -EPERM;
+    }
+
+  flags = enter_critical_section();
+
+  if (nxmq_isfull(msgq))
+    {
+      if (up_interrupt_context())
+        {
+          ret = -EAGAIN;
+        }
+      else
+        {
+          ret = nxmq_wait_send(msgq, mq->f_oflags);
+        }
+    }
+
+  if (ret == OK)
+    {
+      mqmsg = nxmq_ring_alloc(msgq);
+      if (mqmsg != NULL)
+        {
+          msgq->nborrowed++;
+          mqmsg->type = MQ_ALLOC_BORROWED;
+          *buffer     = mqmsg->mail;
+        }
+      else
+        {
+          ret = -EAGAIN;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_mq_publish
+ *
+ * Description:
+ *   Queue the message built in a borrowed slot.  See include/nuttx/mqueue.h.
+ *
+ ****************************************************************************/
+
+int file_mq_publish(FAR struct file *mq, FAR void *buffer, size_t msglen,
+                    unsigned int prio)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_ring_s *ring;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  uintptr_t offset;
+  int ret;
+
+  if (mq->f_inode == NULL)
+    {
+      return -EBADF;
+    }
+
+  msgq = mq->f_inode->i_private;
+  if (msgq == NULL || !nxmq_isring(msgq) ||
+      prio >= CONFIG_MQUEUE_RING_NLANES)
+    {
+      return -EINVAL;
+    }
+
+  if (msglen > (size_t)msgq->maxmsgsize)
+    {
+      return -EMSGSIZE;
+    }
+
+  /* The buffer must be the payload of one of the slots */
+
+  ring   = msgq->ring;
+  mqmsg  = (FAR struct mqueue_msg_s *)
+           ((FAR char *)buffer - offsetof(struct mqueue_msg_s, mail));
+  offset = (uintptr_t)mqmsg - (uintptr_t)ring->slots;
+
+  if ((uintptr_t)mqmsg < (uintptr_t)ring->slots ||
+      offset >= msgq->maxmsgs * ring->slotsize ||
+      offset % ring->slotsize != 0)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  /* A slot is published once per file_mq_borrow() */
+
+  if (mqmsg->type != MQ_ALLOC_BORROWED)
+    {
+      leave_critical_section(flags);
+      return -EINVAL;
+    }
+
+  DEBUGASSERT(msgq->nborrowed > 0);
+  msgq->nborrowed--;
+  mqmsg->type = MQ_ALLOC_RING;
+
+  ret = nxmq_do_send(msgq, mqmsg, buffer, msglen, prio);
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxmq_borrow
+ *
+ * Description:
+ *   The same as file_mq_borrow(), but takes a message queue descriptor.
+ *
+ ****************************************************************************/
+
+int nxmq_borrow(mqd_t mqdes, FAR void **buffer)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_borrow(filep, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_publish
+ *
+ * Description:
+ *   The same as file_mq_publish(), but takes a message queue descriptor.
+ *
+ ****************************************************************************/
+
+int nxmq_publish(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                 unsigned int prio)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_publish(filep, buffer, msglen, prio);
+}
+
+#endif /* CONFIG_MQUEUE_RING */
@@ -87,7 +87,31 @@ int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
 
   msgq = mq->f_inode->i_private;
 
-  /* Allocate a message structure:
+#ifdef CONFIG_MQUEUE_RING
+  /* Ring message queues have one lane per priority */
+
+  if (nxmq_isring(msgq) && prio >= CONFIG_MQUEUE_RING_NLANES)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  /* Allocate a message structure.  The free message lists have their own
+   * lock, this needs not be done in the critical section.  The slots of a
+   * ring message queue are taken below, once there is room in the queue.
+   */
+
+  mqmsg = NULL;
+  if (!nxmq_isring(msgq))
+    {
+      mqmsg = nxmq_alloc_msg();
+      if (mqmsg == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  /* Send the message:
    * - Immediately if we are called from an interrupt handler.
    * - Immediately if the message queue is not full, or
    * - After successfully waiting for the message queue to become
@@ -100,7 +124,7 @@ int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
     {
       /* No.. Not in an interrupt handler.  Is the message queue FULL? */
 
-      if (msgq->nmsgs >= msgq->maxmsgs)
+      if (nxmq_isfull(msgq))
         {
           /* Yes.. the message queue is full.  Wait for space to become
            * available in the message queue.
@@ -112,16 +136,22 @@ int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
 
   /* ret can only be negative if nxmq_wait_send failed */
 
-  if (ret == OK)
+  if (ret == OK && mqmsg == NULL)
     {
-      /* Now allocate the message. */
-
-      mqmsg = nxmq_alloc_msg();
+      /* There is no free slot if an interrupt handler sends to a full ring
+       * message queue.
+       */
 
-      /* Check if the message was successfully allocated */
+      mqmsg = nxmq_ring_alloc(msgq);
+      if (mqmsg == NULL)
+        {
+          ret = -EAGAIN;
+        }
+    }
 
-      /* The allocation was successful (implying that we can also send the
-       * message). Perform the message send.
+  if (ret == OK)
+    {
+      /* Perform the message send.
        *
        * NOTE: There is a race condition here: What if a message is added by
        * interrupt related logic so that queue again becomes non-empty.
@@ -129,12 +159,16 @@ int file_mq_send(FAR struct file *mq, FAR const char *msg, size_t msglen,
        * to be exceeded in that case.
        */
 
-      ret = (mqmsg == NULL) ? -ENOMEM :
-            nxmq_do_send(msgq, mqmsg, msg, msglen, prio);
+      ret = nxmq_do_send(msgq, mqmsg, msg, msglen, prio);
     }
 
   leave_critical_section(flags);
 
+  if (ret < 0 && mqmsg != NULL)
+    {
+      nxmq_free_msg(mqmsg);
+    }
+
   return ret;
 }
 
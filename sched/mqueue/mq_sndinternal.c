@@ -137,45 +137,40 @@ int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
 FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 {
   FAR struct list_node *mqmsg;
+  irqstate_t flags;
 
-  /* Try to get the message from the generally available free list. */
+  /* Try to get the message from the generally available free list.  If we
+   * were called from an interrupt handler and this fails, then try the
+   * list of messages reserved for interrupt handlers.
+   */
 
+  flags = spin_lock_irqsave_stat(&g_msgfreelock, &g_msgfreestat);
   mqmsg = list_remove_head(&g_msgfree);
-  if (mqmsg == NULL)
+  if (mqmsg == NULL && up_interrupt_context())
     {
-      /* If we were called from an interrupt handler, then try to get the
-       * message from generally available list of messages. If this fails,
-       * then try the list of messages reserved for interrupt handlers
-       */
+      mqmsg = list_remove_head(&g_msgfreeirq);
+    }
 
-      if (up_interrupt_context())
-        {
-          /* Try the free list reserved for interrupt handlers */
+  spin_unlock_irqrestore(&g_msgfreelock, flags);
 
-          mqmsg = list_remove_head(&g_msgfreeirq);
-        }
+  /* If we were not called from an interrupt handler and there is no free
+   * message, then we will have to allocate one.
+   */
 
-      /* We were not called from an interrupt handler. */
+  if (mqmsg == NULL && !up_interrupt_context())
+    {
+      mqmsg = (FAR struct list_node *)
+        kmm_malloc((sizeof (struct mqueue_msg_s)));
 
-      else
+      /* Check if we allocated the message */
+
+      if (mqmsg != NULL)
         {
-          /* If we cannot a message from the free list, then we will have to
-           * allocate one.
+          /* Yes... remember that this message was dynamically
+           * allocated.
            */
 
-          mqmsg = (FAR struct list_node *)
-            kmm_malloc((sizeof (struct mqueue_msg_s)));
-
-          /* Check if we allocated the message */
-
-          if (mqmsg != NULL)
-            {
-              /* Yes... remember that this message was dynamically
-               * allocated.
-               */
-
-              ((FAR struct mqueue_msg_s *)mqmsg)->type = MQ_ALLOC_DYN;
-            }
+          ((FAR struct mqueue_msg_s *)mqmsg)->type = MQ_ALLOC_DYN;
         }
     }
 
@@ -235,7 +230,7 @@ int nxmq_wait_send(FAR struct mqueue_inode_s *msgq, int oflags)
    * receiving message queue
    */
 
-  while (msgq->nmsgs >= msgq->maxmsgs)
+  while (nxmq_isfull(msgq))
     {
       /* Should we block until there is sufficient space in the
        * message queue?
@@ -318,36 +313,50 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
   mqmsg->priority = prio;
   mqmsg->msglen   = msglen;
 
-  /* Copy the message data into the message */
-
-  memcpy((FAR void *)mqmsg->mail, (FAR const void *)msg, msglen);
-
-  /* Insert the new message in the message queue
-   * Search the message list to find the location to insert the new
-   * message. Each is list is maintained in ascending priority order.
+  /* Copy the message data into the message, unless it was built in place
+   * in a borrowed slot.
    */
 
-  list_for_every_entry(&msgq->msglist, next, struct mqueue_msg_s, node)
+  if (msg != mqmsg->mail)
     {
-      if (prio > next->priority)
-        {
-          break;
-        }
-      else
-        {
-          prev = next;
-        }
+      memcpy((FAR void *)mqmsg->mail, (FAR const void *)msg, msglen);
     }
 
-  /* Add the message at the right place */
-
-  if (prev)
+  if (nxmq_isring(msgq))
     {
-      list_add_after(&prev->node, &mqmsg->node);
+      /* Ring message queues have one FIFO lane per priority */
+
+      nxmq_ring_add(msgq, mqmsg);
     }
   else
     {
-      list_add_head(&msgq->msglist, &mqmsg->node);
+      /* Insert the new message in the message queue
+       * Search the message list to find the location to insert the new
+       * message. Each is list is maintained in ascending priority order.
+       */
+
+      list_for_every_entry(&msgq->msglist, next, struct mqueue_msg_s, node)
+        {
+          if (prio > next->priority)
+            {
+              break;
+            }
+          else
+            {
+              prev = next;
+            }
+        }
+
+      /* Add the message at the right place */
+
+      if (prev)
+        {
+          list_add_after(&prev->node, &mqmsg->node);
+        }
+      else
+        {
+          list_add_head(&msgq->msglist, &mqmsg->node);
+        }
     }
 
   /* Increment the count of messages in the queue */
@@ -173,7 +173,7 @@ ssize_t file_mq_timedreceive(FAR struct file *mq, FAR char *msg,
    * will not need to start timer.
    */
 
-  if (list_is_empty(&msgq->msglist))
+  if (msgq->nmsgs == 0)
     {
       sclock_t ticks;
 
@@ -165,23 +165,38 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
 
   msgq = mq->f_inode->i_private;
 
-  /* Disable interruption */
+#ifdef CONFIG_MQUEUE_RING
+  /* Ring message queues have one lane per priority */
 
-  flags = enter_critical_section();
+  if (nxmq_isring(msgq) && prio >= CONFIG_MQUEUE_RING_NLANES)
+    {
+      return -EINVAL;
+    }
+#endif
 
-  /* Pre-allocate a message structure */
+  /* Pre-allocate a message structure.  The free message lists have their
+   * own lock, this needs not be done in the critical section.  The slots of
+   * a ring message queue are taken once there is room in the queue.
+   */
 
-  mqmsg = nxmq_alloc_msg();
-  if (mqmsg == NULL)
+  mqmsg = NULL;
+  if (!nxmq_isring(msgq))
     {
-      /* Failed to allocate the message. nxmq_alloc_msg() does not set the
-       * errno value.
-       */
-
-      ret = -ENOMEM;
-      goto errout_in_critical_section;
+      mqmsg = nxmq_alloc_msg();
+      if (mqmsg == NULL)
+        {
+          /* Failed to allocate the message. nxmq_alloc_msg() does not set
+           * the errno value.
+           */
+
+          return -ENOMEM;
+        }
     }
 
+  /* Disable interruption */
+
+  flags = enter_critical_section();
+
   /* OpenGroup.org: "Under no circumstance shall the operation fail with a
    * timeout if there is sufficient room in the queue to add the message
    * immediately. The validity of the abstime parameter need not be checked
@@ -196,7 +211,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
    * exceeded in that case.
    */
 
-  if (msgq->nmsgs < msgq->maxmsgs || up_interrupt_context())
+  if (!nxmq_isfull(msgq) || up_interrupt_context())
     {
       /* Do the send with no further checks (possibly exceeding maxmsgs)
        * Currently nxmq_do_send() always returns OK.
@@ -212,8 +227,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
   if (!abstime || abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
     {
       ret = -EINVAL;
-      nxmq_free_msg(mqmsg);
-      goto errout_in_critical_section;
+      goto errout_with_msg;
     }
 
   /* We are not in an interrupt handler and the message queue is full.
@@ -239,7 +253,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
   if (ret != OK)
     {
       ret = -ret;
-      goto errout_in_critical_section;
+      goto errout_with_msg;
     }
 
   /* Start the watchdog and begin the wait for MQ not full */
@@ -268,7 +282,24 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
        */
 
 out_send_message:
+      if (mqmsg == NULL)
+        {
+          mqmsg = nxmq_ring_alloc(msgq);
+          if (mqmsg == NULL)
+            {
+              ret = -EAGAIN;
+              goto errout_in_critical_section;
+            }
+        }
+
       ret = nxmq_do_send(msgq, mqmsg, msg, msglen, prio);
+      goto errout_in_critical_section;
+    }
+
+errout_with_msg:
+  if (mqmsg != NULL)
+    {
+      nxmq_free_msg(mqmsg);
     }
 
   /* Exit here with (1) the scheduler locked, (2) a message allocated, (3) a
@@ -36,6 +36,7 @@
 #include <sched.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/spinlock.h>
 
 #if defined(CONFIG_MQ_MAXMSGSIZE) && CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -47,6 +48,28 @@
 #define MQ_MAX_MSGS    16
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
+/* Ring message queues keep their messages in preallocated slots */
+
+#ifdef CONFIG_MQUEUE_RING
+#  define nxmq_isring(msgq)            ((msgq)->ring != NULL)
+#else
+#  define nxmq_isring(msgq)            false
+#  define nxmq_ring_alloc(msgq)        NULL
+#  define nxmq_ring_free(msgq, mqmsg)
+#  define nxmq_ring_add(msgq, mqmsg)
+#endif
+
+/* Remove the oldest of the highest priority messages from a queue */
+
+#ifdef CONFIG_MQUEUE_RING
+#  define nxmq_remove_msg(msgq) \
+     (nxmq_isring(msgq) ? nxmq_ring_remove(msgq) : \
+      (FAR struct mqueue_msg_s *)list_remove_head(&(msgq)->msglist))
+#else
+#  define nxmq_remove_msg(msgq) \
+     ((FAR struct mqueue_msg_s *)list_remove_head(&(msgq)->msglist))
+#endif
+
 /********************************************************************************
  * Public Type Definitions
  ********************************************************************************/
@@ -55,7 +78,9 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_RING,       /* Slot of a ring message queue */
+  MQ_ALLOC_BORROWED    /* Slot of a ring message queue, borrowed */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -73,6 +98,24 @@ struct mqueue_msg_s
   char mail[MQ_MAX_BYTES]; /* Message data */
 };
 
+#ifdef CONFIG_MQUEUE_RING
+/* This structure describes the preallocated slots of a ring message queue.
+ * The slots hold messages of the maximum size of the queue only, so they
+ * are smaller than struct mqueue_msg_s and must be accessed by slotsize.
+ * There is one FIFO lane per priority and a bit set in lanemap for each
+ * lane that is not empty, so that both sending and receiving are O(1).
+ */
+
+struct mqueue_ring_s
+{
+  uint32_t lanemap;                 /* Bit (1 << prio) set if lane in use */
+  size_t slotsize;                  /* Size of one slot in bytes */
+  FAR char *slots;                  /* The first slot */
+  struct list_node freelist;        /* Free slots */
+  struct list_node lane[CONFIG_MQUEUE_RING_NLANES];
+};
+#endif
+
 /********************************************************************************
  * Public Data
  ********************************************************************************/
@@ -97,6 +140,16 @@ EXTERN struct list_node g_msgfree;
 
 EXTERN struct list_node g_msgfreeirq;
 
+/* g_msgfreelock protects both lists of free messages, so that messages may
+ * be allocated and freed outside of the critical section.
+ */
+
+EXTERN spinlock_t g_msgfreelock;
+
+#ifdef CONFIG_SPINLOCK_STATISTICS
+EXTERN struct spinlock_stat_s g_msgfreestat;
+#endif
+
 /********************************************************************************
  * Public Function Prototypes
  ********************************************************************************/
@@ -140,6 +193,19 @@ int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
                  FAR struct mqueue_msg_s *mqmsg,
                  FAR const char *msg, size_t msglen, unsigned int prio);
 
+/* mq_ring.c ****************************************************************/
+
+#ifdef CONFIG_MQUEUE_RING
+size_t nxmq_ring_size(FAR const struct mq_attr *attr);
+void nxmq_ring_initialize(FAR struct mqueue_inode_s *msgq, FAR void *mem);
+FAR struct mqueue_msg_s *nxmq_ring_alloc(FAR struct mqueue_inode_s *msgq);
+void nxmq_ring_free(FAR struct mqueue_inode_s *msgq,
+                    FAR struct mqueue_msg_s *mqmsg);
+void nxmq_ring_add(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
+FAR struct mqueue_msg_s *nxmq_ring_remove(FAR struct mqueue_inode_s *msgq);
+#endif
+
 /* mq_recover.c *****************************************************************/
 
 void nxmq_recover(FAR struct tcb_s *tcb);
@@ -52,6 +52,19 @@
 #  define CONFIG_PAGING_STACKSIZE  CONFIG_IDLETHREAD_STACKSIZE
 #endif
 
+#if defined(CONFIG_PAGING_PREFETCH) && \
+    CONFIG_PAGING_PREFETCH_NPAGES >= CONFIG_PAGING_NPPAGED
+#  error "CONFIG_PAGING_PREFETCH_NPAGES must be less than NPPAGED"
+#endif
+
+/* Count a paging event in g_pgstats */
+
+#ifdef CONFIG_PAGING_STATS
+#  define pg_stats_inc(n)  (g_pgstats.n++)
+#else
+#  define pg_stats_inc(n)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -77,6 +90,12 @@ extern pid_t g_pgworker;
 
 extern FAR struct tcb_s *g_pftcb;
 
+#ifdef CONFIG_PAGING_STATS
+/* The counts of the paging events, updated with interrupts disabled */
+
+extern struct pg_stats_s g_pgstats;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
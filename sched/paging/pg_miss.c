@@ -121,6 +121,7 @@ void pg_miss(void)
 
   pginfo("Blocking TCB: %p PID: %d\n", ftcb, ftcb->pid);
   DEBUGASSERT(g_pgworker != ftcb->pid);
+  pg_stats_inc(nfaults);
 
   /* Block the currently executing task
    * - Call up_block_task() to block the task at the head of the ready-
@@ -33,6 +33,7 @@
 #include <debug.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/signal.h>
 #include <nuttx/page.h>
@@ -67,6 +68,12 @@ pid_t g_pgworker;
 
 FAR struct tcb_s *g_pftcb;
 
+#ifdef CONFIG_PAGING_STATS
+/* The counts of the paging events */
+
+struct pg_stats_s g_pgstats;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -88,6 +95,22 @@ static clock_t g_starttime;
 #endif
 #endif
 
+#ifdef CONFIG_PAGING_PREFETCH
+/* The context of the prefetch fills.  The architecture-specific logic
+ * finds the page to fill in it, as in the TCB of a faulting task, but no
+ * task waits for these fills: When g_pftcb points to it, there is nobody
+ * to restart.
+ */
+
+static struct tcb_s g_pgahead;
+
+/* The number of pages of the prefetch window that are left, including the
+ * page of g_pgahead.  Zero if there is no window.
+ */
+
+static unsigned int g_pgnahead;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -279,6 +302,7 @@ static inline bool pg_dequeue(void)
                * the TCB associated with task that requires the page fill.
                */
 
+              pg_stats_inc(nfills);
               return true;
             }
 
@@ -286,6 +310,7 @@ static inline bool pg_dequeue(void)
            * virtual address space -- just restart it.
            */
 
+          pg_stats_inc(nmapped);
           pginfo("Restarting TCB: %p\n", g_pftcb);
           up_unblock_task(g_pftcb);
         }
@@ -295,6 +320,61 @@ static inline bool pg_dequeue(void)
   return false;
 }
 
+/****************************************************************************
+ * Name: pg_prefetch
+ *
+ * Description:
+ *   Find the next page of the prefetch window that is not mapped yet.  The
+ *   pages that are already mapped are skipped.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   True with g_pftcb set to &g_pgahead if a page needs to be filled; false
+ *   if the window is done.
+ *
+ * Assumptions:
+ *   Executing in the context of the page fill worker thread with all
+ *   interrupts disabled, after pg_dequeue() found no task waiting.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PAGING_PREFETCH
+static inline bool pg_prefetch(void)
+{
+  FAR struct tcb_s *wtcb = this_task();
+
+  while (g_pgnahead > 0)
+    {
+      if (!up_checkmapping(&g_pgahead))
+        {
+          /* Nobody waits for this fill, so let the tasks run at their own
+           * priority while it is in progress.
+           */
+
+          if (wtcb->sched_priority > CONFIG_PAGING_DEFPRIO)
+            {
+              pginfo("New worker priority. %d->%d\n",
+                     wtcb->sched_priority, CONFIG_PAGING_DEFPRIO);
+              nxsched_set_priority(wtcb, CONFIG_PAGING_DEFPRIO);
+            }
+
+          g_pftcb = &g_pgahead;
+          pg_stats_inc(nprefetch);
+          return true;
+        }
+
+      if (--g_pgnahead > 0 && !up_nextpage(&g_pgahead, &g_pgahead))
+        {
+          g_pgnahead = 0;
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Name: pg_startfill
  *
@@ -332,10 +412,14 @@ static inline bool pg_startfill(void)
   /* Remove the TCB at the head of the g_waitfor fill list and check if there
    * is any task waiting for a page fill. pg_dequeue will handle this (plus
    * some corner cases) and will true if the next page TCB was successfully
-   * dequeued.
+   * dequeued.  Otherwise, go on with the prefetch window, if any.
    */
 
+#ifdef CONFIG_PAGING_PREFETCH
+  if (pg_dequeue() || pg_prefetch())
+#else
   if (pg_dequeue())
+#endif
     {
       /* Call up_allocpage(tcb, &vpage). This architecture-specific function
        * will set aside page in memory and map to virtual address (vpage). If
@@ -376,6 +460,7 @@ static inline bool pg_startfill(void)
        */
 
       pginfo("Call up_fillpage(%p)\n", g_pftcb);
+      g_fillresult = -EBUSY;
       result = up_fillpage(g_pftcb, vpage, pg_callback);
       DEBUGASSERT(result == OK);
 
@@ -452,8 +537,9 @@ static inline void pg_alldone(void)
  *   thread, or (2) after the blocking up_fillpage() returns (when
  *   CONFIG_PAGING_BLOCKINGFILL is defined).
  *
- *   This function is just a dumb wrapper around up_unblocktask().  This
- *   function simply makes the task that just received the fill ready-to-run.
+ *   This function makes the task that just received the fill ready-to-run.
+ *   With CONFIG_PAGING_PREFETCH, it also opens a new prefetch window after
+ *   the page of the fault; the prefetch fills have no task to restart.
  *
  * Input Parameters:
  *   None.
@@ -469,6 +555,21 @@ static inline void pg_alldone(void)
 
 static inline void pg_fillcomplete(void)
 {
+#ifdef CONFIG_PAGING_PREFETCH
+  if (g_pftcb == &g_pgahead)
+    {
+      return;
+    }
+
+  /* A window in progress is dropped: The faults tell better where the
+   * task is going.
+   */
+
+  g_pgahead.sched_priority = CONFIG_PAGING_DEFPRIO;
+  g_pgnahead = up_nextpage(&g_pgahead, g_pftcb) ?
+               CONFIG_PAGING_PREFETCH_NPAGES : 0;
+#endif
+
   /* Call up_unblocktask(g_pftcb) to make the task that just
    * received the fill ready-to-run.
    */
@@ -566,8 +667,7 @@ int pg_worker(int argc, char *argv[])
                * the task that was blocked waiting for this page fill.
                */
 
-              pginfo("Restarting TCB: %p\n", g_pftcb);
-              up_unblock_task(g_pftcb);
+              pg_fillcomplete();
 
               /* Yes .. Start the next asynchronous fill.  Check the return
                * value to see a fill was actually started (false means that
@@ -643,8 +743,7 @@ int pg_worker(int argc, char *argv[])
            * returns true.
            */
 
-          pginfo("Restarting TCB: %p\n", g_pftcb);
-          up_unblock_task(g_pftcb);
+          pg_fillcomplete();
         }
 
       /* All queued fills have been processed */
@@ -656,4 +755,25 @@ int pg_worker(int argc, char *argv[])
 
   return OK; /* To keep some compilers happy */
 }
+
+/****************************************************************************
+ * Name: pg_getstats
+ *
+ * Description:
+ *   Return the counts of the page faults and of the page fills since boot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PAGING_STATS
+void pg_getstats(FAR struct pg_stats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  flags = up_irq_save();
+  *stats = g_pgstats;
+  up_irq_restore(flags);
+}
+#endif
 #endif /* CONFIG_PAGING */
@@ -99,14 +99,35 @@ int pthread_sem_give(sem_t *sem);
 int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                        FAR const struct timespec *abs_timeout, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
+int pthread_mutex_claim(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct tcb_s *tcb);
+#elif defined(CONFIG_PTHREAD_MUTEX_FUTEX)
+int pthread_futex_take(FAR struct pthread_mutex_s *mutex,
+                       FAR const struct timespec *abs_timeout);
+int pthread_futex_trytake(FAR struct pthread_mutex_s *mutex);
+int pthread_futex_give(FAR struct pthread_mutex_s *mutex);
+
+#  define pthread_mutex_take(m,abs_timeout,i)  pthread_futex_take((m),(abs_timeout))
+#  define pthread_mutex_trytake(m)             pthread_futex_trytake(m)
+#  define pthread_mutex_claim(m)               (OK)
+#  define pthread_mutex_give(m)                pthread_futex_give(m)
 #else
 #  define pthread_mutex_take(m,abs_timeout,i)  pthread_sem_take(&(m)->sem,(abs_timeout),(i))
 #  define pthread_mutex_trytake(m)             pthread_sem_trytake(&(m)->sem)
+#  define pthread_mutex_claim(m)               (OK)
 #  define pthread_mutex_give(m)                pthread_sem_give(&(m)->sem)
 #endif
 
+int pthread_cond_take(FAR pthread_cond_t *cond,
+                      FAR struct pthread_mutex_s *mutex, clockid_t clockid,
+                      FAR const struct timespec *abstime, FAR bool *locked);
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+bool pthread_cond_morph(FAR pthread_cond_t *cond);
+#else
+#  define pthread_cond_morph(c)                (false)
+#endif
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
 #endif
@@ -79,6 +79,16 @@ int pthread_cond_broadcast(FAR pthread_cond_t *cond)
         }
       else
         {
+          /* Try to move all of the waiting threads directly to the wait
+           * list of the mutex.  They are then restarted one at a time as
+           * the mutex is released, rather than all contending for it now.
+           */
+
+          if (sval < 0 && pthread_cond_morph(cond))
+            {
+              sval = 0;
+            }
+
           /* Loop until all of the waiting threads have been restarted. */
 
           while (sval < 0)
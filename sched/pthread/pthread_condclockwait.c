@@ -26,6 +26,7 @@
 #include <nuttx/compiler.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <signal.h>
@@ -74,6 +75,7 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
                            FAR const struct timespec *abstime)
 {
   irqstate_t flags;
+  bool locked = false;
   int mypid = getpid();
   int ret = OK;
   int status;
@@ -141,12 +143,7 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
       ret        = pthread_mutex_give(mutex);
       if (ret == 0)
         {
-          status = nxsem_clockwait_uninterruptible(
-                   &cond->sem, clockid, abstime);
-          if (status < 0)
-            {
-              ret = -status;
-            }
+          ret = pthread_cond_take(cond, mutex, clockid, abstime, &locked);
         }
 
       /* Restore interrupts  (pre-emption will be enabled
@@ -159,7 +156,17 @@ int pthread_cond_clockwait(FAR pthread_cond_t *cond,
 
       sinfo("Re-locking...\n");
 
-      status = pthread_mutex_take(mutex, NULL, false);
+      if (locked)
+        {
+          /* pthread_cond_broadcast() already handed the mutex over */
+
+          status = pthread_mutex_claim(mutex);
+        }
+      else
+        {
+          status = pthread_mutex_take(mutex, NULL, false);
+        }
+
       if (status == OK)
         {
           mutex->pid    = mypid;
@@ -0,0 +1,207 @@
+/****************************************************************************
+ * sched/pthread/pthread_condmorph.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+
+#include "sched/sched.h"
+#include "pthread/pthread.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_take
+ *
+ * Description:
+ *   Wait on the semaphore of a condition variable on behalf of
+ *   pthread_cond_wait() and pthread_cond_clockwait().  The wait ignores
+ *   signals (EINTR) unless the thread has already been moved to the mutex
+ *   by pthread_cond_broadcast().
+ *
+ * Input Parameters:
+ *   cond    - The condition variable to wait on
+ *   mutex   - The mutex released by the caller for the wait
+ *   clockid - The timing source of abstime
+ *   abstime - The absolute time of the timeout or NULL to wait forever
+ *   locked  - Set to true if the thread holds the semaphore of the mutex
+ *             on return and has only to complete locking it with
+ *             pthread_mutex_claim().
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ * Assumptions:
+ *   Called with the scheduler locked.
+ *
+ ****************************************************************************/
+
+int pthread_cond_take(FAR pthread_cond_t *cond,
+                      FAR struct pthread_mutex_s *mutex, clockid_t clockid,
+                      FAR const struct timespec *abstime, FAR bool *locked)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  irqstate_t flags;
+  bool morphed;
+  int ret;
+
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+  rtcb->condmutex = mutex;
+#endif
+
+  do
+    {
+      if (abstime == NULL)
+        {
+          ret = nxsem_wait((FAR sem_t *)&cond->sem);
+        }
+      else
+        {
+          ret = nxsem_clockwait((FAR sem_t *)&cond->sem, clockid, abstime);
+        }
+    }
+  while (ret == -EINTR && (rtcb->flags & TCB_FLAG_COND_MORPHED) == 0);
+
+  flags = enter_critical_section();
+  morphed = (rtcb->flags & TCB_FLAG_COND_MORPHED) != 0;
+  rtcb->flags &= ~TCB_FLAG_COND_MORPHED;
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+  rtcb->condmutex = NULL;
+#endif
+  leave_critical_section(flags);
+
+  /* If the thread was moved to the mutex, then the condition has been
+   * broadcast.  A normal wake-up hands the mutex over to this thread.  If
+   * the wait on the mutex was interrupted or timed out instead, then the
+   * caller must lock the mutex again, but the broadcast still counts.
+   */
+
+  *locked = morphed && ret == OK;
+  if (morphed && (ret == -EINTR || ret == -ETIMEDOUT))
+    {
+      ret = OK;
+    }
+
+  return -ret;
+}
+
+#ifndef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Name: pthread_cond_morph
+ *
+ * Description:
+ *   Implement wait morphing for pthread_cond_broadcast():  Move all threads
+ *   waiting on the condition variable directly to the wait list of the
+ *   mutex instead of waking them up.  They are then restarted one at a
+ *   time as the mutex is released so that they do not all contend for the
+ *   mutex.
+ *
+ *   This is only possible if all waiters use the same mutex and the mutex
+ *   is held; nobody would release a free mutex to restart the first
+ *   waiter.  Mutexes with priority inheritance are left alone, too, since
+ *   the moved threads would not boost the priority of the holder.
+ *
+ * Input Parameters:
+ *   cond - The condition variable being broadcast
+ *
+ * Returned Value:
+ *   True if all waiters were moved to the mutex.  False if nothing was
+ *   done and the waiters have to be restarted.
+ *
+ ****************************************************************************/
+
+bool pthread_cond_morph(FAR pthread_cond_t *cond)
+{
+  FAR sem_t *sem = (FAR sem_t *)&cond->sem;
+  FAR struct pthread_mutex_s *mutex = NULL;
+  FAR struct tcb_s *wtcb;
+  irqstate_t flags;
+  bool morphed = false;
+
+  flags = enter_critical_section();
+
+  for (wtcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+       wtcb != NULL;
+       wtcb = wtcb->flink)
+    {
+      if (wtcb->waitsem == sem)
+        {
+          if (wtcb->condmutex == NULL ||
+              (mutex != NULL && wtcb->condmutex != mutex))
+            {
+              goto out;
+            }
+
+          mutex = wtcb->condmutex;
+        }
+    }
+
+  if (mutex == NULL || mutex->sem.semcount > 0)
+    {
+      goto out;
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      goto out;
+    }
+#endif
+
+  /* The list of waiting threads is shared by all semaphores and
+   * prioritized, so the moved threads stay in priority order.
+   */
+
+  for (wtcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+       wtcb != NULL;
+       wtcb = wtcb->flink)
+    {
+      if (wtcb->waitsem == sem)
+        {
+          sem->semcount++;
+          mutex->sem.semcount--;
+
+          wtcb->waitsem = &mutex->sem;
+          wtcb->flags  |= TCB_FLAG_COND_MORPHED;
+        }
+    }
+
+  morphed = true;
+
+out:
+  leave_critical_section(flags);
+  return morphed;
+}
+
+#endif /* !CONFIG_PTHREAD_MUTEX_FUTEX */
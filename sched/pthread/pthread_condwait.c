@@ -24,8 +24,10 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <time.h>
 #include <sched.h>
 #include <errno.h>
 #include <debug.h>
@@ -56,6 +58,7 @@
 
 int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 {
+  bool locked;
   int status;
   int ret;
 
@@ -107,7 +110,8 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
        * or if the thread is canceled (ECANCELED)
        */
 
-      status = pthread_sem_take((FAR sem_t *)&cond->sem, NULL, false);
+      status = pthread_cond_take(cond, mutex, CLOCK_REALTIME, NULL,
+                                 &locked);
       if (ret == OK)
         {
           /* Report the first failure that occurs */
@@ -126,7 +130,17 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 
       sinfo("Reacquire mutex...\n");
 
-      status = pthread_mutex_take(mutex, NULL, false);
+      if (locked)
+        {
+          /* pthread_cond_broadcast() already handed the mutex over */
+
+          status = pthread_mutex_claim(mutex);
+        }
+      else
+        {
+          status = pthread_mutex_take(mutex, NULL, false);
+        }
+
       if (ret == OK)
         {
           /* Report the first failure that occurs */
@@ -45,6 +45,7 @@
 #include "group/group.h"
 #include "clock/clock.h"
 #include "pthread/pthread.h"
+#include "task/task.h"
 #include "tls/tls.h"
 
 /****************************************************************************
@@ -231,10 +232,23 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
       attr = &g_default_pthread_attr;
     }
 
-  /* Allocate a TCB for the new task. */
+  /* Allocate a TCB for the new task.  A TCB recycled from the TCB cache
+   * already owns a stack of the requested size.
+   */
+
+  ptcb = NULL;
+  if (!attr->stackaddr)
+    {
+      ptcb = (FAR struct pthread_tcb_s *)
+        nxtask_tcbcache_get(TCB_FLAG_TTYPE_PTHREAD, attr->stacksize);
+    }
+
+  if (!ptcb)
+    {
+      ptcb = (FAR struct pthread_tcb_s *)
+                kmm_zalloc(sizeof(struct pthread_tcb_s));
+    }
 
-  ptcb = (FAR struct pthread_tcb_s *)
-            kmm_zalloc(sizeof(struct pthread_tcb_s));
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -285,13 +299,19 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
       ret = up_use_stack((FAR struct tcb_s *)ptcb, attr->stackaddr,
                          attr->stacksize);
     }
-  else
+  else if (ptcb->cmn.stack_alloc_ptr == NULL)
     {
       /* Allocate the stack for the TCB */
 
       ret = up_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
                             TCB_FLAG_TTYPE_PTHREAD);
     }
+  else
+    {
+      /* The TCB came from the TCB cache together with its stack */
+
+      ret = OK;
+    }
 
   if (ret != OK)
     {
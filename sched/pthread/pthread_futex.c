@@ -0,0 +1,288 @@
+/****************************************************************************
+ * sched/pthread/pthread_futex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/futex.h>
+#include <nuttx/semaphore.h>
+
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of wait queues, the futexes are hashed by address */
+
+#define FUTEX_NHASH      16
+#define FUTEX_HASH(a)    (((uintptr_t)(a) >> 2) & (FUTEX_NHASH - 1))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One thread waiting on a futex.  The waiter lives on the stack of the
+ * waiting thread while it is queued.
+ */
+
+struct futex_waiter_s
+{
+  dq_entry_t node;                   /* Link in the wait queue */
+  FAR volatile uint32_t *uaddr;      /* The futex, NULL once woken up */
+  sem_t sem;                         /* The waiting thread blocks here */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static dq_queue_t g_futexhash[FUTEX_NHASH];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: futex_wait
+ *
+ * Description:
+ *   Block the calling thread on the futex word at 'uaddr' if it still holds
+ *   the value 'val'.
+ *
+ * Input Parameters:
+ *   uaddr   - The address of the futex word
+ *   val     - The value that the futex word is expected to hold
+ *   abstime - The absolute CLOCK_REALTIME time to wait until or NULL to
+ *             wait forever
+ *
+ * Returned Value:
+ *   Zero (OK) if woken up, otherwise EAGAIN, ETIMEDOUT, EINTR or EINVAL.
+ *
+ ****************************************************************************/
+
+int futex_wait(FAR volatile uint32_t *uaddr, uint32_t val,
+               FAR const struct timespec *abstime)
+{
+  FAR dq_queue_t *queue;
+  struct futex_waiter_s waiter;
+  irqstate_t flags;
+  int ret;
+
+  if (uaddr == NULL || ((uintptr_t)uaddr & 3) != 0)
+    {
+      return EINVAL;
+    }
+
+  queue = &g_futexhash[FUTEX_HASH(uaddr)];
+
+  nxsem_init(&waiter.sem, 0, 0);
+  nxsem_set_protocol(&waiter.sem, SEM_PRIO_NONE);
+  waiter.uaddr = uaddr;
+
+  /* futex_wake() runs in the critical section too, so the word cannot
+   * change and be followed by a wake-up between this check and the
+   * queuing.
+   */
+
+  flags = enter_critical_section();
+  if (*uaddr != val)
+    {
+      leave_critical_section(flags);
+      nxsem_destroy(&waiter.sem);
+      return EAGAIN;
+    }
+
+  dq_addlast(&waiter.node, queue);
+
+  if (abstime != NULL)
+    {
+      ret = nxsem_timedwait(&waiter.sem, abstime);
+    }
+  else
+    {
+      ret = nxsem_wait(&waiter.sem);
+    }
+
+  /* A waiter that was not woken up is still queued */
+
+  if (waiter.uaddr != NULL)
+    {
+      dq_rem(&waiter.node, queue);
+    }
+  else
+    {
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  nxsem_destroy(&waiter.sem);
+  return -ret;
+}
+
+/****************************************************************************
+ * Name: futex_wake
+ *
+ * Description:
+ *   Wake up to 'nwake' threads blocked on the futex word at 'uaddr'.
+ *
+ * Input Parameters:
+ *   uaddr - The address of the futex word
+ *   nwake - The maximum number of threads to wake up
+ *
+ * Returned Value:
+ *   The number of threads woken up.
+ *
+ ****************************************************************************/
+
+int futex_wake(FAR volatile uint32_t *uaddr, int nwake)
+{
+  FAR struct futex_waiter_s *waiter;
+  FAR struct futex_waiter_s *next;
+  FAR dq_queue_t *queue;
+  irqstate_t flags;
+  int nwoken = 0;
+
+  queue = &g_futexhash[FUTEX_HASH(uaddr)];
+
+  flags = enter_critical_section();
+  for (waiter = (FAR struct futex_waiter_s *)dq_peek(queue);
+       waiter != NULL && nwoken < nwake;
+       waiter = next)
+    {
+      next = (FAR struct futex_waiter_s *)dq_next(&waiter->node);
+      if (waiter->uaddr == uaddr)
+        {
+          dq_rem(&waiter->node, queue);
+          waiter->uaddr = NULL;
+          nxsem_post(&waiter->sem);
+          nwoken++;
+        }
+    }
+
+  leave_critical_section(flags);
+  return nwoken;
+}
+
+/****************************************************************************
+ * Name: pthread_futex_take
+ *
+ * Description:
+ *   Lock the futex word of a mutex, waiting if necessary.  The word is 0
+ *   when the mutex is unlocked, 1 when it is locked and 2 when it is locked
+ *   and there may be waiters.  The fast path in the C library takes an
+ *   unlocked mutex without entering the OS and only calls
+ *   pthread_mutex_timedlock() on contention.
+ *
+ * Input Parameters:
+ *   mutex       - The mutex
+ *   abs_timeout - The absolute time to wait until or NULL
+ *
+ * Returned Value:
+ *   Zero (OK) on success or ETIMEDOUT.  Signals do not interrupt the wait.
+ *
+ ****************************************************************************/
+
+int pthread_futex_take(FAR struct pthread_mutex_s *mutex,
+                       FAR const struct timespec *abs_timeout)
+{
+  uint32_t c = 0;
+  int ret;
+
+  if (__atomic_compare_exchange_n(&mutex->futex, &c, 1, false,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      return OK;
+    }
+
+  if (c != 2)
+    {
+      c = __atomic_exchange_n(&mutex->futex, 2, __ATOMIC_ACQUIRE);
+    }
+
+  while (c != 0)
+    {
+      ret = futex_wait(&mutex->futex, 2, abs_timeout);
+      if (ret == ETIMEDOUT || ret == EINVAL)
+        {
+          return ret;
+        }
+
+      c = __atomic_exchange_n(&mutex->futex, 2, __ATOMIC_ACQUIRE);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_futex_trytake
+ *
+ * Description:
+ *   Lock the futex word of a mutex if it is unlocked.
+ *
+ * Returned Value:
+ *   Zero (OK) on success or EAGAIN.
+ *
+ ****************************************************************************/
+
+int pthread_futex_trytake(FAR struct pthread_mutex_s *mutex)
+{
+  uint32_t c = 0;
+
+  return __atomic_compare_exchange_n(&mutex->futex, &c, 1, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ?
+         OK : EAGAIN;
+}
+
+/****************************************************************************
+ * Name: pthread_futex_give
+ *
+ * Description:
+ *   Unlock the futex word of a mutex and wake up one waiter, if any.
+ *
+ * Returned Value:
+ *   Zero (OK)
+ *
+ ****************************************************************************/
+
+int pthread_futex_give(FAR struct pthread_mutex_s *mutex)
+{
+  if (__atomic_exchange_n(&mutex->futex, 0, __ATOMIC_RELEASE) == 2)
+    {
+      futex_wake(&mutex->futex, 1);
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FUTEX */
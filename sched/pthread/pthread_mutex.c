@@ -169,22 +169,7 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
           ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
           if (ret == OK)
             {
-              /* Check if the holder of the mutex has terminated without
-               * releasing.  In that case, the state of the mutex is
-               * inconsistent and we return EOWNERDEAD.
-               */
-
-              if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
-                {
-                  ret = EOWNERDEAD;
-                }
-
-              /* Add the mutex to the list of mutexes held by this task */
-
-              else
-                {
-                  pthread_mutex_add(mutex);
-                }
+              ret = pthread_mutex_claim(mutex);
             }
         }
 
@@ -194,6 +179,40 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
   return ret;
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_claim
+ *
+ * Description:
+ *   Complete locking the pthread_mutex after the semaphore underlying the
+ *   mutex has been taken:  Either by pthread_mutex_take() or by a condition
+ *   waiter that was handed the mutex after pthread_cond_broadcast().
+ *
+ * Input Parameters:
+ *  mutex - The mutex whose semaphore is held by this thread
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_claim(FAR struct pthread_mutex_s *mutex)
+{
+  /* Check if the holder of the mutex has terminated without releasing.  In
+   * that case, the state of the mutex is inconsistent and we return
+   * EOWNERDEAD.
+   */
+
+  if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
+    {
+      return EOWNERDEAD;
+    }
+
+  /* Add the mutex to the list of mutexes held by this task */
+
+  pthread_mutex_add(mutex);
+  return OK;
+}
+
 /****************************************************************************
  * Name: pthread_mutex_trytake
  *
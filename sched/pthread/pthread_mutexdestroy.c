@@ -27,10 +27,12 @@
 #include <pthread.h>
 #include <signal.h>
 #include <sched.h>
+#include <limits.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/futex.h>
 #include <nuttx/semaphore.h>
 
 #include "pthread/pthread.h"
@@ -96,6 +98,13 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 
               mutex->pid = INVALID_PROCESS_ID;
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+              /* Release the futex word and wake up all of its waiters */
+
+              mutex->futex = 0;
+              futex_wake(&mutex->futex, INT_MAX);
+#endif
+
               /* Reset the semaphore.  If threads are were on this
                * semaphore, then this will awakened them and make
                * destruction of the semaphore impossible here.
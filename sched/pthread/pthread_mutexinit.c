@@ -123,6 +123,20 @@ int pthread_mutex_init(FAR pthread_mutex_t *mutex,
         }
 #endif
 
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+      /* The futex word is the lock.  The holder is not known to the OS, so
+       * there is no priority inheritance.
+       */
+
+      mutex->futex = 0;
+#  ifdef CONFIG_PRIORITY_INHERITANCE
+      if (proto != PTHREAD_PRIO_NONE)
+        {
+          ret = ENOTSUP;
+        }
+#  endif
+#endif
+
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
       /* Initial internal fields of the mutex */
 
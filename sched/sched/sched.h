@@ -86,6 +86,25 @@
 #  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #endif
 
+/* Return true if the TCB 'a' has to be scheduled ahead of the TCB 'b'.
+ * Among deadline threads of the same priority, the earliest absolute
+ * deadline runs first.
+ */
+
+#ifdef CONFIG_SCHED_DEADLINE
+#  define nxsched_deadline_before(a,b) \
+     ((a)->deadline != NULL && (b)->deadline != NULL && \
+      (sclock_t)((a)->deadline->absdeadline - \
+                 (b)->deadline->absdeadline) < 0)
+#  define nxsched_runs_before(a,b) \
+     ((a)->sched_priority > (b)->sched_priority || \
+      ((a)->sched_priority == (b)->sched_priority && \
+       nxsched_deadline_before(a,b)))
+#else
+#  define nxsched_runs_before(a,b) \
+     ((a)->sched_priority > (b)->sched_priority)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -263,47 +282,23 @@ extern volatile uint32_t g_cpuload_total;
  * stopping the other CPUs): Even though pre-emption is disabled, other
  * threads will still be executing on the other CPUS.
  *
- * There are additional rules for this multi-CPU case:
+ * Pre-emption is disabled per CPU:  The lockcount of the task running on a
+ * CPU only keeps other tasks from being started on that same CPU.  The
+ * other CPUs continue to schedule normally.  Hence:
  *
- * 1. There is a global lock count 'g_cpu_lockset' that includes a bit for
- *    each CPU: If the bit is '1', then the corresponding CPU has the
- *    scheduler locked; if '0', then the CPU does not have the scheduler
- *    locked.
- * 2. Scheduling logic would set the bit associated with the cpu in
- *    'g_cpu_lockset' when the TCB at the head of the g_assignedtasks[cpu]
- *    list transitions has 'lockcount' > 0. This might happen when
- *    sched_lock() is called, or after a context switch that changes the
- *    TCB at the head of the g_assignedtasks[cpu] list.
- * 3. Similarly, the cpu bit in the global 'g_cpu_lockset' would be cleared
- *    when the TCB at the head of the g_assignedtasks[cpu] list has
- *    'lockcount' == 0. This might happen when sched_unlock() is called, or
- *    after a context switch that changes the TCB at the head of the
- *    g_assignedtasks[cpu] list.
- * 4. Modification of the global 'g_cpu_lockset' must be protected by a
- *    spinlock, 'g_cpu_schedlock'. That spinlock would be taken when
- *    sched_lock() is called, and released when sched_unlock() is called.
- *    This assures that the scheduler does enforce the critical section.
- *    NOTE: Because of this spinlock, there should never be more than one
- *    bit set in 'g_cpu_lockset'; attempts to set additional bits should
- *    be cause the CPU to block on the spinlock.  However, additional bits
- *    could get set in 'g_cpu_lockset' due to the context switches on the
- *    various CPUs.
- * 5. Each the time the head of a g_assignedtasks[] list changes and the
- *    scheduler modifies 'g_cpu_lockset', it must also set 'g_cpu_schedlock'
- *    depending on the new state of 'g_cpu_lockset'.
- * 5. Logic that currently uses the currently running tasks lockcount
- *    instead uses the global 'g_cpu_schedlock'. A value of SP_UNLOCKED
- *    means that no CPU has pre-emption disabled; SP_LOCKED means that at
- *    least one CPU has pre-emption disabled.
+ * 1. sched_lock() and sched_unlock() only modify the lockcount in the TCB
+ *    of the calling task.  No global state is shared between the CPUs.
+ * 2. A task that becomes ready-to-run and would preempt the task running
+ *    on a CPU with pre-emption disabled is either started on another CPU
+ *    permitted by its affinity mask or it is held in g_pendingtasks.
+ *    nxsched_select_cpu() avoids CPUs with pre-emption disabled.
+ * 3. Tasks in g_pendingtasks are released when pre-emption is re-enabled
+ *    on a CPU or when a critical section is left.
+ * 4. sched_lock() does not provide mutual exclusion with tasks running on
+ *    the other CPUs. Logic that requires that must use a critical section
+ *    (enter_critical_section()) or a spinlock instead.
  */
 
-extern volatile spinlock_t g_cpu_schedlock;
-
-/* Used to keep track of which CPU(s) hold the IRQ lock. */
-
-extern volatile spinlock_t g_cpu_locksetlock;
-extern volatile cpu_set_t g_cpu_lockset;
-
 /* Used to lock tasklist to prevent from concurrent access */
 
 extern volatile spinlock_t g_cpu_tasklistlock;
@@ -366,6 +361,16 @@ uint32_t nxsched_process_sporadic(FAR struct tcb_s *tcb, uint32_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb, int priority,
+                            uint32_t runtime, uint32_t reldl,
+                            uint32_t period);
+int  nxsched_stop_deadline(FAR struct tcb_s *tcb);
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches);
+void nxsched_deadline_throttle(FAR struct tcb_s *tcb);
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 void nxsched_continue(FAR struct tcb_s *tcb);
@@ -377,15 +382,17 @@ FAR struct tcb_s *this_task(void);
 int  nxsched_select_cpu(cpu_set_t affinity);
 int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
 
-#  define nxsched_islocked_global() spin_islocked(&g_cpu_schedlock)
-#  define nxsched_islocked_tcb(tcb) nxsched_islocked_global()
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+void nxsched_idle_balance(void);
+#endif
 
 #else
 #  define nxsched_select_cpu(a)     (0)
 #  define nxsched_pause_cpu(t)      (-38)  /* -ENOSYS */
-#  define nxsched_islocked_tcb(tcb) ((tcb)->lockcount > 0)
 #endif
 
+#define nxsched_islocked_tcb(tcb)   ((tcb)->lockcount > 0)
+
 #ifndef CONFIG_SCHED_CPULOAD_EXTCLK
 
 /* CPU load measurement support */
@@ -399,6 +406,19 @@ void nxsched_process_cpuload_ticks(uint32_t ticks);
 #  define nxsched_process_cpuload() nxsched_process_cpuload_ticks(1)
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+void nxsched_suspend_cpuload(FAR struct tcb_s *tcb);
+void nxsched_resume_cpuload(FAR struct tcb_s *tcb);
+void nxsched_cpuload_irqenter(void);
+void nxsched_cpuload_irqleave(void);
+#endif
+
+/* Stack use sampling */
+
+#ifdef CONFIG_STACK_SAMPLING
+void nxsched_sample_stack(FAR struct tcb_s *tcb);
+#endif
+
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
@@ -408,6 +428,10 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+void nxsched_wakeup_critmon(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -69,13 +69,19 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Start measuring the time until the task runs */
+
+  nxsched_wakeup_critmon(btcb);
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
    * also disabled.
    */
 
-  if (rtcb->lockcount > 0 && rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->lockcount > 0 && nxsched_runs_before(btcb, rtcb))
     {
       /* Yes.  Preemption would occur!  Add the new ready-to-run task to the
        * g_pendingtasks task list for now.
@@ -158,6 +164,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   int cpu;
   int me;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Start measuring the time until the task runs */
+
+  nxsched_wakeup_critmon(btcb);
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
@@ -185,7 +197,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    * required.
    */
 
-  if (rtcb->sched_priority < btcb->sched_priority)
+  if (nxsched_runs_before(btcb, rtcb))
     {
       task_state = TSTATE_TASK_RUNNING;
     }
@@ -210,9 +222,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
    * start running the task.  Be we cannot do that if pre-emption is
-   * disabled.  If the selected state is TSTATE_TASK_READYTORUN, then it
-   * should also go to the pending task list so that it will have a chance
-   * to be restarted when the scheduler is unlocked.
+   * disabled on the selected CPU.  nxsched_select_cpu() only selects such
+   * a CPU if pre-emption is disabled on all CPUs that the task may use.
+   * Then the task goes to the pending task list so that it will have a
+   * chance to be restarted when the scheduler is unlocked.  Pre-emption
+   * disabled on some CPU does not keep TSTATE_TASK_READYTORUN tasks from
+   * being started on the other CPUs.
    *
    * There is an interaction here with IRQ locking.  Even if the pre-
    * emption is enabled, tasks will be forced to pend if the IRQ lock
@@ -222,8 +237,8 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    */
 
   me = this_cpu();
-  if ((nxsched_islocked_global() || irq_cpu_locked(me)) &&
-      task_state != TSTATE_TASK_ASSIGNED)
+  if ((task_state == TSTATE_TASK_RUNNING && nxsched_islocked_tcb(rtcb)) ||
+      (irq_cpu_locked(me) && task_state != TSTATE_TASK_ASSIGNED))
     {
       /* Add the new ready-to-run task to the g_pendingtasks task list for
        * now.
@@ -286,22 +301,6 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
           btcb->cpu        = cpu;
           btcb->task_state = TSTATE_TASK_RUNNING;
 
-          /* Adjust global pre-emption controls.  If the lockcount is
-           * greater than zero, then this task/this CPU holds the scheduler
-           * lock.
-           */
-
-          if (btcb->lockcount > 0)
-            {
-              spin_setbit(&g_cpu_lockset, cpu, &g_cpu_locksetlock,
-                          &g_cpu_schedlock);
-            }
-          else
-            {
-              spin_clrbit(&g_cpu_lockset, cpu, &g_cpu_locksetlock,
-                          &g_cpu_schedlock);
-            }
-
           /* NOTE: If the task runs on another CPU(cpu), adjusting global IRQ
            * controls will be done in the pause handler on the new CPU(cpu).
            * If the task is scheduled on this CPU(me), do nothing because
@@ -328,24 +327,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
               dq_rem((FAR dq_entry_t *)next, tasklist);
 
-              /* Add the task to the g_readytorun or to the g_pendingtasks
-               * list.  NOTE: That the above operations may cause the
-               * scheduler to become locked.  It may be assigned to a
-               * different CPU the next time that it runs.
+              /* Add the task to the g_readytorun list.  It may be assigned
+               * to a different CPU the next time that it runs.
                */
 
-              if (nxsched_islocked_global())
-                {
-                  next->task_state = TSTATE_TASK_PENDING;
-                  tasklist         = &g_pendingtasks;
-                }
-              else
-                {
-                  next->task_state = TSTATE_TASK_READYTORUN;
-                  tasklist         = &g_readytorun;
-                }
-
-              nxsched_add_prioritized(next, tasklist);
+              next->task_state = TSTATE_TASK_READYTORUN;
+              nxsched_add_prioritized(next, &g_readytorun);
             }
 
           doswitch = true;
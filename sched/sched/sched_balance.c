@@ -0,0 +1,128 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_IDLE_BALANCE
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Number of tasks pulled by the IDLE task of each CPU */
+
+uint32_t g_balance_migrations[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_idle_balance
+ *
+ * Description:
+ *   Called from the IDLE loop.  The tasks that are ready-to-run but not
+ *   assigned to any CPU are normally picked up when a CPU gives up its
+ *   running task.  That does not happen while another CPU holds the
+ *   critical section or the scheduler lock, and such a task may then wait
+ *   in g_readytorun while this CPU idles.  Pull the highest priority of
+ *   those tasks that may run on this CPU and start it here.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called by the IDLE task of this CPU, outside of a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_idle_balance(void)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int me;
+
+  /* Avoid the critical section in the usual case that there is nothing
+   * to pull.
+   */
+
+  if (g_readytorun.head == NULL)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+  me    = this_cpu();
+
+  /* Check again now that the lists are stable.  Nothing may be started
+   * while the scheduler is locked or while this CPU runs anything but its
+   * IDLE task.
+   */
+
+  if (!nxsched_islocked_tcb(this_task()) && !irq_cpu_locked(me) &&
+      this_task()->flink == NULL)
+    {
+      /* g_readytorun is prioritized, take the first task that may run on
+       * this CPU.
+       */
+
+      for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+           tcb != NULL && !CPU_ISSET(me, &tcb->affinity);
+           tcb = tcb->flink);
+
+      if (tcb != NULL)
+        {
+          /* Move the task to the pending task list and let
+           * up_release_pending() start it.  nxsched_select_cpu() prefers
+           * this CPU, which runs its IDLE task at the lowest priority, and
+           * the context switch is done by the architecture as usual.
+           */
+
+          dq_rem((FAR dq_entry_t *)tcb, &g_readytorun);
+          tcb->task_state = TSTATE_TASK_PENDING;
+          nxsched_add_prioritized(tcb, &g_pendingtasks);
+
+          g_balance_migrations[me]++;
+          up_release_pending();
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SCHED_IDLE_BALANCE */
@@ -0,0 +1,1260 @@
+/****************************************************************************
+ * sched/sched/sched_bench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <lzf.h>
+#ifdef CONFIG_LIBM
+#  include <math.h>
+#endif
+#ifdef CONFIG_LIBDSP
+#  include <dsp.h>
+#endif
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/lib/math_vector.h>
+#include <nuttx/mqueue.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/signal.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_BENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BENCH_NSAMPLES  CONFIG_SCHED_BENCH_NSAMPLES
+#define BENCH_PRIORITY  CONFIG_SCHED_BENCH_PRIORITY
+#define BENCH_SIGNO     SIGUSR1
+#define BENCH_MQNAME    "sched_bench"
+#define BENCH_MSGSIZE   16
+#define BENCH_NBLOCKS   32
+#define BENCH_BUFSIZE   2048
+#define BENCH_NMOTORS   16
+#define BENCH_STRLEN    256
+#define BENCH_NFLOATS   64
+#define BENCH_LZFSIZE   1024
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The benchmarks fill g_bench.samples[] and return OK or a negated errno
+ * value.
+ */
+
+typedef CODE int (*bench_func_t)(void);
+
+struct bench_entry_s
+{
+  FAR const char *name;
+  bench_func_t func;
+};
+
+/* The state of a run, shared by the benchmark thread, its helper threads
+ * and the watchdog timer.
+ */
+
+struct bench_state_s
+{
+  sem_t wake;                        /* Wakes up the helper */
+  sem_t ack;                         /* Posted by the helper */
+  sem_t done;                        /* Posted when the thread exits */
+  struct wdog_s wdog;                /* For the watchdog benchmarks */
+  FAR uint32_t *samples;             /* The samples of a benchmark */
+  FAR uint8_t *buf;                  /* The data of the library routines */
+  volatile uintptr_t sink;           /* Keeps their results alive */
+  volatile uint32_t start;           /* Start time of the current sample */
+  volatile uint32_t nsamples;        /* Number of samples */
+  volatile bool stop;                /* Stop the helper */
+  pid_t helper;                      /* The helper thread */
+  FAR struct sched_bench_s *results;
+  int nresults;
+  int ret;                           /* The result of the run */
+#ifdef CONFIG_SMP
+  cpu_set_t cpuset;                  /* The CPU of the benchmarks */
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int bench_sempostwait(void);
+static int bench_semwakeup(void);
+static int bench_yield(void);
+#ifndef CONFIG_DISABLE_MQUEUE
+static int bench_mqsendreceive(void);
+#endif
+static int bench_sigwakeup(void);
+static int bench_wdstartcancel(void);
+static int bench_malloc64(void);
+static int bench_malloc1k(void);
+static int bench_mallocmixed(void);
+static int bench_irqwakeup(void);
+static int bench_memcpy(void);
+static int bench_memmove(void);
+static int bench_strlen(void);
+static int bench_strcmp(void);
+static int bench_snprintfint(void);
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+static int bench_snprintfdbl(void);
+#endif
+#ifdef CONFIG_LIBM
+static int bench_expf(void);
+static int bench_sinf(void);
+#endif
+#ifdef CONFIG_LIBM_VECTOR
+static int bench_vexpf(void);
+static int bench_vsinf(void);
+#endif
+#ifdef CONFIG_LIBC_LZF
+static int bench_lzfdecompress(void);
+#endif
+#ifdef CONFIG_NET
+static int bench_netchksum(void);
+#endif
+#ifdef CONFIG_LIBDSP
+static int bench_dsppark(void);
+static int bench_dspparkbatch(void);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct bench_entry_s g_bench_entries[] =
+{
+  { "sem-post-wait",     bench_sempostwait   },
+  { "sem-wakeup",        bench_semwakeup     },
+  { "yield",             bench_yield         },
+#ifndef CONFIG_DISABLE_MQUEUE
+  { "mq-send-receive",   bench_mqsendreceive },
+#endif
+  { "signal-wakeup",     bench_sigwakeup     },
+  { "wdog-start-cancel", bench_wdstartcancel },
+  { "malloc-free-64",    bench_malloc64      },
+  { "malloc-free-1k",    bench_malloc1k      },
+  { "malloc-free-mixed", bench_mallocmixed   },
+  { "irq-wakeup",        bench_irqwakeup     },
+  { "memcpy-1k",         bench_memcpy        },
+  { "memmove-1k",        bench_memmove       },
+  { "strlen-256",        bench_strlen        },
+  { "strcmp-256",        bench_strcmp        },
+  { "snprintf-int",      bench_snprintfint   },
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+  { "snprintf-double",   bench_snprintfdbl   },
+#endif
+#ifdef CONFIG_LIBM
+  { "expf-64",           bench_expf          },
+  { "sinf-64",           bench_sinf          },
+#endif
+#ifdef CONFIG_LIBM_VECTOR
+  { "vexpf-64",          bench_vexpf         },
+  { "vsinf-64",          bench_vsinf         },
+#endif
+#ifdef CONFIG_LIBC_LZF
+  { "lzf-decompress-1k", bench_lzfdecompress },
+#endif
+#ifdef CONFIG_NET
+  { "net-chksum-1500",   bench_netchksum     },
+#endif
+#ifdef CONFIG_LIBDSP
+  { "dsp-park-16",       bench_dsppark       },
+  { "dsp-park-batch-16", bench_dspparkbatch  },
+#endif
+};
+
+#define BENCH_NENTRIES \
+  (sizeof(g_bench_entries) / sizeof(struct bench_entry_s))
+
+/* Serializes the runs */
+
+static sem_t g_bench_lock = SEM_INITIALIZER(1);
+
+static struct bench_state_s g_bench;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bench_record
+ *
+ * Description:
+ *   Record the time elapsed since 'start' as the next sample.
+ *
+ ****************************************************************************/
+
+static inline void bench_record(uint32_t start)
+{
+  uint32_t elapsed = up_perf_gettime() - start;
+
+  if (g_bench.nsamples < BENCH_NSAMPLES)
+    {
+      g_bench.samples[g_bench.nsamples++] = elapsed;
+    }
+}
+
+/****************************************************************************
+ * Name: bench_compare
+ ****************************************************************************/
+
+static int bench_compare(FAR const void *a, FAR const void *b)
+{
+  uint32_t sa = *(FAR const uint32_t *)a;
+  uint32_t sb = *(FAR const uint32_t *)b;
+
+  return sa < sb ? -1 : sa > sb ? 1 : 0;
+}
+
+/****************************************************************************
+ * Name: bench_nsec
+ ****************************************************************************/
+
+static uint32_t bench_nsec(uint32_t elapsed)
+{
+  struct timespec ts;
+  uint64_t nsec;
+
+  up_perf_convert(elapsed, &ts);
+  nsec = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+  return nsec < UINT32_MAX ? (uint32_t)nsec : UINT32_MAX;
+}
+
+/****************************************************************************
+ * Name: bench_summarize
+ *
+ * Description:
+ *   Sort the samples and compute the percentiles.
+ *
+ ****************************************************************************/
+
+static void bench_summarize(FAR struct sched_bench_s *result,
+                            FAR const char *name)
+{
+  FAR uint32_t *samples = g_bench.samples;
+  uint32_t n = g_bench.nsamples;
+
+  result->name     = name;
+  result->nsamples = n;
+
+  if (n == 0)
+    {
+      result->min = 0;
+      result->p50 = 0;
+      result->p90 = 0;
+      result->p99 = 0;
+      result->max = 0;
+      return;
+    }
+
+  qsort(samples, n, sizeof(uint32_t), bench_compare);
+
+  result->min = bench_nsec(samples[0]);
+  result->p50 = bench_nsec(samples[(n - 1) * 50 / 100]);
+  result->p90 = bench_nsec(samples[(n - 1) * 90 / 100]);
+  result->p99 = bench_nsec(samples[(n - 1) * 99 / 100]);
+  result->max = bench_nsec(samples[n - 1]);
+}
+
+/****************************************************************************
+ * Name: bench_start_helper
+ *
+ * Description:
+ *   Start a helper thread on the CPU of the benchmarks.
+ *
+ ****************************************************************************/
+
+static int bench_start_helper(FAR const char *name, int priority,
+                              main_t entry)
+{
+  int ret;
+
+  g_bench.stop = false;
+
+  ret = kthread_create(name, priority, CONFIG_SCHED_BENCH_STACKSIZE,
+                       entry, NULL);
+  if (ret < 0)
+    {
+      serr("ERROR: Failed to start %s: %d\n", name, ret);
+      return ret;
+    }
+
+  g_bench.helper = (pid_t)ret;
+
+#ifdef CONFIG_SMP
+  nxsched_set_affinity(g_bench.helper, sizeof(cpu_set_t), &g_bench.cpuset);
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_sempostwait
+ *
+ * Description:
+ *   Post and take a semaphore in the same thread.
+ *
+ ****************************************************************************/
+
+static int bench_sempostwait(void)
+{
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      nxsem_post(&g_bench.wake);
+      nxsem_wait_uninterruptible(&g_bench.wake);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_semhelper and bench_semwakeup
+ *
+ * Description:
+ *   The time from the post of a semaphore to the return of a higher
+ *   priority thread from its wait.  This includes a context switch.
+ *
+ ****************************************************************************/
+
+static int bench_semhelper(int argc, FAR char *argv[])
+{
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_bench.wake);
+      if (g_bench.stop)
+        {
+          break;
+        }
+
+      bench_record(g_bench.start);
+      nxsem_post(&g_bench.ack);
+    }
+
+  nxsem_post(&g_bench.done);
+  return OK;
+}
+
+static int bench_semwakeup(void)
+{
+  int ret;
+  int i;
+
+  ret = bench_start_helper("bench_sem", BENCH_PRIORITY + 1,
+                           bench_semhelper);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      g_bench.start = up_perf_gettime();
+      nxsem_post(&g_bench.wake);
+      nxsem_wait_uninterruptible(&g_bench.ack);
+    }
+
+  g_bench.stop = true;
+  nxsem_post(&g_bench.wake);
+  nxsem_wait_uninterruptible(&g_bench.done);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_yieldhelper and bench_yield
+ *
+ * Description:
+ *   Two threads of the same priority yield the CPU to each other.  Each
+ *   sample is the time from the call of sched_yield() in one thread to the
+ *   return from sched_yield() in the other.
+ *
+ ****************************************************************************/
+
+static int bench_yieldhelper(int argc, FAR char *argv[])
+{
+  while (!g_bench.stop)
+    {
+      bench_record(g_bench.start);
+      g_bench.start = up_perf_gettime();
+      sched_yield();
+    }
+
+  nxsem_post(&g_bench.done);
+  return OK;
+}
+
+static int bench_yield(void)
+{
+  int ret;
+
+  ret = bench_start_helper("bench_yield", BENCH_PRIORITY,
+                           bench_yieldhelper);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (g_bench.nsamples < BENCH_NSAMPLES)
+    {
+      g_bench.start = up_perf_gettime();
+      sched_yield();
+      bench_record(g_bench.start);
+    }
+
+  g_bench.stop = true;
+  nxsem_wait_uninterruptible(&g_bench.done);
+  return OK;
+}
+
+#ifndef CONFIG_DISABLE_MQUEUE
+/****************************************************************************
+ * Name: bench_mqsendreceive
+ *
+ * Description:
+ *   Send and receive a message in the same thread.
+ *
+ ****************************************************************************/
+
+static int bench_mqsendreceive(void)
+{
+  struct mq_attr attr;
+  struct file mq;
+  char msg[BENCH_MSGSIZE];
+  uint32_t start;
+  unsigned int prio;
+  int ret;
+  int i;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.mq_maxmsg  = 1;
+  attr.mq_msgsize = BENCH_MSGSIZE;
+
+  ret = file_mq_open(&mq, BENCH_MQNAME, O_RDWR | O_CREAT, 0600, &attr);
+  if (ret < 0)
+    {
+      serr("ERROR: file_mq_open failed: %d\n", ret);
+      return ret;
+    }
+
+  memset(msg, 0, sizeof(msg));
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      ret = file_mq_send(&mq, msg, sizeof(msg), 0);
+      if (ret >= 0)
+        {
+          ret = file_mq_receive(&mq, msg, sizeof(msg), &prio);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      bench_record(start);
+    }
+
+  file_mq_close(&mq);
+  file_mq_unlink(BENCH_MQNAME);
+  return ret < 0 ? ret : OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_sighelper and bench_sigwakeup
+ *
+ * Description:
+ *   The time from nxsig_kill() to the return of a higher priority thread
+ *   from its wait for the signal.
+ *
+ ****************************************************************************/
+
+static int bench_sighelper(int argc, FAR char *argv[])
+{
+  struct siginfo info;
+  sigset_t set;
+
+  sigemptyset(&set);
+  sigaddset(&set, BENCH_SIGNO);
+  nxsig_procmask(SIG_BLOCK, &set, NULL);
+
+  nxsem_post(&g_bench.ack);
+
+  for (; ; )
+    {
+      if (nxsig_waitinfo(&set, &info) < 0)
+        {
+          continue;
+        }
+
+      if (g_bench.stop)
+        {
+          break;
+        }
+
+      bench_record(g_bench.start);
+      nxsem_post(&g_bench.ack);
+    }
+
+  nxsem_post(&g_bench.done);
+  return OK;
+}
+
+static int bench_sigwakeup(void)
+{
+  int ret;
+  int i;
+
+  ret = bench_start_helper("bench_sig", BENCH_PRIORITY + 1,
+                           bench_sighelper);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait for the helper to block the signal */
+
+  nxsem_wait_uninterruptible(&g_bench.ack);
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      g_bench.start = up_perf_gettime();
+      ret = nxsig_kill(g_bench.helper, BENCH_SIGNO);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      nxsem_wait_uninterruptible(&g_bench.ack);
+    }
+
+  g_bench.stop = true;
+  nxsig_kill(g_bench.helper, BENCH_SIGNO);
+  nxsem_wait_uninterruptible(&g_bench.done);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: bench_wdnop and bench_wdstartcancel
+ *
+ * Description:
+ *   Start a watchdog timer and cancel it before it expires.
+ *
+ ****************************************************************************/
+
+static void bench_wdnop(wdparm_t arg)
+{
+}
+
+static int bench_wdstartcancel(void)
+{
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      wd_start(&g_bench.wdog, CLK_TCK, bench_wdnop, 0);
+      wd_cancel(&g_bench.wdog);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_malloc
+ *
+ * Description:
+ *   Allocate and free a block of the kernel heap.
+ *
+ ****************************************************************************/
+
+static int bench_malloc(size_t size)
+{
+  FAR void *mem;
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      mem   = kmm_malloc(size);
+      if (mem == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      kmm_free(mem);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_malloc64(void)
+{
+  return bench_malloc(64);
+}
+
+static int bench_malloc1k(void)
+{
+  return bench_malloc(1024);
+}
+
+/****************************************************************************
+ * Name: bench_mallocmixed
+ *
+ * Description:
+ *   Free one of BENCH_NBLOCKS live blocks and allocate another one of a
+ *   different size in its place, from 16 bytes to 1KiB, so that the free
+ *   space of the heap is fragmented.
+ *
+ ****************************************************************************/
+
+static int bench_mallocmixed(void)
+{
+  FAR void *blocks[BENCH_NBLOCKS];
+  uint32_t start;
+  int ret = OK;
+  int i;
+
+  memset(blocks, 0, sizeof(blocks));
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      FAR void **block = &blocks[(i * 7) % BENCH_NBLOCKS];
+      size_t size = 16 * (1 + (i * 37) % 64);
+
+      start = up_perf_gettime();
+      kmm_free(*block);
+      *block = kmm_malloc(size);
+      if (*block == NULL)
+        {
+          ret = -ENOMEM;
+          break;
+        }
+
+      bench_record(start);
+    }
+
+  for (i = 0; i < BENCH_NBLOCKS; i++)
+    {
+      kmm_free(blocks[i]);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bench_irqpost and bench_irqwakeup
+ *
+ * Description:
+ *   The time from the post of a semaphore in the timer interrupt handler
+ *   to the return of the waiting thread.  This includes the end of the
+ *   interrupt handling and a context switch.
+ *
+ ****************************************************************************/
+
+static void bench_irqpost(wdparm_t arg)
+{
+  g_bench.start = up_perf_gettime();
+  nxsem_post(&g_bench.wake);
+}
+
+static int bench_irqwakeup(void)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      ret = wd_start(&g_bench.wdog, 1, bench_irqpost, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      nxsem_wait_uninterruptible(&g_bench.wake);
+      bench_record(g_bench.start);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_memcpy and bench_memmove
+ *
+ * Description:
+ *   Copy 1KiB between the halves of the data buffer, and 1KiB to an
+ *   overlapping destination a few bytes higher.
+ *
+ ****************************************************************************/
+
+static int bench_memcpy(void)
+{
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      memcpy(&g_bench.buf[BENCH_BUFSIZE / 2], g_bench.buf, 1024);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_memmove(void)
+{
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      memmove(&g_bench.buf[12], g_bench.buf, 1024);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_strlen and bench_strcmp
+ *
+ * Description:
+ *   The length of a string of BENCH_STRLEN - 1 characters, and the
+ *   comparison of two copies of it.
+ *
+ ****************************************************************************/
+
+static int bench_strlen(void)
+{
+  uint32_t start;
+  int i;
+
+  memset(g_bench.buf, 'a', BENCH_STRLEN - 1);
+  g_bench.buf[BENCH_STRLEN - 1] = '\0';
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      g_bench.sink = strlen((FAR const char *)g_bench.buf);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_strcmp(void)
+{
+  FAR const char *s1 = (FAR const char *)g_bench.buf;
+  FAR const char *s2 = (FAR const char *)&g_bench.buf[BENCH_BUFSIZE / 2];
+  uint32_t start;
+  int i;
+
+  memset(g_bench.buf, 'a', BENCH_STRLEN - 1);
+  g_bench.buf[BENCH_STRLEN - 1] = '\0';
+  memcpy(&g_bench.buf[BENCH_BUFSIZE / 2], g_bench.buf, BENCH_STRLEN);
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      g_bench.sink = strcmp(s1, s2);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bench_snprintfint and bench_snprintfdbl
+ *
+ * Description:
+ *   Format integers in decimal and hexadecimal, and doubles with %f and
+ *   %e, with different values for each sample.
+ *
+ ****************************************************************************/
+
+static int bench_snprintfint(void)
+{
+  uint32_t start;
+  uint32_t value;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      value = (uint32_t)i * 2654435761u;
+
+      start = up_perf_gettime();
+      g_bench.sink = snprintf((FAR char *)g_bench.buf, BENCH_STRLEN,
+                              "%lu %ld %lx", (unsigned long)value,
+                              -(long)(value >> 1), (unsigned long)value);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+#ifdef CONFIG_LIBC_FLOATINGPOINT
+static int bench_snprintfdbl(void)
+{
+  uint32_t start;
+  double value;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      value = (double)((uint32_t)i * 2654435761u) / 1000.0;
+
+      start = up_perf_gettime();
+      g_bench.sink = snprintf((FAR char *)g_bench.buf, BENCH_STRLEN,
+                              "%f %e", value, value);
+      bench_record(start);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_mathf
+ *
+ * Description:
+ *   Apply a single precision function to BENCH_NFLOATS arguments from
+ *   -scale to scale, one call per argument.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBM
+static int bench_mathf(CODE float (*func)(float), float scale)
+{
+  FAR float *src = (FAR float *)g_bench.buf;
+  FAR float *dst = &src[BENCH_NFLOATS];
+  uint32_t start;
+  int i;
+  int j;
+
+  for (j = 0; j < BENCH_NFLOATS; j++)
+    {
+      src[j] = scale * (2 * j - BENCH_NFLOATS) / BENCH_NFLOATS;
+    }
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      for (j = 0; j < BENCH_NFLOATS; j++)
+        {
+          dst[j] = func(src[j]);
+        }
+
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_expf(void)
+{
+  return bench_mathf(expf, 10.0f);
+}
+
+static int bench_sinf(void)
+{
+  return bench_mathf(sinf, 4.0f);
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_vmathf
+ *
+ * Description:
+ *   The same arguments as bench_mathf(), in one call of a vector function.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBM_VECTOR
+static int bench_vmathf(CODE void (*func)(FAR float *, FAR const float *,
+                                          size_t),
+                        float scale)
+{
+  FAR float *src = (FAR float *)g_bench.buf;
+  FAR float *dst = &src[BENCH_NFLOATS];
+  uint32_t start;
+  int i;
+  int j;
+
+  for (j = 0; j < BENCH_NFLOATS; j++)
+    {
+      src[j] = scale * (2 * j - BENCH_NFLOATS) / BENCH_NFLOATS;
+    }
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      func(dst, src, BENCH_NFLOATS);
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_vexpf(void)
+{
+  return bench_vmathf(vexpf, 10.0f);
+}
+
+static int bench_vsinf(void)
+{
+  return bench_vmathf(vsinf, 4.0f);
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_lzfdecompress
+ *
+ * Description:
+ *   Decompress 1KiB of text, with its literal runs and back references.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZF
+static int bench_lzfdecompress(void)
+{
+  static const char text[] = "The quick brown fox jumps over the lazy dog. ";
+  FAR uint8_t *in = &g_bench.buf[LZF_MAX_HDR_SIZE + 1];
+  FAR uint8_t *out = &in[BENCH_LZFSIZE + LZF_MAX_HDR_SIZE + 1];
+  FAR struct lzf_header_s *header = NULL;
+  FAR lzf_hslot_t *htab;
+  unsigned int outlen;
+  uint32_t start;
+  int i;
+
+  /* Text with a different octet every 61 octets */
+
+  for (i = 0; i < BENCH_LZFSIZE; i++)
+    {
+      in[i] = i % 61 == 0 ? (uint8_t)i : text[i % (sizeof(text) - 1)];
+    }
+
+  /* The hash table of the compression takes 1 << CONFIG_LIBC_LZF_HLOG
+   * slots:  Report no samples if it does not fit in the heap.
+   */
+
+  htab = kmm_malloc(sizeof(lzf_state_t));
+  if (htab == NULL)
+    {
+      return OK;
+    }
+
+  outlen = lzf_compress(in, BENCH_LZFSIZE, out,
+                        BENCH_BUFSIZE - (out - g_bench.buf), htab, &header);
+  kmm_free(htab);
+
+  if (outlen == 0 || header->lzf_type != LZF_TYPE1_HDR)
+    {
+      return -EINVAL;
+    }
+
+  outlen -= LZF_TYPE1_HDR_SIZE;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      if (lzf_decompress(out, outlen, in, BENCH_LZFSIZE) != BENCH_LZFSIZE)
+        {
+          return -EINVAL;
+        }
+
+      bench_record(start);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_netchksum
+ *
+ * Description:
+ *   The Internet checksum of a full Ethernet payload.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET
+static int bench_netchksum(void)
+{
+  uint32_t start;
+  int i;
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      net_chksum((FAR uint16_t *)g_bench.buf, 1500);
+      bench_record(start);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_dsppark and bench_dspparkbatch
+ *
+ * Description:
+ *   The Park transforms of BENCH_NMOTORS motors, one call per motor and
+ *   one batch call.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBDSP
+static int bench_dsppark(void)
+{
+  FAR phase_angle_f32_t *angle = (FAR phase_angle_f32_t *)g_bench.buf;
+  FAR ab_frame_f32_t *ab = (FAR ab_frame_f32_t *)&angle[BENCH_NMOTORS];
+  FAR dq_frame_f32_t *dq = (FAR dq_frame_f32_t *)&ab[BENCH_NMOTORS];
+  uint32_t start;
+  int i;
+  int j;
+
+  for (j = 0; j < BENCH_NMOTORS; j++)
+    {
+      angle[j].angle = 0.0f;
+      angle[j].sin   = 0.6f;
+      angle[j].cos   = 0.8f;
+      ab[j].a        = 0.25f * j;
+      ab[j].b        = 1.0f - 0.25f * j;
+    }
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      for (j = 0; j < BENCH_NMOTORS; j++)
+        {
+          park_transform(&angle[j], &ab[j], &dq[j]);
+        }
+
+      bench_record(start);
+    }
+
+  return OK;
+}
+
+static int bench_dspparkbatch(void)
+{
+  FAR float *data = (FAR float *)g_bench.buf;
+  struct phase_angle_f32_soa_s angle;
+  struct ab_frame_f32_soa_s ab;
+  struct dq_frame_f32_soa_s dq;
+  uint32_t start;
+  int i;
+  int j;
+
+  angle.sin = &data[0 * BENCH_NMOTORS];
+  angle.cos = &data[1 * BENCH_NMOTORS];
+  ab.a      = &data[2 * BENCH_NMOTORS];
+  ab.b      = &data[3 * BENCH_NMOTORS];
+  dq.d      = &data[4 * BENCH_NMOTORS];
+  dq.q      = &data[5 * BENCH_NMOTORS];
+
+  for (j = 0; j < BENCH_NMOTORS; j++)
+    {
+      angle.sin[j] = 0.6f;
+      angle.cos[j] = 0.8f;
+      ab.a[j]      = 0.25f * j;
+      ab.b[j]      = 1.0f - 0.25f * j;
+    }
+
+  for (i = 0; i < BENCH_NSAMPLES; i++)
+    {
+      start = up_perf_gettime();
+      park_transform_batch(&angle, &ab, &dq, BENCH_NMOTORS);
+      bench_record(start);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: bench_thread
+ *
+ * Description:
+ *   Run each benchmark with the samples cleared and summarize its samples.
+ *
+ ****************************************************************************/
+
+static int bench_thread(int argc, FAR char *argv[])
+{
+  int nresults = 0;
+  int ret = OK;
+  int i;
+
+#ifdef CONFIG_SMP
+  /* Run everything on this CPU, so that the context switches are real */
+
+  CPU_ZERO(&g_bench.cpuset);
+  CPU_SET(this_cpu(), &g_bench.cpuset);
+  nxsched_set_affinity(0, sizeof(cpu_set_t), &g_bench.cpuset);
+#endif
+
+  for (i = 0; i < BENCH_NENTRIES && nresults < g_bench.nresults; i++)
+    {
+      g_bench.nsamples = 0;
+
+      ret = g_bench_entries[i].func();
+      if (ret < 0)
+        {
+          serr("ERROR: %s failed: %d\n", g_bench_entries[i].name, ret);
+          break;
+        }
+
+      bench_summarize(&g_bench.results[nresults++],
+                      g_bench_entries[i].name);
+    }
+
+  g_bench.ret = ret < 0 ? ret : nresults;
+  nxsem_post(&g_bench.done);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_bench
+ *
+ * Description:
+ *   Run the benchmarks of the kernel primitives in a thread of priority
+ *   CONFIG_SCHED_BENCH_PRIORITY and wait for their results.  Only one run
+ *   may be in progress at a time.
+ *
+ * Input Parameters:
+ *   results  - The location to return the results
+ *   nresults - The number of entries of results
+ *
+ * Returned Value:
+ *   The number of results on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_bench(FAR struct sched_bench_s *results, int nresults)
+{
+  int ret;
+  int i;
+
+  DEBUGASSERT(results != NULL && nresults > 0);
+
+  ret = nxsem_wait(&g_bench_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memset(&g_bench, 0, sizeof(g_bench));
+  g_bench.results  = results;
+  g_bench.nresults = nresults;
+
+  g_bench.samples = kmm_malloc(BENCH_NSAMPLES * sizeof(uint32_t));
+  if (g_bench.samples == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  g_bench.buf = kmm_malloc(BENCH_BUFSIZE);
+  if (g_bench.buf == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_samples;
+    }
+
+  /* The data buffer holds all byte values */
+
+  for (i = 0; i < BENCH_BUFSIZE; i++)
+    {
+      g_bench.buf[i] = (uint8_t)(i * 131 + 7);
+    }
+
+  /* The semaphores are used for signaling */
+
+  nxsem_init(&g_bench.wake, 0, 0);
+  nxsem_init(&g_bench.ack, 0, 0);
+  nxsem_init(&g_bench.done, 0, 0);
+  nxsem_set_protocol(&g_bench.wake, SEM_PRIO_NONE);
+  nxsem_set_protocol(&g_bench.ack, SEM_PRIO_NONE);
+  nxsem_set_protocol(&g_bench.done, SEM_PRIO_NONE);
+
+  ret = kthread_create("sched_bench", BENCH_PRIORITY,
+                       CONFIG_SCHED_BENCH_STACKSIZE, bench_thread, NULL);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&g_bench.done);
+      ret = g_bench.ret;
+    }
+
+  nxsem_destroy(&g_bench.wake);
+  nxsem_destroy(&g_bench.ack);
+  nxsem_destroy(&g_bench.done);
+  kmm_free(g_bench.buf);
+
+errout_with_samples:
+  kmm_free(g_bench.samples);
+
+errout_with_lock:
+  nxsem_post(&g_bench_lock);
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_BENCH */
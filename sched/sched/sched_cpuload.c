@@ -24,9 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <errno.h>
 #include <assert.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/irq.h>
 
@@ -56,10 +58,20 @@
  * will be incremented multiple times per tick.
  */
 
-#define CPULOAD_TIMECONSTANT \
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+#  define CPULOAD_TIMECONSTANT nxsched_cpuload_timeconstant()
+#else
+#  define CPULOAD_TIMECONSTANT \
      (CONFIG_SMP_NCPUS * \
       CONFIG_SCHED_CPULOAD_TIMECONSTANT * \
       CPULOAD_TICKSPERSEC)
+#endif
+
+/* The counts reported by clock_cpuload() are scaled down below this limit
+ * so that users can multiply them by 1000 without overflow.
+ */
+
+#define CPULOAD_REPORTMAX 0x003fffff
 
 /****************************************************************************
  * Private Data
@@ -80,10 +92,137 @@
 
 volatile uint32_t g_cpuload_total;
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/* The performance counter value at the entry of the interrupt handler that
+ * is currently executing on each CPU.
+ */
+
+static uint32_t g_cpuload_irqstart[CONFIG_SMP_NCPUS];
+
+/* The time spent in interrupt handlers by each CPU.  The time is collected
+ * by each CPU in g_cpuload_irqpend[] without further locking and added to
+ * g_cpuload_irq[] and g_cpuload_total at the next accounting.
+ */
+
+static uint32_t g_cpuload_irqpend[CONFIG_SMP_NCPUS];
+static uint32_t g_cpuload_irq[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nxsched_cpuload_decay
+ *
+ * Description:
+ *   Divide the counts of every thread by two and recalculate the total.
+ *
+ * Assumptions/Limitations:
+ *   This function is called with all interrupts disabled and within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static void nxsched_cpuload_decay(void)
+{
+  uint32_t total = 0;
+  int i;
+
+  for (i = 0; i < g_npidhash; i++)
+    {
+      if (g_pidhash[i])
+        {
+          g_pidhash[i]->ticks >>= 1;
+          total += g_pidhash[i]->ticks;
+        }
+    }
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      g_cpuload_irq[i] >>= 1;
+      total += g_cpuload_irq[i];
+    }
+#endif
+
+  /* Save the new total. */
+
+  g_cpuload_total = total;
+}
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/****************************************************************************
+ * Name: nxsched_cpuload_timeconstant
+ *
+ * Description:
+ *   Return the time constant in units of the performance counter, limited
+ *   so that the accumulated counts cannot overflow.
+ *
+ ****************************************************************************/
+
+static uint32_t nxsched_cpuload_timeconstant(void)
+{
+  uint32_t freq = up_perf_getfreq();
+
+  if (freq > (UINT32_MAX / 2) /
+             (CONFIG_SMP_NCPUS * CONFIG_SCHED_CPULOAD_TIMECONSTANT))
+    {
+      return UINT32_MAX / 2;
+    }
+
+  return freq * CONFIG_SMP_NCPUS * CONFIG_SCHED_CPULOAD_TIMECONSTANT;
+}
+
+/****************************************************************************
+ * Name: nxsched_cpuload_account
+ *
+ * Description:
+ *   Charge the time since the thread 'tcb' was last accounted to it,
+ *   collect the pending interrupt time of this CPU and restart the
+ *   measurement of the thread.
+ *
+ * Assumptions/Limitations:
+ *   'tcb' is the thread running on this CPU.  This function is called with
+ *   all interrupts disabled and within a critical section.
+ *
+ ****************************************************************************/
+
+static void nxsched_cpuload_account(FAR struct tcb_s *tcb)
+{
+  int cpu = this_cpu();
+  uint32_t elapsed;
+  uint32_t now;
+
+  /* Within an interrupt handler, the thread only ran until the entry of
+   * the handler.
+   */
+
+  now     = up_interrupt_context() ? g_cpuload_irqstart[cpu] :
+                                     up_perf_gettime();
+  elapsed = now - tcb->tick_start;
+
+  /* The thread may have been started by the running handler */
+
+  if ((int32_t)elapsed < 0)
+    {
+      elapsed = 0;
+    }
+
+  tcb->tick_start  = now;
+  tcb->ticks      += elapsed;
+  g_cpuload_total += elapsed;
+
+  g_cpuload_irq[cpu]     += g_cpuload_irqpend[cpu];
+  g_cpuload_total        += g_cpuload_irqpend[cpu];
+  g_cpuload_irqpend[cpu]  = 0;
+
+  if (g_cpuload_total > CPULOAD_TIMECONSTANT)
+    {
+      nxsched_cpuload_decay();
+    }
+}
+#else
 /****************************************************************************
  * Name: nxsched_cpu_process_cpuload
  *
@@ -117,6 +256,7 @@ static inline void nxsched_cpu_process_cpuload(int cpu, uint32_t ticks)
 
   g_cpuload_total += ticks;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -145,13 +285,23 @@ static inline void nxsched_cpu_process_cpuload(int cpu, uint32_t ticks)
 
 void nxsched_process_cpuload_ticks(uint32_t ticks)
 {
-  int i;
   irqstate_t flags;
-
-  /* Perform scheduler operations on all CPUs. */
+#ifndef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  int i;
+#endif
 
   flags = enter_critical_section();
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* The ticks are not sampled, only bring the time of the thread running
+   * on this CPU up to date.
+   */
+
+  UNUSED(ticks);
+  nxsched_cpuload_account(this_task());
+#else
+  /* Perform scheduler operations on all CPUs. */
+
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
       nxsched_cpu_process_cpuload(i, ticks);
@@ -163,28 +313,91 @@ void nxsched_process_cpuload_ticks(uint32_t ticks)
 
   if (g_cpuload_total > CPULOAD_TIMECONSTANT)
     {
-      uint32_t total = 0;
+      nxsched_cpuload_decay();
+    }
+#endif
 
-      /* Divide the tick count for every task by two and recalculate the
-       * total.
-       */
+  leave_critical_section(flags);
+}
 
-      for (i = 0; i < g_npidhash; i++)
-        {
-          if (g_pidhash[i])
-            {
-              g_pidhash[i]->ticks >>= 1;
-              total += g_pidhash[i]->ticks;
-            }
-        }
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/****************************************************************************
+ * Name: nxsched_suspend_cpuload
+ *
+ * Description:
+ *   Called by nxsched_suspend_scheduler() to charge the time the thread
+ *   that is being suspended has run.
+ *
+ * Assumptions/Limitations:
+ *   Called with all interrupts disabled and within a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_cpuload(FAR struct tcb_s *tcb)
+{
+  nxsched_cpuload_account(tcb);
+}
 
-      /* Save the new total. */
+/****************************************************************************
+ * Name: nxsched_resume_cpuload
+ *
+ * Description:
+ *   Called by nxsched_resume_scheduler() to start measuring the time the
+ *   thread that is being resumed runs.
+ *
+ ****************************************************************************/
 
-      g_cpuload_total = total;
-    }
+void nxsched_resume_cpuload(FAR struct tcb_s *tcb)
+{
+  tcb->tick_start = up_perf_gettime();
+}
 
-  leave_critical_section(flags);
+/****************************************************************************
+ * Name: nxsched_cpuload_irqenter
+ *
+ * Description:
+ *   Called by irq_dispatch() before the interrupt handler is called.
+ *
+ ****************************************************************************/
+
+void nxsched_cpuload_irqenter(void)
+{
+  g_cpuload_irqstart[this_cpu()] = up_perf_gettime();
+}
+
+/****************************************************************************
+ * Name: nxsched_cpuload_irqleave
+ *
+ * Description:
+ *   Called by irq_dispatch() after the interrupt handler returned.  The
+ *   time spent in the handler is charged to the interrupt load of this CPU
+ *   instead of the thread running on it.
+ *
+ ****************************************************************************/
+
+void nxsched_cpuload_irqleave(void)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  int cpu = this_cpu();
+  uint32_t now = up_perf_gettime();
+  uint32_t elapsed = now - g_cpuload_irqstart[cpu];
+
+  g_cpuload_irqpend[cpu] += elapsed;
+
+  /* Exclude the time of the handler from the running thread.  A thread
+   * resumed by the handler starts running now.
+   */
+
+  if (now - rtcb->tick_start >= elapsed)
+    {
+      rtcb->tick_start += elapsed;
+    }
+  else
+    {
+      rtcb->tick_start = now;
+    }
 }
+#endif
 
 /****************************************************************************
  * Name:  clock_cpuload
@@ -222,6 +435,12 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
   flags = enter_critical_section();
   hash_index = PIDHASH(pid);
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* Bring the time of the thread running on this CPU up to date */
+
+  nxsched_cpuload_account(this_task());
+#endif
+
   /* Make sure that the entry is valid (TCB field is not NULL) and matches
    * the requested PID.  The first check is needed if the thread has exited.
    * The second check is needed for the case where the task associated with
@@ -243,7 +462,63 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
     }
 
   leave_critical_section(flags);
+
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+  /* Scale the performance counter values down to the range of ticks */
+
+  while (ret == OK && cpuload->total > CPULOAD_REPORTMAX)
+    {
+      cpuload->total  >>= 1;
+      cpuload->active >>= 1;
+    }
+#endif
+
   return ret;
 }
 
+#ifdef CONFIG_SCHED_CPULOAD_PERFCOUNT
+/****************************************************************************
+ * Name:  clock_cpuload_irq
+ *
+ * Description:
+ *   Return the load measurement data of the interrupt handlers of a CPU.
+ *
+ * Input Parameters:
+ *   cpu - The CPU of interest
+ *   cpuload - The location to return the CPU load
+ *
+ * Returned Value:
+ *   OK (0) on success; -EINVAL if 'cpu' is not a valid CPU index.
+ *
+ ****************************************************************************/
+
+int clock_cpuload_irq(int cpu, FAR struct cpuload_s *cpuload)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(cpuload);
+
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  nxsched_cpuload_account(this_task());
+  cpuload->total  = g_cpuload_total;
+  cpuload->active = g_cpuload_irq[cpu];
+
+  leave_critical_section(flags);
+
+  while (cpuload->total > CPULOAD_REPORTMAX)
+    {
+      cpuload->total  >>= 1;
+      cpuload->active >>= 1;
+    }
+
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_SCHED_CPULOAD */
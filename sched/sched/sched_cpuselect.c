@@ -50,6 +50,9 @@
  *   Return the index to the CPU with the lowest priority running task,
  *   possibly its IDLE task.
  *
+ *   CPUs whose running task has pre-emption disabled are only selected if
+ *   there is no other CPU in 'affinity'.
+ *
  * Input Parameters:
  *   affinity - The set of CPUs on which the thread is permitted to run.
  *
@@ -63,12 +66,16 @@
 
 int nxsched_select_cpu(cpu_set_t affinity)
 {
+  unsigned int lockprio;
   uint8_t minprio;
+  int lockcpu;
   int cpu;
   int i;
 
-  minprio = SCHED_PRIORITY_MAX;
-  cpu     = IMPOSSIBLE_CPU;
+  minprio  = SCHED_PRIORITY_MAX;
+  cpu      = IMPOSSIBLE_CPU;
+  lockprio = SCHED_PRIORITY_MAX + 1;
+  lockcpu  = IMPOSSIBLE_CPU;
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
@@ -79,11 +86,24 @@ int nxsched_select_cpu(cpu_set_t affinity)
           FAR struct tcb_s *rtcb = (FAR struct tcb_s *)
                                    g_assignedtasks[i].head;
 
+          /* The running task cannot be preempted while it has pre-emption
+           * disabled.  Remember the CPU in case that there is no other.
+           */
+
+          if (nxsched_islocked_tcb(rtcb))
+            {
+              if (rtcb->sched_priority < lockprio)
+                {
+                  lockprio = rtcb->sched_priority;
+                  lockcpu  = i;
+                }
+            }
+
           /* If this CPU is executing its IDLE task, then use it.  The
            * IDLE task is always the last task in the assigned task list.
            */
 
-          if (rtcb->flink == NULL)
+          else if (rtcb->flink == NULL)
             {
               /* The IDLE task should always be assigned to this CPU and have
                * a priority of zero.
@@ -101,6 +121,11 @@ int nxsched_select_cpu(cpu_set_t affinity)
         }
     }
 
+  if (cpu == IMPOSSIBLE_CPU)
+    {
+      cpu = lockcpu;
+    }
+
   DEBUGASSERT(cpu != IMPOSSIBLE_CPU);
   return cpu;
 }
@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <sched.h>
+#include <strings.h>
 #include <assert.h>
 
 #include "sched/sched.h"
@@ -114,6 +115,13 @@ static uint32_t g_crit_start[CONFIG_SMP_NCPUS];
 uint32_t g_premp_max[CONFIG_SMP_NCPUS];
 uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+/* Histograms of the wakeup latencies per priority band */
+
+uint32_t g_wakeup_hist[CONFIG_SCHED_CRITMONITOR_WAKEUP_NBANDS]
+                      [CRITMON_WAKEUP_NBUCKETS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -214,6 +222,33 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
     }
 }
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+/****************************************************************************
+ * Name: nxsched_wakeup_critmon
+ *
+ * Description:
+ *   Called when a thread is made ready-to-run.  The time until it runs is
+ *   recorded by nxsched_resume_critmon().
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_critmon(FAR struct tcb_s *tcb)
+{
+  /* Keep the earlier time if the task only moves, e.g. from the pending
+   * list to the ready-to-run list.
+   */
+
+  if (tcb->wakeup_start == 0)
+    {
+      tcb->wakeup_start = up_perf_gettime();
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxsched_resume_critmon
  *
@@ -235,6 +270,25 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
 
   tcb->run_start = current;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_WAKEUP
+  /* Was this task made ready-to-run? */
+
+  if (tcb->wakeup_start != 0)
+    {
+      /* Yes.. Record the time it waited to run */
+
+      elapsed = current - tcb->wakeup_start;
+      if (elapsed > tcb->wakeup_max)
+        {
+          tcb->wakeup_max = elapsed;
+        }
+
+      g_wakeup_hist[CRITMON_WAKEUP_BAND(tcb->sched_priority)]
+                   [elapsed > 0 ? fls(elapsed) - 1 : 0]++;
+      tcb->wakeup_start = 0;
+    }
+#endif
+
   /* Did this task disable pre-emption? */
 
   if (tcb->lockcount > 0)
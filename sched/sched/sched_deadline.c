@@ -0,0 +1,381 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wdog.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The CPU bandwidth that may be admitted to deadline threads, per mille */
+
+#define DEADLINE_MAXBANDWIDTH \
+  (CONFIG_SCHED_DEADLINE_MAXUTIL * 10 * CONFIG_SMP_NCPUS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The sum of the CPU bandwidth admitted to all deadline threads */
+
+static uint32_t g_deadline_bandwidth;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_set_priority
+ *
+ * Description:
+ *   Change the priority of a deadline thread when its budget is used up or
+ *   refilled.
+ *
+ * Input Parameters:
+ *   tcb      - TCB of the deadline thread
+ *   priority - The new (base) priority
+ *
+ ****************************************************************************/
+
+static void deadline_set_priority(FAR struct tcb_s *tcb, int priority)
+{
+  int ret;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* If the priority is currently boosted above the new priority, just set
+   * the base priority and continue to run at the boosted priority.
+   */
+
+  if (tcb->sched_priority > tcb->base_priority &&
+      tcb->sched_priority > priority)
+    {
+      tcb->base_priority = priority;
+      return;
+    }
+#endif
+
+  ret = nxsched_reprioritize(tcb, priority);
+  if (ret < 0)
+    {
+      serr("ERROR: nxsched_reprioritize failed: %d\n", ret);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_period_expire
+ *
+ * Description:
+ *   Start the next period of a deadline thread:  Move its absolute deadline
+ *   forward, refill its budget and sort it again into its list.
+ *
+ * Input Parameters:
+ *   arg - The deadline structure of the thread
+ *
+ * Assumptions:
+ *   Called from the watchdog timer interrupt handler.
+ *
+ ****************************************************************************/
+
+static void deadline_period_expire(wdparm_t arg)
+{
+  FAR struct deadline_s *deadline = (FAR struct deadline_s *)arg;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  DEBUGASSERT(deadline != NULL && deadline->tcb != NULL);
+  tcb = deadline->tcb;
+
+  flags = enter_critical_section();
+
+  DEBUGVERIFY(wd_start(&deadline->timer, deadline->period,
+                       deadline_period_expire, (wdparm_t)deadline));
+
+  deadline->absdeadline = clock_systime_ticks() + deadline->deadline;
+  tcb->timeslice        = deadline->runtime;
+
+  if (deadline->throttled)
+    {
+      /* Return to the priority of the thread */
+
+      deadline->throttled = false;
+      deadline_set_priority(tcb, deadline->hi_priority);
+    }
+  else
+    {
+      /* Re-sort the thread among the threads of the same priority */
+
+      nxsched_set_priority(tcb, tcb->sched_priority);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Called to start (or restart) deadline scheduling for a thread.  The
+ *   first period begins immediately.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB of the thread that is beginning deadline scheduling
+ *   priority - The priority of the thread while it is within its budget
+ *   runtime  - The execution budget per period in clock ticks
+ *   reldl    - The deadline relative to the start of each period in ticks
+ *   period   - The period in clock ticks
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *
+ *   EINVAL The parameters do not satisfy 0 < runtime <= deadline <= period
+ *   EBUSY  Admitting the thread would exceed CONFIG_SCHED_DEADLINE_MAXUTIL
+ *   ENOMEM The deadline structure could not be allocated
+ *
+ * Assumptions:
+ *   Called in a critical section with the scheduler locked.
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb, int priority,
+                           uint32_t runtime, uint32_t reldl,
+                           uint32_t period)
+{
+  FAR struct deadline_s *deadline;
+  uint32_t bandwidth;
+  uint32_t admitted;
+
+  DEBUGASSERT(tcb != NULL);
+
+  if (runtime < 1 || runtime > reldl || reldl > period)
+    {
+      return -EINVAL;
+    }
+
+  /* Admission control:  The sum of the CPU bandwidth of all deadline
+   * threads must not exceed the configured limit.
+   */
+
+  bandwidth = (uint32_t)(((uint64_t)runtime * 1000 + period - 1) / period);
+  admitted  = g_deadline_bandwidth;
+
+  deadline  = tcb->deadline;
+  if (deadline != NULL)
+    {
+      admitted -= deadline->bandwidth;
+    }
+
+  if (admitted + bandwidth > DEADLINE_MAXBANDWIDTH)
+    {
+      return -EBUSY;
+    }
+
+  if (deadline == NULL)
+    {
+      deadline = (FAR struct deadline_s *)
+        kmm_zalloc(sizeof(struct deadline_s));
+      if (deadline == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      deadline->tcb = tcb;
+      tcb->deadline = deadline;
+    }
+  else
+    {
+      wd_cancel(&deadline->timer);
+    }
+
+  g_deadline_bandwidth  = admitted + bandwidth;
+
+  deadline->bandwidth   = bandwidth;
+  deadline->hi_priority = priority;
+  deadline->throttled   = false;
+  deadline->runtime     = runtime;
+  deadline->deadline    = reldl;
+  deadline->period      = period;
+  deadline->absdeadline = clock_systime_ticks() + reldl;
+  tcb->timeslice        = runtime;
+
+  return wd_start(&deadline->timer, period, deadline_period_expire,
+                  (wdparm_t)deadline);
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Called to terminate deadline scheduling of a thread, either because
+ *   its scheduling policy is changed or because it exits.  The bandwidth of
+ *   the thread is released.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is ending deadline scheduling.
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *deadline;
+  irqstate_t flags;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+
+  flags    = enter_critical_section();
+  deadline = tcb->deadline;
+
+  wd_cancel(&deadline->timer);
+
+  DEBUGASSERT(g_deadline_bandwidth >= deadline->bandwidth);
+  g_deadline_bandwidth -= deadline->bandwidth;
+
+  tcb->deadline  = NULL;
+  tcb->timeslice = 0;
+  leave_critical_section(flags);
+
+  kmm_free(deadline);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_process_deadline
+ *
+ * Description:
+ *   Process the elapsed time interval.  Called from the timer interrupt
+ *   handler while the thread with deadline scheduling is running.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the running deadline thread.
+ *   ticks      - The number of elapsed ticks since the last time this
+ *                function was called.
+ *   noswitches - We are running in a context where context switching is
+ *                not permitted.
+ *
+ * Returned Value:
+ *   The number of ticks remaining in the budget of the current period.
+ *   Zero is returned if the budget is used up.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches)
+{
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL && ticks > 0);
+
+  /* > 0: Within the budget
+   * == 0: Throttled until the next period
+   *  < 0: Budget used up while the scheduler was locked
+   */
+
+  if (tcb->timeslice <= 0)
+    {
+      return 0;
+    }
+
+  if (ticks < tcb->timeslice)
+    {
+      tcb->timeslice -= ticks;
+      return tcb->timeslice;
+    }
+
+  /* The budget is used up.  If the thread holds the scheduler lock, then
+   * sched_unlock() will throttle it.
+   */
+
+  if (nxsched_islocked_tcb(tcb))
+    {
+      tcb->timeslice = -1;
+      return 0;
+    }
+
+  /* Throttle from the normal timer expiration context if context switches
+   * are not permitted now.
+   */
+
+  if (noswitches)
+    {
+      tcb->timeslice = 1;
+      return 1;
+    }
+
+  nxsched_deadline_throttle(tcb);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: nxsched_deadline_throttle
+ *
+ * Description:
+ *   Drop a deadline thread that used up its budget to the lowest priority
+ *   until its next period begins.  Called from the timer interrupt handler
+ *   or from sched_unlock() if the budget was used up while the scheduler
+ *   was locked.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the deadline thread.
+ *
+ ****************************************************************************/
+
+void nxsched_deadline_throttle(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *deadline;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  deadline = tcb->deadline;
+
+  tcb->timeslice = 0;
+  if (!deadline->throttled)
+    {
+      deadline->throttled = true;
+      deadline_set_priority(tcb, SCHED_PRIORITY_MIN);
+    }
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
@@ -135,6 +135,33 @@ int nxsched_get_param(pid_t pid, FAR struct sched_param *param)
               param->sched_ss_init_budget.tv_nsec = 0;
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          if (tcb->deadline != NULL)
+            {
+              FAR struct deadline_s *deadline = tcb->deadline;
+
+              /* Return parameters associated with SCHED_DEADLINE */
+
+              param->sched_priority = (int)deadline->hi_priority;
+
+              clock_ticks2time((sclock_t)deadline->runtime,
+                               &param->sched_dl_runtime);
+              clock_ticks2time((sclock_t)deadline->deadline,
+                               &param->sched_dl_deadline);
+              clock_ticks2time((sclock_t)deadline->period,
+                               &param->sched_dl_period);
+            }
+          else
+            {
+              param->sched_dl_runtime.tv_sec   = 0;
+              param->sched_dl_runtime.tv_nsec  = 0;
+              param->sched_dl_deadline.tv_sec  = 0;
+              param->sched_dl_deadline.tv_nsec = 0;
+              param->sched_dl_period.tv_sec    = 0;
+              param->sched_dl_period.tv_nsec   = 0;
+            }
+#endif
         }
 
       sched_unlock();
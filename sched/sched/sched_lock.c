@@ -57,55 +57,10 @@
  * modify its lockcount.
  */
 
-#ifdef CONFIG_SMP
-/* In the multiple CPU, SMP case, disabling context switches will not give a
- * task exclusive access to the (multiple) CPU resources (at least without
- * stopping the other CPUs): Even though pre-emption is disabled, other
- * threads will still be executing on the other CPUS.
- *
- * There are additional rules for this multi-CPU case:
- *
- * 1. There is a global lock count 'g_cpu_lockset' that includes a bit for
- *    each CPU: If the bit is '1', then the corresponding CPU has the
- *    scheduler locked; if '0', then the CPU does not have the scheduler
- *    locked.
- * 2. Scheduling logic would set the bit associated with the cpu in
- *    'g_cpu_lockset' when the TCB at the head of the g_assignedtasks[cpu]
- *    list transitions has 'lockcount' > 0. This might happen when
- *    sched_lock() is called, or after a context switch that changes the
- *    TCB at the head of the g_assignedtasks[cpu] list.
- * 3. Similarly, the cpu bit in the global 'g_cpu_lockset' would be cleared
- *    when the TCB at the head of the g_assignedtasks[cpu] list has
- *    'lockcount' == 0. This might happen when sched_unlock() is called, or
- *    after a context switch that changes the TCB at the head of the
- *    g_assignedtasks[cpu] list.
- * 4. Modification of the global 'g_cpu_lockset' must be protected by a
- *    spinlock, 'g_cpu_schedlock'. That spinlock would be taken when
- *    sched_lock() is called, and released when sched_unlock() is called.
- *    This assures that the scheduler does enforce the critical section.
- *    NOTE: Because of this spinlock, there should never be more than one
- *    bit set in 'g_cpu_lockset'; attempts to set additional bits should
- *    cause the CPU to block on the spinlock.  However, additional bits
- *    could get set in 'g_cpu_lockset' due to the context switches on the
- *    various CPUs.
- * 5. Each time the head of a g_assignedtasks[] list changes and the
- *    scheduler modifies 'g_cpu_lockset', it must also set 'g_cpu_schedlock'
- *    depending on the new state of 'g_cpu_lockset'.
- * 5. Logic that currently uses the currently running tasks lockcount
- *    instead uses the global 'g_cpu_schedlock'. A value of SP_UNLOCKED
- *    means that no CPU has pre-emption disabled; SP_LOCKED means that at
- *    least one CPU has pre-emption disabled.
+/* In the SMP case, pre-emption is disabled only on the CPU of the task
+ * that holds the lock.  See the description in sched/sched/sched.h.
  */
 
-volatile spinlock_t g_cpu_schedlock = SP_UNLOCKED;
-
-/* Used to keep track of which CPU(s) hold the IRQ lock. */
-
-volatile spinlock_t g_cpu_locksetlock;
-volatile cpu_set_t g_cpu_lockset;
-
-#endif /* CONFIG_SMP */
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -120,6 +75,9 @@ volatile cpu_set_t g_cpu_lockset;
  *   either calls  sched_unlock() (the appropriate number of times) or
  *   until it blocks itself.
  *
+ *   In the SMP case, this only applies to the CPU that executes the
+ *   calling task.  Tasks continue to be scheduled on the other CPUs.
+ *
  * Input Parameters:
  *   None
  *
@@ -128,18 +86,9 @@ volatile cpu_set_t g_cpu_lockset;
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SMP
-
 int sched_lock(void)
 {
-  FAR struct tcb_s *rtcb;
-
-  /* If the CPU supports suppression of interprocessor interrupts, then
-   * simple disabling interrupts will provide sufficient protection for
-   * the following operation.
-   */
-
-  rtcb = this_task();
+  FAR struct tcb_s *rtcb = this_task();
 
   /* Check for some special cases:  (1) rtcb may be NULL only during early
    * boot-up phases, and (2) sched_lock() should have no effect if called
@@ -154,34 +103,13 @@ int sched_lock(void)
 
       DEBUGASSERT(rtcb->lockcount < MAX_LOCK_COUNT);
 
-      irqstate_t flags = enter_critical_section();
-
-      /* We must hold the lock on this CPU before we increment the lockcount
-       * for the first time. Holding the lock is sufficient to lockout
-       * context switching.
+#ifdef CONFIG_SMP
+      /* Only the executing task modifies its lockcount.  But keep the
+       * increment and the instrumentation below on the same CPU.
        */
 
-      if (rtcb->lockcount == 0)
-        {
-          /* We don't have the scheduler locked.  But logic running on a
-           * different CPU may have the scheduler locked.  It is not
-           * possible for some other task on this CPU to have the scheduler
-           * locked (or we would not be executing!).
-           */
-
-          spin_setbit(&g_cpu_lockset, this_cpu(), &g_cpu_locksetlock,
-                      &g_cpu_schedlock);
-        }
-      else
-        {
-          /* If this thread already has the scheduler locked, then
-           * g_cpu_schedlock() should indicate that the scheduler is locked
-           * and g_cpu_lockset should include the bit setting for this CPU.
-           */
-
-          DEBUGASSERT(g_cpu_schedlock == SP_LOCKED &&
-                      (g_cpu_lockset & (1 << this_cpu())) != 0);
-        }
+      irqstate_t flags = up_irq_save();
+#endif
 
       /* A counter is used to support locking.  This allows nested lock
        * operations on this thread (on any CPU)
@@ -206,65 +134,10 @@ int sched_lock(void)
         }
 #endif
 
-      /* Move any tasks in the ready-to-run list to the pending task list
-       * where they will not be available to run until the scheduler is
-       * unlocked and nxsched_merge_pending() is called.
-       */
-
-      nxsched_merge_prioritized(&g_readytorun,
-                                &g_pendingtasks,
-                                TSTATE_TASK_PENDING);
-
-      leave_critical_section(flags);
-    }
-
-  return OK;
-}
-
-#else /* CONFIG_SMP */
-
-int sched_lock(void)
-{
-  FAR struct tcb_s *rtcb = this_task();
-
-  /* Check for some special cases:  (1) rtcb may be NULL only during early
-   * boot-up phases, and (2) sched_lock() should have no effect if called
-   * from the interrupt level.
-   */
-
-  if (rtcb != NULL && !up_interrupt_context())
-    {
-      /* Catch attempts to increment the lockcount beyond the range of the
-       * integer type.
-       */
-
-      DEBUGASSERT(rtcb->lockcount < MAX_LOCK_COUNT);
-
-      /* A counter is used to support locking.  This allows nested lock
-       * operations on this thread (on any CPU)
-       */
-
-      rtcb->lockcount++;
-
-#if defined(CONFIG_SCHED_INSTRUMENTATION_PREEMPTION) || \
-    defined(CONFIG_SCHED_CRITMONITOR)
-      /* Check if we just acquired the lock */
-
-      if (rtcb->lockcount == 1)
-        {
-          /* Note that we have pre-emption locked */
-
-#ifdef CONFIG_SCHED_CRITMONITOR
-          nxsched_critmon_preemption(rtcb, true);
-#endif
-#ifdef CONFIG_SCHED_INSTRUMENTATION_PREEMPTION
-          sched_note_premption(rtcb, true);
-#endif
-        }
+#ifdef CONFIG_SMP
+      up_irq_restore(flags);
 #endif
     }
 
   return OK;
 }
-
-#endif /* CONFIG_SMP */
@@ -37,10 +37,29 @@
 #include "sched/sched.h"
 
 /****************************************************************************
- * Pre-processor Definitions
+ * Private Functions
  ****************************************************************************/
 
-#define ALL_CPUS ((cpu_set_t)-1)
+/****************************************************************************
+ * Name: nxsched_pending_cpu
+ *
+ * Description:
+ *   Return the CPU that nxsched_add_readytorun() would select for the
+ *   pending task 'tcb'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static int nxsched_pending_cpu(FAR struct tcb_s *tcb)
+{
+  if ((tcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
+    {
+      return tcb->cpu;
+    }
+
+  return nxsched_select_cpu(tcb->affinity);
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -99,7 +118,7 @@ bool nxsched_merge_pending(void)
        */
 
       for (;
-           (rtcb && ptcb->sched_priority <= rtcb->sched_priority);
+           (rtcb && !nxsched_runs_before(ptcb, rtcb));
            rtcb = rtcb->flink)
         {
         }
@@ -186,12 +205,11 @@ bool nxsched_merge_pending(void)
 
   /* Remove and process every TCB in the g_pendingtasks list.
    *
-   * Do nothing if (1) pre-emption is still disabled (by any CPU), or (2) if
-   * some CPU other than this one is in a critical section.
+   * Do nothing if some CPU other than this one is in a critical section.
    */
 
   me = this_cpu();
-  if (!nxsched_islocked_global() && !irq_cpu_locked(me))
+  if (!irq_cpu_locked(me))
     {
       /* Find the CPU that is executing the lowest priority task */
 
@@ -203,7 +221,7 @@ bool nxsched_merge_pending(void)
           goto errout;
         }
 
-      cpu  = nxsched_select_cpu(ALL_CPUS); /* REVISIT:  Maybe ptcb->affinity */
+      cpu  = nxsched_pending_cpu(ptcb);
       rtcb = current_task(cpu);
 
       /* Loop while there is a higher priority task in the pending task list
@@ -213,9 +231,14 @@ bool nxsched_merge_pending(void)
        * times.  That number could be larger, however, if the CPU affinity
        * sets do not include all CPUs. In that case, the excess TCBs will
        * end up in the g_readytorun list.
+       *
+       * Stop if pre-emption is disabled on the CPU that would run the
+       * pending task.  The remaining tasks stay pending until that CPU
+       * re-enables pre-emption.
        */
 
-      while (ptcb->sched_priority > rtcb->sched_priority)
+      while (nxsched_runs_before(ptcb, rtcb) &&
+             !nxsched_islocked_tcb(rtcb))
         {
           /* Remove the task from the pending task list */
 
@@ -229,7 +252,7 @@ bool nxsched_merge_pending(void)
            * Check if that happened.
            */
 
-          if (nxsched_islocked_global() || irq_cpu_locked(me))
+          if (irq_cpu_locked(me))
             {
               /* Yes.. then we may have incorrectly placed some TCBs in the
                * g_readytorun list (unlikely, but possible).  We will have to
@@ -257,10 +280,19 @@ bool nxsched_merge_pending(void)
               goto errout;
             }
 
-          cpu  = nxsched_select_cpu(ALL_CPUS); /* REVISIT:  Maybe ptcb->affinity */
+          cpu  = nxsched_pending_cpu(ptcb);
           rtcb = current_task(cpu);
         }
 
+      /* Leave the remaining tasks pending if they would preempt a CPU with
+       * pre-emption disabled.
+       */
+
+      if (nxsched_islocked_tcb(rtcb))
+        {
+          goto errout;
+        }
+
       /* No more pending tasks can be made running.  Move any remaining
        * tasks in the pending task list to the ready-to-run task list.
        */
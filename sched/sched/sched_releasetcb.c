@@ -33,6 +33,8 @@
 
 #include "sched/sched.h"
 #include "group/group.h"
+#include "signal/signal.h"
+#include "task/task.h"
 #include "timer/timer.h"
 
 /****************************************************************************
@@ -111,6 +113,12 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
       timer_deleteall(tcb->pid);
 #endif
 
+#ifdef CONFIG_SMP_CALL
+      /* Remove any signal action request still queued for another CPU */
+
+      nxsched_smp_call_cancel(&tcb->sigcall);
+#endif
+
       /* Release the task's process ID if one was assigned.  PID
        * zero is reserved for the IDLE task.  The TCB of the IDLE
        * task is never release so a value of zero simply means that
@@ -122,12 +130,14 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
           nxsched_releasepid(tcb->pid);
         }
 
+#ifndef CONFIG_SCHED_TCB_CACHE
       /* Delete the thread's stack if one has been allocated */
 
       if (tcb->stack_alloc_ptr)
         {
           up_release_stack(tcb, ttype);
         }
+#endif
 
 #ifdef CONFIG_PIC
       /* Delete the task's allocated DSpace region (external modules only) */
@@ -161,6 +171,26 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       group_leave(tcb);
 
+      /* Release the private pool of pending signal actions */
+
+      nxsig_free_taskpool(tcb);
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+      /* Keep the TCB and its stack for a new thread if possible.  Otherwise
+       * delete the thread's stack if one has been allocated.
+       */
+
+      if (nxtask_tcbcache_put(tcb, ttype))
+        {
+          return ret;
+        }
+
+      if (tcb->stack_alloc_ptr)
+        {
+          up_release_stack(tcb, ttype);
+        }
+#endif
+
       /* And, finally, release the TCB itself */
 
       kmm_free(tcb);
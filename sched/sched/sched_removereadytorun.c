@@ -184,12 +184,13 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * g_readytorun list.  We can only select a task from that list if
        * the affinity mask includes the current CPU.
        *
-       * If pre-emption is locked or another CPU is in a critical section,
-       * then use the 'nxttcb' which will probably be the IDLE thread.
+       * If another CPU is in a critical section, then use the 'nxttcb'
+       * which will probably be the IDLE thread.  Pre-emption disabled on
+       * other CPUs does not matter here.
        * REVISIT: What if it is not the IDLE thread?
        */
 
-      if (!nxsched_islocked_global() && !irq_cpu_locked(me))
+      if (!irq_cpu_locked(me))
         {
           /* Search for the highest priority task that can run on this
            * CPU.
@@ -207,7 +208,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * task from the g_readytorun list with matching affinity (rtrtcb).
        */
 
-      if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
+      if (rtrtcb != NULL && !nxsched_runs_before(nxttcb, rtrtcb))
         {
           /* The TCB rtrtcb has the higher priority and it can be run on
            * target CPU. Remove that task (rtrtcb) from the g_readytorun
@@ -221,25 +222,6 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
           nxttcb = rtrtcb;
         }
 
-      /* Will pre-emption be disabled after the switch?  If the lockcount is
-       * greater than zero, then this task/this CPU holds the scheduler lock.
-       */
-
-      if (nxttcb->lockcount > 0)
-        {
-          /* Yes... make sure that scheduling logic knows about this */
-
-          spin_setbit(&g_cpu_lockset, cpu, &g_cpu_locksetlock,
-                      &g_cpu_schedlock);
-        }
-      else
-        {
-          /* No.. we may need to perform release our hold on the lock. */
-
-          spin_clrbit(&g_cpu_lockset, cpu, &g_cpu_locksetlock,
-                      &g_cpu_schedlock);
-        }
-
       /* NOTE: If the task runs on another CPU(cpu), adjusting global IRQ
        * controls will be done in the pause handler on the new CPU(cpu).
        * If the task is scheduled on this CPU(me), do nothing because
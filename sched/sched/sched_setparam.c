@@ -203,6 +203,42 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Update parameters associated with SCHED_DEADLINE */
+
+  if (tcb->deadline != NULL)
+    {
+      irqstate_t flags;
+      sclock_t runtime_ticks;
+      sclock_t deadline_ticks;
+      sclock_t period_ticks;
+
+      /* Convert timespec values to system clock ticks */
+
+      clock_time2ticks(&param->sched_dl_runtime, &runtime_ticks);
+      clock_time2ticks(&param->sched_dl_deadline, &deadline_ticks);
+      clock_time2ticks(&param->sched_dl_period, &period_ticks);
+
+      if (runtime_ticks < 0 || deadline_ticks < 0 || period_ticks < 0)
+        {
+          ret = -EINVAL;
+          goto errout_with_lock;
+        }
+
+      /* Restart deadline scheduling with the new parameters */
+
+      flags = enter_critical_section();
+      ret = nxsched_start_deadline(tcb, param->sched_priority,
+                                   runtime_ticks, deadline_ticks,
+                                   period_ticks);
+      leave_critical_section(flags);
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+    }
+#endif
+
   /* Then perform the reprioritization */
 
   ret = nxsched_reprioritize(tcb, param->sched_priority);
@@ -64,11 +64,11 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
    * only select a task from that list if the affinity mask includes the
    * tcb->cpu.
    *
-   * If pre-emption is locked or another CPU is in a critical section,
-   * then use the 'nxttcb' which will probably be the IDLE thread.
+   * If another CPU is in a critical section, then use the 'nxttcb' which
+   * will probably be the IDLE thread.
    */
 
-  if (!nxsched_islocked_global() && !irq_cpu_locked(this_cpu()))
+  if (!irq_cpu_locked(this_cpu()))
     {
       /* Search for the highest priority task that can run on tcb->cpu. */
 
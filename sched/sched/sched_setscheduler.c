@@ -72,6 +72,8 @@
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE was requested but the thread could not be
+ *          admitted without exceeding the deadline bandwidth limit.
  *
  ****************************************************************************/
 
@@ -90,6 +92,9 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
@@ -120,6 +125,16 @@ int nxsched_set_scheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Cancel any on-going deadline scheduling if the policy changes */
+
+  if (policy != SCHED_DEADLINE && tcb->deadline != NULL)
+    {
+      DEBUGVERIFY(nxsched_stop_deadline(tcb));
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -141,7 +156,8 @@ int nxsched_set_scheduler(pid_t pid, int policy,
           /* Save the FIFO scheduling parameters */
 
           tcb->flags       |= TCB_FLAG_SCHED_FIFO;
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
           tcb->timeslice    = 0;
 #endif
         }
@@ -258,6 +274,49 @@ int nxsched_set_scheduler(pid_t pid, int policy,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          sclock_t runtime_ticks;
+          sclock_t deadline_ticks;
+          sclock_t period_ticks;
+
+          /* Convert timespec values to system clock ticks */
+
+          clock_time2ticks(&param->sched_dl_runtime, &runtime_ticks);
+          clock_time2ticks(&param->sched_dl_deadline, &deadline_ticks);
+          clock_time2ticks(&param->sched_dl_period, &period_ticks);
+
+          /* Avoid negative times; the admission test rejects zero */
+
+          if (runtime_ticks < 0 || deadline_ticks < 0 || period_ticks < 0)
+            {
+              ret = -EINVAL;
+              goto errout_with_irq;
+            }
+
+          /* Start the first period with a full budget */
+
+          ret = nxsched_start_deadline(tcb, param->sched_priority,
+                                       runtime_ticks, deadline_ticks,
+                                       period_ticks);
+          if (ret < 0)
+            {
+              /* Keep a previous deadline reservation of the thread */
+
+              if (tcb->deadline != NULL)
+                {
+                  tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+                }
+
+              goto errout_with_irq;
+            }
+
+          tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+        }
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         tcb->flags    |= TCB_FLAG_SCHED_OTHER;
@@ -273,7 +332,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   leave_critical_section(flags);
   sched_unlock();
@@ -307,6 +366,8 @@ errout_with_irq:
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
  *   ESRCH  The task whose ID is pid could not be found.
+ *   EBUSY  SCHED_DEADLINE was requested but the thread could not be
+ *          admitted without exceeding the deadline bandwidth limit.
  *
  ****************************************************************************/
 
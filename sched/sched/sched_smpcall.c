@@ -0,0 +1,260 @@
+/****************************************************************************
+ * sched/sched/sched_smpcall.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_CALL
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The requests queued for each CPU and the spinlock protecting them */
+
+static sq_queue_t g_smp_callq[CONFIG_SMP_NCPUS];
+static spinlock_t g_smp_calllock;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_smp_call_queue
+ *
+ * Description:
+ *   Queue a request for the CPU 'cpu' and raise the SMP call interrupt on
+ *   that CPU if the request was not pending already.  If the interrupt
+ *   cannot be raised, the request is taken off the queue again unless the
+ *   handler of that CPU has already taken it.
+ *
+ ****************************************************************************/
+
+static int nxsched_smp_call_queue(int cpu, FAR struct smp_call_s *call)
+{
+  FAR sq_entry_t *node;
+  irqstate_t flags;
+  bool queued = false;
+  int ret;
+
+  DEBUGASSERT((unsigned int)cpu < CONFIG_SMP_NCPUS && call != NULL &&
+              call->func != NULL);
+
+  flags = spin_lock_irqsave(&g_smp_calllock);
+  if (!call->pending)
+    {
+      call->pending = true;
+      call->cpu     = cpu;
+      sq_addlast(&call->node, &g_smp_callq[cpu]);
+      queued        = true;
+    }
+
+  spin_unlock_irqrestore(&g_smp_calllock, flags);
+
+  if (!queued)
+    {
+      return OK;
+    }
+
+  ret = up_send_smp_call((cpu_set_t)1 << cpu);
+  if (ret < 0)
+    {
+      flags = spin_lock_irqsave(&g_smp_calllock);
+      sq_for_every(&g_smp_callq[cpu], node)
+        {
+          if (node == &call->node)
+            {
+              sq_rem(&call->node, &g_smp_callq[cpu]);
+              call->pending = false;
+              break;
+            }
+        }
+
+      spin_unlock_irqrestore(&g_smp_calllock, flags);
+
+      /* The handler runs the request if it has taken it already */
+
+      if (node == NULL)
+        {
+          ret = OK;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_smp_call
+ *
+ * Description:
+ *   Run a function on another CPU and wait until it has returned.  See
+ *   include/nuttx/sched.h.
+ *
+ ****************************************************************************/
+
+int nxsched_smp_call(int cpu, nxsched_smp_call_t func, FAR void *arg)
+{
+  struct smp_call_s call;
+  int ret;
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  if (cpu == this_cpu())
+    {
+      func(arg);
+      return OK;
+    }
+
+  call.func    = func;
+  call.arg     = arg;
+  call.pending = false;
+  call.wait    = true;
+
+  ret = nxsched_smp_call_queue(cpu, &call);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The handler clears 'pending' once the function has returned */
+
+  while (call.pending)
+    {
+      SP_DSB();
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_smp_call_async
+ *
+ * Description:
+ *   Queue a request for another CPU without waiting.  See
+ *   include/nuttx/sched.h.
+ *
+ ****************************************************************************/
+
+int nxsched_smp_call_async(int cpu, FAR struct smp_call_s *call)
+{
+  call->wait = false;
+  return nxsched_smp_call_queue(cpu, call);
+}
+
+/****************************************************************************
+ * Name: nxsched_smp_call_cancel
+ *
+ * Description:
+ *   Remove a request from the queue of its CPU if it is still queued.
+ *   This must be done before the memory of the request is released.
+ *
+ ****************************************************************************/
+
+void nxsched_smp_call_cancel(FAR struct smp_call_s *call)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_smp_calllock);
+  if (call->pending && !call->wait)
+    {
+      sq_rem(&call->node, &g_smp_callq[call->cpu]);
+      call->pending = false;
+    }
+
+  spin_unlock_irqrestore(&g_smp_calllock, flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_smp_call_handler
+ *
+ * Description:
+ *   Run all requests queued for this CPU.  See include/nuttx/sched.h.
+ *
+ ****************************************************************************/
+
+int nxsched_smp_call_handler(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct smp_call_s *call;
+  nxsched_smp_call_t func;
+  FAR void *funcarg;
+  irqstate_t flags;
+  int cpu = this_cpu();
+  bool wait;
+
+  for (; ; )
+    {
+      /* Take the next request off the queue.  Asynchronous requests are
+       * released immediately; their memory may go away once the lock is
+       * dropped.
+       */
+
+      flags = spin_lock_irqsave(&g_smp_calllock);
+      call  = (FAR struct smp_call_s *)sq_remfirst(&g_smp_callq[cpu]);
+      if (call == NULL)
+        {
+          spin_unlock_irqrestore(&g_smp_calllock, flags);
+          break;
+        }
+
+      func    = call->func;
+      funcarg = call->arg;
+      wait    = call->wait;
+      if (!wait)
+        {
+          call->pending = false;
+        }
+
+      spin_unlock_irqrestore(&g_smp_calllock, flags);
+
+      func(funcarg);
+
+      /* Release a waiting requester */
+
+      if (wait)
+        {
+          SP_DMB();
+          call->pending = false;
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_SMP_CALL */
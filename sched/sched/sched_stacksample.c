@@ -0,0 +1,71 @@
+/****************************************************************************
+ * sched/sched/sched_stacksample.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_STACK_SAMPLING
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_sample_stack
+ *
+ * Description:
+ *   Record the stack use of the running thread from the current stack
+ *   pointer, if it deepens the use recorded so far.  This is called when
+ *   the thread is suspended and at the timer interrupts: The samples give
+ *   a lower bound of the real high-water mark, without the cost of the
+ *   stack coloration.  A stack pointer outside of the stack of the thread,
+ *   as on an interrupt stack, is ignored.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the running thread.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_sample_stack(FAR struct tcb_s *tcb)
+{
+  uintptr_t base = (uintptr_t)tcb->stack_base_ptr;
+  uintptr_t top  = base + tcb->adj_stack_size;
+  uintptr_t sp   = up_getsp();
+
+  if (sp > base && sp <= top && top - sp > tcb->stack_sampled)
+    {
+      tcb->stack_sampled = top - sp;
+    }
+}
+
+#endif /* CONFIG_STACK_SAMPLING */
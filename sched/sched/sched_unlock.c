@@ -101,16 +101,6 @@ int sched_unlock(void)
 
           rtcb->lockcount = 0;
 
-          /* The lockcount has decremented to zero and we need to perform
-           * release our hold on the lock.
-           */
-
-          DEBUGASSERT(g_cpu_schedlock == SP_LOCKED &&
-                      (g_cpu_lockset & (1 << cpu)) != 0);
-
-          spin_clrbit(&g_cpu_lockset, cpu, &g_cpu_locksetlock,
-                      &g_cpu_schedlock);
-
           /* Release any ready-to-run tasks that have collected in
            * g_pendingtasks.
            *
@@ -118,11 +108,12 @@ int sched_unlock(void)
            * this task to be switched out!
            */
 
-          /* In the SMP case, the tasks remains pend(1) if we are
-           * in a critical section, i.e., g_cpu_irqlock is locked by other
-           * CPUs, or (2) other CPUs still have pre-emption disabled, i.e.,
-           * g_cpu_schedlock is locked.  In those cases, the release of the
-           * pending tasks must be deferred until those conditions are met.
+          /* In the SMP case, the tasks remain pending if we are in a
+           * critical section, i.e., g_cpu_irqlock is locked by other CPUs.
+           * In that case, the release of the pending tasks must be deferred
+           * until leave_critical_section().  Pre-emption disabled on the
+           * other CPUs does not defer the release:  nxsched_merge_pending()
+           * does not start tasks on those CPUs.
            *
            * There are certain conditions that we must avoid by preventing
            * releasing the pending tasks while within the critical section
@@ -137,7 +128,7 @@ int sched_unlock(void)
            * BEFORE it clears IRQ lock.
            */
 
-          if (!nxsched_islocked_global() && !irq_cpu_locked(cpu) &&
+          if (!irq_cpu_locked(cpu) &&
               g_pendingtasks.head != NULL)
             {
               up_release_pending();
@@ -206,6 +197,18 @@ int sched_unlock(void)
 #endif
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          /* If the budget of a deadline thread was used up while pre-emption
+           * was disabled, then throttle the thread now.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE
+              && rtcb->timeslice < 0)
+            {
+              nxsched_deadline_throttle(rtcb);
+            }
+#endif
         }
 
       leave_critical_section(flags);
@@ -337,6 +340,18 @@ int sched_unlock(void)
 #endif
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          /* If the budget of a deadline thread was used up while pre-emption
+           * was disabled, then throttle the thread now.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE
+              && rtcb->timeslice < 0)
+            {
+              nxsched_deadline_throttle(rtcb);
+            }
+#endif
         }
 
       leave_critical_section(flags);
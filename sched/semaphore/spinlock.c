@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <sched.h>
 #include <assert.h>
 
@@ -36,6 +37,100 @@
 
 #ifdef CONFIG_SPINLOCK
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_acquire
+ *
+ * Description:
+ *   Loop until the spinlock is locked.  A ticket spinlock hands out the
+ *   next ticket and waits for it to be served, so that the CPUs get the
+ *   lock in the order in which they asked for it and spin only reading
+ *   the lock.
+ *
+ ****************************************************************************/
+
+static inline void spin_acquire(FAR volatile spinlock_t *lock)
+{
+#ifdef CONFIG_TICKET_SPINLOCK
+  spinlock_t ticket;
+
+  ticket = SP_TICKET_NEXT(__atomic_fetch_add(lock, SP_LOCKED,
+                                             __ATOMIC_RELAXED));
+  while (SP_TICKET_OWNER(__atomic_load_n(lock, __ATOMIC_ACQUIRE)) !=
+         ticket)
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+#else
+  while (up_testset(lock) == SP_LOCKED)
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+#endif
+
+  SP_DMB();
+}
+
+/****************************************************************************
+ * Name: spin_tryacquire
+ *
+ * Description:
+ *   Try once to lock the spinlock.  A ticket spinlock is only taken if no
+ *   ticket is waiting to be served.
+ *
+ ****************************************************************************/
+
+static inline spinlock_t spin_tryacquire(FAR volatile spinlock_t *lock)
+{
+#ifdef CONFIG_TICKET_SPINLOCK
+  spinlock_t old = *lock;
+
+  if (SP_TICKET_OWNER(old) != SP_TICKET_NEXT(old) ||
+      !__atomic_compare_exchange_n(lock, &old, (spinlock_t)(old + SP_LOCKED),
+                                   false, __ATOMIC_ACQUIRE,
+                                   __ATOMIC_RELAXED))
+#else
+  if (up_testset(lock) == SP_LOCKED)
+#endif
+    {
+      SP_DSB();
+      return SP_LOCKED;
+    }
+
+  SP_DMB();
+  return SP_UNLOCKED;
+}
+
+/****************************************************************************
+ * Name: spin_release
+ *
+ * Description:
+ *   Unlock the spinlock.  A ticket spinlock serves the next ticket, only
+ *   the nibble of the ticket served changes.
+ *
+ ****************************************************************************/
+
+static inline void spin_release(FAR volatile spinlock_t *lock)
+{
+#ifdef CONFIG_TICKET_SPINLOCK
+  spinlock_t owner = SP_TICKET_OWNER(*lock);
+
+  __atomic_fetch_add(lock, owner == 0x0f ? (spinlock_t)-0x0f : 1,
+                     __ATOMIC_RELEASE);
+#else
+  SP_DMB();
+  *lock = SP_UNLOCKED;
+#endif
+
+  SP_DSB();
+  SP_SEV();
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -71,18 +166,13 @@ void spin_lock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock);
 #endif
 
-  while (up_testset(lock) == SP_LOCKED)
-    {
-      SP_DSB();
-      SP_WFE();
-    }
+  spin_acquire(lock);
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
   sched_note_spinlocked(this_task(), lock);
 #endif
-  SP_DMB();
 }
 
 /****************************************************************************
@@ -109,13 +199,7 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
 void spin_lock_wo_note(FAR volatile spinlock_t *lock)
 {
-  while (up_testset(lock) == SP_LOCKED)
-    {
-      SP_DSB();
-      SP_WFE();
-    }
-
-  SP_DMB();
+  spin_acquire(lock);
 }
 
 /****************************************************************************
@@ -145,14 +229,13 @@ spinlock_t spin_trylock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock);
 #endif
 
-  if (up_testset(lock) == SP_LOCKED)
+  if (spin_tryacquire(lock) == SP_LOCKED)
     {
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
       /* Notify that we abort for a spinlock */
 
       sched_note_spinabort(this_task(), &lock);
 #endif
-      SP_DSB();
       return SP_LOCKED;
     }
 
@@ -161,7 +244,6 @@ spinlock_t spin_trylock(FAR volatile spinlock_t *lock)
 
   sched_note_spinlocked(this_task(), lock);
 #endif
-  SP_DMB();
   return SP_UNLOCKED;
 }
 
@@ -189,14 +271,7 @@ spinlock_t spin_trylock(FAR volatile spinlock_t *lock)
 
 spinlock_t spin_trylock_wo_note(FAR volatile spinlock_t *lock)
 {
-  if (up_testset(lock) == SP_LOCKED)
-    {
-      SP_DSB();
-      return SP_LOCKED;
-    }
-
-  SP_DMB();
-  return SP_UNLOCKED;
+  return spin_tryacquire(lock);
 }
 
 /****************************************************************************
@@ -225,10 +300,7 @@ void spin_unlock(FAR volatile spinlock_t *lock)
   sched_note_spinunlock(this_task(), lock);
 #endif
 
-  SP_DMB();
-  *lock = SP_UNLOCKED;
-  SP_DSB();
-  SP_SEV();
+  spin_release(lock);
 }
 #endif
 
@@ -254,10 +326,7 @@ void spin_unlock(FAR volatile spinlock_t *lock)
 
 void spin_unlock_wo_note(FAR volatile spinlock_t *lock)
 {
-  SP_DMB();
-  *lock = SP_UNLOCKED;
-  SP_DSB();
-  SP_SEV();
+  spin_release(lock);
 }
 
 /****************************************************************************
@@ -40,15 +40,29 @@
  * Name: nxsig_alloc_pendingsigaction
  *
  * Description:
- *   Allocate a new element for the pending signal action queue
+ *   Allocate a new element for the pending signal action queue of the task
+ *   stcb.  The private pool of the task is tried first.
  *
  ****************************************************************************/
 
-FAR sigq_t *nxsig_alloc_pendingsigaction(void)
+FAR sigq_t *nxsig_alloc_pendingsigaction(FAR struct tcb_s *stcb)
 {
   FAR sigq_t    *sigq;
   irqstate_t flags;
 
+#if CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0
+  /* Try the private pool of the receiving task */
+
+  flags = enter_critical_section();
+  sigq = (FAR sigq_t *)sq_remfirst(&stcb->sigpoolq);
+  leave_critical_section(flags);
+
+  if (sigq != NULL)
+    {
+      return sigq;
+    }
+#endif
+
   /* Check if we were called from an interrupt handler. */
 
   if (up_interrupt_context())
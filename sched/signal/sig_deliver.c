@@ -198,9 +198,26 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
 
       nxsig_unmask_pendingsignal();
 
+#ifdef CONFIG_SIG_COALESCE_COUNT
+      /* If further instances of the signal were counted while the action
+       * was queued, deliver the same action again.
+       */
+
+      flags = enter_critical_section();
+      if (sigq->count > 0)
+        {
+          sigq->count--;
+          sq_addfirst((FAR sq_entry_t *)sigq, &stcb->sigpendactionq);
+          leave_critical_section(flags);
+          continue;
+        }
+
+      leave_critical_section(flags);
+#endif
+
       /* Then deallocate the signal structure */
 
-      nxsig_release_pendingsigaction(sigq);
+      nxsig_release_pendingsigaction(stcb, sigq);
     }
 
   /* Restore the saved errno value */
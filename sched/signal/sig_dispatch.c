@@ -47,6 +47,86 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nxsig_coalesce_action
+ *
+ * Description:
+ *   Count a signal in an action for the same signal that is queued or
+ *   being delivered to the task, if there is one.
+ *
+ * Returned Value:
+ *   True if the signal was counted.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIG_COALESCE_COUNT
+static bool nxsig_coalesce_action(FAR struct tcb_s *stcb,
+                                  FAR siginfo_t *info)
+{
+  FAR sigq_t *sigq;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  for (sigq = (FAR sigq_t *)stcb->sigpendactionq.head;
+       sigq != NULL && sigq->info.si_signo != info->si_signo;
+       sigq = sigq->flink);
+
+  if (sigq == NULL)
+    {
+      for (sigq = (FAR sigq_t *)stcb->sigpostedq.head;
+           sigq != NULL && sigq->info.si_signo != info->si_signo;
+           sigq = sigq->flink);
+    }
+
+  if (sigq != NULL && sigq->count < UINT16_MAX)
+    {
+      /* Deliver the most recent information with the next instance */
+
+      memcpy(&sigq->info, info, sizeof(siginfo_t));
+      sigq->count++;
+    }
+  else
+    {
+      sigq = NULL;
+    }
+
+  leave_critical_section(flags);
+  return sigq != NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsig_schedule_action
+ *
+ * Description:
+ *   Schedule the signal actions of a thread on the CPU that runs it.  Runs
+ *   in the SMP call handler of that CPU where the thread is normally the
+ *   interrupted task, so the CPU does not have to be paused.
+ *
+ * Input Parameters:
+ *   arg - The PID of the thread.  The TCB may be gone by this time.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_CALL
+static void nxsig_schedule_action(FAR void *arg)
+{
+  FAR struct tcb_s *stcb;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  stcb = nxsched_get_tcb((pid_t)(uintptr_t)arg);
+  if (stcb != NULL && !sq_empty(&stcb->sigpendactionq))
+    {
+      up_schedule_sigaction(stcb, nxsig_deliver);
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Name: nxsig_queue_action
  *
@@ -83,10 +163,15 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
        * unable to allocate memory for the signal data.
        */
 
-      sigq = nxsig_alloc_pendingsigaction();
+      sigq = nxsig_alloc_pendingsigaction(stcb);
       if (!sigq)
         {
-          ret = -ENOMEM;
+#ifdef CONFIG_SIG_COALESCE_COUNT
+          if (!nxsig_coalesce_action(stcb, info))
+#endif
+            {
+              ret = -ENOMEM;
+            }
         }
       else
         {
@@ -100,6 +185,9 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
             }
 
           memcpy(&sigq->info, info, sizeof(siginfo_t));
+#ifdef CONFIG_SIG_COALESCE_COUNT
+          sigq->count = 0;
+#endif
 
           /* Put it at the end of the pending signals list */
 
@@ -111,7 +199,27 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
            * up_schedule_sigaction()
            */
 
-          up_schedule_sigaction(stcb, nxsig_deliver);
+#ifdef CONFIG_SMP_CALL
+          /* If the recipient runs on another CPU, let that CPU schedule the
+           * action itself rather than pausing it.
+           */
+
+          if (stcb->task_state == TSTATE_TASK_RUNNING &&
+              stcb->cpu != this_cpu())
+            {
+              stcb->sigcall.func = nxsig_schedule_action;
+              stcb->sigcall.arg  = (FAR void *)(uintptr_t)stcb->pid;
+              if (nxsched_smp_call_async(stcb->cpu, &stcb->sigcall) < 0)
+                {
+                  up_schedule_sigaction(stcb, nxsig_deliver);
+                }
+            }
+          else
+#endif
+            {
+              up_schedule_sigaction(stcb, nxsig_deliver);
+            }
+
           leave_critical_section(flags);
         }
     }
@@ -242,6 +350,18 @@ static void nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
       /* The signal is already pending... retain only one copy */
 
       memcpy(&sigpend->info, info, sizeof(siginfo_t));
+
+#ifdef CONFIG_SIG_COALESCE_COUNT
+      /* But remember how many times it was received */
+
+      flags = enter_critical_section();
+      if (sigpend->count < UINT16_MAX)
+        {
+          sigpend->count++;
+        }
+
+      leave_critical_section(flags);
+#endif
     }
 
   /* No... There is nothing pending in the group for this signo */
@@ -256,6 +376,9 @@ static void nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
           /* Put the signal information into the allocated structure */
 
           memcpy(&sigpend->info, info, sizeof(siginfo_t));
+#ifdef CONFIG_SIG_COALESCE_COUNT
+          sigpend->count = 0;
+#endif
 
           /* Add the structure to the group pending signal list */
 
@@ -297,6 +420,7 @@ static void nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
 int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
 {
   irqstate_t flags;
+  bool running;
   int masked;
   int ret = OK;
 
@@ -313,6 +437,13 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
       return OK;
     }
 
+  /* A task signaling itself, or interrupted by an interrupt handler that
+   * signals it, is running and cannot be waiting for anything.  The checks
+   * for the waiting states and their critical sections are skipped then.
+   */
+
+  running = (stcb == this_task());
+
   /************************** MASKED SIGNAL ACTIONS *************************/
 
   masked = nxsig_ismember(&stcb->sigprocmask, info->si_signo);
@@ -356,6 +487,12 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
        * signals can be queued from the interrupt level.
        */
 
+      if (running)
+        {
+          nxsig_add_pendingsignal(stcb, info);
+          goto out;
+        }
+
       flags = enter_critical_section();
       if (stcb->task_state == TSTATE_WAIT_SIG &&
           (masked == 0 ||
@@ -391,6 +528,10 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
       /* Queue any sigaction's requested by this task. */
 
       ret = nxsig_queue_action(stcb, info);
+      if (running)
+        {
+          goto out;
+        }
 
       /* Deliver of the signal must be performed in a critical section */
 
@@ -428,7 +569,7 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
    * happen within a system call.
    */
 
-  if (masked == 0)
+  if (masked == 0 && !running)
     {
       /* If the task is blocked waiting for a semaphore, then that task must
        * be unblocked when a signal is received.
@@ -470,6 +611,7 @@ int nxsig_tcbdispatch(FAR struct tcb_s *stcb, siginfo_t *info)
 
   /* In case nxsig_ismember failed due to an invalid signal number */
 
+out:
   if (masked < 0)
     {
       ret = -EINVAL;
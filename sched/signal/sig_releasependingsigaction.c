@@ -38,18 +38,33 @@
  * Name: nxsig_release_pendingsigaction
  *
  * Description:
- *   Deallocate a pending signal action Q entry
+ *   Deallocate a pending signal action Q entry of the task stcb
  *
  ****************************************************************************/
 
-void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
+void nxsig_release_pendingsigaction(FAR struct tcb_s *stcb,
+                                    FAR sigq_t *sigq)
 {
   irqstate_t flags;
 
+#if CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0
+  /* If this structure belongs to the private pool of the receiving task,
+   * then put it back there.
+   */
+
+  if (sigq->type == SIG_ALLOC_TASK)
+    {
+      flags = enter_critical_section();
+      sq_addlast((FAR sq_entry_t *)sigq, &stcb->sigpoolq);
+      leave_critical_section(flags);
+    }
+
   /* If this is a generally available pre-allocated structure,
    * then just put it back in the free list.
    */
 
+  else
+#endif
   if (sigq->type == SIG_ALLOC_FIXED)
     {
       /* Make sure we avoid concurrent access to the free
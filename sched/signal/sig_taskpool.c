@@ -0,0 +1,102 @@
+/****************************************************************************
+ * sched/signal/sig_taskpool.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <queue.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+
+#include "signal/signal.h"
+
+#if CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsig_alloc_taskpool
+ *
+ * Description:
+ *   Allocate the private pool of pending signal actions of a new task or
+ *   thread.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the new task or thread
+ *
+ * Returned Value:
+ *   Zero (OK) on success or -ENOMEM.
+ *
+ ****************************************************************************/
+
+int nxsig_alloc_taskpool(FAR struct tcb_s *tcb)
+{
+  FAR sigq_t *sigq;
+  int i;
+
+  sigq = (FAR sigq_t *)
+    kmm_malloc(sizeof(sigq_t) * CONFIG_SIG_PREALLOC_TASK_ACTIONS);
+  if (sigq == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  tcb->sigpool = sigq;
+  sq_init(&tcb->sigpoolq);
+
+  for (i = 0; i < CONFIG_SIG_PREALLOC_TASK_ACTIONS; i++)
+    {
+      sigq->type = SIG_ALLOC_TASK;
+      sq_addlast((FAR sq_entry_t *)sigq++, &tcb->sigpoolq);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsig_free_taskpool
+ *
+ * Description:
+ *   Free the private pool of pending signal actions of a task or thread.
+ *   The signal lists of the TCB must have been released already.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task or thread
+ *
+ ****************************************************************************/
+
+void nxsig_free_taskpool(FAR struct tcb_s *tcb)
+{
+  if (tcb->sigpool != NULL)
+    {
+      kmm_free(tcb->sigpool);
+      tcb->sigpool = NULL;
+      sq_init(&tcb->sigpoolq);
+    }
+}
+
+#endif /* CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0 */
@@ -253,9 +253,23 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       ret = sigpend->info.si_signo;
 
-      /* Then dispose of the pending signal structure properly */
+#ifdef CONFIG_SIG_COALESCE_COUNT
+      /* Keep the signal pending if further instances were counted */
+
+      if (sigpend->count > 0)
+        {
+          sigpend->count--;
+          sq_addfirst((FAR sq_entry_t *)sigpend,
+                      &rtcb->group->tg_sigpendingq);
+        }
+      else
+#endif
+        {
+          /* Then dispose of the pending signal structure properly */
+
+          nxsig_release_pendingsignal(sigpend);
+        }
 
-      nxsig_release_pendingsignal(sigpend);
       leave_critical_section(flags);
     }
 
@@ -309,10 +323,25 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
           waitticks = MSEC2TICK(waitmsec);
 #endif
 
-          /* Start the watchdog */
+          /* Start the watchdog, the wake-up may be late by the timer slack
+           * of the thread.
+           */
 
-          wd_start(&rtcb->waitdog, waitticks,
-                   nxsig_timeout, (uintptr_t)rtcb);
+#ifdef CONFIG_SCHED_TIMER_SLACK
+          ret = wd_start_slack(&rtcb->waitdog, waitticks, rtcb->timerslack,
+                               nxsig_timeout, (uintptr_t)rtcb);
+#else
+          ret = wd_start(&rtcb->waitdog, waitticks,
+                         nxsig_timeout, (uintptr_t)rtcb);
+#endif
+          if (ret < 0)
+            {
+              /* Do not wait without the timeout */
+
+              rtcb->sigwaitmask = NULL_SIGNAL_SET;
+              leave_critical_section(flags);
+              return ret;
+            }
 
           /* Now wait for either the signal or the watchdog, but
            * first, make sure this is not the idle task,
@@ -103,6 +103,16 @@ bool nxsig_unmask_pendingsignal(void)
 
               nxsig_tcbdispatch(rtcb, &pendingsig->info);
 
+#ifdef CONFIG_SIG_COALESCE_COUNT
+              /* And once more for each further instance that was counted */
+
+              while (pendingsig->count > 0)
+                {
+                  pendingsig->count--;
+                  nxsig_tcbdispatch(rtcb, &pendingsig->info);
+                }
+#endif
+
               /* Then remove it from the pending signal list */
 
               nxsig_release_pendingsignal(pendingsig);
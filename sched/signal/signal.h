@@ -56,7 +56,8 @@ enum sigalloc_e
 {
   SIG_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
   SIG_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  SIG_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  SIG_ALLOC_TASK        /* Preallocated in the private pool of a task */
 };
 
 /* The following defines the sigaction queue entry */
@@ -80,6 +81,9 @@ struct sigpendq
   FAR struct sigpendq *flink;    /* Forward link */
   siginfo_t info;                /* Signal information */
   uint8_t   type;                /* (Used to manage allocations) */
+#ifdef CONFIG_SIG_COALESCE_COUNT
+  uint16_t  count;               /* Further instances of the signal */
+#endif
 };
 typedef struct sigpendq sigpendq_t;
 
@@ -98,6 +102,9 @@ struct sigq_s
                                   * the signal-catching function executes */
   siginfo_t info;                /* Signal information */
   uint8_t   type;                /* (Used to manage allocations) */
+#ifdef CONFIG_SIG_COALESCE_COUNT
+  uint16_t  count;               /* Further deliveries of the action */
+#endif
 };
 typedef struct sigq_s sigq_t;
 
@@ -178,6 +185,16 @@ int                nxsig_dispatch(pid_t pid, FAR siginfo_t *info);
 void               nxsig_cleanup(FAR struct tcb_s *stcb);
 void               nxsig_release(FAR struct task_group_s *group);
 
+/* sig_taskpool.c */
+
+#if CONFIG_SIG_PREALLOC_TASK_ACTIONS > 0
+int                nxsig_alloc_taskpool(FAR struct tcb_s *tcb);
+void               nxsig_free_taskpool(FAR struct tcb_s *tcb);
+#else
+#  define nxsig_alloc_taskpool(tcb) OK
+#  define nxsig_free_taskpool(tcb)
+#endif
+
 /* sig_timedwait.c */
 
 #ifdef CONFIG_CANCELLATION_POINTS
@@ -186,12 +203,13 @@ void nxsig_wait_irq(FAR struct tcb_s *wtcb, int errcode);
 
 /* In files of the same name */
 
-FAR sigq_t        *nxsig_alloc_pendingsigaction(void);
+FAR sigq_t        *nxsig_alloc_pendingsigaction(FAR struct tcb_s *stcb);
 void               nxsig_deliver(FAR struct tcb_s *stcb);
 FAR sigactq_t     *nxsig_find_action(FAR struct task_group_s *group,
                                      int signo);
 int                nxsig_lowest(FAR sigset_t *set);
-void               nxsig_release_pendingsigaction(FAR sigq_t *sigq);
+void               nxsig_release_pendingsigaction(FAR struct tcb_s *stcb,
+                                                  FAR sigq_t *sigq);
 void               nxsig_release_pendingsignal(FAR sigpendq_t *sigpend);
 FAR sigpendq_t    *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb,
                                               int signo);
@@ -58,4 +58,14 @@ void nxtask_recover(FAR struct tcb_s *tcb);
 
 bool nxnotify_cancellation(FAR struct tcb_s *tcb);
 
+/* Cache of released TCBs and their stacks */
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+FAR struct tcb_s *nxtask_tcbcache_get(uint8_t ttype, size_t stack_size);
+bool nxtask_tcbcache_put(FAR struct tcb_s *tcb, uint8_t ttype);
+#else
+#  define nxtask_tcbcache_get(ttype, stack_size) NULL
+#  define nxtask_tcbcache_put(tcb, ttype)        false
+#endif
+
 #endif /* __SCHED_TASK_TASK_H */
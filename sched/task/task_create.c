@@ -76,18 +76,30 @@ static int nxthread_create(FAR const char *name, uint8_t ttype,
   pid_t pid;
   int ret;
 
-  /* Allocate a TCB for the new task. */
+  /* Allocate a TCB for the new task.  A TCB recycled from the TCB cache
+   * already owns a stack of the requested size.
+   */
+
+  tcb = NULL;
+  if (!stack_ptr)
+    {
+      tcb = (FAR struct task_tcb_s *)nxtask_tcbcache_get(ttype, stack_size);
+    }
+
+  if (!tcb)
+    {
+      tcb = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
+    }
 
-  tcb = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
   if (!tcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
       return -ENOMEM;
     }
 
-  /* Setup the task type */
+  /* Setup the task type (keeping TCB_FLAG_FREE_STACK of a recycled TCB) */
 
-  tcb->cmn.flags = ttype;
+  tcb->cmn.flags |= ttype;
 
   /* Initialize the task */
 
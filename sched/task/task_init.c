@@ -37,6 +37,7 @@
 #include "sched/sched.h"
 #include "environ/environ.h"
 #include "group/group.h"
+#include "signal/signal.h"
 #include "task/task.h"
 #include "tls/tls.h"
 
@@ -126,12 +127,18 @@ int nxtask_init(FAR struct task_tcb_s *tcb, const char *name, int priority,
 
       ret = up_use_stack(&tcb->cmn, stack, stack_size);
     }
-  else
+  else if (tcb->cmn.stack_alloc_ptr == NULL)
     {
       /* Allocate the stack for the TCB */
 
       ret = up_create_stack(&tcb->cmn, stack_size, ttype);
     }
+  else
+    {
+      /* The TCB came from the TCB cache together with its stack */
+
+      ret = OK;
+    }
 
   if (ret < OK)
     {
@@ -189,6 +196,7 @@ errout_with_group:
         }
     }
 
+  nxsig_free_taskpool(&tcb->cmn);
   group_leave(&tcb->cmn);
   return ret;
 }
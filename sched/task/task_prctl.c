@@ -26,6 +26,7 @@
 
 #include <sys/prctl.h>
 #include <stdarg.h>
+#include <limits.h>
 #include <string.h>
 #include <errno.h>
 #include <debug.h>
@@ -50,6 +51,7 @@
  * Returned Value:
  *   The returned value may depend on the specific command.  For PR_SET_NAME
  *   and PR_GET_NAME, the returned value of 0 indicates successful operation.
+ *   PR_GET_TIMERSLACK returns the timer slack in nanoseconds.
  *   On any failure, -1 is retruend and the errno value is set appropriately.
  *
  *     EINVAL The value of 'option' is not recognized.
@@ -146,6 +148,42 @@ int prctl(int option, ...)
         goto errout;
 #endif
 
+      case PR_SET_TIMERSLACK:
+      case PR_GET_TIMERSLACK:
+#ifdef CONFIG_SCHED_TIMER_SLACK
+        {
+          FAR struct tcb_s *rtcb = this_task();
+          unsigned long slack;
+          int ret = OK;
+
+          if (option == PR_SET_TIMERSLACK)
+            {
+              /* Round down, the sleeps are never later than requested.
+               * A slack too large for a sclock_t is limited to the largest
+               * one.
+               */
+
+              slack = va_arg(ap, unsigned long) / NSEC_PER_TICK;
+              rtcb->timerslack = slack > SCLOCK_MAX ? SCLOCK_MAX : slack;
+            }
+          else if (rtcb->timerslack > INT_MAX / NSEC_PER_TICK)
+            {
+              ret = INT_MAX;
+            }
+          else
+            {
+              ret = rtcb->timerslack * NSEC_PER_TICK;
+            }
+
+          va_end(ap);
+          return ret;
+        }
+#else
+        serr("ERROR: Option not enabled: %d\n", option);
+        errcode = ENOSYS;
+        goto errout;
+#endif
+
       default:
         serr("ERROR: Unrecognized option: %d\n", option);
         errcode = EINVAL;
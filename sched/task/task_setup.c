@@ -40,6 +40,7 @@
 #include "sched/sched.h"
 #include "pthread/pthread.h"
 #include "group/group.h"
+#include "signal/signal.h"
 #include "task/task.h"
 
 /****************************************************************************
@@ -377,6 +378,19 @@ static int nxthread_setup_scheduler(FAR struct tcb_s *tcb, int priority,
   ret = nxtask_assign_pid(tcb);
   if (ret == OK)
     {
+      /* Allocate the private pool of pending signal actions */
+
+      ret = nxsig_alloc_taskpool(tcb);
+    }
+
+  if (ret == OK)
+    {
+#ifdef CONFIG_PTHREAD_MUTEX_FUTEX
+      /* Let the C library find the thread ID without a system call */
+
+      ((FAR struct tls_info_s *)tcb->stack_alloc_ptr)->tl_tid = tcb->pid;
+#endif
+
       /* Save task priority and entry point in the TCB */
 
       tcb->sched_priority = (uint8_t)priority;
@@ -405,6 +419,12 @@ static int nxthread_setup_scheduler(FAR struct tcb_s *tcb, int priority,
       tcb->flags         |= TCB_FLAG_SCHED_FIFO;
 #endif
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+      /* Set the default slack of the timed waits */
+
+      tcb->timerslack     = USEC2TICK(CONFIG_SCHED_TIMER_SLACK_DEFAULT);
+#endif
+
 #ifdef CONFIG_CANCELLATION_POINTS
       /* Set the deferred cancellation type */
 
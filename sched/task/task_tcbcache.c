@@ -0,0 +1,236 @@
+/****************************************************************************
+ * sched/task/task_tcbcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+
+#include "task/task.h"
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The TCBs kept for reuse, each still owning its stack.  The TCBs are
+ * linked through their flink field, the thread type is kept in the flags
+ * and the usable size of the stack in adj_stack_size.
+ */
+
+static sq_queue_t g_tcbcache;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Statistics of the TCB cache */
+
+uint32_t g_tcbcache_hits;
+uint32_t g_tcbcache_misses;
+uint16_t g_tcbcache_nentries;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxtask_tcbcache_stacksize
+ *
+ * Description:
+ *   Return the usable size of the stack allocated for a thread of the type
+ *   'ttype'.
+ *
+ ****************************************************************************/
+
+static size_t nxtask_tcbcache_stacksize(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+#ifdef CONFIG_MM_KERNEL_HEAP
+  if (ttype == TCB_FLAG_TTYPE_KERNEL)
+    {
+      return kmm_malloc_size(tcb->stack_alloc_ptr);
+    }
+#endif
+
+  return kumm_malloc_size(tcb->stack_alloc_ptr);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxtask_tcbcache_get
+ *
+ * Description:
+ *   Take a TCB of the thread type 'ttype' from the TCB cache.  The TCB must
+ *   own a stack of at least 'stack_size' bytes that does not waste more
+ *   than a quarter of that size.
+ *
+ * Input Parameters:
+ *   ttype      - The thread type of the new thread
+ *   stack_size - The requested stack size of the new thread
+ *
+ * Returned Value:
+ *   A zeroed TCB of the size required by 'ttype' with the stack already
+ *   assigned to it, or NULL if the cache holds no suitable TCB.  The caller
+ *   then has to allocate the TCB and its stack as usual.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxtask_tcbcache_get(uint8_t ttype, size_t stack_size)
+{
+  FAR struct tcb_s *tcb;
+  FAR struct tcb_s *prev = NULL;
+  FAR void *stack;
+  irqstate_t flags;
+  size_t tcbsize;
+
+  flags = enter_critical_section();
+
+  for (tcb = (FAR struct tcb_s *)g_tcbcache.head;
+       tcb != NULL;
+       prev = tcb, tcb = tcb->flink)
+    {
+      if ((tcb->flags & TCB_FLAG_TTYPE_MASK) == ttype &&
+          tcb->adj_stack_size >= stack_size &&
+          tcb->adj_stack_size <= stack_size + stack_size / 4)
+        {
+          break;
+        }
+    }
+
+  if (tcb == NULL)
+    {
+      g_tcbcache_misses++;
+      leave_critical_section(flags);
+      return NULL;
+    }
+
+  if (prev == NULL)
+    {
+      sq_remfirst(&g_tcbcache);
+    }
+  else
+    {
+      sq_remafter((FAR sq_entry_t *)prev, &g_tcbcache);
+    }
+
+  g_tcbcache_hits++;
+  g_tcbcache_nentries--;
+  leave_critical_section(flags);
+
+  /* Reset the TCB and give it back its stack */
+
+  stack   = tcb->stack_alloc_ptr;
+  tcbsize = ttype == TCB_FLAG_TTYPE_PTHREAD ?
+            sizeof(struct pthread_tcb_s) : sizeof(struct task_tcb_s);
+
+  memset(tcb, 0, tcbsize);
+  if (up_use_stack(tcb, stack, stack_size) < 0)
+    {
+      /* Should not happen, the stack is already known to be big enough */
+
+      tcb->stack_alloc_ptr = stack;
+      tcb->flags           = TCB_FLAG_FREE_STACK;
+      up_release_stack(tcb, ttype);
+      kmm_free(tcb);
+      return NULL;
+    }
+
+  /* The stack was allocated by up_create_stack() and must be freed again
+   * when the TCB leaves the cache for good.
+   */
+
+  tcb->flags |= TCB_FLAG_FREE_STACK;
+  return tcb;
+}
+
+/****************************************************************************
+ * Name: nxtask_tcbcache_put
+ *
+ * Description:
+ *   Keep a released TCB together with its stack for a new thread of the
+ *   same type.  This is called by nxsched_release_tcb() once everything
+ *   else of the TCB has been released.
+ *
+ * Input Parameters:
+ *   tcb   - The released TCB
+ *   ttype - The thread type of the TCB
+ *
+ * Returned Value:
+ *   true if the TCB and its stack are now owned by the cache; false if the
+ *   caller has to free them.
+ *
+ ****************************************************************************/
+
+bool nxtask_tcbcache_put(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+  irqstate_t flags;
+  size_t size;
+
+  /* Only stacks allocated by up_create_stack() can be kept */
+
+  if (tcb->stack_alloc_ptr == NULL ||
+      (tcb->flags & TCB_FLAG_FREE_STACK) == 0)
+    {
+      return false;
+    }
+
+  size = nxtask_tcbcache_stacksize(tcb, ttype);
+#if CONFIG_SCHED_TCB_CACHE_MAXSTACK > 0
+  if (size > CONFIG_SCHED_TCB_CACHE_MAXSTACK)
+    {
+      return false;
+    }
+#endif
+
+  flags = enter_critical_section();
+
+  if (g_tcbcache_nentries >= CONFIG_SCHED_TCB_CACHE_NENTRIES)
+    {
+      leave_critical_section(flags);
+      return false;
+    }
+
+  tcb->flags          = ttype;
+  tcb->adj_stack_size = size;
+
+  sq_addfirst((FAR sq_entry_t *)tcb, &g_tcbcache);
+  g_tcbcache_nentries++;
+
+  leave_critical_section(flags);
+  return true;
+}
+
+#endif /* CONFIG_SCHED_TCB_CACHE */
@@ -130,6 +130,50 @@ static inline void wd_expiration(void)
     }
 }
 
+/****************************************************************************
+ * Name: wd_nextdelay
+ *
+ * Description:
+ *   Return the delay of the next interval timer event.  Every watchdog
+ *   must expire within its slack, so the event is due at the earliest
+ *   delay plus slack of all watchdogs.  All the watchdogs whose delay has
+ *   elapsed by then expire together.  The list is sorted, the search ends
+ *   at the first watchdog that is due after the best time found so far.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TIMER_SLACK
+static unsigned int wd_nextdelay(void)
+{
+  FAR struct wdog_s *wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+  sclock_t delay;
+  sclock_t best;
+
+  if (wdog == NULL)
+    {
+      return 0;
+    }
+
+  /* Watchdogs whose expiration is still pending are already late */
+
+  if (wdog->lag <= 0)
+    {
+      return 1;
+    }
+
+  delay = wdog->lag;
+  best  = delay + MIN(wdog->slack, INT32_MAX - delay);
+
+  while ((wdog = wdog->next) != NULL &&
+         (delay += wdog->lag) < best)
+    {
+      best = MIN(best, delay + MIN(wdog->slack, INT32_MAX - delay));
+    }
+
+  return best;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -170,8 +214,39 @@ static inline void wd_expiration(void)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
 int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
              wdentry_t wdentry, wdparm_t arg)
+{
+  return wd_start_slack(wdog, delay, 0, wdentry, arg);
+}
+
+/****************************************************************************
+ * Name: wd_start_slack
+ *
+ * Description:
+ *   This function is the same as wd_start() but lets the watchdog expire
+ *   up to 'slack' ticks late.
+ *
+ * Input Parameters:
+ *   wdog     - Watchdog ID
+ *   delay    - Delay count in clock ticks
+ *   slack    - The allowed delay of the expiration in clock ticks
+ *   wdentry  - Function to call on timeout
+ *   arg      - Parameter to pass to wdentry
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is return to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
+
+int wd_start_slack(FAR struct wdog_s *wdog, sclock_t delay, sclock_t slack,
+                   wdentry_t wdentry, wdparm_t arg)
+#else
+int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
+             wdentry_t wdentry, wdparm_t arg)
+#endif
 {
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
@@ -186,6 +261,13 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
       return -EINVAL;
     }
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  if (slack < 0)
+    {
+      return -EINVAL;
+    }
+#endif
+
   /* Check if the watchdog has been started. If so, stop it.
    * NOTE:  There is a race condition here... the caller may receive
    * the watchdog between the time that wd_start is called and
@@ -203,6 +285,9 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
   wdog->func = wdentry;         /* Function to execute when delay expires */
   up_getpicbase(&wdog->picbase);
   wdog->arg = arg;
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  wdog->slack = slack;
+#endif
 
   /* Calculate delay+1, forcing the delay into a range that we can handle.
    *
@@ -409,8 +494,12 @@ unsigned int wd_timer(int ticks, bool noswitches)
 
   /* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_SCHED_TIMER_SLACK
+  ret = wd_nextdelay();
+#else
   ret = g_wdactivelist.head ?
         MAX(((FAR struct wdog_s *)g_wdactivelist.head)->lag, 1) : 0;
+#endif
 
   /* Return the delay for the next watchdog to expire */
 
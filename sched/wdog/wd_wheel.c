@@ -0,0 +1,555 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_WDOG_TIMER_WHEEL_SIZE & (CONFIG_WDOG_TIMER_WHEEL_SIZE - 1)) != 0
+#  error CONFIG_WDOG_TIMER_WHEEL_SIZE must be a power of two
+#endif
+
+#define WD_WHEEL_MASK    (CONFIG_WDOG_TIMER_WHEEL_SIZE - 1)
+
+/* The slot of the watchdogs expiring at time 't' */
+
+#define WD_SLOT(t)       (&g_wdwheel[(t) & WD_WHEEL_MASK])
+
+/* The number of ticks from now until the watchdog expires */
+
+#define WD_REMAINING(w)  ((sclock_t)((w)->expired - g_wdtickbase))
+
+#ifndef MAX
+#  define MAX(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#ifndef CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG
+#  define CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG 0
+#endif
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG > 0
+#  define CALL_FUNC(func, arg) \
+     do \
+       { \
+         uint32_t start; \
+         uint32_t elapsed; \
+         start = up_perf_gettime(); \
+         func(arg); \
+         elapsed = up_perf_gettime() - start; \
+         if (elapsed > CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG) \
+           { \
+             serr("WDOG %p, %s IRQ, execute too long %"PRIu32"\n", \
+                   func, up_interrupt_context() ? "IN" : "NOT", elapsed); \
+           } \
+       } \
+     while (0)
+#else
+#  define CALL_FUNC(func, arg) func(arg)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The active watchdogs that have not expired yet.  A watchdog is in the
+ * slot of its expiration time modulo the wheel size, in the order in which
+ * the watchdogs were started.  The slot may hold watchdogs of later
+ * revolutions of the wheel.
+ */
+
+static dq_queue_t g_wdwheel[CONFIG_WDOG_TIMER_WHEEL_SIZE];
+static unsigned int g_wdnwheel;
+
+/* The watchdogs whose expiration time has been reached, in the order of
+ * expiration, but whose function has not been called yet.
+ */
+
+static dq_queue_t g_wdexpired;
+
+/* The earliest expiration time in the wheel, if g_wdnextvalid */
+
+static clock_t g_wdnext;
+static bool g_wdnextvalid;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_nextexpiry
+ *
+ * Description:
+ *   Return the earliest expiration time of the watchdogs in the wheel.  The
+ *   value is cached, the wheel is only searched after the watchdog that
+ *   expires first was removed.  The search then ends at the first slot
+ *   holding a watchdog of the current revolution of the wheel.
+ *
+ * Returned Value:
+ *   true if the wheel holds any watchdog.
+ *
+ ****************************************************************************/
+
+static bool wd_nextexpiry(FAR clock_t *next)
+{
+  FAR struct wdog_s *wdog;
+  sclock_t remaining;
+  sclock_t delay;
+  clock_t time;
+  int i;
+
+  if (g_wdnextvalid)
+    {
+      *next = g_wdnext;
+      return true;
+    }
+
+  if (g_wdnwheel == 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i <= CONFIG_WDOG_TIMER_WHEEL_SIZE; i++)
+    {
+      time = g_wdtickbase + i;
+      for (wdog = (FAR struct wdog_s *)dq_peek(WD_SLOT(time));
+           wdog != NULL;
+           wdog = wdog->next)
+        {
+          if (wdog->expired == time)
+            {
+              goto found;
+            }
+        }
+    }
+
+  /* All watchdogs expire in a later revolution of the wheel */
+
+  delay = 0;
+  for (i = 0; i < CONFIG_WDOG_TIMER_WHEEL_SIZE; i++)
+    {
+      for (wdog = (FAR struct wdog_s *)dq_peek(&g_wdwheel[i]);
+           wdog != NULL;
+           wdog = wdog->next)
+        {
+          remaining = WD_REMAINING(wdog);
+          if (delay == 0 || remaining < delay)
+            {
+              delay = remaining;
+            }
+        }
+    }
+
+  time = g_wdtickbase + delay;
+
+found:
+  g_wdnext      = time;
+  g_wdnextvalid = true;
+  *next         = time;
+  return true;
+}
+
+/****************************************************************************
+ * Name: wd_expire
+ *
+ * Description:
+ *   Move the watchdogs that expire at 'time' from the wheel to the list of
+ *   the expired watchdogs.
+ *
+ ****************************************************************************/
+
+static void wd_expire(clock_t time)
+{
+  FAR dq_queue_t *slot = WD_SLOT(time);
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+
+  for (wdog = (FAR struct wdog_s *)dq_peek(slot); wdog != NULL; wdog = next)
+    {
+      next = wdog->next;
+      if (wdog->expired == time)
+        {
+          dq_rem((FAR dq_entry_t *)wdog, slot);
+          dq_addlast((FAR dq_entry_t *)wdog, &g_wdexpired);
+          g_wdnwheel--;
+        }
+    }
+
+  if (g_wdnextvalid && g_wdnext == time)
+    {
+      g_wdnextvalid = false;
+    }
+}
+
+/****************************************************************************
+ * Name: wd_expiration
+ *
+ * Description:
+ *   Execute the expired watchdogs in the order of their expiration.
+ *
+ ****************************************************************************/
+
+static inline void wd_expiration(void)
+{
+  FAR struct wdog_s *wdog;
+  wdentry_t func;
+
+  while ((wdog = (FAR struct wdog_s *)dq_remfirst(&g_wdexpired)) != NULL)
+    {
+      /* Indicate that the watchdog is no longer active. */
+
+      func = wdog->func;
+      wdog->func = NULL;
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(wdog->picbase);
+      CALL_FUNC(func, wdog->arg);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_start
+ *
+ * Description:
+ *   This function adds a watchdog timer to the active timer queue.  The
+ *   specified watchdog function at 'wdentry' will be called from the
+ *   interrupt level after the specified number of ticks has elapsed.
+ *   Watchdog timers may be started from the interrupt level.
+ *
+ *   Watchdog timers execute in the address environment that was in effect
+ *   when wd_start() is called.
+ *
+ *   Watchdog timers execute only once.
+ *
+ *   To replace either the timeout delay or the function to be executed,
+ *   call wd_start again with the same wdog; only the most recent wdStart()
+ *   on a given watchdog ID has any effect.
+ *
+ * Input Parameters:
+ *   wdog     - Watchdog ID
+ *   delay    - Delay count in clock ticks
+ *   wdentry  - Function to call on timeout
+ *   arg      - Parameter to pass to wdentry
+ *
+ *   NOTE:  The parameter must be of type wdparm_t.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is return to
+ *   indicate the nature of any failure.
+ *
+ * Assumptions:
+ *   The watchdog routine runs in the context of the timer interrupt handler
+ *   and is subject to all ISR restrictions.
+ *
+ ****************************************************************************/
+
+int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
+             wdentry_t wdentry, wdparm_t arg)
+{
+  irqstate_t flags;
+
+  /* Verify the wdog and setup parameters */
+
+  if (wdog == NULL || wdentry == NULL || delay < 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Check if the watchdog has been started. If so, stop it. */
+
+  flags = enter_critical_section();
+  if (WDOG_ISACTIVE(wdog))
+    {
+      wd_cancel(wdog);
+    }
+
+  /* Save the data in the watchdog structure */
+
+  wdog->func = wdentry;         /* Function to execute when delay expires */
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+
+  /* Calculate delay+1, forcing the delay into a range that we can handle.
+   * As with the sorted list, the wdog delays FOR AT LEAST as long as
+   * requested, the phase of the system timer is unknown.
+   */
+
+  if (delay <= 0)
+    {
+      delay = 1;
+    }
+  else if (++delay <= 0)
+    {
+      delay--;
+    }
+
+#ifdef CONFIG_SCHED_TICKLESS
+  /* Cancel the interval timer that drives the timing events.  This brings
+   * g_wdtickbase up to date.
+   */
+
+  nxsched_cancel_timer();
+
+  /* The interval timer may not run without active watchdogs */
+
+  if (g_wdnwheel == 0 && dq_empty(&g_wdexpired))
+    {
+      g_wdtickbase = clock_systime_ticks();
+    }
+#endif
+
+  /* Add the watchdog at the end of its slot */
+
+  wdog->expired = g_wdtickbase + delay;
+  dq_addlast((FAR dq_entry_t *)wdog, WD_SLOT(wdog->expired));
+
+  if (g_wdnwheel++ == 0)
+    {
+      g_wdnext      = wdog->expired;
+      g_wdnextvalid = true;
+    }
+  else if (g_wdnextvalid &&
+           WD_REMAINING(wdog) < (sclock_t)(g_wdnext - g_wdtickbase))
+    {
+      g_wdnext = wdog->expired;
+    }
+
+#ifdef CONFIG_SCHED_TICKLESS
+  /* Resume the interval timer that will generate the next interval event.
+   * If the first watchdog to expire changed, then this will pick that new
+   * delay.
+   */
+
+  nxsched_resume_timer();
+#endif
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wd_timer
+ *
+ * Description:
+ *   This function is called from the timer interrupt handler to determine
+ *   if it is time to execute a watchdog function.  If so, the watchdog
+ *   function will be executed in the context of the timer interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   ticks - If CONFIG_SCHED_TICKLESS is defined then the number of ticks
+ *     in the interval that just expired is provided.  Otherwise,
+ *     this function is called on each timer interrupt and a value of one
+ *     is implicit.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   If CONFIG_SCHED_TICKLESS is defined then the number of ticks for the
+ *   next delay is provided (zero if no delay).  Otherwise, this function
+ *   has no returned value.
+ *
+ * Assumptions:
+ *   Called from interrupt handler logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS
+unsigned int wd_timer(int ticks, bool noswitches)
+{
+  clock_t next;
+  sclock_t delay;
+
+  /* Advance to each expiration time within the elapsed interval and move
+   * the watchdogs expiring then to the expired list, in order.
+   */
+
+  while (ticks > 0 && wd_nextexpiry(&next))
+    {
+      delay = (sclock_t)(next - g_wdtickbase);
+      if (delay > ticks)
+        {
+          break;
+        }
+
+      g_wdtickbase = next;
+      ticks       -= delay;
+      wd_expire(next);
+    }
+
+  g_wdtickbase += ticks;
+
+  /* Execute the expired watchdogs */
+
+  if (!noswitches)
+    {
+      wd_expiration();
+    }
+
+  /* Return the delay for the next watchdog to expire */
+
+  if (!dq_empty(&g_wdexpired))
+    {
+      return 1;
+    }
+  else if (wd_nextexpiry(&next))
+    {
+      return MAX((sclock_t)(next - g_wdtickbase), 1);
+    }
+
+  return 0;
+}
+
+#else
+void wd_timer(void)
+{
+  /* Move the watchdogs expiring at this tick to the expired list */
+
+  g_wdtickbase++;
+  if (g_wdnwheel > 0)
+    {
+      wd_expire(g_wdtickbase);
+      wd_expiration();
+    }
+}
+#endif /* CONFIG_SCHED_TICKLESS */
+
+/****************************************************************************
+ * Name: wd_cancel
+ *
+ * Description:
+ *   This function cancels a currently running watchdog timer. Watchdog
+ *   timers may be canceled from the interrupt level.
+ *
+ * Input Parameters:
+ *   wdog - ID of the watchdog to cancel.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
+
+int wd_cancel(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  int ret = -EINVAL;
+
+  flags = enter_critical_section();
+
+  /* Make sure that the watchdog is initialized (non-NULL) and is still
+   * active.
+   */
+
+  if (wdog != NULL && WDOG_ISACTIVE(wdog))
+    {
+      /* The watchdogs whose time was reached are in the expired list, the
+       * others are in the slot of their expiration time.
+       */
+
+      if (WD_REMAINING(wdog) <= 0)
+        {
+          dq_rem((FAR dq_entry_t *)wdog, &g_wdexpired);
+        }
+      else
+        {
+          dq_rem((FAR dq_entry_t *)wdog, WD_SLOT(wdog->expired));
+          g_wdnwheel--;
+
+          /* Reassess the interval timer if this was the watchdog that
+           * expires first.
+           */
+
+          if (!g_wdnextvalid || g_wdnext == wdog->expired)
+            {
+              g_wdnextvalid = false;
+              nxsched_reassess_timer();
+            }
+        }
+
+      /* Mark the watchdog inactive */
+
+      wdog->func = NULL;
+
+      /* Return success */
+
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: wd_gettime
+ *
+ * Description:
+ *   This function returns the time remaining before the specified watchdog
+ *   timer expires.
+ *
+ * Input Parameters:
+ *   wdog - watchdog ID
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the watchdog time expires.
+ *   Zero means either that wdog is not valid or that the wdog has already
+ *   expired.
+ *
+ ****************************************************************************/
+
+sclock_t wd_gettime(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  sclock_t delay = 0;
+
+  flags = enter_critical_section();
+  if (wdog != NULL && WDOG_ISACTIVE(wdog))
+    {
+      delay = WD_REMAINING(wdog) - wd_elapse();
+    }
+
+  leave_critical_section(flags);
+  return delay;
+}
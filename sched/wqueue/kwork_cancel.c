@@ -49,7 +49,6 @@
  *   work_queue() again.
  *
  * Input Parameters:
- *   qid    - The work queue ID
  *   work   - The previously queued work structure to cancel
  *
  * Returned Value:
@@ -57,12 +56,10 @@
  *   reported:
  *
  *   -ENOENT - There is no such work queued.
- *   -EINVAL - An invalid work queue was specified
  *
  ****************************************************************************/
 
-static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
-                        FAR struct work_s *work)
+static int work_qcancel(FAR struct work_s *work)
 {
   irqstate_t flags;
   int ret = -ENOENT;
@@ -87,7 +84,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
         }
       else
         {
-          dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+          dq_rem((FAR dq_entry_t *)work, &work->wq->q);
         }
 
       work->worker = NULL;
@@ -125,27 +122,46 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Cancel high priority work */
+  /* The work is removed from the queue that it was queued in, that may be
+   * the queue of another CPU with per-CPU high priority work queues.
+   */
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
+  if (work_qid2wq(qid) == NULL)
     {
-      /* Cancel low priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
+      return -EINVAL;
     }
-  else
-#endif
+
+  return work_qcancel(work);
+}
+
+/****************************************************************************
+ * Name: work_cancel_wq
+ *
+ * Description:
+ *   Cancel work previously queued with work_queue_wq().
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The previously queued work structure to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno on failure.  This error may be
+ *   reported:
+ *
+ *   -ENOENT - There is no such work queued.
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
+                   FAR struct work_s *work)
+{
+  if (wqueue == NULL)
     {
       return -EINVAL;
     }
+
+  return work_qcancel(work);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
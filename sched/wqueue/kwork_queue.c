@@ -43,54 +43,70 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: hp_work_timer_expiry
+ * Name: work_qqueue
+ *
+ * Description:
+ *   Add the work to the queue and wake up one worker thread.  With
+ *   CONFIG_WQUEUE_PRIORITY, the work goes behind all pending work of the
+ *   same or higher priority.  The queue is searched from the tail so that
+ *   work of a single priority is queued in constant time.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_HPWORK
-static void hp_work_timer_expiry(wdparm_t arg)
+static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_s *work)
 {
-  irqstate_t flags = enter_critical_section();
-  dq_addlast((FAR dq_entry_t *)arg, &g_hpwork.q);
-  nxsem_post(&g_hpwork.sem);
-  leave_critical_section(flags);
-}
+#ifdef CONFIG_WQUEUE_PRIORITY
+  FAR dq_entry_t *prev;
+
+  for (prev = dq_tail(&wqueue->q);
+       prev != NULL && ((FAR struct work_s *)prev)->prio < work->prio;
+       prev = dq_prev(prev));
+
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->q);
+    }
+  else
+    {
+      dq_addafter(prev, (FAR dq_entry_t *)work, &wqueue->q);
+    }
+#else
+  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
 #endif
 
+  nxsem_post(&wqueue->sem);
+}
+
 /****************************************************************************
- * Name: lp_work_timer_expiry
+ * Name: work_timer_expiry
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_LPWORK
-static void lp_work_timer_expiry(wdparm_t arg)
+static void work_timer_expiry(wdparm_t arg)
 {
+  FAR struct work_s *work = (FAR struct work_s *)arg;
   irqstate_t flags = enter_critical_section();
-  dq_addlast((FAR dq_entry_t *)arg, &g_lpwork.q);
-  nxsem_post(&g_lpwork.sem);
+
+  work_qqueue(work->wq, work);
   leave_critical_section(flags);
 }
-#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_queue
+ * Name: work_queue_wq
  *
  * Description:
- *   Queue kernel-mode work to be performed at a later time.  All queued
- *   work will be performed on the worker thread of execution (not the
- *   caller's).
- *
- *   The work structure is allocated and must be initialized to all zero by
- *   the caller.  Otherwise, the work structure is completely managed by the
- *   work queue logic.  The caller should never modify the contents of the
- *   work queue structure directly.  If work_queue() is called before the
- *   previous work has been performed and removed from the queue, then any
- *   pending work will be canceled and lost.
+ *   Queue work to be performed on a work queue created by
+ *   work_queue_create().  See work_queue().
  *
  * Input Parameters:
- *   qid    - The work queue ID (index)
+ *   wqueue - The work queue
  *   work   - The work structure to queue
  *   worker - The worker callback to be invoked.  The callback will be
  *            invoked on the worker thread of execution.
@@ -104,11 +120,16 @@ static void lp_work_timer_expiry(wdparm_t arg)
  *
  ****************************************************************************/
 
-int work_queue(int qid, FAR struct work_s *work, worker_t worker,
-               FAR void *arg, clock_t delay)
+int work_queue_wq(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay)
 {
   irqstate_t flags;
-  int ret = OK;
+
+  if (wqueue == NULL || work == NULL)
+    {
+      return -EINVAL;
+    }
 
   /* Interrupts are disabled so that this logic can be called from with
    * task logic or from interrupt handling logic.
@@ -116,60 +137,70 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
 
   flags = enter_critical_section();
 
-  /* Remove the entry from the timer and work queue. */
+  /* Remove the entry from the timer and work queue, the work may still be
+   * queued in another work queue.
+   */
 
-  work_cancel(qid, work);
+  if (!work_available(work))
+    {
+      work_cancel_wq(work->wq, work);
+    }
 
   /* Initialize the work structure. */
 
   work->worker = worker;           /* Work callback. non-NULL means queued */
   work->arg = arg;                 /* Callback argument */
+  work->wq = wqueue;               /* Queue of the work */
 
   /* Queue the new work */
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
+  if (!delay)
     {
-      /* Queue high priority work */
-
-      if (!delay)
-        {
-          dq_addlast((FAR dq_entry_t *)work, &g_hpwork.q);
-          nxsem_post(&g_hpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, hp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
+      work_qqueue(wqueue, work);
     }
   else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
     {
-      /* Queue low priority work */
-
-      if (!delay)
-        {
-          dq_addlast((FAR dq_entry_t *)work, &g_lpwork.q);
-          nxsem_post(&g_lpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, lp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
-    }
-  else
-#endif
-    {
-      ret = -EINVAL;
+      wd_start(&work->u.timer, delay, work_timer_expiry, (wdparm_t)work);
     }
 
   leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: work_queue
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed at a later time.  All queued
+ *   work will be performed on the worker thread of execution (not the
+ *   caller's).
+ *
+ *   The work structure is allocated and must be initialized to all zero by
+ *   the caller.  Otherwise, the work structure is completely managed by the
+ *   work queue logic.  The caller should never modify the contents of the
+ *   work queue structure directly.  If work_queue() is called before the
+ *   previous work has been performed and removed from the queue, then any
+ *   pending work will be canceled and lost.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will be
+ *            invoked on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
 
-  return ret;
+int work_queue(int qid, FAR struct work_s *work, worker_t worker,
+               FAR void *arg, clock_t delay)
+{
+  return work_queue_wq(work_qid2wq(qid), work, worker, arg, delay);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
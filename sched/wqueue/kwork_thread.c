@@ -35,7 +35,9 @@
 #include <debug.h>
 
 #include <nuttx/wqueue.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
+#include <nuttx/sched.h>
 #include <nuttx/semaphore.h>
 
 #include "wqueue/wqueue.h"
@@ -75,12 +77,17 @@
  ****************************************************************************/
 
 #if defined(CONFIG_SCHED_HPWORK)
-/* The state of the kernel mode, high priority work queue(s). */
+/* The state of the kernel mode, high priority work queue(s).  Work may be
+ * queued before the worker threads are started, that work goes to the
+ * statically initialized queue of CPU0.
+ */
 
-struct hp_wqueue_s g_hpwork =
+struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES] =
 {
-  {NULL, NULL},
-  NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE),
+  {
+    {NULL, NULL},
+    NXSEM_INITIALIZER(0, PRIOINHERIT_FLAGS_DISABLE),
+  },
 };
 
 #endif /* CONFIG_SCHED_HPWORK */
@@ -218,7 +225,7 @@ static int work_thread_create(FAR const char *name, int priority,
   argv[1] = NULL;
 
   /* Don't permit any of the threads to run until we have fully initialized
-   * g_hpwork and g_lpwork.
+   * the work queue.
    */
 
   sched_lock();
@@ -237,6 +244,7 @@ static int work_thread_create(FAR const char *name, int priority,
         }
 
       wqueue->worker[wndx].pid  = pid;
+      wqueue->nthreads++;
     }
 
   sched_unlock();
@@ -267,33 +275,93 @@ static int work_thread_create(FAR const char *name, int priority,
 void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
 {
   FAR struct kwork_wqueue_s *wqueue;
-  int nthread;
+  int nqueues;
   int wndx;
+  int i;
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
+  for (i = 0; ; i++)
     {
-      wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork;
-      nthread = CONFIG_SCHED_HPNTHREADS;
-    }
-  else
+#ifdef CONFIG_SCHED_HPWORK
+      if (qid == HPWORK)
+        {
+          wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork[i];
+          nqueues = HPWORK_NQUEUES;
+        }
+      else
 #endif
 #ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
+      if (qid == LPWORK)
+        {
+          wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
+          nqueues = 1;
+        }
+      else
+#endif
+        {
+          return;
+        }
+
+      for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+        {
+          handler(wqueue->worker[wndx].pid, arg);
+        }
+
+      if (i + 1 >= nqueues)
+        {
+          return;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: work_queue_create
+ *
+ * Description:
+ *   Create a kernel work queue served by its own pool of worker threads.
+ *   The work queue exists until the system is reset.
+ *
+ * Input Parameters:
+ *   name       - Name of the worker threads
+ *   priority   - Priority of the worker threads
+ *   stack_size - Stack size of each worker thread
+ *   nthreads   - Number of worker threads
+ *
+ * Returned Value:
+ *   The work queue on success; NULL on failure.  If only some of the
+ *   threads could be started, the work queue is served by those.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
+                                             int priority, int stack_size,
+                                             int nthreads)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+
+  if (name == NULL || nthreads < 1)
     {
-      wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
-      nthread = CONFIG_SCHED_LPNTHREADS;
+      return NULL;
     }
-  else
-#endif
+
+  wqueue = kmm_zalloc(sizeof(struct kwork_wqueue_s) +
+                      (nthreads - 1) * sizeof(struct kworker_s));
+  if (wqueue == NULL)
     {
-      return;
+      return NULL;
     }
 
-  for (wndx = 0; wndx < nthread; wndx++)
+  nxsem_init(&wqueue->sem, 0, 0);
+  nxsem_set_protocol(&wqueue->sem, SEM_PRIO_NONE);
+
+  work_thread_create(name, priority, stack_size, nthreads, wqueue);
+  if (wqueue->nthreads == 0)
     {
-      handler(wqueue->worker[wndx].pid, arg);
+      nxsem_destroy(&wqueue->sem);
+      kmm_free(wqueue);
+      return NULL;
     }
+
+  return wqueue;
 }
 
 /****************************************************************************
@@ -313,6 +381,55 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
 #if defined(CONFIG_SCHED_HPWORK)
 int work_start_highpri(void)
 {
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  FAR struct hp_wqueue_s *wqueue;
+  cpu_set_t cpuset;
+  char name[16];
+  int wndx;
+  int ret;
+  int cpu;
+
+  /* Start the high-priority, kernel mode worker thread(s) of each CPU and
+   * bind them to that CPU.  The threads are bound before they first run.
+   */
+
+  sinfo("Starting high-priority kernel worker thread(s) of each CPU\n");
+
+  sched_lock();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      wqueue = &g_hpwork[cpu];
+      if (cpu > 0)
+        {
+          nxsem_init(&wqueue->sem, 0, 0);
+          nxsem_set_protocol(&wqueue->sem, SEM_PRIO_NONE);
+        }
+
+      snprintf(name, sizeof(name), HPWORKNAME "%d", cpu);
+      ret = work_thread_create(name, CONFIG_SCHED_HPWORKPRIORITY,
+                               CONFIG_SCHED_HPWORKSTACKSIZE,
+                               CONFIG_SCHED_HPNTHREADS,
+                               (FAR struct kwork_wqueue_s *)wqueue);
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+
+      for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+        {
+          nxsched_set_affinity(wqueue->worker[wndx].pid, sizeof(cpu_set_t),
+                               &cpuset);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  sched_unlock();
+  return ret;
+#else
   /* Start the high-priority, kernel mode worker thread(s) */
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
@@ -320,7 +437,8 @@ int work_start_highpri(void)
   return work_thread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
                             CONFIG_SCHED_HPWORKSTACKSIZE,
                             CONFIG_SCHED_HPNTHREADS,
-                            (FAR struct kwork_wqueue_s *)&g_hpwork);
+                            (FAR struct kwork_wqueue_s *)&g_hpwork[0]);
+#endif
 }
 #endif /* CONFIG_SCHED_HPWORK */
 
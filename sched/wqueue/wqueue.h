@@ -30,7 +30,9 @@
 #include <stdbool.h>
 #include <queue.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +45,14 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* The number of high priority work queues */
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+#  define HPWORK_NQUEUES CONFIG_SMP_NCPUS
+#else
+#  define HPWORK_NQUEUES 1
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -54,12 +64,16 @@ struct kworker_s
   pid_t             pid;       /* The task ID of the worker thread */
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.  The
+ * queues created by work_queue_create() are allocated with as many
+ * entries in worker[] as they have threads.
+ */
 
 struct kwork_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  int               nthreads;  /* The number of started worker threads */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -72,6 +86,7 @@ struct hp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  int               nthreads;  /* The number of started worker threads */
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -88,6 +103,7 @@ struct lp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+  int               nthreads;  /* The number of started worker threads */
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -100,9 +116,11 @@ struct lp_wqueue_s
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_HPWORK
-/* The state of the kernel mode, high priority work queue. */
+/* The state of the kernel mode, high priority work queue(s).  With
+ * CONFIG_SCHED_HPWORK_PERCPU, there is one queue for each CPU.
+ */
 
-extern struct hp_wqueue_s g_hpwork;
+extern struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
 #endif
 
 #ifdef CONFIG_SCHED_LPWORK
@@ -111,6 +129,56 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the work queue for a work queue ID.  With per-CPU high priority
+ *   work queues, this is the queue of the calling CPU once its threads are
+ *   started, the queue of CPU0 before.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID
+ *
+ * Returned Value:
+ *   The work queue or NULL if the ID is not valid.
+ *
+ ****************************************************************************/
+
+static inline FAR struct kwork_wqueue_s *work_qid2wq(int qid)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      FAR struct hp_wqueue_s *wqueue = &g_hpwork[up_cpu_index()];
+
+      if (wqueue->nthreads > 0)
+        {
+          return (FAR struct kwork_wqueue_s *)wqueue;
+        }
+#endif
+
+      return (FAR struct kwork_wqueue_s *)&g_hpwork[0];
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+  else
+#endif
+    {
+      return NULL;
+    }
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -0,0 +1,105 @@
+/****************************************************************************
+ * syscall/syscall_batch.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <syscall.h>
+#include <errno.h>
+
+/* The content of this file is only meaningful during the kernel phase of
+ * a kernel build.
+ */
+
+#if defined(CONFIG_LIB_SYSCALL) && defined(CONFIG_SYSCALL_BATCH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The stubs all take the system call number and up to six parameters:
+ * They are called the way the architectures call them, with all of the
+ * parameters whatever their number is.
+ */
+
+typedef uintptr_t (*syscall_stub_t)(int nbr, uintptr_t parm1,
+                                    uintptr_t parm2, uintptr_t parm3,
+                                    uintptr_t parm4, uintptr_t parm5,
+                                    uintptr_t parm6);
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syscall_batch
+ ****************************************************************************/
+
+int syscall_batch(FAR struct syscall_batch_s *calls, int ncalls)
+{
+  FAR struct syscall_batch_s *call;
+  syscall_stub_t stub;
+  int index;
+  int i;
+
+  if (ncalls < 0 || (calls == NULL && ncalls > 0))
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  for (i = 0; i < ncalls; i++)
+    {
+      call = &calls[i];
+
+      /* A nested batch would recurse, and vfork() needs the frame of its
+       * own trap.
+       */
+
+      if (call->nbr < CONFIG_SYS_RESERVED || call->nbr >= SYS_maxsyscall ||
+#if defined(CONFIG_SCHED_WAITPID) && defined(CONFIG_ARCH_HAVE_VFORK)
+          call->nbr == SYS_vfork ||
+#endif
+          call->nbr == SYS_syscall_batch)
+        {
+          set_errno(ENOSYS);
+          return i > 0 ? i : ERROR;
+        }
+
+      /* The stubs take the number offset by the reserved ones, as the
+       * dispatchers of the architectures pass it.
+       */
+
+      index = call->nbr - CONFIG_SYS_RESERVED;
+      stub  = (syscall_stub_t)g_stublookup[index];
+
+      call->result = stub(index, call->parm[0], call->parm[1],
+                          call->parm[2], call->parm[3], call->parm[4],
+                          call->parm[5]);
+    }
+
+  return ncalls;
+}
+
+#endif /* CONFIG_LIB_SYSCALL && CONFIG_SYSCALL_BATCH */
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+# tools/heapprof.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+import argparse
+import struct
+import subprocess
+import sys
+
+program_description = """
+This program converts the notes of the sampling heap profiler
+(CONFIG_MM_HEAP_PROFILE) into folded stacks, one "frame;frame;... weight"
+line per allocation site, as consumed by flamegraph.pl or speedscope.
+The input is the raw note stream read from /dev/note.  The layout options
+must match the configuration of the target.
+"""
+
+NOTE_DUMP_BINARY = 23
+MM_PROFILE_NOTE_ALLOC = 0xA0
+MM_PROFILE_NOTE_FREE = 0xA1
+
+
+class sample:
+    def __init__(self, size, stack):
+        self.size = size
+        self.stack = stack
+        self.lifetime = None
+
+
+def parse_notes(data, args):
+    endian = ">" if args.big_endian else "<"
+    ptr = "I" if args.pointer_size == 4 else "Q"
+
+    # struct note_common_s and the ip and event fields of
+    # struct note_binary_s
+
+    hdrlen = 3 + (1 if args.smp else 0) + args.pid_size
+    if args.hires:
+        hdrlen += args.time_size + args.long_size
+    else:
+        hdrlen += args.time_size
+    hdrlen += args.pointer_size + 1
+
+    samples = {}
+    offset = 0
+    while offset + 2 <= len(data):
+        length = data[offset]
+        notetype = data[offset + 1]
+        if length == 0:
+            break
+
+        note = data[offset : offset + length]
+        offset += length
+
+        if notetype != NOTE_DUMP_BINARY or length < hdrlen:
+            continue
+
+        event = note[hdrlen - 1]
+        payload = note[hdrlen:]
+        if event == MM_PROFILE_NOTE_ALLOC:
+            fmt = endian + "II" + ptr
+            fixed = struct.calcsize(fmt)
+            if len(payload) < fixed:
+                continue
+
+            sid, size, addr = struct.unpack_from(fmt, payload)
+            depth = (len(payload) - fixed) // args.pointer_size
+            stack = struct.unpack_from(endian + ptr * depth, payload, fixed)
+            samples[sid] = sample(size, list(stack)[args.skip :])
+        elif event == MM_PROFILE_NOTE_FREE:
+            fmt = endian + "II" + ptr
+            if len(payload) < struct.calcsize(fmt):
+                continue
+
+            sid, lifetime, addr = struct.unpack_from(fmt, payload)
+            if sid in samples:
+                samples[sid].lifetime = lifetime
+
+    return samples
+
+
+def symbolize(samples, elf):
+    names = {}
+    if elf is None:
+        return names
+
+    addrs = sorted({a for s in samples.values() for a in s.stack if a})
+    if not addrs:
+        return names
+
+    out = subprocess.run(
+        ["addr2line", "-f", "-e", elf] + ["0x%x" % a for a in addrs],
+        stdout=subprocess.PIPE,
+        universal_newlines=True,
+        check=True,
+    ).stdout.splitlines()
+
+    for i, addr in enumerate(addrs):
+        name = out[2 * i] if 2 * i < len(out) else "??"
+        names[addr] = name if name != "??" else "0x%x" % addr
+
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description=program_description)
+    parser.add_argument("file", help="raw note stream read from /dev/note")
+    parser.add_argument("-e", "--elf", help="ELF file to resolve the symbols")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    parser.add_argument(
+        "-w",
+        "--weight",
+        choices=["bytes", "count", "live", "lifetime"],
+        default="bytes",
+        help="bytes/count of the sampled allocations, bytes still live, "
+        "or the total lifetime in ticks of the freed allocations",
+    )
+    parser.add_argument(
+        "--skip", type=int, default=0, help="innermost frames to drop"
+    )
+    parser.add_argument("--pointer-size", type=int, choices=[4, 8], default=4)
+    parser.add_argument("--pid-size", type=int, default=4)
+    parser.add_argument(
+        "--time-size", type=int, default=4, help="size of clock_t or time_t"
+    )
+    parser.add_argument(
+        "--long-size", type=int, default=4, help="used with --hires"
+    )
+    parser.add_argument(
+        "--hires",
+        action="store_true",
+        help="CONFIG_SCHED_INSTRUMENTATION_HIRES is enabled",
+    )
+    parser.add_argument(
+        "--smp", action="store_true", help="CONFIG_SMP is enabled"
+    )
+    parser.add_argument("--big-endian", action="store_true")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        samples = parse_notes(f.read(), args)
+
+    names = symbolize(samples, args.elf)
+
+    folded = {}
+    for s in samples.values():
+        if args.weight == "bytes":
+            weight = s.size
+        elif args.weight == "count":
+            weight = 1
+        elif args.weight == "live":
+            weight = s.size if s.lifetime is None else 0
+        else:
+            weight = s.lifetime or 0
+
+        if weight == 0:
+            continue
+
+        frames = [names.get(a, "0x%x" % a) for a in reversed(s.stack) if a]
+        key = ";".join(frames) if frames else "[unknown]"
+        folded[key] = folded.get(key, 0) + weight
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    for key in sorted(folded):
+        out.write("%s %d\n" % (key, folded[key]))
+
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
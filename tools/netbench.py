@@ -0,0 +1,655 @@
+#!/usr/bin/env python3
+# tools/netbench.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+import argparse
+import json
+import os
+import re
+import select
+import socket
+import subprocess
+import sys
+import threading
+import time
+
+program_description = """
+This program benchmarks the network stack of a target running NSH with
+the iperf and tcpecho applications, e.g. the sim:netbench configuration.
+The host is the peer of the target: It measures the TCP and UDP
+throughput in both directions, the round-trip latency and the connection
+setup rate, while sampling /proc/cpuload on the target to derive the CPU
+cost per byte.  The target is driven through the console of a command:
+the simulator itself, or a telnet or serial terminal program for a real
+NIC.  With --loopback, both ends of the transfers run on the target over
+the loopback device.  The chksum test reads the Internet checksum case
+of /proc/bench, with CONFIG_SCHED_BENCH on the target.  The results are
+written as JSON; --baseline compares them with a previous run for
+regression tracking.
+"""
+
+# The configuration options that the results depend on
+
+CONFIG_KEYS = [
+    "CONFIG_ARCH_BOARD",
+    "CONFIG_SMP_NCPUS",
+    "CONFIG_NET_ETH_PKTSIZE",
+    "CONFIG_NET_ARCH_CHKSUM",
+    "CONFIG_NETDEV_CSUM_OFFLOAD",
+    "CONFIG_NET_TCP_WRITE_BUFFERS",
+    "CONFIG_NET_TCP_DELAYED_ACK",
+    "CONFIG_NET_TCP_WINDOW_SCALE",
+    "CONFIG_NET_TCP_WINDOW_SCALE_FACTOR",
+    "CONFIG_NET_UDP_WRITE_BUFFERS",
+    "CONFIG_NET_RECV_BUFSIZE",
+    "CONFIG_NET_SEND_BUFSIZE",
+    "CONFIG_IOB_BUFSIZE",
+    "CONFIG_IOB_NBUFFERS",
+    "CONFIG_IOB_NCHAINS",
+    "CONFIG_IOB_THROTTLE",
+]
+
+# The metrics compared with the baseline and whether more is better
+
+METRICS = {
+    "throughput_bps": True,
+    "packets_per_sec": True,
+    "connections_per_sec": True,
+    "latency_p50_us": False,
+    "latency_p99_us": False,
+    "cpu_ns_per_byte": False,
+    "chksum_ns_per_byte": False,
+}
+
+
+class console:
+    """The NSH console of the target, through the pipes of a command"""
+
+    def __init__(self, command, prompt, verbose):
+        self.proc = subprocess.Popen(
+            command,
+            shell=True,
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            bufsize=0,
+        )
+        self.prompt = prompt.encode()
+        self.verbose = verbose
+        self.output = b""
+        self.lock = threading.Lock()
+
+        self.write("")
+        self.expect(self.prompt, 30)
+
+    def write(self, line):
+        self.proc.stdin.write(line.encode() + b"\n")
+        self.proc.stdin.flush()
+
+    def expect(self, pattern, timeout):
+        """Read until 'pattern' and return what preceded it"""
+
+        deadline = time.monotonic() + timeout
+        while True:
+            index = self.output.find(pattern)
+            if index >= 0:
+                data = self.output[:index]
+                self.output = self.output[index + len(pattern) :]
+                return data.decode(errors="replace")
+
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                raise TimeoutError("no %r from the target" % pattern)
+
+            ready, _, _ = select.select([self.proc.stdout], [], [], remaining)
+            if ready:
+                data = os.read(self.proc.stdout.fileno(), 4096)
+                if not data:
+                    raise EOFError("the target console was closed")
+
+                if self.verbose:
+                    sys.stderr.write(data.decode(errors="replace"))
+
+                self.output += data
+
+    def run(self, command, timeout=10):
+        """Run an NSH command and return its output"""
+
+        with self.lock:
+            self.write(command)
+            output = self.expect(self.prompt, timeout)
+
+        # Drop the echo of the command
+
+        return output.split("\n", 1)[1] if "\n" in output else ""
+
+    def drain(self):
+        """Return the output of the background commands so far"""
+
+        with self.lock:
+            ready, _, _ = select.select([self.proc.stdout], [], [], 0)
+            while ready:
+                data = os.read(self.proc.stdout.fileno(), 4096)
+                if not data:
+                    break
+                self.output += data
+                ready, _, _ = select.select([self.proc.stdout], [], [], 0)
+
+            output = self.output.decode(errors="replace")
+            self.output = b""
+
+        return output
+
+    def close(self, quit):
+        if quit:
+            try:
+                self.write(quit)
+                self.proc.wait(5)
+            except (OSError, subprocess.TimeoutExpired):
+                pass
+
+        if self.proc.poll() is None:
+            self.proc.kill()
+
+
+class cpuload:
+    """Sample the CPU load of the target during a test"""
+
+    def __init__(self, target, period):
+        self.target = target
+        self.period = period
+        self.samples = []
+        self.stop = threading.Event()
+        self.thread = threading.Thread(target=self.sample)
+
+    def sample(self):
+        while not self.stop.wait(self.period):
+            try:
+                output = self.target.run("cat /proc/cpuload")
+            except (TimeoutError, EOFError):
+                return
+
+            match = re.search(r"([0-9.]+)%", output)
+            if match:
+                self.samples.append(float(match.group(1)) / 100)
+
+    def __enter__(self):
+        self.thread.start()
+        return self
+
+    def __exit__(self, *args):
+        self.stop.set()
+        self.thread.join()
+
+    def load(self):
+        if not self.samples:
+            return None
+        return sum(self.samples) / len(self.samples)
+
+
+def parse_iperf_bps(output):
+    """Return the mean of the bandwidths reported by the target iperf"""
+
+    scale = {"": 1, "K": 1e3, "M": 1e6, "G": 1e9}
+    rates = [
+        float(value) * scale[unit]
+        for value, unit in re.findall(r"([0-9.]+)\s*([KMG]?)bits/sec", output)
+    ]
+    if not rates:
+        return None
+    return sum(rates) / len(rates)
+
+
+def percentile(values, fraction):
+    values = sorted(values)
+    index = min(len(values) - 1, int(round(fraction * (len(values) - 1))))
+    return values[index]
+
+
+def finish(result, load, args):
+    """Complete a result with the CPU cost of its bytes"""
+
+    result["cpu_load"] = load
+    if load is not None and result.get("bytes"):
+        ns = load * result["duration"] * 1e9 / result["bytes"]
+        result["cpu_ns_per_byte"] = ns
+        if args.cpu_hz:
+            result["cpu_cycles_per_byte"] = ns * args.cpu_hz / 1e9
+
+    return result
+
+
+def test_tcp_rx(target, args):
+    """The host sends to the iperf server of the target"""
+
+    target.run("iperf -s -p %d &" % args.iperf_port)
+    time.sleep(1)
+
+    data = bytes(args.tcp_size)
+    total = 0
+    with socket.create_connection((args.target_ip, args.iperf_port), 10) as s:
+        with cpuload(target, args.sample) as load:
+            start = time.monotonic()
+            while time.monotonic() - start < args.duration:
+                s.sendall(data)
+                total += len(data)
+
+            s.shutdown(socket.SHUT_WR)
+            elapsed = time.monotonic() - start
+
+    target.run("iperf -a")
+    return finish(
+        {
+            "test": "tcp-rx",
+            "duration": elapsed,
+            "bytes": total,
+            "throughput_bps": total * 8 / elapsed,
+        },
+        load.load(),
+        args,
+    )
+
+
+def test_tcp_tx(target, args):
+    """The iperf client of the target sends to the host"""
+
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as listener:
+        listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        listener.bind(("", args.iperf_port))
+        listener.listen(1)
+        listener.settimeout(10)
+
+        target.run(
+            "iperf -c %s -p %d -t %d &"
+            % (args.host_ip, args.iperf_port, args.duration)
+        )
+
+        conn, _ = listener.accept()
+        total = 0
+        with conn, cpuload(target, args.sample) as load:
+            conn.settimeout(args.duration + 10)
+            start = time.monotonic()
+            while True:
+                data = conn.recv(65536)
+                if not data:
+                    break
+                total += len(data)
+            elapsed = time.monotonic() - start
+
+    target.run("iperf -a")
+    return finish(
+        {
+            "test": "tcp-tx",
+            "duration": elapsed,
+            "bytes": total,
+            "throughput_bps": total * 8 / elapsed,
+        },
+        load.load(),
+        args,
+    )
+
+
+def test_udp_rx(target, args):
+    """The host sends datagrams to the iperf server of the target"""
+
+    target.run("iperf -s -u -p %d &" % args.iperf_port)
+    time.sleep(1)
+    target.drain()
+
+    data = bytes(args.udp_size)
+    interval = 1 / args.udp_rate if args.udp_rate else 0
+    count = 0
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as s:
+        s.connect((args.target_ip, args.iperf_port))
+        with cpuload(target, args.sample) as load:
+            start = time.monotonic()
+            while time.monotonic() - start < args.duration:
+                try:
+                    s.send(data)
+                    count += 1
+                except (BlockingIOError, ConnectionRefusedError):
+                    pass
+
+                if interval:
+                    time.sleep(interval)
+            elapsed = time.monotonic() - start
+
+    # The target reports the bandwidth that it received
+
+    time.sleep(2)
+    received = parse_iperf_bps(target.drain())
+    target.run("iperf -a")
+
+    result = {
+        "test": "udp-rx",
+        "duration": elapsed,
+        "datagram_size": args.udp_size,
+        "offered_packets_per_sec": count / elapsed,
+    }
+
+    if received is not None:
+        result["throughput_bps"] = received
+        result["packets_per_sec"] = received / 8 / args.udp_size
+        result["bytes"] = int(received / 8 * elapsed)
+
+    return finish(result, load.load(), args)
+
+
+def test_udp_tx(target, args):
+    """The iperf client of the target sends datagrams to the host"""
+
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as s:
+        s.bind(("", args.iperf_port))
+        s.settimeout(10)
+
+        target.run(
+            "iperf -c %s -u -p %d -t %d &"
+            % (args.host_ip, args.iperf_port, args.duration)
+        )
+
+        total = 0
+        count = 0
+        with cpuload(target, args.sample) as load:
+            data = s.recv(65536)
+            start = time.monotonic()
+            last = start
+            s.settimeout(1)
+            while data:
+                total += len(data)
+                count += 1
+                last = time.monotonic()
+                try:
+                    data = s.recv(65536)
+                except socket.timeout:
+                    break
+            elapsed = max(last - start, 1e-6)
+
+    target.run("iperf -a")
+    return finish(
+        {
+            "test": "udp-tx",
+            "duration": elapsed,
+            "bytes": total,
+            "throughput_bps": total * 8 / elapsed,
+            "packets_per_sec": count / elapsed,
+        },
+        load.load(),
+        args,
+    )
+
+
+def test_latency(target, args):
+    """Round trips of small messages through the tcpecho server"""
+
+    target.run("tcpecho &")
+    time.sleep(1)
+
+    data = bytes(args.latency_size)
+    rtts = []
+    with socket.create_connection((args.target_ip, args.echo_port), 10) as s:
+        s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        s.settimeout(5)
+        for _ in range(args.latency_count):
+            start = time.perf_counter()
+            s.sendall(data)
+            received = 0
+            while received < len(data):
+                chunk = s.recv(len(data) - received)
+                if not chunk:
+                    raise EOFError("the echo server closed the connection")
+                received += len(chunk)
+            rtts.append((time.perf_counter() - start) * 1e6)
+
+    return {
+        "test": "tcp-latency",
+        "message_size": args.latency_size,
+        "count": len(rtts),
+        "latency_min_us": min(rtts),
+        "latency_p50_us": percentile(rtts, 0.50),
+        "latency_p90_us": percentile(rtts, 0.90),
+        "latency_p99_us": percentile(rtts, 0.99),
+        "latency_max_us": max(rtts),
+    }
+
+
+def test_connect(target, args):
+    """Set up, use and close connections to the tcpecho server"""
+
+    count = 0
+    failed = 0
+    with cpuload(target, args.sample) as load:
+        start = time.monotonic()
+        while time.monotonic() - start < args.duration:
+            try:
+                with socket.create_connection(
+                    (args.target_ip, args.echo_port), 5
+                ) as s:
+                    s.sendall(b"x")
+                    if s.recv(1):
+                        count += 1
+            except OSError:
+                failed += 1
+        elapsed = time.monotonic() - start
+
+    return {
+        "test": "tcp-connect",
+        "duration": elapsed,
+        "connections": count,
+        "failures": failed,
+        "connections_per_sec": count / elapsed,
+        "cpu_load": load.load(),
+    }
+
+
+def test_loopback(target, args):
+    """Both ends of a TCP transfer on the target, over the loopback"""
+
+    target.run("iperf -s -p %d &" % args.iperf_port)
+    time.sleep(1)
+
+    with cpuload(target, args.sample) as load:
+        start = time.monotonic()
+        output = target.run(
+            "iperf -c 127.0.0.1 -p %d -t %d" % (args.iperf_port, args.duration),
+            args.duration + 30,
+        )
+        elapsed = time.monotonic() - start
+
+    target.run("iperf -a")
+    result = {"test": "tcp-loopback", "duration": elapsed}
+    rate = parse_iperf_bps(output)
+    if rate is not None:
+        result["throughput_bps"] = rate
+        result["bytes"] = int(rate / 8 * args.duration)
+
+    # The target is both the sender and the receiver
+
+    return finish(result, load.load(), args)
+
+
+def test_chksum(target, args):
+    """The cost of the Internet checksum, from /proc/bench on the target"""
+
+    output = target.run("cat /proc/bench", 120)
+    for line in output.splitlines():
+        fields = line.strip().split(",")
+        if fields[0] == "net-chksum-1500" and len(fields) == 7:
+            nsamples, low, p50, p90, p99, high = map(int, fields[1:])
+            return {
+                "test": "chksum",
+                "bytes": 1500,
+                "count": nsamples,
+                "chksum_min_ns": low,
+                "chksum_p50_ns": p50,
+                "chksum_p99_ns": p99,
+                "chksum_ns_per_byte": p50 / 1500,
+            }
+
+    raise EOFError("no net-chksum-1500 in /proc/bench, see CONFIG_SCHED_BENCH")
+
+
+TESTS = {
+    "tcp-rx": test_tcp_rx,
+    "tcp-tx": test_tcp_tx,
+    "udp-rx": test_udp_rx,
+    "udp-tx": test_udp_tx,
+    "tcp-latency": test_latency,
+    "tcp-connect": test_connect,
+    "tcp-loopback": test_loopback,
+    "chksum": test_chksum,
+}
+
+
+def read_config(path):
+    """Return the options of a .config file that the results depend on"""
+
+    config = {}
+    with open(path) as f:
+        for line in f:
+            match = re.match(r"(CONFIG_\w+)=(.*)", line.strip())
+            if match and match.group(1) in CONFIG_KEYS:
+                config[match.group(1)] = match.group(2).strip('"')
+
+    return config
+
+
+def compare(results, path, threshold):
+    """Report the metrics that regressed from a baseline by 'threshold'%"""
+
+    with open(path) as f:
+        baseline = {r["test"]: r for r in json.load(f)["results"]}
+
+    regressions = []
+    for result in results:
+        old = baseline.get(result["test"])
+        if old is None:
+            continue
+
+        for metric, higher in METRICS.items():
+            if not old.get(metric) or result.get(metric) is None:
+                continue
+
+            change = (result[metric] - old[metric]) * 100 / old[metric]
+            worse = -change if higher else change
+            if worse > threshold:
+                regressions.append(
+                    "%s %s: %.6g -> %.6g (%+.1f%%)"
+                    % (result["test"], metric, old[metric], result[metric], change)
+                )
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=program_description)
+    parser.add_argument(
+        "-c",
+        "--command",
+        default="./nuttx",
+        help="command giving the NSH console of the target, default ./nuttx",
+    )
+    parser.add_argument("--prompt", default="nsh> ", help="NSH prompt")
+    parser.add_argument("--quit", default="poweroff", help="command to stop")
+    parser.add_argument("-t", "--target-ip", default="10.0.1.2")
+    parser.add_argument(
+        "-H", "--host-ip", default="10.0.1.1", help="host address on the target"
+    )
+    parser.add_argument(
+        "-T",
+        "--tests",
+        default="tcp-rx,tcp-tx,udp-rx,udp-tx,tcp-latency,tcp-connect",
+        help="comma-separated tests among: " + ", ".join(TESTS),
+    )
+    parser.add_argument(
+        "--loopback",
+        action="store_true",
+        help="only run the tests over the loopback device of the target",
+    )
+    parser.add_argument("-d", "--duration", type=int, default=10)
+    parser.add_argument("--iperf-port", type=int, default=5001)
+    parser.add_argument("--echo-port", type=int, default=80)
+    parser.add_argument("--tcp-size", type=int, default=16384)
+    parser.add_argument("--udp-size", type=int, default=1024)
+    parser.add_argument(
+        "--udp-rate", type=float, default=0, help="datagrams/s, 0: unlimited"
+    )
+    parser.add_argument("--latency-size", type=int, default=64)
+    parser.add_argument("--latency-count", type=int, default=1000)
+    parser.add_argument(
+        "--sample", type=float, default=1, help="CPU load sampling period (s)"
+    )
+    parser.add_argument(
+        "--cpu-hz", type=float, help="target CPU clock, to report cycles/byte"
+    )
+    parser.add_argument("--config", help=".config of the target build")
+    parser.add_argument("--label", help="free-form label of the run")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    parser.add_argument("-b", "--baseline", help="results of a previous run")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5,
+        help="regression threshold in percent, default 5",
+    )
+    parser.add_argument(
+        "-v", "--verbose", action="store_true", help="echo the target console"
+    )
+    args = parser.parse_args()
+
+    tests = ["tcp-loopback"] if args.loopback else args.tests.split(",")
+    for name in tests:
+        if name not in TESTS:
+            parser.error("unknown test %s" % name)
+
+    report = {
+        "version": 1,
+        "label": args.label,
+        "date": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+        "target": args.command,
+        "config": read_config(args.config) if args.config else {},
+        "results": [],
+    }
+
+    target = console(args.command, args.prompt, args.verbose)
+    try:
+        for name in tests:
+            try:
+                result = TESTS[name](target, args)
+            except (OSError, EOFError) as e:
+                result = {"test": name, "error": str(e)}
+
+            sys.stderr.write(json.dumps(result) + "\n")
+            report["results"].append(result)
+    finally:
+        target.close(args.quit)
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    json.dump(report, output, indent=2)
+    output.write("\n")
+    if args.output:
+        output.close()
+
+    if args.baseline:
+        regressions = compare(report["results"], args.baseline, args.threshold)
+        for line in regressions:
+            sys.stderr.write("REGRESSION: %s\n" % line)
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
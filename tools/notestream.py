@@ -0,0 +1,388 @@
+#!/usr/bin/env python3
+# tools/notestream.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+
+"""
+Convert the output of CONFIG_DRIVER_NOTESTREAM into a trace that the
+Perfetto UI (https://ui.perfetto.dev) and chrome://tracing open: the JSON
+Trace Event Format.
+
+The stream is read from a file (a capture of the serial port or of the RTT
+channel), or from the target with --tcp when DRIVER_NOTESTREAM_TCP is
+enabled:
+
+    $ ./tools/notestream.py --tcp 10.0.1.2:5555 --duration 10 -o trace.json
+    $ ./tools/notestream.py capture.bin -o trace.json
+
+The trace shows, for each CPU, the task that runs, the interrupt handlers
+and the scheduler lock and critical section states; for each task, its
+system calls, blocking time included, and the marks of sched_note_printf()
+("B|pid|name" and "E|pid|name" begin and end a slice, as in systrace).
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+import time
+
+NOTESTREAM_MAGIC = b"NXTR"
+NOTESTREAM_FLAG_LITTLE = 0x01
+NOTESTREAM_FLAG_SMP = 0x02
+NOTESTREAM_FLAG_HIRES = 0x04
+
+# The note types of include/nuttx/sched_note.h and of the stream
+
+NOTE_START = 0
+NOTE_STOP = 1
+NOTE_SUSPEND = 2
+NOTE_RESUME = 3
+NOTE_CPU_START = 4
+NOTE_CPU_STARTED = 5
+NOTE_CPU_PAUSE = 6
+NOTE_CPU_PAUSED = 7
+NOTE_CPU_RESUME = 8
+NOTE_CPU_RESUMED = 9
+NOTE_PREEMPT_LOCK = 10
+NOTE_PREEMPT_UNLOCK = 11
+NOTE_CSECTION_ENTER = 12
+NOTE_CSECTION_LEAVE = 13
+NOTE_SPINLOCK_LOCK = 14
+NOTE_SPINLOCK_LOCKED = 15
+NOTE_SPINLOCK_UNLOCK = 16
+NOTE_SPINLOCK_ABORT = 17
+NOTE_SYSCALL_ENTER = 18
+NOTE_SYSCALL_LEAVE = 19
+NOTE_IRQ_ENTER = 20
+NOTE_IRQ_LEAVE = 21
+NOTE_DUMP_STRING = 22
+NOTE_DUMP_BINARY = 23
+NOTESTREAM_TASKNAME = 0xFE
+NOTESTREAM_DROPPED = 0xFF
+
+# The trace "processes": the CPUs and the tasks
+
+PID_CPUS = 0
+PID_TASKS = 1
+
+# The tracks of a CPU
+
+TRACK_RUNNING = 0
+TRACK_IRQ = 1
+TRACK_LOCKS = 2
+
+
+def uint(data):
+    return int.from_bytes(data, "little")
+
+
+class notestream_decoder:
+    """Decoder of a note stream into trace events"""
+
+    def __init__(self):
+        self.header = None
+        self.events = []
+        self.names = {}
+        self.running = {}
+        self.dropped = 0
+
+    def parse_header(self, data):
+        magic, version, flags, ncpus = struct.unpack_from("<4sBBB", data)
+        pidsize, timesize, longsize, ptrsize = struct.unpack_from("<BBBB", data, 7)
+        usec_per_tick = struct.unpack_from("<I", data, 12)[0]
+        self.header = {
+            "version": version,
+            "little": bool(flags & NOTESTREAM_FLAG_LITTLE),
+            "smp": bool(flags & NOTESTREAM_FLAG_SMP),
+            "hires": bool(flags & NOTESTREAM_FLAG_HIRES),
+            "ncpus": ncpus,
+            "pidsize": pidsize,
+            "timesize": timesize,
+            "longsize": longsize,
+            "ptrsize": ptrsize,
+            "usec_per_tick": usec_per_tick,
+        }
+
+        # The size of struct note_common_s
+
+        self.common = 3 + (1 if self.header["smp"] else 0) + pidsize
+        if self.header["hires"]:
+            self.common += timesize + longsize
+        else:
+            self.common += timesize
+
+        for cpu in range(ncpus):
+            self.thread_name(PID_CPUS, cpu * 4 + TRACK_RUNNING, "CPU%d" % cpu)
+            self.thread_name(PID_CPUS, cpu * 4 + TRACK_IRQ, "CPU%d IRQ" % cpu)
+            self.thread_name(PID_CPUS, cpu * 4 + TRACK_LOCKS, "CPU%d locks" % cpu)
+
+    def thread_name(self, pid, tid, name):
+        self.events.append(
+            {
+                "ph": "M",
+                "name": "thread_name",
+                "pid": pid,
+                "tid": tid,
+                "args": {"name": name},
+            }
+        )
+
+    def event(self, ph, pid, tid, ts, name, args=None):
+        event = {"ph": ph, "pid": pid, "tid": tid, "ts": ts, "name": name}
+        if args:
+            event["args"] = args
+        if ph == "i":
+            event["s"] = "t"
+        self.events.append(event)
+
+    def task_name(self, pid):
+        return self.names.get(pid, "pid %d" % pid)
+
+    def note(self, note):
+        """Convert one note into trace events"""
+
+        hdr = self.header
+        ntype = note[1]
+
+        if ntype == NOTESTREAM_TASKNAME:
+            pid = uint(note[2 : 2 + hdr["pidsize"]])
+            name = note[2 + hdr["pidsize"] :].split(b"\0")[0].decode("utf-8", "replace")
+            self.names[pid] = name
+            self.thread_name(PID_TASKS, pid, name)
+            return
+
+        if ntype == NOTESTREAM_DROPPED:
+            count = uint(note[2:6])
+            self.dropped += count
+            self.event("i", PID_CPUS, 0, self.last_ts, "%d notes lost" % count)
+            return
+
+        if len(note) < self.common:
+            return
+
+        offset = 3
+        cpu = 0
+        if hdr["smp"]:
+            cpu = note[offset]
+            offset += 1
+
+        pid = uint(note[offset : offset + hdr["pidsize"]])
+        offset += hdr["pidsize"]
+
+        if hdr["hires"]:
+            sec = uint(note[offset : offset + hdr["timesize"]])
+            offset += hdr["timesize"]
+            nsec = uint(note[offset : offset + hdr["longsize"]])
+            offset += hdr["longsize"]
+            ts = sec * 1000000 + nsec / 1000
+        else:
+            ticks = uint(note[offset : offset + hdr["timesize"]])
+            offset += hdr["timesize"]
+            ts = ticks * hdr["usec_per_tick"]
+
+        self.last_ts = ts
+        body = note[offset:]
+        cputrack = cpu * 4
+
+        if ntype == NOTE_START:
+            name = body.split(b"\0")[0].decode("utf-8", "replace")
+            if name:
+                self.names[pid] = name
+                self.thread_name(PID_TASKS, pid, name)
+            self.event("i", PID_TASKS, pid, ts, "start")
+        elif ntype == NOTE_STOP:
+            self.event("i", PID_TASKS, pid, ts, "stop")
+        elif ntype == NOTE_SUSPEND:
+            if self.running.get(cpu) == pid:
+                self.event("E", PID_CPUS, cputrack + TRACK_RUNNING, ts, "")
+                del self.running[cpu]
+        elif ntype == NOTE_RESUME:
+            if cpu in self.running:
+                self.event("E", PID_CPUS, cputrack + TRACK_RUNNING, ts, "")
+            self.running[cpu] = pid
+            self.event(
+                "B",
+                PID_CPUS,
+                cputrack + TRACK_RUNNING,
+                ts,
+                self.task_name(pid),
+                {"pid": pid},
+            )
+        elif ntype in (NOTE_CPU_START, NOTE_CPU_PAUSE, NOTE_CPU_RESUME):
+            names = {
+                NOTE_CPU_START: "start CPU%d",
+                NOTE_CPU_PAUSE: "pause CPU%d",
+                NOTE_CPU_RESUME: "resume CPU%d",
+            }
+            self.event(
+                "i", PID_CPUS, cputrack + TRACK_RUNNING, ts, names[ntype] % body[0]
+            )
+        elif ntype in (NOTE_CPU_STARTED, NOTE_CPU_PAUSED, NOTE_CPU_RESUMED):
+            names = {
+                NOTE_CPU_STARTED: "started",
+                NOTE_CPU_PAUSED: "paused",
+                NOTE_CPU_RESUMED: "resumed",
+            }
+            self.event("i", PID_CPUS, cputrack + TRACK_RUNNING, ts, names[ntype])
+        elif ntype in (NOTE_PREEMPT_LOCK, NOTE_PREEMPT_UNLOCK):
+            count = uint(body[0:2])
+            if ntype == NOTE_PREEMPT_LOCK and count == 1:
+                self.event("B", PID_CPUS, cputrack + TRACK_LOCKS, ts, "sched_lock")
+            elif ntype == NOTE_PREEMPT_UNLOCK and count == 0:
+                self.event("E", PID_CPUS, cputrack + TRACK_LOCKS, ts, "")
+        elif ntype == NOTE_CSECTION_ENTER:
+            self.event("B", PID_CPUS, cputrack + TRACK_LOCKS, ts, "critical section")
+        elif ntype == NOTE_CSECTION_LEAVE:
+            self.event("E", PID_CPUS, cputrack + TRACK_LOCKS, ts, "")
+        elif NOTE_SPINLOCK_LOCK <= ntype <= NOTE_SPINLOCK_ABORT:
+            addr = uint(body[0 : hdr["ptrsize"]])
+            names = ["spin_lock", "spin_locked", "spin_unlock", "spin_abort"]
+            self.event(
+                "i",
+                PID_CPUS,
+                cputrack + TRACK_LOCKS,
+                ts,
+                names[ntype - NOTE_SPINLOCK_LOCK],
+                {"lock": hex(addr)},
+            )
+        elif ntype == NOTE_SYSCALL_ENTER:
+            nr, argc = body[0], body[1]
+            args = [
+                hex(uint(body[2 + i * hdr["ptrsize"] : 2 + (i + 1) * hdr["ptrsize"]]))
+                for i in range(argc)
+            ]
+            self.event("B", PID_TASKS, pid, ts, "syscall %d" % nr, {"args": args})
+        elif ntype == NOTE_SYSCALL_LEAVE:
+            result = uint(body[1 : 1 + hdr["ptrsize"]])
+            self.event("E", PID_TASKS, pid, ts, "", {"result": hex(result)})
+        elif ntype == NOTE_IRQ_ENTER:
+            self.event("B", PID_CPUS, cputrack + TRACK_IRQ, ts, "irq %d" % body[0])
+        elif ntype == NOTE_IRQ_LEAVE:
+            self.event("E", PID_CPUS, cputrack + TRACK_IRQ, ts, "")
+        elif ntype == NOTE_DUMP_STRING:
+            text = body[hdr["ptrsize"] :].split(b"\0")[0].decode("utf-8", "replace")
+            fields = text.split("|", 2)
+            if len(fields) == 3 and fields[0] in ("B", "E"):
+                self.event(fields[0], PID_TASKS, pid, ts, fields[2])
+            else:
+                self.event("i", PID_TASKS, pid, ts, text)
+        elif ntype == NOTE_DUMP_BINARY:
+            event = body[hdr["ptrsize"]]
+            data = body[hdr["ptrsize"] + 1 :]
+            self.event(
+                "i", PID_TASKS, pid, ts, "event %d" % event, {"data": data.hex()}
+            )
+
+    def feed(self, data):
+        """Decode the notes of a buffer, return the bytes not used yet"""
+
+        offset = 0
+        while True:
+            if self.header is None:
+                start = data.find(NOTESTREAM_MAGIC, offset)
+                if start < 0 or len(data) - start < 16:
+                    return data[max(offset, len(data) - 16) :]
+                self.parse_header(data[start:])
+                self.last_ts = 0
+                offset = start + 16
+                continue
+
+            if len(data) - offset < 2:
+                break
+
+            # A new header when the stream is reopened
+
+            if data[offset : offset + 4] == NOTESTREAM_MAGIC:
+                if len(data) - offset < 16:
+                    break
+                self.parse_header(data[offset:])
+                offset += 16
+                continue
+
+            length = data[offset]
+            if length < 2:
+                # Lost synchronization: look for the next header
+
+                self.header = None
+                offset += 1
+                continue
+
+            if len(data) - offset < length:
+                break
+
+            self.note(data[offset : offset + length])
+            offset += length
+
+        return data[offset:]
+
+    def finish(self):
+        return {"traceEvents": self.events}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a NuttX note stream to the JSON trace format"
+    )
+    parser.add_argument("streamfile", nargs="?", help="captured note stream")
+    parser.add_argument("--tcp", help="HOST:PORT of DRIVER_NOTESTREAM_TCP")
+    parser.add_argument(
+        "--duration", type=float, default=10, help="seconds to record with --tcp"
+    )
+    parser.add_argument("-o", "--output", default="-", help="JSON trace file")
+    args = parser.parse_args()
+
+    decoder = notestream_decoder()
+    pending = b""
+
+    if args.tcp:
+        host, port = args.tcp.rsplit(":", 1)
+        conn = socket.create_connection((host, int(port)))
+        end = time.monotonic() + args.duration
+        conn.settimeout(0.5)
+        while time.monotonic() < end:
+            try:
+                data = conn.recv(65536)
+            except socket.timeout:
+                continue
+            if not data:
+                break
+            pending = decoder.feed(pending + data)
+        conn.close()
+    else:
+        if args.streamfile:
+            with open(args.streamfile, "rb") as f:
+                data = f.read()
+        else:
+            data = sys.stdin.buffer.read()
+        decoder.feed(data)
+
+    if decoder.header is None:
+        sys.exit("No note stream header found")
+
+    if decoder.dropped:
+        print("%d notes were lost" % decoder.dropped, file=sys.stderr)
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    json.dump(decoder.finish(), out)
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
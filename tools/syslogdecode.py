@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+# tools/syslogdecode.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+
+"""
+Decode the binary SYSLOG output of CONFIG_SYSLOG_BINARY.
+
+Each syslog() message is recorded on the target as a struct syslog_binary_s
+(include/nuttx/syslog/syslog.h): the address of its format string and the
+raw values of its arguments.  This tool reads the format strings from the
+ELF file of the image and formats the messages as printf() would have.
+The bytes that are not part of a record, like the assertion dumps, are
+output as they are.
+
+Example, with the RAMLOG device saved to a file on the target:
+
+    nsh> cat /dev/ramlog > /tmp/syslog.bin
+
+    $ ./tools/syslogdecode.py -e nuttx syslog.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.constants import SH_FLAGS
+from elftools.elf.elffile import ELFFile
+
+SYSLOG_BINARY_MAGIC = 0xA5
+SYSLOG_BINARY_TRUNCATED = 0x80
+SYSLOG_PRIORITY = [
+    "EMERG",
+    "ALERT",
+    "CRIT",
+    "ERROR",
+    "WARN",
+    "NOTICE",
+    "INFO",
+    "DEBUG",
+]
+
+# A printf() conversion specification
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|L|j|z|t)?(?P<conv>[diouxXcspnaAeEfFgG%])"
+)
+
+
+class elf_strings:
+    """The read-only strings of an ELF file, by address"""
+
+    def __init__(self, elffile):
+        self.fd = open(elffile, "rb")
+        self.elf = ELFFile(self.fd)
+        self.little = self.elf.little_endian
+        self.ptrsize = 8 if self.elf.elfclass == 64 else 4
+        self.sections = []
+        self.cache = {}
+
+        for section in self.elf.iter_sections():
+            if section["sh_type"] == "SHT_NOBITS":
+                continue
+
+            if (section["sh_flags"] & SH_FLAGS.SHF_ALLOC) == 0:
+                continue
+
+            self.sections.append(
+                (section["sh_addr"], section["sh_addr"] + section["sh_size"], section)
+            )
+
+    def string(self, addr):
+        """Return the string at addr, None if it is not in the image"""
+
+        if addr in self.cache:
+            return self.cache[addr]
+
+        result = None
+        for start, end, section in self.sections:
+            if start <= addr < end:
+                data = section.data()
+                nul = data.find(b"\0", addr - start)
+                if nul >= 0:
+                    result = data[addr - start : nul].decode("utf-8", "replace")
+                break
+
+        self.cache[addr] = result
+        return result
+
+
+class syslog_decoder:
+    """Decoder of a stream of binary SYSLOG records"""
+
+    def __init__(self, strings, tick_usec):
+        self.strings = strings
+        self.tick_usec = tick_usec
+        endian = "<" if strings.little else ">"
+        ptr = "Q" if strings.ptrsize == 8 else "I"
+
+        # The sizes of the types on the target: ILP32 or LP64
+
+        self.endian = endian
+        self.header = struct.Struct(endian + "BBBBI" + ptr)
+        self.types = {
+            "": "i",
+            "hh": "i",
+            "h": "i",
+            "l": "q" if strings.ptrsize == 8 else "i",
+            "ll": "q",
+            "L": "q",
+            "j": "q",
+            "z": "q" if strings.ptrsize == 8 else "i",
+            "t": "q" if strings.ptrsize == 8 else "i",
+        }
+        self.ptr = ptr
+
+    def take(self, args, fmt):
+        """Take one value from the arguments, None when there is none"""
+
+        size = struct.calcsize(fmt)
+        if len(args[0]) < size:
+            args[0] = b""
+            return None
+
+        value = struct.unpack(self.endian + fmt, args[0][:size])[0]
+        args[0] = args[0][size:]
+        return value
+
+    def take_string(self, args):
+        nul = args[0].find(b"\0")
+        if nul < 0:
+            args[0] = b""
+            return None
+
+        value = args[0][:nul].decode("utf-8", "replace")
+        args[0] = args[0][nul + 1 :]
+        return value
+
+    def format(self, fmt, data):
+        """Format a message as the target printf() would have"""
+
+        args = [data]
+
+        def convert(match):
+            conv = match.group("conv")
+            if conv == "%":
+                return "%"
+
+            width = match.group("width")
+            prec = match.group("prec")
+            if width == "*":
+                width = self.take(args, "i")
+                if width is None:
+                    return "?"
+                width = str(width)
+
+            if prec == "*":
+                prec = self.take(args, "i")
+                if prec is None:
+                    return "?"
+                prec = str(prec)
+
+            spec = "%" + match.group("flags") + (width or "")
+            if prec is not None:
+                spec += "." + prec
+
+            length = match.group("length") or ""
+            if conv in "diouxX":
+                value = self.take(args, self.types[length])
+                if value is None:
+                    return "?"
+                if conv in "ouxX":
+                    bits = 8 * struct.calcsize(self.types[length])
+                    value &= (1 << bits) - 1
+                return (spec + ("d" if conv in "iu" else conv)) % value
+            elif conv == "c":
+                value = self.take(args, "i")
+                return "?" if value is None else (spec + "c") % chr(value & 0xFF)
+            elif conv == "p":
+                value = self.take(args, self.ptr)
+                return "?" if value is None else (spec + "s") % hex(value)
+            elif conv == "s":
+                value = self.take_string(args)
+                return "?" if value is None else (spec + "s") % value
+            elif conv == "n":
+                return ""
+            else:
+                value = self.take(args, "d")
+                if value is None:
+                    return "?"
+                if conv in "aA":
+                    text = float.hex(value)
+                    return text.upper() if conv == "A" else text
+                return (spec + conv) % value
+
+        return CONVERSION.sub(convert, fmt)
+
+    def record(self, data, offset):
+        """Decode the record at offset: (text, size), None if it is not one"""
+
+        if len(data) - offset < self.header.size:
+            return None
+
+        magic, priority, cpu, length, ticks, addr = self.header.unpack_from(
+            data, offset
+        )
+        if magic != SYSLOG_BINARY_MAGIC or length < self.header.size:
+            return None
+
+        if len(data) - offset < length:
+            return None
+
+        fmt = self.strings.string(addr)
+        if fmt is None:
+            return None
+
+        try:
+            message = self.format(
+                fmt, data[offset + self.header.size : offset + length]
+            )
+        except (TypeError, ValueError, OverflowError):
+            return None
+
+        if priority & SYSLOG_BINARY_TRUNCATED:
+            message = message.rstrip("\n") + " [truncated]\n"
+
+        usec = ticks * self.tick_usec
+        prio = SYSLOG_PRIORITY[priority & 7]
+        text = "[%5d.%06d] [CPU%d] [%6s] %s" % (
+            usec // 1000000,
+            usec % 1000000,
+            cpu,
+            prio,
+            message,
+        )
+        return text, length
+
+    def decode(self, data, out):
+        """Decode a stream, resynchronizing on the next record on errors"""
+
+        offset = 0
+        while offset < len(data):
+            result = None
+            if data[offset] == SYSLOG_BINARY_MAGIC:
+                result = self.record(data, offset)
+
+            if result is not None:
+                text, size = result
+                out.write(text)
+                if not text.endswith("\n"):
+                    out.write("\n")
+                offset += size
+            else:
+                # Not a record: this is text output, or a record that the
+                # RAMLOG overwrote partially.
+
+                if data[offset] != 0:
+                    out.write(chr(data[offset]))
+                offset += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode the output of CONFIG_SYSLOG_BINARY"
+    )
+    parser.add_argument(
+        "-e", "--elffile", required=True, help="ELF file of the image"
+    )
+    parser.add_argument(
+        "-t",
+        "--tick-usec",
+        type=int,
+        default=10000,
+        help="CONFIG_USEC_PER_TICK of the image (default: 10000)",
+    )
+    parser.add_argument(
+        "logfile", nargs="?", help="binary SYSLOG output (default: stdin)"
+    )
+    args = parser.parse_args()
+
+    if args.logfile:
+        with open(args.logfile, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    decoder = syslog_decoder(elf_strings(args.elffile), args.tick_usec)
+    decoder.decode(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -85,10 +85,45 @@ static void mac802154_rxbeaconframe(FAR struct ieee802154_privmac_s *priv,
 
 static void mac802154_notify_worker(FAR void *arg);
 
+static bool
+mac802154_indirect_match(FAR const struct ieee802154_txdesc_s *txdesc,
+                         FAR const struct ieee802154_addr_s *addr);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mac802154_indirect_match
+ *
+ * Description:
+ *   Return true if the indirect transaction is for the device with the
+ *   address addr.
+ *
+ ****************************************************************************/
+
+static bool
+mac802154_indirect_match(FAR const struct ieee802154_txdesc_s *txdesc,
+                         FAR const struct ieee802154_addr_s *addr)
+{
+  if (txdesc->destaddr.mode != addr->mode)
+    {
+      return false;
+    }
+
+  if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_SHORT)
+    {
+      return IEEE802154_SADDRCMP(txdesc->destaddr.saddr, addr->saddr);
+    }
+  else if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_EXTENDED)
+    {
+      return IEEE802154_EADDRCMP(txdesc->destaddr.eaddr, addr->eaddr);
+    }
+
+  DEBUGPANIC();
+  return false;
+}
+
 /****************************************************************************
  * Name: mac802154_resetqueues
  *
@@ -366,6 +401,8 @@ void mac802154_notify(FAR struct ieee802154_privmac_s *priv,
  * Description:
  *    Pop each primitive off the queue and call the registered
  *    callbacks.  There is special logic for handling ieee802154_data_ind_s.
+ *    The primitives queued meanwhile are taken all at once, so that the
+ *    MAC is locked once per batch rather than once per primitive.
  *
  ****************************************************************************/
 
@@ -375,14 +412,16 @@ static void mac802154_notify_worker(FAR void *arg)
     (FAR struct ieee802154_privmac_s *)arg;
   FAR struct mac802154_maccb_s *cb;
   FAR struct ieee802154_primitive_s *primitive;
+  sq_queue_t queue;
   int ret;
 
   mac802154_lock(priv, false);
-  primitive =
-    (FAR struct ieee802154_primitive_s *)sq_remfirst(&priv->primitive_queue);
+  queue = priv->primitive_queue;
+  sq_init(&priv->primitive_queue);
   mac802154_unlock(priv);
 
-  while (primitive != NULL)
+  while ((primitive = (FAR struct ieee802154_primitive_s *)
+                        sq_remfirst(&queue)) != NULL)
     {
       /* Data indications are a special case since the frame can only be
        * passed to one place. The return value of the notify call is used to
@@ -448,12 +487,15 @@ static void mac802154_notify_worker(FAR void *arg)
             }
         }
 
-      /* Get the next primitive then loop */
+      /* Take the primitives queued meanwhile when the batch is done */
 
-      mac802154_lock(priv, false);
-      primitive = (FAR struct ieee802154_primitive_s *)
-                    sq_remfirst(&priv->primitive_queue);
-      mac802154_unlock(priv);
+      if (sq_empty(&queue))
+        {
+          mac802154_lock(priv, false);
+          queue = priv->primitive_queue;
+          sq_init(&priv->primitive_queue);
+          mac802154_unlock(priv);
+        }
     }
 }
 
@@ -1465,62 +1507,53 @@ static void mac802154_rxdatareq(FAR struct ieee802154_privmac_s *priv,
    */
 
   txdesc = (FAR struct ieee802154_txdesc_s *)sq_peek(&priv->indirect_queue);
-
-  while (txdesc != NULL)
+  while (txdesc != NULL && !mac802154_indirect_match(txdesc, &ind->src))
     {
-      if (txdesc->destaddr.mode == ind->src.mode)
-        {
-          if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_SHORT)
-            {
-              if (IEEE802154_SADDRCMP(txdesc->destaddr.saddr,
-                                      ind->src.saddr))
-                {
-                  /* Remove the transaction from the queue */
-
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
-
-                  /* NOTE: We don't do anything with the purge timeout,
-                   * because we really don't need to. As of now, I see no
-                   * disadvantage to just letting the timeout expire, which
-                   * won't purge the transaction since it is no longer on
-                   * the list, and then it will reschedule the next timeout
-                   * appropriately.  The logic otherwise may get complicated
-                   * even though it may save a few clock cycles.
-                   */
+      txdesc = (FAR struct ieee802154_txdesc_s *)
+                 sq_next((FAR sq_entry_t *)txdesc);
+    }
 
-                  /* The addresses match, send the transaction immediately */
+  if (txdesc != NULL)
+    {
+      FAR struct ieee802154_txdesc_s *next;
 
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else if (txdesc->destaddr.mode == IEEE802154_ADDRMODE_EXTENDED)
-            {
-              if (IEEE802154_EADDRCMP(txdesc->destaddr.eaddr,
-                                      ind->src.eaddr))
-                {
-                  /* Remove the transaction from the queue */
+      /* Remove the transaction from the queue */
 
-                  sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
+      sq_rem((FAR sq_entry_t *)txdesc, &priv->indirect_queue);
 
-                  /* The addresses match, send the transaction immediately */
+      /* If more transactions wait for the same device, set the Frame
+       * Pending field so that it requests the next one right away, rather
+       * than at its next poll.  [1] pg. 43
+       */
 
-                  priv->radio->txdelayed(priv->radio, txdesc, 0);
-                  priv->beaconupdate = true;
-                  mac802154_unlock(priv)
-                  return;
-                }
-            }
-          else
+      for (next = (FAR struct ieee802154_txdesc_s *)
+                    sq_peek(&priv->indirect_queue);
+           next != NULL;
+           next = (FAR struct ieee802154_txdesc_s *)
+                    sq_next((FAR sq_entry_t *)next))
+        {
+          if (mac802154_indirect_match(next, &ind->src))
             {
-              DEBUGPANIC();
+              frame_ctrl = (FAR uint16_t *)&txdesc->frame->io_data[0];
+              *frame_ctrl |= IEEE802154_FRAMECTRL_PEND;
+              break;
             }
         }
 
-      txdesc = (FAR struct ieee802154_txdesc_s *)
-                 sq_next((FAR sq_entry_t *)txdesc);
+      /* NOTE: We don't do anything with the purge timeout, because we
+       * really don't need to. As of now, I see no disadvantage to just
+       * letting the timeout expire, which won't purge the transaction since
+       * it is no longer on the list, and then it will reschedule the next
+       * timeout appropriately.  The logic otherwise may get complicated
+       * even though it may save a few clock cycles.
+       */
+
+      /* The addresses match, send the transaction immediately */
+
+      priv->radio->txdelayed(priv->radio, txdesc, 0);
+      priv->beaconupdate = true;
+      mac802154_unlock(priv)
+      return;
     }
 
   /* If there is no data frame pending for the requesting device, the